@@ -6,9 +6,15 @@
 
 #include "log.h"
 
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
 #include <filesystem>
 #include <fstream>
+#include <functional>
 #include <set>
+#include <sstream>
+#include <random>
 #include <vector>
 
 namespace fs = std::filesystem;
@@ -76,6 +82,172 @@ std::vector<fs::path> GetConfigPaths(const std::string& configSearch)
 
   return paths;
 }
+
+//----------------------------------------------------------------------------
+/**
+ * Read the blocks of a config file into entries, return false if it cannot be read
+ */
+bool ReadConfigFile(const fs::path& configFilePath, F3DOptionsTools::OptionsEntries& confEntries)
+{
+  std::ifstream file(configFilePath);
+  if (!file.is_open())
+  {
+    // Cannot be tested
+    f3d::log::warn(
+      "Unable to open the configuration file: ", configFilePath.string(), " , ignoring it");
+    return false;
+  }
+
+  // Read the file into a json
+  nlohmann::ordered_json json;
+  try
+  {
+    file >> json;
+  }
+  catch (const std::exception& ex)
+  {
+    f3d::log::error(
+      "Unable to parse the configuration file ", configFilePath.string(), " , ignoring it");
+    f3d::log::error(ex.what());
+    return false;
+  }
+
+  // For each config "pattern"
+  bool valid = true;
+  for (const auto& configBlock : json.items())
+  {
+    // Add each config entry into an option dict
+    F3DOptionsTools::OptionsDict entry;
+    for (const auto& item : configBlock.value().items())
+    {
+      if (item.value().is_number() || item.value().is_boolean())
+      {
+        entry[item.key()] = nlohmann::to_string(item.value());
+      }
+      else if (item.value().is_string())
+      {
+        entry[item.key()] = item.value().get<std::string>();
+      }
+      else
+      {
+        f3d::log::error(item.key(), " from ", configFilePath.string(),
+          " must be a string, a boolean or a number, ignoring entry");
+        valid = false;
+        continue;
+      }
+    }
+
+    // Emplace the option dict for that pattern into the config entries vector
+    confEntries.emplace_back(entry, configFilePath, configBlock.key());
+  }
+  return valid;
+}
+
+// Modification times of the config files and directories, in the order they are read
+using ConfigTimes = std::vector<std::pair<std::string, int64_t>>;
+
+//----------------------------------------------------------------------------
+int64_t GetWriteTime(const fs::path& path)
+{
+  std::error_code ec;
+  fs::file_time_type time = fs::last_write_time(path, ec);
+  return ec ? -1 : static_cast<int64_t>(time.time_since_epoch().count());
+}
+
+//----------------------------------------------------------------------------
+/**
+ * Get the path of the file caching the entries read for a key, empty if there is
+ * no cache directory
+ */
+fs::path GetCacheFilePath(const std::string& cacheKey)
+{
+  fs::path cacheDir = F3DSystemTools::GetUserCacheDirectory();
+  if (cacheDir.empty())
+  {
+    return {};
+  }
+  std::stringstream name;
+  name << "config-" << std::hex << std::hash<std::string>()(cacheKey) << ".json";
+  return cacheDir / "configs" / name.str();
+}
+
+//----------------------------------------------------------------------------
+/**
+ * Read the cached entries if they were read from files with the provided modification times
+ */
+bool ReadCache(const fs::path& cacheFilePath, const ConfigTimes& configTimes,
+  F3DOptionsTools::OptionsEntries& confEntries)
+{
+  if (cacheFilePath.empty())
+  {
+    return false;
+  }
+  std::ifstream file(cacheFilePath);
+  if (!file.is_open())
+  {
+    return false;
+  }
+
+  try
+  {
+    nlohmann::json json;
+    file >> json;
+    if (json.at("times").get<ConfigTimes>() != configTimes)
+    {
+      return false;
+    }
+    for (const nlohmann::json& entry : json.at("entries"))
+    {
+      confEntries.emplace_back(entry.at("options").get<F3DOptionsTools::OptionsDict>(),
+        fs::path(entry.at("source").get<std::string>()), entry.at("pattern").get<std::string>());
+    }
+  }
+  catch (const std::exception&)
+  {
+    confEntries.clear();
+    return false;
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * Write the entries read from files with the provided modification times in the cache
+ */
+void WriteCache(const fs::path& cacheFilePath, const ConfigTimes& configTimes,
+  const F3DOptionsTools::OptionsEntries& confEntries)
+{
+  if (cacheFilePath.empty())
+  {
+    return;
+  }
+
+  nlohmann::json json;
+  json["times"] = configTimes;
+  json["entries"] = nlohmann::json::array();
+  for (const auto& [options, source, pattern] : confEntries)
+  {
+    json["entries"].push_back(
+      { { "options", options }, { "source", source.string() }, { "pattern", pattern } });
+  }
+
+  // Written next to the cache then renamed so that concurrent instances never read a partial file
+  try
+  {
+    fs::create_directories(cacheFilePath.parent_path());
+    fs::path tmpPath = cacheFilePath;
+    tmpPath += "." + std::to_string(std::random_device()());
+    {
+      std::ofstream file(tmpPath);
+      file << json;
+    }
+    fs::rename(tmpPath, cacheFilePath);
+  }
+  catch (const std::exception& ex)
+  {
+    f3d::log::debug("Cannot write the configuration cache: ", ex.what());
+  }
+}
 }
 
 //----------------------------------------------------------------------------
@@ -113,8 +285,10 @@ F3DOptionsTools::OptionsEntries F3DConfigFileTools::ReadConfigFiles(const std::s
     configPaths.emplace_back(userConfig);
   }
 
-  // Recover actual individual config file paths
+  // Recover actual individual config file paths, and their modification times
+  // as well as the directories ones to detect added or removed files
   std::set<fs::path> actualConfigFilePaths;
+  ::ConfigTimes configTimes;
   for (auto configPath : configPaths)
   {
     // Recover an absolute canonical path to config file
@@ -132,6 +306,7 @@ F3DOptionsTools::OptionsEntries F3DConfigFileTools::ReadConfigFiles(const std::s
     if (fs::is_directory(configPath))
     {
       f3d::log::debug("Using config directory ", configPath.string());
+      configTimes.emplace_back(configPath.string(), ::GetWriteTime(configPath));
       for (auto& entry : std::filesystem::directory_iterator(configPath))
       {
         actualConfigFilePaths.emplace(entry);
@@ -143,6 +318,10 @@ F3DOptionsTools::OptionsEntries F3DConfigFileTools::ReadConfigFiles(const std::s
       actualConfigFilePaths.emplace(configPath);
     }
   }
+  for (const auto& configFilePath : actualConfigFilePaths)
+  {
+    configTimes.emplace_back(configFilePath.string(), ::GetWriteTime(configFilePath));
+  }
 
   // If we used a configSearch but did not find any, warn the user
   if (!configSearch.empty() && actualConfigFilePaths.empty())
@@ -150,59 +329,93 @@ F3DOptionsTools::OptionsEntries F3DConfigFileTools::ReadConfigFiles(const std::s
     f3d::log::warn("Configuration file for \"", configSearch, "\" could not be found");
   }
 
-  // Read config files
+  // Reuse the entries of the previous read if the files did not change,
+  // the cache is specific to the searched config paths, eg of an install
+  std::string cacheKey = configSearch.empty() ? userConfig : configSearch;
+  for (const fs::path& configPath : configPaths)
+  {
+    cacheKey += ";" + configPath.string();
+  }
+  const fs::path cacheFilePath = ::GetCacheFilePath(cacheKey);
   F3DOptionsTools::OptionsEntries confEntries;
+  if (::ReadCache(cacheFilePath, configTimes, confEntries))
+  {
+    f3d::log::debug("Using cached configuration ", cacheFilePath.string());
+    return confEntries;
+  }
+
+  // Read config files
+  bool valid = true;
   for (const auto& configFilePath : actualConfigFilePaths)
   {
-    std::ifstream file(configFilePath);
-    if (!file.is_open())
-    {
-      // Cannot be tested
-      f3d::log::warn(
-        "Unable to open the configuration file: ", configFilePath.string(), " , ignoring it");
-      continue;
-    }
+    valid &= ::ReadConfigFile(configFilePath, confEntries);
+  }
 
-    // Read the file into a json
-    nlohmann::ordered_json json;
-    try
+  // Files with errors are not cached so that errors are reported each time
+  if (valid)
+  {
+    ::WriteCache(cacheFilePath, configTimes, confEntries);
+  }
+  return confEntries;
+}
+
+//----------------------------------------------------------------------------
+F3DConfigFileTools::PatternMatcher::PatternMatcher(const std::string& pattern)
+{
+  // Recognize `.*(ext|ext)` and `.*` patterns
+  const std::string prefix = ".*";
+  bool simple = pattern.compare(0, prefix.size(), prefix) == 0;
+  std::string alternatives = simple ? pattern.substr(prefix.size()) : "";
+  if (simple && !alternatives.empty())
+  {
+    simple = alternatives.size() >= 2 && alternatives.front() == '(' &&
+      alternatives.back() == ')';
+    alternatives = simple ? alternatives.substr(1, alternatives.size() - 2) : "";
+    simple = simple &&
+      std::all_of(alternatives.begin(), alternatives.end(),
+        [](char c) { return std::isalnum(static_cast<unsigned char>(c)) || c == '.' || c == '|'; });
+  }
+
+  if (simple)
+  {
+    std::transform(alternatives.begin(), alternatives.end(), alternatives.begin(),
+      [](char c) { return static_cast<char>(std::tolower(static_cast<unsigned char>(c))); });
+    std::stringstream ss(alternatives);
+    std::string suffix;
+    while (std::getline(ss, suffix, '|'))
     {
-      file >> json;
+      this->Suffixes.emplace_back(suffix);
     }
-    catch (const std::exception& ex)
+    if (this->Suffixes.empty() || alternatives.back() == '|')
     {
-      f3d::log::error(
-        "Unable to parse the configuration file ", configFilePath.string(), " , ignoring it");
-      f3d::log::error(ex.what());
-      continue;
+      // `.*` or an empty alternative, matches everything
+      this->Suffixes.emplace_back();
     }
+  }
+  else
+  {
+    this->Regex = std::regex(pattern, std::regex_constants::icase);
+  }
+}
 
-    // For each config "pattern"
-    for (const auto& configBlock : json.items())
-    {
-      // Add each config entry into an option dict
-      F3DOptionsTools::OptionsDict entry;
-      for (const auto& item : configBlock.value().items())
-      {
-        if (item.value().is_number() || item.value().is_boolean())
-        {
-          entry[item.key()] = nlohmann::to_string(item.value());
-        }
-        else if (item.value().is_string())
-        {
-          entry[item.key()] = item.value().get<std::string>();
-        }
-        else
-        {
-          f3d::log::error(item.key(), " from ", configFilePath.string(),
-            " must be a string, a boolean or a number, ignoring entry");
-          continue;
-        }
-      }
-
-      // Emplace the option dict for that pattern into the config entries vector
-      confEntries.emplace_back(entry, configFilePath, configBlock.key());
-    }
+//----------------------------------------------------------------------------
+bool F3DConfigFileTools::PatternMatcher::Match(const std::string& fileName) const
+{
+  if (this->Regex)
+  {
+    return std::regex_match(fileName, *this->Regex);
   }
-  return confEntries;
+
+  // `.` matches any character like in the regex
+  auto sameChar = [](char suffixChar, char fileChar)
+  {
+    return suffixChar == '.' ||
+      suffixChar == static_cast<char>(std::tolower(static_cast<unsigned char>(fileChar)));
+  };
+  return std::any_of(this->Suffixes.begin(), this->Suffixes.end(),
+    [&](const std::string& suffix)
+    {
+      return suffix.size() <= fileName.size() &&
+        std::equal(suffix.begin(), suffix.end(), fileName.end() - suffix.size(), sameChar);
+    });
 }
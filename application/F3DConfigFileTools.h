@@ -6,15 +6,40 @@
  */
 #include "F3DOptionsTools.h"
 
+#include <optional>
+#include <regex>
 #include <string>
+#include <vector>
 
 namespace F3DConfigFileTools
 {
 /**
  * Read config files using userConfig if any, return an optionEntries
  * containing ordered optionDict.
+ * The parsed entries are cached in the user cache directory and reused as long as
+ * the modification times of the config files and directories are unchanged.
  */
 F3DOptionsTools::OptionsEntries ReadConfigFiles(const std::string& userConfig);
+
+/**
+ * Match the pattern of a config block with file names, ignoring case.
+ * Patterns of the form `.*(ext|ext)`, where `.` in extensions matches any character,
+ * only compare the end of the file names, other patterns are compiled once as a regex.
+ */
+class PatternMatcher
+{
+public:
+  explicit PatternMatcher(const std::string& pattern);
+
+  /**
+   * Return true if the whole file name matches the pattern
+   */
+  bool Match(const std::string& fileName) const;
+
+private:
+  std::vector<std::string> Suffixes;
+  std::optional<std::regex> Regex;
+};
 }
 
 #endif
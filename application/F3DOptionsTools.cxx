@@ -63,17 +63,29 @@ static inline const std::array<CLIGroup, 8> CLIOptions = {{
   { "Applicative",
     { { "output", "", "Render to file", "<png file>", "" },
       { "no-background", "", "No background when render to file", "<bool>", "1" },
+      { "output-scale", "", "Render to file an image larger than the window by this factor, in tiles", "<int>", "" },
+      { "output-band", "", "Render to file only a horizontal band of the output, to split a render across processes", "<index,count>", "" },
+      { "batch", "", "Render the jobs read from a JSON lines file, or stdin with -, reusing the same engine", "<jobs file>", "-" },
+      { "animation-frames", "", "Render all the animation frames at the animation frame rate into the output", "<bool>", "1" },
+      { "video-codec", "", "Codec used by ffmpeg to encode a video output", "<codec>", "" },
       { "help", "h", "Print help", "", "" }, { "version", "", "Print version details", "", "" },
       { "readers-list", "", "Print the list of readers", "", "" },
       { "config", "", "Specify the configuration file to use. absolute/relative path or filename/filestem to search in configuration file locations", "<filePath/filename/fileStem>", "" },
       { "dry-run", "", "Do not read the configuration file", "<bool>", "1" },
       { "no-render", "", "Do not read the configuration file", "<bool>", "1" },
       { "rendering-backend", "", "Backend to use when rendering (auto|glx|wgl|egl|osmesa)", "<string>", "" },
+      { "rendering-device", "", "Index of the GPU to render with when using the egl backend", "<index>", "" },
+      { "shader-cache", "", "Let the OpenGL drivers store the compiled shaders in the cache directory for the next runs", "<bool>", "1" },
       { "max-size", "", "Maximum size in Mib of a file to load, negative value means unlimited", "<size in Mib>", "" },
       { "watch", "", "Watch current file and automatically reload it whenever it is modified on disk", "<bool>", "1" },
+      { "command-input", "", "Read commands to trigger from a file, a fifo or stdin with -, one per line", "<file_path>", "-" },
+      { "remote-server", "", "Stream the frames to a WebSocket client on this port, applying its commands", "<port>", "" },
+      { "preload", "", "Read the previous and next file groups in the background, using at most the provided memory in MiB", "<MiB>", "1024" },
       { "load-plugins", "", "List of plugins to load separated with a comma", "<paths or names>", "" },
       { "scan-plugins", "", "Scan standard directories for plugins and display available plugins (result can be incomplete)", "", "" },
-      { "screenshot-filename", "", "Screenshot filename", "<filename>", "" } } },
+      { "screenshot-filename", "", "Screenshot filename", "<filename>", "" },
+      { "trace", "", "Write a trace of the startup and rendering steps in a JSON trace event file", "<json file>", "" },
+      { "metrics", "", "Write the load, render and cache metrics in a JSON file when exiting and after each batch job", "<json file>", "" } } },
   { "General",
     { { "verbose", "", "Set verbose level, providing more information about the loaded data in the console output", "{debug, info, warning, error, quiet}", "debug" },
       { "progress", "", "Show loading progress bar", "<bool>", "1" },
@@ -94,11 +106,33 @@ static inline const std::array<CLIGroup, 8> CLIOptions = {{
       { "animation-speed-factor", "", "Set animation speed factor", "<factor>", "" },
       { "animation-time", "", "Set animation time to load", "<time>", "" },
       {"animation-frame-rate", "", "Set animation frame rate when playing animation interactively", "<frame rate>", ""},
+      {"animation-vsync", "", "Play the animation at the refresh rate of the display", "<bool>", "1"},
+      { "animation-prefetch", "", "Set the number of time steps to decode ahead when playing animation", "<count>", "" },
+      { "animation-prefetch-memory", "", "Set the memory budget of the prefetched time steps in MiB", "<MiB>", "" },
+      { "point-cloud-budget", "", "Stream large point clouds from an octree with this many points at most", "<count>", "" },
+      { "point-cloud-memory", "", "Set the memory budget of the streamed point cloud nodes in MiB", "<MiB>", "" },
+      { "volume-budget", "", "Stream large volumes from a bricked pyramid with this size at most in MiB", "<MiB>", "" },
+      { "volume-memory", "", "Set the memory budget of the streamed volume bricks in MiB", "<MiB>", "" },
+      { "memory-budget", "", "Set the memory budget of the scene in MiB, reject files exceeding it", "<MiB>", "" },
+      { "optimize-geometry", "", "Merge duplicated vertices and meshes when importing scenes", "<bool>", "1" },
+      { "payloads", "", "Regular expression of the prim paths whose payloads are loaded", "<regex>", "" },
+      { "population-mask", "", "Comma separated prim paths of the stage to populate", "<paths>", "" },
+      { "tessellation-error", "", "Refine the tessellation of CAD models above this error in pixels", "<pixels>", "" },
+      { "snapshot", "", "Cache a snapshot of the imported scenes to reopen them faster", "<bool>", "1" },
+      { "remote-cache", "", "Copy the files on network filesystems to the cache directory to read them", "<bool>", "1" },
+      { "lazy-arrays", "", "Only read the colored array of data files", "<bool>", "1" },
+      { "thumbnail-profile", "", "Read files faster at a lower quality to generate thumbnails", "<bool>", "1" },
+      { "triangle-budget", "", "Simplify the surfaces of each file to this many triangles at most", "<count>", "" },
+      { "generate-normals", "", "Generate smooth normals for the surfaces without normals", "<bool>", "1" },
+      { "normals-feature-angle", "", "Angle in degrees between faces above which generated normals are not smoothed", "<angle>", "" },
+      { "texture-cache", "", "Keep the decoded textures up to this many megabytes to share them between files", "<MB>", "" },
       {"font-file", "", "Path to a FreeType compatible font file", "<file_path>", ""} } },
   { "Material",
     { {"point-sprites", "o", "Show sphere sprites instead of surfaces", "<bool>", "1" },
       {"point-sprites-type", "", "Point sprites type", "<sphere|gaussian>", ""},
       {"point-sprites-size", "", "Point sprites size", "<size>", ""},
+      {"point-sprites-sort-budget", "", "Maximum number of gaussians sorted per frame during interaction", "<count>", ""},
+      {"point-sprites-instancing", "", "Draw point sprites as instances of a single quad", "<bool>", "1"},
       {"point-size", "", "Point size when showing vertices, model specified by default", "<size>", ""},
       {"line-width", "", "Line width when showing edges, model specified by default", "<width>", ""},
       {"backface-type", "", "Backface type, can be visible or hidden, model specified by default", "<visible|hidden>", ""},
@@ -121,11 +155,20 @@ static inline const std::array<CLIGroup, 8> CLIOptions = {{
       {"resolution", "", "Window resolution", "<width,height>", ""},
       {"position", "", "Window position", "<x,y>", ""},
       {"fps", "z", "Display frame per second", "<bool>", "1"},
+      {"frame-stats", "", "Display frame time statistics", "<bool>", "1"},
       {"filename", "n", "Display filename", "<bool>", "1"},
       {"metadata", "m", "Display file metadata", "<bool>", "1"},
       {"blur-background", "u", "Blur background", "<bool>", "1" },
       {"blur-coc", "", "Blur circle of confusion radius", "<value>", ""},
-      {"light-intensity", "", "Light intensity", "<value>", ""} } },
+      {"light-intensity", "", "Light intensity", "<value>", ""},
+      {"dynamic-resolution", "", "Lower the resolution of the objects while interacting", "<bool>", "1"},
+      {"dynamic-resolution-frame-rate", "", "Target frame rate while interacting, the resolution is lowered when it is not reached", "<fps>", ""},
+      {"lod", "", "Render decimated proxies of dense surfaces while interacting", "<bool>", "1"},
+      {"lod-frame-rate", "", "Target frame rate while interacting, proxies are used when it is not reached", "<fps>", ""},
+      {"occlusion-culling", "", "Do not render the objects hidden behind others while interacting", "<bool>", "1"},
+      {"static-batching", "", "Render the small objects sharing a material of static files together", "<bool>", "1"},
+      {"compact-vertices", "", "Upload the surfaces in compact vertex buffers, halving their GPU memory", "<bool>", "1"},
+      {"texture-budget", "", "GPU memory budget of the textures in MB, downsampling the textures far from the camera", "<MB>", ""} } },
   {"Scientific visualization",
     { {"scalar-coloring", "s", "Color by a scalar array", "<bool>", "1" },
       {"coloring-array", "", "Name of the array to color with", "<array_name>", "" },
@@ -135,8 +178,11 @@ static inline const std::array<CLIGroup, 8> CLIOptions = {{
       {"bar", "b", "Show scalar bar", "<bool>", "1" },
       {"colormap-file", "", "Specify a colormap image", "<filePath/filename/fileStem>", ""},
       {"colormap", "", "Specify a custom colormap (ignored if \"colormap-file\" is specified)", "<color_list>", ""},
+      {"gpu-coloring", "", "Map the point scalars to colors on the GPU", "<bool>", "1"},
       {"volume", "v", "Show volume if the file is compatible", "<bool>", "1"},
-      {"inverse", "i", "Inverse opacity function for volume rendering", "<bool>", "1"} } },
+      {"inverse", "i", "Inverse opacity function for volume rendering", "<bool>", "1"},
+      {"volume-precision", "", "Precision of the volume textures, quantized to normalized 16-bit or 8-bit values over the coloring range", "<native|16bit|8bit>", ""},
+      {"volume-pre-integration", "", "Pre-integrate the transfer functions between the volume samples, allowing larger sample distances", "<bool>", "1"} } },
   {"Camera",
     { {"camera-position", "", "Camera position (overrides camera direction and camera zoom factor if any)", "<X,Y,Z>", ""},
       {"camera-focal-point", "", "Camera focal point", "<X,Y,Z>", ""},
@@ -156,15 +202,24 @@ static inline const std::array<CLIGroup, 8> CLIOptions = {{
 #endif
   {"PostFX (OpenGL)",
     { {"translucency-support", "p", "Enable translucency support, implemented using depth peeling", "<bool>", "1"},
+      {"translucency-technique", "", "Technique used for translucency support, exact depth peeling or faster weighted blended order independent transparency", "<depth_peeling|weighted_blended>", ""},
+      {"translucency-peels", "", "Maximum number of depth peels of translucency support", "<count>", ""},
+      {"translucency-threshold", "", "Ratio of the pixels under which a depth peel stops the peeling", "<ratio>", ""},
       {"ambient-occlusion", "q", "Enable ambient occlusion providing approximate shadows for better depth perception, implemented using SSAO", "<bool>", "1"},
+      {"ambient-occlusion-downsampling", "", "Divide the resolution of the ambient occlusion, which is then accumulated over the frames while the view is still", "<int>", ""},
+      {"eye-dome-lighting", "", "Shade the edges of the points and surfaces using their depth only, enabled by default when showing point sprites", "<bool>", "1"},
+      {"progressive-frames", "", "Render cheaply while interacting and accumulate this number of anti-aliased frames while the view is still", "<int>", ""},
       {"anti-aliasing", "a", "Enable anti-aliasing, implemented using FXAA", "<bool>", "1"},
+      {"anti-aliasing-technique", "", "Technique used for anti-aliasing, FXAA or temporal anti-aliasing accumulating jittered frames", "<fxaa|taa>", ""},
       {"tone-mapping", "t", "Enable Tone Mapping, providing balanced coloring", "<bool>", "1"},
       {"final-shader", "", "Execute the final shader at the end of the rendering pipeline", "<GLSL code>", ""} } },
   {"Testing",
     { {"ref", "", "Reference", "<png file>", ""},
       {"ref-threshold", "", "Testing threshold", "<threshold>", ""},
       {"interaction-test-record", "", "Path to an interaction log file to record interactions events to", "<file_path>", ""},
-      {"interaction-test-play", "", "Path to an interaction log file to play interaction events from when loading a file", "<file_path>", ""} } }
+      {"interaction-test-play", "", "Path to an interaction log file to play interaction events from when loading a file", "<file_path>", ""},
+      {"interaction-test-fast", "", "Play interaction events without the idle timer events and log the replay timings", "<bool>", "1"},
+      {"interaction-test-render-interval", "", "Render played interaction events every N events only", "<N>", ""} } }
 }};
 
 /**
@@ -28,14 +28,26 @@ static inline const OptionsDict DefaultAppOptions = {
   { "input", "" },
   { "output", "" },
   { "no-background", "false" },
+  { "output-scale", "1" },
+  { "output-band", "" },
+  { "batch", "" },
+  { "animation-frames", "false" },
+  { "video-codec", "libx264" },
   { "config", "" },
   { "dry-run", "false" },
   { "no-render", "false" },
   { "rendering-backend", "auto" },
+  { "rendering-device", "-1" },
+  { "shader-cache", "false" },
   { "max-size", "-1.0" },
   { "watch", "false" },
+  { "command-input", "" },
+  { "remote-server", "0" },
+  { "preload", "0" },
   { "load-plugins", "" },
   { "screenshot-filename", "{app}/{model}_{n}.png" },
+  { "trace", "" },
+  { "metrics", "" },
   { "verbose", "info" },
   { "multi-file-mode", "single" },
   { "resolution", "1000, 600" },
@@ -72,15 +84,39 @@ static inline const std::map<std::string_view, std::string_view> LibOptionsNames
   { "camera-index", "scene.camera.index" },
   { "trackball", "interactor.trackball" },
   { "invert-zoom", "interactor.invert_zoom" },
+  { "interaction-test-fast", "interactor.replay.fast" },
+  { "interaction-test-render-interval", "interactor.replay.render_interval" },
   { "animation-autoplay", "scene.animation.autoplay" },
   { "animation-index", "scene.animation.index" },
   { "animation-speed-factor", "scene.animation.speed_factor" },
   { "animation-time", "scene.animation.time" },
   { "animation-frame-rate", "scene.animation.frame_rate" },
+  { "animation-vsync", "scene.animation.vsync" },
+  { "animation-prefetch", "scene.animation.prefetch" },
+  { "animation-prefetch-memory", "scene.animation.prefetch_memory" },
+  { "point-cloud-budget", "scene.point_cloud.budget" },
+  { "point-cloud-memory", "scene.point_cloud.memory" },
+  { "volume-budget", "scene.volume.budget" },
+  { "volume-memory", "scene.volume.memory" },
+  { "memory-budget", "scene.memory_budget" },
+  { "optimize-geometry", "scene.optimize_geometry" },
+  { "payloads", "scene.payloads" },
+  { "population-mask", "scene.population_mask" },
+  { "tessellation-error", "scene.tessellation_error" },
+  { "snapshot", "scene.snapshot" },
+  { "remote-cache", "scene.remote_cache" },
+  { "lazy-arrays", "scene.lazy_arrays" },
+  { "thumbnail-profile", "scene.thumbnail_profile" },
+  { "triangle-budget", "scene.triangle_budget" },
+  { "generate-normals", "scene.normals.generate" },
+  { "normals-feature-angle", "scene.normals.feature_angle" },
+  { "texture-cache", "scene.texture_cache" },
   { "font-file", "ui.font_file" },
   { "point-sprites", "model.point_sprites.enable" },
   { "point-sprites-type", "model.point_sprites.type" },
   { "point-sprites-size", "model.point_sprites.size" },
+  { "point-sprites-sort-budget", "model.point_sprites.sort_budget" },
+  { "point-sprites-instancing", "model.point_sprites.instancing" },
   { "point-size", "render.point_size" },
   { "line-width", "render.line_width" },
   { "backface-type", "render.backface_type" },
@@ -100,6 +136,7 @@ static inline const std::map<std::string_view, std::string_view> LibOptionsNames
   { "normal-scale", "model.normal.scale" },
   { "bg-color", "render.background.color" },
   { "fps", "ui.fps" },
+  { "frame-stats", "ui.frame_stats" },
   { "filename", "ui.filename" },
   { "metadata", "ui.metadata" },
   { "blur-background", "render.background.blur" },
@@ -107,20 +144,38 @@ static inline const std::map<std::string_view, std::string_view> LibOptionsNames
   { "scalar-coloring", "model.scivis.enable" },
   { "coloring-array", "model.scivis.array_name" },
   { "light-intensity", "render.light.intensity" },
+  { "dynamic-resolution", "render.dynamic_resolution.enable" },
+  { "dynamic-resolution-frame-rate", "render.dynamic_resolution.frame_rate" },
+  { "lod", "render.lod.enable" },
+  { "lod-frame-rate", "render.lod.frame_rate" },
+  { "occlusion-culling", "render.occlusion_culling" },
+  { "static-batching", "render.static_batching" },
+  { "compact-vertices", "render.compact_vertices" },
+  { "texture-budget", "render.texture_budget" },
   { "comp", "model.scivis.component" },
   { "cells", "model.scivis.cells" },
   { "range", "model.scivis.range" },
   { "bar", "ui.scalar_bar" },
   { "colormap", "model.scivis.colormap" },
+  { "gpu-coloring", "model.scivis.gpu_coloring" },
   { "volume", "model.volume.enable" },
   { "inverse", "model.volume.inverse" },
+  { "volume-precision", "model.volume.precision" },
+  { "volume-pre-integration", "model.volume.pre_integration" },
   { "camera-orthographic", "scene.camera.orthographic" },
   { "raytracing", "render.raytracing.enable" },
   { "samples", "render.raytracing.samples" },
   { "denoise", "render.raytracing.denoise" },
   { "translucency-support", "render.effect.translucency_support" },
+  { "translucency-technique", "render.effect.translucency_technique" },
+  { "translucency-peels", "render.effect.translucency_peels" },
+  { "translucency-threshold", "render.effect.translucency_threshold" },
   { "ambient-occlusion", "render.effect.ambient_occlusion" },
+  { "ambient-occlusion-downsampling", "render.effect.ambient_occlusion_downsampling" },
+  { "eye-dome-lighting", "render.effect.eye_dome_lighting" },
+  { "progressive-frames", "render.effect.progressive_frames" },
   { "anti-aliasing", "render.effect.anti_aliasing" },
+  { "anti-aliasing-technique", "render.effect.anti_aliasing_technique" },
   { "tone-mapping", "render.effect.tone_mapping" },
   { "final-shader", "render.effect.final_shader" },
 };
@@ -6,6 +6,8 @@
 #include <engine.h>
 #include <log.h>
 
+#include <filesystem>
+
 namespace
 {
 //----------------------------------------------------------------------------
@@ -24,11 +26,27 @@ std::vector<std::string> GetPluginSearchPaths()
   return searchPaths;
 #endif
 }
+
+//----------------------------------------------------------------------------
+std::filesystem::path GetPluginJsonPath(const std::string& plugin)
+{
+#if F3D_MACOS_BUNDLE
+  return {};
+#else
+  // The json files are generated by the plugin SDK next to the application
+  auto jsonPath = F3DSystemTools::GetApplicationPath();
+  jsonPath = jsonPath.parent_path().parent_path();
+  jsonPath /= "share/f3d/plugins";
+  jsonPath /= plugin + ".json";
+  return jsonPath;
+#endif
+}
 };
 
 //----------------------------------------------------------------------------
 void F3DPluginsTools::LoadPlugins(const std::vector<std::string>& plugins)
 {
+  const f3d::log::traceSpan span("F3DPluginsTools::LoadPlugins");
   try
   {
     f3d::engine::autoloadPlugins();
@@ -37,7 +55,17 @@ void F3DPluginsTools::LoadPlugins(const std::vector<std::string>& plugins)
     {
       if (!plugin.empty())
       {
-        f3d::engine::loadPlugin(plugin, ::GetPluginSearchPaths());
+        // Declare the plugin when possible so it is only loaded if needed to read a file
+        const std::filesystem::path jsonPath = ::GetPluginJsonPath(plugin);
+        std::error_code ec;
+        if (!jsonPath.empty() && std::filesystem::is_regular_file(jsonPath, ec))
+        {
+          f3d::engine::declarePlugin(jsonPath.string(), ::GetPluginSearchPaths());
+        }
+        else
+        {
+          f3d::engine::loadPlugin(plugin, ::GetPluginSearchPaths());
+        }
       }
     }
   }
@@ -0,0 +1,765 @@
+#include "F3DRemoteServer.h"
+
+#include "log.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+
+#ifndef _WIN32
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+// see RFC 6455
+constexpr char WEBSOCKET_GUID[] = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+constexpr unsigned char OPCODE_CONTINUATION = 0x0;
+constexpr unsigned char OPCODE_TEXT = 0x1;
+constexpr unsigned char OPCODE_BINARY = 0x2;
+constexpr unsigned char OPCODE_CLOSE = 0x8;
+constexpr unsigned char OPCODE_PING = 0x9;
+constexpr unsigned char OPCODE_PONG = 0xA;
+
+// larger client messages are considered malicious
+constexpr size_t MAX_MESSAGE_SIZE = 1 << 20;
+
+// the time a frame can take to be encoded and sent before the tiles are downscaled
+constexpr std::chrono::milliseconds FRAME_BUDGET(50);
+constexpr int MAX_SCALE = 4;
+
+// the time without change before a downscaled frame is sent again at full resolution
+constexpr std::chrono::milliseconds REFINE_DELAY(250);
+
+// a client not receiving a frame for this long is disconnected
+constexpr int SEND_TIMEOUT = 5000;
+
+constexpr unsigned int TILE_SIZE = 128;
+
+//----------------------------------------------------------------------------
+uint32_t RotateLeft(uint32_t value, int bits)
+{
+  return (value << bits) | (value >> (32 - bits));
+}
+
+//----------------------------------------------------------------------------
+std::array<unsigned char, 20> SHA1(const std::string& message)
+{
+  uint32_t h[5] = { 0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0 };
+
+  std::string data = message;
+  const uint64_t bitLength = static_cast<uint64_t>(message.size()) * 8;
+  data += '\x80';
+  while (data.size() % 64 != 56)
+  {
+    data += '\0';
+  }
+  for (int i = 7; i >= 0; i--)
+  {
+    data += static_cast<char>((bitLength >> (8 * i)) & 0xFF);
+  }
+
+  for (size_t chunk = 0; chunk < data.size(); chunk += 64)
+  {
+    uint32_t w[80];
+    for (int i = 0; i < 16; i++)
+    {
+      const auto byte = [&](int j)
+      { return static_cast<uint32_t>(static_cast<unsigned char>(data[chunk + 4 * i + j])); };
+      w[i] = (byte(0) << 24) | (byte(1) << 16) | (byte(2) << 8) | byte(3);
+    }
+    for (int i = 16; i < 80; i++)
+    {
+      w[i] = ::RotateLeft(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+    }
+
+    uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+    for (int i = 0; i < 80; i++)
+    {
+      uint32_t f, k;
+      if (i < 20)
+      {
+        f = (b & c) | (~b & d);
+        k = 0x5A827999;
+      }
+      else if (i < 40)
+      {
+        f = b ^ c ^ d;
+        k = 0x6ED9EBA1;
+      }
+      else if (i < 60)
+      {
+        f = (b & c) | (b & d) | (c & d);
+        k = 0x8F1BBCDC;
+      }
+      else
+      {
+        f = b ^ c ^ d;
+        k = 0xCA62C1D6;
+      }
+      const uint32_t temp = ::RotateLeft(a, 5) + f + e + k + w[i];
+      e = d;
+      d = c;
+      c = ::RotateLeft(b, 30);
+      b = a;
+      a = temp;
+    }
+    h[0] += a;
+    h[1] += b;
+    h[2] += c;
+    h[3] += d;
+    h[4] += e;
+  }
+
+  std::array<unsigned char, 20> digest;
+  for (int i = 0; i < 20; i++)
+  {
+    digest[i] = static_cast<unsigned char>((h[i / 4] >> (24 - 8 * (i % 4))) & 0xFF);
+  }
+  return digest;
+}
+
+//----------------------------------------------------------------------------
+std::string Base64(const unsigned char* data, size_t size)
+{
+  constexpr char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  std::string encoded;
+  for (size_t i = 0; i < size; i += 3)
+  {
+    uint32_t value = static_cast<uint32_t>(data[i]) << 16;
+    value |= i + 1 < size ? static_cast<uint32_t>(data[i + 1]) << 8 : 0;
+    value |= i + 2 < size ? static_cast<uint32_t>(data[i + 2]) : 0;
+    encoded += alphabet[(value >> 18) & 0x3F];
+    encoded += alphabet[(value >> 12) & 0x3F];
+    encoded += i + 1 < size ? alphabet[(value >> 6) & 0x3F] : '=';
+    encoded += i + 2 < size ? alphabet[value & 0x3F] : '=';
+  }
+  return encoded;
+}
+
+//----------------------------------------------------------------------------
+void AppendLittleEndian(std::string& buffer, uint64_t value, int size)
+{
+  for (int i = 0; i < size; i++)
+  {
+    buffer += static_cast<char>((value >> (8 * i)) & 0xFF);
+  }
+}
+
+//----------------------------------------------------------------------------
+/**
+ * Average the pixels of a RGB frame by blocks of scale x scale pixels
+ */
+std::vector<unsigned char> Downscale(const unsigned char* pixels, unsigned int width,
+  unsigned int height, int scale, unsigned int& scaledWidth, unsigned int& scaledHeight)
+{
+  scaledWidth = (width + scale - 1) / scale;
+  scaledHeight = (height + scale - 1) / scale;
+  std::vector<unsigned char> scaled(static_cast<size_t>(scaledWidth) * scaledHeight * 3);
+  for (unsigned int y = 0; y < scaledHeight; y++)
+  {
+    for (unsigned int x = 0; x < scaledWidth; x++)
+    {
+      unsigned int sum[3] = { 0, 0, 0 };
+      unsigned int count = 0;
+      for (unsigned int j = y * scale; j < std::min((y + 1) * scale, height); j++)
+      {
+        for (unsigned int i = x * scale; i < std::min((x + 1) * scale, width); i++)
+        {
+          const unsigned char* pixel = pixels + (static_cast<size_t>(j) * width + i) * 3;
+          sum[0] += pixel[0];
+          sum[1] += pixel[1];
+          sum[2] += pixel[2];
+          count++;
+        }
+      }
+      unsigned char* pixel = scaled.data() + (static_cast<size_t>(y) * scaledWidth + x) * 3;
+      for (int c = 0; c < 3; c++)
+      {
+        pixel[c] = static_cast<unsigned char>(sum[c] / count);
+      }
+    }
+  }
+  return scaled;
+}
+}
+
+//----------------------------------------------------------------------------
+F3DRemoteServer::~F3DRemoteServer()
+{
+  this->Close();
+}
+
+//----------------------------------------------------------------------------
+bool F3DRemoteServer::Open([[maybe_unused]] int port)
+{
+  this->Close();
+
+#ifdef _WIN32
+  f3d::log::error("Remote server is not supported on Windows");
+  return false;
+#else
+  if (port <= 0 || port > 65535)
+  {
+    f3d::log::error("Invalid remote server port: ", port);
+    return false;
+  }
+
+  this->ListenSocket = socket(AF_INET, SOCK_STREAM, 0);
+  if (this->ListenSocket < 0)
+  {
+    f3d::log::error("Cannot create the remote server socket: ", std::strerror(errno));
+    return false;
+  }
+
+  int reuse = 1;
+  setsockopt(this->ListenSocket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_ANY);
+  address.sin_port = htons(static_cast<uint16_t>(port));
+  if (bind(this->ListenSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+    listen(this->ListenSocket, 1) != 0)
+  {
+    f3d::log::error("Cannot listen on port ", port, ": ", std::strerror(errno));
+    this->Close();
+    return false;
+  }
+  fcntl(this->ListenSocket, F_SETFL, fcntl(this->ListenSocket, F_GETFL) | O_NONBLOCK);
+  return true;
+#endif
+}
+
+//----------------------------------------------------------------------------
+std::vector<std::string> F3DRemoteServer::Poll([[maybe_unused]] int timeout)
+{
+  std::vector<std::string> messages;
+#ifndef _WIN32
+  if (this->ListenSocket < 0)
+  {
+    return messages;
+  }
+
+  pollfd fds[2] = { { this->ListenSocket, POLLIN, 0 }, { this->ClientSocket, POLLIN, 0 } };
+  if (poll(fds, this->ClientSocket >= 0 ? 2 : 1, timeout) <= 0)
+  {
+    return messages;
+  }
+
+  if (fds[0].revents & POLLIN)
+  {
+    this->Accept();
+  }
+  if (this->ClientSocket >= 0 && (fds[1].revents & (POLLIN | POLLHUP | POLLERR)))
+  {
+    if (!this->Receive(messages))
+    {
+      this->Disconnect();
+    }
+  }
+#endif
+  return messages;
+}
+
+//----------------------------------------------------------------------------
+bool F3DRemoteServer::Accept()
+{
+#ifdef _WIN32
+  return false;
+#else
+  int client = accept(this->ListenSocket, nullptr, nullptr);
+  if (client < 0)
+  {
+    return false;
+  }
+  if (this->ClientSocket >= 0)
+  {
+    f3d::log::warn("Remote server only supports one client, a connection was refused");
+    close(client);
+    return false;
+  }
+
+  // tiles are sent as soon as they are encoded
+  int noDelay = 1;
+  setsockopt(client, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+#ifdef SO_NOSIGPIPE
+  int noSigPipe = 1;
+  setsockopt(client, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+#endif
+  fcntl(client, F_SETFL, fcntl(client, F_GETFL) | O_NONBLOCK);
+
+  this->ClientSocket = client;
+  this->HandshakeDone = false;
+  this->Received.clear();
+  this->Fragments.clear();
+  this->PreviousScale = 0;
+  this->Scale = 1;
+  this->FrameInterval = std::chrono::milliseconds(0);
+  return true;
+#endif
+}
+
+//----------------------------------------------------------------------------
+bool F3DRemoteServer::Receive(std::vector<std::string>& messages)
+{
+#ifdef _WIN32
+  return false;
+#else
+  char buffer[4096];
+  while (true)
+  {
+    ssize_t size = recv(this->ClientSocket, buffer, sizeof(buffer), 0);
+    if (size > 0)
+    {
+      this->Received.append(buffer, static_cast<size_t>(size));
+      continue;
+    }
+    if (size < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+    {
+      break;
+    }
+    if (size < 0 && errno == EINTR)
+    {
+      continue;
+    }
+    // closed by the client
+    return false;
+  }
+
+  if (!this->HandshakeDone)
+  {
+    size_t end = this->Received.find("\r\n\r\n");
+    if (end == std::string::npos)
+    {
+      return this->Received.size() < ::MAX_MESSAGE_SIZE;
+    }
+
+    std::string request = this->Received.substr(0, end + 2);
+    this->Received.erase(0, end + 4);
+    std::string lower = request;
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+      [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+    constexpr char keyHeader[] = "\r\nsec-websocket-key:";
+    size_t keyStart = lower.find(keyHeader);
+    const bool metrics = keyStart == std::string::npos &&
+      (lower.rfind("get /metrics ", 0) == 0 || lower.rfind("get /metrics?", 0) == 0);
+    std::string response;
+    if (metrics)
+    {
+      // a plain HTTP request of the metrics, eg. by a Prometheus server, is answered then closed
+      const std::string body = f3d::log::getMetrics();
+      response = "HTTP/1.1 200 OK\r\n"
+                 "Content-Type: text/plain; version=0.0.4\r\n"
+                 "Content-Length: " +
+        std::to_string(body.size()) + "\r\nConnection: close\r\n\r\n" + body;
+    }
+    else if (keyStart == std::string::npos)
+    {
+      f3d::log::warn("Remote server received a request that is not a WebSocket handshake");
+      response = "HTTP/1.1 400 Bad Request\r\nContent-Length: 0\r\n\r\n";
+      send(this->ClientSocket, response.data(), response.size(), 0);
+      return false;
+    }
+    else
+    {
+      keyStart += std::strlen(keyHeader);
+      size_t keyEnd = request.find("\r\n", keyStart);
+      std::string key = request.substr(keyStart, keyEnd - keyStart);
+      key.erase(0, key.find_first_not_of(" \t"));
+      key.erase(key.find_last_not_of(" \t") + 1);
+
+      const std::array<unsigned char, 20> digest = ::SHA1(key + ::WEBSOCKET_GUID);
+      response = "HTTP/1.1 101 Switching Protocols\r\n"
+                 "Upgrade: websocket\r\n"
+                 "Connection: Upgrade\r\n"
+                 "Sec-WebSocket-Accept: " +
+        ::Base64(digest.data(), digest.size()) + "\r\n\r\n";
+    }
+
+    size_t sent = 0;
+    while (sent < response.size())
+    {
+      pollfd fd = { this->ClientSocket, POLLOUT, 0 };
+      if (poll(&fd, 1, ::SEND_TIMEOUT) <= 0)
+      {
+        return false;
+      }
+      ssize_t size = send(this->ClientSocket, response.data() + sent, response.size() - sent, 0);
+      if (size < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+      {
+        return false;
+      }
+      sent += size > 0 ? static_cast<size_t>(size) : 0;
+    }
+    if (metrics)
+    {
+      return false;
+    }
+
+    this->HandshakeDone = true;
+    f3d::log::info("Remote client connected");
+  }
+
+  return this->ParseFrames(messages);
+#endif
+}
+
+//----------------------------------------------------------------------------
+bool F3DRemoteServer::ParseFrames(std::vector<std::string>& messages)
+{
+  while (this->Received.size() >= 2)
+  {
+    const unsigned char* data = reinterpret_cast<const unsigned char*>(this->Received.data());
+    const bool final = (data[0] & 0x80) != 0;
+    const unsigned char opcode = data[0] & 0x0F;
+    const bool masked = (data[1] & 0x80) != 0;
+    uint64_t length = data[1] & 0x7F;
+
+    // all the client frames must be masked
+    if (!masked)
+    {
+      f3d::log::warn("Remote server received an unmasked frame, disconnecting");
+      return false;
+    }
+
+    size_t headerSize = 2;
+    if (length == 126)
+    {
+      headerSize += 2;
+    }
+    else if (length == 127)
+    {
+      headerSize += 8;
+    }
+    if (this->Received.size() < headerSize + 4)
+    {
+      return true;
+    }
+    if (length >= 126)
+    {
+      uint64_t extended = 0;
+      for (size_t i = 2; i < headerSize; i++)
+      {
+        extended = (extended << 8) | data[i];
+      }
+      length = extended;
+    }
+    if (length + this->Fragments.size() > ::MAX_MESSAGE_SIZE)
+    {
+      f3d::log::warn("Remote server received a message too large, disconnecting");
+      return false;
+    }
+    if (this->Received.size() < headerSize + 4 + length)
+    {
+      return true;
+    }
+
+    const unsigned char* mask = data + headerSize;
+    std::string payload(this->Received, headerSize + 4, static_cast<size_t>(length));
+    for (size_t i = 0; i < payload.size(); i++)
+    {
+      payload[i] = static_cast<char>(payload[i] ^ mask[i % 4]);
+    }
+    this->Received.erase(0, headerSize + 4 + static_cast<size_t>(length));
+
+    switch (opcode)
+    {
+      case ::OPCODE_CONTINUATION:
+      case ::OPCODE_TEXT:
+      case ::OPCODE_BINARY:
+        this->Fragments += payload;
+        if (final)
+        {
+          messages.emplace_back(std::move(this->Fragments));
+          this->Fragments.clear();
+        }
+        break;
+      case ::OPCODE_PING:
+        if (!this->SendMessage(::OPCODE_PONG, payload))
+        {
+          return false;
+        }
+        break;
+      case ::OPCODE_CLOSE:
+        this->SendMessage(::OPCODE_CLOSE, "");
+        return false;
+      default:
+        break;
+    }
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool F3DRemoteServer::SendMessage(
+  [[maybe_unused]] unsigned char opcode, [[maybe_unused]] const std::string& payload)
+{
+#ifdef _WIN32
+  return false;
+#else
+  std::string header;
+  header += static_cast<char>(0x80 | opcode);
+  if (payload.size() < 126)
+  {
+    header += static_cast<char>(payload.size());
+  }
+  else if (payload.size() <= 0xFFFF)
+  {
+    header += static_cast<char>(126);
+    header += static_cast<char>((payload.size() >> 8) & 0xFF);
+    header += static_cast<char>(payload.size() & 0xFF);
+  }
+  else
+  {
+    header += static_cast<char>(127);
+    for (int i = 7; i >= 0; i--)
+    {
+      header += static_cast<char>((static_cast<uint64_t>(payload.size()) >> (8 * i)) & 0xFF);
+    }
+  }
+
+#ifdef MSG_NOSIGNAL
+  constexpr int flags = MSG_NOSIGNAL;
+#else
+  constexpr int flags = 0;
+#endif
+
+  for (const std::string* buffer : { static_cast<const std::string*>(&header), &payload })
+  {
+    size_t sent = 0;
+    while (sent < buffer->size())
+    {
+      ssize_t size = send(this->ClientSocket, buffer->data() + sent, buffer->size() - sent, flags);
+      if (size > 0)
+      {
+        sent += static_cast<size_t>(size);
+        continue;
+      }
+      if (size < 0 && errno == EINTR)
+      {
+        continue;
+      }
+      if (size < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+      {
+        // the client does not read fast enough, wait for it
+        pollfd fd = { this->ClientSocket, POLLOUT, 0 };
+        if (poll(&fd, 1, ::SEND_TIMEOUT) > 0)
+        {
+          continue;
+        }
+      }
+      return false;
+    }
+  }
+  return true;
+#endif
+}
+
+//----------------------------------------------------------------------------
+bool F3DRemoteServer::IsConnected() const
+{
+  return this->ClientSocket >= 0 && this->HandshakeDone;
+}
+
+//----------------------------------------------------------------------------
+bool F3DRemoteServer::IsFrameDue(bool changed) const
+{
+  if (!this->IsConnected())
+  {
+    return false;
+  }
+
+  const auto now = std::chrono::steady_clock::now();
+  if (!changed)
+  {
+    // nothing to send once a full resolution frame was sent
+    if (this->PreviousScale == 1)
+    {
+      return false;
+    }
+
+    // wait for the interaction to end before refining a downscaled frame
+    if (this->PreviousScale > 1 && now - this->LastChange < ::REFINE_DELAY)
+    {
+      return false;
+    }
+  }
+  return now - this->LastFrame >= this->FrameInterval;
+}
+
+//----------------------------------------------------------------------------
+void F3DRemoteServer::SendFrame(const f3d::image& frame, bool changed)
+{
+  if (!this->IsConnected() || frame.getChannelCount() != 3 ||
+    frame.getChannelType() != f3d::image::ChannelType::BYTE)
+  {
+    return;
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  if (changed)
+  {
+    this->LastChange = start;
+  }
+
+  const unsigned int width = frame.getWidth();
+  const unsigned int height = frame.getHeight();
+  const int scale = changed ? this->Scale : 1;
+
+  unsigned int scaledWidth = width;
+  unsigned int scaledHeight = height;
+  std::vector<unsigned char> pixels;
+  if (scale > 1)
+  {
+    pixels = ::Downscale(static_cast<const unsigned char*>(frame.getContent()), width, height,
+      scale, scaledWidth, scaledHeight);
+  }
+  else
+  {
+    const unsigned char* content = static_cast<const unsigned char*>(frame.getContent());
+    pixels.assign(content, content + static_cast<size_t>(width) * height * 3);
+  }
+
+  // all the tiles are sent when the client has no frame at this scale and size
+  const bool full = scale != this->PreviousScale || this->PreviousSize[0] != width ||
+    this->PreviousSize[1] != height;
+
+  std::string message;
+  ::AppendLittleEndian(message, this->FrameId + 1, 4);
+  ::AppendLittleEndian(message, width, 2);
+  ::AppendLittleEndian(message, height, 2);
+  ::AppendLittleEndian(message, scale, 1);
+  ::AppendLittleEndian(message, 0, 1);
+  const size_t tileCountOffset = message.size();
+  ::AppendLittleEndian(message, 0, 2);
+
+  // the pixels start from the bottom row, the tiles are positioned from the top
+  const size_t rowSize = static_cast<size_t>(scaledWidth) * 3;
+  uint16_t tileCount = 0;
+  std::vector<unsigned char> tile;
+  for (unsigned int y = 0; y < scaledHeight; y += ::TILE_SIZE)
+  {
+    const unsigned int tileHeight = std::min(::TILE_SIZE, scaledHeight - y);
+    for (unsigned int x = 0; x < scaledWidth; x += ::TILE_SIZE)
+    {
+      const unsigned int tileWidth = std::min(::TILE_SIZE, scaledWidth - x);
+      const size_t tileRowSize = static_cast<size_t>(tileWidth) * 3;
+
+      bool tileChanged = full;
+      for (unsigned int j = y; j < y + tileHeight && !tileChanged; j++)
+      {
+        const size_t offset = j * rowSize + x * 3;
+        tileChanged = std::memcmp(&pixels[offset], &this->Previous[offset], tileRowSize) != 0;
+      }
+      if (!tileChanged)
+      {
+        continue;
+      }
+
+      tile.resize(tileRowSize * tileHeight);
+      for (unsigned int j = 0; j < tileHeight; j++)
+      {
+        std::memcpy(&tile[j * tileRowSize], &pixels[(y + j) * rowSize + x * 3], tileRowSize);
+      }
+      const f3d::image tileImage(
+        tileWidth, tileHeight, 3, f3d::image::ChannelType::BYTE, tile.data());
+      const std::vector<unsigned char> jpeg = tileImage.saveBuffer(f3d::image::SaveFormat::JPG);
+
+      ::AppendLittleEndian(message, x, 2);
+      ::AppendLittleEndian(message, scaledHeight - y - tileHeight, 2);
+      ::AppendLittleEndian(message, tileWidth, 2);
+      ::AppendLittleEndian(message, tileHeight, 2);
+      ::AppendLittleEndian(message, jpeg.size(), 4);
+      message.append(jpeg.begin(), jpeg.end());
+      tileCount++;
+    }
+  }
+
+  this->Previous = std::move(pixels);
+  this->PreviousSize[0] = width;
+  this->PreviousSize[1] = height;
+  this->PreviousScale = scale;
+  this->LastFrame = start;
+
+  if (tileCount == 0)
+  {
+    return;
+  }
+
+  message[tileCountOffset] = static_cast<char>(tileCount & 0xFF);
+  message[tileCountOffset + 1] = static_cast<char>(tileCount >> 8);
+  this->FrameId++;
+  if (!this->SendMessage(::OPCODE_BINARY, message))
+  {
+    f3d::log::warn("Remote client does not receive the frames, disconnecting");
+    this->Disconnect();
+    return;
+  }
+
+  // the next frame is not sent before the client could receive this one, and the tiles of the
+  // interactive frames are downscaled when they are too slow to encode and send
+  const auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+    std::chrono::steady_clock::now() - start);
+  this->FrameInterval = duration;
+  if (changed)
+  {
+    if (duration > ::FRAME_BUDGET && this->Scale < ::MAX_SCALE)
+    {
+      this->Scale *= 2;
+    }
+    else if (duration < ::FRAME_BUDGET / 4 && this->Scale > 1)
+    {
+      this->Scale /= 2;
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+void F3DRemoteServer::RequestFullFrame()
+{
+  this->PreviousScale = 0;
+}
+
+//----------------------------------------------------------------------------
+void F3DRemoteServer::Disconnect()
+{
+#ifndef _WIN32
+  if (this->ClientSocket >= 0)
+  {
+    close(this->ClientSocket);
+    if (this->HandshakeDone)
+    {
+      f3d::log::info("Remote client disconnected");
+    }
+  }
+#endif
+  this->ClientSocket = -1;
+  this->HandshakeDone = false;
+  this->Received.clear();
+  this->Fragments.clear();
+  this->Previous.clear();
+  this->PreviousScale = 0;
+}
+
+//----------------------------------------------------------------------------
+void F3DRemoteServer::Close()
+{
+  this->Disconnect();
+#ifndef _WIN32
+  if (this->ListenSocket >= 0)
+  {
+    close(this->ListenSocket);
+  }
+#endif
+  this->ListenSocket = -1;
+}
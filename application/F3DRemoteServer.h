@@ -0,0 +1,112 @@
+/**
+ * @class   F3DRemoteServer
+ * @brief   A WebSocket server streaming the rendered frames to a remote client
+ *
+ * A single client connects with a WebSocket on the listened port and sends text messages,
+ * that are returned by `Poll` for the starter to apply. Frames are sent as binary messages
+ * containing only the tiles that changed since the previous frame, each one encoded in JPEG.
+ *
+ * Each frame message starts with a 12 bytes header, all the values being little endian:
+ * - uint32 frame id, starting at 1
+ * - uint16 width and uint16 height of the rendered frame
+ * - uint8 scale, the tiles are downscaled by this factor
+ * - uint8 reserved
+ * - uint16 tile count
+ *
+ * followed by each tile: uint16 x, y, width and height in downscaled pixels, from the top left
+ * corner of the frame, then uint32 size and the JPEG data.
+ *
+ * Bandwidth is adapted to the client: frames are not sent more often than the time needed to
+ * encode and send the previous one, and the scale increases while the frames are slower than
+ * the frame budget. Once nothing changes, the frame is sent again at full resolution.
+ * A plain HTTP `GET /metrics` request is answered with the libf3d metrics in the Prometheus text
+ * format then closed, so that the server can be scraped while no client is connected.
+ * Only available on POSIX systems.
+ */
+
+#ifndef F3DRemoteServer_h
+#define F3DRemoteServer_h
+
+#include "image.h"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class F3DRemoteServer
+{
+public:
+  F3DRemoteServer() = default;
+  ~F3DRemoteServer();
+
+  F3DRemoteServer(const F3DRemoteServer&) = delete;
+  F3DRemoteServer& operator=(const F3DRemoteServer&) = delete;
+
+  /**
+   * Listen for a client on the provided TCP port, on all interfaces.
+   * Return false if the port cannot be listened.
+   */
+  bool Open(int port);
+
+  /**
+   * Wait at most timeout milliseconds for a client or its messages, accept the client and
+   * answer the WebSocket handshake, then return the text messages received, in order.
+   * Another client can connect once the current one disconnects.
+   */
+  std::vector<std::string> Poll(int timeout);
+
+  /**
+   * Return true if a client completed the handshake.
+   */
+  bool IsConnected() const;
+
+  /**
+   * Return true if a frame should be rendered and sent, because the scene changed, the client
+   * needs a full frame or the last frame was downscaled, and enough time passed since the
+   * previous one.
+   */
+  bool IsFrameDue(bool changed) const;
+
+  /**
+   * Encode the tiles of the frame that changed since the previous one and send them.
+   * The frame must have 3 byte channels. The client is disconnected if it cannot receive it.
+   */
+  void SendFrame(const f3d::image& frame, bool changed);
+
+  /**
+   * Send all the tiles of the next frame, at full resolution if nothing changes.
+   */
+  void RequestFullFrame();
+
+  /**
+   * Disconnect the client and stop listening.
+   */
+  void Close();
+
+private:
+  bool Accept();
+  bool Receive(std::vector<std::string>& messages);
+  bool ParseFrames(std::vector<std::string>& messages);
+  bool SendMessage(unsigned char opcode, const std::string& payload);
+  void Disconnect();
+
+  int ListenSocket = -1;
+  int ClientSocket = -1;
+  bool HandshakeDone = false;
+  std::string Received;
+  std::string Fragments;
+
+  // the last frame sent, at its scale, to find the changed tiles
+  std::vector<unsigned char> Previous;
+  unsigned int PreviousSize[2] = { 0, 0 };
+  int Scale = 1;
+  int PreviousScale = 0;
+  uint32_t FrameId = 0;
+
+  std::chrono::steady_clock::time_point LastFrame;
+  std::chrono::steady_clock::time_point LastChange;
+  std::chrono::milliseconds FrameInterval{ 0 };
+};
+
+#endif
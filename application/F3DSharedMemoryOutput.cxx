@@ -0,0 +1,189 @@
+#include "F3DSharedMemoryOutput.h"
+
+#include "log.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <new>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+constexpr char SHM_PREFIX[] = "shm://";
+constexpr uint32_t SHM_VERSION = 1;
+
+// size of the header, the slots start after it
+constexpr uint32_t SHM_HEADER_SIZE = 64;
+
+static_assert(sizeof(F3DSharedMemoryOutput::Header) <= SHM_HEADER_SIZE);
+static_assert(sizeof(F3DSharedMemoryOutput::Slot) == 64);
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+  "Lock free atomics are required to share them between processes");
+}
+
+//----------------------------------------------------------------------------
+F3DSharedMemoryOutput::~F3DSharedMemoryOutput()
+{
+  this->Close();
+}
+
+//----------------------------------------------------------------------------
+bool F3DSharedMemoryOutput::IsSharedMemoryOutput(const std::string& output)
+{
+  return output.rfind(::SHM_PREFIX, 0) == 0;
+}
+
+//----------------------------------------------------------------------------
+bool F3DSharedMemoryOutput::Open(const std::string& output, unsigned int slotCount)
+{
+  this->Close();
+
+  std::string name = output.substr(std::strlen(::SHM_PREFIX));
+  if (name.empty() || name.find('/') != std::string::npos)
+  {
+    f3d::log::error("Invalid shared memory output ", output, ", expected shm://<name>");
+    return false;
+  }
+
+#ifdef _WIN32
+  f3d::log::error("Shared memory output is not supported on Windows");
+  return false;
+#else
+  this->Name = "/" + name;
+  this->SlotCount = std::max(slotCount, 1u);
+  this->FrameId = 0;
+  this->FileDescriptor = shm_open(this->Name.c_str(), O_CREAT | O_RDWR, 0600);
+  if (this->FileDescriptor < 0)
+  {
+    f3d::log::error(
+      "Cannot create the shared memory object ", this->Name, ": ", std::strerror(errno));
+    return false;
+  }
+  return true;
+#endif
+}
+
+//----------------------------------------------------------------------------
+bool F3DSharedMemoryOutput::Map([[maybe_unused]] uint64_t slotSize)
+{
+#ifdef _WIN32
+  return false;
+#else
+  if (this->Memory)
+  {
+    munmap(this->Memory, this->MemorySize);
+    this->Memory = nullptr;
+  }
+
+  this->MemorySize = ::SHM_HEADER_SIZE + this->SlotCount * (sizeof(Slot) + slotSize);
+  if (ftruncate(this->FileDescriptor, static_cast<off_t>(this->MemorySize)) != 0)
+  {
+    f3d::log::error(
+      "Cannot resize the shared memory object ", this->Name, ": ", std::strerror(errno));
+    return false;
+  }
+
+  void* memory =
+    mmap(nullptr, this->MemorySize, PROT_READ | PROT_WRITE, MAP_SHARED, this->FileDescriptor, 0);
+  if (memory == MAP_FAILED)
+  {
+    f3d::log::error("Cannot map the shared memory object ", this->Name, ": ", std::strerror(errno));
+    return false;
+  }
+  this->Memory = memory;
+  this->SlotSize = slotSize;
+
+  // the slots are reset with the header, readers detect it with the new slot size
+  std::memset(this->Memory, 0, this->MemorySize);
+  Header* header = new (this->Memory) Header;
+  std::memcpy(header->Magic, "F3DS", 4);
+  header->Version = ::SHM_VERSION;
+  header->SlotCount = this->SlotCount;
+  header->HeaderSize = ::SHM_HEADER_SIZE;
+  header->LastFrameId.store(0, std::memory_order_relaxed);
+  for (uint32_t i = 0; i < this->SlotCount; i++)
+  {
+    new (static_cast<char*>(this->Memory) + ::SHM_HEADER_SIZE + i * (sizeof(Slot) + slotSize)) Slot;
+  }
+  std::atomic_thread_fence(std::memory_order_release);
+  header->SlotSize = slotSize;
+  return true;
+#endif
+}
+
+//----------------------------------------------------------------------------
+bool F3DSharedMemoryOutput::Write(const f3d::image& frame)
+{
+  if (this->FileDescriptor < 0)
+  {
+    return false;
+  }
+
+  const uint64_t size = static_cast<uint64_t>(frame.getWidth()) * frame.getHeight() *
+    frame.getChannelCount() * frame.getChannelTypeSize();
+  // the slots size is a multiple of the header size, to keep them aligned
+  const uint64_t slotSize = (size + ::SHM_HEADER_SIZE - 1) / ::SHM_HEADER_SIZE * ::SHM_HEADER_SIZE;
+  if ((!this->Memory || size > this->SlotSize) && !this->Map(slotSize))
+  {
+    return false;
+  }
+
+  // seqlock: the sequence is odd while the slot is written
+  this->FrameId++;
+  Slot* slot = reinterpret_cast<Slot*>(static_cast<char*>(this->Memory) + ::SHM_HEADER_SIZE +
+    ((this->FrameId - 1) % this->SlotCount) * (sizeof(Slot) + this->SlotSize));
+  const uint64_t sequence = slot->Sequence.load(std::memory_order_relaxed);
+  slot->Sequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  slot->FrameId = this->FrameId;
+  slot->Width = frame.getWidth();
+  slot->Height = frame.getHeight();
+  slot->ChannelCount = frame.getChannelCount();
+  slot->ChannelType = static_cast<uint32_t>(frame.getChannelType());
+  slot->Size = size;
+  std::memcpy(static_cast<void*>(slot + 1), frame.getContent(), size);
+
+  slot->Sequence.store(sequence + 2, std::memory_order_release);
+  static_cast<Header*>(this->Memory)->LastFrameId.store(this->FrameId, std::memory_order_release);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void F3DSharedMemoryOutput::Close()
+{
+#ifndef _WIN32
+  if (this->Memory)
+  {
+    munmap(this->Memory, this->MemorySize);
+  }
+  if (this->FileDescriptor >= 0)
+  {
+    close(this->FileDescriptor);
+  }
+#endif
+  this->Memory = nullptr;
+  this->MemorySize = 0;
+  this->FileDescriptor = -1;
+}
+
+//----------------------------------------------------------------------------
+bool F3DSharedMemoryOutput::Unlink([[maybe_unused]] const std::string& output)
+{
+#ifdef _WIN32
+  return false;
+#else
+  if (!F3DSharedMemoryOutput::IsSharedMemoryOutput(output))
+  {
+    return false;
+  }
+  const std::string name = "/" + output.substr(std::strlen(::SHM_PREFIX));
+  return shm_unlink(name.c_str()) == 0;
+#endif
+}
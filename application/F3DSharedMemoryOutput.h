@@ -0,0 +1,109 @@
+/**
+ * @class   F3DSharedMemoryOutput
+ * @brief   A frame sink writing the rendered frames into a POSIX shared memory ring
+ *
+ * The frames are copied as raw pixels, without encoding, into a shared memory object that another
+ * process can map to read them. The object starts with a header followed by a ring of slots,
+ * each one holding a frame, see `Header` and `Slot` for the layout. Each slot is protected by a
+ * sequence number which is odd while the frame is written, so a reader copies a frame, then
+ * checks that the sequence number did not change. The object is not removed when closed, so
+ * that the last frames can still be read after the process exits, the consumer is expected to
+ * remove it with `Unlink` or `shm_unlink`, otherwise it stays in memory until the next reboot.
+ * Only available on POSIX systems.
+ */
+
+#ifndef F3DSharedMemoryOutput_h
+#define F3DSharedMemoryOutput_h
+
+#include "image.h"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+class F3DSharedMemoryOutput
+{
+public:
+  /**
+   * Layout of the beginning of the shared memory object, all the values are in native endianness.
+   * SlotSize is the number of bytes of the pixels of each slot, it increases when a larger frame
+   * is written and the object is resized, readers must map it again when it changes.
+   * LastFrameId is the id of the last frame written, 0 before the first one.
+   */
+  struct Header
+  {
+    char Magic[4];
+    uint32_t Version;
+    uint32_t SlotCount;
+    uint32_t HeaderSize;
+    uint64_t SlotSize;
+    std::atomic<uint64_t> LastFrameId;
+  };
+
+  /**
+   * Layout of each slot, followed by its pixels, starting from the bottom row.
+   * Frame `n` is written in the slot `(n - 1) % SlotCount`, the first slot starting
+   * after HeaderSize bytes and each one taking `sizeof(Slot) + SlotSize` bytes.
+   * ChannelType is 0 for bytes, 1 for 16-bit integers, 2 for 32-bit floats and 3 for 16-bit
+   * floats.
+   */
+  struct Slot
+  {
+    std::atomic<uint64_t> Sequence;
+    uint64_t FrameId;
+    uint32_t Width;
+    uint32_t Height;
+    uint32_t ChannelCount;
+    uint32_t ChannelType;
+    uint64_t Size;
+    uint64_t Padding[3];
+  };
+
+  F3DSharedMemoryOutput() = default;
+  ~F3DSharedMemoryOutput();
+
+  F3DSharedMemoryOutput(const F3DSharedMemoryOutput&) = delete;
+  F3DSharedMemoryOutput& operator=(const F3DSharedMemoryOutput&) = delete;
+
+  /**
+   * Return true if the output is a shared memory name, eg: `shm://f3d`.
+   */
+  static bool IsSharedMemoryOutput(const std::string& output);
+
+  /**
+   * Create the shared memory object named after the output, eg: `shm://f3d` creates `/f3d`,
+   * with a ring of slotCount frames. The size of the slots is set by the first frame.
+   * Return false if the object cannot be created.
+   */
+  bool Open(const std::string& output, unsigned int slotCount = 3);
+
+  /**
+   * Copy a frame in the next slot of the ring and publish it as the last frame.
+   * Return false if the frame could not be written.
+   */
+  bool Write(const f3d::image& frame);
+
+  /**
+   * Unmap the shared memory object, without removing it.
+   */
+  void Close();
+
+  /**
+   * Remove the shared memory object named after the output, once its frames have been read.
+   * Return false if it does not exist or cannot be removed.
+   */
+  static bool Unlink(const std::string& output);
+
+private:
+  bool Map(uint64_t slotSize);
+
+  std::string Name;
+  int FileDescriptor = -1;
+  void* Memory = nullptr;
+  size_t MemorySize = 0;
+  uint32_t SlotCount = 0;
+  uint64_t SlotSize = 0;
+  uint64_t FrameId = 0;
+};
+
+#endif
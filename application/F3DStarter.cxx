@@ -7,7 +7,10 @@
 #include "F3DNSDelegate.h"
 #include "F3DOptionsTools.h"
 #include "F3DPluginsTools.h"
+#include "F3DRemoteServer.h"
+#include "F3DSharedMemoryOutput.h"
 #include "F3DSystemTools.h"
+#include "F3DVideoEncoder.h"
 
 #define DMON_IMPL
 #ifdef WIN32
@@ -30,17 +33,31 @@
 #include "interactor.h"
 #include "log.h"
 #include "options.h"
+#include "scene.h"
 #include "window.h"
 
+#include "nlohmann/json.hpp"
+
 #include <algorithm>
 #include <atomic>
 #include <cassert>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
 #include <filesystem>
+#include <fstream>
+#include <future>
 #include <iomanip>
 #include <iostream>
+#include <map>
+#include <memory>
 #include <mutex>
 #include <regex>
 #include <set>
+#include <thread>
+#include <utility>
 
 namespace fs = std::filesystem;
 
@@ -49,6 +66,62 @@ class F3DStarter::F3DInternals
 public:
   F3DInternals() = default;
 
+  /**
+   * Stop the trace, if any, and write it when destroyed
+   */
+  struct TraceWriter
+  {
+    std::string FileName;
+    ~TraceWriter()
+    {
+      if (!this->FileName.empty() && !f3d::log::stopTrace())
+      {
+        f3d::log::error("Could not write the trace to ", this->FileName);
+      }
+    }
+  };
+
+  /**
+   * Write the metrics in JSON in the file, if any, replacing the previous ones,
+   * when calling Write and when destroyed
+   */
+  struct MetricsWriter
+  {
+    std::string FileName;
+    void Write() const
+    {
+      if (this->FileName.empty())
+      {
+        return;
+      }
+
+      // written next to the file then renamed, so that the file is never read partially written
+      const fs::path path(this->FileName);
+      fs::path tmpPath = path;
+      tmpPath += ".tmp";
+      bool written = false;
+      {
+        std::ofstream file(tmpPath);
+        file << f3d::log::getMetrics(f3d::log::MetricsFormat::JSON) << "\n";
+        written = file.good();
+      }
+      std::error_code ec;
+      if (written)
+      {
+        fs::rename(tmpPath, path, ec);
+      }
+      if (!written || ec)
+      {
+        f3d::log::error("Could not write the metrics to ", this->FileName);
+      }
+    }
+    ~MetricsWriter()
+    {
+      this->Write();
+    }
+  };
+  MetricsWriter Metrics;
+
   // XXX: The values in the following two structs
   // are left uninitialized as the will all be initialized from
   // F3DOptionsTools::DefaultAppOptions
@@ -68,10 +141,20 @@ public:
   {
     std::string Output;
     bool NoBackground;
+    int OutputScale;
+    std::vector<int> OutputBand;
+    std::string Batch;
+    bool AnimationFrames;
+    std::string VideoCodec;
     bool NoRender;
     std::string RenderingBackend;
+    int RenderingDevice;
+    bool ShaderCache;
     double MaxSize;
     bool Watch;
+    std::string CommandInput;
+    int RemoteServer;
+    int Preload;
     std::vector<std::string> Plugins;
     std::string ScreenshotFilename;
     std::string VerboseLevel;
@@ -164,6 +247,17 @@ public:
     return false;
   }
 
+  static bool HasGLBExtension(const std::string& file)
+  {
+    std::string ext = fs::path(file).extension().string();
+    for (char& c : ext)
+    {
+      // casting is required on Windows
+      c = static_cast<char>(toupper(c));
+    }
+    return ext == ".GLB";
+  }
+
   static void SetVerboseLevel(const std::string& level, bool forceStdErr)
   {
     // A switch/case over verbose level
@@ -195,22 +289,200 @@ public:
 
     if (forceStdErr)
     {
-      f3d::log::info("Output image will be saved to stdout, all log types including debug and info "
+      f3d::log::info("Output will be streamed to stdout, all log types including debug and info "
                      "levels are redirected to stderr");
     }
   }
 
-  static void dmonFolderChanged(
-    dmon_watch_id, dmon_action, const char*, const char* filename, const char*, void* userData)
+  /**
+   * Let the OpenGL drivers store the compiled shaders in the user cache directory,
+   * keeping the variables set by the user. Drivers read them when creating their first context.
+   */
+  static void SetShaderDiskCache()
+  {
+    fs::path cacheDir = F3DSystemTools::GetUserCacheDirectory();
+    std::error_code ec;
+    if (cacheDir.empty() || (!fs::create_directories(cacheDir / "shaders", ec) && ec))
+    {
+      f3d::log::warn("Cannot create the shader cache directory in ", cacheDir.string());
+      return;
+    }
+
+    // Mesa, then NVIDIA
+    const std::string directory = (cacheDir / "shaders").string();
+    for (const auto& [name, value] :
+      std::initializer_list<std::pair<const char*, std::string>>{
+        { "MESA_SHADER_CACHE_DIR", directory }, { "__GL_SHADER_DISK_CACHE_PATH", directory },
+        { "__GL_SHADER_DISK_CACHE", "1" } })
+    {
+      if (!std::getenv(name))
+      {
+#ifdef _WIN32
+        _putenv_s(name, value.c_str());
+#else
+        setenv(name, value.c_str(), 0);
+#endif
+      }
+    }
+  }
+
+  static void dmonFolderChanged(dmon_watch_id, dmon_action action, const char*,
+    const char* filename, const char*, void* userData)
   {
-    F3DStarter* self = reinterpret_cast<F3DStarter*>(userData);
+    // A busy folder mostly reports the changes of other files, they are discarded by the watcher
+    // thread without locking, and a removed file cannot be reloaded
+    const FolderWatch* watch = static_cast<const FolderWatch*>(userData);
+    if (action == DMON_ACTION_DELETE)
+    {
+      return;
+    }
+    auto it = watch->Files.find(fs::path(filename));
+    if (it == watch->Files.end())
+    {
+      return;
+    }
+
+    // Reloaded by the main thread once the changes have settled
+    F3DStarter* self = watch->Starter;
     const std::lock_guard<std::mutex> lock(self->Internals->LoadedFilesMutex);
-    if (std::find_if(self->Internals->LoadedFiles.begin(), self->Internals->LoadedFiles.end(),
-          [&](const auto& path)
-          { return path.filename() == filename; }) != self->Internals->LoadedFiles.end())
+    self->Internals->ChangedFiles.insert(it->second);
+    self->Internals->LastFileChange = std::chrono::steady_clock::now();
+  }
+
+  /**
+   * Add the files of a folder and its sub folders to the scan, in the same order than
+   * F3DStarter::AddFile, so the groups do not depend on the scan being done in the background
+   */
+  static void ScanFolder(const fs::path& path, FolderScan& scan)
+  {
+    std::set<fs::path> sortedPaths;
+    std::error_code ec;
+    for (const auto& entry : fs::directory_iterator(path, ec))
+    {
+      if (scan.Abort)
+      {
+        return;
+      }
+      sortedPaths.insert(entry.path());
+    }
+    for (const auto& entryPath : sortedPaths)
+    {
+      if (scan.Abort)
+      {
+        return;
+      }
+      if (fs::is_directory(entryPath, ec))
+      {
+        F3DInternals::ScanFolder(entryPath, scan);
+      }
+      else
+      {
+        const std::lock_guard<std::mutex> lock(scan.Mutex);
+        scan.Files.emplace_back(entryPath);
+        scan.Found.notify_one();
+      }
+    }
+  }
+
+  /**
+   * Read the commands of the command input, one per line, in a detached thread so that a fifo
+   * without writer does not block the event loop. A fifo is reopened once its writer closes it
+   * so that controllers can connect one after the other.
+   * Returns false if the command input file does not exist.
+   */
+  bool StartCommandInput()
+  {
+    const std::string input = this->AppOptions.CommandInput;
+    if (input != "-" && !fs::exists(fs::path(input)))
+    {
+      f3d::log::error("Command input does not exist: ", input);
+      return false;
+    }
+
+    auto pending = std::make_shared<PendingCommands>();
+    this->CommandInputCommands = pending;
+    std::thread(
+      [pending, input]()
+      {
+        do
+        {
+          std::ifstream file;
+          std::istream* stream = &std::cin;
+          if (input != "-")
+          {
+            file.open(fs::path(input));
+            if (!file.is_open())
+            {
+              return;
+            }
+            stream = &file;
+          }
+
+          std::string line;
+          while (std::getline(*stream, line))
+          {
+            if (!line.empty() && line.back() == '\r')
+            {
+              line.pop_back();
+            }
+            if (!line.empty() && line[0] != '#')
+            {
+              const std::lock_guard<std::mutex> lock(pending->Mutex);
+              pending->Commands.emplace_back(std::move(line));
+            }
+          }
+        } while (input != "-" && fs::is_fifo(fs::path(input)));
+      })
+      .detach();
+    return true;
+  }
+
+  /**
+   * Return the commands read since the previous call, in order
+   */
+  std::vector<std::string> TakePendingCommands()
+  {
+    const std::lock_guard<std::mutex> lock(this->CommandInputCommands->Mutex);
+    return std::exchange(this->CommandInputCommands->Commands, {});
+  }
+
+  /**
+   * Return the loaded files that changed if no change happened during the settle time,
+   * so that files written in several steps are only reloaded once
+   */
+  std::vector<fs::path> GetSettledChangedFiles()
+  {
+    // Enough for most tools to finish writing a file
+    constexpr std::chrono::milliseconds settleTime(300);
+
+    const std::lock_guard<std::mutex> lock(this->LoadedFilesMutex);
+    std::vector<fs::path> changedFiles;
+    if (!this->ChangedFiles.empty() &&
+      std::chrono::steady_clock::now() - this->LastFileChange >= settleTime)
+    {
+      changedFiles.assign(this->ChangedFiles.begin(), this->ChangedFiles.end());
+      this->ChangedFiles.clear();
+    }
+    return changedFiles;
+  }
+
+  /**
+   * Render the output image, in tiles with --output-scale, or only its band with --output-band
+   */
+  f3d::image RenderOutputImage(f3d::window& window) const
+  {
+    const std::vector<int>& band = this->AppOptions.OutputBand;
+    if (band.size() == 2 && band[0] >= 0 && band[0] < band[1])
+    {
+      return window.renderToTiledImageBand(
+        this->AppOptions.OutputScale, band[0], band[1], this->AppOptions.NoBackground);
+    }
+    if (!band.empty())
     {
-      self->Internals->ReloadFileRequested = true;
+      f3d::log::warn("Invalid output band, it must be an index lower than a count, "
+                     "the whole image is rendered");
     }
+    return window.renderToTiledImage(this->AppOptions.OutputScale, this->AppOptions.NoBackground);
   }
 
   void addOutputImageMetadata(f3d::image& image)
@@ -248,12 +520,14 @@ public:
    * - `{n}`: auto-incremented number to make filename unique (up to 1000000)
    * - `{n:2}`, `{n:3}`, ...: zero-padded auto-incremented number to make filename unique
    *   (up to 1000000)
+   * - `{frame}`, `{frame:2}`, ...: index of the rendered animation frame, optionally zero-padded
    */
   fs::path applyFilenameTemplate(const std::string& templateString)
   {
     constexpr size_t maxNumberingAttempts = 1000000;
     const std::regex numberingRe("\\{(n:?([0-9]*))\\}");
     const std::regex dateRe("date:?([A-Za-z%]*)");
+    const std::regex frameRe("frame:?([0-9]*)");
 
     /* Return a file related string depending on the currently loaded files, or the empty string if
      * a single file is loaded */
@@ -327,6 +601,14 @@ public:
         joined << std::put_time(std::localtime(&t), fmt.c_str());
         return joined.str();
       }
+      else if (this->AnimationFrame >= 0 && std::regex_match(var, frameRe))
+      {
+        const std::string pad = std::regex_replace(var, frameRe, "$1");
+        std::stringstream joined;
+        joined << std::setfill('0') << std::setw(pad.empty() ? 0 : std::stoi(pad))
+               << this->AnimationFrame;
+        return joined.str();
+      }
       throw std::out_of_range(var);
     };
 
@@ -438,6 +720,14 @@ public:
       std::to_string(maxNumberingAttempts) + " attempts");
   }
 
+  /**
+   * Get the matcher of a config block pattern, created once and reused for all the input files
+   */
+  const F3DConfigFileTools::PatternMatcher& GetPatternMatcher(const std::string& pattern)
+  {
+    return this->PatternMatchers.try_emplace(pattern, pattern).first->second;
+  }
+
   void UpdateOptions(const std::vector<F3DOptionsTools::OptionsEntries>& entriesVector,
     const std::vector<fs::path>& paths)
   {
@@ -465,11 +755,9 @@ public:
         // For each entry (eg: difference config files)
         for (auto const& [conf, source, pattern] : entries)
         {
-          std::regex re(pattern, std::regex_constants::icase);
-          std::smatch matches;
           // If the source is empty, there is no pattern, all options applies
           // Note: An empty inputFile matches with ".*"
-          if (source.empty() || std::regex_match(inputFile, matches, re))
+          if (source.empty() || this->GetPatternMatcher(pattern).Match(inputFile))
           {
             // For each option key/value
             for (auto const& [key, value] : conf)
@@ -540,7 +828,8 @@ public:
     this->UpdateTypedAppOptions(appOptions);
 
     // Update Verbose level as soon as possible
-    F3DInternals::SetVerboseLevel(this->AppOptions.VerboseLevel, this->AppOptions.Output == "-");
+    F3DInternals::SetVerboseLevel(
+      this->AppOptions.VerboseLevel, this->AppOptions.Output == "-" || !this->AppOptions.Batch.empty());
 
     // Load any new plugins
     F3DPluginsTools::LoadPlugins(this->AppOptions.Plugins);
@@ -557,11 +846,23 @@ public:
     // Update typed app options from app options
     this->AppOptions.Output = f3d::options::parse<std::string>(appOptions.at("output"));
     this->AppOptions.NoBackground = f3d::options::parse<bool>(appOptions.at("no-background"));
+    this->AppOptions.OutputScale = f3d::options::parse<int>(appOptions.at("output-scale"));
+    this->AppOptions.OutputBand =
+      f3d::options::parse<std::vector<int>>(appOptions.at("output-band"));
+    this->AppOptions.Batch = f3d::options::parse<std::string>(appOptions.at("batch"));
+    this->AppOptions.AnimationFrames = f3d::options::parse<bool>(appOptions.at("animation-frames"));
+    this->AppOptions.VideoCodec = f3d::options::parse<std::string>(appOptions.at("video-codec"));
     this->AppOptions.NoRender = f3d::options::parse<bool>(appOptions.at("no-render"));
     this->AppOptions.RenderingBackend =
       f3d::options::parse<std::string>(appOptions.at("rendering-backend"));
+    this->AppOptions.RenderingDevice = f3d::options::parse<int>(appOptions.at("rendering-device"));
+    this->AppOptions.ShaderCache = f3d::options::parse<bool>(appOptions.at("shader-cache"));
     this->AppOptions.MaxSize = f3d::options::parse<double>(appOptions.at("max-size"));
     this->AppOptions.Watch = f3d::options::parse<bool>(appOptions.at("watch"));
+    this->AppOptions.CommandInput =
+      f3d::options::parse<std::string>(appOptions.at("command-input"));
+    this->AppOptions.RemoteServer = f3d::options::parse<int>(appOptions.at("remote-server"));
+    this->AppOptions.Preload = f3d::options::parse<int>(appOptions.at("preload"));
     this->AppOptions.Plugins = { f3d::options::parse<std::vector<std::string>>(
       appOptions.at("load-plugins")) };
     this->AppOptions.ScreenshotFilename =
@@ -655,7 +956,7 @@ public:
     for (const auto& tmpPath : paths)
     {
       fs::path parentPath = tmpPath.parent_path();
-      if (std::find(parents.begin(), parents.end(), tmpPath) == parents.end())
+      if (std::find(parents.begin(), parents.end(), parentPath) == parents.end())
       {
         parents.emplace_back(parentPath);
       }
@@ -663,23 +964,109 @@ public:
     return parents;
   }
 
+  /**
+   * Reserve a filename by creating an empty file, so that filename templates using `{n}`
+   * do not select it again while the image is still being saved asynchronously
+   */
+  static void ReserveFilename(const fs::path& path)
+  {
+    std::ofstream reserved(path, std::ios::app);
+  }
+
+  /**
+   * Log the finished asynchronous saves and their errors, wait for all of them if needed
+   */
+  void CheckPendingSaves(bool wait)
+  {
+    for (auto it = this->PendingSaves.begin(); it != this->PendingSaves.end();)
+    {
+      auto& [path, future] = *it;
+      if (!wait && future.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+      {
+        ++it;
+        continue;
+      }
+
+      try
+      {
+        future.get();
+        f3d::log::debug("Image saved to ", path.string());
+      }
+      catch (const f3d::image::write_exception& ex)
+      {
+        f3d::log::error("Cannot save ", path.string(), ": ", ex.what());
+      }
+      it = this->PendingSaves.erase(it);
+    }
+  }
+
   F3DAppOptions AppOptions;
   f3d::options LibOptions;
   F3DOptionsTools::OptionsEntries ConfigOptionsEntries;
+  std::map<std::string, F3DConfigFileTools::PatternMatcher> PatternMatchers;
   F3DOptionsTools::OptionsEntries CLIOptionsEntries;
   F3DOptionsTools::OptionsEntries DynamicOptionsEntries;
+  F3DOptionsTools::OptionsEntries BatchOptionsEntries;
   std::unique_ptr<f3d::engine> Engine;
   std::vector<std::vector<fs::path>> FilesGroups;
+  std::map<fs::path, int> FilesGroupIndices;
   std::vector<fs::path> LoadedFiles;
-  std::vector<dmon_watch_id> FolderWatchIds;
+
+  // A folder watched by dmon and the loaded files it contains, by file name. The files are not
+  // modified while the folder is watched so that the watcher thread can read them without locking
+  struct FolderWatch
+  {
+    F3DStarter* Starter;
+    std::map<fs::path, fs::path> Files;
+    dmon_watch_id Id;
+  };
+  std::vector<std::unique_ptr<FolderWatch>> FolderWatches;
+
   int CurrentFilesGroupIndex = -1;
 
+  // Index of the animation frame being saved by --animation-frames, -1 otherwise
+  int AnimationFrame = -1;
+
   // dmon used atomic and mutex
   std::mutex LoadedFilesMutex;
+  std::set<fs::path> ChangedFiles;
+  std::chrono::steady_clock::time_point LastFileChange;
+  std::vector<fs::path> FilesToReload;
+
+  // Commands read by the command input thread, see StartCommandInput
+  struct PendingCommands
+  {
+    std::mutex Mutex;
+    std::vector<std::string> Commands;
+  };
+  std::shared_ptr<PendingCommands> CommandInputCommands;
+
+  // Folders scanned in the background, their files are added in order by the main thread,
+  // see AddFile and MergeFolderScans
+  struct FolderScan
+  {
+    std::mutex Mutex;
+    std::condition_variable Found;
+    std::vector<fs::path> Files;
+    bool Done = false;
+    std::atomic<bool> Abort = false;
+    std::future<void> Worker;
+  };
+  std::deque<std::unique_ptr<FolderScan>> FolderScans;
+  bool AsyncFolderScan = false;
 
   // Event loop atomics
   std::atomic<bool> RenderRequested = false;
   std::atomic<bool> ReloadFileRequested = false;
+
+  // Event loop scheduling, only used by the main thread
+  bool EventLoopRunning = false;
+  bool EventLoopScheduled = false;
+  bool PendingSavesCheckScheduled = false;
+  bool FolderScansMergeScheduled = false;
+
+  // Screenshots being encoded in the background
+  std::deque<std::pair<fs::path, std::future<void>>> PendingSaves;
 };
 
 //----------------------------------------------------------------------------
@@ -693,6 +1080,16 @@ F3DStarter::F3DStarter()
 //----------------------------------------------------------------------------
 F3DStarter::~F3DStarter()
 {
+  // make sure all screenshots are written
+  this->Internals->CheckPendingSaves(true);
+
+  // stop the folder scans still running
+  for (const auto& scan : this->Internals->FolderScans)
+  {
+    scan->Abort = true;
+  }
+  this->Internals->FolderScans.clear();
+
   // deinit dmon
   dmon_deinit();
 }
@@ -727,6 +1124,11 @@ int F3DStarter::Start(int argc, char** argv)
   {
     renderToStdout = f3d::options::parse<std::string>(cliOptionsDict["output"]) == "-";
   }
+  if (cliOptionsDict.find("batch") != cliOptionsDict.end())
+  {
+    // batch results are streamed to stdout
+    renderToStdout |= !f3d::options::parse<std::string>(cliOptionsDict["batch"]).empty();
+  }
   this->Internals->AppOptions.VerboseLevel = "info";
   if (cliOptionsDict.find("verbose") != cliOptionsDict.end())
   {
@@ -737,18 +1139,40 @@ int F3DStarter::Start(int argc, char** argv)
   // Set verbosity level early from command line
   F3DInternals::SetVerboseLevel(this->Internals->AppOptions.VerboseLevel, renderToStdout);
 
+  // Start the trace as early as possible, it is written when leaving this method
+  F3DInternals::TraceWriter traceWriter;
+  if (cliOptionsDict.find("trace") != cliOptionsDict.end())
+  {
+    traceWriter.FileName = f3d::options::parse<std::string>(cliOptionsDict["trace"]);
+  }
+  if (!traceWriter.FileName.empty())
+  {
+    f3d::log::startTrace(traceWriter.FileName);
+  }
+  const f3d::log::traceSpan startSpan("F3DStarter::Start");
+
+  // The metrics are written when exiting, and after each job in batch mode
+  if (cliOptionsDict.find("metrics") != cliOptionsDict.end())
+  {
+    this->Internals->Metrics.FileName = f3d::options::parse<std::string>(cliOptionsDict["metrics"]);
+  }
+
   f3d::log::debug("========== Initializing Options ==========");
 
   // Read config files
   if (!dryRun)
   {
+    const f3d::log::traceSpan span("F3DConfigFileTools::ReadConfigFiles");
     this->Internals->ConfigOptionsEntries = F3DConfigFileTools::ReadConfigFiles(config);
   }
 
   // Update app and libf3d options based on config entries, with an empty input file
   // config < cli
-  this->Internals->UpdateOptions(
-    { this->Internals->ConfigOptionsEntries, this->Internals->CLIOptionsEntries }, { "" });
+  {
+    const f3d::log::traceSpan span("F3DStarter::UpdateOptions");
+    this->Internals->UpdateOptions(
+      { this->Internals->ConfigOptionsEntries, this->Internals->CLIOptionsEntries }, { "" });
+  }
 
 #if __APPLE__
   // Initialize MacOS delegate
@@ -766,11 +1190,18 @@ int F3DStarter::Start(int argc, char** argv)
   }
   else
   {
-    bool offscreen = !reference.empty() || !output.empty();
+    if (this->Internals->AppOptions.ShaderCache)
+    {
+      F3DInternals::SetShaderDiskCache();
+    }
+
+    bool offscreen = !reference.empty() || !output.empty() ||
+      !this->Internals->AppOptions.Batch.empty() || this->Internals->AppOptions.RemoteServer > 0;
 
     if (this->Internals->AppOptions.RenderingBackend == "egl")
     {
-      this->Internals->Engine = std::make_unique<f3d::engine>(f3d::engine::createEGL(offscreen));
+      this->Internals->Engine = std::make_unique<f3d::engine>(
+        f3d::engine::createEGL(offscreen, this->Internals->AppOptions.RenderingDevice));
     }
     else if (this->Internals->AppOptions.RenderingBackend == "osmesa")
     {
@@ -912,6 +1343,24 @@ int F3DStarter::Start(int argc, char** argv)
   this->Internals->Engine->setOptions(this->Internals->LibOptions);
   f3d::log::debug("Engine configured");
 
+  // Render jobs with the same engine until the batch input ends
+  if (!this->Internals->AppOptions.Batch.empty())
+  {
+    if (!inputFiles.empty())
+    {
+      f3d::log::warn("Input files are ignored in batch mode, provide them in the jobs instead");
+    }
+    return this->RunBatch();
+  }
+
+  // Folders are only scanned in the background when interacting, the other modes and the
+  // played interactions need all the files, and all the files are in the same group with
+  // the "all" multi-file mode
+  const auto& appOptions = this->Internals->AppOptions;
+  this->Internals->AsyncFolderScan = !appOptions.NoRender && appOptions.Output.empty() &&
+    appOptions.RemoteServer <= 0 && appOptions.InteractionTestPlayFile.empty() &&
+    appOptions.MultiFileMode != "all";
+
   // Add all input files
   for (auto& file : inputFiles)
   {
@@ -1020,7 +1469,29 @@ int F3DStarter::Start(int argc, char** argv)
         return EXIT_FAILURE;
       }
 
-      f3d::image img = window.renderToImage(this->Internals->AppOptions.NoBackground);
+      // a glb output converts the loaded files instead of rendering them
+      if (F3DInternals::HasGLBExtension(output))
+      {
+        if (renderToStdout)
+        {
+          f3d::log::error("A scene cannot be streamed to stdout");
+          return EXIT_FAILURE;
+        }
+        return this->SaveScene();
+      }
+
+      // a video output contains all the animation frames
+      if (this->Internals->AppOptions.AnimationFrames || F3DVideoEncoder::IsVideoFile(output))
+      {
+        if (renderToStdout)
+        {
+          f3d::log::error("Animation frames cannot be streamed to stdout");
+          return EXIT_FAILURE;
+        }
+        return this->RenderAnimationFrames();
+      }
+
+      f3d::image img = this->Internals->RenderOutputImage(window);
       this->Internals->addOutputImageMetadata(img);
 
       if (renderToStdout)
@@ -1029,6 +1500,15 @@ int F3DStarter::Start(int argc, char** argv)
         std::copy(buffer.begin(), buffer.end(), std::ostreambuf_iterator(std::cout));
         f3d::log::debug("Output image saved to stdout");
       }
+      else if (F3DSharedMemoryOutput::IsSharedMemoryOutput(output))
+      {
+        F3DSharedMemoryOutput sharedMemory;
+        if (!sharedMemory.Open(output) || !sharedMemory.Write(img))
+        {
+          return EXIT_FAILURE;
+        }
+        f3d::log::debug("Output image written to ", output);
+      }
       else
       {
         fs::path path = this->Internals->applyFilenameTemplate(output);
@@ -1042,6 +1522,11 @@ int F3DStarter::Start(int argc, char** argv)
                        "files were ignored.");
       }
     }
+    // Stream the frames to a remote client
+    else if (this->Internals->AppOptions.RemoteServer > 0)
+    {
+      return this->RunRemoteServer();
+    }
     // Start interaction
     else
     {
@@ -1049,10 +1534,42 @@ int F3DStarter::Start(int argc, char** argv)
       f3d::log::error("This is a headless build of F3D, interactive rendering is not supported");
       return EXIT_FAILURE;
 #else
-      // Create the event loop repeating timer
-      interactor.createTimerCallBack(30, [this]() { this->EventLoop(); });
-      this->RequestRender();
+      // The event loop is scheduled on demand, only dmon requests and the command input,
+      // posted by other threads, need to be polled
+      if (this->Internals->AppOptions.Watch)
+      {
+        interactor.createTimerCallBack(100,
+          [this]()
+          {
+            std::vector<fs::path> changedFiles = this->Internals->GetSettledChangedFiles();
+            if (!changedFiles.empty())
+            {
+              this->Internals->FilesToReload = std::move(changedFiles);
+              this->Internals->ReloadFileRequested = true;
+              this->ScheduleEventLoop();
+            }
+          });
+      }
+      if (!this->Internals->AppOptions.CommandInput.empty() &&
+        this->Internals->StartCommandInput())
+      {
+        // Commands received together, like the script of a controller, are rendered once
+        interactor.createTimerCallBack(50,
+          [this, &interactor]()
+          {
+            const std::vector<std::string> commands = this->Internals->TakePendingCommands();
+            if (!commands.empty())
+            {
+              interactor.triggerCommands({ commands.begin(), commands.end() });
+            }
+          });
+      }
+      this->Internals->EventLoopRunning = true;
+      this->Internals->RenderRequested = true;
+      this->ScheduleEventLoop();
+      this->ScheduleFolderScansMerge();
       interactor.start();
+      this->Internals->EventLoopRunning = false;
 #endif
     }
   }
@@ -1095,6 +1612,7 @@ void F3DStarter::LoadFileGroup(int index, bool relativeIndex, bool forceClear)
     std::string groupIdx = "(" + std::to_string(groupIndex + 1) + "/" +
       std::to_string(this->Internals->FilesGroups.size()) + ")";
     this->LoadFileGroup(this->Internals->FilesGroups[groupIndex], clear, groupIdx);
+    this->PreloadAdjacentFileGroups();
   }
   else
   {
@@ -1107,6 +1625,7 @@ void F3DStarter::LoadFileGroup(int index, bool relativeIndex, bool forceClear)
 void F3DStarter::LoadFileGroup(
   const std::vector<fs::path>& paths, bool clear, const std::string& groupIdx)
 {
+  const f3d::log::traceSpan span("F3DStarter::LoadFileGroup");
   // Make sure the animation is stopped before trying to load any file
   if (!this->Internals->AppOptions.NoRender)
   {
@@ -1148,10 +1667,11 @@ void F3DStarter::LoadFileGroup(
     // In the main thread, we only need to guard writing
     const std::lock_guard<std::mutex> lock(this->Internals->LoadedFilesMutex);
 
+    // The scene itself is cleared when the new files replace the current ones
     if (clear)
     {
-      scene.clear();
       this->Internals->LoadedFiles.clear();
+      this->Internals->ChangedFiles.clear();
     }
 
     if (paths.empty())
@@ -1167,7 +1687,7 @@ void F3DStarter::LoadFileGroup(
       std::copy(paths.begin(), paths.end(), std::back_inserter(configPaths));
       this->Internals->UpdateOptions(
         { this->Internals->ConfigOptionsEntries, this->Internals->CLIOptionsEntries,
-          this->Internals->DynamicOptionsEntries },
+          this->Internals->BatchOptionsEntries, this->Internals->DynamicOptionsEntries },
         configPaths);
 
       this->Internals->Engine->setOptions(this->Internals->LibOptions);
@@ -1204,8 +1724,15 @@ void F3DStarter::LoadFileGroup(
 
       if (!localPaths.empty())
       {
-        // Add files to the scene
-        scene.add(localPaths);
+        // Add files to the scene, the current files stay rendered until replaced
+        if (clear)
+        {
+          scene.replace(localPaths);
+        }
+        else
+        {
+          scene.add(localPaths);
+        }
 
         // Update loaded files
         std::copy(
@@ -1223,6 +1750,12 @@ void F3DStarter::LoadFileGroup(
     unsupported = true;
   }
 
+  // Nothing replaced the current files
+  if (clear && this->Internals->LoadedFiles.empty())
+  {
+    scene.clear();
+  }
+
   std::string filenameInfo;
   if (this->Internals->LoadedFiles.size() > 0)
   {
@@ -1242,19 +1775,30 @@ void F3DStarter::LoadFileGroup(
     if (this->Internals->AppOptions.Watch)
     {
       // Always unwatch and watch current folder, even on reload
-      for (const auto& dmonId : this->Internals->FolderWatchIds)
+      for (const auto& watch : this->Internals->FolderWatches)
       {
-        if (dmonId.id > 0)
+        if (watch->Id.id > 0)
         {
-          dmon_unwatch(dmonId);
+          dmon_unwatch(watch->Id);
         }
       }
-      this->Internals->FolderWatchIds.clear();
+      this->Internals->FolderWatches.clear();
 
+      // Each folder is watched once, with the names of the loaded files it contains
       for (const auto& parentPath : F3DInternals::ParentPaths(this->Internals->LoadedFiles))
       {
-        this->Internals->FolderWatchIds.emplace_back(
-          dmon_watch(parentPath.string().c_str(), &F3DInternals::dmonFolderChanged, 0, this));
+        auto watch = std::make_unique<F3DInternals::FolderWatch>();
+        watch->Starter = this;
+        for (const fs::path& loadedPath : this->Internals->LoadedFiles)
+        {
+          if (loadedPath.parent_path() == parentPath)
+          {
+            watch->Files.emplace(loadedPath.filename(), loadedPath);
+          }
+        }
+        watch->Id = dmon_watch(
+          parentPath.string().c_str(), &F3DInternals::dmonFolderChanged, 0, watch.get());
+        this->Internals->FolderWatches.emplace_back(std::move(watch));
       }
     }
   }
@@ -1301,29 +1845,573 @@ void F3DStarter::LoadFileGroup(
 }
 
 //----------------------------------------------------------------------------
-void F3DStarter::RequestRender()
+int F3DStarter::SaveScene()
 {
-  // Render will be called by the next event loop
-  this->Internals->RenderRequested = true;
-}
+  fs::path path = this->Internals->applyFilenameTemplate(this->Internals->AppOptions.Output);
+  try
+  {
+    this->Internals->Engine->getScene().save(path);
+  }
+  catch (const f3d::scene::save_failure_exception& ex)
+  {
+    f3d::log::error("Could not save the scene: ", ex.what());
+    return EXIT_FAILURE;
+  }
+  f3d::log::debug("Scene saved to ", path);
 
-//----------------------------------------------------------------------------
-void F3DStarter::Render()
-{
-  f3d::log::debug("========== Rendering ==========");
-  this->Internals->Engine->getWindow().render();
-  f3d::log::debug("Render done");
+  if (this->Internals->FilesGroups.size() > 1)
+  {
+    f3d::log::warn("The scene was saved using a single 3D file, other provided 3D "
+                   "files were ignored.");
+  }
+  return EXIT_SUCCESS;
 }
 
 //----------------------------------------------------------------------------
-void F3DStarter::SaveScreenshot(const std::string& filenameTemplate, bool minimal)
+int F3DStarter::RenderAnimationFrames()
 {
+  f3d::scene& scene = this->Internals->Engine->getScene();
+  f3d::window& window = this->Internals->Engine->getWindow();
+  const std::string& output = this->Internals->AppOptions.Output;
+  const bool noBackground = this->Internals->AppOptions.NoBackground;
 
-  const auto getScreenshotDir = []()
+  const auto [startTime, endTime] = scene.animationTimeRange();
+  if (startTime >= endTime)
   {
-    for (const char* const& candidate : { "XDG_PICTURES_DIR", "HOME", "USERPROFILE" })
+    f3d::log::error("No animation available, cannot render animation frames");
+    return EXIT_FAILURE;
+  }
+
+  const double frameRate = this->Internals->Engine->getOptions().scene.animation.frame_rate;
+  if (frameRate <= 0)
+  {
+    f3d::log::error("Animation frame rate must be positive to render animation frames");
+    return EXIT_FAILURE;
+  }
+
+  const bool toVideo = F3DVideoEncoder::IsVideoFile(output);
+  const bool toSharedMemory = F3DSharedMemoryOutput::IsSharedMemoryOutput(output);
+  if (!toVideo && !toSharedMemory && output.find("{frame") == std::string::npos &&
+    output.find("{n") == std::string::npos)
+  {
+    f3d::log::warn("The output does not contain a {frame} template variable, "
+                   "each animation frame will overwrite the previous one");
+  }
+
+  // Step through the time range at a fixed frame rate, the last frame is the end of the range.
+  // A small epsilon avoid skipping it because of floating point errors.
+  const int nbFrames = static_cast<int>(std::floor((endTime - startTime) * frameRate + 1e-6)) + 1;
+  f3d::log::debug("Rendering ", nbFrames, " animation frames at ", frameRate, " fps");
+
+  // Limit the number of frames being encoded to keep memory usage bounded
+  const size_t maxPendingSaves = std::max(2u, std::thread::hardware_concurrency());
+  std::deque<std::pair<fs::path, std::future<void>>> pendingSaves;
+  bool success = true;
+  const auto waitSave = [&]()
+  {
+    auto& [path, future] = pendingSaves.front();
+    try
     {
-      char* val = std::getenv(candidate);
+      future.get();
+      f3d::log::debug("Animation frame saved to ", path.string());
+    }
+    catch (const f3d::image::write_exception& ex)
+    {
+      f3d::log::error("Cannot save ", path.string(), ": ", ex.what());
+      success = false;
+    }
+    pendingSaves.pop_front();
+  };
+
+  // The frame N readback is collected after frame N+1 has been loaded and submitted,
+  // so that the importer update overlaps the readback, and images are encoded on background
+  // threads
+  std::future<f3d::image> pendingImage;
+  F3DVideoEncoder encoder;
+  if (toVideo)
+  {
+    fs::path path = this->Internals->applyFilenameTemplate(output);
+    F3DInternals::ReserveFilename(path);
+    encoder.Open(path, frameRate, this->Internals->AppOptions.VideoCodec);
+  }
+  F3DSharedMemoryOutput sharedMemory;
+  if (toSharedMemory && !sharedMemory.Open(output))
+  {
+    return EXIT_FAILURE;
+  }
+  const auto saveFrame = [&](int frame)
+  {
+    f3d::image img = pendingImage.get();
+    if (toVideo)
+    {
+      success = encoder.AddFrame(std::move(img)) && success;
+      return;
+    }
+    if (toSharedMemory)
+    {
+      // the raw pixels are copied, there is nothing to encode on a background thread
+      success = sharedMemory.Write(img) && success;
+      return;
+    }
+    this->Internals->AnimationFrame = frame;
+    this->Internals->addOutputImageMetadata(img);
+    fs::path path = this->Internals->applyFilenameTemplate(output);
+    this->Internals->AnimationFrame = -1;
+    F3DInternals::ReserveFilename(path);
+    pendingSaves.emplace_back(path, img.saveAsync(path.string()));
+    while (pendingSaves.size() > maxPendingSaves)
+    {
+      waitSave();
+    }
+  };
+
+  for (int frame = 0; frame < nbFrames; frame++)
+  {
+    scene.loadAnimationTime(std::min(startTime + frame / frameRate, endTime));
+    std::future<f3d::image> image = window.renderToImageAsync(noBackground);
+    if (pendingImage.valid())
+    {
+      saveFrame(frame - 1);
+    }
+    pendingImage = std::move(image);
+  }
+  saveFrame(nbFrames - 1);
+
+  while (!pendingSaves.empty())
+  {
+    waitSave();
+  }
+  if (toVideo)
+  {
+    success = encoder.Close() && success;
+    if (success)
+    {
+      f3d::log::debug("Animation video saved to ", output);
+    }
+  }
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+//----------------------------------------------------------------------------
+int F3DStarter::RunBatch()
+{
+  f3d::log::debug("========== Running batch ==========");
+
+  if (this->Internals->AppOptions.NoRender)
+  {
+    f3d::log::error("Batch mode requires rendering, it cannot be used with --no-render");
+    return EXIT_FAILURE;
+  }
+
+  const std::string& batch = this->Internals->AppOptions.Batch;
+  std::ifstream file;
+  std::istream* stream = &std::cin;
+  if (batch != "-")
+  {
+    file.open(fs::path(batch));
+    if (!file.is_open())
+    {
+      f3d::log::error("Unable to open the batch file: ", batch);
+      return EXIT_FAILURE;
+    }
+    stream = &file;
+  }
+
+  f3d::window& window = this->Internals->Engine->getWindow();
+
+  // Images are encoded in the background while the next jobs are rendered,
+  // the results are streamed in order as soon as their image is saved
+  bool success = true;
+  std::deque<std::pair<nlohmann::ordered_json, std::future<void>>> pendingResults;
+  const auto flushResults = [&](bool wait)
+  {
+    while (!pendingResults.empty())
+    {
+      auto& [result, future] = pendingResults.front();
+      if (future.valid())
+      {
+        if (!wait && future.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        {
+          break;
+        }
+        try
+        {
+          future.get();
+          result["status"] = "success";
+        }
+        catch (const f3d::image::write_exception& ex)
+        {
+          f3d::log::error("Batch job ", result["job"].get<int>(), " failed: ", ex.what());
+          result["status"] = "failure";
+          result["error"] = ex.what();
+          success = false;
+        }
+      }
+      std::cout << result.dump() << std::endl;
+      pendingResults.pop_front();
+    }
+  };
+
+  // Each line is a JSON object describing a job, using the same keys than a configuration file
+  // block with an additional "input" key, the engine and window are kept between jobs
+  int jobIndex = 0;
+  std::string line;
+  while (std::getline(*stream, line))
+  {
+    if (line.find_first_not_of(" \t\r") == std::string::npos)
+    {
+      continue;
+    }
+
+    nlohmann::ordered_json result;
+    std::future<void> saved;
+    result["job"] = jobIndex;
+    try
+    {
+      nlohmann::ordered_json job = nlohmann::ordered_json::parse(line);
+      if (!job.is_object())
+      {
+        throw std::runtime_error("a job must be a JSON object");
+      }
+
+      std::vector<fs::path> paths;
+      F3DOptionsTools::OptionsDict jobOptions;
+      for (const auto& item : job.items())
+      {
+        if (item.key() == "input")
+        {
+          const auto addPath = [&](const nlohmann::ordered_json& value)
+          {
+            if (!value.is_string())
+            {
+              throw std::runtime_error("input must be a string or an array of strings");
+            }
+            paths.emplace_back(value.get<std::string>());
+          };
+          if (item.value().is_array())
+          {
+            std::for_each(item.value().begin(), item.value().end(), addPath);
+          }
+          else
+          {
+            addPath(item.value());
+          }
+        }
+        else if (item.value().is_number() || item.value().is_boolean())
+        {
+          jobOptions[item.key()] = nlohmann::to_string(item.value());
+        }
+        else if (item.value().is_string())
+        {
+          jobOptions[item.key()] = item.value().get<std::string>();
+        }
+        else
+        {
+          throw std::runtime_error(item.key() + " must be a string, a boolean or a number");
+        }
+      }
+
+      if (paths.empty())
+      {
+        throw std::runtime_error("no input provided");
+      }
+      result["input"] = job["input"];
+
+      // Job options are only applied to this job, on top of the config and CLI options
+      this->Internals->BatchOptionsEntries = { { jobOptions, fs::path(),
+        "batch job " + std::to_string(jobIndex) } };
+      this->Internals->DynamicOptionsEntries.clear();
+      this->LoadFileGroup(paths, true, "");
+
+      if (this->Internals->LoadedFiles.empty())
+      {
+        throw std::runtime_error("no file loaded");
+      }
+
+      const std::string& output = this->Internals->AppOptions.Output;
+      if (output.empty() || output == "-")
+      {
+        throw std::runtime_error("an output file is required");
+      }
+
+      f3d::image img = this->Internals->RenderOutputImage(window);
+      this->Internals->addOutputImageMetadata(img);
+
+      fs::path path = this->Internals->applyFilenameTemplate(output);
+      F3DInternals::ReserveFilename(path);
+      saved = img.saveAsync(path.string());
+
+      result["output"] = path.string();
+    }
+    catch (const std::exception& ex)
+    {
+      f3d::log::error("Batch job ", jobIndex, " failed: ", ex.what());
+      result["status"] = "failure";
+      result["error"] = ex.what();
+      success = false;
+    }
+
+    pendingResults.emplace_back(std::move(result), std::move(saved));
+
+    // Wait for the results before waiting for more jobs, so that a client sending
+    // jobs one at a time, like f3d-thumbnail-server, receives each result
+    flushResults(stream->rdbuf()->in_avail() <= 0);
+    this->Internals->Metrics.Write();
+    jobIndex++;
+  }
+
+  flushResults(true);
+  this->Internals->BatchOptionsEntries.clear();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+//----------------------------------------------------------------------------
+int F3DStarter::RunRemoteServer()
+{
+  f3d::log::debug("========== Running remote server ==========");
+
+  const int port = this->Internals->AppOptions.RemoteServer;
+  F3DRemoteServer server;
+  if (!server.Open(port))
+  {
+    return EXIT_FAILURE;
+  }
+  f3d::log::info("Remote server listening on port ", port);
+
+  f3d::window& window = this->Internals->Engine->getWindow();
+  f3d::interactor& interactor = this->Internals->Engine->getInteractor();
+  f3d::camera& camera = window.getCamera();
+
+  // There is no event loop to stop, the server is stopped instead
+  bool running = true;
+  interactor.addCommandCallback("stop_interactor",
+    [&running](const std::vector<std::string>&)
+    {
+      running = false;
+      return true;
+    });
+
+  // Each message is a JSON object, the keys are applied in order:
+  // - "command": a command to trigger, eg: "toggle ui.fps"
+  // - "commands": an array of commands to trigger together
+  // - "camera": an object of camera moves applied in order, "azimuth", "elevation", "roll",
+  //   "yaw" and "pitch" in degrees, "dolly" and "zoom" factors, "pan" as [right, up]
+  // - "resize": the [width, height] of the client view
+  // - "refresh": send all the tiles of the next frame
+  const auto applyMessage = [&](const std::string& message)
+  {
+    nlohmann::ordered_json json = nlohmann::ordered_json::parse(message);
+    if (!json.is_object())
+    {
+      throw std::runtime_error("a message must be a JSON object");
+    }
+    for (const auto& item : json.items())
+    {
+      const auto& value = item.value();
+      if (item.key() == "command")
+      {
+        interactor.triggerCommand(value.get<std::string>());
+      }
+      else if (item.key() == "commands")
+      {
+        const std::vector<std::string> commands = value.get<std::vector<std::string>>();
+        interactor.triggerCommands({ commands.begin(), commands.end() });
+      }
+      else if (item.key() == "camera")
+      {
+        for (const auto& move : value.items())
+        {
+          const std::string& name = move.key();
+          if (name == "pan")
+          {
+            const std::vector<double> pan = move.value().get<std::vector<double>>();
+            camera.pan(pan.at(0), pan.at(1));
+            continue;
+          }
+          const double amount = move.value().get<double>();
+          if (name == "azimuth")
+          {
+            camera.azimuth(amount);
+          }
+          else if (name == "elevation")
+          {
+            camera.elevation(amount);
+          }
+          else if (name == "roll")
+          {
+            camera.roll(amount);
+          }
+          else if (name == "yaw")
+          {
+            camera.yaw(amount);
+          }
+          else if (name == "pitch")
+          {
+            camera.pitch(amount);
+          }
+          else if (name == "dolly")
+          {
+            camera.dolly(amount);
+          }
+          else if (name == "zoom")
+          {
+            camera.zoom(amount);
+          }
+          else
+          {
+            throw std::runtime_error("unknown camera move " + name);
+          }
+        }
+      }
+      else if (item.key() == "resize")
+      {
+        const std::vector<int> size = value.get<std::vector<int>>();
+        if (size.at(0) > 0 && size.at(1) > 0)
+        {
+          window.setSize(size.at(0), size.at(1));
+        }
+      }
+      else if (item.key() == "refresh")
+      {
+        server.RequestFullFrame();
+      }
+      else
+      {
+        throw std::runtime_error("unknown key " + item.key());
+      }
+    }
+  };
+
+  // Frames are only rendered when the scene changed or when the server needs one,
+  // the messages received while a frame is sent are applied before the next render
+  f3d::image frame;
+  bool changed = false;
+  while (running)
+  {
+    for (const std::string& message : server.Poll(changed ? 1 : 50))
+    {
+      try
+      {
+        applyMessage(message);
+        changed = true;
+      }
+      catch (const std::exception& ex)
+      {
+        f3d::log::warn("Invalid remote message: ", ex.what());
+      }
+    }
+
+    if (server.IsFrameDue(changed))
+    {
+      window.renderToImage(frame);
+      server.SendFrame(frame, changed);
+      changed = false;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+//----------------------------------------------------------------------------
+void F3DStarter::RequestRender()
+{
+  // Render will be called by the next event loop, requests are coalesced into a single render
+  if (!this->Internals->RenderRequested.exchange(true))
+  {
+    this->ScheduleEventLoop();
+  }
+}
+
+//----------------------------------------------------------------------------
+void F3DStarter::ScheduleEventLoop()
+{
+  if (this->Internals->EventLoopRunning && !this->Internals->EventLoopScheduled)
+  {
+    this->Internals->EventLoopScheduled = true;
+    this->Internals->Engine->getInteractor().createOneShotTimerCallBack(
+      0, [this]() { this->EventLoop(); });
+  }
+}
+
+//----------------------------------------------------------------------------
+void F3DStarter::SchedulePendingSavesCheck()
+{
+  if (this->Internals->EventLoopRunning && !this->Internals->PendingSavesCheckScheduled &&
+    !this->Internals->PendingSaves.empty())
+  {
+    this->Internals->PendingSavesCheckScheduled = true;
+    this->Internals->Engine->getInteractor().createOneShotTimerCallBack(100,
+      [this]()
+      {
+        this->Internals->PendingSavesCheckScheduled = false;
+        this->Internals->CheckPendingSaves(false);
+        this->SchedulePendingSavesCheck();
+      });
+  }
+}
+
+//----------------------------------------------------------------------------
+void F3DStarter::MergeFolderScans()
+{
+  auto& scans = this->Internals->FolderScans;
+  while (!scans.empty())
+  {
+    F3DInternals::FolderScan& scan = *scans.front();
+    std::vector<fs::path> files;
+    bool done;
+    {
+      const std::lock_guard<std::mutex> lock(scan.Mutex);
+      files = std::exchange(scan.Files, {});
+      done = scan.Done;
+    }
+    for (const fs::path& file : files)
+    {
+      this->AddFile(file, true);
+    }
+
+    // The files of the next scans are added once all the files of this one are
+    if (!done)
+    {
+      break;
+    }
+    scans.pop_front();
+  }
+}
+
+//----------------------------------------------------------------------------
+void F3DStarter::ScheduleFolderScansMerge()
+{
+  if (this->Internals->EventLoopRunning && !this->Internals->FolderScansMergeScheduled &&
+    !this->Internals->FolderScans.empty())
+  {
+    this->Internals->FolderScansMergeScheduled = true;
+    this->Internals->Engine->getInteractor().createOneShotTimerCallBack(100,
+      [this]()
+      {
+        this->Internals->FolderScansMergeScheduled = false;
+        this->MergeFolderScans();
+        this->ScheduleFolderScansMerge();
+      });
+  }
+}
+
+//----------------------------------------------------------------------------
+void F3DStarter::Render()
+{
+  const f3d::log::traceSpan span("F3DStarter::Render");
+  f3d::log::debug("========== Rendering ==========");
+  this->Internals->Engine->getWindow().render();
+  f3d::log::debug("Render done");
+}
+
+//----------------------------------------------------------------------------
+void F3DStarter::SaveScreenshot(const std::string& filenameTemplate, bool minimal)
+{
+
+  const auto getScreenshotDir = []()
+  {
+    for (const char* const& candidate : { "XDG_PICTURES_DIR", "HOME", "USERPROFILE" })
+    {
+      char* val = std::getenv(candidate);
       if (val != nullptr)
       {
         fs::path path(val);
@@ -1355,6 +2443,7 @@ void F3DStarter::SaveScreenshot(const std::string& filenameTemplate, bool minima
     options.ui.cheatsheet = false;
     options.ui.filename = false;
     options.ui.fps = false;
+    options.ui.frame_stats = false;
     options.ui.metadata = false;
     options.ui.animation_progress = false;
     options.interactor.axis = false;
@@ -1364,7 +2453,12 @@ void F3DStarter::SaveScreenshot(const std::string& filenameTemplate, bool minima
 
   f3d::image img = this->Internals->Engine->getWindow().renderToImage(noBackground);
   this->Internals->addOutputImageMetadata(img);
-  img.save(path.string(), f3d::image::SaveFormat::PNG);
+
+  // encode in the background to not block the interaction
+  F3DInternals::ReserveFilename(path);
+  this->Internals->PendingSaves.emplace_back(
+    path, img.saveAsync(path.string(), f3d::image::SaveFormat::PNG));
+  this->SchedulePendingSavesCheck();
 
   options.render.light.intensity *= 5;
   this->Render();
@@ -1389,6 +2483,30 @@ int F3DStarter::AddFile(const fs::path& path, bool quiet)
   // If file is a folder, add files recursively
   else if (fs::is_directory(tmpPath))
   {
+    // Large folders, eg. on network shares, are scanned in the background and only the first
+    // file is waited for, so it is shown without waiting for the whole scan
+    if (this->Internals->AsyncFolderScan)
+    {
+      auto scan = std::make_unique<F3DInternals::FolderScan>();
+      F3DInternals::FolderScan* scanPtr = scan.get();
+      scan->Worker = std::async(std::launch::async,
+        [tmpPath, scanPtr]()
+        {
+          F3DInternals::ScanFolder(tmpPath, *scanPtr);
+          const std::lock_guard<std::mutex> lock(scanPtr->Mutex);
+          scanPtr->Done = true;
+          scanPtr->Found.notify_one();
+        });
+      {
+        std::unique_lock<std::mutex> lock(scan->Mutex);
+        scan->Found.wait(lock, [&]() { return !scan->Files.empty() || scan->Done; });
+      }
+      this->Internals->FolderScans.emplace_back(std::move(scan));
+      this->MergeFolderScans();
+      this->ScheduleFolderScansMerge();
+      return static_cast<int>(this->Internals->FilesGroups.size()) - 1;
+    }
+
     std::set<fs::path> sortedPaths;
     for (const auto& entry : fs::directory_iterator(tmpPath))
     {
@@ -1404,19 +2522,8 @@ int F3DStarter::AddFile(const fs::path& path, bool quiet)
   else
   {
     // Check if file has already been added
-    bool found = false;
-    std::vector<std::vector<fs::path>>::iterator it;
-    for (it = this->Internals->FilesGroups.begin(); it != this->Internals->FilesGroups.end(); it++)
-    {
-      auto localIt = std::find(it->begin(), it->end(), tmpPath);
-      found |= localIt != it->end();
-      if (found)
-      {
-        break;
-      }
-    }
-
-    if (!found)
+    auto indexIt = this->Internals->FilesGroupIndices.find(tmpPath);
+    if (indexIt == this->Internals->FilesGroupIndices.end())
     {
       // Add to the right file group
       // XXX more multi-file mode may be added in the future
@@ -1428,6 +2535,7 @@ int F3DStarter::AddFile(const fs::path& path, bool quiet)
         }
         assert(this->Internals->FilesGroups.size() == 1);
         this->Internals->FilesGroups[0].emplace_back(tmpPath);
+        this->Internals->FilesGroupIndices.emplace(tmpPath, 0);
       }
       else
       {
@@ -1437,6 +2545,8 @@ int F3DStarter::AddFile(const fs::path& path, bool quiet)
             this->Internals->AppOptions.MultiFileMode, ". Assuming \"single\" mode.");
         }
         this->Internals->FilesGroups.emplace_back(std::vector<fs::path>{ tmpPath });
+        this->Internals->FilesGroupIndices.emplace(
+          tmpPath, static_cast<int>(this->Internals->FilesGroups.size()) - 1);
       }
       return static_cast<int>(this->Internals->FilesGroups.size()) - 1;
     }
@@ -1447,7 +2557,55 @@ int F3DStarter::AddFile(const fs::path& path, bool quiet)
       {
         f3d::log::warn("File ", tmpPath.string(), " has already been added");
       }
-      return static_cast<int>(std::distance(this->Internals->FilesGroups.begin(), it));
+      return indexIt->second;
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+void F3DStarter::PreloadAdjacentFileGroups()
+{
+  const auto& appOptions = this->Internals->AppOptions;
+  int size = static_cast<int>(this->Internals->FilesGroups.size());
+  int current = this->Internals->CurrentFilesGroupIndex;
+  if (appOptions.Preload <= 0 || size < 2 || current < 0 || appOptions.NoRender ||
+    !appOptions.Output.empty() || !appOptions.Batch.empty())
+  {
+    return;
+  }
+
+  // The next group is preloaded last so it is the last to be discarded
+  f3d::scene& scene = this->Internals->Engine->getScene();
+  for (int offset : { -1, +1 })
+  {
+    int index = (current + offset + size) % size;
+    if (index == current)
+    {
+      continue;
+    }
+
+    // Same files as the ones added to the scene by LoadFileGroup when switching group
+    std::vector<fs::path> paths;
+    for (const fs::path& path : this->Internals->FilesGroups[index])
+    {
+      static constexpr int BYTES_IN_MIB = 1048576;
+      std::error_code ec;
+      if (scene.supports(path) &&
+        (appOptions.MaxSize < 0.0 ||
+          fs::file_size(path, ec) <=
+            static_cast<std::uintmax_t>(appOptions.MaxSize * BYTES_IN_MIB)))
+      {
+        paths.emplace_back(path);
+      }
+    }
+
+    try
+    {
+      scene.preload(paths, appOptions.Preload);
+    }
+    catch (const f3d::scene::load_failure_exception& ex)
+    {
+      f3d::log::debug("Cannot preload files: ", ex.what());
     }
   }
 }
@@ -1474,16 +2632,37 @@ bool F3DStarter::LoadRelativeFileGroup(int index, bool restoreCamera, bool force
 }
 
 //----------------------------------------------------------------------------
-void F3DStarter::EventLoop()
+void F3DStarter::ReloadFiles(std::vector<fs::path> paths)
 {
-  if (this->Internals->ReloadFileRequested)
+  const f3d::log::traceSpan span("F3DStarter::ReloadFiles");
+
+  // Only the changed files are reloaded, the other files keep their actors
+  try
+  {
+    f3d::log::debug("========== Reloading 3D files ==========");
+    this->Internals->Engine->getScene().reload(paths);
+  }
+  catch (const f3d::scene::load_failure_exception& ex)
   {
+    // eg. a file removed or renamed, reload the whole group
+    f3d::log::debug("Reloading the file group: ", ex.what());
     this->LoadRelativeFileGroup(0, true, true);
-    this->Internals->ReloadFileRequested = false;
   }
-  if (this->Internals->RenderRequested)
+  this->RequestRender();
+}
+
+//----------------------------------------------------------------------------
+void F3DStarter::EventLoop()
+{
+  // Requests made while handling this one schedule a new event loop
+  this->Internals->EventLoopScheduled = false;
+  if (this->Internals->ReloadFileRequested.exchange(false))
+  {
+    this->ReloadFiles(std::move(this->Internals->FilesToReload));
+  }
+  if (this->Internals->RenderRequested.exchange(false))
   {
     this->Render();
-    this->Internals->RenderRequested = false;
   }
+  this->Internals->CheckPendingSaves(false);
 }
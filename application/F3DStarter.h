@@ -33,7 +33,8 @@ public:
   void LoadFileGroup(int index = 0, bool relativeIndex = false, bool forceClear = false);
 
   /**
-   * Trigger a render on the next event loop
+   * Trigger a render on the next event loop, scheduling it if needed (must be called by the main
+   * thread)
    */
   void RequestRender();
 
@@ -67,6 +68,18 @@ private:
   bool LoadRelativeFileGroup(
     int relativeIndex = 0, bool restoreCamera = false, bool forceClear = false);
 
+  /**
+   * Internal method used to reload files of the current file group that changed on disk.
+   * The whole file group is loaded again if any of them cannot be reloaded
+   */
+  void ReloadFiles(std::vector<std::filesystem::path> paths);
+
+  /**
+   * Internal method used to read the previous and next file groups in the background
+   * when using --preload, so they are added to the scene without reading them again
+   */
+  void PreloadAdjacentFileGroups();
+
   /**
    * Internal method used to load a provided file group into the scene.
    * Set clear to true to clear the scene first
@@ -76,11 +89,60 @@ private:
     const std::vector<std::filesystem::path>& paths, bool clear, const std::string& groupIdx);
 
   /**
-   * Internal event loop that is triggered repeatedly to handle specific events:
+   * Internal method used to render all the animation frames into the output,
+   * stepping through the animation time range at the animation frame rate.
+   * Returns EXIT_FAILURE if there is no animation or a frame could not be saved
+   */
+  int RenderAnimationFrames();
+
+  /**
+   * Internal method used to save the loaded files into the glb output, see f3d::scene::save.
+   * Returns EXIT_FAILURE if the scene could not be saved
+   */
+  int SaveScene();
+
+  /**
+   * Internal method used to render the jobs read from the batch file, or stdin,
+   * one JSON object per line, reusing the same engine for all of them.
+   * A JSON result is written to stdout for each job.
+   * Returns EXIT_FAILURE if any job failed
+   */
+  int RunBatch();
+
+  /**
+   * Internal method used to stream the frames to the client of the remote server, applying the
+   * commands and camera moves it sends, until the process is terminated.
+   * Returns EXIT_FAILURE if the port cannot be listened
+   */
+  int RunRemoteServer();
+
+  /**
+   * Internal event loop that is triggered on demand to handle specific events:
    * - Render
    * - ReloadFile
    */
   void EventLoop();
+
+  /**
+   * Internal method scheduling the event loop on the next iteration of the interactor,
+   * if it is not already scheduled. Does nothing if the interactor is not started.
+   */
+  void ScheduleEventLoop();
+
+  /**
+   * Internal method checking the pending screenshot saves periodically until all are done.
+   */
+  void SchedulePendingSavesCheck();
+
+  /**
+   * Internal method adding the files found by the background folder scans, in order.
+   */
+  void MergeFolderScans();
+
+  /**
+   * Internal method merging the background folder scans periodically until all are done.
+   */
+  void ScheduleFolderScansMerge();
 };
 
 #endif
@@ -119,6 +119,47 @@ fs::path F3DSystemTools::GetUserConfigFileDirectory()
   return dirPath;
 }
 
+//----------------------------------------------------------------------------
+fs::path F3DSystemTools::GetUserCacheDirectory()
+{
+  std::string applicationName = "f3d";
+  fs::path dirPath;
+#if defined(_WIN32)
+  const char* localAppData = std::getenv("LOCALAPPDATA");
+  if (!localAppData)
+  {
+    return {};
+  }
+  dirPath = fs::path(localAppData);
+#else
+  const char* home = std::getenv("HOME");
+#if defined(__APPLE__)
+  if (!home || strlen(home) == 0)
+  {
+    return {};
+  }
+  dirPath = fs::path(home) / "Library" / "Caches";
+#else
+  // Implementing XDG specifications
+  const char* xdgCacheHome = std::getenv("XDG_CACHE_HOME");
+  if (xdgCacheHome && strlen(xdgCacheHome) > 0)
+  {
+    dirPath = fs::path(xdgCacheHome);
+  }
+  else
+  {
+    if (!home || strlen(home) == 0)
+    {
+      return {};
+    }
+    dirPath = fs::path(home) / ".cache";
+  }
+#endif
+#endif
+  dirPath /= applicationName;
+  return dirPath;
+}
+
 //----------------------------------------------------------------------------
 fs::path F3DSystemTools::GetBinaryResourceDirectory()
 {
@@ -16,6 +16,7 @@ namespace F3DSystemTools
 std::filesystem::path GetApplicationPath();
 std::vector<std::string> GetVectorEnvironnementVariable(const std::string& envVar);
 std::filesystem::path GetUserConfigFileDirectory();
+std::filesystem::path GetUserCacheDirectory();
 std::filesystem::path GetBinaryResourceDirectory();
 }
 
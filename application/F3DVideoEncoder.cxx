@@ -0,0 +1,141 @@
+#include "F3DVideoEncoder.h"
+
+#include "log.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <sstream>
+
+#if defined(_WIN32)
+#define popen _popen
+#define pclose _pclose
+#endif
+
+namespace fs = std::filesystem;
+
+//----------------------------------------------------------------------------
+F3DVideoEncoder::~F3DVideoEncoder()
+{
+  if (this->Pipe)
+  {
+    this->Close();
+  }
+}
+
+//----------------------------------------------------------------------------
+bool F3DVideoEncoder::IsVideoFile(const fs::path& path)
+{
+  std::string ext = path.extension().string();
+  std::transform(
+    ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return std::tolower(c); });
+
+  constexpr std::array<const char*, 5> videoExtensions = { ".mp4", ".mkv", ".mov", ".webm",
+    ".avi" };
+  return std::find(videoExtensions.begin(), videoExtensions.end(), ext) != videoExtensions.end();
+}
+
+//----------------------------------------------------------------------------
+void F3DVideoEncoder::Open(const fs::path& path, double frameRate, const std::string& codec)
+{
+  this->Path = path;
+  this->FrameRate = frameRate;
+  this->Codec = codec;
+  this->Success = true;
+}
+
+//----------------------------------------------------------------------------
+bool F3DVideoEncoder::Start(const f3d::image& frame)
+{
+  this->Width = frame.getWidth();
+  this->Height = frame.getHeight();
+  this->ChannelCount = frame.getChannelCount();
+
+  // the images are stored from the bottom row, most codecs expect an even size
+  // and VAAPI encoders expect the frames to be uploaded to the GPU first
+  const bool vaapi = this->Codec.find("vaapi") != std::string::npos;
+  std::stringstream cmd;
+  cmd << "ffmpeg -hide_banner -loglevel error -y";
+  if (vaapi)
+  {
+    cmd << " -vaapi_device /dev/dri/renderD128";
+  }
+  cmd << " -f rawvideo -pix_fmt " << (this->ChannelCount == 4 ? "rgba" : "rgb24") << " -s "
+      << this->Width << "x" << this->Height << " -framerate " << this->FrameRate
+      << " -i - -vf \"vflip,pad=ceil(iw/2)*2:ceil(ih/2)*2"
+      << (vaapi ? ",format=nv12,hwupload" : ",format=yuv420p") << "\" -c:v " << this->Codec
+      << " \"" << this->Path.string() << "\"";
+
+  f3d::log::debug("Starting video encoder: ", cmd.str());
+#if defined(_WIN32)
+  this->Pipe = popen(cmd.str().c_str(), "wb");
+#else
+  this->Pipe = popen(cmd.str().c_str(), "w");
+#endif
+  if (!this->Pipe)
+  {
+    f3d::log::error("Cannot start ffmpeg to encode ", this->Path.string(),
+      ", make sure it is installed and in the PATH");
+    return false;
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool F3DVideoEncoder::AddFrame(f3d::image frame)
+{
+  if (this->PendingWrite.valid())
+  {
+    this->Success = this->PendingWrite.get() && this->Success;
+  }
+  if (!this->Success)
+  {
+    return false;
+  }
+
+  if (!this->Pipe && !this->Start(frame))
+  {
+    this->Success = false;
+    return false;
+  }
+
+  if (frame.getWidth() != this->Width || frame.getHeight() != this->Height ||
+    frame.getChannelCount() != this->ChannelCount ||
+    frame.getChannelType() != f3d::image::ChannelType::BYTE)
+  {
+    f3d::log::error("All the frames of a video must have the same size and channel count");
+    this->Success = false;
+    return false;
+  }
+
+  this->PendingWrite = std::async(std::launch::async,
+    [this, frame = std::move(frame)]()
+    {
+      const size_t size =
+        static_cast<size_t>(this->Width) * this->Height * this->ChannelCount;
+      return std::fwrite(frame.getContent(), 1, size, this->Pipe) == size;
+    });
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool F3DVideoEncoder::Close()
+{
+  if (this->PendingWrite.valid())
+  {
+    this->Success = this->PendingWrite.get() && this->Success;
+  }
+  if (!this->Pipe)
+  {
+    return false;
+  }
+
+  int status = pclose(this->Pipe);
+  this->Pipe = nullptr;
+  if (status != 0)
+  {
+    f3d::log::error("ffmpeg failed to encode ", this->Path.string());
+    this->Success = false;
+  }
+  return this->Success;
+}
@@ -0,0 +1,69 @@
+/**
+ * @class   F3DVideoEncoder
+ * @brief   A frame sink encoding the rendered frames into a video file
+ *
+ * The frames are streamed as raw pixels to the standard input of an ffmpeg process,
+ * which encodes them with the requested codec. Writing a frame is asynchronous,
+ * so that it overlaps with the rendering of the next one.
+ */
+
+#ifndef F3DVideoEncoder_h
+#define F3DVideoEncoder_h
+
+#include "image.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <future>
+#include <string>
+
+class F3DVideoEncoder
+{
+public:
+  F3DVideoEncoder() = default;
+  ~F3DVideoEncoder();
+
+  F3DVideoEncoder(const F3DVideoEncoder&) = delete;
+  F3DVideoEncoder& operator=(const F3DVideoEncoder&) = delete;
+
+  /**
+   * Return true if the extension of the path is a video container supported by the encoder.
+   */
+  static bool IsVideoFile(const std::filesystem::path& path);
+
+  /**
+   * Start the encoder process writing into path at the provided frame rate, using the codec,
+   * eg: libx264, libx265, libaom-av1 or a hardware encoder like h264_nvenc or h264_vaapi.
+   * The frame size is set by the first frame.
+   */
+  void Open(const std::filesystem::path& path, double frameRate, const std::string& codec);
+
+  /**
+   * Send a frame to the encoder once the previous one is written.
+   * All the frames must have the same size and channel count.
+   * Return false if the previous frame could not be written.
+   */
+  bool AddFrame(f3d::image frame);
+
+  /**
+   * Wait for the last frame, then close the encoder and wait for the end of the encoding.
+   * Return true if the video was encoded successfully.
+   */
+  bool Close();
+
+private:
+  bool Start(const f3d::image& frame);
+
+  std::filesystem::path Path;
+  double FrameRate = 30.0;
+  std::string Codec;
+
+  FILE* Pipe = nullptr;
+  unsigned int Width = 0;
+  unsigned int Height = 0;
+  unsigned int ChannelCount = 0;
+  std::future<bool> PendingWrite;
+  bool Success = true;
+};
+
+#endif
@@ -0,0 +1,174 @@
+/**
+ * Test of F3DSharedMemoryOutput, reading back the header and the slots of the shared memory
+ * object. Without arguments, frames are written then read. With `<output> <width> <height>`,
+ * the last frame written by f3d in the `<output>` object is checked, then the object is removed.
+ */
+
+#include "F3DSharedMemoryOutput.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+using Header = F3DSharedMemoryOutput::Header;
+using Slot = F3DSharedMemoryOutput::Slot;
+
+//----------------------------------------------------------------------------
+/**
+ * Map a copy of the shared memory object, empty if it cannot be read
+ */
+std::vector<char> ReadObject(const std::string& output)
+{
+  const std::string name = "/" + output.substr(std::strlen("shm://"));
+  int fd = shm_open(name.c_str(), O_RDONLY, 0);
+  if (fd < 0)
+  {
+    return {};
+  }
+
+  std::vector<char> content;
+  struct stat info;
+  if (fstat(fd, &info) == 0 && info.st_size > 0)
+  {
+    void* memory = mmap(nullptr, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    if (memory != MAP_FAILED)
+    {
+      content.assign(static_cast<char*>(memory), static_cast<char*>(memory) + info.st_size);
+      munmap(memory, info.st_size);
+    }
+  }
+  close(fd);
+  return content;
+}
+
+//----------------------------------------------------------------------------
+const Slot* GetSlot(const std::vector<char>& content, uint64_t frameId)
+{
+  const Header* header = reinterpret_cast<const Header*>(content.data());
+  return reinterpret_cast<const Slot*>(content.data() + header->HeaderSize +
+    ((frameId - 1) % header->SlotCount) * (sizeof(Slot) + header->SlotSize));
+}
+
+//----------------------------------------------------------------------------
+bool CheckHeader(const std::vector<char>& content, uint32_t slotCount, uint64_t lastFrameId)
+{
+  if (content.size() < sizeof(Header))
+  {
+    std::cerr << "Cannot read the shared memory object" << std::endl;
+    return false;
+  }
+  const Header* header = reinterpret_cast<const Header*>(content.data());
+  if (std::memcmp(header->Magic, "F3DS", 4) != 0 || header->Version != 1 ||
+    header->HeaderSize != 64 || header->SlotCount != slotCount ||
+    header->LastFrameId != lastFrameId || header->SlotSize % 64 != 0 ||
+    content.size() != header->HeaderSize + slotCount * (sizeof(Slot) + header->SlotSize))
+  {
+    std::cerr << "Unexpected shared memory header" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool CheckSlot(const Slot* slot, uint64_t frameId, uint32_t width, uint32_t height,
+  uint32_t channelCount)
+{
+  if (slot->Sequence % 2 != 0 || slot->FrameId != frameId || slot->Width != width ||
+    slot->Height != height || slot->ChannelCount != channelCount || slot->ChannelType != 0 ||
+    slot->Size != static_cast<uint64_t>(width) * height * channelCount)
+  {
+    std::cerr << "Unexpected shared memory slot of frame " << frameId << std::endl;
+    return false;
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+int TestWriteFrames()
+{
+  const std::string output = "shm://f3d-TestSharedMemoryOutput";
+  F3DSharedMemoryOutput sharedMemory;
+  if (F3DSharedMemoryOutput::IsSharedMemoryOutput("f3d.png") ||
+    !F3DSharedMemoryOutput::IsSharedMemoryOutput(output) || sharedMemory.Open("shm://") ||
+    !sharedMemory.Open(output, 2))
+  {
+    std::cerr << "Cannot open the shared memory output" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // the second frame fits in the slots of the first one, the third one resizes the object
+  f3d::image small(4, 2, 3);
+  std::vector<unsigned char> pixels(4 * 2 * 3);
+  for (size_t i = 0; i < pixels.size(); i++)
+  {
+    pixels[i] = static_cast<unsigned char>(i);
+  }
+  small.setContent(pixels.data());
+  if (!sharedMemory.Write(small) || !sharedMemory.Write(small))
+  {
+    std::cerr << "Cannot write the frames" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::vector<char> content = ::ReadObject(output);
+  if (!::CheckHeader(content, 2, 2) || !::CheckSlot(::GetSlot(content, 1), 1, 4, 2, 3) ||
+    !::CheckSlot(::GetSlot(content, 2), 2, 4, 2, 3) ||
+    std::memcmp(::GetSlot(content, 2) + 1, pixels.data(), pixels.size()) != 0)
+  {
+    return EXIT_FAILURE;
+  }
+
+  f3d::image large(16, 8, 4);
+  if (!sharedMemory.Write(large))
+  {
+    std::cerr << "Cannot write the larger frame" << std::endl;
+    return EXIT_FAILURE;
+  }
+  content = ::ReadObject(output);
+  if (!::CheckHeader(content, 2, 3) || !::CheckSlot(::GetSlot(content, 3), 3, 16, 8, 4) ||
+    reinterpret_cast<const Header*>(content.data())->SlotSize != 16 * 8 * 4)
+  {
+    return EXIT_FAILURE;
+  }
+
+  // the object stays after closing, until it is removed
+  sharedMemory.Close();
+  if (::ReadObject(output).empty() || !F3DSharedMemoryOutput::Unlink(output) ||
+    !::ReadObject(output).empty() || F3DSharedMemoryOutput::Unlink(output))
+  {
+    std::cerr << "The shared memory object is not removed by Unlink" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+}
+
+//----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  if (argc == 1)
+  {
+    return ::TestWriteFrames();
+  }
+  if (argc != 4)
+  {
+    std::cerr << "Usage: " << argv[0] << " [<output> <width> <height>]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const std::string output = argv[1];
+  std::vector<char> content = ::ReadObject(output);
+  const bool valid = ::CheckHeader(content, 3, 1) &&
+    ::CheckSlot(::GetSlot(content, 1), 1, std::atoi(argv[2]), std::atoi(argv[3]), 3);
+  F3DSharedMemoryOutput::Unlink(output);
+  return valid ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,186 @@
+/**
+ * Test of F3DVideoEncoder, using a stand-in ffmpeg executable that records its arguments
+ * and copies the raw frames it receives into the output file.
+ * Usage: <temporary directory>
+ */
+
+#include "F3DVideoEncoder.h"
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+//----------------------------------------------------------------------------
+/**
+ * Write a stand-in ffmpeg in the directory and put it first in the PATH.
+ * It fails after reading the frames when F3D_TEST_FFMPEG_FAIL is set.
+ */
+bool InstallStandInEncoder(const fs::path& dir)
+{
+  std::error_code ec;
+  fs::create_directories(dir, ec);
+
+  const fs::path script = dir / "ffmpeg";
+  {
+    std::ofstream file(script);
+    file << "#!/bin/sh\n"
+         << "for last; do :; done\n"
+         << "echo \"$@\" > \"$last.args\"\n"
+         << "cat > \"$last\"\n"
+         << "if [ -n \"$F3D_TEST_FFMPEG_FAIL\" ]; then exit 1; fi\n";
+  }
+  fs::permissions(script, fs::perms::owner_all, fs::perm_options::add, ec);
+
+  const char* path = std::getenv("PATH");
+  const std::string newPath = dir.string() + (path ? std::string(":") + path : std::string());
+  return !ec && setenv("PATH", newPath.c_str(), 1) == 0;
+}
+
+//----------------------------------------------------------------------------
+std::string ReadFile(const fs::path& path)
+{
+  std::ifstream file(path, std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+//----------------------------------------------------------------------------
+f3d::image CreateFrame(unsigned int width, unsigned int height, unsigned char value)
+{
+  f3d::image frame(width, height, 3);
+  std::vector<unsigned char> pixels(static_cast<size_t>(width) * height * 3, value);
+  frame.setContent(pixels.data());
+  return frame;
+}
+}
+
+//----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  if (argc != 2)
+  {
+    std::cerr << "Usage: " << argv[0] << " <temporary directory>" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const fs::path tmp = fs::path(argv[1]) / "TestVideoEncoder";
+
+  if (!F3DVideoEncoder::IsVideoFile("anim.mp4") || !F3DVideoEncoder::IsVideoFile("anim.MKV") ||
+    F3DVideoEncoder::IsVideoFile("anim.png") || F3DVideoEncoder::IsVideoFile("mp4"))
+  {
+    std::cerr << "Unexpected video file detection" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (!::InstallStandInEncoder(tmp / "bin"))
+  {
+    std::cerr << "Cannot install the stand-in encoder" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // the frames are streamed in order, with the size and the format of the first one
+  {
+    const fs::path video = tmp / "frames.mp4";
+    F3DVideoEncoder encoder;
+    encoder.Open(video, 24, "libx264");
+    for (unsigned char i = 0; i < 3; i++)
+    {
+      if (!encoder.AddFrame(::CreateFrame(4, 2, i)))
+      {
+        std::cerr << "Cannot add frame " << static_cast<int>(i) << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+    if (!encoder.Close())
+    {
+      std::cerr << "Cannot close the encoder" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    std::string expected;
+    for (char i = 0; i < 3; i++)
+    {
+      expected.append(4 * 2 * 3, i);
+    }
+    if (::ReadFile(video) != expected)
+    {
+      std::cerr << "The encoder did not receive the frames" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    const std::string args = ::ReadFile(video.string() + ".args");
+    if (args.find("-pix_fmt rgb24 -s 4x2 -framerate 24") == std::string::npos ||
+      args.find("-c:v libx264") == std::string::npos ||
+      args.find("hwupload") != std::string::npos)
+    {
+      std::cerr << "Unexpected encoder arguments: " << args << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // the VAAPI encoders get their frames uploaded to the device
+  {
+    const fs::path video = tmp / "vaapi.mp4";
+    F3DVideoEncoder encoder;
+    encoder.Open(video, 30, "h264_vaapi");
+    if (!encoder.AddFrame(::CreateFrame(4, 2, 0)) || !encoder.Close())
+    {
+      std::cerr << "Cannot encode with a VAAPI codec" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    const std::string args = ::ReadFile(video.string() + ".args");
+    if (args.find("-vaapi_device") == std::string::npos ||
+      args.find("format=nv12,hwupload") == std::string::npos)
+    {
+      std::cerr << "Unexpected VAAPI encoder arguments: " << args << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // a frame of another size is rejected, and so are the next ones
+  {
+    F3DVideoEncoder encoder;
+    encoder.Open(tmp / "size.mp4", 30, "libx264");
+    if (!encoder.AddFrame(::CreateFrame(4, 2, 0)) || encoder.AddFrame(::CreateFrame(2, 2, 0)) ||
+      encoder.AddFrame(::CreateFrame(4, 2, 0)) || encoder.Close())
+    {
+      std::cerr << "A frame of another size is not rejected" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // nothing is encoded without frames
+  {
+    F3DVideoEncoder encoder;
+    encoder.Open(tmp / "empty.mp4", 30, "libx264");
+    if (encoder.Close())
+    {
+      std::cerr << "A video without frames is reported as encoded" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // a failure of the encoder process is reported when closing
+  {
+    setenv("F3D_TEST_FFMPEG_FAIL", "1", 1);
+    F3DVideoEncoder encoder;
+    encoder.Open(tmp / "failure.mp4", 30, "libx264");
+    const bool added = encoder.AddFrame(::CreateFrame(4, 2, 0));
+    const bool closed = encoder.Close();
+    unsetenv("F3D_TEST_FFMPEG_FAIL");
+    if (!added || closed)
+    {
+      std::cerr << "A failure of the encoder is not reported" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,398 @@
+/**
+ * f3d-bench replays an interaction recording against a list of datasets and option profiles,
+ * and reports the load time, the first frame latency, the frame times and the peak memory
+ * of each of them as JSON. Results can be compared against a baseline to detect regressions.
+ *
+ * Each dataset/profile case runs in its own process so that the peak memory and the first frame
+ * latency are not affected by the previous cases.
+ */
+
+#include "F3DSystemTools.h"
+
+#include <camera.h>
+#include <engine.h>
+#include <interactor.h>
+#include <log.h>
+#include <options.h>
+#include <scene.h>
+#include <window.h>
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+// psapi.h must be included after windows.h
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace
+{
+constexpr const char* USAGE =
+  "Usage: f3d-bench <config.json> [--output=<results.json>] [--baseline=<baseline.json>] "
+  "[--tolerance=<ratio>] [--warn-only]";
+
+// metrics compared against the baseline, a higher value is a regression for all of them
+constexpr const char* METRICS[] = { "load_time", "first_frame_time", "interaction_time",
+  "frame_time_mean", "frame_time_p99", "peak_memory" };
+
+//----------------------------------------------------------------------------
+using BenchClock = std::chrono::steady_clock;
+double ElapsedMilliseconds(BenchClock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(BenchClock::now() - start).count();
+}
+
+//----------------------------------------------------------------------------
+std::size_t GetPeakMemory()
+{
+#if defined(_WIN32)
+  PROCESS_MEMORY_COUNTERS counters;
+  if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+  {
+    return counters.PeakWorkingSetSize;
+  }
+  return 0;
+#else
+  rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+  {
+    return 0;
+  }
+#ifdef __APPLE__
+  return static_cast<std::size_t>(usage.ru_maxrss);
+#else
+  return static_cast<std::size_t>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+//----------------------------------------------------------------------------
+nlohmann::json ReadJSON(const fs::path& path)
+{
+  std::ifstream file(path);
+  if (!file.is_open())
+  {
+    throw std::runtime_error("Cannot open " + path.string());
+  }
+  return nlohmann::json::parse(file);
+}
+
+//----------------------------------------------------------------------------
+struct BenchCase
+{
+  std::string Dataset;
+  std::string Profile;
+  nlohmann::json Options;
+};
+
+//----------------------------------------------------------------------------
+/**
+ * List the cases of the configuration, every dataset with every profile
+ */
+std::vector<BenchCase> GetCases(const nlohmann::json& config)
+{
+  nlohmann::json profiles = config.value("profiles", nlohmann::json::object());
+  if (profiles.empty())
+  {
+    profiles["default"] = nlohmann::json::object();
+  }
+
+  std::vector<BenchCase> cases;
+  for (const std::string& dataset : config.at("datasets").get<std::vector<std::string>>())
+  {
+    for (const auto& [name, options] : profiles.items())
+    {
+      cases.push_back({ dataset, name, options });
+    }
+  }
+  return cases;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * Run a single case in the current process and return its results
+ */
+nlohmann::json RunCase(const nlohmann::json& config, const fs::path& configDir, const BenchCase& bench)
+{
+  const int frames = config.value("frames", 100);
+  const std::vector<int> resolution = config.value("resolution", std::vector<int>{ 1000, 600 });
+  if (resolution.size() != 2)
+  {
+    throw std::runtime_error("resolution must contain two values");
+  }
+
+  f3d::engine::autoloadPlugins();
+
+  BenchClock::time_point start = BenchClock::now();
+  f3d::engine eng = f3d::engine::create(true);
+  double engineTime = ::ElapsedMilliseconds(start);
+
+  f3d::options& options = eng.getOptions();
+  for (const auto& [name, value] : bench.Options.items())
+  {
+    options.setAsString(name, value.is_string() ? value.get<std::string>() : value.dump());
+  }
+
+  f3d::window& win = eng.getWindow();
+  win.setSize(resolution[0], resolution[1]);
+
+  start = BenchClock::now();
+  eng.getScene().add(configDir / bench.Dataset);
+  double loadTime = ::ElapsedMilliseconds(start);
+
+  start = BenchClock::now();
+  win.render();
+  double firstFrameTime = ::ElapsedMilliseconds(start);
+
+  double interactionTime = 0;
+  if (config.contains("recording"))
+  {
+    fs::path recording = configDir / config.at("recording").get<std::string>();
+    start = BenchClock::now();
+    if (!eng.getInteractor().playInteraction(recording.string()))
+    {
+      throw std::runtime_error("Cannot play " + recording.string());
+    }
+    interactionTime = ::ElapsedMilliseconds(start);
+  }
+
+  // a full orbit around the model, so the frame times do not depend on the recording
+  std::vector<double> frameTimes;
+  f3d::camera& cam = win.getCamera();
+  for (int i = 0; i < frames; i++)
+  {
+    cam.azimuth(360.0 / frames);
+    start = BenchClock::now();
+    win.render();
+    frameTimes.push_back(::ElapsedMilliseconds(start));
+  }
+
+  double mean = 0;
+  double p99 = 0;
+  if (!frameTimes.empty())
+  {
+    mean = std::accumulate(frameTimes.begin(), frameTimes.end(), 0.0) / frameTimes.size();
+    std::sort(frameTimes.begin(), frameTimes.end());
+    std::size_t rank = static_cast<std::size_t>(std::ceil(0.99 * frameTimes.size()));
+    p99 = frameTimes[std::max<std::size_t>(rank, 1) - 1];
+  }
+
+  return { { "dataset", bench.Dataset }, { "profile", bench.Profile },
+    { "engine_time", engineTime }, { "load_time", loadTime },
+    { "first_frame_time", firstFrameTime }, { "interaction_time", interactionTime },
+    { "frames", frames }, { "frame_time_mean", mean }, { "frame_time_p99", p99 },
+    { "peak_memory", ::GetPeakMemory() } };
+}
+
+//----------------------------------------------------------------------------
+/**
+ * Run a case in a child process and return its results
+ */
+nlohmann::json RunCaseProcess(const fs::path& configPath, std::size_t index)
+{
+  fs::path resultPath =
+    fs::temp_directory_path() / ("f3d-bench-" + std::to_string(index) + ".json");
+  fs::remove(resultPath);
+
+  std::string command = "\"" + F3DSystemTools::GetApplicationPath().string() +
+    "\" --run-case=" + std::to_string(index) + " \"" + configPath.string() + "\" \"" +
+    resultPath.string() + "\"";
+#if defined(_WIN32)
+  // cmd removes the first and last quotes of the command
+  command = "\"" + command + "\"";
+#endif
+
+  if (std::system(command.c_str()) != 0 || !fs::exists(resultPath))
+  {
+    throw std::runtime_error("The benchmark process failed");
+  }
+
+  nlohmann::json result = ::ReadJSON(resultPath);
+  fs::remove(resultPath);
+  return result;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * Compare the results against the baseline and print the regressions.
+ * Return the number of regressions.
+ */
+int CompareBaseline(const nlohmann::json& results, const nlohmann::json& baseline, double tolerance)
+{
+  int regressions = 0;
+  for (const nlohmann::json& result : results.at("results"))
+  {
+    auto reference = std::find_if(baseline.at("results").begin(), baseline.at("results").end(),
+      [&](const nlohmann::json& ref)
+      {
+        return ref.value("dataset", "") == result.value("dataset", "") &&
+          ref.value("profile", "") == result.value("profile", "");
+      });
+
+    const std::string caseName =
+      result.value("dataset", "") + " (" + result.value("profile", "") + ")";
+    if (reference == baseline.at("results").end())
+    {
+      f3d::log::warn(caseName, ": not found in the baseline");
+      continue;
+    }
+
+    for (const char* metric : ::METRICS)
+    {
+      if (!result.contains(metric) || !reference->contains(metric))
+      {
+        continue;
+      }
+
+      double value = result.at(metric).get<double>();
+      double ref = reference->at(metric).get<double>();
+      if (ref > 0 && value > ref * (1.0 + tolerance))
+      {
+        f3d::log::error(caseName, ": ", metric, " regressed from ", ref, " to ", value, " (+",
+          std::round((value / ref - 1.0) * 100), "%)");
+        regressions++;
+      }
+    }
+  }
+  return regressions;
+}
+
+//----------------------------------------------------------------------------
+int Run(int argc, char** argv)
+{
+  std::vector<std::string> args(argv + 1, argv + argc);
+  auto getArg = [&](const std::string& name) -> std::string
+  {
+    const std::string prefix = "--" + name + "=";
+    for (const std::string& arg : args)
+    {
+      if (arg.rfind(prefix, 0) == 0)
+      {
+        return arg.substr(prefix.size());
+      }
+    }
+    return {};
+  };
+
+  std::vector<std::string> positionals;
+  std::copy_if(args.begin(), args.end(), std::back_inserter(positionals),
+    [](const std::string& arg) { return arg.rfind("--", 0) != 0; });
+
+  f3d::log::setVerboseLevel(f3d::log::VerboseLevel::WARN);
+
+  // internal mode used by RunCaseProcess
+  std::string caseIndex = getArg("run-case");
+  if (!caseIndex.empty())
+  {
+    if (positionals.size() != 2)
+    {
+      f3d::log::error(::USAGE);
+      return EXIT_FAILURE;
+    }
+    fs::path configPath = fs::absolute(positionals[0]);
+    nlohmann::json config = ::ReadJSON(configPath);
+    std::vector<BenchCase> cases = ::GetCases(config);
+    std::size_t index = std::stoul(caseIndex);
+    if (index >= cases.size())
+    {
+      f3d::log::error("Invalid case index ", index);
+      return EXIT_FAILURE;
+    }
+
+    nlohmann::json result = ::RunCase(config, configPath.parent_path(), cases[index]);
+    std::ofstream(positionals[1]) << result.dump();
+    return EXIT_SUCCESS;
+  }
+
+  if (positionals.size() != 1)
+  {
+    f3d::log::error(::USAGE);
+    return EXIT_FAILURE;
+  }
+
+  fs::path configPath = fs::absolute(positionals[0]);
+  nlohmann::json config = ::ReadJSON(configPath);
+  std::vector<BenchCase> cases = ::GetCases(config);
+
+  f3d::engine::libInformation info = f3d::engine::getLibInfo();
+  nlohmann::json results = { { "f3d_version", info.VersionFull },
+    { "vtk_version", info.VTKVersion }, { "results", nlohmann::json::array() } };
+
+  int failures = 0;
+  for (std::size_t i = 0; i < cases.size(); i++)
+  {
+    try
+    {
+      results["results"].push_back(::RunCaseProcess(configPath, i));
+    }
+    catch (const std::exception& ex)
+    {
+      f3d::log::error(cases[i].Dataset, " (", cases[i].Profile, "): ", ex.what());
+      results["results"].push_back(
+        { { "dataset", cases[i].Dataset }, { "profile", cases[i].Profile }, { "error", ex.what() } });
+      failures++;
+    }
+  }
+
+  std::string output = getArg("output");
+  if (output.empty())
+  {
+    std::cout << results.dump(2) << std::endl;
+  }
+  else
+  {
+    std::ofstream(output) << results.dump(2) << std::endl;
+  }
+
+  std::string baseline = getArg("baseline");
+  if (!baseline.empty())
+  {
+    std::string tolerance = getArg("tolerance");
+    int regressions =
+      ::CompareBaseline(results, ::ReadJSON(baseline), tolerance.empty() ? 0.1 : std::stod(tolerance));
+    if (regressions > 0 && std::find(args.begin(), args.end(), "--warn-only") != args.end())
+    {
+      f3d::log::warn(regressions, " regression(s) reported as warnings");
+    }
+    else
+    {
+      failures += regressions;
+    }
+  }
+
+  return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+}
+
+//----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  try
+  {
+    return ::Run(argc, argv);
+  }
+  catch (const std::exception& ex)
+  {
+    f3d::log::error("f3d-bench encountered an unexpected exception:");
+    f3d::log::error(ex.what());
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,593 @@
+/**
+ * f3d-microbench times the hot kernels of the VTK extensions and libf3d in isolation, each one
+ * on synthetic inputs of several sizes, and reports their timings as JSON. Results can be
+ * compared against a baseline to detect regressions, like f3d-bench.
+ *
+ * Each kernel has an untimed reset step, restoring its input before each timed run, so that
+ * the timings only measure the kernel itself.
+ */
+
+#include "F3DColoringInfoHandler.h"
+#include "vtkF3DFaceVaryingPointDispatcher.h"
+#include "vtkF3DMemoryMesh.h"
+#include "vtkF3DSplatReader.h"
+
+#include <engine.h>
+#include <image.h>
+#include <log.h>
+
+#include <vtkActor.h>
+#include <vtkCamera.h>
+#include <vtkCellArray.h>
+#include <vtkFloatArray.h>
+#include <vtkInformation.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkRenderWindow.h>
+#include <vtkRenderer.h>
+#include <vtkRendererCollection.h>
+#include <vtkVersion.h>
+
+#if !defined(__ANDROID__) && !defined(__EMSCRIPTEN__) &&                                           \
+  VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240203)
+#define F3D_MICROBENCH_COMPUTE
+#include "vtkF3DBitonicSort.h"
+#include "vtkF3DPointSplatMapper.h"
+
+#include <vtkOpenGLBufferObject.h>
+#include <vtkOpenGLRenderWindow.h>
+#include <vtkShader.h>
+#endif
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+constexpr const char* USAGE =
+  "Usage: f3d-microbench [--filter=<substring>] [--min-time=<ms>] [--output=<results.json>] "
+  "[--baseline=<baseline.json>] [--tolerance=<ratio>] [--warn-only]";
+
+// the synthetic inputs are the same for every run, so that results can be compared
+constexpr unsigned int SEED = 42;
+
+//----------------------------------------------------------------------------
+using BenchClock = std::chrono::steady_clock;
+
+/**
+ * A kernel to time, Reset is called before each Run and is not timed.
+ * A kernel without Run is skipped, eg. when compute shaders are not supported.
+ */
+struct Kernel
+{
+  std::function<void()> Reset;
+  std::function<void()> Run;
+};
+
+struct Benchmark
+{
+  std::string Name;
+  std::function<Kernel()> Setup;
+};
+
+//----------------------------------------------------------------------------
+std::vector<float> RandomFloats(std::size_t count, float min, float max)
+{
+  std::mt19937 rng(::SEED);
+  std::uniform_real_distribution<float> dist(min, max);
+  std::vector<float> values(count);
+  std::generate(values.begin(), values.end(), [&]() { return dist(rng); });
+  return values;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * A grid of size x size quads, in a polydata or as the face sizes and indices of a memory mesh
+ */
+std::vector<float> GridPoints(int size)
+{
+  std::vector<float> positions;
+  positions.reserve(3 * static_cast<std::size_t>(size + 1) * (size + 1));
+  for (int j = 0; j <= size; j++)
+  {
+    for (int i = 0; i <= size; i++)
+    {
+      positions.insert(positions.end(), { static_cast<float>(i), static_cast<float>(j), 0.f });
+    }
+  }
+  return positions;
+}
+
+std::vector<unsigned int> GridQuads(int size)
+{
+  std::vector<unsigned int> indices;
+  indices.reserve(4 * static_cast<std::size_t>(size) * size);
+  const unsigned int row = static_cast<unsigned int>(size + 1);
+  for (unsigned int j = 0; j < static_cast<unsigned int>(size); j++)
+  {
+    for (unsigned int i = 0; i < static_cast<unsigned int>(size); i++)
+    {
+      const unsigned int p = j * row + i;
+      indices.insert(indices.end(), { p, p + 1, p + row + 1, p + row });
+    }
+  }
+  return indices;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * A .splat file content with count random splats of 32 bytes each
+ */
+std::vector<unsigned char> SplatBuffer(std::size_t count)
+{
+  std::vector<float> floats = ::RandomFloats(6 * count, -1.f, 1.f);
+  std::vector<unsigned char> buffer(32 * count);
+  std::mt19937 rng(::SEED);
+  std::uniform_int_distribution<int> bytes(0, 255);
+  for (std::size_t i = 0; i < count; i++)
+  {
+    unsigned char* splat = buffer.data() + 32 * i;
+    std::memcpy(splat, floats.data() + 6 * i, 3 * sizeof(float));
+    for (int c = 0; c < 3; c++)
+    {
+      // positive scales
+      float scale = 0.01f + 0.01f * std::abs(floats[6 * i + 3 + c]);
+      std::memcpy(splat + 12 + c * sizeof(float), &scale, sizeof(float));
+    }
+    for (int c = 24; c < 32; c++)
+    {
+      splat[c] = static_cast<unsigned char>(bytes(rng));
+    }
+  }
+  return buffer;
+}
+
+//----------------------------------------------------------------------------
+Kernel SplatReaderKernel(std::size_t count)
+{
+  auto buffer = std::make_shared<std::vector<unsigned char>>(::SplatBuffer(count));
+  vtkSmartPointer<vtkF3DSplatReader> reader = vtkSmartPointer<vtkF3DSplatReader>::New();
+  reader->SetBuffer(buffer->data(), buffer->size());
+  return { [reader]() { reader->Modified(); }, [reader, buffer]() { reader->Update(); } };
+}
+
+//----------------------------------------------------------------------------
+Kernel MemoryMeshSetFacesKernel(int size)
+{
+  // quads split in two triangles every other row, so that face offsets are not analytic
+  auto positions = std::make_shared<std::vector<float>>(::GridPoints(size));
+  std::vector<unsigned int> quads = ::GridQuads(size);
+  auto sizes = std::make_shared<std::vector<unsigned int>>();
+  auto indices = std::make_shared<std::vector<unsigned int>>();
+  for (std::size_t q = 0; q < quads.size() / 4; q++)
+  {
+    const unsigned int* quad = quads.data() + 4 * q;
+    if ((q / size) % 2 == 0)
+    {
+      sizes->push_back(4);
+      indices->insert(indices->end(), quad, quad + 4);
+    }
+    else
+    {
+      sizes->insert(sizes->end(), { 3, 3 });
+      indices->insert(indices->end(), { quad[0], quad[1], quad[2], quad[0], quad[2], quad[3] });
+    }
+  }
+
+  vtkSmartPointer<vtkF3DMemoryMesh> mesh = vtkSmartPointer<vtkF3DMemoryMesh>::New();
+  return { [mesh, positions]() { mesh->SetPoints(*positions); },
+    [mesh, sizes, indices]()
+    {
+      mesh->SetFaces(*sizes, *indices);
+      mesh->Update();
+    } };
+}
+
+//----------------------------------------------------------------------------
+Kernel FaceVaryingDispatcherKernel(int size, bool weld)
+{
+  std::vector<float> positions = ::GridPoints(size);
+  std::vector<unsigned int> quads = ::GridQuads(size);
+
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToFloat();
+  points->SetNumberOfPoints(static_cast<vtkIdType>(positions.size() / 3));
+  std::copy(positions.begin(), positions.end(),
+    static_cast<float*>(points->GetData()->GetVoidPointer(0)));
+
+  vtkNew<vtkCellArray> polys;
+  for (std::size_t q = 0; q < quads.size() / 4; q++)
+  {
+    vtkIdType ids[4] = { quads[4 * q], quads[4 * q + 1], quads[4 * q + 2], quads[4 * q + 3] };
+    polys->InsertNextCell(4, ids);
+  }
+
+  // face-varying texture coordinates, continuous inside each row of quads only
+  vtkNew<vtkFloatArray> tcoords;
+  tcoords->SetName("st");
+  tcoords->SetNumberOfComponents(2);
+  tcoords->SetNumberOfTuples(static_cast<vtkIdType>(quads.size()));
+  for (std::size_t c = 0; c < quads.size(); c++)
+  {
+    const float* point = positions.data() + 3 * quads[c];
+    const float row = static_cast<float>((c / 4) / size);
+    tcoords->SetTuple2(static_cast<vtkIdType>(c), point[0], point[1] == row ? 0.f : 1.f);
+  }
+  tcoords->GetInformation()->Set(vtkF3DFaceVaryingPointDispatcher::INTERPOLATION_TYPE(), 1);
+
+  vtkNew<vtkPolyData> polyData;
+  polyData->SetPoints(points);
+  polyData->SetPolys(polys);
+  polyData->GetPointData()->AddArray(tcoords);
+
+  vtkSmartPointer<vtkF3DFaceVaryingPointDispatcher> dispatcher =
+    vtkSmartPointer<vtkF3DFaceVaryingPointDispatcher>::New();
+  dispatcher->SetInputData(polyData);
+  dispatcher->SetWeld(weld);
+  return { [dispatcher]() { dispatcher->Modified(); },
+    [dispatcher]() { dispatcher->Update(); } };
+}
+
+//----------------------------------------------------------------------------
+Kernel ColoringInfoKernel(vtkIdType count)
+{
+  // a few scalar and vector arrays, the ranges are computed when the coloring is recovered
+  vtkNew<vtkPolyData> polyData;
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(count);
+  polyData->SetPoints(points);
+  for (int a = 0; a < 8; a++)
+  {
+    const int nbComponents = a % 2 == 0 ? 1 : 3;
+    std::vector<float> values =
+      ::RandomFloats(static_cast<std::size_t>(count) * nbComponents, -1.f, 1.f);
+    vtkNew<vtkFloatArray> array;
+    array->SetName(("array" + std::to_string(a)).c_str());
+    array->SetNumberOfComponents(nbComponents);
+    array->SetNumberOfTuples(count);
+    std::copy(values.begin(), values.end(), array->GetPointer(0));
+    polyData->GetPointData()->AddArray(array);
+  }
+
+  auto handler = std::make_shared<F3DColoringInfoHandler>();
+  vtkSmartPointer<vtkPolyData> dataset = polyData.Get();
+  return { [handler]() { handler->ClearColoringInfo(); },
+    [handler, dataset]()
+    {
+      handler->UpdateColoringInfo(dataset, false);
+      for (int a = 0; a < 8; a++)
+      {
+        handler->SetCurrentColoring(true, false, "array" + std::to_string(a), true);
+      }
+    } };
+}
+
+//----------------------------------------------------------------------------
+Kernel ImageCompareKernel(unsigned int size)
+{
+  std::vector<float> noise = ::RandomFloats(3 * static_cast<std::size_t>(size) * size, 0, 255);
+  auto reference = std::make_shared<f3d::image>(size, size, 3);
+  auto other = std::make_shared<f3d::image>(size, size, 3);
+  auto* referenceContent = static_cast<unsigned char*>(reference->getContent());
+  auto* otherContent = static_cast<unsigned char*>(other->getContent());
+  for (std::size_t i = 0; i < noise.size(); i++)
+  {
+    referenceContent[i] = static_cast<unsigned char>(noise[i]);
+    otherContent[i] = static_cast<unsigned char>(255.f - noise[i]);
+  }
+  return { nullptr,
+    [reference, other]()
+    {
+      double error;
+      reference->compare(*other, 0.05, error);
+    } };
+}
+
+#ifdef F3D_MICROBENCH_COMPUTE
+//----------------------------------------------------------------------------
+/**
+ * Return a shared OpenGL context, or nullptr if compute shaders are not supported
+ */
+vtkRenderWindow* GetComputeContext()
+{
+  static vtkSmartPointer<vtkRenderWindow> renWin;
+  if (!renWin)
+  {
+    renWin = vtkSmartPointer<vtkRenderWindow>::New();
+    renWin->SetSize(640, 480);
+    renWin->OffScreenRenderingOn();
+    renWin->Start();
+  }
+  return vtkShader::IsComputeShaderSupported() ? renWin.Get() : nullptr;
+}
+
+//----------------------------------------------------------------------------
+Kernel BitonicSortKernel(int count)
+{
+  vtkOpenGLRenderWindow* context = vtkOpenGLRenderWindow::SafeDownCast(::GetComputeContext());
+  vtkSmartPointer<vtkF3DBitonicSort> sorter = vtkSmartPointer<vtkF3DBitonicSort>::New();
+  if (!context || !sorter->Initialize(128, VTK_FLOAT, VTK_UNSIGNED_INT))
+  {
+    return {};
+  }
+
+  auto keys = std::make_shared<std::vector<float>>(::RandomFloats(count, 0.f, 1.f));
+  auto values = std::make_shared<std::vector<unsigned int>>(count);
+  std::iota(values->begin(), values->end(), 0u);
+  vtkSmartPointer<vtkOpenGLBufferObject> keysBuffer =
+    vtkSmartPointer<vtkOpenGLBufferObject>::New();
+  vtkSmartPointer<vtkOpenGLBufferObject> valuesBuffer =
+    vtkSmartPointer<vtkOpenGLBufferObject>::New();
+
+  // the buffers are sorted in place, so they are uploaded again before each run
+  return { [=]()
+    {
+      context->MakeCurrent();
+      keysBuffer->Upload(*keys, vtkOpenGLBufferObject::ArrayBuffer);
+      valuesBuffer->Upload(*values, vtkOpenGLBufferObject::ArrayBuffer);
+      context->WaitForCompletion();
+    },
+    [=]()
+    {
+      sorter->Run(context, count, keysBuffer, valuesBuffer);
+      context->WaitForCompletion();
+    } };
+}
+
+//----------------------------------------------------------------------------
+Kernel SplatDepthSortKernel(std::size_t count)
+{
+  vtkRenderWindow* renWin = ::GetComputeContext();
+  if (!renWin)
+  {
+    return {};
+  }
+
+  auto buffer = std::make_shared<std::vector<unsigned char>>(::SplatBuffer(count));
+  vtkNew<vtkF3DSplatReader> reader;
+  reader->SetBuffer(buffer->data(), buffer->size());
+  reader->Update();
+
+  // configured like the gaussian splats of the renderer
+  vtkNew<vtkF3DPointSplatMapper> mapper;
+  mapper->SetInputData(reader->GetOutput());
+  mapper->EmissiveOff();
+  mapper->SetScaleFactor(1.0);
+  mapper->SetSplatShaderCode(nullptr);
+  mapper->SetScaleArray("scale");
+  vtkNew<vtkActor> actor;
+  actor->SetMapper(mapper);
+  actor->ForceTranslucentOn();
+
+  vtkSmartPointer<vtkRenderer> renderer = vtkSmartPointer<vtkRenderer>::New();
+  renderer->AddActor(actor);
+  renWin->GetRenderers()->RemoveAllItems();
+  renWin->AddRenderer(renderer);
+  renderer->ResetCamera();
+  renWin->Render();
+
+  // each run renders a new view direction, so the depths are computed and sorted again
+  return { [renderer]() { renderer->GetActiveCamera()->Azimuth(10.0); },
+    [renWin, renderer]()
+    {
+      renWin->Render();
+      renWin->WaitForCompletion();
+    } };
+}
+#endif
+
+//----------------------------------------------------------------------------
+std::vector<Benchmark> GetBenchmarks()
+{
+  std::vector<Benchmark> benchmarks;
+  for (std::size_t count : { 10000, 100000, 1000000 })
+  {
+    const std::string suffix = "/" + std::to_string(count);
+    benchmarks.push_back({ "SplatReader" + suffix, [=]() { return ::SplatReaderKernel(count); } });
+#ifdef F3D_MICROBENCH_COMPUTE
+    benchmarks.push_back(
+      { "SplatDepthSort" + suffix, [=]() { return ::SplatDepthSortKernel(count); } });
+#endif
+    benchmarks.push_back(
+      { "ColoringInfoHandler" + suffix,
+        [=]() { return ::ColoringInfoKernel(static_cast<vtkIdType>(count)); } });
+  }
+#ifdef F3D_MICROBENCH_COMPUTE
+  for (int count : { 1 << 14, 1 << 17, 1 << 20 })
+  {
+    benchmarks.push_back({ "BitonicSort/" + std::to_string(count),
+      [=]() { return ::BitonicSortKernel(count); } });
+  }
+#endif
+  for (int size : { 100, 1000 })
+  {
+    const std::string suffix = "/" + std::to_string(size) + "x" + std::to_string(size);
+    benchmarks.push_back(
+      { "MemoryMeshSetFaces" + suffix, [=]() { return ::MemoryMeshSetFacesKernel(size); } });
+    benchmarks.push_back({ "FaceVaryingPointDispatcher" + suffix,
+      [=]() { return ::FaceVaryingDispatcherKernel(size, false); } });
+    benchmarks.push_back({ "FaceVaryingPointDispatcherWeld" + suffix,
+      [=]() { return ::FaceVaryingDispatcherKernel(size, true); } });
+  }
+  for (unsigned int size : { 256u, 1024u, 4096u })
+  {
+    benchmarks.push_back({ "ImageCompare/" + std::to_string(size),
+      [=]() { return ::ImageCompareKernel(size); } });
+  }
+  return benchmarks;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * Run the kernel until minTime milliseconds are spent in it, at least 3 times,
+ * after an untimed warm up run
+ */
+nlohmann::json RunBenchmark(const Benchmark& benchmark, double minTime)
+{
+  Kernel kernel = benchmark.Setup();
+  if (!kernel.Run)
+  {
+    return { { "name", benchmark.Name }, { "skipped", true } };
+  }
+
+  std::vector<double> times;
+  double total = 0.0;
+  for (int i = -1; i < 3 || total < minTime; i++)
+  {
+    if (kernel.Reset)
+    {
+      kernel.Reset();
+    }
+    BenchClock::time_point start = BenchClock::now();
+    kernel.Run();
+    double time = std::chrono::duration<double, std::milli>(BenchClock::now() - start).count();
+    if (i >= 0)
+    {
+      times.push_back(time);
+      total += time;
+    }
+  }
+
+  std::sort(times.begin(), times.end());
+  return { { "name", benchmark.Name }, { "iterations", times.size() },
+    { "time_mean", total / times.size() }, { "time_median", times[times.size() / 2] },
+    { "time_min", times.front() }, { "time_max", times.back() } };
+}
+
+//----------------------------------------------------------------------------
+/**
+ * Compare the median times against the baseline, return the number of regressions
+ */
+int CompareBaseline(const nlohmann::json& results, const nlohmann::json& baseline, double tolerance)
+{
+  int regressions = 0;
+  for (const nlohmann::json& result : results.at("results"))
+  {
+    auto it = std::find_if(baseline.at("results").begin(), baseline.at("results").end(),
+      [&](const nlohmann::json& ref) { return ref.value("name", "") == result.at("name"); });
+    if (it == baseline.at("results").end() || !result.contains("time_median") ||
+      !it->contains("time_median"))
+    {
+      continue;
+    }
+
+    const double value = result.at("time_median").get<double>();
+    const double reference = it->at("time_median").get<double>();
+    if (value > reference * (1.0 + tolerance))
+    {
+      f3d::log::error(result.at("name").get<std::string>(), ": time_median regressed from ",
+        reference, " to ", value);
+      regressions++;
+    }
+  }
+  return regressions;
+}
+
+//----------------------------------------------------------------------------
+int Run(int argc, char** argv)
+{
+  std::vector<std::string> args(argv + 1, argv + argc);
+  auto getArg = [&](const std::string& name) -> std::string
+  {
+    const std::string prefix = "--" + name + "=";
+    for (const std::string& arg : args)
+    {
+      if (arg.rfind(prefix, 0) == 0)
+      {
+        return arg.substr(prefix.size());
+      }
+    }
+    return {};
+  };
+
+  if (std::any_of(args.begin(), args.end(),
+        [](const std::string& arg) { return arg.rfind("--", 0) != 0; }))
+  {
+    f3d::log::error(::USAGE);
+    return EXIT_FAILURE;
+  }
+
+  f3d::log::setVerboseLevel(f3d::log::VerboseLevel::WARN);
+
+  const std::string filter = getArg("filter");
+  const std::string minTime = getArg("min-time");
+
+  f3d::engine::libInformation info = f3d::engine::getLibInfo();
+  nlohmann::json results = { { "f3d_version", info.VersionFull },
+    { "vtk_version", info.VTKVersion }, { "results", nlohmann::json::array() } };
+
+  for (const Benchmark& benchmark : ::GetBenchmarks())
+  {
+    if (benchmark.Name.find(filter) != std::string::npos)
+    {
+      results["results"].push_back(
+        ::RunBenchmark(benchmark, minTime.empty() ? 500.0 : std::stod(minTime)));
+    }
+  }
+
+  std::string output = getArg("output");
+  if (output.empty())
+  {
+    std::cout << results.dump(2) << std::endl;
+  }
+  else
+  {
+    std::ofstream(output) << results.dump(2) << std::endl;
+  }
+
+  int failures = 0;
+  std::string baseline = getArg("baseline");
+  if (!baseline.empty())
+  {
+    std::ifstream file(baseline);
+    if (!file.is_open())
+    {
+      f3d::log::error("Cannot open ", baseline);
+      return EXIT_FAILURE;
+    }
+    std::string tolerance = getArg("tolerance");
+    int regressions = ::CompareBaseline(
+      results, nlohmann::json::parse(file), tolerance.empty() ? 0.1 : std::stod(tolerance));
+    if (regressions > 0 && std::find(args.begin(), args.end(), "--warn-only") != args.end())
+    {
+      f3d::log::warn(regressions, " regression(s) reported as warnings");
+    }
+    else
+    {
+      failures += regressions;
+    }
+  }
+
+  return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+}
+
+//----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  try
+  {
+    return ::Run(argc, argv);
+  }
+  catch (const std::exception& ex)
+  {
+    f3d::log::error("f3d-microbench encountered an unexpected exception:");
+    f3d::log::error(ex.what());
+    return EXIT_FAILURE;
+  }
+}
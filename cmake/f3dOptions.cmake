@@ -69,13 +69,8 @@ function (f3d_generate_options)
   file(READ ${_f3d_generate_options_INPUT_JSON} _options_json)
   _parse_json_option(${_options_json})
 
-  list(JOIN _options_setter ";\n    else " _options_setter)
-  list(JOIN _options_getter ";\n  else " _options_getter)
-  list(JOIN _options_string_setter ";\n  else " _options_string_setter)
-  list(JOIN _options_string_getter ";\n  else " _options_string_getter)
   list(JOIN _options_lister ",\n  " _options_lister)
-  list(JOIN _options_is_optional ";\n  else " _options_is_optional)
-  list(JOIN _options_reset ";\n  else " _options_reset)
+  list(JOIN _options_changed ";\n  " _options_changed)
 
   configure_file(
     "${_f3d_generate_options_INPUT_PUBLIC_HEADER}"
@@ -136,23 +131,30 @@ function(_parse_json_option _top_json)
        if(_default_value_error STREQUAL "NOTFOUND")
          # Use default_value
          set(_optional_default_value_initialize "${_option_default_value_start}${_option_default_value}${_option_default_value_end}")
+         set(_option_member_type "${_option_actual_type}")
          string(APPEND _options_struct "${_option_indent}  ${_option_actual_type} ${_member_name} = ${_optional_default_value_initialize};\n")
          set(_optional_getter "")
-         list(APPEND _options_is_optional "if (name == \"${_option_name}\") return false")
-         list(APPEND _options_reset "if (name == \"${_option_name}\") opt.${_option_name} = ${_optional_default_value_initialize}")
+         set(_option_is_optional "false")
+         set(_option_reset "opt.${_option_name} = ${_optional_default_value_initialize}")
        else()
          # No default_value, it is an std::optional
+         set(_option_member_type "std::optional<${_option_actual_type}>")
          string(APPEND _options_struct "${_option_indent}  std::optional<${_option_actual_type}> ${_member_name};\n")
          set(_optional_getter ".value()")
-         list(APPEND _options_is_optional "if (name == \"${_option_name}\") return true")
-         list(APPEND _options_reset "if (name == \"${_option_name}\") opt.${_option_name}.reset()")
+         set(_option_is_optional "true")
+         set(_option_reset "opt.${_option_name}.reset()")
        endif()
 
-       list(APPEND _options_setter "if (name == \"${_option_name}\") opt.${_option_name} = std::get<${_option_variant_type}>(value)")
-       list(APPEND _options_getter "if (name == \"${_option_name}\") return opt.${_option_name}${_optional_getter}")
-       list(APPEND _options_string_setter "if (name == \"${_option_name}\") opt.${_option_name} = options_tools::parse<${_option_actual_type}>(str)")
-       list(APPEND _options_string_getter "if (name == \"${_option_name}\") return options_tools::format(opt.${_option_name}${_optional_getter})")
+       # Add the option accessors to the table, the semicolons in the lambdas prevent using a list
+       string(APPEND _options_entries "  { ${_option_is_optional}, &typeid(${_option_member_type}),\n")
+       string(APPEND _options_entries "    [](options& opt, const option_variant_t& value) { opt.${_option_name} = std::get<${_option_variant_type}>(value); },\n")
+       string(APPEND _options_entries "    [](const options& opt) -> option_variant_t { return opt.${_option_name}${_optional_getter}; },\n")
+       string(APPEND _options_entries "    [](options& opt, const std::string& str) { opt.${_option_name} = options_tools::parse<${_option_actual_type}>(str); },\n")
+       string(APPEND _options_entries "    [](const options& opt) { return options_tools::format(opt.${_option_name}${_optional_getter}); },\n")
+       string(APPEND _options_entries "    [](options& opt) { ${_option_reset}; },\n")
+       string(APPEND _options_entries "    [](const options& opt) -> const void* { return &opt.${_option_name}; } },\n")
        list(APPEND _options_lister "\"${_option_name}\"")
+       list(APPEND _options_changed "if (!(opt.${_option_name} == other.${_option_name})) names.emplace_back(\"${_option_name}\")")
 
     else()
       # Group found, add in the struct and recurse
@@ -170,11 +172,7 @@ function(_parse_json_option _top_json)
   # Set appended variables and list in the parent before leaving the recursion
   # Always use quotes for string variable as it contains semi-colons
   set(_options_struct "${_options_struct}" PARENT_SCOPE)
-  set(_options_setter ${_options_setter} PARENT_SCOPE)
-  set(_options_getter ${_options_getter} PARENT_SCOPE)
-  set(_options_string_setter ${_options_string_setter} PARENT_SCOPE)
-  set(_options_string_getter ${_options_string_getter} PARENT_SCOPE)
+  set(_options_entries "${_options_entries}" PARENT_SCOPE)
   set(_options_lister ${_options_lister} PARENT_SCOPE)
-  set(_options_is_optional ${_options_is_optional} PARENT_SCOPE)
-  set(_options_reset ${_options_reset} PARENT_SCOPE)
+  set(_options_changed ${_options_changed} PARENT_SCOPE)
 endfunction()
@@ -38,6 +38,7 @@ f3d_plugin_declare_reader(
   [SCORE                 <integer>]
   [EXCLUDE_FROM_THUMBNAILER]
   [CUSTOM_CODE           <file>]
+  [INCLUDES              <header>...]
   EXTENSIONS             <string>...
   MIMETYPES              <string>...)
 ~~~
@@ -52,14 +53,17 @@ The `NAME` argument is required. The arguments are as follows:
   * `FORMAT_DESCRIPTION`: The description of the format read by the reader.
   * `SCORE`: The score of the reader (from 0 to 100). Default value is 50.
   * `EXCLUDE_FROM_THUMBNAILER`: If specified, the reader will not be used for generating thumbnails.
-  * `CUSTOM_CODE`: A custom code file containing the implementation of ``applyCustomReader`` function.
+  * `CUSTOM_CODE`: A custom code file containing the implementation of ``applyCustomReader`` function,
+    or of the ``create*FromMemory`` functions when the format can be read from a buffer.
+  * `INCLUDES`: The headers required by the custom code, in addition to the header of the VTK
+    importer or reader class.
   * `EXTENSIONS`: (Required) The list of file extensions supported by the reader.
   * `MIMETYPES`: (Required) The list of mimetypes supported by the reader.
 
 #]==]
 
 macro(f3d_plugin_declare_reader)
-  cmake_parse_arguments(F3D_READER "EXCLUDE_FROM_THUMBNAILER" "NAME;VTK_IMPORTER;VTK_READER;FORMAT_DESCRIPTION;SCORE;CUSTOM_CODE" "EXTENSIONS;MIMETYPES" ${ARGN})
+  cmake_parse_arguments(F3D_READER "EXCLUDE_FROM_THUMBNAILER" "NAME;VTK_IMPORTER;VTK_READER;FORMAT_DESCRIPTION;SCORE;CUSTOM_CODE" "EXTENSIONS;MIMETYPES;INCLUDES" ${ARGN})
 
   if(F3D_READER_CUSTOM_CODE)
     set(F3D_READER_HAS_CUSTOM_CODE 1)
@@ -67,6 +71,11 @@ macro(f3d_plugin_declare_reader)
     set(F3D_READER_HAS_CUSTOM_CODE 0)
   endif()
 
+  set(F3D_READER_INCLUDES_CODE "")
+  foreach(_include IN LISTS F3D_READER_INCLUDES)
+    string(APPEND F3D_READER_INCLUDES_CODE "#include <${_include}>\n")
+  endforeach()
+
   if(F3D_READER_SCORE)
     set(F3D_READER_HAS_SCORE 1)
   else()
@@ -125,8 +134,21 @@ macro(f3d_plugin_declare_reader)
 
   if(F3D_READER_VTK_READER)
     set(F3D_READER_HAS_GEOMETRY_READER 1)
+    string(JSON F3D_READER_JSON
+      SET "${F3D_READER_JSON}" "geometry_reader" "true")
   else()
     set(F3D_READER_HAS_GEOMETRY_READER 0)
+    string(JSON F3D_READER_JSON
+      SET "${F3D_READER_JSON}" "geometry_reader" "false")
+  endif()
+
+  # The score is used to declare the plugin without loading it
+  if(F3D_READER_SCORE)
+    string(JSON F3D_READER_JSON
+      SET "${F3D_READER_JSON}" "score" "${F3D_READER_SCORE}")
+  else()
+    string(JSON F3D_READER_JSON
+      SET "${F3D_READER_JSON}" "score" "50")
   endif()
 
   if (NOT F3D_READER_HAS_SCENE_READER AND NOT F3D_READER_HAS_GEOMETRY_READER)
@@ -233,6 +255,7 @@ macro(f3d_plugin_build)
   if(EMSCRIPTEN)
     # Exceptions are disabled by default in emscripten but we need them
     list(APPEND f3d_plugin_compile_options "-fexceptions")
+    list(APPEND f3d_plugin_compile_options ${f3d_wasm_threads_compile_options})
   endif()
 
   set(f3d_plugin_link_options "")
@@ -374,8 +397,11 @@ macro(f3d_plugin_build)
       {
         "description" : "Reader description",
         "extensions" : [ "myext" ],
+        "full_scene" : false,
+        "geometry_reader" : true,
         "mimetypes" : [ "application/vnd.myext" ],
-        "name" : "myReader"
+        "name" : "myReader",
+        "score" : 50
       }
     ],
     "type" : "MODULE",
@@ -6,9 +6,11 @@
 #include <app_f3d_F3D_Window.h>
 
 #include <engine.h>
+#include <image.h>
 #include <log.h>
 
 #include <cassert>
+#include <vector>
 
 #define JAVA_BIND(Cls, Func) JNICALL Java_app_f3d_F3D_##Cls##_##Func
 
@@ -21,6 +23,23 @@ inline f3d::engine* GetEngine(JNIEnv* env, jobject self)
   return reinterpret_cast<f3d::engine*>(ptr);
 }
 
+inline void ThrowIllegalArgument(JNIEnv* env, const char* message)
+{
+  env->ThrowNew(env->FindClass("java/lang/IllegalArgumentException"), message);
+}
+
+// Wrap a direct buffer without copy, an empty buffer_t is returned for null or non direct buffers
+template<typename T>
+inline f3d::mesh_view_t::buffer_t<T> GetDirectBuffer(JNIEnv* env, jobject buffer)
+{
+  if (!buffer || !env->GetDirectBufferAddress(buffer))
+  {
+    return {};
+  }
+  return { static_cast<const T*>(env->GetDirectBufferAddress(buffer)),
+    static_cast<size_t>(env->GetDirectBufferCapacity(buffer)) };
+}
+
 extern "C"
 {
   // Engine
@@ -61,6 +80,77 @@ extern "C"
     GetEngine(env, self)->getScene().add(str);
     env->ReleaseStringUTFChars(path, str);
   }
+  JNIEXPORT void JAVA_BIND(Scene, addBuffer)(
+    JNIEnv* env, jobject self, jbyteArray data, jstring format)
+  {
+    const char* str = env->GetStringUTFChars(format, nullptr);
+    jbyte* bytes = env->GetByteArrayElements(data, nullptr);
+    GetEngine(env, self)->getScene().add(reinterpret_cast<const std::byte*>(bytes),
+      static_cast<size_t>(env->GetArrayLength(data)), str);
+    env->ReleaseByteArrayElements(data, bytes, JNI_ABORT);
+    env->ReleaseStringUTFChars(format, str);
+  }
+  JNIEXPORT void JAVA_BIND(Scene, addMesh)(JNIEnv* env, jobject self, jobject points,
+    jobject normals, jobject textureCoordinates, jobject triangleIndices)
+  {
+    if (!env->GetDirectBufferAddress(points) || !env->GetDirectBufferAddress(triangleIndices) ||
+      (normals && !env->GetDirectBufferAddress(normals)) ||
+      (textureCoordinates && !env->GetDirectBufferAddress(textureCoordinates)))
+    {
+      ThrowIllegalArgument(env, "Mesh buffers must be direct buffers");
+      return;
+    }
+
+    f3d::mesh_view_t view;
+    view.points = GetDirectBuffer<float>(env, points);
+    view.normals = GetDirectBuffer<float>(env, normals);
+    view.texture_coordinates = GetDirectBuffer<float>(env, textureCoordinates);
+    view.triangle_indices = GetDirectBuffer<unsigned int>(env, triangleIndices);
+
+    // The buffers are kept alive by global references until the scene does not use them,
+    // which may be released from another thread
+    std::vector<jobject> references;
+    for (jobject buffer : { points, normals, textureCoordinates, triangleIndices })
+    {
+      if (buffer)
+      {
+        references.emplace_back(env->NewGlobalRef(buffer));
+      }
+    }
+    JavaVM* vm = nullptr;
+    env->GetJavaVM(&vm);
+    view.deleter = [vm, references]()
+    {
+      JNIEnv* threadEnv = nullptr;
+      bool attached = false;
+      if (vm->GetEnv(reinterpret_cast<void**>(&threadEnv), JNI_VERSION_1_6) == JNI_EDETACHED)
+      {
+#ifdef __ANDROID__
+        vm->AttachCurrentThread(&threadEnv, nullptr);
+#else
+        vm->AttachCurrentThread(reinterpret_cast<void**>(&threadEnv), nullptr);
+#endif
+        attached = true;
+      }
+      for (jobject reference : references)
+      {
+        threadEnv->DeleteGlobalRef(reference);
+      }
+      if (attached)
+      {
+        vm->DetachCurrentThread();
+      }
+    };
+
+    try
+    {
+      GetEngine(env, self)->getScene().add(view);
+    }
+    catch (const f3d::scene::load_failure_exception& e)
+    {
+      ThrowIllegalArgument(env, e.what());
+    }
+  }
   JNIEXPORT void JAVA_BIND(Scene, clear)(JNIEnv* env, jobject self)
   {
     GetEngine(env, self)->getScene().clear();
@@ -72,6 +162,27 @@ extern "C"
     GetEngine(env, self)->getWindow().render();
   }
 
+  JNIEXPORT void JAVA_BIND(Window, renderToImage)(
+    JNIEnv* env, jobject self, jobject output, jboolean noBackground)
+  {
+    f3d::window& win = GetEngine(env, self)->getWindow();
+    const unsigned int width = static_cast<unsigned int>(win.getWidth());
+    const unsigned int height = static_cast<unsigned int>(win.getHeight());
+    const unsigned int channels = noBackground ? 4 : 3;
+
+    void* address = env->GetDirectBufferAddress(output);
+    if (!address ||
+      env->GetDirectBufferCapacity(output) < static_cast<jlong>(width) * height * channels)
+    {
+      ThrowIllegalArgument(env, "Output must be a direct buffer of width*height*channels bytes");
+      return;
+    }
+
+    // The render is written directly into the wrapped buffer
+    f3d::image img(width, height, channels, f3d::image::ChannelType::BYTE, address);
+    win.renderToImage(img, noBackground);
+  }
+
   JNIEXPORT void JAVA_BIND(Window, setSize)(JNIEnv* env, jobject self, jint w, jint h)
   {
     GetEngine(env, self)->getWindow().setSize(w, h);
@@ -7,6 +7,15 @@ public class Scene {
     }
 
     public native void add(String file);
+    public native void addBuffer(byte[] data, String format);
+
+    /**
+     * Add a triangle mesh from direct buffers in native byte order, without copy.
+     * Normals and texture coordinates can be null. The buffers must not be modified
+     * while they are used by the scene.
+     */
+    public native void addMesh(java.nio.FloatBuffer points, java.nio.FloatBuffer normals,
+        java.nio.FloatBuffer textureCoordinates, java.nio.IntBuffer triangleIndices);
     public native void clear();
 
     private long mNativeAddress;
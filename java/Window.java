@@ -10,6 +10,12 @@ public class Window {
     public Camera getCamera() { return mCamera; }
 
     public native void render();
+
+    /**
+     * Render the window into a direct ByteBuffer, without copy, as RGB bytes, or RGBA bytes
+     * when noBackground is true. Its capacity must be width * height * channels.
+     */
+    public native void renderToImage(java.nio.ByteBuffer output, boolean noBackground);
     public native void setSize(int width, int height);
 
     public native int getWidth();
@@ -30,6 +30,33 @@ public class TestJavaBindings {
 
       Scene scene = engine.getScene();
       scene.add(args[0] + "data/cow.vtp");
+
+      try {
+        byte[] data = java.nio.file.Files.readAllBytes(java.nio.file.Paths.get(args[0] + "data/suzanne.ply"));
+        scene.clear();
+        scene.addBuffer(data, "ply");
+      } catch (java.io.IOException e) {
+        assert false : "Cannot read the file to add from memory";
+      }
+
+      java.nio.FloatBuffer points = java.nio.ByteBuffer.allocateDirect(9 * 4)
+        .order(java.nio.ByteOrder.nativeOrder()).asFloatBuffer();
+      points.put(new float[] { 0, 0, 0, 0, 1, 0, 1, 0, 0 });
+      java.nio.IntBuffer triangles = java.nio.ByteBuffer.allocateDirect(3 * 4)
+        .order(java.nio.ByteOrder.nativeOrder()).asIntBuffer();
+      triangles.put(new int[] { 0, 1, 2 });
+      scene.clear();
+      scene.addMesh(points, null, null, triangles);
+
+      Window window = engine.getWindow();
+      window.setSize(300, 200);
+      java.nio.ByteBuffer image = java.nio.ByteBuffer.allocateDirect(300 * 200 * 4);
+      window.renderToImage(image, true);
+      boolean rendered = false;
+      for (int i = 3; i < image.capacity(); i += 4) {
+        rendered |= image.get(i) != 0;
+      }
+      assert rendered : "The mesh is not rendered in the buffer";
     }
   }
 }
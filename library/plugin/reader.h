@@ -3,6 +3,7 @@
 
 #include <vtkAlgorithm.h>
 #include <vtkImporter.h>
+#include <vtkPolyData.h>
 #include <vtkSmartPointer.h>
 
 #include <algorithm>
@@ -23,6 +24,11 @@ namespace f3d
  * automatically done when the plugin is loaded by CMake when declaring every reader
  * with the f3d_plugin_declare_reader() macro.
  *
+ * The asynchronous loads are cancelled cooperatively: the geometry readers are aborted with
+ * their AbortExecute flag, set from their progress events, and must check it between the chunks
+ * they report the progress of, while the scene readers deriving from vtkF3DImporter must check
+ * vtkF3DImporter::IsCancelled between the steps of their import.
+ *
  * @warning This file is used internally by the plugin SDK, it is not intended to be included
  * directly by libf3d users.
  */
@@ -62,6 +68,8 @@ public:
 
   /**
    * Check if this reader can read the given filename - generally according its extension
+   * The factory only calls it for the files with one of the extensions of this reader,
+   * it can be overridden to refuse some of them.
    */
   virtual bool canRead(const std::string& fileName) const
   {
@@ -102,6 +110,25 @@ public:
     return nullptr;
   }
 
+  /**
+   * Return true if the readers created by this reader can read from a buffer in memory
+   * with `createGeometryReaderFromMemory` or `createSceneReaderFromMemory`, false otherwise.
+   */
+  virtual bool canReadFromMemory() const
+  {
+    return false;
+  }
+
+  /**
+   * Create the geometry reader (VTK reader) reading the provided buffer in memory,
+   * nullptr if this reader does not support reading from memory.
+   * The buffer is kept alive by the caller as long as the created reader is used.
+   */
+  virtual vtkSmartPointer<vtkAlgorithm> createGeometryReaderFromMemory(const void*, size_t) const
+  {
+    return nullptr;
+  }
+
   /**
    * Apply custom code for the reader
    */
@@ -109,6 +136,58 @@ public:
   {
   }
 
+  /**
+   * Configure a geometry reader created by this reader, before it is updated, to read the file
+   * faster at the cost of its quality, eg. with a coarser tessellation, to generate thumbnails.
+   * Return false if not supported.
+   */
+  virtual bool applyThumbnailReader(vtkAlgorithm*) const
+  {
+    return false;
+  }
+
+  /**
+   * Restrict the data arrays read by a geometry reader created by this reader
+   * to the provided array names.
+   * Return false if not supported, in which case all arrays are read.
+   */
+  virtual bool selectArrays(vtkAlgorithm*, const std::vector<std::string>&) const
+  {
+    return false;
+  }
+
+  /**
+   * Restrict the blocks of the composite dataset read by a geometry reader created by this
+   * reader to the blocks matching the provided paths, with their descendants.
+   * Return false if not supported, in which case all blocks are read.
+   */
+  virtual bool selectBlocks(vtkAlgorithm*, const std::vector<std::string>&) const
+  {
+    return false;
+  }
+
+  /**
+   * Configure a geometry reader created by this reader, before it is updated, so that the
+   * surfaces of its output can be refined later with refineSurface, eg. by keeping the exact
+   * geometry in memory. The first tessellation can then be coarser.
+   * Return false if not supported.
+   */
+  virtual bool enableRefinement(vtkAlgorithm*) const
+  {
+    return false;
+  }
+
+  /**
+   * Return a new tessellation of a surface output by a geometry reader for which refinement is
+   * enabled, with a chordal error smaller than the provided one in world units, or nullptr
+   * if the current tessellation is already fine enough or if not supported.
+   * It is called on a worker thread, but never concurrently for the same geometry reader.
+   */
+  virtual vtkSmartPointer<vtkPolyData> refineSurface(vtkAlgorithm*, vtkPolyData*, double) const
+  {
+    return nullptr;
+  }
+
   /**
    * Return true if this reader can create a scene reader
    * false otherwise
@@ -126,12 +205,44 @@ public:
     return nullptr;
   }
 
+  /**
+   * Create the scene reader (VTK importer) reading the provided buffer in memory,
+   * nullptr if this reader does not support reading from memory.
+   * The buffer is kept alive by the caller as long as the created importer is used.
+   */
+  virtual vtkSmartPointer<vtkImporter> createSceneReaderFromMemory(const void*, size_t) const
+  {
+    return nullptr;
+  }
+
   /**
    * Apply custom code for the importer
    */
   virtual void applyCustomImporter(vtkImporter*, const std::string&) const
   {
   }
+
+  /**
+   * Configure a scene reader created by this reader, before it is updated, to read the file
+   * faster at the cost of its quality, to generate thumbnails.
+   * The textures and animations of the importers inheriting vtkF3DImporter are already
+   * reduced by F3D. Return false if not supported.
+   */
+  virtual bool applyThumbnailImporter(vtkImporter*) const
+  {
+    return false;
+  }
+
+  /**
+   * Recover the bounds of the geometry of a file as [xmin, xmax, ymin, ymax, zmin, zmax], from
+   * its metadata or a quick scan of its positions, much faster than reading it, eg. to set up
+   * the camera before the file is read. The bounds may be larger than the read geometry.
+   * Return false if not supported or if the bounds are unknown.
+   */
+  virtual bool probeBounds(const std::string&, double[6]) const
+  {
+    return false;
+  }
 };
 }
 
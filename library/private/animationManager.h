@@ -6,11 +6,14 @@
 #ifndef f3d_animationManager_h
 #define f3d_animationManager_h
 
+#include "camera.h"
+
 #include <vtkNew.h>
 #include <vtkProgressBarWidget.h>
 #include <vtkSmartPointer.h>
 
 #include <chrono>
+#include <functional>
 #include <set>
 
 class vtkF3DRenderer;
@@ -20,16 +23,16 @@ class vtkRenderWindow;
 namespace f3d
 {
 class options;
-class window;
 
 namespace detail
 {
 class interactor_impl;
+class window_impl;
 
 class animationManager
 {
 public:
-  animationManager(const options& options, window& window);
+  animationManager(const options& options, window_impl& window);
   ~animationManager() = default;
 
   /**
@@ -51,6 +54,12 @@ public:
    */
   bool Initialize();
 
+  /**
+   * Stop the animation and forget about the current animations.
+   * Initialize must be called again before playing an animation.
+   */
+  void Finalize();
+
   /**
    * Start/Stop playing the animation
    */
@@ -100,20 +109,37 @@ public:
    */
   void GetTimeRange(double timeRange[2]);
 
+  /**
+   * Play a camera animation track of the provided duration in milliseconds, independently of the
+   * scene animations. The interpolator is called with a ratio varying from `0.` for the initial
+   * state to `1.` for the final state, and shall return the camera state at this ratio.
+   * Only the first frame forwards the options to the renderer, the next ones are rendered in a
+   * tight loop only moving the camera, without touching the importers.
+   */
+  void PlayCameraTrack(
+    const std::function<camera_state_t(double)>& interpolateCameraState, int duration);
+
 private:
   /**
    * Called by an internal timer to advance one animation tick
    */
   void Tick();
 
+  /**
+   * Call Tick as soon as the events are processed, then again after each tick while playing
+   * paced by the vertical sync
+   */
+  void ScheduleTick();
+
   const options& Options;
-  window& Window;
+  window_impl& Window;
   vtkImporter* Importer = nullptr;
   interactor_impl* Interactor = nullptr;
 
   double TimeRange[2] = { 0.0, 0.0 };
   bool Playing = false;
   bool HasAnimation = false;
+  bool Paced = false;
   unsigned long CallBackId = 0;
   double CurrentTime = 0;
   bool CurrentTimeSet = false;
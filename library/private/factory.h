@@ -8,6 +8,12 @@
  * with the CMake macro f3d_plugin_declare_reader(). Then, at configure time, CMake
  * generates a cxx file that instantiates all the reader classes and registers
  * them to the factory.
+ * Plugins can also be declared with the description of their readers, in which case
+ * they are only loaded when one of their readers is picked to read a file.
+ * The readers of the loaded plugins are indexed by extension when registered, so that picking
+ * the reader of a file only checks the readers supporting its extension.
+ * The factory is shared by all engines and can be used from several threads,
+ * its methods lock a recursive mutex that must also be held when iterating the returned lists.
  */
 
 #ifndef f3d_plugin_factory_h
@@ -16,7 +22,11 @@
 #include "plugin.h"
 #include "reader.h"
 
+#include <functional>
 #include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace f3d
@@ -25,6 +35,31 @@ class factory
 {
 public:
   using plugin_initializer_t = plugin* (*)();
+  using plugin_loader_t = std::function<void()>;
+
+  /**
+   * The description of a reader of a declared but not loaded plugin
+   */
+  struct declared_reader
+  {
+    std::string Name;
+    std::string Description;
+    std::vector<std::string> Extensions;
+    std::vector<std::string> MimeTypes;
+    int Score = 50;
+    bool HasSceneReader = false;
+    bool HasGeometryReader = false;
+  };
+
+  /**
+   * A plugin declared but not loaded yet
+   */
+  struct declared_plugin
+  {
+    std::string Name;
+    std::vector<declared_reader> Readers;
+    plugin_loader_t Loader;
+  };
 
   /**
    * Get instance
@@ -36,6 +71,18 @@ public:
    */
   void load(plugin*);
 
+  /**
+   * Declare a plugin without loading it, using the description of its readers.
+   * The loader is called to load the plugin the first time one of its declared readers
+   * has the best score for a file. Declaring an already declared or loaded plugin does nothing.
+   */
+  void declare(const declared_plugin& plug);
+
+  /**
+   * Get the list of the declared plugins that are not loaded yet
+   */
+  const std::vector<declared_plugin>& getDeclaredPlugins();
+
   /**
    * Register all static plugins to the factory
    */
@@ -43,6 +90,8 @@ public:
 
   /**
    * Get the reader that can read the given file, nullptr if none
+   * Only the readers supporting the extension of the file are checked with `reader::canRead`.
+   * A declared plugin is loaded if one of its readers has the best score for this file.
    */
   reader* getReader(const std::string& fileName);
 
@@ -57,15 +106,42 @@ public:
    */
   plugin_initializer_t getStaticInitializer(const std::string& pluginName);
 
+  /**
+   * Get the mutex protecting the plugins, to lock while using getPlugins or getDeclaredPlugins
+   * or while loading a plugin
+   */
+  std::recursive_mutex& getMutex();
+
 protected:
   factory();
   virtual ~factory() = default;
 
   bool registerOnce(plugin* p);
 
+  /**
+   * Add a reader of a registered plugin to the extension index
+   */
+  void indexReader(reader* read);
+
+  /**
+   * A registered reader with its score, cached at registration
+   */
+  struct indexed_reader
+  {
+    reader* Reader;
+    int Score;
+  };
+
   std::vector<plugin*> Plugins;
 
+  // The readers of the registered plugins for each extension, by decreasing score
+  std::unordered_map<std::string, std::vector<indexed_reader>> ReadersByExtension;
+
+  std::vector<declared_plugin> DeclaredPlugins;
+
   std::map<std::string, plugin_initializer_t> StaticPluginInitializers;
+
+  std::recursive_mutex Mutex;
 };
 }
 #endif
@@ -42,8 +42,10 @@ public:
     std::string action, std::function<bool(const std::vector<std::string>&)> callback) override;
   interactor& removeCommandCallback(const std::string& action) override;
   bool triggerCommand(std::string_view command) override;
+  bool triggerCommands(const std::vector<std::string_view>& commands) override;
 
   unsigned long createTimerCallBack(double time, std::function<void()> callBack) override;
+  unsigned long createOneShotTimerCallBack(double time, std::function<void()> callBack) override;
   void removeTimerCallBack(unsigned long id) override;
 
   void toggleAnimation() override;
@@ -34,8 +34,22 @@ public:
   scene& add(const std::vector<std::filesystem::path>& filePath) override;
   scene& add(const std::vector<std::string>& filePathStrings) override;
   scene& add(const mesh_t& mesh) override;
+  scene& add(const mesh_view_t& mesh) override;
+  scene& add(const std::byte* buffer, std::size_t size, const std::string& format) override;
+  scene& updateMesh(size_t meshIndex, const mesh_view_t& mesh) override;
+  scene& reload(const std::vector<std::filesystem::path>& filePaths) override;
+  std::shared_ptr<load_handle> addAsync(
+    const std::vector<std::filesystem::path>& filePaths) override;
+  scene& preload(const std::vector<std::filesystem::path>& filePaths, int memoryBudget) override;
+  std::shared_ptr<load_handle> replaceAsync(
+    const std::vector<std::filesystem::path>& filePaths) override;
+  scene& replace(const std::vector<std::filesystem::path>& filePaths) override;
   scene& clear() override;
   bool supports(const std::filesystem::path& filePath) override;
+  scene& loadAnimationTime(double timeValue) override;
+  std::pair<double, double> animationTimeRange() override;
+  memory_usage_t getMemoryUsage() override;
+  scene& save(const std::filesystem::path& filePath) override;
   ///@}
 
   /**
@@ -44,7 +58,21 @@ public:
    */
   void SetInteractor(interactor_impl* interactor);
 
+  /**
+   * Implementation only API.
+   * Set if the nodes of streamed point clouds are read by worker threads, used while interacting.
+   */
+  void SetUseAsyncPointClouds(bool use);
+
+  /**
+   * Implementation only API.
+   * Return true if nodes of streamed point clouds have been read by worker threads since the
+   * last call, in which case a render is needed to show them.
+   */
+  bool HasNewPointCloudNodes();
+
 private:
+  class async_load;
   class internals;
   std::unique_ptr<internals> Internals;
 };
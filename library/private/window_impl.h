@@ -14,6 +14,7 @@
 #include "log.h"
 #include "window.h"
 
+#include <functional>
 #include <memory>
 #include <optional>
 
@@ -48,6 +49,17 @@ public:
   camera& getCamera() override;
   bool render() override;
   image renderToImage(bool noBackground = false) override;
+  image& renderToImage(image& output, bool noBackground = false) override;
+  std::future<image> renderToImageAsync(bool noBackground = false) override;
+  image renderToTiledImage(int scale, bool noBackground = false) override;
+  image renderToTiledImageBand(
+    int scale, int index, int count, bool noBackground = false) override;
+  aovs_t renderToAOVs(bool noBackground = false) override;
+  std::vector<image> renderViews(
+    const std::vector<camera_state_t>& views, bool noBackground = false) override;
+  image renderViewsToSpriteSheet(
+    const std::vector<camera_state_t>& views, int columns, bool noBackground = false) override;
+  window& setAdditionalViews(const std::vector<camera_state_t>& views) override;
   int getWidth() const override;
   int getHeight() const override;
   window& setAnimationNameInfo(const std::string& name);
@@ -77,6 +89,14 @@ public:
    */
   void SetImporter(vtkF3DMetaImporter* importer);
 
+  /**
+   * Implementation only API.
+   * Frame the provided bounds, with the ones of the current scene, and render them with the grid
+   * before the files they come from are imported. nullptr to stop using them.
+   * See vtkF3DRenderer::SetPlaceholderBounds.
+   */
+  void ShowPlaceholderBounds(const double* bounds);
+
   /**
    * Implementation only API.
    * Use all the rendering related options to update the configuration of the window
@@ -86,6 +106,13 @@ public:
    */
   void UpdateDynamicOptions();
 
+  /**
+   * Implementation only API.
+   * Render a frame in which only the camera changed since the previous render.
+   * The options are not forwarded to the renderer, which must be up to date.
+   */
+  void RenderCamera();
+
   /**
    * Implementation only API.
    * Print scene description to log using provided verbose level
@@ -98,6 +125,13 @@ public:
    */
   void PrintColoringDescription(log::VerboseLevel level);
 
+  /**
+   * Implementation only API.
+   * Print the frame time statistics as a JSON object to log using provided verbose level.
+   * Return false if no frame statistics are recorded.
+   */
+  bool PrintFrameStatistics(log::VerboseLevel level);
+
   /**
    * Implementation only API.
    * Get a pointer to the internal vtkRenderWindow
@@ -110,7 +144,33 @@ public:
    */
   void SetCachePath(const std::string& cachePath);
 
+  /**
+   * Implementation only API.
+   * Select the EGL device to render with, before the first render.
+   * Does nothing if the window is not an EGL window.
+   */
+  void SetDeviceIndex(int index);
+
+  /**
+   * Implementation only API.
+   * Get the number of EGL devices, 0 if EGL is not supported.
+   */
+  static int GetEGLDeviceCount();
+
 private:
+  /**
+   * Render the views back to back and call the consumer with the index and the image of each view,
+   * in order, after the camera is restored
+   */
+  void RenderViews(const std::vector<camera_state_t>& views, bool noBackground,
+    const std::function<void(size_t, const image&)>& consumer);
+
+  /**
+   * Render the rows from rowBegin to rowEnd, from the bottom, of the image `scale` times larger
+   * than the window, in tiles, see renderToTiledImage
+   */
+  image RenderTiles(int scale, bool noBackground, int rowBegin, int rowEnd);
+
   class internals;
   std::unique_ptr<internals> Internals;
 };
@@ -73,12 +73,19 @@ public:
   /**
    * Create an engine with an EGL window.
    * VTK >= 9.4 required.
-   * If several GPU are available, the environment variable
-   * `VTK_DEFAULT_EGL_DEVICE_INDEX` allows its selection.
+   * If several GPU are available, deviceIndex selects the one to render with, in the range
+   * given by getEGLDeviceCount(). If negative, the environment variable
+   * `VTK_DEFAULT_EGL_DEVICE_INDEX` allows its selection, the first device is used otherwise.
    * Optionally, the window can be hidden by setting offscreen to true.
    * Throws engine::loading_exception in case of failure.
    */
-  static engine createEGL(bool offscreen = false);
+  static engine createEGL(bool offscreen = false, int deviceIndex = -1);
+
+  /**
+   * Get the number of EGL devices, usually one per GPU, enumerated with
+   * EGL_EXT_device_enumeration. Returns 0 if EGL is not supported.
+   */
+  static int getEGLDeviceCount();
 
   /**
    * Create an engine with an OSMesa window.
@@ -155,7 +162,8 @@ public:
 
   /**
    * Set the cache path. Must be an absolute path.
-   * Currently, it's only used to store HDRI baked textures.
+   * It is used to store HDRI baked textures and, by plugins, to cache expensive to read data.
+   * Within a process, compiled shader programs are always reused by a window across scene loads.
    * By default, the cache path is:
    * - Windows: %LOCALAPPDATA%\f3d
    * - Linux: ~/.cache/f3d
@@ -163,6 +171,17 @@ public:
    */
   void setCachePath(const std::string& cachePath);
 
+  /**
+   * Compile the shader programs needed to render with the provided options, by rendering
+   * a small textured quad with normals in the window, hidden if not shown yet.
+   * The compiled programs are kept by the window so that the first render of the files added
+   * later does not wait for them. To overlap the compilation with the reading of the files,
+   * start reading them with `scene::preload` before calling this method.
+   * The scene is cleared, the options and the camera state are restored afterwards.
+   * Does nothing if the engine has no window.
+   */
+  engine& precompileShaders(const options& opt);
+
   /**
    * Engine provide a default options that you can use using engine::getOptions().
    * But you can use this setter to use other options directly.
@@ -215,6 +234,18 @@ public:
   static void loadPlugin(
     const std::string& nameOrPath, const std::vector<std::string>& pluginSearchPaths = {});
 
+  /**
+   * Declare a plugin using its json file, as generated by the plugin SDK, without loading it.
+   * The readers listed in the json file are considered when looking for a reader for a file,
+   * using their extensions and scores, and the plugin is loaded with loadPlugin, using its name
+   * and the provided plugin search paths, only when one of them is picked.
+   * This avoids loading plugins with large dependencies that may not be needed.
+   * Declaring an already loaded plugin does nothing.
+   * Throw a plugin_exception if the json file cannot be read.
+   */
+  static void declarePlugin(
+    const std::string& jsonPath, const std::vector<std::string>& pluginSearchPaths = {});
+
   /**
    * Automatically load all the static plugins.
    * The plugin "native" is guaranteed to be static.
@@ -4,6 +4,8 @@
 #include "exception.h"
 #include "export.h"
 
+#include <functional>
+#include <future>
 #include <string>
 #include <vector>
 
@@ -27,7 +29,8 @@ public:
     PNG,
     JPG,
     TIF,
-    BMP
+    BMP,
+    EXR
   };
 
   /**
@@ -36,12 +39,14 @@ public:
    * BYTE: 8-bit integer in range [0,255]
    * SHORT: 16-bit integer in range [0,65535]
    * FLOAT: 32-bit floating point in range [-inf,+inf]
+   * HALF: 16-bit floating point in range [-65504,+65504], stored as the IEEE 754 bits
    */
   enum class ChannelType : unsigned char
   {
     BYTE,
     SHORT,
-    FLOAT
+    FLOAT,
+    HALF
   };
 
   /**
@@ -60,6 +65,15 @@ public:
   image(unsigned int width, unsigned int height, unsigned int channelCount,
     ChannelType type = ChannelType::BYTE);
 
+  /**
+   * Create an image wrapping an external buffer, without copying it.
+   * Its size is expected to be `width * height * channelCount * typeSize`.
+   * The buffer must stay valid as long as the image exists, the deleter, if any, is then
+   * called with the buffer. Copies of the image do not share the buffer.
+   */
+  image(unsigned int width, unsigned int height, unsigned int channelCount, ChannelType type,
+    void* buffer, std::function<void(void*)> deleter = nullptr);
+
   ///@{ @name Constructors
   /**
    * Default/copy/move constructors/operators.
@@ -83,6 +97,7 @@ public:
   /**
    * Read one specific pixel and return all channel normalized values.
    * If the channel type is BYTE or SHORT, the values are normalized to [0, 1] range.
+   * If the channel type is HALF, the values are converted to floating point.
    * \warning Because of the normalization, this function can be slow, prefer getContent when
    * reading several pixels and normalization is not needed.
    */
@@ -141,8 +156,9 @@ public:
    * return true otherwise.
    * The error is minimum between Minkownski and Wasserstein distance
    * on a SSIM computation, as specified in VTK.
+   * Identical images are detected before the SSIM computation and always have an error of 0.
    * Please note, due to possible arithmetic imprecision in the SSIM computation
-   * using a threshold of zero may return false with identical images.
+   * using a threshold of zero may return false with almost identical images.
    * Depending on the VTK version, another comparison algorithm may be used.
    * Threshold should be in range [0, 1[, this returns false otherwise.
    * 1e-14: Pixel perfect comparison.
@@ -153,6 +169,22 @@ public:
    */
   bool compare(const image& reference, double threshold, double& error) const;
 
+  /**
+   * Compare current image to a reference using the peak signal-to-noise ratio, in decibels,
+   * of the normalized values of all the channels, the HALF channels being converted to floats.
+   * Return true if the PSNR is at least the threshold, false otherwise.
+   * The squared errors are summed natively, row by row on all the cores, and the summation stops
+   * as soon as the PSNR is proven to be lower than the threshold: psnr is then only an upper
+   * bound of the PSNR. It is exact when this returns true.
+   * Identical images have an infinite PSNR. Images with a different type, size or number of
+   * components have a PSNR of 0.
+   * This is much faster than compare on different images, but the PSNR and the SSIM error
+   * are not comparable, the thresholds of compare cannot be used.
+   * 30: Small visible difference on BYTE images.
+   * 40: Visually indistinguishable.
+   */
+  bool comparePSNR(const image& reference, double threshold, double& psnr) const;
+
   /**
    * Save an image to a file in the specified format.
    * Default format is PNG if not specified.
@@ -160,17 +192,30 @@ public:
    * JPG: Supports channel type BYTE with channel count of 1 or 3
    * TIF: Supports channel type BYTE, SHORT and FLOAT with channel count of 1 to 4
    * BMP: Supports channel type BYTE with channel count of 1 to 4
+   * EXR: Supports channel type FLOAT and HALF with channel count of 1 to 4, if the EXR module is
+   * built. The scanlines are ZIP compressed on all the cores.
    * Throw an `image::write_exception` if the format is incompatible with with image channel type or
    * channel count
    */
   void save(const std::string& path, SaveFormat format = SaveFormat::PNG) const;
 
+  /**
+   * Save an image to a file in the specified format, like `save`, but encode it on a pool of
+   * background threads shared by all images, so that rendering can continue in the meantime.
+   * The image is copied so it can be modified or destroyed right after this call.
+   * Throw an `image::write_exception` if the format is incompatible with with image channel type or
+   * channel count. Other errors are reported as an `image::write_exception` by the returned future.
+   */
+  std::future<void> saveAsync(const std::string& path, SaveFormat format = SaveFormat::PNG) const;
+
   /**
    * Save an image to a memory buffer in the specified format.
    * Default format is PNG if not specified.
    * PNG: Supports channel type BYTE and SHORT with channel count of 1 to 4
    * JPG: Supports channel type BYTE with channel count of 1 or 3
    * BMP: Supports channel type BYTE with channel count of 1 to 4
+   * EXR: Supports channel type FLOAT and HALF with channel count of 1 to 4, if the EXR module is
+   * built.
    * TIF format is not supported yet.
    * Throw an `image::write_exception` if the type is TIF or
    * if the format is incompatible with with image channel type or channel count.
@@ -197,6 +242,40 @@ public:
    */
   std::string toTerminalText() const;
 
+  /**
+   * Convert to colored text like `toTerminalText(std::ostream& stream)`, but only write the
+   * characters that changed since a previous image, for repeated frames in a terminal.
+   * The cursor is expected to be where the text of the previous image left it,
+   * it is moved back to the top left of that text and over the unchanged characters.
+   * Throw a `image::write_exception` if the type is not byte RGB or RGBA
+   * or if the previous image does not have the same size and type.
+   */
+  const f3d::image& toTerminalText(std::ostream& stream, const image& previous) const;
+
+  /**
+   * Write the image using the kitty terminal graphics protocol, as a PNG payload.
+   * This is far more compact than text and displays the image at its full resolution
+   * in terminals supporting the protocol.
+   * Throw a `image::write_exception` if the type is not byte RGB or RGBA.
+   */
+  const f3d::image& toTerminalGraphics(std::ostream& stream) const;
+
+  /**
+   * Return a copy of the image downsampled by an integer factor using a box filter,
+   * for example before converting it to terminal text.
+   * The size of the result is rounded up, the blocks on the edges may be partial.
+   * Throw a `image::write_exception` if the factor is 0.
+   */
+  image downsample(unsigned int factor) const;
+
+  /**
+   * Return a copy of the image with the provided channel type, FLOAT channels are converted
+   * to HALF channels rounding to the nearest value, and HALF channels to FLOAT channels.
+   * This halves the size of HDR images and of the depth or normal outputs.
+   * Throw a `image::write_exception` if the types are different and not FLOAT or HALF.
+   */
+  image convert(ChannelType type) const;
+
   /**
    * Set the value for a metadata key. Setting an empty value (`""`) removes the key.
    */
@@ -63,6 +63,14 @@ public:
    * Trigger provided command, see COMMAND.md for more information
    */
   virtual bool triggerCommand(std::string_view command) = 0;
+
+  /**
+   * Trigger provided commands in order and render once when they have all been applied,
+   * which is faster than triggering them one by one when they change many options.
+   * All commands are tokenized first, none of them is triggered if one cannot be tokenized.
+   * Return true if all commands succeeded.
+   */
+  virtual bool triggerCommands(const std::vector<std::string_view>& commands) = 0;
   ///@}
 
   /**
@@ -71,6 +79,13 @@ public:
    */
   virtual unsigned long createTimerCallBack(double time, std::function<void()> callBack) = 0;
 
+  /**
+   * Use this method to create a timer callback called only once, after time ms.
+   * No timer is kept running once it is called, which can be used to wake up the event loop
+   * without polling. Return an id to use in removeTimerCallBack before it is called.
+   */
+  virtual unsigned long createOneShotTimerCallBack(double time, std::function<void()> callBack) = 0;
+
   /**
    * Remove a previously created timer callback using the id.
    */
@@ -3,6 +3,8 @@
 
 #include "export.h"
 
+#include <cstddef>
+#include <cstdint>
 #include <sstream>
 #include <string>
 
@@ -41,10 +43,15 @@ public:
 
   /**
    * Log provided args as provided verbose level.
+   * The args are only formatted if a message of this level is displayed.
    */
   template<typename... Args>
   static void print(VerboseLevel level, Args... args)
   {
+    if (!log::isEnabled(level))
+    {
+      return;
+    }
     std::stringstream ss;
     log::appendArg(ss, args...);
     log::printInternal(level, ss.str());
@@ -56,6 +63,10 @@ public:
   template<typename... Args>
   static void debug(Args... args)
   {
+    if (!log::isEnabled(VerboseLevel::DEBUG))
+    {
+      return;
+    }
     std::stringstream ss;
     log::appendArg(ss, args...);
     log::debugInternal(ss.str());
@@ -67,6 +78,10 @@ public:
   template<typename... Args>
   static void info(Args... args)
   {
+    if (!log::isEnabled(VerboseLevel::INFO))
+    {
+      return;
+    }
     std::stringstream ss;
     log::appendArg(ss, args...);
     log::infoInternal(ss.str());
@@ -78,6 +93,10 @@ public:
   template<typename... Args>
   static void warn(Args... args)
   {
+    if (!log::isEnabled(VerboseLevel::WARN))
+    {
+      return;
+    }
     std::stringstream ss;
     log::appendArg(ss, args...);
     log::warnInternal(ss.str());
@@ -89,6 +108,10 @@ public:
   template<typename... Args>
   static void error(Args... args)
   {
+    if (!log::isEnabled(VerboseLevel::ERROR))
+    {
+      return;
+    }
     std::stringstream ss;
     log::appendArg(ss, args...);
     log::errorInternal(ss.str());
@@ -106,12 +129,87 @@ public:
    */
   static void setVerboseLevel(VerboseLevel level, bool forceStdErr = false);
 
+  /**
+   * Return true if a message of the provided verbose level is displayed with the current verbose
+   * level, to avoid computing a message that would not be displayed.
+   */
+  static bool isEnabled(VerboseLevel level);
+
+  /**
+   * Set the asynchronous mode.
+   * When enabled, the messages are copied in a queue of the provided capacity and written by a
+   * background thread, so that logging does not wait for the output. When the queue is full,
+   * messages are dropped and counted instead of blocking the logging thread.
+   * Disabling the asynchronous mode writes the pending messages before returning.
+   * Has no effect if threads are not supported, eg: webassembly without threads.
+   */
+  static void setAsynchronous(bool async, std::size_t capacity = 4096);
+
+  /**
+   * Get the number of messages dropped because the asynchronous queue was full.
+   */
+  static std::uint64_t getNumberOfDroppedMessages();
+
   /**
    * Wait for user if applicable (eg: win32 output window).
    * No effect otherwise.
    */
   static void waitForUser();
 
+  /**
+   * Start recording a trace of the time spent in the main steps of libf3d and its plugins,
+   * eg: engine creation, reader lookup, scene import, renderer configuration and rendering.
+   * The trace is written in the provided file, in the Chrome trace event JSON format that
+   * can be opened with https://ui.perfetto.dev, when calling stopTrace.
+   */
+  static void startTrace(const std::string& filePath);
+
+  /**
+   * Stop recording the trace and write it.
+   * Return false if no trace was started or if the file could not be written.
+   */
+  static bool stopTrace();
+
+  /**
+   * A span of the trace, recorded from its construction to its destruction
+   * if a trace is started, to add custom steps in the trace.
+   */
+  class F3D_EXPORT traceSpan
+  {
+  public:
+    explicit traceSpan(const std::string& name);
+    ~traceSpan();
+    traceSpan(const traceSpan&) = delete;
+    traceSpan& operator=(const traceSpan&) = delete;
+
+  private:
+    std::string Name;
+    std::int64_t Start = -1;
+  };
+
+  /**
+   * Enumeration of the formats of the metrics.
+   */
+  enum class MetricsFormat : unsigned char
+  {
+    PROMETHEUS,
+    JSON
+  };
+
+  /**
+   * Return the metrics accumulated by libf3d and its plugins since the library was loaded or
+   * the last resetMetrics, eg: the number and duration of the loads by reader, the duration of
+   * the renders and image readbacks, the hits of the caches and the memory used by the scene.
+   * Unlike the trace, the metrics are always recorded, to monitor long-running processes.
+   * PROMETHEUS returns them in the Prometheus text exposition format, JSON in a JSON object.
+   */
+  static std::string getMetrics(MetricsFormat format = MetricsFormat::PROMETHEUS);
+
+  /**
+   * Forget all the metrics accumulated so far.
+   */
+  static void resetMetrics();
+
 protected:
   //! @cond
   static void appendArg(std::stringstream&)
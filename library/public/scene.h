@@ -5,8 +5,12 @@
 #include "export.h"
 #include "types.h"
 
+#include <array>
+#include <cstddef>
 #include <filesystem>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace f3d
@@ -43,21 +47,162 @@ public:
       : exception(what){};
   };
 
+  /**
+   * An exception that can be thrown by the scene
+   * when it failed to save the scene for some reason.
+   */
+  struct save_failure_exception : public exception
+  {
+    explicit save_failure_exception(const std::string& what = "")
+      : exception(what){};
+  };
+
   ///@{
   /**
    * Add and load provided files into the scene
    * Already added file will NOT be reloaded
+   * When an interactor is available, the files already loaded are rendered
+   * while the next ones are being read.
    */
   virtual scene& add(const std::filesystem::path& filePath) = 0;
   virtual scene& add(const std::vector<std::filesystem::path>& filePath) = 0;
   virtual scene& add(const std::vector<std::string>& filePathStrings) = 0;
   ///@}
 
+  /**
+   * Reload provided files, that must have been added using `add` before.
+   * Other files of the scene are not reloaded and the camera is not reset.
+   * Throw a `scene::load_failure_exception` if a file has not been added
+   * or cannot be loaded anymore.
+   */
+  virtual scene& reload(const std::vector<std::filesystem::path>& filePaths) = 0;
+
+  /**
+   * A handle on an asynchronous load started with `addAsync`.
+   */
+  class load_handle
+  {
+  public:
+    /**
+     * Enumeration of possible status of an asynchronous load
+     */
+    enum class Status : unsigned char
+    {
+      LOADING,
+      LOADED,
+      CANCELLED,
+      FAILED
+    };
+
+    /**
+     * Get the status of the load without blocking.
+     * If files have been read, this finalize the load on the calling thread
+     * by adding the imported actors into the scene before returning LOADED.
+     */
+    virtual Status getStatus() = 0;
+
+    /**
+     * Get the reading progress in range [0, 1].
+     */
+    virtual double getProgress() const = 0;
+
+    /**
+     * Block until files have been read then finalize the load on the calling thread.
+     * Throw a `scene::load_failure_exception` if the load failed.
+     * Return immediately if the load was cancelled or already finalized.
+     */
+    virtual void wait() = 0;
+
+    /**
+     * Request to cancel the load. Reading is interrupted as soon as possible
+     * and nothing is added to the scene.
+     */
+    virtual void cancel() = 0;
+
+    virtual ~load_handle() = default;
+  };
+
+  /**
+   * Add and load provided files into the scene asynchronously.
+   * Files are read on a worker thread while the calling thread can keep rendering
+   * and interacting with the current scene. The scene is only modified when the load is
+   * finalized on the calling thread, which happens in the interactor event loop if any,
+   * or when calling `getStatus` or `wait` on the returned handle.
+   * Throw a `scene::load_failure_exception` if a file does not exist or is not supported.
+   * Please note animated lights and cameras are not supported when loading asynchronously.
+   */
+  virtual std::shared_ptr<load_handle> addAsync(
+    const std::vector<std::filesystem::path>& filePaths) = 0;
+
+  /**
+   * Read provided files in the background without adding them to the scene, so that a later
+   * `add` of the same files, in the same order, uses the read data instead of reading them again,
+   * even after a `clear`. `add` waits for the read to finish if needed.
+   * Read data is kept until added, or discarded, oldest first, when the memory used by the
+   * preloaded files exceeds `memoryBudget` in MiB. The provided files are never discarded,
+   * preloading files already preloaded only marks them as the most recent ones.
+   * Preloaded files are not used when `scene.camera.index` is set.
+   * Throw a `scene::load_failure_exception` if a file does not exist or is not supported.
+   * Please note animated lights and cameras are not supported when preloading.
+   */
+  virtual scene& preload(const std::vector<std::filesystem::path>& filePaths, int memoryBudget) = 0;
+
+  /**
+   * Replace the files of the scene by the provided files asynchronously.
+   * The files are read on a worker thread, like with `addAsync`, while the current files stay
+   * rendered and interactive. When the load is finalized, the scene is cleared and the new files
+   * are added in the same step, so that no empty scene is rendered in between.
+   * Other pending asynchronous loads are cancelled at that time.
+   * If the files cannot be read, the current files are kept.
+   */
+  virtual std::shared_ptr<load_handle> replaceAsync(
+    const std::vector<std::filesystem::path>& filePaths) = 0;
+
+  /**
+   * Replace the files of the scene by the provided files, read before clearing the scene so that
+   * the current files stay rendered until the new ones are added all at once.
+   * Preloaded files are used, see `preload`. Clear the scene if no files are provided.
+   * Throw a `scene::load_failure_exception` if the files cannot be loaded,
+   * the current files are kept if they could not be read.
+   */
+  virtual scene& replace(const std::vector<std::filesystem::path>& filePaths) = 0;
+
   /**
    * Add and load provided mesh into the scene
    */
   virtual scene& add(const mesh_t& mesh) = 0;
 
+  /**
+   * Add and load provided mesh into the scene without copying its buffers.
+   * Throw a `scene::load_failure_exception` if the mesh is invalid, `mesh.deleter` is called
+   * before throwing in that case.
+   */
+  virtual scene& add(const mesh_view_t& mesh) = 0;
+
+  /**
+   * Add and load a file provided as a buffer in memory into the scene.
+   * `format` is the extension of the file format, eg "glb" or ".ply", used to pick the reader.
+   * The buffer is copied and read from memory directly by the readers supporting it, such as glTF,
+   * PLY, splat and Draco readers, other formats are written to a temporary file, removed on `clear`.
+   * Only self contained files are supported, external files such as textures are not found.
+   * Throw a `scene::load_failure_exception` if the buffer is empty or the format is not supported.
+   */
+  virtual scene& add(const std::byte* buffer, std::size_t size, const std::string& format) = 0;
+
+  /**
+   * Update the points, normals, texture coordinates, colors and arrays of a mesh added from
+   * memory, keeping its faces, so that only the updated data is uploaded again on the next render.
+   * `meshIndex` is the index of the mesh among the meshes added from memory since the last
+   * `clear`, in the order they were added.
+   * Each buffer must be empty, to keep the current data, or match the number of points of the mesh,
+   * arrays replace the arrays with the same name and the face buffers must be empty.
+   * The buffers are used without copy, as in `add(const mesh_view_t&)`.
+   * The camera and the bounding box of the scene are not updated.
+   * Throw a `scene::load_failure_exception` if the index or the buffers are invalid,
+   * `mesh.deleter` is called before throwing in that case.
+   */
+  virtual scene& updateMesh(size_t meshIndex, const mesh_view_t& mesh) = 0;
+
   ///@{
   /**
    * Convenience initializer list signature for add method
@@ -82,6 +227,90 @@ public:
    */
   virtual bool supports(const std::filesystem::path& filePath) = 0;
 
+  /**
+   * Load the added files at the provided animation time value.
+   * The time value is clamped to the animation time range.
+   * Does nothing if there is no animation.
+   */
+  virtual scene& loadAnimationTime(double timeValue) = 0;
+
+  /**
+   * Get the time range of the currently enabled animations.
+   * Return [0, 0] if there is no animation.
+   */
+  virtual std::pair<double, double> animationTimeRange() = 0;
+
+  /**
+   * Memory used by the files added to the scene, in bytes
+   */
+  struct memory_usage_t
+  {
+    /**
+     * Memory used by the imported geometries, textures and volumes
+     */
+    std::size_t cpu = 0;
+
+    /**
+     * Estimation of the memory used by the buffers and textures uploaded to render them
+     */
+    std::size_t gpu = 0;
+  };
+
+  /**
+   * Get the memory used by the files added to the scene.
+   * The `scene.memory_budget` option limits the CPU memory of the scene.
+   */
+  virtual memory_usage_t getMemoryUsage() = 0;
+
+  /**
+   * Save the surfaces of the files added to the scene, with their materials, textures and
+   * transforms, to a binary glTF file, so that slow to import files can be converted once into
+   * a file that loads quickly. Only the `.glb` extension is supported.
+   * The surfaces are triangulated and their triangles reordered for the GPU vertex caches,
+   * a surface used several times is only written once and the textures are embedded as PNG.
+   * Volumes, point sprites, lights, cameras and animations are not saved.
+   * Throw a `scene::save_failure_exception` if the extension is not supported or the file
+   * cannot be written.
+   */
+  virtual scene& save(const std::filesystem::path& filePath) = 0;
+
+  /**
+   * Information about the content of a file, see `query`
+   */
+  struct info_t
+  {
+    /**
+     * A data array of the file, arrays with the same name and location are merged
+     */
+    struct array_t
+    {
+      std::string name;
+      /** "point", "cell" or "field" */
+      std::string location;
+      int components = 0;
+      /** The range of the magnitude for arrays with multiple components */
+      std::pair<double, double> range = { 0.0, 0.0 };
+    };
+
+    /** The bounds of the geometry as [xmin, xmax, ymin, ymax, zmin, zmax], null when empty */
+    std::array<double, 6> bounds = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+    std::size_t points = 0;
+    std::size_t cells = 0;
+    std::vector<array_t> arrays;
+    std::size_t animations = 0;
+    /** The time range of all the animations, [0, 0] if there is no animation */
+    std::pair<double, double> animationTimeRange = { 0.0, 0.0 };
+    std::vector<std::string> cameras;
+  };
+
+  /**
+   * Read a file and return information about its content, without adding it to a scene nor
+   * creating anything needed to render it. It does not require an engine, only the plugin
+   * providing the reader to be loaded, and can be called from multiple threads in parallel.
+   * Throws a load_failure_exception if the file cannot be read.
+   */
+  static info_t query(const std::filesystem::path& filePath);
+
 protected:
   //! @cond
   scene() = default;
@@ -4,6 +4,9 @@
 #include "export.h"
 
 #include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -66,14 +69,83 @@ private:
  * - texture_coordinates can be empty or its length must be 2 times the number of points
  * - face_sides can be any size including empty resulting in a point cloud
  * - face_indices length must be the sum of all values in face_sides
+ * - triangle_indices or triangle_indices_16 can be used instead of face_sides and face_indices
+ *   for a triangle mesh, their length must be a multiple of 3
+ * - colors can be empty or its length must be 4 times the number of points, RGBA values
+ * - point_data arrays length must be their number of components times the number of points
+ * - cell_data arrays length must be their number of components times the number of faces
+ * - arrays must have a name and at least one component
+ * Colors are available for coloring as a `colors` point array, with direct scalars.
  */
 struct mesh_t
 {
+  /**
+   * A named array of values associated with the points or the faces of a mesh, available
+   * for scalar coloring.
+   */
+  struct array_t
+  {
+    std::string name;
+    int components = 1;
+    std::vector<float> values;
+  };
+
   std::vector<float> points;
   std::vector<float> normals;
   std::vector<float> texture_coordinates;
   std::vector<unsigned int> face_sides;
   std::vector<unsigned int> face_indices;
+  std::vector<unsigned int> triangle_indices;
+  std::vector<uint16_t> triangle_indices_16;
+  std::vector<unsigned char> colors;
+  std::vector<array_t> point_data;
+  std::vector<array_t> cell_data;
+
+  /**
+   * Check validity of the mesh.
+   * Returns a pair with the first element to true if the mesh is valid.
+   * If invalid, an error message is returned in the second element.
+   */
+  F3D_EXPORT std::pair<bool, std::string> isValid() const;
+};
+
+/**
+ * Describe a 3D surfacic mesh stored in buffers owned by the caller, so that it can be added to a
+ * scene without copying the points, normals, texture coordinates, colors, arrays and face indices.
+ * 16-bit triangle indices are converted to 32-bit indices.
+ * The buffers have the same requirements than the `mesh_t` vectors, `size` being their number of
+ * values, and must not be modified while they are used by the scene.
+ * `deleter`, if any, is called once the scene does not use the buffers anymore, possibly from
+ * another thread, it is used to release them. Without a deleter, the buffers must stay valid until
+ * the engine is destroyed.
+ */
+struct mesh_view_t
+{
+  template<typename T>
+  struct buffer_t
+  {
+    const T* data = nullptr;
+    size_t size = 0;
+  };
+
+  struct array_t
+  {
+    std::string name;
+    int components = 1;
+    buffer_t<float> values;
+  };
+
+  buffer_t<float> points;
+  buffer_t<float> normals;
+  buffer_t<float> texture_coordinates;
+  buffer_t<unsigned int> face_sides;
+  buffer_t<unsigned int> face_indices;
+  buffer_t<unsigned int> triangle_indices;
+  buffer_t<uint16_t> triangle_indices_16;
+  buffer_t<unsigned char> colors;
+  std::vector<array_t> point_data;
+  std::vector<array_t> cell_data;
+  std::function<void()> deleter;
 
   /**
    * Check validity of the mesh.
@@ -5,10 +5,28 @@
 #include "export.h"
 #include "image.h"
 
+#include <future>
 #include <string>
+#include <vector>
 
 namespace f3d
 {
+/**
+ * The arbitrary output variables of a render, see `window::renderToAOVs`.
+ * All the images have the size of the window and start from the bottom left corner.
+ */
+struct F3D_EXPORT aovs_t
+{
+  /** The color, identical to `renderToImage` */
+  image color;
+  /** The distance to the camera plane, 1 FLOAT channel, 0 for the background */
+  image depth;
+  /** The normal facing the camera in view space, 3 FLOAT channels, null for the background */
+  image normal;
+  /** The index of the actor starting from 1, 1 SHORT channel, 0 for the background */
+  image index;
+};
+
 /**
  * @class   window
  * @brief   Abstract class to render in a window or an image
@@ -76,6 +94,82 @@ public:
    */
   virtual image renderToImage(bool noBackground = false) = 0;
 
+  /**
+   * Perform a render of the window to the screen and write the result in an existing f3d::image,
+   * like `renderToImage`. The image is reallocated only if its size, channel count or
+   * channel type does not match, otherwise its buffer is written directly, including a buffer
+   * wrapped without copy.
+   * Return a reference to the image.
+   */
+  virtual image& renderToImage(image& output, bool noBackground = false) = 0;
+
+  /**
+   * Perform a render of the window and start transferring the result to the CPU without waiting
+   * for it, so that the transfer overlaps with the next renders.
+   * Call `get()` on the returned future to recover a f3d::image, identical to the one returned
+   * by `renderToImage`. It must be called from the rendering thread and before the window
+   * is destroyed. Falls back to `renderToImage` if asynchronous transfer is not supported.
+   */
+  virtual std::future<image> renderToImageAsync(bool noBackground = false) = 0;
+
+  /**
+   * Perform renders of the window in tiles and stitch them in a f3d::image `scale` times larger
+   * than the window in each direction, like `renderToImage`. This bypasses the limits of the
+   * framebuffer size to create very large images. The tiles overlap so that screen space effects
+   * are continuous, and the 2D annotations are not rendered.
+   * Return the resulting f3d::image. A scale lower than 2 is identical to `renderToImage`.
+   */
+  virtual image renderToTiledImage(int scale, bool noBackground = false) = 0;
+
+  /**
+   * Render the horizontal band `index`, from the top, of `count` bands of equal heights of the
+   * image returned by `renderToTiledImage`, so that several processes loading the same scene
+   * with the same options and window size can each render a band of a slow image, eg: a
+   * raytraced one, the bands being stacked from the first to the last to form the image.
+   * The bands are rendered in tiles like `renderToTiledImage`, with their overlap, so that the
+   * screen space effects and the denoiser are continuous across the bands.
+   * Return the resulting f3d::image, which is empty if the index is not lower than the count.
+   */
+  virtual image renderToTiledImageBand(
+    int scale, int index, int count, bool noBackground = false) = 0;
+
+  /**
+   * Perform a render of the window like `renderToImage`, and recover the depth and the normals
+   * of the same render, reconstructed from its depth buffer, and the index of the actor visible in
+   * each pixel, in the order the actors were added to the scene. The index requires an additional
+   * render of the props ids, without any shading. The depth and the normals are null when they
+   * are not available, eg. when raytracing.
+   * Return the resulting f3d::aovs_t.
+   */
+  virtual aovs_t renderToAOVs(bool noBackground = false) = 0;
+
+  /**
+   * Render the window from each of the provided camera states, like `renderToImage`.
+   * The options are updated once and the transfer of each image overlaps with the renders of the
+   * next views, which is much faster than moving the camera and calling `renderToImage` in a loop.
+   * The camera is restored once all the views are rendered.
+   * Return the resulting f3d::image of each view.
+   */
+  virtual std::vector<image> renderViews(
+    const std::vector<camera_state_t>& views, bool noBackground = false) = 0;
+
+  /**
+   * Render the window from each of the provided camera states like `renderViews`, and pack the
+   * results in a single f3d::image, row by row from the top left corner, with `columns` views per
+   * row. Unused cells of the last row are black.
+   * Return the resulting f3d::image, empty if no views are provided.
+   */
+  virtual image renderViewsToSpriteSheet(
+    const std::vector<camera_state_t>& views, int columns, bool noBackground = false) = 0;
+
+  /**
+   * Set camera states of additional views, rendered side by side after the main view
+   * in equal parts of the window. All the views share the same scene data, which is only
+   * uploaded once, but the main view is the only one using `getCamera`, the interactor
+   * and displaying the annotations. An empty vector goes back to a single view.
+   */
+  virtual window& setAdditionalViews(const std::vector<camera_state_t>& views) = 0;
+
   /**
    * Set the size of the window.
    */
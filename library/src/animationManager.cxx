@@ -3,11 +3,15 @@
 #include "interactor_impl.h"
 #include "log.h"
 #include "options.h"
-#include "window.h"
+#include "window_impl.h"
+
+#include "vtkF3DMetaImporter.h"
 
 #include <vtkDoubleArray.h>
 #include <vtkImporter.h>
+#include <vtkMath.h>
 #include <vtkProgressBarRepresentation.h>
+#include <vtkRenderWindow.h>
 #include <vtkVersion.h>
 
 #include <cmath>
@@ -16,7 +20,7 @@
 namespace f3d::detail
 {
 //----------------------------------------------------------------------------
-animationManager::animationManager(const options& options, window& window)
+animationManager::animationManager(const options& options, window_impl& window)
   : Options(options)
   , Window(window)
 {
@@ -149,6 +153,19 @@ bool animationManager::Initialize()
   return true;
 }
 
+//----------------------------------------------------------------------------
+void animationManager::Finalize()
+{
+  this->StopAnimation();
+  this->HasAnimation = false;
+  this->AvailAnimations = -1;
+  this->CurrentTime = 0;
+  this->CurrentTimeSet = false;
+  this->TimeRange[0] = 0.0;
+  this->TimeRange[1] = 0.0;
+  this->ProgressWidget = nullptr;
+}
+
 //----------------------------------------------------------------------------
 void animationManager::StartAnimation()
 {
@@ -177,6 +194,12 @@ void animationManager::ToggleAnimation()
     if (this->CallBackId != 0)
     {
       this->Interactor->removeTimerCallBack(this->CallBackId);
+      this->CallBackId = 0;
+    }
+    if (this->Paced)
+    {
+      this->Window.GetRenderWindow()->SetSwapControl(0);
+      this->Paced = false;
     }
     if (this->Playing)
     {
@@ -190,9 +213,28 @@ void animationManager::ToggleAnimation()
       // Always reset previous tick when starting the animation
       this->PreviousTick = std::chrono::steady_clock::now();
 
-      double frameRate = this->Options.scene.animation.frame_rate;
-      this->CallBackId =
-        this->Interactor->createTimerCallBack(1000.0 / frameRate, [this]() { this->Tick(); });
+      // When the swap of the buffers waits for the vertical sync, each tick is rendered as soon
+      // as the previous frame is presented, otherwise a timer ticks at the frame rate
+      this->Paced = this->Options.scene.animation.vsync &&
+        this->Window.GetRenderWindow()->SetSwapControl(1);
+      if (this->Paced)
+      {
+        this->ScheduleTick();
+      }
+      else
+      {
+        double frameRate = this->Options.scene.animation.frame_rate;
+        this->CallBackId =
+          this->Interactor->createTimerCallBack(1000.0 / frameRate, [this]() { this->Tick(); });
+      }
+    }
+
+    // The files lagging behind while playing are brought to the current time once paused
+    vtkF3DMetaImporter* metaImporter = vtkF3DMetaImporter::SafeDownCast(this->Importer);
+    if (!this->Playing && metaImporter && metaImporter->HasPendingUpdate() &&
+      this->LoadAtTime(this->CurrentTime))
+    {
+      this->Window.render();
     }
 
     if (this->Playing && this->Options.scene.camera.index.has_value())
@@ -206,19 +248,34 @@ void animationManager::ToggleAnimation()
   }
 }
 
+//----------------------------------------------------------------------------
+void animationManager::ScheduleTick()
+{
+  this->CallBackId = this->Interactor->createOneShotTimerCallBack(0,
+    [this]()
+    {
+      this->CallBackId = 0;
+      this->Tick();
+      if (this->Playing && this->Paced)
+      {
+        this->ScheduleTick();
+      }
+    });
+}
+
 //----------------------------------------------------------------------------
 void animationManager::Tick()
 {
   assert(this->Interactor);
 
-  // Compute time since previous tick
+  // Compute time since previous tick, which is the time between the presentation of the last
+  // two frames when paced by the vertical sync, since the render returns once it is swapped
   std::chrono::steady_clock::time_point tick = std::chrono::steady_clock::now();
-  auto timeInMS =
-    std::chrono::duration_cast<std::chrono::milliseconds>(tick - this->PreviousTick).count();
+  double elapsedTime = std::chrono::duration<double>(tick - this->PreviousTick).count();
   this->PreviousTick = tick;
 
-  // Convert to a usable time in seconds
-  double elapsedTime = static_cast<double>(timeInMS) / 1000.0;
+  // A frame rendered long after the previous one jumps to the current time, the frames that could
+  // not be presented in between are never loaded
   double animationSpeedFactor = this->Options.scene.animation.speed_factor;
 
   // elapsedTime can be negative
@@ -237,7 +294,19 @@ void animationManager::Tick()
       modulo(this->CurrentTime - this->TimeRange[0], this->TimeRange[1] - this->TimeRange[0]);
   }
 
-  if (this->LoadAtTime(this->CurrentTime))
+  // While playing, a file that is slow to read shows its latest decoded time step instead of
+  // slowing down the others
+  vtkF3DMetaImporter* metaImporter = vtkF3DMetaImporter::SafeDownCast(this->Importer);
+  if (metaImporter)
+  {
+    metaImporter->SetAsynchronousUpdate(true);
+  }
+  bool loaded = this->LoadAtTime(this->CurrentTime);
+  if (metaImporter)
+  {
+    metaImporter->SetAsynchronousUpdate(false);
+  }
+  if (loaded)
   {
     this->Window.render();
   }
@@ -355,4 +424,45 @@ void animationManager::GetTimeRange(double timeRange[2])
   timeRange[0] = this->TimeRange[0];
   timeRange[1] = this->TimeRange[1];
 }
+
+//----------------------------------------------------------------------------
+void animationManager::PlayCameraTrack(
+  const std::function<camera_state_t(double)>& interpolateCameraState, int duration)
+{
+  camera& cam = this->Window.getCamera();
+
+  // the first frame is rendered normally so the pending options are taken into account
+  bool firstFrame = true;
+  auto renderAt = [&](double ratio)
+  {
+    cam.setState(interpolateCameraState(ratio));
+    if (firstFrame)
+    {
+      this->Window.render();
+      firstFrame = false;
+    }
+    else
+    {
+      this->Window.RenderCamera();
+    }
+  };
+
+  if (duration > 0)
+  {
+    // TODO implement a way to not queue key presses while the animation is running
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto end = start + std::chrono::milliseconds(duration);
+    auto now = start;
+    while (now < end)
+    {
+      const double timeDelta =
+        std::chrono::duration_cast<std::chrono::milliseconds>(now - start).count();
+      renderAt((1 - std::cos(vtkMath::Pi() * (timeDelta / duration))) / 2);
+      now = std::chrono::steady_clock::now();
+    }
+  }
+
+  renderAt(1.); // ensure final update
+}
 }
@@ -11,7 +11,9 @@
 
 #include "vtkF3DConfigure.h"
 #include "vtkF3DNoRenderWindow.h"
+#include "vtkF3DTrace.h"
 
+#include <vtkRenderWindow.h>
 #include <vtkVersion.h>
 
 #include <vtksys/Directory.hxx>
@@ -37,6 +39,7 @@ engine::engine(
   const std::optional<window::Type>& windowType, bool offscreen, const context::function& loader)
   : Internals(new engine::internals)
 {
+  F3D_TRACE_SCOPE("engine::engine");
   // Ensure all lib initialization is done (once)
   detail::init::initialize();
 
@@ -98,9 +101,20 @@ engine engine::createWGL(bool offscreen)
 }
 
 //----------------------------------------------------------------------------
-engine engine::createEGL(bool offscreen)
+engine engine::createEGL(bool offscreen, int deviceIndex)
 {
-  return { window::Type::EGL, offscreen, context::egl() };
+  engine eng(window::Type::EGL, offscreen, context::egl());
+  if (deviceIndex >= 0)
+  {
+    eng.Internals->Window->SetDeviceIndex(deviceIndex);
+  }
+  return eng;
+}
+
+//----------------------------------------------------------------------------
+int engine::getEGLDeviceCount()
+{
+  return detail::window_impl::GetEGLDeviceCount();
 }
 
 //----------------------------------------------------------------------------
@@ -224,6 +238,9 @@ void engine::loadPlugin(const std::string& pathOrName, const std::vector<std::st
   std::string pluginOrigin = "static";
   factory* factory = factory::instance();
 
+  // the whole loading is locked so that a plugin is never opened twice by concurrent engines
+  const std::lock_guard<std::recursive_mutex> lock(factory->getMutex());
+
   // check if the plugin is already loaded
   for (auto* plug : factory->getPlugins())
   {
@@ -323,6 +340,39 @@ void engine::loadPlugin(const std::string& pathOrName, const std::vector<std::st
   log::debug("Loaded plugin ", plug->getName(), " from: \"", plug->getOrigin(), "\"");
 }
 
+//----------------------------------------------------------------------------
+void engine::declarePlugin(
+  const std::string& jsonPath, const std::vector<std::string>& pluginSearchPaths)
+{
+  factory::declared_plugin plug;
+  try
+  {
+    auto root = nlohmann::json::parse(std::ifstream(jsonPath));
+    plug.Name = root.at("name").get<std::string>();
+    for (const auto& jsonReader : root.at("readers"))
+    {
+      factory::declared_reader reader;
+      reader.Name = jsonReader.at("name").get<std::string>();
+      reader.Description = jsonReader.value("description", "");
+      reader.Extensions = jsonReader.value("extensions", std::vector<std::string>());
+      reader.MimeTypes = jsonReader.value("mimetypes", std::vector<std::string>());
+      reader.Score = jsonReader.value("score", 50);
+      reader.HasSceneReader = jsonReader.value("full_scene", false);
+      reader.HasGeometryReader = jsonReader.value("geometry_reader", !reader.HasSceneReader);
+      plug.Readers.emplace_back(std::move(reader));
+    }
+  }
+  catch (const nlohmann::json::exception& ex)
+  {
+    throw engine::plugin_exception(
+      "Cannot declare the plugin from \"" + jsonPath + "\": " + ex.what());
+  }
+
+  plug.Loader = [name = plug.Name, pluginSearchPaths]()
+  { engine::loadPlugin(name, pluginSearchPaths); };
+  factory::instance()->declare(plug);
+}
+
 //----------------------------------------------------------------------------
 void engine::autoloadPlugins()
 {
@@ -423,6 +473,7 @@ engine::libInformation engine::getLibInfo()
 std::vector<engine::readerInformation> engine::getReadersInfo()
 {
   std::vector<readerInformation> readersInfo;
+  const std::lock_guard<std::recursive_mutex> lock(factory::instance()->getMutex());
   const auto& plugins = factory::instance()->getPlugins();
   for (const auto& plugin : plugins)
   {
@@ -439,6 +490,21 @@ std::vector<engine::readerInformation> engine::getReadersInfo()
       readersInfo.push_back(info);
     }
   }
+  for (const auto& plugin : factory::instance()->getDeclaredPlugins())
+  {
+    for (const auto& reader : plugin.Readers)
+    {
+      readerInformation info;
+      info.PluginName = plugin.Name;
+      info.Name = reader.Name;
+      info.Description = reader.Description;
+      info.Extensions = reader.Extensions;
+      info.MimeTypes = reader.MimeTypes;
+      info.HasSceneReader = reader.HasSceneReader;
+      info.HasGeometryReader = reader.HasGeometryReader;
+      readersInfo.push_back(info);
+    }
+  }
   return readersInfo;
 }
 
@@ -448,6 +514,49 @@ void engine::setCachePath(const std::string& cachePath)
   this->Internals->Window->SetCachePath(cachePath);
 }
 
+//----------------------------------------------------------------------------
+engine& engine::precompileShaders(const options& opt)
+{
+  F3D_TRACE_SCOPE("engine::precompileShaders");
+  detail::window_impl& win = *this->Internals->Window;
+  if (win.getType() == window::Type::NONE)
+  {
+    return *this;
+  }
+
+  // a quad with the point attributes used by the mappers
+  mesh_t mesh;
+  mesh.points = { 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 1.f, 1.f, 0.f, 0.f, 1.f, 0.f };
+  mesh.normals = { 0.f, 0.f, 1.f, 0.f, 0.f, 1.f, 0.f, 0.f, 1.f, 0.f, 0.f, 1.f };
+  mesh.texture_coordinates = { 0.f, 0.f, 1.f, 0.f, 1.f, 1.f, 0.f, 1.f };
+  mesh.face_sides = { 4 };
+  mesh.face_indices = { 0, 1, 2, 3 };
+
+  // do not show the window only to compile shaders
+  vtkRenderWindow* renWin = win.GetRenderWindow();
+  bool showWindow = renWin->GetShowWindow();
+  if (!renWin->GetMapped())
+  {
+    renWin->SetShowWindow(false);
+  }
+
+  options previous = *this->Internals->Options;
+  camera_state_t cameraState = win.getCamera().getState();
+  *this->Internals->Options = opt;
+
+  this->Internals->Scene->add(mesh);
+  win.render();
+  this->Internals->Scene->clear();
+
+  // shader programs are kept by the render window across clears
+  *this->Internals->Options = std::move(previous);
+  win.getCamera().setState(cameraState);
+  renWin->SetShowWindow(showWindow);
+  log::debug("Shaders precompiled");
+
+  return *this;
+}
+
 //----------------------------------------------------------------------------
 engine::no_window_exception::no_window_exception(const std::string& what)
   : exception(what)
@@ -3,17 +3,27 @@
 #include "export.h"
 #include "init.h"
 
+#include "vtkF3DConfigure.h"
+
+#if F3D_MODULE_EXR
+#include "vtkF3DEXRWriter.h"
+#endif
+
 #include <vtkBMPWriter.h>
+#include <vtkCallbackCommand.h>
+#include <vtkDataArray.h>
 #include <vtkDataArrayRange.h>
 #include <vtkDoubleArray.h>
 #include <vtkImageData.h>
 #include <vtkImageReader2.h>
 #include <vtkImageReader2Collection.h>
 #include <vtkImageReader2Factory.h>
+#include <vtkJPEGReader.h>
 #include <vtkJPEGWriter.h>
 #include <vtkPNGReader.h>
 #include <vtkPNGWriter.h>
 #include <vtkPointData.h>
+#include <vtkSMPTools.h>
 #include <vtkSmartPointer.h>
 #include <vtkStringArray.h>
 #include <vtkTIFFWriter.h>
@@ -21,6 +31,19 @@
 #include <vtkVersion.h>
 #include <vtksys/SystemTools.hxx>
 
+#ifdef _WIN32
+#include <vtksys/Encoding.hxx>
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240729)
 #include <vtkImageSSIM.h>
 #else
@@ -28,10 +51,21 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <mutex>
 #include <regex>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
 #include <unordered_map>
 
 namespace f3d
@@ -45,11 +79,455 @@ public:
     { SaveFormat::BMP, "BMP" },
     { SaveFormat::JPG, "JPG" },
     { SaveFormat::TIF, "TIF" },
+    { SaveFormat::EXR, "EXR" },
   };
 
   vtkSmartPointer<vtkImageData> Image;
   std::unordered_map<std::string, std::string> Metadata;
 
+  /**
+   * A read only view of a file mapped in memory, decoded in place by the readers supporting
+   * memory buffers instead of being read by small chunks
+   */
+  struct MappedFile
+  {
+    const void* Data = nullptr;
+    size_t Size = 0;
+
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    void operator=(const MappedFile&) = delete;
+
+    bool Open(const std::string& path)
+    {
+#ifdef _WIN32
+      HANDLE file = CreateFileW(vtksys::Encoding::ToWindowsExtendedPath(path).c_str(),
+        GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+      if (file == INVALID_HANDLE_VALUE)
+      {
+        return false;
+      }
+      LARGE_INTEGER size;
+      HANDLE mapping = nullptr;
+      if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+      {
+        mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+      }
+      CloseHandle(file);
+      if (!mapping)
+      {
+        return false;
+      }
+      this->Data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+      CloseHandle(mapping);
+      this->Size = this->Data ? static_cast<size_t>(size.QuadPart) : 0;
+#else
+      int fd = open(path.c_str(), O_RDONLY);
+      if (fd < 0)
+      {
+        return false;
+      }
+      struct stat st;
+      void* memory = MAP_FAILED;
+      if (fstat(fd, &st) == 0 && st.st_size > 0)
+      {
+        memory = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+      }
+      close(fd);
+      if (memory != MAP_FAILED)
+      {
+        // the decoders read the file sequentially
+        madvise(memory, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+        this->Data = memory;
+        this->Size = static_cast<size_t>(st.st_size);
+      }
+#endif
+      return this->Data != nullptr;
+    }
+
+    ~MappedFile()
+    {
+      if (this->Data)
+      {
+#ifdef _WIN32
+        UnmapViewOfFile(this->Data);
+#else
+        munmap(const_cast<void*>(this->Data), this->Size);
+#endif
+      }
+    }
+  };
+
+  /**
+   * Create the reader of an image file, chosen by its extension first since choosing it
+   * among all the image readers opens the file once for each of them
+   */
+  /**
+   * Conversions between floats and the bits of IEEE 754 halves, rounding to the nearest even.
+   * Both paths are computed and selected without branches so that the loops are vectorized.
+   */
+  static std::uint16_t FloatToHalf(float value)
+  {
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const std::uint32_t sign = (bits >> 16) & 0x8000u;
+    bits &= 0x7fffffffu;
+
+    // too large values are infinite, NaN stays a quiet NaN
+    const std::uint32_t special = bits > 0x7f800000u ? 0x7e00u : 0x7c00u;
+
+    // the addition of 0.5 shifts the denormals mantissa in place and rounds it
+    float denormalValue;
+    std::memcpy(&denormalValue, &bits, sizeof(bits));
+    denormalValue += 0.5f;
+    std::uint32_t denormal;
+    std::memcpy(&denormal, &denormalValue, sizeof(denormal));
+    denormal -= 0x3f000000u;
+
+    // rebias the exponent and round the mantissa, ties to even
+    const std::uint32_t normal = (bits + 0xc8000fffu + ((bits >> 13) & 1u)) >> 13;
+
+    const std::uint32_t half =
+      bits >= 0x47800000u ? special : (bits < 0x38800000u ? denormal : normal);
+    return static_cast<std::uint16_t>(half | sign);
+  }
+
+  static float HalfToFloat(std::uint16_t half)
+  {
+    std::uint32_t bits = static_cast<std::uint32_t>(half & 0x7fffu) << 13;
+    const std::uint32_t exponent = bits & 0x0f800000u;
+    bits += 0x38000000u;
+
+    // infinite and NaN keep the maximal exponent
+    const std::uint32_t special = bits + 0x38000000u;
+
+    // denormals are normalized by a float subtraction
+    float denormalValue;
+    const std::uint32_t denormalBits = bits + 0x00800000u;
+    std::memcpy(&denormalValue, &denormalBits, sizeof(denormalBits));
+    denormalValue -= 6.103515625e-05f;
+    std::uint32_t denormal;
+    std::memcpy(&denormal, &denormalValue, sizeof(denormal));
+
+    bits = exponent == 0x0f800000u ? special : (exponent == 0 ? denormal : bits);
+    bits |= static_cast<std::uint32_t>(half & 0x8000u) << 16;
+
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+
+  /**
+   * Convert the channels of an image between FLOAT and HALF, using all the cores
+   */
+  static image ConvertChannels(const image& self, ChannelType type)
+  {
+    const std::size_t size =
+      static_cast<std::size_t>(self.getWidth()) * self.getHeight() * self.getChannelCount();
+    image output(self.getWidth(), self.getHeight(), self.getChannelCount(), type);
+    if (type == ChannelType::HALF)
+    {
+      const float* src = static_cast<const float*>(self.getContent());
+      std::uint16_t* dst = static_cast<std::uint16_t*>(output.getContent());
+      vtkSMPTools::For(0, size,
+        [&](std::size_t begin, std::size_t end)
+        {
+          for (std::size_t i = begin; i < end; i++)
+          {
+            dst[i] = FloatToHalf(src[i]);
+          }
+        });
+    }
+    else
+    {
+      const std::uint16_t* src = static_cast<const std::uint16_t*>(self.getContent());
+      float* dst = static_cast<float*>(output.getContent());
+      vtkSMPTools::For(0, size,
+        [&](std::size_t begin, std::size_t end)
+        {
+          for (std::size_t i = begin; i < end; i++)
+          {
+            dst[i] = HalfToFloat(src[i]);
+          }
+        });
+    }
+    output.Internals->Metadata = self.Internals->Metadata;
+    return output;
+  }
+
+  /**
+   * Sum the squared differences of the normalized values of two images of the same type and size,
+   * row by row using all the cores. The rows are contiguous so the kernel is vectorized.
+   * Stop as soon as the sum is larger than the bound, and return false in this case.
+   */
+  template<typename T>
+  static bool SumSquaredErrors(
+    const image& self, const image& reference, double scale, double bound, double& sum)
+  {
+    const std::size_t rowSize = static_cast<std::size_t>(self.getWidth()) * self.getChannelCount();
+    const T* values = static_cast<const T*>(self.getContent());
+    const T* referenceValues = static_cast<const T*>(reference.getContent());
+
+    std::atomic<double> total(0.0);
+    std::atomic<bool> exceeded(false);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(self.getHeight()),
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        for (vtkIdType row = begin; row < end && !exceeded.load(std::memory_order_relaxed); row++)
+        {
+          const T* a = values + row * rowSize;
+          const T* b = referenceValues + row * rowSize;
+          double rowSum = 0.0;
+          for (std::size_t i = 0; i < rowSize; i++)
+          {
+            const double diff = static_cast<double>(a[i]) - static_cast<double>(b[i]);
+            rowSum += diff * diff;
+          }
+          rowSum *= scale * scale;
+
+          double current = total.load(std::memory_order_relaxed);
+          while (!total.compare_exchange_weak(current, current + rowSum))
+          {
+          }
+          if (current + rowSum > bound)
+          {
+            exceeded = true;
+          }
+        }
+      });
+    sum = total;
+    return !exceeded;
+  }
+
+  static vtkSmartPointer<vtkImageReader2> CreateReader(const std::string& path)
+  {
+    const std::string ext = vtksys::SystemTools::GetFilenameLastExtension(path);
+    auto reader = vtkSmartPointer<vtkImageReader2>::Take(
+      vtkImageReader2Factory::CreateImageReader2FromExtension(ext.c_str()));
+    if (!reader || !reader->CanReadFile(path.c_str()))
+    {
+      reader = vtkSmartPointer<vtkImageReader2>::Take(
+        vtkImageReader2Factory::CreateImageReader2(path.c_str()));
+    }
+    return reader;
+  }
+
+  static void checkTerminalTextCompatibility(const image& img)
+  {
+    const unsigned int depth = img.getChannelCount();
+    if (img.getChannelType() != ChannelType::BYTE || depth < 3 || depth > 4)
+    {
+      throw write_exception("image must be byte RGB or RGBA");
+    }
+  }
+
+  static std::string encodeBase64(const std::vector<unsigned char>& data)
+  {
+    constexpr std::string_view alphabet =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string encoded;
+    encoded.reserve((data.size() + 2) / 3 * 4);
+    for (size_t i = 0; i < data.size(); i += 3)
+    {
+      const size_t remaining = data.size() - i;
+      const unsigned int triplet = data[i] << 16 | (remaining > 1 ? data[i + 1] << 8 : 0) |
+        (remaining > 2 ? data[i + 2] : 0);
+      encoded += alphabet[(triplet >> 18) & 0x3f];
+      encoded += alphabet[(triplet >> 12) & 0x3f];
+      encoded += remaining > 1 ? alphabet[(triplet >> 6) & 0x3f] : '=';
+      encoded += remaining > 2 ? alphabet[triplet & 0x3f] : '=';
+    }
+    return encoded;
+  }
+
+  /* Build the terminal text of an image, the numbers are formatted by hand since
+    ostream insertions dominate the cost. When a previous image is provided, the cursor
+    is moved back to the top left of its text and only the changed characters are written.
+  */
+  static std::string buildTerminalText(const image& img, const image* previous)
+  {
+    const int depth = img.getChannelCount();
+    const int width = img.getWidth();
+    const int height = img.getHeight();
+    const unsigned char* content = static_cast<unsigned char*>(img.getContent());
+    const unsigned char* previousContent =
+      previous ? static_cast<unsigned char*>(previous->getContent()) : nullptr;
+
+    constexpr unsigned char alphaCutoff = 127;
+
+    std::string out;
+    out.reserve(static_cast<size_t>(width) * (height + 1) / 2 * 8);
+
+    /* Function to retrieve pixels so we can return:
+      - transparent black values for out-of-bounds coords,
+      - opaque alpha value when the image has no alpha channel.
+      Rendering with half blocks means 1 line of text represents 2 rows of pixels
+      so we _will_ attempt to access a line past the bottom if the height is not even.
+    */
+    const auto getPixel = [=](const unsigned char* pixels, int x, int y)
+    {
+      if (y < height)
+      {
+        const size_t i = depth * (static_cast<size_t>(height - 1 - y) * width + x);
+        const int rgb = pixels[i + 0] << 16 | pixels[i + 1] << 8 | pixels[i + 2];
+        const bool transparent = depth > 3 ? pixels[i + 3] <= alphaCutoff : false;
+        return std::make_pair(rgb, transparent);
+      }
+      return std::make_pair(0x000000, true);
+    };
+
+    const auto appendNumber = [&](unsigned int value)
+    {
+      char digits[10];
+      int n = 0;
+      do
+      {
+        digits[n++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+      } while (value > 0);
+      while (n > 0)
+      {
+        out += digits[--n];
+      }
+    };
+
+    /* Functions to manipulate the terminal colors using escape sequences.
+      Keep track of the foreground and background states to avoid redundant sequences.
+    */
+    int currentFg = -1;
+    int currentBg = -1;
+    const auto appendColor = [&](std::string_view prefix, int rgb)
+    {
+      out += prefix;
+      appendNumber((rgb >> 16) & 0xff);
+      out += ';';
+      appendNumber((rgb >> 8) & 0xff);
+      out += ';';
+      appendNumber(rgb & 0xff);
+      out += 'm';
+    };
+    const auto setFg = [&](int rgb)
+    {
+      if (currentFg != rgb)
+      {
+        appendColor("\033[38;2;", rgb); // set 24-bit foreground
+        currentFg = rgb;
+      }
+    };
+    const auto setBg = [&](int rgb)
+    {
+      if (currentBg != rgb)
+      {
+        appendColor("\033[48;2;", rgb); // set 24-bit background
+        currentBg = rgb;
+      }
+    };
+    const auto reset = [&]()
+    {
+      if (currentBg > -1 || currentFg > -1)
+      {
+        out += "\033[0m"; // reset all
+        currentBg = -1;
+        currentFg = -1;
+      }
+    };
+    const auto resetBg = [&]()
+    {
+      if (currentBg > -1)
+      {
+        out += "\033[49m"; // reset background
+        currentBg = -1;
+      }
+    };
+
+    constexpr std::string_view EMPTY_BLOCK = " ";
+    constexpr std::string_view TOP_BLOCK = u8"\u2580";
+    constexpr std::string_view BOTTOM_BLOCK = u8"\u2584";
+    constexpr std::string_view FULL_BLOCK = u8"\u2588";
+    constexpr std::string_view EOL = "\n";
+
+    if (previousContent && height > 2)
+    {
+      // move back to the first column of the first line of the previous text
+      out += "\r\033[";
+      appendNumber((height + 1) / 2 - 1);
+      out += 'A';
+    }
+    else if (previousContent)
+    {
+      out += '\r';
+    }
+
+    for (int y = 0; y < height; y += 2)
+    {
+      if (y > 0)
+      {
+        out += EOL;
+      }
+      int skipped = 0;
+      for (int x = 0; x < width; ++x)
+      {
+        const auto [rgb1, blank1] = getPixel(content, x, y + 0);
+        const auto [rgb2, blank2] = getPixel(content, x, y + 1);
+        if (previousContent)
+        {
+          // move the cursor over the characters that did not change
+          if (std::make_pair(rgb1, blank1) == getPixel(previousContent, x, y + 0) &&
+            std::make_pair(rgb2, blank2) == getPixel(previousContent, x, y + 1))
+          {
+            skipped++;
+            continue;
+          }
+          if (skipped > 0)
+          {
+            out += "\033[";
+            appendNumber(skipped);
+            out += 'C';
+            skipped = 0;
+          }
+        }
+
+        if (blank1 && blank2)
+        {
+          reset();
+          out += EMPTY_BLOCK;
+        }
+        else if (blank1)
+        {
+          resetBg();
+          setFg(rgb2);
+          out += BOTTOM_BLOCK;
+        }
+        else if (blank2)
+        {
+          resetBg();
+          setFg(rgb1);
+          out += TOP_BLOCK;
+        }
+        else if (rgb1 == rgb2)
+        {
+          setFg(rgb1);
+          out += FULL_BLOCK;
+        }
+        else if (rgb1 == currentFg || rgb2 == currentBg)
+        {
+          setBg(rgb2);
+          setFg(rgb1);
+          out += TOP_BLOCK;
+        }
+        else
+        {
+          setBg(rgb1);
+          setFg(rgb2);
+          out += BOTTOM_BLOCK;
+        }
+      }
+      reset(); // reset after every line to keep the right edge of the image
+    }
+
+    return out;
+  }
+
   template<typename WriterType>
   std::vector<unsigned char> SaveBuffer(vtkSmartPointer<WriterType> writer)
   {
@@ -57,6 +535,11 @@ public:
     writer->SetInputData(this->Image);
     writer->Write();
 
+    if (writer->GetErrorCode() != 0)
+    {
+      throw write_exception("Cannot save to buffer");
+    }
+
     std::vector<unsigned char> result;
 
     auto valRange = vtk::DataArrayValueRange(writer->GetResult());
@@ -121,7 +604,21 @@ public:
             saveFormatString.at(format) + " format is only compatible with BYTE channel types");
         }
         break;
-      default:
+      case SaveFormat::TIF:
+        if (type == ChannelType::HALF)
+        {
+          throw write_exception("TIF format is not compatible with HALF channel types");
+        }
+        break;
+      case SaveFormat::EXR:
+#if F3D_MODULE_EXR
+        if (type != ChannelType::FLOAT && type != ChannelType::HALF)
+        {
+          throw write_exception("EXR format is only compatible with FLOAT or HALF channel types");
+        }
+#else
+        throw write_exception("EXR format is not supported, the EXR module is not built");
+#endif
         break;
     }
 
@@ -136,6 +633,7 @@ public:
       case SaveFormat::PNG:
       case SaveFormat::BMP:
       case SaveFormat::TIF:
+      case SaveFormat::EXR:
         if (count < 1 || count > 4)
         {
           throw write_exception(saveFormatString.at(format) +
@@ -144,6 +642,82 @@ public:
         break;
     }
   }
+
+  /**
+   * A fixed size pool of threads encoding images, created on first use.
+   * Queued tasks are all processed before the pool is destroyed.
+   */
+  class encoder_pool
+  {
+  public:
+    static encoder_pool& Get()
+    {
+      static encoder_pool pool;
+      return pool;
+    }
+
+    std::future<void> Push(std::packaged_task<void()> task)
+    {
+      std::future<void> future = task.get_future();
+      {
+        std::lock_guard<std::mutex> lock(this->Mutex);
+        this->Tasks.emplace_back(std::move(task));
+      }
+      this->Condition.notify_one();
+      return future;
+    }
+
+    ~encoder_pool()
+    {
+      {
+        std::lock_guard<std::mutex> lock(this->Mutex);
+        this->Stop = true;
+      }
+      this->Condition.notify_all();
+      for (std::thread& worker : this->Workers)
+      {
+        worker.join();
+      }
+    }
+
+    encoder_pool(const encoder_pool&) = delete;
+    encoder_pool& operator=(const encoder_pool&) = delete;
+
+  private:
+    encoder_pool()
+    {
+      const unsigned int count = std::max(1u, std::thread::hardware_concurrency());
+      for (unsigned int i = 0; i < count; i++)
+      {
+        this->Workers.emplace_back(&encoder_pool::Work, this);
+      }
+    }
+
+    void Work()
+    {
+      while (true)
+      {
+        std::packaged_task<void()> task;
+        {
+          std::unique_lock<std::mutex> lock(this->Mutex);
+          this->Condition.wait(lock, [this]() { return this->Stop || !this->Tasks.empty(); });
+          if (this->Tasks.empty())
+          {
+            return;
+          }
+          task = std::move(this->Tasks.front());
+          this->Tasks.pop_front();
+        }
+        task();
+      }
+    }
+
+    std::mutex Mutex;
+    std::condition_variable Condition;
+    std::deque<std::packaged_task<void()>> Tasks;
+    std::vector<std::thread> Workers;
+    bool Stop = false;
+  };
 };
 
 //----------------------------------------------------------------------------
@@ -171,6 +745,10 @@ image::image(unsigned int width, unsigned int height, unsigned int channelCount,
     case ChannelType::FLOAT:
       this->Internals->Image->AllocateScalars(VTK_FLOAT, static_cast<int>(channelCount));
       break;
+    case ChannelType::HALF:
+      // VTK has no half float type, the bits of the halves are stored as shorts
+      this->Internals->Image->AllocateScalars(VTK_SHORT, static_cast<int>(channelCount));
+      break;
   }
 }
 
@@ -186,12 +764,21 @@ image::image(const std::string& path)
     throw read_exception("Cannot open file " + path);
   }
 
-  auto reader = vtkSmartPointer<vtkImageReader2>::Take(
-    vtkImageReader2Factory::CreateImageReader2(fullPath.c_str()));
-
+  vtkSmartPointer<vtkImageReader2> reader = image::internals::CreateReader(fullPath);
   if (reader)
   {
-    reader->SetFileName(fullPath.c_str());
+    // PNG and JPEG files are decoded straight from the mapped file
+    image::internals::MappedFile mapped;
+    if ((vtkPNGReader::SafeDownCast(reader) || vtkJPEGReader::SafeDownCast(reader)) &&
+      mapped.Open(fullPath))
+    {
+      reader->SetMemoryBuffer(mapped.Data);
+      reader->SetMemoryBufferLength(static_cast<vtkIdType>(mapped.Size));
+    }
+    else
+    {
+      reader->SetFileName(fullPath.c_str());
+    }
     reader->Update();
     this->Internals->Image = reader->GetOutput();
 
@@ -208,6 +795,61 @@ image::image(const std::string& path)
   }
 }
 
+//----------------------------------------------------------------------------
+image::image(unsigned int width, unsigned int height, unsigned int channelCount, ChannelType type,
+  void* buffer, std::function<void(void*)> deleter)
+  : Internals(new image::internals())
+{
+  int vtkType = VTK_UNSIGNED_CHAR;
+  switch (type)
+  {
+    case ChannelType::BYTE:
+      vtkType = VTK_UNSIGNED_CHAR;
+      break;
+    case ChannelType::SHORT:
+      vtkType = VTK_UNSIGNED_SHORT;
+      break;
+    case ChannelType::FLOAT:
+      vtkType = VTK_FLOAT;
+      break;
+    case ChannelType::HALF:
+      vtkType = VTK_SHORT;
+      break;
+  }
+
+  // the array does not own the buffer, the deleter is called when the array is destroyed
+  vtkSmartPointer<vtkDataArray> scalars =
+    vtkSmartPointer<vtkDataArray>::Take(vtkDataArray::CreateDataArray(vtkType));
+  scalars->SetNumberOfComponents(static_cast<int>(channelCount));
+  scalars->SetVoidArray(
+    buffer, static_cast<vtkIdType>(width) * height * channelCount, 1 /* do not free */);
+
+  if (deleter)
+  {
+    struct ExternalBuffer
+    {
+      void* Buffer;
+      std::function<void(void*)> Deleter;
+    };
+
+    vtkNew<vtkCallbackCommand> onDelete;
+    onDelete->SetClientData(new ExternalBuffer{ buffer, std::move(deleter) });
+    onDelete->SetCallback(
+      [](vtkObject*, unsigned long, void* clientData, void*)
+      {
+        ExternalBuffer* external = static_cast<ExternalBuffer*>(clientData);
+        external->Deleter(external->Buffer);
+      });
+    onDelete->SetClientDataDeleteCallback(
+      [](void* clientData) { delete static_cast<ExternalBuffer*>(clientData); });
+    scalars->AddObserver(vtkCommand::DeleteEvent, onDelete);
+  }
+
+  this->Internals->Image = vtkSmartPointer<vtkImageData>::New();
+  this->Internals->Image->SetDimensions(static_cast<int>(width), static_cast<int>(height), 1);
+  this->Internals->Image->GetPointData()->SetScalars(scalars);
+}
+
 //----------------------------------------------------------------------------
 image::~image()
 {
@@ -306,6 +948,8 @@ image::ChannelType image::getChannelType() const
       return ChannelType::SHORT;
     case VTK_FLOAT:
       return ChannelType::FLOAT;
+    case VTK_SHORT:
+      return ChannelType::HALF;
     default:
       break;
   }
@@ -371,6 +1015,22 @@ bool image::compare(const image& reference, double threshold, double& error) con
     return true;
   }
 
+  // Identical buffers do not need the SSIM pipeline, which is the common case in regression tests
+  std::size_t size = static_cast<std::size_t>(this->getWidth()) * this->getHeight() * count *
+    this->Internals->Image->GetScalarSize();
+  if (size == 0 || std::memcmp(this->getContent(), reference.getContent(), size) == 0)
+  {
+    error = 0;
+    return true;
+  }
+
+  // the SSIM is computed on the float values of the halves
+  if (type == ChannelType::HALF)
+  {
+    return internals::ConvertChannels(*this, ChannelType::FLOAT)
+      .compare(internals::ConvertChannels(reference, ChannelType::FLOAT), threshold, error);
+  }
+
 #if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240729)
   vtkNew<vtkImageSSIM> ssim;
   std::vector<int> ranges(count);
@@ -385,6 +1045,7 @@ bool image::compare(const image& reference, double threshold, double& error) con
       ssim->SetInputRange(ranges);
       break;
     case ChannelType::FLOAT:
+    case ChannelType::HALF:
       ssim->SetInputToAuto();
       break;
   }
@@ -423,6 +1084,56 @@ bool image::compare(const image& reference, double threshold, double& error) con
 #endif
 }
 
+//----------------------------------------------------------------------------
+bool image::comparePSNR(const image& reference, double threshold, double& psnr) const
+{
+  ChannelType type = this->getChannelType();
+  if (type != reference.getChannelType() ||
+    this->getChannelCount() != reference.getChannelCount() ||
+    this->getWidth() != reference.getWidth() || this->getHeight() != reference.getHeight())
+  {
+    psnr = 0;
+    return false;
+  }
+
+  // the PSNR is computed on the float values of the halves
+  if (type == ChannelType::HALF)
+  {
+    return internals::ConvertChannels(*this, ChannelType::FLOAT)
+      .comparePSNR(internals::ConvertChannels(reference, ChannelType::FLOAT), threshold, psnr);
+  }
+
+  const double nbValues =
+    static_cast<double>(this->getWidth()) * this->getHeight() * this->getChannelCount();
+  if (nbValues == 0)
+  {
+    psnr = std::numeric_limits<double>::infinity();
+    return true;
+  }
+
+  // the PSNR is lower than the threshold once the sum of the squared errors is larger than the
+  // one of a PSNR equal to the threshold, the peak of the normalized values being 1
+  const double bound = nbValues * std::pow(10.0, -threshold / 10.0);
+  double sum = 0;
+  bool complete = false;
+  switch (type)
+  {
+    case ChannelType::BYTE:
+      complete = internals::SumSquaredErrors<std::uint8_t>(*this, reference, 1 / 255.0, bound, sum);
+      break;
+    case ChannelType::SHORT:
+      complete =
+        internals::SumSquaredErrors<std::uint16_t>(*this, reference, 1 / 65535.0, bound, sum);
+      break;
+    default:
+      complete = internals::SumSquaredErrors<float>(*this, reference, 1.0, bound, sum);
+      break;
+  }
+
+  psnr = sum == 0 ? std::numeric_limits<double>::infinity() : 10 * std::log10(nbValues / sum);
+  return complete && psnr >= threshold;
+}
+
 //----------------------------------------------------------------------------
 bool image::operator==(const image& reference) const
 {
@@ -457,6 +1168,9 @@ std::vector<double> image::getNormalizedPixel(const std::pair<int, int>& xy) con
       case ChannelType::SHORT:
         pixel[i] = v / 65535.0;
         break;
+      case ChannelType::HALF:
+        pixel[i] = internals::HalfToFloat(static_cast<std::uint16_t>(static_cast<short>(v)));
+        break;
       default:
         pixel[i] = v;
         break;
@@ -490,6 +1204,11 @@ void image::save(const std::string& path, SaveFormat format) const
     case SaveFormat::BMP:
       writer = vtkSmartPointer<vtkBMPWriter>::New();
       break;
+    case SaveFormat::EXR:
+#if F3D_MODULE_EXR
+      writer = vtkSmartPointer<vtkF3DEXRWriter>::New();
+#endif
+      break;
   }
 
   writer->SetFileName(path.c_str());
@@ -502,6 +1221,19 @@ void image::save(const std::string& path, SaveFormat format) const
   }
 }
 
+//----------------------------------------------------------------------------
+std::future<void> image::saveAsync(const std::string& path, SaveFormat format) const
+{
+  internals::checkSaveFormatCompatibility(*this, format);
+
+  // the copy constructor does not copy the metadata, which are needed by the PNG writer
+  auto copy = std::make_shared<image>(*this);
+  copy->Internals->Metadata = this->Internals->Metadata;
+
+  return internals::encoder_pool::Get().Push(
+    std::packaged_task<void()>([copy, path, format]() { copy->save(path, format); }));
+}
+
 //----------------------------------------------------------------------------
 std::vector<unsigned char> image::saveBuffer(SaveFormat format) const
 {
@@ -519,6 +1251,10 @@ std::vector<unsigned char> image::saveBuffer(SaveFormat format) const
       return this->Internals->SaveBuffer(vtkSmartPointer<vtkJPEGWriter>::New());
     case SaveFormat::BMP:
       return this->Internals->SaveBuffer(vtkSmartPointer<vtkBMPWriter>::New());
+#if F3D_MODULE_EXR
+    case SaveFormat::EXR:
+      return this->Internals->SaveBuffer(vtkSmartPointer<vtkF3DEXRWriter>::New());
+#endif
     default:
       throw write_exception(
         "Cannot save to buffer in the specified format: " + internals::saveFormatString.at(format));
@@ -528,134 +1264,145 @@ std::vector<unsigned char> image::saveBuffer(SaveFormat format) const
 //----------------------------------------------------------------------------
 const f3d::image& image::toTerminalText(std::ostream& stream) const
 {
-  const int depth = this->getChannelCount();
-  if (this->getChannelType() != ChannelType::BYTE || depth < 3 || depth > 4)
+  internals::checkTerminalTextCompatibility(*this);
+  std::string text = internals::buildTerminalText(*this, nullptr);
+  stream.write(text.data(), static_cast<std::streamsize>(text.size()));
+  return *this;
+}
+
+//----------------------------------------------------------------------------
+const f3d::image& image::toTerminalText(std::ostream& stream, const image& previous) const
+{
+  internals::checkTerminalTextCompatibility(*this);
+  if (previous.getWidth() != this->getWidth() || previous.getHeight() != this->getHeight() ||
+    previous.getChannelCount() != this->getChannelCount() ||
+    previous.getChannelType() != this->getChannelType())
   {
-    throw write_exception("image must be byte RGB or RGBA");
+    throw write_exception("previous image must have the same size and type");
   }
 
-  int dims[3];
-  this->Internals->Image->GetDimensions(dims);
-  const int width = dims[0];
-  const int height = dims[1];
-  const unsigned char* content = static_cast<unsigned char*>(this->getContent());
+  std::string text = internals::buildTerminalText(*this, &previous);
+  stream.write(text.data(), static_cast<std::streamsize>(text.size()));
+  return *this;
+}
 
-  constexpr unsigned char alphaCutoff = 127;
+//----------------------------------------------------------------------------
+const f3d::image& image::toTerminalGraphics(std::ostream& stream) const
+{
+  internals::checkTerminalTextCompatibility(*this);
 
-  /* Function to retrieve pixels so we can return:
-    - transparent black values for out-of-bounds coords,
-    - opaque alpha value when the image has no alpha channel.
-    Rendering with half blocks means 1 line of text represents 2 rows of pixels
-    so we _will_ attempt to access a line past the bottom if the height is not even.
-  */
-  const auto getPixel = [=](int x, int y)
+  // kitty graphics protocol, a PNG payload encoded in base64 and sent in chunks
+  std::string payload = internals::encodeBase64(this->saveBuffer(SaveFormat::PNG));
+  constexpr size_t chunkSize = 4096;
+  for (size_t i = 0; i < payload.size() || i == 0; i += chunkSize)
   {
-    if (x >= 0 && x < width && y >= 0 && y < height)
-    {
-      const size_t i = depth * ((height - 1 - y) * width + x);
-      const int rgb = content[i + 0] << 16 | content[i + 1] << 8 | content[i + 2];
-      const bool transparent = depth > 3 ? content[i + 3] <= alphaCutoff : false;
-      return std::make_pair(rgb, transparent);
-    }
-    return std::make_pair(0x000000, true);
-  };
+    bool last = i + chunkSize >= payload.size();
+    stream << "\033_G" << (i == 0 ? "a=T,f=100," : "") << "m=" << (last ? 0 : 1) << ";";
+    stream.write(payload.data() + i,
+      static_cast<std::streamsize>(std::min(chunkSize, payload.size() - i)));
+    stream << "\033\\";
+  }
+  return *this;
+}
 
-  /* Functions to manipulate the terminal colors using escape sequences.
-    Keep track of the foreground and background states to avoid redundant sequences.
-  */
-  int currentFg = -1;
-  int currentBg = -1;
-  const auto setFg = [&](int rgb)
+//----------------------------------------------------------------------------
+image image::downsample(unsigned int factor) const
+{
+  if (factor == 0)
   {
-    if (currentFg != rgb)
-    {
-      stream << "\033[38;2;" // set 24-bit foreground
-             << ((rgb >> 16) & 0xff) << ";" << ((rgb >> 8) & 0xff) << ";" << (rgb & 0xff) << "m";
-      currentFg = rgb;
-    }
-  };
-  const auto setBg = [&](int rgb)
+    throw write_exception("downsample factor must be positive");
+  }
+
+  const unsigned int width = this->getWidth();
+  const unsigned int height = this->getHeight();
+  const unsigned int count = this->getChannelCount();
+  const ChannelType type = this->getChannelType();
+
+  // halves are filtered as floats
+  if (type == ChannelType::HALF)
   {
-    if (currentBg != rgb)
-    {
-      stream << "\033[48;2;" // set 24-bit background
-             << ((rgb >> 16) & 0xff) << ";" << ((rgb >> 8) & 0xff) << ";" << (rgb & 0xff) << "m";
-      currentBg = rgb;
-    }
-  };
-  const auto reset = [&]()
+    return internals::ConvertChannels(
+      internals::ConvertChannels(*this, ChannelType::FLOAT).downsample(factor), ChannelType::HALF);
+  }
+
+  image output((width + factor - 1) / factor, (height + factor - 1) / factor, count, type);
+
+  // box filter, the blocks on the right and top edges may be partial
+  const auto filter = [&](auto* dst, const auto* src)
   {
-    if (currentBg > -1 || currentFg > -1)
+    const unsigned int outWidth = output.getWidth();
+    std::vector<double> sum(count);
+    for (unsigned int y = 0; y < output.getHeight(); y++)
     {
-      stream << "\033[0m"; // reset all
-      currentBg = -1;
-      currentFg = -1;
+      for (unsigned int x = 0; x < outWidth; x++)
+      {
+        std::fill(sum.begin(), sum.end(), 0.0);
+        const unsigned int xEnd = std::min((x + 1) * factor, width);
+        const unsigned int yEnd = std::min((y + 1) * factor, height);
+        for (unsigned int sy = y * factor; sy < yEnd; sy++)
+        {
+          for (unsigned int sx = x * factor; sx < xEnd; sx++)
+          {
+            const auto* pixel = src + (static_cast<size_t>(sy) * width + sx) * count;
+            for (unsigned int c = 0; c < count; c++)
+            {
+              sum[c] += pixel[c];
+            }
+          }
+        }
+
+        const double samples = static_cast<double>(xEnd - x * factor) * (yEnd - y * factor);
+        auto* pixel = dst + (static_cast<size_t>(y) * outWidth + x) * count;
+        for (unsigned int c = 0; c < count; c++)
+        {
+          using ValueType = std::remove_reference_t<decltype(*pixel)>;
+          pixel[c] = std::is_floating_point_v<ValueType>
+            ? static_cast<ValueType>(sum[c] / samples)
+            : static_cast<ValueType>(std::lround(sum[c] / samples));
+        }
+      }
     }
   };
-  const auto resetBg = [&]()
+
+  switch (type)
   {
-    if (currentBg > -1)
-    {
-      stream << "\033[49m"; // reset background
-      currentBg = -1;
-    }
-  };
+    case ChannelType::BYTE:
+      filter(static_cast<unsigned char*>(output.getContent()),
+        static_cast<const unsigned char*>(this->getContent()));
+      break;
+    case ChannelType::SHORT:
+      filter(static_cast<unsigned short*>(output.getContent()),
+        static_cast<const unsigned short*>(this->getContent()));
+      break;
+    case ChannelType::FLOAT:
+      filter(static_cast<float*>(output.getContent()),
+        static_cast<const float*>(this->getContent()));
+      break;
+    case ChannelType::HALF:
+      break;
+  }
 
-  constexpr std::string_view EMPTY_BLOCK = " ";
-  constexpr std::string_view TOP_BLOCK = u8"\u2580";
-  constexpr std::string_view BOTTOM_BLOCK = u8"\u2584";
-  constexpr std::string_view FULL_BLOCK = u8"\u2588";
-  constexpr std::string_view EOL = "\n";
+  output.Internals->Metadata = this->Internals->Metadata;
+  return output;
+}
 
-  for (int y = 0; y < height; y += 2)
+//----------------------------------------------------------------------------
+image image::convert(ChannelType type) const
+{
+  const ChannelType current = this->getChannelType();
+  if (current == type)
   {
-    if (y > 0)
-    {
-      stream << EOL;
-    }
-    for (int x = 0; x < width; ++x)
-    {
-      const auto [rgb1, blank1] = getPixel(x, y + 0);
-      const auto [rgb2, blank2] = getPixel(x, y + 1);
-      if (blank1 && blank2)
-      {
-        reset();
-        stream << EMPTY_BLOCK;
-      }
-      else if (blank1)
-      {
-        resetBg();
-        setFg(rgb2);
-        stream << BOTTOM_BLOCK;
-      }
-      else if (blank2)
-      {
-        resetBg();
-        setFg(rgb1);
-        stream << TOP_BLOCK;
-      }
-      else if (rgb1 == rgb2)
-      {
-        setFg(rgb1);
-        stream << FULL_BLOCK;
-      }
-      else if (rgb1 == currentFg || rgb2 == currentBg)
-      {
-        setBg(rgb2);
-        setFg(rgb1);
-        stream << TOP_BLOCK;
-      }
-      else
-      {
-        setBg(rgb1);
-        setFg(rgb2);
-        stream << BOTTOM_BLOCK;
-      }
-    }
-    reset(); // reset after every line to keep the right edge of the image
+    image output(*this);
+    output.Internals->Metadata = this->Internals->Metadata;
+    return output;
   }
 
-  return *this;
+  if ((current != ChannelType::FLOAT && current != ChannelType::HALF) ||
+    (type != ChannelType::FLOAT && type != ChannelType::HALF))
+  {
+    throw write_exception("only FLOAT and HALF channel types can be converted to each other");
+  }
+  return internals::ConvertChannels(*this, type);
 }
 
 //----------------------------------------------------------------------------
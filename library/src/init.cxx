@@ -15,6 +15,7 @@
 #include <vtkVersion.h>
 
 #include <memory>
+#include <mutex>
 
 namespace f3d::detail
 {
@@ -22,11 +23,10 @@ namespace f3d::detail
 //----------------------------------------------------------------------------
 void init::initialize()
 {
+  // engines and logs can be used from several threads, initialize only once
   static std::unique_ptr<init> instance;
-  if (!instance)
-  {
-    instance = std::make_unique<init>();
-  }
+  static std::once_flag once;
+  std::call_once(once, []() { instance = std::make_unique<init>(); });
 }
 
 //----------------------------------------------------------------------------
@@ -11,17 +11,23 @@
 #include "vtkF3DInteractorStyle.h"
 #include "vtkF3DRenderer.h"
 
+#include <vtkActor.h>
 #include <vtkCallbackCommand.h>
 #include <vtkCellPicker.h>
 #include <vtkGenericRenderWindowInteractor.h>
+#include <vtkMapper.h>
 #include <vtkMath.h>
 #include <vtkMatrix3x3.h>
 #include <vtkNew.h>
 #include <vtkPicker.h>
 #include <vtkPointPicker.h>
+#include <vtkPolyData.h>
+#include <vtkPropCollection.h>
 #include <vtkRenderWindow.h>
 #include <vtkRenderWindowInteractor.h>
+#include <vtkRenderer.h>
 #include <vtkRendererCollection.h>
+#include <vtkStaticCellLocator.h>
 #include <vtkStringArray.h>
 #include <vtkVersion.h>
 #include <vtksys/SystemTools.hxx>
@@ -29,6 +35,7 @@
 #include <algorithm>
 #include <chrono>
 #include <cmath>
+#include <future>
 #include <map>
 #include <vector>
 
@@ -87,6 +94,21 @@ public:
     middleButtonReleaseCallback->SetCallback(OnMiddleButtonRelease);
     this->Style->AddObserver(vtkCommand::MiddleButtonReleaseEvent, middleButtonReleaseCallback);
 
+    vtkNew<vtkCallbackCommand> mouseMoveCallback;
+    mouseMoveCallback->SetClientData(this);
+    mouseMoveCallback->SetCallback(OnMouseMove);
+    this->Style->AddObserver(vtkCommand::MouseMoveEvent, mouseMoveCallback);
+
+    vtkNew<vtkCallbackCommand> leftButtonReleaseCallback;
+    leftButtonReleaseCallback->SetClientData(this);
+    leftButtonReleaseCallback->SetCallback(OnLeftButtonRelease);
+    this->Style->AddObserver(vtkCommand::LeftButtonReleaseEvent, leftButtonReleaseCallback);
+
+    vtkNew<vtkCallbackCommand> rightButtonReleaseCallback;
+    rightButtonReleaseCallback->SetClientData(this);
+    rightButtonReleaseCallback->SetCallback(OnRightButtonRelease);
+    this->Style->AddObserver(vtkCommand::RightButtonReleaseEvent, rightButtonReleaseCallback);
+
     this->Recorder = vtkSmartPointer<vtkF3DInteractorEventRecorder>::New();
     this->Recorder->SetInteractor(this->VTKInteractor);
   }
@@ -376,13 +398,83 @@ public:
 
     self->VTKInteractor->GetEventPosition(self->MiddleButtonDownPosition);
 
+    // start building the locators of the large meshes before the button is released
+    self->PreparePickers(
+      self->VTKInteractor->GetRenderWindow()->GetRenderers()->GetFirstRenderer());
+
     self->Style->OnMiddleButtonDown();
   }
 
+  //----------------------------------------------------------------------------
+  /**
+   * Set up the cell picker with a cell locator for each large mesh of the renderer.
+   * The locators are built on a background thread and cached until the mesh is modified.
+   * A mesh whose locator is still being built is not picked by the cell picker,
+   * which would test all its cells, only by the point picker.
+   */
+  void PreparePickers(vtkRenderer* renderer)
+  {
+    this->CellPicker->RemoveAllLocators();
+    this->CellPicker->InitializePickList();
+    this->CellPicker->PickFromListOn();
+
+    std::map<vtkPolyData*, PickLocator> locators;
+    vtkPropCollection* props = renderer->GetViewProps();
+    vtkCollectionSimpleIterator it;
+    props->InitTraversal(it);
+    while (vtkProp* prop = props->GetNextProp(it))
+    {
+      vtkActor* actor = vtkActor::SafeDownCast(prop);
+      vtkPolyData* mesh = actor && actor->GetMapper()
+        ? vtkPolyData::SafeDownCast(actor->GetMapper()->GetInput())
+        : nullptr;
+      if (!mesh || mesh->GetNumberOfCells() < this->PickLocatorMinimumCells)
+      {
+        this->CellPicker->AddPickList(prop);
+        continue;
+      }
+
+      auto cached = this->PickLocators.find(mesh);
+      if (cached != this->PickLocators.end() && cached->second.MTime == mesh->GetMTime())
+      {
+        locators.emplace(mesh, std::move(cached->second));
+      }
+      else if (!locators.count(mesh))
+      {
+        PickLocator entry;
+        entry.Mesh = mesh;
+        entry.MTime = mesh->GetMTime();
+        entry.Locator = vtkSmartPointer<vtkStaticCellLocator>::New();
+        entry.Locator->SetDataSet(mesh);
+
+        // the bounds are computed here as they are also used by the render
+        mesh->GetBounds();
+        vtkStaticCellLocator* locator = entry.Locator;
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+        entry.Build = std::async(std::launch::deferred, [locator]() { locator->BuildLocator(); });
+#else
+        entry.Build = std::async(std::launch::async, [locator]() { locator->BuildLocator(); });
+#endif
+        locators.emplace(mesh, std::move(entry));
+      }
+
+      PickLocator& entry = locators.at(mesh);
+      if (entry.Build.wait_for(std::chrono::seconds(0)) != std::future_status::timeout)
+      {
+        this->CellPicker->AddLocator(entry.Locator);
+        this->CellPicker->AddPickList(prop);
+      }
+    }
+
+    // the locators of the meshes not in the renderer anymore are released
+    this->PickLocators = std::move(locators);
+  }
+
   //----------------------------------------------------------------------------
   static void OnMiddleButtonRelease(vtkObject*, unsigned long, void* clientData, void*)
   {
     internals* self = static_cast<internals*>(clientData);
+    self->ApplyPendingMotion();
 
     const int* middleButtonUpPosition = self->VTKInteractor->GetEventPosition();
 
@@ -396,6 +488,8 @@ public:
       vtkRenderer* renderer =
         self->VTKInteractor->GetRenderWindow()->GetRenderers()->GetFirstRenderer();
 
+      self->PreparePickers(renderer);
+
       bool pickSuccessful = false;
       double picked[3];
       if (self->CellPicker->Pick(x, y, 0, renderer))
@@ -456,6 +550,132 @@ public:
     self->Style->OnMiddleButtonUp();
   }
 
+  //----------------------------------------------------------------------------
+  /**
+   * While the event loop runs, the mouse moves of a camera interaction are coalesced: the first
+   * move schedules a timer, which only fires once the events queued meanwhile are processed,
+   * and the camera is then moved once by the accumulated delta and rendered.
+   * Otherwise, when rendering is slower than the mouse polling rate, each queued move would
+   * render a frame and the view would lag behind the input.
+   */
+  static void OnMouseMove(vtkObject*, unsigned long, void* clientData, void*)
+  {
+    internals* self = static_cast<internals*>(clientData);
+
+    // the moves without interaction, and the played interactions, are handled as is
+    if (!self->CoalesceMotion || self->Style->GetState() == VTKIS_NONE)
+    {
+      self->Style->OnMouseMove();
+      return;
+    }
+
+    if (self->MotionTimer != 0)
+    {
+      return;
+    }
+
+    // the position the camera was last moved from, the delta is computed from it when applied
+    self->VTKInteractor->GetLastEventPosition(self->MotionOrigin);
+    self->MotionTimer =
+      self->Interactor.createOneShotTimerCallBack(1, [self]() { self->ApplyPendingMotion(); });
+  }
+
+  //----------------------------------------------------------------------------
+  /**
+   * Move the camera by the delta of the coalesced mouse moves, if any
+   */
+  void ApplyPendingMotion()
+  {
+    if (this->MotionTimer == 0)
+    {
+      return;
+    }
+
+    // the timer is already removed when it fired
+    if (this->OneShotTimerCallBacks.count(this->MotionTimer) > 0)
+    {
+      this->Interactor.removeTimerCallBack(this->MotionTimer);
+    }
+    this->MotionTimer = 0;
+
+    this->VTKInteractor->SetLastEventPosition(this->MotionOrigin);
+    this->Style->OnMouseMove();
+  }
+
+  //----------------------------------------------------------------------------
+  /**
+   * Observe the events of a played interaction, see interactor.replay options.
+   * The recorded timer events are the idle time of the session, they are dropped by fast
+   * replays. The camera interactions are rendered every RenderInterval events, the state
+   * reached by the previous events being rendered before the next one is processed.
+   */
+  static void OnReplayEvent(vtkObject*, unsigned long event, void* clientData, void*)
+  {
+    internals* self = static_cast<internals*>(clientData);
+    ReplayState& replay = self->Replay;
+    // only the input events are counted, not the events invoked by the interactor style
+    if (event == vtkCommand::ModifiedEvent || event == vtkCommand::RenderEvent ||
+      event == vtkCommand::StartInteractionEvent || event == vtkCommand::InteractionEvent ||
+      event == vtkCommand::EndInteractionEvent)
+    {
+      return;
+    }
+    if (event == vtkCommand::TimerEvent && replay.Fast)
+    {
+      replay.Callback->AbortFlagOn();
+      return;
+    }
+
+    if (replay.RenderInterval > 0 && replay.PendingEvents >= replay.RenderInterval)
+    {
+      self->RenderReplayCheckpoint();
+    }
+    replay.PendingEvents++;
+  }
+
+  //----------------------------------------------------------------------------
+  /**
+   * Render the events played since the previous checkpoint and log their timings
+   */
+  void RenderReplayCheckpoint()
+  {
+    ReplayState& replay = this->Replay;
+    const auto renderStart = std::chrono::steady_clock::now();
+    this->Window.render();
+    const auto renderEnd = std::chrono::steady_clock::now();
+
+    const double eventsTime =
+      std::chrono::duration<double, std::milli>(renderStart - replay.CheckpointTime).count();
+    const double renderTime =
+      std::chrono::duration<double, std::milli>(renderEnd - renderStart).count();
+    log::debug("Interaction replay: events ", replay.Events + 1, " to ",
+      replay.Events + replay.PendingEvents, " processed in ", eventsTime, " ms and rendered in ",
+      renderTime, " ms");
+
+    replay.Events += replay.PendingEvents;
+    replay.PendingEvents = 0;
+    replay.Renders++;
+    replay.EventsTime += eventsTime;
+    replay.RenderTime += renderTime;
+    replay.CheckpointTime = renderEnd;
+  }
+
+  //----------------------------------------------------------------------------
+  static void OnLeftButtonRelease(vtkObject*, unsigned long, void* clientData, void*)
+  {
+    internals* self = static_cast<internals*>(clientData);
+    self->ApplyPendingMotion();
+    self->Style->OnLeftButtonUp();
+  }
+
+  //----------------------------------------------------------------------------
+  static void OnRightButtonRelease(vtkObject*, unsigned long, void* clientData, void*)
+  {
+    internals* self = static_cast<internals*>(clientData);
+    self->ApplyPendingMotion();
+    self->Style->OnRightButtonUp();
+  }
+
   //----------------------------------------------------------------------------
   std::function<bool(int, const std::string&)> KeyPressUserCallBack = [](int, const std::string&)
   { return false; };
@@ -465,14 +685,130 @@ public:
   //----------------------------------------------------------------------------
   void StartInteractor()
   {
+    // While interacting, the HDRI is preprocessed on a worker thread so the window stays
+    // responsive, render again once it is done to switch to the new environment
+    vtkF3DRenderer* ren = vtkF3DRenderer::SafeDownCast(
+      this->VTKInteractor->GetRenderWindow()->GetRenderers()->GetFirstRenderer());
+    ren->SetUseAsyncHDRI(true);
+    this->Interactor.createTimerCallBack(50,
+      [this, ren]()
+      {
+        if (ren->IsHDRIPreprocessed())
+        {
+          this->Window.render();
+        }
+      });
+
+    // Accumulated effects converge over the frames rendered while the view is still
+    this->Interactor.createTimerCallBack(50,
+      [this, ren]()
+      {
+        if (ren->IsRenderAccumulating())
+        {
+          this->Window.render();
+        }
+      });
+
+    // Refined tessellations are also computed on a worker thread, render once they are
+    ren->SetUseAsyncTessellation(true);
+    this->Interactor.createTimerCallBack(50,
+      [this, ren]()
+      {
+        if (ren->IsTessellationRefined())
+        {
+          this->Window.render();
+        }
+      });
+
+    // Streamed point cloud nodes are also read on worker threads, render once they are
+    this->Scene.SetUseAsyncPointClouds(true);
+    this->Interactor.createTimerCallBack(50,
+      [this]()
+      {
+        if (this->Scene.HasNewPointCloudNodes())
+        {
+          this->Window.render();
+        }
+      });
+
+    this->CoalesceMotion = true;
     this->VTKInteractor->Start();
   }
 
   //----------------------------------------------------------------------------
   void StopInteractor()
   {
+    this->CoalesceMotion = false;
+    this->MotionTimer = 0;
     this->VTKInteractor->RemoveObservers(vtkCommand::TimerEvent);
+    for (const auto& [id, timer] : this->OneShotTimerCallBacks)
+    {
+      this->VTKInteractor->DestroyTimer(timer.TimerId);
+    }
+    this->OneShotTimerCallBacks.clear();
     this->VTKInteractor->ExitCallback();
+
+    vtkF3DRenderer* ren = vtkF3DRenderer::SafeDownCast(
+      this->VTKInteractor->GetRenderWindow()->GetRenderers()->GetFirstRenderer());
+    ren->SetUseAsyncHDRI(false);
+    ren->SetUseAsyncTessellation(false);
+    this->Scene.SetUseAsyncPointClouds(false);
+  }
+
+  //----------------------------------------------------------------------------
+  static bool TokenizeCommand(std::string_view command, std::vector<std::string>& tokens)
+  {
+    try
+    {
+      tokens = utils::tokenize(command);
+    }
+    catch (const utils::tokenize_exception&)
+    {
+      log::error("Command: unable to tokenize command:\"", command, "\", ignoring");
+      return false;
+    }
+    return true;
+  }
+
+  //----------------------------------------------------------------------------
+  bool ExecuteCommand(std::string_view command, const std::vector<std::string>& tokens)
+  {
+    const std::string& action = tokens[0];
+    try
+    {
+      // Find the right command to call
+      auto callbackIt = this->CommandCallbacks.find(action);
+      if (callbackIt != this->CommandCallbacks.end())
+      {
+        return callbackIt->second({ tokens.begin() + 1, tokens.end() });
+      }
+      else
+      {
+        log::error("Command: \"", action, "\" is not recognized, ignoring");
+        return false;
+      }
+    }
+    catch (const f3d::options::incompatible_exception&)
+    {
+      log::error("Command: provided args in command: \"", command,
+        "\" are not compatible with action:\"", action, "\", ignoring");
+    }
+    catch (const f3d::options::inexistent_exception&)
+    {
+      log::error("Command: provided args in command: \"", command,
+        "\" point to an inexistent option, ignoring");
+    }
+    catch (const f3d::options::no_value_exception&)
+    {
+      log::error("Command: provided args in command: \"", command,
+        "\" point to an option without a value, ignoring");
+    }
+    catch (const f3d::options::parsing_exception&)
+    {
+      log::error("Command: provided args in command: \"", command,
+        "\" cannot be parsed into an option, ignoring");
+    }
+    return false;
   }
 
   //----------------------------------------------------------------------------
@@ -485,30 +821,9 @@ public:
   template<class CameraStateInterpolator>
   void AnimateCameraTransition(CameraStateInterpolator interpolateCameraState)
   {
-    window& win = this->Window;
-    camera& cam = win.getCamera();
-    const int duration = this->TransitionDuration;
-
-    if (duration > 0)
-    {
-      // TODO implement a way to not queue key presses while the animation is running
-
-      const auto start = std::chrono::high_resolution_clock::now();
-      const auto end = start + std::chrono::milliseconds(duration);
-      auto now = start;
-      while (now < end)
-      {
-        const double timeDelta =
-          std::chrono::duration_cast<std::chrono::milliseconds>(now - start).count();
-        const double ratio = (1 - std::cos(vtkMath::Pi() * (timeDelta / duration))) / 2;
-        cam.setState(interpolateCameraState(ratio));
-        this->Window.render();
-        now = std::chrono::high_resolution_clock::now();
-      }
-    }
-
-    cam.setState(interpolateCameraState(1.)); // ensure final update
-    this->Window.render();
+    // the transition is a camera track, its frames do not update the options nor the importers
+    assert(this->AnimationManager);
+    this->AnimationManager->PlayCameraTrack(interpolateCameraState, this->TransitionDuration);
   }
 
   //----------------------------------------------------------------------------
@@ -523,11 +838,50 @@ public:
   vtkSmartPointer<vtkF3DInteractorEventRecorder> Recorder;
   std::map<unsigned long, std::pair<int, std::function<void()>>> TimerCallBacks;
 
+  struct OneShotTimerCallBack
+  {
+    internals* Internals;
+    unsigned long Id;
+    int TimerId;
+    std::function<void()> CallBack;
+  };
+  std::map<unsigned long, OneShotTimerCallBack> OneShotTimerCallBacks;
+
+  // the coalesced mouse moves, see OnMouseMove
+  bool CoalesceMotion = false;
+  unsigned long MotionTimer = 0;
+  int MotionOrigin[2] = { 0, 0 };
+
   std::map<std::string, std::function<bool(const std::vector<std::string>&)>> CommandCallbacks;
 
+  // the played interaction when rendered at checkpoints, see OnReplayEvent
+  struct ReplayState
+  {
+    vtkNew<vtkCallbackCommand> Callback;
+    bool Fast = false;
+    int RenderInterval = 1;
+    int Events = 0;
+    int PendingEvents = 0;
+    int Renders = 0;
+    double EventsTime = 0.0;
+    double RenderTime = 0.0;
+    std::chrono::steady_clock::time_point CheckpointTime;
+  };
+  ReplayState Replay;
+
   vtkNew<vtkCellPicker> CellPicker;
   vtkNew<vtkPointPicker> PointPicker;
 
+  struct PickLocator
+  {
+    vtkSmartPointer<vtkPolyData> Mesh;
+    vtkMTimeType MTime = 0;
+    vtkSmartPointer<vtkStaticCellLocator> Locator;
+    std::future<void> Build;
+  };
+  std::map<vtkPolyData*, PickLocator> PickLocators;
+  vtkIdType PickLocatorMinimumCells = 100000;
+
   int MiddleButtonDownPosition[2] = { 0, 0 };
 
   int DragDistanceTol = 3;      /* px */
@@ -677,6 +1031,10 @@ interactor_impl::interactor_impl(options& options, window_impl& window, scene_im
       return true;
     });
 
+  this->addCommandCallback("print_frame_stats",
+    [&](const std::vector<std::string>&) -> bool
+    { return this->Internals->Window.PrintFrameStatistics(log::VerboseLevel::INFO); });
+
   this->addCommandCallback("set_camera",
     [&](const std::vector<std::string>& args) -> bool
     {
@@ -786,58 +1144,54 @@ interactor& interactor_impl::removeCommandCallback(const std::string& action)
 bool interactor_impl::triggerCommand(std::string_view command)
 {
   std::vector<std::string> tokens;
-  try
+  if (!internals::TokenizeCommand(command, tokens))
   {
-    tokens = utils::tokenize(command);
-  }
-  catch (const utils::tokenize_exception&)
-  {
-    log::error("Command: unable to tokenize command:\"", command, "\", ignoring");
     return false;
   }
+  return this->Internals->ExecuteCommand(command, tokens);
+}
 
-  const std::string& action = tokens[0];
-  try
+//----------------------------------------------------------------------------
+bool interactor_impl::triggerCommands(const std::vector<std::string_view>& commands)
+{
+  // All the commands are parsed before any of them is applied, so that a malformed batch
+  // does not leave the options half modified
+  std::vector<std::vector<std::string>> tokenized(commands.size());
+  for (size_t i = 0; i < commands.size(); i++)
   {
-    // Find the right command to call
-    auto callbackIt = this->Internals->CommandCallbacks.find(action);
-    if (callbackIt != this->Internals->CommandCallbacks.end())
+    if (!internals::TokenizeCommand(commands[i], tokenized[i]))
     {
-      return callbackIt->second({ tokens.begin() + 1, tokens.end() });
-    }
-    else
-    {
-      log::error("Command: \"", action, "\" is not recognized, ignoring");
       return false;
     }
   }
-  catch (const f3d::options::incompatible_exception&)
-  {
-    log::error("Command: provided args in command: \"", command,
-      "\" are not compatible with action:\"", action, "\", ignoring");
-  }
-  catch (const f3d::options::inexistent_exception&)
-  {
-    log::error("Command: provided args in command: \"", command,
-      "\" point to an inexistent option, ignoring");
-  }
-  catch (const f3d::options::no_value_exception&)
+
+  bool success = true;
+  for (size_t i = 0; i < commands.size(); i++)
   {
-    log::error("Command: provided args in command: \"", command,
-      "\" point to an option without a value, ignoring");
+    success = this->Internals->ExecuteCommand(commands[i], tokenized[i]) && success;
   }
-  catch (const f3d::options::parsing_exception&)
+
+  // The options changed by the whole batch are applied by a single render
+  if (!commands.empty())
   {
-    log::error("Command: provided args in command: \"", command,
-      "\" cannot be parsed into an option, ignoring");
+    this->Internals->Window.render();
   }
-  return false;
+  return success;
 }
 
 //----------------------------------------------------------------------------
 void interactor_impl::removeTimerCallBack(unsigned long id)
 {
   this->Internals->VTKInteractor->RemoveObserver(id);
+
+  auto oneShotIt = this->Internals->OneShotTimerCallBacks.find(id);
+  if (oneShotIt != this->Internals->OneShotTimerCallBacks.end())
+  {
+    this->Internals->VTKInteractor->DestroyTimer(oneShotIt->second.TimerId);
+    this->Internals->OneShotTimerCallBacks.erase(oneShotIt);
+    return;
+  }
+
   this->Internals->VTKInteractor->DestroyTimer(this->Internals->TimerCallBacks[id].first);
 }
 
@@ -864,6 +1218,36 @@ unsigned long interactor_impl::createTimerCallBack(double time, std::function<vo
   return id;
 }
 
+//----------------------------------------------------------------------------
+unsigned long interactor_impl::createOneShotTimerCallBack(
+  double time, std::function<void()> callBack)
+{
+  int timerId = this->Internals->VTKInteractor->CreateOneShotTimer(time);
+
+  // Only the event of this timer calls the callback, so that a timer created by a callback
+  // is not called by the event being processed
+  vtkNew<vtkCallbackCommand> timerCallBack;
+  timerCallBack->SetCallback(
+    [](vtkObject*, unsigned long, void* clientData, void* callData)
+    {
+      auto* timer = static_cast<internals::OneShotTimerCallBack*>(clientData);
+      if (!callData || *static_cast<int*>(callData) != timer->TimerId)
+      {
+        return;
+      }
+      std::function<void()> callBackCopy = std::move(timer->CallBack);
+      timer->Internals->Interactor.removeTimerCallBack(timer->Id);
+      callBackCopy();
+    });
+  unsigned long id =
+    this->Internals->VTKInteractor->AddObserver(vtkCommand::TimerEvent, timerCallBack);
+
+  internals::OneShotTimerCallBack& timer = this->Internals->OneShotTimerCallBacks[id];
+  timer = { this->Internals.get(), id, timerId, std::move(callBack) };
+  timerCallBack->SetClientData(&timer);
+  return id;
+}
+
 //----------------------------------------------------------------------------
 void interactor_impl::toggleAnimation()
 {
@@ -921,7 +1305,53 @@ bool interactor_impl::playInteraction(const std::string& file)
     std::string cleanFile = vtksys::SystemTools::CollapseFullPath(file);
     this->Internals->Recorder->SetFileName(cleanFile.c_str());
     this->Internals->Window.UpdateDynamicOptions();
-    this->Internals->Recorder->Play();
+
+    // the played events are not queued, so each move is applied as recorded
+    bool coalesceMotion = this->Internals->CoalesceMotion;
+    this->Internals->ApplyPendingMotion();
+    this->Internals->CoalesceMotion = false;
+
+    // a replay rendered at checkpoints, or fast, is a benchmark of the recorded session
+    internals::ReplayState& replay = this->Internals->Replay;
+    replay.Fast = this->Internals->Options.interactor.replay.fast;
+    replay.RenderInterval = std::max(this->Internals->Options.interactor.replay.render_interval, 0);
+    if (!replay.Fast && replay.RenderInterval == 1)
+    {
+      this->Internals->Recorder->Play();
+    }
+    else
+    {
+      replay.Events = 0;
+      replay.PendingEvents = 0;
+      replay.Renders = 0;
+      replay.EventsTime = 0.0;
+      replay.RenderTime = 0.0;
+      replay.Callback->SetClientData(this->Internals.get());
+      replay.Callback->SetCallback(internals::OnReplayEvent);
+
+      // the camera interactions only render at the checkpoints
+      vtkRenderWindowInteractor* rwi = this->Internals->VTKInteractor;
+      const bool enableRender = rwi->GetEnableRender();
+      rwi->SetEnableRender(false);
+      unsigned long observer = rwi->AddObserver(vtkCommand::AnyEvent, replay.Callback, 1.0);
+
+      const auto start = std::chrono::steady_clock::now();
+      replay.CheckpointTime = start;
+      this->Internals->Recorder->Play();
+      rwi->RemoveObserver(observer);
+      rwi->SetEnableRender(enableRender);
+      if (!rwi->GetDone())
+      {
+        this->Internals->RenderReplayCheckpoint();
+      }
+
+      const double total =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+          .count();
+      log::info("Interaction replay: ", replay.Events, " events played in ", total, " ms, ",
+        replay.RenderTime, " ms of which spent in ", replay.Renders, " renders");
+    }
+    this->Internals->CoalesceMotion = coalesceMotion && !this->Internals->VTKInteractor->GetDone();
   }
 
   // Recorder can stop the interactor, make sure it is still running
@@ -3,6 +3,8 @@
 #include "init.h"
 
 #include "F3DLog.h"
+#include "vtkF3DMetrics.h"
+#include "vtkF3DTrace.h"
 
 #include <vtkObject.h>
 
@@ -106,10 +108,89 @@ void log::setVerboseLevel(log::VerboseLevel level, bool forceStdErr)
   vtkObject::SetGlobalWarningDisplay(level == log::VerboseLevel::DEBUG);
 }
 
+//----------------------------------------------------------------------------
+bool log::isEnabled(log::VerboseLevel level)
+{
+  switch (level)
+  {
+    case (log::VerboseLevel::DEBUG):
+      return F3DLog::IsEnabled(F3DLog::Severity::Debug);
+    case (log::VerboseLevel::INFO):
+      return F3DLog::IsEnabled(F3DLog::Severity::Info);
+    case (log::VerboseLevel::WARN):
+      return F3DLog::IsEnabled(F3DLog::Severity::Warning);
+    case (log::VerboseLevel::ERROR):
+      return F3DLog::IsEnabled(F3DLog::Severity::Error);
+    case (log::VerboseLevel::QUIET):
+    default:
+      return false;
+  }
+}
+
+//----------------------------------------------------------------------------
+void log::setAsynchronous(bool async, std::size_t capacity)
+{
+  detail::init::initialize();
+  if (!F3DLog::SetAsynchronous(async, capacity))
+  {
+    log::warn("Asynchronous logging is not supported without threads");
+  }
+}
+
+//----------------------------------------------------------------------------
+std::uint64_t log::getNumberOfDroppedMessages()
+{
+  return F3DLog::GetNumberOfDroppedMessages();
+}
+
 //----------------------------------------------------------------------------
 void log::waitForUser()
 {
   detail::init::initialize();
   F3DLog::WaitForUser();
 }
+
+//----------------------------------------------------------------------------
+void log::startTrace(const std::string& filePath)
+{
+  vtkF3DTrace::Start(filePath);
+}
+
+//----------------------------------------------------------------------------
+bool log::stopTrace()
+{
+  return vtkF3DTrace::Stop();
+}
+
+//----------------------------------------------------------------------------
+log::traceSpan::traceSpan(const std::string& name)
+{
+  if (vtkF3DTrace::IsEnabled())
+  {
+    this->Name = name;
+    this->Start = vtkF3DTrace::GetTime();
+  }
+}
+
+//----------------------------------------------------------------------------
+log::traceSpan::~traceSpan()
+{
+  if (this->Start >= 0)
+  {
+    vtkF3DTrace::AddSpan(this->Name, this->Start, vtkF3DTrace::GetTime());
+  }
+}
+
+//----------------------------------------------------------------------------
+std::string log::getMetrics(log::MetricsFormat format)
+{
+  return format == log::MetricsFormat::JSON ? vtkF3DMetrics::ToJSON()
+                                            : vtkF3DMetrics::ToPrometheus();
+}
+
+//----------------------------------------------------------------------------
+void log::resetMetrics()
+{
+  vtkF3DMetrics::Reset();
+}
 }
@@ -118,6 +118,12 @@ std::vector<std::string> options::getNames() const
   return setNames;
 }
 
+//----------------------------------------------------------------------------
+std::vector<std::string> options::getChangedNames(const options& other) const
+{
+  return options_tools::getChangedNames(*this, other);
+}
+
 //----------------------------------------------------------------------------
 std::pair<std::string, unsigned int> options::getClosestOption(const std::string& option) const
 {
@@ -166,6 +172,19 @@ void options::removeValue(const std::string& name)
   }
 }
 
+//----------------------------------------------------------------------------
+template<typename T>
+options::key<T> options::getKey(const std::string& name)
+{
+  const options_tools::option_entry& entry = options_tools::find(name);
+  if (*entry.Type != typeid(T))
+  {
+    throw options::incompatible_exception(
+      "Trying to get a key of " + name + " with incompatible type");
+  }
+  return options::key<T>(entry.Address);
+}
+
 //----------------------------------------------------------------------------
 template<typename T>
 T options::parse(const std::string& str)
@@ -185,6 +204,19 @@ F3D_DECL_TYPE(double);
 F3D_DECL_TYPE(f3d::ratio_t);
 F3D_DECL_TYPE(std::string);
 
+//----------------------------------------------------------------------------
+#define F3D_DECL_KEY_INTERNAL(TYPE)                                                                \
+  template F3D_EXPORT options::key<TYPE> options::getKey<TYPE>(const std::string& name)
+#define F3D_DECL_KEY(TYPE)                                                                         \
+  F3D_DECL_KEY_INTERNAL(TYPE);                                                                     \
+  F3D_DECL_KEY_INTERNAL(std::optional<TYPE>)
+F3D_DECL_KEY(bool);
+F3D_DECL_KEY(int);
+F3D_DECL_KEY(double);
+F3D_DECL_KEY(f3d::ratio_t);
+F3D_DECL_KEY(std::string);
+F3D_DECL_KEY(std::vector<double>);
+
 //----------------------------------------------------------------------------
 options::parsing_exception::parsing_exception(const std::string& what)
   : exception(what)
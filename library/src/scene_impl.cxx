@@ -1,25 +1,69 @@
 #include "scene_impl.h"
 
 #include "animationManager.h"
+#include "config.h"
+#include "init.h"
 #include "interactor_impl.h"
 #include "log.h"
 #include "options.h"
 #include "window_impl.h"
 
 #include "factory.h"
+#include "vtkF3DBrickedVolume.h"
 #include "vtkF3DGenericImporter.h"
+#include "vtkF3DImporter.h"
 #include "vtkF3DMemoryMesh.h"
 #include "vtkF3DMetaImporter.h"
+#include "vtkF3DMetrics.h"
+#include "vtkF3DNoRenderWindow.h"
+#include "vtkF3DOctreePointCloud.h"
+#include "vtkF3DReadAhead.h"
+#include "vtkF3DScratchArena.h"
+#include "vtkF3DSnapshotImporter.h"
+#include "vtkF3DTextureCache.h"
+#include "vtkF3DTrace.h"
 
+#include <vtkActor.h>
+#include <vtkActorCollection.h>
+#include <vtkBoundingBox.h>
 #include <vtkCallbackCommand.h>
+#include <vtkCellData.h>
+#include <vtkCompositeDataSet.h>
+#include <vtkDataArray.h>
+#include <vtkDataObject.h>
+#include <vtkDataSet.h>
+#include <vtkDataSetAttributes.h>
+#include <vtkDoubleArray.h>
+#include <vtkFieldData.h>
+#include <vtkImageData.h>
+#include <vtkInformation.h>
+#include <vtkMapper.h>
+#include <vtkMath.h>
+#include <vtkPointData.h>
+#include <vtkPolyData.h>
 #include <vtkProgressBarRepresentation.h>
 #include <vtkProgressBarWidget.h>
+#include <vtkRenderWindow.h>
+#include <vtkRendererCollection.h>
+#include <vtkRenderer.h>
+#include <vtkStreamingDemandDrivenPipeline.h>
 #include <vtkTimerLog.h>
 #include <vtkVersion.h>
+#include <vtkWeakPointer.h>
 #include <vtksys/SystemTools.hxx>
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <memory>
 #include <numeric>
+#include <optional>
+#include <thread>
 #include <vector>
 
 namespace fs = std::filesystem;
@@ -29,6 +73,9 @@ namespace f3d::detail
 class scene_impl::internals
 {
 public:
+  // Maximum size in pixels of the textures imported with scene.thumbnail_profile
+  static constexpr int THUMBNAIL_TEXTURE_MAXIMUM_SIZE = 256;
+
   internals(const options& options, window_impl& window)
     : Options(options)
     , Window(window)
@@ -87,20 +134,502 @@ public:
     data->timer->StartTimer();
   }
 
-  void Load(const std::vector<vtkSmartPointer<vtkImporter>>& importers)
+  struct ProgressiveDataStruct
+  {
+    internals* self;
+    vtkTimerLog* timer;
+    bool resetCamera;
+    bool rendered;
+  };
+
+  /**
+   * Render the importers added so far each time one is added by the meta importer, at most
+   * every 0.5 seconds, resetting the camera on the first render if needed
+   */
+  static void CreateProgressiveRenderingCallback(ProgressiveDataStruct* data, vtkImporter* importer)
+  {
+    vtkNew<vtkCallbackCommand> addedCallback;
+    addedCallback->SetClientData(data);
+    addedCallback->SetCallback(
+      [](vtkObject*, unsigned long, void* clientData, void*)
+      {
+        auto progressiveData = static_cast<ProgressiveDataStruct*>(clientData);
+        progressiveData->timer->StopTimer();
+        if (progressiveData->rendered && progressiveData->timer->GetElapsedTime() < 0.5)
+        {
+          return;
+        }
+
+        window_impl& window = progressiveData->self->Window;
+        window.UpdateDynamicOptions();
+        if (!progressiveData->rendered && progressiveData->resetCamera)
+        {
+          window.getCamera().resetToBounds();
+        }
+        window.render();
+        progressiveData->rendered = true;
+        progressiveData->timer->StartTimer();
+      });
+    importer->AddObserver(vtkF3DMetaImporter::ImporterAddedEvent, addedCallback);
+    data->timer->StartTimer();
+  }
+
+  /**
+   * Create a streamed octree source for a large point cloud file, indexing it on first open.
+   * Returns nullptr if the file is not a point cloud larger than the point budget, the provided
+   * reader may have been updated.
+   */
+  vtkSmartPointer<vtkF3DOctreePointCloud> CreatePointCloud(
+    const fs::path& filePath, vtkAlgorithm* vtkReader)
+  {
+    const std::string octreeFile = vtkF3DOctreePointCloud::GetCacheFileName(filePath.string());
+    if (octreeFile.empty())
+    {
+      log::debug("Point cloud streaming requires a cache path");
+      return nullptr;
+    }
+
+    if (!vtksys::SystemTools::FileExists(octreeFile, true))
+    {
+      vtkReader->Update();
+      vtkPolyData* cloud = vtkPolyData::SafeDownCast(vtkReader->GetOutputDataObject(0));
+      if (!cloud || cloud->GetNumberOfPoints() <= this->Options.scene.point_cloud.budget ||
+        cloud->GetNumberOfPolys() > 0 || cloud->GetNumberOfLines() > 0 ||
+        cloud->GetNumberOfStrips() > 0)
+      {
+        return nullptr;
+      }
+
+      log::debug("Indexing the point cloud into ", octreeFile);
+      if (!vtkF3DOctreePointCloud::BuildOctree(cloud, octreeFile, 50000))
+      {
+        log::warn("Cannot write the point cloud octree ", octreeFile);
+        return nullptr;
+      }
+    }
+
+    // Forget the point clouds of the importers that have been replaced or discarded
+    this->PointClouds.erase(std::remove_if(this->PointClouds.begin(), this->PointClouds.end(),
+                              [](const vtkSmartPointer<vtkF3DOctreePointCloud>& pointCloud)
+                              { return pointCloud->GetReferenceCount() == 1; }),
+      this->PointClouds.end());
+
+    vtkRenderer* renderer = this->Window.GetRenderWindow()->GetRenderers()->GetFirstRenderer();
+    vtkNew<vtkF3DOctreePointCloud> octree;
+    octree->SetFileName(octreeFile);
+    octree->SetPointBudget(this->Options.scene.point_cloud.budget);
+    octree->SetMemoryBudget(this->Options.scene.point_cloud.memory);
+    octree->SetRenderer(renderer);
+    octree->SetAsyncLoading(this->AsyncPointClouds);
+    this->PointClouds.emplace_back(octree);
+    return octree;
+  }
+
+  /**
+   * Create a streamed source for a 3D image file larger than the volume budget, converting it
+   * into a pyramid of bricks on first open.
+   * Returns nullptr if the file is not an image larger than the volume budget.
+   */
+  vtkSmartPointer<vtkF3DBrickedVolume> CreateVolume(
+    const fs::path& filePath, vtkAlgorithm* vtkReader)
+  {
+    const std::string pyramidFile = vtkF3DBrickedVolume::GetCacheFileName(filePath.string());
+    if (pyramidFile.empty())
+    {
+      log::debug("Volume streaming requires a cache path");
+      return nullptr;
+    }
+
+    if (!vtksys::SystemTools::FileExists(pyramidFile, true))
+    {
+      // The size of the image is known from its information, without reading it
+      vtkReader->UpdateInformation();
+      vtkInformation* outInfo = vtkReader->GetOutputInformation(0);
+      int extent[6];
+      if (!vtkImageData::SafeDownCast(vtkReader->GetOutputDataObject(0)) ||
+        !outInfo->Has(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT()))
+      {
+        return nullptr;
+      }
+      outInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), extent);
+      std::uintmax_t voxelSize = 1;
+      vtkInformation* scalarInfo = vtkDataObject::GetActiveFieldInformation(
+        outInfo, vtkDataObject::FIELD_ASSOCIATION_POINTS, vtkDataSetAttributes::SCALARS);
+      if (scalarInfo && scalarInfo->Has(vtkDataObject::FIELD_ARRAY_TYPE()))
+      {
+        voxelSize =
+          vtkDataArray::GetDataTypeSize(scalarInfo->Get(vtkDataObject::FIELD_ARRAY_TYPE())) *
+          std::max(1, scalarInfo->Get(vtkDataObject::FIELD_NUMBER_OF_COMPONENTS()));
+      }
+      std::uintmax_t size = voxelSize;
+      for (int c = 0; c < 3; c++)
+      {
+        size *= static_cast<std::uintmax_t>(std::max(0, extent[2 * c + 1] - extent[2 * c] + 1));
+      }
+      if (size <= static_cast<std::uintmax_t>(this->Options.scene.volume.budget) * 1024 * 1024)
+      {
+        return nullptr;
+      }
+
+      log::debug("Converting the volume into the bricks of ", pyramidFile);
+      if (!vtkF3DBrickedVolume::BuildPyramid(vtkReader, pyramidFile, 32))
+      {
+        log::warn("Cannot write the volume pyramid ", pyramidFile);
+        return nullptr;
+      }
+    }
+
+    vtkNew<vtkF3DBrickedVolume> volume;
+    volume->SetFileName(pyramidFile);
+    volume->SetMemoryBudget(this->Options.scene.volume.budget);
+    volume->SetCacheBudget(this->Options.scene.volume.memory);
+    return volume;
+  }
+
+  std::vector<vtkSmartPointer<vtkImporter>> CreateImporters(const std::vector<fs::path>& filePaths)
+  {
+    const options& options = this->Options;
+    std::vector<vtkSmartPointer<vtkImporter>> importers;
+    std::uintmax_t filesSize = 0;
+    this->ProbedBounds.Reset();
+    for (const fs::path& filePath : filePaths)
+    {
+      if (filePath.empty())
+      {
+        log::debug("An empty file to load was provided\n");
+        continue;
+      }
+      if (!vtksys::SystemTools::FileExists(filePath.string(), true))
+      {
+        throw scene::load_failure_exception(filePath.string() + " does not exists");
+      }
+
+      // Decoded data is rarely smaller than the file, reject it before reading it
+      std::error_code ec;
+      filesSize += fs::file_size(filePath, ec);
+      if (!ec && this->IsOverMemoryBudget(filesSize))
+      {
+        throw scene::load_failure_exception(filePath.string() +
+          " is larger than the memory budget of " + std::to_string(options.scene.memory_budget) +
+          " MiB");
+      }
+
+      // Recover the importer for the provided file path
+      f3d::reader* reader = f3d::factory::instance()->getReader(filePath.string());
+      if (reader)
+      {
+        log::debug(
+          "Found a reader for \"" + filePath.string() + "\" : \"" + reader->getName() + "\"");
+      }
+      else
+      {
+        throw scene::load_failure_exception(
+          filePath.string() + " is not a file of a supported 3D scene file format");
+      }
+
+      // The bounds are only used to frame the files while they are read progressively
+      double probedBounds[6];
+      if (this->Interactor && reader->probeBounds(filePath.string(), probedBounds))
+      {
+        log::debug("Probed bounds of ", filePath.string(), ": [", probedBounds[0], ", ",
+          probedBounds[1], "] [", probedBounds[2], ", ", probedBounds[3], "] [", probedBounds[4],
+          ", ", probedBounds[5], "]");
+        this->ProbedBounds.AddBounds(probedBounds);
+      }
+
+      // Import the snapshot of a previous import of the file if any, see scene.snapshot
+      std::string snapshotFileName;
+      if (options.scene.snapshot)
+      {
+        snapshotFileName =
+          vtkF3DSnapshotImporter::GetCacheFileName(filePath.string(), this->GetSnapshotKey(reader));
+        if (!snapshotFileName.empty() && vtkF3DSnapshotImporter::CanReadFile(snapshotFileName))
+        {
+          log::debug("Importing the snapshot ", snapshotFileName);
+          vtkF3DMetrics::Increment("f3d_cache_hits_total", { "cache", "snapshot" });
+          vtkSmartPointer<vtkF3DSnapshotImporter> snapshotImporter =
+            vtkSmartPointer<vtkF3DSnapshotImporter>::New();
+          snapshotImporter->SetFileName(snapshotFileName);
+          this->ImporterReaders.emplace_back(snapshotImporter.Get(), reader->getName());
+          importers.emplace_back(snapshotImporter);
+          continue;
+        }
+        vtkF3DMetrics::Increment("f3d_cache_misses_total", { "cache", "snapshot" });
+      }
+
+      // Files on network filesystems are read from a local copy, see scene.remote_cache
+      const std::string readPath = options.scene.remote_cache
+        ? vtkF3DReadAhead::GetLocalCopy(filePath.string())
+        : filePath.string();
+      if (readPath != filePath.string())
+      {
+        log::debug("Reading the local copy ", readPath);
+      }
+
+      vtkSmartPointer<vtkImporter> importer = reader->createSceneReader(readPath);
+      if (!importer)
+      {
+        // XXX: F3D Plugin CMake logic ensure there is either a scene reader or a geometry reader
+        auto vtkReader = reader->createGeometryReader(readPath);
+        assert(vtkReader);
+        this->SelectBlocks(reader, vtkReader);
+        if (options.scene.thumbnail_profile && !reader->applyThumbnailReader(vtkReader))
+        {
+          log::debug(reader->getName(), " has no thumbnail profile, the file is read as usual");
+        }
+        vtkSmartPointer<vtkF3DGenericImporter> genericImporter =
+          vtkSmartPointer<vtkF3DGenericImporter>::New();
+        genericImporter->SetNormalsGeneration(
+          options.scene.normals.generate, options.scene.normals.feature_angle);
+        vtkSmartPointer<vtkF3DOctreePointCloud> pointCloud;
+        if (options.scene.point_cloud.budget > 0)
+        {
+          pointCloud = this->CreatePointCloud(filePath, vtkReader);
+        }
+        vtkSmartPointer<vtkF3DBrickedVolume> volume;
+        if (!pointCloud && options.scene.volume.budget > 0)
+        {
+          volume = this->CreateVolume(filePath, vtkReader);
+        }
+        const bool streamed = pointCloud || volume;
+        if (pointCloud)
+        {
+          genericImporter->SetInternalReader(pointCloud);
+        }
+        else if (volume)
+        {
+          genericImporter->SetInternalReader(volume);
+        }
+        else
+        {
+          genericImporter->SetInternalReader(vtkReader);
+        }
+        if (!streamed)
+        {
+          genericImporter->SetArraySelector(
+            [reader](vtkAlgorithm* algo, const std::vector<std::string>& arrayNames)
+            { return reader->selectArrays(algo, arrayNames); });
+        }
+        if (!streamed && options.scene.tessellation_error > 0 &&
+          !options.scene.thumbnail_profile && reader->enableRefinement(vtkReader))
+        {
+          genericImporter->SetTessellator(
+            [reader](vtkAlgorithm* algo, vtkPolyData* surface, double deflection)
+            { return reader->refineSurface(algo, surface, deflection); },
+            options.scene.tessellation_error);
+        }
+        if (streamed)
+        {
+          // Streamed point clouds and volumes are not imported at once
+          snapshotFileName.clear();
+        }
+        if (!streamed && options.scene.animation.prefetch > 0 && !options.scene.thumbnail_profile)
+        {
+          // VTK pipelines cannot be updated concurrently, a dedicated reader is needed
+          vtkSmartPointer<vtkAlgorithm> prefetchReader = reader->createGeometryReader(readPath);
+          this->SelectBlocks(reader, prefetchReader);
+          genericImporter->SetPrefetchReader(prefetchReader);
+          genericImporter->SetPrefetchCount(options.scene.animation.prefetch);
+          genericImporter->SetPrefetchMemoryBudget(options.scene.animation.prefetch_memory);
+        }
+        // The thumbnail profile cannot know the first array to color with before reading them
+        const bool lazyArrays = options.scene.lazy_arrays ||
+          (options.scene.thumbnail_profile && !options.model.scivis.array_name.empty());
+        if (!streamed && lazyArrays)
+        {
+          // Only the colored array is read, if any
+          std::vector<std::string> arrayNames;
+          if (!options.model.scivis.array_name.empty())
+          {
+            arrayNames.emplace_back(options.model.scivis.array_name);
+          }
+          if (!genericImporter->SelectArraysForImport(arrayNames))
+          {
+            log::debug(reader->getName(), " cannot select the arrays to read, all are read");
+          }
+        }
+        importer = genericImporter;
+      }
+      else
+      {
+        if (vtkF3DImporter* f3dImporter = vtkF3DImporter::SafeDownCast(importer))
+        {
+          f3dImporter->SetOptimizeGeometry(options.scene.optimize_geometry);
+          f3dImporter->SetPayloadsPattern(options.scene.payloads);
+          f3dImporter->SetPopulationMask(options.scene.population_mask);
+          f3dImporter->SetImportAnimations(!options.scene.thumbnail_profile);
+          f3dImporter->SetTextureMaximumSize(
+            options.scene.thumbnail_profile ? THUMBNAIL_TEXTURE_MAXIMUM_SIZE : 0);
+        }
+        if (options.scene.thumbnail_profile)
+        {
+          reader->applyThumbnailImporter(importer);
+        }
+      }
+      if (!snapshotFileName.empty())
+      {
+        this->Snapshots.emplace_back(importer.Get(), snapshotFileName);
+      }
+      this->ImporterReaders.emplace_back(importer.Get(), reader->getName());
+      importers.emplace_back(importer);
+    }
+
+    log::debug("\nLoading files: ");
+    if (filePaths.size() == 1)
+    {
+      log::debug(filePaths[0].string());
+    }
+    else
+    {
+      for (const fs::path& filePathStr : filePaths)
+      {
+        log::debug("- ", filePathStr.string());
+      }
+    }
+    log::debug("");
+
+    return importers;
+  }
+
+  /**
+   * Add importers to the meta importer and load them.
+   * When updated is true, importers are expected to have already been updated
+   * in their own render window and their props are moved into the scene.
+   */
+  void Load(const std::vector<vtkSmartPointer<vtkImporter>>& importers, bool updated = false)
+  {
+    this->RecordLoad(importers,
+      [&]()
+      {
+        for (const vtkSmartPointer<vtkImporter>& importer : importers)
+        {
+          if (updated)
+          {
+            this->MetaImporter->AddUpdatedImporter(importer);
+          }
+          else
+          {
+            this->MetaImporter->AddImporter(importer);
+          }
+          this->AttachSnapshot(importer);
+        }
+
+        // Initialize the UpVector on load
+        this->Window.InitializeUpVector();
+
+        this->Import(!updated, true);
+        this->EnforceMemoryBudget(importers);
+      });
+  }
+
+  /**
+   * Call load, recording the load of the importers and its duration in the metrics of their
+   * reader, and its failure if it throws.
+   * The importers already updated in the background are only recorded once added in the scene.
+   */
+  template<typename F>
+  void RecordLoad(const std::vector<vtkSmartPointer<vtkImporter>>& importers, F&& load)
+  {
+    const vtkF3DMetrics::Label label = { "reader", this->TakeReaderLabel(importers) };
+    vtkF3DMetrics::Increment("f3d_scene_loads_total", label);
+    const vtkF3DMetrics::Timer timer("f3d_scene_load_seconds", label);
+    try
+    {
+      load();
+    }
+    catch (const scene::load_failure_exception&)
+    {
+      vtkF3DMetrics::Increment("f3d_scene_load_failures_total", label);
+      throw;
+    }
+  }
+
+  /**
+   * Return the name of the reader of importers created by CreateImporters, "mixed" if they were
+   * created by several readers or "memory" if none was, and forget them
+   */
+  std::string TakeReaderLabel(const std::vector<vtkSmartPointer<vtkImporter>>& importers)
   {
+    std::string label;
     for (const vtkSmartPointer<vtkImporter>& importer : importers)
     {
-      this->MetaImporter->AddImporter(importer);
+      auto it = std::find_if(this->ImporterReaders.begin(), this->ImporterReaders.end(),
+        [&](const auto& importerReader) { return importerReader.first == importer; });
+      if (it != this->ImporterReaders.end())
+      {
+        label = label.empty() || label == it->second ? it->second : "mixed";
+        this->ImporterReaders.erase(it);
+      }
+    }
+
+    // Forget the importers that were never added, eg. discarded preloads
+    this->ImporterReaders.erase(
+      std::remove_if(this->ImporterReaders.begin(), this->ImporterReaders.end(),
+        [](const auto& importerReader) { return !importerReader.first; }),
+      this->ImporterReaders.end());
+    return label.empty() ? "memory" : label;
+  }
+
+  /**
+   * Return true if the provided memory size, in bytes, is larger than the memory budget
+   */
+  bool IsOverMemoryBudget(std::uintmax_t size) const
+  {
+    const int budget = this->Options.scene.memory_budget;
+    return budget > 0 && size > static_cast<std::uintmax_t>(budget) * 1024 * 1024;
+  }
+
+  /**
+   * Downscale the textures while the memory used by the scene exceeds the memory budget,
+   * then remove the provided importers from the scene and throw if it is still exceeded.
+   */
+  void EnforceMemoryBudget(const std::vector<vtkSmartPointer<vtkImporter>>& importers)
+  {
+    vtkTypeInt64 cpu;
+    vtkTypeInt64 gpu;
+    this->MetaImporter->GetMemoryUsage(cpu, gpu);
+    vtkF3DTrace::AddCounter("Scene CPU memory", cpu);
+    vtkF3DTrace::AddCounter("Scene GPU memory", gpu);
+    vtkF3DMetrics::SetGauge(
+      "f3d_scene_memory_bytes", static_cast<double>(cpu), { "memory", "cpu" });
+    vtkF3DMetrics::SetGauge(
+      "f3d_scene_memory_bytes", static_cast<double>(gpu), { "memory", "gpu" });
+
+    constexpr int minimumTextureSize = 256;
+    while (
+      this->IsOverMemoryBudget(cpu) && this->MetaImporter->DownscaleTextures(minimumTextureSize))
+    {
+      log::debug("Downscaling the textures to meet the memory budget");
+      this->MetaImporter->GetMemoryUsage(cpu, gpu);
+    }
+    if (!this->IsOverMemoryBudget(cpu))
+    {
+      return;
     }
 
-    // Initialize the UpVector on load
-    this->Window.InitializeUpVector();
+    for (const vtkSmartPointer<vtkImporter>& importer : importers)
+    {
+      this->MetaImporter->RemoveImporter(importer);
+    }
+    this->AnimationManager.Finalize();
+    this->Import(false, false);
+    throw scene::load_failure_exception("the scene uses " + std::to_string(cpu / (1024 * 1024)) +
+      " MiB of memory, more than the memory budget of " +
+      std::to_string(this->Options.scene.memory_budget) + " MiB");
+  }
 
+  /**
+   * Update the meta importer, which only imports the importers that have not been imported yet,
+   * then update the animation and the window.
+   */
+  void Import(bool showProgress, bool resetCamera)
+  {
     if (this->Options.scene.camera.index.has_value())
     {
       this->MetaImporter->SetCameraIndex(this->Options.scene.camera.index.value());
     }
+    this->MetaImporter->SetTriangleBudget(this->Options.scene.triangle_budget);
+    vtkF3DTextureCache::SetBudget(this->Options.scene.texture_cache);
 
     // Manage progress bar
     vtkNew<vtkProgressBarWidget> progressWidget;
@@ -108,26 +637,66 @@ public:
     scene_impl::internals::ProgressDataStruct callbackData;
     callbackData.timer = timer;
     callbackData.widget = progressWidget;
-    if (this->Options.ui.loader_progress && this->Interactor)
+    if (this->Options.ui.loader_progress && this->Interactor && showProgress)
     {
       scene_impl::internals::CreateProgressRepresentationAndCallback(
         &callbackData, this->MetaImporter, this->Interactor);
     }
 
-    // Update the meta importer, the will only update importers that have not been update before
-#if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240707)
-    if (!this->MetaImporter->Update())
+    // Show the first files while the next ones are being read
+    vtkNew<vtkTimerLog> progressiveTimer;
+    scene_impl::internals::ProgressiveDataStruct progressiveData{ this, progressiveTimer,
+      resetCamera && !this->Options.scene.camera.index.has_value(), false };
+    if (this->Interactor && showProgress)
     {
-      throw scene::load_failure_exception("failed to load scene");
+      scene_impl::internals::CreateProgressiveRenderingCallback(
+        &progressiveData, this->MetaImporter);
     }
+
+    // Frame the probed bounds with the grid before the files are read
+    const bool placeholder = this->Interactor && showProgress && progressiveData.resetCamera &&
+      this->ProbedBounds.IsValid();
+    if (placeholder)
+    {
+      double bounds[6];
+      this->ProbedBounds.GetBounds(bounds);
+      this->Window.ShowPlaceholderBounds(bounds);
+    }
+
+    // Update the meta importer, the will only update importers that have not been update before
+#if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240707)
+    const bool updated = this->MetaImporter->Update();
 #else
     this->MetaImporter->Update();
+    const bool updated = true;
 #endif
+    if (placeholder)
+    {
+      this->Window.ShowPlaceholderBounds(nullptr);
+    }
+    if (!updated)
+    {
+      throw scene::load_failure_exception("failed to load scene");
+    }
 
     // Remove anything progress related if any
     this->MetaImporter->RemoveObservers(vtkCommand::ProgressEvent);
+    this->MetaImporter->RemoveObservers(vtkF3DMetaImporter::ImporterAddedEvent);
     progressWidget->Off();
 
+    // Show the allocations of the conversion passes that did not use the system allocator
+    const vtkF3DScratchArena::Counters scratch = vtkF3DScratchArena::GetCounters();
+    vtkF3DScratchArena::ResetCounters();
+    if (scratch.Allocations > 0)
+    {
+      log::debug("Scratch arenas served ", scratch.Allocations, " allocations (",
+        scratch.AllocatedBytes / 1024, " KiB) with ", scratch.Blocks, " blocks (",
+        scratch.BlockBytes / 1024, " KiB)");
+      vtkF3DTrace::AddCounter(
+        "Scratch allocations", static_cast<std::int64_t>(scratch.Allocations));
+      vtkF3DTrace::AddCounter("Scratch blocks", static_cast<std::int64_t>(scratch.Blocks));
+    }
+
     // Initialize the animation using temporal information from the importer
     if (this->AnimationManager.Initialize())
     {
@@ -153,7 +722,7 @@ public:
 
     // Update all window options and reset camera to bounds if needed
     this->Window.UpdateDynamicOptions();
-    if (!this->Options.scene.camera.index.has_value())
+    if (resetCamera && !this->Options.scene.camera.index.has_value())
     {
       this->Window.getCamera().resetToBounds();
     }
@@ -191,135 +760,1072 @@ public:
   animationManager AnimationManager;
 
   vtkNew<vtkF3DMetaImporter> MetaImporter;
-};
-
-//----------------------------------------------------------------------------
-scene_impl::scene_impl(const options& options, window_impl& window)
-  : Internals(std::make_unique<scene_impl::internals>(options, window))
-{
-}
-
-//----------------------------------------------------------------------------
-scene_impl::~scene_impl() = default;
 
-//----------------------------------------------------------------------------
-scene& scene_impl::add(const fs::path& filePath)
-{
-  std::vector<fs::path> paths = { filePath };
-  return this->add(paths);
-}
+  // Snapshots to write for the importers created by CreateImporters, until they are added
+  std::vector<std::pair<vtkWeakPointer<vtkImporter>, std::string>> Snapshots;
 
-//----------------------------------------------------------------------------
-scene& scene_impl::add(const std::vector<std::string>& filePathStrings)
-{
-  std::vector<fs::path> paths;
-  paths.reserve(filePathStrings.size());
-  for (const std::string& str : filePathStrings)
-  {
-    paths.emplace_back(str);
-  }
-  return this->add(paths);
-}
+  // Names of the readers of the importers created by CreateImporters, until they are added
+  std::vector<std::pair<vtkWeakPointer<vtkImporter>, std::string>> ImporterReaders;
 
-//----------------------------------------------------------------------------
-scene& scene_impl::add(const std::vector<fs::path>& filePaths)
-{
-  if (filePaths.empty())
+  /**
+   * Return the key of the snapshots of the files read by the reader, identifying the reader
+   * and the options the imported actors depend on
+   */
+  std::string GetSnapshotKey(const f3d::reader* reader)
   {
-    log::debug("No file to load a full scene provided\n");
-    return *this;
+    const options& options = this->Options;
+    return detail::LibVersionFull + ";" + reader->getName() + ";" +
+      std::to_string(options.scene.optimize_geometry) + ";" + options.scene.payloads + ";" +
+      options.scene.population_mask + ";" + std::to_string(options.scene.lazy_arrays) + ";" +
+      std::to_string(options.scene.thumbnail_profile) + ";" +
+      std::to_string(options.scene.triangle_budget) + ";" +
+      std::to_string(options.scene.normals.generate) + ";" +
+      std::to_string(options.scene.normals.feature_angle) + ";" + options.model.scivis.array_name;
   }
 
-  std::vector<vtkSmartPointer<vtkImporter>> importers;
-  for (const fs::path& filePath : filePaths)
+  /**
+   * Restrict the blocks read by a geometry reader to the comma separated paths of the
+   * population mask, if any, for the readers of composite datasets supporting it
+   */
+  void SelectBlocks(const f3d::reader* reader, vtkAlgorithm* vtkReader)
   {
-    if (filePath.empty())
+    if (this->Options.scene.population_mask.empty())
     {
-      log::debug("An empty file to load was provided\n");
-      continue;
-    }
-    if (!vtksys::SystemTools::FileExists(filePath.string(), true))
-    {
-      throw scene::load_failure_exception(filePath.string() + " does not exists");
+      return;
     }
 
-    // Recover the importer for the provided file path
-    f3d::reader* reader = f3d::factory::instance()->getReader(filePath.string());
-    if (reader)
+    std::vector<std::string> paths;
+    for (const std::string& path :
+      vtksys::SystemTools::SplitString(this->Options.scene.population_mask, ','))
     {
-      log::debug(
-        "Found a reader for \"" + filePath.string() + "\" : \"" + reader->getName() + "\"");
+      std::string trimmed = vtksys::SystemTools::TrimWhitespace(path);
+      if (!trimmed.empty())
+      {
+        paths.emplace_back(trimmed);
+      }
     }
-    else
+    if (!reader->selectBlocks(vtkReader, paths))
     {
-      throw scene::load_failure_exception(
-        filePath.string() + " is not a file of a supported 3D scene file format");
+      log::debug(reader->getName(), " cannot select the blocks to read, all are read");
     }
-    vtkSmartPointer<vtkImporter> importer = reader->createSceneReader(filePath.string());
-    if (!importer)
+  }
+
+  /**
+   * Let the meta importer write the snapshot of an added importer, if any, see scene.snapshot
+   */
+  void AttachSnapshot(vtkImporter* importer)
+  {
+    auto it = std::find_if(this->Snapshots.begin(), this->Snapshots.end(),
+      [&](const auto& snapshot) { return snapshot.first == importer; });
+    if (it != this->Snapshots.end())
     {
-      // XXX: F3D Plugin CMake logic ensure there is either a scene reader or a geometry reader
-      auto vtkReader = reader->createGeometryReader(filePath.string());
-      assert(vtkReader);
-      vtkSmartPointer<vtkF3DGenericImporter> genericImporter =
-        vtkSmartPointer<vtkF3DGenericImporter>::New();
-      genericImporter->SetInternalReader(vtkReader);
-      importer = genericImporter;
+      this->MetaImporter->SetImporterSnapshot(importer, it->second);
+      this->Snapshots.erase(it);
     }
-    importers.emplace_back(importer);
+
+    // Forget the snapshots of the importers that were never added, eg. discarded preloads
+    this->Snapshots.erase(std::remove_if(this->Snapshots.begin(), this->Snapshots.end(),
+                            [](const auto& snapshot) { return !snapshot.first; }),
+      this->Snapshots.end());
   }
 
-  log::debug("\nLoading files: ");
-  if (filePaths.size() == 1)
+  // Importers of the files added with add, used to reload them
+  std::map<fs::path, vtkSmartPointer<vtkImporter>> FileImporters;
+
+  // Bounds probed from the metadata of the files of the last CreateImporters, framed by Import
+  vtkBoundingBox ProbedBounds;
+
+  // Streamed point clouds, whose nodes are read asynchronously while interacting
+  std::vector<vtkSmartPointer<vtkF3DOctreePointCloud>> PointClouds;
+  bool AsyncPointClouds = false;
+
+  // Meshes added from memory, in order, used to update them
+  struct MemoryMesh
   {
-    log::debug(filePaths[0].string());
-  }
-  else
+    vtkSmartPointer<vtkF3DMemoryMesh> Source;
+    vtkSmartPointer<vtkImporter> Importer;
+    bool Dynamic = false;
+  };
+  std::vector<MemoryMesh> MemoryMeshes;
+
+  // Copies of the files added from memory, read by their readers until cleared
+  std::vector<std::vector<std::byte>> MemoryBuffers;
+
+  // Files added from memory whose reader cannot read from memory, removed when cleared
+  std::vector<fs::path> TemporaryFiles;
+
+  /**
+   * Remove the temporary files of the files added from memory
+   */
+  void RemoveTemporaryFiles()
   {
-    for (const fs::path& filePathStr : filePaths)
+    for (const fs::path& filePath : this->TemporaryFiles)
     {
-      log::debug("- ", filePathStr.string());
+      std::error_code ec;
+      fs::remove(filePath, ec);
     }
+    this->TemporaryFiles.clear();
   }
-  log::debug("");
 
-  this->Internals->Load(importers);
-  return *this;
-}
+  /**
+   * Cancel and wait for all asynchronous loads that have not been finalized yet
+   */
+  void CancelAsyncLoads();
 
-//----------------------------------------------------------------------------
-scene& scene_impl::add(const mesh_t& mesh)
-{
-  // sanity checks
-  auto [valid, err] = mesh.isValid();
-  if (!valid)
+  /**
+   * Remove all the files from the scene, cancelling the asynchronous loads
+   */
+  void Clear();
+
+  /**
+   * Keep track of an asynchronous load and finalize it from the event loop if there is one
+   */
+  void PollAsyncLoad(const std::shared_ptr<scene_impl::async_load>& load);
+
+  /**
+   * Keep track of the importers of the provided files, empty paths do not have an importer
+   */
+  void SetFileImporters(const std::vector<fs::path>& filePaths,
+    const std::vector<vtkSmartPointer<vtkImporter>>& importers)
   {
-    throw scene::load_failure_exception(err);
+    auto importerIt = importers.begin();
+    for (const fs::path& filePath : filePaths)
+    {
+      if (!filePath.empty() && importerIt != importers.end())
+      {
+        this->FileImporters[filePath] = *importerIt++;
+      }
+    }
   }
 
-  vtkNew<vtkF3DMemoryMesh> vtkSource;
-  vtkSource->SetPoints(mesh.points);
-  vtkSource->SetNormals(mesh.normals);
-  vtkSource->SetTCoords(mesh.texture_coordinates);
-  vtkSource->SetFaces(mesh.face_sides, mesh.face_indices);
+  // Asynchronous loads that have not been finalized yet
+  std::vector<std::shared_ptr<scene_impl::async_load>> AsyncLoads;
 
-  vtkSmartPointer<vtkF3DGenericImporter> importer = vtkSmartPointer<vtkF3DGenericImporter>::New();
-  importer->SetInternalReader(vtkSource);
+  /**
+   * Return and forget the preload of the provided files, if any and if it can be used
+   */
+  std::shared_ptr<scene_impl::async_load> TakePreload(const std::vector<fs::path>& filePaths);
 
-  log::debug("Loading 3D scene from memory");
-  this->Internals->Load({ importer });
-  return *this;
-}
+  // Files read by preload and not added yet, most recent last
+  struct Preload
+  {
+    std::vector<fs::path> FilePaths;
+    std::shared_ptr<scene_impl::async_load> Load;
+  };
+  std::vector<Preload> Preloads;
+};
+
+//----------------------------------------------------------------------------
+class scene_impl::async_load
+  : public scene::load_handle
+  , public std::enable_shared_from_this<scene_impl::async_load>
+{
+public:
+  async_load(scene_impl::internals* internals,
+    const std::vector<vtkSmartPointer<vtkImporter>>& importers, vtkIdType localCameraIndex)
+    : Internals(internals)
+    , Importers(importers)
+    , LocalCameraIndex(localCameraIndex)
+    , ImporterProgress(new std::atomic<double>[importers.size()])
+  {
+    for (size_t i = 0; i < this->Importers.size(); i++)
+    {
+      const vtkSmartPointer<vtkImporter>& importer = this->Importers[i];
+      this->ImporterProgress[i] = 0.0;
+
+      // Each importer is updated in its own render window so that the scene
+      // is not modified by the worker thread
+      vtkNew<vtkF3DNoRenderWindow> renWin;
+      vtkNew<vtkRenderer> renderer;
+      renWin->AddRenderer(renderer);
+      importer->SetRenderWindow(renWin);
+
+      vtkNew<vtkCallbackCommand> progressCallback;
+      progressCallback->SetClientData(this);
+      progressCallback->SetCallback(
+        [](vtkObject* caller, unsigned long, void* clientData, void* callData)
+        {
+          auto self = static_cast<scene_impl::async_load*>(clientData);
+          for (size_t j = 0; j < self->Importers.size(); j++)
+          {
+            if (self->Importers[j] == caller)
+            {
+              self->SetImporterProgress(j, *static_cast<double*>(callData));
+            }
+          }
+        });
+
+      // The importers outlive the load in the scene, so the observers are removed once finalized
+      this->ObserverTags.emplace_back(
+        importer->AddObserver(vtkCommand::ProgressEvent, progressCallback));
+    }
+
+    this->Worker = std::thread(&scene_impl::async_load::Read, this);
+  }
+
+  ~async_load() override
+  {
+    this->Detach();
+  }
+
+  Status getStatus() override
+  {
+    if (this->CurrentStatus == Status::LOADING && this->ReadDone)
+    {
+      this->Finalize();
+    }
+    return this->CurrentStatus;
+  }
+
+  double getProgress() const override
+  {
+    return this->Progress;
+  }
+
+  void wait() override
+  {
+    if (this->CurrentStatus == Status::LOADING)
+    {
+      this->Finalize();
+    }
+    if (this->CurrentStatus == Status::FAILED)
+    {
+      throw scene::load_failure_exception(this->FailureMessage);
+    }
+  }
+
+  void cancel() override
+  {
+    this->Cancel();
+  }
+
+  /**
+   * Return true if the files have been read and the load can be finalized without waiting
+   */
+  bool IsRead() const
+  {
+    return this->ReadDone;
+  }
+
+  /**
+   * Get the memory used by the read data in bytes, only valid once read
+   */
+  size_t GetMemorySize()
+  {
+    if (!this->MemorySize.has_value())
+    {
+      size_t size = 0;
+      for (const vtkSmartPointer<vtkImporter>& importer : this->Importers)
+      {
+        vtkActorCollection* actors = importer->GetRenderer()->GetActors();
+        vtkCollectionSimpleIterator ait;
+        actors->InitTraversal(ait);
+        while (vtkActor* actor = actors->GetNextActor(ait))
+        {
+          vtkMapper* mapper = actor->GetMapper();
+          vtkDataObject* input = mapper ? mapper->GetInputDataObject(0, 0) : nullptr;
+          size += input ? input->GetActualMemorySize() : 0;
+        }
+
+        vtkF3DGenericImporter* genericImporter = vtkF3DGenericImporter::SafeDownCast(importer);
+        if (genericImporter && genericImporter->GetImportedImage())
+        {
+          size += genericImporter->GetImportedImage()->GetActualMemorySize();
+        }
+      }
+
+      // GetActualMemorySize is in KiB
+      this->MemorySize = size * 1024;
+    }
+    return this->MemorySize.value();
+  }
+
+  const std::vector<vtkSmartPointer<vtkImporter>>& GetImporters() const
+  {
+    return this->Importers;
+  }
+
+  /**
+   * Clear the scene when finalizing the load, before adding the imported props,
+   * and keep track of the importers of the provided files
+   */
+  void SetReplace(const std::vector<fs::path>& filePaths)
+  {
+    this->Replace = true;
+    this->FilePaths = filePaths;
+  }
+
+  /**
+   * Poll the load from the interactor event loop, finalize it and render if reading is done
+   */
+  void PollFromEventLoop()
+  {
+    if (this->CurrentStatus == Status::LOADING && this->ReadDone)
+    {
+      scene_impl::internals* internals = this->Internals;
+      this->Finalize();
+      if (internals && this->CurrentStatus == Status::FAILED)
+      {
+        log::error(this->FailureMessage);
+      }
+      if (internals)
+      {
+        internals->Window.render();
+      }
+    }
+  }
+
+  /**
+   * Cancel the load, wait for the worker thread and forget about the scene
+   */
+  void Detach()
+  {
+    this->Cancel();
+    this->Finalize();
+  }
+
+  unsigned long TimerId = 0;
+  bool HasTimer = false;
+
+private:
+  /**
+   * Cancel the load and the importers being updated by the worker threads,
+   * which stop at their next cancellation check instead of reading the whole files
+   */
+  void Cancel()
+  {
+    this->Cancelled = true;
+    for (const vtkSmartPointer<vtkImporter>& importer : this->Importers)
+    {
+      if (vtkF3DImporter* f3dImporter = vtkF3DImporter::SafeDownCast(importer))
+      {
+        f3dImporter->Cancel();
+      }
+    }
+  }
+
+  /**
+   * Set the progress of an importer, the importers read in parallel report it concurrently
+   */
+  void SetImporterProgress(size_t index, double progress)
+  {
+    this->ImporterProgress[index] = progress;
+    double total = 0.0;
+    for (size_t i = 0; i < this->Importers.size(); i++)
+    {
+      total += this->ImporterProgress[i];
+    }
+    this->Progress = total / this->Importers.size();
+  }
+
+  static bool Update(vtkImporter* importer)
+  {
+#if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240707)
+    return importer->Update();
+#else
+    importer->Update();
+    return true;
+#endif
+  }
+
+  void Read()
+  {
+    // Without camera index, the importers do not depend on each other and are read in parallel,
+    // as when they are added synchronously, so that replacing files is not slower than adding them
+    if (this->LocalCameraIndex < 0 && this->Importers.size() > 1)
+    {
+      std::atomic<size_t> next = 0;
+      auto worker = [&]()
+      {
+        for (size_t i = next++; i < this->Importers.size() && !this->Cancelled && !this->ReadFailed;
+             i = next++)
+        {
+          if (!async_load::Update(this->Importers[i]))
+          {
+            this->ReadFailed = true;
+          }
+          this->SetImporterProgress(i, 1.0);
+        }
+      };
+      const size_t nbThreads = std::min<size_t>(
+        std::max(std::thread::hardware_concurrency(), 1u), this->Importers.size());
+      std::vector<std::thread> workers;
+      for (size_t t = 0; t < nbThreads; t++)
+      {
+        workers.emplace_back(worker);
+      }
+      for (std::thread& thread : workers)
+      {
+        thread.join();
+      }
+      this->ReadDone = true;
+      return;
+    }
+
+    vtkIdType localCameraIndex = this->LocalCameraIndex;
+    for (size_t i = 0; i < this->Importers.size() && !this->Cancelled; i++)
+    {
+      vtkImporter* importer = this->Importers[i];
+
+      // This is required to avoid updating two times
+      // but may cause a warning in VTK
+      if (localCameraIndex >= 0)
+      {
+        importer->SetCamera(localCameraIndex);
+      }
+
+      if (!async_load::Update(importer))
+      {
+        this->ReadFailed = true;
+        break;
+      }
+      this->SetImporterProgress(i, 1.0);
+      localCameraIndex -= importer->GetNumberOfCameras();
+    }
+    this->ReadDone = true;
+  }
+
+  /**
+   * Join the worker thread and add the imported props into the scene, on the calling thread
+   */
+  void Finalize()
+  {
+    if (this->Worker.joinable())
+    {
+      this->Worker.join();
+    }
+    for (size_t i = 0; i < this->ObserverTags.size(); i++)
+    {
+      this->Importers[i]->RemoveObserver(this->ObserverTags[i]);
+    }
+    this->ObserverTags.clear();
+    if (this->CurrentStatus != Status::LOADING)
+    {
+      return;
+    }
+
+    scene_impl::internals* internals = this->Internals;
+    this->Internals = nullptr;
+    if (internals)
+    {
+      if (this->HasTimer && internals->Interactor)
+      {
+        internals->Interactor->removeTimerCallBack(this->TimerId);
+      }
+
+      // Keep this alive while removing it from the scene
+      auto self = this->shared_from_this();
+      internals->AsyncLoads.erase(
+        std::remove(internals->AsyncLoads.begin(), internals->AsyncLoads.end(), self),
+        internals->AsyncLoads.end());
+    }
+
+    if (this->Cancelled || !internals)
+    {
+      this->CurrentStatus = Status::CANCELLED;
+      return;
+    }
+    if (this->ReadFailed)
+    {
+      const vtkF3DMetrics::Label label = { "reader", internals->TakeReaderLabel(this->Importers) };
+      vtkF3DMetrics::Increment("f3d_scene_loads_total", label);
+      vtkF3DMetrics::Increment("f3d_scene_load_failures_total", label);
+      this->CurrentStatus = Status::FAILED;
+      this->FailureMessage = "failed to load scene";
+      return;
+    }
+
+    try
+    {
+      // The current props are only removed once the new ones are ready to be added
+      if (this->Replace)
+      {
+        internals->Clear();
+      }
+      internals->Load(this->Importers, true);
+      internals->SetFileImporters(this->FilePaths, this->Importers);
+      this->CurrentStatus = Status::LOADED;
+    }
+    catch (const scene::load_failure_exception& ex)
+    {
+      this->CurrentStatus = Status::FAILED;
+      this->FailureMessage = ex.what();
+    }
+  }
+
+  scene_impl::internals* Internals;
+  std::vector<vtkSmartPointer<vtkImporter>> Importers;
+  vtkIdType LocalCameraIndex;
+  bool Replace = false;
+  std::vector<fs::path> FilePaths;
+
+  std::thread Worker;
+  std::atomic<bool> Cancelled = false;
+  std::atomic<bool> ReadDone = false;
+  std::atomic<bool> ReadFailed = false;
+  std::vector<unsigned long> ObserverTags;
+  std::unique_ptr<std::atomic<double>[]> ImporterProgress;
+  std::atomic<double> Progress = 0.0;
+
+  Status CurrentStatus = Status::LOADING;
+  std::string FailureMessage;
+  std::optional<size_t> MemorySize;
+};
+
+//----------------------------------------------------------------------------
+void scene_impl::internals::CancelAsyncLoads()
+{
+  // Copy as loads remove themselves from the list
+  std::vector<std::shared_ptr<scene_impl::async_load>> loads = this->AsyncLoads;
+  for (const auto& load : loads)
+  {
+    load->Detach();
+  }
+}
+
+//----------------------------------------------------------------------------
+void scene_impl::internals::Clear()
+{
+  // Cancel any pending asynchronous load
+  this->CancelAsyncLoads();
+
+  // Animations of cleared importers are not available anymore
+  this->AnimationManager.Finalize();
+
+  // Clear the meta importer from all importers
+  this->MetaImporter->Clear();
+  this->FileImporters.clear();
+  this->MemoryMeshes.clear();
+  this->PointClouds.clear();
+  this->MemoryBuffers.clear();
+  this->RemoveTemporaryFiles();
+
+  // Clear the window of all actors
+  this->Window.Initialize();
+}
+
+//----------------------------------------------------------------------------
+void scene_impl::internals::PollAsyncLoad(const std::shared_ptr<scene_impl::async_load>& load)
+{
+  if (std::find(this->AsyncLoads.begin(), this->AsyncLoads.end(), load) == this->AsyncLoads.end())
+  {
+    this->AsyncLoads.emplace_back(load);
+  }
+
+  // Finalize the load from the event loop if there is one
+  if (this->Interactor && !load->HasTimer)
+  {
+    std::weak_ptr<scene_impl::async_load> weakLoad = load;
+    load->TimerId = this->Interactor->createTimerCallBack(50,
+      [weakLoad]()
+      {
+        if (auto pollLoad = weakLoad.lock())
+        {
+          pollLoad->PollFromEventLoop();
+        }
+      });
+    load->HasTimer = true;
+  }
+}
+
+//----------------------------------------------------------------------------
+std::shared_ptr<scene_impl::async_load> scene_impl::internals::TakePreload(
+  const std::vector<fs::path>& filePaths)
+{
+  auto it = std::find_if(this->Preloads.begin(), this->Preloads.end(),
+    [&](const Preload& preload) { return preload.FilePaths == filePaths; });
+  if (it == this->Preloads.end())
+  {
+    return nullptr;
+  }
+
+  // The camera index is applied when reading, which is done before knowing the scene
+  std::shared_ptr<scene_impl::async_load> load = it->Load;
+  this->Preloads.erase(it);
+  if (this->Options.scene.camera.index.has_value())
+  {
+    load->Detach();
+    return nullptr;
+  }
+
+  // Finalized by the caller, like any asynchronous load
+  this->AsyncLoads.emplace_back(load);
+  return load;
+}
+
+//----------------------------------------------------------------------------
+scene_impl::scene_impl(const options& options, window_impl& window)
+  : Internals(std::make_unique<scene_impl::internals>(options, window))
+{
+}
+
+//----------------------------------------------------------------------------
+scene_impl::~scene_impl()
+{
+  // The interactor may already have been destroyed at this point
+  this->Internals->Interactor = nullptr;
+  this->Internals->CancelAsyncLoads();
+  for (const scene_impl::internals::Preload& preload : this->Internals->Preloads)
+  {
+    preload.Load->Detach();
+  }
+  this->Internals->Preloads.clear();
+  this->Internals->RemoveTemporaryFiles();
+}
+
+//----------------------------------------------------------------------------
+scene& scene_impl::add(const fs::path& filePath)
+{
+  std::vector<fs::path> paths = { filePath };
+  return this->add(paths);
+}
+
+//----------------------------------------------------------------------------
+scene& scene_impl::add(const std::vector<std::string>& filePathStrings)
+{
+  std::vector<fs::path> paths;
+  paths.reserve(filePathStrings.size());
+  for (const std::string& str : filePathStrings)
+  {
+    paths.emplace_back(str);
+  }
+  return this->add(paths);
+}
+
+//----------------------------------------------------------------------------
+scene& scene_impl::add(const std::vector<fs::path>& filePaths)
+{
+  F3D_TRACE_SCOPE("scene::add");
+  if (filePaths.empty())
+  {
+    log::debug("No file to load a full scene provided\n");
+    return *this;
+  }
+
+  std::vector<vtkSmartPointer<vtkImporter>> importers;
+  std::shared_ptr<scene_impl::async_load> preload = this->Internals->TakePreload(filePaths);
+  if (preload)
+  {
+    log::debug("Using preloaded files");
+    importers = preload->GetImporters();
+    preload->wait();
+  }
+  else
+  {
+    importers = this->Internals->CreateImporters(filePaths);
+    this->Internals->Load(importers);
+  }
+
+  this->Internals->SetFileImporters(filePaths, importers);
+  return *this;
+}
+
+//----------------------------------------------------------------------------
+scene& scene_impl::reload(const std::vector<fs::path>& filePaths)
+{
+  F3D_TRACE_SCOPE("scene::reload");
+  if (filePaths.empty())
+  {
+    return *this;
+  }
+
+  for (const fs::path& filePath : filePaths)
+  {
+    if (this->Internals->FileImporters.count(filePath) == 0)
+    {
+      throw scene::load_failure_exception(filePath.string() + " has not been added");
+    }
+  }
+
+  std::vector<vtkSmartPointer<vtkImporter>> importers = this->Internals->CreateImporters(filePaths);
+  this->Internals->RecordLoad(importers,
+    [&]()
+    {
+      for (size_t i = 0; i < filePaths.size(); i++)
+      {
+        vtkSmartPointer<vtkImporter>& previous = this->Internals->FileImporters[filePaths[i]];
+        this->Internals->MetaImporter->ReplaceImporter(previous, importers[i]);
+        this->Internals->AttachSnapshot(importers[i]);
+        previous = importers[i];
+      }
+
+      // Animations of replaced importers are not valid anymore
+      this->Internals->AnimationManager.Finalize();
+      this->Internals->Import(true, false);
+    });
+  return *this;
+}
+
+//----------------------------------------------------------------------------
+std::shared_ptr<scene::load_handle> scene_impl::addAsync(const std::vector<fs::path>& filePaths)
+{
+  std::vector<vtkSmartPointer<vtkImporter>> importers = this->Internals->CreateImporters(filePaths);
+
+  // Camera index is local to the importers being added
+  vtkIdType localCameraIndex = -1;
+  if (this->Internals->Options.scene.camera.index.has_value())
+  {
+    localCameraIndex = this->Internals->Options.scene.camera.index.value() -
+      this->Internals->MetaImporter->GetNumberOfCameras();
+  }
+
+  auto load = std::make_shared<scene_impl::async_load>(
+    this->Internals.get(), importers, localCameraIndex);
+  this->Internals->PollAsyncLoad(load);
+  return load;
+}
+
+//----------------------------------------------------------------------------
+std::shared_ptr<scene::load_handle> scene_impl::replaceAsync(
+  const std::vector<fs::path>& filePaths)
+{
+  std::shared_ptr<scene_impl::async_load> load = this->Internals->TakePreload(filePaths);
+  if (load)
+  {
+    log::debug("Using preloaded files");
+  }
+  else
+  {
+    // The camera index is local to the new files as the scene is cleared
+    std::vector<vtkSmartPointer<vtkImporter>> importers =
+      this->Internals->CreateImporters(filePaths);
+    load = std::make_shared<scene_impl::async_load>(this->Internals.get(), importers,
+      this->Internals->Options.scene.camera.index.value_or(-1));
+  }
+  load->SetReplace(filePaths);
+  this->Internals->PollAsyncLoad(load);
+  return load;
+}
+
+//----------------------------------------------------------------------------
+scene& scene_impl::replace(const std::vector<fs::path>& filePaths)
+{
+  F3D_TRACE_SCOPE("scene::replace");
+  if (filePaths.empty())
+  {
+    return this->clear();
+  }
+  this->replaceAsync(filePaths)->wait();
+  return *this;
+}
+
+//----------------------------------------------------------------------------
+scene& scene_impl::preload(const std::vector<fs::path>& filePaths, int memoryBudget)
+{
+  std::vector<scene_impl::internals::Preload>& preloads = this->Internals->Preloads;
+  auto it = std::find_if(preloads.begin(), preloads.end(),
+    [&](const scene_impl::internals::Preload& preload) { return preload.FilePaths == filePaths; });
+  if (it != preloads.end())
+  {
+    // Mark as the most recent
+    std::rotate(it, std::next(it), preloads.end());
+  }
+  else
+  {
+    std::vector<vtkSmartPointer<vtkImporter>> importers =
+      this->Internals->CreateImporters(filePaths);
+    if (importers.empty())
+    {
+      return *this;
+    }
+
+    // Not kept in AsyncLoads so that clear does not cancel it, it is not finalized until added
+    preloads.push_back({ filePaths,
+      std::make_shared<scene_impl::async_load>(this->Internals.get(), importers, -1) });
+  }
+
+  // Discard the oldest read preloads until the budget is met, but not the provided files
+  const size_t budget = static_cast<size_t>(std::max(memoryBudget, 0)) * 1024 * 1024;
+  size_t memory = std::accumulate(preloads.begin(), preloads.end(), size_t(0),
+    [](size_t sum, const scene_impl::internals::Preload& preload)
+    { return sum + (preload.Load->IsRead() ? preload.Load->GetMemorySize() : 0); });
+  for (auto pit = preloads.begin(); memory > budget && std::next(pit) != preloads.end();)
+  {
+    if (pit->Load->IsRead())
+    {
+      memory -= pit->Load->GetMemorySize();
+      log::debug("Discarding preloaded files to meet the memory budget");
+      pit->Load->Detach();
+      pit = preloads.erase(pit);
+    }
+    else
+    {
+      ++pit;
+    }
+  }
+  return *this;
+}
+
+//----------------------------------------------------------------------------
+scene& scene_impl::add(const mesh_t& mesh)
+{
+  // sanity checks
+  auto [valid, err] = mesh.isValid();
+  if (!valid)
+  {
+    throw scene::load_failure_exception(err);
+  }
+
+  vtkNew<vtkF3DMemoryMesh> vtkSource;
+  vtkSource->SetPoints(mesh.points);
+  vtkSource->SetNormals(mesh.normals);
+  vtkSource->SetTCoords(mesh.texture_coordinates);
+  if (!mesh.triangle_indices.empty())
+  {
+    vtkSource->SetTriangles(mesh.triangle_indices);
+  }
+  else if (!mesh.triangle_indices_16.empty())
+  {
+    vtkSource->SetTriangles(mesh.triangle_indices_16);
+  }
+  else
+  {
+    vtkSource->SetFaces(mesh.face_sides, mesh.face_indices);
+  }
+  if (!mesh.colors.empty())
+  {
+    vtkSource->SetColors(mesh.colors);
+  }
+  for (const mesh_t::array_t& array : mesh.point_data)
+  {
+    vtkSource->SetPointArray(array.name, array.components, array.values);
+  }
+  for (const mesh_t::array_t& array : mesh.cell_data)
+  {
+    vtkSource->SetCellArray(array.name, array.components, array.values);
+  }
+
+  vtkSmartPointer<vtkF3DGenericImporter> importer = vtkSmartPointer<vtkF3DGenericImporter>::New();
+  importer->SetInternalReader(vtkSource);
+
+  log::debug("Loading 3D scene from memory");
+  this->Internals->Load({ importer });
+  this->Internals->MemoryMeshes.push_back({ vtkSource, importer });
+  return *this;
+}
 
 //----------------------------------------------------------------------------
-scene& scene_impl::clear()
+scene& scene_impl::add(const mesh_view_t& mesh)
 {
-  // Clear the meta importer from all importers
-  this->Internals->MetaImporter->Clear();
+  // sanity checks
+  auto [valid, err] = mesh.isValid();
+  if (!valid)
+  {
+    if (mesh.deleter)
+    {
+      mesh.deleter();
+    }
+    throw scene::load_failure_exception(err);
+  }
 
-  // Clear the window of all actors
-  this->Internals->Window.Initialize();
+  vtkNew<vtkF3DMemoryMesh> vtkSource;
+  vtkSource->SetExternalBuffersDeleter(mesh.deleter);
+  vtkSource->SetExternalPoints(mesh.points.data, mesh.points.size);
+  vtkSource->SetExternalNormals(mesh.normals.data, mesh.normals.size);
+  vtkSource->SetExternalTCoords(mesh.texture_coordinates.data, mesh.texture_coordinates.size);
+  if (mesh.triangle_indices.size > 0)
+  {
+    vtkSource->SetExternalTriangles(mesh.triangle_indices.data, mesh.triangle_indices.size);
+  }
+  else if (mesh.triangle_indices_16.size > 0)
+  {
+    vtkSource->SetExternalTriangles(mesh.triangle_indices_16.data, mesh.triangle_indices_16.size);
+  }
+  else
+  {
+    vtkSource->SetExternalFaces(mesh.face_sides.data, mesh.face_sides.size,
+      mesh.face_indices.data, mesh.face_indices.size);
+  }
+  if (mesh.colors.size > 0)
+  {
+    vtkSource->SetExternalColors(mesh.colors.data, mesh.colors.size);
+  }
+  for (const mesh_view_t::array_t& array : mesh.point_data)
+  {
+    vtkSource->SetExternalPointArray(
+      array.name, array.components, array.values.data, array.values.size);
+  }
+  for (const mesh_view_t::array_t& array : mesh.cell_data)
+  {
+    vtkSource->SetExternalCellArray(
+      array.name, array.components, array.values.data, array.values.size);
+  }
+
+  vtkSmartPointer<vtkF3DGenericImporter> importer = vtkSmartPointer<vtkF3DGenericImporter>::New();
+  importer->SetInternalReader(vtkSource);
+
+  log::debug("Loading 3D scene from memory without copy");
+  this->Internals->Load({ importer });
+  this->Internals->MemoryMeshes.push_back({ vtkSource, importer });
+  return *this;
+}
+
+//----------------------------------------------------------------------------
+scene& scene_impl::add(const std::byte* buffer, std::size_t size, const std::string& format)
+{
+  F3D_TRACE_SCOPE("scene::add");
+
+  if (!buffer || size == 0)
+  {
+    throw scene::load_failure_exception("An empty buffer to load was provided");
+  }
+
+  // The reader is picked using the extension only
+  const std::string extension = format.substr(format.find_last_of('.') + 1);
+  f3d::reader* reader = f3d::factory::instance()->getReader("memory." + extension);
+  if (!reader)
+  {
+    throw scene::load_failure_exception(
+      format + " is not a supported 3D scene file format to read from memory");
+  }
+  log::debug("Found a reader for a buffer of format \"" + extension + "\" : \"" +
+    reader->getName() + "\"");
+
+  vtkSmartPointer<vtkImporter> importer;
+  if (reader->canReadFromMemory())
+  {
+    // Readers read the copy as long as it is in the scene, some of them do not copy it
+    std::vector<std::byte>& data =
+      this->Internals->MemoryBuffers.emplace_back(buffer, buffer + size);
+
+    importer = reader->createSceneReaderFromMemory(data.data(), data.size());
+    vtkSmartPointer<vtkAlgorithm> vtkReader =
+      importer ? nullptr : reader->createGeometryReaderFromMemory(data.data(), data.size());
+    if (vtkReader)
+    {
+      vtkSmartPointer<vtkF3DGenericImporter> genericImporter =
+        vtkSmartPointer<vtkF3DGenericImporter>::New();
+      genericImporter->SetInternalReader(vtkReader);
+      genericImporter->SetArraySelector(
+        [reader](vtkAlgorithm* algo, const std::vector<std::string>& arrayNames)
+        { return reader->selectArrays(algo, arrayNames); });
+      importer = genericImporter;
+    }
+  }
+
+  if (!importer)
+  {
+    // The reader can only read files, write the buffer to a temporary file
+    fs::path filePath = fs::temp_directory_path() /
+      ("f3d-memory-" +
+        std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) + "." +
+        extension);
+    std::ofstream file(filePath, std::ios::binary);
+    if (!file.write(reinterpret_cast<const char*>(buffer), static_cast<std::streamsize>(size)))
+    {
+      throw scene::load_failure_exception(
+        "Cannot write the buffer to the temporary file " + filePath.string());
+    }
+    file.close();
+    log::debug("Reading the buffer from the temporary file ", filePath.string());
+    this->Internals->TemporaryFiles.emplace_back(filePath);
+    importer = this->Internals->CreateImporters({ filePath }).front();
+  }
+  else
+  {
+    log::debug("Loading 3D scene from memory");
+  }
+
+  this->Internals->Load({ importer });
+  return *this;
+}
+
+//----------------------------------------------------------------------------
+scene& scene_impl::updateMesh(size_t meshIndex, const mesh_view_t& mesh)
+{
+  // sanity checks
+  std::string err;
+  if (meshIndex >= this->Internals->MemoryMeshes.size())
+  {
+    err = "There is no mesh added from memory at index " + std::to_string(meshIndex);
+  }
+  else
+  {
+    vtkF3DMemoryMesh* vtkSource = this->Internals->MemoryMeshes[meshIndex].Source;
+    size_t nbPoints = static_cast<size_t>(vtkSource->GetNumberOfPoints());
+    size_t nbCells = static_cast<size_t>(vtkSource->GetNumberOfCells());
+    auto isInvalid = [](const auto& buffer, size_t expectedSize)
+    { return buffer.size > 0 && (buffer.size != expectedSize || !buffer.data); };
+    auto isInvalidArray = [&](const mesh_view_t::array_t& array, size_t nbTuples)
+    {
+      return array.name.empty() || array.components < 1 ||
+        array.values.size != nbTuples * array.components ||
+        (!array.values.data && array.values.size > 0);
+    };
+    if (isInvalid(mesh.points, nbPoints * 3) || isInvalid(mesh.normals, nbPoints * 3) ||
+      isInvalid(mesh.texture_coordinates, nbPoints * 2) || isInvalid(mesh.colors, nbPoints * 4) ||
+      std::any_of(mesh.point_data.begin(), mesh.point_data.end(),
+        [&](const mesh_view_t::array_t& array) { return isInvalidArray(array, nbPoints); }) ||
+      std::any_of(mesh.cell_data.begin(), mesh.cell_data.end(),
+        [&](const mesh_view_t::array_t& array) { return isInvalidArray(array, nbCells); }))
+    {
+      err = "The buffers must be empty or match the " + std::to_string(nbPoints) +
+        " points and the " + std::to_string(nbCells) + " faces of the mesh";
+    }
+    else if (mesh.face_sides.size > 0 || mesh.face_indices.size > 0 ||
+      mesh.triangle_indices.size > 0 || mesh.triangle_indices_16.size > 0)
+    {
+      err = "The faces of a mesh cannot be updated";
+    }
+  }
+
+  if (!err.empty())
+  {
+    if (mesh.deleter)
+    {
+      mesh.deleter();
+    }
+    throw scene::load_failure_exception(err);
+  }
+
+  scene_impl::internals::MemoryMesh& memoryMesh = this->Internals->MemoryMeshes[meshIndex];
+  vtkF3DMemoryMesh* vtkSource = memoryMesh.Source;
+  vtkSource->SetExternalBuffersDeleter(mesh.deleter);
+  if (mesh.points.size > 0)
+  {
+    vtkSource->SetExternalPoints(mesh.points.data, mesh.points.size);
+  }
+  if (mesh.normals.size > 0)
+  {
+    vtkSource->SetExternalNormals(mesh.normals.data, mesh.normals.size);
+  }
+  if (mesh.texture_coordinates.size > 0)
+  {
+    vtkSource->SetExternalTCoords(mesh.texture_coordinates.data, mesh.texture_coordinates.size);
+  }
+  if (mesh.colors.size > 0)
+  {
+    vtkSource->SetExternalColors(mesh.colors.data, mesh.colors.size);
+  }
+  for (const mesh_view_t::array_t& array : mesh.point_data)
+  {
+    vtkSource->SetExternalPointArray(
+      array.name, array.components, array.values.data, array.values.size);
+  }
+  for (const mesh_view_t::array_t& array : mesh.cell_data)
+  {
+    vtkSource->SetExternalCellArray(
+      array.name, array.components, array.values.data, array.values.size);
+  }
+
+  // Batches and level of detail proxies would show the previous geometry
+  if (!memoryMesh.Dynamic)
+  {
+    memoryMesh.Dynamic = this->Internals->MetaImporter->SetImporterDynamic(memoryMesh.Importer);
+  }
+
+  // The cached counts, memory usage and bounds are outdated by each update
+  this->Internals->MetaImporter->DataModified();
+
+  // Only the updated arrays keep the deleter, it is called once they are all released
+  vtkSource->SetExternalBuffersDeleter(nullptr);
+  return *this;
+}
 
+//----------------------------------------------------------------------------
+scene& scene_impl::clear()
+{
+  this->Internals->Clear();
   return *this;
 }
 
@@ -329,6 +1835,59 @@ bool scene_impl::supports(const fs::path& filePath)
   return f3d::factory::instance()->getReader(filePath.string()) != nullptr;
 }
 
+//----------------------------------------------------------------------------
+scene& scene_impl::loadAnimationTime(double timeValue)
+{
+  this->Internals->AnimationManager.LoadAtTime(timeValue);
+  return *this;
+}
+
+//----------------------------------------------------------------------------
+std::pair<double, double> scene_impl::animationTimeRange()
+{
+  double timeRange[2];
+  this->Internals->AnimationManager.GetTimeRange(timeRange);
+
+  // Time range is invalid when there is no animation
+  if (!(timeRange[0] < timeRange[1]))
+  {
+    return std::make_pair(0.0, 0.0);
+  }
+  return std::make_pair(timeRange[0], timeRange[1]);
+}
+
+//----------------------------------------------------------------------------
+scene::memory_usage_t scene_impl::getMemoryUsage()
+{
+  vtkTypeInt64 cpu;
+  vtkTypeInt64 gpu;
+  this->Internals->MetaImporter->GetMemoryUsage(cpu, gpu);
+  return { static_cast<std::size_t>(cpu), static_cast<std::size_t>(gpu) };
+}
+
+//----------------------------------------------------------------------------
+scene& scene_impl::save(const std::filesystem::path& filePath)
+{
+  std::string ext = filePath.extension().string();
+  for (char& c : ext)
+  {
+    // casting is required on Windows
+    c = static_cast<char>(tolower(c));
+  }
+  if (ext != ".glb")
+  {
+    throw scene::save_failure_exception(
+      filePath.string() + " cannot be saved, only the .glb extension is supported");
+  }
+
+  if (!this->Internals->MetaImporter->WriteGLB(filePath.string()))
+  {
+    throw scene::save_failure_exception(filePath.string() + " could not be written");
+  }
+  log::debug("Scene saved to ", filePath.string());
+  return *this;
+}
+
 //----------------------------------------------------------------------------
 void scene_impl::SetInteractor(interactor_impl* interactor)
 {
@@ -336,4 +1895,224 @@ void scene_impl::SetInteractor(interactor_impl* interactor)
   this->Internals->AnimationManager.SetInteractor(interactor);
   this->Internals->Interactor->SetAnimationManager(&this->Internals->AnimationManager);
 }
+
+//----------------------------------------------------------------------------
+void scene_impl::SetUseAsyncPointClouds(bool use)
+{
+  this->Internals->AsyncPointClouds = use;
+  for (vtkF3DOctreePointCloud* pointCloud : this->Internals->PointClouds)
+  {
+    pointCloud->SetAsyncLoading(use);
+  }
+}
+
+//----------------------------------------------------------------------------
+bool scene_impl::HasNewPointCloudNodes()
+{
+  bool hasNewNodes = false;
+  for (vtkF3DOctreePointCloud* pointCloud : this->Internals->PointClouds)
+  {
+    hasNewNodes = pointCloud->ConsumeNewNodes() || hasNewNodes;
+  }
+  return hasNewNodes;
+}
+}
+
+namespace
+{
+/**
+ * Accumulate the information about the datasets of a file, see scene::query
+ */
+struct InfoAccumulator
+{
+  f3d::scene::info_t Info;
+  vtkBoundingBox Bounds;
+  std::vector<bool> HasRange;
+
+  void AddArrays(vtkFieldData* fields, const std::string& location)
+  {
+    if (!fields)
+    {
+      return;
+    }
+    for (int i = 0; i < fields->GetNumberOfArrays(); i++)
+    {
+      vtkAbstractArray* array = fields->GetAbstractArray(i);
+      if (!array || !array->GetName())
+      {
+        continue;
+      }
+
+      auto it = std::find_if(this->Info.arrays.begin(), this->Info.arrays.end(),
+        [&](const f3d::scene::info_t::array_t& info)
+        { return info.name == array->GetName() && info.location == location; });
+      if (it == this->Info.arrays.end())
+      {
+        this->Info.arrays.push_back({ array->GetName(), location, 0, { 0.0, 0.0 } });
+        this->HasRange.push_back(false);
+        it = std::prev(this->Info.arrays.end());
+      }
+      const size_t index = std::distance(this->Info.arrays.begin(), it);
+      it->components = std::max(it->components, array->GetNumberOfComponents());
+
+      vtkDataArray* dataArray = vtkDataArray::SafeDownCast(array);
+      if (dataArray && dataArray->GetNumberOfTuples() > 0)
+      {
+        double range[2];
+        dataArray->GetRange(range, dataArray->GetNumberOfComponents() > 1 ? -1 : 0);
+        it->range.first = this->HasRange[index] ? std::min(it->range.first, range[0]) : range[0];
+        it->range.second = this->HasRange[index] ? std::max(it->range.second, range[1]) : range[1];
+        this->HasRange[index] = true;
+      }
+    }
+  }
+
+  void AddDataObject(vtkDataObject* object, bool addBounds)
+  {
+    std::vector<vtkDataSet*> datasets;
+    if (vtkCompositeDataSet* composite = vtkCompositeDataSet::SafeDownCast(object))
+    {
+      datasets = vtkCompositeDataSet::GetDataSets(composite);
+      this->AddArrays(composite->GetFieldData(), "field");
+    }
+    else if (vtkDataSet* dataset = vtkDataSet::SafeDownCast(object))
+    {
+      datasets.emplace_back(dataset);
+    }
+
+    for (vtkDataSet* dataset : datasets)
+    {
+      this->Info.points += static_cast<std::size_t>(dataset->GetNumberOfPoints());
+      this->Info.cells += static_cast<std::size_t>(dataset->GetNumberOfCells());
+      if (addBounds && dataset->GetNumberOfPoints() > 0)
+      {
+        this->Bounds.AddBounds(dataset->GetBounds());
+      }
+      this->AddArrays(dataset->GetPointData(), "point");
+      this->AddArrays(dataset->GetCellData(), "cell");
+      this->AddArrays(dataset->GetFieldData(), "field");
+    }
+  }
+};
+}
+
+namespace f3d
+{
+//----------------------------------------------------------------------------
+scene::info_t scene::query(const fs::path& filePath)
+{
+  F3D_TRACE_SCOPE("scene::query");
+  detail::init::initialize();
+  if (!vtksys::SystemTools::FileExists(filePath.string(), true))
+  {
+    throw scene::load_failure_exception(filePath.string() + " does not exists");
+  }
+
+  f3d::reader* reader = f3d::factory::instance()->getReader(filePath.string());
+  if (!reader)
+  {
+    throw scene::load_failure_exception(
+      filePath.string() + " is not a file of a supported 3D scene file format");
+  }
+
+  // Only the reader is used, none of the actors, mappers and coloring of a scene are created
+  InfoAccumulator accumulator;
+  scene::info_t& info = accumulator.Info;
+  vtkSmartPointer<vtkImporter> importer = reader->createSceneReader(filePath.string());
+  if (importer)
+  {
+    // Importers create their own actors, in a render window that cannot render
+    vtkNew<vtkF3DNoRenderWindow> renWin;
+    vtkNew<vtkRenderer> renderer;
+    renWin->AddRenderer(renderer);
+    importer->SetRenderWindow(renWin);
+#if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240707)
+    if (!importer->Update())
+    {
+      throw scene::load_failure_exception(filePath.string() + " could not be read");
+    }
+#else
+    importer->Update();
+#endif
+
+    vtkActorCollection* actors = renderer->GetActors();
+    vtkCollectionSimpleIterator it;
+    actors->InitTraversal(it);
+    while (vtkActor* actor = actors->GetNextActor(it))
+    {
+      vtkMapper* mapper = actor->GetMapper();
+      if (mapper && mapper->GetNumberOfInputPorts() > 0 && mapper->GetNumberOfInputConnections(0))
+      {
+        // The bounds of the actors account for their transform
+        accumulator.AddDataObject(mapper->GetInputDataObject(0, 0), false);
+        const double* bounds = actor->GetBounds();
+        if (bounds && vtkMath::AreBoundsInitialized(bounds))
+        {
+          accumulator.Bounds.AddBounds(bounds);
+        }
+      }
+    }
+
+    for (vtkIdType i = 0; i < importer->GetNumberOfCameras(); i++)
+    {
+      info.cameras.emplace_back(importer->GetCameraName(i));
+    }
+
+    const vtkIdType nbAnimations = importer->GetNumberOfAnimations();
+    info.animations = static_cast<std::size_t>(std::max<vtkIdType>(0, nbAnimations));
+    double timeRange[2] = { std::numeric_limits<double>::infinity(),
+      -std::numeric_limits<double>::infinity() };
+    for (vtkIdType i = 0; i < nbAnimations; i++)
+    {
+      // The frame rate does not change the time range
+      int nbTimeSteps;
+      double animationRange[2];
+      vtkNew<vtkDoubleArray> timeSteps;
+      if (importer->GetTemporalInformation(i, 30.0, nbTimeSteps, animationRange, timeSteps))
+      {
+        timeRange[0] = std::min(timeRange[0], animationRange[0]);
+        timeRange[1] = std::max(timeRange[1], animationRange[1]);
+      }
+    }
+    if (timeRange[0] < timeRange[1])
+    {
+      info.animationTimeRange = std::make_pair(timeRange[0], timeRange[1]);
+    }
+  }
+  else
+  {
+    vtkSmartPointer<vtkAlgorithm> vtkReader = reader->createGeometryReader(filePath.string());
+    if (!vtkReader)
+    {
+      throw scene::load_failure_exception(filePath.string() + " could not be read");
+    }
+
+    // The time steps of a geometry reader are a single animation
+    vtkReader->UpdateInformation();
+    vtkInformation* outInfo = vtkReader->GetOutputInformation(0);
+    if (outInfo && outInfo->Has(vtkStreamingDemandDrivenPipeline::TIME_RANGE()))
+    {
+      const double* timeRange = outInfo->Get(vtkStreamingDemandDrivenPipeline::TIME_RANGE());
+      if (timeRange[0] < timeRange[1])
+      {
+        info.animations = 1;
+        info.animationTimeRange = std::make_pair(timeRange[0], timeRange[1]);
+      }
+    }
+
+    vtkReader->Update();
+    vtkDataObject* output = vtkReader->GetOutputDataObject(0);
+    if (!output)
+    {
+      throw scene::load_failure_exception(filePath.string() + " could not be read");
+    }
+    accumulator.AddDataObject(output, true);
+  }
+
+  if (accumulator.Bounds.IsValid())
+  {
+    accumulator.Bounds.GetBounds(info.bounds.data());
+  }
+  return info;
+}
 }
@@ -2,59 +2,196 @@
 
 #include <algorithm>
 #include <numeric>
+#include <tuple>
 
-namespace f3d
+namespace
 {
 //----------------------------------------------------------------------------
-std::pair<bool, std::string> mesh_t::isValid() const
+template<typename T>
+size_t Size(const std::vector<T>& buffer)
+{
+  return buffer.size();
+}
+
+//----------------------------------------------------------------------------
+template<typename T>
+size_t Size(const f3d::mesh_view_t::buffer_t<T>& buffer)
+{
+  return buffer.size;
+}
+
+//----------------------------------------------------------------------------
+template<typename T>
+const T* Data(const std::vector<T>& buffer)
+{
+  return buffer.data();
+}
+
+//----------------------------------------------------------------------------
+template<typename T>
+const T* Data(const f3d::mesh_view_t::buffer_t<T>& buffer)
+{
+  return buffer.data;
+}
+
+//----------------------------------------------------------------------------
+template<typename T>
+std::pair<bool, std::string> CheckIndices(
+  const std::string& vertexName, const T* indices, size_t nbIndices, size_t nbPoints)
 {
-  if (this->points.size() == 0)
+  const T* it =
+    std::find_if(indices, indices + nbIndices, [=](T idx) { return idx >= nbPoints; });
+  if (it != indices + nbIndices)
+  {
+    std::string err = vertexName;
+    err += " at index ";
+    err += std::to_string(std::distance(indices, it));
+    err += " is greater than the maximum vertex index (";
+    err += std::to_string(nbPoints);
+    err += ")";
+    return { false, std::move(err) };
+  }
+  return { true, {} };
+}
+
+//----------------------------------------------------------------------------
+template<typename Arrays>
+std::pair<bool, std::string> CheckArrays(
+  const Arrays& arrays, size_t nbTuples, const std::string& location)
+{
+  for (const auto& array : arrays)
+  {
+    if (array.name.empty() || array.components < 1)
+    {
+      return { false, "The " + location + " arrays must have a name and at least one component." };
+    }
+
+    if (::Size(array.values) != nbTuples * array.components ||
+      (!::Data(array.values) && ::Size(array.values) > 0))
+    {
+      return { false,
+        "The " + array.name + " array length must be its number of components times the number " +
+          "of " + (location == "point_data" ? "points." : "faces.") };
+    }
+  }
+  return { true, {} };
+}
+
+//----------------------------------------------------------------------------
+/**
+ * Check a mesh_t or a mesh_view_t, which have the same members
+ */
+template<typename Mesh>
+std::pair<bool, std::string> CheckMesh(const Mesh& mesh)
+{
+  if (::Size(mesh.points) == 0)
   {
     return { false, "The points buffer must not be empty." };
   }
 
-  if (this->points.size() % 3 != 0)
+  if (::Size(mesh.points) % 3 != 0)
   {
     std::string err = "The points buffer is not a multiple of 3. It's length is ";
-    err += std::to_string(this->points.size());
+    err += std::to_string(::Size(mesh.points));
     return { false, std::move(err) };
   }
 
-  size_t nbPoints = this->points.size() / 3;
+  size_t nbPoints = ::Size(mesh.points) / 3;
 
-  if (this->normals.size() > 0 && this->normals.size() != nbPoints * 3)
+  if (::Size(mesh.normals) > 0 && ::Size(mesh.normals) != nbPoints * 3)
   {
     return { false, "The normals buffer must be empty or equal to 3 times the number of points." };
   }
 
-  if (this->texture_coordinates.size() > 0 && this->texture_coordinates.size() != nbPoints * 2)
+  if (::Size(mesh.texture_coordinates) > 0 && ::Size(mesh.texture_coordinates) != nbPoints * 2)
   {
     return { false,
       "The texture_coordinates buffer must be empty or equal to 2 times the number of points." };
   }
 
-  unsigned int expectedSize = std::accumulate(this->face_sides.begin(), this->face_sides.end(), 0);
+  if (::Size(mesh.colors) > 0 && ::Size(mesh.colors) != nbPoints * 4)
+  {
+    return { false, "The colors buffer must be empty or equal to 4 times the number of points." };
+  }
 
-  if (this->face_indices.size() != expectedSize)
+  size_t nbTriangleBuffers = (::Size(mesh.triangle_indices) > 0 ? 1 : 0) +
+    (::Size(mesh.triangle_indices_16) > 0 ? 1 : 0) + (::Size(mesh.face_sides) > 0 ? 1 : 0);
+  if (nbTriangleBuffers > 1)
+  {
+    return { false,
+      "Only one of face_sides, triangle_indices and triangle_indices_16 can be provided." };
+  }
+
+  size_t nbFaces = ::Size(mesh.face_sides);
+  if (::Size(mesh.triangle_indices) > 0 || ::Size(mesh.triangle_indices_16) > 0)
+  {
+    size_t nbTriangleIndices = ::Size(mesh.triangle_indices) + ::Size(mesh.triangle_indices_16);
+    if (nbTriangleIndices % 3 != 0)
+    {
+      return { false, "The triangle indices buffer length must be a multiple of 3." };
+    }
+    nbFaces = nbTriangleIndices / 3;
+
+    auto [valid, err] = ::Size(mesh.triangle_indices) > 0
+      ? ::CheckIndices("Triangle vertex", ::Data(mesh.triangle_indices),
+          ::Size(mesh.triangle_indices), nbPoints)
+      : ::CheckIndices("Triangle vertex", ::Data(mesh.triangle_indices_16),
+          ::Size(mesh.triangle_indices_16), nbPoints);
+    if (!valid)
+    {
+      return { false, std::move(err) };
+    }
+  }
+
+  size_t expectedSize = std::accumulate(
+    ::Data(mesh.face_sides), ::Data(mesh.face_sides) + ::Size(mesh.face_sides), size_t(0));
+
+  if (::Size(mesh.face_indices) != expectedSize)
   {
     std::string err = "The face_indices buffer size is invalid, it should be ";
     err += std::to_string(expectedSize);
     return { false, std::move(err) };
   }
 
-  auto it = std::find_if(this->face_indices.cbegin(), this->face_indices.cend(),
-    [=](unsigned int idx) { return idx >= nbPoints; });
-  if (it != this->face_indices.cend())
+  auto [valid, err] = ::CheckIndices(
+    "Face vertex", ::Data(mesh.face_indices), ::Size(mesh.face_indices), nbPoints);
+  if (!valid)
   {
-    std::string err = "Face vertex at index ";
-    err += std::to_string(std::distance(this->face_indices.cbegin(), it));
-    err += " is greater than the maximum vertex index (";
-    err += std::to_string(nbPoints);
-    err += ")";
     return { false, std::move(err) };
   }
 
-  return { true, {} };
+  std::tie(valid, err) = ::CheckArrays(mesh.point_data, nbPoints, "point_data");
+  if (!valid)
+  {
+    return { false, std::move(err) };
+  }
+  return ::CheckArrays(mesh.cell_data, nbFaces, "cell_data");
+}
 }
 
+namespace f3d
+{
+//----------------------------------------------------------------------------
+std::pair<bool, std::string> mesh_t::isValid() const
+{
+  return ::CheckMesh(*this);
+}
+
+//----------------------------------------------------------------------------
+std::pair<bool, std::string> mesh_view_t::isValid() const
+{
+  if ((!this->points.data && this->points.size > 0) ||
+    (!this->normals.data && this->normals.size > 0) ||
+    (!this->texture_coordinates.data && this->texture_coordinates.size > 0) ||
+    (!this->face_sides.data && this->face_sides.size > 0) ||
+    (!this->face_indices.data && this->face_indices.size > 0) ||
+    (!this->triangle_indices.data && this->triangle_indices.size > 0) ||
+    (!this->triangle_indices_16.data && this->triangle_indices_16.size > 0) ||
+    (!this->colors.data && this->colors.size > 0))
+  {
+    return { false, "A buffer has a size but no data." };
+  }
+
+  return ::CheckMesh(*this);
+}
 }
@@ -5,17 +5,28 @@
 #include "log.h"
 #include "options.h"
 
+#include "vtkF3DCache.h"
 #include "vtkF3DConfigure.h"
+#include "vtkF3DFrameStatistics.h"
 
 #include "vtkF3DGenericImporter.h"
+#include "vtkF3DMetrics.h"
 #include "vtkF3DNoRenderWindow.h"
 #include "vtkF3DRenderer.h"
+#include "vtkF3DTrace.h"
 
+#include <vtkActor2D.h>
+#include <vtkBoundingBox.h>
 #include <vtkCamera.h>
 #include <vtkImageData.h>
 #include <vtkImageExport.h>
+#include <vtkMath.h>
+#include <vtkOpenGLRenderWindow.h>
 #include <vtkPNGReader.h>
+#include <vtkPixelBufferObject.h>
 #include <vtkPointGaussianMapper.h>
+#include <vtkPropCollection.h>
+#include <vtkRect.h>
 #include <vtkRenderWindow.h>
 #include <vtkRendererCollection.h>
 #include <vtkRenderingOpenGLConfigure.h>
@@ -43,6 +54,18 @@
 #include <vtkExternalOpenGLRenderWindow.h>
 #endif
 
+#if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240914)
+#include <vtk_glad.h>
+#else
+#include <vtk_glew.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <string_view>
+#include <vector>
+
 #ifdef _WIN32
 #include <Windows.h>
 #include <dwmapi.h>
@@ -54,6 +77,12 @@
 constexpr auto IMMERSIVE_DARK_MODE_SUPPORTED_SINCE = 19041;
 #endif
 
+namespace
+{
+// number of views rendered while the transfer of a previous one is in flight
+constexpr size_t MAX_PENDING_VIEWS = 3;
+}
+
 namespace f3d::detail
 {
 class window_impl::internals
@@ -164,10 +193,68 @@ public:
     return (*fn)(name);
   }
 
+  /**
+   * A pixel buffer object receiving a frame asynchronously, it can be reused
+   * once no future references it anymore
+   */
+  struct readback
+  {
+    vtkNew<vtkPixelBufferObject> PBO;
+  };
+
+  /**
+   * Start transferring the last rendered frame to a readback without waiting for it,
+   * and return a future mapping it in a f3d::image
+   */
+  std::future<image> ReadPixelsAsync(vtkOpenGLRenderWindow* oglRenWin, bool noBackground)
+  {
+    const int* size = this->RenWin->GetSize();
+    const int width = size[0];
+    const int height = size[1];
+    const int cmp = noBackground ? 4 : 3;
+
+    // a readback still referenced by a future is waiting to be read, use another one
+    auto it = std::find_if(this->Readbacks.begin(), this->Readbacks.end(),
+      [](const std::shared_ptr<readback>& rb) { return rb.use_count() == 1; });
+    std::shared_ptr<readback> rb = it != this->Readbacks.end()
+      ? *it
+      : this->Readbacks.emplace_back(std::make_shared<readback>());
+
+    // the pixels are copied into the PBO by the GPU, glReadPixels returns immediately
+    rb->PBO->SetContext(oglRenWin);
+    rb->PBO->Allocate(VTK_UNSIGNED_CHAR, width * height, cmp, vtkPixelBufferObject::PACKED_BUFFER);
+    rb->PBO->Bind(vtkPixelBufferObject::PACKED_BUFFER);
+    oglRenWin->ReadPixels(
+      vtkRecti(0, 0, width, height), 1, cmp == 4 ? GL_RGBA : GL_RGB, GL_UNSIGNED_BYTE, nullptr);
+    rb->PBO->UnBind();
+
+    // the PBO is mapped only when the image is requested, hopefully once the transfer is done
+    vtkSmartPointer<vtkOpenGLRenderWindow> context = oglRenWin;
+    return std::async(std::launch::deferred,
+      [rb, context, width, height, cmp]()
+      {
+        image output(width, height, cmp);
+        context->MakeCurrent();
+        void* data = rb->PBO->MapPackedBuffer();
+        if (data)
+        {
+          std::copy_n(static_cast<const unsigned char*>(data),
+            static_cast<size_t>(width) * height * cmp,
+            static_cast<unsigned char*>(output.getContent()));
+        }
+        rb->PBO->UnmapPackedBuffer();
+        return output;
+      });
+  }
+
   std::unique_ptr<camera_impl> Camera;
   vtkSmartPointer<vtkRenderWindow> RenWin;
   vtkNew<vtkF3DRenderer> Renderer;
+  vtkNew<vtkWindowToImageFilter> WindowToImageFilter;
+  vtkNew<vtkImageExport> ImageExporter;
+  std::vector<std::shared_ptr<readback>> Readbacks;
   const options& Options;
+  std::optional<options> AppliedOptions;
   std::string CachePath;
   context::function GetProcAddress;
 };
@@ -276,6 +363,7 @@ window_impl::window_impl(const options& options, const std::optional<Type>& type
 void window_impl::Initialize()
 {
   this->Internals->Renderer->Initialize();
+  this->Internals->AppliedOptions.reset();
 }
 
 //----------------------------------------------------------------------------
@@ -449,6 +537,7 @@ window_impl::~window_impl()
 //----------------------------------------------------------------------------
 void window_impl::UpdateDynamicOptions()
 {
+  F3D_TRACE_SCOPE("window_impl::UpdateDynamicOptions");
   vtkF3DRenderer* renderer = this->Internals->Renderer;
 
   if (this->Internals->RenWin->IsA("vtkF3DNoRenderWindow"))
@@ -464,87 +553,165 @@ void window_impl::UpdateDynamicOptions()
   // Make sure lights are created before we take options into account
   renderer->UpdateLights();
 
+  // Only forward the options modified since the last update to the renderer
   const options& opt = this->Internals->Options;
-  renderer->ShowAxis(opt.interactor.axis);
-  renderer->SetUseTrackball(opt.interactor.trackball);
-  renderer->SetInvertZoom(opt.interactor.invert_zoom);
-
-  // XXX: model.point_sprites.type only has an effect on geometry scene
-  // but we set it here for practical reasons
-  const int pointSpritesSize = opt.model.point_sprites.size;
-  const vtkF3DRenderer::SplatType splatType = opt.model.point_sprites.type == "gaussian"
-    ? vtkF3DRenderer::SplatType::GAUSSIAN
-    : vtkF3DRenderer::SplatType::SPHERE;
-  renderer->SetPointSpritesProperties(splatType, pointSpritesSize);
-
-  renderer->SetLineWidth(opt.render.line_width);
-  renderer->SetPointSize(opt.render.point_size);
-  renderer->ShowEdge(opt.render.show_edges);
-  renderer->ShowTimer(opt.ui.fps);
-  renderer->ShowFilename(opt.ui.filename);
-  renderer->SetFilenameInfo(opt.ui.filename_info);
-  renderer->ShowMetaData(opt.ui.metadata);
-  renderer->ShowCheatSheet(opt.ui.cheatsheet);
-  renderer->ShowDropZone(opt.ui.dropzone);
-  renderer->SetDropZoneInfo(opt.ui.dropzone_info);
-
-  renderer->SetUseRaytracing(opt.render.raytracing.enable);
-  renderer->SetRaytracingSamples(opt.render.raytracing.samples);
-  renderer->SetUseRaytracingDenoiser(opt.render.raytracing.denoise);
-
-  renderer->SetUseSSAOPass(opt.render.effect.ambient_occlusion);
-  renderer->SetUseFXAAPass(opt.render.effect.anti_aliasing);
-  renderer->SetUseToneMappingPass(opt.render.effect.tone_mapping);
-  renderer->SetUseDepthPeelingPass(opt.render.effect.translucency_support);
-  renderer->SetBackfaceType(opt.render.backface_type);
-  renderer->SetFinalShader(opt.render.effect.final_shader);
-
-  renderer->SetBackground(opt.render.background.color.data());
-  renderer->SetUseBlurBackground(opt.render.background.blur);
-  renderer->SetBlurCircleOfConfusionRadius(opt.render.background.blur_coc);
-  renderer->SetLightIntensity(opt.render.light.intensity);
-
-  renderer->SetHDRIFile(opt.render.hdri.file);
-  renderer->SetUseImageBasedLighting(opt.render.hdri.ambient);
-  renderer->ShowHDRISkybox(opt.render.background.skybox);
-
-  renderer->SetFontFile(opt.ui.font_file);
-
-  renderer->SetGridUnitSquare(opt.render.grid.unit);
-  renderer->SetGridSubdivisions(opt.render.grid.subdivisions);
-  renderer->SetGridAbsolute(opt.render.grid.absolute);
-  renderer->ShowGrid(opt.render.grid.enable);
-  renderer->SetGridColor(opt.render.grid.color);
-
-  if (!opt.scene.camera.index.has_value())
+  std::optional<options>& applied = this->Internals->AppliedOptions;
+  const std::vector<std::string> changedNames =
+    applied.has_value() ? opt.getChangedNames(applied.value()) : std::vector<std::string>();
+  auto changed = [&](std::initializer_list<std::string_view> prefixes)
+  {
+    return !applied.has_value() ||
+      std::any_of(changedNames.begin(), changedNames.end(),
+        [&](const std::string& name)
+        {
+          return std::any_of(prefixes.begin(), prefixes.end(),
+            [&](std::string_view prefix) { return name.compare(0, prefix.size(), prefix) == 0; });
+        });
+  };
+
+  if (changed({ "interactor." }))
+  {
+    renderer->ShowAxis(opt.interactor.axis);
+    renderer->SetUseTrackball(opt.interactor.trackball);
+    renderer->SetInvertZoom(opt.interactor.invert_zoom);
+  }
+
+  if (changed({ "model.point_sprites." }))
+  {
+    // XXX: model.point_sprites.type only has an effect on geometry scene
+    // but we set it here for practical reasons
+    const int pointSpritesSize = opt.model.point_sprites.size;
+    const vtkF3DRenderer::SplatType splatType = opt.model.point_sprites.type == "gaussian"
+      ? vtkF3DRenderer::SplatType::GAUSSIAN
+      : vtkF3DRenderer::SplatType::SPHERE;
+    renderer->SetPointSpritesProperties(splatType, pointSpritesSize,
+      opt.model.point_sprites.sort_budget, opt.model.point_sprites.instancing);
+    renderer->SetUsePointSprites(opt.model.point_sprites.enable);
+  }
+
+  if (changed({ "render.line_width", "render.point_size", "render.show_edges" }))
+  {
+    renderer->SetLineWidth(opt.render.line_width);
+    renderer->SetPointSize(opt.render.point_size);
+    renderer->ShowEdge(opt.render.show_edges);
+  }
+
+  if (changed({ "ui." }))
+  {
+    renderer->ShowTimer(opt.ui.fps);
+    renderer->ShowFrameStatistics(opt.ui.frame_stats);
+    renderer->ShowFilename(opt.ui.filename);
+    renderer->SetFilenameInfo(opt.ui.filename_info);
+    renderer->ShowMetaData(opt.ui.metadata);
+    renderer->ShowCheatSheet(opt.ui.cheatsheet);
+    renderer->ShowDropZone(opt.ui.dropzone);
+    renderer->SetDropZoneInfo(opt.ui.dropzone_info);
+    renderer->SetFontFile(opt.ui.font_file);
+    renderer->ShowScalarBar(opt.ui.scalar_bar);
+  }
+
+  if (changed({ "render.raytracing." }))
+  {
+    renderer->SetUseRaytracing(opt.render.raytracing.enable);
+    renderer->SetRaytracingSamples(opt.render.raytracing.samples);
+    renderer->SetUseRaytracingDenoiser(opt.render.raytracing.denoise);
+  }
+
+  if (changed({ "render.effect.", "render.backface_type" }))
+  {
+    renderer->SetUseSSAOPass(opt.render.effect.ambient_occlusion);
+    renderer->SetAmbientOcclusionDownsampling(opt.render.effect.ambient_occlusion_downsampling);
+    renderer->SetUseEDLPass(opt.render.effect.eye_dome_lighting);
+    renderer->SetProgressiveFrames(opt.render.effect.progressive_frames);
+    renderer->SetUseFXAAPass(opt.render.effect.anti_aliasing);
+    renderer->SetAntiAliasingTechnique(opt.render.effect.anti_aliasing_technique);
+    renderer->SetUseToneMappingPass(opt.render.effect.tone_mapping);
+    renderer->SetUseDepthPeelingPass(opt.render.effect.translucency_support);
+    renderer->SetTranslucencyTechnique(opt.render.effect.translucency_technique);
+    renderer->SetTranslucencyPeels(opt.render.effect.translucency_peels);
+    renderer->SetTranslucencyThreshold(opt.render.effect.translucency_threshold);
+    renderer->SetBackfaceType(opt.render.backface_type);
+    renderer->SetFinalShader(opt.render.effect.final_shader);
+  }
+
+  if (changed({ "render.background.", "render.hdri.", "render.light." }))
+  {
+    renderer->SetBackground(opt.render.background.color.data());
+    renderer->SetUseBlurBackground(opt.render.background.blur);
+    renderer->SetBlurCircleOfConfusionRadius(opt.render.background.blur_coc);
+    renderer->SetLightIntensity(opt.render.light.intensity);
+
+    renderer->SetHDRIFile(opt.render.hdri.file);
+    renderer->SetUseImageBasedLighting(opt.render.hdri.ambient);
+    renderer->ShowHDRISkybox(opt.render.background.skybox);
+  }
+
+  if (changed({ "render.dynamic_resolution.", "render.lod.", "render.occlusion_culling",
+        "render.static_batching", "render.compact_vertices", "render.texture_budget" }))
+  {
+    renderer->SetUseDynamicResolution(opt.render.dynamic_resolution.enable);
+    renderer->SetDynamicResolutionFrameRate(opt.render.dynamic_resolution.frame_rate);
+    renderer->SetUseLOD(opt.render.lod.enable);
+    renderer->SetLODFrameRate(opt.render.lod.frame_rate);
+    renderer->SetUseOcclusionCulling(opt.render.occlusion_culling);
+    renderer->SetUseStaticBatching(opt.render.static_batching);
+    renderer->SetUseCompactVertices(opt.render.compact_vertices);
+    renderer->SetTextureBudget(opt.render.texture_budget);
+  }
+
+  if (changed({ "render.grid." }))
+  {
+    renderer->SetGridUnitSquare(opt.render.grid.unit);
+    renderer->SetGridSubdivisions(opt.render.grid.subdivisions);
+    renderer->SetGridAbsolute(opt.render.grid.absolute);
+    renderer->ShowGrid(opt.render.grid.enable);
+    renderer->SetGridColor(opt.render.grid.color);
+  }
+
+  if (changed({ "scene.camera." }) && !opt.scene.camera.index.has_value())
   {
     renderer->SetUseOrthographicProjection(opt.scene.camera.orthographic);
   }
 
-  renderer->SetSurfaceColor(opt.model.color.rgb);
-  renderer->SetOpacity(opt.model.color.opacity);
-  renderer->SetTextureBaseColor(opt.model.color.texture);
-  renderer->SetRoughness(opt.model.material.roughness);
-  renderer->SetMetallic(opt.model.material.metallic);
-  renderer->SetTextureMaterial(opt.model.material.texture);
-  renderer->SetTextureEmissive(opt.model.emissive.texture);
-  renderer->SetEmissiveFactor(opt.model.emissive.factor);
-  renderer->SetTextureNormal(opt.model.normal.texture);
-  renderer->SetNormalScale(opt.model.normal.scale);
-  renderer->SetTextureMatCap(opt.model.matcap.texture);
+  if (changed({ "model.color.", "model.material.", "model.emissive.", "model.normal.",
+        "model.matcap." }))
+  {
+    renderer->SetSurfaceColor(opt.model.color.rgb);
+    renderer->SetOpacity(opt.model.color.opacity);
+    renderer->SetTextureBaseColor(opt.model.color.texture);
+    renderer->SetRoughness(opt.model.material.roughness);
+    renderer->SetMetallic(opt.model.material.metallic);
+    renderer->SetTextureMaterial(opt.model.material.texture);
+    renderer->SetTextureEmissive(opt.model.emissive.texture);
+    renderer->SetEmissiveFactor(opt.model.emissive.factor);
+    renderer->SetTextureNormal(opt.model.normal.texture);
+    renderer->SetNormalScale(opt.model.normal.scale);
+    renderer->SetTextureMatCap(opt.model.matcap.texture);
+  }
 
-  renderer->SetEnableColoring(opt.model.scivis.enable);
-  renderer->SetUseCellColoring(opt.model.scivis.cells);
-  renderer->SetArrayNameForColoring(opt.model.scivis.array_name);
-  renderer->SetComponentForColoring(opt.model.scivis.component);
+  if (changed({ "model.scivis." }))
+  {
+    renderer->SetEnableColoring(opt.model.scivis.enable);
+    renderer->SetUseCellColoring(opt.model.scivis.cells);
+    renderer->SetArrayNameForColoring(opt.model.scivis.array_name);
+    renderer->SetComponentForColoring(opt.model.scivis.component);
+    renderer->SetScalarBarRange(opt.model.scivis.range);
+    renderer->SetColormap(opt.model.scivis.colormap);
+    renderer->SetUseGPUColoring(opt.model.scivis.gpu_coloring);
+  }
 
-  renderer->SetScalarBarRange(opt.model.scivis.range);
-  renderer->SetColormap(opt.model.scivis.colormap);
-  renderer->ShowScalarBar(opt.ui.scalar_bar);
+  if (changed({ "model.volume." }))
+  {
+    renderer->SetUseVolume(opt.model.volume.enable);
+    renderer->SetUseInverseOpacityFunction(opt.model.volume.inverse);
+    renderer->SetVolumePrecision(opt.model.volume.precision);
+    renderer->SetUseVolumePreIntegration(opt.model.volume.pre_integration);
+  }
 
-  renderer->SetUsePointSprites(opt.model.point_sprites.enable);
-  renderer->SetUseVolume(opt.model.volume.enable);
-  renderer->SetUseInverseOpacityFunction(opt.model.volume.inverse);
+  if (!applied.has_value() || !changedNames.empty())
+  {
+    applied = opt;
+  }
 
   renderer->UpdateActors();
 }
@@ -565,6 +732,19 @@ void window_impl::PrintColoringDescription(log::VerboseLevel level)
   }
 }
 
+//----------------------------------------------------------------------------
+bool window_impl::PrintFrameStatistics(log::VerboseLevel level)
+{
+  vtkF3DFrameStatistics* stats = this->Internals->Renderer->GetFrameStatistics();
+  if (stats->GetCPUSummary().Count == 0)
+  {
+    log::warn("No frame statistics recorded, enable ui.fps or ui.frame_stats to record them");
+    return false;
+  }
+  log::print(level, stats->GetJSON());
+  return true;
+}
+
 //----------------------------------------------------------------------------
 vtkRenderWindow* window_impl::GetRenderWindow()
 {
@@ -574,49 +754,494 @@ vtkRenderWindow* window_impl::GetRenderWindow()
 //----------------------------------------------------------------------------
 bool window_impl::render()
 {
+  F3D_TRACE_SCOPE("window::render");
+  const vtkF3DMetrics::Timer timer("f3d_render_seconds");
   this->UpdateDynamicOptions();
   this->Internals->RenWin->Render();
   return true;
 }
 
+//----------------------------------------------------------------------------
+void window_impl::RenderCamera()
+{
+  F3D_TRACE_SCOPE("window_impl::RenderCamera");
+  this->Internals->RenWin->Render();
+}
+
 //----------------------------------------------------------------------------
 image window_impl::renderToImage(bool noBackground)
 {
+  image output;
+  this->renderToImage(output, noBackground);
+  return output;
+}
+
+//----------------------------------------------------------------------------
+image& window_impl::renderToImage(image& output, bool noBackground)
+{
+  F3D_TRACE_SCOPE("window::renderToImage");
+  const vtkF3DMetrics::Timer timer("f3d_render_to_image_seconds");
   this->UpdateDynamicOptions();
 
-  vtkNew<vtkWindowToImageFilter> rtW2if;
+  // the filters are reused between calls, force them to update
+  vtkWindowToImageFilter* rtW2if = this->Internals->WindowToImageFilter;
   rtW2if->SetInput(this->Internals->RenWin);
+  rtW2if->SetInputBufferTypeToRGB();
+  rtW2if->Modified();
 
   if (noBackground)
   {
     // we need to set the background to black to avoid blending issues with translucent
     // objects when saving to file with no background
     this->Internals->RenWin->GetRenderers()->GetFirstRenderer()->SetBackground(0, 0, 0);
+    this->Internals->AppliedOptions.reset();
     rtW2if->SetInputBufferTypeToRGBA();
   }
 
-  vtkNew<vtkImageExport> exporter;
+  // the frames accumulated while the view is still are all rendered before capturing the image,
+  // the number of renders is bounded in case the window is interacted with meanwhile
+  const options& opt = this->Internals->Options;
+  if (opt.render.effect.progressive_frames > 0 ||
+    (opt.render.effect.ambient_occlusion && opt.render.effect.ambient_occlusion_downsampling > 1) ||
+    (opt.render.effect.anti_aliasing && opt.render.effect.anti_aliasing_technique == "taa"))
+  {
+    int maxRenders = std::max(opt.render.effect.progressive_frames, 16) + 1;
+    for (int i = 0; i < maxRenders && (i == 0 || this->Internals->Renderer->IsRenderAccumulating());
+         i++)
+    {
+      this->Internals->RenWin->Render();
+    }
+  }
+
+  // the render, if not accumulated above, and the copy of the frame buffer
+  const vtkF3DMetrics::Timer readbackTimer("f3d_readback_seconds");
+  vtkImageExport* exporter = this->Internals->ImageExporter;
   exporter->SetInputConnection(rtW2if->GetOutputPort());
   exporter->ImageLowerLeftOn();
 
   int* dims = exporter->GetDataDimensions();
   int cmp = exporter->GetDataNumberOfScalarComponents();
 
-  image output(dims[0], dims[1], cmp);
+  // reuse the provided image buffer when possible
+  if (output.getWidth() != static_cast<unsigned int>(dims[0]) ||
+    output.getHeight() != static_cast<unsigned int>(dims[1]) ||
+    output.getChannelCount() != static_cast<unsigned int>(cmp) ||
+    output.getChannelType() != image::ChannelType::BYTE)
+  {
+    output = image(dims[0], dims[1], cmp);
+  }
   exporter->Export(output.getContent());
 
   return output;
 }
 
+//----------------------------------------------------------------------------
+image window_impl::renderToTiledImage(int scale, bool noBackground)
+{
+  if (scale < 2)
+  {
+    return this->renderToImage(noBackground);
+  }
+
+  F3D_TRACE_SCOPE("window::renderToTiledImage");
+  return this->RenderTiles(scale, noBackground, 0, this->Internals->RenWin->GetSize()[1] * scale);
+}
+
+//----------------------------------------------------------------------------
+image window_impl::renderToTiledImageBand(int scale, int index, int count, bool noBackground)
+{
+  if (count < 2)
+  {
+    return index == 0 ? this->renderToTiledImage(scale, noBackground) : image();
+  }
+  if (index < 0 || index >= count)
+  {
+    return image();
+  }
+
+  // the bands are from the top, the rows of the images start at the bottom
+  F3D_TRACE_SCOPE("window::renderToTiledImageBand");
+  scale = std::max(scale, 1);
+  const int outputHeight = this->Internals->RenWin->GetSize()[1] * scale;
+  const int bandHeight = (outputHeight + count - 1) / count;
+  const int rowEnd = std::max(outputHeight - index * bandHeight, 0);
+  const int rowBegin = std::max(rowEnd - bandHeight, 0);
+  if (rowBegin == rowEnd)
+  {
+    return image();
+  }
+  return this->RenderTiles(scale, noBackground, rowBegin, rowEnd);
+}
+
+//----------------------------------------------------------------------------
+image window_impl::RenderTiles(int scale, bool noBackground, int rowBegin, int rowEnd)
+{
+  vtkRenderWindow* renWin = this->Internals->RenWin;
+  vtkRenderer* renderer = this->Internals->Renderer;
+  vtkCamera* cam = renderer->GetActiveCamera();
+
+  const int width = renWin->GetSize()[0];
+  const int height = renWin->GetSize()[1];
+
+  // screen space effects (ambient occlusion, blur, anti-aliasing) read the neighbouring pixels,
+  // so the tiles overlap by a margin which is not copied in the output
+  const int margin = std::min(32, std::min(width, height) / 4);
+  const int tileWidth = width - 2 * margin;
+  const int tileHeight = height - 2 * margin;
+  const int outputWidth = width * scale;
+  const int outputHeight = height * scale;
+  const int bandHeight = rowEnd - rowBegin;
+
+  // the 2D annotations would be repeated in each tile
+  std::vector<vtkProp*> hiddenProps;
+  vtkCollectionSimpleIterator propIt;
+  vtkPropCollection* props = renderer->GetViewProps();
+  props->InitTraversal(propIt);
+  while (vtkProp* prop = props->GetNextProp(propIt))
+  {
+    if (vtkActor2D::SafeDownCast(prop) && prop->GetVisibility())
+    {
+      prop->VisibilityOff();
+      hiddenProps.emplace_back(prop);
+    }
+  }
+  std::vector<vtkRenderer*> hiddenRenderers;
+  vtkCollectionSimpleIterator renIt;
+  vtkRendererCollection* renderers = renWin->GetRenderers();
+  renderers->InitTraversal(renIt);
+  while (vtkRenderer* ren = renderers->GetNextRenderer(renIt))
+  {
+    if (ren != renderer && ren->GetDraw())
+    {
+      ren->DrawOff();
+      hiddenRenderers.emplace_back(ren);
+    }
+  }
+
+  // each tile is rendered with a sub-frustum of the camera, so a pixel of the window
+  // is a pixel of the output
+  double viewAngle = cam->GetViewAngle();
+  double parallelScale = cam->GetParallelScale();
+  double windowCenter[2];
+  cam->GetWindowCenter(windowCenter);
+  cam->SetViewAngle(vtkMath::DegreesFromRadians(
+    2.0 * std::atan(std::tan(vtkMath::RadiansFromDegrees(viewAngle) / 2.0) / scale)));
+  cam->SetParallelScale(parallelScale / scale);
+
+  image output;
+  image tile;
+  for (int y = rowBegin; y < rowEnd; y += tileHeight)
+  {
+    for (int x = 0; x < outputWidth; x += tileWidth)
+    {
+      // offset of the tile center from the output center, in the normalized units of the tile
+      cam->SetWindowCenter(
+        windowCenter[0] * scale + (2.0 * x + tileWidth - outputWidth) / width,
+        windowCenter[1] * scale + (2.0 * y + tileHeight - outputHeight) / height);
+
+      this->renderToImage(tile, noBackground);
+
+      const unsigned int cmp = tile.getChannelCount();
+      if (output.getChannelCount() != cmp)
+      {
+        output = image(outputWidth, bandHeight, cmp);
+      }
+
+      const int copyWidth = std::min(tileWidth, outputWidth - x);
+      const int copyHeight = std::min(tileHeight, rowEnd - y);
+      const unsigned char* tileData = static_cast<const unsigned char*>(tile.getContent());
+      unsigned char* outputData = static_cast<unsigned char*>(output.getContent());
+      for (int row = 0; row < copyHeight; row++)
+      {
+        std::copy_n(tileData + (static_cast<size_t>(row + margin) * width + margin) * cmp,
+          static_cast<size_t>(copyWidth) * cmp,
+          outputData + (static_cast<size_t>(y - rowBegin + row) * outputWidth + x) * cmp);
+      }
+    }
+  }
+
+  cam->SetViewAngle(viewAngle);
+  cam->SetParallelScale(parallelScale);
+  cam->SetWindowCenter(windowCenter[0], windowCenter[1]);
+  for (vtkProp* prop : hiddenProps)
+  {
+    prop->VisibilityOn();
+  }
+  for (vtkRenderer* ren : hiddenRenderers)
+  {
+    ren->DrawOn();
+  }
+
+  return output;
+}
+
+//----------------------------------------------------------------------------
+aovs_t window_impl::renderToAOVs(bool noBackground)
+{
+  F3D_TRACE_SCOPE("window::renderToAOVs");
+  aovs_t aovs;
+  this->renderToImage(aovs.color, noBackground);
+
+  const unsigned int width = aovs.color.getWidth();
+  const unsigned int height = aovs.color.getHeight();
+  const size_t nbPixels = static_cast<size_t>(width) * height;
+  aovs.depth = image(width, height, 1, image::ChannelType::FLOAT);
+  aovs.normal = image(width, height, 3, image::ChannelType::FLOAT);
+  aovs.index = image(width, height, 1, image::ChannelType::SHORT);
+
+  float* depth = static_cast<float*>(aovs.depth.getContent());
+  float* normal = static_cast<float*>(aovs.normal.getContent());
+  std::vector<float> values;
+  vtkF3DRenderer* renderer = this->Internals->Renderer;
+  if (renderer->ReadDepthAndNormals(values) && values.size() == 4 * nbPixels)
+  {
+    for (size_t i = 0; i < nbPixels; i++)
+    {
+      std::copy_n(values.data() + 4 * i, 3, normal + 3 * i);
+      depth[i] = values[4 * i + 3];
+    }
+  }
+  else
+  {
+    std::fill_n(depth, nbPixels, 0.f);
+    std::fill_n(normal, 3 * nbPixels, 0.f);
+  }
+
+  std::vector<unsigned short> indices;
+  renderer->RenderActorIndices(indices);
+  unsigned short* index = static_cast<unsigned short*>(aovs.index.getContent());
+  std::fill_n(index, nbPixels, 0);
+  std::copy_n(indices.data(), std::min(indices.size(), nbPixels), index);
+
+  return aovs;
+}
+
+//----------------------------------------------------------------------------
+std::future<image> window_impl::renderToImageAsync(bool noBackground)
+{
+  vtkOpenGLRenderWindow* oglRenWin = vtkOpenGLRenderWindow::SafeDownCast(this->Internals->RenWin);
+  if (!oglRenWin)
+  {
+    std::promise<image> result;
+    result.set_value(this->renderToImage(noBackground));
+    return result.get_future();
+  }
+
+  this->UpdateDynamicOptions();
+
+  if (noBackground)
+  {
+    // same as renderToImage, see above
+    this->Internals->RenWin->GetRenderers()->GetFirstRenderer()->SetBackground(0, 0, 0);
+    this->Internals->AppliedOptions.reset();
+  }
+
+  this->Internals->RenWin->Render();
+  return this->Internals->ReadPixelsAsync(oglRenWin, noBackground);
+}
+
+//----------------------------------------------------------------------------
+void window_impl::RenderViews(const std::vector<camera_state_t>& views, bool noBackground,
+  const std::function<void(size_t, const image&)>& consumer)
+{
+  camera& cam = this->getCamera();
+  const camera_state_t initialState = cam.getState();
+
+  vtkOpenGLRenderWindow* oglRenWin = vtkOpenGLRenderWindow::SafeDownCast(this->Internals->RenWin);
+  if (!oglRenWin)
+  {
+    for (size_t i = 0; i < views.size(); i++)
+    {
+      cam.setState(views[i]);
+      consumer(i, this->renderToImage(noBackground));
+    }
+    cam.setState(initialState);
+    return;
+  }
+
+  // only the camera changes between the views, the options are forwarded once
+  this->UpdateDynamicOptions();
+  if (noBackground)
+  {
+    // same as renderToImage, see above
+    this->Internals->RenWin->GetRenderers()->GetFirstRenderer()->SetBackground(0, 0, 0);
+    this->Internals->AppliedOptions.reset();
+  }
+
+  const options& opt = this->Internals->Options;
+  const bool accumulate = opt.render.effect.progressive_frames > 0 ||
+    (opt.render.effect.ambient_occlusion && opt.render.effect.ambient_occlusion_downsampling > 1) ||
+    (opt.render.effect.anti_aliasing && opt.render.effect.anti_aliasing_technique == "taa");
+  const int maxRenders = accumulate ? std::max(opt.render.effect.progressive_frames, 16) + 1 : 1;
+
+  // the transfer of a view overlaps with the renders of the next ones, the number of views
+  // in flight is bounded to limit the memory used by the readbacks
+  std::deque<std::future<image>> pending;
+  size_t consumed = 0;
+  for (const camera_state_t& view : views)
+  {
+    cam.setState(view);
+    for (int i = 0; i < maxRenders && (i == 0 || this->Internals->Renderer->IsRenderAccumulating());
+         i++)
+    {
+      this->Internals->RenWin->Render();
+    }
+    pending.emplace_back(this->Internals->ReadPixelsAsync(oglRenWin, noBackground));
+
+    if (pending.size() > ::MAX_PENDING_VIEWS)
+    {
+      consumer(consumed++, pending.front().get());
+      pending.pop_front();
+    }
+  }
+  for (std::future<image>& future : pending)
+  {
+    consumer(consumed++, future.get());
+  }
+
+  cam.setState(initialState);
+}
+
+//----------------------------------------------------------------------------
+std::vector<image> window_impl::renderViews(
+  const std::vector<camera_state_t>& views, bool noBackground)
+{
+  F3D_TRACE_SCOPE("window::renderViews");
+  std::vector<image> output(views.size());
+  this->RenderViews(
+    views, noBackground, [&](size_t index, const image& view) { output[index] = view; });
+  return output;
+}
+
+//----------------------------------------------------------------------------
+image window_impl::renderViewsToSpriteSheet(
+  const std::vector<camera_state_t>& views, int columns, bool noBackground)
+{
+  F3D_TRACE_SCOPE("window::renderViewsToSpriteSheet");
+  if (views.empty())
+  {
+    return image();
+  }
+
+  const int width = this->Internals->RenWin->GetSize()[0];
+  const int height = this->Internals->RenWin->GetSize()[1];
+  const int nbViews = static_cast<int>(views.size());
+  columns = std::clamp(columns, 1, nbViews);
+  const int rows = (nbViews + columns - 1) / columns;
+  const int outputWidth = width * columns;
+
+  // the views are packed from the top left corner, the rows of the images start at the bottom
+  image output(outputWidth, height * rows, noBackground ? 4 : 3);
+  unsigned char* outputData = static_cast<unsigned char*>(output.getContent());
+  std::fill_n(outputData,
+    static_cast<size_t>(outputWidth) * height * rows * output.getChannelCount(), 0);
+  this->RenderViews(views, noBackground,
+    [&](size_t index, const image& view)
+    {
+      const unsigned int cmp = view.getChannelCount();
+      const int x = static_cast<int>(index) % columns * width;
+      const int y = (rows - 1 - static_cast<int>(index) / columns) * height;
+      const unsigned char* viewData = static_cast<const unsigned char*>(view.getContent());
+      for (int row = 0; row < height; row++)
+      {
+        std::copy_n(viewData + static_cast<size_t>(row) * width * cmp,
+          static_cast<size_t>(width) * cmp,
+          outputData + (static_cast<size_t>(y + row) * outputWidth + x) * cmp);
+      }
+    });
+  return output;
+}
+
+//----------------------------------------------------------------------------
+window& window_impl::setAdditionalViews(const std::vector<camera_state_t>& views)
+{
+  vtkF3DRenderer* renderer = this->Internals->Renderer;
+  std::vector<vtkSmartPointer<vtkCamera>> cameras;
+  for (const camera_state_t& view : views)
+  {
+    // the other parameters, like the parallel projection, are the ones of the main view
+    vtkNew<vtkCamera> camera;
+    camera->DeepCopy(renderer->GetActiveCamera());
+    camera->SetPosition(view.pos.data());
+    camera->SetFocalPoint(view.foc.data());
+    camera->SetViewUp(view.up.data());
+    camera->SetViewAngle(view.angle);
+    camera->OrthogonalizeViewUp();
+    cameras.emplace_back(camera);
+  }
+  renderer->SetAdditionalViewCameras(cameras);
+  return *this;
+}
+
 //----------------------------------------------------------------------------
 void window_impl::SetImporter(vtkF3DMetaImporter* importer)
 {
   this->Internals->Renderer->SetImporter(importer);
 }
 
+//----------------------------------------------------------------------------
+void window_impl::ShowPlaceholderBounds(const double* bounds)
+{
+  vtkF3DRenderer* renderer = this->Internals->Renderer;
+  renderer->SetPlaceholderBounds(bounds);
+  if (!bounds)
+  {
+    return;
+  }
+
+  double sceneBounds[6];
+  renderer->GetSceneBounds(sceneBounds);
+  vtkBoundingBox box(bounds);
+  if (vtkMath::AreBoundsInitialized(sceneBounds))
+  {
+    box.AddBounds(sceneBounds);
+  }
+  double framedBounds[6];
+  box.GetBounds(framedBounds);
+
+  this->UpdateDynamicOptions();
+  renderer->ResetCamera(framedBounds);
+  this->render();
+}
+
 //----------------------------------------------------------------------------
 void window_impl::SetCachePath(const std::string& cachePath)
 {
   this->Internals->CachePath = cachePath;
+
+  // share the cache path with readers, including plugins ones
+  vtkF3DCache::SetDirectory(cachePath);
+}
+
+//----------------------------------------------------------------------------
+void window_impl::SetDeviceIndex(int index)
+{
+#if defined(VTK_OPENGL_HAS_EGL) && VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240914)
+  vtkEGLRenderWindow* eglRenWin = vtkEGLRenderWindow::SafeDownCast(this->Internals->RenWin);
+  if (eglRenWin)
+  {
+    int count = eglRenWin->GetNumberOfDevices();
+    if (index >= count)
+    {
+      throw engine::no_window_exception("EGL device index " + std::to_string(index) +
+        " is invalid, " + std::to_string(count) + " devices are available");
+    }
+    log::debug("Using EGL device ", index, " out of ", count);
+    eglRenWin->SetDeviceIndex(index);
+  }
+#else
+  (void)index;
+#endif
+}
+
+//----------------------------------------------------------------------------
+int window_impl::GetEGLDeviceCount()
+{
+#if defined(VTK_OPENGL_HAS_EGL) && VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240914)
+  vtkNew<vtkEGLRenderWindow> eglRenWin;
+  return eglRenWin->GetNumberOfDevices();
+#else
+  return 0;
+#endif
 }
 };
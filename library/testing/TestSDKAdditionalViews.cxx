@@ -0,0 +1,57 @@
+#include "PseudoUnitTest.h"
+
+#include <engine.h>
+#include <image.h>
+#include <log.h>
+#include <scene.h>
+#include <window.h>
+
+#include <algorithm>
+#include <vector>
+
+int TestSDKAdditionalViews(int argc, char* argv[])
+{
+  PseudoUnitTest test;
+
+  f3d::log::setVerboseLevel(f3d::log::VerboseLevel::DEBUG);
+  f3d::engine eng = f3d::engine::create(true);
+  f3d::scene& sce = eng.getScene();
+  f3d::window& win = eng.getWindow().setSize(300, 200);
+  f3d::camera& cam = win.getCamera();
+
+  sce.add(std::string(argv[1]) + "data/suzanne.ply");
+  const f3d::image reference = win.renderToImage();
+
+  // an additional view with the camera of the main view renders the same half of the window
+  win.setAdditionalViews({ cam.getState() });
+  const f3d::image views = win.renderToImage();
+  test("size of the window", views.getWidth() == 300 && views.getHeight() == 200);
+
+  const unsigned char* data = static_cast<const unsigned char*>(views.getContent());
+  bool same = true;
+  for (int row = 0; row < 200 && same; row++)
+  {
+    const unsigned char* left = data + row * 300 * 3;
+    same = std::equal(left, left + 150 * 3, left + 150 * 3);
+  }
+  test("views are identical", same);
+  test("views are different from a single view", !(views == reference));
+
+  // moving the main camera does not move the additional view
+  cam.azimuth(90);
+  const f3d::image moved = win.renderToImage();
+  const unsigned char* movedData = static_cast<const unsigned char*>(moved.getContent());
+  same = true;
+  for (int row = 0; row < 200 && same; row++)
+  {
+    const unsigned char* right = data + row * 300 * 3 + 150 * 3;
+    same = std::equal(right, right + 150 * 3, movedData + row * 300 * 3 + 150 * 3);
+  }
+  test("additional view is not moved by the main camera", same);
+
+  cam.azimuth(-90);
+  win.setAdditionalViews({});
+  test("single view is restored", win.renderToImage() == reference);
+
+  return test.result();
+}
@@ -39,5 +39,25 @@ int TestSDKAnimation(int argc, char* argv[])
     return EXIT_FAILURE;
   }
 
+  std::pair<double, double> timeRange = sce.animationTimeRange();
+  if (timeRange.first != 0.0 || timeRange.second <= timeRange.first)
+  {
+    std::cerr << "Unexpected animation time range: [" << timeRange.first << ", "
+              << timeRange.second << "]." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Out of range animation times are clamped
+  sce.loadAnimationTime(timeRange.second / 2);
+  sce.loadAnimationTime(timeRange.second + 1);
+
+  sce.clear();
+  timeRange = sce.animationTimeRange();
+  if (timeRange.first != 0.0 || timeRange.second != 0.0)
+  {
+    std::cerr << "Unexpected animation time range without animation." << std::endl;
+    return EXIT_FAILURE;
+  }
+
   return EXIT_SUCCESS;
 }
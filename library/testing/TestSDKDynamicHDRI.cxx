@@ -59,15 +59,15 @@ int TestSDKDynamicHDRI(int argc, char* argv[])
     return EXIT_FAILURE;
   }
 
-  // Check caching is working
+  // The LUT is embedded, it must not be written in the cache
   std::ifstream lutFile(cachePath + "/lut.vti");
-  if (!lutFile.is_open())
+  if (lutFile.is_open())
   {
-    std::cerr << "LUT cache file not found" << std::endl;
+    std::cerr << "LUT cache file should not be written" << std::endl;
     return EXIT_FAILURE;
   }
 
-  // Force a cache path change to force a LUT reconfiguration and test dynamic cache path
+  // Force a cache path change to test dynamic cache path
   eng.setCachePath(std::string(argv[2]) + "/cache_" + std::to_string(dist(e1)));
   ret = TestSDKHelpers::RenderTest(eng.getWindow(), std::string(argv[1]) + "baselines/",
     std::string(argv[2]), "TestSDKDynamicHDRI");
@@ -71,5 +71,21 @@ int TestSDKEngine(int argc, char* argv[])
     return EXIT_FAILURE;
   }
 
+  // An out of range EGL device cannot be selected
+  int eglDevices = f3d::engine::getEGLDeviceCount();
+  if (eglDevices > 0)
+  {
+    try
+    {
+      f3d::engine eng3 = f3d::engine::createEGL(true, eglDevices);
+      std::cerr << "Unexpected EGL engine with an invalid device index" << std::endl;
+      return EXIT_FAILURE;
+    }
+    catch (const f3d::engine::no_window_exception& ex)
+    {
+      std::cout << "Expected exception: " << ex.what() << std::endl;
+    }
+  }
+
   return EXIT_SUCCESS;
 }
@@ -31,6 +31,18 @@ int TestSDKEngineExceptions(int argc, char* argv[])
     std::cout << ex.what() << std::endl;
   }
 
+  try
+  {
+    f3d::engine::declarePlugin("invalid.json");
+    std::cerr << "An exception has not been thrown when declaring a plugin from an invalid file"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+  catch (const f3d::engine::plugin_exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+  }
+
 // These tests are defined for coverage
 #ifdef __linux__
   try
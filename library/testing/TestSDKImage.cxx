@@ -3,8 +3,10 @@
 #include <image.h>
 
 #include <algorithm>
+#include <cmath>
 #include <fstream>
 #include <functional>
+#include <future>
 #include <iostream>
 #include <limits>
 #include <random>
@@ -61,6 +63,28 @@ int TestSDKImage(int argc, char* argv[])
   generated16.save(tmpDir + "/TestSDKImage16.tif", f3d::image::SaveFormat::TIF);
   generated32.save(tmpDir + "/TestSDKImage32.tif", f3d::image::SaveFormat::TIF);
 
+  // test saveAsync, the image can be modified while it is being saved
+  {
+    f3d::image asyncImg = generated;
+    asyncImg.setMetadata("key", "value");
+    std::vector<std::future<void>> futures;
+    futures.emplace_back(asyncImg.saveAsync(tmpDir + "/TestSDKImageAsync.png"));
+    futures.emplace_back(
+      asyncImg.saveAsync(tmpDir + "/TestSDKImageAsync.bmp", f3d::image::SaveFormat::BMP));
+    asyncImg.setContent(pixels16.data());
+    test("saveAsync PNG", [&]() { futures[0].get(); });
+    test("saveAsync BMP", [&]() { futures[1].get(); });
+    f3d::image asyncRead(tmpDir + "/TestSDKImageAsync.png");
+    test("saveAsync PNG content", asyncRead == generated);
+    test("saveAsync PNG metadata", asyncRead.getMetadata("key"), std::string("value"));
+
+    test.expect<f3d::image::write_exception>("saveAsync incompatible format", [&]()
+      { generated16.saveAsync(tmpDir + "/TestSDKImageAsync.jpg", f3d::image::SaveFormat::JPG); });
+    std::future<void> invalid = generated.saveAsync("/dummy/folder/img.png");
+    test.expect<f3d::image::write_exception>(
+      "saveAsync to incorrect path", [&]() { invalid.get(); });
+  }
+
   // test saveBuffer in different formats
   std::vector<unsigned char> bufferPNG = generated.saveBuffer();
   test("generated buffer not empty", bufferPNG.size() != 0);
@@ -238,6 +262,84 @@ int TestSDKImage(int argc, char* argv[])
     test("toTerminalText with RGBA image",
       f3d::image(testingDir + "/data/toTerminalText-rgba.png").toTerminalText() ==
         fileToString(testingDir + "/data/toTerminalText-rgba.txt"));
+
+    f3d::image frame(testingDir + "/data/toTerminalText-rgb.png");
+    std::stringstream unchanged;
+    frame.toTerminalText(unchanged, frame);
+    test("toTerminalText with an unchanged previous image",
+      unchanged.str().find_first_of(u8"\u2580\u2584\u2588") == std::string::npos);
+    test.expect<f3d::image::write_exception>("invalid toTerminalText with previous size",
+      [&]() { frame.toTerminalText(unchanged, f3d::image(3, 3, 3)); });
+
+    std::stringstream graphics;
+    frame.toTerminalGraphics(graphics);
+    test("toTerminalGraphics header", graphics.str().rfind("\033_Ga=T,f=100,", 0) == 0);
+  }
+
+  // test downsample
+  {
+    f3d::image img(3, 3, 3);
+    std::vector<unsigned char> pixels(27);
+    for (size_t i = 0; i < pixels.size(); i++)
+    {
+      pixels[i] = static_cast<unsigned char>(i * 4);
+    }
+    img.setContent(pixels.data());
+
+    f3d::image downsampled = img.downsample(2);
+    test("downsample size", downsampled.getWidth() == 2 && downsampled.getHeight() == 2);
+    test("downsample box filter",
+      static_cast<unsigned char*>(downsampled.getContent())[0] == (0 + 12 + 36 + 48) / 4);
+    test("downsample partial block",
+      static_cast<unsigned char*>(downsampled.getContent())[9] == 96);
+    test.expect<f3d::image::write_exception>(
+      "invalid downsample factor", [&]() { img.downsample(0); });
+  }
+
+  // test half float channels
+  {
+    f3d::image img(2, 2, 3, f3d::image::ChannelType::FLOAT);
+    std::vector<float> values = { 0.f, 1.f, -2.5f, 0.1f, 65504.f, 1e6f, 1e-7f, -0.f, 3.14159f,
+      std::numeric_limits<float>::infinity(), 0.5f, 1024.f };
+    img.setContent(values.data());
+
+    f3d::image half = img.convert(f3d::image::ChannelType::HALF);
+    test("convert to HALF channel type", half.getChannelType() == f3d::image::ChannelType::HALF);
+    test("convert to HALF channel type size", half.getChannelTypeSize() == 2);
+
+    const uint16_t* bits = static_cast<const uint16_t*>(half.getContent());
+    test("convert to HALF exact", bits[1] == 0x3c00 && bits[2] == 0xc100);
+    test("convert to HALF max and overflow", bits[4] == 0x7bff && bits[5] == 0x7c00);
+    test("convert to HALF denormal", bits[6] == 0x0002);
+
+    f3d::image back = half.convert(f3d::image::ChannelType::FLOAT);
+    const float* converted = static_cast<const float*>(back.getContent());
+    test("convert to FLOAT rounded", std::abs(converted[3] - 0.1f) < 1e-4f);
+    test("convert to FLOAT infinity", converted[9] == std::numeric_limits<float>::infinity());
+    test("getNormalizedPixel HALF", half.getNormalizedPixel({ 1, 1 })[2] == 1024.0);
+    test("compare HALF", half == img.convert(f3d::image::ChannelType::HALF));
+    test("downsample HALF",
+      half.downsample(2).getChannelType() == f3d::image::ChannelType::HALF);
+
+    test.expect<f3d::image::write_exception>("invalid convert to BYTE",
+      [&]() { half.convert(f3d::image::ChannelType::BYTE); });
+    test.expect<f3d::image::write_exception>("save incompatible HALF to TIF format",
+      [&]() { half.save(tmpDir + "/TestSDKImageHalf.tif", f3d::image::SaveFormat::TIF); });
+    test.expect<f3d::image::write_exception>("save incompatible BYTE to EXR format",
+      [&]() { generated.saveBuffer(f3d::image::SaveFormat::EXR); });
+
+#if F3D_MODULE_EXR
+    f3d::image hdrHalf = hdrImg.convert(f3d::image::ChannelType::HALF);
+    hdrHalf.save(tmpDir + "/TestSDKImageHalf.exr", f3d::image::SaveFormat::EXR);
+    f3d::image exrHalf(tmpDir + "/TestSDKImageHalf.exr");
+    double error;
+    test("save HALF to EXR format",
+      exrHalf.convert(f3d::image::ChannelType::HALF).compare(hdrHalf, 0.05, error));
+
+    std::vector<unsigned char> bufferEXR = hdrImg.saveBuffer(f3d::image::SaveFormat::EXR);
+    test("save FLOAT to EXR buffer",
+      bufferEXR.size() > 4 && bufferEXR[0] == 0x76 && bufferEXR[1] == 0x2f);
+#endif
   }
 
   // test metadata
@@ -291,6 +393,19 @@ int TestSDKImage(int argc, char* argv[])
       img2.getMetadata("foo") == "bar" && img2.getMetadata("hello") == "world");
   }
 
+  // Test external buffer adoption
+  {
+    std::vector<unsigned char> external(4 * 2 * 3, 127);
+    bool deleted = false;
+    {
+      f3d::image wrapped(4, 2, 3, f3d::image::ChannelType::BYTE, external.data(),
+        [&](void* buffer) { deleted = buffer == external.data(); });
+      test("wrapped image does not copy", wrapped.getContent() == external.data());
+      test("wrapped image pixel", wrapped.getNormalizedPixel({ 1, 1 })[0] == 127. / 255.);
+    }
+    test("wrapped image deleter", deleted);
+  }
+
   // Test image::compare dedicated code paths
   double error;
   test("compare images with different channel types",
@@ -306,8 +421,93 @@ int TestSDKImage(int argc, char* argv[])
 
   f3d::image empty(0, 0, 0);
   test("compare empty images", empty.compare(empty, 0, error) && error == 0.);
+  f3d::image generatedCopy = generated;
+  test("compare identical images", generated.compare(generatedCopy, 0, error) && error == 0.);
   test("compare with negative threshold", !empty.compare(empty, -1, error) && error == 1.);
   test("compare with threshold == 1", !empty.compare(empty, 1, error) && error == 1.);
 
+  // identical buffers skip the SSIM, images differing by a single value still compute it
+  f3d::image generatedSame(width, height, channels);
+  generatedSame.setContent(pixels.data());
+  test("compare identical buffers", generated.compare(generatedSame, 1e-14, error) && error == 0.);
+
+  std::vector<uint8_t> nearPixels = pixels;
+  nearPixels[channels * (width * height / 2 + width / 2)] ^= 1;
+  f3d::image generatedNear(width, height, channels);
+  generatedNear.setContent(nearPixels.data());
+  double nearError;
+  test("compare near identical images",
+    !generated.compare(generatedNear, 0, nearError) && nearError > 0. && nearError < 0.05 &&
+      generated.compare(generatedNear, 0.05, error) && error == nearError &&
+      generatedNear.compare(generated, 0.05, error) && error == nearError);
+
+  // the PSNR is checked against the squared errors summed value by value
+  const auto referencePSNR = [&](const auto& a, const auto& b, double peak)
+  {
+    double sum = 0;
+    for (size_t i = 0; i < a.size(); i++)
+    {
+      const double diff = (static_cast<double>(a[i]) - static_cast<double>(b[i])) / peak;
+      sum += diff * diff;
+    }
+    return 10 * std::log10(static_cast<double>(a.size()) / sum);
+  };
+
+  std::vector<uint8_t> noisyPixels = pixels;
+  for (size_t i = 0; i < noisyPixels.size(); i += 7)
+  {
+    noisyPixels[i] = static_cast<uint8_t>(std::clamp(noisyPixels[i] + 5, 0, 255));
+  }
+  f3d::image generatedNoisy(width, height, channels);
+  generatedNoisy.setContent(noisyPixels.data());
+
+  double psnr;
+  const double expectedPSNR = referencePSNR(pixels, noisyPixels, 255.0);
+  test("compare PSNR", generated.comparePSNR(generatedNoisy, 0, psnr) &&
+      std::abs(psnr - expectedPSNR) < 1e-9);
+  test("compare PSNR near identical",
+    generated.comparePSNR(generatedNear, 0, psnr) &&
+      std::abs(psnr - referencePSNR(pixels, nearPixels, 255.0)) < 1e-9);
+  test("compare PSNR identical", generated.comparePSNR(generatedSame, 1000, psnr) &&
+      psnr == std::numeric_limits<double>::infinity());
+  test("compare PSNR early out", !generated.comparePSNR(generatedNoisy, 1000, psnr) &&
+      psnr < 1000 && psnr >= expectedPSNR);
+  test("compare PSNR threshold", !generated.comparePSNR(generatedNoisy, expectedPSNR + 1, psnr));
+
+  std::vector<uint16_t> noisyPixels16 = pixels16;
+  for (size_t i = 0; i < noisyPixels16.size(); i += 3)
+  {
+    noisyPixels16[i] = static_cast<uint16_t>(noisyPixels16[i] / 2);
+  }
+  f3d::image generatedNoisy16(width, height, channels, f3d::image::ChannelType::SHORT);
+  generatedNoisy16.setContent(noisyPixels16.data());
+  test("compare PSNR SHORT", generated16.comparePSNR(generatedNoisy16, 0, psnr) &&
+      std::abs(psnr - referencePSNR(pixels16, noisyPixels16, 65535.0)) < 1e-9);
+
+  std::vector<float> gradient(width * height * channels);
+  std::vector<float> shifted(gradient.size());
+  for (size_t i = 0; i < gradient.size(); i++)
+  {
+    gradient[i] = static_cast<float>(i) / gradient.size();
+    shifted[i] = gradient[i] + (i % 2 ? 0.01f : -0.02f);
+  }
+  f3d::image gradient32(width, height, channels, f3d::image::ChannelType::FLOAT);
+  gradient32.setContent(gradient.data());
+  f3d::image shifted32(width, height, channels, f3d::image::ChannelType::FLOAT);
+  shifted32.setContent(shifted.data());
+  const double expectedPSNR32 = referencePSNR(gradient, shifted, 1.0);
+  test("compare PSNR FLOAT", gradient32.comparePSNR(shifted32, 0, psnr) &&
+      std::abs(psnr - expectedPSNR32) < 1e-9);
+  test("compare PSNR HALF",
+    gradient32.convert(f3d::image::ChannelType::HALF)
+        .comparePSNR(shifted32.convert(f3d::image::ChannelType::HALF), 0, psnr) &&
+      std::abs(psnr - expectedPSNR32) < 1.0);
+
+  test("compare PSNR with different channel types",
+    !generated.comparePSNR(generated16, 0, psnr) && psnr == 0.);
+  test("compare PSNR with different size",
+    !generated.comparePSNR(generatedSize, 0, psnr) && psnr == 0.);
+  test("compare PSNR empty images", empty.comparePSNR(empty, 0, psnr));
+
   return EXIT_SUCCESS;
 }
@@ -58,6 +58,10 @@ int TestSDKInteractorCommand(int argc, char* argv[])
   test(
     "triggerCommand set_camera invalid arg", inter.triggerCommand("set_camera invalid") == false);
 
+  // Coverage print_frame_stats, nothing is rendered
+  test("triggerCommand print_frame_stats without frames",
+    inter.triggerCommand("print_frame_stats") == false);
+
   // Coverage exception handling
   test("triggerCommand exception handling",
     inter.triggerCommand(R"(print "render.hdri.file)") == false);
@@ -75,5 +79,17 @@ int TestSDKInteractorCommand(int argc, char* argv[])
   test("triggerCommand cycle_coloring invalid args",
     inter.triggerCommand("cycle_coloring one two") == false);
 
+  // Test batched commands
+  test("triggerCommands",
+    inter.triggerCommands({ "set model.scivis.cells true", "toggle ui.axis" }));
+  test("triggerCommands applied", options.model.scivis.cells == true && options.ui.axis == true);
+  test("triggerCommands empty", inter.triggerCommands({}));
+  test("triggerCommands failing command",
+    inter.triggerCommands({ "reset model.scivis.cells", "reset inexistent" }) == false);
+  test("triggerCommands failing command applied", options.model.scivis.cells == false);
+  test("triggerCommands untokenizable",
+    inter.triggerCommands({ "reset ui.axis", R"(print "render.hdri.file)" }) == false);
+  test("triggerCommands untokenizable not applied", options.ui.axis == true);
+
   return test.result();
 }
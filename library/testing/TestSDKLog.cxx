@@ -1,5 +1,8 @@
 #include <log.h>
 
+#include <cstdint>
+#include <iostream>
+
 int TestSDKLog(int argc, char* argv[])
 {
   f3d::log::setUseColoring(false);
@@ -51,6 +54,37 @@ int TestSDKLog(int argc, char* argv[])
   f3d::log::warn("Test Warning Coloring");
   f3d::log::error("Test Error Coloring");
 
+  // Levels are checked before formatting the messages
+  f3d::log::setVerboseLevel(f3d::log::VerboseLevel::WARN);
+  if (f3d::log::isEnabled(f3d::log::VerboseLevel::INFO) ||
+    !f3d::log::isEnabled(f3d::log::VerboseLevel::WARN) ||
+    f3d::log::isEnabled(f3d::log::VerboseLevel::QUIET))
+  {
+    std::cerr << "Unexpected enabled verbose levels" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Messages are written by a background thread, disabling it writes the pending messages
+  f3d::log::setVerboseLevel(f3d::log::VerboseLevel::DEBUG);
+  f3d::log::setUseColoring(false);
+  f3d::log::setAsynchronous(true, 4);
+  for (int i = 0; i < 100; i++)
+  {
+    f3d::log::debug("Test Async Debug ", i);
+  }
+  f3d::log::setAsynchronous(false);
+  std::uint64_t dropped = f3d::log::getNumberOfDroppedMessages();
+  f3d::log::info("Test Async Dropped ", dropped);
+
+  // Metrics are exported in both formats and can be reset
+  f3d::log::resetMetrics();
+  if (!f3d::log::getMetrics().empty() ||
+    f3d::log::getMetrics(f3d::log::MetricsFormat::JSON) != "{}")
+  {
+    std::cerr << "Unexpected metrics after reset" << std::endl;
+    return EXIT_FAILURE;
+  }
+
   f3d::log::waitForUser(); // This just returns immediately in testing environment
   return EXIT_SUCCESS;
 }
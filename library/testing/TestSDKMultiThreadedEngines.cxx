@@ -0,0 +1,78 @@
+#include "PseudoUnitTest.h"
+
+#include <engine.h>
+#include <image.h>
+#include <log.h>
+#include <scene.h>
+#include <window.h>
+
+#include <iostream>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+int TestSDKMultiThreadedEngines(int argc, char* argv[])
+{
+  PseudoUnitTest test;
+
+  f3d::log::setVerboseLevel(f3d::log::VerboseLevel::DEBUG);
+
+  // Only offscreen contexts that are not bound to a display connection can render concurrently
+  {
+    f3d::engine eng = f3d::engine::create(true);
+    f3d::window::Type type = eng.getWindow().getType();
+    if (type != f3d::window::Type::EGL && type != f3d::window::Type::OSMESA)
+    {
+      std::cout << "Concurrent rendering requires an EGL or OSMesa window, skipping" << std::endl;
+      return EXIT_SUCCESS;
+    }
+  }
+
+  constexpr size_t count = 4;
+  const std::string file = std::string(argv[1]) + "data/suzanne.ply";
+
+  // each thread creates, loads and renders its own engine, logging concurrently
+  std::vector<std::optional<f3d::image>> images(count);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < count; i++)
+  {
+    threads.emplace_back(
+      [&, i]()
+      {
+        try
+        {
+          f3d::engine eng = f3d::engine::create(true);
+          eng.getWindow().setSize(300, 300);
+          eng.getScene().add(file);
+          images[i] = eng.getWindow().renderToImage();
+        }
+        catch (const std::exception& ex)
+        {
+          f3d::log::error("Engine ", i, " failed: ", ex.what());
+        }
+      });
+  }
+
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+
+  for (size_t i = 0; i < count; i++)
+  {
+    test("engine " + std::to_string(i) + " rendered", images[i].has_value());
+  }
+
+  if (images[0])
+  {
+    test("image size", images[0]->getWidth() == 300 && images[0]->getHeight() == 300);
+    for (size_t i = 1; i < count; i++)
+    {
+      test("engine " + std::to_string(i) + " image is identical",
+        images[i].has_value() && *images[i] == *images[0]);
+    }
+  }
+
+  return test.result();
+}
@@ -169,6 +169,35 @@ int TestSDKOptions(int argc, char* argv[])
   opt2.copy(opt, "render.background.color");
   test("copy with vectors", opt2.render.background.color == std::vector<double>({ 0.1, 0.2, 0.7 }));
 
+  // Test getChangedNames
+  test("getChangedNames identical", opt.getChangedNames(opt2).empty());
+
+  opt2.render.line_width = 3.12;
+  opt2.scene.animation.time = 0.5;
+  test("getChangedNames", opt.getChangedNames(opt2) ==
+      std::vector<std::string>({ "render.line_width", "scene.animation.time" }));
+
+  opt2.copy(opt, "render.line_width");
+  opt2.removeValue("scene.animation.time");
+  test("getChangedNames after copy", opt.getChangedNames(opt2).empty());
+
+  // Test key
+  f3d::options::key<bool> showEdges = f3d::options::getKey<bool>("render.show_edges");
+  showEdges(opt) = true;
+  test("key set", opt.render.show_edges == true);
+  opt2.render.show_edges = false;
+  test("key get", showEdges(opt2) == false);
+
+  f3d::options::key<std::optional<double>> lineWidth =
+    f3d::options::getKey<std::optional<double>>("render.line_width");
+  test("key optional", lineWidth(opt).has_value() && lineWidth(opt).value() == 2.17);
+
+  test.expect<f3d::options::inexistent_exception>(
+    "inexistent_exception exception on getKey", [&]() { f3d::options::getKey<bool>("dummy"); });
+
+  test.expect<f3d::options::incompatible_exception>("incompatible_exception exception on getKey",
+    [&]() { f3d::options::getKey<double>("render.line_width"); });
+
   // Test isSame/copy error path
   test.expect<f3d::options::inexistent_exception>(
     "inexistent_exception exception on isSame", [&]() { opt.isSame(opt2, "dummy"); });
@@ -0,0 +1,45 @@
+#include "PseudoUnitTest.h"
+
+#include <engine.h>
+#include <image.h>
+#include <log.h>
+#include <options.h>
+#include <scene.h>
+#include <window.h>
+
+int TestSDKPrecompileShaders(int argc, char* argv[])
+{
+  PseudoUnitTest test;
+
+  f3d::log::setVerboseLevel(f3d::log::VerboseLevel::DEBUG);
+  const std::string file = std::string(argv[1]) + "data/suzanne.ply";
+
+  f3d::options opt;
+  opt.render.effect.tone_mapping = true;
+  opt.render.effect.anti_aliasing = true;
+
+  f3d::engine reference = f3d::engine::create(true);
+  reference.setOptions(opt);
+  reference.getWindow().setSize(300, 300);
+  reference.getScene().add(file);
+  f3d::image expected = reference.getWindow().renderToImage();
+
+  // precompiling must not change the rendering of the files added later
+  f3d::engine eng = f3d::engine::create(true);
+  eng.setOptions(opt);
+  eng.getWindow().setSize(300, 300);
+  eng.getScene().preload({ file }, 64);
+  eng.precompileShaders(opt);
+
+  test("options are restored", eng.getOptions().render.effect.tone_mapping);
+
+  eng.getScene().add(file);
+  f3d::image img = eng.getWindow().renderToImage();
+  test("image is identical to the one rendered without precompilation", img == expected);
+
+  // nothing to compile without a window
+  f3d::engine none = f3d::engine::createNone();
+  test("precompile without window", [&]() { none.precompileShaders(opt); });
+
+  return test.result();
+}
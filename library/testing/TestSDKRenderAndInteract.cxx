@@ -3,6 +3,8 @@
 #include <scene.h>
 #include <window.h>
 
+#include <iostream>
+
 int TestSDKRenderAndInteract(int argc, char* argv[])
 {
   // Order of allocation matter for VTK
@@ -18,8 +20,24 @@ int TestSDKRenderAndInteract(int argc, char* argv[])
   win.render();
 
   f3d::interactor& inter = eng.getInteractor();
+
+  // One shot timers are called once, unless removed before
+  int oneShotCalls = 0;
+  int removedCalls = 0;
+  inter.createOneShotTimerCallBack(10, [&oneShotCalls]() { oneShotCalls++; });
+  unsigned long removedId =
+    inter.createOneShotTimerCallBack(10, [&removedCalls]() { removedCalls++; });
+  inter.removeTimerCallBack(removedId);
+
   inter.createTimerCallBack(1000, [&inter]() { inter.stop(); });
   inter.start();
 
+  if (oneShotCalls != 1 || removedCalls != 0)
+  {
+    std::cerr << "Unexpected one shot timer calls: " << oneShotCalls << " " << removedCalls
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
   return EXIT_SUCCESS;
 }
@@ -0,0 +1,116 @@
+#include "PseudoUnitTest.h"
+
+#include <engine.h>
+#include <image.h>
+#include <options.h>
+#include <scene.h>
+#include <window.h>
+
+#include <string>
+
+int TestSDKRenderOptions(int argc, char* argv[])
+{
+  PseudoUnitTest test;
+
+  f3d::engine eng = f3d::engine::create(true);
+  f3d::window& win = eng.getWindow();
+  f3d::options& opt = eng.getOptions();
+  win.setSize(300, 300);
+
+  eng.getScene().add(std::string(argv[1]) + "/data/cow.vtp");
+  const f3d::image reference = win.renderToImage();
+
+  // the render options are compared to the default render instead of baselines
+  const auto similar = [&](const f3d::image& img)
+  {
+    double error;
+    return img.compare(reference, 0.05, error);
+  };
+
+  // Test eye-dome lighting
+  opt.setAsString("render.effect.eye_dome_lighting", "true");
+  test("eye_dome_lighting round-trip", opt.getAsString("render.effect.eye_dome_lighting"),
+    std::string("true"));
+  test("eye_dome_lighting shades the render", win.renderToImage() != reference);
+  opt.removeValue("render.effect.eye_dome_lighting");
+  test("eye_dome_lighting removed", similar(win.renderToImage()));
+
+  // Test weighted blended translucency, close to depth peeling
+  opt.model.color.opacity = 0.5;
+  opt.render.effect.translucency_support = true;
+  const f3d::image peeled = win.renderToImage();
+  opt.setAsString("render.effect.translucency_technique", "weighted_blended");
+  test("translucency_technique round-trip",
+    opt.getAsString("render.effect.translucency_technique"), std::string("weighted_blended"));
+  const f3d::image blended = win.renderToImage();
+  double error;
+  test("translucency_technique blends the render", blended != reference);
+  test("translucency_technique close to depth peeling", blended.compare(peeled, 0.5, error));
+  opt.reset("render.effect.translucency_technique");
+  opt.reset("render.effect.translucency_support");
+  opt.reset("model.color.opacity");
+  test("translucency_technique reset", similar(win.renderToImage()));
+
+  // Test the downsampled ambient occlusion, accumulated up to the full resolution one
+  opt.render.effect.ambient_occlusion = true;
+  const f3d::image occluded = win.renderToImage();
+  opt.setAsString("render.effect.ambient_occlusion_downsampling", "2");
+  test("ambient_occlusion_downsampling round-trip",
+    opt.getAsString("render.effect.ambient_occlusion_downsampling"), std::string("2"));
+  test("ambient_occlusion_downsampling close to full resolution",
+    win.renderToImage().compare(occluded, 0.5, error));
+  opt.reset("render.effect.ambient_occlusion_downsampling");
+  opt.reset("render.effect.ambient_occlusion");
+
+  // Test the progressive frames, accumulated into an anti-aliased render
+  opt.setAsString("render.effect.progressive_frames", "8");
+  test("progressive_frames round-trip", opt.getAsString("render.effect.progressive_frames"),
+    std::string("8"));
+  const f3d::image accumulated = win.renderToImage();
+  test("progressive_frames anti-aliases the render", accumulated != reference);
+  test("progressive_frames close to the default render",
+    accumulated.compare(reference, 0.5, error));
+  opt.reset("render.effect.progressive_frames");
+
+  // Test the dynamic resolution, only lowered while interacting
+  opt.setAsString("render.dynamic_resolution.enable", "true");
+  opt.setAsString("render.dynamic_resolution.frame_rate", "1000");
+  test("dynamic_resolution round-trip", opt.getAsString("render.dynamic_resolution.frame_rate"),
+    std::string("1000"));
+  test("dynamic_resolution keeps the still render", similar(win.renderToImage()));
+  opt.reset("render.dynamic_resolution.enable");
+  opt.reset("render.dynamic_resolution.frame_rate");
+
+  // Test the compact vertices, quantized but visually identical
+  opt.setAsString("render.compact_vertices", "true");
+  test("compact_vertices round-trip", opt.getAsString("render.compact_vertices"),
+    std::string("true"));
+  test("compact_vertices keeps the render", similar(win.renderToImage()));
+  opt.reset("render.compact_vertices");
+
+  // Test the GPU coloring, close to the CPU one
+  eng.getScene().clear().add(std::string(argv[1]) + "/data/dragon.vtu");
+  opt.model.scivis.enable = true;
+  const f3d::image cpuColored = win.renderToImage();
+  opt.setAsString("model.scivis.gpu_coloring", "true");
+  test("gpu_coloring round-trip", opt.getAsString("model.scivis.gpu_coloring"),
+    std::string("true"));
+  test("gpu_coloring close to the CPU coloring",
+    win.renderToImage().compare(cpuColored, 0.1, error));
+  opt.reset("model.scivis.gpu_coloring");
+  opt.reset("model.scivis.enable");
+
+  // Test the quantized volume textures, close to the native ones
+  eng.getScene().clear().add(std::string(argv[1]) + "/data/waveletArrays.vti");
+  opt.model.volume.enable = true;
+  const f3d::image nativeVolume = win.renderToImage();
+  opt.setAsString("model.volume.precision", "8bit");
+  test("volume precision round-trip", opt.getAsString("model.volume.precision"),
+    std::string("8bit"));
+  test("volume precision close to the native one",
+    win.renderToImage().compare(nativeVolume, 0.1, error));
+  opt.reset("model.volume.precision");
+  opt.reset("model.volume.enable");
+
+  return test.result();
+}
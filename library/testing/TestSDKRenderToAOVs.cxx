@@ -0,0 +1,58 @@
+#include "PseudoUnitTest.h"
+
+#include <engine.h>
+#include <image.h>
+#include <log.h>
+#include <scene.h>
+#include <window.h>
+
+#include <cmath>
+
+int TestSDKRenderToAOVs(int argc, char* argv[])
+{
+  PseudoUnitTest test;
+
+  f3d::log::setVerboseLevel(f3d::log::VerboseLevel::DEBUG);
+  f3d::engine eng = f3d::engine::create(true);
+  f3d::scene& sce = eng.getScene();
+  f3d::window& win = eng.getWindow().setSize(300, 200);
+
+  sce.add(std::string(argv[1]) + "data/suzanne.ply");
+
+  f3d::aovs_t aovs = win.renderToAOVs();
+  test("color is identical to a render", aovs.color == win.renderToImage());
+
+  test("depth format",
+    aovs.depth.getWidth() == 300 && aovs.depth.getHeight() == 200 &&
+      aovs.depth.getChannelCount() == 1 &&
+      aovs.depth.getChannelType() == f3d::image::ChannelType::FLOAT);
+  test("normal format",
+    aovs.normal.getChannelCount() == 3 &&
+      aovs.normal.getChannelType() == f3d::image::ChannelType::FLOAT);
+  test("index format",
+    aovs.index.getChannelCount() == 1 &&
+      aovs.index.getChannelType() == f3d::image::ChannelType::SHORT);
+
+  // the model is in the center of the view, the corners are the background
+  const float* depth = static_cast<const float*>(aovs.depth.getContent());
+  const float* normal = static_cast<const float*>(aovs.normal.getContent());
+  const unsigned short* index = static_cast<const unsigned short*>(aovs.index.getContent());
+  const size_t center = 100 * 300 + 150;
+
+  test("depth of the model", depth[center] > 0.f);
+  test("depth of the background", depth[0], 0.f);
+
+  float length = std::sqrt(normal[3 * center] * normal[3 * center] +
+    normal[3 * center + 1] * normal[3 * center + 1] +
+    normal[3 * center + 2] * normal[3 * center + 2]);
+  test("normal of the model is normalized", std::abs(length - 1.f) < 1e-3f);
+  test("normal of the model faces the camera", normal[3 * center + 2] > 0.f);
+
+  test("index of the model", index[center], static_cast<unsigned short>(1));
+  test("index of the background", index[0], static_cast<unsigned short>(0));
+
+  f3d::aovs_t transparent = win.renderToAOVs(true);
+  test("color without background", transparent.color.getChannelCount(), 4u);
+
+  return test.result();
+}
@@ -0,0 +1,47 @@
+#include "PseudoUnitTest.h"
+
+#include <engine.h>
+#include <image.h>
+#include <log.h>
+#include <scene.h>
+#include <window.h>
+
+#include <future>
+#include <vector>
+
+int TestSDKRenderToImageAsync(int argc, char* argv[])
+{
+  PseudoUnitTest test;
+
+  f3d::log::setVerboseLevel(f3d::log::VerboseLevel::DEBUG);
+  f3d::engine eng = f3d::engine::create(true);
+  f3d::scene& sce = eng.getScene();
+  f3d::window& win = eng.getWindow().setSize(300, 300);
+  f3d::camera& cam = win.getCamera();
+
+  sce.add(std::string(argv[1]) + "data/suzanne.ply");
+
+  // compare each asynchronous frame with its synchronous counterpart
+  // while several readbacks are in flight
+  std::vector<f3d::image> references;
+  std::vector<std::future<f3d::image>> futures;
+  for (int i = 0; i < 4; i++)
+  {
+    cam.azimuth(30);
+    references.emplace_back(win.renderToImage(i % 2 == 0));
+    futures.emplace_back(win.renderToImageAsync(i % 2 == 0));
+  }
+
+  for (size_t i = 0; i < futures.size(); i++)
+  {
+    f3d::image img = futures[i].get();
+    test("async image channel count", img.getChannelCount(), references[i].getChannelCount());
+    test("async image is identical to sync image", img == references[i]);
+  }
+
+  // readbacks are reused once their image has been recovered
+  f3d::image img = win.renderToImageAsync().get();
+  test("async image size", img.getWidth() == 300 && img.getHeight() == 300);
+
+  return test.result();
+}
@@ -0,0 +1,53 @@
+#include "PseudoUnitTest.h"
+
+#include <engine.h>
+#include <image.h>
+#include <log.h>
+#include <scene.h>
+#include <window.h>
+
+#include <algorithm>
+
+int TestSDKRenderToTiledImage(int argc, char* argv[])
+{
+  PseudoUnitTest test;
+
+  f3d::log::setVerboseLevel(f3d::log::VerboseLevel::DEBUG);
+  f3d::engine eng = f3d::engine::create(true);
+  f3d::scene& sce = eng.getScene();
+  f3d::window& win = eng.getWindow().setSize(300, 200);
+
+  sce.add(std::string(argv[1]) + "data/suzanne.ply");
+
+  f3d::image single = win.renderToTiledImage(1);
+  test("scale of 1 is a single render", single == win.renderToImage());
+
+  f3d::image tiled = win.renderToTiledImage(3);
+  test("tiled image size", tiled.getWidth() == 900 && tiled.getHeight() == 600);
+
+  // stitching the tiles is equivalent to rendering a larger window
+  win.setSize(900, 600);
+  f3d::image reference = win.renderToImage();
+  double error;
+  test("tiled image is close to a large render", tiled.compare(reference, 0.05, error));
+
+  f3d::image transparent = win.setSize(300, 200).renderToTiledImage(2, true);
+  test("tiled image without background", transparent.getChannelCount(), 4u);
+
+  // the bands stacked from the top form the tiled image, the rows start at the bottom
+  win.setSize(300, 200);
+  f3d::image top = win.renderToTiledImageBand(3, 0, 2);
+  f3d::image bottom = win.renderToTiledImageBand(3, 1, 2);
+  test("tiled image bands size",
+    top.getWidth() == 900 && top.getHeight() == 300 && bottom.getHeight() == 300);
+  f3d::image stacked(900, 600, top.getChannelCount());
+  const size_t bandSize = static_cast<size_t>(900) * 300 * top.getChannelCount();
+  unsigned char* stackedData = static_cast<unsigned char*>(stacked.getContent());
+  std::copy_n(static_cast<const unsigned char*>(bottom.getContent()), bandSize, stackedData);
+  std::copy_n(
+    static_cast<const unsigned char*>(top.getContent()), bandSize, stackedData + bandSize);
+  test("stacked bands are close to the tiled image", stacked.compare(tiled, 0.05, error));
+  test("band out of range is empty", win.renderToTiledImageBand(3, 2, 2).getWidth(), 0u);
+
+  return test.result();
+}
@@ -0,0 +1,69 @@
+#include "PseudoUnitTest.h"
+
+#include <engine.h>
+#include <image.h>
+#include <log.h>
+#include <scene.h>
+#include <window.h>
+
+#include <algorithm>
+#include <vector>
+
+int TestSDKRenderViews(int argc, char* argv[])
+{
+  PseudoUnitTest test;
+
+  f3d::log::setVerboseLevel(f3d::log::VerboseLevel::DEBUG);
+  f3d::engine eng = f3d::engine::create(true);
+  f3d::scene& sce = eng.getScene();
+  f3d::window& win = eng.getWindow().setSize(300, 200);
+  f3d::camera& cam = win.getCamera();
+
+  sce.add(std::string(argv[1]) + "data/suzanne.ply");
+  win.render();
+
+  // a turntable around the model, compared with renders of each view
+  const f3d::camera_state_t initialState = cam.getState();
+  std::vector<f3d::camera_state_t> views;
+  std::vector<f3d::image> references;
+  for (int i = 0; i < 5; i++)
+  {
+    cam.azimuth(72);
+    views.emplace_back(cam.getState());
+    references.emplace_back(win.renderToImage());
+  }
+  cam.setState(initialState);
+
+  std::vector<f3d::image> images = win.renderViews(views);
+  test("number of views", images.size(), views.size());
+  for (size_t i = 0; i < images.size(); i++)
+  {
+    test("view is identical to a single render", images[i] == references[i]);
+  }
+
+  f3d::camera_state_t state = cam.getState();
+  test("camera is restored", state.pos == initialState.pos && state.foc == initialState.foc);
+
+  f3d::image sheet = win.renderViewsToSpriteSheet(views, 3);
+  test("sprite sheet size", sheet.getWidth() == 900 && sheet.getHeight() == 400);
+  test("sprite sheet channel count", sheet.getChannelCount(), 3u);
+
+  // the first view is at the top left corner, the rows of the images start at the bottom
+  const unsigned char* sheetData = static_cast<const unsigned char*>(sheet.getContent());
+  const unsigned char* viewData = static_cast<const unsigned char*>(references[0].getContent());
+  bool same = true;
+  for (int row = 0; row < 200 && same; row++)
+  {
+    same = std::equal(viewData + row * 300 * 3, viewData + (row + 1) * 300 * 3,
+      sheetData + ((row + 200) * 900) * 3);
+  }
+  test("first view of the sprite sheet", same);
+
+  f3d::image transparent = win.renderViewsToSpriteSheet(views, 10, true);
+  test("sprite sheet columns are clamped", transparent.getWidth() == 1500);
+  test("sprite sheet without background", transparent.getChannelCount(), 4u);
+
+  test("no views", win.renderViewsToSpriteSheet({}, 2).getWidth(), 0u);
+
+  return test.result();
+}
@@ -57,6 +57,12 @@ int TestSDKScene(int argc, char* argv[])
   test("add with multiples filepaths", [&]() { sce.add({ fs::path(sphere2), fs::path(cube) }); });
   test("add with multiples file strings", [&]() { sce.add({ sphere1, world }); });
 
+  // reload code paths, reloaded files are rendered the same
+  test.expect<f3d::scene::load_failure_exception>(
+    "reload with a file not added", [&]() { sce.reload({ fs::path(nonExistent) }); });
+  test("reload with empty files", [&]() { sce.reload({}); });
+  test("reload with multiples filepaths", [&]() { sce.reload({ fs::path(logo), fs::path(cube) }); });
+
   // render test
   test("render after add", [&]() {
     if (!TestSDKHelpers::RenderTest(
@@ -0,0 +1,76 @@
+#include "PseudoUnitTest.h"
+
+#include <engine.h>
+#include <image.h>
+#include <interactor.h>
+#include <log.h>
+#include <options.h>
+#include <scene.h>
+#include <window.h>
+
+#include <string>
+
+int TestSDKSceneArraySelection(int argc, char* argv[])
+{
+  PseudoUnitTest test;
+
+  f3d::log::setVerboseLevel(f3d::log::VerboseLevel::DEBUG);
+  f3d::engine::loadPlugin("exodus", { argv[3] });
+
+  const std::string file = std::string(argv[1]) + "data/small.ex2";
+  constexpr double time = 0.003;
+
+  // only the colored array is read when animating, the cycled array must be read again
+  f3d::engine cycled = f3d::engine::create(true);
+  f3d::options& cycledOpt = cycled.getOptions();
+  f3d::scene& cycledScene = cycled.getScene();
+  f3d::window& cycledWin = cycled.getWindow();
+  cycledOpt.model.scivis.enable = true;
+  cycledScene.add(file);
+  cycledWin.render();
+  const std::string firstArray = cycledOpt.model.scivis.array_name;
+
+  cycledScene.loadAnimationTime(time / 2);
+  cycledWin.render();
+  cycledScene.loadAnimationTime(time);
+  cycledWin.render();
+  test("cycle coloring", cycled.getInteractor().triggerCommand("cycle_coloring array"));
+  const std::string cycledArray = cycledOpt.model.scivis.array_name;
+  test("cycled to another array", !cycledArray.empty() && cycledArray != firstArray);
+
+  cycledWin.render();
+  const f3d::point3_t cycledFocal = cycledWin.getCamera().resetToBounds().getFocalPoint();
+  f3d::image cycledImage = cycledWin.renderToImage();
+
+  // a reference reading all the arrays of the same time step, the arrays are only selected
+  // once rendered
+  f3d::engine reference = f3d::engine::create(true);
+  f3d::options& referenceOpt = reference.getOptions();
+  f3d::scene& referenceScene = reference.getScene();
+  f3d::window& referenceWin = reference.getWindow();
+  referenceOpt.model.scivis.enable = true;
+  referenceOpt.model.scivis.array_name = cycledArray;
+  referenceScene.add(file);
+  referenceScene.loadAnimationTime(time);
+  const f3d::point3_t referenceFocal = referenceWin.getCamera().resetToBounds().getFocalPoint();
+  f3d::image referenceImage = referenceWin.renderToImage();
+
+  double error;
+  test("cycled array values", cycledImage.compare(referenceImage, 0.05, error));
+
+  referenceOpt.model.scivis.enable = false;
+  f3d::image uncoloredImage = referenceWin.renderToImage();
+  test("cycled array is colored", !cycledImage.compare(uncoloredImage, 0.05, error));
+
+  // the displacement arrays are still read and applied with only the cycled array selected
+  test("displacements applied after cycling", cycledFocal == referenceFocal);
+
+  cycledScene.loadAnimationTime(0);
+  cycledWin.render();
+  cycledScene.loadAnimationTime(time);
+  cycledWin.render();
+  test("displacements applied after animating",
+    cycledWin.getCamera().resetToBounds().getFocalPoint() == referenceFocal);
+
+  return test.result();
+}
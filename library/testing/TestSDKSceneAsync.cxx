@@ -0,0 +1,95 @@
+#include "PseudoUnitTest.h"
+#include "TestSDKHelpers.h"
+
+#include <engine.h>
+#include <image.h>
+#include <log.h>
+#include <scene.h>
+#include <window.h>
+
+namespace fs = std::filesystem;
+
+int TestSDKSceneAsync(int argc, char* argv[])
+{
+  PseudoUnitTest test;
+
+  f3d::log::setVerboseLevel(f3d::log::VerboseLevel::DEBUG);
+  f3d::engine eng = f3d::engine::create(true);
+  f3d::scene& sce = eng.getScene();
+  f3d::window& win = eng.getWindow().setSize(300, 300);
+
+  std::string nonExistent = std::string(argv[1]) + "data/nonExistent.vtp";
+  std::string logo = std::string(argv[1]) + "data/mb/recursive/f3d.glb";
+  std::string cube = std::string(argv[1]) + "data/mb/recursive/mb_0_0.vtu";
+  std::string world = std::string(argv[1]) + "data/world.obj";
+
+  // addAsync error code paths
+  test.expect<f3d::scene::load_failure_exception>(
+    "addAsync with inexistent file", [&]() { sce.addAsync({ fs::path(nonExistent) }); });
+
+  // cancelled load does not modify the scene
+  std::shared_ptr<f3d::scene::load_handle> handle = sce.addAsync({ fs::path(world) });
+  handle->cancel();
+  test("wait after cancel", [&]() { handle->wait(); });
+  test("status after cancel",
+    handle->getStatus() == f3d::scene::load_handle::Status::CANCELLED);
+
+  f3d::image emptyImg = win.renderToImage();
+
+  // standard code path
+  handle = sce.addAsync({ fs::path(logo), fs::path(cube) });
+  test("wait after addAsync", [&]() { handle->wait(); });
+  test("status after wait", handle->getStatus() == f3d::scene::load_handle::Status::LOADED);
+  test("progress after wait", handle->getProgress() >= 0.0 && handle->getProgress() <= 1.0);
+  test("wait after load", [&]() { handle->wait(); });
+
+  f3d::image asyncImg = win.renderToImage();
+  test("render after addAsync is not empty", asyncImg != emptyImg);
+
+  // compare with a synchronous load
+  f3d::engine syncEng = f3d::engine::create(true);
+  syncEng.getWindow().setSize(300, 300);
+  syncEng.getScene().add({ fs::path(logo), fs::path(cube) });
+  f3d::image syncImg = syncEng.getWindow().renderToImage();
+  test("render after addAsync is identical to add", asyncImg == syncImg);
+
+  // preloaded files are used by add, even after a clear
+  test.expect<f3d::scene::load_failure_exception>(
+    "preload with inexistent file", [&]() { sce.preload({ fs::path(nonExistent) }, 512); });
+  sce.clear();
+  test("preload", [&]() { sce.preload({ fs::path(logo), fs::path(cube) }, 512); });
+  test("preload again", [&]() { sce.preload({ fs::path(logo), fs::path(cube) }, 512); });
+  test("preload with a null budget", [&]() { sce.preload({ fs::path(world) }, 0); });
+  sce.clear();
+  test("add after preload", [&]() { sce.add({ fs::path(logo), fs::path(cube) }); });
+  test("render after preload is identical to add", win.renderToImage() == syncImg);
+
+  // the current files are kept until they are replaced
+  handle = sce.replaceAsync({ fs::path(world) });
+  test("render while replacing is identical to add", win.renderToImage() == syncImg);
+  test("wait after replaceAsync", [&]() { handle->wait(); });
+  f3d::image replacedImg = win.renderToImage();
+  test("render after replaceAsync", replacedImg != syncImg && replacedImg != emptyImg);
+  test("replace", [&]() { sce.replace({ fs::path(logo), fs::path(cube) }); });
+  test("render after replace is identical to add", win.renderToImage() == syncImg);
+  test.expect<f3d::scene::load_failure_exception>(
+    "replace with inexistent file", [&]() { sce.replace({ fs::path(nonExistent) }); });
+  test("render after failed replace is identical to add", win.renderToImage() == syncImg);
+  test("replace without files", [&]() { sce.replace({}); });
+  test("render after replace without files is empty", win.renderToImage() == emptyImg);
+
+  // clear cancels a pending load
+  handle = sce.addAsync({ fs::path(world) });
+  sce.clear();
+  test("status after clear", handle->getStatus() == f3d::scene::load_handle::Status::CANCELLED);
+
+  // a pending load can outlive the scene
+  {
+    f3d::engine tmpEng = f3d::engine::create(true);
+    handle = tmpEng.getScene().addAsync({ fs::path(world) });
+  }
+  test("status after engine destruction",
+    handle->getStatus() == f3d::scene::load_handle::Status::CANCELLED);
+
+  return test.result();
+}
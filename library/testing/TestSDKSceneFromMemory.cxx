@@ -53,6 +53,63 @@ int TestSDKSceneFromMemory(int argc, char* argv[])
         { 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 1.f, 0.f, 0.f }, {}, { 1.f }, { 3 }, { 0, 1, 2, 4 } });
     });
 
+  // Add mesh with both faces and triangles
+  test.expect<f3d::scene::load_failure_exception>("add mesh with faces and triangles", [&]() {
+    f3d::mesh_t mesh{ { 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 1.f, 0.f, 0.f }, {}, {}, { 3 }, { 0, 1, 2 } };
+    mesh.triangle_indices = { 0, 1, 2 };
+    sce.add(mesh);
+  });
+
+  // Add mesh with invalid triangle indices
+  test.expect<f3d::scene::load_failure_exception>("add mesh with invalid triangle indices", [&]() {
+    f3d::mesh_t mesh{ { 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 1.f, 0.f, 0.f } };
+    mesh.triangle_indices_16 = { 0, 1 };
+    sce.add(mesh);
+  });
+
+  // Add mesh with invalid colors
+  test.expect<f3d::scene::load_failure_exception>("add mesh with invalid colors", [&]() {
+    f3d::mesh_t mesh{ { 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 1.f, 0.f, 0.f } };
+    mesh.colors = { 255, 0, 0, 255 };
+    sce.add(mesh);
+  });
+
+  // Add mesh with invalid cell data
+  test.expect<f3d::scene::load_failure_exception>("add mesh with invalid cell data", [&]() {
+    f3d::mesh_t mesh{ { 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 1.f, 0.f, 0.f } };
+    mesh.triangle_indices = { 0, 1, 2 };
+    mesh.cell_data = { { "pressure", 1, { 1.f, 2.f } } };
+    sce.add(mesh);
+  });
+
+  // Add mesh with unnamed point data
+  test.expect<f3d::scene::load_failure_exception>("add mesh with unnamed point data", [&]() {
+    f3d::mesh_t mesh{ { 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 1.f, 0.f, 0.f } };
+    mesh.point_data = { { "", 1, { 1.f, 2.f, 3.f } } };
+    sce.add(mesh);
+  });
+
+  // Add triangle meshes with colors and arrays, with 32-bit and 16-bit indices
+  test("add triangle mesh with arrays", [&]() {
+    f3d::mesh_t mesh{ { 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 1.f, 0.f, 0.f } };
+    mesh.triangle_indices = { 0, 1, 2 };
+    mesh.colors = { 255, 0, 0, 255, 0, 255, 0, 255, 0, 0, 255, 255 };
+    mesh.point_data = { { "temperature", 1, { 1.f, 2.f, 3.f } },
+      { "velocity", 3, { 1.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 1.f } } };
+    mesh.cell_data = { { "pressure", 1, { 1.f } } };
+    sce.add(mesh);
+
+    mesh.triangle_indices.clear();
+    mesh.triangle_indices_16 = { 0, 1, 2 };
+    sce.add(mesh);
+
+    eng.getOptions().model.scivis.enable = true;
+    eng.getOptions().model.scivis.array_name = "temperature";
+    win.render();
+    eng.getOptions().model.scivis.enable = false;
+    sce.clear();
+  });
+
   // Add mesh from memory and render it
   test("add mesh from memory", [&]() {
     sce.add(f3d::mesh_t{ { 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 1.f, 0.f, 0.f, 1.f, 1.f, 0.f },
@@ -69,5 +126,107 @@ int TestSDKSceneFromMemory(int argc, char* argv[])
     }
   });
 
+  // Add the same quad as one face, then with faces of different sizes overlapping it
+  test("render mesh with a quad face", [&]() {
+    sce.clear();
+    sce.add(f3d::mesh_t{ { 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 1.f, 0.f, 0.f, 1.f, 1.f, 0.f },
+      { 0.f, 0.f, -1.f, 0.f, 0.f, -1.f, 0.f, 0.f, -1.f, 0.f, 0.f, -1.f },
+      { 0.f, 0.f, 0.f, 1.f, 1.f, 0.f, 1.f, 1.f }, { 4 }, { 0, 1, 3, 2 } });
+    if (!TestSDKHelpers::RenderTest(
+          win, std::string(argv[1]) + "baselines/", argv[2], "TestSDKSceneFromMemory"))
+    {
+      throw "rendering test failed";
+    }
+  });
+
+  test("render mesh with faces of different sizes", [&]() {
+    sce.clear();
+    sce.add(f3d::mesh_t{ { 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 1.f, 0.f, 0.f, 1.f, 1.f, 0.f },
+      { 0.f, 0.f, -1.f, 0.f, 0.f, -1.f, 0.f, 0.f, -1.f, 0.f, 0.f, -1.f },
+      { 0.f, 0.f, 0.f, 1.f, 1.f, 0.f, 1.f, 1.f }, { 3, 4 }, { 0, 1, 2, 0, 1, 3, 2 } });
+    if (!TestSDKHelpers::RenderTest(
+          win, std::string(argv[1]) + "baselines/", argv[2], "TestSDKSceneFromMemory"))
+    {
+      throw "rendering test failed";
+    }
+  });
+
+  // Add the same mesh without copy
+  std::vector<float> points = { 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 1.f, 0.f, 0.f, 1.f, 1.f, 0.f };
+  std::vector<float> normals = { 0.f, 0.f, -1.f, 0.f, 0.f, -1.f, 0.f, 0.f, -1.f, 0.f, 0.f, -1.f };
+  std::vector<float> tcoords = { 0.f, 0.f, 0.f, 1.f, 1.f, 0.f, 1.f, 1.f };
+  std::vector<unsigned int> faceSides = { 3, 3 };
+  std::vector<unsigned int> faceIndices = { 0, 1, 2, 1, 3, 2 };
+  int deleterCalls = 0;
+  f3d::mesh_view_t view = { { points.data(), points.size() }, { normals.data(), normals.size() },
+    { tcoords.data(), tcoords.size() }, { faceSides.data(), faceSides.size() },
+    { faceIndices.data(), faceIndices.size() } };
+  view.deleter = [&]() { deleterCalls++; };
+
+  // Add mesh view with invalid vertex index
+  test.expect<f3d::scene::load_failure_exception>("add mesh view with invalid vertex index", [&]() {
+    f3d::mesh_view_t invalid = view;
+    invalid.face_indices.size = 5;
+    sce.add(invalid);
+  });
+  test("invalid mesh view deleter called", deleterCalls == 1);
+
+  test("add mesh view from memory", [&]() {
+    deleterCalls = 0;
+    sce.clear();
+    sce.add(view);
+  });
+  test("mesh view deleter not called while used", deleterCalls == 0);
+
+  test("render mesh view from memory", [&]() {
+    if (!TestSDKHelpers::RenderTest(
+          win, std::string(argv[1]) + "baselines/", argv[2], "TestSDKSceneFromMemory"))
+    {
+      throw "rendering test failed";
+    }
+  });
+
+  // Update the points of the mesh view with the same values
+  std::vector<float> updatedPoints = points;
+  int updateDeleterCalls = 0;
+  f3d::mesh_view_t update;
+  update.points = { updatedPoints.data(), updatedPoints.size() };
+  update.deleter = [&]() { updateDeleterCalls++; };
+
+  test.expect<f3d::scene::load_failure_exception>(
+    "update mesh with invalid index", [&]() { sce.updateMesh(1, update); });
+
+  test.expect<f3d::scene::load_failure_exception>("update mesh with invalid points", [&]() {
+    f3d::mesh_view_t invalid = update;
+    invalid.points.size = 3;
+    sce.updateMesh(0, invalid);
+  });
+
+  test.expect<f3d::scene::load_failure_exception>("update mesh faces", [&]() {
+    f3d::mesh_view_t invalid = update;
+    invalid.face_sides = { faceSides.data(), faceSides.size() };
+    sce.updateMesh(0, invalid);
+  });
+  test.expect<f3d::scene::load_failure_exception>("update mesh with invalid point data", [&]() {
+    f3d::mesh_view_t invalid = update;
+    invalid.point_data = { { "temperature", 1, { updatedPoints.data(), 3 } } };
+    sce.updateMesh(0, invalid);
+  });
+  test("invalid mesh update deleter called", updateDeleterCalls, 4);
+
+  test("update mesh points", [&]() {
+    updateDeleterCalls = 0;
+    sce.updateMesh(0, update);
+  });
+  test("mesh update deleter not called while used", updateDeleterCalls, 0);
+
+  test("render updated mesh", [&]() {
+    if (!TestSDKHelpers::RenderTest(
+          win, std::string(argv[1]) + "baselines/", argv[2], "TestSDKSceneFromMemory"))
+    {
+      throw "rendering test failed";
+    }
+  });
+
   return test.result();
 }
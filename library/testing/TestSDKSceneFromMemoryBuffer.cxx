@@ -0,0 +1,59 @@
+#include "PseudoUnitTest.h"
+
+#include <engine.h>
+#include <image.h>
+#include <log.h>
+#include <scene.h>
+#include <window.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+namespace
+{
+std::vector<std::byte> ReadFile(const std::string& filePath)
+{
+  std::ifstream file(filePath, std::ios::binary);
+  std::vector<char> content{ std::istreambuf_iterator<char>(file), {} };
+  std::vector<std::byte> buffer(content.size());
+  std::transform(content.begin(), content.end(), buffer.begin(),
+    [](char c) { return static_cast<std::byte>(c); });
+  return buffer;
+}
+}
+
+int TestSDKSceneFromMemoryBuffer(int argc, char* argv[])
+{
+  PseudoUnitTest test;
+
+  f3d::log::setVerboseLevel(f3d::log::VerboseLevel::DEBUG);
+  f3d::engine eng = f3d::engine::create(true);
+  f3d::scene& sce = eng.getScene();
+  f3d::window& win = eng.getWindow().setSize(300, 300);
+
+  const std::string dataDir = std::string(argv[1]) + "data/";
+
+  test.expect<f3d::scene::load_failure_exception>(
+    "add empty buffer", [&]() { sce.add(nullptr, 0, "ply"); });
+
+  std::vector<std::byte> ply = ::ReadFile(dataDir + "suzanne.ply");
+  test.expect<f3d::scene::load_failure_exception>(
+    "add buffer of unsupported format", [&]() { sce.add(ply.data(), ply.size(), "dummy"); });
+
+  // read from memory directly (ply, glb, splat) or through a temporary file (stl),
+  // the render must not depend on where the data comes from
+  for (const std::string& fileName : { "suzanne.ply", "f3d.glb", "small.splat", "suzanne.stl" })
+  {
+    sce.clear().add(dataDir + fileName);
+    f3d::image reference = win.renderToImage();
+
+    std::vector<std::byte> buffer = ::ReadFile(dataDir + fileName);
+    const std::string format = fileName.substr(fileName.find_last_of('.'));
+    sce.clear().add(buffer.data(), buffer.size(), format);
+    test("render of " + fileName + " from memory", win.renderToImage() == reference);
+  }
+
+  return test.result();
+}
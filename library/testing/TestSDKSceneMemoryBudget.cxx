@@ -0,0 +1,41 @@
+#include "PseudoUnitTest.h"
+
+#include <engine.h>
+#include <log.h>
+#include <options.h>
+#include <scene.h>
+
+int TestSDKSceneMemoryBudget(int argc, char* argv[])
+{
+  PseudoUnitTest test;
+
+  f3d::log::setVerboseLevel(f3d::log::VerboseLevel::DEBUG);
+  f3d::engine eng = f3d::engine::createNone();
+  f3d::scene& sce = eng.getScene();
+  f3d::options& opt = eng.getOptions();
+
+  std::string dragon = std::string(argv[1]) + "data/dragon.vtu";
+  std::string world = std::string(argv[1]) + "data/world.obj";
+
+  test("empty scene memory usage", sce.getMemoryUsage().cpu == 0 && sce.getMemoryUsage().gpu == 0);
+
+  sce.add(dragon);
+  f3d::scene::memory_usage_t dragonUsage = sce.getMemoryUsage();
+  test("geometry memory usage", dragonUsage.cpu > 0 && dragonUsage.gpu > 0);
+
+  // Textures are counted too
+  sce.add(world);
+  test("texture memory usage", sce.getMemoryUsage().cpu > dragonUsage.cpu);
+
+  // A scene exceeding the budget is rejected and the added files are removed
+  sce.clear();
+  opt.scene.memory_budget = 1;
+  test.expect<f3d::scene::load_failure_exception>(
+    "add exceeding the memory budget", [&]() { sce.add(dragon); });
+  test("rejected files are removed", sce.getMemoryUsage().cpu, static_cast<std::size_t>(0));
+
+  opt.scene.memory_budget = 0;
+  test("add without memory budget", [&]() { sce.add(dragon); });
+
+  return test.result();
+}
@@ -0,0 +1,59 @@
+#include "PseudoUnitTest.h"
+
+#include <engine.h>
+#include <log.h>
+#include <scene.h>
+
+#include <algorithm>
+#include <future>
+#include <vector>
+
+int TestSDKSceneQuery(int argc, char* argv[])
+{
+  PseudoUnitTest test;
+
+  f3d::log::setVerboseLevel(f3d::log::VerboseLevel::DEBUG);
+  f3d::engine::autoloadPlugins();
+
+  const std::string data = std::string(argv[1]) + "data/";
+
+  // a geometry reader
+  f3d::scene::info_t dragon = f3d::scene::query(data + "dragon.vtu");
+  test("geometry points", dragon.points > 0);
+  test("geometry cells", dragon.cells > 0);
+  test("geometry bounds", dragon.bounds[0] < dragon.bounds[1]);
+  test("geometry without animation", dragon.animations, static_cast<std::size_t>(0));
+  test("geometry arrays", !dragon.arrays.empty());
+  test("geometry array ranges",
+    std::all_of(dragon.arrays.begin(), dragon.arrays.end(),
+      [](const f3d::scene::info_t::array_t& array)
+      { return array.components > 0 && array.range.first <= array.range.second; }));
+
+  // a scene importer with an animation and cameras
+  f3d::scene::info_t box = f3d::scene::query(data + "BoxAnimated.gltf");
+  test("scene points", box.points > 0);
+  test("scene bounds", box.bounds[0] < box.bounds[1]);
+  test("scene animations", box.animations > 0);
+  test("scene animation time range", box.animationTimeRange.first < box.animationTimeRange.second);
+
+  f3d::scene::info_t cameras = f3d::scene::query(data + "Cameras.gltf");
+  test("scene cameras", !cameras.cameras.empty());
+
+  // queries can run in parallel
+  std::vector<std::future<f3d::scene::info_t>> queries;
+  for (int i = 0; i < 4; i++)
+  {
+    queries.emplace_back(
+      std::async(std::launch::async, [&]() { return f3d::scene::query(data + "dragon.vtu"); }));
+  }
+  test("parallel queries", std::all_of(queries.begin(), queries.end(),
+                             [&](std::future<f3d::scene::info_t>& query)
+                             { return query.get().points == dragon.points; }));
+
+  test.expect<f3d::scene::load_failure_exception>("query a non existent file",
+    [&]() { f3d::scene::query(data + "nonExistent.vtp"); });
+  test.expect<f3d::scene::load_failure_exception>("query an unsupported file",
+    [&]() { f3d::scene::query(data + "unsupportedFile.dummy"); });
+
+  return test.result();
+}
@@ -0,0 +1,41 @@
+#include "PseudoUnitTest.h"
+
+#include <engine.h>
+#include <log.h>
+#include <scene.h>
+
+#include <cmath>
+
+int TestSDKSceneSave(int argc, char* argv[])
+{
+  PseudoUnitTest test;
+
+  f3d::log::setVerboseLevel(f3d::log::VerboseLevel::DEBUG);
+  f3d::engine::autoloadPlugins();
+  f3d::engine eng = f3d::engine::createNone();
+  f3d::scene& sce = eng.getScene();
+
+  const std::string data = std::string(argv[1]) + "data/";
+  const std::string output = std::string(argv[2]) + "TestSDKSceneSave.glb";
+
+  // a textured glTF file is read back with the same geometry
+  sce.add(data + "WaterBottle.glb");
+  test("save a scene", [&]() { sce.save(output); });
+  f3d::scene::info_t original = f3d::scene::query(data + "WaterBottle.glb");
+  f3d::scene::info_t saved = f3d::scene::query(output);
+  test("saved points", saved.points, original.points);
+  test("saved bounds", std::abs(saved.bounds[1] - original.bounds[1]) < 1e-4);
+
+  // other files are converted too
+  sce.clear();
+  sce.add(data + "dragon.vtu");
+  test("save a converted file", [&]() { sce.save(output); });
+  test("saved converted file", f3d::scene::query(output).points > 0);
+
+  test.expect<f3d::scene::save_failure_exception>(
+    "save with an unsupported extension", [&]() { sce.save(std::string(argv[2]) + "scene.obj"); });
+  test.expect<f3d::scene::save_failure_exception>("save in a non existent directory",
+    [&]() { sce.save(std::string(argv[2]) + "nonExistent/scene.glb"); });
+
+  return test.result();
+}
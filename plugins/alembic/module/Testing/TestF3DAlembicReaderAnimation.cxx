@@ -0,0 +1,38 @@
+#include <vtkNew.h>
+#include <vtkPolyData.h>
+#include <vtkTestUtilities.h>
+
+#include "vtkF3DAlembicReader.h"
+
+#include <array>
+#include <iostream>
+
+int TestF3DAlembicReaderAnimation(int vtkNotUsed(argc), char* argv[])
+{
+  std::string filename = std::string(argv[1]) + "data/drop.abc";
+
+  // Read a first sample then another, the second one being updated from the first
+  vtkNew<vtkF3DAlembicReader> reader;
+  reader->SetFileName(filename);
+  reader->UpdateTimeStep(0.5);
+  reader->UpdateTimeStep(2.0);
+  std::array<double, 6> bounds;
+  reader->GetOutput()->GetBounds(bounds.data());
+
+  // Read the same sample directly
+  vtkNew<vtkF3DAlembicReader> referenceReader;
+  referenceReader->SetFileName(filename);
+  referenceReader->UpdateTimeStep(2.0);
+  std::array<double, 6> referenceBounds;
+  referenceReader->GetOutput()->GetBounds(referenceBounds.data());
+
+  if (reader->GetOutput()->GetNumberOfPoints() !=
+      referenceReader->GetOutput()->GetNumberOfPoints() ||
+    bounds != referenceBounds)
+  {
+    std::cerr << "Updated animated sample differs from the directly read sample" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -8,6 +8,8 @@
 #include <vtkObjectFactory.h>
 #include <vtkPointData.h>
 #include <vtkPoints.h>
+#include <vtkSMPThreadLocal.h>
+#include <vtkSMPTools.h>
 #include <vtkSmartPointer.h>
 #include <vtkStreamingDemandDrivenPipeline.h>
 
@@ -26,7 +28,6 @@
 
 using IndicesContainer = std::vector<int>;
 using V3fContainer = std::vector<Alembic::Abc::V3f>;
-using AttributesContainer = std::map<std::string, V3fContainer>;
 using PerFaceWavefrontIndicesTripletsContainer = std::vector<Alembic::Abc::V3i>;
 using PerMeshWavefrontIndicesTripletsContainer =
   std::vector<PerFaceWavefrontIndicesTripletsContainer>;
@@ -35,42 +36,74 @@ constexpr int pIndicesOffset = 0;
 constexpr int uvIndicesOffset = 1;
 constexpr int nIndicesOffset = 2;
 
+/**
+ * Attributes of a mesh being read, the containers are reused between the meshes read by a thread
+ * so clearing them keeps their memory
+ */
 struct IntermediateGeometry
 {
-  AttributesContainer Attributes;
+  V3fContainer Positions;
+  V3fContainer UVs;
+  V3fContainer Normals;
   PerMeshWavefrontIndicesTripletsContainer Indices;
+  bool HasPositions = false;
+  bool HasUVs = false;
+  bool HasNormals = false;
   bool uvFaceVarying = false;
   bool nFaceVarying = false;
+
+  void Clear()
+  {
+    this->Positions.clear();
+    this->UVs.clear();
+    this->Normals.clear();
+    this->HasPositions = this->HasUVs = this->HasNormals = false;
+    this->uvFaceVarying = this->nFaceVarying = false;
+  }
 };
 
 class vtkF3DAlembicReader::vtkInternals
 {
+  /**
+   * Temporary containers of a thread
+   */
+  struct ReadBuffers
+  {
+    IntermediateGeometry Original;
+    IntermediateGeometry Duplicated;
+    IndicesContainer FaceIndices;
+    std::vector<vtkIdType> CellIndices;
+  };
+
   void SetupIndicesStorage(const Alembic::AbcGeom::Int32ArraySamplePtr& faceVertexCounts,
     PerMeshWavefrontIndicesTripletsContainer& extractedIndices)
   {
+    // the faces already allocated by a previous mesh are reused
+    extractedIndices.resize(faceVertexCounts->size());
     for (size_t i = 0; i < faceVertexCounts->size(); i++)
     {
-      extractedIndices.emplace_back(faceVertexCounts->get()[i]);
+      extractedIndices[i].assign(faceVertexCounts->get()[i], Alembic::Abc::V3i());
     }
   }
 
   template<typename I>
   void UpdateIndices(const I& attributeIndices, int indicesOffset,
-    PerMeshWavefrontIndicesTripletsContainer& meshIndices, bool doReverseRotate = true)
+    PerMeshWavefrontIndicesTripletsContainer& meshIndices, IndicesContainer& thisFaceIndices,
+    bool doReverseRotate = true)
   {
     size_t faceIndicesCounter = 0;
     for (auto& perFaceIndices : meshIndices)
     {
       // Perform the collection first
       size_t thisFaceVertexCount = perFaceIndices.size();
-      IndicesContainer thisFaceIndices;
+      thisFaceIndices.clear();
       for (size_t j = 0; j < thisFaceVertexCount; j++)
       {
         auto vertex = attributeIndices->get()[faceIndicesCounter];
         thisFaceIndices.emplace_back(vertex);
         faceIndicesCounter++;
       }
-      if (doReverseRotate)
+      if (doReverseRotate && !thisFaceIndices.empty())
       {
         std::reverse(thisFaceIndices.begin(), thisFaceIndices.end());
         std::rotate(thisFaceIndices.begin(), thisFaceIndices.begin() + thisFaceIndices.size() - 1,
@@ -85,122 +118,92 @@ class vtkF3DAlembicReader::vtkInternals
     }
   }
 
-  void PointDuplicateAccumulator(
+  /**
+   * Duplicate the points of the face varying attributes.
+   * Return the geometry to convert, the original one when nothing is face varying.
+   */
+  const IntermediateGeometry& PointDuplicateAccumulator(
     const IntermediateGeometry& originalData, IntermediateGeometry& duplicatedData)
   {
+    if (!originalData.uvFaceVarying && !originalData.nFaceVarying)
+    {
+      return originalData;
+    }
+
+    duplicatedData.Clear();
     duplicatedData.uvFaceVarying = originalData.uvFaceVarying;
     duplicatedData.nFaceVarying = originalData.nFaceVarying;
-    bool needToDuplicate = originalData.uvFaceVarying || originalData.nFaceVarying;
-
-    auto uvMapIter = originalData.Attributes.find("uv");
-    auto nMapIter = originalData.Attributes.find("N");
-    bool haveUV = uvMapIter != originalData.Attributes.end();
-    bool haveN = nMapIter != originalData.Attributes.end();
-
-    if (needToDuplicate)
+    duplicatedData.HasPositions = originalData.HasPositions;
+    duplicatedData.HasUVs = originalData.HasUVs;
+    duplicatedData.HasNormals = originalData.HasNormals;
+
+    auto faceCount = originalData.Indices.size();
+    duplicatedData.Indices.resize(faceCount);
+    size_t vertexCount = 0;
+    for (size_t i = 0; i < faceCount; i++)
     {
-      auto faceCount = originalData.Indices.size();
-      duplicatedData.Indices.resize(faceCount);
-      for (size_t i = 0; i < faceCount; i++)
-      {
-        auto thisFaceVertexCount = originalData.Indices[i].size();
-        duplicatedData.Indices[i].resize(thisFaceVertexCount, Alembic::Abc::V3i());
-      }
-
-      // Points
-      {
-        V3fContainer pV3F;
-        int pRunningIndex = 0;
-        for (size_t i = 0; i < faceCount; i++)
-        {
-          auto thisFaceVertexCount = originalData.Indices[i].size();
-          for (size_t j = 0; j < thisFaceVertexCount; j++)
-          {
-            Alembic::Abc::V3f originalPosition =
-              originalData.Attributes.at("P")[originalData.Indices[i][j].x];
-            pV3F.emplace_back(originalPosition);
-            duplicatedData.Indices[i][j].x = pRunningIndex;
-            pRunningIndex++;
-          }
-        }
+      auto thisFaceVertexCount = originalData.Indices[i].size();
+      duplicatedData.Indices[i].assign(thisFaceVertexCount, Alembic::Abc::V3i());
+      vertexCount += thisFaceVertexCount;
+    }
 
-        duplicatedData.Attributes.insert(AttributesContainer::value_type("P", pV3F));
-      }
+    // Each face vertex gets its own point, and its own uv and normal
+    duplicatedData.Positions.reserve(vertexCount);
+    if (originalData.HasUVs)
+    {
+      duplicatedData.UVs.reserve(vertexCount);
+    }
+    if (originalData.HasNormals)
+    {
+      duplicatedData.Normals.reserve(vertexCount);
+    }
 
-      // UV
-      if (haveUV)
+    int runningIndex = 0;
+    for (size_t i = 0; i < faceCount; i++)
+    {
+      auto thisFaceVertexCount = originalData.Indices[i].size();
+      for (size_t j = 0; j < thisFaceVertexCount; j++)
       {
-        V3fContainer uvV3F;
-        int uvRunningIndex = 0;
-
-        for (size_t i = 0; i < faceCount; i++)
+        const Alembic::Abc::V3i& indices = originalData.Indices[i][j];
+        duplicatedData.Positions.emplace_back(originalData.Positions[indices.x]);
+        if (originalData.HasUVs)
         {
-          auto thisFaceVertexCount = originalData.Indices[i].size();
-          for (size_t j = 0; j < thisFaceVertexCount; j++)
-          {
-            Alembic::Abc::V3f originalUV =
-              originalData.Attributes.at("uv")[originalData.Indices[i][j].y];
-            uvV3F.emplace_back(originalUV);
-            duplicatedData.Indices[i][j].y = uvRunningIndex;
-            uvRunningIndex++;
-          }
+          duplicatedData.UVs.emplace_back(originalData.UVs[indices.y]);
         }
-
-        duplicatedData.Attributes.insert(AttributesContainer::value_type("uv", uvV3F));
-      }
-
-      // Normal
-      if (haveN)
-      {
-        V3fContainer nV3F;
-        int nRunningIndex = 0;
-
-        for (size_t i = 0; i < faceCount; i++)
+        if (originalData.HasNormals)
         {
-          auto thisFaceVertexCount = originalData.Indices[i].size();
-          for (size_t j = 0; j < thisFaceVertexCount; j++)
-          {
-            Alembic::Abc::V3f originalN =
-              originalData.Attributes.at("N")[originalData.Indices[i][j].z];
-            nV3F.emplace_back(originalN);
-            duplicatedData.Indices[i][j].z = nRunningIndex;
-            nRunningIndex++;
-          }
+          duplicatedData.Normals.emplace_back(originalData.Normals[indices.z]);
         }
-
-        duplicatedData.Attributes.insert(AttributesContainer::value_type("N", nV3F));
+        duplicatedData.Indices[i][j] = Alembic::Abc::V3i(runningIndex, runningIndex, runningIndex);
+        runningIndex++;
       }
     }
-    else
-    {
-      duplicatedData = originalData;
-    }
+
+    return duplicatedData;
   }
 
-  void FillPolyData(const IntermediateGeometry& data, vtkPolyData* polydata)
+  void FillPolyData(
+    const IntermediateGeometry& data, std::vector<vtkIdType>& indexArr, vtkPolyData* polydata)
   {
-    vtkNew<vtkPoints> points;
-    vtkNew<vtkCellArray> cells;
-
-    auto pMapIter = data.Attributes.find("P");
-    if (pMapIter == data.Attributes.end())
+    if (!data.HasPositions)
     {
       // Not a geometry, silent return
       return;
     }
 
-    // Note : uv and N are optional
-    auto uvMapIter = data.Attributes.find("uv");
-    auto nMapIter = data.Attributes.find("N");
-    bool haveUV = uvMapIter != data.Attributes.end();
-    bool haveN = nMapIter != data.Attributes.end();
-    for (auto& pIter : pMapIter->second)
+    vtkNew<vtkPoints> points;
+    points->SetDataTypeToFloat();
+    points->SetNumberOfPoints(static_cast<vtkIdType>(data.Positions.size()));
+    for (size_t i = 0; i < data.Positions.size(); i++)
     {
-      points->InsertNextPoint(pIter.x, pIter.y, pIter.z);
+      const Alembic::Abc::V3f& p = data.Positions[i];
+      points->SetPoint(static_cast<vtkIdType>(i), p.x, p.y, p.z);
     }
     polydata->SetPoints(points);
 
-    std::vector<vtkIdType> indexArr;
+    vtkNew<vtkCellArray> cells;
+    cells->AllocateExact(static_cast<vtkIdType>(data.Indices.size()),
+      static_cast<vtkIdType>(data.Positions.size()));
     for (auto& faceIndicesIter : data.Indices)
     {
       indexArr.clear();
@@ -213,43 +216,178 @@ class vtkF3DAlembicReader::vtkInternals
     polydata->SetPolys(cells);
     vtkDataSetAttributes* pointAttributes = polydata->GetAttributes(vtkDataSet::POINT);
 
-    if (haveN)
+    // Note : uv and N are optional
+    if (data.HasNormals)
     {
       vtkNew<vtkFloatArray> normals;
       normals->SetName("Normals");
       normals->SetNumberOfComponents(3);
-      for (auto& N : nMapIter->second)
+      normals->SetNumberOfTuples(static_cast<vtkIdType>(data.Normals.size()));
+      for (size_t i = 0; i < data.Normals.size(); i++)
       {
-        normals->InsertNextTuple3(N.x, N.y, N.z);
+        const Alembic::Abc::V3f& N = data.Normals[i];
+        normals->SetTypedTuple(static_cast<vtkIdType>(i), &N.x);
       }
       pointAttributes->SetNormals(normals);
     }
 
-    if (haveUV)
+    if (data.HasUVs)
     {
       vtkNew<vtkFloatArray> uvs;
       uvs->SetName("UVs");
       uvs->SetNumberOfComponents(2);
-      for (auto& uv : uvMapIter->second)
+      uvs->SetNumberOfTuples(static_cast<vtkIdType>(data.UVs.size()));
+      for (size_t i = 0; i < data.UVs.size(); i++)
       {
-        uvs->InsertNextTuple2(uv.x, uv.y);
+        uvs->SetTypedTuple(static_cast<vtkIdType>(i), &data.UVs[i].x);
       }
       pointAttributes->SetTCoords(uvs);
     }
   }
 
+  /**
+   * Data kept between time values for each mesh, so that meshes with a constant topology
+   * only have their animated arrays read again
+   */
+  struct MeshCache
+  {
+    Alembic::AbcCoreAbstract::index_t SampleIndex = -1;
+    vtkSmartPointer<vtkPolyData> PolyData;
+    PerMeshWavefrontIndicesTripletsContainer Indices;
+    std::vector<int> PointMap; // source position of each point, empty if not duplicated
+    size_t NbPositions = 0;
+    bool Duplicated = false;
+    bool NormalsFaceVarying = false;
+  };
+
+  /**
+   * Read only the positions and normals of the sample into the existing arrays.
+   * Return false if the arrays cannot be updated in place, the mesh must then be read again.
+   */
+  bool UpdateAnimatedArrays(const Alembic::AbcGeom::IPolyMeshSchema& schema,
+    const Alembic::AbcGeom::ISampleSelector& selector, MeshCache& cache, ReadBuffers& buffers)
+  {
+    // Texture coordinates are expected to be constant with the topology
+    Alembic::AbcGeom::IV2fGeomParam uvsParam = schema.getUVsParam();
+    if (uvsParam.valid() && !uvsParam.isConstant())
+    {
+      return false;
+    }
+
+    vtkPoints* points = cache.PolyData->GetPoints();
+    Alembic::AbcGeom::P3fArraySamplePtr positions =
+      schema.getPositionsProperty().getValue(selector);
+    if (!points || !positions || positions->size() != cache.NbPositions)
+    {
+      return false;
+    }
+
+    // Positions
+    const vtkIdType nbPoints = points->GetNumberOfPoints();
+    for (vtkIdType k = 0; k < nbPoints; k++)
+    {
+      const Alembic::Abc::V3f& p =
+        positions->get()[cache.Duplicated ? cache.PointMap[k] : static_cast<int>(k)];
+      points->SetPoint(k, p.x, p.y, p.z);
+    }
+    points->Modified();
+
+    // Normals
+    Alembic::AbcGeom::IN3fGeomParam normalsParam = schema.getNormalsParam();
+    if (normalsParam.valid() && !normalsParam.isConstant())
+    {
+      vtkDataArray* normals = cache.PolyData->GetPointData()->GetNormals();
+      Alembic::AbcGeom::IN3fGeomParam::Sample normalValue = normalsParam.getIndexedValue(selector);
+      bool faceVarying = normalsParam.getScope() == Alembic::AbcGeom::kFacevaryingScope;
+      if (!normals || !normalValue.valid() || faceVarying != cache.NormalsFaceVarying)
+      {
+        return false;
+      }
+
+      // Face varying normals indices may be different for each sample
+      if (faceVarying)
+      {
+        this->UpdateIndices<Alembic::AbcGeom::UInt32ArraySamplePtr>(
+          normalValue.getIndices(), nIndicesOffset, cache.Indices, buffers.FaceIndices);
+      }
+
+      Alembic::AbcGeom::N3fArraySamplePtr vals = normalValue.getVals();
+      const auto setNormal = [&](vtkIdType k, size_t index)
+      {
+        if (index >= vals->size() || k >= normals->GetNumberOfTuples())
+        {
+          return false;
+        }
+        const Alembic::AbcGeom::V3f& n = vals->get()[index];
+        normals->SetTuple3(k, n.x, n.y, n.z);
+        return true;
+      };
+
+      vtkIdType k = 0;
+      if (cache.Duplicated)
+      {
+        for (const auto& perFaceIndices : cache.Indices)
+        {
+          for (const auto& indices : perFaceIndices)
+          {
+            if (!setNormal(k++, indices.z))
+            {
+              return false;
+            }
+          }
+        }
+      }
+      else
+      {
+        for (; k < static_cast<vtkIdType>(vals->size()); k++)
+        {
+          if (!setNormal(k, k))
+          {
+            return false;
+          }
+        }
+      }
+      normals->Modified();
+    }
+
+    return true;
+  }
+
 public:
-  vtkSmartPointer<vtkPolyData> ProcessIPolyMesh(
-    const Alembic::AbcGeom::IPolyMesh& pmesh, double time)
+  /**
+   * Read the mesh at the given time, or update its cached polydata.
+   * Meshes with different caches can be processed concurrently, each thread with its buffers.
+   */
+  vtkSmartPointer<vtkPolyData> ProcessIPolyMesh(const Alembic::AbcGeom::IPolyMesh& pmesh,
+    double time, MeshCache& cache, ReadBuffers& buffers)
   {
     vtkNew<vtkPolyData> polydata;
-    IntermediateGeometry originalData;
+    IntermediateGeometry& originalData = buffers.Original;
+    originalData.Clear();
 
     Alembic::AbcGeom::IPolyMeshSchema::Sample samp;
     const Alembic::AbcGeom::IPolyMeshSchema& schema = pmesh.getSchema();
     if (schema.getNumSamples() > 0)
     {
       Alembic::AbcGeom::ISampleSelector selector(time);
+
+      // The sample index is computed from the time sampling without reading anything,
+      // scrubbing on the same sample does not read the mesh again
+      Alembic::AbcCoreAbstract::index_t sampleIndex =
+        selector.getIndex(schema.getTimeSampling(), schema.getNumSamples());
+      if (cache.PolyData && sampleIndex == cache.SampleIndex)
+      {
+        return cache.PolyData;
+      }
+      if (cache.PolyData &&
+        schema.getTopologyVariance() != Alembic::AbcGeom::kHeterogenousTopology &&
+        this->UpdateAnimatedArrays(schema, selector, cache, buffers))
+      {
+        cache.SampleIndex = sampleIndex;
+        return cache.PolyData;
+      }
+
+      cache.SampleIndex = sampleIndex;
       schema.get(samp, selector);
 
       Alembic::AbcGeom::P3fArraySamplePtr positions = samp.getPositions();
@@ -260,16 +398,11 @@ public:
 
       // Positions
       {
-        V3fContainer pV3F;
-        for (size_t pIndex = 0; pIndex < positions->size(); pIndex++)
-        {
-          pV3F.emplace_back(
-            positions->get()[pIndex].x, positions->get()[pIndex].y, positions->get()[pIndex].z);
-        }
-        originalData.Attributes.insert(AttributesContainer::value_type("P", pV3F));
+        originalData.Positions.assign(positions->get(), positions->get() + positions->size());
+        originalData.HasPositions = true;
 
         this->UpdateIndices<Alembic::AbcGeom::Int32ArraySamplePtr>(
-          facePositionIndices, pIndicesOffset, originalData.Indices);
+          facePositionIndices, pIndicesOffset, originalData.Indices, buffers.FaceIndices);
       }
 
       // Texture coordinate
@@ -279,25 +412,25 @@ public:
         Alembic::AbcGeom::IV2fGeomParam::Sample uvValue = uvsParam.getIndexedValue(selector);
         if (uvValue.valid())
         {
-          V3fContainer uvV3F;
           Alembic::AbcGeom::UInt32ArraySamplePtr uvIndices = uvValue.getIndices();
+          originalData.UVs.reserve(uvValue.getVals()->size());
           for (size_t index = 0; index < uvValue.getVals()->size(); ++index)
           {
             Alembic::AbcGeom::V2f uv = (*(uvValue.getVals()))[index];
-            uvV3F.emplace_back(uv[0], uv[1], 0);
+            originalData.UVs.emplace_back(uv[0], uv[1], 0);
           }
-          originalData.Attributes.insert(AttributesContainer::value_type("uv", uvV3F));
+          originalData.HasUVs = true;
 
           if (uvsParam.getScope() == Alembic::AbcGeom::kFacevaryingScope)
           {
             originalData.uvFaceVarying = true;
             this->UpdateIndices<Alembic::AbcGeom::UInt32ArraySamplePtr>(
-              uvIndices, uvIndicesOffset, originalData.Indices);
+              uvIndices, uvIndicesOffset, originalData.Indices, buffers.FaceIndices);
           }
           else
           {
             this->UpdateIndices<Alembic::AbcGeom::Int32ArraySamplePtr>(
-              facePositionIndices, uvIndicesOffset, originalData.Indices);
+              facePositionIndices, uvIndicesOffset, originalData.Indices, buffers.FaceIndices);
           }
         }
       }
@@ -310,36 +443,49 @@ public:
           normalsParam.getIndexedValue(selector);
         if (normalValue.valid())
         {
-          V3fContainer normal_v3f;
           Alembic::AbcGeom::UInt32ArraySamplePtr normalIndices = normalValue.getIndices();
-          for (size_t index = 0; index < normalValue.getVals()->size(); ++index)
-          {
-            Alembic::AbcGeom::V3f normal = (*(normalValue.getVals()))[index];
-            normal_v3f.emplace_back(normal[0], normal[1], normal[2]);
-          }
-          originalData.Attributes.insert(AttributesContainer::value_type("N", normal_v3f));
+          Alembic::AbcGeom::N3fArraySamplePtr normals = normalValue.getVals();
+          originalData.Normals.assign(normals->get(), normals->get() + normals->size());
+          originalData.HasNormals = true;
 
           if (normalsParam.getScope() == Alembic::AbcGeom::kFacevaryingScope)
           {
             originalData.nFaceVarying = true;
 
             this->UpdateIndices<Alembic::AbcGeom::UInt32ArraySamplePtr>(
-              normalIndices, nIndicesOffset, originalData.Indices);
+              normalIndices, nIndicesOffset, originalData.Indices, buffers.FaceIndices);
           }
           else
           {
             this->UpdateIndices<Alembic::AbcGeom::Int32ArraySamplePtr>(
-              facePositionIndices, nIndicesOffset, originalData.Indices);
+              facePositionIndices, nIndicesOffset, originalData.Indices, buffers.FaceIndices);
           }
         }
       }
     }
 
-    IntermediateGeometry duplicatedData;
+    const IntermediateGeometry& geometry =
+      this->PointDuplicateAccumulator(originalData, buffers.Duplicated);
 
-    this->PointDuplicateAccumulator(originalData, duplicatedData);
+    this->FillPolyData(geometry, buffers.CellIndices, polydata);
 
-    this->FillPolyData(duplicatedData, polydata);
+    // Keep what is needed to update the animated arrays at another time value
+    cache.PolyData = polydata;
+    cache.NbPositions = originalData.Positions.size();
+    cache.Duplicated = originalData.uvFaceVarying || originalData.nFaceVarying;
+    cache.NormalsFaceVarying = originalData.nFaceVarying;
+    cache.PointMap.clear();
+    if (cache.Duplicated)
+    {
+      for (const auto& perFaceIndices : originalData.Indices)
+      {
+        for (const auto& indices : perFaceIndices)
+        {
+          cache.PointMap.emplace_back(indices.x);
+        }
+      }
+    }
+    cache.Indices = originalData.Indices;
 
     return polydata;
   }
@@ -373,17 +519,32 @@ public:
     }
   }
 
-  void ImportRoot(vtkAppendPolyData* append, double time)
+  void ImportRoot(std::vector<vtkSmartPointer<vtkPolyData>>& meshes, double time)
   {
     Alembic::Abc::IObject top = this->Archive.getTop();
 
-    auto appendMesh = [&](const Alembic::AbcGeom::IPolyMesh& polymesh)
-    { append->AddInputData(ProcessIPolyMesh(polymesh, time)); };
+    // The hierarchy is traversed first, the caches are created before the concurrent reads
+    std::vector<std::pair<Alembic::AbcGeom::IPolyMesh, MeshCache*>> polymeshes;
+    auto collectMesh = [&](const Alembic::AbcGeom::IPolyMesh& polymesh)
+    { polymeshes.emplace_back(polymesh, &this->MeshCaches[polymesh.getFullName()]); };
 
     for (size_t i = 0; i < top.getNumChildren(); ++i)
     {
-      this->IterateIObject(appendMesh, top, top.getChildHeader(i));
+      this->IterateIObject(collectMesh, top, top.getChildHeader(i));
     }
+
+    // Each object is read from its own Ogawa stream, and converted in parallel
+    meshes.resize(polymeshes.size());
+    vtkSMPTools::For(0, static_cast<vtkIdType>(polymeshes.size()), 1,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        ReadBuffers& buffers = this->Buffers.Local();
+        for (vtkIdType i = begin; i < end; i++)
+        {
+          meshes[i] =
+            this->ProcessIPolyMesh(polymeshes[i].first, time, *polymeshes[i].second, buffers);
+        }
+      });
   }
 
   void ExtendTimeRange(double& start, double& end)
@@ -421,9 +582,16 @@ public:
     Alembic::AbcCoreFactory::IFactory factory;
     Alembic::AbcCoreFactory::IFactory::CoreType coreType;
 
+    // Several streams let the threads read different objects concurrently
+    factory.setOgawaNumStreams(
+      static_cast<size_t>(std::max(1, vtkSMPTools::GetEstimatedNumberOfThreads())));
+
     this->Archive = factory.getArchive(filePath, coreType);
+    this->MeshCaches.clear();
   }
   Alembic::Abc::IArchive Archive;
+  std::map<std::string, MeshCache> MeshCaches;
+  vtkSMPThreadLocal<ReadBuffers> Buffers;
 };
 
 vtkStandardNewMacro(vtkF3DAlembicReader);
@@ -472,8 +640,21 @@ int vtkF3DAlembicReader::RequestData(
     requestedTimeValue = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP());
   }
 
+  std::vector<vtkSmartPointer<vtkPolyData>> meshes;
+  this->Internals->ImportRoot(meshes, requestedTimeValue);
+
+  // Avoid copying all the arrays when there is a single mesh
+  if (meshes.size() == 1)
+  {
+    output->ShallowCopy(meshes[0]);
+    return 1;
+  }
+
   vtkNew<vtkAppendPolyData> append;
-  this->Internals->ImportRoot(append, requestedTimeValue);
+  for (const vtkSmartPointer<vtkPolyData>& mesh : meshes)
+  {
+    append->AddInputData(mesh);
+  }
   append->Update();
 
   output->ShallowCopy(append->GetOutput());
@@ -6,6 +6,8 @@
  * Currently, only polygonal points positions are retrieved
  * to build polygonal geometries. Vertex normals and texture
  * coordinates are not supported yet.
+ * The archive is opened with an Ogawa stream per thread, and the meshes are read and converted
+ * in parallel with vtkSMPTools before being appended.
  *
  * @sa https://github.com/alembic/alembic/blob/master/README.txt
  *
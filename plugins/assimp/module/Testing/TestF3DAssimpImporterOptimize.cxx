@@ -0,0 +1,62 @@
+#include <vtkActor.h>
+#include <vtkActorCollection.h>
+#include <vtkDataSet.h>
+#include <vtkMapper.h>
+#include <vtkNew.h>
+#include <vtkRenderer.h>
+#include <vtkTestUtilities.h>
+
+#include "vtkF3DAssimpImporter.h"
+
+#include <iostream>
+
+namespace
+{
+vtkIdType CountPoints(vtkF3DAssimpImporter* importer)
+{
+  vtkIdType nbPoints = 0;
+  vtkActorCollection* actors = importer->GetRenderer()->GetActors();
+  actors->InitTraversal();
+  while (vtkActor* actor = actors->GetNextActor())
+  {
+    if (actor->GetMapper() && actor->GetMapper()->GetInput())
+    {
+      nbPoints += actor->GetMapper()->GetInput()->GetNumberOfPoints();
+    }
+  }
+  return nbPoints;
+}
+}
+
+int TestF3DAssimpImporterOptimize(int vtkNotUsed(argc), char* argv[])
+{
+  std::string filename = std::string(argv[1]) + "data/animatedWorld.fbx";
+
+  vtkNew<vtkF3DAssimpImporter> importer;
+  importer->SetFileName(filename);
+  importer->Update();
+
+  vtkNew<vtkF3DAssimpImporter> optimizedImporter;
+  optimizedImporter->SetFileName(filename);
+  optimizedImporter->SetOptimizeGeometry(true);
+  optimizedImporter->Update();
+  optimizedImporter->Print(cout);
+
+  vtkIdType nbPoints = ::CountPoints(importer);
+  vtkIdType nbOptimizedPoints = ::CountPoints(optimizedImporter);
+  if (nbOptimizedPoints == 0 || nbOptimizedPoints > nbPoints)
+  {
+    std::cerr << "Unexpected number of points after optimization: " << nbOptimizedPoints
+              << " instead of at most " << nbPoints << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // the nodes are not modified by the optimization
+  if (optimizedImporter->GetNumberOfAnimations() != importer->GetNumberOfAnimations())
+  {
+    std::cerr << "The animations are modified by the optimization" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -1,4 +1,6 @@
 #include "vtkF3DAssimpImporter.h"
+#include "vtkF3DScratchArena.h"
+#include "vtkF3DTextureCache.h"
 
 #include <vtkActor.h>
 #include <vtkActorCollection.h>
@@ -19,6 +21,7 @@
 #include <vtkProperty.h>
 #include <vtkQuaternion.h>
 #include <vtkRenderer.h>
+#include <vtkSMPTools.h>
 #include <vtkShaderProperty.h>
 #include <vtkSmartPointer.h>
 #include <vtkStringArray.h>
@@ -32,14 +35,56 @@
 
 #include <assimp/Exceptional.h>
 #include <assimp/Importer.hpp>
+#include <assimp/ProgressHandler.hpp>
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <functional>
+#include <map>
 #include <memory>
 #include <regex>
+#include <string_view>
+#include <vector>
 
 vtkStandardNewMacro(vtkF3DAssimpImporter);
 
+namespace
+{
+//----------------------------------------------------------------------------
+size_t GetEmbeddedTextureSize(const aiTexture* aTexture)
+{
+  // compressed textures store their size in bytes in the width
+  return aTexture->mHeight == 0
+    ? aTexture->mWidth
+    : static_cast<size_t>(aTexture->mWidth) * aTexture->mHeight * sizeof(aiTexel);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * Stop the read of Assimp, which checks the handler at each step of the import,
+ * once the importer is cancelled
+ */
+class CancellationHandler : public Assimp::ProgressHandler
+{
+public:
+  explicit CancellationHandler(const vtkF3DImporter* importer)
+    : Importer(importer)
+  {
+  }
+
+  bool Update(float) override
+  {
+    return !this->Importer->IsCancelled();
+  }
+
+private:
+  const vtkF3DImporter* Importer;
+};
+}
+
 class vtkF3DAssimpImporter::vtkInternals
 {
 public:
@@ -162,121 +207,225 @@ public:
 
   //----------------------------------------------------------------------------
   /**
-   * Generate a VTK texture from a file path
+   * Find the embedded texture referenced by a material, nullptr if the texture is a file
    */
-  vtkSmartPointer<vtkTexture> CreateTexture(const char* path, bool sRGB = false)
+  const aiTexture* FindEmbeddedTexture(const char* path)
   {
-    vtkSmartPointer<vtkTexture> vTexture;
-
     if (path[0] == '*')
     {
       int texIndex = std::atoi(path + 1);
-
-      if (texIndex >= 0 && texIndex < static_cast<int>(this->EmbeddedTextures.size()))
+      if (texIndex >= 0 && texIndex < static_cast<int>(this->Scene->mNumTextures))
       {
-        vTexture = this->EmbeddedTextures[texIndex];
+        return this->Scene->mTextures[texIndex];
       }
     }
 
-    if (!vTexture)
+    // sometimes, embedded textures are indexed by filename
+    return this->Scene->GetEmbeddedTexture(path);
+  }
+
+  //----------------------------------------------------------------------------
+  /**
+   * Find the file of a texture referenced by a material, empty if it does not exist
+   */
+  std::string FindTextureFile(const char* path)
+  {
+    std::string dir = vtksys::SystemTools::GetParentDirectory(this->Parent->GetFileName());
+    std::string texturePath = vtksys::SystemTools::CollapseFullPath(path, dir);
+
+    // try to get the texture in the same dir as the model file
+    if (!vtksys::SystemTools::FileExists(texturePath))
     {
-      // sometimes, embedded textures are indexed by filename
-      const aiTexture* aTexture = this->Scene->GetEmbeddedTexture(path);
+      std::string fileName = vtksys::SystemTools::GetFilenameName(path);
+      texturePath = vtksys::SystemTools::CollapseFullPath(fileName, dir);
+    }
 
-      if (aTexture)
-      {
-        vTexture = this->CreateEmbeddedTexture(aTexture);
-      }
-      else
-      {
-        std::string dir = vtksys::SystemTools::GetParentDirectory(this->Parent->GetFileName());
-        std::string texturePath = vtksys::SystemTools::CollapseFullPath(path, dir);
+    if (!vtksys::SystemTools::FileExists(texturePath))
+    {
+      vtkWarningWithObjectMacro(this->Parent, "Cannot find texture: " << texturePath);
+      return {};
+    }
+    return texturePath;
+  }
 
-        // try to get the texture in the same dir as the model file
-        if (!vtksys::SystemTools::FileExists(texturePath))
+  //----------------------------------------------------------------------------
+  /**
+   * Decode the images of all the textures referenced by the materials.
+   * An image referenced by several materials, or embedded several times, is decoded once,
+   * and the images are decoded concurrently.
+   * The images of texture files are shared with the other importers, see vtkF3DTextureCache.
+   */
+  void DecodeTextureImages()
+  {
+    struct TextureImage
+    {
+      vtkSmartPointer<vtkImageReader2> Reader;
+      vtkSmartPointer<vtkImageData> Image;
+      const aiTexture* Embedded = nullptr;
+      std::string CacheKey;
+    };
+    std::vector<TextureImage> images;
+    std::map<std::string, size_t> imageIndices;
+    std::map<std::string, size_t> pathIndices;
+
+    constexpr std::array<aiTextureType, 4> textureTypes = { aiTextureType_DIFFUSE,
+      aiTextureType_NORMALS, aiTextureType_BASE_COLOR, aiTextureType_EMISSIVE };
+
+    // the readers are created sequentially, the image readers factory is not thread safe
+    for (unsigned int i = 0; i < this->Scene->mNumMaterials; i++)
+    {
+      for (aiTextureType type : textureTypes)
+      {
+        aiString texPath;
+        if (this->Scene->mMaterials[i]->GetTexture(type, 0, &texPath) != aiReturn_SUCCESS ||
+          pathIndices.count(texPath.C_Str()) > 0)
         {
-          std::string fileName = vtksys::SystemTools::GetFilenameName(path);
-          texturePath = vtksys::SystemTools::CollapseFullPath(fileName, dir);
+          continue;
         }
 
-        if (vtksys::SystemTools::FileExists(texturePath))
+        TextureImage image;
+        std::string key;
+        const aiTexture* aTexture = this->FindEmbeddedTexture(texPath.C_Str());
+        if (aTexture)
         {
-          vtkSmartPointer<vtkImageReader2> reader;
-          reader.TakeReference(vtkImageReader2Factory::CreateImageReader2(texturePath.c_str()));
-
-          if (!reader)
+          // the embedded textures are identified by their content
+          image.Embedded = aTexture;
+          size_t size = ::GetEmbeddedTextureSize(aTexture);
+          key = std::string(aTexture->achFormatHint) + ":" + std::to_string(size) + ":" +
+            std::to_string(std::hash<std::string_view>()(
+              std::string_view(reinterpret_cast<const char*>(aTexture->pcData), size)));
+        }
+        else
+        {
+          key = this->FindTextureFile(texPath.C_Str());
+          if (key.empty())
           {
-            vtkWarningWithObjectMacro(
-              this->Parent, "Cannot instantiate the image reader for texture: " << texturePath);
-            return nullptr;
+            continue;
           }
+        }
 
-          reader->SetFileName(texturePath.c_str());
+        auto it = imageIndices.find(key);
+        if (it != imageIndices.end() &&
+          (!aTexture ||
+            std::memcmp(images[it->second].Embedded->pcData, aTexture->pcData,
+              ::GetEmbeddedTextureSize(aTexture)) == 0))
+        {
+          pathIndices[texPath.C_Str()] = it->second;
+          continue;
+        }
 
-          vTexture = vtkSmartPointer<vtkTexture>::New();
-          vTexture->SetInputConnection(reader->GetOutputPort());
+        if (!aTexture)
+        {
+          image.CacheKey = vtkF3DTextureCache::GetFileKey(
+            key, std::to_string(this->Parent->GetTextureMaximumSize()));
+          image.Image = vtkF3DTextureCache::FindImage(image.CacheKey);
+          if (!image.Image)
+          {
+            image.Reader.TakeReference(vtkImageReader2Factory::CreateImageReader2(key.c_str()));
+            if (!image.Reader)
+            {
+              vtkWarningWithObjectMacro(
+                this->Parent, "Cannot instantiate the image reader for texture: " << key);
+              continue;
+            }
+            image.Reader->SetFileName(key.c_str());
+          }
+        }
+        else if (aTexture->mHeight == 0)
+        {
+          image.Reader.TakeReference(
+            vtkImageReader2Factory::CreateImageReader2FromExtension(aTexture->achFormatHint));
+          if (image.Reader)
+          {
+            image.Reader->SetMemoryBuffer(aTexture->pcData);
+            image.Reader->SetMemoryBufferLength(aTexture->mWidth);
+          }
         }
         else
         {
-          vtkWarningWithObjectMacro(this->Parent, "Cannot find texture: " << texturePath);
-          return nullptr;
+          // Sometimes Assimp returns corrupted textures (encountered with 3MF)
+          // Let's validate it before trying to read it
+          // See https://github.com/assimp/assimp/issues/5328
+          std::regex validRegexp("[rgba]{4}[0-9]{4}");
+
+          if (std::regex_match(aTexture->achFormatHint, validRegexp))
+          {
+            // only "rgba8888" is supported for now
+            image.Image = vtkSmartPointer<vtkImageData>::New();
+            image.Image->SetDimensions(aTexture->mWidth, aTexture->mHeight, 1);
+            image.Image->AllocateScalars(VTK_UNSIGNED_CHAR, 4);
+            const unsigned char* texels = reinterpret_cast<const unsigned char*>(aTexture->pcData);
+            std::copy(texels, texels + 4 * aTexture->mWidth * aTexture->mHeight,
+              static_cast<unsigned char*>(image.Image->GetScalarPointer()));
+          }
         }
+
+        if (it == imageIndices.end())
+        {
+          imageIndices[key] = images.size();
+        }
+        pathIndices[texPath.C_Str()] = images.size();
+        images.emplace_back(std::move(image));
       }
     }
 
-    vTexture->MipmapOn();
-    vTexture->InterpolateOn();
-    vTexture->SetColorModeToDirectScalars();
-    vTexture->SetUseSRGBColorSpace(sRGB);
+    const int textureMaximumSize = this->Parent->GetTextureMaximumSize();
+    vtkSMPTools::For(0, static_cast<vtkIdType>(images.size()),
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        for (vtkIdType i = begin; i < end; i++)
+        {
+          // the cached images are already shrunk
+          if (!images[i].Reader && !images[i].CacheKey.empty())
+          {
+            continue;
+          }
+          if (images[i].Reader)
+          {
+            images[i].Reader->Update();
+            images[i].Image = images[i].Reader->GetOutput();
+          }
+          images[i].Image = vtkF3DImporter::ShrinkTexture(images[i].Image, textureMaximumSize);
+        }
+      });
 
-    return vTexture;
+    for (const TextureImage& image : images)
+    {
+      if (image.Reader)
+      {
+        vtkF3DTextureCache::AddImage(image.CacheKey, image.Image);
+      }
+    }
+
+    this->TextureImages.clear();
+    for (const auto& [path, index] : pathIndices)
+    {
+      vtkImageData* image = images[index].Image;
+      if (image && image->GetNumberOfPoints() > 0)
+      {
+        this->TextureImages[path] = image;
+      }
+    }
   }
 
   //----------------------------------------------------------------------------
   /**
-   * Generate a VTK texture from an embedded ASSIMP texture
+   * Get the VTK texture of a texture path referenced by a material, the textures are shared
+   * by the materials using the same image in the same color space
    */
-  vtkSmartPointer<vtkTexture> CreateEmbeddedTexture(const aiTexture* aTexture)
+  vtkSmartPointer<vtkTexture> CreateTexture(const char* path, bool sRGB = false)
   {
-    vtkNew<vtkTexture> vTexture;
-
-    if (aTexture->mHeight == 0)
+    auto it = this->TextureImages.find(path);
+    if (it == this->TextureImages.end())
     {
-      std::string fileType = aTexture->achFormatHint;
-
-      vtkSmartPointer<vtkImageReader2> reader;
-      reader.TakeReference(
-        vtkImageReader2Factory::CreateImageReader2FromExtension(fileType.c_str()));
-
-      if (reader)
-      {
-        reader->SetMemoryBuffer(aTexture->pcData);
-        reader->SetMemoryBufferLength(aTexture->mWidth);
-        vTexture->SetInputConnection(reader->GetOutputPort());
-      }
+      return nullptr;
     }
-    else
-    {
-      // Sometimes Assimp returns corrupted textures (encountered with 3MF)
-      // Let's validate it before trying to read it
-      // See https://github.com/assimp/assimp/issues/5328
-      std::regex validRegexp("[rgba]{4}[0-9]{4}");
 
-      if (std::regex_match(aTexture->achFormatHint, validRegexp))
-      {
-        // only "rgba8888" is supported for now
-        vtkNew<vtkImageData> img;
-        img->SetDimensions(aTexture->mWidth, aTexture->mHeight, 1);
-        img->AllocateScalars(VTK_UNSIGNED_CHAR, 4);
-
-        unsigned char* imageBuffer = reinterpret_cast<unsigned char*>(img->GetScalarPointer());
-        std::copy(imageBuffer, imageBuffer + 4 * aTexture->mWidth * aTexture->mHeight,
-          reinterpret_cast<unsigned char*>(aTexture->pcData));
-
-        vTexture->SetInputData(img);
-      }
+    vtkSmartPointer<vtkTexture>& vTexture = this->Textures[{ it->second.Get(), sRGB }];
+    if (!vTexture)
+    {
+      vTexture = vtkF3DTextureCache::GetTexture(it->second, sRGB);
     }
-
     return vTexture;
   }
 
@@ -386,6 +535,8 @@ public:
    */
   vtkSmartPointer<vtkPolyData> CreateMesh(const aiMesh* mesh)
   {
+    // the temporary containers of the conversion are freed once the mesh is created
+    vtkF3DScratchArena::Scope scratch;
     vtkNew<vtkPolyData> polyData;
 
     vtkNew<vtkPoints> points;
@@ -493,7 +644,7 @@ public:
     polyData->SetLines(linesCells);
     polyData->SetPolys(polysCells);
 
-    if (mesh->mNumBones > 0)
+    if (mesh->mNumBones > 0 && this->Parent->GetImportAnimations())
     {
       struct SkinData
       {
@@ -502,7 +653,7 @@ public:
         unsigned int nb = 0;
       };
 
-      std::vector<SkinData> skinPoints(mesh->mNumVertices);
+      vtkF3DScratchArena::Vector<SkinData> skinPoints(mesh->mNumVertices);
 
       vtkNew<vtkStringArray> bonesList;
       bonesList->SetName("Bones");
@@ -592,7 +743,17 @@ public:
     {
       // Work around for https://github.com/assimp/assimp/issues/4620
       this->Importer.SetPropertyBool(AI_CONFIG_IMPORT_FBX_PRESERVE_PIVOTS, false);
-      this->Scene = this->Importer.ReadFile(filePath, aiProcess_LimitBoneWeights);
+      unsigned int flags = aiProcess_LimitBoneWeights;
+      if (this->Parent->GetOptimizeGeometry())
+      {
+        // the nodes are kept as is, so the animations and the cameras are not affected
+        flags |= aiProcess_JoinIdenticalVertices | aiProcess_OptimizeMeshes |
+          aiProcess_ImproveCacheLocality;
+      }
+
+      // the handler is owned by the Assimp importer
+      this->Importer.SetProgressHandler(new CancellationHandler(this->Parent));
+      this->Scene = this->Importer.ReadFile(filePath, flags);
     }
     catch (const DeadlyImportError& e)
     {
@@ -600,21 +761,35 @@ public:
       return false;
     }
 
+    // a cancelled read is not an error, the scene is just discarded
+    if (this->Parent->IsCancelled())
+    {
+      return false;
+    }
+
     if (this->Scene)
     {
       // convert meshes to polyData
       this->Meshes.resize(this->Scene->mNumMeshes);
-      for (unsigned int i = 0; i < this->Scene->mNumMeshes; i++)
+      this->Mappers.clear();
+      this->Mappers.resize(this->Scene->mNumMeshes);
+      // the meshes are independent, they are converted concurrently
+      vtkSMPTools::For(0, static_cast<vtkIdType>(this->Scene->mNumMeshes),
+        [&](vtkIdType begin, vtkIdType end)
+        {
+          for (vtkIdType i = begin; i < end && !this->Parent->IsCancelled(); i++)
+          {
+            this->Meshes[i] = this->CreateMesh(this->Scene->mMeshes[i]);
+          }
+        });
+      if (this->Parent->IsCancelled())
       {
-        this->Meshes[i] = this->CreateMesh(this->Scene->mMeshes[i]);
+        return false;
       }
 
-      // read embedded textures
-      this->EmbeddedTextures.resize(this->Scene->mNumTextures);
-      for (unsigned int i = 0; i < this->Scene->mNumTextures; i++)
-      {
-        this->EmbeddedTextures[i] = this->CreateEmbeddedTexture(this->Scene->mTextures[i]);
-      }
+      // decode the textures before they are shared by the materials
+      this->Textures.clear();
+      this->DecodeTextureImages();
 
       // convert materials to properties
       this->Properties.resize(this->Scene->mNumMaterials);
@@ -662,7 +837,8 @@ public:
   /**
    * Build recursively the node tree
    */
-  void ImportNode(vtkRenderer* renderer, const aiNode* node, vtkMatrix4x4* parentMat, int level = 0)
+  void ImportNode(vtkRenderer* renderer, const aiNode* node, vtkMatrix4x4* parentMat, int level = 0,
+    int parentIndex = -1)
   {
     vtkNew<vtkMatrix4x4> mat;
     vtkNew<vtkMatrix4x4> localMat;
@@ -676,9 +852,20 @@ public:
     for (unsigned int i = 0; i < node->mNumMeshes; i++)
     {
       vtkNew<vtkActor> actor;
-      vtkNew<vtkPolyDataMapper> mapper;
-      mapper->SetInputData(this->Meshes[node->mMeshes[i]]);
-      mapper->SetColorModeToDirectScalars();
+
+      // nodes referencing the same mesh share its mapper, so it is uploaded only once.
+      // skinned meshes keep their own mapper as the joint matrices are per actor
+      vtkSmartPointer<vtkPolyDataMapper> mapper = this->Mappers[node->mMeshes[i]];
+      if (!mapper)
+      {
+        mapper = vtkSmartPointer<vtkPolyDataMapper>::New();
+        if (!this->Scene->mMeshes[node->mMeshes[i]]->HasBones())
+        {
+          this->Mappers[node->mMeshes[i]] = mapper;
+        }
+        mapper->SetInputData(this->Meshes[node->mMeshes[i]]);
+        mapper->SetColorModeToDirectScalars();
+      }
 
       actor->SetMapper(mapper);
       actor->SetUserMatrix(mat);
@@ -699,9 +886,14 @@ public:
     this->NodeLocalMatrix.insert({ node->mName.data, localMat });
     this->NodeGlobalMatrix.insert({ node->mName.data, mat });
 
+    // actors use the global matrix directly, so it is updated in place when animating
+    int index = static_cast<int>(this->FlatNodes.size());
+    this->FlatNodes.push_back(
+      { parentIndex, this->NodeLocalMatrix[node->mName.data], vtkSmartPointer<vtkMatrix4x4>(mat) });
+
     for (unsigned int i = 0; i < node->mNumChildren; i++)
     {
-      this->ImportNode(renderer, node->mChildren[i], mat, level + 1);
+      this->ImportNode(renderer, node->mChildren[i], mat, level + 1, index);
     }
   }
 
@@ -718,36 +910,171 @@ public:
       this->ImportNode(renderer, this->Scene->mRootNode, identity);
 
       // even if there is no animation, the bones needs to be updated
+      this->ImportSkins();
       this->UpdateBones();
     }
   }
 
   //----------------------------------------------------------------------------
   /**
-   * Update the actors matrix from the computed transformations
+   * Update the actors matrix from the computed transformations.
+   * Nodes are flattened with parents first, so this is a single pass without any lookup.
    */
-  void UpdateNodeTransform(const aiNode* node, const vtkMatrix4x4* parentMat)
+  void UpdateNodeTransforms()
   {
-    vtkSmartPointer<vtkMatrix4x4> localMat = this->NodeLocalMatrix[node->mName.data];
+    for (const FlatNode& node : this->FlatNodes)
+    {
+      if (node.Parent < 0)
+      {
+        node.GlobalMatrix->DeepCopy(node.LocalMatrix);
+      }
+      else
+      {
+        vtkMatrix4x4::Multiply4x4(
+          this->FlatNodes[node.Parent].GlobalMatrix, node.LocalMatrix, node.GlobalMatrix);
+        node.GlobalMatrix->Modified();
+      }
+    }
+  }
 
-    vtkNew<vtkMatrix4x4> mat;
-    vtkMatrix4x4::Multiply4x4(parentMat, localMat, mat);
+  //----------------------------------------------------------------------------
+  /**
+   * Convert the channels of an animation into flat keyframe tracks
+   */
+  void BuildTracks(vtkIdType animationIndex)
+  {
+    this->Tracks.clear();
+    this->TracksAnimation = animationIndex;
 
-    this->NodeGlobalMatrix[node->mName.data] = mat;
+    const aiAnimation* anim = this->Scene->mAnimations[animationIndex];
+    this->Tracks.reserve(anim->mNumChannels);
+    for (unsigned int nodeChannelId = 0; nodeChannelId < anim->mNumChannels; nodeChannelId++)
+    {
+      const aiNodeAnim* nodeAnim = anim->mChannels[nodeChannelId];
+      auto it = this->NodeLocalMatrix.find(nodeAnim->mNodeName.data);
+      if (it == this->NodeLocalMatrix.end() || !it->second)
+      {
+        continue;
+      }
 
-    // update current node actors
-    vtkActorCollection* actors = this->NodeActors[node->mName.data];
-    actors->InitTraversal();
+      NodeTrack track;
+      track.LocalMatrix = it->second;
+      for (unsigned int i = 0; i < nodeAnim->mNumPositionKeys; i++)
+      {
+        const aiVectorKey& key = nodeAnim->mPositionKeys[i];
+        track.PositionTimes.push_back(key.mTime);
+        track.Positions.insert(track.Positions.end(), { key.mValue.x, key.mValue.y, key.mValue.z });
+      }
+      for (unsigned int i = 0; i < nodeAnim->mNumRotationKeys; i++)
+      {
+        const aiQuatKey& key = nodeAnim->mRotationKeys[i];
+        track.RotationTimes.push_back(key.mTime);
+        track.Rotations.insert(
+          track.Rotations.end(), { key.mValue.w, key.mValue.x, key.mValue.y, key.mValue.z });
+      }
+      for (unsigned int i = 0; i < nodeAnim->mNumScalingKeys; i++)
+      {
+        const aiVectorKey& key = nodeAnim->mScalingKeys[i];
+        track.ScalingTimes.push_back(key.mTime);
+        track.Scalings.insert(track.Scalings.end(), { key.mValue.x, key.mValue.y, key.mValue.z });
+      }
 
-    vtkActor* actor = nullptr;
-    while ((actor = actors->GetNextActor()) != nullptr)
+      this->Tracks.push_back(std::move(track));
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  /**
+   * Locate the keys surrounding the tick in sorted key times.
+   * Return false if there is no key, otherwise set the previous and next key indices
+   * and the interpolation factor between them.
+   */
+  static bool LocateKeys(const std::vector<double>& times, double tick, size_t& prev, size_t& next,
+    ai_real& factor)
+  {
+    if (times.empty())
     {
-      actor->SetUserMatrix(mat);
+      return false;
     }
 
-    for (unsigned int i = 0; i < node->mNumChildren; i++)
+    const size_t index = std::lower_bound(times.begin(), times.end(), tick) - times.begin();
+    factor = 0;
+    if (index == 0)
+    {
+      prev = next = 0;
+    }
+    else if (index == times.size())
     {
-      this->UpdateNodeTransform(node->mChildren[i], mat);
+      prev = next = times.size() - 1;
+    }
+    else
+    {
+      prev = index - 1;
+      next = index;
+      factor = static_cast<ai_real>((tick - times[prev]) / (times[next] - times[prev]));
+    }
+    return true;
+  }
+
+  //----------------------------------------------------------------------------
+  /**
+   * Evaluate all tracks at the provided tick and update the local matrices
+   */
+  void EvaluateTracks(double tick)
+  {
+    size_t prev, next;
+    ai_real d;
+    for (const NodeTrack& track : this->Tracks)
+    {
+      ai_real translation[3] = { 0, 0, 0 };
+      ai_real scaling[3] = { 1, 1, 1 };
+      aiQuaternion quaternion;
+
+      if (LocateKeys(track.PositionTimes, tick, prev, next, d))
+      {
+        for (int c = 0; c < 3; c++)
+        {
+          const ai_real a = track.Positions[3 * prev + c];
+          translation[c] = a + (track.Positions[3 * next + c] - a) * d;
+        }
+      }
+
+      if (LocateKeys(track.RotationTimes, tick, prev, next, d))
+      {
+        const ai_real* a = &track.Rotations[4 * prev];
+        const ai_real* b = &track.Rotations[4 * next];
+        aiQuaternion::Interpolate(quaternion, aiQuaternion(a[0], a[1], a[2], a[3]),
+          aiQuaternion(b[0], b[1], b[2], b[3]), d);
+      }
+
+      if (LocateKeys(track.ScalingTimes, tick, prev, next, d))
+      {
+        for (int c = 0; c < 3; c++)
+        {
+          const ai_real a = track.Scalings[3 * prev + c];
+          scaling[c] = a + (track.Scalings[3 * next + c] - a) * d;
+        }
+      }
+
+      // Initialize quaternion
+      vtkQuaternion<double> rotation;
+      rotation.Set(quaternion.w, quaternion.x, quaternion.y, quaternion.z);
+      rotation.Normalize();
+
+      double rotationMatrix[3][3];
+      rotation.ToMatrix3x3(rotationMatrix);
+
+      // Apply transformations, the matrix is modified only once
+      double* transform = track.LocalMatrix->GetData();
+      for (int i = 0; i < 3; i++)
+      {
+        for (int j = 0; j < 3; j++)
+        {
+          transform[4 * i + j] = scaling[j] * rotationMatrix[i][j];
+        }
+        transform[4 * i + 3] = translation[i];
+      }
+      track.LocalMatrix->Modified();
     }
   }
 
@@ -781,10 +1108,12 @@ public:
 
   //----------------------------------------------------------------------------
   /**
-   * Update bones information for skinning
+   * Collect the skinned actors with their bones, so that animating only
+   * requires to compute the joint matrices
    */
-  void UpdateBones()
+  void ImportSkins()
   {
+    this->Skins.clear();
     for (auto& pairsActor : NodeActors)
     {
       vtkActorCollection* actors = pairsActor.second;
@@ -794,70 +1123,85 @@ public:
       while ((actor = actors->GetNextActor()) != nullptr)
       {
         vtkPolyDataMapper* mapper = vtkPolyDataMapper::SafeDownCast(actor->GetMapper());
+        vtkPolyData* polyData = mapper ? mapper->GetInput() : nullptr;
+        if (!polyData)
+        {
+          continue;
+        }
 
-        if (mapper)
+        vtkStringArray* bonesList =
+          vtkStringArray::SafeDownCast(polyData->GetFieldData()->GetAbstractArray("Bones"));
+        vtkDoubleArray* bonesTransform = vtkDoubleArray::SafeDownCast(
+          polyData->GetFieldData()->GetArray("InverseBindMatrices"));
+        if (!bonesList || !bonesTransform || bonesList->GetNumberOfValues() == 0)
         {
-          vtkPolyData* polyData = mapper->GetInput();
+          continue;
+        }
 
-          if (polyData)
+        Skin skin;
+        skin.Actor = actor;
+        skin.InverseBindMatrices = bonesTransform;
+        vtkIdType nbBones = bonesList->GetNumberOfValues();
+        for (vtkIdType i = 0; i < nbBones; i++)
+        {
+          std::string boneName = bonesList->GetValue(i);
+          auto it = this->NodeGlobalMatrix.find(boneName);
+          if (it == this->NodeGlobalMatrix.end() || !it->second)
           {
-            vtkStringArray* bonesList =
-              vtkStringArray::SafeDownCast(polyData->GetFieldData()->GetAbstractArray("Bones"));
-            vtkDoubleArray* bonesTransform = vtkDoubleArray::SafeDownCast(
-              polyData->GetFieldData()->GetArray("InverseBindMatrices"));
-            if (bonesList && bonesTransform)
-            {
-              vtkIdType nbBones = bonesList->GetNumberOfValues();
+            vtkWarningWithObjectMacro(
+              this->Parent, "Cannot find global matrix of bone " << boneName);
+            skin.BoneMatrices.emplace_back(nullptr);
+          }
+          else
+          {
+            skin.BoneMatrices.emplace_back(it->second);
+          }
+        }
+        skin.JointMatrices.resize(16 * nbBones);
+        this->Skins.push_back(std::move(skin));
+      }
+    }
+  }
 
-              if (nbBones > 0)
-              {
-                std::vector<float> vec;
-                vec.reserve(16 * nbBones);
-
-                vtkNew<vtkMatrix4x4> inverseRoot;
-                actor->GetUserMatrix()->DeepCopy(inverseRoot);
-                inverseRoot->Invert();
-
-                for (vtkIdType i = 0; i < nbBones; i++)
-                {
-                  std::string boneName = bonesList->GetValue(i);
-
-                  vtkNew<vtkMatrix4x4> boneMat;
-                  bonesTransform->GetTypedTuple(i, boneMat->GetData());
-
-                  auto globalMatrix = this->NodeGlobalMatrix[boneName];
-
-                  if (globalMatrix)
-                  {
-                    vtkMatrix4x4::Multiply4x4(globalMatrix, boneMat, boneMat);
-                  }
-                  else
-                  {
-                    vtkWarningWithObjectMacro(
-                      this->Parent, "Cannot find global matrix of bone " << boneName);
-                  }
-
-                  vtkMatrix4x4::Multiply4x4(inverseRoot, boneMat, boneMat);
-
-                  for (int j = 0; j < 4; j++)
-                  {
-                    for (int k = 0; k < 4; k++)
-                    {
-                      vec.push_back(static_cast<float>(boneMat->GetElement(k, j)));
-                    }
-                  }
-                }
-
-                vtkShaderProperty* shaderProp = actor->GetShaderProperty();
-                vtkUniforms* uniforms = shaderProp->GetVertexCustomUniforms();
-                uniforms->RemoveAllUniforms();
-                uniforms->SetUniformMatrix4x4v(
-                  "jointMatrices", static_cast<int>(nbBones), vec.data());
-              }
-            }
+  //----------------------------------------------------------------------------
+  /**
+   * Update bones information for skinning.
+   * Only the joint matrices palette is sent to the GPU, skinning is done in the vertex shader.
+   */
+  void UpdateBones()
+  {
+    vtkNew<vtkMatrix4x4> inverseRoot;
+    vtkNew<vtkMatrix4x4> boneMat;
+    for (Skin& skin : this->Skins)
+    {
+      inverseRoot->DeepCopy(skin.Actor->GetUserMatrix());
+      inverseRoot->Invert();
+
+      for (size_t i = 0; i < skin.BoneMatrices.size(); i++)
+      {
+        skin.InverseBindMatrices->GetTypedTuple(i, boneMat->GetData());
+
+        if (skin.BoneMatrices[i])
+        {
+          vtkMatrix4x4::Multiply4x4(skin.BoneMatrices[i], boneMat, boneMat);
+        }
+
+        vtkMatrix4x4::Multiply4x4(inverseRoot, boneMat, boneMat);
+
+        float* joint = &skin.JointMatrices[16 * i];
+        for (int j = 0; j < 4; j++)
+        {
+          for (int k = 0; k < 4; k++)
+          {
+            joint[4 * j + k] = static_cast<float>(boneMat->GetElement(k, j));
           }
         }
       }
+
+      // The uniform is updated in place, adding or removing uniforms would rebuild the shaders
+      vtkUniforms* uniforms = skin.Actor->GetShaderProperty()->GetVertexCustomUniforms();
+      uniforms->SetUniformMatrix4x4v("jointMatrices",
+        static_cast<int>(skin.BoneMatrices.size()), skin.JointMatrices.data());
     }
   }
 
@@ -865,8 +1209,10 @@ public:
   const aiScene* Scene = nullptr;
   std::string Description;
   std::vector<vtkSmartPointer<vtkPolyData>> Meshes;
+  std::vector<vtkSmartPointer<vtkPolyDataMapper>> Mappers;
   std::vector<vtkSmartPointer<vtkProperty>> Properties;
-  std::vector<vtkSmartPointer<vtkTexture>> EmbeddedTextures;
+  std::map<std::string, vtkSmartPointer<vtkImageData>> TextureImages;
+  std::map<std::pair<vtkImageData*, bool>, vtkSmartPointer<vtkTexture>> Textures;
   vtkIdType ActiveAnimation = -1; // -1 means no animation enabled here
   std::vector<std::pair<std::string, vtkSmartPointer<vtkLight>>> Lights;
   std::vector<
@@ -877,6 +1223,38 @@ public:
   std::unordered_map<std::string, vtkSmartPointer<vtkMatrix4x4>> NodeLocalMatrix;
   std::unordered_map<std::string, vtkSmartPointer<vtkMatrix4x4>> NodeTRSMatrix;
   std::unordered_map<std::string, vtkSmartPointer<vtkMatrix4x4>> NodeGlobalMatrix;
+
+  struct FlatNode
+  {
+    int Parent; // -1 for the root
+    vtkSmartPointer<vtkMatrix4x4> LocalMatrix;
+    vtkSmartPointer<vtkMatrix4x4> GlobalMatrix;
+  };
+  std::vector<FlatNode> FlatNodes;
+
+  // Keyframe tracks of the active animation, one array per channel and component type
+  struct NodeTrack
+  {
+    vtkSmartPointer<vtkMatrix4x4> LocalMatrix;
+    std::vector<double> PositionTimes;
+    std::vector<ai_real> Positions; // xyz
+    std::vector<double> RotationTimes;
+    std::vector<ai_real> Rotations; // wxyz
+    std::vector<double> ScalingTimes;
+    std::vector<ai_real> Scalings; // xyz
+  };
+  std::vector<NodeTrack> Tracks;
+  vtkIdType TracksAnimation = -1;
+
+  struct Skin
+  {
+    vtkActor* Actor;
+    vtkSmartPointer<vtkDoubleArray> InverseBindMatrices;
+    std::vector<vtkSmartPointer<vtkMatrix4x4>> BoneMatrices; // nullptr if the bone is not found
+    std::vector<float> JointMatrices;
+  };
+  std::vector<Skin> Skins;
+
   vtkF3DAssimpImporter* Parent;
 };
 
@@ -924,105 +1302,18 @@ bool vtkF3DAssimpImporter::UpdateAtTimeValue(double timeValue)
     fps = 1.0;
   }
 
-  aiAnimation* anim = this->Internals->Scene->mAnimations[this->Internals->ActiveAnimation];
-  double tick = timeValue * fps;
-
-  Assimp::Interpolator<aiVectorKey> vectorInterpolator;
-  Assimp::Interpolator<aiQuatKey> quaternionInterpolator;
-
-  for (unsigned int nodeChannelId = 0; nodeChannelId < anim->mNumChannels; nodeChannelId++)
+  if (this->Internals->TracksAnimation != this->Internals->ActiveAnimation)
   {
-    aiNodeAnim* nodeAnim = anim->mChannels[nodeChannelId];
-
-    aiVector3D translation;
-    aiVector3D scaling;
-    aiQuaternion quaternion;
-
-    aiVectorKey* positionKey = std::lower_bound(nodeAnim->mPositionKeys,
-      nodeAnim->mPositionKeys + nodeAnim->mNumPositionKeys, tick,
-      [](const aiVectorKey& key, const double& time) { return key.mTime < time; });
-
-    if (positionKey == nodeAnim->mPositionKeys)
-    {
-      translation = positionKey->mValue;
-    }
-    else if (positionKey == nodeAnim->mPositionKeys + nodeAnim->mNumPositionKeys)
-    {
-      translation = (positionKey - 1)->mValue;
-    }
-    else
-    {
-      aiVectorKey* prev = positionKey - 1;
-      ai_real d = (tick - prev->mTime) / (positionKey->mTime - prev->mTime);
-      vectorInterpolator(translation, *prev, *positionKey, d);
-    }
-
-    aiQuatKey* rotationKey = std::lower_bound(nodeAnim->mRotationKeys,
-      nodeAnim->mRotationKeys + nodeAnim->mNumRotationKeys, tick,
-      [](const aiQuatKey& key, const double& time) { return key.mTime < time; });
-
-    if (rotationKey == nodeAnim->mRotationKeys)
-    {
-      quaternion = rotationKey->mValue;
-    }
-    else if (rotationKey == nodeAnim->mRotationKeys + nodeAnim->mNumRotationKeys)
-    {
-      quaternion = (rotationKey - 1)->mValue;
-    }
-    else
-    {
-      aiQuatKey* prev = rotationKey - 1;
-      ai_real d = (tick - prev->mTime) / (rotationKey->mTime - prev->mTime);
-      quaternionInterpolator(quaternion, *prev, *rotationKey, d);
-    }
-
-    aiVectorKey* scalingKey =
-      std::lower_bound(nodeAnim->mScalingKeys, nodeAnim->mScalingKeys + nodeAnim->mNumScalingKeys,
-        tick, [](const aiVectorKey& key, const double& time) { return key.mTime < time; });
-
-    if (scalingKey == nodeAnim->mScalingKeys)
-    {
-      scaling = scalingKey->mValue;
-    }
-    else if (scalingKey == nodeAnim->mScalingKeys + nodeAnim->mNumScalingKeys)
-    {
-      scaling = (scalingKey - 1)->mValue;
-    }
-    else
-    {
-      aiVectorKey* prev = scalingKey - 1;
-      ai_real d = (tick - prev->mTime) / (scalingKey->mTime - prev->mTime);
-      vectorInterpolator(scaling, *prev, *scalingKey, d);
-    }
-
-    vtkMatrix4x4* transform = this->Internals->NodeLocalMatrix[nodeAnim->mNodeName.data];
-
-    if (transform)
-    {
-      // Initialize quaternion
-      vtkQuaternion<double> rotation;
-      rotation.Set(quaternion.w, quaternion.x, quaternion.y, quaternion.z);
-      rotation.Normalize();
-
-      double rotationMatrix[3][3];
-      rotation.ToMatrix3x3(rotationMatrix);
-
-      // Apply transformations
-      for (int i = 0; i < 3; i++)
-      {
-        for (int j = 0; j < 3; j++)
-        {
-          transform->SetElement(i, j, scaling[j] * rotationMatrix[i][j]);
-        }
-        transform->SetElement(i, 3, translation[i]);
-      }
-    }
+    this->Internals->BuildTracks(this->Internals->ActiveAnimation);
   }
+  this->Internals->EvaluateTracks(timeValue * fps);
+  this->Internals->UpdateNodeTransforms();
 
-  vtkNew<vtkMatrix4x4> identity;
-  this->Internals->UpdateNodeTransform(this->Internals->Scene->mRootNode, identity);
-
-  this->Internals->UpdateBones();
+  // Rigid animations do not need any bone update
+  if (!this->Internals->Skins.empty())
+  {
+    this->Internals->UpdateBones();
+  }
   this->Internals->UpdateCameras();
   this->Internals->UpdateLights();
   return true;
@@ -1031,7 +1322,8 @@ bool vtkF3DAssimpImporter::UpdateAtTimeValue(double timeValue)
 //----------------------------------------------------------------------------
 vtkIdType vtkF3DAssimpImporter::GetNumberOfAnimations()
 {
-  return this->Internals->Scene ? this->Internals->Scene->mNumAnimations : 0;
+  return this->Internals->Scene && this->ImportAnimations ? this->Internals->Scene->mNumAnimations
+                                                          : 0;
 }
 
 //----------------------------------------------------------------------------
@@ -1128,4 +1420,7 @@ void vtkF3DAssimpImporter::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
   os << indent << "FileName: " << this->FileName << "\n";
+  os << indent << "OptimizeGeometry: " << this->OptimizeGeometry << "\n";
+  os << indent << "ImportAnimations: " << this->ImportAnimations << "\n";
+  os << indent << "TextureMaximumSize: " << this->TextureMaximumSize << "\n";
 }
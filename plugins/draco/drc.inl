@@ -0,0 +1,12 @@
+bool canReadFromMemory() const override
+{
+  return true;
+}
+
+vtkSmartPointer<vtkAlgorithm> createGeometryReaderFromMemory(
+  const void* buffer, size_t size) const override
+{
+  vtkNew<vtkF3DDracoReader> dracoReader;
+  dracoReader->SetBuffer(buffer, size);
+  return dracoReader;
+}
@@ -0,0 +1,24 @@
+bool canReadFromMemory() const override
+{
+  return VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 4, 0);
+}
+
+vtkSmartPointer<vtkImporter> createSceneReaderFromMemory(
+  const void* buffer, size_t size) const override
+{
+#if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 4, 0)
+  // Only self contained files can be read from memory, external buffers and images are not found.
+  vtkNew<vtkMemoryResourceStream> stream;
+  stream->SetBuffer(buffer, size);
+
+  vtkNew<vtkF3DGLTFImporter> importer;
+  importer->SetStream(stream);
+  importer->SetStreamIsBinary(
+    size >= 4 && std::string(static_cast<const char*>(buffer), 4) == "glTF");
+  return importer;
+#else
+  (void)buffer;
+  (void)size;
+  return nullptr;
+#endif
+}
@@ -1,9 +1,13 @@
 #include <vtkNew.h>
+#include <vtkPolyData.h>
 #include <vtkTestUtilities.h>
 
 #include "vtkF3DDracoReader.h"
 
+#include <fstream>
 #include <iostream>
+#include <iterator>
+#include <vector>
 
 int TestF3DDracoReader(int vtkNotUsed(argc), char* argv[])
 {
@@ -12,5 +16,20 @@ int TestF3DDracoReader(int vtkNotUsed(argc), char* argv[])
   reader->SetFileName(filename);
   reader->Update();
   reader->Print(cout);
+
+  // Decoding the file from memory gives the same output
+  std::ifstream file(filename, std::ios::binary);
+  std::vector<char> buffer{ std::istreambuf_iterator<char>(file), {} };
+  vtkNew<vtkF3DDracoReader> memoryReader;
+  memoryReader->SetBuffer(buffer.data(), buffer.size());
+  memoryReader->Update();
+  if (memoryReader->GetOutput()->GetNumberOfPoints() != reader->GetOutput()->GetNumberOfPoints() ||
+    memoryReader->GetOutput()->GetNumberOfCells() != reader->GetOutput()->GetNumberOfCells())
+  {
+    std::cerr << "Reading from memory does not give the same output as reading the file"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
   return EXIT_SUCCESS;
 }
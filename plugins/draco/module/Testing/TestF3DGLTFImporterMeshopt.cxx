@@ -0,0 +1,100 @@
+#include <vtkActor.h>
+#include <vtkActorCollection.h>
+#include <vtkCellArray.h>
+#include <vtkIdList.h>
+#include <vtkMapper.h>
+#include <vtkNew.h>
+#include <vtkPolyData.h>
+#include <vtkRenderer.h>
+#include <vtkTestUtilities.h>
+#include <vtkVersion.h>
+
+#if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 4, 0)
+#include <vtkMemoryResourceStream.h>
+#endif
+
+#include "vtkF3DGLTFImporter.h"
+
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace
+{
+// the quad of the file, decoded from the EXT_meshopt_compression buffer views,
+// the uncompressed fallback buffer only contains zeros
+bool CheckQuad(vtkF3DGLTFImporter* importer, const std::string& label)
+{
+  vtkActorCollection* actors = importer->GetRenderer()->GetActors();
+  vtkActor* actor = actors->GetNumberOfItems() == 1 ? actors->GetLastActor() : nullptr;
+  vtkPolyData* polyData =
+    actor ? vtkPolyData::SafeDownCast(actor->GetMapper()->GetInput()) : nullptr;
+  if (!polyData || polyData->GetNumberOfPoints() != 4 || polyData->GetNumberOfPolys() != 2)
+  {
+    std::cerr << label << ": the meshopt compressed quad is not imported" << std::endl;
+    return false;
+  }
+
+  const double expected[4][3] = { { 0, 0, 0 }, { 1, 0, 0 }, { 1, 1, 0 }, { 0, 1, 0 } };
+  for (vtkIdType i = 0; i < 4; i++)
+  {
+    double point[3];
+    polyData->GetPoint(i, point);
+    if (point[0] != expected[i][0] || point[1] != expected[i][1] || point[2] != expected[i][2])
+    {
+      std::cerr << label << ": the vertex buffer is not decoded, point " << i << " is "
+                << point[0] << ", " << point[1] << ", " << point[2] << std::endl;
+      return false;
+    }
+  }
+
+  const vtkIdType expectedIds[2][3] = { { 0, 1, 2 }, { 0, 2, 3 } };
+  vtkNew<vtkIdList> ids;
+  for (vtkIdType c = 0; c < 2; c++)
+  {
+    polyData->GetPolys()->GetCellAtId(c, ids);
+    if (ids->GetNumberOfIds() != 3 || ids->GetId(0) != expectedIds[c][0] ||
+      ids->GetId(1) != expectedIds[c][1] || ids->GetId(2) != expectedIds[c][2])
+    {
+      std::cerr << label << ": the index buffer is not decoded for the triangle " << c
+                << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestF3DGLTFImporterMeshopt(int vtkNotUsed(argc), char* argv[])
+{
+  std::string filename = std::string(argv[1]) + "data/Quad_meshopt.gltf";
+
+  vtkNew<vtkF3DGLTFImporter> importer;
+  importer->SetFileName(filename.c_str());
+  importer->Update();
+  if (!::CheckQuad(importer, "File"))
+  {
+    return EXIT_FAILURE;
+  }
+
+#if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 4, 0)
+  // the buffer views are also decoded when reading from memory
+  std::ifstream file(filename, std::ios::binary);
+  std::vector<char> buffer{ std::istreambuf_iterator<char>(file), {} };
+  vtkNew<vtkMemoryResourceStream> stream;
+  stream->SetBuffer(buffer.data(), buffer.size());
+
+  vtkNew<vtkF3DGLTFImporter> memoryImporter;
+  memoryImporter->SetStream(stream);
+  memoryImporter->SetStreamIsBinary(false);
+  memoryImporter->Update();
+  if (!::CheckQuad(memoryImporter, "Memory"))
+  {
+    return EXIT_FAILURE;
+  }
+#endif
+
+  return EXIT_SUCCESS;
+}
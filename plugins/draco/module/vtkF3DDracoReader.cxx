@@ -12,6 +12,7 @@
 #include <vtkPointData.h>
 #include <vtkPoints.h>
 #include <vtkPolyData.h>
+#include <vtkSMPTools.h>
 
 #include "draco/compression/decode.h"
 #include "draco/draco_features.h"
@@ -20,6 +21,21 @@
 #ifndef DRACO_MESH_COMPRESSION_SUPPORTED
 #error "Please rebuild draco with DRACO_MESH_COMPRESSION cmake option enabled."
 #endif
+
+#ifdef _WIN32
+#include <vtksys/Encoding.hxx>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <cstring>
+#include <string>
+#include <vector>
+
 class vtkF3DDracoReader::vtkInternals
 {
 public:
@@ -29,35 +45,132 @@ public:
   {
   }
 
+  //----------------------------------------------------------------------------
+  ~vtkInternals()
+  {
+    this->UnmapFile();
+  }
+
+  //----------------------------------------------------------------------------
+  /**
+   * Map the file in memory so that it is decoded without being copied in a buffer first.
+   * Return false if it cannot be mapped, eg. if it is empty.
+   */
+  bool MapFile(const std::string& fileName)
+  {
+    this->UnmapFile();
+#ifdef _WIN32
+    HANDLE file = CreateFileW(vtksys::Encoding::ToWindowsExtendedPath(fileName).c_str(),
+      GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+      return false;
+    }
+    LARGE_INTEGER size;
+    HANDLE mapping = nullptr;
+    if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+    {
+      mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    }
+    CloseHandle(file);
+    if (!mapping)
+    {
+      return false;
+    }
+    void* memory = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!memory)
+    {
+      return false;
+    }
+    this->MemorySize = static_cast<size_t>(size.QuadPart);
+#else
+    int fd = open(fileName.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+      return false;
+    }
+    struct stat st;
+    void* memory = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size > 0)
+    {
+      memory = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+    if (memory == MAP_FAILED)
+    {
+      return false;
+    }
+    this->MemorySize = static_cast<size_t>(st.st_size);
+    madvise(memory, this->MemorySize, MADV_SEQUENTIAL);
+#endif
+    this->Memory = memory;
+    return true;
+  }
+
+  //----------------------------------------------------------------------------
+  void UnmapFile()
+  {
+    if (this->Memory)
+    {
+#ifdef _WIN32
+      UnmapViewOfFile(this->Memory);
+#else
+      munmap(this->Memory, this->MemorySize);
+#endif
+      this->Memory = nullptr;
+      this->MemorySize = 0;
+    }
+  }
+
+  //----------------------------------------------------------------------------
   template<typename T>
   static vtkSmartPointer<vtkAOSDataArrayTemplate<T>> FillArray(
-    int nbPoints, draco::PointAttribute* attribute)
+    vtkIdType nbPoints, const draco::PointAttribute* attribute)
   {
     vtkNew<vtkAOSDataArrayTemplate<T>> arr;
 
-    arr->SetNumberOfComponents(attribute->num_components());
+    const int nbComps = attribute->num_components();
+    arr->SetNumberOfComponents(nbComps);
     arr->SetNumberOfTuples(nbPoints);
 
-    for (int i = 0; i < nbPoints; i++)
+    // the values are copied as is in the storage of the array, in bulk when they are
+    // tightly packed and in point order, the most common layout of the decoded attributes
+    T* output = arr->GetPointer(0);
+    const uint8_t* input = attribute->buffer()->data() + attribute->byte_offset();
+    const size_t tupleSize = nbComps * sizeof(T);
+    const int64_t stride = attribute->byte_stride();
+    if (attribute->is_mapping_identity() && stride == static_cast<int64_t>(tupleSize) &&
+      attribute->size() >= static_cast<size_t>(nbPoints))
     {
-      draco::AttributeValueIndex idx = attribute->mapped_index(draco::PointIndex(i));
-      T* p = reinterpret_cast<T*>(attribute->buffer()->data() +
-        attribute->byte_stride() * idx.value() + attribute->byte_offset());
-      arr->SetTypedTuple(i, p);
+      std::memcpy(output, input, nbPoints * tupleSize);
+      return arr;
     }
 
+    vtkSMPTools::For(0, nbPoints,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        for (vtkIdType i = begin; i < end; i++)
+        {
+          draco::AttributeValueIndex idx =
+            attribute->mapped_index(draco::PointIndex(static_cast<uint32_t>(i)));
+          std::memcpy(output + i * nbComps, input + stride * idx.value(), tupleSize);
+        }
+      });
+
     return arr;
   }
 
+  //----------------------------------------------------------------------------
   template<typename T>
   static void FillPoints(const T& input, vtkPolyData* output)
   {
     int nbAttr = input->num_attributes();
-    int nbPoints = input->num_points();
+    vtkIdType nbPoints = input->num_points();
 
     for (int i = 0; i < nbAttr; i++)
     {
-      draco::PointAttribute* attr = input->attribute(i);
+      const draco::PointAttribute* attr = input->attribute(i);
 
       vtkSmartPointer<vtkDataArray> dataArray;
 
@@ -90,7 +203,6 @@ public:
         case draco::DT_FLOAT32:
           dataArray = vtkInternals::FillArray<float>(nbPoints, attr);
           break;
-          break;
         case draco::DT_FLOAT64:
           dataArray = vtkInternals::FillArray<double>(nbPoints, attr);
           break;
@@ -131,31 +243,45 @@ public:
     }
   }
 
+  //----------------------------------------------------------------------------
   static void FillFaces(const std::unique_ptr<draco::Mesh>& mesh, vtkPolyData* output)
   {
-    int nbCells = mesh->num_faces();
-
-    vtkNew<vtkIdTypeArray> triangles;
-    triangles->SetNumberOfTuples(4 * nbCells);
-
-    for (int i = 0; i < nbCells; i++)
-    {
-      const draco::Mesh::Face& face = mesh->face(draco::FaceIndex(i));
-
-      triangles->SetTypedComponent(4 * i, 0, 3);
-      for (int j = 0; j < 3; j++)
+    vtkIdType nbCells = mesh->num_faces();
+
+    // each face writes its connectivity and its offset, so they are converted in parallel
+    vtkNew<vtkIdTypeArray> offsets;
+    offsets->SetNumberOfValues(nbCells + 1);
+    vtkNew<vtkIdTypeArray> connectivity;
+    connectivity->SetNumberOfValues(3 * nbCells);
+    vtkIdType* offsetsPtr = offsets->GetPointer(0);
+    vtkIdType* connectivityPtr = connectivity->GetPointer(0);
+    offsetsPtr[nbCells] = 3 * nbCells;
+
+    vtkSMPTools::For(0, nbCells,
+      [&](vtkIdType begin, vtkIdType end)
       {
-        triangles->SetTypedComponent(4 * i + j + 1, 0, face[j].value());
-      }
-    }
+        for (vtkIdType i = begin; i < end; i++)
+        {
+          const draco::Mesh::Face& face = mesh->face(draco::FaceIndex(static_cast<uint32_t>(i)));
+          for (int j = 0; j < 3; j++)
+          {
+            connectivityPtr[3 * i + j] = face[j].value();
+          }
+          offsetsPtr[i] = 3 * i;
+        }
+      });
 
     vtkNew<vtkCellArray> cells;
-    cells->SetCells(nbCells, triangles);
+    cells->SetData(offsets, connectivity);
 
     output->SetPolys(cells);
   }
 
   vtkF3DDracoReader* Parent;
+
+  // the file is only mapped while it is decoded, the decoded mesh does not reference it
+  void* Memory = nullptr;
+  size_t MemorySize = 0;
 };
 
 //----------------------------------------------------------------------------
@@ -171,23 +297,40 @@ vtkF3DDracoReader::vtkF3DDracoReader()
 //----------------------------------------------------------------------------
 vtkF3DDracoReader::~vtkF3DDracoReader() = default;
 
+//----------------------------------------------------------------------------
+void vtkF3DDracoReader::SetBuffer(const void* buffer, size_t size)
+{
+  this->Buffer = static_cast<const char*>(buffer);
+  this->BufferSize = size;
+  this->Modified();
+}
+
 //----------------------------------------------------------------------------
 int vtkF3DDracoReader::RequestData(
   vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector)
 {
   vtkPolyData* output = vtkPolyData::GetData(outputVector);
 
+  draco::DecoderBuffer buffer;
   std::vector<char> data;
-
-  auto reader = draco::StdioFileReader::Open(this->FileName);
-  if (!reader->ReadFileToBuffer(&data))
+  if (this->Buffer)
   {
-    vtkErrorMacro("Cannot read file");
-    return 0;
+    buffer.Init(this->Buffer, this->BufferSize);
+  }
+  else if (this->Internals->MapFile(this->FileName))
+  {
+    buffer.Init(static_cast<const char*>(this->Internals->Memory), this->Internals->MemorySize);
+  }
+  else
+  {
+    auto reader = draco::StdioFileReader::Open(this->FileName);
+    if (!reader || !reader->ReadFileToBuffer(&data))
+    {
+      vtkErrorMacro("Cannot read file");
+      return 0;
+    }
+    buffer.Init(data.data(), data.size());
   }
-
-  draco::DecoderBuffer buffer;
-  buffer.Init(data.data(), data.size());
 
   draco::Decoder decoder;
   auto geom_type = draco::Decoder::GetEncodedGeometryType(&buffer);
@@ -216,6 +359,7 @@ int vtkF3DDracoReader::RequestData(
     vtkInternals::FillPoints(pc.value(), output);
   }
 
+  this->Internals->UnmapFile();
   return 1;
 }
 
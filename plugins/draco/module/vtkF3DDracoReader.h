@@ -31,6 +31,12 @@ public:
   vtkGetMacro(FileName, std::string);
   ///@}
 
+  /**
+   * Set a buffer in memory to decode instead of the file.
+   * The buffer is not copied and must be kept alive while the reader is used.
+   */
+  void SetBuffer(const void* buffer, size_t size);
+
 protected:
   vtkF3DDracoReader();
   ~vtkF3DDracoReader() override;
@@ -45,6 +51,8 @@ private:
   std::unique_ptr<vtkInternals> Internals;
 
   std::string FileName;
+  const char* Buffer = nullptr;
+  size_t BufferSize = 0;
 };
 
 #endif
@@ -1,103 +1,408 @@
 #include "vtkF3DGLTFDocumentLoader.h"
 
 #include <vtkObjectFactory.h>
+#include <vtkSMPTools.h>
+
+#include <vtksys/FStream.hxx>
+#include <vtksys/SystemTools.hxx>
 
 #include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
 
 #include "draco/compression/decode.h"
 
+#ifdef F3D_PLUGIN_DRACO_MESHOPT
+#include <meshoptimizer.h>
+
+#include <vtkVersion.h>
+#include <vtk_nlohmannjson.h>
+#include VTK_NLOHMANN_JSON(json.hpp)
+
+#if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 4, 0)
+#include <vtkResourceStream.h>
+#endif
+#endif
+
 namespace
 {
 //----------------------------------------------------------------------------
 template<typename Decoder, typename... Args>
-std::vector<char> ComponentDispatcher(vtkGLTFDocumentLoader::ComponentType compType, Args&&... args)
+bool ComponentDispatcher(vtkGLTFDocumentLoader::ComponentType compType, Args&&... args)
 {
   switch (compType)
   {
     case vtkGLTFDocumentLoader::ComponentType::BYTE:
-      return Decoder().template decode<int8_t>(args...);
+      Decoder().template decode<int8_t>(args...);
+      return true;
     case vtkGLTFDocumentLoader::ComponentType::UNSIGNED_BYTE:
-      return Decoder().template decode<uint16_t>(args...);
+      Decoder().template decode<uint8_t>(args...);
+      return true;
     case vtkGLTFDocumentLoader::ComponentType::SHORT:
-      return Decoder().template decode<int16_t>(args...);
+      Decoder().template decode<int16_t>(args...);
+      return true;
     case vtkGLTFDocumentLoader::ComponentType::UNSIGNED_SHORT:
-      return Decoder().template decode<uint16_t>(args...);
+      Decoder().template decode<uint16_t>(args...);
+      return true;
     case vtkGLTFDocumentLoader::ComponentType::UNSIGNED_INT:
-      return Decoder().template decode<uint32_t>(args...);
+      Decoder().template decode<uint32_t>(args...);
+      return true;
     case vtkGLTFDocumentLoader::ComponentType::FLOAT:
-      return Decoder().template decode<float>(args...);
+      Decoder().template decode<float>(args...);
+      return true;
     default:
       break;
   }
 
-  return {};
+  return false;
 }
 
 //----------------------------------------------------------------------------
 struct IndexBufferDecoder
 {
   template<typename T>
-  std::vector<char> decode(const std::unique_ptr<draco::Mesh>& mesh)
+  void decode(const draco::Mesh& mesh, std::vector<char>& outBuffer)
   {
-    std::vector<char> outBuffer(mesh->num_faces() * 3 * sizeof(T));
+    outBuffer.resize(mesh.num_faces() * 3 * sizeof(T));
+    T* indices = reinterpret_cast<T*>(outBuffer.data());
 
-    for (draco::FaceIndex f(0); f < mesh->num_faces(); ++f)
+    for (draco::FaceIndex f(0); f < mesh.num_faces(); ++f)
     {
-      const draco::Mesh::Face& face = mesh->face(f);
-
-      T indices[3] = { static_cast<T>(face[0].value()), static_cast<T>(face[1].value()),
-        static_cast<T>(face[2].value()) };
-
-      std::copy(
-        indices, indices + 3, reinterpret_cast<T*>(outBuffer.data() + f.value() * sizeof(indices)));
+      const draco::Mesh::Face& face = mesh.face(f);
+      for (int j = 0; j < 3; j++)
+      {
+        indices[3 * f.value() + j] = static_cast<T>(face[j].value());
+      }
     }
-
-    return outBuffer;
   }
 };
 
 //----------------------------------------------------------------------------
-std::vector<char> DecodeIndexBuffer(
-  const std::unique_ptr<draco::Mesh>& mesh, vtkGLTFDocumentLoader::ComponentType compType)
+bool DecodeIndexBuffer(const draco::Mesh& mesh, vtkGLTFDocumentLoader::ComponentType compType,
+  std::vector<char>& outBuffer)
 {
   // indexing using float does not make sense
   assert(compType != vtkGLTFDocumentLoader::ComponentType::FLOAT);
 
-  return ComponentDispatcher<IndexBufferDecoder>(compType, mesh);
+  return ComponentDispatcher<IndexBufferDecoder>(compType, mesh, outBuffer);
 }
 
 //----------------------------------------------------------------------------
 struct VertexBufferDecoder
 {
   template<typename T>
-  std::vector<char> decode(
-    const std::unique_ptr<draco::Mesh>& mesh, const draco::PointAttribute* attribute)
+  void decode(
+    const draco::Mesh& mesh, const draco::PointAttribute* attribute, std::vector<char>& outBuffer)
   {
-    std::vector<char> outBuffer(mesh->num_points() * attribute->num_components() * sizeof(T));
-    std::vector<T> values(attribute->num_components());
+    const int nbComponents = attribute->num_components();
+    outBuffer.resize(mesh.num_points() * nbComponents * sizeof(T));
+    T* values = reinterpret_cast<T*>(outBuffer.data());
 
-    size_t byteOffset = 0;
-    for (draco::PointIndex i(0); i < mesh->num_points(); ++i)
+    for (draco::PointIndex i(0); i < mesh.num_points(); ++i)
     {
       attribute->ConvertValue<T>(
-        attribute->mapped_index(i), attribute->num_components(), values.data());
+        attribute->mapped_index(i), nbComponents, values + i.value() * nbComponents);
+    }
+  }
+};
+
+//----------------------------------------------------------------------------
+bool DecodeVertexBuffer(vtkGLTFDocumentLoader::ComponentType compType, const draco::Mesh& mesh,
+  int attIndex, std::vector<char>& outBuffer)
+{
+  const draco::PointAttribute* attribute = mesh.GetAttributeByUniqueId(attIndex);
+  if (!attribute)
+  {
+    return false;
+  }
+  return ComponentDispatcher<VertexBufferDecoder>(compType, mesh, attribute, outBuffer);
+}
 
-      std::copy(values.begin(), values.end(), reinterpret_cast<T*>(outBuffer.data() + byteOffset));
+//----------------------------------------------------------------------------
+/**
+ * Add a tightly packed buffer view covering the whole buffer, return its index
+ */
+int AddBufferView(
+  vtkGLTFDocumentLoader::Model& model, int bufferIndex, vtkGLTFDocumentLoader::Target target)
+{
+  vtkGLTFDocumentLoader::BufferView decodedBufferView;
+  decodedBufferView.Buffer = bufferIndex;
+  decodedBufferView.ByteLength = static_cast<int>(model.Buffers[bufferIndex].size());
+  decodedBufferView.ByteOffset = 0;
+  decodedBufferView.ByteStride = 0;
+  decodedBufferView.Target = static_cast<int>(target);
+  model.BufferViews.emplace_back(std::move(decodedBufferView));
+  return static_cast<int>(model.BufferViews.size() - 1);
+}
 
-      byteOffset += sizeof(T) * attribute->num_components();
+//----------------------------------------------------------------------------
+size_t GetComponentSize(vtkGLTFDocumentLoader::ComponentType compType)
+{
+  switch (compType)
+  {
+    case vtkGLTFDocumentLoader::ComponentType::BYTE:
+    case vtkGLTFDocumentLoader::ComponentType::UNSIGNED_BYTE:
+      return 1;
+    case vtkGLTFDocumentLoader::ComponentType::SHORT:
+    case vtkGLTFDocumentLoader::ComponentType::UNSIGNED_SHORT:
+      return 2;
+    case vtkGLTFDocumentLoader::ComponentType::UNSIGNED_INT:
+    case vtkGLTFDocumentLoader::ComponentType::FLOAT:
+      return 4;
+    default:
+      break;
+  }
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * Return the factor the normalized integers are multiplied by, see the glTF specification
+ */
+double GetNormalizationScale(vtkGLTFDocumentLoader::ComponentType compType)
+{
+  switch (compType)
+  {
+    case vtkGLTFDocumentLoader::ComponentType::BYTE:
+      return 1.0 / std::numeric_limits<int8_t>::max();
+    case vtkGLTFDocumentLoader::ComponentType::UNSIGNED_BYTE:
+      return 1.0 / std::numeric_limits<uint8_t>::max();
+    case vtkGLTFDocumentLoader::ComponentType::SHORT:
+      return 1.0 / std::numeric_limits<int16_t>::max();
+    case vtkGLTFDocumentLoader::ComponentType::UNSIGNED_SHORT:
+      return 1.0 / std::numeric_limits<uint16_t>::max();
+    case vtkGLTFDocumentLoader::ComponentType::UNSIGNED_INT:
+      return 1.0 / std::numeric_limits<uint32_t>::max();
+    default:
+      break;
+  }
+  return 1.0;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * An attribute accessor whose values are normalized integers or interleaved,
+ * and the buffer its tightly packed values are decoded to
+ */
+struct AttributeAccessor
+{
+  int Accessor = -1;
+  int Buffer = -1;
+  int DecodedBuffer = -1;
+  size_t SourceOffset = 0;
+  size_t Stride = 0;
+  size_t Count = 0;
+  size_t NbComponents = 0;
+  size_t ComponentSize = 0;
+  bool Normalize = false;
+  bool Decoded = false;
+};
+
+//----------------------------------------------------------------------------
+struct AttributeDecoder
+{
+  template<typename T>
+  void decode(
+    const AttributeAccessor& accessor, const std::vector<char>& source, std::vector<char>& output)
+  {
+    const size_t nbValues = accessor.Count * accessor.NbComponents;
+    const char* data = source.data() + accessor.SourceOffset;
+    if (!accessor.Normalize)
+    {
+      const size_t elementSize = accessor.NbComponents * sizeof(T);
+      output.resize(accessor.Count * elementSize);
+      for (size_t i = 0; i < accessor.Count; i++)
+      {
+        std::memcpy(output.data() + i * elementSize, data + i * accessor.Stride, elementSize);
+      }
+      return;
+    }
+
+    output.resize(nbValues * sizeof(float));
+    float* values = reinterpret_cast<float*>(output.data());
+    const float scale = 1.f / static_cast<float>(std::numeric_limits<T>::max());
+    if (accessor.Stride == accessor.NbComponents * sizeof(T))
+    {
+      // a plain loop over contiguous values, vectorized by the compiler
+      const T* input = reinterpret_cast<const T*>(data);
+      for (size_t i = 0; i < nbValues; i++)
+      {
+        values[i] = std::max(static_cast<float>(input[i]) * scale, -1.f);
+      }
+      return;
+    }
+
+    for (size_t i = 0; i < accessor.Count; i++)
+    {
+      const T* input = reinterpret_cast<const T*>(data + i * accessor.Stride);
+      for (size_t c = 0; c < accessor.NbComponents; c++)
+      {
+        values[i * accessor.NbComponents + c] =
+          std::max(static_cast<float>(input[c]) * scale, -1.f);
+      }
+    }
+  }
+};
+
+//----------------------------------------------------------------------------
+/**
+ * A Draco compressed primitive and the buffers its decoded indices and attributes are written to
+ */
+struct DracoPrimitive
+{
+  int BufferView;
+  int IndicesAccessor = -1;
+  int IndicesBuffer = -1;
+  std::vector<std::pair<int, int>> Attributes; // accessor and Draco unique id
+  std::vector<int> AttributeBuffers;
+
+  bool Decoded = false;
+  int NbFaces = 0;
+  int NbPoints = 0;
+};
+
+#ifdef F3D_PLUGIN_DRACO_MESHOPT
+//----------------------------------------------------------------------------
+/**
+ * Read the JSON part of a glTF or GLB document, the loader does not keep the bufferView
+ * extensions. read(data, size) reads the next bytes of the document from its start and returns
+ * the number of bytes read.
+ */
+template<typename Reader>
+nlohmann::json ReadGLTFJSON(Reader&& read)
+{
+  std::string content;
+  char magic[4] = {};
+  size_t nbRead = read(magic, sizeof(magic));
+  if (nbRead == sizeof(magic) && std::memcmp(magic, "glTF", 4) == 0)
+  {
+    // GLB header (magic, version, length) followed by the JSON chunk (length, type, data)
+    uint32_t header[4];
+    if (read(reinterpret_cast<char*>(header), sizeof(header)) != sizeof(header))
+    {
+      return nullptr;
+    }
+    content.resize(header[2]);
+    if (read(&content[0], header[2]) != header[2])
+    {
+      return nullptr;
+    }
+  }
+  else
+  {
+    content.assign(magic, nbRead);
+    char chunk[4096];
+    while ((nbRead = read(chunk, sizeof(chunk))) > 0)
+    {
+      content.append(chunk, nbRead);
     }
+  }
+  return nlohmann::json::parse(content, nullptr, false);
+}
 
-    return outBuffer;
+//----------------------------------------------------------------------------
+/**
+ * Read the JSON part of the document of the model, from the stream it was loaded from if any,
+ * eg. when read from memory, or from its file
+ */
+nlohmann::json ReadGLTFJSON(const vtkGLTFDocumentLoader::Model& model)
+{
+#if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 4, 0)
+  if (vtkResourceStream* stream = model.Stream)
+  {
+    // the stream position is restored for the loader
+    const vtkTypeInt64 position = stream->Tell();
+    stream->Seek(0, vtkResourceStream::SeekDirection::Begin);
+    nlohmann::json root =
+      ::ReadGLTFJSON([&](char* data, size_t size) { return stream->Read(data, size); });
+    stream->Seek(position, vtkResourceStream::SeekDirection::Begin);
+    return root;
   }
+#endif
+
+  vtksys::ifstream file(model.FileName.c_str(), std::ios::binary);
+  if (!file.is_open())
+  {
+    return nullptr;
+  }
+  return ::ReadGLTFJSON(
+    [&](char* data, size_t size)
+    {
+      file.read(data, static_cast<std::streamsize>(size));
+      return static_cast<size_t>(file.gcount());
+    });
+}
+
+//----------------------------------------------------------------------------
+/**
+ * A meshopt compressed buffer view and the buffer it is decoded to
+ */
+struct MeshoptBufferView
+{
+  int BufferView;
+  int Buffer;
+  size_t SourceOffset;
+  size_t SourceLength;
+  size_t Count;
+  size_t Stride;
+  std::string Mode;
+  std::string Filter;
+  int DecodedBuffer;
+  bool Decoded = false;
 };
 
 //----------------------------------------------------------------------------
-std::vector<char> DecodeVertexBuffer(vtkGLTFDocumentLoader::ComponentType compType,
-  const std::unique_ptr<draco::Mesh>& mesh, int attIndex)
+bool DecodeMeshoptBufferView(
+  const MeshoptBufferView& meshoptView, const std::vector<char>& source, std::vector<char>& output)
 {
-  return ComponentDispatcher<VertexBufferDecoder>(
-    compType, mesh, mesh->GetAttributeByUniqueId(attIndex));
+  output.resize(meshoptView.Count * meshoptView.Stride);
+  if (meshoptView.SourceOffset + meshoptView.SourceLength > source.size())
+  {
+    return false;
+  }
+  const unsigned char* data =
+    reinterpret_cast<const unsigned char*>(source.data()) + meshoptView.SourceOffset;
+
+  int status = -1;
+  if (meshoptView.Mode == "ATTRIBUTES")
+  {
+    status = meshopt_decodeVertexBuffer(output.data(), meshoptView.Count, meshoptView.Stride, data,
+      meshoptView.SourceLength);
+  }
+  else if (meshoptView.Mode == "TRIANGLES")
+  {
+    status = meshopt_decodeIndexBuffer(output.data(), meshoptView.Count, meshoptView.Stride, data,
+      meshoptView.SourceLength);
+  }
+  else if (meshoptView.Mode == "INDICES")
+  {
+    status = meshopt_decodeIndexSequence(output.data(), meshoptView.Count, meshoptView.Stride,
+      data, meshoptView.SourceLength);
+  }
+  if (status != 0)
+  {
+    return false;
+  }
+
+  if (meshoptView.Filter == "OCTAHEDRAL")
+  {
+    meshopt_decodeFilterOct(output.data(), meshoptView.Count, meshoptView.Stride);
+  }
+  else if (meshoptView.Filter == "QUATERNION")
+  {
+    meshopt_decodeFilterQuat(output.data(), meshoptView.Count, meshoptView.Stride);
+  }
+  else if (meshoptView.Filter == "EXPONENTIAL")
+  {
+    meshopt_decodeFilterExp(output.data(), meshoptView.Count, meshoptView.Stride);
+  }
+  return true;
 }
+#endif
 }
 
 //----------------------------------------------------------------------------
@@ -108,6 +413,9 @@ std::vector<std::string> vtkF3DGLTFDocumentLoader::GetSupportedExtensions()
 {
   std::vector<std::string> extensions = this->Superclass::GetSupportedExtensions();
   extensions.emplace_back("KHR_draco_mesh_compression");
+#ifdef F3D_PLUGIN_DRACO_MESHOPT
+  extensions.emplace_back("EXT_meshopt_compression");
+#endif
   return extensions;
 }
 
@@ -116,6 +424,12 @@ void vtkF3DGLTFDocumentLoader::PrepareData()
 {
   std::shared_ptr<Model> model = this->GetInternalModel();
 
+#ifdef F3D_PLUGIN_DRACO_MESHOPT
+  this->DecodeMeshoptBuffers();
+#endif
+
+  // Allocate the decoded buffers first, so that they are not moved while decoding
+  std::vector<::DracoPrimitive> dracoPrimitives;
   for (size_t i = 0; i < model->Meshes.size(); i++)
   {
     for (Primitive& primitive : model->Meshes[i].Primitives)
@@ -124,59 +438,309 @@ void vtkF3DGLTFDocumentLoader::PrepareData()
       auto& dracoMetaData = primitive.ExtensionMetaData.KHRDracoMetaData;
       if (dracoMetaData.BufferView >= 0)
       {
-        auto& view = model->BufferViews[primitive.ExtensionMetaData.KHRDracoMetaData.BufferView];
-        auto& buffer = model->Buffers[view.Buffer];
+        ::DracoPrimitive dracoPrimitive;
+        dracoPrimitive.BufferView = dracoMetaData.BufferView;
+        if (primitive.IndicesId >= 0)
+        {
+          dracoPrimitive.IndicesAccessor = primitive.IndicesId;
+          dracoPrimitive.IndicesBuffer = static_cast<int>(model->Buffers.size());
+          model->Buffers.emplace_back();
+        }
+        for (const auto& attrib : dracoMetaData.AttributeIndices)
+        {
+          dracoPrimitive.Attributes.emplace_back(
+            primitive.AttributeIndices[attrib.first], attrib.second);
+          dracoPrimitive.AttributeBuffers.emplace_back(static_cast<int>(model->Buffers.size()));
+          model->Buffers.emplace_back();
+        }
+        dracoPrimitives.emplace_back(std::move(dracoPrimitive));
+      }
+    }
+  }
+
+  // Decode the primitives concurrently, straight into their buffers
+  vtkSMPTools::For(0, static_cast<vtkIdType>(dracoPrimitives.size()),
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType p = begin; p < end; p++)
+      {
+        ::DracoPrimitive& dracoPrimitive = dracoPrimitives[p];
+        const auto& view = model->BufferViews[dracoPrimitive.BufferView];
+        const auto& buffer = model->Buffers[view.Buffer];
 
         draco::DecoderBuffer decoderBuffer;
         decoderBuffer.Init(buffer.data() + view.ByteOffset, view.ByteLength);
         auto decodeResult = draco::Decoder().DecodeMeshFromBuffer(&decoderBuffer);
-        if (decodeResult.ok())
+        if (!decodeResult.ok())
         {
-          const std::unique_ptr<draco::Mesh>& mesh = decodeResult.value();
-
-          // handle index buffer
-          if (primitive.IndicesId >= 0)
-          {
-            auto& accessor = model->Accessors[primitive.IndicesId];
-
-            model->Buffers.emplace_back(::DecodeIndexBuffer(mesh, accessor.ComponentTypeValue));
-
-            vtkGLTFDocumentLoader::BufferView decodedIndexBufferView;
-            decodedIndexBufferView.Buffer = static_cast<int>(model->Buffers.size() - 1);
-            decodedIndexBufferView.ByteLength = model->Buffers.back().size();
-            decodedIndexBufferView.ByteOffset = 0;
-            decodedIndexBufferView.ByteStride = 0;
-            decodedIndexBufferView.Target =
-              static_cast<int>(vtkGLTFDocumentLoader::Target::ARRAY_BUFFER);
-            model->BufferViews.emplace_back(std::move(decodedIndexBufferView));
-
-            accessor.BufferView = static_cast<int>(model->BufferViews.size() - 1);
-            accessor.Count = static_cast<int>(mesh->num_faces() * 3);
-          }
-
-          // handle vertex attributes
-          for (const auto& attrib : dracoMetaData.AttributeIndices)
-          {
-            auto& attrAccessor = model->Accessors[primitive.AttributeIndices[attrib.first]];
-
-            model->Buffers.emplace_back(
-              ::DecodeVertexBuffer(attrAccessor.ComponentTypeValue, mesh, attrib.second));
-
-            vtkGLTFDocumentLoader::BufferView decodedBufferView;
-            decodedBufferView.Buffer = static_cast<int>(model->Buffers.size() - 1);
-            decodedBufferView.ByteLength = model->Buffers.back().size();
-            decodedBufferView.ByteOffset = 0;
-            decodedBufferView.ByteStride = 0;
-            decodedBufferView.Target =
-              static_cast<int>(vtkGLTFDocumentLoader::Target::ELEMENT_ARRAY_BUFFER);
-            model->BufferViews.emplace_back(std::move(decodedBufferView));
-
-            attrAccessor.BufferView = static_cast<int>(model->BufferViews.size() - 1);
-            attrAccessor.Count = static_cast<int>(mesh->num_points());
-            attrAccessor.ByteOffset = 0;
-          }
+          continue;
         }
+
+        const draco::Mesh& mesh = *decodeResult.value();
+        if (dracoPrimitive.IndicesAccessor >= 0)
+        {
+          ::DecodeIndexBuffer(mesh,
+            model->Accessors[dracoPrimitive.IndicesAccessor].ComponentTypeValue,
+            model->Buffers[dracoPrimitive.IndicesBuffer]);
+        }
+        for (size_t a = 0; a < dracoPrimitive.Attributes.size(); a++)
+        {
+          ::DecodeVertexBuffer(
+            model->Accessors[dracoPrimitive.Attributes[a].first].ComponentTypeValue, mesh,
+            dracoPrimitive.Attributes[a].second,
+            model->Buffers[dracoPrimitive.AttributeBuffers[a]]);
+        }
+        dracoPrimitive.Decoded = true;
+        dracoPrimitive.NbFaces = static_cast<int>(mesh.num_faces());
+        dracoPrimitive.NbPoints = static_cast<int>(mesh.num_points());
       }
+    });
+
+  // Point the accessors to the decoded buffers
+  auto addBufferView = [&](int bufferIndex, vtkGLTFDocumentLoader::Target target)
+  { return ::AddBufferView(*model, bufferIndex, target); };
+
+  for (const ::DracoPrimitive& dracoPrimitive : dracoPrimitives)
+  {
+    if (!dracoPrimitive.Decoded)
+    {
+      continue;
+    }
+
+    // handle index buffer
+    if (dracoPrimitive.IndicesAccessor >= 0)
+    {
+      auto& accessor = model->Accessors[dracoPrimitive.IndicesAccessor];
+      accessor.BufferView = addBufferView(
+        dracoPrimitive.IndicesBuffer, vtkGLTFDocumentLoader::Target::ARRAY_BUFFER);
+      accessor.Count = dracoPrimitive.NbFaces * 3;
+    }
+
+    // handle vertex attributes
+    for (size_t a = 0; a < dracoPrimitive.Attributes.size(); a++)
+    {
+      auto& attrAccessor = model->Accessors[dracoPrimitive.Attributes[a].first];
+      attrAccessor.BufferView = addBufferView(
+        dracoPrimitive.AttributeBuffers[a], vtkGLTFDocumentLoader::Target::ELEMENT_ARRAY_BUFFER);
+      attrAccessor.Count = dracoPrimitive.NbPoints;
+      attrAccessor.ByteOffset = 0;
+    }
+  }
+
+  this->DecodeAttributeAccessors();
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DGLTFDocumentLoader::DecodeAttributeAccessors()
+{
+  std::shared_ptr<Model> model = this->GetInternalModel();
+
+  // Collect the accessors of the attributes and morph targets that VTK would convert value by
+  // value, the accessors shared by several primitives are decoded once
+  std::vector<::AttributeAccessor> attributeAccessors;
+  std::vector<bool> collected(model->Accessors.size(), false);
+  auto collect = [&](int accessorIndex)
+  {
+    if (accessorIndex < 0 || accessorIndex >= static_cast<int>(model->Accessors.size()) ||
+      collected[accessorIndex])
+    {
+      return;
+    }
+    collected[accessorIndex] = true;
+
+    const Accessor& accessor = model->Accessors[accessorIndex];
+    if (accessor.IsSparse || accessor.BufferView < 0 ||
+      accessor.BufferView >= static_cast<int>(model->BufferViews.size()) || accessor.Count <= 0)
+    {
+      return;
+    }
+    const BufferView& view = model->BufferViews[accessor.BufferView];
+    if (view.Buffer < 0 || view.Buffer >= static_cast<int>(model->Buffers.size()))
+    {
+      return;
+    }
+
+    ::AttributeAccessor attributeAccessor;
+    attributeAccessor.Accessor = accessorIndex;
+    attributeAccessor.ComponentSize = ::GetComponentSize(accessor.ComponentTypeValue);
+    attributeAccessor.NbComponents = static_cast<size_t>(accessor.NumberOfComponents);
+    attributeAccessor.Count = static_cast<size_t>(accessor.Count);
+    attributeAccessor.Normalize = accessor.Normalized &&
+      accessor.ComponentTypeValue != vtkGLTFDocumentLoader::ComponentType::FLOAT;
+    if (attributeAccessor.ComponentSize == 0 || attributeAccessor.NbComponents == 0)
+    {
+      return;
+    }
+
+    const size_t elementSize = attributeAccessor.ComponentSize * attributeAccessor.NbComponents;
+    attributeAccessor.Stride =
+      view.ByteStride > 0 ? static_cast<size_t>(view.ByteStride) : elementSize;
+    if (!attributeAccessor.Normalize && attributeAccessor.Stride == elementSize)
+    {
+      // tightly packed values are already copied efficiently
+      return;
+    }
+
+    attributeAccessor.SourceOffset =
+      static_cast<size_t>(view.ByteOffset) + static_cast<size_t>(accessor.ByteOffset);
+    const size_t sourceEnd = attributeAccessor.SourceOffset +
+      (attributeAccessor.Count - 1) * attributeAccessor.Stride + elementSize;
+    attributeAccessor.Buffer = view.Buffer;
+    if (attributeAccessor.Stride < elementSize || sourceEnd > model->Buffers[view.Buffer].size())
+    {
+      return;
+    }
+
+    attributeAccessor.DecodedBuffer = static_cast<int>(model->Buffers.size());
+    model->Buffers.emplace_back();
+    attributeAccessors.emplace_back(attributeAccessor);
+  };
+
+  for (const Mesh& mesh : model->Meshes)
+  {
+    for (const Primitive& primitive : mesh.Primitives)
+    {
+      for (const auto& attribute : primitive.AttributeIndices)
+      {
+        collect(attribute.second);
+      }
+      for (const MorphTarget& target : primitive.Targets)
+      {
+        for (const auto& attribute : target.AttributeIndices)
+        {
+          collect(attribute.second);
+        }
+      }
+    }
+  }
+
+  // Decode the accessors concurrently, the loops over tightly packed values are vectorized
+  vtkSMPTools::For(0, static_cast<vtkIdType>(attributeAccessors.size()),
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType a = begin; a < end; a++)
+      {
+        ::AttributeAccessor& attributeAccessor = attributeAccessors[a];
+        attributeAccessor.Decoded = ::ComponentDispatcher<::AttributeDecoder>(
+          model->Accessors[attributeAccessor.Accessor].ComponentTypeValue, attributeAccessor,
+          model->Buffers[attributeAccessor.Buffer],
+          model->Buffers[attributeAccessor.DecodedBuffer]);
+      }
+    });
+
+  // Point the accessors to the tightly packed, and normalized, values
+  for (const ::AttributeAccessor& attributeAccessor : attributeAccessors)
+  {
+    if (!attributeAccessor.Decoded)
+    {
+      continue;
+    }
+
+    Accessor& accessor = model->Accessors[attributeAccessor.Accessor];
+    if (attributeAccessor.Normalize)
+    {
+      const double scale = ::GetNormalizationScale(accessor.ComponentTypeValue);
+      for (double& value : accessor.Min)
+      {
+        value = std::max(value * scale, -1.0);
+      }
+      for (double& value : accessor.Max)
+      {
+        value = std::max(value * scale, -1.0);
+      }
+      accessor.ComponentTypeValue = vtkGLTFDocumentLoader::ComponentType::FLOAT;
+      accessor.Normalized = false;
+    }
+    accessor.BufferView = ::AddBufferView(
+      *model, attributeAccessor.DecodedBuffer, vtkGLTFDocumentLoader::Target::ARRAY_BUFFER);
+    accessor.ByteOffset = 0;
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DGLTFDocumentLoader::ReleaseBuffers()
+{
+  std::shared_ptr<Model> model = this->GetInternalModel();
+  if (!model)
+  {
+    return;
+  }
+
+  // clear() keeps the capacity, swap with an empty buffer to free it
+  for (std::vector<char>& buffer : model->Buffers)
+  {
+    std::vector<char>().swap(buffer);
+  }
+}
+
+#ifdef F3D_PLUGIN_DRACO_MESHOPT
+//----------------------------------------------------------------------------
+void vtkF3DGLTFDocumentLoader::DecodeMeshoptBuffers()
+{
+  std::shared_ptr<Model> model = this->GetInternalModel();
+
+  nlohmann::json root = ::ReadGLTFJSON(*model);
+  if (!root.is_object() || !root.contains("bufferViews") || !root["bufferViews"].is_array())
+  {
+    return;
+  }
+
+  // Allocate the decoded buffers first, so that they are not moved while decoding
+  std::vector<::MeshoptBufferView> meshoptViews;
+  const nlohmann::json& bufferViews = root["bufferViews"];
+  for (size_t i = 0; i < bufferViews.size() && i < model->BufferViews.size(); i++)
+  {
+    const nlohmann::json& view = bufferViews[i];
+    if (!view.contains("extensions") || !view["extensions"].contains("EXT_meshopt_compression"))
+    {
+      continue;
+    }
+
+    const nlohmann::json& meshopt = view["extensions"]["EXT_meshopt_compression"];
+    ::MeshoptBufferView meshoptView;
+    meshoptView.BufferView = static_cast<int>(i);
+    meshoptView.Buffer = meshopt.value("buffer", -1);
+    meshoptView.SourceOffset = meshopt.value("byteOffset", size_t(0));
+    meshoptView.SourceLength = meshopt.value("byteLength", size_t(0));
+    meshoptView.Count = meshopt.value("count", size_t(0));
+    meshoptView.Stride = meshopt.value("byteStride", size_t(0));
+    meshoptView.Mode = meshopt.value("mode", std::string());
+    meshoptView.Filter = meshopt.value("filter", std::string("NONE"));
+    if (meshoptView.Buffer < 0 || meshoptView.Buffer >= static_cast<int>(model->Buffers.size()))
+    {
+      vtkWarningMacro("Invalid EXT_meshopt_compression buffer in buffer view " << i);
+      continue;
+    }
+    meshoptView.DecodedBuffer = static_cast<int>(model->Buffers.size());
+    model->Buffers.emplace_back();
+    meshoptViews.emplace_back(std::move(meshoptView));
+  }
+
+  // meshopt decoders are vectorized, also decode the buffer views concurrently
+  vtkSMPTools::For(0, static_cast<vtkIdType>(meshoptViews.size()),
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType v = begin; v < end; v++)
+      {
+        ::MeshoptBufferView& meshoptView = meshoptViews[v];
+        meshoptView.Decoded = ::DecodeMeshoptBufferView(meshoptView,
+          model->Buffers[meshoptView.Buffer], model->Buffers[meshoptView.DecodedBuffer]);
+      }
+    });
+
+  // Point the buffer views to the decoded buffers
+  for (const ::MeshoptBufferView& meshoptView : meshoptViews)
+  {
+    if (!meshoptView.Decoded)
+    {
+      vtkWarningMacro(
+        "Cannot decode EXT_meshopt_compression buffer view " << meshoptView.BufferView);
+      continue;
     }
+    BufferView& view = model->BufferViews[meshoptView.BufferView];
+    view.Buffer = meshoptView.DecodedBuffer;
+    view.ByteOffset = 0;
+    view.ByteLength = static_cast<int>(meshoptView.Count * meshoptView.Stride);
   }
 }
+#endif
@@ -2,7 +2,10 @@
  * @class   vtkF3DGLTFDocumentLoader
  * @brief   Specialized GLTF document loader with Draco buffer decoding
  *
- * This class subclasses vtkGLTFDocumentLoader to handle Draco metadata
+ * This class subclasses vtkGLTFDocumentLoader to handle Draco metadata.
+ * When built with meshoptimizer, EXT_meshopt_compression buffer views are also decoded.
+ * The normalized and interleaved attributes are decoded concurrently before VTK builds its arrays.
+ * The buffers can be released once the VTK objects are built, see ReleaseBuffers.
  */
 
 #ifndef vtkF3DGLTFDocumentLoader_h
@@ -17,7 +20,8 @@ public:
   vtkTypeMacro(vtkF3DGLTFDocumentLoader, vtkGLTFDocumentLoader);
 
   /**
-   * Overridden to add KHR_draco_mesh_compression support
+   * Overridden to add KHR_draco_mesh_compression support, and EXT_meshopt_compression support
+   * when built with meshoptimizer
    */
   std::vector<std::string> GetSupportedExtensions() override;
 
@@ -28,6 +32,14 @@ public:
    */
   void PrepareData() override;
 
+  /**
+   * Free the content of the buffers of the model, including the decoded ones.
+   * The geometry, images and animations copy the accessors they use into their own arrays,
+   * so the buffers are not needed anymore once they are built.
+   * The number of buffers is kept so that the buffer views stay valid.
+   */
+  void ReleaseBuffers();
+
 protected:
   vtkF3DGLTFDocumentLoader() = default;
   ~vtkF3DGLTFDocumentLoader() override = default;
@@ -35,6 +47,23 @@ protected:
 private:
   vtkF3DGLTFDocumentLoader(const vtkF3DGLTFDocumentLoader&) = delete;
   void operator=(const vtkF3DGLTFDocumentLoader&) = delete;
+
+  /**
+   * Decode the attributes and morph targets accessors with normalized integers or interleaved
+   * values into new tightly packed buffers, concurrently, and point the accessors to them.
+   * The normalized integers are converted to floats, like VTK would do value by value,
+   * so that VTK only copies contiguous values into its arrays. Done after decoding the Draco
+   * primitives.
+   */
+  void DecodeAttributeAccessors();
+
+#ifdef F3D_PLUGIN_DRACO_MESHOPT
+  /**
+   * Decode the EXT_meshopt_compression buffer views into new buffers, and point the buffer views
+   * to them. Done before decoding the Draco primitives.
+   */
+  void DecodeMeshoptBuffers();
+#endif
 };
 
 #endif
@@ -12,3 +12,19 @@ void vtkF3DGLTFImporter::InitializeLoader()
 {
   this->Loader = vtkSmartPointer<vtkF3DGLTFDocumentLoader>::New();
 }
+
+//----------------------------------------------------------------------------
+int vtkF3DGLTFImporter::ImportBegin()
+{
+  if (!this->Superclass::ImportBegin())
+  {
+    return 0;
+  }
+
+  vtkF3DGLTFDocumentLoader* loader = vtkF3DGLTFDocumentLoader::SafeDownCast(this->Loader);
+  if (loader)
+  {
+    loader->ReleaseBuffers();
+  }
+  return 1;
+}
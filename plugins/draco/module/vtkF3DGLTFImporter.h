@@ -3,6 +3,8 @@
  * @brief   VTK GLTF importer with Draco support
  *
  * Subclasses the native importer to initialize our own loader.
+ * The buffers of the loader are released once the scene is imported, so that the content of
+ * large files is not kept in memory next to the VTK arrays built from it.
  * @sa vtkF3DGLTFDocumentLoader
  */
 
@@ -26,6 +28,11 @@ protected:
    */
   void InitializeLoader() override;
 
+  /**
+   * Overridden to release the buffers of the loader once the VTK objects are built
+   */
+  int ImportBegin() override;
+
 private:
   vtkF3DGLTFImporter(const vtkF3DGLTFImporter&) = delete;
   void operator=(const vtkF3DGLTFImporter&) = delete;
@@ -5,3 +5,26 @@ void applyCustomReader(vtkAlgorithm* algo, const std::string&) const override
   exReader->SetAllArrayStatus(vtkExodusIIReader::NODAL, 1);
   exReader->SetAllArrayStatus(vtkExodusIIReader::ELEM_BLOCK, 1);
 }
+
+bool selectArrays(vtkAlgorithm* algo, const std::vector<std::string>& arrayNames) const override
+{
+  vtkExodusIIReader* exReader = vtkExodusIIReader::SafeDownCast(algo);
+  for (int type : { vtkExodusIIReader::NODAL, vtkExodusIIReader::ELEM_BLOCK })
+  {
+    for (int i = 0; i < exReader->GetNumberOfObjectArrays(type); i++)
+    {
+      std::string name = exReader->GetObjectArrayName(type, i);
+
+      // Displacements are applied by the reader and only read if their array is enabled
+      std::string prefix = name.substr(0, 3);
+      std::transform(prefix.begin(), prefix.end(), prefix.begin(), ::tolower);
+      bool displacement =
+        type == vtkExodusIIReader::NODAL && exReader->GetApplyDisplacements() && prefix == "dis";
+
+      bool selected = displacement ||
+        std::find(arrayNames.begin(), arrayNames.end(), name) != arrayNames.end();
+      exReader->SetObjectArrayStatus(type, name.c_str(), selected ? 1 : 0);
+    }
+  }
+  return true;
+}
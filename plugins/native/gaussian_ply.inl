@@ -0,0 +1,18 @@
+bool canRead(const std::string& fileName) const override
+{
+  // Other .ply files are read by the PLYReader
+  return vtkF3DSplatReader::IsGaussianPLYFile(fileName);
+}
+
+bool canReadFromMemory() const override
+{
+  return true;
+}
+
+vtkSmartPointer<vtkAlgorithm> createGeometryReaderFromMemory(
+  const void* buffer, size_t size) const override
+{
+  vtkNew<vtkF3DSplatReader> splatReader;
+  splatReader->SetBuffer(buffer, size);
+  return splatReader;
+}
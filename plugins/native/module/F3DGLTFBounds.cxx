@@ -0,0 +1,86 @@
+#include "F3DGLTFBounds.h"
+
+#include <vtkBoundingBox.h>
+#include <vtkGLTFDocumentLoader.h>
+#include <vtkMatrix4x4.h>
+#include <vtkNew.h>
+
+#include <vector>
+
+//----------------------------------------------------------------------------
+bool F3DGLTFBounds::Probe(const std::string& fileName, double bounds[6])
+{
+  vtkNew<vtkGLTFDocumentLoader> loader;
+  if (!loader->LoadModelMetaDataFromFile(fileName))
+  {
+    return false;
+  }
+  loader->BuildGlobalTransforms();
+  const std::shared_ptr<vtkGLTFDocumentLoader::Model> model = loader->GetInternalModel();
+
+  // the nodes of the default scene, or of the first one
+  std::vector<int> nodes;
+  if (!model->Scenes.empty())
+  {
+    const int scene = model->DefaultScene >= 0 &&
+        model->DefaultScene < static_cast<int>(model->Scenes.size())
+      ? model->DefaultScene
+      : 0;
+    nodes.assign(model->Scenes[scene].Nodes.begin(), model->Scenes[scene].Nodes.end());
+  }
+
+  vtkBoundingBox box;
+  std::vector<bool> visited(model->Nodes.size(), false);
+  while (!nodes.empty())
+  {
+    const int index = nodes.back();
+    nodes.pop_back();
+    if (index < 0 || index >= static_cast<int>(model->Nodes.size()) || visited[index])
+    {
+      continue;
+    }
+    visited[index] = true;
+
+    const vtkGLTFDocumentLoader::Node& node = model->Nodes[index];
+    nodes.insert(nodes.end(), node.Children.begin(), node.Children.end());
+    if (node.Mesh < 0 || node.Mesh >= static_cast<int>(model->Meshes.size()))
+    {
+      continue;
+    }
+
+    for (const vtkGLTFDocumentLoader::Primitive& primitive : model->Meshes[node.Mesh].Primitives)
+    {
+      auto position = primitive.AttributeIndices.find("POSITION");
+      if (position == primitive.AttributeIndices.end() || position->second < 0 ||
+        position->second >= static_cast<int>(model->Accessors.size()))
+      {
+        continue;
+      }
+      const vtkGLTFDocumentLoader::Accessor& accessor = model->Accessors[position->second];
+      if (accessor.Min.size() != 3 || accessor.Max.size() != 3)
+      {
+        continue;
+      }
+
+      // the box of the positions is transformed by its corners
+      for (int corner = 0; corner < 8; corner++)
+      {
+        double point[4] = { corner & 1 ? accessor.Max[0] : accessor.Min[0],
+          corner & 2 ? accessor.Max[1] : accessor.Min[1],
+          corner & 4 ? accessor.Max[2] : accessor.Min[2], 1.0 };
+        if (node.GlobalTransform)
+        {
+          node.GlobalTransform->MultiplyPoint(point, point);
+        }
+        box.AddPoint(point);
+      }
+    }
+  }
+
+  if (!box.IsValid())
+  {
+    return false;
+  }
+  box.GetBounds(bounds);
+  return true;
+}
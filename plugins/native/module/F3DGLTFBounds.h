@@ -0,0 +1,25 @@
+/**
+ * @class F3DGLTFBounds
+ * @brief Recover the bounds of a glTF file from its metadata
+ *
+ * Only the JSON document is read, the buffers are not. The POSITION accessors of the
+ * primitives have mandatory min and max values, their corners are transformed by the global
+ * transform of the nodes of the default scene. Skinning, morph targets and animations are
+ * ignored.
+ */
+#ifndef F3DGLTFBounds_h
+#define F3DGLTFBounds_h
+
+#include <string>
+
+class F3DGLTFBounds
+{
+public:
+  /**
+   * Compute the bounds of the meshes of the default scene of a .gltf or .glb file.
+   * Return false if the document cannot be read or if it has no bounded mesh.
+   */
+  static bool Probe(const std::string& fileName, double bounds[6]);
+};
+
+#endif
@@ -0,0 +1,109 @@
+#include "F3DMappedFile.h"
+
+#ifdef _WIN32
+#include <vtksys/Encoding.hxx>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+//----------------------------------------------------------------------------
+F3DMappedFile::~F3DMappedFile()
+{
+  this->Close();
+}
+
+//----------------------------------------------------------------------------
+bool F3DMappedFile::Open(const std::string& fileName)
+{
+  this->Close();
+#ifdef _WIN32
+  HANDLE file = CreateFileW(vtksys::Encoding::ToWindowsExtendedPath(fileName).c_str(),
+    GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+  {
+    return false;
+  }
+  LARGE_INTEGER size;
+  HANDLE mapping = nullptr;
+  if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+  {
+    mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  }
+  CloseHandle(file);
+  if (!mapping)
+  {
+    return false;
+  }
+  void* memory = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  CloseHandle(mapping);
+  if (!memory)
+  {
+    return false;
+  }
+  this->Size = static_cast<size_t>(size.QuadPart);
+#else
+  int fd = open(fileName.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    return false;
+  }
+  struct stat st;
+  void* memory = MAP_FAILED;
+  if (fstat(fd, &st) == 0 && st.st_size > 0)
+  {
+    memory = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+  }
+  close(fd);
+  if (memory == MAP_FAILED)
+  {
+    return false;
+  }
+  this->Size = static_cast<size_t>(st.st_size);
+
+  // the threads parse contiguous ranges, let the kernel read ahead
+  madvise(memory, this->Size, MADV_WILLNEED);
+#endif
+  this->Data = static_cast<const char*>(memory);
+  this->Mapped = true;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void F3DMappedFile::Open(const void* buffer, size_t size)
+{
+  this->Close();
+  this->Data = static_cast<const char*>(buffer);
+  this->Size = size;
+}
+
+//----------------------------------------------------------------------------
+void F3DMappedFile::Close()
+{
+  if (this->Mapped)
+  {
+#ifdef _WIN32
+    UnmapViewOfFile(this->Data);
+#else
+    munmap(const_cast<char*>(this->Data), this->Size);
+#endif
+  }
+  this->Data = nullptr;
+  this->Size = 0;
+  this->Mapped = false;
+}
+
+//----------------------------------------------------------------------------
+const char* F3DMappedFile::GetData() const
+{
+  return this->Data;
+}
+
+//----------------------------------------------------------------------------
+size_t F3DMappedFile::GetSize() const
+{
+  return this->Size;
+}
@@ -0,0 +1,57 @@
+/**
+ * @class F3DMappedFile
+ * @brief A read only view of a file mapped in memory, or of a buffer
+ *
+ * The file is mapped with mmap or MapViewOfFile so that the readers of the native plugin parse
+ * it in place, from several threads, without copying it in a buffer first.
+ * A buffer in memory can be used instead of a file, it is not copied and must be kept alive
+ * while the view is used.
+ */
+#ifndef F3DMappedFile_h
+#define F3DMappedFile_h
+
+#include <cstddef>
+#include <string>
+
+class F3DMappedFile
+{
+public:
+  F3DMappedFile() = default;
+  ~F3DMappedFile();
+
+  /**
+   * Map the file in memory.
+   * Return false if it cannot be mapped, eg. if it does not exist or if it is empty.
+   */
+  bool Open(const std::string& fileName);
+
+  /**
+   * Use a buffer in memory instead of a file
+   */
+  void Open(const void* buffer, size_t size);
+
+  /**
+   * Unmap the file, if any
+   */
+  void Close();
+
+  /**
+   * Return the first byte of the view, nullptr if nothing is opened
+   */
+  const char* GetData() const;
+
+  /**
+   * Return the size of the view in bytes
+   */
+  size_t GetSize() const;
+
+private:
+  F3DMappedFile(const F3DMappedFile&) = delete;
+  void operator=(const F3DMappedFile&) = delete;
+
+  const char* Data = nullptr;
+  size_t Size = 0;
+  bool Mapped = false;
+};
+
+#endif
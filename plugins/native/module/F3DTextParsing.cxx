@@ -0,0 +1,59 @@
+#include "F3DTextParsing.h"
+
+#include <vtkSMPTools.h>
+
+#include <algorithm>
+
+namespace
+{
+// size of the chunks parsed by each thread, cut at the end of a line
+constexpr size_t CHUNK_SIZE = 1 << 20;
+}
+
+//----------------------------------------------------------------------------
+std::vector<F3DTextParsing::Chunk> F3DTextParsing::SplitLines(const char* begin, const char* end)
+{
+  std::vector<Chunk> chunks;
+  const char* cur = begin;
+  while (cur != end)
+  {
+    const char* chunkEnd =
+      static_cast<size_t>(end - cur) > ::CHUNK_SIZE ? cur + ::CHUNK_SIZE : end;
+    chunkEnd = chunkEnd == end ? end : F3DTextParsing::NextLine(chunkEnd, end);
+    chunks.push_back({ cur, chunkEnd, 0 });
+    cur = chunkEnd;
+  }
+
+  std::vector<vtkIdType> nbLines(chunks.size());
+  vtkSMPTools::For(0, static_cast<vtkIdType>(chunks.size()),
+    [&](vtkIdType first, vtkIdType last)
+    {
+      for (vtkIdType i = first; i < last; i++)
+      {
+        nbLines[i] = std::count(chunks[i].Begin, chunks[i].End, '\n');
+      }
+    });
+
+  vtkIdType line = 0;
+  for (size_t i = 0; i < chunks.size(); i++)
+  {
+    chunks[i].FirstLine = line;
+    line += nbLines[i];
+  }
+  return chunks;
+}
+
+//----------------------------------------------------------------------------
+const char* F3DTextParsing::SkipLines(const char* begin, const char* end, vtkIdType count)
+{
+  const char* cur = begin;
+  for (vtkIdType i = 0; i < count; i++)
+  {
+    if (cur == end)
+    {
+      return nullptr;
+    }
+    cur = F3DTextParsing::NextLine(cur, end);
+  }
+  return cur;
+}
@@ -0,0 +1,150 @@
+/**
+ * @class F3DTextParsing
+ * @brief Helpers to parse the text based mesh formats in place and from several threads
+ *
+ * The text is split in chunks of whole lines that can be parsed concurrently, the first line
+ * of each chunk being known so that the parsed values are written directly at their place.
+ * Numbers are parsed with std::from_chars, which does not depend on the locale and is much
+ * faster than the streams. The standard libraries that do not provide it for floating point
+ * values fall back to std::strtod.
+ */
+#ifndef F3DTextParsing_h
+#define F3DTextParsing_h
+
+#include <vtkType.h>
+
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+class F3DTextParsing
+{
+public:
+  /**
+   * A range of whole lines of the text
+   */
+  struct Chunk
+  {
+    const char* Begin;
+    const char* End;
+    vtkIdType FirstLine;
+  };
+
+  /**
+   * Split the text in chunks of whole lines, counting the lines concurrently.
+   * The returned chunks cover the whole text, the last line may not end with a new line.
+   */
+  static std::vector<Chunk> SplitLines(const char* begin, const char* end);
+
+  /**
+   * Return the beginning of the line following count lines, nullptr if there are less lines.
+   * The last line may not end with a new line.
+   */
+  static const char* SkipLines(const char* begin, const char* end, vtkIdType count);
+
+  /**
+   * Return the beginning of the next line
+   */
+  static inline const char* NextLine(const char* cur, const char* end)
+  {
+    const char* eol = static_cast<const char*>(std::memchr(cur, '\n', end - cur));
+    return eol ? eol + 1 : end;
+  }
+
+  /**
+   * Skip the spaces and the tabulations, but not the end of the line
+   */
+  static inline const char* SkipSpaces(const char* cur, const char* end)
+  {
+    while (cur != end && (*cur == ' ' || *cur == '\t'))
+    {
+      ++cur;
+    }
+    return cur;
+  }
+
+  /**
+   * Skip the spaces and return true if the line continues with the keyword followed by a space
+   */
+  static inline bool StartsWith(const char*& cur, const char* end, const char* keyword)
+  {
+    cur = F3DTextParsing::SkipSpaces(cur, end);
+    const size_t length = std::strlen(keyword);
+    if (static_cast<size_t>(end - cur) <= length || std::memcmp(cur, keyword, length) != 0 ||
+      (cur[length] != ' ' && cur[length] != '\t'))
+    {
+      return false;
+    }
+    cur += length;
+    return true;
+  }
+
+  /**
+   * Skip the spaces and parse a number, advancing cur after it.
+   * Return false if there is no number.
+   */
+  template<typename T>
+  static inline bool Parse(const char*& cur, const char* end, T& value)
+  {
+    cur = F3DTextParsing::SkipSpaces(cur, end);
+    if (cur != end && *cur == '+')
+    {
+      ++cur;
+    }
+#if defined(__cpp_lib_to_chars)
+    constexpr bool fromChars = true;
+#else
+    constexpr bool fromChars = !std::is_floating_point_v<T>;
+#endif
+    if constexpr (!fromChars)
+    {
+      return F3DTextParsing::ParseWithStrtod(cur, end, value);
+    }
+    else
+    {
+      std::from_chars_result result = std::from_chars(cur, end, value);
+      if (result.ec == std::errc::invalid_argument)
+      {
+        return false;
+      }
+      if (result.ec == std::errc::result_out_of_range)
+      {
+        // denormalized values
+        value = 0;
+      }
+      cur = result.ptr;
+      return true;
+    }
+  }
+
+private:
+  /**
+   * Parse a floating point value with std::strtod, which needs a null terminated string
+   */
+  template<typename T>
+  static bool ParseWithStrtod(const char*& cur, const char* end, T& value)
+  {
+    char token[64];
+    size_t length = 0;
+    while (cur + length != end && length < sizeof(token) - 1 && cur[length] != ' ' &&
+      cur[length] != '\t' && cur[length] != '\r' && cur[length] != '\n' && cur[length] != '/')
+    {
+      token[length] = cur[length];
+      ++length;
+    }
+    token[length] = '\0';
+
+    char* parsed = nullptr;
+    value = static_cast<T>(std::strtod(token, &parsed));
+    if (parsed == token)
+    {
+      return false;
+    }
+    cur += parsed - token;
+    return true;
+  }
+};
+
+#endif
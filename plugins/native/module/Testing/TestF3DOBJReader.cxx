@@ -0,0 +1,130 @@
+#include <vtkCellArray.h>
+#include <vtkDataArray.h>
+#include <vtkIdList.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkPolyData.h>
+#include <vtkTestUtilities.h>
+
+#include "vtkF3DOBJReader.h"
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+namespace
+{
+vtkSmartPointer<vtkPolyData> ReadFromMemory(const std::string& content)
+{
+  vtkNew<vtkF3DOBJReader> reader;
+  reader->SetBuffer(content.data(), content.size());
+  reader->Update();
+  return reader->GetOutput();
+}
+
+bool CheckFace(vtkPolyData* output, vtkIdType cellId, const vtkIdType expected[3])
+{
+  vtkNew<vtkIdList> ids;
+  output->GetPolys()->GetCellAtId(cellId, ids);
+  return ids->GetNumberOfIds() == 3 && ids->GetId(0) == expected[0] &&
+    ids->GetId(1) == expected[1] && ids->GetId(2) == expected[2];
+}
+}
+
+int TestF3DOBJReader(int vtkNotUsed(argc), char* argv[])
+{
+  // relative indices are resolved from the vertices read so far
+  const std::string relative = "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\nv 0 0 1\nf -4 -2 -1\nl 1 -1\n";
+  vtkSmartPointer<vtkPolyData> output = ::ReadFromMemory(relative);
+  const vtkIdType firstFace[3] = { 0, 1, 2 };
+  const vtkIdType secondFace[3] = { 0, 2, 3 };
+  if (output->GetNumberOfPoints() != 4 || output->GetNumberOfPolys() != 2 ||
+    output->GetNumberOfLines() != 1 || !::CheckFace(output, 0, firstFace) ||
+    !::CheckFace(output, 1, secondFace))
+  {
+    std::cerr << "Relative indices are not resolved correctly" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // the same indices for all the attributes share the points
+  const std::string shared = "v 0 0 0\nv 1 0 0\nv 0 1 0\nvn 0 0 1\nvn 0 0 1\nvn 0 0 1\n"
+                             "vt 0 0\nvt 1 0\nvt 0 1\nf 1/1/1 2/2/2 3/3/3\n";
+  output = ::ReadFromMemory(shared);
+  if (output->GetNumberOfPoints() != 3 || !output->GetPointData()->GetNormals() ||
+    !output->GetPointData()->GetTCoords() || !::CheckFace(output, 0, firstFace))
+  {
+    std::cerr << "Faces with the same indices do not share the points" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // separate indices give each face corner its own point, after the vertices
+  const std::string separate = "v 0 0 0\nv 1 0 0\nv 0 1 0\nvn 0 0 1\nvt 0.5 0.5\n"
+                               "f 1/1/1 2/1/1 3/1/1\nf -1//-1 -3//-1 -2//-1\n";
+  output = ::ReadFromMemory(separate);
+  const vtkIdType separateFace[3] = { 6, 7, 8 };
+  double point[3];
+  output->GetPoint(6, point);
+  if (output->GetNumberOfPoints() != 9 || output->GetNumberOfPolys() != 2 ||
+    !output->GetPointData()->GetNormals() || !output->GetPointData()->GetTCoords() ||
+    !::CheckFace(output, 1, separateFace) || point[0] != 0 || point[1] != 1)
+  {
+    std::cerr << "Faces with separate indices are not read correctly" << std::endl;
+    return EXIT_FAILURE;
+  }
+  double tcoord[2];
+  output->GetPointData()->GetTCoords()->GetTuple(3, tcoord);
+  if (tcoord[0] != 0.5 || tcoord[1] != 0.5)
+  {
+    std::cerr << "Texture coordinates of separate indices are wrong" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // reading the file gives the same output as reading from memory
+  const std::string filename = std::string(argv[2]) + "TestF3DOBJReader.obj";
+  {
+    std::ofstream file(filename, std::ios::binary);
+    file << separate;
+  }
+  vtkNew<vtkF3DOBJReader> reader;
+  reader->SetFileName(filename);
+  reader->Update();
+  if (reader->GetOutput()->GetNumberOfPoints() != output->GetNumberOfPoints() ||
+    reader->GetOutput()->GetNumberOfCells() != output->GetNumberOfCells())
+  {
+    std::cerr << "Reading the file does not give the same output as reading from memory"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // the material libraries are detected anywhere in the file, whatever their name
+  const std::string materialFilename = std::string(argv[2]) + "TestF3DOBJReaderMaterial.obj";
+  {
+    std::ofstream file(materialFilename, std::ios::binary);
+    file << "mtllib TestF3DOBJReaderMaterial.mtl\n" << separate;
+  }
+  const std::string lateFilename = std::string(argv[2]) + "TestF3DOBJReaderLateMaterial.obj";
+  {
+    std::ofstream file(lateFilename, std::ios::binary);
+    for (int i = 0; i < 200; i++)
+    {
+      file << "# a long comment header, longer than the first blocks of the file\n";
+    }
+    file << separate << "mtllib materials/another_name.mtl\n";
+  }
+  const std::string usedFilename = std::string(argv[2]) + "TestF3DOBJReaderUsedMaterial.obj";
+  {
+    std::ofstream file(usedFilename, std::ios::binary);
+    file << "v 0 0 0\nv 1 0 0\nv 0 1 0\nusemtl red\nf 1 2 3\n";
+  }
+  if (vtkF3DOBJReader::HasMaterialLibrary(filename) ||
+    !vtkF3DOBJReader::HasMaterialLibrary(materialFilename) ||
+    !vtkF3DOBJReader::HasMaterialLibrary(lateFilename) ||
+    !vtkF3DOBJReader::HasMaterialLibrary(usedFilename) ||
+    vtkF3DOBJReader::HasMaterialLibrary(std::string(argv[2]) + "missing.obj"))
+  {
+    std::cerr << "Material libraries are not detected correctly" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
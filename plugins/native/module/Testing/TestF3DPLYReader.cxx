@@ -0,0 +1,142 @@
+#include <vtkCellArray.h>
+#include <vtkDataArray.h>
+#include <vtkIdList.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkPolyData.h>
+#include <vtkTestUtilities.h>
+
+#include "vtkF3DPLYReader.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+namespace
+{
+vtkSmartPointer<vtkPolyData> ReadFromMemory(const std::string& content)
+{
+  vtkNew<vtkF3DPLYReader> reader;
+  reader->SetBuffer(content.data(), content.size());
+  reader->Update();
+  return reader->GetOutput();
+}
+
+// append the bytes of a value with the most significant one first
+template<typename T>
+void AppendBigEndian(std::string& content, T value)
+{
+  char bytes[sizeof(T)];
+  std::memcpy(bytes, &value, sizeof(T));
+  const uint16_t one = 1;
+  if (*reinterpret_cast<const unsigned char*>(&one) == 1)
+  {
+    std::reverse(bytes, bytes + sizeof(T));
+  }
+  content.append(bytes, sizeof(T));
+}
+
+bool CheckOutput(vtkPolyData* output, const std::string& format)
+{
+  const double expectedBounds[6] = { -1, 2, 0, 3, 0.5, 0.5 };
+  double bounds[6];
+  output->GetBounds(bounds);
+  for (int i = 0; i < 6; i++)
+  {
+    if (bounds[i] != expectedBounds[i])
+    {
+      std::cerr << "Wrong bounds reading the " << format << " file" << std::endl;
+      return false;
+    }
+  }
+
+  vtkDataArray* colors = output->GetPointData()->GetArray("RGB");
+  vtkNew<vtkIdList> ids;
+  if (output->GetNumberOfPoints() != 4 || output->GetNumberOfPolys() != 2 || !colors ||
+    colors->GetComponent(3, 2) != 200)
+  {
+    std::cerr << "Wrong points or colors reading the " << format << " file" << std::endl;
+    return false;
+  }
+  output->GetPolys()->GetCellAtId(1, ids);
+  if (ids->GetNumberOfIds() != 3 || ids->GetId(0) != 2 || ids->GetId(1) != 3 ||
+    ids->GetId(2) != 0)
+  {
+    std::cerr << "Wrong faces reading the " << format << " file" << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestF3DPLYReader(int vtkNotUsed(argc), char* argv[])
+{
+  const float points[4][3] = { { -1, 0, 0.5 }, { 2, 0, 0.5 }, { 2, 3, 0.5 }, { -1, 3, 0.5 } };
+  const unsigned char colors[4][3] = { { 0, 0, 0 }, { 255, 0, 0 }, { 0, 255, 0 }, { 0, 0, 200 } };
+  const int32_t faces[2][3] = { { 0, 1, 2 }, { 2, 3, 0 } };
+
+  std::string header = "element vertex 4\nproperty float x\nproperty float y\nproperty float z\n"
+                       "property uchar red\nproperty uchar green\nproperty uchar blue\n"
+                       "element face 2\nproperty list uchar int vertex_indices\nend_header\n";
+
+  std::string ascii = "ply\nformat ascii 1.0\n" + header;
+  std::string binary = "ply\nformat binary_big_endian 1.0\n" + header;
+  for (int i = 0; i < 4; i++)
+  {
+    for (int c = 0; c < 3; c++)
+    {
+      ascii += std::to_string(points[i][c]) + " ";
+      ::AppendBigEndian(binary, points[i][c]);
+    }
+    for (int c = 0; c < 3; c++)
+    {
+      ascii += std::to_string(colors[i][c]) + " ";
+      binary += static_cast<char>(colors[i][c]);
+    }
+    ascii += "\n";
+  }
+  for (const int32_t* face : faces)
+  {
+    ascii += "3";
+    binary += static_cast<char>(3);
+    for (int c = 0; c < 3; c++)
+    {
+      ascii += " " + std::to_string(face[c]);
+      ::AppendBigEndian(binary, face[c]);
+    }
+    ascii += "\n";
+  }
+
+  if (!::CheckOutput(::ReadFromMemory(ascii), "ASCII") ||
+    !::CheckOutput(::ReadFromMemory(binary), "binary big endian"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // the file gives the same output, and its bounds can be probed without reading it
+  const std::string filename = std::string(argv[2]) + "TestF3DPLYReader.ply";
+  {
+    std::ofstream file(filename, std::ios::binary);
+    file << binary;
+  }
+  vtkNew<vtkF3DPLYReader> reader;
+  reader->SetFileName(filename);
+  reader->Update();
+  if (!::CheckOutput(reader->GetOutput(), "binary big endian on disk"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  double bounds[6];
+  if (!vtkF3DPLYReader::ProbeBounds(filename, bounds) || bounds[0] != -1 || bounds[1] != 2 ||
+    bounds[3] != 3)
+  {
+    std::cerr << "Wrong probed bounds" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,116 @@
+#include <vtkNew.h>
+#include <vtkPolyData.h>
+#include <vtkTestUtilities.h>
+
+#include "vtkF3DSTLReader.h"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+namespace
+{
+bool CheckOutput(vtkPolyData* output, const std::string& format)
+{
+  const double expectedBounds[6] = { 0, 1, 0, 2, -1, 0 };
+  double bounds[6];
+  output->GetBounds(bounds);
+  for (int i = 0; i < 6; i++)
+  {
+    if (bounds[i] != expectedBounds[i])
+    {
+      std::cerr << "Wrong bounds reading the " << format << " file" << std::endl;
+      return false;
+    }
+  }
+
+  // each triangle has its own points
+  if (output->GetNumberOfPoints() != 6 || output->GetNumberOfPolys() != 2)
+  {
+    std::cerr << "Wrong triangles reading the " << format << " file" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+// append the bytes of a 4 bytes value with the least significant one first
+template<typename T>
+void AppendLittleEndian(std::string& content, T value)
+{
+  static_assert(sizeof(T) == 4, "Only 4 bytes values are used by STL files");
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  for (int i = 0; i < 4; i++)
+  {
+    content += static_cast<char>((bits >> (8 * i)) & 0xFF);
+  }
+}
+}
+
+int TestF3DSTLReader(int vtkNotUsed(argc), char* argv[])
+{
+  const float triangles[2][3][3] = { { { 0, 0, 0 }, { 1, 0, 0 }, { 0, 2, 0 } },
+    { { 0, 0, -1 }, { 1, 0, -1 }, { 0, 2, -1 } } };
+
+  std::string ascii = "solid test\n";
+  std::string binary(80, '\0');
+  ::AppendLittleEndian(binary, static_cast<uint32_t>(2));
+  for (const auto& triangle : triangles)
+  {
+    ascii += "  facet normal 0 0 1\n    outer loop\n";
+    for (int c = 0; c < 3; c++)
+    {
+      ::AppendLittleEndian(binary, c == 2 ? 1.f : 0.f);
+    }
+    for (const float* vertex : triangle)
+    {
+      ascii += "      vertex " + std::to_string(vertex[0]) + " " + std::to_string(vertex[1]) +
+        " " + std::to_string(vertex[2]) + "\n";
+      for (int c = 0; c < 3; c++)
+      {
+        ::AppendLittleEndian(binary, vertex[c]);
+      }
+    }
+    ascii += "    endloop\n  endfacet\n";
+    binary.append(2, '\0');
+  }
+  ascii += "endsolid test\n";
+
+  // the same content is read from memory and from the files
+  const std::string formats[2] = { "ascii", "binary" };
+  const std::string contents[2] = { ascii, binary };
+  for (int f = 0; f < 2; f++)
+  {
+    vtkNew<vtkF3DSTLReader> memoryReader;
+    memoryReader->SetBuffer(contents[f].data(), contents[f].size());
+    memoryReader->Update();
+    if (!::CheckOutput(memoryReader->GetOutput(), formats[f] + " in memory"))
+    {
+      return EXIT_FAILURE;
+    }
+
+    const std::string filename = std::string(argv[2]) + "TestF3DSTLReader_" + formats[f] + ".stl";
+    {
+      std::ofstream file(filename, std::ios::binary);
+      file << contents[f];
+    }
+    vtkNew<vtkF3DSTLReader> reader;
+    reader->SetFileName(filename);
+    reader->Update();
+    if (!::CheckOutput(reader->GetOutput(), formats[f]))
+    {
+      return EXIT_FAILURE;
+    }
+
+    double bounds[6];
+    if (!vtkF3DSTLReader::ProbeBounds(filename, bounds) || bounds[3] != 2 || bounds[4] != -1)
+    {
+      std::cerr << "Wrong probed bounds of the " << formats[f] << " file" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
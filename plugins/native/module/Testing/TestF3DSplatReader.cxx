@@ -0,0 +1,150 @@
+#include <vtkDataArray.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkPolyData.h>
+#include <vtkTestUtilities.h>
+
+#include "vtkF3DSplatReader.h"
+
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+/**
+ * Create a binary little endian 3DGS .ply file of two gaussians, with the spherical harmonics
+ * coefficients of the given degree. Each f_rest value is the index of its coefficient plus
+ * 100 times its channel, so that the interleaving of the output can be checked.
+ */
+std::string CreateGaussianPLY(int degree)
+{
+  const int nbCoeffs = (degree + 1) * (degree + 1) - 1;
+  std::string header = "ply\nformat binary_little_endian 1.0\nelement vertex 2\n";
+  std::vector<std::string> names = { "x", "y", "z", "nx", "ny", "nz", "f_dc_0", "f_dc_1",
+    "f_dc_2" };
+  for (int i = 0; i < 3 * nbCoeffs; i++)
+  {
+    names.emplace_back("f_rest_" + std::to_string(i));
+  }
+  names.insert(names.end(),
+    { "opacity", "scale_0", "scale_1", "scale_2", "rot_0", "rot_1", "rot_2", "rot_3" });
+  for (const std::string& name : names)
+  {
+    header += "property float " + name + "\n";
+  }
+  header += "end_header\n";
+
+  std::string content = header;
+  for (int v = 0; v < 2; v++)
+  {
+    std::vector<float> values = { static_cast<float>(v), 1, 2, 0, 0, 0, 0, 0, 0 };
+    for (int c = 0; c < 3; c++)
+    {
+      for (int j = 0; j < nbCoeffs; j++)
+      {
+        values.emplace_back(static_cast<float>(j + 100 * c));
+      }
+    }
+    values.insert(values.end(), { 0, 0, std::log(2.f), 0, 2, 0, 0, 0 });
+    content.append(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(float));
+  }
+  return content;
+}
+
+bool CheckOutput(vtkPolyData* output, int degree)
+{
+  const int nbCoeffs = (degree + 1) * (degree + 1) - 1;
+  double point[3];
+  output->GetPoint(1, point);
+  if (output->GetNumberOfPoints() != 2 || point[0] != 1 || point[2] != 2)
+  {
+    std::cerr << "Wrong positions with spherical harmonics of degree " << degree << std::endl;
+    return false;
+  }
+
+  // the activations are applied
+  vtkPointData* pointData = output->GetPointData();
+  vtkDataArray* colors = pointData->GetArray("color");
+  vtkDataArray* scales = pointData->GetArray("scale");
+  vtkDataArray* rotations = pointData->GetArray("rotation");
+  if (!colors || !scales || !rotations || colors->GetComponent(0, 0) != 128 ||
+    colors->GetComponent(0, 3) != 128 || std::abs(scales->GetComponent(0, 1) - 2) > 1e-5 ||
+    rotations->GetComponent(0, 0) != 1)
+  {
+    std::cerr << "Wrong activations with spherical harmonics of degree " << degree << std::endl;
+    return false;
+  }
+
+  // the coefficients are interleaved by channel
+  vtkDataArray* harmonics = pointData->GetArray("spherical_harmonics");
+  if (!harmonics || harmonics->GetNumberOfComponents() != 3 * nbCoeffs ||
+    harmonics->GetNumberOfTuples() != 2)
+  {
+    std::cerr << "Wrong harmonics array with spherical harmonics of degree " << degree
+              << std::endl;
+    return false;
+  }
+  for (int j = 0; j < nbCoeffs; j++)
+  {
+    for (int c = 0; c < 3; c++)
+    {
+      if (harmonics->GetComponent(1, 3 * j + c) != j + 100 * c)
+      {
+        std::cerr << "Wrong coefficient " << j << " of channel " << c
+                  << " with spherical harmonics of degree " << degree << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestF3DSplatReader(int vtkNotUsed(argc), char* argv[])
+{
+  for (int degree : { 1, 3 })
+  {
+    const std::string content = ::CreateGaussianPLY(degree);
+
+    vtkNew<vtkF3DSplatReader> memoryReader;
+    memoryReader->SetBuffer(content.data(), content.size());
+    memoryReader->Update();
+    if (!::CheckOutput(memoryReader->GetOutput(), degree))
+    {
+      return EXIT_FAILURE;
+    }
+
+    const std::string filename =
+      std::string(argv[2]) + "TestF3DSplatReader_" + std::to_string(degree) + ".ply";
+    {
+      std::ofstream file(filename, std::ios::binary);
+      file << content;
+    }
+    if (!vtkF3DSplatReader::IsGaussianPLYFile(filename))
+    {
+      std::cerr << "The gaussian .ply file is not detected" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    vtkNew<vtkF3DSplatReader> reader;
+    reader->SetFileName(filename);
+    reader->Update();
+    if (!::CheckOutput(reader->GetOutput(), degree))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  // other .ply files are not gaussians
+  if (vtkF3DSplatReader::IsGaussianPLYFile(std::string(argv[1]) + "data/suzanne.ply"))
+  {
+    std::cerr << "A regular .ply file is detected as gaussians" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,502 @@
+#include "vtkF3DOBJReader.h"
+
+#include "F3DMappedFile.h"
+#include "F3DTextParsing.h"
+
+#include <vtkCellArray.h>
+#include <vtkFloatArray.h>
+#include <vtkIdTypeArray.h>
+#include <vtkInformation.h>
+#include <vtkInformationVector.h>
+#include <vtkNew.h>
+#include <vtkObjectFactory.h>
+#include <vtkPointData.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkSMPTools.h>
+
+#include <algorithm>
+#include <atomic>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+//----------------------------------------------------------------------------
+/**
+ * The number of elements of a chunk, or the index of the first ones of a chunk
+ */
+struct OBJCounts
+{
+  vtkIdType Vertices = 0;
+  vtkIdType Normals = 0;
+  vtkIdType TCoords = 0;
+  vtkIdType Faces = 0;
+  vtkIdType FaceCorners = 0;
+  vtkIdType Lines = 0;
+  vtkIdType LineCorners = 0;
+
+  OBJCounts& operator+=(const OBJCounts& other)
+  {
+    this->Vertices += other.Vertices;
+    this->Normals += other.Normals;
+    this->TCoords += other.TCoords;
+    this->Faces += other.Faces;
+    this->FaceCorners += other.FaceCorners;
+    this->Lines += other.Lines;
+    this->LineCorners += other.LineCorners;
+    return *this;
+  }
+};
+
+//----------------------------------------------------------------------------
+/**
+ * Return the number of corners of a f or l line, separated by spaces
+ */
+vtkIdType CountCorners(const char* cur, const char* end)
+{
+  vtkIdType count = 0;
+  while (true)
+  {
+    cur = F3DTextParsing::SkipSpaces(cur, end);
+    if (cur == end || *cur == '\r' || *cur == '\n' || *cur == '#')
+    {
+      return count;
+    }
+    count++;
+    while (cur != end && *cur != ' ' && *cur != '\t' && *cur != '\r' && *cur != '\n')
+    {
+      ++cur;
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+/**
+ * Return the 0 based index of a 1 based or relative index, -1 if there is no index
+ */
+inline vtkIdType ResolveIndex(vtkIdType index, vtkIdType count)
+{
+  return index > 0 ? index - 1 : (index < 0 ? count + index : -1);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * Parse a v, v/vt, v//vn or v/vt/vn face corner, the missing indices are 0
+ */
+bool ParseCorner(const char*& cur, const char* end, vtkIdType ids[3])
+{
+  ids[0] = ids[1] = ids[2] = 0;
+  if (!F3DTextParsing::Parse(cur, end, ids[0]))
+  {
+    return false;
+  }
+  if (cur != end && *cur == '/')
+  {
+    ++cur;
+    if (cur != end && *cur != '/' && !F3DTextParsing::Parse(cur, end, ids[1]))
+    {
+      return false;
+    }
+    if (cur != end && *cur == '/')
+    {
+      ++cur;
+      if (!F3DTextParsing::Parse(cur, end, ids[2]))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+template<int NbComps>
+bool ParseValues(const char* cur, const char* end, float* values)
+{
+  for (int c = 0; c < NbComps; c++)
+  {
+    if (!F3DTextParsing::Parse(cur, end, values[c]))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * Create an array of the raw values of the points, the normals or the texture coordinates
+ */
+vtkSmartPointer<vtkFloatArray> CreateArray(const char* name, int nbComps, vtkIdType nbTuples)
+{
+  vtkNew<vtkFloatArray> array;
+  array->SetName(name);
+  array->SetNumberOfComponents(nbComps);
+  array->SetNumberOfTuples(nbTuples);
+  return array;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * Copy the tuples of an array indexed by the ids, the missing ones are zeros
+ */
+vtkSmartPointer<vtkFloatArray> Gather(
+  vtkFloatArray* source, const vtkIdType* ids, vtkIdType nbIds, vtkIdType nbLeading)
+{
+  const int nbComps = source->GetNumberOfComponents();
+  vtkSmartPointer<vtkFloatArray> output =
+    ::CreateArray(source->GetName(), nbComps, nbLeading + nbIds);
+  const float* in = source->GetPointer(0);
+  float* out = output->GetPointer(0);
+  std::fill(out, out + nbLeading * nbComps, 0.f);
+  vtkSMPTools::For(0, nbIds,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType i = begin; i < end; i++)
+      {
+        float* tuple = out + (nbLeading + i) * nbComps;
+        if (ids[i] >= 0)
+        {
+          std::copy(in + ids[i] * nbComps, in + (ids[i] + 1) * nbComps, tuple);
+        }
+        else
+        {
+          std::fill(tuple, tuple + nbComps, 0.f);
+        }
+      }
+    });
+  return output;
+}
+}
+
+//----------------------------------------------------------------------------
+vtkStandardNewMacro(vtkF3DOBJReader);
+
+//----------------------------------------------------------------------------
+vtkF3DOBJReader::vtkF3DOBJReader()
+{
+  this->SetNumberOfInputPorts(0);
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DOBJReader::SetBuffer(const void* buffer, size_t size)
+{
+  this->Buffer = buffer;
+  this->BufferSize = size;
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DOBJReader::HasMaterialLibrary(const std::string& fileName)
+{
+  // mtllib lines can be after a long comment header, so the whole file is searched,
+  // which is fast enough to be done for each candidate file when selecting a reader
+  F3DMappedFile file;
+  if (!file.Open(fileName))
+  {
+    return false;
+  }
+  const std::string_view content(file.GetData(), file.GetSize());
+  return content.find("mtllib") != std::string_view::npos ||
+    content.find("usemtl") != std::string_view::npos;
+}
+
+//----------------------------------------------------------------------------
+int vtkF3DOBJReader::RequestData(
+  vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector)
+{
+  vtkPolyData* output = vtkPolyData::GetData(outputVector);
+
+  F3DMappedFile file;
+  if (this->Buffer)
+  {
+    file.Open(this->Buffer, this->BufferSize);
+  }
+  else if (!file.Open(this->FileName))
+  {
+    vtkErrorMacro("Cannot open file " << this->FileName);
+    return 0;
+  }
+
+  std::vector<F3DTextParsing::Chunk> chunks =
+    F3DTextParsing::SplitLines(file.GetData(), file.GetData() + file.GetSize());
+  const vtkIdType nbChunks = static_cast<vtkIdType>(chunks.size());
+
+  // first pass, count the elements of each chunk
+  std::vector<::OBJCounts> chunkFirsts(nbChunks + 1);
+  vtkSMPTools::For(0, nbChunks,
+    [&](vtkIdType first, vtkIdType last)
+    {
+      for (vtkIdType c = first; c < last; c++)
+      {
+        ::OBJCounts& counts = chunkFirsts[c + 1];
+        const char* end = chunks[c].End;
+        for (const char* line = chunks[c].Begin; line != end;)
+        {
+          const char* next = F3DTextParsing::NextLine(line, end);
+          const char* cur = line;
+          if (F3DTextParsing::StartsWith(cur, next, "v"))
+          {
+            counts.Vertices++;
+          }
+          else if (F3DTextParsing::StartsWith(cur, next, "vn"))
+          {
+            counts.Normals++;
+          }
+          else if (F3DTextParsing::StartsWith(cur, next, "vt"))
+          {
+            counts.TCoords++;
+          }
+          else if (F3DTextParsing::StartsWith(cur, next, "f"))
+          {
+            counts.Faces++;
+            counts.FaceCorners += ::CountCorners(cur, next);
+          }
+          else if (F3DTextParsing::StartsWith(cur, next, "l"))
+          {
+            counts.Lines++;
+            counts.LineCorners += ::CountCorners(cur, next);
+          }
+          line = next;
+        }
+      }
+    });
+
+  for (vtkIdType c = 0; c < nbChunks; c++)
+  {
+    chunkFirsts[c + 1] += chunkFirsts[c];
+  }
+  const ::OBJCounts& totals = chunkFirsts[nbChunks];
+
+  vtkSmartPointer<vtkFloatArray> positions = ::CreateArray(nullptr, 3, totals.Vertices);
+  vtkSmartPointer<vtkFloatArray> normals = ::CreateArray("Normals", 3, totals.Normals);
+  vtkSmartPointer<vtkFloatArray> tcoords = ::CreateArray("TCoords", 2, totals.TCoords);
+  float* positionValues = positions->GetPointer(0);
+  float* normalValues = normals->GetPointer(0);
+  float* tcoordValues = tcoords->GetPointer(0);
+
+  // the position, texture coordinates and normal indices of each face corner, -1 if missing
+  std::vector<vtkIdType> cornerIds[3];
+  for (std::vector<vtkIdType>& ids : cornerIds)
+  {
+    ids.resize(totals.FaceCorners);
+  }
+
+  vtkNew<vtkIdTypeArray> faceOffsets;
+  faceOffsets->SetNumberOfValues(totals.Faces + 1);
+  vtkIdType* faceOffsetValues = faceOffsets->GetPointer(0);
+  faceOffsetValues[0] = 0;
+
+  vtkNew<vtkIdTypeArray> lineOffsets;
+  lineOffsets->SetNumberOfValues(totals.Lines + 1);
+  vtkIdType* lineOffsetValues = lineOffsets->GetPointer(0);
+  lineOffsetValues[0] = 0;
+
+  vtkNew<vtkIdTypeArray> lineConnectivity;
+  lineConnectivity->SetNumberOfValues(totals.LineCorners);
+  vtkIdType* lineConnectivityValues = lineConnectivity->GetPointer(0);
+
+  // second pass, parse the elements at their place
+  std::atomic<bool> valid(true);
+  vtkSMPTools::For(0, nbChunks,
+    [&](vtkIdType first, vtkIdType last)
+    {
+      for (vtkIdType c = first; c < last && valid; c++)
+      {
+        ::OBJCounts ids = chunkFirsts[c];
+        const char* end = chunks[c].End;
+        for (const char* line = chunks[c].Begin; line != end;)
+        {
+          const char* next = F3DTextParsing::NextLine(line, end);
+          const char* cur = line;
+          bool parsed = true;
+          if (F3DTextParsing::StartsWith(cur, next, "v"))
+          {
+            parsed = ::ParseValues<3>(cur, next, positionValues + 3 * ids.Vertices++);
+          }
+          else if (F3DTextParsing::StartsWith(cur, next, "vn"))
+          {
+            parsed = ::ParseValues<3>(cur, next, normalValues + 3 * ids.Normals++);
+          }
+          else if (F3DTextParsing::StartsWith(cur, next, "vt"))
+          {
+            // the second texture coordinate is optional
+            float* tcoord = tcoordValues + 2 * ids.TCoords++;
+            tcoord[1] = 0.f;
+            parsed = F3DTextParsing::Parse(cur, next, tcoord[0]);
+            F3DTextParsing::Parse(cur, next, tcoord[1]);
+          }
+          else if (F3DTextParsing::StartsWith(cur, next, "f"))
+          {
+            const vtkIdType nbCorners = ::CountCorners(cur, next);
+            for (vtkIdType i = 0; i < nbCorners && parsed; i++, ids.FaceCorners++)
+            {
+              vtkIdType corner[3];
+              parsed = ::ParseCorner(cur, next, corner);
+              cornerIds[0][ids.FaceCorners] = ::ResolveIndex(corner[0], ids.Vertices);
+              cornerIds[1][ids.FaceCorners] = ::ResolveIndex(corner[1], ids.TCoords);
+              cornerIds[2][ids.FaceCorners] = ::ResolveIndex(corner[2], ids.Normals);
+            }
+            faceOffsetValues[++ids.Faces] = ids.FaceCorners;
+          }
+          else if (F3DTextParsing::StartsWith(cur, next, "l"))
+          {
+            const vtkIdType nbCorners = ::CountCorners(cur, next);
+            for (vtkIdType i = 0; i < nbCorners && parsed; i++, ids.LineCorners++)
+            {
+              vtkIdType corner[3];
+              parsed = ::ParseCorner(cur, next, corner);
+              lineConnectivityValues[ids.LineCorners] = ::ResolveIndex(corner[0], ids.Vertices);
+            }
+            lineOffsetValues[++ids.Lines] = ids.LineCorners;
+          }
+          if (!parsed)
+          {
+            valid = false;
+            break;
+          }
+          line = next;
+        }
+      }
+    });
+
+  if (!valid)
+  {
+    vtkErrorMacro("Invalid line in " << this->FileName);
+    return 0;
+  }
+
+  // check the indices, and if the points can be shared by the faces
+  std::atomic<bool> shared(true);
+  std::atomic<bool> hasTCoords(false);
+  std::atomic<bool> hasNormals(false);
+  const vtkIdType nbCounts[3] = { totals.Vertices, totals.TCoords, totals.Normals };
+  vtkSMPTools::For(0, totals.FaceCorners,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType i = begin; i < end; i++)
+      {
+        const vtkIdType vertex = cornerIds[0][i];
+        for (int a = 0; a < 3; a++)
+        {
+          const vtkIdType id = cornerIds[a][i];
+          if (id >= nbCounts[a] || id < (a == 0 ? 0 : -1))
+          {
+            valid = false;
+          }
+          if (id >= 0 && a == 1)
+          {
+            hasTCoords = true;
+          }
+          if (id >= 0 && a == 2)
+          {
+            hasNormals = true;
+          }
+          if (id >= 0 && id != vertex)
+          {
+            shared = false;
+          }
+        }
+      }
+    });
+  if (!std::all_of(lineConnectivityValues, lineConnectivityValues + totals.LineCorners,
+        [&](vtkIdType id) { return id >= 0 && id < totals.Vertices; }))
+  {
+    valid = false;
+  }
+
+  if (!valid)
+  {
+    vtkErrorMacro("Invalid index in " << this->FileName);
+    return 0;
+  }
+
+  vtkNew<vtkIdTypeArray> faceConnectivity;
+  if (shared)
+  {
+    // the normals and texture coordinates have the indices of the points
+    std::vector<vtkIdType> ids(totals.Vertices);
+    vtkSMPTools::For(0, totals.Vertices,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        for (vtkIdType i = begin; i < end; i++)
+        {
+          ids[i] = i;
+        }
+      });
+
+    if (hasNormals)
+    {
+      std::vector<vtkIdType> normalIds = ids;
+      std::replace_if(
+        normalIds.begin(), normalIds.end(), [&](vtkIdType i) { return i >= totals.Normals; }, -1);
+      normals = ::Gather(normals, normalIds.data(), totals.Vertices, 0);
+    }
+    if (hasTCoords)
+    {
+      std::replace_if(ids.begin(), ids.end(), [&](vtkIdType i) { return i >= totals.TCoords; }, -1);
+      tcoords = ::Gather(tcoords, ids.data(), totals.Vertices, 0);
+    }
+
+    faceConnectivity->SetNumberOfValues(totals.FaceCorners);
+    std::copy(cornerIds[0].begin(), cornerIds[0].end(), faceConnectivity->GetPointer(0));
+  }
+  else
+  {
+    // each face corner has its own point, following the points used by the lines
+    const vtkIdType nbVertices = totals.Vertices;
+    vtkSmartPointer<vtkFloatArray> vertices = positions;
+    positions = ::Gather(vertices, cornerIds[0].data(), totals.FaceCorners, nbVertices);
+    std::copy(positionValues, positionValues + 3 * nbVertices, positions->GetPointer(0));
+
+    if (hasNormals)
+    {
+      normals = ::Gather(normals, cornerIds[2].data(), totals.FaceCorners, nbVertices);
+    }
+    if (hasTCoords)
+    {
+      tcoords = ::Gather(tcoords, cornerIds[1].data(), totals.FaceCorners, nbVertices);
+    }
+
+    faceConnectivity->SetNumberOfValues(totals.FaceCorners);
+    vtkIdType* connectivityValues = faceConnectivity->GetPointer(0);
+    vtkSMPTools::For(0, totals.FaceCorners,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        for (vtkIdType i = begin; i < end; i++)
+        {
+          connectivityValues[i] = nbVertices + i;
+        }
+      });
+  }
+
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToFloat();
+  points->SetData(positions);
+  output->SetPoints(points);
+
+  if (hasNormals)
+  {
+    output->GetPointData()->SetNormals(normals);
+  }
+  if (hasTCoords)
+  {
+    output->GetPointData()->SetTCoords(tcoords);
+  }
+
+  if (totals.Faces > 0)
+  {
+    vtkNew<vtkCellArray> polys;
+    polys->SetData(faceOffsets, faceConnectivity);
+    output->SetPolys(polys);
+  }
+  if (totals.Lines > 0)
+  {
+    vtkNew<vtkCellArray> lines;
+    lines->SetData(lineOffsets, lineConnectivity);
+    output->SetLines(lines);
+  }
+
+  return 1;
+}
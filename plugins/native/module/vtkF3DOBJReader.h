@@ -0,0 +1,60 @@
+/**
+ * @class   vtkF3DOBJReader
+ * @brief   VTK Reader for the geometry of .obj files
+ *
+ * The file is mapped in memory and its lines are parsed concurrently by chunks, in two passes:
+ * the first one counts the elements of each chunk so that the second one parses them directly
+ * at their place in the output arrays.
+ * The v, vn and vt lines are the points, the "Normals" and the "TCoords", the f lines the
+ * polygons and the l lines the polylines. When the faces use different indices for the
+ * positions and the normals or texture coordinates, each face corner has its own point.
+ * Groups and materials are ignored, the files using materials are read by vtkOBJImporter.
+ */
+
+#ifndef vtkF3DOBJReader_h
+#define vtkF3DOBJReader_h
+
+#include <vtkPolyDataAlgorithm.h>
+
+#include <string>
+
+class vtkF3DOBJReader : public vtkPolyDataAlgorithm
+{
+public:
+  static vtkF3DOBJReader* New();
+  vtkTypeMacro(vtkF3DOBJReader, vtkPolyDataAlgorithm);
+
+  /**
+   * Set the file name.
+   */
+  vtkSetMacro(FileName, std::string);
+
+  /**
+   * Set a buffer in memory to read instead of the file.
+   * The buffer is not copied and must be kept alive while the reader is used.
+   */
+  void SetBuffer(const void* buffer, size_t size);
+
+  /**
+   * Return true if the provided file references a material library or a material with a mtllib
+   * or a usemtl line anywhere in the file, which is mapped in memory and searched without being
+   * parsed. Return false if it cannot be read.
+   */
+  static bool HasMaterialLibrary(const std::string& fileName);
+
+protected:
+  vtkF3DOBJReader();
+  ~vtkF3DOBJReader() override = default;
+
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+
+private:
+  vtkF3DOBJReader(const vtkF3DOBJReader&) = delete;
+  void operator=(const vtkF3DOBJReader&) = delete;
+
+  std::string FileName;
+  const void* Buffer = nullptr;
+  size_t BufferSize = 0;
+};
+
+#endif
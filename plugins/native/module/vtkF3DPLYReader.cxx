@@ -0,0 +1,820 @@
+#include "vtkF3DPLYReader.h"
+
+#include "F3DMappedFile.h"
+#include "F3DTextParsing.h"
+
+#include <vtkBoundingBox.h>
+#include <vtkCellArray.h>
+#include <vtkCellData.h>
+#include <vtkFloatArray.h>
+#include <vtkIdTypeArray.h>
+#include <vtkInformation.h>
+#include <vtkInformationVector.h>
+#include <vtkNew.h>
+#include <vtkObjectFactory.h>
+#include <vtkPointData.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkSMPThreadLocal.h>
+#include <vtkSMPTools.h>
+#include <vtkUnsignedCharArray.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <numeric>
+#include <sstream>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+//----------------------------------------------------------------------------
+enum class PLYType
+{
+  Invalid,
+  Int8,
+  UInt8,
+  Int16,
+  UInt16,
+  Int32,
+  UInt32,
+  Float32,
+  Float64
+};
+
+//----------------------------------------------------------------------------
+PLYType GetType(const std::string& name)
+{
+  static const std::map<std::string, PLYType> types = { { "char", PLYType::Int8 },
+    { "int8", PLYType::Int8 }, { "uchar", PLYType::UInt8 }, { "uint8", PLYType::UInt8 },
+    { "short", PLYType::Int16 }, { "int16", PLYType::Int16 }, { "ushort", PLYType::UInt16 },
+    { "uint16", PLYType::UInt16 }, { "int", PLYType::Int32 }, { "int32", PLYType::Int32 },
+    { "uint", PLYType::UInt32 }, { "uint32", PLYType::UInt32 }, { "float", PLYType::Float32 },
+    { "float32", PLYType::Float32 }, { "double", PLYType::Float64 },
+    { "float64", PLYType::Float64 } };
+  auto it = types.find(name);
+  return it == types.end() ? PLYType::Invalid : it->second;
+}
+
+//----------------------------------------------------------------------------
+size_t GetTypeSize(PLYType type)
+{
+  switch (type)
+  {
+    case PLYType::Int8:
+    case PLYType::UInt8:
+      return 1;
+    case PLYType::Int16:
+    case PLYType::UInt16:
+      return 2;
+    case PLYType::Int32:
+    case PLYType::UInt32:
+    case PLYType::Float32:
+      return 4;
+    case PLYType::Float64:
+      return 8;
+    default:
+      return 0;
+  }
+}
+
+//----------------------------------------------------------------------------
+struct PLYProperty
+{
+  std::string Name;
+  PLYType Type = PLYType::Invalid;
+
+  // type of the number of values of a list property, Invalid for a scalar property
+  PLYType CountType = PLYType::Invalid;
+};
+
+//----------------------------------------------------------------------------
+struct PLYElement
+{
+  std::string Name;
+  vtkIdType Count = 0;
+  std::vector<PLYProperty> Properties;
+
+  /**
+   * Return the index of a property, -1 if it does not exist or does not have the expected kind
+   */
+  int GetIndex(const std::string& name, bool list = false) const
+  {
+    for (size_t i = 0; i < this->Properties.size(); i++)
+    {
+      const PLYProperty& prop = this->Properties[i];
+      if (prop.Name == name && (prop.CountType != PLYType::Invalid) == list)
+      {
+        return static_cast<int>(i);
+      }
+    }
+    return -1;
+  }
+
+  /**
+   * Return the size of each item in a binary file, 0 if it depends on the size of the lists
+   */
+  size_t GetStride() const
+  {
+    size_t stride = 0;
+    for (const PLYProperty& prop : this->Properties)
+    {
+      if (prop.CountType != PLYType::Invalid)
+      {
+        return 0;
+      }
+      stride += ::GetTypeSize(prop.Type);
+    }
+    return stride;
+  }
+};
+
+//----------------------------------------------------------------------------
+struct PLYFile
+{
+  bool Binary = false;
+
+  // true if the endianness of the file is not the one of the host
+  bool Swap = false;
+
+  // the data following the header
+  const char* Begin = nullptr;
+  const char* End = nullptr;
+
+  std::vector<PLYElement> Elements;
+  std::string Error;
+};
+
+//----------------------------------------------------------------------------
+PLYFile ParseHeader(const char* data, size_t size)
+{
+  PLYFile ply;
+  const std::string_view view(data, size);
+  const size_t headerEnd = view.find("end_header");
+  if (view.compare(0, 3, "ply") != 0 || headerEnd == std::string_view::npos)
+  {
+    ply.Error = "Invalid PLY header";
+    return ply;
+  }
+  ply.Begin = F3DTextParsing::NextLine(data + headerEnd, data + size);
+  ply.End = data + size;
+
+  const uint16_t one = 1;
+  const bool littleEndianHost = *reinterpret_cast<const unsigned char*>(&one) == 1;
+
+  std::istringstream lines(std::string(data, headerEnd));
+  std::string line;
+  bool hasFormat = false;
+  while (std::getline(lines, line))
+  {
+    std::istringstream words(line);
+    std::string keyword;
+    words >> keyword;
+    if (keyword == "format")
+    {
+      std::string format;
+      words >> format;
+      hasFormat = true;
+      ply.Binary = format != "ascii";
+      if (format == "binary_little_endian")
+      {
+        ply.Swap = !littleEndianHost;
+      }
+      else if (format == "binary_big_endian")
+      {
+        ply.Swap = littleEndianHost;
+      }
+      else if (format != "ascii")
+      {
+        ply.Error = "Unsupported PLY format " + format;
+        return ply;
+      }
+    }
+    else if (keyword == "element")
+    {
+      PLYElement& element = ply.Elements.emplace_back();
+      words >> element.Name >> element.Count;
+      if (!words || element.Count < 0)
+      {
+        ply.Error = "Invalid element in the PLY header: " + line;
+        return ply;
+      }
+    }
+    else if (keyword == "property")
+    {
+      std::string type;
+      words >> type;
+
+      PLYProperty prop;
+      const bool list = type == "list";
+      if (list)
+      {
+        std::string countType;
+        words >> countType >> type;
+        prop.CountType = ::GetType(countType);
+      }
+      prop.Type = ::GetType(type);
+      words >> prop.Name;
+      if (!words || ply.Elements.empty() || prop.Type == PLYType::Invalid ||
+        (list && prop.CountType == PLYType::Invalid))
+      {
+        ply.Error = "Invalid property in the PLY header: " + line;
+        return ply;
+      }
+      ply.Elements.back().Properties.emplace_back(prop);
+    }
+  }
+
+  if (!hasFormat)
+  {
+    ply.Error = "Missing format in the PLY header";
+  }
+  return ply;
+}
+
+//----------------------------------------------------------------------------
+template<typename T>
+double LoadValue(const char* data, bool swap)
+{
+  char bytes[sizeof(T)];
+  std::memcpy(bytes, data, sizeof(T));
+  if (swap)
+  {
+    std::reverse(bytes, bytes + sizeof(T));
+  }
+  T value;
+  std::memcpy(&value, bytes, sizeof(T));
+  return static_cast<double>(value);
+}
+
+//----------------------------------------------------------------------------
+double LoadBinary(const char* data, PLYType type, bool swap)
+{
+  switch (type)
+  {
+    case PLYType::Int8:
+      return ::LoadValue<int8_t>(data, false);
+    case PLYType::UInt8:
+      return ::LoadValue<uint8_t>(data, false);
+    case PLYType::Int16:
+      return ::LoadValue<int16_t>(data, swap);
+    case PLYType::UInt16:
+      return ::LoadValue<uint16_t>(data, swap);
+    case PLYType::Int32:
+      return ::LoadValue<int32_t>(data, swap);
+    case PLYType::UInt32:
+      return ::LoadValue<uint32_t>(data, swap);
+    case PLYType::Float32:
+      return ::LoadValue<float>(data, swap);
+    case PLYType::Float64:
+      return ::LoadValue<double>(data, swap);
+    default:
+      return 0.0;
+  }
+}
+
+//----------------------------------------------------------------------------
+/**
+ * Read a value of an item and advance cur after it
+ */
+template<typename T>
+bool ReadValue(const char*& cur, const char* end, const PLYFile& ply, PLYType type, T& value)
+{
+  if (!ply.Binary)
+  {
+    return F3DTextParsing::Parse(cur, end, value);
+  }
+
+  const size_t size = ::GetTypeSize(type);
+  if (static_cast<size_t>(end - cur) < size)
+  {
+    return false;
+  }
+  value = static_cast<T>(::LoadBinary(cur, type, ply.Swap));
+  cur += size;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * Decode the scalar properties of an item and the values of one of its list properties
+ */
+bool DecodeItem(const PLYFile& ply, const PLYElement& element, const char* cur, const char* end,
+  int listIndex, double* scalars, std::vector<vtkIdType>& list)
+{
+  for (size_t p = 0; p < element.Properties.size(); p++)
+  {
+    const PLYProperty& prop = element.Properties[p];
+    if (prop.CountType == PLYType::Invalid)
+    {
+      if (!::ReadValue(cur, end, ply, prop.Type, scalars[p]))
+      {
+        return false;
+      }
+      continue;
+    }
+
+    vtkIdType count;
+    if (!::ReadValue(cur, end, ply, prop.CountType, count) || count < 0)
+    {
+      return false;
+    }
+    if (static_cast<int>(p) == listIndex)
+    {
+      list.resize(count);
+      for (vtkIdType& value : list)
+      {
+        if (!::ReadValue(cur, end, ply, prop.Type, value))
+        {
+          return false;
+        }
+      }
+    }
+    else if (ply.Binary)
+    {
+      const size_t size = count * ::GetTypeSize(prop.Type);
+      if (static_cast<size_t>(end - cur) < size)
+      {
+        return false;
+      }
+      cur += size;
+    }
+    else
+    {
+      double value;
+      for (vtkIdType i = 0; i < count; i++)
+      {
+        if (!::ReadValue(cur, end, ply, prop.Type, value))
+        {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * The location of the items of an element
+ */
+struct PLYElementRange
+{
+  const char* Begin = nullptr;
+  const char* End = nullptr;
+
+  // size of the binary items without lists
+  size_t Stride = 0;
+
+  // the binary items with lists, followed by the end of the last one
+  std::vector<const char*> Items;
+
+  // the ASCII lines, one per item
+  std::vector<F3DTextParsing::Chunk> Chunks;
+};
+
+//----------------------------------------------------------------------------
+bool LocateElement(
+  const PLYFile& ply, const PLYElement& element, const char* begin, PLYElementRange& range)
+{
+  range.Begin = begin;
+  if (!ply.Binary)
+  {
+    range.End = F3DTextParsing::SkipLines(begin, ply.End, element.Count);
+    if (!range.End)
+    {
+      return false;
+    }
+    range.Chunks = F3DTextParsing::SplitLines(begin, range.End);
+    return true;
+  }
+
+  range.Stride = element.GetStride();
+  if (range.Stride > 0)
+  {
+    if (static_cast<size_t>(ply.End - begin) / range.Stride < static_cast<size_t>(element.Count))
+    {
+      return false;
+    }
+    range.End = begin + element.Count * range.Stride;
+    return true;
+  }
+
+  // only the sizes of the lists are read to locate the items
+  range.Items.resize(element.Count + 1);
+  const char* cur = begin;
+  for (vtkIdType i = 0; i < element.Count; i++)
+  {
+    range.Items[i] = cur;
+    for (const PLYProperty& prop : element.Properties)
+    {
+      size_t size = ::GetTypeSize(prop.Type);
+      if (prop.CountType != PLYType::Invalid)
+      {
+        vtkIdType count;
+        if (!::ReadValue(cur, ply.End, ply, prop.CountType, count) || count < 0)
+        {
+          return false;
+        }
+        size *= count;
+      }
+      if (static_cast<size_t>(ply.End - cur) < size)
+      {
+        return false;
+      }
+      cur += size;
+    }
+  }
+  range.Items[element.Count] = cur;
+  range.End = cur;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * Decode the items of an element concurrently and call the functor with the id, the scalar
+ * properties and the values of the list property of each item.
+ * Return false if an item cannot be decoded or if the functor returns false.
+ */
+template<typename Functor>
+bool ForEachItem(const PLYFile& ply, const PLYElement& element, const PLYElementRange& range,
+  int listIndex, Functor&& functor)
+{
+  std::atomic<bool> valid(true);
+  auto decode = [&](vtkIdType id, const char* begin, const char* end,
+                  std::vector<double>& scalars, std::vector<vtkIdType>& list)
+  {
+    if (!::DecodeItem(ply, element, begin, end, listIndex, scalars.data(), list) ||
+      !functor(id, scalars.data(), list))
+    {
+      valid = false;
+    }
+  };
+
+  if (!ply.Binary)
+  {
+    vtkSMPTools::For(0, static_cast<vtkIdType>(range.Chunks.size()),
+      [&](vtkIdType first, vtkIdType last)
+      {
+        std::vector<double> scalars(element.Properties.size());
+        std::vector<vtkIdType> list;
+        for (vtkIdType c = first; c < last; c++)
+        {
+          const F3DTextParsing::Chunk& chunk = range.Chunks[c];
+          vtkIdType id = chunk.FirstLine;
+          for (const char* line = chunk.Begin; line != chunk.End; id++)
+          {
+            const char* next = F3DTextParsing::NextLine(line, chunk.End);
+            decode(id, line, next, scalars, list);
+            line = next;
+          }
+        }
+      });
+  }
+  else
+  {
+    vtkSMPTools::For(0, element.Count,
+      [&](vtkIdType first, vtkIdType last)
+      {
+        std::vector<double> scalars(element.Properties.size());
+        std::vector<vtkIdType> list;
+        for (vtkIdType i = first; i < last; i++)
+        {
+          const char* begin = range.Stride > 0 ? range.Begin + i * range.Stride : range.Items[i];
+          const char* end = range.Stride > 0 ? begin + range.Stride : range.Items[i + 1];
+          decode(i, begin, end, scalars, list);
+        }
+      });
+  }
+  return valid;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * Return the indices of the first of the names triplets, or pairs, that are all properties
+ */
+std::vector<int> GetIndices(
+  const PLYElement& element, const std::vector<std::vector<std::string>>& candidates)
+{
+  for (const std::vector<std::string>& names : candidates)
+  {
+    std::vector<int> indices;
+    for (const std::string& name : names)
+    {
+      indices.emplace_back(element.GetIndex(name));
+    }
+    if (std::find(indices.begin(), indices.end(), -1) == indices.end())
+    {
+      return indices;
+    }
+  }
+  return {};
+}
+
+//----------------------------------------------------------------------------
+/**
+ * Create a color array of the red, green, blue and alpha properties, if any.
+ * The floating point colors are between 0 and 1.
+ */
+vtkSmartPointer<vtkUnsignedCharArray> CreateColors(
+  const PLYElement& element, std::vector<int>& indices, std::vector<double>& scales)
+{
+  indices = ::GetIndices(element, { { "red", "green", "blue" }, { "r", "g", "b" },
+                                    { "diffuse_red", "diffuse_green", "diffuse_blue" } });
+  if (indices.empty())
+  {
+    return nullptr;
+  }
+
+  int alpha = element.GetIndex("alpha");
+  alpha = alpha < 0 ? element.GetIndex("a") : alpha;
+  if (alpha >= 0)
+  {
+    indices.emplace_back(alpha);
+  }
+
+  scales.clear();
+  for (int index : indices)
+  {
+    PLYType type = element.Properties[index].Type;
+    scales.emplace_back(type == PLYType::Float32 || type == PLYType::Float64 ? 255.0 : 1.0);
+  }
+
+  vtkNew<vtkUnsignedCharArray> colors;
+  colors->SetName(alpha >= 0 ? "RGBA" : "RGB");
+  colors->SetNumberOfComponents(static_cast<int>(indices.size()));
+  colors->SetNumberOfTuples(element.Count);
+  return colors;
+}
+
+//----------------------------------------------------------------------------
+inline unsigned char ToColor(double value, double scale)
+{
+  return static_cast<unsigned char>(std::clamp(value * scale, 0.0, 255.0));
+}
+}
+
+//----------------------------------------------------------------------------
+vtkStandardNewMacro(vtkF3DPLYReader);
+
+//----------------------------------------------------------------------------
+vtkF3DPLYReader::vtkF3DPLYReader()
+{
+  this->SetNumberOfInputPorts(0);
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DPLYReader::SetBuffer(const void* buffer, size_t size)
+{
+  this->Buffer = buffer;
+  this->BufferSize = size;
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DPLYReader::ProbeBounds(const std::string& fileName, double bounds[6])
+{
+  F3DMappedFile file;
+  if (!file.Open(fileName))
+  {
+    return false;
+  }
+
+  ::PLYFile ply = ::ParseHeader(file.GetData(), file.GetSize());
+  if (!ply.Error.empty())
+  {
+    return false;
+  }
+
+  // the elements before the vertices are only located, the following ones are not read
+  vtkSMPThreadLocal<vtkBoundingBox> localBoxes;
+  const char* cur = ply.Begin;
+  for (const ::PLYElement& element : ply.Elements)
+  {
+    ::PLYElementRange range;
+    if (!::LocateElement(ply, element, cur, range))
+    {
+      return false;
+    }
+    cur = range.End;
+    if (element.Name != "vertex")
+    {
+      continue;
+    }
+
+    std::vector<int> xyz = ::GetIndices(element, { { "x", "y", "z" } });
+    if (xyz.empty() ||
+      !::ForEachItem(ply, element, range, -1,
+        [&](vtkIdType, const double* scalars, const std::vector<vtkIdType>&)
+        {
+          localBoxes.Local().AddPoint(scalars[xyz[0]], scalars[xyz[1]], scalars[xyz[2]]);
+          return true;
+        }))
+    {
+      return false;
+    }
+    break;
+  }
+
+  vtkBoundingBox box;
+  for (const vtkBoundingBox& localBox : localBoxes)
+  {
+    box.AddBox(localBox);
+  }
+  if (!box.IsValid())
+  {
+    return false;
+  }
+  box.GetBounds(bounds);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+int vtkF3DPLYReader::RequestData(
+  vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector)
+{
+  vtkPolyData* output = vtkPolyData::GetData(outputVector);
+
+  F3DMappedFile file;
+  if (this->Buffer)
+  {
+    file.Open(this->Buffer, this->BufferSize);
+  }
+  else if (!file.Open(this->FileName))
+  {
+    vtkErrorMacro("Cannot open file " << this->FileName);
+    return 0;
+  }
+
+  ::PLYFile ply = ::ParseHeader(file.GetData(), file.GetSize());
+  if (!ply.Error.empty())
+  {
+    vtkErrorMacro(<< ply.Error << " in " << this->FileName);
+    return 0;
+  }
+
+  auto vertexElement = std::find_if(ply.Elements.begin(), ply.Elements.end(),
+    [](const ::PLYElement& element) { return element.Name == "vertex"; });
+  if (vertexElement == ply.Elements.end())
+  {
+    vtkErrorMacro("There is no vertex element in " << this->FileName);
+    return 0;
+  }
+  const vtkIdType nbPoints = vertexElement->Count;
+
+  const char* cur = ply.Begin;
+  for (const ::PLYElement& element : ply.Elements)
+  {
+    ::PLYElementRange range;
+    if (!::LocateElement(ply, element, cur, range))
+    {
+      vtkErrorMacro("The " << element.Name << " elements are truncated in " << this->FileName);
+      return 0;
+    }
+    cur = range.End;
+
+    bool valid = true;
+    if (element.Name == "vertex")
+    {
+      std::vector<int> xyz = ::GetIndices(element, { { "x", "y", "z" } });
+      if (xyz.empty())
+      {
+        vtkErrorMacro("The vertices have no x, y and z properties in " << this->FileName);
+        return 0;
+      }
+
+      vtkNew<vtkFloatArray> positions;
+      positions->SetNumberOfComponents(3);
+      positions->SetNumberOfTuples(nbPoints);
+      float* positionValues = positions->GetPointer(0);
+
+      std::vector<int> nxyz = ::GetIndices(element, { { "nx", "ny", "nz" } });
+      vtkNew<vtkFloatArray> normals;
+      normals->SetName("Normals");
+      normals->SetNumberOfComponents(3);
+      normals->SetNumberOfTuples(nxyz.empty() ? 0 : nbPoints);
+      float* normalValues = normals->GetPointer(0);
+
+      std::vector<int> uv = ::GetIndices(element,
+        { { "u", "v" }, { "s", "t" }, { "texture_u", "texture_v" },
+          { "texture_s", "texture_t" } });
+      vtkNew<vtkFloatArray> tcoords;
+      tcoords->SetName("TCoords");
+      tcoords->SetNumberOfComponents(2);
+      tcoords->SetNumberOfTuples(uv.empty() ? 0 : nbPoints);
+      float* tcoordValues = tcoords->GetPointer(0);
+
+      std::vector<int> rgba;
+      std::vector<double> rgbaScales;
+      vtkSmartPointer<vtkUnsignedCharArray> colors = ::CreateColors(element, rgba, rgbaScales);
+      unsigned char* colorValues = colors ? colors->GetPointer(0) : nullptr;
+      const size_t nbColorComps = rgba.size();
+
+      valid = ::ForEachItem(ply, element, range, -1,
+        [&](vtkIdType id, const double* scalars, const std::vector<vtkIdType>&)
+        {
+          for (int c = 0; c < 3; c++)
+          {
+            positionValues[3 * id + c] = static_cast<float>(scalars[xyz[c]]);
+          }
+          for (size_t c = 0; c < nxyz.size(); c++)
+          {
+            normalValues[3 * id + c] = static_cast<float>(scalars[nxyz[c]]);
+          }
+          for (size_t c = 0; c < uv.size(); c++)
+          {
+            tcoordValues[2 * id + c] = static_cast<float>(scalars[uv[c]]);
+          }
+          for (size_t c = 0; c < nbColorComps; c++)
+          {
+            colorValues[nbColorComps * id + c] = ::ToColor(scalars[rgba[c]], rgbaScales[c]);
+          }
+          return true;
+        });
+
+      vtkNew<vtkPoints> points;
+      points->SetDataTypeToFloat();
+      points->SetData(positions);
+      output->SetPoints(points);
+      if (!nxyz.empty())
+      {
+        output->GetPointData()->SetNormals(normals);
+      }
+      if (!uv.empty())
+      {
+        output->GetPointData()->SetTCoords(tcoords);
+      }
+      if (colors)
+      {
+        output->GetPointData()->SetScalars(colors);
+      }
+    }
+    else if (element.Name == "face")
+    {
+      int listIndex = element.GetIndex("vertex_indices", true);
+      listIndex = listIndex < 0 ? element.GetIndex("vertex_index", true) : listIndex;
+      if (listIndex < 0)
+      {
+        continue;
+      }
+
+      std::vector<int> rgba;
+      std::vector<double> rgbaScales;
+      vtkSmartPointer<vtkUnsignedCharArray> colors = ::CreateColors(element, rgba, rgbaScales);
+      unsigned char* colorValues = colors ? colors->GetPointer(0) : nullptr;
+      const size_t nbColorComps = rgba.size();
+
+      // the faces are decoded twice, to count their vertices, then to copy them at their place
+      vtkNew<vtkIdTypeArray> offsets;
+      offsets->SetNumberOfValues(element.Count + 1);
+      vtkIdType* offsetValues = offsets->GetPointer(0);
+      offsetValues[0] = 0;
+      valid = ::ForEachItem(ply, element, range, listIndex,
+        [&](vtkIdType id, const double* scalars, const std::vector<vtkIdType>& list)
+        {
+          offsetValues[id + 1] = static_cast<vtkIdType>(list.size());
+          for (size_t c = 0; c < nbColorComps; c++)
+          {
+            colorValues[nbColorComps * id + c] = ::ToColor(scalars[rgba[c]], rgbaScales[c]);
+          }
+          return true;
+        });
+      std::partial_sum(offsetValues, offsetValues + element.Count + 1, offsetValues);
+
+      vtkNew<vtkIdTypeArray> connectivity;
+      connectivity->SetNumberOfValues(offsetValues[element.Count]);
+      vtkIdType* connectivityValues = connectivity->GetPointer(0);
+      valid = valid &&
+        ::ForEachItem(ply, element, range, listIndex,
+          [&](vtkIdType id, const double*, const std::vector<vtkIdType>& list)
+          {
+            if (std::any_of(list.begin(), list.end(),
+                  [&](vtkIdType index) { return index < 0 || index >= nbPoints; }))
+            {
+              return false;
+            }
+            std::copy(list.begin(), list.end(), connectivityValues + offsetValues[id]);
+            return true;
+          });
+
+      vtkNew<vtkCellArray> polys;
+      polys->SetData(offsets, connectivity);
+      output->SetPolys(polys);
+      if (colors)
+      {
+        output->GetCellData()->SetScalars(colors);
+      }
+    }
+
+    if (!valid)
+    {
+      vtkErrorMacro("Invalid " << element.Name << " element in " << this->FileName);
+      return 0;
+    }
+  }
+
+  return 1;
+}
@@ -0,0 +1,60 @@
+/**
+ * @class   vtkF3DPLYReader
+ * @brief   VTK Reader for ASCII and binary .ply files
+ *
+ * The file is mapped in memory and the items of its elements are decoded concurrently:
+ * the binary items are located by their stride, or by a quick pass over the lists sizes, and
+ * the ASCII lines are split in chunks parsed by different threads.
+ * The output has the same arrays as vtkPLYReader: the x, y, z vertex properties are the points,
+ * the nx, ny, nz ones the "Normals", the red, green, blue and alpha ones the "RGB" or "RGBA"
+ * scalars, the u, v ones (or s, t, texture_u, texture_v) the "TCoords", and the
+ * vertex_indices lists of the faces are the polygons, colored by their red, green and blue
+ * properties if any. Other elements and properties are ignored.
+ */
+
+#ifndef vtkF3DPLYReader_h
+#define vtkF3DPLYReader_h
+
+#include <vtkPolyDataAlgorithm.h>
+
+#include <string>
+
+class vtkF3DPLYReader : public vtkPolyDataAlgorithm
+{
+public:
+  static vtkF3DPLYReader* New();
+  vtkTypeMacro(vtkF3DPLYReader, vtkPolyDataAlgorithm);
+
+  /**
+   * Set the file name.
+   */
+  vtkSetMacro(FileName, std::string);
+
+  /**
+   * Set a buffer in memory to read instead of the file.
+   * The buffer is not copied and must be kept alive while the reader is used.
+   */
+  void SetBuffer(const void* buffer, size_t size);
+
+  /**
+   * Compute the bounds of the vertices of a file without reading its other properties
+   * and elements. Return false if the file cannot be read.
+   */
+  static bool ProbeBounds(const std::string& fileName, double bounds[6]);
+
+protected:
+  vtkF3DPLYReader();
+  ~vtkF3DPLYReader() override = default;
+
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+
+private:
+  vtkF3DPLYReader(const vtkF3DPLYReader&) = delete;
+  void operator=(const vtkF3DPLYReader&) = delete;
+
+  std::string FileName;
+  const void* Buffer = nullptr;
+  size_t BufferSize = 0;
+};
+
+#endif
@@ -0,0 +1,309 @@
+#include "vtkF3DSTLReader.h"
+
+#include "F3DMappedFile.h"
+#include "F3DTextParsing.h"
+
+#include <vtkBoundingBox.h>
+#include <vtkByteSwap.h>
+#include <vtkCellArray.h>
+#include <vtkFloatArray.h>
+#include <vtkIdTypeArray.h>
+#include <vtkInformation.h>
+#include <vtkInformationVector.h>
+#include <vtkNew.h>
+#include <vtkObjectFactory.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkSMPThreadLocal.h>
+#include <vtkSMPTools.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+namespace
+{
+// 80 bytes header followed by the number of triangles
+constexpr size_t BINARY_HEADER_SIZE = 84;
+
+// normal, 3 vertices and attribute byte count
+constexpr size_t BINARY_TRIANGLE_SIZE = 50;
+
+//----------------------------------------------------------------------------
+/**
+ * Set the points and the triangles, each triangle using its own three points
+ */
+void SetTriangles(vtkPolyData* output, vtkFloatArray* positions)
+{
+  const vtkIdType nbPoints = positions->GetNumberOfTuples();
+
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(nbPoints);
+  vtkIdType* ids = connectivity->GetPointer(0);
+  vtkSMPTools::For(0, nbPoints,
+    [&](vtkIdType begin, vtkIdType end) { std::iota(ids + begin, ids + end, begin); });
+
+  vtkNew<vtkCellArray> triangles;
+  triangles->SetData(3, connectivity);
+
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToFloat();
+  points->SetData(positions);
+  output->SetPoints(points);
+  output->SetPolys(triangles);
+}
+}
+
+//----------------------------------------------------------------------------
+vtkStandardNewMacro(vtkF3DSTLReader);
+
+//----------------------------------------------------------------------------
+vtkF3DSTLReader::vtkF3DSTLReader()
+{
+  this->SetNumberOfInputPorts(0);
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DSTLReader::SetBuffer(const void* buffer, size_t size)
+{
+  this->Buffer = buffer;
+  this->BufferSize = size;
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DSTLReader::ProbeBounds(const std::string& fileName, double bounds[6])
+{
+  F3DMappedFile file;
+  if (!file.Open(fileName))
+  {
+    return false;
+  }
+  const char* data = file.GetData();
+  const size_t size = file.GetSize();
+
+  // same detection of the binary files as RequestData
+  uint32_t nbTriangles = 0;
+  if (size >= ::BINARY_HEADER_SIZE)
+  {
+    std::memcpy(&nbTriangles, data + 80, sizeof(nbTriangles));
+    vtkByteSwap::Swap4LE(&nbTriangles);
+  }
+  const char* text = F3DTextParsing::SkipSpaces(data, data + size);
+  const bool ascii =
+    static_cast<size_t>(data + size - text) >= 5 && std::memcmp(text, "solid", 5) == 0;
+  const bool binary = size >= ::BINARY_HEADER_SIZE &&
+    (size == ::BINARY_HEADER_SIZE + nbTriangles * ::BINARY_TRIANGLE_SIZE || !ascii);
+
+  // the vertices are only scanned, each thread accumulating the bounds of its own ones
+  vtkSMPThreadLocal<vtkBoundingBox> localBoxes;
+  if (binary)
+  {
+    const char* records = data + ::BINARY_HEADER_SIZE;
+    vtkSMPTools::For(0,
+      static_cast<vtkIdType>((size - ::BINARY_HEADER_SIZE) / ::BINARY_TRIANGLE_SIZE),
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        vtkBoundingBox& box = localBoxes.Local();
+        float xyz[9];
+        for (vtkIdType i = begin; i < end; i++)
+        {
+          std::memcpy(xyz, records + ::BINARY_TRIANGLE_SIZE * i + 12, sizeof(xyz));
+          vtkByteSwap::Swap4LERange(xyz, 9);
+          for (int v = 0; v < 3; v++)
+          {
+            box.AddPoint(xyz[3 * v], xyz[3 * v + 1], xyz[3 * v + 2]);
+          }
+        }
+      });
+  }
+  else if (ascii)
+  {
+    std::vector<F3DTextParsing::Chunk> chunks = F3DTextParsing::SplitLines(data, data + size);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(chunks.size()),
+      [&](vtkIdType first, vtkIdType last)
+      {
+        vtkBoundingBox& box = localBoxes.Local();
+        for (vtkIdType c = first; c < last; c++)
+        {
+          const char* end = chunks[c].End;
+          for (const char* line = chunks[c].Begin; line != end;)
+          {
+            const char* next = F3DTextParsing::NextLine(line, end);
+            const char* cur = line;
+            float xyz[3];
+            if (F3DTextParsing::StartsWith(cur, next, "vertex") &&
+              F3DTextParsing::Parse(cur, next, xyz[0]) &&
+              F3DTextParsing::Parse(cur, next, xyz[1]) && F3DTextParsing::Parse(cur, next, xyz[2]))
+            {
+              box.AddPoint(xyz[0], xyz[1], xyz[2]);
+            }
+            line = next;
+          }
+        }
+      });
+  }
+
+  vtkBoundingBox box;
+  for (const vtkBoundingBox& localBox : localBoxes)
+  {
+    box.AddBox(localBox);
+  }
+  if (!box.IsValid())
+  {
+    return false;
+  }
+  box.GetBounds(bounds);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+int vtkF3DSTLReader::RequestData(
+  vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector)
+{
+  vtkPolyData* output = vtkPolyData::GetData(outputVector);
+
+  F3DMappedFile file;
+  if (this->Buffer)
+  {
+    file.Open(this->Buffer, this->BufferSize);
+  }
+  else if (!file.Open(this->FileName))
+  {
+    vtkErrorMacro("Cannot open file " << this->FileName);
+    return 0;
+  }
+  const char* data = file.GetData();
+  const size_t size = file.GetSize();
+
+  // binary files can also start with "solid", their size is checked first
+  if (size >= ::BINARY_HEADER_SIZE)
+  {
+    uint32_t nbTriangles;
+    std::memcpy(&nbTriangles, data + 80, sizeof(nbTriangles));
+    vtkByteSwap::Swap4LE(&nbTriangles);
+    if (size == ::BINARY_HEADER_SIZE + nbTriangles * ::BINARY_TRIANGLE_SIZE)
+    {
+      return this->RequestDataBinary(output, data + ::BINARY_HEADER_SIZE, nbTriangles);
+    }
+  }
+
+  const char* text = F3DTextParsing::SkipSpaces(data, data + size);
+  if (static_cast<size_t>(data + size - text) >= 5 && std::memcmp(text, "solid", 5) == 0)
+  {
+    return this->RequestDataASCII(output, data, size);
+  }
+
+  if (size < ::BINARY_HEADER_SIZE)
+  {
+    vtkErrorMacro("The file is too small to be a STL file: " << this->FileName);
+    return 0;
+  }
+
+  // some writers do not fill the attribute byte count, read the complete triangles
+  vtkWarningMacro("The number of triangles does not match the size of " << this->FileName);
+  return this->RequestDataBinary(output, data + ::BINARY_HEADER_SIZE,
+    static_cast<vtkIdType>((size - ::BINARY_HEADER_SIZE) / ::BINARY_TRIANGLE_SIZE));
+}
+
+//----------------------------------------------------------------------------
+int vtkF3DSTLReader::RequestDataBinary(
+  vtkPolyData* output, const char* data, vtkIdType nbTriangles)
+{
+  vtkNew<vtkFloatArray> positions;
+  positions->SetNumberOfComponents(3);
+  positions->SetNumberOfTuples(3 * nbTriangles);
+  float* values = positions->GetPointer(0);
+
+  // the records are not aligned, memcpy the vertices of each one
+  vtkSMPTools::For(0, nbTriangles,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType i = begin; i < end; i++)
+      {
+        std::memcpy(values + 9 * i, data + ::BINARY_TRIANGLE_SIZE * i + 12, 9 * sizeof(float));
+      }
+      vtkByteSwap::Swap4LERange(values + 9 * begin, 9 * (end - begin));
+    });
+
+  ::SetTriangles(output, positions);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkF3DSTLReader::RequestDataASCII(vtkPolyData* output, const char* data, size_t size)
+{
+  std::vector<F3DTextParsing::Chunk> chunks = F3DTextParsing::SplitLines(data, data + size);
+
+  // the vertices are parsed in a buffer per chunk, then copied at their place
+  std::vector<std::vector<float>> chunkValues(chunks.size());
+  std::vector<char> chunkErrors(chunks.size(), 0);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(chunks.size()),
+    [&](vtkIdType first, vtkIdType last)
+    {
+      for (vtkIdType c = first; c < last; c++)
+      {
+        const char* end = chunks[c].End;
+        std::vector<float>& values = chunkValues[c];
+        for (const char* line = chunks[c].Begin; line != end;)
+        {
+          const char* next = F3DTextParsing::NextLine(line, end);
+          const char* cur = line;
+          if (F3DTextParsing::StartsWith(cur, next, "vertex"))
+          {
+            float xyz[3];
+            if (!F3DTextParsing::Parse(cur, next, xyz[0]) ||
+              !F3DTextParsing::Parse(cur, next, xyz[1]) ||
+              !F3DTextParsing::Parse(cur, next, xyz[2]))
+            {
+              chunkErrors[c] = 1;
+              break;
+            }
+            values.insert(values.end(), xyz, xyz + 3);
+          }
+          line = next;
+        }
+      }
+    });
+
+  if (std::find(chunkErrors.begin(), chunkErrors.end(), 1) != chunkErrors.end())
+  {
+    vtkErrorMacro("Invalid vertex in " << this->FileName);
+    return 0;
+  }
+
+  std::vector<vtkIdType> chunkOffsets(chunks.size() + 1, 0);
+  for (size_t c = 0; c < chunks.size(); c++)
+  {
+    chunkOffsets[c + 1] = chunkOffsets[c] + static_cast<vtkIdType>(chunkValues[c].size());
+  }
+
+  // incomplete triangles are ignored
+  const vtkIdType nbTriangles = chunkOffsets.back() / 9;
+
+  vtkNew<vtkFloatArray> positions;
+  positions->SetNumberOfComponents(3);
+  positions->SetNumberOfTuples(3 * nbTriangles);
+  float* values = positions->GetPointer(0);
+  const vtkIdType nbValues = 9 * nbTriangles;
+
+  vtkSMPTools::For(0, static_cast<vtkIdType>(chunks.size()),
+    [&](vtkIdType first, vtkIdType last)
+    {
+      for (vtkIdType c = first; c < last; c++)
+      {
+        const vtkIdType count = std::min(
+          static_cast<vtkIdType>(chunkValues[c].size()), nbValues - chunkOffsets[c]);
+        if (count > 0)
+        {
+          std::copy(
+            chunkValues[c].begin(), chunkValues[c].begin() + count, values + chunkOffsets[c]);
+        }
+      }
+    });
+
+  ::SetTriangles(output, positions);
+  return 1;
+}
@@ -0,0 +1,66 @@
+/**
+ * @class   vtkF3DSTLReader
+ * @brief   VTK Reader for ASCII and binary .stl files
+ *
+ * The file is mapped in memory. The triangles of a binary file are copied concurrently from the
+ * mapped records, and the lines of an ASCII file are parsed concurrently by chunks.
+ * Like vtkSTLReader with merging disabled, each triangle has its own three points and the
+ * normals of the file are ignored.
+ */
+
+#ifndef vtkF3DSTLReader_h
+#define vtkF3DSTLReader_h
+
+#include <vtkPolyDataAlgorithm.h>
+
+#include <string>
+
+class vtkF3DSTLReader : public vtkPolyDataAlgorithm
+{
+public:
+  static vtkF3DSTLReader* New();
+  vtkTypeMacro(vtkF3DSTLReader, vtkPolyDataAlgorithm);
+
+  /**
+   * Set the file name.
+   */
+  vtkSetMacro(FileName, std::string);
+
+  /**
+   * Set a buffer in memory to read instead of the file.
+   * The buffer is not copied and must be kept alive while the reader is used.
+   */
+  void SetBuffer(const void* buffer, size_t size);
+
+  /**
+   * Compute the bounds of the vertices of a file without creating the triangles.
+   * Return false if the file cannot be read.
+   */
+  static bool ProbeBounds(const std::string& fileName, double bounds[6]);
+
+protected:
+  vtkF3DSTLReader();
+  ~vtkF3DSTLReader() override = default;
+
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+
+  /**
+   * Read the triangles of a binary file, after its 80 bytes header and triangles count
+   */
+  int RequestDataBinary(vtkPolyData* output, const char* data, vtkIdType nbTriangles);
+
+  /**
+   * Read the vertices of an ASCII file
+   */
+  int RequestDataASCII(vtkPolyData* output, const char* data, size_t size);
+
+private:
+  vtkF3DSTLReader(const vtkF3DSTLReader&) = delete;
+  void operator=(const vtkF3DSTLReader&) = delete;
+
+  std::string FileName;
+  const void* Buffer = nullptr;
+  size_t BufferSize = 0;
+};
+
+#endif
@@ -12,8 +12,87 @@
 #include <vtkPointData.h>
 #include <vtkPoints.h>
 #include <vtkPolyData.h>
+#include <vtkSMPTools.h>
 #include <vtkUnsignedCharArray.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+//----------------------------------------------------------------------------
+/**
+ * The vertex properties of a binary little endian .ply file
+ */
+struct PLYHeader
+{
+  vtkIdType NumberOfVertices = 0;
+  std::vector<std::string> Properties;
+  std::string Error;
+};
+
+//----------------------------------------------------------------------------
+PLYHeader ParsePLYHeader(const std::string& header)
+{
+  PLYHeader ply;
+  std::istringstream lines(header);
+  std::string line;
+  bool binary = false;
+  bool inVertex = false;
+  while (std::getline(lines, line))
+  {
+    std::istringstream words(line);
+    std::string keyword;
+    words >> keyword;
+    if (keyword == "format")
+    {
+      std::string format;
+      words >> format;
+      binary = format == "binary_little_endian";
+    }
+    else if (keyword == "element")
+    {
+      std::string name;
+      words >> name;
+      inVertex = name == "vertex";
+      if (inVertex)
+      {
+        words >> ply.NumberOfVertices;
+      }
+    }
+    else if (keyword == "property" && inVertex)
+    {
+      std::string type;
+      std::string name;
+      words >> type >> name;
+      if (type != "float" && type != "float32")
+      {
+        ply.Error = "Unsupported type " + type + " of the vertex property " + name;
+        return ply;
+      }
+      ply.Properties.emplace_back(name);
+    }
+  }
+  if (!binary)
+  {
+    ply.Error = "Only binary little endian gaussian splatting .ply files are supported";
+  }
+  return ply;
+}
+
+//----------------------------------------------------------------------------
+int GetPropertyIndex(const PLYHeader& ply, const std::string& name)
+{
+  auto it = std::find(ply.Properties.begin(), ply.Properties.end(), name);
+  return it == ply.Properties.end() ? -1 : static_cast<int>(it - ply.Properties.begin());
+}
+}
+
 //----------------------------------------------------------------------------
 vtkStandardNewMacro(vtkF3DSplatReader);
 
@@ -23,27 +102,238 @@ vtkF3DSplatReader::vtkF3DSplatReader()
   this->SetNumberOfInputPorts(0);
 }
 
+//----------------------------------------------------------------------------
+void vtkF3DSplatReader::SetBuffer(const void* buffer, size_t size)
+{
+  this->Buffer = static_cast<const unsigned char*>(buffer);
+  this->BufferSize = size;
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DSplatReader::IsGaussianPLYFile(const std::string& fileName)
+{
+  std::ifstream file(fileName, std::ios::binary);
+  std::string line;
+  if (!std::getline(file, line) || line.compare(0, 3, "ply") != 0)
+  {
+    return false;
+  }
+
+  bool hasColor = false;
+  bool hasRotation = false;
+  while (std::getline(file, line) && line.compare(0, 10, "end_header") != 0)
+  {
+    hasColor = hasColor || line.find(" f_dc_0") != std::string::npos;
+    hasRotation = hasRotation || line.find(" rot_0") != std::string::npos;
+  }
+  return hasColor && hasRotation;
+}
+
 //----------------------------------------------------------------------------
 int vtkF3DSplatReader::RequestData(
   vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector)
 {
   vtkPolyData* output = vtkPolyData::GetData(outputVector);
 
-  std::ifstream inputStream(this->FileName, std::ios::binary);
+  std::ifstream inputStream;
+  std::streamoff fileSize = static_cast<std::streamoff>(this->BufferSize);
+  if (!this->Buffer)
+  {
+    inputStream.open(this->FileName, std::ios::binary | std::ios::ate);
+    if (!inputStream)
+    {
+      vtkErrorMacro("Cannot open file " << this->FileName);
+      return 0;
+    }
+    fileSize = inputStream.tellg();
+    inputStream.seekg(0, std::ios::beg);
+  }
 
-  std::vector<unsigned char> buffer(std::istreambuf_iterator<char>(inputStream), {});
+  // .ply files start with a text header ending with an end_header line
+  std::string header;
+  if (this->Buffer)
+  {
+    const char* begin = reinterpret_cast<const char*>(this->Buffer);
+    const std::string_view view(begin, this->BufferSize);
+    if (view.compare(0, 3, "ply") == 0)
+    {
+      size_t end = view.find("end_header");
+      end = end == std::string_view::npos ? end : view.find('\n', end);
+      if (end != std::string_view::npos)
+      {
+        header.assign(begin, end + 1);
+      }
+    }
+  }
+  else
+  {
+    std::string line;
+    if (std::getline(inputStream, line) && line.compare(0, 3, "ply") == 0)
+    {
+      header = line + "\n";
+      while (std::getline(inputStream, line))
+      {
+        header += line + "\n";
+        if (line.compare(0, 10, "end_header") == 0)
+        {
+          break;
+        }
+      }
+    }
+    else
+    {
+      inputStream.clear();
+      inputStream.seekg(0, std::ios::beg);
+    }
+  }
+  if (!header.empty())
+  {
+    return this->RequestDataPLY(
+      output, inputStream, header, fileSize - static_cast<std::streamoff>(header.size()));
+  }
 
   // position: 3 floats (12 bytes)
   // scale: 3 floats (12 bytes)
-  // rotation: 4 chars (4 bytes)
   // color+opacity: 4 chars (4 bytes)
+  // rotation: 4 chars (4 bytes)
   constexpr size_t splatSize = 32;
   constexpr size_t positionOffset = 0;
   constexpr size_t scaleOffset = 12;
   constexpr size_t colorOffset = 24;
   constexpr size_t rotationOffset = 28;
 
-  size_t nbSplats = buffer.size() / splatSize;
+  const vtkIdType nbSplats = static_cast<vtkIdType>(fileSize / splatSize);
+
+  vtkNew<vtkFloatArray> positionArray;
+  positionArray->SetNumberOfComponents(3);
+  positionArray->SetNumberOfTuples(nbSplats);
+  positionArray->SetName("position");
+
+  vtkNew<vtkFloatArray> scaleArray;
+  scaleArray->SetNumberOfComponents(3);
+  scaleArray->SetNumberOfTuples(nbSplats);
+  scaleArray->SetName("scale");
+
+  vtkNew<vtkUnsignedCharArray> colorArray;
+  colorArray->SetNumberOfComponents(4);
+  colorArray->SetNumberOfTuples(nbSplats);
+  colorArray->SetName("color");
+
+  vtkNew<vtkFloatArray> rotationArray;
+  rotationArray->SetNumberOfComponents(4);
+  rotationArray->SetNumberOfTuples(nbSplats);
+  rotationArray->SetName("rotation");
+
+  float* positions = positionArray->GetPointer(0);
+  float* scales = scaleArray->GetPointer(0);
+  unsigned char* colors = colorArray->GetPointer(0);
+  float* rotations = rotationArray->GetPointer(0);
+
+  // The file is read by chunks into a small buffer that is directly scattered into the arrays
+  // so that the memory peak is close to the size of the arrays instead of twice the file size.
+  // A buffer in memory is scattered directly.
+  constexpr vtkIdType chunkSplats = 1 << 20;
+  std::vector<unsigned char> buffer(
+    this->Buffer ? 0 : std::min(nbSplats, chunkSplats) * splatSize);
+
+  for (vtkIdType first = 0; first < nbSplats; first += chunkSplats)
+  {
+    const vtkIdType count = std::min(chunkSplats, nbSplats - first);
+    const unsigned char* chunk = this->Buffer ? this->Buffer + first * splatSize : buffer.data();
+    if (!this->Buffer &&
+      !inputStream.read(reinterpret_cast<char*>(buffer.data()), count * splatSize))
+    {
+      vtkErrorMacro("Cannot read splats from " << this->FileName);
+      return 0;
+    }
+
+    vtkSMPTools::For(0, count,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        for (vtkIdType i = begin; i < end; i++)
+        {
+          const unsigned char* splat = chunk + splatSize * i;
+          const vtkIdType id = first + i;
+
+          // memcpy avoids unaligned float reads
+          std::memcpy(positions + 3 * id, splat + positionOffset, 3 * sizeof(float));
+          std::memcpy(scales + 3 * id, splat + scaleOffset, 3 * sizeof(float));
+          std::memcpy(colors + 4 * id, splat + colorOffset, 4);
+
+          const unsigned char* rotation = splat + rotationOffset;
+          for (int c = 0; c < 4; c++)
+          {
+            rotations[4 * id + c] = (static_cast<float>(rotation[c]) - 128.f) / 128.f;
+          }
+        }
+      });
+
+    this->UpdateProgress(static_cast<double>(first + count) / nbSplats);
+    if (this->GetAbortExecute())
+    {
+      return 0;
+    }
+  }
+
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToFloat();
+  points->SetData(positionArray);
+  output->SetPoints(points);
+
+  output->GetPointData()->SetScalars(colorArray);
+  output->GetPointData()->AddArray(scaleArray);
+  output->GetPointData()->AddArray(rotationArray);
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkF3DSplatReader::RequestDataPLY(vtkPolyData* output, std::istream& inputStream,
+  const std::string& header, std::streamoff dataSize)
+{
+  ::PLYHeader ply = ::ParsePLYHeader(header);
+  if (!ply.Error.empty())
+  {
+    vtkErrorMacro(<< ply.Error);
+    return 0;
+  }
+
+  const int x = ::GetPropertyIndex(ply, "x");
+  const int dc = ::GetPropertyIndex(ply, "f_dc_0");
+  const int opacity = ::GetPropertyIndex(ply, "opacity");
+  const int scale = ::GetPropertyIndex(ply, "scale_0");
+  const int rot = ::GetPropertyIndex(ply, "rot_0");
+  if (x < 0 || dc < 0 || opacity < 0 || scale < 0 || rot < 0 ||
+    ::GetPropertyIndex(ply, "z") != x + 2 || ::GetPropertyIndex(ply, "f_dc_2") != dc + 2 ||
+    ::GetPropertyIndex(ply, "scale_2") != scale + 2 || ::GetPropertyIndex(ply, "rot_3") != rot + 3)
+  {
+    vtkErrorMacro("Missing gaussian vertex properties in " << this->FileName);
+    return 0;
+  }
+
+  // The coefficients of each channel are contiguous: all the red ones, then green, then blue
+  const int rest = ::GetPropertyIndex(ply, "f_rest_0");
+  int nbRest = 0;
+  while (rest >= 0 &&
+    ::GetPropertyIndex(ply, "f_rest_" + std::to_string(nbRest)) == rest + nbRest)
+  {
+    nbRest++;
+  }
+  const int nbCoeffs = nbRest / 3;
+  if (nbCoeffs != 0 && nbCoeffs != 3 && nbCoeffs != 8 && nbCoeffs != 15)
+  {
+    vtkErrorMacro("Unsupported number of spherical harmonics coefficients: " << nbRest);
+    return 0;
+  }
+
+  const vtkIdType nbSplats = ply.NumberOfVertices;
+  const size_t splatSize = ply.Properties.size() * sizeof(float);
+  if (dataSize < static_cast<std::streamoff>(nbSplats * splatSize))
+  {
+    vtkErrorMacro("The gaussian splatting .ply file is truncated: " << this->FileName);
+    return 0;
+  }
 
   vtkNew<vtkFloatArray> positionArray;
   positionArray->SetNumberOfComponents(3);
@@ -65,20 +355,76 @@ int vtkF3DSplatReader::RequestData(
   rotationArray->SetNumberOfTuples(nbSplats);
   rotationArray->SetName("rotation");
 
-  for (size_t i = 0; i < nbSplats; i++)
+  vtkNew<vtkFloatArray> harmonicsArray;
+  harmonicsArray->SetNumberOfComponents(std::max(3 * nbCoeffs, 1));
+  harmonicsArray->SetNumberOfTuples(nbCoeffs > 0 ? nbSplats : 0);
+  harmonicsArray->SetName("spherical_harmonics");
+
+  float* positions = positionArray->GetPointer(0);
+  float* scales = scaleArray->GetPointer(0);
+  unsigned char* colors = colorArray->GetPointer(0);
+  float* rotations = rotationArray->GetPointer(0);
+  float* harmonics = harmonicsArray->GetPointer(0);
+
+  // Read by chunks like .splat files
+  constexpr vtkIdType chunkSplats = 1 << 18;
+  std::vector<unsigned char> buffer(
+    this->Buffer ? 0 : std::min(nbSplats, chunkSplats) * splatSize);
+  const unsigned char* data = this->Buffer ? this->Buffer + header.size() : nullptr;
+
+  for (vtkIdType first = 0; first < nbSplats; first += chunkSplats)
   {
-    float* position = reinterpret_cast<float*>(buffer.data() + (splatSize * i) + positionOffset);
-    float* scale = reinterpret_cast<float*>(buffer.data() + (splatSize * i) + scaleOffset);
-    unsigned char* rotation = buffer.data() + (splatSize * i) + rotationOffset;
-    unsigned char* color = buffer.data() + (splatSize * i) + colorOffset;
+    const vtkIdType count = std::min(chunkSplats, nbSplats - first);
+    const unsigned char* chunk = data ? data + first * splatSize : buffer.data();
+    if (!data && !inputStream.read(reinterpret_cast<char*>(buffer.data()), count * splatSize))
+    {
+      vtkErrorMacro("Cannot read splats from " << this->FileName);
+      return 0;
+    }
+
+    vtkSMPTools::For(0, count,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        std::vector<float> props(ply.Properties.size());
+        for (vtkIdType i = begin; i < end; i++)
+        {
+          // memcpy avoids unaligned float reads
+          std::memcpy(props.data(), chunk + splatSize * i, splatSize);
+          const vtkIdType id = first + i;
+
+          // The trainers store the values before their activation functions
+          constexpr float SH_C0 = 0.28209479177387814f;
+          for (int c = 0; c < 3; c++)
+          {
+            positions[3 * id + c] = props[x + c];
+            scales[3 * id + c] = std::exp(props[scale + c]);
+            float color = std::clamp(0.5f + SH_C0 * props[dc + c], 0.f, 1.f);
+            colors[4 * id + c] = static_cast<unsigned char>(color * 255.f + 0.5f);
+          }
+          float alpha = 1.f / (1.f + std::exp(-props[opacity]));
+          colors[4 * id + 3] = static_cast<unsigned char>(alpha * 255.f + 0.5f);
 
-    positionArray->SetTypedTuple(i, position);
-    scaleArray->SetTypedTuple(i, scale);
-    colorArray->SetTypedTuple(i, color);
+          float norm = std::sqrt(props[rot] * props[rot] + props[rot + 1] * props[rot + 1] +
+            props[rot + 2] * props[rot + 2] + props[rot + 3] * props[rot + 3]);
+          for (int c = 0; c < 4; c++)
+          {
+            rotations[4 * id + c] = norm > 0.f ? props[rot + c] / norm : (c == 0 ? 1.f : 0.f);
+          }
 
-    for (int c = 0; c < 4; c++)
+          for (int j = 0; j < nbCoeffs; j++)
+          {
+            for (int c = 0; c < 3; c++)
+            {
+              harmonics[(id * nbCoeffs + j) * 3 + c] = props[rest + c * nbCoeffs + j];
+            }
+          }
+        }
+      });
+
+    this->UpdateProgress(static_cast<double>(first + count) / nbSplats);
+    if (this->GetAbortExecute())
     {
-      rotationArray->SetTypedComponent(i, c, (static_cast<float>(rotation[c]) - 128.f) / 128.f);
+      return 0;
     }
   }
 
@@ -90,6 +436,10 @@ int vtkF3DSplatReader::RequestData(
   output->GetPointData()->SetScalars(colorArray);
   output->GetPointData()->AddArray(scaleArray);
   output->GetPointData()->AddArray(rotationArray);
+  if (nbCoeffs > 0)
+  {
+    output->GetPointData()->AddArray(harmonicsArray);
+  }
 
   return 1;
 }
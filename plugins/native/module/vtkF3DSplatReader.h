@@ -1,11 +1,17 @@
 /**
  * @class   vtkF3DSplatReader
- * @brief   VTK Reader for 3D Gaussians in binary .splat file format
+ * @brief   VTK Reader for 3D Gaussians in binary .splat and 3DGS .ply file formats
  *
  * Reader for binary .splat files as defined in https://github.com/antimatter15/splat
  * This reader will probably evolve until there is no standard defined yet
  * An interesting discussion can be followed here:
  * https://github.com/mkkellogg/GaussianSplats3D/issues/47
+ *
+ * Binary little endian .ply files written by 3D Gaussian Splatting trainers, with the
+ * f_dc_*, f_rest_*, opacity, scale_* and rot_* float vertex properties, are also read.
+ * Their activations are applied so that the output has the same arrays as a .splat file,
+ * and the spherical harmonics coefficients of degree 1 to 3, if any, are stored in a
+ * "spherical_harmonics" array with the RGB values of each coefficient interleaved.
  */
 
 #ifndef vtkF3DSplatReader_h
@@ -13,6 +19,9 @@
 
 #include <vtkPolyDataAlgorithm.h>
 
+#include <iosfwd>
+#include <string>
+
 class vtkF3DSplatReader : public vtkPolyDataAlgorithm
 {
 public:
@@ -24,17 +33,37 @@ public:
    */
   vtkSetMacro(FileName, std::string);
 
+  /**
+   * Set a buffer in memory to read instead of the file.
+   * The buffer is not copied and must be kept alive while the reader is used.
+   */
+  void SetBuffer(const void* buffer, size_t size);
+
+  /**
+   * Return true if the provided file is a 3D Gaussian Splatting .ply file,
+   * by looking for the gaussian vertex properties in its header.
+   */
+  static bool IsGaussianPLYFile(const std::string& fileName);
+
 protected:
   vtkF3DSplatReader();
   ~vtkF3DSplatReader() override = default;
 
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
 
+  /**
+   * Read the vertices of a 3D Gaussian Splatting .ply file, after its header
+   */
+  int RequestDataPLY(vtkPolyData* output, std::istream& inputStream, const std::string& header,
+    std::streamoff dataSize);
+
 private:
   vtkF3DSplatReader(const vtkF3DSplatReader&) = delete;
   void operator=(const vtkF3DSplatReader&) = delete;
 
   std::string FileName;
+  const unsigned char* Buffer = nullptr;
+  size_t BufferSize = 0;
 };
 
 #endif
@@ -0,0 +1,18 @@
+bool canRead(const std::string& fileName) const override
+{
+  // Files with materials are read by the OBJ importer
+  return f3d::reader::canRead(fileName) && !vtkF3DOBJReader::HasMaterialLibrary(fileName);
+}
+
+bool canReadFromMemory() const override
+{
+  return true;
+}
+
+vtkSmartPointer<vtkAlgorithm> createGeometryReaderFromMemory(
+  const void* buffer, size_t size) const override
+{
+  vtkNew<vtkF3DOBJReader> objReader;
+  objReader->SetBuffer(buffer, size);
+  return objReader;
+}
@@ -0,0 +1,17 @@
+bool canReadFromMemory() const override
+{
+  return true;
+}
+
+vtkSmartPointer<vtkAlgorithm> createGeometryReaderFromMemory(
+  const void* buffer, size_t size) const override
+{
+  vtkNew<vtkF3DPLYReader> plyReader;
+  plyReader->SetBuffer(buffer, size);
+  return plyReader;
+}
+
+bool probeBounds(const std::string& fileName, double bounds[6]) const override
+{
+  return vtkF3DPLYReader::ProbeBounds(fileName, bounds);
+}
@@ -0,0 +1,17 @@
+bool canReadFromMemory() const override
+{
+  return true;
+}
+
+vtkSmartPointer<vtkAlgorithm> createGeometryReaderFromMemory(
+  const void* buffer, size_t size) const override
+{
+  vtkNew<vtkF3DSTLReader> stlReader;
+  stlReader->SetBuffer(buffer, size);
+  return stlReader;
+}
+
+bool probeBounds(const std::string& fileName, double bounds[6]) const override
+{
+  return vtkF3DSTLReader::ProbeBounds(fileName, bounds);
+}
@@ -0,0 +1,13 @@
+bool canReadFromMemory() const override
+{
+  return true;
+}
+
+vtkSmartPointer<vtkAlgorithm> createGeometryReaderFromMemory(
+  const void* buffer, size_t size) const override
+{
+  vtkNew<vtkPLYReader> plyReader;
+  plyReader->ReadFromInputStringOn();
+  plyReader->SetInputString(static_cast<const char*>(buffer), static_cast<int>(size));
+  return plyReader;
+}
@@ -0,0 +1,12 @@
+bool canReadFromMemory() const override
+{
+  return true;
+}
+
+vtkSmartPointer<vtkAlgorithm> createGeometryReaderFromMemory(
+  const void* buffer, size_t size) const override
+{
+  vtkNew<vtkF3DSplatReader> splatReader;
+  splatReader->SetBuffer(buffer, size);
+  return splatReader;
+}
@@ -0,0 +1,16 @@
+bool selectArrays(vtkAlgorithm* algo, const std::vector<std::string>& arrayNames) const override
+{
+  // Only the datasets of the selected arrays are read from the file, at each time step
+  vtkHDFReader* hdfReader = vtkHDFReader::SafeDownCast(algo);
+  hdfReader->UpdateInformation();
+  for (vtkDataArraySelection* selection :
+    { hdfReader->GetPointDataArraySelection(), hdfReader->GetCellDataArraySelection() })
+  {
+    selection->DisableAllArrays();
+    for (const std::string& name : arrayNames)
+    {
+      selection->EnableArray(name.c_str());
+    }
+  }
+  return true;
+}
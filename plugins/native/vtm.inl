@@ -0,0 +1,13 @@
+#include "xml.inl"
+
+bool selectBlocks(vtkAlgorithm* algo, const std::vector<std::string>& paths) const override
+{
+  // Paths are selectors of the data assembly of the hierarchy, eg. /Root/Wing
+  vtkXMLCompositeDataReader* compositeReader = vtkXMLCompositeDataReader::SafeDownCast(algo);
+  compositeReader->ClearSelectors();
+  for (const std::string& path : paths)
+  {
+    compositeReader->AddSelector(path.c_str());
+  }
+  return true;
+}
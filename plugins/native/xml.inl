@@ -0,0 +1,17 @@
+bool selectArrays(vtkAlgorithm* algo, const std::vector<std::string>& arrayNames) const override
+{
+  // The arrays are listed by the information pass, the ones not listed yet are not read either
+  vtkXMLReader* xmlReader = vtkXMLReader::SafeDownCast(algo);
+  xmlReader->UpdateInformation();
+  for (vtkDataArraySelection* selection :
+    { xmlReader->GetPointDataArraySelection(), xmlReader->GetCellDataArraySelection() })
+  {
+    selection->SetUnknownArraySetting(0);
+    selection->DisableAllArrays();
+    for (const std::string& name : arrayNames)
+    {
+      selection->EnableArray(name.c_str());
+    }
+  }
+  return true;
+}
@@ -8,3 +8,25 @@ void applyCustomReader(vtkAlgorithm* algo, const std::string& vtkNotUsed(fileNam
   occtReader->ReadWireOn();
   occtReader->SetFileFormat(vtkF3DOCCTReader::FILE_FORMAT::IGES);
 }
+
+bool applyThumbnailReader(vtkAlgorithm* algo) const override
+{
+  vtkF3DOCCTReader* occtReader = vtkF3DOCCTReader::SafeDownCast(algo);
+
+  // A thumbnail is a few hundred pixels wide, a coarse tessellation cannot be noticed
+  occtReader->SetLinearDeflection(0.5);
+  occtReader->SetAngularDeflection(1.0);
+  return true;
+}
+
+bool enableRefinement(vtkAlgorithm* algo) const override
+{
+  vtkF3DOCCTReader::SafeDownCast(algo)->AdaptiveTessellationOn();
+  return true;
+}
+
+vtkSmartPointer<vtkPolyData> refineSurface(
+  vtkAlgorithm* algo, vtkPolyData* surface, double deflection) const override
+{
+  return vtkF3DOCCTReader::SafeDownCast(algo)->Refine(surface, deflection);
+}
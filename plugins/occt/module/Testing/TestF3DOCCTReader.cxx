@@ -1,14 +1,36 @@
+#include <vtkDataObjectTreeIterator.h>
 #include <vtkMultiBlockDataSet.h>
 #include <vtkNew.h>
+#include <vtkPolyData.h>
 #include <vtkTestUtilities.h>
+#include <vtksys/SystemTools.hxx>
 
+#include "vtkF3DCache.h"
 #include "vtkF3DOCCTReader.h"
 
 #include <iostream>
 
-bool testReader(const std::string& filename, const vtkF3DOCCTReader::FILE_FORMAT& format)
+vtkIdType countCells(vtkMultiBlockDataSet* mb)
+{
+  vtkIdType count = 0;
+  vtkNew<vtkDataObjectTreeIterator> iter;
+  iter->SetDataSet(mb);
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    vtkPolyData* pd = vtkPolyData::SafeDownCast(iter->GetCurrentDataObject());
+    if (pd)
+    {
+      count += pd->GetNumberOfCells();
+    }
+  }
+  return count;
+}
+
+vtkIdType testReader(const std::string& filename, const vtkF3DOCCTReader::FILE_FORMAT& format,
+  int maxThreads = 0)
 {
   vtkNew<vtkF3DOCCTReader> reader;
+  reader->SetMaxThreads(maxThreads);
   reader->RelativeDeflectionOn();
   reader->SetLinearDeflection(0.1);
   reader->SetAngularDeflection(0.5);
@@ -17,16 +39,77 @@ bool testReader(const std::string& filename, const vtkF3DOCCTReader::FILE_FORMAT
   reader->SetFileFormat(format);
   reader->Update();
   reader->Print(cout);
-  return reader->GetOutput()->GetNumberOfBlocks() > 0;
+  return reader->GetOutput()->GetNumberOfBlocks() > 0 ? countCells(reader->GetOutput()) : -1;
 }
 
 int TestF3DOCCTReader(int vtkNotUsed(argc), char* argv[])
 {
   const std::string data = std::string(argv[1]) + "data";
-  return (testReader(data + "/f3d.stp", vtkF3DOCCTReader::FILE_FORMAT::STEP) &&
-           testReader(data + "/f3d.igs", vtkF3DOCCTReader::FILE_FORMAT::IGES) &&
-           testReader(data + "/f3d.brep", vtkF3DOCCTReader::FILE_FORMAT::BREP) &&
-           testReader(data + "/f3d.xbf", vtkF3DOCCTReader::FILE_FORMAT::XBF))
-    ? EXIT_SUCCESS
-    : EXIT_FAILURE;
+  if (testReader(data + "/f3d.stp", vtkF3DOCCTReader::FILE_FORMAT::STEP) < 0 ||
+    testReader(data + "/f3d.igs", vtkF3DOCCTReader::FILE_FORMAT::IGES) < 0 ||
+    testReader(data + "/f3d.brep", vtkF3DOCCTReader::FILE_FORMAT::BREP) < 0 ||
+    testReader(data + "/f3d.xbf", vtkF3DOCCTReader::FILE_FORMAT::XBF) < 0)
+  {
+    return EXIT_FAILURE;
+  }
+
+  // check the serial tessellation gives the same result as the parallel one
+  if (testReader(data + "/f3d.stp", vtkF3DOCCTReader::FILE_FORMAT::STEP, 1) !=
+    testReader(data + "/f3d.stp", vtkF3DOCCTReader::FILE_FORMAT::STEP))
+  {
+    std::cerr << "The serial tessellation is different from the parallel one" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // check the tessellation cache gives the same result
+  const std::string cacheDir = std::string(argv[2]) + "/TestF3DOCCTReaderCache";
+  vtksys::SystemTools::RemoveADirectory(cacheDir);
+  vtkF3DCache::SetDirectory(cacheDir);
+
+  vtkIdType firstRead = testReader(data + "/f3d.stp", vtkF3DOCCTReader::FILE_FORMAT::STEP);
+  if (!vtksys::SystemTools::FileIsDirectory(cacheDir + "/occt"))
+  {
+    std::cerr << "The tessellation cache has not been written" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkIdType cachedRead = testReader(data + "/f3d.stp", vtkF3DOCCTReader::FILE_FORMAT::STEP);
+  vtkF3DCache::SetDirectory("");
+  if (firstRead <= 0 || firstRead != cachedRead)
+  {
+    std::cerr << "The cached tessellation is different: " << firstRead << " != " << cachedRead
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // check the adaptive tessellation refines the surfaces only once for a given deflection
+  vtkNew<vtkF3DOCCTReader> adaptiveReader;
+  adaptiveReader->RelativeDeflectionOn();
+  adaptiveReader->SetLinearDeflection(0.1);
+  adaptiveReader->SetAngularDeflection(0.5);
+  adaptiveReader->ReadWireOn();
+  adaptiveReader->AdaptiveTessellationOn();
+  adaptiveReader->SetFileName(data + "/f3d.stp");
+  adaptiveReader->SetFileFormat(vtkF3DOCCTReader::FILE_FORMAT::STEP);
+  adaptiveReader->Update();
+  if (countCells(adaptiveReader->GetOutput()) >= firstRead)
+  {
+    std::cerr << "The adaptive tessellation is not coarser" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkDataObjectTreeIterator> iter;
+  iter->SetDataSet(adaptiveReader->GetOutput());
+  iter->InitTraversal();
+  vtkPolyData* surface = vtkPolyData::SafeDownCast(iter->GetCurrentDataObject());
+  vtkSmartPointer<vtkPolyData> refined =
+    surface ? adaptiveReader->Refine(surface, 1e-3 * surface->GetLength()) : nullptr;
+  if (!refined || refined->GetNumberOfCells() <= surface->GetNumberOfCells() ||
+    adaptiveReader->Refine(surface, 1e-3 * surface->GetLength()))
+  {
+    std::cerr << "The adaptive tessellation is not refined as expected" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
 }
@@ -55,25 +55,47 @@
 #include <vtkCommand.h>
 #include <vtkDemandDrivenPipeline.h>
 #include <vtkFloatArray.h>
+#include <vtkIdTypeArray.h>
 #include <vtkInformation.h>
+#include <vtkInformationDoubleVectorKey.h>
 #include <vtkInformationVector.h>
+#include <vtkMath.h>
 #include <vtkMatrix4x4.h>
 #include <vtkMultiBlockDataSet.h>
 #include <vtkNew.h>
 #include <vtkPointData.h>
 #include <vtkPoints.h>
 #include <vtkPolyData.h>
+#include <vtkSMPTools.h>
 #include <vtkTransform.h>
 #include <vtkTransformFilter.h>
 #include <vtkUnsignedCharArray.h>
 #include <vtkUnsignedIntArray.h>
+#include <vtkXMLMultiBlockDataReader.h>
+#include <vtkXMLMultiBlockDataWriter.h>
 #include <vtksys/SystemTools.hxx>
 
+#include <vtkF3DCache.h>
+#include <vtkF3DImporter.h>
+#include <vtkF3DTrace.h>
+
+#include <algorithm>
 #include <array>
 #include <numeric>
+#include <sstream>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
+namespace
+{
+// factor applied to the linear deflection of the first tessellation when it is adaptive
+constexpr double COARSE_DEFLECTION_FACTOR = 4.0;
+
+// smallest linear deflection of a refined tessellation, relative to the shape size
+constexpr double MIN_RELATIVE_DEFLECTION = 1e-3;
+}
+
 class vtkF3DOCCTReader::vtkInternals
 {
 #if F3D_PLUGIN_OCCT_XCAF
@@ -89,9 +111,11 @@ public:
 
   //----------------------------------------------------------------------------
 #if F3D_PLUGIN_OCCT_XCAF
-  vtkSmartPointer<vtkPolyData> CreateShape(const TopoDS_Shape& shape, const TDF_Label& label)
+  vtkSmartPointer<vtkPolyData> CreateShape(
+    const TopoDS_Shape& shape, const TDF_Label& label, double deflection, bool relative)
 #else
-  vtkSmartPointer<vtkPolyData> CreateShape(const TopoDS_Shape& shape)
+  vtkSmartPointer<vtkPolyData> CreateShape(
+    const TopoDS_Shape& shape, double deflection, bool relative)
 #endif
   {
     vtkNew<vtkPoints> points;
@@ -115,9 +139,12 @@ public:
     const StyleMap inheritedStyles = this->CollectInheritedStyles(label, shape);
 #endif
 
+    /* Only let OCCT mesh in parallel when not explicitly limited to a single thread */
+    const Standard_Boolean isInParallel = this->Parent->GetMaxThreads() != 1;
+
     /* Mesh the whole shape. This only affect faces, edges have to be handled separately. */
-    BRepMesh_IncrementalMesh(shape, this->Parent->GetLinearDeflection(),
-      this->Parent->GetRelativeDeflection(), this->Parent->GetAngularDeflection(), Standard_True);
+    BRepMesh_IncrementalMesh(
+      shape, deflection, relative, this->Parent->GetAngularDeflection(), isInParallel);
 
     if (this->Parent->GetReadWire())
     {
@@ -133,9 +160,8 @@ public:
           builder.Add(compound, edge);
           edges.push_back(edge);
         }
-        BRepMesh_IncrementalMesh(compound, this->Parent->GetLinearDeflection(),
-          this->Parent->GetRelativeDeflection(), this->Parent->GetAngularDeflection(),
-          Standard_True);
+        BRepMesh_IncrementalMesh(
+          compound, deflection, relative, this->Parent->GetAngularDeflection(), isInParallel);
       }
 
       // Add all edges to polydata
@@ -193,113 +219,185 @@ public:
       }
     }
 
-    // Add all faces to polydata
+    // Collect the triangulated faces and compute, with a prefix sum, the offset of each face
+    // into the output arrays so they can then be converted in parallel
+    struct FaceInfo
+    {
+      TopoDS_Face Face;
+      Handle(Poly_Triangulation) Poly;
+      TopLoc_Location Location;
+      vtkIdType PointOffset;
+      vtkIdType TriangleOffset;
+      std::array<unsigned char, 3> Color;
+    };
+    std::vector<FaceInfo> faces;
+    std::vector<Handle(Poly_Triangulation)> triangulations;
+    std::unordered_set<const Poly_Triangulation*> uniqueTriangulations;
+    vtkIdType nbFacePoints = 0;
+    vtkIdType nbTriangles = 0;
     for (TopExp_Explorer exFace(shape, TopAbs_FACE); exFace.More(); exFace.Next())
     {
-      TopoDS_Face face = TopoDS::Face(exFace.Current());
-
-      TopLoc_Location location;
-      const auto& poly = BRep_Tool::Triangulation(face, location);
+      FaceInfo info;
+      info.Face = TopoDS::Face(exFace.Current());
+      info.Poly = BRep_Tool::Triangulation(info.Face, info.Location);
 
-      if (poly.IsNull())
+      if (info.Poly.IsNull())
       {
         continue;
       }
 
-      Poly::ComputeNormals(poly);
-      TopAbs_Orientation faceOrientation = face.Orientation();
-
-      Standard_Integer nbT = poly->NbTriangles();
-      Standard_Integer nbV = poly->NbNodes();
-
-      // Points
-      for (Standard_Integer i = 1; i <= nbV; i++)
-      {
-        gp_Pnt pt = poly->Node(i).Transformed(location);
-        points->InsertNextPoint(pt.X(), pt.Y(), pt.Z());
-      }
-
-      // Normals
-      if (poly->HasNormals())
-      {
-        for (Standard_Integer i = 1; i <= nbV; i++)
-        {
-          gp_Dir n = poly->Normal(i);
-          float fn[3] = { static_cast<float>(n.X()), static_cast<float>(n.Y()),
-            static_cast<float>(n.Z()) };
-          if (faceOrientation == TopAbs_Orientation::TopAbs_REVERSED)
-          {
-            vtkMath::MultiplyScalar(fn, -1.f);
-          }
-          normals->InsertNextTypedTuple(fn);
-        }
-      }
-      else
-      {
-        // just in case a face does not have normals, add a dummy normal
-        float fn[3] = { 0.0, 0.0, 1.0 };
-        for (Standard_Integer i = 1; i <= nbV; i++)
-        {
-          normals->InsertNextTypedTuple(fn);
-        }
-      }
-
-      // UVs
-      if (poly->HasUVNodes())
-      {
-        for (Standard_Integer i = 1; i <= nbV; i++)
-        {
-          gp_Pnt2d uv = poly->UVNode(i);
-          float fn[2] = { static_cast<float>(uv.X()), static_cast<float>(uv.Y()) };
-          uvs->InsertNextTypedTuple(fn);
-        }
-      }
-      else
-      {
-        uvs->SetNumberOfTuples(nbV);
-        uvs->Fill(0.0);
-      }
-
-      for (int i = 1; i <= nbT; i++)
-      {
-        int n1, n2, n3;
-        poly->Triangle(i).Get(n1, n2, n3);
-
-        vtkIdType cell[3] = { shift + n1 - 1, shift + n2 - 1, shift + n3 - 1 };
-        if (faceOrientation != TopAbs_Orientation::TopAbs_FORWARD)
-        {
-          std::swap(cell[0], cell[2]);
-        }
-        trianglesCells->InsertNextCell(3, cell);
-      }
+      info.PointOffset = shift + nbFacePoints;
+      info.TriangleOffset = nbTriangles;
+      info.Color = { 255, 255, 255 };
+      nbFacePoints += info.Poly->NbNodes();
+      nbTriangles += info.Poly->NbTriangles();
 
 #if F3D_PLUGIN_OCCT_XCAF
-      std::array<unsigned char, 3> rgb = { 255, 255, 255 };
       try
       {
-        const auto& style = inheritedStyles.FindFromKey(face);
+        const auto& style = inheritedStyles.FindFromKey(info.Face);
         if (style.IsSetColorSurf())
         {
           Quantity_Color color = style.GetColorSurf();
-          rgb[0] = static_cast<unsigned char>(255.0 * color.Red());
-          rgb[1] = static_cast<unsigned char>(255.0 * color.Green());
-          rgb[2] = static_cast<unsigned char>(255.0 * color.Blue());
+          info.Color[0] = static_cast<unsigned char>(255.0 * color.Red());
+          info.Color[1] = static_cast<unsigned char>(255.0 * color.Green());
+          info.Color[2] = static_cast<unsigned char>(255.0 * color.Blue());
         }
       }
       catch (Standard_NoSuchObject&)
       {
         /* face has no style, safe to ignore */
       }
+#endif
 
-      for (int i = 1; i <= nbT; i++)
+      // a triangulation can be shared by several faces, make sure normals are computed only once
+      if (uniqueTriangulations.insert(info.Poly.get()).second)
       {
-        colors->InsertNextTypedTuple(rgb.data());
+        triangulations.push_back(info.Poly);
       }
+
+      faces.push_back(std::move(info));
+    }
+
+    points->SetNumberOfPoints(shift + nbFacePoints);
+    normals->SetNumberOfTuples(shift + nbFacePoints);
+    uvs->SetNumberOfTuples(shift + nbFacePoints);
+#if F3D_PLUGIN_OCCT_XCAF
+    const vtkIdType nbLines = linesCells->GetNumberOfCells();
+    colors->SetNumberOfTuples(nbLines + nbTriangles);
+#endif
+    vtkNew<vtkIdTypeArray> offsets;
+    offsets->SetNumberOfValues(nbTriangles + 1);
+    vtkNew<vtkIdTypeArray> connectivity;
+    connectivity->SetNumberOfValues(3 * nbTriangles);
+
+    // vtkPoints are float by default
+    float* pointsPtr = static_cast<float*>(points->GetVoidPointer(0));
+    float* normalsPtr = normals->GetPointer(0);
+    float* uvsPtr = uvs->GetPointer(0);
+#if F3D_PLUGIN_OCCT_XCAF
+    unsigned char* colorsPtr = colors->GetPointer(0);
+#endif
+    vtkIdType* offsetsPtr = offsets->GetPointer(0);
+    vtkIdType* connectivityPtr = connectivity->GetPointer(0);
+    offsetsPtr[nbTriangles] = 3 * nbTriangles;
+
+    auto convertFaces = [&]()
+    {
+      vtkSMPTools::For(0, static_cast<vtkIdType>(triangulations.size()),
+        [&](vtkIdType begin, vtkIdType end)
+        {
+          for (vtkIdType t = begin; t < end; t++)
+          {
+            Poly::ComputeNormals(triangulations[t]);
+          }
+        });
+
+      // Add all faces to polydata, each face writes into its own range of the arrays
+      vtkSMPTools::For(0, static_cast<vtkIdType>(faces.size()),
+        [&](vtkIdType begin, vtkIdType end)
+        {
+          for (vtkIdType f = begin; f < end; f++)
+          {
+            const FaceInfo& info = faces[f];
+            const Handle(Poly_Triangulation)& poly = info.Poly;
+            const TopAbs_Orientation faceOrientation = info.Face.Orientation();
+            const bool reversed = faceOrientation == TopAbs_Orientation::TopAbs_REVERSED;
+
+            const Standard_Integer nbT = poly->NbTriangles();
+            const Standard_Integer nbV = poly->NbNodes();
+            const bool hasNormals = poly->HasNormals();
+            const bool hasUVs = poly->HasUVNodes();
+
+            for (Standard_Integer i = 1; i <= nbV; i++)
+            {
+              const vtkIdType id = info.PointOffset + i - 1;
+
+              // Points
+              gp_Pnt pt = poly->Node(i).Transformed(info.Location);
+              pointsPtr[3 * id + 0] = static_cast<float>(pt.X());
+              pointsPtr[3 * id + 1] = static_cast<float>(pt.Y());
+              pointsPtr[3 * id + 2] = static_cast<float>(pt.Z());
+
+              // Normals, just in case a face does not have normals, add a dummy normal
+              float fn[3] = { 0.0, 0.0, 1.0 };
+              if (hasNormals)
+              {
+                gp_Dir n = poly->Normal(i);
+                fn[0] = static_cast<float>(n.X());
+                fn[1] = static_cast<float>(n.Y());
+                fn[2] = static_cast<float>(n.Z());
+                if (reversed)
+                {
+                  vtkMath::MultiplyScalar(fn, -1.f);
+                }
+              }
+              std::copy(fn, fn + 3, normalsPtr + 3 * id);
+
+              // UVs
+              gp_Pnt2d uv = hasUVs ? poly->UVNode(i) : gp_Pnt2d(0.0, 0.0);
+              uvsPtr[2 * id + 0] = static_cast<float>(uv.X());
+              uvsPtr[2 * id + 1] = static_cast<float>(uv.Y());
+            }
+
+            for (Standard_Integer i = 1; i <= nbT; i++)
+            {
+              const vtkIdType triangleId = info.TriangleOffset + i - 1;
+
+              int n1, n2, n3;
+              poly->Triangle(i).Get(n1, n2, n3);
+
+              vtkIdType* cell = connectivityPtr + 3 * triangleId;
+              cell[0] = info.PointOffset + n1 - 1;
+              cell[1] = info.PointOffset + n2 - 1;
+              cell[2] = info.PointOffset + n3 - 1;
+              if (faceOrientation != TopAbs_Orientation::TopAbs_FORWARD)
+              {
+                std::swap(cell[0], cell[2]);
+              }
+              offsetsPtr[triangleId] = 3 * triangleId;
+
+#if F3D_PLUGIN_OCCT_XCAF
+              std::copy(
+                info.Color.begin(), info.Color.end(), colorsPtr + 3 * (nbLines + triangleId));
 #endif
+            }
+          }
+        });
+    };
 
-      shift += nbV;
+    const int maxThreads = this->Parent->GetMaxThreads();
+    if (maxThreads > 0)
+    {
+      vtkSMPTools::LocalScope(vtkSMPTools::Config{ maxThreads }, convertFaces);
+    }
+    else
+    {
+      convertFaces();
     }
 
+    trianglesCells->SetData(offsets, connectivity);
+
     vtkNew<vtkPolyData> polydata;
     polydata->SetPoints(points);
     polydata->GetPointData()->SetNormals(normals);
@@ -315,6 +413,67 @@ public:
     return polydata;
   }
 
+  //----------------------------------------------------------------------------
+  // Tessellate a shape with the deflection of the parent, coarser when the tessellation is
+  // adaptive, in which case the shape is kept to refine it later
+#if F3D_PLUGIN_OCCT_XCAF
+  vtkSmartPointer<vtkPolyData> CreateInitialShape(const TopoDS_Shape& shape, const TDF_Label& label)
+#else
+  vtkSmartPointer<vtkPolyData> CreateInitialShape(const TopoDS_Shape& shape)
+#endif
+  {
+    const bool adaptive = this->Parent->GetAdaptiveTessellation();
+    const double deflection =
+      this->Parent->GetLinearDeflection() * (adaptive ? ::COARSE_DEFLECTION_FACTOR : 1.0);
+    const bool relative = this->Parent->GetRelativeDeflection();
+
+#if F3D_PLUGIN_OCCT_XCAF
+    vtkSmartPointer<vtkPolyData> polydata = this->CreateShape(shape, label, deflection, relative);
+#else
+    vtkSmartPointer<vtkPolyData> polydata = this->CreateShape(shape, deflection, relative);
+#endif
+
+    if (adaptive && polydata && polydata->GetNumberOfCells() > 0)
+    {
+      // a relative deflection is relative to the size of each edge and face,
+      // the size of the whole shape gives an upper bound of the absolute deflection
+      KeptShape& kept = this->KeptShapes[polydata];
+      kept.Shape = shape;
+#if F3D_PLUGIN_OCCT_XCAF
+      kept.Label = label;
+#endif
+      kept.Length = polydata->GetLength();
+      kept.Deflection = relative ? deflection * kept.Length : deflection;
+    }
+    return polydata;
+  }
+
+  //----------------------------------------------------------------------------
+  // Tessellate again a kept shape if the deflection is finer than its current tessellation
+  vtkSmartPointer<vtkPolyData> RefineShape(vtkPolyData* surface, double deflection)
+  {
+    auto it = this->KeptShapes.find(surface);
+    if (it == this->KeptShapes.end())
+    {
+      return nullptr;
+    }
+
+    // finer tessellations of large shapes would not fit in memory
+    KeptShape& kept = it->second;
+    deflection = std::max(deflection, kept.Length * ::MIN_RELATIVE_DEFLECTION);
+    if (deflection >= kept.Deflection)
+    {
+      return nullptr;
+    }
+    kept.Deflection = deflection;
+
+#if F3D_PLUGIN_OCCT_XCAF
+    return this->CreateShape(kept.Shape, kept.Label, deflection, false);
+#else
+    return this->CreateShape(kept.Shape, deflection, false);
+#endif
+  }
+
 #if F3D_PLUGIN_OCCT_XCAF
   StyleMap CollectInheritedStyles(const TDF_Label& rootLabel, const TopoDS_Shape& rootShape)
   {
@@ -416,18 +575,16 @@ public:
       vtkPolyData* polydata = this->ShapeMap[this->GetHash(label)];
       if (polydata && polydata->GetNumberOfCells() > 0)
       {
-        vtkNew<vtkTransformFilter> transfoFilter;
-        vtkNew<vtkTransform> transfo;
-        transfo->SetMatrix(position);
-        transfoFilter->SetTransform(transfo);
-        transfoFilter->SetInputData(polydata);
-        transfoFilter->Update();
-
+        // all the occurrences of a shape share its tessellation, only their placement differs
         vtkIdType blockId = mb->GetNumberOfBlocks();
-        mb->SetBlock(blockId, transfoFilter->GetOutput());
+        mb->SetBlock(blockId, polydata);
 
         vtkInformation* info = mb->GetMetaData(blockId);
         info->Set(vtkMultiBlockDataSet::NAME(), this->GetName(label));
+        if (!position->IsIdentity())
+        {
+          info->Set(vtkF3DImporter::INSTANCE_MATRIX(), position->GetData(), 16);
+        }
       }
     }
 
@@ -532,14 +689,72 @@ public:
 
   std::unordered_map<int, vtkSmartPointer<vtkPolyData>> ShapeMap;
   Handle(XCAFDoc_ShapeTool) ShapeTool;
+
+  // the labels of the kept shapes belong to the document
+  Handle(TDocStd_Document) Document;
 #endif
 
+  // shapes kept by the adaptive tessellation, by output surface
+  struct KeptShape
+  {
+    TopoDS_Shape Shape;
+#if F3D_PLUGIN_OCCT_XCAF
+    TDF_Label Label;
+#endif
+    double Length = 0.0;
+    double Deflection = 0.0;
+  };
+  std::unordered_map<vtkPolyData*, KeptShape> KeptShapes;
+
   vtkF3DOCCTReader* Parent;
 };
 
 //----------------------------------------------------------------------------
 vtkStandardNewMacro(vtkF3DOCCTReader);
 
+namespace
+{
+//----------------------------------------------------------------------------
+// The XML writers do not write the instance matrices of the blocks,
+// so the instances are transformed copies in the cache
+vtkSmartPointer<vtkMultiBlockDataSet> ApplyInstanceMatrices(vtkMultiBlockDataSet* mb)
+{
+  vtkNew<vtkMultiBlockDataSet> output;
+  output->SetNumberOfBlocks(mb->GetNumberOfBlocks());
+  for (unsigned int i = 0; i < mb->GetNumberOfBlocks(); i++)
+  {
+    vtkDataObject* block = mb->GetBlock(i);
+    vtkInformation* info = mb->HasMetaData(i) ? mb->GetMetaData(i) : nullptr;
+    if (info)
+    {
+      output->GetMetaData(i)->Copy(info);
+      output->GetMetaData(i)->Remove(vtkF3DImporter::INSTANCE_MATRIX());
+    }
+
+    if (vtkMultiBlockDataSet* child = vtkMultiBlockDataSet::SafeDownCast(block))
+    {
+      output->SetBlock(i, ::ApplyInstanceMatrices(child));
+    }
+    else if (info && info->Has(vtkF3DImporter::INSTANCE_MATRIX()))
+    {
+      vtkNew<vtkTransform> transfo;
+      transfo->SetMatrix(info->Get(vtkF3DImporter::INSTANCE_MATRIX()));
+
+      vtkNew<vtkTransformFilter> transfoFilter;
+      transfoFilter->SetTransform(transfo);
+      transfoFilter->SetInputData(block);
+      transfoFilter->Update();
+      output->SetBlock(i, transfoFilter->GetOutput());
+    }
+    else
+    {
+      output->SetBlock(i, block);
+    }
+  }
+  return output;
+}
+}
+
 //----------------------------------------------------------------------------
 vtkF3DOCCTReader::vtkF3DOCCTReader()
   : Internals(new vtkF3DOCCTReader::vtkInternals(this))
@@ -571,6 +786,12 @@ protected:
     }
   }
 
+  // Checked by OCCT at each step of the progress, set by the observers of the progress events
+  Standard_Boolean UserBreak() override
+  {
+    return this->Reader->GetAbortExecute() != 0;
+  }
+
 private:
   double LastPosition = 0.0;
   vtkF3DOCCTReader* Reader = nullptr;
@@ -598,12 +819,86 @@ bool TransferToDocument(vtkF3DOCCTReader* that, T& reader, Handle(TDocStd_Docume
 }
 #endif
 
+//----------------------------------------------------------------------------
+std::string vtkF3DOCCTReader::GetCacheFileName()
+{
+  // the shapes are needed by the adaptive tessellation, they are not cached
+  std::string directory = vtkF3DCache::GetDirectory();
+  if (!this->UseCache || this->AdaptiveTessellation || directory.empty())
+  {
+    return "";
+  }
+
+  // all the parameters changing the output are part of the key
+  std::ostringstream salt;
+  salt.precision(17);
+  salt << "occt-cache-v1;" << static_cast<int>(this->FileFormat) << ";" << this->LinearDeflection
+       << ";" << this->AngularDeflection << ";" << this->RelativeDeflection << ";"
+       << this->ReadWire;
+#if F3D_PLUGIN_OCCT_XCAF
+  salt << ";xcaf";
+#endif
+
+  std::string hash = vtkF3DCache::ComputeHash(this->FileName, salt.str());
+  if (hash.empty())
+  {
+    return "";
+  }
+  return directory + "/occt/" + hash + ".vtm";
+}
+
 //----------------------------------------------------------------------------
 int vtkF3DOCCTReader::RequestData(
   vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector)
 {
   vtkMultiBlockDataSet* output = vtkMultiBlockDataSet::GetData(outputVector);
 
+  const std::string cacheFileName = this->GetCacheFileName();
+  if (!cacheFileName.empty() && vtksys::SystemTools::FileExists(cacheFileName, true))
+  {
+    vtkNew<vtkXMLMultiBlockDataReader> cacheReader;
+    cacheReader->SetFileName(cacheFileName.c_str());
+    cacheReader->Update();
+
+    vtkMultiBlockDataSet* cached = vtkMultiBlockDataSet::SafeDownCast(cacheReader->GetOutput());
+    if (cacheReader->GetErrorCode() == 0 && cached)
+    {
+      output->ShallowCopy(cached);
+      return 1;
+    }
+    vtkWarningMacro("Cannot read the tessellation cache " << cacheFileName << ", ignoring it");
+  }
+
+  if (!this->ReadAndMesh(output))
+  {
+    return 0;
+  }
+
+  if (!cacheFileName.empty())
+  {
+    vtksys::SystemTools::MakeDirectory(vtksys::SystemTools::GetFilenamePath(cacheFileName));
+
+    // appended raw data compressed with LZ4 is the fastest to read back
+    vtkNew<vtkXMLMultiBlockDataWriter> cacheWriter;
+    cacheWriter->SetFileName(cacheFileName.c_str());
+    cacheWriter->SetInputData(::ApplyInstanceMatrices(output));
+    cacheWriter->SetDataModeToAppended();
+    cacheWriter->EncodeAppendedDataOff();
+    cacheWriter->SetCompressorTypeToLZ4();
+    if (!cacheWriter->Write())
+    {
+      vtkWarningMacro("Cannot write the tessellation cache " << cacheFileName);
+    }
+  }
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkF3DOCCTReader::ReadAndMesh(vtkMultiBlockDataSet* output)
+{
+  F3D_TRACE_SCOPE("vtkF3DOCCTReader::ReadAndMesh");
+  this->Internals->KeptShapes.clear();
   Message::DefaultMessenger()->RemovePrinters(STANDARD_TYPE(Message_PrinterOStream));
 
   if (this->FileFormat == FILE_FORMAT::BREP)
@@ -628,9 +923,9 @@ int vtkF3DOCCTReader::RequestData(
       output->SetNumberOfBlocks(1);
 #if F3D_PLUGIN_OCCT_XCAF
       const vtkSmartPointer<vtkPolyData> polydata =
-        this->Internals->CreateShape(shape, TDF_Label());
+        this->Internals->CreateInitialShape(shape, TDF_Label());
 #else
-      const vtkSmartPointer<vtkPolyData> polydata = this->Internals->CreateShape(shape);
+      const vtkSmartPointer<vtkPolyData> polydata = this->Internals->CreateInitialShape(shape);
 #endif
       if (polydata && polydata->GetNumberOfCells() > 0)
       {
@@ -669,7 +964,17 @@ int vtkF3DOCCTReader::RequestData(
     }
   }
 
+  // the transfer stops early when the read is aborted, the partial document is not meshed
+  if (this->GetAbortExecute())
+  {
+    return 0;
+  }
+
   this->Internals->ShapeTool = XCAFDoc_DocumentTool::ShapeTool(doc->Main());
+  if (this->AdaptiveTessellation)
+  {
+    this->Internals->Document = doc;
+  }
 
   TDF_LabelSequence topLevelShapes;
 
@@ -684,10 +989,14 @@ int vtkF3DOCCTReader::RequestData(
     this->Internals->ShapeTool->GetShape(label, shape);
 
     this->Internals->ShapeMap[this->Internals->GetHash(label)] =
-      this->Internals->CreateShape(shape, label);
+      this->Internals->CreateInitialShape(shape, label);
 
     double progress = 0.5 + (static_cast<double>(iLabel) / topLevelShapes.Length()) / 2;
     this->InvokeEvent(vtkCommand::ProgressEvent, &progress);
+    if (this->GetAbortExecute())
+    {
+      return 0;
+    }
   }
 
   // create multiblock
@@ -715,14 +1024,14 @@ int vtkF3DOCCTReader::RequestData(
     ProgressIndicator pi(this);
     reader->TransferRoots(pi.Start());
 
-    Standard_Integer nbShapes = reader->NbShapes();
+    Standard_Integer nbShapes = this->GetAbortExecute() ? 0 : reader->NbShapes();
 
     output->SetNumberOfBlocks(nbShapes);
 
     for (int iShape = 1; iShape <= nbShapes; iShape++)
     {
       TopoDS_Shape shape = reader->Shape(iShape);
-      vtkSmartPointer<vtkPolyData> polydata = this->Internals->CreateShape(shape);
+      vtkSmartPointer<vtkPolyData> polydata = this->Internals->CreateInitialShape(shape);
 
       if (polydata && polydata->GetNumberOfCells() > 0)
       {
@@ -736,6 +1045,13 @@ int vtkF3DOCCTReader::RequestData(
   return 1;
 }
 
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkPolyData> vtkF3DOCCTReader::Refine(vtkPolyData* surface, double linearDeflection)
+{
+  F3D_TRACE_SCOPE("vtkF3DOCCTReader::Refine");
+  return this->Internals->RefineShape(surface, linearDeflection);
+}
+
 //----------------------------------------------------------------------------
 void vtkF3DOCCTReader::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -745,6 +1061,10 @@ void vtkF3DOCCTReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "AngularDeflection: " << this->AngularDeflection << "\n";
   os << indent << "RelativeDeflection: " << (this->RelativeDeflection ? "true" : "false") << "\n";
   os << indent << "ReadWire: " << (this->ReadWire ? "true" : "false") << "\n";
+  os << indent << "UseCache: " << (this->UseCache ? "true" : "false") << "\n";
+  os << indent << "AdaptiveTessellation: " << (this->AdaptiveTessellation ? "true" : "false")
+     << "\n";
+  os << indent << "MaxThreads: " << this->MaxThreads << "\n";
   // clang-format off
   switch (this->FileFormat)
   {
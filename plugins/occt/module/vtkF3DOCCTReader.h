@@ -8,6 +8,10 @@
  * The quality of the generated mesh is configured using RelativeDeflection, LinearDeflection,
  * and LinearDeflection.
  * Reading 1D cells (wires) is optional.
+ * The tessellated output can be cached on disk, in the directory provided by vtkF3DCache,
+ * so that reading the same file with the same parameters skips the transfer and the meshing.
+ * With AdaptiveTessellation, the shapes are kept in memory so that the tessellation of each
+ * output surface can be refined later with Refine.
  *
  */
 
@@ -15,11 +19,14 @@
 #define vtkF3DOCCTReader_h
 
 #include <vtkMultiBlockDataSetAlgorithm.h>
+#include <vtkSmartPointer.h>
 #include <vtkVersion.h>
 
 #include <memory>
 
 class vtkInformationDoubleVectorKey;
+class vtkMultiBlockDataSet;
+class vtkPolyData;
 
 class vtkF3DOCCTReader : public vtkMultiBlockDataSetAlgorithm
 {
@@ -86,6 +93,51 @@ public:
   vtkBooleanMacro(ReadWire, bool);
   ///@}
 
+  ///@{
+  /**
+   * Enable/Disable the on disk cache of the tessellated output.
+   * The cache is used only if a directory is set in vtkF3DCache.
+   * Default is true
+   */
+  vtkGetMacro(UseCache, bool);
+  vtkSetMacro(UseCache, bool);
+  vtkBooleanMacro(UseCache, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the maximum number of threads used to mesh the shapes and convert them.
+   * 1 disables the OCCT parallel meshing entirely, 0 means no limit is set
+   * and the vtkSMPTools default is used.
+   * Default is 0
+   */
+  vtkGetMacro(MaxThreads, int);
+  vtkSetClampMacro(MaxThreads, int, 0, VTK_INT_MAX);
+  ///@}
+
+  ///@{
+  /**
+   * Enable/Disable the adaptive tessellation.
+   * If enabled, the shapes are first tessellated with a linear deflection 4 times larger, and
+   * they are kept in memory after reading, with the document, so that Refine can be used.
+   * The on disk cache is not used in this mode.
+   * Default is false
+   */
+  vtkGetMacro(AdaptiveTessellation, bool);
+  vtkSetMacro(AdaptiveTessellation, bool);
+  vtkBooleanMacro(AdaptiveTessellation, bool);
+  ///@}
+
+  /**
+   * Tessellate again the shape of a surface of the output, with the provided absolute linear
+   * deflection, when AdaptiveTessellation is enabled.
+   * The deflection is limited to a thousandth of the surface size.
+   * Return nullptr if the surface is unknown or if its tessellation is already finer.
+   * The output is not modified, the returned surface is meant to replace it in the rendering.
+   * It can be called on a worker thread, but not concurrently.
+   */
+  vtkSmartPointer<vtkPolyData> Refine(vtkPolyData* surface, double linearDeflection);
+
   ///@{
   /**
    * Get/Set the file name.
@@ -104,6 +156,17 @@ private:
   vtkF3DOCCTReader(const vtkF3DOCCTReader&) = delete;
   void operator=(const vtkF3DOCCTReader&) = delete;
 
+  /**
+   * Read the file and tessellate the shapes into the output
+   */
+  int ReadAndMesh(vtkMultiBlockDataSet* output);
+
+  /**
+   * Return the path of the cache file for the current file and parameters,
+   * or an empty string if the cache is not used
+   */
+  std::string GetCacheFileName();
+
   class vtkInternals;
   std::unique_ptr<vtkInternals> Internals;
 
@@ -113,6 +176,9 @@ private:
   double AngularDeflection = 0.5;
   bool RelativeDeflection = false;
   bool ReadWire = false;
+  bool UseCache = true;
+  bool AdaptiveTessellation = false;
+  int MaxThreads = 0;
   FILE_FORMAT FileFormat = FILE_FORMAT::STEP;
 };
 
@@ -0,0 +1,154 @@
+#include <vtkActor.h>
+#include <vtkActorCollection.h>
+#include <vtkMapper.h>
+#include <vtkNew.h>
+#include <vtkRenderer.h>
+#include <vtkTestUtilities.h>
+
+#include "vtkF3DUSDImporter.h"
+
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+const char* Triangle = "  int[] faceVertexCounts = [3]\n"
+                       "  int[] faceVertexIndices = [0, 1, 2]\n";
+
+bool CheckCenter(vtkActor* actor, int axis, double expected, const std::string& label)
+{
+  const double* bounds = actor->GetBounds();
+  double center = 0.5 * (bounds[2 * axis] + bounds[2 * axis + 1]);
+  if (std::abs(center - expected) > 1e-3)
+  {
+    std::cerr << label << " is centered at " << center << " instead of " << expected
+              << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestF3DUSDImporterAnimation(int vtkNotUsed(argc), char* argv[])
+{
+  std::string filename = std::string(argv[2]) + "TestF3DUSDImporterAnimation.usda";
+
+  {
+    std::ofstream stage(filename);
+    stage << "#usda 1.0\n"
+          << "(\n  startTimeCode = 0\n  endTimeCode = 10\n  timeCodesPerSecond = 10\n)\n"
+          << "def Xform \"Moving\"\n{\n"
+          << "  double3 xformOp:translate.timeSamples = { 0: (0, 0, 0), 10: (10, 0, 0) }\n"
+          << "  uniform token[] xformOpOrder = [\"xformOp:translate\"]\n"
+          << "  def Mesh \"Triangle\"\n  {\n"
+          << "  point3f[] points = [(0, 0, 0), (1, 0, 0), (0, 1, 0)]\n"
+          << ::Triangle << "  }\n"
+          << "}\n"
+          << "def Mesh \"Static\"\n{\n"
+          << "  point3f[] points = [(0, 0, 0), (1, 0, 0), (0, 1, 0)]\n"
+          << ::Triangle << "}\n"
+          << "def Mesh \"Blinking\"\n{\n"
+          << "  token visibility.timeSamples = { 0: \"inherited\", 5: \"invisible\" }\n"
+          << "  point3f[] points = [(0, 0, 0), (1, 0, 0), (0, 1, 0)]\n"
+          << ::Triangle << "}\n"
+          << "def Mesh \"Deforming\"\n{\n"
+          << "  point3f[] points.timeSamples = { 0: [(0, 0, 0), (1, 0, 0), (0, 1, 0)], "
+          << "10: [(0, 0, 0), (3, 0, 0), (0, 1, 0)] }\n"
+          << ::Triangle << "}\n"
+          << "def PointInstancer \"Instancer\"\n{\n"
+          << "  point3f[] positions.timeSamples = { 0: [(0, 0, -5)], 10: [(0, 0, -15)] }\n"
+          << "  int[] protoIndices = [0]\n"
+          << "  rel prototypes = [</Instancer/Box>]\n"
+          << "  def Cube \"Box\" { double size = 1 }\n"
+          << "}\n";
+  }
+
+  vtkNew<vtkF3DUSDImporter> importer;
+  importer->SetFileName(filename);
+  importer->Update();
+
+  vtkRenderer* renderer = importer->GetRenderer();
+  if (!renderer || renderer->GetActors()->GetNumberOfItems() != 5)
+  {
+    std::cerr << "Unexpected number of imported actors" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // actors are added in the traversal order
+  std::vector<vtkActor*> actors;
+  std::vector<vtkMapper*> mappers;
+  vtkActorCollection* collection = renderer->GetActors();
+  collection->InitTraversal();
+  while (vtkActor* actor = collection->GetNextActor())
+  {
+    actors.emplace_back(actor);
+    mappers.emplace_back(actor->GetMapper());
+  }
+  vtkActor* moving = actors[0];
+  vtkActor* still = actors[1];
+  vtkActor* blinking = actors[2];
+  vtkActor* deforming = actors[3];
+  vtkActor* instanced = actors[4];
+
+  vtkF3DImporter* animated = importer;
+  if (!animated->UpdateAtTimeValue(1.0))
+  {
+    std::cerr << "UpdateAtTimeValue failed" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // no actor is created again when the time value changes
+  if (renderer->GetActors()->GetNumberOfItems() != 5)
+  {
+    std::cerr << "Actors were added when updating the time value" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // only the matrix of a moving prim is updated, its geometry is kept
+  if (moving->GetMapper() != mappers[0] || !::CheckCenter(moving, 0, 10.5, "Moving prim"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // a static prim is not imported again
+  if (still->GetMapper() != mappers[1] || !::CheckCenter(still, 0, 0.5, "Static prim"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  if (blinking->GetVisibility())
+  {
+    std::cerr << "Prim made invisible is still visible" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (!::CheckCenter(deforming, 0, 1.5, "Deforming prim") ||
+    !::CheckCenter(instanced, 2, -15, "Instanced prim"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // going back to the first time value restores the initial state
+  if (!animated->UpdateAtTimeValue(0.0))
+  {
+    std::cerr << "UpdateAtTimeValue failed" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (!blinking->GetVisibility())
+  {
+    std::cerr << "Prim made visible again is still hidden" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (!::CheckCenter(moving, 0, 0.5, "Moving prim") ||
+    !::CheckCenter(deforming, 0, 0.5, "Deforming prim") ||
+    !::CheckCenter(instanced, 2, -5, "Instanced prim"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,117 @@
+#include <vtkActor.h>
+#include <vtkActorCollection.h>
+#include <vtkDataArray.h>
+#include <vtkGlyph3DMapper.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkPolyData.h>
+#include <vtkRenderer.h>
+#include <vtkTestUtilities.h>
+
+#include "vtkF3DUSDImporter.h"
+
+#include <cmath>
+#include <fstream>
+#include <iostream>
+
+namespace
+{
+bool CheckBounds(const double* bounds, const double (&expected)[6])
+{
+  for (int i = 0; i < 6; i++)
+  {
+    if (std::abs(bounds[i] - expected[i]) > 0.1)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestF3DUSDImporterInstancer(int vtkNotUsed(argc), char* argv[])
+{
+  std::string filename = std::string(argv[2]) + "TestF3DUSDImporterInstancer.usda";
+
+  {
+    // three cubes, one of them scaled, and a sphere
+    std::ofstream stage(filename);
+    stage << "#usda 1.0\n"
+          << "def PointInstancer \"Instancer\"\n{\n"
+          << "  point3f[] positions = [(0, 0, 0), (10, 0, 0), (20, 0, 0), (0, 10, 0)]\n"
+          << "  float3[] scales = [(1, 1, 1), (1, 1, 1), (2, 2, 2), (1, 1, 1)]\n"
+          << "  int[] protoIndices = [0, 1, 0, 0]\n"
+          << "  rel prototypes = [</Instancer/Prototypes/Box>, </Instancer/Prototypes/Ball>]\n"
+          << "  def Scope \"Prototypes\"\n  {\n"
+          << "    def Cube \"Box\" { double size = 1 }\n"
+          << "    def Sphere \"Ball\" { double radius = 1 }\n"
+          << "  }\n"
+          << "}\n";
+  }
+
+  vtkNew<vtkF3DUSDImporter> importer;
+  importer->SetFileName(filename);
+  importer->Update();
+
+  vtkRenderer* renderer = importer->GetRenderer();
+  if (!renderer)
+  {
+    std::cerr << "Importer failed to create a renderer" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // one actor per prototype, not per instance
+  vtkActorCollection* actors = renderer->GetActors();
+  if (actors->GetNumberOfItems() != 2)
+  {
+    std::cerr << "Unexpected number of actors: " << actors->GetNumberOfItems()
+              << ", expected one per prototype" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const vtkIdType expectedInstances[2] = { 3, 1 };
+  const double expectedBounds[2][6] = { { -0.5, 21, -0.5, 10.5, -1, 1 },
+    { 9, 11, -1, 1, -1, 1 } };
+  const double expectedSourceSize[2] = { 1, 2 };
+
+  actors->InitTraversal();
+  for (int i = 0; i < 2; i++)
+  {
+    vtkActor* actor = actors->GetNextActor();
+    vtkGlyph3DMapper* mapper = vtkGlyph3DMapper::SafeDownCast(actor->GetMapper());
+    if (!mapper)
+    {
+      std::cerr << "Instanced actor " << i << " does not use a vtkGlyph3DMapper" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    vtkDataSet* instances = mapper->GetInput();
+    if (!instances || instances->GetNumberOfPoints() != expectedInstances[i] ||
+      !instances->GetPointData()->GetArray("Orientation") ||
+      !instances->GetPointData()->GetArray("Scale"))
+    {
+      std::cerr << "Unexpected instances for prototype " << i << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // the prototype geometry is shared by all the instances
+    vtkPolyData* source = mapper->GetSource(0);
+    if (!source || source->GetNumberOfPoints() == 0 ||
+      std::abs(source->GetBounds()[1] - source->GetBounds()[0] - expectedSourceSize[i]) > 0.1)
+    {
+      std::cerr << "Unexpected source geometry for prototype " << i << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    if (!::CheckBounds(actor->GetBounds(), expectedBounds[i]))
+    {
+      const double* bounds = actor->GetBounds();
+      std::cerr << "Unexpected bounds for prototype " << i << ": " << bounds[0] << ", "
+                << bounds[1] << ", " << bounds[2] << ", " << bounds[3] << ", " << bounds[4]
+                << ", " << bounds[5] << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
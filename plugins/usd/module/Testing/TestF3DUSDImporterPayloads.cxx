@@ -0,0 +1,51 @@
+#include <vtkActorCollection.h>
+#include <vtkNew.h>
+#include <vtkRenderer.h>
+#include <vtkTestUtilities.h>
+
+#include "vtkF3DUSDImporter.h"
+
+#include <fstream>
+#include <iostream>
+
+namespace
+{
+int CountActors(const std::string& filename, const std::string& payloads, const std::string& mask)
+{
+  vtkNew<vtkF3DUSDImporter> importer;
+  importer->SetFileName(filename);
+  importer->SetPayloadsPattern(payloads);
+  importer->SetPopulationMask(mask);
+  importer->Update();
+  return importer->GetRenderer() ? importer->GetRenderer()->GetActors()->GetNumberOfItems() : -1;
+}
+}
+
+int TestF3DUSDImporterPayloads(int vtkNotUsed(argc), char* argv[])
+{
+  std::string asset = std::string(argv[1]) + "data/suzanne.usd";
+  std::string filename = std::string(argv[2]) + "TestF3DUSDImporterPayloads.usda";
+
+  {
+    std::ofstream stage(filename);
+    stage << "#usda 1.0\n"
+          << "def Xform \"World\"\n{\n"
+          << "  def Xform \"Left\" (payload = @" << asset << "@) {}\n"
+          << "  def Xform \"Right\" (payload = @" << asset << "@) {}\n"
+          << "}\n";
+  }
+
+  int all = ::CountActors(filename, ".*", "");
+  int none = ::CountActors(filename, "", "");
+  int left = ::CountActors(filename, "/World/Left", "");
+  int masked = ::CountActors(filename, ".*", "/World/Right");
+
+  if (all <= 0 || none != 0 || 2 * left != all || 2 * masked != all)
+  {
+    std::cerr << "Unexpected number of actors: " << all << " loading all the payloads, " << none
+              << " loading none, " << left << " loading one and " << masked << " with a mask\n";
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
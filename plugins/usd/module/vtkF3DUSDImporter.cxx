@@ -1,6 +1,8 @@
 #include "vtkF3DUSDImporter.h"
 
 #include "vtkF3DFaceVaryingPointDispatcher.h"
+#include "vtkF3DScratchArena.h"
+#include "vtkF3DTextureCache.h"
 
 #include <vtkActor.h>
 #include <vtkCapsuleSource.h>
@@ -9,6 +11,7 @@
 #include <vtkCylinderSource.h>
 #include <vtkDoubleArray.h>
 #include <vtkFloatArray.h>
+#include <vtkGlyph3DMapper.h>
 #include <vtkImageAppendComponents.h>
 #include <vtkImageData.h>
 #include <vtkImageExtractComponents.h>
@@ -27,12 +30,16 @@
 #include <vtkPolyDataTangents.h>
 #include <vtkProperty.h>
 #include <vtkRenderer.h>
+#include <vtkSMPTools.h>
+#include <vtkShaderProperty.h>
 #include <vtkSmartPointer.h>
 #include <vtkSphereSource.h>
 #include <vtkTexture.h>
 #include <vtkTransform.h>
 #include <vtkTransformFilter.h>
 #include <vtkTriangleFilter.h>
+#include <vtkUniforms.h>
+#include <vtkUnsignedShortArray.h>
 
 #if defined(__clang__)
 #pragma clang diagnostic push
@@ -48,11 +55,16 @@
 #elif defined(_MSC_VER)
 #pragma warning(push, 0)
 #endif
+#include <pxr/base/gf/transform.h>
+#include <pxr/base/tf/diagnostic.h>
+#include <pxr/base/tf/stringUtils.h>
 #include <pxr/usd/ar/asset.h>
 #include <pxr/usd/ar/resolver.h>
 #include <pxr/usd/usd/modelAPI.h>
 #include <pxr/usd/usd/primRange.h>
 #include <pxr/usd/usd/stage.h>
+#include <pxr/usd/usd/stagePopulationMask.h>
+#include <pxr/usd/usdGeom/bboxCache.h>
 #include <pxr/usd/usdGeom/capsule.h>
 #include <pxr/usd/usdGeom/cone.h>
 #include <pxr/usd/usdGeom/cube.h>
@@ -67,7 +79,12 @@
 #include <pxr/usd/usdGeom/xform.h>
 #include <pxr/usd/usdShade/material.h>
 #include <pxr/usd/usdShade/materialBindingAPI.h>
-#include <pxr/usd/usdSkel/bakeSkinning.h>
+#include <pxr/usd/usdSkel/binding.h>
+#include <pxr/usd/usdSkel/cache.h>
+#include <pxr/usd/usdSkel/root.h>
+#include <pxr/usd/usdSkel/skeletonQuery.h>
+#include <pxr/usd/usdSkel/skinningQuery.h>
+#include <pxr/usd/usdSkel/utils.h>
 #if defined(__clang__)
 #pragma clang diagnostic pop
 #elif defined(__GNUC__)
@@ -76,32 +93,225 @@
 #pragma warning(pop, 0)
 #endif
 
+#include <algorithm>
+#include <regex>
+#include <unordered_set>
+
 class vtkF3DUSDImporter::vtkInternals
 {
 public:
   explicit vtkInternals(vtkF3DUSDImporter* parent)
-    : Delegate(parent)
+    : Parent(parent)
+    , Delegate(parent)
   {
     pxr::TfDiagnosticMgr::GetInstance().AddDelegate(&this->Delegate);
   }
 
-  void ReadScene(const std::string& filePath)
+  void ReadScene(const std::string& filePath, const std::string& payloadsPattern,
+    const std::string& populationMask, bool importAnimations)
   {
     // in case of failure, you may want to set PXR_PLUGINPATH_NAME to the lib/usd path
     if (!this->Stage)
     {
-      this->Stage = pxr::UsdStage::Open(filePath);
+      // the payloads are loaded after opening the stage when only some of them are requested
+      bool loadAll = payloadsPattern == ".*";
+      pxr::UsdStage::InitialLoadSet load =
+        loadAll ? pxr::UsdStage::LoadAll : pxr::UsdStage::LoadNone;
+
+      if (populationMask.empty())
+      {
+        this->Stage = pxr::UsdStage::Open(filePath, load);
+      }
+      else
+      {
+        pxr::UsdStagePopulationMask mask;
+        for (const std::string& path : pxr::TfStringSplit(populationMask, ","))
+        {
+          std::string trimmed = pxr::TfStringTrim(path);
+          if (pxr::SdfPath::IsValidPathString(trimmed))
+          {
+            mask.Add(pxr::SdfPath(trimmed));
+          }
+          else
+          {
+            TF_WARN("Invalid prim path in the population mask: %s", trimmed.c_str());
+          }
+        }
+        this->Stage = pxr::UsdStage::OpenMasked(filePath, mask, load);
+      }
+
+      if (this->Stage && !loadAll && !payloadsPattern.empty())
+      {
+        this->LoadPayloads(payloadsPattern);
+      }
+
+      if (this->Stage && importAnimations)
+      {
+        this->PopulateSkinning();
+      }
+    }
+  }
+
+  void PopulateSkinning()
+  {
+    // the skinning is evaluated in the vertex shader at the requested time,
+    // only the joint influences of the points are stored with the geometry
+    this->SkinnedPrims.clear();
+    pxr::UsdPrimRange range = this->Stage->Traverse();
+    for (auto it = range.begin(); it != range.end(); ++it)
+    {
+      if (!it->IsA<pxr::UsdSkelRoot>())
+      {
+        continue;
+      }
+      it.PruneChildren();
+
+      pxr::UsdSkelRoot skelRoot(*it);
+      this->SkelCache.Populate(skelRoot, pxr::UsdTraverseInstanceProxies());
+
+      std::vector<pxr::UsdSkelBinding> bindings;
+      this->SkelCache.ComputeSkelBindings(skelRoot, &bindings, pxr::UsdTraverseInstanceProxies());
+      for (const pxr::UsdSkelBinding& binding : bindings)
+      {
+        pxr::UsdSkelSkeletonQuery skelQuery = this->SkelCache.GetSkelQuery(binding.GetSkeleton());
+        if (!skelQuery)
+        {
+          continue;
+        }
+
+        for (const pxr::UsdSkelSkinningQuery& skinningQuery : binding.GetSkinningTargets())
+        {
+          if (skinningQuery.HasJointInfluences() && skinningQuery.GetPrim().IsA<pxr::UsdGeomMesh>())
+          {
+            this->SkinnedPrims[skinningQuery.GetPrim().GetPath().GetAsString()] = { skelQuery,
+              skinningQuery };
+          }
+        }
+      }
+    }
+  }
+
+  void AddJointInfluences(
+    const pxr::UsdSkelSkinningQuery& skinningQuery, vtkIdType nbPoints, vtkPolyData* polydata)
+  {
+    pxr::VtIntArray indices;
+    pxr::VtFloatArray weights;
+    if (!skinningQuery.ComputeJointInfluences(&indices, &weights))
+    {
+      return;
+    }
+
+    // the vertex shader supports 4 influences per point, the weights are renormalized
+    int nbInfluences = skinningQuery.GetNumInfluencesPerComponent();
+    pxr::UsdSkelResizeInfluences(&indices, nbInfluences, 4);
+    pxr::UsdSkelResizeInfluences(&weights, nbInfluences, 4);
+
+    // rigidly deformed prims have the same influences for all the points
+    bool rigid = skinningQuery.IsRigidlyDeformed();
+    size_t expectedSize = rigid ? 4 : 4 * static_cast<size_t>(nbPoints);
+    if (indices.size() != expectedSize || weights.size() != expectedSize)
+    {
+      TF_WARN("Invalid joint influences of %s", skinningQuery.GetPrim().GetPath().GetText());
+      return;
+    }
+
+    vtkNew<vtkFloatArray> vWeights;
+    vWeights->SetName("WEIGHTS_0");
+    vWeights->SetNumberOfComponents(4);
+    vWeights->SetNumberOfTuples(nbPoints);
+
+    vtkNew<vtkUnsignedShortArray> vJoints;
+    vJoints->SetName("JOINTS_0");
+    vJoints->SetNumberOfComponents(4);
+    vJoints->SetNumberOfTuples(nbPoints);
+
+    for (vtkIdType i = 0; i < nbPoints; i++)
+    {
+      size_t offset = rigid ? 0 : 4 * static_cast<size_t>(i);
+      for (int j = 0; j < 4; j++)
+      {
+        vWeights->SetTypedComponent(i, j, weights[offset + j]);
+        vJoints->SetTypedComponent(i, j, static_cast<unsigned short>(indices[offset + j]));
+      }
+    }
+
+    polydata->GetPointData()->AddArray(vWeights);
+    polydata->GetPointData()->AddArray(vJoints);
+  }
+
+  void UpdateSkinnedActors(pxr::UsdTimeCode timeCode)
+  {
+    std::vector<float> jointMatrices;
+    for (auto& [actorPath, skinned] : this->SkinnedActors)
+    {
+      pxr::VtMatrix4dArray xforms;
+      if (!skinned.SkelQuery.ComputeSkinningTransforms(&xforms, timeCode))
+      {
+        continue;
+      }
 
-      if (this->Stage)
+      // the joints order of the skinned prim can differ from the skeleton one
+      if (const pxr::UsdSkelAnimMapperRefPtr& mapper = skinned.SkinningQuery.GetJointMapper())
       {
-        // TODO: USD bake skinning is not performant
-        // We need to read joints and do the skinning in the shader
-        // See https://github.com/f3d-app/f3d/issues/1076
-        pxr::UsdSkelBakeSkinning(this->Stage->Traverse());
+        pxr::VtMatrix4dArray primXforms;
+        if (!mapper->RemapTransforms(xforms, &primXforms))
+        {
+          continue;
+        }
+        xforms = primXforms;
       }
+
+      // the points are skinned in the skeleton space, then brought back to the local space
+      // of the prim where the actor matrix applies
+      pxr::GfMatrix4d geomBind = skinned.SkinningQuery.GetGeomBindTransform(timeCode);
+      pxr::GfMatrix4d skelToPrim =
+        pxr::UsdGeomImageable(skinned.SkelQuery.GetPrim()).ComputeLocalToWorldTransform(timeCode) *
+        pxr::UsdGeomImageable(skinned.SkinningQuery.GetPrim())
+          .ComputeLocalToWorldTransform(timeCode)
+          .GetInverse();
+
+      // USD matrices transform row vectors, their row major values are the column major values
+      // of the VTK matrices expected by the shader
+      jointMatrices.resize(16 * xforms.size());
+      for (size_t i = 0; i < xforms.size(); i++)
+      {
+        pxr::GfMatrix4d joint = geomBind * xforms[i] * skelToPrim;
+        std::copy(joint.data(), joint.data() + 16, jointMatrices.begin() + 16 * i);
+      }
+
+      // The uniform is updated in place, adding or removing uniforms would rebuild the shaders
+      vtkUniforms* uniforms = skinned.Actor->GetShaderProperty()->GetVertexCustomUniforms();
+      uniforms->SetUniformMatrix4x4v(
+        "jointMatrices", static_cast<int>(xforms.size()), jointMatrices.data());
     }
   }
 
+  void LoadPayloads(const std::string& payloadsPattern)
+  {
+    std::regex regex;
+    try
+    {
+      regex = std::regex(payloadsPattern);
+    }
+    catch (const std::regex_error& e)
+    {
+      TF_WARN("Invalid payloads pattern \"%s\": %s", payloadsPattern.c_str(), e.what());
+      return;
+    }
+
+    // the nested payloads are only composed once their parent payload is loaded,
+    // so a matching prim loads all the payloads below it
+    pxr::SdfPathSet loadSet;
+    for (const pxr::SdfPath& path : this->Stage->FindLoadable())
+    {
+      if (std::regex_match(path.GetString(), regex))
+      {
+        loadSet.insert(path);
+      }
+    }
+    this->Stage->LoadAndUnload(loadSet, pxr::SdfPathSet(), pxr::UsdLoadWithDescendants);
+  }
+
   template<typename T>
   std::pair<pxr::UsdShadeShader, pxr::TfToken> GetConnectedShaderPrim(const T& port)
   {
@@ -138,13 +348,28 @@ public:
   }
 
   void AddActor(vtkRenderer* renderer, const pxr::SdfPath& path, const pxr::UsdGeomGprim& geomPrim,
-    const pxr::UsdPrim& prim, vtkMatrix4x4* mat, vtkPolyData* polydata)
+    const pxr::UsdPrim& prim, vtkMatrix4x4* mat, vtkPolyData* polydata,
+    vtkPolyData* instances = nullptr)
   {
     pxr::SdfPath actorPath = path.AppendChild(pxr::TfToken(prim.GetName()));
 
     auto& actor = this->ActorMap[actorPath.GetAsString()];
     bool actorAlreadyExists = (actor != nullptr);
 
+    auto& actorInput = this->ActorInputMap[actorPath.GetAsString()];
+    if (actorAlreadyExists)
+    {
+      actor->VisibilityOn();
+
+      // the geometry did not change, only the matrix may have
+      if (actorInput == polydata && !instances)
+      {
+        actor->SetUserMatrix(mat);
+        return;
+      }
+    }
+    actorInput = polydata;
+
     if (!actorAlreadyExists)
     {
       actor = vtkSmartPointer<vtkActor>::New();
@@ -224,7 +449,7 @@ public:
     }
 
     // set mapper
-    vtkNew<vtkPolyDataMapper> mapper;
+    vtkSmartPointer<vtkPolyData> mapperInput = polydata;
 
     if (actor->GetProperty()->GetTexture("normalTex"))
     {
@@ -237,13 +462,50 @@ public:
       vtkNew<vtkPolyDataTangents> tangents;
       tangents->SetInputConnection(normals->GetOutputPort());
       tangents->Update();
-      mapper->SetInputData(tangents->GetOutput());
+      mapperInput = tangents->GetOutput();
     }
-    else
+
+    if (instances)
     {
-      mapper->SetInputData(polydata);
+      // the prim transform is applied before the instance transforms,
+      // so it is applied to the shared geometry directly
+      vtkNew<vtkTransform> t;
+      t->SetMatrix(mat);
+
+      vtkNew<vtkTransformFilter> transform;
+      transform->SetTransform(t);
+      transform->SetInputData(mapperInput);
+      transform->Update();
+
+      vtkNew<vtkGlyph3DMapper> glyphMapper;
+      glyphMapper->SetInputData(instances);
+      glyphMapper->SetSourceData(vtkPolyData::SafeDownCast(transform->GetOutput()));
+      glyphMapper->SetOrientationArray("Orientation");
+      glyphMapper->SetOrientationModeToQuaternion();
+      glyphMapper->SetScaleArray("Scale");
+      glyphMapper->SetScaleModeToScaleByVectorComponents();
+      glyphMapper->ScalingOn();
+
+      if (!this->HasTimeCode())
+      {
+        glyphMapper->StaticOn();
+      }
+
+      actor->SetMapper(glyphMapper);
+      actor->SetUserMatrix(nullptr);
+      return;
     }
 
+    auto skinned = this->SkinnedPrims.find(geomPrim.GetPath().GetAsString());
+    if (skinned != this->SkinnedPrims.end())
+    {
+      this->SkinnedActors[actorPath.GetAsString()] = { actor, skinned->second.SkelQuery,
+        skinned->second.SkinningQuery };
+    }
+
+    vtkNew<vtkPolyDataMapper> mapper;
+    mapper->SetInputData(mapperInput);
+
     if (!this->HasTimeCode())
     {
       mapper->StaticOn();
@@ -253,455 +515,762 @@ public:
     actor->SetUserMatrix(mat);
   }
 
-  void ImportNode(vtkRenderer* renderer, const pxr::UsdPrim& node, const pxr::SdfPath& path,
-    vtkMatrix4x4* currentMatrix)
+  bool MightBeTimeVarying(const pxr::UsdPrim& prim)
   {
-    pxr::UsdTimeCode timeCode = this->CurrentTime * this->Stage->GetTimeCodesPerSecond();
+    // xform ops, visibility and primvars are all attributes of the prim
+    auto timeVarying = [](const auto& a) { return a.ValueMightBeTimeVarying(); };
 
-    // simple range-for iteration
-    for (pxr::UsdPrim prim : pxr::UsdPrimSiblingRange(node.GetAllChildren()))
+    std::vector<pxr::UsdAttribute> attributes = prim.GetAttributes();
+    if (std::any_of(attributes.cbegin(), attributes.cend(), timeVarying))
     {
-      if (prim.IsA<pxr::UsdGeomImageable>())
-      {
-        pxr::UsdGeomImageable imageable = pxr::UsdGeomImageable(prim);
+      return true;
+    }
 
-        pxr::TfToken visibility;
-        pxr::UsdAttribute visAttr = imageable.GetVisibilityAttr();
-        if (visAttr && visAttr.HasAuthoredValue() && visAttr.Get(&visibility, timeCode) &&
-          visibility == pxr::UsdGeomTokens->invisible)
+    // prototypes are only imported through the instancer
+    if (prim.IsA<pxr::UsdGeomPointInstancer>())
+    {
+      pxr::SdfPathVector prototypes;
+      pxr::UsdGeomPointInstancer(prim).GetPrototypesRel().GetTargets(&prototypes);
+      for (const pxr::SdfPath& prototypePath : prototypes)
+      {
+        pxr::UsdPrim prototype = this->Stage->GetPrimAtPath(prototypePath);
+        if (!prototype)
         {
-          // not visible, skip
           continue;
         }
 
-        pxr::TfToken purpose;
-        pxr::UsdAttribute purpAttr = imageable.GetPurposeAttr();
-        if (purpAttr && purpAttr.HasAuthoredValue() && purpAttr.Get(&purpose, timeCode) &&
-          (purpose == pxr::UsdGeomTokens->proxy || purpose == pxr::UsdGeomTokens->guide))
+        pxr::UsdPrimRange range(prototype, pxr::UsdPrimAllPrimsPredicate);
+        for (const pxr::UsdPrim& child : range)
         {
-          // proxy, skip
-          continue;
+          if (child != prim && this->MightBeTimeVarying(child))
+          {
+            return true;
+          }
         }
       }
+      return false;
+    }
 
-      if (prim.IsInstance())
-      {
-        pxr::UsdGeomXform xform = pxr::UsdGeomXform(prim);
+    // subsets are child prims but are imported with the geometry
+    if (prim.IsA<pxr::UsdGeomGprim>())
+    {
+      std::vector<pxr::UsdGeomSubset> subsets =
+        pxr::UsdGeomSubset::GetGeomSubsets(pxr::UsdGeomGprim(prim));
+      return std::any_of(subsets.cbegin(), subsets.cend(),
+        [&](const pxr::UsdGeomSubset& subset) { return timeVarying(subset.GetIndicesAttr()); });
+    }
 
-        auto mat = this->GetLocalTransform(xform, timeCode);
-        vtkMatrix4x4::Multiply4x4(currentMatrix, mat, mat);
+    return false;
+  }
 
-        this->ImportNode(renderer, prim.GetPrototype(), path.AppendChild(prim.GetName()), mat);
-      }
-      else if (prim.IsA<pxr::UsdGeomPointInstancer>())
-      {
-        pxr::UsdGeomPointInstancer glyphs = pxr::UsdGeomPointInstancer(prim);
+  bool IsInvisible(const pxr::UsdPrim& prim, pxr::UsdTimeCode timeCode)
+  {
+    if (!prim.IsA<pxr::UsdGeomImageable>())
+    {
+      return false;
+    }
 
-        // TODO: Ideally, we should use the 3D glyph mapper, but it's left for future work
-        // See https://github.com/f3d-app/f3d/issues/1075
-        pxr::VtMatrix4dArray xforms;
+    pxr::TfToken visibility;
+    pxr::UsdAttribute visAttr = pxr::UsdGeomImageable(prim).GetVisibilityAttr();
+    return visAttr && visAttr.HasAuthoredValue() && visAttr.Get(&visibility, timeCode) &&
+      visibility == pxr::UsdGeomTokens->invisible;
+  }
 
-        if (glyphs.ComputeInstanceTransformsAtTime(&xforms, timeCode, timeCode))
-        {
-          int i = 0;
-          for (const pxr::GfMatrix4d& currInstMatrix : xforms)
-          {
-            auto mat = this->ConvertMatrix(currInstMatrix);
-            vtkMatrix4x4::Multiply4x4(currentMatrix, mat, mat);
+  bool IsProxy(const pxr::UsdPrim& prim, pxr::UsdTimeCode timeCode)
+  {
+    if (!prim.IsA<pxr::UsdGeomImageable>())
+    {
+      return false;
+    }
 
-            pxr::TfToken tok(std::string("instance_") + std::to_string(i++));
+    pxr::TfToken purpose;
+    pxr::UsdAttribute purpAttr = pxr::UsdGeomImageable(prim).GetPurposeAttr();
+    return purpAttr && purpAttr.HasAuthoredValue() && purpAttr.Get(&purpose, timeCode) &&
+      (purpose == pxr::UsdGeomTokens->proxy || purpose == pxr::UsdGeomTokens->guide);
+  }
 
-            this->ImportNode(
-              renderer, prim, path.AppendChild(prim.GetName()).AppendChild(tok), mat);
-          }
-        }
-      }
-      else if (prim.IsA<pxr::UsdGeomGprim>())
+  bool IsHidden(const pxr::UsdPrim& prim, pxr::UsdTimeCode timeCode)
+  {
+    return this->IsInvisible(prim, timeCode) || this->IsProxy(prim, timeCode);
+  }
+
+  void HideActors(const pxr::SdfPath& path)
+  {
+    const std::string prefix = path.GetAsString();
+    for (auto& [actorPath, actor] : this->ActorMap)
+    {
+      if (actorPath.compare(0, prefix.size(), prefix) == 0 &&
+        (actorPath.size() == prefix.size() || actorPath[prefix.size()] == '/'))
       {
-        pxr::UsdGeomGprim geomPrim = pxr::UsdGeomGprim(prim);
+        actor->VisibilityOff();
+      }
+    }
+  }
 
-        vtkSmartPointer<vtkPolyData> polydata;
+  bool IsMeshTimeVarying(const pxr::UsdGeomMesh& meshPrim)
+  {
+    auto TimeVarying = [](const auto& a) { return a.ValueMightBeTimeVarying(); };
 
-        if (prim.IsA<pxr::UsdGeomMesh>())
-        {
-          pxr::UsdGeomMesh meshPrim = pxr::UsdGeomMesh(prim);
+    std::vector<pxr::UsdGeomPrimvar> primVars = pxr::UsdGeomPrimvarsAPI(meshPrim).GetPrimvars();
+    return std::any_of(primVars.cbegin(), primVars.cend(), TimeVarying) ||
+      TimeVarying(meshPrim.GetPointsAttr()) || TimeVarying(meshPrim.GetNormalsAttr()) ||
+      TimeVarying(meshPrim.GetFaceVertexCountsAttr()) ||
+      TimeVarying(meshPrim.GetFaceVertexIndicesAttr());
+  }
 
-          vtkSmartPointer<vtkPolyData>& mappedPolydata =
-            this->MeshMap[meshPrim.GetPath().GetAsString()];
-          bool meshAlreadyExists = (mappedPolydata != nullptr);
+  // only reads the stage, so it can be called concurrently
+  vtkSmartPointer<vtkPolyData> ConvertMesh(
+    const pxr::UsdGeomMesh& meshPrim, pxr::UsdTimeCode timeCode)
+  {
+    // the temporary containers of the conversion are freed once the mesh is converted
+    vtkF3DScratchArena::Scope scratch;
 
-          // attributes
-          pxr::UsdAttribute normalsAttr = meshPrim.GetNormalsAttr();
-          pxr::UsdAttribute pointsAttr = meshPrim.GetPointsAttr();
-          pxr::UsdAttribute facesCountAttr = meshPrim.GetFaceVertexCountsAttr();
-          pxr::UsdAttribute facesIndicesAttr = meshPrim.GetFaceVertexIndicesAttr();
+    // attributes
+    pxr::UsdAttribute normalsAttr = meshPrim.GetNormalsAttr();
+    pxr::UsdAttribute pointsAttr = meshPrim.GetPointsAttr();
+    pxr::UsdAttribute facesCountAttr = meshPrim.GetFaceVertexCountsAttr();
+    pxr::UsdAttribute facesIndicesAttr = meshPrim.GetFaceVertexIndicesAttr();
 
-          std::vector<pxr::UsdGeomPrimvar> primVars =
-            pxr::UsdGeomPrimvarsAPI(meshPrim).GetPrimvars();
+    std::vector<pxr::UsdGeomPrimvar> primVars = pxr::UsdGeomPrimvarsAPI(meshPrim).GetPrimvars();
 
-          auto TimeVarying = [](const auto& a) { return a.ValueMightBeTimeVarying(); };
+    vtkNew<vtkPolyData> newPolyData;
 
-          bool animatedAttribute = std::any_of(primVars.cbegin(), primVars.cend(), TimeVarying);
-          animatedAttribute = animatedAttribute || TimeVarying(pointsAttr);
-          animatedAttribute = animatedAttribute || TimeVarying(normalsAttr);
-          animatedAttribute = animatedAttribute || TimeVarying(facesCountAttr);
-          animatedAttribute = animatedAttribute || TimeVarying(facesIndicesAttr);
+    // normals
+    pxr::VtArray<pxr::GfVec3f> normals;
+    normalsAttr.Get(&normals, timeCode);
 
-          // Check if the mesh has to be rebuilt
-          if (!meshAlreadyExists || animatedAttribute)
-          {
-            vtkNew<vtkPolyData> newPolyData;
+    if (normals.size() > 0)
+    {
+      vtkNew<vtkFloatArray> vNormals;
+      vNormals->SetName("Normals");
+      vNormals->SetNumberOfComponents(3);
+      vNormals->Allocate(normals.size());
 
-            // normals
-            pxr::VtArray<pxr::GfVec3f> normals;
-            normalsAttr.Get(&normals, timeCode);
+      for (const pxr::GfVec3f& n : normals)
+      {
+        vNormals->InsertNextTuple3(n[0], n[1], n[2]);
+      }
 
-            if (normals.size() > 0)
-            {
-              vtkNew<vtkFloatArray> vNormals;
-              vNormals->SetName("Normals");
-              vNormals->SetNumberOfComponents(3);
-              vNormals->Allocate(normals.size());
+      vtkInformation* info = vNormals->GetInformation();
+      info->Set(vtkF3DFaceVaryingPointDispatcher::INTERPOLATION_TYPE(),
+        meshPrim.GetNormalsInterpolation() == pxr::UsdGeomTokens->faceVarying ? 1 : 0);
 
-              for (const pxr::GfVec3f& n : normals)
-              {
-                vNormals->InsertNextTuple3(n[0], n[1], n[2]);
-              }
+      newPolyData->GetPointData()->SetNormals(vNormals);
+    }
 
-              vtkInformation* info = vNormals->GetInformation();
-              info->Set(vtkF3DFaceVaryingPointDispatcher::INTERPOLATION_TYPE(),
-                meshPrim.GetNormalsInterpolation() == pxr::UsdGeomTokens->faceVarying ? 1 : 0);
+    // texture coordinates
+    bool firstArray = true;
+    for (const pxr::UsdGeomPrimvar& primVar : primVars)
+    {
+      if (primVar.GetTypeName() == "texCoord2f[]" || primVar.GetTypeName() == "float2[]")
+      {
+        pxr::VtArray<pxr::GfVec2f> uvs;
+        primVar.Get(&uvs, timeCode);
 
-              newPolyData->GetPointData()->SetNormals(vNormals);
-            }
+        if (uvs.size() > 0)
+        {
+          std::string name = primVar.GetPrimvarName();
+
+          vtkNew<vtkFloatArray> texCoords;
+          texCoords->SetName(name.c_str());
+          texCoords->SetNumberOfComponents(2);
 
-            // texture coordinates
-            bool firstArray = true;
-            for (const pxr::UsdGeomPrimvar& primVar : primVars)
+          if (primVar.IsIndexed())
+          {
+            pxr::UsdAttribute indicesAttr = primVar.GetIndicesAttr();
+
+            pxr::VtArray<int> indices;
+            if (indicesAttr.Get(&indices) && indices.size() > 0)
             {
-              if (primVar.GetTypeName() == "texCoord2f[]" || primVar.GetTypeName() == "float2[]")
+              texCoords->Allocate(indices.size());
+
+              for (int index : indices)
               {
-                pxr::VtArray<pxr::GfVec2f> uvs;
-                primVar.Get(&uvs, timeCode);
-
-                if (uvs.size() > 0)
-                {
-                  std::string name = primVar.GetPrimvarName();
-
-                  vtkNew<vtkFloatArray> texCoords;
-                  texCoords->SetName(name.c_str());
-                  texCoords->SetNumberOfComponents(2);
-
-                  if (primVar.IsIndexed())
-                  {
-                    pxr::UsdAttribute indicesAttr = primVar.GetIndicesAttr();
-
-                    pxr::VtArray<int> indices;
-                    if (indicesAttr.Get(&indices) && indices.size() > 0)
-                    {
-                      texCoords->Allocate(indices.size());
-
-                      for (int index : indices)
-                      {
-                        const pxr::GfVec2f& uv = uvs[index];
-                        texCoords->InsertNextTuple2(uv[0], uv[1]);
-                      }
-                    }
-                  }
-                  else
-                  {
-                    texCoords->Allocate(uvs.size());
-
-                    for (const pxr::GfVec2f& uv : uvs)
-                    {
-                      texCoords->InsertNextTuple2(uv[0], uv[1]);
-                    }
-                  }
-
-                  vtkInformation* info = texCoords->GetInformation();
-                  info->Set(vtkF3DFaceVaryingPointDispatcher::INTERPOLATION_TYPE(),
-                    primVar.GetInterpolation() == pxr::UsdGeomTokens->faceVarying ? 1 : 0);
-
-                  // the size of the array can be larger than the number of points if the attribute
-                  // interpolation is face-varying.
-                  // It will be normalized by the vtkF3DFaceVaryingPointDispatcher later
-                  newPolyData->GetPointData()->AddArray(texCoords);
-
-                  if (firstArray)
-                  {
-                    // sometimes we are enable to fetch the array name to use for texture mapping
-                    // so we fallback to the first UV set added
-                    // see https://github.com/f3d-app/f3d/issues/1184
-                    firstArray = false;
-                    newPolyData->GetPointData()->SetTCoords(texCoords);
-                  }
-                }
+                const pxr::GfVec2f& uv = uvs[index];
+                texCoords->InsertNextTuple2(uv[0], uv[1]);
               }
             }
+          }
+          else
+          {
+            texCoords->Allocate(uvs.size());
 
-            // points
-            pxr::VtArray<pxr::GfVec3f> positions;
-            pointsAttr.Get(&positions, timeCode);
-
-            vtkNew<vtkPoints> points;
-            points->Allocate(positions.size());
-            for (const pxr::GfVec3f& p : positions)
+            for (const pxr::GfVec2f& uv : uvs)
             {
-              points->InsertNextPoint(p[0], p[1], p[2]);
+              texCoords->InsertNextTuple2(uv[0], uv[1]);
             }
+          }
 
-            newPolyData->SetPoints(points);
+          vtkInformation* info = texCoords->GetInformation();
+          info->Set(vtkF3DFaceVaryingPointDispatcher::INTERPOLATION_TYPE(),
+            primVar.GetInterpolation() == pxr::UsdGeomTokens->faceVarying ? 1 : 0);
 
-            // faces
-            pxr::VtArray<int> counts;
-            facesCountAttr.Get(&counts, timeCode);
+          // the size of the array can be larger than the number of points if the attribute
+          // interpolation is face-varying.
+          // It will be normalized by the vtkF3DFaceVaryingPointDispatcher later
+          newPolyData->GetPointData()->AddArray(texCoords);
 
-            pxr::VtArray<int> indices;
-            facesIndicesAttr.Get(&indices, timeCode);
+          if (firstArray)
+          {
+            // sometimes we are enable to fetch the array name to use for texture mapping
+            // so we fallback to the first UV set added
+            // see https://github.com/f3d-app/f3d/issues/1184
+            firstArray = false;
+            newPolyData->GetPointData()->SetTCoords(texCoords);
+          }
+        }
+      }
+    }
 
-            // add polygons
-            vtkNew<vtkCellArray> cells;
-            auto currentCellIt = indices.cbegin();
-            std::vector<vtkIdType> indexArr;
-            for (int c : counts)
-            {
-              indexArr.clear();
-              indexArr.insert(indexArr.begin(), currentCellIt, std::next(currentCellIt, c));
-              cells->InsertNextCell(c, indexArr.data());
-              std::advance(currentCellIt, c);
-            }
+    // points
+    pxr::VtArray<pxr::GfVec3f> positions;
+    pointsAttr.Get(&positions, timeCode);
 
-            newPolyData->SetPolys(cells);
+    vtkNew<vtkPoints> points;
+    points->Allocate(positions.size());
+    for (const pxr::GfVec3f& p : positions)
+    {
+      points->InsertNextPoint(p[0], p[1], p[2]);
+    }
 
-            vtkNew<vtkF3DFaceVaryingPointDispatcher> faceVaryingFilter;
-            faceVaryingFilter->SetInputData(newPolyData);
-            faceVaryingFilter->Update();
+    newPolyData->SetPoints(points);
 
-            mappedPolydata = faceVaryingFilter->GetOutput();
-          }
+    auto skinned = this->SkinnedPrims.find(meshPrim.GetPath().GetAsString());
+    if (skinned != this->SkinnedPrims.end())
+    {
+      this->AddJointInfluences(
+        skinned->second.SkinningQuery, static_cast<vtkIdType>(positions.size()), newPolyData);
+    }
 
-          polydata = mappedPolydata;
-        }
-        else if (prim.IsA<pxr::UsdGeomSphere>())
-        {
-          pxr::UsdGeomSphere spherePrim = pxr::UsdGeomSphere(prim);
+    // faces
+    pxr::VtArray<int> counts;
+    facesCountAttr.Get(&counts, timeCode);
 
-          vtkNew<vtkSphereSource> sphere;
-          sphere->SetThetaResolution(20);
-          sphere->SetPhiResolution(20);
+    pxr::VtArray<int> indices;
+    facesIndicesAttr.Get(&indices, timeCode);
 
-          double radius;
-          if (spherePrim.GetRadiusAttr().Get(&radius))
-          {
-            sphere->SetRadius(radius);
-          }
+    // add polygons
+    vtkNew<vtkCellArray> cells;
+    cells->AllocateExact(
+      static_cast<vtkIdType>(counts.size()), static_cast<vtkIdType>(indices.size()));
+    auto currentCellIt = indices.cbegin();
+    vtkF3DScratchArena::Vector<vtkIdType> indexArr;
+    for (int c : counts)
+    {
+      indexArr.clear();
+      indexArr.insert(indexArr.begin(), currentCellIt, std::next(currentCellIt, c));
+      cells->InsertNextCell(c, indexArr.data());
+      std::advance(currentCellIt, c);
+    }
+
+    newPolyData->SetPolys(cells);
+
+    vtkNew<vtkF3DFaceVaryingPointDispatcher> faceVaryingFilter;
+    faceVaryingFilter->SetInputData(newPolyData);
+    faceVaryingFilter->WeldOn();
+    faceVaryingFilter->Update();
 
-          sphere->Update();
-          polydata = sphere->GetOutput();
+    return faceVaryingFilter->GetOutput();
+  }
+
+  // collect the meshes that the traversal of a subtree would convert
+  void CollectMeshes(const pxr::UsdPrim& root, pxr::UsdTimeCode timeCode,
+    std::vector<pxr::UsdGeomMesh>& meshes, std::unordered_set<std::string>& visited)
+  {
+    pxr::UsdPrimRange range(root, pxr::UsdPrimAllPrimsPredicate);
+    for (auto it = range.begin(); it != range.end() && !this->Parent->IsCancelled(); ++it)
+    {
+      const pxr::UsdPrim& prim = *it;
+
+      if (this->IsHidden(prim, timeCode))
+      {
+        it.PruneChildren();
+        continue;
+      }
+
+      if (prim.IsInstance())
+      {
+        // the prototypes are shared by their instances
+        pxr::UsdPrim prototype = prim.GetPrototype();
+        if (visited.insert(prototype.GetPath().GetAsString()).second)
+        {
+          this->CollectMeshes(prototype, timeCode, meshes, visited);
         }
-        else if (prim.IsA<pxr::UsdGeomCube>())
+      }
+      else if (prim.IsA<pxr::UsdGeomMesh>())
+      {
+        pxr::UsdGeomMesh meshPrim = pxr::UsdGeomMesh(prim);
+        const std::string meshPath = meshPrim.GetPath().GetAsString();
+        if (visited.insert(meshPath).second &&
+          (this->MeshMap.count(meshPath) == 0 || this->IsMeshTimeVarying(meshPrim)))
         {
-          pxr::UsdGeomCube cubePrim = pxr::UsdGeomCube(prim);
+          meshes.emplace_back(meshPrim);
+        }
+      }
+    }
+  }
 
-          vtkNew<vtkCubeSource> cube;
+  // convert concurrently the meshes of the subtrees that are about to be traversed,
+  // USD supports concurrent reads of a stage, only the actors are created sequentially
+  void PrefetchMeshes(const std::vector<pxr::UsdPrim>& roots)
+  {
+    pxr::UsdTimeCode timeCode = this->CurrentTime * this->Stage->GetTimeCodesPerSecond();
 
-          double length;
-          if (cubePrim.GetSizeAttr().Get(&length))
-          {
-            cube->SetXLength(length);
-            cube->SetYLength(length);
-            cube->SetZLength(length);
-          }
+    std::vector<pxr::UsdGeomMesh> meshes;
+    std::unordered_set<std::string> visited;
+    for (const pxr::UsdPrim& root : roots)
+    {
+      this->CollectMeshes(root, timeCode, meshes, visited);
+    }
 
-          cube->Update();
-          polydata = cube->GetOutput();
-        }
-        else if (prim.IsA<pxr::UsdGeomCapsule>())
+    std::vector<vtkSmartPointer<vtkPolyData>> polydatas(meshes.size());
+    vtkSMPTools::For(0, static_cast<vtkIdType>(meshes.size()),
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        for (vtkIdType i = begin; i < end && !this->Parent->IsCancelled(); i++)
         {
-          pxr::UsdGeomCapsule capsulePrim = pxr::UsdGeomCapsule(prim);
+          polydatas[i] = this->ConvertMesh(meshes[i], timeCode);
+        }
+      });
+
+    this->PrefetchedMeshes.clear();
+    for (size_t i = 0; i < meshes.size(); i++)
+    {
+      this->PrefetchedMeshes[meshes[i].GetPath().GetAsString()] = polydatas[i];
+    }
+  }
+
+  vtkSmartPointer<vtkPolyData> ImportGeometry(const pxr::UsdPrim& prim, pxr::UsdTimeCode timeCode)
+  {
+    vtkSmartPointer<vtkPolyData> polydata;
+
+    if (prim.IsA<pxr::UsdGeomMesh>())
+    {
+      pxr::UsdGeomMesh meshPrim = pxr::UsdGeomMesh(prim);
+      const std::string meshPath = meshPrim.GetPath().GetAsString();
+
+      vtkSmartPointer<vtkPolyData>& mappedPolydata = this->MeshMap[meshPath];
+
+      // the meshes converted concurrently before the traversal are up to date
+      auto prefetched = this->PrefetchedMeshes.find(meshPath);
+      if (prefetched != this->PrefetchedMeshes.end())
+      {
+        mappedPolydata = prefetched->second;
+        this->PrefetchedMeshes.erase(prefetched);
+      }
+      // Check if the mesh has to be rebuilt
+      else if (!mappedPolydata || this->IsMeshTimeVarying(meshPrim))
+      {
+        mappedPolydata = this->ConvertMesh(meshPrim, timeCode);
+      }
+
+      polydata = mappedPolydata;
+    }
+    else if (prim.IsA<pxr::UsdGeomSphere>())
+    {
+      pxr::UsdGeomSphere spherePrim = pxr::UsdGeomSphere(prim);
+
+      vtkNew<vtkSphereSource> sphere;
+      sphere->SetThetaResolution(20);
+      sphere->SetPhiResolution(20);
+
+      double radius;
+      if (spherePrim.GetRadiusAttr().Get(&radius))
+      {
+        sphere->SetRadius(radius);
+      }
+
+      sphere->Update();
+      polydata = sphere->GetOutput();
+    }
+    else if (prim.IsA<pxr::UsdGeomCube>())
+    {
+      pxr::UsdGeomCube cubePrim = pxr::UsdGeomCube(prim);
+
+      vtkNew<vtkCubeSource> cube;
+
+      double length;
+      if (cubePrim.GetSizeAttr().Get(&length))
+      {
+        cube->SetXLength(length);
+        cube->SetYLength(length);
+        cube->SetZLength(length);
+      }
+
+      cube->Update();
+      polydata = cube->GetOutput();
+    }
+    else if (prim.IsA<pxr::UsdGeomCapsule>())
+    {
+      pxr::UsdGeomCapsule capsulePrim = pxr::UsdGeomCapsule(prim);
 
-          // See https://gitlab.kitware.com/vtk/vtk/-/merge_requests/10531
+      // See https://gitlab.kitware.com/vtk/vtk/-/merge_requests/10531
 #if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 0)
-          vtkNew<vtkCylinderSource> capsule;
-          capsule->CapsuleCapOn();
+      vtkNew<vtkCylinderSource> capsule;
+      capsule->CapsuleCapOn();
 
-          double height;
-          if (capsulePrim.GetHeightAttr().Get(&height))
-          {
-            capsule->SetHeight(height);
-          }
+      double height;
+      if (capsulePrim.GetHeightAttr().Get(&height))
+      {
+        capsule->SetHeight(height);
+      }
 #else
-          vtkNew<vtkCapsuleSource> capsule;
+      vtkNew<vtkCapsuleSource> capsule;
 
-          double height;
-          if (capsulePrim.GetHeightAttr().Get(&height))
-          {
-            capsule->SetCylinderLength(height);
-          }
+      double height;
+      if (capsulePrim.GetHeightAttr().Get(&height))
+      {
+        capsule->SetCylinderLength(height);
+      }
 #endif
 
-          double radius;
-          if (capsulePrim.GetRadiusAttr().Get(&radius))
-          {
-            capsule->SetRadius(radius);
-          }
+      double radius;
+      if (capsulePrim.GetRadiusAttr().Get(&radius))
+      {
+        capsule->SetRadius(radius);
+      }
 
-          // In VTK, the capsule is aligned with the Y axis
-          // In USD, the default is aligned with Z, but can be modified
-          // Let's rotate it if needed
-          vtkNew<vtkTransformFilter> transform;
-          vtkNew<vtkTransform> t;
-          transform->SetTransform(t);
+      // In VTK, the capsule is aligned with the Y axis
+      // In USD, the default is aligned with Z, but can be modified
+      // Let's rotate it if needed
+      vtkNew<vtkTransformFilter> transform;
+      vtkNew<vtkTransform> t;
+      transform->SetTransform(t);
 
-          pxr::TfToken axisToken(pxr::UsdGeomTokens->z);
-          capsulePrim.GetAxisAttr().Get(&axisToken);
+      pxr::TfToken axisToken(pxr::UsdGeomTokens->z);
+      capsulePrim.GetAxisAttr().Get(&axisToken);
 
-          if (axisToken == pxr::UsdGeomTokens->x)
-          {
-            t->RotateZ(90.0);
-          }
-          else if (axisToken == pxr::UsdGeomTokens->z)
-          {
-            t->RotateX(90.0);
-          }
+      if (axisToken == pxr::UsdGeomTokens->x)
+      {
+        t->RotateZ(90.0);
+      }
+      else if (axisToken == pxr::UsdGeomTokens->z)
+      {
+        t->RotateX(90.0);
+      }
 
-          transform->SetInputConnection(capsule->GetOutputPort());
-          transform->Update();
-          polydata = vtkPolyData::SafeDownCast(transform->GetOutput());
-        }
-        else if (prim.IsA<pxr::UsdGeomCylinder>())
-        {
-          pxr::UsdGeomCylinder cylinderPrim = pxr::UsdGeomCylinder(prim);
-          vtkNew<vtkCylinderSource> cylinder;
-          cylinder->SetResolution(20);
+      transform->SetInputConnection(capsule->GetOutputPort());
+      transform->Update();
+      polydata = vtkPolyData::SafeDownCast(transform->GetOutput());
+    }
+    else if (prim.IsA<pxr::UsdGeomCylinder>())
+    {
+      pxr::UsdGeomCylinder cylinderPrim = pxr::UsdGeomCylinder(prim);
+      vtkNew<vtkCylinderSource> cylinder;
+      cylinder->SetResolution(20);
 
-          double height;
-          if (cylinderPrim.GetHeightAttr().Get(&height))
-          {
-            cylinder->SetHeight(height);
-          }
+      double height;
+      if (cylinderPrim.GetHeightAttr().Get(&height))
+      {
+        cylinder->SetHeight(height);
+      }
 
-          double radius;
-          if (cylinderPrim.GetRadiusAttr().Get(&radius))
-          {
-            cylinder->SetRadius(radius);
-          }
+      double radius;
+      if (cylinderPrim.GetRadiusAttr().Get(&radius))
+      {
+        cylinder->SetRadius(radius);
+      }
 
-          // In VTK, the cylinder is aligned with the Y axis
-          // In USD, the default is aligned with Z, but can be modified
-          // Let's rotate it if needed
-          vtkNew<vtkTransformFilter> transform;
-          vtkNew<vtkTransform> t;
-          transform->SetTransform(t);
+      // In VTK, the cylinder is aligned with the Y axis
+      // In USD, the default is aligned with Z, but can be modified
+      // Let's rotate it if needed
+      vtkNew<vtkTransformFilter> transform;
+      vtkNew<vtkTransform> t;
+      transform->SetTransform(t);
 
-          pxr::TfToken axisToken(pxr::UsdGeomTokens->z);
-          cylinderPrim.GetAxisAttr().Get(&axisToken);
+      pxr::TfToken axisToken(pxr::UsdGeomTokens->z);
+      cylinderPrim.GetAxisAttr().Get(&axisToken);
 
-          if (axisToken == pxr::TfToken(pxr::UsdGeomTokens->x))
-          {
-            t->RotateZ(90.0);
-          }
-          else if (axisToken == pxr::TfToken(pxr::UsdGeomTokens->z))
-          {
-            t->RotateX(90.0);
-          }
+      if (axisToken == pxr::TfToken(pxr::UsdGeomTokens->x))
+      {
+        t->RotateZ(90.0);
+      }
+      else if (axisToken == pxr::TfToken(pxr::UsdGeomTokens->z))
+      {
+        t->RotateX(90.0);
+      }
 
-          transform->SetInputConnection(cylinder->GetOutputPort());
-          transform->Update();
-          polydata = vtkPolyData::SafeDownCast(transform->GetOutput());
-        }
-        else if (prim.IsA<pxr::UsdGeomCone>())
-        {
-          pxr::UsdGeomCone conePrim = pxr::UsdGeomCone(prim);
-          vtkNew<vtkConeSource> cone;
-          cone->SetResolution(20);
+      transform->SetInputConnection(cylinder->GetOutputPort());
+      transform->Update();
+      polydata = vtkPolyData::SafeDownCast(transform->GetOutput());
+    }
+    else if (prim.IsA<pxr::UsdGeomCone>())
+    {
+      pxr::UsdGeomCone conePrim = pxr::UsdGeomCone(prim);
+      vtkNew<vtkConeSource> cone;
+      cone->SetResolution(20);
 
-          double height;
-          if (conePrim.GetHeightAttr().Get(&height))
-          {
-            cone->SetHeight(height);
-          }
+      double height;
+      if (conePrim.GetHeightAttr().Get(&height))
+      {
+        cone->SetHeight(height);
+      }
 
-          double radius;
-          if (conePrim.GetRadiusAttr().Get(&radius))
-          {
-            cone->SetRadius(radius);
-          }
+      double radius;
+      if (conePrim.GetRadiusAttr().Get(&radius))
+      {
+        cone->SetRadius(radius);
+      }
 
-          // In VTK, the cylinder is aligned with the X axis
-          // In USD, the default is aligned with Z, but can be modified
-          // Let's rotate it if needed
-          vtkNew<vtkTransformFilter> transform;
-          vtkNew<vtkTransform> t;
-          transform->SetTransform(t);
+      // In VTK, the cylinder is aligned with the X axis
+      // In USD, the default is aligned with Z, but can be modified
+      // Let's rotate it if needed
+      vtkNew<vtkTransformFilter> transform;
+      vtkNew<vtkTransform> t;
+      transform->SetTransform(t);
 
-          pxr::TfToken axisToken(pxr::UsdGeomTokens->z);
-          conePrim.GetAxisAttr().Get(&axisToken);
+      pxr::TfToken axisToken(pxr::UsdGeomTokens->z);
+      conePrim.GetAxisAttr().Get(&axisToken);
 
-          if (axisToken == pxr::TfToken(pxr::UsdGeomTokens->y))
-          {
-            t->RotateZ(90.0);
-          }
-          else if (axisToken == pxr::TfToken(pxr::UsdGeomTokens->z))
-          {
-            t->RotateY(90.0);
-          }
+      if (axisToken == pxr::TfToken(pxr::UsdGeomTokens->y))
+      {
+        t->RotateZ(90.0);
+      }
+      else if (axisToken == pxr::TfToken(pxr::UsdGeomTokens->z))
+      {
+        t->RotateY(90.0);
+      }
 
-          transform->SetInputConnection(cone->GetOutputPort());
-          transform->Update();
-          polydata = vtkPolyData::SafeDownCast(transform->GetOutput());
-        }
+      transform->SetInputConnection(cone->GetOutputPort());
+      transform->Update();
+      polydata = vtkPolyData::SafeDownCast(transform->GetOutput());
+    }
+
+    return polydata;
+  }
+
+  void AddGprimActors(vtkRenderer* renderer, const pxr::SdfPath& path,
+    const pxr::UsdGeomGprim& geomPrim, const pxr::UsdPrim& prim, vtkMatrix4x4* mat,
+    vtkPolyData* polydata, vtkPolyData* instances, pxr::UsdTimeCode timeCode)
+  {
+    std::vector<pxr::UsdGeomSubset> subsets = pxr::UsdGeomSubset::GetGeomSubsets(geomPrim);
+
+    if (subsets.empty())
+    {
+      this->AddActor(renderer, path, geomPrim, prim, mat, polydata, instances);
+    }
+    else
+    {
+      // split subsets
+      for (const pxr::UsdGeomSubset& subset : subsets)
+      {
+        pxr::UsdAttribute indicesAttr = subset.GetIndicesAttr();
 
-        // create actors
+        pxr::VtArray<int> indices;
+        indicesAttr.Get(&indices, timeCode);
 
-        // get xform
-        auto mat = this->GetLocalTransform(geomPrim, timeCode);
-        vtkMatrix4x4::Multiply4x4(currentMatrix, mat, mat);
+        vtkNew<vtkPolyData> polydataSubset;
+        polydataSubset->SetPoints(polydata->GetPoints());
+        polydataSubset->GetPointData()->ShallowCopy(polydata->GetPointData());
 
-        std::vector<pxr::UsdGeomSubset> subsets = pxr::UsdGeomSubset::GetGeomSubsets(geomPrim);
+        vtkCellArray* mainPolys = polydata->GetPolys();
 
-        if (subsets.empty())
+        // add polygons
+        vtkNew<vtkCellArray> cells;
+        for (int cellId : indices)
         {
-          this->AddActor(renderer, path, geomPrim, prim, mat, polydata);
+          vtkIdType cellSize;
+          const vtkIdType* cellPoints;
+          mainPolys->GetCellAtId(cellId, cellSize, cellPoints);
+          cells->InsertNextCell(cellSize, cellPoints);
         }
-        else
-        {
-          // split subsets
-          for (const pxr::UsdGeomSubset& subset : subsets)
-          {
-            pxr::UsdAttribute indicesAttr = subset.GetIndicesAttr();
 
-            pxr::VtArray<int> indices;
-            indicesAttr.Get(&indices, timeCode);
+        polydataSubset->SetPolys(cells);
 
-            vtkNew<vtkPolyData> polydataSubset;
-            polydataSubset->SetPoints(polydata->GetPoints());
-            polydataSubset->GetPointData()->ShallowCopy(polydata->GetPointData());
+        this->AddActor(renderer, path.AppendChild(pxr::TfToken(prim.GetName())), geomPrim,
+          subset.GetPrim(), mat, polydataSubset, instances);
+      }
+    }
+  }
 
-            vtkCellArray* mainPolys = polydata->GetPolys();
+  vtkSmartPointer<vtkPolyData> CreateInstances(const pxr::VtMatrix4dArray& xforms,
+    const pxr::VtIntArray& protoIndices, int protoIndex, vtkMatrix4x4* currentMatrix)
+  {
+    vtkNew<vtkPoints> points;
 
-            // add polygons
-            vtkNew<vtkCellArray> cells;
-            for (int cellId : indices)
-            {
-              vtkIdType cellSize;
-              const vtkIdType* cellPoints;
-              mainPolys->GetCellAtId(cellId, cellSize, cellPoints);
-              cells->InsertNextCell(cellSize, cellPoints);
-            }
+    vtkNew<vtkDoubleArray> orientations;
+    orientations->SetName("Orientation");
+    orientations->SetNumberOfComponents(4);
 
-            polydataSubset->SetPolys(cells);
+    vtkNew<vtkDoubleArray> scales;
+    scales->SetName("Scale");
+    scales->SetNumberOfComponents(3);
 
-            this->AddActor(renderer, path.AppendChild(pxr::TfToken(prim.GetName())), geomPrim,
-              subset.GetPrim(), mat, polydataSubset);
-          }
-        }
+    for (size_t i = 0; i < xforms.size(); i++)
+    {
+      if (protoIndices[i] != protoIndex)
+      {
+        continue;
       }
-      else
+
+      auto mat = this->ConvertMatrix(xforms[i]);
+      vtkMatrix4x4::Multiply4x4(currentMatrix, mat, mat);
+
+      // the glyph mapper expects the transform to be decomposed
+      pxr::GfMatrix4d uMatrix;
+      std::copy(mat->GetData(), mat->GetData() + 16, uMatrix.data());
+      pxr::GfTransform transform(uMatrix.GetTranspose());
+
+      const pxr::GfVec3d& t = transform.GetTranslation();
+      const pxr::GfVec3d& s = transform.GetScale();
+      pxr::GfQuatd q = transform.GetRotation().GetQuat();
+
+      points->InsertNextPoint(t[0], t[1], t[2]);
+      orientations->InsertNextTuple4(
+        q.GetReal(), q.GetImaginary()[0], q.GetImaginary()[1], q.GetImaginary()[2]);
+      scales->InsertNextTuple3(s[0], s[1], s[2]);
+    }
+
+    vtkNew<vtkPolyData> instances;
+    instances->SetPoints(points);
+    instances->GetPointData()->AddArray(orientations);
+    instances->GetPointData()->AddArray(scales);
+    return instances;
+  }
+
+  void ImportPrototype(vtkRenderer* renderer, const pxr::UsdPrim& prototype,
+    const pxr::SdfPath& path, vtkPolyData* instances, pxr::UsdTimeCode timeCode)
+  {
+    int primIndex = 0;
+    pxr::UsdPrimRange range(prototype, pxr::UsdPrimAllPrimsPredicate);
+    for (auto it = range.begin(); it != range.end(); ++it)
+    {
+      const pxr::UsdPrim& prim = *it;
+
+      if (prim.IsInstance() || prim.IsA<pxr::UsdGeomPointInstancer>())
       {
-        // just traverse the node
-        this->ImportNode(renderer, prim, path.AppendChild(prim.GetName()), currentMatrix);
+        // nested instancing is not supported
+        it.PruneChildren();
+        continue;
       }
+
+      if (prim.IsA<pxr::UsdGeomImageable>() &&
+        pxr::UsdGeomImageable(prim).ComputeVisibility(timeCode) == pxr::UsdGeomTokens->invisible)
+      {
+        it.PruneChildren();
+        continue;
+      }
+
+      if (!prim.IsA<pxr::UsdGeomGprim>())
+      {
+        continue;
+      }
+
+      vtkSmartPointer<vtkPolyData> polydata = this->ImportGeometry(prim, timeCode);
+      if (!polydata)
+      {
+        continue;
+      }
+
+      pxr::UsdGeomGprim geomPrim = pxr::UsdGeomGprim(prim);
+      auto mat = this->GetLocalTransform(geomPrim, timeCode);
+
+      pxr::TfToken tok(std::string("prim_") + std::to_string(primIndex++));
+      this->AddGprimActors(
+        renderer, path.AppendChild(tok), geomPrim, prim, mat, polydata, instances, timeCode);
+    }
+  }
+
+  void ImportNode(vtkRenderer* renderer, const pxr::UsdPrim& node, const pxr::SdfPath& path,
+    vtkMatrix4x4* currentMatrix, bool recordAnimated)
+  {
+    // simple range-for iteration
+    for (pxr::UsdPrim prim : pxr::UsdPrimSiblingRange(node.GetAllChildren()))
+    {
+      this->ImportPrim(renderer, prim, path, currentMatrix, recordAnimated);
+    }
+  }
+
+  void ImportPrim(vtkRenderer* renderer, const pxr::UsdPrim& prim, const pxr::SdfPath& path,
+    vtkMatrix4x4* currentMatrix, bool recordAnimated)
+  {
+    // the traversal is stopped at the next prim once cancelled
+    if (this->Parent->IsCancelled())
+    {
+      return;
+    }
+
+    pxr::UsdTimeCode timeCode = this->CurrentTime * this->Stage->GetTimeCodesPerSecond();
+
+    // record the top most animated prims, only their subtree is imported again
+    // when the time value changes
+    if (recordAnimated && this->MightBeTimeVarying(prim))
+    {
+      vtkNew<vtkMatrix4x4> parentMatrix;
+      parentMatrix->DeepCopy(currentMatrix);
+      this->AnimatedPrims.push_back({ prim, path, parentMatrix });
+      recordAnimated = false;
+    }
+
+    if (this->IsInvisible(prim, timeCode))
+    {
+      // not visible, skip and hide what may have been imported at another time value
+      this->HideActors(path.AppendChild(prim.GetName()));
+      return;
+    }
+
+    if (this->IsProxy(prim, timeCode))
+    {
+      // proxy, skip
+      return;
+    }
+
+    if (prim.IsInstance())
+    {
+      pxr::UsdGeomXform xform = pxr::UsdGeomXform(prim);
+
+      auto mat = this->GetLocalTransform(xform, timeCode);
+      vtkMatrix4x4::Multiply4x4(currentMatrix, mat, mat);
+
+      this->ImportNode(
+        renderer, prim.GetPrototype(), path.AppendChild(prim.GetName()), mat, recordAnimated);
+    }
+    else if (prim.IsA<pxr::UsdGeomPointInstancer>())
+    {
+      pxr::UsdGeomPointInstancer glyphs = pxr::UsdGeomPointInstancer(prim);
+
+      pxr::VtMatrix4dArray xforms;
+      pxr::VtIntArray protoIndices;
+      pxr::SdfPathVector prototypes;
+
+      if (glyphs.ComputeInstanceTransformsAtTime(&xforms, timeCode, timeCode) &&
+        glyphs.GetProtoIndicesAttr().Get(&protoIndices, timeCode) &&
+        protoIndices.size() == xforms.size() && glyphs.GetPrototypesRel().GetTargets(&prototypes))
+      {
+        // each prototype geometry is shared by all its instances and rendered with a single
+        // vtkGlyph3DMapper instead of an actor per instance
+        for (size_t protoIndex = 0; protoIndex < prototypes.size(); protoIndex++)
+        {
+          pxr::UsdPrim prototype = this->Stage->GetPrimAtPath(prototypes[protoIndex]);
+          vtkSmartPointer<vtkPolyData> instances = this->CreateInstances(
+            xforms, protoIndices, static_cast<int>(protoIndex), currentMatrix);
+
+          if (prototype && instances->GetNumberOfPoints() > 0)
+          {
+            pxr::TfToken tok(std::string("prototype_") + std::to_string(protoIndex));
+            this->ImportPrototype(renderer, prototype,
+              path.AppendChild(prim.GetName()).AppendChild(tok), instances, timeCode);
+          }
+        }
+      }
+    }
+    else if (prim.IsA<pxr::UsdGeomGprim>())
+    {
+      pxr::UsdGeomGprim geomPrim = pxr::UsdGeomGprim(prim);
+
+      vtkSmartPointer<vtkPolyData> polydata = this->ImportGeometry(prim, timeCode);
+
+      // get xform
+      auto mat = this->GetLocalTransform(geomPrim, timeCode);
+      vtkMatrix4x4::Multiply4x4(currentMatrix, mat, mat);
+
+      this->AddGprimActors(renderer, path, geomPrim, prim, mat, polydata, nullptr, timeCode);
+    }
+    else
+    {
+      // just traverse the node
+      this->ImportNode(
+        renderer, prim, path.AppendChild(prim.GetName()), currentMatrix, recordAnimated);
     }
   }
 
@@ -728,10 +1297,37 @@ public:
       rootTransform->SetElement(3, 3, 1.0);
     }
 
-    this->ImportNode(renderer, this->Stage->GetPseudoRoot(), pxr::SdfPath("/"), rootTransform);
+    this->AnimatedPrims.clear();
+    this->SkinnedActors.clear();
+    this->PrefetchMeshes({ this->Stage->GetPseudoRoot() });
+    this->ImportNode(
+      renderer, this->Stage->GetPseudoRoot(), pxr::SdfPath("/"), rootTransform, true);
+    this->PrefetchedMeshes.clear();
+    if (this->Parent->IsCancelled())
+    {
+      return false;
+    }
+    this->UpdateSkinnedActors(this->CurrentTime * this->Stage->GetTimeCodesPerSecond());
     return true;
   }
 
+  void UpdateAnimatedPrims(vtkRenderer* renderer)
+  {
+    std::vector<pxr::UsdPrim> roots;
+    for (const AnimatedPrim& animated : this->AnimatedPrims)
+    {
+      roots.emplace_back(animated.Prim);
+    }
+    this->PrefetchMeshes(roots);
+
+    for (const AnimatedPrim& animated : this->AnimatedPrims)
+    {
+      this->ImportPrim(renderer, animated.Prim, animated.Path, animated.ParentMatrix, false);
+    }
+    this->PrefetchedMeshes.clear();
+    this->UpdateSkinnedActors(this->CurrentTime * this->Stage->GetTimeCodesPerSecond());
+  }
+
   vtkSmartPointer<vtkImageData> CombineORMImage(
     vtkImageData* occlusionImage, vtkImageData* roughnessImage, vtkImageData* metallicImage)
   {
@@ -866,39 +1462,52 @@ public:
       pxr::UsdShadeInput fileInput = samplerPrim.GetInput(pxr::TfToken("file"));
       if (fileInput && fileInput.Get(&path))
       {
-        vtkSmartPointer<vtkImageReader2> reader;
-
-        const std::string& assetPath = path.GetAssetPath();
-        std::string ext = assetPath.substr(assetPath.find_last_of('.'));
-        reader.TakeReference(vtkImageReader2Factory::CreateImageReader2FromExtension(ext.c_str()));
-        if (!reader)
+        // the images of texture files are shared with the other importers
+        const std::string& resolvedPath = path.GetResolvedPath();
+        const std::string cacheKey =
+          vtkF3DTextureCache::GetFileKey(resolvedPath, std::to_string(this->TextureMaximumSize));
+        vtkSmartPointer<vtkImageData> image = vtkF3DTextureCache::FindImage(cacheKey);
+        if (!image)
         {
-          // cannot read the image file
-          return nullptr;
-        }
+          vtkSmartPointer<vtkImageReader2> reader;
 
-        const std::string& resolvedPath = path.GetResolvedPath();
-        auto asset = pxr::ArGetResolver().OpenAsset(pxr::ArResolvedPath(resolvedPath));
+          const std::string& assetPath = path.GetAssetPath();
+          std::string ext = assetPath.substr(assetPath.find_last_of('.'));
+          reader.TakeReference(
+            vtkImageReader2Factory::CreateImageReader2FromExtension(ext.c_str()));
+          if (!reader)
+          {
+            // cannot read the image file
+            return nullptr;
+          }
 
-        if (!asset)
-        {
-          // cannot get USD asset
-          return nullptr;
-        }
+          auto asset = pxr::ArGetResolver().OpenAsset(pxr::ArResolvedPath(resolvedPath));
 
-        auto buffer = asset->GetBuffer();
+          if (!asset)
+          {
+            // cannot get USD asset
+            return nullptr;
+          }
 
-        if (!buffer)
-        {
-          // buffer invalid
-          return nullptr;
-        }
+          auto buffer = asset->GetBuffer();
+
+          if (!buffer)
+          {
+            // buffer invalid
+            return nullptr;
+          }
 
-        reader->SetMemoryBuffer(buffer.get());
-        reader->SetMemoryBufferLength(asset->GetSize());
-        reader->Update();
+          reader->SetMemoryBuffer(buffer.get());
+          reader->SetMemoryBufferLength(asset->GetSize());
+          reader->Update();
 
-        tex = reader->GetOutput();
+          image = vtkF3DImporter::ShrinkTexture(reader->GetOutput(), this->TextureMaximumSize);
+          vtkF3DTextureCache::AddImage(cacheKey, image);
+        }
+
+        // the information of the image is specific to this sampler
+        tex = vtkSmartPointer<vtkImageData>::New();
+        tex->ShallowCopy(image);
       }
       else
       {
@@ -1164,11 +1773,39 @@ public:
   pxr::UsdStageRefPtr Stage = nullptr;
 
 private:
+  struct AnimatedPrim
+  {
+    pxr::UsdPrim Prim;
+    pxr::SdfPath Path;
+    vtkSmartPointer<vtkMatrix4x4> ParentMatrix;
+  };
+
+  std::vector<AnimatedPrim> AnimatedPrims;
+
+  struct Skinning
+  {
+    pxr::UsdSkelSkeletonQuery SkelQuery;
+    pxr::UsdSkelSkinningQuery SkinningQuery;
+  };
+  pxr::UsdSkelCache SkelCache;
+  std::unordered_map<std::string, Skinning> SkinnedPrims;
+
+  struct SkinnedActor
+  {
+    vtkSmartPointer<vtkActor> Actor;
+    pxr::UsdSkelSkeletonQuery SkelQuery;
+    pxr::UsdSkelSkinningQuery SkinningQuery;
+  };
+  std::unordered_map<std::string, SkinnedActor> SkinnedActors;
   std::unordered_map<std::string, vtkSmartPointer<vtkActor>> ActorMap;
+  std::unordered_map<std::string, vtkSmartPointer<vtkPolyData>> ActorInputMap;
   std::unordered_map<std::string, vtkSmartPointer<vtkPolyData>> MeshMap;
+  std::unordered_map<std::string, vtkSmartPointer<vtkPolyData>> PrefetchedMeshes;
   std::unordered_map<std::string, vtkSmartPointer<vtkProperty>> ShaderMap;
   std::unordered_map<std::string, vtkSmartPointer<vtkImageData>> TextureMap;
+  int TextureMaximumSize = 0;
   double CurrentTime = 0.0;
+  vtkF3DUSDImporter* Parent = nullptr;
 
   class DiagDelegate : public pxr::TfDiagnosticMgr::Delegate
   {
@@ -1225,7 +1862,9 @@ vtkF3DUSDImporter::~vtkF3DUSDImporter() = default;
 //----------------------------------------------------------------------------
 int vtkF3DUSDImporter::ImportBegin()
 {
-  this->Internals->ReadScene(this->FileName);
+  this->Internals->TextureMaximumSize = this->TextureMaximumSize;
+  this->Internals->ReadScene(
+    this->FileName, this->PayloadsPattern, this->PopulationMask, this->ImportAnimations);
 
   return 1;
 }
@@ -1242,7 +1881,7 @@ void vtkF3DUSDImporter::ImportActors(vtkRenderer* renderer)
 //----------------------------------------------------------------------------
 vtkIdType vtkF3DUSDImporter::GetNumberOfAnimations()
 {
-  return this->Internals->HasTimeCode() ? 1 : 0;
+  return this->ImportAnimations && this->Internals->HasTimeCode() ? 1 : 0;
 }
 
 //----------------------------------------------------------------------------
@@ -1266,14 +1905,63 @@ bool vtkF3DUSDImporter::GetTemporalInformation(vtkIdType vtkNotUsed(animationInd
 bool vtkF3DUSDImporter::UpdateAtTimeValue(double timeValue)
 {
   this->Internals->SetCurrentTime(timeValue);
-  this->Update();
+
+  // only the prims recorded as animated during the import are updated
+  vtkRenderer* renderer = this->GetRenderer();
+  if (renderer)
+  {
+    this->Internals->UpdateAnimatedPrims(renderer);
+  }
+  else
+  {
+    this->Update();
+  }
   return this->Superclass::UpdateAtTimeValue(timeValue);
 }
 
+//----------------------------------------------------------------------------
+bool vtkF3DUSDImporter::ProbeBounds(const std::string& fileName, double bounds[6])
+{
+  pxr::UsdStageRefPtr stage = pxr::UsdStage::Open(fileName, pxr::UsdStage::LoadNone);
+  if (!stage)
+  {
+    return false;
+  }
+
+  // the unloaded payloads are bounded by the extentsHint of their model, if any
+  pxr::UsdGeomBBoxCache cache(pxr::UsdTimeCode::EarliestTime(),
+    { pxr::UsdGeomTokens->default_, pxr::UsdGeomTokens->render }, true);
+  const pxr::GfRange3d range =
+    cache.ComputeWorldBound(stage->GetPseudoRoot()).ComputeAlignedRange();
+  if (range.IsEmpty())
+  {
+    return false;
+  }
+  const pxr::GfVec3d& min = range.GetMin();
+  const pxr::GfVec3d& max = range.GetMax();
+
+  // same rotation of the +Z up stages as ImportRoot
+  if (pxr::UsdGeomGetStageUpAxis(stage) == pxr::UsdGeomTokens->z)
+  {
+    const double rotated[6] = { min[0], max[0], min[2], max[2], -max[1], -min[1] };
+    std::copy(rotated, rotated + 6, bounds);
+  }
+  else
+  {
+    const double aligned[6] = { min[0], max[0], min[1], max[1], min[2], max[2] };
+    std::copy(aligned, aligned + 6, bounds);
+  }
+  return true;
+}
+
 //----------------------------------------------------------------------------
 void vtkF3DUSDImporter::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
   os << indent << "FileName: " << this->FileName << "\n";
   os << indent << "AnimationEnabled: " << std::boolalpha << this->AnimationEnabled << "\n";
+  os << indent << "PayloadsPattern: " << this->PayloadsPattern << "\n";
+  os << indent << "PopulationMask: " << this->PopulationMask << "\n";
+  os << indent << "ImportAnimations: " << std::boolalpha << this->ImportAnimations << "\n";
+  os << indent << "TextureMaximumSize: " << this->TextureMaximumSize << "\n";
 }
@@ -10,8 +10,10 @@
  * - Only supports preview materials
  * - Does not support UV transforms
  * - Do not support lights and cameras
- * - Skinning is done on the CPU
+ * - Skinning is done in the vertex shader with 4 influences per point, blend shapes are ignored
  * - Ignore volumes and NURBS
+ * - Point instancers are rendered with a vtkGlyph3DMapper, which does not support coloring
+ *   and ignores nested instancing in prototypes
  *
  * @sa https://openusd.org/release/index.html
  */
@@ -61,6 +63,13 @@ public:
    */
   static vtkInformationStringKey* TCOORDS_NAME();
 
+  /**
+   * Compute the bounds of the geometry of a file without loading its payloads, using the
+   * extentsHint of the models and the extent of the boundable prims, in the axes of the
+   * imported actors. Return false if the stage cannot be opened or has no extent.
+   */
+  static bool ProbeBounds(const std::string& fileName, double bounds[6]);
+
 protected:
   vtkF3DUSDImporter();
   ~vtkF3DUSDImporter() override;
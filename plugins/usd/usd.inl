@@ -0,0 +1,4 @@
+bool probeBounds(const std::string& fileName, double bounds[6]) const override
+{
+  return vtkF3DUSDImporter::ProbeBounds(fileName, bounds);
+}
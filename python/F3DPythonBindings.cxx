@@ -15,6 +15,14 @@
 #include "utils.h"
 #include "window.h"
 
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <type_traits>
+
 namespace py = pybind11;
 
 template<typename T, size_t S>
@@ -72,24 +80,145 @@ public:
   PYBIND11_TYPE_CASTER(f3d::vector3_t, const_name("f3d.vector3_t"));
 };
 
+// Python buffers wrapped without copy by a mesh view, the GIL must be held when destroyed
+struct mesh_view_buffers
+{
+  f3d::mesh_view_t view;
+  std::vector<std::unique_ptr<py::buffer_info>> buffers;
+};
+
+template<typename T>
+bool is_buffer_of(const py::buffer_info& info)
+{
+  if (info.itemsize != static_cast<py::ssize_t>(sizeof(T)) || info.format.empty())
+  {
+    return false;
+  }
+
+  // ignore the byte order prefix, the item size is already checked
+  const char kind = info.format.back();
+  if (std::is_floating_point_v<T>)
+  {
+    return kind == 'f';
+  }
+  return std::string("BHILQ").find(kind) != std::string::npos;
+}
+
+template<typename T>
+f3d::mesh_view_t::buffer_t<T> wrap_buffer(
+  mesh_view_buffers& holder, const py::object& obj, const std::string& name, int* components = nullptr)
+{
+  if (obj.is_none())
+  {
+    return {};
+  }
+
+  auto info = std::make_unique<py::buffer_info>(py::buffer(obj).request());
+  if (!is_buffer_of<T>(*info))
+  {
+    throw py::type_error(name + " buffer has an incompatible type '" + info->format + "'");
+  }
+
+  py::ssize_t stride = info->itemsize;
+  for (py::ssize_t i = info->ndim - 1; i >= 0; i--)
+  {
+    if (info->shape[i] > 1 && info->strides[i] != stride)
+    {
+      throw py::value_error(name + " buffer must be C-contiguous");
+    }
+    stride *= info->shape[i];
+  }
+
+  if (components)
+  {
+    *components = info->ndim == 2 ? static_cast<int>(info->shape[1]) : 1;
+  }
+
+  f3d::mesh_view_t::buffer_t<T> buffer{ static_cast<const T*>(info->ptr),
+    static_cast<size_t>(info->size) };
+  holder.buffers.emplace_back(std::move(info));
+  return buffer;
+}
+
+std::vector<f3d::mesh_view_t::array_t> wrap_arrays(
+  mesh_view_buffers& holder, const py::dict& arrays)
+{
+  std::vector<f3d::mesh_view_t::array_t> result;
+  for (const auto& item : arrays)
+  {
+    f3d::mesh_view_t::array_t array;
+    array.name = py::cast<std::string>(item.first);
+    array.values = wrap_buffer<float>(
+      holder, py::reinterpret_borrow<py::object>(item.second), array.name, &array.components);
+    result.emplace_back(std::move(array));
+  }
+  return result;
+}
+
+// Iterate over the animation frames at a fixed frame rate, the readback of a frame is collected
+// once the next frame has been loaded and rendered, so that they overlap
+struct frame_iterator
+{
+  f3d::engine& engine;
+  double start;
+  double end;
+  double frameRate;
+  bool noBackground;
+  int count;
+  int submitted = 0;
+  double pendingTime = 0.0;
+  std::future<f3d::image> pending;
+
+  bool done() const
+  {
+    return !this->pending.valid() && this->submitted >= this->count;
+  }
+
+  void submit()
+  {
+    // the last frame is the end of the range, see F3DStarter::RenderAnimationFrames
+    this->pendingTime = std::min(this->start + this->submitted / this->frameRate, this->end);
+    this->engine.getScene().loadAnimationTime(this->pendingTime);
+    this->pending = this->engine.getWindow().renderToImageAsync(this->noBackground);
+    this->submitted++;
+  }
+
+  std::pair<double, f3d::image> next()
+  {
+    if (!this->pending.valid())
+    {
+      this->submit();
+    }
+    const double time = this->pendingTime;
+    std::future<f3d::image> current = std::move(this->pending);
+    if (this->submitted < this->count)
+    {
+      this->submit();
+    }
+    return std::make_pair(time, current.get());
+  }
+};
+
 PYBIND11_MODULE(pyf3d, module)
 {
   module.doc() = "f3d library bindings";
 
   // f3d::image
-  py::class_<f3d::image> image(module, "Image");
+  py::class_<f3d::image> image(module, "Image", py::buffer_protocol());
 
   py::enum_<f3d::image::SaveFormat>(image, "SaveFormat")
     .value("PNG", f3d::image::SaveFormat::PNG)
     .value("JPG", f3d::image::SaveFormat::JPG)
     .value("TIF", f3d::image::SaveFormat::TIF)
     .value("BMP", f3d::image::SaveFormat::BMP)
+    .value("EXR", f3d::image::SaveFormat::EXR)
     .export_values();
 
   py::enum_<f3d::image::ChannelType>(image, "ChannelType")
     .value("BYTE", f3d::image::ChannelType::BYTE)
     .value("SHORT", f3d::image::ChannelType::SHORT)
     .value("FLOAT", f3d::image::ChannelType::FLOAT)
+    .value("HALF", f3d::image::ChannelType::HALF)
     .export_values();
 
   auto setImageBytes = [](f3d::image& img, const py::bytes& data)
@@ -121,6 +250,52 @@ PYBIND11_MODULE(pyf3d, module)
     .def(py::init<>())
     .def(py::init<const std::string&>())
     .def(py::init<unsigned int, unsigned int, unsigned int, f3d::image::ChannelType>())
+    .def(py::init(
+           [](py::buffer buffer, unsigned int width, unsigned int height, unsigned int channelCount,
+             f3d::image::ChannelType type)
+           {
+             // wrap a writable contiguous buffer without copy, keeping the python object alive
+             py::buffer_info info = buffer.request(true);
+             size_t typeSize = type == f3d::image::ChannelType::FLOAT ? 4
+               : type == f3d::image::ChannelType::SHORT ||
+                 type == f3d::image::ChannelType::HALF
+               ? 2
+               : 1;
+             size_t expectedSize = static_cast<size_t>(width) * height * channelCount * typeSize;
+             if (static_cast<size_t>(info.size * info.itemsize) != expectedSize)
+             {
+               throw py::value_error();
+             }
+
+             PyObject* owner = buffer.inc_ref().ptr();
+             return f3d::image(width, height, channelCount, type, info.ptr,
+               [owner](void*)
+               {
+                 py::gil_scoped_acquire gil;
+                 Py_DECREF(owner);
+               });
+           }),
+      "Wrap a writable buffer without copy", py::arg("buffer"), py::arg("width"),
+      py::arg("height"), py::arg("channel_count"),
+      py::arg("channel_type") = f3d::image::ChannelType::BYTE)
+    .def_buffer(
+      [](f3d::image& img)
+      {
+        // expose the content without copy as a (height, width, channels) array
+        const py::ssize_t typeSize = img.getChannelTypeSize();
+        const py::ssize_t channels = img.getChannelCount();
+        const std::string format = img.getChannelType() == f3d::image::ChannelType::FLOAT
+          ? py::format_descriptor<float>::format()
+          : img.getChannelType() == f3d::image::ChannelType::SHORT
+          ? py::format_descriptor<uint16_t>::format()
+          : img.getChannelType() == f3d::image::ChannelType::HALF ? std::string("e")
+          : py::format_descriptor<uint8_t>::format();
+        return py::buffer_info(img.getContent(), typeSize, format, 3,
+          { static_cast<py::ssize_t>(img.getHeight()), static_cast<py::ssize_t>(img.getWidth()),
+            channels },
+          { static_cast<py::ssize_t>(img.getWidth()) * channels * typeSize, channels * typeSize,
+            typeSize });
+      })
     .def(py::self == py::self)
     .def(py::self != py::self)
     .def_static("supported_formats", &f3d::image::getSupportedFormats)
@@ -131,12 +306,37 @@ PYBIND11_MODULE(pyf3d, module)
     .def_property_readonly("channel_type_size", &f3d::image::getChannelTypeSize)
     .def_property("content", getImageBytes, setImageBytes)
     .def("compare", &f3d::image::compare)
+    .def(
+      "compare_psnr",
+      [](const f3d::image& img, const f3d::image& reference, double threshold)
+      {
+        double psnr;
+        img.comparePSNR(reference, threshold, psnr);
+        return psnr;
+      },
+      py::arg("reference"), py::arg("threshold") = -std::numeric_limits<double>::infinity())
     .def(
       "save", &f3d::image::save, py::arg("path"), py::arg("format") = f3d::image::SaveFormat::PNG)
     .def("save_buffer", getFileBytes, py::arg("format") = f3d::image::SaveFormat::PNG)
     .def("_repr_png_",
       [&](const f3d::image& img) { return getFileBytes(img, f3d::image::SaveFormat::PNG); })
     .def("to_terminal_text", [](const f3d::image& img) { return img.toTerminalText(); })
+    .def("to_terminal_text",
+      [](const f3d::image& img, const f3d::image& previous)
+      {
+        std::stringstream ss;
+        img.toTerminalText(ss, previous);
+        return ss.str();
+      })
+    .def("to_terminal_graphics",
+      [](const f3d::image& img)
+      {
+        std::stringstream ss;
+        img.toTerminalGraphics(ss);
+        return ss.str();
+      })
+    .def("downsample", &f3d::image::downsample)
+    .def("convert", &f3d::image::convert)
     .def("set_metadata", &f3d::image::setMetadata)
     .def("get_metadata",
       [](const f3d::image& img, const std::string& key)
@@ -198,6 +398,7 @@ PYBIND11_MODULE(pyf3d, module)
     .def("keys", &f3d::options::getNames) // to do `dict(options)`
     .def("toggle", &f3d::options::toggle)
     .def("is_same", &f3d::options::isSame)
+    .def("get_changed_names", &f3d::options::getChangedNames)
     .def("get_closest_option", &f3d::options::getClosestOption)
     .def("copy", &f3d::options::copy);
 
@@ -228,10 +429,22 @@ PYBIND11_MODULE(pyf3d, module)
     .def("remove_command_callback", &f3d::interactor::removeCommandCallback,
       "Remove a command callback")
     .def("trigger_command", &f3d::interactor::triggerCommand, "Trigger a command")
+    .def("trigger_commands", &f3d::interactor::triggerCommands,
+      "Trigger commands and render once")
     .def_static("get_default_interactions_info", &f3d::interactor::getDefaultInteractionsInfo);
 
   // f3d::mesh_t
-  py::class_<f3d::mesh_t>(module, "Mesh")
+  py::class_<f3d::mesh_t> mesh(module, "Mesh");
+
+  py::class_<f3d::mesh_t::array_t>(mesh, "Array")
+    .def(py::init<>())
+    .def(py::init<const std::string&, int, const std::vector<float>&>(), py::arg("name"),
+      py::arg("components"), py::arg("values"))
+    .def_readwrite("name", &f3d::mesh_t::array_t::name)
+    .def_readwrite("components", &f3d::mesh_t::array_t::components)
+    .def_readwrite("values", &f3d::mesh_t::array_t::values);
+
+  mesh //
     .def(py::init<>())
     .def(py::init<const std::vector<float>&, const std::vector<float>&, const std::vector<float>&,
            const std::vector<unsigned int>&, const std::vector<unsigned int>&>(),
@@ -243,7 +456,65 @@ PYBIND11_MODULE(pyf3d, module)
     .def_readwrite("normals", &f3d::mesh_t::normals)
     .def_readwrite("texture_coordinates", &f3d::mesh_t::texture_coordinates)
     .def_readwrite("face_sides", &f3d::mesh_t::face_sides)
-    .def_readwrite("face_indices", &f3d::mesh_t::face_indices);
+    .def_readwrite("face_indices", &f3d::mesh_t::face_indices)
+    .def_readwrite("triangle_indices", &f3d::mesh_t::triangle_indices)
+    .def_readwrite("triangle_indices_16", &f3d::mesh_t::triangle_indices_16)
+    .def_readwrite("colors", &f3d::mesh_t::colors)
+    .def_readwrite("point_data", &f3d::mesh_t::point_data)
+    .def_readwrite("cell_data", &f3d::mesh_t::cell_data);
+
+  // f3d::mesh_view_t
+  py::class_<mesh_view_buffers, std::shared_ptr<mesh_view_buffers>>(module, "MeshView")
+    .def(py::init(
+           [](const py::object& points, const py::object& normals,
+             const py::object& textureCoordinates, const py::object& faceSides,
+             const py::object& faceIndices, const py::object& triangleIndices,
+             const py::object& colors, const py::dict& pointData, const py::dict& cellData)
+           {
+             auto holder = std::make_shared<mesh_view_buffers>();
+             f3d::mesh_view_t& view = holder->view;
+             view.points = wrap_buffer<float>(*holder, points, "points");
+             view.normals = wrap_buffer<float>(*holder, normals, "normals");
+             view.texture_coordinates =
+               wrap_buffer<float>(*holder, textureCoordinates, "texture_coordinates");
+             view.face_sides = wrap_buffer<unsigned int>(*holder, faceSides, "face_sides");
+             view.face_indices = wrap_buffer<unsigned int>(*holder, faceIndices, "face_indices");
+             if (!triangleIndices.is_none() &&
+               py::buffer(triangleIndices).request().itemsize == sizeof(uint16_t))
+             {
+               view.triangle_indices_16 =
+                 wrap_buffer<uint16_t>(*holder, triangleIndices, "triangle_indices");
+             }
+             else
+             {
+               view.triangle_indices =
+                 wrap_buffer<unsigned int>(*holder, triangleIndices, "triangle_indices");
+             }
+             view.colors = wrap_buffer<unsigned char>(*holder, colors, "colors");
+             view.point_data = wrap_arrays(*holder, pointData);
+             view.cell_data = wrap_arrays(*holder, cellData);
+             return holder;
+           }),
+      "Wrap buffer-protocol objects without copy, they must not be modified while used by a scene",
+      py::arg("points"), py::arg("normals") = py::none(),
+      py::arg("texture_coordinates") = py::none(), py::arg("face_sides") = py::none(),
+      py::arg("face_indices") = py::none(), py::arg("triangle_indices") = py::none(),
+      py::arg("colors") = py::none(), py::arg("point_data") = py::dict(),
+      py::arg("cell_data") = py::dict())
+    .def("is_valid", [](const mesh_view_buffers& holder) { return holder.view.isValid(); });
+
+  // the scene keeps the wrapped buffers alive until it releases them, possibly from another thread
+  auto toMeshView = [](const std::shared_ptr<mesh_view_buffers>& holder)
+  {
+    f3d::mesh_view_t view = holder->view;
+    auto owner = new std::shared_ptr<mesh_view_buffers>(holder);
+    view.deleter = [owner]()
+    {
+      py::gil_scoped_acquire gil;
+      delete owner;
+    };
+    return view;
+  };
 
   // f3d::scene
   py::class_<f3d::scene, std::unique_ptr<f3d::scene, py::nodelete>> scene(module, "Scene");
@@ -251,13 +522,88 @@ PYBIND11_MODULE(pyf3d, module)
     .def("supports", &f3d::scene::supports)
     .def("clear", &f3d::scene::clear)
     .def("add", py::overload_cast<const std::filesystem::path&>(&f3d::scene::add),
-      "Add a file the scene", py::arg("file_path"))
+      "Add a file the scene", py::arg("file_path"), py::call_guard<py::gil_scoped_release>())
     .def("add", py::overload_cast<const std::vector<std::filesystem::path>&>(&f3d::scene::add),
-      "Add multiple filepaths to the scene", py::arg("file_path_vector"))
+      "Add multiple filepaths to the scene", py::arg("file_path_vector"),
+      py::call_guard<py::gil_scoped_release>())
     .def("add", py::overload_cast<const std::vector<std::string>&>(&f3d::scene::add),
-      "Add multiple filenames to the scene", py::arg("file_name_vector"))
+      "Add multiple filenames to the scene", py::arg("file_name_vector"),
+      py::call_guard<py::gil_scoped_release>())
     .def("add", py::overload_cast<const f3d::mesh_t&>(&f3d::scene::add),
-      "Add a surfacic mesh from memory into the scene", py::arg("mesh"));
+      "Add a surfacic mesh from memory into the scene", py::arg("mesh"),
+      py::call_guard<py::gil_scoped_release>())
+    .def(
+      "add",
+      [toMeshView](f3d::scene& sce, const std::shared_ptr<mesh_view_buffers>& holder)
+        -> f3d::scene&
+      {
+        f3d::mesh_view_t view = toMeshView(holder);
+        py::gil_scoped_release release;
+        return sce.add(view);
+      },
+      "Add a surfacic mesh from buffers into the scene without copy", py::arg("mesh"),
+      py::return_value_policy::reference)
+    .def(
+      "add_buffer",
+      [](f3d::scene& sce, py::buffer data, const std::string& format) -> f3d::scene&
+      {
+        const py::buffer_info info = data.request();
+        py::gil_scoped_release release;
+        return sce.add(static_cast<const std::byte*>(info.ptr),
+          static_cast<size_t>(info.size * info.itemsize), format);
+      },
+      "Add a file from a buffer in memory, of the format of the provided extension",
+      py::arg("data"), py::arg("format"), py::return_value_policy::reference)
+    .def(
+      "update_mesh",
+      [toMeshView](f3d::scene& sce, size_t meshIndex,
+        const std::shared_ptr<mesh_view_buffers>& holder) -> f3d::scene&
+      {
+        f3d::mesh_view_t view = toMeshView(holder);
+        py::gil_scoped_release release;
+        return sce.updateMesh(meshIndex, view);
+      },
+      "Update a surfacic mesh previously added from memory without copy", py::arg("mesh_index"),
+      py::arg("mesh"), py::return_value_policy::reference)
+    .def("reload", &f3d::scene::reload, "Reload previously added filepaths",
+      py::arg("file_path_vector"))
+    .def("preload", &f3d::scene::preload,
+      "Read filepaths in the background to add them later without reading them again",
+      py::arg("file_path_vector"), py::arg("memory_budget"))
+    .def("replace", &f3d::scene::replace,
+      "Replace the files of the scene, keeping the current ones until the new ones are read",
+      py::arg("file_path_vector"), py::call_guard<py::gil_scoped_release>())
+    .def("load_animation_time", &f3d::scene::loadAnimationTime,
+      "Load the scene at the provided animation time", py::arg("time_value"))
+    .def("animation_time_range", &f3d::scene::animationTimeRange,
+      "Get the time range of the enabled animations")
+    .def("get_memory_usage", &f3d::scene::getMemoryUsage,
+      "Get the memory used by the files added to the scene")
+    .def("save", &f3d::scene::save, "Save the surfaces of the scene to a binary glTF file",
+      py::arg("file_path"), py::call_guard<py::gil_scoped_release>())
+    .def_static("query", &f3d::scene::query,
+      "Read a file and return information about its content without rendering structures",
+      py::arg("file_path"), py::call_guard<py::gil_scoped_release>());
+
+  py::class_<f3d::scene::memory_usage_t>(scene, "MemoryUsage")
+    .def_readonly("cpu", &f3d::scene::memory_usage_t::cpu)
+    .def_readonly("gpu", &f3d::scene::memory_usage_t::gpu);
+
+  py::class_<f3d::scene::info_t> sceneInfo(scene, "Info");
+  sceneInfo //
+    .def_readonly("bounds", &f3d::scene::info_t::bounds)
+    .def_readonly("points", &f3d::scene::info_t::points)
+    .def_readonly("cells", &f3d::scene::info_t::cells)
+    .def_readonly("arrays", &f3d::scene::info_t::arrays)
+    .def_readonly("animations", &f3d::scene::info_t::animations)
+    .def_readonly("animation_time_range", &f3d::scene::info_t::animationTimeRange)
+    .def_readonly("cameras", &f3d::scene::info_t::cameras);
+
+  py::class_<f3d::scene::info_t::array_t>(sceneInfo, "Array")
+    .def_readonly("name", &f3d::scene::info_t::array_t::name)
+    .def_readonly("location", &f3d::scene::info_t::array_t::location)
+    .def_readonly("components", &f3d::scene::info_t::array_t::components)
+    .def_readonly("range", &f3d::scene::info_t::array_t::range);
 
   // f3d::camera
   py::class_<f3d::camera, std::unique_ptr<f3d::camera, py::nodelete>> camera(module, "Camera");
@@ -294,6 +640,13 @@ PYBIND11_MODULE(pyf3d, module)
     .def_readwrite("up", &f3d::camera_state_t::up)
     .def_readwrite("angle", &f3d::camera_state_t::angle);
 
+  py::class_<f3d::aovs_t>(module, "AOVs")
+    .def(py::init<>())
+    .def_readwrite("color", &f3d::aovs_t::color)
+    .def_readwrite("depth", &f3d::aovs_t::depth)
+    .def_readwrite("normal", &f3d::aovs_t::normal)
+    .def_readwrite("index", &f3d::aovs_t::index);
+
   // f3d::window
   py::class_<f3d::window, std::unique_ptr<f3d::window, py::nodelete>> window(module, "Window");
 
@@ -320,9 +673,34 @@ PYBIND11_MODULE(pyf3d, module)
       [](f3d::window& win, int w) { win.setSize(w, win.getHeight()); })
     .def_property("height", &f3d::window::getHeight,
       [](f3d::window& win, int h) { win.setSize(win.getWidth(), h); })
-    .def("render", &f3d::window::render, "Render the window")
-    .def("render_to_image", &f3d::window::renderToImage, "Render the window to an image",
-      py::arg("no_background") = false)
+    .def("render", &f3d::window::render, "Render the window",
+      py::call_guard<py::gil_scoped_release>())
+    .def("render_to_image", py::overload_cast<bool>(&f3d::window::renderToImage),
+      "Render the window to an image", py::arg("no_background") = false,
+      py::call_guard<py::gil_scoped_release>())
+    .def("render_to_image", py::overload_cast<f3d::image&, bool>(&f3d::window::renderToImage),
+      "Render the window into an existing image", py::arg("image"),
+      py::arg("no_background") = false, py::return_value_policy::reference,
+      py::call_guard<py::gil_scoped_release>())
+    .def("render_to_tiled_image", &f3d::window::renderToTiledImage,
+      "Render the window in tiles to an image larger than the window", py::arg("scale"),
+      py::arg("no_background") = false, py::call_guard<py::gil_scoped_release>())
+    .def("render_to_tiled_image_band", &f3d::window::renderToTiledImageBand,
+      "Render a horizontal band of the image rendered in tiles", py::arg("scale"),
+      py::arg("index"), py::arg("count"), py::arg("no_background") = false,
+      py::call_guard<py::gil_scoped_release>())
+    .def("render_to_aovs", &f3d::window::renderToAOVs,
+      "Render the window to the color, depth, normal and actor index images",
+      py::arg("no_background") = false, py::call_guard<py::gil_scoped_release>())
+    .def("render_views", &f3d::window::renderViews,
+      "Render the window from each camera state to a list of images", py::arg("views"),
+      py::arg("no_background") = false, py::call_guard<py::gil_scoped_release>())
+    .def("render_views_to_sprite_sheet", &f3d::window::renderViewsToSpriteSheet,
+      "Render the window from each camera state and pack the images in a single one",
+      py::arg("views"), py::arg("columns"), py::arg("no_background") = false,
+      py::call_guard<py::gil_scoped_release>())
+    .def("set_additional_views", &f3d::window::setAdditionalViews,
+      "Render additional views from each camera state next to the main view", py::arg("views"))
     .def("set_position", &f3d::window::setPosition)
     .def("set_icon", &f3d::window::setIcon,
       "Set the icon of the window using a memory buffer representing a PNG file")
@@ -332,6 +710,21 @@ PYBIND11_MODULE(pyf3d, module)
     .def("get_display_from_world", &f3d::window::getDisplayFromWorld,
       "Get display coordinate point from world coordinate");
 
+  // frame_iterator
+  py::class_<frame_iterator>(module, "FrameIterator")
+    .def("__iter__", [](py::object self) { return self; })
+    .def("__len__", [](const frame_iterator& it) { return it.count; })
+    .def("__next__",
+      [](frame_iterator& it)
+      {
+        if (it.done())
+        {
+          throw py::stop_iteration();
+        }
+        py::gil_scoped_release release;
+        return it.next();
+      });
+
   // f3d::engine
   py::class_<f3d::engine> engine(module, "Engine");
 
@@ -343,7 +736,10 @@ PYBIND11_MODULE(pyf3d, module)
     .def_static(
       "create_wgl", &f3d::engine::createWGL, "Create an engine with an WGL window (Windows only)")
     .def_static("create_egl", &f3d::engine::createEGL,
-      "Create an engine with an EGL window (Windows/Linux only)")
+      "Create an engine with an EGL window (Windows/Linux only)", py::arg("offscreen") = false,
+      py::arg("device_index") = -1)
+    .def_static("get_egl_device_count", &f3d::engine::getEGLDeviceCount,
+      "Get the number of EGL devices, usually one per GPU")
     .def_static("create_osmesa", &f3d::engine::createOSMesa,
       "Create an engine with an OSMesa window (Windows/Linux only)")
     .def_static("create_external_glx", &f3d::engine::createExternalGLX,
@@ -357,6 +753,9 @@ PYBIND11_MODULE(pyf3d, module)
     .def_static("create_external_osmesa", &f3d::engine::createExternalOSMesa,
       "Create an engine with an existing OSMesa context (Windows/Linux only)")
     .def("set_cache_path", &f3d::engine::setCachePath, "Set the cache path directory")
+    .def("precompile_shaders", &f3d::engine::precompileShaders,
+      "Compile the shaders needed to render with the provided options", py::arg("options"),
+      py::return_value_policy::reference, py::call_guard<py::gil_scoped_release>())
     .def_property("options", &f3d::engine::getOptions,
       py::overload_cast<const f3d::options&>(&f3d::engine::setOptions),
       py::return_value_policy::reference)
@@ -364,7 +763,35 @@ PYBIND11_MODULE(pyf3d, module)
     .def_property_readonly("scene", &f3d::engine::getScene, py::return_value_policy::reference)
     .def_property_readonly(
       "interactor", &f3d::engine::getInteractor, py::return_value_policy::reference)
+    .def(
+      "frames",
+      [](f3d::engine& eng, std::optional<double> start, std::optional<double> end,
+        std::optional<double> fps, bool noBackground)
+      {
+        const auto [startTime, endTime] = eng.getScene().animationTimeRange();
+        const double first = start.value_or(startTime);
+        const double last = end.value_or(endTime);
+        const double frameRate = fps.value_or(eng.getOptions().scene.animation.frame_rate);
+        if (last < first)
+        {
+          throw py::value_error("end must not be before start");
+        }
+        if (frameRate <= 0)
+        {
+          throw py::value_error("fps must be positive");
+        }
+        // a small epsilon avoid skipping the last frame because of floating point errors
+        const int count = static_cast<int>(std::floor((last - first) * frameRate + 1e-6)) + 1;
+        return std::make_unique<frame_iterator>(
+          frame_iterator{ eng, first, last, frameRate, noBackground, count });
+      },
+      "Iterate over (time, image) pairs of the animation frames, the next frame is loaded and "
+      "rendered while the current one is read back",
+      py::arg("start") = py::none(), py::arg("end") = py::none(), py::arg("fps") = py::none(),
+      py::arg("no_background") = false, py::keep_alive<0, 1>())
     .def_static("load_plugin", &f3d::engine::loadPlugin, "Load a plugin")
+    .def_static(
+      "declare_plugin", &f3d::engine::declarePlugin, "Declare a plugin without loading it")
     .def_static(
       "autoload_plugins", &f3d::engine::autoloadPlugins, "Automatically load internal plugins")
     .def_static("get_plugins_list", &f3d::engine::getPluginsList)
@@ -396,10 +823,22 @@ PYBIND11_MODULE(pyf3d, module)
   // f3d::log
   py::class_<f3d::log> log(module, "Log");
 
+  // registered before the methods using it as a default argument
+  py::enum_<f3d::log::MetricsFormat>(log, "MetricsFormat")
+    .value("PROMETHEUS", f3d::log::MetricsFormat::PROMETHEUS)
+    .value("JSON", f3d::log::MetricsFormat::JSON);
+
   log //
     .def_static("set_verbose_level", &f3d::log::setVerboseLevel, py::arg("level"),
       py::arg("force_std_err") = false)
     .def_static("set_use_coloring", &f3d::log::setUseColoring)
+    .def_static("is_enabled", &f3d::log::isEnabled, py::arg("level"))
+    .def_static("set_asynchronous", &f3d::log::setAsynchronous, py::arg("async"),
+      py::arg("capacity") = 4096)
+    .def_static("get_number_of_dropped_messages", &f3d::log::getNumberOfDroppedMessages)
+    .def_static("get_metrics", &f3d::log::getMetrics,
+      py::arg("format") = f3d::log::MetricsFormat::PROMETHEUS)
+    .def_static("reset_metrics", &f3d::log::resetMetrics)
     .def_static("print",
       [](f3d::log::VerboseLevel& level, const std::string& message)
       { f3d::log::print(level, message); });
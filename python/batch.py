@@ -0,0 +1,144 @@
+"""
+Batch rendering over a pool of worker processes.
+
+Each worker creates a single engine, optionally on its own EGL device, and keeps it warm
+to render all the jobs it is given, so that the creation of the engine, the loading of the
+plugins and the compilation of the shaders are amortized over the jobs.
+
+```python
+import f3d.batch
+
+jobs = [f3d.batch.Job(file, options={"render.effect.tone_mapping": True}) for file in files]
+for result in f3d.batch.render(jobs, processes=4, devices=[0, 1]):
+    print(result.index, result.error or result.images[0].shape)
+```
+"""
+
+import multiprocessing
+import os
+from dataclasses import dataclass, field
+from typing import Any, Dict, Iterable, Iterator, List, Optional, Sequence, Tuple, Union
+
+__all__ = ["Job", "Result", "render"]
+
+
+@dataclass
+class Job:
+    """
+    A set of files rendered together, with its options, from each of its cameras.
+
+    `cameras` are `(position, focal_point, view_up, view_angle)` tuples, the camera is reset
+    to the bounds of the files when empty. `outputs`, if any, are the image files written for
+    each camera, the images are returned as NumPy arrays otherwise.
+    """
+
+    files: Union[str, os.PathLike, Sequence[Union[str, os.PathLike]]]
+    options: Dict[str, Any] = field(default_factory=dict)
+    cameras: List[Tuple[Sequence[float], Sequence[float], Sequence[float], float]] = field(
+        default_factory=list
+    )
+    outputs: List[Union[str, os.PathLike]] = field(default_factory=list)
+    resolution: Tuple[int, int] = (1000, 600)
+
+
+@dataclass
+class Result:
+    """
+    The result of the job at `index` in the iterable of jobs. `images` contains the rendered
+    images as NumPy arrays, or `outputs` the written files. `error` is set if the job failed.
+    """
+
+    index: int
+    images: List[Any] = field(default_factory=list)
+    outputs: List[str] = field(default_factory=list)
+    error: Optional[str] = None
+
+
+# the engine of the worker process, kept between the jobs
+_engine = None
+
+
+def _init_worker(devices, offscreen):
+    global _engine
+    import f3d
+
+    if devices is not None:
+        _engine = f3d.Engine.create_egl(offscreen, devices.get())
+    else:
+        _engine = f3d.Engine.create(offscreen)
+
+
+def _render_job(indexed_job):
+    import f3d
+
+    index, job = indexed_job
+    result = Result(index)
+    try:
+        cameras = job.cameras or [None]
+        if job.outputs and len(job.outputs) != len(cameras):
+            raise ValueError("a job needs one output per camera")
+
+        # start each job from the default options, the engine is reused
+        _engine.options = f3d.Options()
+        _engine.options.update(job.options)
+        _engine.window.size = job.resolution
+
+        files = job.files
+        if isinstance(files, (str, os.PathLike)):
+            files = [files]
+        _engine.scene.clear()
+        _engine.scene.add([os.fspath(file) for file in files])
+
+        for i, state in enumerate(cameras):
+            camera = _engine.window.camera
+            if state is None:
+                camera.reset_to_bounds()
+            else:
+                camera.state = f3d.CameraState(*state)
+
+            image = _engine.window.render_to_image()
+            if job.outputs:
+                output = os.fspath(job.outputs[i])
+                image.save(output)
+                result.outputs.append(output)
+            else:
+                import numpy
+
+                # the image is freed with the next render
+                result.images.append(numpy.array(image, copy=True))
+    except Exception as error:
+        result.error = str(error) or type(error).__name__
+    return result
+
+
+def render(
+    jobs: Iterable[Job],
+    processes: Optional[int] = None,
+    devices: Optional[Sequence[int]] = None,
+    offscreen: bool = True,
+    ordered: bool = False,
+) -> Iterator[Result]:
+    """
+    Render the jobs over `processes` worker processes, one per CPU by default, and yield their
+    results as soon as they are rendered, or in the order of the jobs if `ordered` is true.
+
+    If `devices` is provided, the workers create EGL engines on these devices in turn,
+    eg. `range(f3d.Engine.get_egl_device_count())` to spread them over all the GPUs.
+    A failing job does not stop the others, its result has an `error`.
+    """
+    if devices is not None and len(devices) == 0:
+        raise ValueError("devices cannot be empty")
+    if processes is None:
+        processes = len(devices) if devices is not None else os.cpu_count() or 1
+
+    # rendering contexts do not survive a fork
+    context = multiprocessing.get_context("spawn")
+    device_queue = None
+    if devices is not None:
+        device_queue = context.Queue()
+        for i in range(processes):
+            device_queue.put(devices[i % len(devices)])
+
+    with context.Pool(processes, _init_worker, (device_queue, offscreen)) as pool:
+        imap = pool.imap if ordered else pool.imap_unordered
+        yield from imap(_render_job, enumerate(jobs))
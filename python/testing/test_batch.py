@@ -0,0 +1,56 @@
+from pathlib import Path
+import pytest
+import tempfile
+
+import f3d
+import f3d.batch
+
+
+def test_batch_outputs():
+    testing_dir = Path(__file__).parent.parent.parent / "testing"
+    output = Path(tempfile.gettempdir())
+
+    jobs = [
+        f3d.batch.Job(
+            f"{testing_dir}/data/cow.vtp",
+            options={"render.show_edges": True},
+            cameras=[
+                ((0, 0, 10), (0, 0, 0), (0, 1, 0), 30),
+                ((10, 0, 0), (0, 0, 0), (0, 1, 0), 30),
+            ],
+            outputs=[output / "TestPythonBatchFront.png", output / "TestPythonBatchSide.png"],
+            resolution=(300, 300),
+        ),
+        f3d.batch.Job(f"{testing_dir}/data/invalid.vtp"),
+    ]
+
+    results = sorted(f3d.batch.render(jobs, processes=1), key=lambda result: result.index)
+    assert len(results) == 2
+
+    assert results[0].error is None
+    assert len(results[0].outputs) == 2
+    assert f3d.Image(results[0].outputs[0]).width == 300
+    assert f3d.Image(results[0].outputs[1]).height == 300
+
+    assert results[1].error is not None
+
+
+def test_batch_arrays():
+    np = pytest.importorskip("numpy")
+    testing_dir = Path(__file__).parent.parent.parent / "testing"
+
+    jobs = [
+        f3d.batch.Job(f"{testing_dir}/data/cow.vtp", resolution=(300, 200)),
+        f3d.batch.Job([f"{testing_dir}/data/dragon.vtu"], resolution=(200, 300)),
+    ]
+
+    results = list(f3d.batch.render(jobs, processes=2, ordered=True))
+    assert [result.index for result in results] == [0, 1]
+    assert results[0].images[0].shape == (200, 300, 3)
+    assert results[1].images[0].shape == (300, 200, 3)
+    assert np.any(results[0].images[0])
+
+
+def test_batch_invalid():
+    with pytest.raises(ValueError):
+        list(f3d.batch.render([], devices=[]))
@@ -1,5 +1,7 @@
+import math
 import os
 from pathlib import Path
+import struct
 import tempfile
 import pytest
 
@@ -45,6 +47,39 @@ def test_set_data(f3d_engine):
     assert img.content == data
 
 
+def test_render_to_external_buffer(f3d_engine):
+    window = f3d_engine.window
+
+    buffer = bytearray(window.width * window.height * 3)
+    img = f3d.Image(buffer, window.width, window.height, 3)
+    window.render_to_image(img)
+    assert bytes(buffer) == window.render_to_image().content
+
+
+def test_buffer_protocol(f3d_engine):
+    img = f3d_engine.window.render_to_image()
+    view = memoryview(img)
+    assert view.shape == (img.height, img.width, img.channel_count)
+    assert view.format == "B"
+    assert view.tobytes() == img.content
+
+    view[0, 0, 0] = 255 - view[0, 0, 0]
+    assert view.tobytes() == img.content
+
+
+def test_half_channels():
+    buffer = bytearray(struct.pack("4f", 0.0, 1.0, -2.5, 0.1))
+    img = f3d.Image(buffer, 2, 2, 1, f3d.Image.ChannelType.FLOAT)
+    half = img.convert(f3d.Image.ChannelType.HALF)
+    assert half.channel_type == f3d.Image.ChannelType.HALF
+    assert half.channel_type_size == 2
+
+    view = memoryview(half)
+    assert view.format == "e"
+    rounded = struct.unpack("e", struct.pack("e", 0.1))[0]
+    assert view.tolist() == [[[0.0], [1.0]], [[-2.5], [rounded]]]
+
+
 def test_set_wrong_data(f3d_engine):
     img = f3d_engine.window.render_to_image()
     with pytest.raises(ValueError):
@@ -103,3 +138,18 @@ def test_metadata():
         image.get_metadata("baz")
 
     assert set(image.all_metadata()) == set(["foo", "hello"])
+
+
+def test_compare_psnr():
+    byte = f3d.Image.ChannelType.BYTE
+    img = f3d.Image(4, 4, 1, byte)
+    img.content = bytes(16)
+    reference = f3d.Image(4, 4, 1, byte)
+    reference.content = bytes(15) + bytes([255])
+
+    assert img.compare_psnr(img) == float("inf")
+    assert img.compare_psnr(reference) == pytest.approx(10 * math.log10(16))
+
+    # the summation stops once the PSNR is lower than the threshold, giving an upper bound of it
+    assert img.compare_psnr(reference, 50) < 50
+    assert img.compare_psnr(f3d.Image(4, 4, 3, byte)) == 0
@@ -18,3 +18,14 @@ def test_command(capfd):
     inter.remove_command_callback("my_cmd")
     out, err = capfd.readouterr()
     assert out == "['arg1', 'arg2']\n"
+
+
+def test_commands(capfd):
+    engine = f3d.Engine.create(True)
+    inter = engine.interactor
+    inter.add_command_callback("my_cmd", callback_fn)
+    assert inter.trigger_commands(["my_cmd arg1", "my_cmd arg2"])
+    assert not inter.trigger_commands(["my_cmd arg1", "my_cmd 'arg2"])
+    inter.remove_command_callback("my_cmd")
+    out, err = capfd.readouterr()
+    assert out == "['arg1']\n['arg2']\n"
@@ -37,6 +37,39 @@ def test_coloring():
     )
 
 
+def test_is_enabled():
+    from f3d import Log
+
+    Log.set_verbose_level(Log.WARN)
+    assert not Log.is_enabled(Log.INFO)
+    assert Log.is_enabled(Log.ERROR)
+    assert not Log.is_enabled(Log.QUIET)
+    Log.set_verbose_level(Log.INFO)
+
+
+def test_asynchronous():
+    assert (
+        run_python(
+            "from f3d import Log",
+            "Log.set_use_coloring(False)",
+            "Log.set_asynchronous(True)",
+            "Log.print(Log.INFO, 'info1')",
+            "Log.print(Log.INFO, 'info2')",
+            "Log.set_asynchronous(False)",
+            "print(Log.get_number_of_dropped_messages())",
+        )
+        == "info1\ninfo2\n0\n"
+    )
+
+
+def test_metrics():
+    from f3d import Log
+
+    Log.reset_metrics()
+    assert Log.get_metrics() == ""
+    assert Log.get_metrics(Log.MetricsFormat.JSON) == "{}"
+
+
 def run_python(*statements: str):
     return subprocess.check_output(
         [sys.executable, "-c", "; ".join(statements)],
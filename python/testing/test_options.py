@@ -134,6 +134,15 @@ def test_is_same():
     assert not options2.is_same(options1, "interactor.axis")
 
 
+def test_get_changed_names():
+    options1 = f3d.Options()
+    options2 = f3d.Options()
+    assert options2.get_changed_names(options1) == []
+    options1["interactor.axis"] = True
+    options2["interactor.axis"] = False
+    assert options2.get_changed_names(options1) == ["interactor.axis"]
+
+
 def test_is_copy():
     options1 = f3d.Options()
     options2 = f3d.Options()
@@ -1,3 +1,4 @@
+from array import array
 from pathlib import Path
 import pytest
 import tempfile
@@ -29,6 +30,55 @@ def test_scene_memory():
     assert img.compare(f3d.Image(reference), 0.05, error)
 
 
+def test_scene_memory_triangles():
+    testing_dir = Path(__file__).parent.parent.parent / "testing"
+    reference = f"{testing_dir}/baselines/TestPythonSceneMemory.png"
+    output = tempfile.gettempdir() + "/TestPythonSceneMemoryTriangles.png"
+
+    engine = f3d.Engine.create(True)
+    engine.window.size = 300, 300
+
+    mesh = f3d.Mesh(points=[0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 1.0, 0.0, 0.0])
+    mesh.triangle_indices_16 = [0, 1, 2]
+    mesh.point_data = [f3d.Mesh.Array("temperature", 1, [1.0, 2.0, 3.0])]
+    engine.scene.add(mesh)
+
+    img = engine.window.render_to_image()
+    img.save(output)
+
+    error = 0.0
+
+    assert img.compare(f3d.Image(reference), 0.05, error)
+
+
+def test_scene_memory_view():
+    testing_dir = Path(__file__).parent.parent.parent / "testing"
+    reference = f"{testing_dir}/baselines/TestPythonSceneMemory.png"
+    output = tempfile.gettempdir() + "/TestPythonSceneMemoryView.png"
+
+    engine = f3d.Engine.create(True)
+    engine.window.size = 300, 300
+
+    points = array("f", [0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 1.0, 0.0, 0.0])
+    mesh = f3d.MeshView(
+        points=points,
+        triangle_indices=array("I", [0, 1, 2]),
+        point_data={"temperature": array("f", [1.0, 2.0, 3.0])},
+    )
+    engine.scene.add(mesh)
+    engine.scene.update_mesh(0, mesh)
+
+    img = engine.window.render_to_image()
+    img.save(output)
+
+    error = 0.0
+
+    assert img.compare(f3d.Image(reference), 0.05, error)
+
+    with pytest.raises(TypeError):
+        f3d.MeshView(points=array("d", points))
+
+
 def test_scene():
     testing_dir = Path(__file__).parent.parent.parent / "testing"
     world = f"{testing_dir}/data/world.obj"
@@ -53,3 +103,33 @@ def test_scene():
     error = 0.0
 
     assert img.compare(f3d.Image(reference), 0.05, error)
+
+
+def test_scene_frames():
+    testing_dir = Path(__file__).parent.parent.parent / "testing"
+
+    engine = f3d.Engine.create(True)
+    engine.window.size = 300, 300
+    engine.scene.add(f"{testing_dir}/data/BoxAnimated.gltf")
+    start, end = engine.scene.animation_time_range()
+
+    frames = engine.frames(fps=2)
+    assert len(frames) == int((end - start) * 2) + 1
+
+    times = []
+    for time, img in frames:
+        assert img.width == 300 and img.height == 300
+        times.append(time)
+    assert len(times) == len(frames)
+    assert times[0] == start
+    assert times == sorted(times) and times[-1] <= end
+
+    # the frames are the ones rendered when loading each time
+    last_time, last_img = list(engine.frames(start=1.0, end=1.5, fps=2))[-1]
+    assert last_time == 1.5
+    engine.scene.load_animation_time(1.5)
+    error = 0.0
+    assert last_img.compare(engine.window.render_to_image(), 0.05, error)
+
+    with pytest.raises(ValueError):
+        engine.frames(fps=0)
@@ -0,0 +1,941 @@
+/**
+ * f3d-thumbnail-server keeps a pool of warm f3d processes running in batch mode, so that
+ * thumbnails are rendered without starting a process, loading plugins and creating a graphic
+ * context for each of them.
+ *
+ * Requests are received on a named pipe on Windows and on a unix domain socket elsewhere,
+ * one JSON object per line: {"input": "<file>", "size": <pixels>}, and are answered with
+ * {"status": "success", "output": "<png file>"} or {"status": "failure", "error": "<message>"}.
+ * Thumbnails are cached on disk, keyed on the input path, modification time and size,
+ * the thumbnail size and the options of the workers.
+ *
+ * With --request, a single request is sent to the server and the thumbnail is copied to the
+ * provided output, which is suitable for freedesktop thumbnailers. The server is started in the
+ * background if it is not running yet.
+ */
+
+#include "F3DSystemTools.h"
+
+#include <log.h>
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <fcntl.h>
+#include <io.h>
+#include <windows.h>
+#else
+#include <csignal>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace
+{
+constexpr const char* USAGE =
+  "Usage: f3d-thumbnail-server [--endpoint=<name>] [--cache=<dir>] [--workers=<count>] "
+  "[--idle-timeout=<seconds>] [--timeout=<seconds>] [--worker=<executable>] "
+  "[--request <input> <output> <size>]";
+
+struct Settings
+{
+  std::string Endpoint;
+  fs::path Cache;
+
+  // The f3d executable next to the server if empty
+  fs::path Worker;
+  int Workers = 0;
+  int IdleTimeout = 300;
+  int Timeout = 8;
+};
+
+// Options of the workers, part of the cache key
+const std::vector<std::string> WORKER_ARGS = { "--batch=-", "--config=thumbnail",
+  "--verbose=quiet" };
+
+//----------------------------------------------------------------------------
+std::string DefaultEndpoint()
+{
+#if defined(_WIN32)
+  const char* user = std::getenv("USERNAME");
+  return std::string("\\\\.\\pipe\\f3d-thumbnail-") + (user ? user : "");
+#else
+  const char* runtimeDir = std::getenv("XDG_RUNTIME_DIR");
+  if (runtimeDir && runtimeDir[0] != '\0')
+  {
+    return (fs::path(runtimeDir) / "f3d-thumbnail.sock").string();
+  }
+  return (fs::temp_directory_path() / ("f3d-thumbnail-" + std::to_string(getuid()) + ".sock"))
+    .string();
+#endif
+}
+
+//----------------------------------------------------------------------------
+fs::path DefaultCache()
+{
+#if defined(_WIN32)
+  const char* localAppData = std::getenv("LOCALAPPDATA");
+  fs::path dir = localAppData ? fs::path(localAppData) : fs::temp_directory_path();
+#else
+  const char* xdgCacheHome = std::getenv("XDG_CACHE_HOME");
+  const char* home = std::getenv("HOME");
+  fs::path dir = xdgCacheHome && xdgCacheHome[0] != '\0' ? fs::path(xdgCacheHome)
+    : home                                               ? fs::path(home) / ".cache"
+                                                         : fs::temp_directory_path();
+#endif
+  return dir / "f3d" / "thumbnails";
+}
+
+//----------------------------------------------------------------------------
+/**
+ * Return the cache file of a thumbnail, or an empty path if the input cannot be read
+ */
+fs::path GetCachePath(const fs::path& cache, const fs::path& input, int size)
+{
+  std::error_code ec;
+  fs::path absolute = fs::absolute(input, ec);
+  auto mtime = fs::last_write_time(input, ec);
+  auto fileSize = fs::file_size(input, ec);
+  if (ec)
+  {
+    return {};
+  }
+
+  std::string key = absolute.string() + "|" +
+    std::to_string(mtime.time_since_epoch().count()) + "|" + std::to_string(fileSize) + "|" +
+    std::to_string(size);
+  for (const std::string& arg : ::WORKER_ARGS)
+  {
+    key += "|" + arg;
+  }
+
+  std::stringstream name;
+  name << std::hex << std::setw(16) << std::setfill('0') << std::hash<std::string>()(key);
+  return cache / (name.str() + ".png");
+}
+
+//----------------------------------------------------------------------------
+/**
+ * Read a line from a file, without the line ending, or nothing at the end of the file
+ */
+std::optional<std::string> ReadLine(FILE* file)
+{
+  std::string line;
+  int c;
+  while ((c = std::fgetc(file)) != EOF)
+  {
+    if (c == '\n')
+    {
+      if (!line.empty() && line.back() == '\r')
+      {
+        line.pop_back();
+      }
+      return line;
+    }
+    line += static_cast<char>(c);
+  }
+  return std::nullopt;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * A f3d process rendering the jobs written on its standard input
+ */
+class Worker
+{
+public:
+  explicit Worker(fs::path executable)
+    : Executable(std::move(executable))
+  {
+  }
+
+  ~Worker()
+  {
+    this->Stop();
+  }
+
+  Worker(const Worker&) = delete;
+  Worker& operator=(const Worker&) = delete;
+
+  bool IsRunning() const
+  {
+    return this->In != nullptr;
+  }
+
+  /**
+   * Start the process, no other process must be started at the same time
+   */
+  bool Start()
+  {
+#if defined(_WIN32)
+    SECURITY_ATTRIBUTES sa = { sizeof(SECURITY_ATTRIBUTES), nullptr, TRUE };
+    HANDLE inRead, inWrite, outRead, outWrite;
+    if (!CreatePipe(&inRead, &inWrite, &sa, 0))
+    {
+      return false;
+    }
+    if (!CreatePipe(&outRead, &outWrite, &sa, 0))
+    {
+      CloseHandle(inRead);
+      CloseHandle(inWrite);
+      return false;
+    }
+    SetHandleInformation(inWrite, HANDLE_FLAG_INHERIT, 0);
+    SetHandleInformation(outRead, HANDLE_FLAG_INHERIT, 0);
+
+    std::wstring command = L"\"" + this->Executable.wstring() + L"\"";
+    for (const std::string& arg : ::WORKER_ARGS)
+    {
+      command += L" " + fs::path(arg).wstring();
+    }
+
+    STARTUPINFOW si = {};
+    si.cb = sizeof(STARTUPINFOW);
+    si.dwFlags = STARTF_USESTDHANDLES;
+    si.hStdInput = inRead;
+    si.hStdOutput = outWrite;
+    PROCESS_INFORMATION pi = {};
+    BOOL started = CreateProcessW(this->Executable.wstring().c_str(), command.data(), nullptr,
+      nullptr, TRUE, CREATE_NO_WINDOW, nullptr, nullptr, &si, &pi);
+    CloseHandle(inRead);
+    CloseHandle(outWrite);
+    if (!started)
+    {
+      CloseHandle(inWrite);
+      CloseHandle(outRead);
+      return false;
+    }
+    CloseHandle(pi.hThread);
+    this->Process = pi.hProcess;
+    this->In = _fdopen(_open_osfhandle(reinterpret_cast<intptr_t>(inWrite), 0), "wb");
+    this->Out = _fdopen(_open_osfhandle(reinterpret_cast<intptr_t>(outRead), _O_RDONLY), "rb");
+#else
+    int in[2];
+    int out[2];
+    if (pipe(in) != 0)
+    {
+      return false;
+    }
+    if (pipe(out) != 0)
+    {
+      close(in[0]);
+      close(in[1]);
+      return false;
+    }
+
+    // The other workers must not inherit the ends of the pipes of this one
+    fcntl(in[1], F_SETFD, FD_CLOEXEC);
+    fcntl(out[0], F_SETFD, FD_CLOEXEC);
+
+    // Nothing can be allocated after fork
+    std::string executable = this->Executable.string();
+    std::vector<char*> argv = { executable.data() };
+    std::vector<std::string> args = ::WORKER_ARGS;
+    for (std::string& arg : args)
+    {
+      argv.emplace_back(arg.data());
+    }
+    argv.emplace_back(nullptr);
+
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+      dup2(in[0], STDIN_FILENO);
+      dup2(out[1], STDOUT_FILENO);
+      close(in[0]);
+      close(in[1]);
+      close(out[0]);
+      close(out[1]);
+      execv(argv[0], argv.data());
+      _exit(EXIT_FAILURE);
+    }
+    close(in[0]);
+    close(out[1]);
+    if (pid < 0)
+    {
+      close(in[1]);
+      close(out[0]);
+      return false;
+    }
+    this->Pid = pid;
+    this->In = fdopen(in[1], "w");
+    this->Out = fdopen(out[0], "r");
+#endif
+    return true;
+  }
+
+  /**
+   * Close the standard input of the process, which makes it exit, and wait for it
+   */
+  void Stop()
+  {
+    if (!this->IsRunning())
+    {
+      return;
+    }
+    std::fclose(this->In);
+    std::fclose(this->Out);
+    this->In = nullptr;
+    this->Out = nullptr;
+#if defined(_WIN32)
+    if (WaitForSingleObject(this->Process, 5000) != WAIT_OBJECT_0)
+    {
+      TerminateProcess(this->Process, EXIT_FAILURE);
+    }
+    CloseHandle(this->Process);
+#else
+    waitpid(this->Pid, nullptr, 0);
+#endif
+  }
+
+  /**
+   * Send a job to the process and return its result, or nothing if the process failed or did not
+   * answer in time, in which case it is killed and started again by the next job
+   */
+  std::optional<std::string> Run(const std::string& job, std::chrono::seconds timeout)
+  {
+    if (std::fputs((job + "\n").c_str(), this->In) == EOF || std::fflush(this->In) != 0)
+    {
+      this->Stop();
+      return std::nullopt;
+    }
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool done = false;
+    std::thread watchdog(
+      [&]()
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (!cv.wait_for(lock, timeout, [&]() { return done; }))
+        {
+          this->Kill();
+        }
+      });
+
+    std::optional<std::string> result = ::ReadLine(this->Out);
+    {
+      const std::lock_guard<std::mutex> lock(mutex);
+      done = true;
+    }
+    cv.notify_one();
+    watchdog.join();
+
+    if (!result)
+    {
+      this->Stop();
+    }
+    return result;
+  }
+
+private:
+  void Kill()
+  {
+#if defined(_WIN32)
+    TerminateProcess(this->Process, EXIT_FAILURE);
+#else
+    kill(this->Pid, SIGKILL);
+#endif
+  }
+
+  fs::path Executable;
+  FILE* In = nullptr;
+  FILE* Out = nullptr;
+#if defined(_WIN32)
+  HANDLE Process = nullptr;
+#else
+  pid_t Pid = -1;
+#endif
+};
+
+//----------------------------------------------------------------------------
+/**
+ * Workers shared between the connections, each job uses the first available one
+ */
+class WorkerPool
+{
+public:
+  WorkerPool(const fs::path& executable, int count)
+  {
+    for (int i = 0; i < count; i++)
+    {
+      this->Workers.emplace_back(std::make_unique<Worker>(executable));
+      this->Available.emplace_back(this->Workers.back().get());
+    }
+
+    // Start all the workers now so that the first thumbnails are rendered by warm processes
+    for (const auto& worker : this->Workers)
+    {
+      worker->Start();
+    }
+  }
+
+  std::optional<std::string> Run(const std::string& job, std::chrono::seconds timeout)
+  {
+    Worker* worker = nullptr;
+    {
+      std::unique_lock<std::mutex> lock(this->Mutex);
+      this->AvailableCondition.wait(lock, [&]() { return !this->Available.empty(); });
+      worker = this->Available.back();
+      this->Available.pop_back();
+    }
+
+    std::optional<std::string> result;
+    bool running = worker->IsRunning();
+    if (!running)
+    {
+      const std::lock_guard<std::mutex> lock(this->StartMutex);
+      running = worker->Start();
+    }
+    if (running)
+    {
+      result = worker->Run(job, timeout);
+    }
+
+    {
+      const std::lock_guard<std::mutex> lock(this->Mutex);
+      this->Available.emplace_back(worker);
+    }
+    this->AvailableCondition.notify_one();
+    return result;
+  }
+
+private:
+  std::vector<std::unique_ptr<Worker>> Workers;
+  std::vector<Worker*> Available;
+  std::mutex Mutex;
+  std::condition_variable AvailableCondition;
+
+  // Processes must be started one at a time so they do not inherit the pipes of each other,
+  // as the pipes are inheritable until they are started on Windows
+  std::mutex StartMutex;
+};
+
+//----------------------------------------------------------------------------
+/**
+ * Answer a request, rendering the thumbnail with a worker if it is not cached
+ */
+nlohmann::json HandleRequest(const std::string& line, const Settings& settings, WorkerPool& pool)
+{
+  nlohmann::json request = nlohmann::json::parse(line, nullptr, false);
+  if (!request.is_object() || !request.contains("input") || !request["input"].is_string() ||
+    !request.contains("size") || !request["size"].is_number_integer())
+  {
+    return { { "status", "failure" }, { "error", "invalid request" } };
+  }
+
+  fs::path input = fs::u8path(request["input"].get<std::string>());
+  int size = request["size"].get<int>();
+  fs::path cachePath = ::GetCachePath(settings.Cache, input, size);
+  if (cachePath.empty() || size <= 0)
+  {
+    return { { "status", "failure" }, { "error", "cannot read " + input.u8string() } };
+  }
+
+  std::error_code ec;
+  if (!fs::exists(cachePath, ec))
+  {
+    // Render in a temporary file so that an incomplete thumbnail is never read
+    static std::atomic<int> jobIndex = 0;
+    fs::path tmpPath = cachePath;
+    tmpPath.replace_filename(
+      cachePath.stem().string() + "-" + std::to_string(jobIndex++) + ".tmp.png");
+
+    nlohmann::json job = { { "input", input.u8string() }, { "output", tmpPath.u8string() },
+      { "resolution", std::to_string(size) + "," + std::to_string(size) } };
+    std::optional<std::string> resultLine =
+      pool.Run(job.dump(), std::chrono::seconds(settings.Timeout));
+    nlohmann::json result =
+      resultLine ? nlohmann::json::parse(*resultLine, nullptr, false) : nlohmann::json();
+    if (!result.is_object() || result.value("status", "") != "success")
+    {
+      fs::remove(tmpPath, ec);
+      std::string error = result.is_object() ? result.value("error", "") : "";
+      return { { "status", "failure" },
+        { "error", error.empty() ? "cannot render " + input.u8string() : error } };
+    }
+    fs::rename(tmpPath, cachePath, ec);
+    if (ec)
+    {
+      fs::remove(tmpPath, ec);
+      return { { "status", "failure" }, { "error", "cannot write the thumbnail cache" } };
+    }
+  }
+  return { { "status", "success" }, { "output", cachePath.u8string() } };
+}
+
+#if defined(_WIN32)
+using Connection = HANDLE;
+constexpr Connection INVALID_CONNECTION = INVALID_HANDLE_VALUE;
+#else
+using Connection = int;
+constexpr Connection INVALID_CONNECTION = -1;
+#endif
+
+//----------------------------------------------------------------------------
+void CloseConnection(Connection connection)
+{
+#if defined(_WIN32)
+  CloseHandle(connection);
+#else
+  close(connection);
+#endif
+}
+
+//----------------------------------------------------------------------------
+std::optional<std::string> ReceiveLine(Connection connection)
+{
+  std::string line;
+  char c;
+  while (true)
+  {
+#if defined(_WIN32)
+    DWORD read = 0;
+    if (!ReadFile(connection, &c, 1, &read, nullptr) || read != 1)
+    {
+      return std::nullopt;
+    }
+#else
+    if (recv(connection, &c, 1, 0) != 1)
+    {
+      return std::nullopt;
+    }
+#endif
+    if (c == '\n')
+    {
+      return line;
+    }
+    line += c;
+  }
+}
+
+//----------------------------------------------------------------------------
+bool SendLine(Connection connection, const std::string& line)
+{
+  std::string data = line + "\n";
+#if defined(_WIN32)
+  DWORD written = 0;
+  return WriteFile(connection, data.data(), static_cast<DWORD>(data.size()), &written, nullptr) &&
+    written == data.size();
+#else
+  return send(connection, data.data(), data.size(), 0) == static_cast<ssize_t>(data.size());
+#endif
+}
+
+//----------------------------------------------------------------------------
+Connection Connect(const std::string& endpoint)
+{
+#if defined(_WIN32)
+  std::wstring name = fs::u8path(endpoint).wstring();
+  return CreateFileW(name.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, OPEN_EXISTING, 0,
+    nullptr);
+#else
+  sockaddr_un address = {};
+  address.sun_family = AF_UNIX;
+  if (endpoint.size() >= sizeof(address.sun_path))
+  {
+    return INVALID_CONNECTION;
+  }
+  endpoint.copy(address.sun_path, endpoint.size());
+
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd >= 0 && connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+  {
+    close(fd);
+    fd = INVALID_CONNECTION;
+  }
+  return fd;
+#endif
+}
+
+//----------------------------------------------------------------------------
+/**
+ * Accept connections until the server is idle for too long, each one is handled by its own thread
+ */
+int RunServer(const Settings& settings)
+{
+  fs::path executable = settings.Worker;
+  if (executable.empty())
+  {
+    executable = F3DSystemTools::GetApplicationPath().parent_path() /
+#if defined(_WIN32)
+      "f3d.exe";
+#else
+      "f3d";
+#endif
+  }
+
+  std::error_code ec;
+  fs::create_directories(settings.Cache, ec);
+
+#if defined(_WIN32)
+  std::wstring name = fs::u8path(settings.Endpoint).wstring();
+  const auto createPipe = [&]()
+  {
+    return CreateNamedPipeW(name.c_str(), PIPE_ACCESS_DUPLEX,
+      PIPE_TYPE_BYTE | PIPE_READMODE_BYTE | PIPE_WAIT | PIPE_REJECT_REMOTE_CLIENTS,
+      PIPE_UNLIMITED_INSTANCES, 4096, 4096, 0, nullptr);
+  };
+
+  // The first instance is created before starting the workers to detect a running server
+  HANDLE pipe = CreateNamedPipeW(name.c_str(),
+    PIPE_ACCESS_DUPLEX | FILE_FLAG_FIRST_PIPE_INSTANCE,
+    PIPE_TYPE_BYTE | PIPE_READMODE_BYTE | PIPE_WAIT | PIPE_REJECT_REMOTE_CLIENTS,
+    PIPE_UNLIMITED_INSTANCES, 4096, 4096, 0, nullptr);
+  if (pipe == INVALID_HANDLE_VALUE)
+  {
+    f3d::log::error("Cannot create the pipe ", settings.Endpoint, ", is a server already running?");
+    return EXIT_FAILURE;
+  }
+#else
+  // Writing to a worker or a client that exited must not terminate the server
+  std::signal(SIGPIPE, SIG_IGN);
+
+  if (::Connect(settings.Endpoint) != INVALID_CONNECTION)
+  {
+    f3d::log::error("A server is already running on ", settings.Endpoint);
+    return EXIT_FAILURE;
+  }
+
+  sockaddr_un address = {};
+  address.sun_family = AF_UNIX;
+  if (settings.Endpoint.size() >= sizeof(address.sun_path))
+  {
+    f3d::log::error("The socket path is too long: ", settings.Endpoint);
+    return EXIT_FAILURE;
+  }
+  settings.Endpoint.copy(address.sun_path, settings.Endpoint.size());
+  unlink(settings.Endpoint.c_str());
+
+  int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+  fcntl(listener, F_SETFD, FD_CLOEXEC);
+  if (listener < 0 || bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+    listen(listener, SOMAXCONN) != 0)
+  {
+    f3d::log::error("Cannot listen on ", settings.Endpoint);
+    return EXIT_FAILURE;
+  }
+#endif
+
+  int workers = settings.Workers > 0
+    ? settings.Workers
+    : static_cast<int>(std::clamp(std::thread::hardware_concurrency() / 2, 1u, 4u));
+  WorkerPool pool(executable, workers);
+
+  // Stop accepting connections once the server has been idle for too long
+  std::atomic<int> activeConnections = 0;
+  std::atomic<std::chrono::steady_clock::rep> lastActivity =
+    std::chrono::steady_clock::now().time_since_epoch().count();
+  std::atomic<bool> stopping = false;
+  std::thread idleWatcher(
+    [&]()
+    {
+      const auto idleTimeout = std::chrono::seconds(settings.IdleTimeout);
+      while (settings.IdleTimeout > 0)
+      {
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+        auto last = std::chrono::steady_clock::time_point(
+          std::chrono::steady_clock::duration(lastActivity.load()));
+        if (activeConnections == 0 && std::chrono::steady_clock::now() - last > idleTimeout)
+        {
+          // Wake up the blocking accept
+          stopping = true;
+#if defined(_WIN32)
+          HANDLE wake = CreateFileW(
+            name.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, OPEN_EXISTING, 0, nullptr);
+          if (wake != INVALID_HANDLE_VALUE)
+          {
+            CloseHandle(wake);
+          }
+#else
+          shutdown(listener, SHUT_RDWR);
+#endif
+          return;
+        }
+      }
+    });
+
+  const auto handleConnection = [&](Connection connection)
+  {
+    while (std::optional<std::string> line = ::ReceiveLine(connection))
+    {
+      nlohmann::json response = ::HandleRequest(*line, settings, pool);
+      if (!::SendLine(connection, response.dump()))
+      {
+        break;
+      }
+    }
+    ::CloseConnection(connection);
+    lastActivity = std::chrono::steady_clock::now().time_since_epoch().count();
+    activeConnections--;
+  };
+
+  while (!stopping)
+  {
+#if defined(_WIN32)
+    bool connected = ConnectNamedPipe(pipe, nullptr) || GetLastError() == ERROR_PIPE_CONNECTED;
+    Connection connection = connected ? pipe : INVALID_CONNECTION;
+    if (!connected)
+    {
+      CloseHandle(pipe);
+    }
+    pipe = createPipe();
+#else
+    Connection connection = accept(listener, nullptr, nullptr);
+    if (connection != INVALID_CONNECTION)
+    {
+      fcntl(connection, F_SETFD, FD_CLOEXEC);
+    }
+#endif
+    if (connection == INVALID_CONNECTION || stopping)
+    {
+      if (connection != INVALID_CONNECTION)
+      {
+        ::CloseConnection(connection);
+      }
+      continue;
+    }
+    activeConnections++;
+    lastActivity = std::chrono::steady_clock::now().time_since_epoch().count();
+    std::thread(handleConnection, connection).detach();
+  }
+
+  idleWatcher.join();
+#if defined(_WIN32)
+  CloseHandle(pipe);
+#else
+  close(listener);
+  unlink(settings.Endpoint.c_str());
+#endif
+  return EXIT_SUCCESS;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * Start a server in the background with the same settings
+ */
+void StartServer(const Settings& settings)
+{
+  fs::path executable = F3DSystemTools::GetApplicationPath();
+  std::vector<std::string> args = { "--endpoint=" + settings.Endpoint,
+    "--cache=" + settings.Cache.u8string(), "--workers=" + std::to_string(settings.Workers),
+    "--idle-timeout=" + std::to_string(settings.IdleTimeout),
+    "--timeout=" + std::to_string(settings.Timeout) };
+  if (!settings.Worker.empty())
+  {
+    args.emplace_back("--worker=" + settings.Worker.u8string());
+  }
+#if defined(_WIN32)
+  std::wstring command = L"\"" + executable.wstring() + L"\"";
+  for (const std::string& arg : args)
+  {
+    command += L" \"" + fs::u8path(arg).wstring() + L"\"";
+  }
+  STARTUPINFOW si = {};
+  si.cb = sizeof(STARTUPINFOW);
+  PROCESS_INFORMATION pi = {};
+  if (CreateProcessW(executable.wstring().c_str(), command.data(), nullptr, nullptr, FALSE,
+        DETACHED_PROCESS | CREATE_NO_WINDOW, nullptr, nullptr, &si, &pi))
+  {
+    CloseHandle(pi.hThread);
+    CloseHandle(pi.hProcess);
+  }
+#else
+  std::string path = executable.string();
+  std::vector<char*> argv = { path.data() };
+  for (std::string& arg : args)
+  {
+    argv.emplace_back(arg.data());
+  }
+  argv.emplace_back(nullptr);
+
+  // Double fork so that the server is not a child of the client
+  pid_t pid = fork();
+  if (pid == 0)
+  {
+    setsid();
+    if (fork() == 0)
+    {
+      execv(argv[0], argv.data());
+    }
+    _exit(EXIT_SUCCESS);
+  }
+  if (pid > 0)
+  {
+    waitpid(pid, nullptr, 0);
+  }
+#endif
+}
+
+//----------------------------------------------------------------------------
+/**
+ * Send a single request, starting a server if needed, and copy the thumbnail to the output
+ */
+int RunRequest(const Settings& settings, const std::string& input, const fs::path& output, int size)
+{
+  Connection connection = ::Connect(settings.Endpoint);
+  if (connection == INVALID_CONNECTION)
+  {
+    ::StartServer(settings);
+
+    // Wait for the server to start its workers
+    for (int i = 0; i < 50 && connection == INVALID_CONNECTION; i++)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      connection = ::Connect(settings.Endpoint);
+    }
+    if (connection == INVALID_CONNECTION)
+    {
+      f3d::log::error("Cannot connect to the thumbnail server on ", settings.Endpoint);
+      return EXIT_FAILURE;
+    }
+  }
+
+  nlohmann::json request = { { "input", fs::absolute(fs::u8path(input)).u8string() },
+    { "size", size } };
+  std::optional<std::string> line;
+  if (::SendLine(connection, request.dump()))
+  {
+    line = ::ReceiveLine(connection);
+  }
+  ::CloseConnection(connection);
+
+  nlohmann::json response = line ? nlohmann::json::parse(*line, nullptr, false) : nlohmann::json();
+  if (!response.is_object() || response.value("status", "") != "success")
+  {
+    f3d::log::error("Cannot create the thumbnail of ", input, ": ",
+      response.is_object() ? response.value("error", "") : "no response from the server");
+    return EXIT_FAILURE;
+  }
+
+  std::error_code ec;
+  fs::copy_file(fs::u8path(response["output"].get<std::string>()), output,
+    fs::copy_options::overwrite_existing, ec);
+  if (ec)
+  {
+    f3d::log::error("Cannot write ", output.string(), ": ", ec.message());
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+//----------------------------------------------------------------------------
+int Run(int argc, char** argv)
+{
+  Settings settings;
+  settings.Endpoint = ::DefaultEndpoint();
+  settings.Cache = ::DefaultCache();
+
+  std::vector<std::string> positionals;
+  bool request = false;
+  for (int i = 1; i < argc; i++)
+  {
+    std::string arg = argv[i];
+    const auto getValue = [&](const std::string& name) -> std::optional<std::string>
+    {
+      const std::string prefix = "--" + name + "=";
+      if (arg.rfind(prefix, 0) == 0)
+      {
+        return arg.substr(prefix.size());
+      }
+      return std::nullopt;
+    };
+
+    if (auto endpoint = getValue("endpoint"))
+    {
+      settings.Endpoint = *endpoint;
+    }
+    else if (auto cache = getValue("cache"))
+    {
+      settings.Cache = fs::u8path(*cache);
+    }
+    else if (auto workers = getValue("workers"))
+    {
+      settings.Workers = std::stoi(*workers);
+    }
+    else if (auto idleTimeout = getValue("idle-timeout"))
+    {
+      settings.IdleTimeout = std::stoi(*idleTimeout);
+    }
+    else if (auto timeout = getValue("timeout"))
+    {
+      settings.Timeout = std::stoi(*timeout);
+    }
+    else if (auto worker = getValue("worker"))
+    {
+      settings.Worker = fs::u8path(*worker);
+    }
+    else if (arg == "--request")
+    {
+      request = true;
+    }
+    else if (arg.rfind("--", 0) != 0)
+    {
+      positionals.emplace_back(arg);
+    }
+    else
+    {
+      f3d::log::error(::USAGE);
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (request)
+  {
+    if (positionals.size() != 3)
+    {
+      f3d::log::error(::USAGE);
+      return EXIT_FAILURE;
+    }
+    return ::RunRequest(
+      settings, positionals[0], fs::u8path(positionals[1]), std::stoi(positionals[2]));
+  }
+
+  if (!positionals.empty())
+  {
+    f3d::log::error(::USAGE);
+    return EXIT_FAILURE;
+  }
+  return ::RunServer(settings);
+}
+}
+
+//----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  try
+  {
+    return ::Run(argc, argv);
+  }
+  catch (const std::exception& ex)
+  {
+    f3d::log::error("f3d-thumbnail-server encountered an unexpected exception:");
+    f3d::log::error(ex.what());
+    return EXIT_FAILURE;
+  }
+}
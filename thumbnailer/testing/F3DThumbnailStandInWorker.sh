@@ -0,0 +1,20 @@
+#!/bin/sh
+# Stand-in for "f3d --batch=-" to test f3d-thumbnail-server without rendering.
+# Each job is answered according to F3D_THUMBNAIL_WORKER_MODE:
+# "fail" answers a failure, "hang" never answers, anything else writes a fake thumbnail.
+while IFS= read -r job; do
+  case "${F3D_THUMBNAIL_WORKER_MODE}" in
+    fail)
+      echo '{"status":"failure","error":"stand-in worker failure"}'
+      ;;
+    hang)
+      # replace the shell so that the watchdog kills the process holding the pipes
+      exec sleep 60
+      ;;
+    *)
+      output=$(printf '%s\n' "${job}" | sed -n 's/.*"output":"\([^"]*\)".*/\1/p')
+      echo "stand-in thumbnail" > "${output}"
+      echo "{\"output\":\"${output}\",\"status\":\"success\"}"
+      ;;
+  esac
+done
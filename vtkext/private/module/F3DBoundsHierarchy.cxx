@@ -0,0 +1,165 @@
+#include "F3DBoundsHierarchy.h"
+
+#include <vtkBoundingBox.h>
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+namespace
+{
+// maximum number of items in a leaf of the hierarchy
+constexpr int LEAF_SIZE = 4;
+}
+
+//----------------------------------------------------------------------------
+bool F3DBoundsHierarchy::Update(std::vector<double> bounds)
+{
+  if (bounds == this->Bounds && (this->Bounds.empty() || !this->Nodes.empty()))
+  {
+    return false;
+  }
+
+  this->Bounds = std::move(bounds);
+  this->Indices.resize(this->Bounds.size() / 6);
+  std::iota(this->Indices.begin(), this->Indices.end(), 0);
+
+  this->Nodes.clear();
+  if (!this->Indices.empty())
+  {
+    this->BuildNode(0, static_cast<int>(this->Indices.size()));
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+size_t F3DBoundsHierarchy::GetNumberOfItems() const
+{
+  return this->Indices.size();
+}
+
+//----------------------------------------------------------------------------
+const double* F3DBoundsHierarchy::GetItemBounds(size_t item) const
+{
+  return &this->Bounds[6 * item];
+}
+
+//----------------------------------------------------------------------------
+void F3DBoundsHierarchy::Traverse(const double planes[24],
+  const std::function<bool(const double*)>& nodeFilter,
+  const std::function<void(int)>& visitor) const
+{
+  std::vector<std::pair<int, bool>> stack;
+  if (!this->Nodes.empty())
+  {
+    stack.emplace_back(0, false);
+  }
+
+  while (!stack.empty())
+  {
+    int nodeIndex = stack.back().first;
+    bool inside = stack.back().second;
+    stack.pop_back();
+
+    const Node& node = this->Nodes[nodeIndex];
+    if (!inside && F3DBoundsHierarchy::IsOutsideFrustum(planes, node.Bounds, inside))
+    {
+      continue;
+    }
+
+    if (nodeFilter && !nodeFilter(node.Bounds))
+    {
+      continue;
+    }
+
+    if (node.Left < 0)
+    {
+      for (int i = node.First; i < node.First + node.Count; i++)
+      {
+        visitor(this->Indices[i]);
+      }
+    }
+    else
+    {
+      stack.emplace_back(node.Right, inside);
+      stack.emplace_back(node.Left, inside);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+bool F3DBoundsHierarchy::IsOutsideFrustum(
+  const double planes[24], const double bounds[6], bool& allInside)
+{
+  allInside = true;
+  for (int i = 0; i < 6; i++)
+  {
+    const double* plane = planes + 4 * i;
+    double nearest = plane[3];
+    double farthest = plane[3];
+    for (int j = 0; j < 3; j++)
+    {
+      double low = plane[j] * bounds[2 * j];
+      double high = plane[j] * bounds[2 * j + 1];
+      nearest += std::min(low, high);
+      farthest += std::max(low, high);
+    }
+
+    if (farthest < 0.0)
+    {
+      return true;
+    }
+    if (nearest < 0.0)
+    {
+      allInside = false;
+    }
+  }
+  return false;
+}
+
+//----------------------------------------------------------------------------
+int F3DBoundsHierarchy::BuildNode(int first, int count)
+{
+  int nodeIndex = static_cast<int>(this->Nodes.size());
+  this->Nodes.emplace_back();
+
+  auto center = [&](int index, int axis)
+  {
+    const double* bounds = &this->Bounds[6 * index];
+    return bounds[2 * axis] + bounds[2 * axis + 1];
+  };
+
+  vtkBoundingBox bbox;
+  vtkBoundingBox centers;
+  for (int i = first; i < first + count; i++)
+  {
+    int index = this->Indices[i];
+    bbox.AddBounds(&this->Bounds[6 * index]);
+    centers.AddPoint(0.5 * center(index, 0), 0.5 * center(index, 1), 0.5 * center(index, 2));
+  }
+  bbox.GetBounds(this->Nodes[nodeIndex].Bounds);
+
+  // split along the largest extent of the items centers
+  double lengths[3];
+  centers.GetLengths(lengths);
+  int axis = static_cast<int>(std::max_element(lengths, lengths + 3) - lengths);
+
+  if (count <= ::LEAF_SIZE || lengths[axis] <= 0.0)
+  {
+    this->Nodes[nodeIndex].First = first;
+    this->Nodes[nodeIndex].Count = count;
+    return nodeIndex;
+  }
+
+  int half = count / 2;
+  std::nth_element(this->Indices.begin() + first, this->Indices.begin() + first + half,
+    this->Indices.begin() + first + count,
+    [&](int a, int b) { return center(a, axis) < center(b, axis); });
+
+  // nodes can be reallocated by the recursion, do not keep a reference
+  int left = this->BuildNode(first, half);
+  int right = this->BuildNode(first + half, count - half);
+  this->Nodes[nodeIndex].Left = left;
+  this->Nodes[nodeIndex].Right = right;
+  return nodeIndex;
+}
@@ -0,0 +1,71 @@
+/**
+ * @class F3DBoundsHierarchy
+ * @brief A bounding volume hierarchy of axis aligned bounds
+ *
+ * The hierarchy is built from a list of bounds, 6 values per item, by recursively splitting the
+ * items along the largest extent of their centers. It is used to find quickly the items
+ * intersecting a camera frustum, to cull the props or to compute tight clipping ranges.
+ */
+#ifndef F3DBoundsHierarchy_h
+#define F3DBoundsHierarchy_h
+
+#include <functional>
+#include <vector>
+
+class F3DBoundsHierarchy
+{
+public:
+  /**
+   * Rebuild the hierarchy of the provided bounds, 6 values per item,
+   * only if they changed since the last build. Return true if the hierarchy was rebuilt.
+   */
+  bool Update(std::vector<double> bounds);
+
+  /**
+   * Return the number of items in the hierarchy
+   */
+  size_t GetNumberOfItems() const;
+
+  /**
+   * Return the bounds of an item
+   */
+  const double* GetItemBounds(size_t item) const;
+
+  /**
+   * Traverse the nodes intersecting the frustum given as 6 inward facing planes, like
+   * vtkCamera::GetFrustumPlanes. The frustum test is skipped for nodes known to be fully inside.
+   * nodeFilter is called with the bounds of each node in the frustum, it can return false
+   * to discard the node, eg. when it is occluded. visitor is called for each item of the
+   * leaves that are not discarded.
+   */
+  void Traverse(const double planes[24], const std::function<bool(const double*)>& nodeFilter,
+    const std::function<void(int)>& visitor) const;
+
+  /**
+   * Return true if the bounds are entirely outside of one of the inward facing frustum planes.
+   * allInside is set to true if the bounds are entirely inside all the planes.
+   */
+  static bool IsOutsideFrustum(const double planes[24], const double bounds[6], bool& allInside);
+
+private:
+  /**
+   * Recursively build the node of the items Indices[first, first + count[,
+   * and return its index
+   */
+  int BuildNode(int first, int count);
+
+  struct Node
+  {
+    double Bounds[6];
+    int Left = -1;
+    int Right = -1;
+    int First = 0;
+    int Count = 0;
+  };
+
+  std::vector<Node> Nodes;
+  std::vector<int> Indices;
+  std::vector<double> Bounds;
+};
+
+#endif
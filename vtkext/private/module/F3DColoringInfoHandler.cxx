@@ -2,19 +2,137 @@
 
 #include "F3DLog.h"
 
+#include <vtkArrayDispatch.h>
 #include <vtkCellData.h>
 #include <vtkDataArray.h>
+#include <vtkDataArrayRange.h>
 #include <vtkDataSet.h>
 #include <vtkPointData.h>
+#include <vtkSMPThreadLocal.h>
+#include <vtkSMPTools.h>
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <limits>
 #include <set>
 
+namespace
+{
+//----------------------------------------------------------------------------
+// Compute the range of each component and of the squared magnitude in a single pass,
+// reduced over the threads. NaN values are ignored by the comparisons, like vtkDataArray.
+template<typename ArrayT>
+struct RangesFunctor
+{
+  explicit RangesFunctor(ArrayT* array)
+    : Array(array)
+    , NumberOfComponents(array->GetNumberOfComponents())
+  {
+  }
+
+  void Initialize()
+  {
+    std::vector<double>& ranges = this->ThreadRanges.Local();
+    ranges.resize(2 * (this->NumberOfComponents + 1));
+    for (size_t i = 0; i < ranges.size(); i += 2)
+    {
+      ranges[i] = std::numeric_limits<double>::max();
+      ranges[i + 1] = std::numeric_limits<double>::lowest();
+    }
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    std::vector<double>& ranges = this->ThreadRanges.Local();
+    const int nComps = this->NumberOfComponents;
+    for (const auto tuple : vtk::DataArrayTupleRange(this->Array, begin, end))
+    {
+      double squared = 0.0;
+      for (int comp = 0; comp < nComps; comp++)
+      {
+        double value = static_cast<double>(tuple[comp]);
+        ranges[2 * comp + 2] = std::min(ranges[2 * comp + 2], value);
+        ranges[2 * comp + 3] = std::max(ranges[2 * comp + 3], value);
+        squared += value * value;
+      }
+      ranges[0] = std::min(ranges[0], squared);
+      ranges[1] = std::max(ranges[1], squared);
+    }
+  }
+
+  void Reduce()
+  {
+    this->Ranges.assign(this->NumberOfComponents + 1,
+      { std::numeric_limits<double>::max(), std::numeric_limits<double>::lowest() });
+    for (const std::vector<double>& ranges : this->ThreadRanges)
+    {
+      for (size_t i = 0; i < this->Ranges.size(); i++)
+      {
+        this->Ranges[i][0] = std::min(this->Ranges[i][0], ranges[2 * i]);
+        this->Ranges[i][1] = std::max(this->Ranges[i][1], ranges[2 * i + 1]);
+      }
+    }
+  }
+
+  ArrayT* Array;
+  int NumberOfComponents;
+  vtkSMPThreadLocal<std::vector<double>> ThreadRanges;
+  std::vector<std::array<double, 2>> Ranges;
+};
+
+struct RangesWorker
+{
+  template<typename ArrayT>
+  void operator()(ArrayT* array, std::vector<std::array<double, 2>>& ranges)
+  {
+    RangesFunctor<ArrayT> functor(array);
+    vtkSMPTools::For(0, array->GetNumberOfTuples(), functor);
+    ranges = std::move(functor.Ranges);
+  }
+};
+
+//----------------------------------------------------------------------------
+// Return the magnitude range followed by the range of each component of an array
+std::vector<std::array<double, 2>> ComputeRanges(vtkDataArray* array)
+{
+  std::vector<std::array<double, 2>> ranges;
+  RangesWorker worker;
+  if (!vtkArrayDispatch::Dispatch::Execute(array, worker, ranges))
+  {
+    worker(array, ranges);
+  }
+
+  // the squared magnitude is compared to avoid a square root per tuple
+  std::array<double, 2>& magnitude = ranges[0];
+  if (magnitude[0] <= magnitude[1])
+  {
+    magnitude[0] = std::sqrt(magnitude[0]);
+    magnitude[1] = std::sqrt(magnitude[1]);
+  }
+
+  // the magnitude of a single component is the component itself, like vtkDataArray::GetRange
+  if (ranges.size() == 2)
+  {
+    magnitude = ranges[1];
+  }
+  return ranges;
+}
+}
+
 //----------------------------------------------------------------------------
 void F3DColoringInfoHandler::ClearColoringInfo()
 {
   this->PointDataColoringInfo.clear();
   this->CellDataColoringInfo.clear();
+  this->PointDataPendingArrays.clear();
+  this->CellDataPendingArrays.clear();
+
+  // Keep the cached ranges of the arrays that still exist, they are often reused
+  for (auto it = this->RangesCaches.begin(); it != this->RangesCaches.end();)
+  {
+    it = it->second.Array ? std::next(it) : this->RangesCaches.erase(it);
+  }
 }
 
 //----------------------------------------------------------------------------
@@ -40,6 +158,7 @@ void F3DColoringInfoHandler::UpdateColoringInfo(vtkDataSet* dataset, bool useCel
   }
 
   auto& data = useCellData ? this->CellDataColoringInfo : this->PointDataColoringInfo;
+  auto& pending = useCellData ? this->CellDataPendingArrays : this->PointDataPendingArrays;
 
   for (const std::string& arrayName : arrayNames)
   {
@@ -54,25 +173,12 @@ void F3DColoringInfoHandler::UpdateColoringInfo(vtkDataSet* dataset, bool useCel
       info.MaximumNumberOfComponents =
         std::max(info.MaximumNumberOfComponents, array->GetNumberOfComponents());
 
-      // Set ranges
+      // Ranges are computed only when this array is used for coloring
       // XXX this does not take animation into account
-      std::array<double, 2> range;
-      array->GetRange(range.data(), -1);
-      info.MagnitudeRange[0] = std::min(info.MagnitudeRange[0], range[0]);
-      info.MagnitudeRange[1] = std::max(info.MagnitudeRange[1], range[1]);
-
-      for (size_t i = 0; i < static_cast<size_t>(array->GetNumberOfComponents()); i++)
+      std::vector<vtkSmartPointer<vtkDataArray>>& arrays = pending[arrayName];
+      if (std::find(arrays.begin(), arrays.end(), array) == arrays.end())
       {
-        array->GetRange(range.data(), static_cast<int>(i));
-        if (i < info.ComponentRanges.size())
-        {
-          info.ComponentRanges[i][0] = std::min(info.ComponentRanges[i][0], range[0]);
-          info.ComponentRanges[i][1] = std::max(info.ComponentRanges[i][1], range[1]);
-        }
-        else
-        {
-          info.ComponentRanges.emplace_back(range);
-        }
+        arrays.emplace_back(array);
       }
 
       // Set component names
@@ -100,6 +206,63 @@ void F3DColoringInfoHandler::UpdateColoringInfo(vtkDataSet* dataset, bool useCel
   }
 }
 
+//----------------------------------------------------------------------------
+void F3DColoringInfoHandler::MergePendingRanges(
+  ColoringInfo& info, std::vector<vtkSmartPointer<vtkDataArray>>& arrays)
+{
+  // Recover the ranges of the arrays that were not modified since they were computed
+  std::vector<const std::vector<std::array<double, 2>>*> ranges(arrays.size(), nullptr);
+  std::vector<size_t> toCompute;
+  for (size_t i = 0; i < arrays.size(); i++)
+  {
+    auto it = this->RangesCaches.find(arrays[i]);
+    if (it != this->RangesCaches.end() && it->second.Array == arrays[i] &&
+      it->second.MTime == arrays[i]->GetMTime())
+    {
+      ranges[i] = &it->second.Ranges;
+    }
+    else
+    {
+      toCompute.emplace_back(i);
+    }
+  }
+
+  // Compute the other ones in a single pass per array over all the components,
+  // the tuples being reduced in parallel so a single large array uses all the threads
+  for (size_t i : toCompute)
+  {
+    vtkDataArray* array = arrays[i];
+    RangesCache& cache = this->RangesCaches[array];
+    cache.Array = array;
+    cache.MTime = array->GetMTime();
+    cache.Ranges = ::ComputeRanges(array);
+    ranges[i] = &cache.Ranges;
+  }
+
+  // Merge the ranges in the coloring info, in the order the arrays were added
+  for (const std::vector<std::array<double, 2>>* arrayRanges : ranges)
+  {
+    info.MagnitudeRange[0] = std::min(info.MagnitudeRange[0], (*arrayRanges)[0][0]);
+    info.MagnitudeRange[1] = std::max(info.MagnitudeRange[1], (*arrayRanges)[0][1]);
+
+    for (size_t i = 1; i < arrayRanges->size(); i++)
+    {
+      const std::array<double, 2>& range = (*arrayRanges)[i];
+      if (i - 1 < info.ComponentRanges.size())
+      {
+        info.ComponentRanges[i - 1][0] = std::min(info.ComponentRanges[i - 1][0], range[0]);
+        info.ComponentRanges[i - 1][1] = std::max(info.ComponentRanges[i - 1][1], range[1]);
+      }
+      else
+      {
+        info.ComponentRanges.emplace_back(range);
+      }
+    }
+  }
+
+  arrays.clear();
+}
+
 //----------------------------------------------------------------------------
 std::optional<F3DColoringInfoHandler::ColoringInfo> F3DColoringInfoHandler::SetCurrentColoring(bool enable, bool useCellData, const std::optional<std::string>& arrayName, bool quiet)
 {
@@ -146,11 +309,19 @@ std::optional<F3DColoringInfoHandler::ColoringInfo> F3DColoringInfoHandler::SetC
 }
 
 //----------------------------------------------------------------------------
-std::optional<F3DColoringInfoHandler::ColoringInfo> F3DColoringInfoHandler::GetCurrentColoringInfo() const
+std::optional<F3DColoringInfoHandler::ColoringInfo> F3DColoringInfoHandler::GetCurrentColoringInfo()
 {
   if (this->CurrentColoringIter.has_value())
   {
-    return this->CurrentColoringIter.value()->second;
+    ColoringInfo& info = this->CurrentColoringIter.value()->second;
+    auto& pending =
+      this->CurrentUsingCellData ? this->CellDataPendingArrays : this->PointDataPendingArrays;
+    auto it = pending.find(info.Name);
+    if (it != pending.end() && !it->second.empty())
+    {
+      this->MergePendingRanges(info, it->second);
+    }
+    return info;
   }
   return std::nullopt;
 }
@@ -5,6 +5,10 @@
 #ifndef F3DColoringInfoHandler_h
 #define F3DColoringInfoHandler_h
 
+#include <vtkSmartPointer.h>
+#include <vtkType.h>
+#include <vtkWeakPointer.h>
+
 #include <array>
 #include <limits>
 #include <map>
@@ -12,6 +16,7 @@
 #include <string>
 #include <vector>
 
+class vtkDataArray;
 class vtkDataSet;
 class F3DColoringInfoHandler
 {
@@ -32,6 +37,7 @@ public:
   /**
    * Update internal coloring maps using provided dataset
    * useCellData control if point data or cell data should be updated
+   * Ranges are not computed here but only when the coloring info is recovered
    */
   void UpdateColoringInfo(vtkDataSet* dataset, bool useCellData);
 
@@ -51,10 +57,10 @@ public:
   std::optional<ColoringInfo> SetCurrentColoring(bool enable, bool useCellData, const std::optional<std::string>& arrayName, bool quiet);
 
   /**
-   * Get the current coloring state
+   * Get the current coloring state, computing the ranges of its arrays if needed
    * Return current coloring info if any, unset optional otherwise
    */
-  std::optional<ColoringInfo> GetCurrentColoringInfo() const;
+  std::optional<ColoringInfo> GetCurrentColoringInfo();
 
   /**
    * Cycle the current coloring
@@ -70,6 +76,25 @@ private:
   ColoringMap PointDataColoringInfo;
   ColoringMap CellDataColoringInfo;
 
+  // Map of arrayName -> arrays whose ranges are not merged in the coloring info yet
+  using PendingArraysMap = std::map<std::string, std::vector<vtkSmartPointer<vtkDataArray>>>;
+  PendingArraysMap PointDataPendingArrays;
+  PendingArraysMap CellDataPendingArrays;
+
+  /**
+   * Compute the ranges of the pending arrays in parallel and merge them in the coloring info
+   */
+  void MergePendingRanges(ColoringInfo& info, std::vector<vtkSmartPointer<vtkDataArray>>& arrays);
+
+  // Ranges of arrays, magnitude first, kept while the arrays are not modified
+  struct RangesCache
+  {
+    vtkWeakPointer<vtkDataArray> Array;
+    vtkMTimeType MTime = 0;
+    std::vector<std::array<double, 2>> Ranges;
+  };
+  std::map<vtkDataArray*, RangesCache> RangesCaches;
+
   // Current coloring state
   bool CurrentUsingCellData = false;
   std::optional<ColoringMap::iterator> CurrentColoringIter;
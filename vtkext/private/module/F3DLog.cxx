@@ -7,45 +7,256 @@
 #include "vtkF3DWin32OutputWindow.h"
 #endif
 
-F3DLog::Severity F3DLog::VerboseLevel = F3DLog::Severity::Info;
+#include <algorithm>
+#include <memory>
+#include <mutex>
+
+#if !defined(__EMSCRIPTEN__) || defined(__EMSCRIPTEN_PTHREADS__)
+#define F3D_LOG_HAS_THREADS 1
+#include <chrono>
+#include <condition_variable>
+#include <thread>
+#endif
+
+std::atomic<F3DLog::Severity> F3DLog::VerboseLevel{ F3DLog::Severity::Info };
+
+namespace
+{
+// the output window is shared by all the engines
+std::mutex OutputMutex;
+
+// set when the standard stream is None, nothing is displayed
+std::atomic<bool> Quiet{ false };
+
+std::atomic<std::uint64_t> DroppedMessages{ 0 };
 
 //----------------------------------------------------------------------------
-void F3DLog::Print(Severity sev, const std::string& str)
+// OutputMutex must be locked
+void Display(F3DLog::Severity sev, const std::string& str)
 {
   vtkOutputWindow* win = vtkOutputWindow::GetInstance();
   switch (sev)
   {
     default:
     case F3DLog::Severity::Debug:
-      if (F3DLog::VerboseLevel <= F3DLog::Severity::Debug)
+    case F3DLog::Severity::Info:
+      win->DisplayText(str.c_str());
+      break;
+    case F3DLog::Severity::Warning:
+      win->DisplayWarningText(str.c_str());
+      break;
+    case F3DLog::Severity::Error:
+      win->DisplayErrorText(str.c_str());
+      break;
+  }
+}
+
+#if F3D_LOG_HAS_THREADS
+/**
+ * A bounded queue of messages with several producers and a single consumer.
+ * Each slot has a sequence number telling if it is ready to be written or read at a position,
+ * so that the producers only compete on the atomic push position, without lock.
+ */
+class MessageQueue
+{
+public:
+  explicit MessageQueue(std::size_t capacity)
+    : Capacity(capacity)
+    , Slots(new Slot[capacity])
+  {
+    for (std::size_t i = 0; i < capacity; i++)
+    {
+      this->Slots[i].Sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  /**
+   * Push a message, return false if the queue is full
+   */
+  bool Push(F3DLog::Severity sev, const std::string& str)
+  {
+    std::size_t pos = this->PushPosition.load(std::memory_order_relaxed);
+    while (true)
+    {
+      Slot& slot = this->Slots[pos % this->Capacity];
+      std::size_t seq = slot.Sequence.load(std::memory_order_acquire);
+      std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+      if (diff == 0)
       {
-        win->DisplayText(str.c_str());
+        // the slot is free, reserve it
+        if (this->PushPosition.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+        {
+          slot.Severity = sev;
+          slot.Message = str;
+          slot.Sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
       }
-      break;
-    case F3DLog::Severity::Info:
-      if (F3DLog::VerboseLevel <= F3DLog::Severity::Info)
+      else if (diff < 0)
       {
-        win->DisplayText(str.c_str());
+        // the slot still contains the message pushed one lap before
+        return false;
       }
-      break;
-    case F3DLog::Severity::Warning:
-      if (F3DLog::VerboseLevel <= F3DLog::Severity::Warning)
+      else
       {
-        win->DisplayWarningText(str.c_str());
+        // another producer reserved the slot
+        pos = this->PushPosition.load(std::memory_order_relaxed);
       }
-      break;
-    case F3DLog::Severity::Error:
-      if (F3DLog::VerboseLevel <= F3DLog::Severity::Error)
+    }
+  }
+
+  /**
+   * Pop a message, return false if the queue is empty. Must only be called by the consumer.
+   */
+  bool Pop(F3DLog::Severity& sev, std::string& str)
+  {
+    Slot& slot = this->Slots[this->PopPosition % this->Capacity];
+    if (slot.Sequence.load(std::memory_order_acquire) != this->PopPosition + 1)
+    {
+      return false;
+    }
+    sev = slot.Severity;
+    str = std::move(slot.Message);
+    slot.Message.clear();
+    slot.Sequence.store(this->PopPosition + this->Capacity, std::memory_order_release);
+    this->PopPosition++;
+    return true;
+  }
+
+private:
+  struct Slot
+  {
+    std::atomic<std::size_t> Sequence{ 0 };
+    F3DLog::Severity Severity = F3DLog::Severity::Info;
+    std::string Message;
+  };
+
+  const std::size_t Capacity;
+  std::unique_ptr<Slot[]> Slots;
+  std::atomic<std::size_t> PushPosition{ 0 };
+  std::size_t PopPosition = 0;
+};
+
+/**
+ * The background thread writing the queued messages in the output window
+ */
+class AsyncWriter
+{
+public:
+  explicit AsyncWriter(std::size_t capacity)
+    : Queue(capacity)
+  {
+    this->Thread = std::thread([this]() { this->Run(); });
+  }
+
+  ~AsyncWriter()
+  {
+    this->Running = false;
+    this->Wakeup.notify_one();
+    this->Thread.join();
+  }
+
+  void Push(F3DLog::Severity sev, const std::string& str)
+  {
+    if (!this->Queue.Push(sev, str))
+    {
+      ::DroppedMessages++;
+      return;
+    }
+    this->Wakeup.notify_one();
+  }
+
+private:
+  void Run()
+  {
+    F3DLog::Severity sev;
+    std::string str;
+    while (true)
+    {
+      // read the flag before draining so that the messages pushed before stopping are written
+      bool running = this->Running;
+      while (this->Queue.Pop(sev, str))
       {
-        win->DisplayErrorText(str.c_str());
+        const std::lock_guard<std::mutex> lock(::OutputMutex);
+        ::Display(sev, str);
       }
-      break;
+      if (!running)
+      {
+        break;
+      }
+
+      // producers do not lock when notifying, a wakeup can be missed so do not wait for too long
+      std::unique_lock<std::mutex> lock(this->WakeupMutex);
+      this->Wakeup.wait_for(lock, std::chrono::milliseconds(10));
+    }
+  }
+
+  MessageQueue Queue;
+  std::atomic<bool> Running{ true };
+  std::mutex WakeupMutex;
+  std::condition_variable Wakeup;
+  std::thread Thread;
+};
+
+// accessed with std::atomic_load and std::atomic_exchange, destroyed at exit, writing the
+// pending messages
+std::shared_ptr<AsyncWriter> Writer;
+#endif
+}
+
+//----------------------------------------------------------------------------
+void F3DLog::Print(Severity sev, const std::string& str)
+{
+  if (!F3DLog::IsEnabled(sev))
+  {
+    return;
   }
+
+#if F3D_LOG_HAS_THREADS
+  std::shared_ptr<AsyncWriter> writer = std::atomic_load(&::Writer);
+  if (writer)
+  {
+    writer->Push(sev, str);
+    return;
+  }
+#endif
+
+  const std::lock_guard<std::mutex> lock(::OutputMutex);
+  ::Display(sev, str);
+}
+
+//----------------------------------------------------------------------------
+bool F3DLog::IsEnabled(Severity sev)
+{
+  return !::Quiet && F3DLog::VerboseLevel <= sev;
+}
+
+//----------------------------------------------------------------------------
+bool F3DLog::SetAsynchronous(bool async, std::size_t capacity)
+{
+#if F3D_LOG_HAS_THREADS
+  std::shared_ptr<AsyncWriter> writer =
+    async ? std::make_shared<AsyncWriter>(std::max<std::size_t>(capacity, 1)) : nullptr;
+
+  // the previous writer, if any, writes its pending messages when destroyed
+  std::atomic_exchange(&::Writer, writer);
+  return true;
+#else
+  (void)capacity;
+  return !async;
+#endif
+}
+
+//----------------------------------------------------------------------------
+std::uint64_t F3DLog::GetNumberOfDroppedMessages()
+{
+  return ::DroppedMessages;
 }
 
 //----------------------------------------------------------------------------
 void F3DLog::SetUseColoring(bool use)
 {
+  const std::lock_guard<std::mutex> lock(::OutputMutex);
   vtkOutputWindow* win = vtkOutputWindow::GetInstance();
   vtkF3DConsoleOutputWindow* consoleWin = vtkF3DConsoleOutputWindow::SafeDownCast(win);
   if (consoleWin)
@@ -57,8 +268,10 @@ void F3DLog::SetUseColoring(bool use)
 //----------------------------------------------------------------------------
 void F3DLog::SetStandardStream(StandardStream mode)
 {
+  const std::lock_guard<std::mutex> lock(::OutputMutex);
   vtkOutputWindow* win = vtkOutputWindow::GetInstance();
 
+  ::Quiet = mode == StandardStream::None;
   switch (mode)
   {
     case StandardStream::None:
@@ -78,6 +291,9 @@ void F3DLog::SetStandardStream(StandardStream mode)
 void F3DLog::WaitForUser()
 {
 #if F3D_WINDOWS_GUI
+  // write the pending messages before waiting
+  F3DLog::SetAsynchronous(false, 0);
+
   vtkOutputWindow* win = vtkOutputWindow::GetInstance();
   vtkF3DWin32OutputWindow* win32Win = vtkF3DWin32OutputWindow::SafeDownCast(win);
   if (win32Win && win->GetDisplayMode() != vtkOutputWindow::NEVER)
@@ -11,6 +11,9 @@
 #ifndef F3DLog_h
 #define F3DLog_h
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
 namespace F3DLog
@@ -34,13 +37,33 @@ enum class StandardStream : unsigned char
  * Set this global variable to control the verbose level
  * that actually display something in Print
  */
-extern Severity VerboseLevel;
+extern std::atomic<Severity> VerboseLevel;
 
 /**
  * Print a message with corresponding severity in the output window
+ * Messages printed from several threads are serialized.
  */
 void Print(Severity sev, const std::string& msg);
 
+/**
+ * Return true if a message with corresponding severity is displayed by Print
+ */
+bool IsEnabled(Severity sev);
+
+/**
+ * Enable or disable the asynchronous mode.
+ * In this mode, Print pushes the messages in a bounded lock-free queue of the provided capacity,
+ * written to the output window by a background thread. Messages pushed when the queue is full are
+ * dropped and counted. Disabling it writes the pending messages and stops the thread.
+ * Return false if threads are not supported.
+ */
+bool SetAsynchronous(bool async, std::size_t capacity);
+
+/**
+ * Get the number of messages dropped because the asynchronous queue was full
+ */
+std::uint64_t GetNumberOfDroppedMessages();
+
 /**
  * If output window is a vtkF3DConsoleOutputWindow,
  * set the coloring usage.
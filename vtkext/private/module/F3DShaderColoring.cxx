@@ -0,0 +1,306 @@
+#include "F3DShaderColoring.h"
+
+#include <vtkDataArray.h>
+#include <vtkOpenGLRenderWindow.h>
+#include <vtkPolyData.h>
+#include <vtkScalarsToColors.h>
+#include <vtkShaderProgram.h>
+#include <vtkWindow.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+// number of colors sampled from the lookup table
+constexpr int COLOR_MAP_SIZE = 256;
+}
+
+//----------------------------------------------------------------------------
+bool F3DShaderColoring::IsSupported()
+{
+#ifdef GL_ES_VERSION_3_0
+  return false;
+#else
+  return true;
+#endif
+}
+
+//----------------------------------------------------------------------------
+bool F3DShaderColoring::SetEnabled(bool enabled)
+{
+  bool enabledBefore = this->Enabled && this->Array;
+  this->Enabled = enabled;
+  return enabledBefore != (this->Enabled && this->Array);
+}
+
+//----------------------------------------------------------------------------
+bool F3DShaderColoring::GetEnabled() const
+{
+  return this->Enabled;
+}
+
+//----------------------------------------------------------------------------
+bool F3DShaderColoring::SetArray(
+  vtkDataArray* array, vtkScalarsToColors* lut, const double range[2])
+{
+  // the shaders only depend on the coloring being used, the rest is provided by uniforms
+  bool rebuild = this->Enabled && ((this->Array == nullptr) != (array == nullptr));
+
+  this->Array = array;
+  this->LookupTable = lut;
+  if (range)
+  {
+    this->Range[0] = range[0];
+    this->Range[1] = range[1];
+  }
+  return rebuild;
+}
+
+//----------------------------------------------------------------------------
+vtkDataArray* F3DShaderColoring::GetArray() const
+{
+  return this->Array;
+}
+
+//----------------------------------------------------------------------------
+bool F3DShaderColoring::IsUsed(vtkPolyData* input) const
+{
+  return this->Enabled && this->Array && input &&
+    this->Array->GetNumberOfTuples() == input->GetNumberOfPoints() &&
+    F3DShaderColoring::IsSupported();
+}
+
+//----------------------------------------------------------------------------
+void F3DShaderColoring::ReplaceShaderValues(std::map<vtkShader::Type, vtkShader*> shaders)
+{
+  std::string VSSource = shaders[vtkShader::Vertex]->GetSource();
+  std::string FSSource = shaders[vtkShader::Fragment]->GetSource();
+
+  // clang-format off
+  vtkShaderProgram::Substitute(VSSource, "//VTK::Color::Dec",
+    "//VTK::Color::Dec\n"
+    "uniform samplerBuffer gpuScalars;\n"
+    "uniform int gpuScalarsComponents;\n"
+    "uniform int gpuScalarsComponent;\n"
+    "uniform vec2 gpuScalarsRange;\n"
+    "out float gpuScalarsCoordVSOutput;\n"
+  );
+
+  // the point ids are the vertex ids, the colored array is not reordered
+  vtkShaderProgram::Substitute(VSSource, "//VTK::Color::Impl",
+    "//VTK::Color::Impl\n"
+    "  float gpuScalar = 0.0;\n"
+    "  if (gpuScalarsComponent >= 0)\n"
+    "  {\n"
+    "    gpuScalar = texelFetch(gpuScalars,\n"
+    "      gl_VertexID * gpuScalarsComponents + gpuScalarsComponent).r;\n"
+    "  }\n"
+    "  else\n"
+    "  {\n"
+    "    for (int i = 0; i < gpuScalarsComponents; i++)\n"
+    "    {\n"
+    "      float value = texelFetch(gpuScalars, gl_VertexID * gpuScalarsComponents + i).r;\n"
+    "      gpuScalar += value * value;\n"
+    "    }\n"
+    "    gpuScalar = sqrt(gpuScalar);\n"
+    "  }\n"
+    "  float gpuScalarsDelta = gpuScalarsRange.y - gpuScalarsRange.x;\n"
+    "  gpuScalarsCoordVSOutput = gpuScalarsDelta > 0.0 ?\n"
+    "    (gpuScalar - gpuScalarsRange.x) / gpuScalarsDelta : 0.0;\n"
+  );
+
+  // the wide lines and the point sprites are generated by a geometry shader
+  vtkShader* geometryShader = shaders[vtkShader::Geometry];
+  std::string GSSource = geometryShader ? geometryShader->GetSource() : "";
+  if (!GSSource.empty())
+  {
+    vtkShaderProgram::Substitute(GSSource, "//VTK::Color::Dec",
+      "//VTK::Color::Dec\n"
+      "in float gpuScalarsCoordVSOutput[];\n"
+      "out float gpuScalarsCoordGSOutput;\n"
+    );
+    vtkShaderProgram::Substitute(GSSource, "//VTK::Color::Impl",
+      "//VTK::Color::Impl\n"
+      "gpuScalarsCoordGSOutput = gpuScalarsCoordVSOutput[i];\n"
+    );
+    geometryShader->SetSource(GSSource);
+  }
+
+  vtkShaderProgram::Substitute(FSSource, "//VTK::Color::Dec",
+    "//VTK::Color::Dec\n"
+    "uniform sampler2D gpuColorMap;\n"
+    "in float gpuScalarsCoordVSOutput;\n"
+  );
+
+  // inserted before the tag, the implementation of the superclass uses the local colors
+  vtkShaderProgram::Substitute(FSSource, "//VTK::Color::Impl",
+    "  float gpuColorCoord = clamp(gpuScalarsCoordVSOutput, 0.0, 1.0);\n"
+    "  vec4 gpuColor = texture(gpuColorMap, vec2((gpuColorCoord * " +
+    std::to_string(::COLOR_MAP_SIZE - 1) + ".0 + 0.5) / " + std::to_string(::COLOR_MAP_SIZE) +
+    ".0, 0.5));\n"
+    "  float gpuOpacity = opacityUniform * gpuColor.a;\n"
+    "  vec3 ambientColorUniform = gpuColor.rgb;\n"
+    "  vec3 diffuseColorUniform = gpuColor.rgb;\n"
+    "  float opacityUniform = gpuOpacity;\n"
+    "//VTK::Color::Impl\n"
+  );
+  // clang-format on
+
+  shaders[vtkShader::Vertex]->SetSource(VSSource);
+  shaders[vtkShader::Fragment]->SetSource(FSSource);
+}
+
+//----------------------------------------------------------------------------
+void F3DShaderColoring::SetShaderParameters(
+  vtkShaderProgram* program, vtkOpenGLRenderWindow* renWin)
+{
+  if (!program->IsUniformUsed("gpuScalars"))
+  {
+    return;
+  }
+
+  this->UpdateTextures(renWin);
+
+  int nComps = this->Array->GetNumberOfComponents();
+  vtkScalarsToColors* lut = this->LookupTable;
+
+  // same component selection as vtkScalarsToColors, -1 meaning the magnitude
+  int component = -1;
+  if (!lut || lut->GetVectorMode() == vtkScalarsToColors::COMPONENT || nComps == 1)
+  {
+    component = lut ? std::clamp(lut->GetVectorComponent(), 0, nComps - 1) : 0;
+  }
+
+  this->CurrentScalars->Texture->Activate();
+  this->ColorMapTexture->Activate();
+  program->SetUniformi("gpuScalars", this->CurrentScalars->Texture->GetTextureUnit());
+  program->SetUniformi("gpuScalarsComponents", nComps);
+  program->SetUniformi("gpuScalarsComponent", component);
+  float range[2] = { static_cast<float>(this->Range[0]), static_cast<float>(this->Range[1]) };
+  program->SetUniform2f("gpuScalarsRange", range);
+  program->SetUniformi("gpuColorMap", this->ColorMapTexture->GetTextureUnit());
+}
+
+//----------------------------------------------------------------------------
+void F3DShaderColoring::Deactivate()
+{
+  if (this->CurrentScalars && this->CurrentScalars->Texture)
+  {
+    this->CurrentScalars->Texture->Deactivate();
+  }
+  if (this->ColorMapTexture)
+  {
+    this->ColorMapTexture->Deactivate();
+  }
+}
+
+//----------------------------------------------------------------------------
+void F3DShaderColoring::ReleaseGraphicsResources(vtkWindow* win)
+{
+  for (auto& [array, scalars] : this->ScalarsCache)
+  {
+    if (scalars->Texture)
+    {
+      scalars->Texture->ReleaseGraphicsResources(win);
+    }
+    scalars->Buffer->ReleaseGraphicsResources();
+  }
+  this->ScalarsCache.clear();
+  this->CurrentScalars = nullptr;
+
+  if (this->ColorMapTexture)
+  {
+    this->ColorMapTexture->ReleaseGraphicsResources(win);
+    this->ColorMapTexture = nullptr;
+  }
+  this->ColorMapTime = 0;
+}
+
+//----------------------------------------------------------------------------
+void F3DShaderColoring::UpdateTextures(vtkOpenGLRenderWindow* renWin)
+{
+  vtkDataArray* array = this->Array;
+
+  // forget the arrays that were deleted, their address can be reused
+  for (auto it = this->ScalarsCache.begin(); it != this->ScalarsCache.end();)
+  {
+    if (!it->second->Array)
+    {
+      if (it->second->Texture)
+      {
+        it->second->Texture->ReleaseGraphicsResources(renWin);
+      }
+      it->second->Buffer->ReleaseGraphicsResources();
+      it = this->ScalarsCache.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+
+  // the raw values are uploaded once per array, one texel per component
+  std::unique_ptr<Scalars>& scalars = this->ScalarsCache[array];
+  if (!scalars)
+  {
+    scalars = std::make_unique<Scalars>();
+    scalars->Array = array;
+  }
+  if (!scalars->Texture || scalars->Time < array->GetMTime())
+  {
+    vtkIdType nValues = array->GetNumberOfValues();
+    std::vector<float> values(nValues);
+    for (vtkIdType i = 0; i < nValues; i++)
+    {
+      values[i] = static_cast<float>(array->GetVariantValue(i).ToDouble());
+    }
+
+    scalars->Buffer->Upload(values, vtkOpenGLBufferObject::TextureBuffer);
+    if (!scalars->Texture)
+    {
+      scalars->Texture = vtkSmartPointer<vtkTextureObject>::New();
+    }
+    scalars->Texture->SetContext(renWin);
+    scalars->Texture->CreateTextureBuffer(
+      static_cast<unsigned int>(nValues), 1, VTK_FLOAT, scalars->Buffer);
+    scalars->Time = array->GetMTime();
+  }
+  this->CurrentScalars = scalars.get();
+
+  // the lookup table is sampled in the scalar range, the shaders only normalize the values
+  vtkScalarsToColors* lut = this->LookupTable;
+  vtkMTimeType lutTime = lut ? lut->GetMTime() : 0;
+  if (this->ColorMapTexture && this->ColorMapTime >= lutTime &&
+    this->ColorMapRange[0] == this->Range[0] && this->ColorMapRange[1] == this->Range[1])
+  {
+    return;
+  }
+
+  std::vector<unsigned char> colors(4 * ::COLOR_MAP_SIZE, 255);
+  if (lut)
+  {
+    for (int i = 0; i < ::COLOR_MAP_SIZE; i++)
+    {
+      double t = static_cast<double>(i) / (::COLOR_MAP_SIZE - 1);
+      const unsigned char* rgba =
+        lut->MapValue(this->Range[0] + t * (this->Range[1] - this->Range[0]));
+      std::copy(rgba, rgba + 4, colors.begin() + 4 * i);
+    }
+  }
+
+  if (!this->ColorMapTexture)
+  {
+    this->ColorMapTexture = vtkSmartPointer<vtkTextureObject>::New();
+    this->ColorMapTexture->SetContext(renWin);
+    this->ColorMapTexture->SetWrapS(vtkTextureObject::ClampToEdge);
+    this->ColorMapTexture->SetWrapT(vtkTextureObject::ClampToEdge);
+    this->ColorMapTexture->SetMinificationFilter(vtkTextureObject::Linear);
+    this->ColorMapTexture->SetMagnificationFilter(vtkTextureObject::Linear);
+  }
+  this->ColorMapTexture->Create2DFromRaw(
+    ::COLOR_MAP_SIZE, 1, 4, VTK_UNSIGNED_CHAR, colors.data());
+  this->ColorMapTime = lutTime;
+  this->ColorMapRange[0] = this->Range[0];
+  this->ColorMapRange[1] = this->Range[1];
+}
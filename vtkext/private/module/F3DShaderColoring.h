@@ -0,0 +1,120 @@
+/**
+ * @class F3DShaderColoring
+ * @brief Map point scalars to colors in the shaders of a poly data mapper
+ *
+ * The raw values of each colored array are uploaded once in a texture buffer, and kept to switch
+ * between arrays without uploading them again. The lookup table is sampled in a small texture.
+ * The vertex shader normalizes the scalar of each vertex in the range provided as a uniform and
+ * the fragment shader samples the colormap, so changing the array, the component or the range
+ * does not map the scalars on the CPU nor rebuild the vertex buffers.
+ * It is used by vtkF3DPolyDataMapper and by the point sprites helper of vtkF3DPointSplatMapper.
+ */
+#ifndef F3DShaderColoring_h
+#define F3DShaderColoring_h
+
+#include <vtkNew.h>
+#include <vtkOpenGLBufferObject.h>
+#include <vtkShader.h>
+#include <vtkSmartPointer.h>
+#include <vtkTextureObject.h>
+#include <vtkWeakPointer.h>
+
+#include <map>
+#include <memory>
+
+class vtkDataArray;
+class vtkOpenGLRenderWindow;
+class vtkPolyData;
+class vtkScalarsToColors;
+class vtkShaderProgram;
+class vtkWindow;
+
+class F3DShaderColoring
+{
+public:
+  /**
+   * Return true if the scalars can be mapped in the shaders.
+   * Texture buffers are not available with OpenGL ES.
+   */
+  static bool IsSupported();
+
+  /**
+   * Enable or disable the mapping of the scalars in the shaders.
+   * Return true if the shaders of the mapper must be rebuilt.
+   */
+  bool SetEnabled(bool enabled);
+
+  /**
+   * Return true if the mapping of the scalars in the shaders is enabled
+   */
+  bool GetEnabled() const;
+
+  /**
+   * Set the point array mapped to colors, using the vector mode and the vector component of
+   * the lookup table in the provided range. A nullptr array disables the coloring.
+   * Return true if the shaders of the mapper must be rebuilt.
+   */
+  bool SetArray(vtkDataArray* array, vtkScalarsToColors* lut, const double range[2]);
+
+  /**
+   * Return the point array mapped to colors, if any
+   */
+  vtkDataArray* GetArray() const;
+
+  /**
+   * Return true if the scalars of the input are mapped to colors in the shaders
+   */
+  bool IsUsed(vtkPolyData* input) const;
+
+  /**
+   * Add the coloring to the shaders, before the superclass replaces the color tags.
+   * The colors are provided by shadowing the color uniforms at the beginning of the fragment
+   * color implementation, so the code appended by the mappers, eg. the point sprites shapes,
+   * is still applied.
+   */
+  static void ReplaceShaderValues(std::map<vtkShader::Type, vtkShader*> shaders);
+
+  /**
+   * Upload the array and the lookup table if needed, activate the textures and set the uniforms
+   */
+  void SetShaderParameters(vtkShaderProgram* program, vtkOpenGLRenderWindow* renWin);
+
+  /**
+   * Deactivate the textures after drawing
+   */
+  void Deactivate();
+
+  /**
+   * Release the uploaded arrays and the lookup table texture
+   */
+  void ReleaseGraphicsResources(vtkWindow* win);
+
+private:
+  /**
+   * Upload the array if not already uploaded, and the lookup table if modified
+   */
+  void UpdateTextures(vtkOpenGLRenderWindow* renWin);
+
+  struct Scalars
+  {
+    vtkWeakPointer<vtkDataArray> Array;
+    vtkMTimeType Time = 0;
+    vtkNew<vtkOpenGLBufferObject> Buffer;
+    vtkSmartPointer<vtkTextureObject> Texture;
+  };
+
+  bool Enabled = false;
+  vtkWeakPointer<vtkDataArray> Array;
+  vtkWeakPointer<vtkScalarsToColors> LookupTable;
+  double Range[2] = { 0.0, 1.0 };
+
+  // the uploaded arrays are kept to switch between them without uploading them again
+  std::map<vtkDataArray*, std::unique_ptr<Scalars>> ScalarsCache;
+  Scalars* CurrentScalars = nullptr;
+
+  vtkSmartPointer<vtkTextureObject> ColorMapTexture;
+  vtkMTimeType ColorMapTime = 0;
+  double ColorMapRange[2] = { 0.0, 0.0 };
+};
+
+#endif
@@ -0,0 +1,77 @@
+#include "F3DBoundsHierarchy.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <set>
+#include <vector>
+
+int TestF3DBoundsHierarchy(int, char*[])
+{
+  // a row of 100 unit boxes along X
+  std::vector<double> bounds;
+  for (int i = 0; i < 100; i++)
+  {
+    double box[6] = { 2.0 * i, 2.0 * i + 1.0, 0.0, 1.0, 0.0, 1.0 };
+    bounds.insert(bounds.end(), box, box + 6);
+  }
+
+  F3DBoundsHierarchy hierarchy;
+  if (!hierarchy.Update(bounds) || hierarchy.GetNumberOfItems() != 100)
+  {
+    std::cerr << "The hierarchy should be built" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (hierarchy.Update(bounds))
+  {
+    std::cerr << "The hierarchy should not be rebuilt with the same bounds" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // an axis aligned frustum containing the boxes 10 to 19, ie. x in [19.5, 39.5]
+  // clang-format off
+  double planes[24] = {
+     1.0,  0.0,  0.0, -19.5,
+    -1.0,  0.0,  0.0,  39.5,
+     0.0,  1.0,  0.0,  10.0,
+     0.0, -1.0,  0.0,  10.0,
+     0.0,  0.0,  1.0,  10.0,
+     0.0,  0.0, -1.0,  10.0 };
+  // clang-format on
+
+  std::set<int> visited;
+  hierarchy.Traverse(planes, nullptr, [&](int item) { visited.insert(item); });
+  for (int i = 10; i < 20; i++)
+  {
+    if (!visited.count(i))
+    {
+      std::cerr << "The box " << i << " should be in the frustum" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  if (visited.size() > 20)
+  {
+    std::cerr << "Too many boxes visited: " << visited.size() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // discarding all the nodes does not visit any item
+  visited.clear();
+  hierarchy.Traverse(
+    planes, [](const double*) { return false; }, [&](int item) { visited.insert(item); });
+  if (!visited.empty())
+  {
+    std::cerr << "No box should be visited when the nodes are discarded" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  bool inside = false;
+  double box[6] = { 25.0, 26.0, 0.0, 1.0, 0.0, 1.0 };
+  if (F3DBoundsHierarchy::IsOutsideFrustum(planes, box, inside) || !inside)
+  {
+    std::cerr << "The box should be fully inside the frustum" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
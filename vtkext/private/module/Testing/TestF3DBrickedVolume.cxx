@@ -0,0 +1,64 @@
+#include <vtkDataArray.h>
+#include <vtkImageData.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkRTAnalyticSource.h>
+
+#include "vtkF3DBrickedVolume.h"
+
+#include <cmath>
+#include <iostream>
+#include <string>
+
+int TestF3DBrickedVolume(int vtkNotUsed(argc), char* argv[])
+{
+  // 41^3 voxels, streamed from the source by slabs of 16 slices
+  vtkNew<vtkRTAnalyticSource> source;
+  source->SetWholeExtent(-20, 20, -20, 20, -20, 20);
+
+  const std::string pyramidFile = std::string(argv[2]) + "TestF3DBrickedVolume.bricks";
+  if (!vtkF3DBrickedVolume::BuildPyramid(source, pyramidFile, 16))
+  {
+    std::cerr << "Cannot build the volume pyramid" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Without budget, the whole coarsest level is output
+  vtkNew<vtkF3DBrickedVolume> volume;
+  volume->SetFileName(pyramidFile);
+  volume->SetMemoryBudget(0);
+  volume->Update();
+
+  int dims[3];
+  volume->GetOutput()->GetDimensions(dims);
+  if (volume->GetNumberOfLevels() != 3 || volume->GetSelectedLevel() != 2 || dims[0] != 11 ||
+    dims[1] != 11 || dims[2] != 11 || !volume->GetOutput()->GetPointData()->GetArray("RTData"))
+  {
+    std::cerr << "Unexpected coarsest level" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The finest level fits in the budget, it is read back unchanged
+  volume->SetMemoryBudget(1);
+  volume->UpdateSelection(nullptr);
+  volume->Update();
+
+  source->UpdateWholeExtent();
+  vtkImageData* finest = volume->GetOutput();
+  vtkDataArray* values = finest->GetPointData()->GetScalars();
+  vtkDataArray* expected = source->GetOutput()->GetPointData()->GetScalars();
+  double bounds[6];
+  double expectedBounds[6];
+  finest->GetBounds(bounds);
+  source->GetOutput()->GetBounds(expectedBounds);
+  if (volume->GetSelectedLevel() != 0 || finest->GetNumberOfPoints() != 41 * 41 * 41 || !values ||
+    values->GetComponent(1234, 0) != expected->GetComponent(1234, 0) ||
+    std::abs(bounds[0] - expectedBounds[0]) > 1e-6 ||
+    std::abs(bounds[5] - expectedBounds[5]) > 1e-6)
+  {
+    std::cerr << "Unexpected finest level" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,65 @@
+#include <vtkFloatArray.h>
+#include <vtkImageData.h>
+#include <vtkMultiBlockDataSet.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtksys/FStream.hxx>
+
+#include "vtkF3DCachedSpecularTexture.h"
+
+#include <iostream>
+
+int TestF3DCachedSpecularTexture(int argc, char* argv[])
+{
+  std::string cachePath = std::string(argv[2]) + "TestF3DCachedSpecularTexture.bin";
+
+  // two mip levels of a 4x4 cube map
+  vtkNew<vtkMultiBlockDataSet> levels;
+  levels->SetNumberOfBlocks(2);
+  for (unsigned int i = 0; i < 2; i++)
+  {
+    vtkNew<vtkImageData> img;
+    img->SetDimensions(4 >> i, 4 >> i, 6);
+    img->AllocateScalars(VTK_FLOAT, 3);
+    vtkFloatArray::SafeDownCast(img->GetPointData()->GetScalars())->Fill(0.5);
+    levels->SetBlock(i, img);
+  }
+
+  if (!vtkF3DCachedSpecularTexture::WriteCache(cachePath, levels))
+  {
+    std::cerr << "Cannot write the specular cache" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (!vtkF3DCachedSpecularTexture::IsValidCache(cachePath))
+  {
+    std::cerr << "The written specular cache is not valid" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // a cache with trailing data is rejected
+  {
+    vtksys::ofstream file(cachePath.c_str(), std::ios::binary | std::ios::app);
+    file << "garbage";
+  }
+
+  if (vtkF3DCachedSpecularTexture::IsValidCache(cachePath))
+  {
+    std::cerr << "A specular cache with an unexpected size is valid" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // an image with an unexpected type cannot be written
+  vtkNew<vtkImageData> img;
+  img->SetDimensions(4, 4, 6);
+  img->AllocateScalars(VTK_UNSIGNED_CHAR, 3);
+  levels->SetBlock(0, img);
+
+  if (vtkF3DCachedSpecularTexture::WriteCache(cachePath, levels))
+  {
+    std::cerr << "A specular cache with an unexpected type is written" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
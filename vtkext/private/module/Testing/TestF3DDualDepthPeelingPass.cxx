@@ -0,0 +1,100 @@
+#include <vtkActor.h>
+#include <vtkCameraPass.h>
+#include <vtkLightsPass.h>
+#include <vtkNew.h>
+#include <vtkOpaquePass.h>
+#include <vtkPolyDataMapper.h>
+#include <vtkProperty.h>
+#include <vtkRenderPassCollection.h>
+#include <vtkRenderWindow.h>
+#include <vtkRenderer.h>
+#include <vtkSequencePass.h>
+#include <vtkSphereSource.h>
+#include <vtkTranslucentPass.h>
+#include <vtkVolumetricPass.h>
+
+#include "vtkF3DDualDepthPeelingPass.h"
+
+#include <iostream>
+
+int TestF3DDualDepthPeelingPass(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  // three nested translucent spheres, each of them has a front and a back layer
+  vtkNew<vtkRenderer> renderer;
+  for (double radius : { 0.5, 1.0, 1.5 })
+  {
+    vtkNew<vtkSphereSource> sphere;
+    sphere->SetRadius(radius);
+    sphere->SetThetaResolution(32);
+    sphere->SetPhiResolution(32);
+    vtkNew<vtkPolyDataMapper> mapper;
+    mapper->SetInputConnection(sphere->GetOutputPort());
+    vtkNew<vtkActor> actor;
+    actor->SetMapper(mapper);
+    actor->GetProperty()->SetOpacity(0.3);
+    renderer->AddActor(actor);
+  }
+
+  vtkNew<vtkF3DDualDepthPeelingPass> ddpP;
+  vtkNew<vtkTranslucentPass> translucentP;
+  vtkNew<vtkVolumetricPass> volumeP;
+  ddpP->SetTranslucentPass(translucentP);
+  ddpP->SetVolumetricPass(volumeP);
+  ddpP->SetMaximumNumberOfPeels(8);
+
+  vtkNew<vtkLightsPass> lightsP;
+  vtkNew<vtkOpaquePass> opaqueP;
+  vtkNew<vtkRenderPassCollection> collection;
+  collection->AddItem(lightsP);
+  collection->AddItem(opaqueP);
+  collection->AddItem(ddpP);
+  vtkNew<vtkSequencePass> sequence;
+  sequence->SetPasses(collection);
+  vtkNew<vtkCameraPass> camP;
+  camP->SetDelegatePass(sequence);
+  renderer->SetPass(camP);
+
+  vtkNew<vtkRenderWindow> renWin;
+  renWin->SetSize(300, 300);
+  renWin->AddRenderer(renderer);
+  renWin->OffScreenRenderingOn();
+  renderer->ResetCamera();
+  renWin->Render();
+
+  const int peels = ddpP->GetLastNumberOfPeels();
+  if (peels < 1 || peels > 8)
+  {
+    std::cerr << "Unexpected number of peels: " << peels << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (renderer->GetMaximumNumberOfPeels() != 8)
+  {
+    std::cerr << "The maximum number of peels is not set on the renderer" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // the maximum number of peels is never exceeded
+  ddpP->SetMaximumNumberOfPeels(1);
+  renWin->Render();
+  if (ddpP->GetLastNumberOfPeels() > 1)
+  {
+    std::cerr << "The maximum number of peels is exceeded: " << ddpP->GetLastNumberOfPeels()
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // a threshold covering most of the image can only stop the peeling earlier
+  ddpP->SetMaximumNumberOfPeels(8);
+  ddpP->SetOcclusionRatio(0.5);
+  renWin->Render();
+  if (ddpP->GetLastNumberOfPeels() > peels || renderer->GetOcclusionRatio() != 0.5)
+  {
+    std::cerr << "The occlusion ratio does not stop the peeling" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  ddpP->Print(std::cout);
+
+  return EXIT_SUCCESS;
+}
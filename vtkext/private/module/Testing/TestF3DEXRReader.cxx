@@ -25,5 +25,16 @@ int TestF3DEXRReader(int argc, char* argv[])
     return EXIT_FAILURE;
   }
 
+  // a scanline file only has the full resolution level
+  reader->SetLevel(2);
+  reader->Update();
+
+  dims = reader->GetOutput()->GetDimensions();
+  if (dims[0] != 1024 || dims[1] != 512)
+  {
+    std::cerr << "Incorrect EXR image size when reading a level of a scanline file." << std::endl;
+    return EXIT_FAILURE;
+  }
+
   return EXIT_SUCCESS;
 }
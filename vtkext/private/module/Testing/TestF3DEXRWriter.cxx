@@ -0,0 +1,71 @@
+#include <vtkImageData.h>
+#include <vtkNew.h>
+#include <vtkUnsignedCharArray.h>
+
+#include "vtkF3DEXRReader.h"
+#include "vtkF3DEXRWriter.h"
+
+#include <iostream>
+
+int TestF3DEXRWriter(int argc, char* argv[])
+{
+  vtkNew<vtkImageData> img;
+  img->SetDimensions(4, 3, 1);
+  img->AllocateScalars(VTK_FLOAT, 3);
+  float* scalars = static_cast<float*>(img->GetScalarPointer());
+  for (int i = 0; i < 4 * 3 * 3; i++)
+  {
+    scalars[i] = 0.25f * i;
+  }
+
+  std::string filename = std::string(argv[2]) + "/TestF3DEXRWriter.exr";
+  vtkNew<vtkF3DEXRWriter> writer;
+  writer->SetCompression(vtkF3DEXRWriter::PIZ);
+  writer->SetFileName(filename.c_str());
+  writer->SetInputData(img);
+  writer->Write();
+  writer->Print(cout);
+
+  if (writer->GetErrorCode() != 0)
+  {
+    std::cerr << "Cannot write EXR image." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkF3DEXRReader> reader;
+  reader->SetFileName(filename.c_str());
+  reader->Update();
+
+  vtkImageData* output = reader->GetOutput();
+  int* dims = output->GetDimensions();
+  if (dims[0] != 4 || dims[1] != 3)
+  {
+    std::cerr << "Incorrect written EXR image size." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // the values are exactly representable as halves, which the reader converts to
+  float* read = static_cast<float*>(output->GetScalarPointer());
+  for (int i = 0; i < 4 * 3 * 3; i++)
+  {
+    if (read[i] != scalars[i])
+    {
+      std::cerr << "Incorrect written EXR image value at " << i << ": " << read[i] << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // in memory, starting with the magic number
+  writer->WriteToMemoryOn();
+  writer->SetCompression(vtkF3DEXRWriter::DWAA);
+  writer->Write();
+  vtkUnsignedCharArray* result = writer->GetResult();
+  if (writer->GetErrorCode() != 0 || !result || result->GetNumberOfValues() < 4 ||
+    result->GetValue(0) != 0x76 || result->GetValue(1) != 0x2f)
+  {
+    std::cerr << "Cannot write EXR image in memory." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
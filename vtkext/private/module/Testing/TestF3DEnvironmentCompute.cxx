@@ -0,0 +1,129 @@
+#include <vtkFloatArray.h>
+#include <vtkImageData.h>
+#include <vtkNew.h>
+#include <vtkOpenGLRenderWindow.h>
+#include <vtkOpenGLTexture.h>
+#include <vtkPixelBufferObject.h>
+#include <vtkPointData.h>
+#include <vtkRenderer.h>
+#include <vtkShader.h>
+#include <vtkSphericalHarmonics.h>
+#include <vtkTable.h>
+#include <vtkTextureObject.h>
+#include <vtkVersion.h>
+
+#if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240914)
+#include <vtk_glad.h>
+#else
+#include <vtk_glew.h>
+#endif
+
+#include "vtkF3DCachedSpecularTexture.h"
+#include "vtkF3DEnvironmentCompute.h"
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+int TestF3DEnvironmentCompute(int argc, char* argv[])
+{
+  // Turn off VTK error reporting to avoid unwanted failure detection by ctest
+  vtkObject::GlobalWarningDisplayOff();
+
+  // we need an OpenGL context
+  vtkNew<vtkRenderWindow> renWin;
+  vtkNew<vtkRenderer> ren;
+  renWin->AddRenderer(ren);
+  renWin->OffScreenRenderingOn();
+  renWin->Start();
+
+  if (!vtkF3DEnvironmentCompute::IsSupported())
+  {
+    std::cerr << "Compute shaders are not supported on this system, skipping the test.\n";
+    return EXIT_SUCCESS;
+  }
+
+  // a constant environment has a radiance only on the first harmonic, and the same color at
+  // every roughness
+  const double color[3] = { 1.0, 0.5, 0.25 };
+  vtkNew<vtkImageData> img;
+  img->SetDimensions(256, 128, 1);
+  img->AllocateScalars(VTK_FLOAT, 3);
+  vtkFloatArray* scalars = vtkFloatArray::SafeDownCast(img->GetPointData()->GetScalars());
+  for (vtkIdType i = 0; i < scalars->GetNumberOfTuples(); i++)
+  {
+    scalars->SetTuple(i, color);
+  }
+
+  vtkNew<vtkOpenGLTexture> texture;
+  texture->SetInputData(img);
+  texture->SetColorModeToDirectScalars();
+  texture->MipmapOn();
+  texture->InterpolateOn();
+
+  vtkNew<vtkF3DEnvironmentCompute> compute;
+  compute->Print(cout);
+
+  vtkNew<vtkFloatArray> harmonics;
+  if (!compute->ComputeSphericalHarmonics(ren, texture, harmonics) ||
+    harmonics->GetNumberOfTuples() != 9 || harmonics->GetNumberOfComponents() != 3)
+  {
+    std::cerr << "Cannot compute the spherical harmonics" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // same result as the CPU implementation
+  vtkNew<vtkSphericalHarmonics> reference;
+  reference->SetInputData(img);
+  reference->Update();
+  vtkDataArray* expected = vtkTable::SafeDownCast(reference->GetOutputDataObject(0))->GetColumn(0);
+
+  for (int k = 0; k < 9; k++)
+  {
+    for (int c = 0; c < 3; c++)
+    {
+      double value = harmonics->GetComponent(k, c);
+      if (std::abs(value - expected->GetComponent(k, c)) > 1e-2)
+      {
+        std::cerr << "Unexpected spherical harmonic " << k << " component " << c << ": " << value
+                  << " instead of " << expected->GetComponent(k, c) << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  vtkNew<vtkF3DCachedSpecularTexture> specular;
+  specular->SetInputTexture(texture);
+  specular->SetEnvironmentCompute(compute);
+  specular->HalfPrecisionOff();
+  specular->Load(ren);
+
+  vtkTextureObject* prefiltered = specular->GetTextureObject();
+  if (!prefiltered || prefiltered->GetComponents() != 4)
+  {
+    std::cerr << "Cannot prefilter the specular texture" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const unsigned int level = specular->GetPrefilterLevels() - 1;
+  unsigned int dims[2] = { specular->GetPrefilterSize() >> level,
+    specular->GetPrefilterSize() >> level };
+  vtkIdType incr[2] = { 0, 0 };
+  std::vector<float> texels(dims[0] * dims[1] * 4);
+  vtkPixelBufferObject* pbo = prefiltered->Download(GL_TEXTURE_CUBE_MAP_POSITIVE_X, level);
+  pbo->Download2D(VTK_FLOAT, texels.data(), dims, 4, incr);
+  pbo->Delete();
+  specular->PostRender(ren);
+
+  for (int c = 0; c < 3; c++)
+  {
+    if (std::abs(texels[c] - color[c]) > 1e-2)
+    {
+      std::cerr << "Unexpected prefiltered color component " << c << ": " << texels[c]
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
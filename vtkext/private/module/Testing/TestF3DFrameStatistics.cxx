@@ -0,0 +1,84 @@
+#include <vtkNew.h>
+
+#include "vtkF3DFrameStatistics.h"
+
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+bool CheckSummary(const std::string& name, const vtkF3DFrameStatistics::Summary& summary,
+  std::size_t count, double min, double avg, double p95, double p99)
+{
+  auto equal = [](double a, double b) { return std::abs(a - b) < 1e-9; };
+  if (summary.Count != count || !equal(summary.Min, min) || !equal(summary.Average, avg) ||
+    !equal(summary.P95, p95) || !equal(summary.P99, p99))
+  {
+    std::cerr << "Unexpected " << name << " statistics: " << summary.Count << " " << summary.Min
+              << " " << summary.Average << " " << summary.P95 << " " << summary.P99 << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestF3DFrameStatistics(int argc, char* argv[])
+{
+  vtkNew<vtkF3DFrameStatistics> stats;
+  stats->SetWindowSize(100);
+
+  // the first frame is dropped by the sliding window
+  for (int i = 0; i <= 100; i++)
+  {
+    double time = i == 0 ? 1000.0 : static_cast<double>(i);
+
+    // "outer" contains "inner", which is rendered twice
+    stats->BeginPass("outer");
+    stats->BeginPass("inner");
+    stats->EndPass([]() { return 1.0; });
+    stats->BeginPass("inner");
+    stats->EndPass([]() { return 2.0; });
+    stats->EndPass([]() { return 10.0; });
+
+    stats->EndFrame(time, i > 0 && i % 2 == 0 ? time * 2 : -1.0);
+  }
+
+  if (!::CheckSummary("CPU", stats->GetCPUSummary(), 100, 1, 50.5, 95, 99) ||
+    !::CheckSummary("GPU", stats->GetGPUSummary(), 50, 4, 102, 192, 200) ||
+    !::CheckSummary("outer", stats->GetPassSummary("outer"), 100, 7, 7, 7, 7) ||
+    !::CheckSummary("inner", stats->GetPassSummary("inner"), 100, 3, 3, 3, 3) ||
+    !::CheckSummary("missing", stats->GetPassSummary("missing"), 0, 0, 0, 0, 0))
+  {
+    return EXIT_FAILURE;
+  }
+
+  std::vector<std::string> names = stats->GetPassNames();
+  if (names.size() != 2 || names[0] != "outer" || names[1] != "inner")
+  {
+    std::cerr << "Unexpected pass names" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::string json = stats->GetJSON();
+  if (json.find("{\"frames\":100,\"cpu\":{\"min\":1.000,\"avg\":50.500,") != 0 ||
+    json.find("\"passes\":{\"outer\":{\"min\":7.000,") == std::string::npos)
+  {
+    std::cerr << "Unexpected JSON: " << json << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (stats->GetDescription().find("GPU") == std::string::npos)
+  {
+    std::cerr << "Unexpected description: " << stats->GetDescription() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  stats->Reset();
+  if (stats->GetCPUSummary().Count != 0 || !stats->GetPassNames().empty())
+  {
+    std::cerr << "Statistics are not reset" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,98 @@
+#include <vtkActor.h>
+#include <vtkActorCollection.h>
+#include <vtkGLTFImporter.h>
+#include <vtkImageData.h>
+#include <vtkMatrix4x4.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkPolyData.h>
+#include <vtkPolyDataMapper.h>
+#include <vtkProperty.h>
+#include <vtkRenderer.h>
+#include <vtkSphereSource.h>
+#include <vtkTexture.h>
+#include <vtkUnsignedCharArray.h>
+
+#include "vtkF3DGLBWriter.h"
+
+#include <cmath>
+#include <iostream>
+
+int TestF3DGLBWriter(int vtkNotUsed(argc), char* argv[])
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->Update();
+
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(4, 4, 1);
+  vtkNew<vtkUnsignedCharArray> pixels;
+  pixels->SetNumberOfComponents(3);
+  pixels->SetNumberOfTuples(16);
+  pixels->Fill(200);
+  image->GetPointData()->SetScalars(pixels);
+  vtkNew<vtkTexture> texture;
+  texture->SetInputData(image);
+
+  // two actors sharing the sphere, the second one is translated, textured and translucent
+  vtkNew<vtkPolyDataMapper> mapper;
+  mapper->SetInputData(sphere->GetOutput());
+  vtkNew<vtkActor> first;
+  first->SetMapper(mapper);
+  first->GetProperty()->SetMetallic(0.8);
+  vtkNew<vtkActor> second;
+  second->SetMapper(mapper);
+  second->SetPosition(2.0, 0.0, 0.0);
+  second->GetProperty()->SetOpacity(0.5);
+  second->GetProperty()->SetTexture("albedoTex", texture);
+  vtkNew<vtkActor> hidden;
+  hidden->SetMapper(mapper);
+  hidden->VisibilityOff();
+
+  const std::string glbFile = std::string(argv[2]) + "TestF3DGLBWriter.glb";
+  if (!vtkF3DGLBWriter::Write({ first, second, hidden }, glbFile))
+  {
+    std::cerr << "Cannot write the GLB file" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkGLTFImporter> importer;
+  importer->SetFileName(glbFile.c_str());
+  importer->Update();
+
+  vtkActorCollection* actors = importer->GetRenderer()->GetActors();
+  if (actors->GetNumberOfItems() != 2)
+  {
+    std::cerr << "Unexpected number of actors: " << actors->GetNumberOfItems() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkActor* firstRead = vtkActor::SafeDownCast(actors->GetItemAsObject(0));
+  vtkActor* secondRead = vtkActor::SafeDownCast(actors->GetItemAsObject(1));
+  vtkPolyData* surface = vtkPolyDataMapper::SafeDownCast(firstRead->GetMapper())->GetInput();
+  if (surface->GetNumberOfPoints() != sphere->GetOutput()->GetNumberOfPoints() ||
+    surface->GetNumberOfPolys() != sphere->GetOutput()->GetNumberOfPolys() ||
+    !surface->GetPointData()->GetNormals())
+  {
+    std::cerr << "The sphere is not read back" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkMatrix4x4> matrix;
+  secondRead->GetMatrix(matrix);
+  if (std::abs(firstRead->GetProperty()->GetMetallic() - 0.8) > 1e-6 ||
+    std::abs(secondRead->GetProperty()->GetOpacity() - 0.5) > 1e-6 ||
+    matrix->GetElement(0, 3) != 2.0 || !secondRead->GetProperty()->GetTexture("albedoTex"))
+  {
+    std::cerr << "The materials or the matrices are not read back" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // no file is left when it cannot be written
+  if (vtkF3DGLBWriter::Write({ first }, std::string(argv[2]) + "nonExistent/file.glb"))
+  {
+    std::cerr << "A GLB file was written in a non existent directory" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
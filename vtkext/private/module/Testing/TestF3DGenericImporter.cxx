@@ -74,6 +74,21 @@ int TestF3DGenericImporter(int argc, char* argv[])
   }
 #endif
 
+#if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240707)
+  // A cancelled importer fails without reading the file
+  vtkNew<vtkGLTFReader> cancelledReader;
+  cancelledReader->SetFileName((std::string(argv[1]) + "data/BoxAnimated.gltf").c_str());
+
+  vtkNew<vtkF3DGenericImporter> cancelledImporter;
+  cancelledImporter->SetInternalReader(cancelledReader);
+  cancelledImporter->Cancel();
+  if (!cancelledImporter->IsCancelled() || cancelledImporter->Update())
+  {
+    std::cerr << "Unexpected cancelled importer update success" << std::endl;
+    return EXIT_FAILURE;
+  }
+#endif
+
   // Static method testing
   if (vtkF3DGenericImporter::GetDataObjectDescription(nullptr) != "")
   {
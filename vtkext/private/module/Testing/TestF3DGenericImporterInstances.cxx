@@ -0,0 +1,61 @@
+#include <vtkActor.h>
+#include <vtkActorCollection.h>
+#include <vtkInformation.h>
+#include <vtkInformationDoubleVectorKey.h>
+#include <vtkMatrix4x4.h>
+#include <vtkMultiBlockDataSet.h>
+#include <vtkNew.h>
+#include <vtkRenderer.h>
+#include <vtkSphereSource.h>
+#include <vtkTestUtilities.h>
+#include <vtkTrivialProducer.h>
+
+#include "vtkF3DGenericImporter.h"
+
+#include <iostream>
+
+int TestF3DGenericImporterInstances(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->Update();
+
+  // the same sphere is placed twice, the second one is translated
+  vtkNew<vtkMatrix4x4> matrix;
+  matrix->SetElement(0, 3, 2.0);
+
+  vtkNew<vtkMultiBlockDataSet> mb;
+  mb->SetBlock(0, sphere->GetOutput());
+  mb->SetBlock(1, sphere->GetOutput());
+  mb->GetMetaData(1u)->Set(vtkF3DImporter::INSTANCE_MATRIX(), matrix->GetData(), 16);
+
+  vtkNew<vtkTrivialProducer> producer;
+  producer->SetOutput(mb);
+
+  vtkNew<vtkF3DGenericImporter> importer;
+  importer->SetInternalReader(producer);
+  importer->Update();
+
+  vtkActorCollection* actors = importer->GetRenderer()->GetActors();
+  if (actors->GetNumberOfItems() != 2)
+  {
+    std::cerr << "Unexpected number of actors: " << actors->GetNumberOfItems() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkActor* first = vtkActor::SafeDownCast(actors->GetItemAsObject(0));
+  vtkActor* second = vtkActor::SafeDownCast(actors->GetItemAsObject(1));
+  if (first->GetMapper() != second->GetMapper())
+  {
+    std::cerr << "The instances do not share their mapper" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (first->GetUserMatrix() || !second->GetUserMatrix() ||
+    second->GetUserMatrix()->GetElement(0, 3) != 2.0)
+  {
+    std::cerr << "Unexpected instance matrices" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,61 @@
+#include <vtkNew.h>
+#include <vtkRenderWindow.h>
+#include <vtkRenderer.h>
+#include <vtkTextProperty.h>
+
+#include "vtkF3DGlyphTextActor.h"
+
+#include <iostream>
+
+int TestF3DGlyphTextActor(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  vtkNew<vtkF3DGlyphTextActor> actor;
+  actor->SetPosition(10, 10);
+  actor->GetTextProperty()->SetFontSize(15);
+  actor->GetTextProperty()->SetFontFamilyToCourier();
+  actor->SetInput("0 fps");
+
+  vtkNew<vtkRenderer> renderer;
+  renderer->AddActor(actor);
+
+  vtkNew<vtkRenderWindow> renWin;
+  renWin->SetSize(300, 300);
+  renWin->AddRenderer(renderer);
+  renWin->OffScreenRenderingOn();
+  renWin->Render();
+
+  if (actor->GetNumberOfAtlases() != 1)
+  {
+    std::cerr << "The glyph atlas is not rasterized" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // changing the text, even with unsupported characters, reuses the atlas
+  actor->SetInput("60 fps\nLast 100 frames (ms)\n\tCPU \xC2\xB5");
+  renWin->Render();
+  actor->SetInput("");
+  renWin->Render();
+
+  if (actor->GetNumberOfAtlases() != 1)
+  {
+    std::cerr << "The glyph atlas is rasterized again when the text changes" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // a new font needs its own atlas, switching back to the previous font does not
+  actor->SetInput("120 fps");
+  actor->GetTextProperty()->SetFontSize(30);
+  renWin->Render();
+  actor->GetTextProperty()->SetFontSize(15);
+  renWin->Render();
+
+  if (actor->GetNumberOfAtlases() != 2)
+  {
+    std::cerr << "Unexpected number of atlases: " << actor->GetNumberOfAtlases() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  actor->Print(std::cout);
+
+  return EXIT_SUCCESS;
+}
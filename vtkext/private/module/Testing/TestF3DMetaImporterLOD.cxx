@@ -0,0 +1,56 @@
+#include <vtkNew.h>
+#include <vtkPolyData.h>
+#include <vtkQuadricClustering.h>
+#include <vtkRenderWindow.h>
+#include <vtkRenderer.h>
+#include <vtkSphereSource.h>
+#include <vtkTestUtilities.h>
+
+#include "vtkF3DGenericImporter.h"
+#include "vtkF3DMetaImporter.h"
+
+#include <iostream>
+
+int TestF3DMetaImporterLOD(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  // A dense surface gets a proxy, a light one does not
+  vtkNew<vtkSphereSource> denseSphere;
+  denseSphere->SetThetaResolution(800);
+  denseSphere->SetPhiResolution(800);
+  vtkNew<vtkF3DGenericImporter> denseImporter;
+  denseImporter->SetInternalReader(denseSphere);
+
+  vtkNew<vtkSphereSource> lightSphere;
+  vtkNew<vtkF3DGenericImporter> lightImporter;
+  lightImporter->SetInternalReader(lightSphere);
+
+  vtkNew<vtkF3DMetaImporter> importer;
+  importer->AddImporter(denseImporter);
+  importer->AddImporter(lightImporter);
+
+  vtkNew<vtkRenderWindow> window;
+  vtkNew<vtkRenderer> renderer;
+  window->AddRenderer(renderer);
+  importer->SetRenderWindow(window);
+  importer->Update();
+
+  std::vector<vtkF3DMetaImporter::LODStruct>& lods = importer->GetLODActorsAndMappers();
+  if (lods.size() != 1)
+  {
+    std::cerr << "Unexpected number of LOD proxies: " << lods.size() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  importer->BuildLODProxies();
+  lods[0].Proxy.get();
+
+  vtkPolyData* proxy = vtkPolyData::SafeDownCast(lods[0].Decimator->GetOutputDataObject(0));
+  vtkIdType nbCells = lods[0].Surface->GetNumberOfCells();
+  if (!proxy || proxy->GetNumberOfCells() == 0 || proxy->GetNumberOfCells() >= nbCells)
+  {
+    std::cerr << "Unexpected LOD proxy, it should be smaller than the surface" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
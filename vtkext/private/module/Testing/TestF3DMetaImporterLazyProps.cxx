@@ -0,0 +1,78 @@
+#include <vtkNew.h>
+#include <vtkRenderWindow.h>
+#include <vtkRenderer.h>
+#include <vtkSphereSource.h>
+#include <vtkTestUtilities.h>
+
+#include "vtkF3DGenericImporter.h"
+#include "vtkF3DMetaImporter.h"
+
+#include <iostream>
+
+int TestF3DMetaImporterLazyProps(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  vtkNew<vtkSphereSource> sphere;
+  vtkNew<vtkF3DGenericImporter> sphereImporter;
+  sphereImporter->SetInternalReader(sphere);
+
+  vtkNew<vtkF3DMetaImporter> importer;
+  importer->AddImporter(sphereImporter);
+
+  vtkNew<vtkRenderWindow> window;
+  vtkNew<vtkRenderer> renderer;
+  window->AddRenderer(renderer);
+  importer->SetRenderWindow(window);
+  importer->Update();
+
+  // The props are not created by the import
+  const auto& colorings = importer->GetColoringActorsAndMappers();
+  if (colorings.size() != 1 || colorings[0].Actor || colorings[0].Mapper ||
+    !importer->GetPointSpritesActorsAndMappers().empty() ||
+    !importer->GetVolumePropsAndMappers().empty())
+  {
+    std::cerr << "Unexpected props created by the import" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // They are only created once, for the eligible actors
+  if (!importer->CreateColoringActors() || !colorings[0].Actor || !colorings[0].Mapper ||
+    importer->CreateColoringActors())
+  {
+    std::cerr << "Unexpected coloring actors creation" << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (!importer->CreatePointSprites() || importer->CreatePointSprites() ||
+    importer->GetPointSpritesActorsAndMappers().size() != 1)
+  {
+    std::cerr << "Unexpected point sprites creation" << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (importer->CreateVolumes() || !importer->GetVolumePropsAndMappers().empty())
+  {
+    std::cerr << "Unexpected volume created without an image" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The actors imported afterwards get their props on the next creation
+  vtkNew<vtkSphereSource> otherSphere;
+  vtkNew<vtkF3DGenericImporter> otherImporter;
+  otherImporter->SetInternalReader(otherSphere);
+  importer->AddImporter(otherImporter);
+  importer->Update();
+  if (colorings.size() != 2 || colorings[1].Actor || !importer->CreatePointSprites() ||
+    importer->GetPointSpritesActorsAndMappers().size() != 2)
+  {
+    std::cerr << "Unexpected props of the importer added afterwards" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The props of a removed importer are removed with it
+  if (!importer->RemoveImporter(sphereImporter) || colorings.size() != 1 ||
+    importer->GetPointSpritesActorsAndMappers().size() != 1 || !importer->CreateColoringActors())
+  {
+    std::cerr << "Unexpected props after removing an importer" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
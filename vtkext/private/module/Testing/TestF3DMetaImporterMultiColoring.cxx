@@ -1,3 +1,4 @@
+#include <vtkActorCollection.h>
 #include <vtkMathUtilities.h>
 #include <vtkNew.h>
 #include <vtkRenderer.h>
@@ -64,6 +65,24 @@ int TestF3DMetaImporterMultiColoring(int argc, char* argv[])
   importer->SetRenderWindow(window);
   importer->Update();
 
+  // Importers are updated in parallel, check that all props have been moved into the renderer
+  // Each importer provides a geometry actor, the coloring and point sprites actors are only
+  // added once created
+  if (renderer->GetActors()->GetNumberOfItems() != 2)
+  {
+    std::cerr << "Unexpected number of actors in the renderer: "
+              << renderer->GetActors()->GetNumberOfItems() << std::endl;
+    return EXIT_FAILURE;
+  }
+  importer->CreateColoringActors();
+  importer->CreatePointSprites();
+  if (renderer->GetActors()->GetNumberOfItems() != 6)
+  {
+    std::cerr << "Unexpected number of actors in the renderer once props are created: "
+              << renderer->GetActors()->GetNumberOfItems() << std::endl;
+    return EXIT_FAILURE;
+  }
+
   // Test coloring handler
   F3DColoringInfoHandler& coloringHandler = importer->GetColoringInfoHandler();
 
@@ -111,5 +130,19 @@ int TestF3DMetaImporterMultiColoring(int argc, char* argv[])
     return EXIT_FAILURE;
   }
 
+  // Static importers are not updated at a time value and keep their coloring info
+  if (!importer->UpdateAtTimeValue(1.0))
+  {
+    std::cerr << "Unexpected failure to update static importers at a time value" << std::endl;
+    return EXIT_FAILURE;
+  }
+  info = importer->GetColoringInfoHandler().GetCurrentColoringInfo();
+  if (!info.has_value() || info.value().Name != "Momentum" ||
+    info.value().MaximumNumberOfComponents != 3)
+  {
+    std::cerr << "Unexpected coloring after updating at a time value" << std::endl;
+    return EXIT_FAILURE;
+  }
+
   return EXIT_SUCCESS;
 }
@@ -0,0 +1,187 @@
+#include <vtkCellArray.h>
+#include <vtkInformation.h>
+#include <vtkInformationVector.h>
+#include <vtkNew.h>
+#include <vtkObjectFactory.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkPolyDataAlgorithm.h>
+#include <vtkRenderWindow.h>
+#include <vtkRenderer.h>
+#include <vtkStreamingDemandDrivenPipeline.h>
+
+#include "vtkF3DGenericImporter.h"
+#include "vtkF3DMetaImporter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace
+{
+constexpr int NbTimeSteps = 10;
+
+// a time series of NbTimeSteps time steps, the time step i has i + 1 points
+class TimeSeriesSource : public vtkPolyDataAlgorithm
+{
+public:
+  static TimeSeriesSource* New();
+  vtkTypeMacro(TimeSeriesSource, vtkPolyDataAlgorithm);
+
+  // the time it takes to read a time step
+  std::chrono::milliseconds Delay{ 0 };
+
+protected:
+  TimeSeriesSource() { this->SetNumberOfInputPorts(0); }
+
+  int RequestInformation(
+    vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector) override
+  {
+    double timeSteps[NbTimeSteps];
+    for (int i = 0; i < NbTimeSteps; i++)
+    {
+      timeSteps[i] = i;
+    }
+    double timeRange[2] = { 0, NbTimeSteps - 1 };
+
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_STEPS(), timeSteps, NbTimeSteps);
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_RANGE(), timeRange, 2);
+    return 1;
+  }
+
+  int RequestData(
+    vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector) override
+  {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    double time = outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP())
+      ? outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP())
+      : 0;
+    int index = std::clamp(static_cast<int>(std::floor(time)), 0, NbTimeSteps - 1);
+
+    std::this_thread::sleep_for(this->Delay);
+
+    vtkNew<vtkPoints> points;
+    vtkNew<vtkCellArray> verts;
+    for (int i = 0; i <= index; i++)
+    {
+      verts->InsertNextCell(1);
+      verts->InsertCellPoint(points->InsertNextPoint(i, 0, 0));
+    }
+    vtkPolyData* output = vtkPolyData::GetData(outputVector);
+    output->SetPoints(points);
+    output->SetVerts(verts);
+    return 1;
+  }
+};
+vtkStandardNewMacro(TimeSeriesSource);
+
+vtkSmartPointer<vtkF3DGenericImporter> CreateImporter(std::chrono::milliseconds delay)
+{
+  vtkNew<TimeSeriesSource> reader;
+  reader->Delay = delay;
+  vtkNew<TimeSeriesSource> prefetchReader;
+  prefetchReader->Delay = delay;
+
+  vtkSmartPointer<vtkF3DGenericImporter> importer =
+    vtkSmartPointer<vtkF3DGenericImporter>::New();
+  importer->SetInternalReader(reader);
+  importer->SetPrefetchReader(prefetchReader);
+  importer->SetPrefetchCount(2);
+  return importer;
+}
+
+// check the importer shows the time step of the provided time value
+bool CheckTime(vtkF3DGenericImporter* importer, int time, const std::string& label)
+{
+  const std::string expected = "Number of points: " + std::to_string(time + 1) + "\n";
+  if (importer->GetOutputsDescription().find(expected) == std::string::npos)
+  {
+    std::cerr << label << ": the importer did not reach the time " << time
+              << ", its output is:\n"
+              << importer->GetOutputsDescription() << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestF3DMetaImporterPrefetch(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  // a time series much slower to read than the other
+  vtkSmartPointer<vtkF3DGenericImporter> fast = ::CreateImporter(std::chrono::milliseconds(0));
+  vtkSmartPointer<vtkF3DGenericImporter> slow = ::CreateImporter(std::chrono::milliseconds(200));
+
+  vtkNew<vtkF3DMetaImporter> importer;
+  importer->AddImporter(fast);
+  importer->AddImporter(slow);
+
+  vtkNew<vtkRenderWindow> window;
+  vtkNew<vtkRenderer> renderer;
+  window->AddRenderer(renderer);
+  importer->SetRenderWindow(window);
+  importer->Update();
+  fast->EnableAnimation(0);
+  slow->EnableAnimation(0);
+
+  // while playing, the slow time series lags behind
+  importer->SetAsynchronousUpdate(true);
+  for (int time = 1; time <= 4; time++)
+  {
+    if (!importer->UpdateAtTimeValue(time))
+    {
+      std::cerr << "Asynchronous update failed at the time " << time << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  if (!importer->HasPendingUpdate() || !slow->HasPendingUpdate())
+  {
+    std::cerr << "The slow time series is not lagging behind while playing" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // it catches up with the requested time once decoded
+  auto start = std::chrono::steady_clock::now();
+  while (importer->HasPendingUpdate() &&
+    std::chrono::steady_clock::now() - start < std::chrono::seconds(20))
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    importer->UpdateAtTimeValue(4);
+  }
+  if (!::CheckTime(fast, 4, "Playing") || !::CheckTime(slow, 4, "Playing"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // pausing updates the time series lagging behind synchronously, like the animation manager
+  for (int time = 5; time <= 7; time++)
+  {
+    importer->UpdateAtTimeValue(time);
+  }
+  importer->SetAsynchronousUpdate(false);
+  if (importer->HasPendingUpdate() && !importer->UpdateAtTimeValue(7))
+  {
+    std::cerr << "Synchronous update failed when pausing" << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (importer->HasPendingUpdate() || !::CheckTime(fast, 7, "Paused") ||
+    !::CheckTime(slow, 7, "Paused"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // exporting a frame or setting a time is always synchronous, even with time steps pending
+  importer->SetAsynchronousUpdate(true);
+  importer->UpdateAtTimeValue(8);
+  importer->SetAsynchronousUpdate(false);
+  if (!importer->UpdateAtTimeValue(2) || importer->HasPendingUpdate() ||
+    !::CheckTime(fast, 2, "Exported") || !::CheckTime(slow, 2, "Exported"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
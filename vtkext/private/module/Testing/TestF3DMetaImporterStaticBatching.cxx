@@ -0,0 +1,72 @@
+#include <vtkCellData.h>
+#include <vtkNew.h>
+#include <vtkPolyData.h>
+#include <vtkRenderWindow.h>
+#include <vtkRenderer.h>
+#include <vtkSphereSource.h>
+#include <vtkTestUtilities.h>
+
+#include "vtkF3DGenericImporter.h"
+#include "vtkF3DMetaImporter.h"
+
+#include <iostream>
+
+int TestF3DMetaImporterStaticBatching(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  // Two small surfaces with the same material are batched, a dense one is not
+  vtkNew<vtkSphereSource> sphere;
+  vtkNew<vtkF3DGenericImporter> importer1;
+  importer1->SetInternalReader(sphere);
+
+  vtkNew<vtkSphereSource> otherSphere;
+  otherSphere->SetCenter(2, 0, 0);
+  vtkNew<vtkF3DGenericImporter> importer2;
+  importer2->SetInternalReader(otherSphere);
+
+  vtkNew<vtkSphereSource> denseSphere;
+  denseSphere->SetThetaResolution(200);
+  denseSphere->SetPhiResolution(200);
+  vtkNew<vtkF3DGenericImporter> importer3;
+  importer3->SetInternalReader(denseSphere);
+
+  vtkNew<vtkF3DMetaImporter> importer;
+  importer->AddImporter(importer1);
+  importer->AddImporter(importer2);
+  importer->AddImporter(importer3);
+
+  vtkNew<vtkRenderWindow> window;
+  vtkNew<vtkRenderer> renderer;
+  window->AddRenderer(renderer);
+  importer->SetRenderWindow(window);
+  importer->Update();
+
+  importer->BuildStaticBatches();
+
+  const std::vector<vtkF3DMetaImporter::BatchStruct>& batches = importer->GetStaticBatches();
+  if (batches.size() != 1 || batches[0].OriginalActors.size() != 2)
+  {
+    std::cerr << "Unexpected number of static batches: " << batches.size() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkPolyData* batched = batches[0].Mapper->GetInput();
+  vtkIdType nbCells = sphere->GetOutput()->GetNumberOfCells();
+  if (!batched || batched->GetNumberOfCells() != 2 * nbCells ||
+    !batched->GetCellData()->GetArray("BatchedActorId"))
+  {
+    std::cerr << "Unexpected batched surface" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Building again without new importers is a no-op
+  vtkActor* batchActor = batches[0].Actor;
+  importer->BuildStaticBatches();
+  if (importer->GetStaticBatches().size() != 1 ||
+    importer->GetStaticBatches()[0].Actor != batchActor)
+  {
+    std::cerr << "Static batches are built again" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,97 @@
+#include <vtkCellArray.h>
+#include <vtkDataArray.h>
+#include <vtkMath.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkSphereSource.h>
+
+#include "vtkF3DNormalsFilter.h"
+
+#include <cmath>
+#include <iostream>
+
+int TestF3DNormalsFilter(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  // the smooth normals of a sphere are radial
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(64);
+  sphere->SetPhiResolution(64);
+  sphere->GenerateNormalsOff();
+
+  vtkNew<vtkF3DNormalsFilter> normals;
+  normals->SetInputConnection(sphere->GetOutputPort());
+  normals->Update();
+  vtkPolyData* output = normals->GetOutput();
+  vtkDataArray* sphereNormals = output->GetPointData()->GetNormals();
+  if (!sphereNormals || output->GetNumberOfPoints() != sphere->GetOutput()->GetNumberOfPoints())
+  {
+    std::cerr << "The normals of the sphere are not generated" << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (vtkIdType i = 0; i < output->GetNumberOfPoints(); i++)
+  {
+    double point[3];
+    double normal[3];
+    output->GetPoint(i, point);
+    sphereNormals->GetTuple(i, normal);
+    vtkMath::Normalize(point);
+    if (vtkMath::Dot(point, normal) < 0.99)
+    {
+      std::cerr << "The normal of the point " << i << " is not radial" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // a cube made of 8 points
+  vtkNew<vtkPoints> points;
+  for (int i = 0; i < 8; i++)
+  {
+    points->InsertNextPoint(i & 1 ? 1.0 : -1.0, i & 2 ? 1.0 : -1.0, i & 4 ? 1.0 : -1.0);
+  }
+  vtkNew<vtkCellArray> quads;
+  const vtkIdType faces[6][4] = { { 0, 2, 3, 1 }, { 4, 5, 7, 6 }, { 0, 1, 5, 4 }, { 2, 6, 7, 3 },
+    { 0, 4, 6, 2 }, { 1, 3, 7, 5 } };
+  for (const vtkIdType* face : faces)
+  {
+    quads->InsertNextCell(4, face);
+  }
+  vtkNew<vtkPolyData> cube;
+  cube->SetPoints(points);
+  cube->SetPolys(quads);
+
+  // without feature angle, the corners are smoothed along the diagonals
+  normals->SetInputData(cube);
+  normals->Update();
+  double normal[3];
+  normals->GetOutput()->GetPointData()->GetNormals()->GetTuple(7, normal);
+  if (normals->GetOutput()->GetNumberOfPoints() != 8 ||
+    std::abs(normal[0] - 1.0 / std::sqrt(3.0)) > 1e-6)
+  {
+    std::cerr << "The corners of the cube are not smoothed" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // with a feature angle, each face has its own corners
+  normals->SetFeatureAngle(30.0);
+  normals->Update();
+  output = normals->GetOutput();
+  if (output->GetNumberOfPoints() != 24 || output->GetNumberOfPolys() != 6)
+  {
+    std::cerr << "The corners of the cube are not split: " << output->GetNumberOfPoints()
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (vtkIdType i = 0; i < output->GetNumberOfPoints(); i++)
+  {
+    output->GetPointData()->GetNormals()->GetTuple(i, normal);
+    if (std::abs(std::abs(normal[0]) + std::abs(normal[1]) + std::abs(normal[2]) - 1.0) > 1e-6)
+    {
+      std::cerr << "The split normal of the point " << i << " is not a face normal" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,94 @@
+#include <vtkCamera.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkPointSource.h>
+#include <vtkPolyData.h>
+#include <vtkRenderWindow.h>
+#include <vtkRenderer.h>
+#include <vtkUnsignedCharArray.h>
+
+#include "vtkF3DOctreePointCloud.h"
+
+#include <iostream>
+
+int TestF3DOctreePointCloud(int vtkNotUsed(argc), char* argv[])
+{
+  vtkNew<vtkPointSource> source;
+  source->SetNumberOfPoints(200000);
+  source->SetRadius(1.0);
+  source->SetDistributionToUniform();
+  source->Update();
+
+  vtkNew<vtkPolyData> cloud;
+  cloud->ShallowCopy(source->GetOutput());
+  vtkNew<vtkUnsignedCharArray> colors;
+  colors->SetNumberOfComponents(3);
+  colors->SetNumberOfTuples(cloud->GetNumberOfPoints());
+  colors->Fill(128);
+  cloud->GetPointData()->SetScalars(colors);
+
+  const std::string octreeFile = std::string(argv[2]) + "TestF3DOctreePointCloud.octree";
+  if (!vtkF3DOctreePointCloud::BuildOctree(cloud, octreeFile, 10000))
+  {
+    std::cerr << "Cannot build the octree" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkF3DOctreePointCloud> octree;
+  octree->SetFileName(octreeFile);
+  octree->SetPointBudget(1000000);
+  octree->Update();
+
+  vtkPolyData* output = octree->GetOutput();
+  if (octree->GetNumberOfPointsInFile() != 200000 || octree->GetNumberOfNodes() < 9 ||
+    output->GetNumberOfPoints() != 200000 || !output->GetPointData()->GetScalars())
+  {
+    std::cerr << "Unexpected octree output, all the points should be streamed: "
+              << output->GetNumberOfPoints() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The coarsest levels are selected first
+  octree->SetPointBudget(50000);
+  octree->Update();
+  vtkIdType nbPoints = octree->GetOutput()->GetNumberOfPoints();
+  if (nbPoints == 0 || nbPoints > 50000)
+  {
+    std::cerr << "Unexpected number of points for the budget: " << nbPoints << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Nodes outside of the view frustum are not selected
+  vtkNew<vtkRenderWindow> window;
+  vtkNew<vtkRenderer> renderer;
+  window->AddRenderer(renderer);
+  renderer->GetActiveCamera()->SetPosition(0, 0, 10);
+  renderer->GetActiveCamera()->SetFocalPoint(0, 0, 20);
+  octree->SetRenderer(renderer);
+  if (!octree->UpdateSelection())
+  {
+    std::cerr << "The selection should change when looking away" << std::endl;
+    return EXIT_FAILURE;
+  }
+  octree->Update();
+  if (octree->GetOutput()->GetNumberOfPoints() != 0)
+  {
+    std::cerr << "Nodes behind the camera should not be streamed" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Looking at the cloud from afar only needs its coarse levels
+  renderer->GetActiveCamera()->SetPosition(0, 0, 1000);
+  renderer->GetActiveCamera()->SetFocalPoint(0, 0, 0);
+  renderer->ResetCameraClippingRange();
+  octree->UpdateSelection();
+  octree->Update();
+  nbPoints = octree->GetOutput()->GetNumberOfPoints();
+  if (nbPoints == 0 || nbPoints >= 50000)
+  {
+    std::cerr << "Unexpected number of points from afar: " << nbPoints << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
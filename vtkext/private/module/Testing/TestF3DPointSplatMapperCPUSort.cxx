@@ -0,0 +1,178 @@
+#include <vtkActor.h>
+#include <vtkCamera.h>
+#include <vtkFloatArray.h>
+#include <vtkImageData.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkRenderWindow.h>
+#include <vtkRenderWindowInteractor.h>
+#include <vtkRenderer.h>
+#include <vtkShader.h>
+#include <vtkUnsignedCharArray.h>
+#include <vtkWindowToImageFilter.h>
+
+#include "vtkF3DPointSplatMapper.h"
+
+#include <cmath>
+#include <iostream>
+#include <string>
+
+namespace
+{
+// two overlapping layers of opaque at their center gaussians, red in front and blue behind
+vtkSmartPointer<vtkPolyData> CreateLayers()
+{
+  constexpr int res = 10;
+
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkFloatArray> scales;
+  scales->SetName("scale");
+  scales->SetNumberOfComponents(3);
+  vtkNew<vtkFloatArray> rotations;
+  rotations->SetName("rotation");
+  rotations->SetNumberOfComponents(4);
+  vtkNew<vtkUnsignedCharArray> colors;
+  colors->SetName("color");
+  colors->SetNumberOfComponents(3);
+
+  for (int layer = 0; layer < 2; layer++)
+  {
+    for (int j = 0; j < res; j++)
+    {
+      for (int i = 0; i < res; i++)
+      {
+        points->InsertNextPoint(0.1 * i, 0.1 * j, layer == 0 ? 0.5 : -0.5);
+        scales->InsertNextTuple3(0.1, 0.1, 0.1);
+        rotations->InsertNextTuple4(1.0, 0.0, 0.0, 0.0);
+        colors->InsertNextTuple3(layer == 0 ? 255 : 0, 0, layer == 0 ? 0 : 255);
+      }
+    }
+  }
+
+  vtkSmartPointer<vtkPolyData> splats = vtkSmartPointer<vtkPolyData>::New();
+  splats->SetPoints(points);
+  splats->GetPointData()->AddArray(scales);
+  splats->GetPointData()->AddArray(rotations);
+  splats->GetPointData()->SetScalars(colors);
+  return splats;
+}
+
+vtkSmartPointer<vtkImageData> Capture(vtkRenderWindow* renWin)
+{
+  vtkNew<vtkWindowToImageFilter> w2i;
+  w2i->SetInput(renWin);
+  w2i->Update();
+
+  vtkSmartPointer<vtkImageData> image = vtkSmartPointer<vtkImageData>::New();
+  image->DeepCopy(w2i->GetOutput());
+  return image;
+}
+
+// the layer facing the camera must be drawn last, over the other one
+bool CheckFrontLayer(vtkRenderWindow* renWin, bool red, const std::string& label)
+{
+  vtkSmartPointer<vtkImageData> image = ::Capture(renWin);
+  const unsigned char* pixel = static_cast<unsigned char*>(image->GetScalarPointer(150, 150, 0));
+  if (red ? pixel[0] <= pixel[2] : pixel[2] <= pixel[0])
+  {
+    std::cerr << label << ": the back layer is drawn over the front one, the center pixel is "
+              << static_cast<int>(pixel[0]) << ", " << static_cast<int>(pixel[1]) << ", "
+              << static_cast<int>(pixel[2]) << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestF3DPointSplatMapperCPUSort(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  vtkNew<vtkF3DPointSplatMapper> mapper;
+  mapper->SetInputData(::CreateLayers());
+  mapper->SetColorModeToDirectScalars();
+  mapper->EmissiveOff();
+  mapper->SetScaleFactor(1.0);
+  mapper->SetScaleArray("scale");
+  mapper->AnisotropicOn();
+  mapper->SetBoundScale(3.0);
+  mapper->SetRotationArray("rotation");
+  mapper->ComputeSortOff();
+
+  vtkNew<vtkActor> actor;
+  actor->SetMapper(mapper);
+  actor->ForceTranslucentOn();
+
+  vtkNew<vtkRenderer> renderer;
+  renderer->AddActor(actor);
+
+  vtkNew<vtkRenderWindow> renWin;
+  renWin->SetSize(300, 300);
+  renWin->AddRenderer(renderer);
+  renWin->OffScreenRenderingOn();
+
+  vtkNew<vtkRenderWindowInteractor> iren;
+  iren->SetRenderWindow(renWin);
+  iren->SetStillUpdateRate(0.001);
+  renWin->SetDesiredUpdateRate(0.001);
+
+  vtkCamera* camera = renderer->GetActiveCamera();
+  camera->SetFocalPoint(0.45, 0.45, 0.0);
+  camera->SetPosition(0.45, 0.45, 5.0);
+  camera->SetViewUp(0.0, 1.0, 0.0);
+  renderer->ResetCameraClippingRange();
+
+  renWin->Render();
+  if (!::CheckFrontLayer(renWin, true, "Still render from the front"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // the splats are sorted again when the camera looks from the other side
+  camera->SetPosition(0.45, 0.45, -5.0);
+  renderer->ResetCameraClippingRange();
+  renWin->Render();
+  if (!::CheckFrontLayer(renWin, false, "Still render from the back"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // while interacting, the sort runs in the background and the still render waits for it
+  renWin->SetDesiredUpdateRate(30.0);
+  camera->SetPosition(0.45, 0.45, 5.0);
+  renderer->ResetCameraClippingRange();
+  renWin->Render();
+  renWin->SetDesiredUpdateRate(0.001);
+  renWin->Render();
+  if (!::CheckFrontLayer(renWin, true, "Still render after an interaction"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // the CPU sort matches the compute shaders one when they are supported
+  if (vtkShader::IsComputeShaderSupported())
+  {
+    vtkSmartPointer<vtkImageData> cpuSorted = ::Capture(renWin);
+
+    mapper->ComputeSortOn();
+    renWin->Render();
+    vtkSmartPointer<vtkImageData> gpuSorted = ::Capture(renWin);
+
+    vtkUnsignedCharArray* cpuColors =
+      vtkUnsignedCharArray::SafeDownCast(cpuSorted->GetPointData()->GetScalars());
+    vtkUnsignedCharArray* gpuColors =
+      vtkUnsignedCharArray::SafeDownCast(gpuSorted->GetPointData()->GetScalars());
+    vtkIdType differences = 0;
+    for (vtkIdType i = 0; i < cpuColors->GetNumberOfValues(); i++)
+    {
+      differences += std::abs(static_cast<int>(cpuColors->GetValue(i)) - gpuColors->GetValue(i));
+    }
+    if (differences > cpuColors->GetNumberOfValues())
+    {
+      std::cerr << "The CPU sort render differs from the compute shaders one" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
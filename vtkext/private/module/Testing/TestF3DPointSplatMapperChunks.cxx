@@ -0,0 +1,201 @@
+#include <vtkActor.h>
+#include <vtkCamera.h>
+#include <vtkFloatArray.h>
+#include <vtkImageData.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkRenderWindow.h>
+#include <vtkRenderer.h>
+#include <vtkShader.h>
+#include <vtkUnsignedCharArray.h>
+#include <vtkWindowToImageFilter.h>
+
+#include "vtkF3DPointSplatMapper.h"
+
+#include <cmath>
+#include <iostream>
+#include <string>
+
+namespace
+{
+// layers of gaussians with distinct depths, so the sorted order does not depend on the chunks
+vtkSmartPointer<vtkPolyData> CreateSplats()
+{
+  constexpr int res = 32;
+
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkFloatArray> scales;
+  scales->SetName("scale");
+  scales->SetNumberOfComponents(3);
+  vtkNew<vtkFloatArray> rotations;
+  rotations->SetName("rotation");
+  rotations->SetNumberOfComponents(4);
+  vtkNew<vtkUnsignedCharArray> colors;
+  colors->SetName("color");
+  colors->SetNumberOfComponents(3);
+
+  for (int k = 0; k < 4; k++)
+  {
+    for (int j = 0; j < res; j++)
+    {
+      for (int i = 0; i < res; i++)
+      {
+        points->InsertNextPoint(0.1 * i, 0.1 * j, 0.1 * k + 1e-4 * (i + res * j));
+        scales->InsertNextTuple3(0.05, 0.05, 0.05);
+        rotations->InsertNextTuple4(1.0, 0.0, 0.0, 0.0);
+        colors->InsertNextTuple3(8 * i, 8 * j, 64 * k);
+      }
+    }
+  }
+
+  vtkSmartPointer<vtkPolyData> splats = vtkSmartPointer<vtkPolyData>::New();
+  splats->SetPoints(points);
+  splats->GetPointData()->AddArray(scales);
+  splats->GetPointData()->AddArray(rotations);
+  splats->GetPointData()->SetScalars(colors);
+  return splats;
+}
+
+void SetupGaussians(vtkF3DPointSplatMapper* mapper, vtkPolyData* splats)
+{
+  mapper->SetInputData(splats);
+  mapper->SetColorModeToDirectScalars();
+  mapper->EmissiveOff();
+  mapper->SetScaleFactor(1.0);
+  mapper->SetScaleArray("scale");
+  mapper->AnisotropicOn();
+  mapper->SetBoundScale(3.0);
+  mapper->SetRotationArray("rotation");
+}
+
+vtkSmartPointer<vtkImageData> Capture(vtkRenderWindow* renWin)
+{
+  renWin->Render();
+
+  vtkNew<vtkWindowToImageFilter> w2i;
+  w2i->SetInput(renWin);
+  w2i->Update();
+
+  vtkSmartPointer<vtkImageData> image = vtkSmartPointer<vtkImageData>::New();
+  image->DeepCopy(w2i->GetOutput());
+  return image;
+}
+
+// mean absolute difference of the color components, -1 if the images cannot be compared
+double Difference(vtkImageData* a, vtkImageData* b)
+{
+  vtkUnsignedCharArray* colorsA =
+    vtkUnsignedCharArray::SafeDownCast(a->GetPointData()->GetScalars());
+  vtkUnsignedCharArray* colorsB =
+    vtkUnsignedCharArray::SafeDownCast(b->GetPointData()->GetScalars());
+  if (!colorsA || !colorsB || colorsA->GetNumberOfValues() != colorsB->GetNumberOfValues())
+  {
+    return -1.0;
+  }
+
+  double error = 0.0;
+  for (vtkIdType i = 0; i < colorsA->GetNumberOfValues(); i++)
+  {
+    error += std::abs(static_cast<int>(colorsA->GetValue(i)) - colorsB->GetValue(i));
+  }
+  return error / colorsA->GetNumberOfValues();
+}
+}
+
+int TestF3DPointSplatMapperChunks(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  vtkSmartPointer<vtkPolyData> splats = ::CreateSplats();
+
+  // the same splats in a single chunk and in chunks of about 16 splats
+  vtkNew<vtkF3DPointSplatMapper> single;
+  ::SetupGaussians(single, splats);
+  single->SetChunkSize(0);
+
+  vtkNew<vtkF3DPointSplatMapper> chunked;
+  ::SetupGaussians(chunked, splats);
+  chunked->SetChunkSize(16);
+
+  // the actor is moved to check the culling in model coordinates
+  vtkNew<vtkActor> actor;
+  actor->ForceTranslucentOn();
+  actor->SetPosition(10.0, 0.0, 0.0);
+
+  vtkNew<vtkRenderer> renderer;
+  renderer->AddActor(actor);
+
+  vtkNew<vtkRenderWindow> renWin;
+  renWin->SetSize(300, 300);
+  renWin->AddRenderer(renderer);
+  renWin->OffScreenRenderingOn();
+  renWin->Start();
+
+  vtkCamera* camera = renderer->GetActiveCamera();
+  const auto render = [&](vtkF3DPointSplatMapper* mapper, const double position[3],
+                        const double focalPoint[3])
+  {
+    actor->SetMapper(mapper);
+    camera->SetPosition(position[0], position[1], position[2]);
+    camera->SetFocalPoint(focalPoint[0], focalPoint[1], focalPoint[2]);
+    camera->SetViewUp(0.0, 1.0, 0.0);
+    renderer->ResetCameraClippingRange();
+    return ::Capture(renWin);
+  };
+
+  // a close view of a corner, with most of the chunks outside of the frustum, and a view
+  // from the other side, sorted again with another set of visible chunks
+  const double position[2][3] = { { 10.5, 0.5, 2.0 }, { 12.6, 2.6, -2.0 } };
+  const double focalPoint[2][3] = { { 10.5, 0.5, 0.0 }, { 12.6, 2.6, 0.0 } };
+
+  // a view in the opposite direction, where all the chunks are culled
+  const double awayPosition[3] = { 10.5, 0.5, -1.0 };
+  const double awayFocalPoint[3] = { 10.5, 0.5, -5.0 };
+
+  for (bool computeSort : { false, true })
+  {
+    if (computeSort && !vtkShader::IsComputeShaderSupported())
+    {
+      std::cerr << "Compute shaders are not supported on this system, skipping the GPU sort.\n";
+      break;
+    }
+    single->SetComputeSort(computeSort);
+    chunked->SetComputeSort(computeSort);
+    const std::string sort = computeSort ? "GPU sort" : "CPU sort";
+
+    for (int view = 0; view < 2; view++)
+    {
+      vtkSmartPointer<vtkImageData> reference = render(single, position[view], focalPoint[view]);
+      vtkSmartPointer<vtkImageData> culled = render(chunked, position[view], focalPoint[view]);
+
+      double error = ::Difference(reference, culled);
+      if (error < 0.0 || error > 1.0)
+      {
+        std::cerr << "The culled chunks render of view " << view << " with the " << sort
+                  << " differs from the single chunk render: " << error << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    // nothing is drawn when all the chunks are culled, they are drawn again afterwards
+    vtkSmartPointer<vtkImageData> empty = render(single, awayPosition, awayFocalPoint);
+    double error = ::Difference(empty, render(chunked, awayPosition, awayFocalPoint));
+    if (error < 0.0 || error > 1.0)
+    {
+      std::cerr << "Splats are drawn with all the chunks culled with the " << sort << ": "
+                << error << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    vtkSmartPointer<vtkImageData> reference = render(single, position[0], focalPoint[0]);
+    error = ::Difference(reference, render(chunked, position[0], focalPoint[0]));
+    if (error < 0.0 || error > 1.0)
+    {
+      std::cerr << "The chunks are not drawn again after being culled with the " << sort << ": "
+                << error << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
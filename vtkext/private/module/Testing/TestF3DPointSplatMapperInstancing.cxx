@@ -0,0 +1,169 @@
+#include <vtkActor.h>
+#include <vtkFloatArray.h>
+#include <vtkImageData.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkRenderWindow.h>
+#include <vtkRenderer.h>
+#include <vtkShader.h>
+#include <vtkUnsignedCharArray.h>
+#include <vtkWindowToImageFilter.h>
+
+#include "vtkF3DPointSplatMapper.h"
+
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+vtkSmartPointer<vtkImageData> Capture(vtkRenderWindow* renWin)
+{
+  renWin->Render();
+
+  vtkNew<vtkWindowToImageFilter> w2i;
+  w2i->SetInput(renWin);
+  w2i->Update();
+
+  vtkSmartPointer<vtkImageData> image = vtkSmartPointer<vtkImageData>::New();
+  image->DeepCopy(w2i->GetOutput());
+  return image;
+}
+
+// mean absolute difference of the color components, -1 if the images cannot be compared
+double Difference(vtkImageData* a, vtkImageData* b)
+{
+  vtkUnsignedCharArray* colorsA =
+    vtkUnsignedCharArray::SafeDownCast(a->GetPointData()->GetScalars());
+  vtkUnsignedCharArray* colorsB =
+    vtkUnsignedCharArray::SafeDownCast(b->GetPointData()->GetScalars());
+  if (!colorsA || !colorsB || colorsA->GetNumberOfValues() != colorsB->GetNumberOfValues())
+  {
+    return -1.0;
+  }
+
+  double error = 0.0;
+  for (vtkIdType i = 0; i < colorsA->GetNumberOfValues(); i++)
+  {
+    error += std::abs(static_cast<int>(colorsA->GetValue(i)) - colorsB->GetValue(i));
+  }
+  return error / colorsA->GetNumberOfValues();
+}
+
+// a grid of isotropic splats, so the orientation of the gaussians does not matter
+vtkSmartPointer<vtkPolyData> CreateSplats()
+{
+  constexpr int res = 20;
+
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkFloatArray> scales;
+  scales->SetName("scale");
+  scales->SetNumberOfComponents(3);
+  vtkNew<vtkFloatArray> rotations;
+  rotations->SetName("rotation");
+  rotations->SetNumberOfComponents(4);
+
+  for (int k = 0; k < res; k++)
+  {
+    for (int j = 0; j < res; j++)
+    {
+      for (int i = 0; i < res; i++)
+      {
+        points->InsertNextPoint(i / (res - 1.0), j / (res - 1.0), k / (res - 1.0));
+        scales->InsertNextTuple3(0.02, 0.02, 0.02);
+        rotations->InsertNextTuple4(1.0, 0.0, 0.0, 0.0);
+      }
+    }
+  }
+
+  vtkSmartPointer<vtkPolyData> splats = vtkSmartPointer<vtkPolyData>::New();
+  splats->SetPoints(points);
+  splats->GetPointData()->AddArray(scales);
+  splats->GetPointData()->AddArray(rotations);
+  return splats;
+}
+}
+
+int TestF3DPointSplatMapperInstancing(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  vtkNew<vtkF3DPointSplatMapper> mapper;
+  mapper->SetInputData(::CreateSplats());
+  mapper->ScalarVisibilityOff();
+  mapper->EmissiveOff();
+
+  vtkNew<vtkActor> actor;
+  actor->SetMapper(mapper);
+
+  vtkNew<vtkRenderer> renderer;
+  renderer->AddActor(actor);
+
+  vtkNew<vtkRenderWindow> renWin;
+  renWin->SetSize(300, 300);
+  renWin->AddRenderer(renderer);
+  renWin->OffScreenRenderingOn();
+
+  // the spheres, shaded like vtkF3DRenderer does
+  mapper->SetScaleFactor(0.02);
+  mapper->SetSplatShaderCode("//VTK::Color::Impl\n"
+                             "float dist = dot(offsetVCVSOutput.xy, offsetVCVSOutput.xy);\n"
+                             "if (dist > 1.0) {\n"
+                             "  discard;\n"
+                             "} else {\n"
+                             "  float scale = (1.0 - dist);\n"
+                             "  ambientColor *= scale;\n"
+                             "  diffuseColor *= scale;\n"
+                             "}\n");
+  renderer->ResetCamera();
+  vtkSmartPointer<vtkImageData> spheres = ::Capture(renWin);
+
+  // the instances need shader storage buffers, supported with compute shaders
+  if (!vtkShader::IsComputeShaderSupported())
+  {
+    std::cerr << "Compute shaders are not supported on this system, skipping the test.\n";
+    return EXIT_SUCCESS;
+  }
+
+  mapper->InstancingOn();
+  vtkSmartPointer<vtkImageData> instancedSpheres = ::Capture(renWin);
+
+  double error = ::Difference(spheres, instancedSpheres);
+  if (error < 0.0 || error > 16.0)
+  {
+    std::cerr << "The instanced spheres differ from the VTK ones: " << error << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // the gaussians, sorted back to front with the chunks
+  mapper->InstancingOff();
+  mapper->SetScaleFactor(1.0);
+  mapper->SetSplatShaderCode(nullptr);
+  mapper->SetScaleArray("scale");
+  mapper->AnisotropicOn();
+  mapper->SetBoundScale(3.0);
+  mapper->SetRotationArray("rotation");
+  mapper->SetLowpassMatrix(0.3 / (300 * 300), 0.0, 0.3 / (300 * 300));
+  actor->ForceTranslucentOn();
+  vtkSmartPointer<vtkImageData> gaussians = ::Capture(renWin);
+
+  mapper->InstancingOn();
+  vtkSmartPointer<vtkImageData> instancedGaussians = ::Capture(renWin);
+
+  error = ::Difference(gaussians, instancedGaussians);
+  if (error < 0.0 || error > 16.0)
+  {
+    std::cerr << "The instanced gaussians differ from the VTK ones: " << error << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // the VTK helper is used again when the instancing is disabled
+  mapper->InstancingOff();
+  error = ::Difference(gaussians, ::Capture(renWin));
+  if (error < 0.0 || error > 1.0)
+  {
+    std::cerr << "The gaussians differ once the instancing is disabled: " << error << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,76 @@
+#include <vtkActor.h>
+#include <vtkImageData.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkRenderWindow.h>
+#include <vtkRenderer.h>
+#include <vtkTexturedSphereSource.h>
+#include <vtkUnsignedCharArray.h>
+#include <vtkWindowToImageFilter.h>
+
+#include "vtkF3DPolyDataMapper.h"
+
+#include <cmath>
+#include <iostream>
+
+int TestF3DPolyDataMapperCompactVertices(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  vtkNew<vtkTexturedSphereSource> sphere;
+  sphere->SetThetaResolution(64);
+  sphere->SetPhiResolution(64);
+
+  vtkNew<vtkF3DPolyDataMapper> mapper;
+  mapper->SetInputConnection(sphere->GetOutputPort());
+
+  vtkNew<vtkActor> actor;
+  actor->SetMapper(mapper);
+
+  vtkNew<vtkRenderer> renderer;
+  renderer->AddActor(actor);
+
+  vtkNew<vtkRenderWindow> renWin;
+  renWin->SetSize(300, 300);
+  renWin->AddRenderer(renderer);
+  renWin->OffScreenRenderingOn();
+  renWin->Render();
+
+  vtkNew<vtkImageData> reference;
+  {
+    vtkNew<vtkWindowToImageFilter> w2i;
+    w2i->SetInput(renWin);
+    w2i->Update();
+    reference->DeepCopy(w2i->GetOutput());
+  }
+
+  // the compact vertex buffers are decoded in the vertex shader, the render is almost the same
+  mapper->SetCompactVertices(true);
+  renWin->Render();
+
+  vtkNew<vtkWindowToImageFilter> w2i;
+  w2i->SetInput(renWin);
+  w2i->Update();
+
+  vtkUnsignedCharArray* expected =
+    vtkUnsignedCharArray::SafeDownCast(reference->GetPointData()->GetScalars());
+  vtkUnsignedCharArray* actual =
+    vtkUnsignedCharArray::SafeDownCast(w2i->GetOutput()->GetPointData()->GetScalars());
+  if (!expected || !actual || expected->GetNumberOfValues() != actual->GetNumberOfValues())
+  {
+    std::cerr << "Unexpected render of the compact vertices" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  double error = 0.0;
+  for (vtkIdType i = 0; i < actual->GetNumberOfValues(); i++)
+  {
+    error += std::abs(static_cast<int>(actual->GetValue(i)) - expected->GetValue(i));
+  }
+  error /= actual->GetNumberOfValues();
+  if (error > 1.0)
+  {
+    std::cerr << "The compact vertices render differs from the reference: " << error << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,63 @@
+#include <vtkActor.h>
+#include <vtkNew.h>
+#include <vtkPolyDataMapper.h>
+#include <vtkRenderWindow.h>
+#include <vtkRenderer.h>
+#include <vtkSphereSource.h>
+
+#include "vtkF3DPostProcessPass.h"
+#include "vtkF3DRenderPass.h"
+
+#include <iostream>
+
+int TestF3DPostProcessPass(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  vtkNew<vtkSphereSource> sphere;
+  vtkNew<vtkPolyDataMapper> mapper;
+  mapper->SetInputConnection(sphere->GetOutputPort());
+  vtkNew<vtkActor> actor;
+  actor->SetMapper(mapper);
+
+  vtkNew<vtkF3DRenderPass> pass;
+  vtkNew<vtkF3DPostProcessPass> postP;
+  postP->SetDelegatePass(pass);
+  postP->Print(std::cout);
+
+  vtkNew<vtkRenderer> renderer;
+  renderer->AddActor(actor);
+  renderer->SetPass(postP);
+
+  vtkNew<vtkRenderWindow> renWin;
+  renWin->SetSize(200, 200);
+  renWin->AddRenderer(renderer);
+  renWin->OffScreenRenderingOn();
+
+  // every combination of the effects must build a valid shader
+  for (int effects = 0; effects < 8; effects++)
+  {
+    postP->SetUseToneMapping(effects & 1);
+    postP->SetUseFXAA(effects & 2);
+
+    // the user function samples the source with all the redefined functions
+    postP->SetUserShader((effects & 4)
+        ? "vec4 pixel(vec2 uv)\n"
+          "{\n"
+          "  vec4 c = texture(source, uv) + textureLod(source, uv, 0.0);\n"
+          "  c += texelFetch(source, ivec2(uv * vec2(resolution)), 0);\n"
+          "  return vec4(c.rgb / 3.0, 1.0);\n"
+          "}\n"
+        : "");
+    renWin->Render();
+  }
+
+  if (!postP->GetUseToneMapping() || !postP->GetUseFXAA() || postP->GetUserShader().empty())
+  {
+    std::cerr << "The effects are not set" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // render again without changing the effects, the shader is reused
+  renWin->Render();
+
+  return EXIT_SUCCESS;
+}
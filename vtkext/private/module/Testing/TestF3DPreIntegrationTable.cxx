@@ -0,0 +1,62 @@
+#include <vtkColorTransferFunction.h>
+#include <vtkFloatArray.h>
+#include <vtkImageData.h>
+#include <vtkNew.h>
+#include <vtkPiecewiseFunction.h>
+#include <vtkPointData.h>
+#include <vtkVolume.h>
+
+#include "vtkF3DPreIntegrationTable.h"
+
+#include <cmath>
+#include <iostream>
+
+int TestF3DPreIntegrationTable(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  // a sharp colormap, black below 5 and white above, and a constant opacity
+  vtkNew<vtkColorTransferFunction> ctf;
+  ctf->AddRGBPoint(0.0, 0.0, 0.0, 0.0);
+  ctf->AddRGBPoint(4.999, 0.0, 0.0, 0.0);
+  ctf->AddRGBPoint(5.0, 1.0, 1.0, 1.0);
+  ctf->AddRGBPoint(10.0, 1.0, 1.0, 1.0);
+  vtkNew<vtkPiecewiseFunction> otf;
+  otf->AddPoint(0.0, 0.5);
+  otf->AddPoint(10.0, 0.5);
+
+  const double range[2] = { 0.0, 10.0 };
+  vtkSmartPointer<vtkImageData> image =
+    vtkF3DPreIntegrationTable::Compute(ctf, otf, range, 2.0, 1.0, 11);
+
+  int* dims = image->GetDimensions();
+  vtkFloatArray* table = vtkFloatArray::SafeDownCast(image->GetPointData()->GetScalars());
+  if (dims[0] != 11 || dims[1] != 11 || !table || table->GetNumberOfComponents() != 4)
+  {
+    std::cerr << "Unexpected pre-integration table structure" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // the opacity is corrected for a segment twice as long as the unit distance
+  const auto value = [&](int front, int back, int comp)
+  { return table->GetTypedComponent(back * 11 + front, comp); };
+  if (std::abs(value(2, 2, 3) - 0.75) > 1e-3 || std::abs(value(0, 10, 3) - 0.75) > 1e-3)
+  {
+    std::cerr << "Unexpected pre-integrated opacity: " << value(2, 2, 3) << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // the segments crossing the step of the colormap are gray, and do not depend on the direction
+  if (value(2, 2, 0) != 0.f || value(8, 8, 0) != 1.f || value(0, 10, 0) < 0.4f ||
+    value(0, 10, 0) > 0.6f || value(0, 10, 0) != value(10, 0, 0))
+  {
+    std::cerr << "Unexpected pre-integrated color: " << value(0, 10, 0) << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // the shading can be replaced and restored
+  vtkNew<vtkVolume> volume;
+  vtkF3DPreIntegrationTable::SetVolumeShading(volume, true);
+  vtkF3DPreIntegrationTable::SetVolumeShading(volume, true);
+  vtkF3DPreIntegrationTable::SetVolumeShading(volume, false);
+
+  return EXIT_SUCCESS;
+}
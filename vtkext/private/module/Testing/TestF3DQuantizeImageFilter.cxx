@@ -0,0 +1,72 @@
+#include <vtkDoubleArray.h>
+#include <vtkImageData.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkUnsignedCharArray.h>
+#include <vtkUnsignedShortArray.h>
+
+#include "vtkF3DQuantizeImageFilter.h"
+
+#include <iostream>
+#include <string>
+
+int TestF3DQuantizeImageFilter(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(4, 2, 1);
+  vtkNew<vtkDoubleArray> values;
+  values->SetName("Values");
+  values->SetNumberOfComponents(2);
+  values->SetNumberOfTuples(8);
+  for (vtkIdType i = 0; i < 8; i++)
+  {
+    values->SetTypedComponent(i, 0, i * 10.0);
+    values->SetTypedComponent(i, 1, 0.0);
+  }
+  image->GetPointData()->AddArray(values);
+
+  vtkNew<vtkF3DQuantizeImageFilter> quantizer;
+  quantizer->SetInputData(image);
+  quantizer->SetInputArrayToProcess(
+    0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, "Values");
+  quantizer->SetComponent(0);
+  quantizer->SetScalarRange(10.0, 60.0);
+  quantizer->SetOutputScalarType(VTK_UNSIGNED_CHAR);
+  quantizer->Update();
+
+  vtkImageData* output = quantizer->GetOutput();
+  vtkUnsignedCharArray* bytes =
+    vtkUnsignedCharArray::SafeDownCast(output->GetPointData()->GetScalars());
+  if (output->GetNumberOfPoints() != 8 || !bytes || std::string(bytes->GetName()) != "Values")
+  {
+    std::cerr << "The quantized array is missing" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // values out of the range are clamped
+  if (bytes->GetValue(0) != 0 || bytes->GetValue(1) != 0 || bytes->GetValue(2) != 51 ||
+    bytes->GetValue(6) != 255 || bytes->GetValue(7) != 255)
+  {
+    std::cerr << "Unexpected 8-bit values" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // the magnitude is quantized with the full range of 16-bit values
+  quantizer->SetComponent(-1);
+  quantizer->SetScalarRange(0.0, 70.0);
+  quantizer->SetOutputScalarType(VTK_UNSIGNED_SHORT);
+  quantizer->Update();
+
+  vtkUnsignedShortArray* shorts =
+    vtkUnsignedShortArray::SafeDownCast(quantizer->GetOutput()->GetPointData()->GetScalars());
+  double outputRange[2];
+  quantizer->GetOutputRange(outputRange);
+  if (!shorts || shorts->GetValue(0) != 0 || shorts->GetValue(7) != 65535 ||
+    outputRange[1] != 65535.0)
+  {
+    std::cerr << "Unexpected 16-bit values" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
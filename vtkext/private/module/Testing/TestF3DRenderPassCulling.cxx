@@ -0,0 +1,98 @@
+#include <vtkActor.h>
+#include <vtkCamera.h>
+#include <vtkCubeSource.h>
+#include <vtkNew.h>
+#include <vtkPolyDataMapper.h>
+#include <vtkRenderWindow.h>
+#include <vtkRenderWindowInteractor.h>
+#include <vtkRenderer.h>
+#include <vtkSphereSource.h>
+
+#include "vtkF3DRenderPass.h"
+
+#include <iostream>
+
+int TestF3DRenderPassCulling(int argc, char* argv[])
+{
+  vtkNew<vtkF3DRenderPass> pass;
+  pass->SetUseOcclusionCulling(true);
+
+  vtkNew<vtkRenderer> renderer;
+  renderer->SetPass(pass);
+
+  vtkNew<vtkRenderWindow> renWin;
+  renWin->SetSize(300, 300);
+  renWin->AddRenderer(renderer);
+  renWin->OffScreenRenderingOn();
+
+  vtkNew<vtkRenderWindowInteractor> iren;
+  iren->SetRenderWindow(renWin);
+
+  vtkCamera* camera = renderer->GetActiveCamera();
+  camera->SetPosition(0, 0, 5);
+  camera->SetFocalPoint(0, 0, 0);
+  camera->SetClippingRange(0.1, 100);
+
+  // a sphere in front of the camera and another one behind it
+  vtkNew<vtkSphereSource> sphere;
+  vtkNew<vtkPolyDataMapper> sphereMapper;
+  sphereMapper->SetInputConnection(sphere->GetOutputPort());
+
+  vtkNew<vtkActor> frontSphere;
+  frontSphere->SetMapper(sphereMapper);
+  renderer->AddActor(frontSphere);
+
+  vtkNew<vtkActor> backSphere;
+  backSphere->SetMapper(sphereMapper);
+  backSphere->SetPosition(0, 0, 20);
+  renderer->AddActor(backSphere);
+
+  renWin->Render();
+
+  if (pass->GetNumberOfRenderedProps() != 1)
+  {
+    std::cerr << "The sphere behind the camera is not frustum culled: "
+              << pass->GetNumberOfRenderedProps() << " rendered props" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // a wall between the camera and the front sphere
+  renderer->RemoveActor(backSphere);
+
+  vtkNew<vtkCubeSource> cube;
+  cube->SetXLength(4);
+  cube->SetYLength(4);
+  cube->SetCenter(0, 0, 2);
+  vtkNew<vtkPolyDataMapper> cubeMapper;
+  cubeMapper->SetInputConnection(cube->GetOutputPort());
+
+  vtkNew<vtkActor> wall;
+  wall->SetMapper(cubeMapper);
+  renderer->AddActor(wall);
+
+  // simulate an interaction, the first render builds the depth used by the second one
+  iren->SetStillUpdateRate(0.001);
+  renWin->SetDesiredUpdateRate(30.0);
+  renWin->Render();
+  renWin->Render();
+
+  if (pass->GetNumberOfRenderedProps() != 1)
+  {
+    std::cerr << "The sphere behind the wall is not occlusion culled: "
+              << pass->GetNumberOfRenderedProps() << " rendered props" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // the still render does not use occlusion culling
+  renWin->SetDesiredUpdateRate(0.001);
+  renWin->Render();
+
+  if (pass->GetNumberOfRenderedProps() != 2)
+  {
+    std::cerr << "Props are occlusion culled in a still render: "
+              << pass->GetNumberOfRenderedProps() << " rendered props" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
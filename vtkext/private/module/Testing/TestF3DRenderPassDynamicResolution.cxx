@@ -0,0 +1,76 @@
+#include <vtkActor.h>
+#include <vtkCamera.h>
+#include <vtkNew.h>
+#include <vtkPolyDataMapper.h>
+#include <vtkRenderWindow.h>
+#include <vtkRenderWindowInteractor.h>
+#include <vtkRenderer.h>
+#include <vtkSphereSource.h>
+
+#include "vtkF3DRenderPass.h"
+
+#include <iostream>
+
+int TestF3DRenderPassDynamicResolution(int argc, char* argv[])
+{
+  // a frame rate that cannot be reached, so the resolution is always lowered
+  vtkNew<vtkF3DRenderPass> pass;
+  pass->SetDynamicResolutionFrameRate(1e6);
+
+  vtkNew<vtkRenderer> renderer;
+  renderer->SetPass(pass);
+
+  vtkNew<vtkRenderWindow> renWin;
+  renWin->SetSize(300, 300);
+  renWin->AddRenderer(renderer);
+  renWin->OffScreenRenderingOn();
+
+  vtkNew<vtkRenderWindowInteractor> iren;
+  iren->SetRenderWindow(renWin);
+
+  vtkNew<vtkSphereSource> sphere;
+  vtkNew<vtkPolyDataMapper> mapper;
+  mapper->SetInputConnection(sphere->GetOutputPort());
+  vtkNew<vtkActor> actor;
+  actor->SetMapper(mapper);
+  renderer->AddActor(actor);
+  renderer->ResetCamera();
+
+  renWin->Render();
+
+  if (pass->GetResolutionScale() != 1.0)
+  {
+    std::cerr << "A still render is not at full resolution: " << pass->GetResolutionScale()
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // simulate an interaction, the camera moves so that the frames are not reused
+  iren->SetStillUpdateRate(0.001);
+  renWin->SetDesiredUpdateRate(30.0);
+  for (int i = 0; i < 3; i++)
+  {
+    renderer->GetActiveCamera()->Azimuth(10);
+    renWin->Render();
+  }
+
+  if (pass->GetResolutionScale() != 0.25)
+  {
+    std::cerr << "The resolution is not lowered while interacting: "
+              << pass->GetResolutionScale() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // the still render is at full resolution again, even if the camera did not move
+  renWin->SetDesiredUpdateRate(0.001);
+  renWin->Render();
+
+  if (pass->GetResolutionScale() != 1.0)
+  {
+    std::cerr << "The resolution is not restored when the view is still: "
+              << pass->GetResolutionScale() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,165 @@
+#include <vtkActor.h>
+#include <vtkCamera.h>
+#include <vtkCubeSource.h>
+#include <vtkImageData.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkPolyDataMapper.h>
+#include <vtkRenderWindow.h>
+#include <vtkRenderWindowInteractor.h>
+#include <vtkRenderer.h>
+#include <vtkShaderProperty.h>
+#include <vtkSphereSource.h>
+#include <vtkUniforms.h>
+#include <vtkUnsignedCharArray.h>
+#include <vtkWindowToImageFilter.h>
+
+#include "vtkF3DRenderPass.h"
+
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+vtkSmartPointer<vtkImageData> Capture(vtkRenderWindow* renWin)
+{
+  renWin->Render();
+
+  vtkNew<vtkWindowToImageFilter> w2i;
+  w2i->SetInput(renWin);
+  w2i->Update();
+
+  vtkSmartPointer<vtkImageData> image = vtkSmartPointer<vtkImageData>::New();
+  image->DeepCopy(w2i->GetOutput());
+  return image;
+}
+
+// mean absolute difference of the color components, -1 if the images cannot be compared
+double Difference(vtkImageData* a, vtkImageData* b)
+{
+  vtkUnsignedCharArray* colorsA =
+    vtkUnsignedCharArray::SafeDownCast(a->GetPointData()->GetScalars());
+  vtkUnsignedCharArray* colorsB =
+    vtkUnsignedCharArray::SafeDownCast(b->GetPointData()->GetScalars());
+  if (!colorsA || !colorsB || colorsA->GetNumberOfValues() != colorsB->GetNumberOfValues())
+  {
+    return -1.0;
+  }
+
+  double error = 0.0;
+  for (vtkIdType i = 0; i < colorsA->GetNumberOfValues(); i++)
+  {
+    error += std::abs(static_cast<int>(colorsA->GetValue(i)) - colorsB->GetValue(i));
+  }
+  return error / colorsA->GetNumberOfValues();
+}
+
+const unsigned char* CenterPixel(vtkImageData* image)
+{
+  return static_cast<unsigned char*>(image->GetScalarPointer(150, 150, 0));
+}
+}
+
+int TestF3DRenderPassFrameReuse(int argc, char* argv[])
+{
+  vtkNew<vtkF3DRenderPass> pass;
+  pass->SetUseOcclusionCulling(true);
+
+  vtkNew<vtkRenderer> renderer;
+  renderer->SetPass(pass);
+
+  vtkNew<vtkRenderWindow> renWin;
+  renWin->SetSize(300, 300);
+  renWin->AddRenderer(renderer);
+  renWin->OffScreenRenderingOn();
+
+  vtkNew<vtkRenderWindowInteractor> iren;
+  iren->SetRenderWindow(renWin);
+  iren->SetStillUpdateRate(0.001);
+
+  vtkCamera* camera = renderer->GetActiveCamera();
+  camera->SetPosition(0, 0, 5);
+  camera->SetFocalPoint(0, 0, 0);
+  camera->SetClippingRange(0.1, 100);
+
+  // a sphere hidden by a wall
+  vtkNew<vtkSphereSource> sphere;
+  vtkNew<vtkPolyDataMapper> sphereMapper;
+  sphereMapper->SetInputConnection(sphere->GetOutputPort());
+  vtkNew<vtkActor> sphereActor;
+  sphereActor->SetMapper(sphereMapper);
+  renderer->AddActor(sphereActor);
+
+  vtkNew<vtkCubeSource> cube;
+  cube->SetXLength(4);
+  cube->SetYLength(4);
+  cube->SetCenter(0, 0, 2);
+  vtkNew<vtkPolyDataMapper> cubeMapper;
+  cubeMapper->SetInputConnection(cube->GetOutputPort());
+  vtkNew<vtkActor> wall;
+  wall->SetMapper(cubeMapper);
+  renderer->AddActor(wall);
+
+  // while interacting, the wall is moved out of the view, but the sphere is still occlusion
+  // culled using the depth of the previous frame
+  renWin->SetDesiredUpdateRate(30.0);
+  renWin->Render();
+  wall->SetPosition(10, 0, 0);
+  renWin->Render();
+
+  if (pass->GetNumberOfRenderedProps() != 0)
+  {
+    std::cerr << "The sphere is not occlusion culled by the previous frame: "
+              << pass->GetNumberOfRenderedProps() << " rendered props" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // the interaction ends without any change, the still frame must not be the interactive one
+  renWin->SetDesiredUpdateRate(0.001);
+  vtkSmartPointer<vtkImageData> still = ::Capture(renWin);
+
+  if (pass->GetNumberOfRenderedProps() != 1)
+  {
+    std::cerr << "The interactive frame is reused as the still frame: "
+              << pass->GetNumberOfRenderedProps() << " rendered props" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // a full still render of the same view is the baseline
+  renderer->Modified();
+  vtkSmartPointer<vtkImageData> baseline = ::Capture(renWin);
+
+  double error = ::Difference(still, baseline);
+  if (error < 0.0 || error > 1.0)
+  {
+    std::cerr << "The still frame after the interaction differs from a still render: " << error
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // the animations only modify the custom uniforms of the shaders, the frame is not reused
+  renderer->RemoveActor(wall);
+  vtkShaderProperty* shaderProperty = sphereActor->GetShaderProperty();
+  shaderProperty->AddFragmentShaderReplacement("//VTK::Light::Impl", true,
+    "//VTK::Light::Impl\n  gl_FragData[0] = vec4(tint, 1.0);\n", false);
+  float red[3] = { 1.0, 0.0, 0.0 };
+  shaderProperty->GetFragmentCustomUniforms()->SetUniform3f("tint", red);
+  vtkSmartPointer<vtkImageData> redSphere = ::Capture(renWin);
+
+  float blue[3] = { 0.0, 0.0, 1.0 };
+  shaderProperty->GetFragmentCustomUniforms()->SetUniform3f("tint", blue);
+  vtkSmartPointer<vtkImageData> blueSphere = ::Capture(renWin);
+
+  const unsigned char* redPixel = ::CenterPixel(redSphere);
+  const unsigned char* bluePixel = ::CenterPixel(blueSphere);
+  if (redPixel[0] <= redPixel[2] || bluePixel[2] <= bluePixel[0])
+  {
+    std::cerr << "The frame is reused when a custom uniform is modified, the center pixels are "
+              << static_cast<int>(redPixel[0]) << ", " << static_cast<int>(redPixel[2])
+              << " and " << static_cast<int>(bluePixel[0]) << ", "
+              << static_cast<int>(bluePixel[2]) << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
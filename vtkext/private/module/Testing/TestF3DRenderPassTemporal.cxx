@@ -0,0 +1,69 @@
+#include <vtkActor.h>
+#include <vtkCamera.h>
+#include <vtkNew.h>
+#include <vtkPolyDataMapper.h>
+#include <vtkRenderWindow.h>
+#include <vtkRenderWindowInteractor.h>
+#include <vtkRenderer.h>
+#include <vtkSphereSource.h>
+
+#include "vtkF3DRenderPass.h"
+
+#include <iostream>
+
+int TestF3DRenderPassTemporal(int argc, char* argv[])
+{
+  vtkNew<vtkF3DRenderPass> pass;
+  pass->SetUseTAAPass(true);
+
+  vtkNew<vtkRenderer> renderer;
+  renderer->SetPass(pass);
+
+  vtkNew<vtkRenderWindow> renWin;
+  renWin->SetSize(300, 300);
+  renWin->AddRenderer(renderer);
+  renWin->OffScreenRenderingOn();
+
+  vtkNew<vtkRenderWindowInteractor> iren;
+  iren->SetRenderWindow(renWin);
+
+  vtkNew<vtkSphereSource> sphere;
+  vtkNew<vtkPolyDataMapper> mapper;
+  mapper->SetInputConnection(sphere->GetOutputPort());
+  vtkNew<vtkActor> actor;
+  actor->SetMapper(mapper);
+  renderer->AddActor(actor);
+  renderer->ResetCamera();
+
+  // the history is reprojected while the camera moves
+  iren->SetStillUpdateRate(0.001);
+  renWin->SetDesiredUpdateRate(30.0);
+  for (int i = 0; i < 4; i++)
+  {
+    renderer->GetActiveCamera()->Azimuth(5);
+    renWin->Render();
+  }
+
+  // once still, a bounded number of frames converge the history
+  renWin->SetDesiredUpdateRate(0.001);
+  int renders = 0;
+  do
+  {
+    renWin->Render();
+    renders++;
+  } while (pass->IsAccumulating() && renders < 100);
+
+  if (pass->IsAccumulating())
+  {
+    std::cerr << "The temporal anti-aliasing does not converge once still" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (renders < 2)
+  {
+    std::cerr << "The temporal anti-aliasing does not accumulate the still frames" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,82 @@
+#include <vtkNew.h>
+#include <vtkRenderWindow.h>
+#include <vtkTestUtilities.h>
+#include <vtkXMLImageDataReader.h>
+#include <vtkXMLUnstructuredGridReader.h>
+
+#include "vtkF3DGenericImporter.h"
+#include "vtkF3DRenderer.h"
+
+#include <iostream>
+
+int TestF3DRendererLazyProps(int argc, char* argv[])
+{
+  vtkNew<vtkF3DRenderer> renderer;
+  vtkNew<vtkF3DMetaImporter> importer;
+  vtkNew<vtkRenderWindow> window;
+
+  window->AddRenderer(renderer);
+  importer->SetRenderWindow(window);
+  renderer->SetImporter(importer);
+
+  vtkNew<vtkXMLUnstructuredGridReader> readerVTU;
+  std::string filename = std::string(argv[1]) + "data/bluntfin_t.vtu";
+  readerVTU->SetFileName(filename.c_str());
+  vtkNew<vtkF3DGenericImporter> importerVTU;
+  importerVTU->SetInternalReader(readerVTU);
+
+  vtkNew<vtkXMLImageDataReader> readerVTI;
+  filename = std::string(argv[1]) + "data/waveletArrays.vti";
+  readerVTI->SetFileName(filename.c_str());
+  vtkNew<vtkF3DGenericImporter> importerVTI;
+  importerVTI->SetInternalReader(readerVTI);
+
+  importer->AddImporter(importerVTU);
+  importer->AddImporter(importerVTI);
+  importer->Update();
+
+  // Without coloring, point sprites nor volume, only the imported actors are shown
+  renderer->UpdateActors();
+  const auto& colorings = importer->GetColoringActorsAndMappers();
+  if (colorings.size() != 2 || colorings[0].Actor || colorings[1].Actor ||
+    !importer->GetPointSpritesActorsAndMappers().empty() ||
+    !importer->GetVolumePropsAndMappers().empty())
+  {
+    std::cerr << "Unexpected props created before being shown" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The coloring actors are created and shown when coloring is enabled
+  renderer->SetEnableColoring(true);
+  renderer->SetArrayNameForColoring("Momentum");
+  renderer->UpdateActors();
+  if (!colorings[0].Actor || !colorings[0].Actor->GetVisibility() ||
+    colorings[0].OriginalActor->GetVisibility() ||
+    !importer->GetPointSpritesActorsAndMappers().empty())
+  {
+    std::cerr << "Unexpected coloring actors once coloring is enabled" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The point sprites are created and shown, for all actors, when enabled
+  renderer->SetUsePointSprites(true);
+  renderer->UpdateActors();
+  const auto& pointSprites = importer->GetPointSpritesActorsAndMappers();
+  if (pointSprites.size() != 2 || !pointSprites[0].Actor->GetVisibility() ||
+    colorings[0].Actor->GetVisibility() || !importer->GetVolumePropsAndMappers().empty())
+  {
+    std::cerr << "Unexpected point sprites once enabled" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The volume is only created for the image
+  renderer->SetUseVolume(true);
+  renderer->UpdateActors();
+  if (importer->GetVolumePropsAndMappers().size() != 1 || pointSprites[0].Actor->GetVisibility())
+  {
+    std::cerr << "Unexpected volumes once enabled" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
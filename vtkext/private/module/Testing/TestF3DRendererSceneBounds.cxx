@@ -0,0 +1,150 @@
+#include <vtkGLTFReader.h>
+#include <vtkNew.h>
+#include <vtkRenderWindow.h>
+#include <vtkTestUtilities.h>
+
+#include "vtkF3DGenericImporter.h"
+#include "vtkF3DMemoryMesh.h"
+#include "vtkF3DRenderer.h"
+
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <map>
+#include <vector>
+
+int TestF3DRendererSceneBounds(int vtkNotUsed(argc), char* argv[])
+{
+  vtkNew<vtkF3DRenderer> renderer;
+  vtkNew<vtkF3DMetaImporter> importer;
+  vtkNew<vtkRenderWindow> window;
+  window->AddRenderer(renderer);
+  importer->SetRenderWindow(window);
+  renderer->SetImporter(importer);
+
+  vtkNew<vtkF3DMemoryMesh> mesh;
+  mesh->SetPoints({ 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 1.f, 0.f });
+  mesh->SetFaces({ 3 }, { 0, 1, 2 });
+  vtkNew<vtkF3DGenericImporter> meshImporter;
+  meshImporter->SetInternalReader(mesh);
+  importer->AddImporter(meshImporter);
+  importer->Update();
+  renderer->UpdateActors();
+
+  auto checkBounds = [&](double xmin, const std::string& step)
+  {
+    double bounds[6];
+    renderer->GetSceneBounds(bounds);
+    if (bounds[0] != xmin || bounds[1] != xmin + 1.0)
+    {
+      std::cerr << "Unexpected scene bounds " << step << ": " << bounds[0] << ", " << bounds[1]
+                << std::endl;
+      return false;
+    }
+    return true;
+  };
+  if (!checkBounds(0.0, "once imported"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // The bounds follow each modification of the geometry in place
+  importer->SetImporterDynamic(meshImporter);
+  for (float x : { 10.f, 20.f })
+  {
+    mesh->SetPoints({ x, 0.f, 0.f, x + 1.f, 0.f, 0.f, x, 1.f, 0.f });
+    importer->DataModified();
+    if (!checkBounds(x, "after moving the points"))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  // An animated box next to the mesh, the bounds of each time value are cached
+  vtkNew<vtkGLTFReader> reader;
+  std::string filename = std::string(argv[1]) + "data/BoxAnimated.gltf";
+  reader->SetFileName(filename.c_str());
+  reader->UpdateInformation();
+  reader->EnableAnimation(0);
+  vtkNew<vtkF3DGenericImporter> animatedImporter;
+  animatedImporter->SetInternalReader(reader);
+  importer->AddImporter(animatedImporter);
+  importer->Update();
+  renderer->UpdateActors();
+
+  // the cached bounds must always be the ones of the props at this time value
+  using Bounds = std::array<double, 6>;
+  auto checkTimeBounds = [&](Bounds& bounds, const std::string& step)
+  {
+    renderer->GetSceneBounds(bounds.data());
+    const double* propsBounds = renderer->ComputeVisiblePropBounds();
+    if (!std::equal(bounds.begin(), bounds.end(), propsBounds))
+    {
+      std::cerr << "Unexpected scene bounds " << step << ": " << bounds[0] << ", " << bounds[1]
+                << ", " << bounds[2] << ", " << bounds[3] << ", " << bounds[4] << ", "
+                << bounds[5] << " instead of " << propsBounds[0] << ", " << propsBounds[1]
+                << ", " << propsBounds[2] << ", " << propsBounds[3] << ", " << propsBounds[4]
+                << ", " << propsBounds[5] << std::endl;
+      return false;
+    }
+    return true;
+  };
+
+  const std::vector<double> timeValues = { 0.0, 0.5, 1.0, 1.5, 2.0 };
+  std::map<double, Bounds> timeBounds;
+  for (bool loop : { false, true })
+  {
+    for (double timeValue : timeValues)
+    {
+      if (!importer->UpdateAtTimeValue(timeValue))
+      {
+        std::cerr << "Cannot update at time value " << timeValue << std::endl;
+        return EXIT_FAILURE;
+      }
+      Bounds bounds;
+      if (!checkTimeBounds(bounds, loop ? "when looping" : "at a new time value"))
+      {
+        return EXIT_FAILURE;
+      }
+      if (loop && bounds != timeBounds[timeValue])
+      {
+        std::cerr << "The bounds of time value " << timeValue << " changed when looping"
+                  << std::endl;
+        return EXIT_FAILURE;
+      }
+      timeBounds[timeValue] = bounds;
+    }
+  }
+
+  if (std::all_of(timeBounds.begin(), timeBounds.end(),
+        [&](const auto& pair) { return pair.second == timeBounds.begin()->second; }))
+  {
+    std::cerr << "The scene bounds do not change between time values" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Moving the mesh outdates the bounds cached for all the time values
+  mesh->SetPoints({ 100.f, 0.f, 0.f, 101.f, 0.f, 0.f, 100.f, 1.f, 0.f });
+  importer->DataModified();
+  for (double timeValue : timeValues)
+  {
+    if (!importer->UpdateAtTimeValue(timeValue))
+    {
+      std::cerr << "Cannot update at time value " << timeValue << std::endl;
+      return EXIT_FAILURE;
+    }
+    Bounds bounds;
+    if (!checkTimeBounds(bounds, "after moving the points"))
+    {
+      return EXIT_FAILURE;
+    }
+    if (bounds[1] != 101.0 || bounds == timeBounds[timeValue])
+    {
+      std::cerr << "The bounds of time value " << timeValue
+                << " are not updated after moving the points" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
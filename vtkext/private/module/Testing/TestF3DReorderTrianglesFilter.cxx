@@ -0,0 +1,117 @@
+#include <vtkCellArray.h>
+#include <vtkCellArrayIterator.h>
+#include <vtkCellData.h>
+#include <vtkIdList.h>
+#include <vtkIntArray.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkPolyData.h>
+#include <vtkSphereSource.h>
+
+#include "vtkF3DReorderTrianglesFilter.h"
+
+#include <algorithm>
+#include <deque>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace
+{
+// Average number of vertices transformed per triangle with a FIFO cache
+double GetCacheMissRatio(vtkPolyData* surface, size_t cacheSize)
+{
+  std::deque<vtkIdType> cache;
+  vtkIdType misses = 0;
+  auto iter = vtk::TakeSmartPointer(surface->GetPolys()->NewIterator());
+  for (iter->GoToFirstCell(); !iter->IsDoneWithTraversal(); iter->GoToNextCell())
+  {
+    vtkIdList* ids = iter->GetCurrentCell();
+    for (vtkIdType id : *ids)
+    {
+      if (std::find(cache.begin(), cache.end(), id) == cache.end())
+      {
+        misses++;
+        cache.push_back(id);
+        if (cache.size() > cacheSize)
+        {
+          cache.pop_front();
+        }
+      }
+    }
+  }
+  return static_cast<double>(misses) / surface->GetNumberOfPolys();
+}
+}
+
+int TestF3DReorderTrianglesFilter(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(100);
+  sphere->SetPhiResolution(100);
+  sphere->Update();
+  vtkPolyData* input = sphere->GetOutput();
+
+  // shuffle the triangles like a scanned mesh, each one keeps its index as cell data
+  std::vector<vtkIdType> order(input->GetNumberOfPolys());
+  std::iota(order.begin(), order.end(), 0);
+  std::shuffle(order.begin(), order.end(), std::mt19937(0));
+  vtkNew<vtkCellArray> shuffled;
+  vtkNew<vtkIntArray> triangleIds;
+  triangleIds->SetName("triangle");
+  vtkNew<vtkIdList> ids;
+  for (vtkIdType t : order)
+  {
+    input->GetCellPoints(t, ids);
+    shuffled->InsertNextCell(ids);
+    triangleIds->InsertNextValue(static_cast<int>(t));
+  }
+  vtkNew<vtkPolyData> scanned;
+  scanned->SetPoints(input->GetPoints());
+  scanned->GetPointData()->ShallowCopy(input->GetPointData());
+  scanned->SetPolys(shuffled);
+  scanned->GetCellData()->AddArray(triangleIds);
+
+  vtkNew<vtkF3DReorderTrianglesFilter> reorder;
+  reorder->SetInputData(scanned);
+  reorder->Update();
+  vtkPolyData* output = reorder->GetOutput();
+
+  if (output->GetNumberOfPolys() != scanned->GetNumberOfPolys() ||
+    output->GetNumberOfPoints() != scanned->GetNumberOfPoints() ||
+    !output->GetPointData()->GetNormals() || !output->GetCellData()->GetArray("triangle"))
+  {
+    std::cerr << "The surface is not preserved" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // the first triangle of the output is the same triangle of the input, with its cell data
+  vtkIdType triangle =
+    static_cast<vtkIdType>(output->GetCellData()->GetArray("triangle")->GetTuple1(0));
+  vtkNew<vtkIdList> outputIds;
+  output->GetCellPoints(0, outputIds);
+  input->GetCellPoints(triangle, ids);
+  for (int c = 0; c < 3; c++)
+  {
+    double expected[3];
+    double actual[3];
+    input->GetPoint(ids->GetId(c), expected);
+    output->GetPoint(outputIds->GetId(c), actual);
+    if (!std::equal(expected, expected + 3, actual))
+    {
+      std::cerr << "The reordered triangles do not match the input" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  double before = ::GetCacheMissRatio(scanned, 16);
+  double after = ::GetCacheMissRatio(output, 16);
+  if (after > 1.0 || after >= before)
+  {
+    std::cerr << "Unexpected cache miss ratio: " << before << " -> " << after << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,48 @@
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkPolyData.h>
+#include <vtkSphereSource.h>
+
+#include "vtkF3DSimplifyFilter.h"
+
+#include <iostream>
+
+int TestF3DSimplifyFilter(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(400);
+  sphere->SetPhiResolution(400);
+  sphere->Update();
+  const vtkIdType nbTriangles = sphere->GetOutput()->GetNumberOfPolys();
+
+  vtkNew<vtkF3DSimplifyFilter> simplifier;
+  simplifier->SetInputConnection(sphere->GetOutputPort());
+
+  // the input is passed through when it fits in the budget
+  simplifier->SetTargetNumberOfTriangles(nbTriangles);
+  simplifier->Update();
+  if (simplifier->GetOutput()->GetNumberOfPolys() != nbTriangles)
+  {
+    std::cerr << "A surface fitting in the budget is simplified" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  constexpr vtkIdType target = 5000;
+  simplifier->SetTargetNumberOfTriangles(target);
+  simplifier->Update();
+  vtkPolyData* output = simplifier->GetOutput();
+  const vtkIdType nbSimplified = output->GetNumberOfPolys();
+  if (nbSimplified > target || nbSimplified < target / 2)
+  {
+    std::cerr << "Unexpected number of simplified triangles: " << nbSimplified << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (!output->GetPointData()->GetNormals())
+  {
+    std::cerr << "The normals are not kept" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,95 @@
+#include <vtkActor.h>
+#include <vtkActorCollection.h>
+#include <vtkImageData.h>
+#include <vtkMatrix4x4.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkPolyData.h>
+#include <vtkPolyDataMapper.h>
+#include <vtkProperty.h>
+#include <vtkRenderer.h>
+#include <vtkSphereSource.h>
+#include <vtkTexture.h>
+#include <vtkUnsignedCharArray.h>
+
+#include "vtkF3DSnapshotImporter.h"
+
+#include <iostream>
+
+int TestF3DSnapshotImporter(int vtkNotUsed(argc), char* argv[])
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->Update();
+
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(4, 4, 1);
+  vtkNew<vtkUnsignedCharArray> pixels;
+  pixels->SetNumberOfComponents(3);
+  pixels->SetNumberOfTuples(16);
+  pixels->Fill(200);
+  image->GetPointData()->SetScalars(pixels);
+  vtkNew<vtkTexture> texture;
+  texture->SetInputData(image);
+  texture->UseSRGBColorSpaceOn();
+
+  // two actors sharing the sphere, the second one is translated and textured
+  vtkNew<vtkPolyDataMapper> mapper;
+  mapper->SetInputData(sphere->GetOutput());
+  vtkNew<vtkActor> first;
+  first->SetMapper(mapper);
+  first->GetProperty()->SetMetallic(0.8);
+  vtkNew<vtkActor> second;
+  second->SetMapper(mapper);
+  second->SetPosition(2.0, 0.0, 0.0);
+  second->GetProperty()->SetTexture("albedoTex", texture);
+
+  const std::string snapshotFile = std::string(argv[2]) + "TestF3DSnapshotImporter.f3dsnap";
+  if (!vtkF3DSnapshotImporter::Write({ first, second }, snapshotFile) ||
+    !vtkF3DSnapshotImporter::CanReadFile(snapshotFile))
+  {
+    std::cerr << "Cannot write the snapshot" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkF3DSnapshotImporter> importer;
+  importer->SetFileName(snapshotFile);
+  importer->Update();
+
+  vtkActorCollection* actors = importer->GetRenderer()->GetActors();
+  if (actors->GetNumberOfItems() != 2)
+  {
+    std::cerr << "Unexpected number of actors: " << actors->GetNumberOfItems() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkActor* firstRead = vtkActor::SafeDownCast(actors->GetItemAsObject(0));
+  vtkActor* secondRead = vtkActor::SafeDownCast(actors->GetItemAsObject(1));
+  vtkPolyData* surface = vtkPolyDataMapper::SafeDownCast(firstRead->GetMapper())->GetInput();
+  if (surface != vtkPolyDataMapper::SafeDownCast(secondRead->GetMapper())->GetInput() ||
+    surface->GetNumberOfPoints() != sphere->GetOutput()->GetNumberOfPoints() ||
+    surface->GetNumberOfCells() != sphere->GetOutput()->GetNumberOfCells() ||
+    !surface->GetPointData()->GetNormals())
+  {
+    std::cerr << "The sphere is not read back as a single shared surface" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkTexture* textureRead = secondRead->GetProperty()->GetTexture("albedoTex");
+  if (firstRead->GetProperty()->GetMetallic() != 0.8 ||
+    secondRead->GetMatrix()->GetElement(0, 3) != 2.0 || !textureRead ||
+    !textureRead->GetUseSRGBColorSpace() ||
+    textureRead->GetInput()->GetPointData()->GetScalars()->GetComponent(5, 1) != 200)
+  {
+    std::cerr << "The materials or the matrices are not read back" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // other files are not snapshots
+  if (vtkF3DSnapshotImporter::CanReadFile(std::string(argv[1]) + "data/cow.vtp"))
+  {
+    std::cerr << "A VTP file should not be read as a snapshot" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
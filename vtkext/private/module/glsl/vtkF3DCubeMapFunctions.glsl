@@ -0,0 +1,32 @@
+// Direction of a point of a cube map face, st being its coordinates in [-1, 1], following the
+// orientation of the faces of the OpenGL cube map lookups
+vec3 f3dCubeMapDirection(int face, vec2 st)
+{
+  if (face == 0)
+  {
+    return vec3(1.0, -st.y, -st.x);
+  }
+  if (face == 1)
+  {
+    return vec3(-1.0, -st.y, st.x);
+  }
+  if (face == 2)
+  {
+    return vec3(st.x, 1.0, st.y);
+  }
+  if (face == 3)
+  {
+    return vec3(st.x, -1.0, -st.y);
+  }
+  if (face == 4)
+  {
+    return vec3(st.x, -st.y, 1.0);
+  }
+  return vec3(-st.x, -st.y, -1.0);
+}
+
+// Coordinates in [-1, 1] of the center of a texel of a cube map face
+vec2 f3dCubeMapCoordinates(ivec2 texel, int size)
+{
+  return (vec2(texel) + 0.5) / float(size) * 2.0 - 1.0;
+}
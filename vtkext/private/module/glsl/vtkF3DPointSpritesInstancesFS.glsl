@@ -0,0 +1,45 @@
+#version 430
+
+uniform mat4 VCDCMatrix;
+uniform int gaussian;
+uniform float intensity;
+uniform float opacity;
+uniform float boundScale;
+
+in vec4 vertexColorVSOutput;
+in vec2 offsetVSOutput;
+flat in vec3 centerVCVSOutput;
+flat in float radiusVSOutput;
+
+layout(location = 0) out vec4 fragOutput0;
+
+void main()
+{
+  float dist2 = dot(offsetVSOutput, offsetVSOutput);
+  vec4 color = vertexColorVSOutput;
+
+  if (gaussian != 0)
+  {
+    if (dist2 > boundScale * boundScale)
+    {
+      discard;
+    }
+    gl_FragDepth = gl_FragCoord.z;
+    fragOutput0 = vec4(color.rgb * intensity, color.a * opacity * exp(-0.5 * dist2));
+    return;
+  }
+
+  if (dist2 > 1.0)
+  {
+    discard;
+  }
+
+  // depth of the front of the sphere, so intersecting spheres are correctly occluded
+  vec3 surfaceVC = centerVCVSOutput +
+    radiusVSOutput * vec3(offsetVSOutput, sqrt(1.0 - dist2));
+  vec4 surfaceDC = VCDCMatrix * vec4(surfaceVC, 1.0);
+  gl_FragDepth = 0.5 * surfaceDC.z / surfaceDC.w + 0.5;
+
+  // same shading as the sphere splat shader code of the geometry shader path
+  fragOutput0 = vec4(color.rgb * intensity * (1.0 - dist2), color.a * opacity);
+}
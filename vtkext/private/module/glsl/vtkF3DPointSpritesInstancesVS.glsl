@@ -0,0 +1,132 @@
+#version 430
+layout(std430) buffer;
+
+// positions of the splats, in the layout of the buffer read by the depth compute shader
+layout(binding = 0) readonly buffer Points
+{
+  float point[];
+};
+
+// packed attributes of the splats, attributeStride values per splat:
+// - the RGBA8 color
+// - spheres: the radius as a float, only if there is no constant radius
+// - gaussians: the scale as three halves, a padding half and the rotation as four snorm16
+layout(binding = 1) readonly buffer Attributes
+{
+  uint attribute[];
+};
+
+// the splats to draw, sorted back to front for the gaussians
+layout(binding = 2) readonly buffer Indices
+{
+  uint index[];
+};
+
+uniform mat4 MCVCMatrix;
+uniform mat4 VCDCMatrix;
+uniform vec2 viewportSize;
+uniform int parallelProjection;
+uniform int gaussian;
+uniform int attributeStride;
+uniform int hasColors;
+uniform vec4 defaultColor;
+uniform float radius;
+uniform float boundScale;
+uniform float lowPass;
+
+uniform samplerBuffer sphericalHarmonics;
+uniform int sphericalHarmonicsCoeffs;
+uniform vec3 cameraPositionMC;
+
+out vec4 vertexColorVSOutput;
+out vec2 offsetVSOutput;
+flat out vec3 centerVCVSOutput;
+flat out float radiusVSOutput;
+
+void main()
+{
+  uint splatId = index[gl_InstanceID];
+  vec4 vertexMC = vec4(point[3 * splatId], point[3 * splatId + 1], point[3 * splatId + 2], 1.0);
+  uint base = splatId * uint(attributeStride);
+
+  vertexColorVSOutput = hasColors != 0 ? unpackUnorm4x8(attribute[base]) : defaultColor;
+
+  //F3D::SphericalHarmonics::Impl
+
+  // the corners of the quad, drawn as a triangle strip of four vertices
+  vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1) * 2.0 - 1.0;
+  vec4 centerVC = MCVCMatrix * vertexMC;
+  centerVC /= centerVC.w;
+
+  if (gaussian == 0)
+  {
+    // the quad faces the camera, the fragment shader computes the sphere depth
+    float r = attributeStride > 1 ? uintBitsToFloat(attribute[base + 1]) : radius;
+    offsetVSOutput = corner;
+    centerVCVSOutput = centerVC.xyz;
+    radiusVSOutput = r;
+    gl_Position = VCDCMatrix * vec4(centerVC.xy + corner * r, centerVC.z, 1.0);
+    return;
+  }
+
+  if (parallelProjection == 0 && centerVC.z >= 0.0)
+  {
+    // behind the camera, outside of the clipping volume
+    gl_Position = vec4(0.0, 0.0, 2.0, 1.0);
+    return;
+  }
+
+  vec3 scale = vec3(unpackHalf2x16(attribute[base + 1]), unpackHalf2x16(attribute[base + 2]).x);
+  vec4 q = vec4(unpackSnorm2x16(attribute[base + 3]), unpackSnorm2x16(attribute[base + 4]));
+  q = dot(q, q) > 0.0 ? normalize(q) : vec4(1.0, 0.0, 0.0, 0.0);
+
+  // rotation matrix of the (w, x, y, z) quaternion, in column major order
+  float w = q.x, x = q.y, y = q.z, z = q.w;
+  mat3 rotation = mat3(1.0 - 2.0 * (y * y + z * z), 2.0 * (x * y + w * z), 2.0 * (x * z - w * y),
+    2.0 * (x * y - w * z), 1.0 - 2.0 * (x * x + z * z), 2.0 * (y * z + w * x),
+    2.0 * (x * z + w * y), 2.0 * (y * z - w * x), 1.0 - 2.0 * (x * x + y * y));
+
+  // covariance in view coordinates, projected in pixels with the jacobian of the projection
+  mat3 m = mat3(MCVCMatrix) * mat3(rotation[0] * scale.x, rotation[1] * scale.y,
+    rotation[2] * scale.z);
+  mat3 covariance = m * transpose(m);
+
+  vec2 focal = vec2(VCDCMatrix[0][0], VCDCMatrix[1][1]) * viewportSize * 0.5;
+  mat3 jacobian;
+  if (parallelProjection != 0)
+  {
+    jacobian = mat3(focal.x, 0.0, 0.0, 0.0, focal.y, 0.0, 0.0, 0.0, 0.0);
+  }
+  else
+  {
+    float iz = 1.0 / centerVC.z;
+    jacobian = mat3(-focal.x * iz, 0.0, 0.0, 0.0, -focal.y * iz, 0.0,
+      focal.x * centerVC.x * iz * iz, focal.y * centerVC.y * iz * iz, 0.0);
+  }
+  mat3 projected = jacobian * covariance * transpose(jacobian);
+
+  // the low pass filter dilates the gaussians smaller than a pixel
+  float a = projected[0][0] + lowPass;
+  float b = projected[0][1];
+  float c = projected[1][1] + lowPass;
+
+  // the quad is aligned on the eigen vectors of the 2D covariance
+  float mid = 0.5 * (a + c);
+  float delta = length(vec2(0.5 * (a - c), b));
+  float lambda1 = mid + delta;
+  float lambda2 = max(mid - delta, 1e-4);
+  vec2 v1 = abs(b) > 1e-8 ? normalize(vec2(b, lambda1 - a)) :
+    (a >= c ? vec2(1.0, 0.0) : vec2(0.0, 1.0));
+  vec2 v2 = vec2(-v1.y, v1.x);
+
+  vec2 offsetPixels =
+    boundScale * (corner.x * sqrt(lambda1) * v1 + corner.y * sqrt(lambda2) * v2);
+
+  // the offset is in standard deviations, its length is the Mahalanobis distance
+  offsetVSOutput = corner * boundScale;
+  centerVCVSOutput = centerVC.xyz;
+  radiusVSOutput = 0.0;
+
+  vec4 centerDC = VCDCMatrix * centerVC;
+  gl_Position = centerDC + vec4(offsetPixels * 2.0 / viewportSize * centerDC.w, 0.0, 0.0);
+}
@@ -0,0 +1,148 @@
+// Functions of the fused post processing, F3D_TONE_MAPPING and F3D_FXAA select the effects
+// applied by f3dPostProcess, the source texture is the linear output of the render passes
+
+uniform sampler2D source;
+uniform ivec2 resolution;
+
+#ifdef F3D_TONE_MAPPING
+// Khronos PBR Neutral tone mapping, like vtkToneMappingPass::NeutralPBR
+vec3 f3dToneMap(vec3 color)
+{
+  const float startCompression = 0.8 - 0.04;
+  const float desaturation = 0.15;
+
+  float x = min(color.r, min(color.g, color.b));
+  float offset = x < 0.08 ? x - 6.25 * x * x : 0.04;
+  color -= offset;
+
+  float peak = max(color.r, max(color.g, color.b));
+  if (peak < startCompression)
+  {
+    return color;
+  }
+
+  const float d = 1.0 - startCompression;
+  float newPeak = 1.0 - d * d / (peak + d - startCompression);
+  color *= newPeak / peak;
+
+  float g = 1.0 - 1.0 / (desaturation * (peak - newPeak) + 1.0);
+  return mix(color, vec3(newPeak), g);
+}
+#endif
+
+vec4 f3dSample(vec2 uv)
+{
+  vec4 color = texture(source, uv);
+#ifdef F3D_TONE_MAPPING
+  color.rgb = f3dToneMap(color.rgb);
+#endif
+  return color;
+}
+
+#ifdef F3D_FXAA
+float f3dLuma(vec2 uv)
+{
+  return dot(f3dSample(uv).rgb, vec3(0.299, 0.587, 0.114));
+}
+
+// FXAA with the default thresholds of vtkOpenGLFXAAFilter, the neighbors are tone mapped
+// when sampled so the edges are detected on the displayed colors
+vec4 f3dFXAA(vec2 uv)
+{
+  vec2 texel = 1.0 / vec2(resolution);
+  vec4 center = f3dSample(uv);
+  float lumaM = dot(center.rgb, vec3(0.299, 0.587, 0.114));
+  float lumaN = f3dLuma(uv + vec2(0.0, texel.y));
+  float lumaS = f3dLuma(uv - vec2(0.0, texel.y));
+  float lumaE = f3dLuma(uv + vec2(texel.x, 0.0));
+  float lumaW = f3dLuma(uv - vec2(texel.x, 0.0));
+
+  float lumaMax = max(lumaM, max(max(lumaN, lumaS), max(lumaE, lumaW)));
+  float lumaMin = min(lumaM, min(min(lumaN, lumaS), min(lumaE, lumaW)));
+  float range = lumaMax - lumaMin;
+  if (range < max(1.0 / 16.0, lumaMax / 8.0))
+  {
+    return center;
+  }
+
+  float lumaNE = f3dLuma(uv + texel);
+  float lumaSW = f3dLuma(uv - texel);
+  float lumaNW = f3dLuma(uv + vec2(-texel.x, texel.y));
+  float lumaSE = f3dLuma(uv + vec2(texel.x, -texel.y));
+
+  // blending of the sub pixel aliasing
+  float lumaL =
+    (2.0 * (lumaN + lumaS + lumaE + lumaW) + lumaNE + lumaNW + lumaSE + lumaSW) / 12.0;
+  float subpixel = smoothstep(0.0, 1.0, clamp(abs(lumaL - lumaM) / range, 0.0, 1.0));
+  subpixel = subpixel * subpixel * 0.75;
+
+  float edgeH = abs(lumaNW + lumaNE - 2.0 * lumaN) + 2.0 * abs(lumaW + lumaE - 2.0 * lumaM) +
+    abs(lumaSW + lumaSE - 2.0 * lumaS);
+  float edgeV = abs(lumaNW + lumaSW - 2.0 * lumaW) + 2.0 * abs(lumaN + lumaS - 2.0 * lumaM) +
+    abs(lumaNE + lumaSE - 2.0 * lumaE);
+  bool horizontal = edgeH >= edgeV;
+
+  // the side of the edge with the steepest gradient
+  float luma1 = horizontal ? lumaS : lumaW;
+  float luma2 = horizontal ? lumaN : lumaE;
+  float gradient1 = abs(luma1 - lumaM);
+  float gradient2 = abs(luma2 - lumaM);
+  float stepLength = horizontal ? texel.y : texel.x;
+  float lumaLocal = 0.5 * (luma2 + lumaM);
+  float gradient = gradient2;
+  if (gradient1 >= gradient2)
+  {
+    stepLength = -stepLength;
+    lumaLocal = 0.5 * (luma1 + lumaM);
+    gradient = gradient1;
+  }
+
+  vec2 edgeUV = uv + (horizontal ? vec2(0.0, 0.5 * stepLength) : vec2(0.5 * stepLength, 0.0));
+  vec2 offset = horizontal ? vec2(texel.x, 0.0) : vec2(0.0, texel.y);
+  float gradientScaled = 0.25 * gradient;
+
+  // search the two ends of the edge
+  vec2 uv1 = edgeUV - offset;
+  vec2 uv2 = edgeUV + offset;
+  float end1 = f3dLuma(uv1) - lumaLocal;
+  float end2 = f3dLuma(uv2) - lumaLocal;
+  bool reached1 = abs(end1) >= gradientScaled;
+  bool reached2 = abs(end2) >= gradientScaled;
+  for (int i = 0; i < 12 && !(reached1 && reached2); i++)
+  {
+    if (!reached1)
+    {
+      uv1 -= offset;
+      end1 = f3dLuma(uv1) - lumaLocal;
+      reached1 = abs(end1) >= gradientScaled;
+    }
+    if (!reached2)
+    {
+      uv2 += offset;
+      end2 = f3dLuma(uv2) - lumaLocal;
+      reached2 = abs(end2) >= gradientScaled;
+    }
+  }
+
+  float dist1 = horizontal ? uv.x - uv1.x : uv.y - uv1.y;
+  float dist2 = horizontal ? uv2.x - uv.x : uv2.y - uv.y;
+  bool closer1 = dist1 < dist2;
+  float pixelOffset = 0.5 - min(dist1, dist2) / (dist1 + dist2);
+
+  // only blend when the closest end varies in the opposite direction of the center
+  bool correctVariation = ((closer1 ? end1 : end2) < 0.0) != (lumaM < lumaLocal);
+  float finalOffset = max(correctVariation ? pixelOffset : 0.0, subpixel);
+
+  return f3dSample(
+    uv + (horizontal ? vec2(0.0, finalOffset * stepLength) : vec2(finalOffset * stepLength, 0.0)));
+}
+#endif
+
+vec4 f3dPostProcess(vec2 uv)
+{
+#ifdef F3D_FXAA
+  return f3dFXAA(uv);
+#else
+  return f3dSample(uv);
+#endif
+}
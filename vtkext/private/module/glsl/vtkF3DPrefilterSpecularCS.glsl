@@ -0,0 +1,79 @@
+#version 430
+
+// Prefiltering of a level of the specular cube map with GGX importance sampling, assuming the
+// view direction is the normal. Each sample reads the mip level of the environment covering its
+// solid angle (filtered importance sampling), so that a few samples are enough.
+layout(local_size_x = 8, local_size_y = 8, local_size_z = 1) in;
+
+uniform samplerCube environment;
+uniform int environmentSize;
+uniform int size;
+uniform float roughness;
+uniform int samples;
+
+layout(//F3D::PrefilterFormat, binding = 0) writeonly uniform imageCube prefiltered;
+
+//F3D::CubeMapFunctions::Dec
+
+const float PI = 3.14159265358979;
+
+vec2 f3dHammersley(uint i, uint n)
+{
+  return vec2(float(i) / float(n), float(bitfieldReverse(i)) * 2.3283064365386963e-10);
+}
+
+void main()
+{
+  ivec3 texel = ivec3(gl_GlobalInvocationID);
+  if (texel.x >= size || texel.y >= size)
+  {
+    return;
+  }
+
+  vec3 n = normalize(f3dCubeMapDirection(texel.z, f3dCubeMapCoordinates(texel.xy, size)));
+
+  if (roughness == 0.0)
+  {
+    // the first level is the environment itself, minified to the size of the level
+    float lod = max(log2(float(environmentSize) / float(size)), 0.0);
+    imageStore(prefiltered, texel, vec4(textureLod(environment, n, lod).rgb, 1.0));
+    return;
+  }
+
+  vec3 up = abs(n.z) < 0.999 ? vec3(0.0, 0.0, 1.0) : vec3(1.0, 0.0, 0.0);
+  vec3 tangentX = normalize(cross(up, n));
+  vec3 tangentY = cross(n, tangentX);
+
+  float alpha = roughness * roughness;
+  float alpha2 = alpha * alpha;
+  float texelSolidAngle = 4.0 * PI / (6.0 * float(environmentSize * environmentSize));
+
+  vec3 color = vec3(0.0);
+  float weight = 0.0;
+  for (int i = 0; i < samples; i++)
+  {
+    vec2 xi = f3dHammersley(uint(i), uint(samples));
+    float phi = 2.0 * PI * xi.x;
+    float cosTheta = sqrt((1.0 - xi.y) / (1.0 + (alpha2 - 1.0) * xi.y));
+    float sinTheta = sqrt(1.0 - cosTheta * cosTheta);
+    vec3 h = (cos(phi) * tangentX + sin(phi) * tangentY) * sinTheta + cosTheta * n;
+    vec3 l = 2.0 * dot(n, h) * h - n;
+
+    float nDotL = dot(n, l);
+    if (nDotL > 0.0)
+    {
+      // probability of the sample, the view direction being the normal
+      float t = cosTheta * cosTheta * (alpha2 - 1.0) + 1.0;
+      float pdf = alpha2 / (4.0 * PI * t * t);
+
+      // the biased level of the environment with texels covering the solid angle of the sample
+      float sampleSolidAngle = 1.0 / (float(samples) * pdf);
+      float lod = max(0.5 * log2(sampleSolidAngle / texelSolidAngle) + 1.0, 0.0);
+
+      color += textureLod(environment, l, lod).rgb * nDotL;
+      weight += nDotL;
+    }
+  }
+
+  imageStore(prefiltered, texel, vec4(color / max(weight, 1e-4), 1.0));
+}
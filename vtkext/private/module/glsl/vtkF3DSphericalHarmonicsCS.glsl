@@ -0,0 +1,83 @@
+#version 430
+
+// Projection of the radiance of a cube map on the 9 first spherical harmonics, each texel
+// is weighted by its solid angle and each workgroup reduces the contributions of its texels
+// in shared memory before writing its 9 RGB partial sums followed by the sum of the weights
+layout(local_size_x = 16, local_size_y = 16, local_size_z = 1) in;
+
+uniform samplerCube environment;
+uniform int size;
+
+layout(std430, binding = 0) writeonly buffer Partials
+{
+  float partial[];
+};
+
+shared vec3 coefficients[256][9];
+shared float weights[256];
+
+//F3D::CubeMapFunctions::Dec
+
+void main()
+{
+  ivec3 texel = ivec3(gl_GlobalInvocationID);
+  uint local = gl_LocalInvocationIndex;
+
+  for (int k = 0; k < 9; k++)
+  {
+    coefficients[local][k] = vec3(0.0);
+  }
+  weights[local] = 0.0;
+
+  if (texel.x < size && texel.y < size)
+  {
+    vec2 st = f3dCubeMapCoordinates(texel.xy, size);
+    vec3 n = normalize(f3dCubeMapDirection(texel.z, st));
+
+    // solid angle of the texel, up to a constant factor removed by the normalization
+    float d = 1.0 + dot(st, st);
+    float weight = 1.0 / (d * sqrt(d));
+
+    // the texel center is sampled so there is no interpolation
+    vec3 color = textureLod(environment, n, 0.0).rgb * weight;
+
+    // same basis and signs as vtkSphericalHarmonics
+    coefficients[local][0] = 0.282095 * color;
+    coefficients[local][1] = -0.488603 * n.y * color;
+    coefficients[local][2] = 0.488603 * n.z * color;
+    coefficients[local][3] = -0.488603 * n.x * color;
+    coefficients[local][4] = 1.092548 * n.x * n.y * color;
+    coefficients[local][5] = -1.092548 * n.y * n.z * color;
+    coefficients[local][6] = 0.315392 * (3.0 * n.z * n.z - 1.0) * color;
+    coefficients[local][7] = -1.092548 * n.x * n.z * color;
+    coefficients[local][8] = 0.546274 * (n.x * n.x - n.y * n.y) * color;
+    weights[local] = weight;
+  }
+  barrier();
+
+  for (uint stride = 128u; stride > 0u; stride >>= 1u)
+  {
+    if (local < stride)
+    {
+      for (int k = 0; k < 9; k++)
+      {
+        coefficients[local][k] += coefficients[local + stride][k];
+      }
+      weights[local] += weights[local + stride];
+    }
+    barrier();
+  }
+
+  if (local == 0u)
+  {
+    uint group = (gl_WorkGroupID.z * gl_NumWorkGroups.y + gl_WorkGroupID.y) * gl_NumWorkGroups.x +
+      gl_WorkGroupID.x;
+    for (int k = 0; k < 9; k++)
+    {
+      partial[group * 28u + 3u * uint(k)] = coefficients[0][k].r;
+      partial[group * 28u + 3u * uint(k) + 1u] = coefficients[0][k].g;
+      partial[group * 28u + 3u * uint(k) + 2u] = coefficients[0][k].b;
+    }
+    partial[group * 28u + 27u] = weights[0];
+  }
+}
@@ -0,0 +1,995 @@
+#include "vtkF3DBrickedVolume.h"
+
+#include "vtkF3DCache.h"
+
+#include <vtkArrayDispatch.h>
+#include <vtkCamera.h>
+#include <vtkDataArrayRange.h>
+#include <vtkImageData.h>
+#include <vtkInformation.h>
+#include <vtkInformationVector.h>
+#include <vtkMath.h>
+#include <vtkMatrix3x3.h>
+#include <vtkNew.h>
+#include <vtkObjectFactory.h>
+#include <vtkPointData.h>
+#include <vtkRenderer.h>
+#include <vtkSMPTools.h>
+#include <vtkStreamingDemandDrivenPipeline.h>
+#include <vtksys/FStream.hxx>
+#include <vtksys/MD5.h>
+#include <vtksys/SystemTools.hxx>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace
+{
+constexpr char Magic[8] = { 'F', '3', 'D', 'B', 'R', 'C', 'K', '\0' };
+constexpr uint32_t Version = 1;
+
+struct Header
+{
+  int32_t DataType = VTK_VOID;
+  int32_t NbComponents = 0;
+  std::string ArrayName;
+  std::array<int32_t, 3> Dimensions = {};
+  std::array<double, 3> Origin = {};
+  std::array<double, 3> Spacing = {};
+  std::array<double, 9> Direction = { 1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0 };
+  int32_t BrickSize = 0;
+  uint32_t NbLevels = 0;
+  uint64_t TableOffset = 0;
+
+  size_t GetVoxelSize() const
+  {
+    return static_cast<size_t>(this->NbComponents) * vtkDataArray::GetDataTypeSize(this->DataType);
+  }
+};
+
+struct Level
+{
+  std::array<int, 3> Dimensions;
+  std::array<int, 3> NbBricks;
+  std::vector<uint64_t> Offsets;
+
+  int GetBrickIndex(int bx, int by, int bz) const
+  {
+    return (bz * this->NbBricks[1] + by) * this->NbBricks[0] + bx;
+  }
+};
+
+// A range of bricks of a level, the output is the image made of these bricks
+struct Selection
+{
+  int Level = -1;
+  std::array<int, 6> Bricks = {};
+
+  bool operator==(const Selection& other) const
+  {
+    return this->Level == other.Level && this->Bricks == other.Bricks;
+  }
+};
+
+struct Brick
+{
+  std::vector<char> Data;
+  uint64_t LastUse = 0;
+};
+
+//----------------------------------------------------------------------------
+template<typename T>
+void Write(std::ostream& os, const T& value)
+{
+  os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+//----------------------------------------------------------------------------
+template<typename T>
+bool Read(std::istream& is, T& value)
+{
+  is.read(reinterpret_cast<char*>(&value), sizeof(T));
+  return static_cast<bool>(is);
+}
+
+//----------------------------------------------------------------------------
+void WriteHeader(std::ostream& os, const ::Header& header)
+{
+  os.write(::Magic, sizeof(::Magic));
+  ::Write(os, ::Version);
+  ::Write(os, header.DataType);
+  ::Write(os, header.NbComponents);
+  ::Write(os, static_cast<uint32_t>(header.ArrayName.size()));
+  os.write(header.ArrayName.data(), static_cast<std::streamsize>(header.ArrayName.size()));
+  for (int32_t dim : header.Dimensions)
+  {
+    ::Write(os, dim);
+  }
+  for (double value : header.Origin)
+  {
+    ::Write(os, value);
+  }
+  for (double value : header.Spacing)
+  {
+    ::Write(os, value);
+  }
+  for (double value : header.Direction)
+  {
+    ::Write(os, value);
+  }
+  ::Write(os, header.BrickSize);
+  ::Write(os, header.NbLevels);
+  ::Write(os, header.TableOffset);
+}
+
+//----------------------------------------------------------------------------
+bool ReadHeader(std::istream& is, ::Header& header)
+{
+  char magic[sizeof(::Magic)];
+  uint32_t version = 0;
+  uint32_t nameSize = 0;
+  is.read(magic, sizeof(magic));
+  if (!is || std::memcmp(magic, ::Magic, sizeof(magic)) != 0 || !::Read(is, version) ||
+    version != ::Version || !::Read(is, header.DataType) || !::Read(is, header.NbComponents) ||
+    !::Read(is, nameSize))
+  {
+    return false;
+  }
+  header.ArrayName.resize(nameSize);
+  is.read(&header.ArrayName[0], nameSize);
+  for (int32_t& dim : header.Dimensions)
+  {
+    ::Read(is, dim);
+  }
+  for (double& value : header.Origin)
+  {
+    ::Read(is, value);
+  }
+  for (double& value : header.Spacing)
+  {
+    ::Read(is, value);
+  }
+  for (double& value : header.Direction)
+  {
+    ::Read(is, value);
+  }
+  return ::Read(is, header.BrickSize) && ::Read(is, header.NbLevels) &&
+    ::Read(is, header.TableOffset) && header.BrickSize > 0 && header.NbComponents > 0;
+}
+
+//----------------------------------------------------------------------------
+// Each level halves the dimensions of the previous one until it fits in a single brick
+std::vector<::Level> ComputeLevels(const std::array<int32_t, 3>& dimensions, int brickSize)
+{
+  std::vector<::Level> levels;
+  std::array<int, 3> dims = { dimensions[0], dimensions[1], dimensions[2] };
+  while (true)
+  {
+    ::Level& level = levels.emplace_back();
+    level.Dimensions = dims;
+    for (int c = 0; c < 3; c++)
+    {
+      level.NbBricks[c] = (dims[c] + brickSize - 1) / brickSize;
+    }
+    level.Offsets.resize(
+      static_cast<size_t>(level.NbBricks[0]) * level.NbBricks[1] * level.NbBricks[2]);
+    if (dims[0] <= brickSize && dims[1] <= brickSize && dims[2] <= brickSize)
+    {
+      return levels;
+    }
+    for (int c = 0; c < 3; c++)
+    {
+      dims[c] = (dims[c] + 1) / 2;
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+// Voxel extent of a brick of a level, clamped to the level dimensions
+std::array<int, 6> GetBrickExtent(const ::Level& level, int brickSize, int bx, int by, int bz)
+{
+  const int brick[3] = { bx, by, bz };
+  std::array<int, 6> extent;
+  for (int c = 0; c < 3; c++)
+  {
+    extent[2 * c] = brick[c] * brickSize;
+    extent[2 * c + 1] = std::min(level.Dimensions[c], (brick[c] + 1) * brickSize) - 1;
+  }
+  return extent;
+}
+
+//----------------------------------------------------------------------------
+// Call the functor with the byte offsets of each row of a brick in the brick and in a region
+// of a level containing it, whose voxels are contiguous along x then y then z
+template<typename F>
+void ForEachBrickRow(const std::array<int, 6>& brickExtent,
+  const std::array<int, 6>& regionExtent, size_t voxelSize, F&& functor)
+{
+  const size_t rowSize = static_cast<size_t>(brickExtent[1] - brickExtent[0] + 1) * voxelSize;
+  const size_t regionDimX = regionExtent[1] - regionExtent[0] + 1;
+  const size_t regionDimY = regionExtent[3] - regionExtent[2] + 1;
+  size_t brickOffset = 0;
+  for (int z = brickExtent[4]; z <= brickExtent[5]; z++)
+  {
+    for (int y = brickExtent[2]; y <= brickExtent[3]; y++)
+    {
+      const size_t regionIndex =
+        (static_cast<size_t>(z - regionExtent[4]) * regionDimY + (y - regionExtent[2])) *
+          regionDimX +
+        (brickExtent[0] - regionExtent[0]);
+      functor(brickOffset, regionIndex * voxelSize, rowSize);
+      brickOffset += rowSize;
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+void CopyBrickToRegion(const char* brickData, const std::array<int, 6>& brickExtent,
+  const std::array<int, 6>& regionExtent, size_t voxelSize, char* regionData)
+{
+  ::ForEachBrickRow(brickExtent, regionExtent, voxelSize,
+    [&](size_t brickOffset, size_t regionOffset, size_t rowSize)
+    { std::memcpy(regionData + regionOffset, brickData + brickOffset, rowSize); });
+}
+
+//----------------------------------------------------------------------------
+void CopyRegionToBrick(const char* regionData, const std::array<int, 6>& regionExtent,
+  const std::array<int, 6>& brickExtent, size_t voxelSize, char* brickData)
+{
+  ::ForEachBrickRow(brickExtent, regionExtent, voxelSize,
+    [&](size_t brickOffset, size_t regionOffset, size_t rowSize)
+    { std::memcpy(brickData + brickOffset, regionData + regionOffset, rowSize); });
+}
+
+//----------------------------------------------------------------------------
+size_t GetBrickSize(const std::array<int, 6>& extent, size_t voxelSize)
+{
+  return static_cast<size_t>(extent[1] - extent[0] + 1) * (extent[3] - extent[2] + 1) *
+    (extent[5] - extent[4] + 1) * voxelSize;
+}
+
+//----------------------------------------------------------------------------
+// Write the bricks of a slab of a level, covering its full x and y dimensions and the bricks
+// of the bz row along z
+bool WriteSlab(std::ostream& os, ::Level& level, int brickSize, int bz, vtkDataArray* slab,
+  size_t voxelSize)
+{
+  const std::array<int, 6> slabExtent = { 0, level.Dimensions[0] - 1, 0,
+    level.Dimensions[1] - 1, bz * brickSize,
+    std::min(level.Dimensions[2], (bz + 1) * brickSize) - 1 };
+  const char* slabData = static_cast<const char*>(slab->GetVoidPointer(0));
+  std::vector<char> brickData;
+  for (int by = 0; by < level.NbBricks[1]; by++)
+  {
+    for (int bx = 0; bx < level.NbBricks[0]; bx++)
+    {
+      const std::array<int, 6> brickExtent = ::GetBrickExtent(level, brickSize, bx, by, bz);
+      brickData.resize(::GetBrickSize(brickExtent, voxelSize));
+      ::CopyRegionToBrick(slabData, slabExtent, brickExtent, voxelSize, brickData.data());
+      level.Offsets[level.GetBrickIndex(bx, by, bz)] = static_cast<uint64_t>(os.tellp());
+      os.write(brickData.data(), static_cast<std::streamsize>(brickData.size()));
+    }
+  }
+  return static_cast<bool>(os);
+}
+
+//----------------------------------------------------------------------------
+bool ReadBrick(std::istream& is, const ::Level& level, int brickIndex,
+  const std::array<int, 6>& brickExtent, size_t voxelSize, std::vector<char>& data)
+{
+  data.resize(::GetBrickSize(brickExtent, voxelSize));
+  is.clear();
+  is.seekg(static_cast<std::streamoff>(level.Offsets[brickIndex]));
+  is.read(data.data(), static_cast<std::streamsize>(data.size()));
+  return static_cast<bool>(is);
+}
+
+//----------------------------------------------------------------------------
+// Average the 2x2x2 voxels of the input region into each voxel of the output region,
+// clamping at the borders of odd dimensions
+struct DownsampleWorker
+{
+  template<typename ArrayT>
+  void operator()(
+    ArrayT* input, vtkDataArray* output, const std::array<int, 3>& inDims, const int outDims[3])
+  {
+    using ValueT = vtk::GetAPIType<ArrayT>;
+    ArrayT* typedOutput = static_cast<ArrayT*>(output);
+    const int nComps = input->GetNumberOfComponents();
+    auto in = vtk::DataArrayValueRange(input);
+    auto out = vtk::DataArrayValueRange(typedOutput);
+
+    vtkSMPTools::For(0, outDims[2],
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        std::vector<double> sum(nComps);
+        for (vtkIdType k = begin; k < end; k++)
+        {
+          const int zs[2] = { static_cast<int>(2 * k),
+            std::min(static_cast<int>(2 * k + 1), inDims[2] - 1) };
+          for (int j = 0; j < outDims[1]; j++)
+          {
+            const int ys[2] = { 2 * j, std::min(2 * j + 1, inDims[1] - 1) };
+            for (int i = 0; i < outDims[0]; i++)
+            {
+              const int xs[2] = { 2 * i, std::min(2 * i + 1, inDims[0] - 1) };
+              std::fill(sum.begin(), sum.end(), 0.0);
+              for (int z : zs)
+              {
+                for (int y : ys)
+                {
+                  for (int x : xs)
+                  {
+                    const size_t index =
+                      ((static_cast<size_t>(z) * inDims[1] + y) * inDims[0] + x) * nComps;
+                    for (int c = 0; c < nComps; c++)
+                    {
+                      sum[c] += static_cast<double>(in[index + c]);
+                    }
+                  }
+                }
+              }
+              const size_t outIndex =
+                ((static_cast<size_t>(k) * outDims[1] + j) * outDims[0] + i) * nComps;
+              for (int c = 0; c < nComps; c++)
+              {
+                const double average = sum[c] / 8.0;
+                out[outIndex + c] = static_cast<ValueT>(
+                  std::is_integral<ValueT>::value ? std::round(average) : average);
+              }
+            }
+          }
+        }
+      });
+  }
+};
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkDataArray> CreateRegionArray(const ::Header& header, vtkIdType nbTuples)
+{
+  vtkSmartPointer<vtkDataArray> array;
+  array.TakeReference(vtkDataArray::CreateDataArray(header.DataType));
+  array->SetName(header.ArrayName.c_str());
+  array->SetNumberOfComponents(header.NbComponents);
+  array->SetNumberOfTuples(nbTuples);
+  return array;
+}
+
+//----------------------------------------------------------------------------
+// Read the slab of bricks of the reader output covering the z range of the bz brick row of the
+// finest level. Readers without update extent support output their whole image.
+vtkSmartPointer<vtkDataArray> ReadReaderSlab(vtkAlgorithm* reader, const int wholeExtent[6],
+  const ::Header& header, const ::Level& level, int bz)
+{
+  const int z0 = bz * header.BrickSize;
+  const int z1 = std::min(level.Dimensions[2], (bz + 1) * header.BrickSize) - 1;
+  int slabExtent[6] = { wholeExtent[0], wholeExtent[1], wholeExtent[2], wholeExtent[3],
+    wholeExtent[4] + z0, wholeExtent[4] + z1 };
+  reader->UpdateExtent(slabExtent);
+  vtkImageData* image = vtkImageData::SafeDownCast(reader->GetOutputDataObject(0));
+  vtkDataArray* array =
+    image ? image->GetPointData()->GetArray(header.ArrayName.c_str()) : nullptr;
+  if (!array || array->GetNumberOfComponents() != header.NbComponents)
+  {
+    return nullptr;
+  }
+
+  // Copy the rows of the slab, in the standard memory layout of the data type
+  vtkSmartPointer<vtkDataArray> source = array;
+  if (!array->HasStandardMemoryLayout() || array->GetDataType() != header.DataType)
+  {
+    source = ::CreateRegionArray(header, array->GetNumberOfTuples());
+    source->DeepCopy(array);
+  }
+  const int* imageExtent = image->GetExtent();
+  for (int c = 0; c < 6; c += 2)
+  {
+    if (imageExtent[c] > slabExtent[c] || imageExtent[c + 1] < slabExtent[c + 1])
+    {
+      return nullptr;
+    }
+  }
+
+  const size_t voxelSize = header.GetVoxelSize();
+  const size_t rowSize = static_cast<size_t>(level.Dimensions[0]) * voxelSize;
+  const size_t imageDimX = imageExtent[1] - imageExtent[0] + 1;
+  const size_t imageDimY = imageExtent[3] - imageExtent[2] + 1;
+  vtkSmartPointer<vtkDataArray> slab = ::CreateRegionArray(
+    header, static_cast<vtkIdType>(level.Dimensions[0]) * level.Dimensions[1] * (z1 - z0 + 1));
+  const char* sourceData = static_cast<const char*>(source->GetVoidPointer(0));
+  char* slabData = static_cast<char*>(slab->GetVoidPointer(0));
+  for (int z = slabExtent[4]; z <= slabExtent[5]; z++)
+  {
+    for (int y = slabExtent[2]; y <= slabExtent[3]; y++)
+    {
+      const size_t imageIndex =
+        (static_cast<size_t>(z - imageExtent[4]) * imageDimY + (y - imageExtent[2])) *
+          imageDimX +
+        (slabExtent[0] - imageExtent[0]);
+      std::memcpy(slabData, sourceData + imageIndex * voxelSize, rowSize);
+      slabData += rowSize;
+    }
+  }
+  return slab;
+}
+
+//----------------------------------------------------------------------------
+// Axis aligned bounds of a voxel extent of a level
+void GetWorldBounds(const ::Header& header, int levelIndex, const std::array<int, 6>& extent,
+  double bounds[6])
+{
+  const double factor = static_cast<double>(1 << levelIndex);
+  vtkMath::UninitializeBounds(bounds);
+  for (int corner = 0; corner < 8; corner++)
+  {
+    double local[3];
+    for (int c = 0; c < 3; c++)
+    {
+      const int index = extent[2 * c + ((corner >> c) & 1)];
+      local[c] = (index * factor + (factor - 1.0) / 2.0) * header.Spacing[c];
+    }
+    for (int c = 0; c < 3; c++)
+    {
+      const double world = header.Origin[c] + header.Direction[3 * c] * local[0] +
+        header.Direction[3 * c + 1] * local[1] + header.Direction[3 * c + 2] * local[2];
+      bounds[2 * c] = corner == 0 ? world : std::min(bounds[2 * c], world);
+      bounds[2 * c + 1] = corner == 0 ? world : std::max(bounds[2 * c + 1], world);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+bool IsOutsideFrustum(const double planes[24], const double bounds[6])
+{
+  for (int i = 0; i < 6; i++)
+  {
+    const double* plane = planes + 4 * i;
+    double farthest = plane[3];
+    for (int j = 0; j < 3; j++)
+    {
+      farthest += std::max(plane[j] * bounds[2 * j], plane[j] * bounds[2 * j + 1]);
+    }
+    if (farthest < 0.0)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+}
+
+//----------------------------------------------------------------------------
+struct vtkF3DBrickedVolume::Internals
+{
+  bool ReadIndex(const std::string& fileName)
+  {
+    this->File.close();
+    this->File.clear();
+    this->File.open(fileName.c_str(), std::ios::binary);
+    if (!this->File.is_open() || !::ReadHeader(this->File, this->FileHeader))
+    {
+      return false;
+    }
+
+    this->Levels = ::ComputeLevels(this->FileHeader.Dimensions, this->FileHeader.BrickSize);
+    if (this->Levels.size() != this->FileHeader.NbLevels)
+    {
+      return false;
+    }
+    this->File.seekg(static_cast<std::streamoff>(this->FileHeader.TableOffset));
+    for (::Level& level : this->Levels)
+    {
+      for (uint64_t& offset : level.Offsets)
+      {
+        if (!::Read(this->File, offset))
+        {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  ::Selection GetWholeLevel(int levelIndex) const
+  {
+    const ::Level& level = this->Levels[levelIndex];
+    ::Selection selection;
+    selection.Level = levelIndex;
+    selection.Bricks = { 0, level.NbBricks[0] - 1, 0, level.NbBricks[1] - 1, 0,
+      level.NbBricks[2] - 1 };
+    return selection;
+  }
+
+  std::array<int, 6> GetExtent(const ::Selection& selection) const
+  {
+    const ::Level& level = this->Levels[selection.Level];
+    const int brickSize = this->FileHeader.BrickSize;
+    std::array<int, 6> extent;
+    for (int c = 0; c < 3; c++)
+    {
+      extent[2 * c] = selection.Bricks[2 * c] * brickSize;
+      extent[2 * c + 1] =
+        std::min(level.Dimensions[c], (selection.Bricks[2 * c + 1] + 1) * brickSize) - 1;
+    }
+    return extent;
+  }
+
+  size_t GetMemorySize(const ::Selection& selection) const
+  {
+    return ::GetBrickSize(this->GetExtent(selection), this->FileHeader.GetVoxelSize());
+  }
+
+  ::Selection ComputeSelection(vtkRenderer* renderer, size_t budget, double maxError) const
+  {
+    const int nbLevels = static_cast<int>(this->Levels.size());
+    if (!renderer || !renderer->IsActiveCameraCreated() || renderer->GetSize()[1] <= 0)
+    {
+      for (int levelIndex = 0; levelIndex < nbLevels - 1; levelIndex++)
+      {
+        ::Selection whole = this->GetWholeLevel(levelIndex);
+        if (this->GetMemorySize(whole) <= budget)
+        {
+          return whole;
+        }
+      }
+      return this->GetWholeLevel(nbLevels - 1);
+    }
+
+    vtkCamera* camera = renderer->GetActiveCamera();
+    double planes[24];
+    camera->GetFrustumPlanes(renderer->GetTiledAspectRatio(), planes);
+    const double height = renderer->GetSize()[1];
+    const double pixelsPerUnit = camera->GetParallelProjection()
+      ? height / (2.0 * camera->GetParallelScale())
+      : height / (2.0 * std::tan(vtkMath::RadiansFromDegrees(camera->GetViewAngle()) / 2.0));
+    const double* eye = camera->GetPosition();
+    const double finestSpacing = *std::max_element(
+      this->FileHeader.Spacing.begin(), this->FileHeader.Spacing.end());
+
+    // Levels are refined from the coarsest one, only the children of the visible bricks of the
+    // coarser level are tested, until the error is small enough or the budget is exceeded
+    const int brickSize = this->FileHeader.BrickSize;
+    ::Selection selected = this->GetWholeLevel(nbLevels - 1);
+    std::array<int, 6> candidates = selected.Bricks;
+    for (int levelIndex = nbLevels - 1; levelIndex >= 0; levelIndex--)
+    {
+      const ::Level& level = this->Levels[levelIndex];
+      ::Selection visible;
+      visible.Level = levelIndex;
+      visible.Bricks = { VTK_INT_MAX, VTK_INT_MIN, VTK_INT_MAX, VTK_INT_MIN, VTK_INT_MAX,
+        VTK_INT_MIN };
+      for (int bz = candidates[4]; bz <= candidates[5]; bz++)
+      {
+        for (int by = candidates[2]; by <= candidates[3]; by++)
+        {
+          for (int bx = candidates[0]; bx <= candidates[1]; bx++)
+          {
+            double bounds[6];
+            ::GetWorldBounds(this->FileHeader, levelIndex,
+              ::GetBrickExtent(level, brickSize, bx, by, bz), bounds);
+            if (!::IsOutsideFrustum(planes, bounds))
+            {
+              const int brick[3] = { bx, by, bz };
+              for (int c = 0; c < 3; c++)
+              {
+                visible.Bricks[2 * c] = std::min(visible.Bricks[2 * c], brick[c]);
+                visible.Bricks[2 * c + 1] = std::max(visible.Bricks[2 * c + 1], brick[c]);
+              }
+            }
+          }
+        }
+      }
+      if (visible.Bricks[0] > visible.Bricks[1])
+      {
+        // Nothing is visible, keep the coarsest level
+        return this->GetWholeLevel(nbLevels - 1);
+      }
+      if (levelIndex < nbLevels - 1 && this->GetMemorySize(visible) > budget)
+      {
+        break;
+      }
+      selected = visible;
+
+      // Projected size of the voxels of the level, at the nearest visible point
+      double bounds[6];
+      ::GetWorldBounds(this->FileHeader, levelIndex, this->GetExtent(visible), bounds);
+      double error = finestSpacing * (1 << levelIndex) * pixelsPerUnit;
+      if (!camera->GetParallelProjection())
+      {
+        double distance = 0.0;
+        for (int c = 0; c < 3; c++)
+        {
+          const double delta =
+            std::max({ 0.0, bounds[2 * c] - eye[c], eye[c] - bounds[2 * c + 1] });
+          distance += delta * delta;
+        }
+        error /= std::max(std::sqrt(distance), finestSpacing);
+      }
+      if (error <= maxError || levelIndex == 0)
+      {
+        break;
+      }
+
+      // The children of the visible bricks in the finer level
+      const ::Level& finer = this->Levels[levelIndex - 1];
+      for (int c = 0; c < 3; c++)
+      {
+        candidates[2 * c] = 2 * visible.Bricks[2 * c];
+        candidates[2 * c + 1] =
+          std::min(finer.NbBricks[c] - 1, 2 * visible.Bricks[2 * c + 1] + 1);
+      }
+    }
+    return selected;
+  }
+
+  const ::Brick* GetBrick(int levelIndex, int bx, int by, int bz)
+  {
+    const ::Level& level = this->Levels[levelIndex];
+    const int brickIndex = level.GetBrickIndex(bx, by, bz);
+    auto it = this->Loaded.find({ levelIndex, brickIndex });
+    if (it == this->Loaded.end())
+    {
+      ::Brick brick;
+      if (!::ReadBrick(this->File, level, brickIndex,
+            ::GetBrickExtent(level, this->FileHeader.BrickSize, bx, by, bz),
+            this->FileHeader.GetVoxelSize(), brick.Data))
+      {
+        return nullptr;
+      }
+      this->LoadedMemory += brick.Data.size();
+      it = this->Loaded.emplace(std::make_pair(levelIndex, brickIndex), std::move(brick)).first;
+    }
+    it->second.LastUse = ++this->UseCounter;
+    return &it->second;
+  }
+
+  // Discard the least recently used bricks exceeding the budget, except the ones in use
+  void Evict(size_t budget, uint64_t firstUse)
+  {
+    while (this->LoadedMemory > budget)
+    {
+      auto oldest = std::min_element(this->Loaded.begin(), this->Loaded.end(),
+        [](const auto& a, const auto& b) { return a.second.LastUse < b.second.LastUse; });
+      if (oldest == this->Loaded.end() || oldest->second.LastUse >= firstUse)
+      {
+        return;
+      }
+      this->LoadedMemory -= oldest->second.Data.size();
+      this->Loaded.erase(oldest);
+    }
+  }
+
+  std::string IndexedFileName;
+  vtksys::ifstream File;
+  ::Header FileHeader;
+  std::vector<::Level> Levels;
+  ::Selection Selected;
+  std::map<std::pair<int, int>, ::Brick> Loaded;
+  size_t LoadedMemory = 0;
+  uint64_t UseCounter = 0;
+};
+
+//----------------------------------------------------------------------------
+vtkStandardNewMacro(vtkF3DBrickedVolume);
+
+//----------------------------------------------------------------------------
+vtkF3DBrickedVolume::vtkF3DBrickedVolume()
+  : Pimpl(new Internals())
+{
+  this->SetNumberOfInputPorts(0);
+}
+
+//----------------------------------------------------------------------------
+vtkF3DBrickedVolume::~vtkF3DBrickedVolume() = default;
+
+//----------------------------------------------------------------------------
+bool vtkF3DBrickedVolume::BuildPyramid(
+  vtkAlgorithm* reader, const std::string& filePath, int brickSize)
+{
+  reader->UpdateInformation();
+  vtkInformation* outInfo = reader->GetOutputInformation(0);
+  int wholeExtent[6];
+  if (brickSize <= 0 || !outInfo->Has(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT()))
+  {
+    return false;
+  }
+  outInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), wholeExtent);
+
+  // The first slice gives the array, the origin, the spacing and the direction
+  int sliceExtent[6] = { wholeExtent[0], wholeExtent[1], wholeExtent[2], wholeExtent[3],
+    wholeExtent[4], wholeExtent[4] };
+  reader->UpdateExtent(sliceExtent);
+  vtkImageData* image = vtkImageData::SafeDownCast(reader->GetOutputDataObject(0));
+  if (!image)
+  {
+    return false;
+  }
+  vtkDataArray* array = image->GetPointData()->GetScalars();
+  if (!array && image->GetPointData()->GetNumberOfArrays() > 0)
+  {
+    array = image->GetPointData()->GetArray(0);
+  }
+  if (!array || !array->GetName() || array->GetNumberOfComponents() == 0)
+  {
+    return false;
+  }
+
+  ::Header header;
+  header.DataType = array->GetDataType();
+  header.NbComponents = array->GetNumberOfComponents();
+  header.ArrayName = array->GetName();
+  header.BrickSize = brickSize;
+  for (int c = 0; c < 3; c++)
+  {
+    header.Dimensions[c] = wholeExtent[2 * c + 1] - wholeExtent[2 * c] + 1;
+    header.Spacing[c] = image->GetSpacing()[c];
+  }
+  const double firstIndex[3] = { static_cast<double>(wholeExtent[0]),
+    static_cast<double>(wholeExtent[2]), static_cast<double>(wholeExtent[4]) };
+  image->TransformContinuousIndexToPhysicalPoint(firstIndex, header.Origin.data());
+  for (int i = 0; i < 3; i++)
+  {
+    for (int j = 0; j < 3; j++)
+    {
+      header.Direction[3 * i + j] = image->GetDirectionMatrix()->GetElement(i, j);
+    }
+  }
+  std::vector<::Level> levels = ::ComputeLevels(header.Dimensions, brickSize);
+  header.NbLevels = static_cast<uint32_t>(levels.size());
+
+  vtksys::SystemTools::MakeDirectory(vtksys::SystemTools::GetFilenamePath(filePath));
+  const std::string tmpPath = filePath + ".tmp";
+  vtksys::ofstream file(tmpPath.c_str(), std::ios::binary);
+  if (!file.is_open())
+  {
+    return false;
+  }
+
+  // The header is written again once the brick table offset is known
+  ::WriteHeader(file, header);
+
+  // The finest level is streamed from the reader by slabs of bricks, the coarser levels are
+  // averaged from the slabs of the previous level read back from the file
+  const size_t voxelSize = header.GetVoxelSize();
+  bool success = true;
+  for (int bz = 0; success && bz < levels[0].NbBricks[2]; bz++)
+  {
+    vtkSmartPointer<vtkDataArray> slab =
+      ::ReadReaderSlab(reader, wholeExtent, header, levels[0], bz);
+    success = slab && ::WriteSlab(file, levels[0], brickSize, bz, slab, voxelSize);
+  }
+  file.flush();
+
+  vtksys::ifstream readBack(tmpPath.c_str(), std::ios::binary);
+  for (size_t levelIndex = 1; success && levelIndex < levels.size(); levelIndex++)
+  {
+    const ::Level& previous = levels[levelIndex - 1];
+    ::Level& level = levels[levelIndex];
+    for (int bz = 0; success && bz < level.NbBricks[2]; bz++)
+    {
+      // The two brick rows of the previous level covering this one
+      const int pbz0 = 2 * bz;
+      const int pbz1 = std::min(previous.NbBricks[2] - 1, 2 * bz + 1);
+      const std::array<int, 6> inExtent = { 0, previous.Dimensions[0] - 1, 0,
+        previous.Dimensions[1] - 1, pbz0 * brickSize,
+        std::min(previous.Dimensions[2], (pbz1 + 1) * brickSize) - 1 };
+      const std::array<int, 3> inDims = { previous.Dimensions[0], previous.Dimensions[1],
+        inExtent[5] - inExtent[4] + 1 };
+      vtkSmartPointer<vtkDataArray> input = ::CreateRegionArray(
+        header, static_cast<vtkIdType>(inDims[0]) * inDims[1] * inDims[2]);
+      char* inputData = static_cast<char*>(input->GetVoidPointer(0));
+
+      std::vector<char> brickData;
+      for (int pbz = pbz0; success && pbz <= pbz1; pbz++)
+      {
+        for (int by = 0; success && by < previous.NbBricks[1]; by++)
+        {
+          for (int bx = 0; success && bx < previous.NbBricks[0]; bx++)
+          {
+            const std::array<int, 6> brickExtent =
+              ::GetBrickExtent(previous, brickSize, bx, by, pbz);
+            success = ::ReadBrick(readBack, previous, previous.GetBrickIndex(bx, by, pbz),
+              brickExtent, voxelSize, brickData);
+            ::CopyBrickToRegion(brickData.data(), brickExtent, inExtent, voxelSize, inputData);
+          }
+        }
+      }
+
+      const int outDims[3] = { level.Dimensions[0], level.Dimensions[1],
+        std::min(level.Dimensions[2], (bz + 1) * brickSize) - bz * brickSize };
+      vtkSmartPointer<vtkDataArray> output = ::CreateRegionArray(
+        header, static_cast<vtkIdType>(outDims[0]) * outDims[1] * outDims[2]);
+      ::DownsampleWorker worker;
+      if (!vtkArrayDispatch::Dispatch::Execute(input.Get(), worker, output.Get(), inDims, outDims))
+      {
+        worker(input.Get(), output.Get(), inDims, outDims);
+      }
+      success = success && ::WriteSlab(file, level, brickSize, bz, output, voxelSize);
+    }
+    file.flush();
+  }
+  readBack.close();
+
+  header.TableOffset = static_cast<uint64_t>(file.tellp());
+  for (const ::Level& level : levels)
+  {
+    for (uint64_t offset : level.Offsets)
+    {
+      ::Write(file, offset);
+    }
+  }
+  file.seekp(0);
+  ::WriteHeader(file, header);
+  file.close();
+
+  if (!success || !file || std::rename(tmpPath.c_str(), filePath.c_str()) != 0)
+  {
+    vtksys::SystemTools::RemoveFile(tmpPath);
+    return false;
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+std::string vtkF3DBrickedVolume::GetCacheFileName(const std::string& filePath)
+{
+  std::string directory = vtkF3DCache::GetDirectory();
+  if (directory.empty())
+  {
+    return "";
+  }
+
+  // The whole file is not hashed as it can be very large
+  std::string key = vtksys::SystemTools::CollapseFullPath(filePath) + ";" +
+    std::to_string(vtksys::SystemTools::FileLength(filePath)) + ";" +
+    std::to_string(vtksys::SystemTools::ModifiedTime(filePath)) + ";" +
+    std::to_string(::Version);
+
+  vtksysMD5* md5 = vtksysMD5_New();
+  vtksysMD5_Initialize(md5);
+  vtksysMD5_Append(
+    md5, reinterpret_cast<const unsigned char*>(key.data()), static_cast<int>(key.size()));
+  unsigned char digest[16];
+  char md5Hash[33];
+  md5Hash[32] = '\0';
+  vtksysMD5_Finalize(md5, digest);
+  vtksysMD5_DigestToHex(digest, md5Hash);
+  vtksysMD5_Delete(md5);
+
+  return directory + "/volumes/" + md5Hash + ".bricks";
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DBrickedVolume::UpdateSelection(vtkRenderer* renderer)
+{
+  Internals& internals = *this->Pimpl;
+  if (internals.IndexedFileName != this->FileName || internals.Levels.empty())
+  {
+    return false;
+  }
+
+  ::Selection selection = internals.ComputeSelection(renderer,
+    static_cast<size_t>(this->MemoryBudget) * 1024 * 1024, this->ScreenSpaceError);
+  if (selection == internals.Selected)
+  {
+    return false;
+  }
+  internals.Selected = selection;
+  this->Modified();
+  return true;
+}
+
+//----------------------------------------------------------------------------
+int vtkF3DBrickedVolume::GetNumberOfLevels()
+{
+  return static_cast<int>(this->Pimpl->Levels.size());
+}
+
+//----------------------------------------------------------------------------
+int vtkF3DBrickedVolume::GetSelectedLevel()
+{
+  return this->Pimpl->Selected.Level;
+}
+
+//----------------------------------------------------------------------------
+int vtkF3DBrickedVolume::RequestInformation(
+  vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector)
+{
+  Internals& internals = *this->Pimpl;
+  if (internals.IndexedFileName != this->FileName)
+  {
+    internals.Loaded.clear();
+    internals.LoadedMemory = 0;
+    internals.Levels.clear();
+    internals.IndexedFileName = this->FileName;
+    if (!internals.ReadIndex(this->FileName))
+    {
+      vtkErrorMacro("Cannot read the volume pyramid " << this->FileName);
+      internals.Levels.clear();
+      return 0;
+    }
+    internals.Selected = internals.ComputeSelection(
+      nullptr, static_cast<size_t>(this->MemoryBudget) * 1024 * 1024, this->ScreenSpaceError);
+  }
+  if (internals.Levels.empty())
+  {
+    return 0;
+  }
+
+  const ::Header& header = internals.FileHeader;
+  const std::array<int, 6> extent = internals.GetExtent(internals.Selected);
+  const double factor = static_cast<double>(1 << internals.Selected.Level);
+  double spacing[3];
+  double localOrigin[3];
+  for (int c = 0; c < 3; c++)
+  {
+    spacing[c] = header.Spacing[c] * factor;
+    localOrigin[c] = (factor - 1.0) / 2.0 * header.Spacing[c];
+  }
+  double origin[3];
+  for (int c = 0; c < 3; c++)
+  {
+    origin[c] = header.Origin[c] + header.Direction[3 * c] * localOrigin[0] +
+      header.Direction[3 * c + 1] * localOrigin[1] + header.Direction[3 * c + 2] * localOrigin[2];
+  }
+
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  outInfo->Set(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), extent.data(), 6);
+  outInfo->Set(vtkDataObject::SPACING(), spacing, 3);
+  outInfo->Set(vtkDataObject::ORIGIN(), origin, 3);
+  outInfo->Set(vtkDataObject::DIRECTION(), header.Direction.data(), 9);
+  vtkDataObject::SetPointDataActiveScalarInfo(outInfo, header.DataType, header.NbComponents);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkF3DBrickedVolume::RequestData(
+  vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector)
+{
+  Internals& internals = *this->Pimpl;
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  vtkImageData* output = vtkImageData::GetData(outInfo);
+
+  const ::Header& header = internals.FileHeader;
+  const ::Selection& selection = internals.Selected;
+  const std::array<int, 6> extent = internals.GetExtent(selection);
+  output->SetExtent(extent.data());
+  output->SetSpacing(outInfo->Get(vtkDataObject::SPACING()));
+  output->SetOrigin(outInfo->Get(vtkDataObject::ORIGIN()));
+  output->SetDirectionMatrix(header.Direction.data());
+
+  vtkSmartPointer<vtkDataArray> array = ::CreateRegionArray(header, output->GetNumberOfPoints());
+  char* data = static_cast<char*>(array->GetVoidPointer(0));
+  const size_t voxelSize = header.GetVoxelSize();
+  const ::Level& level = internals.Levels[selection.Level];
+  const uint64_t firstUse = internals.UseCounter + 1;
+  for (int bz = selection.Bricks[4]; bz <= selection.Bricks[5]; bz++)
+  {
+    for (int by = selection.Bricks[2]; by <= selection.Bricks[3]; by++)
+    {
+      for (int bx = selection.Bricks[0]; bx <= selection.Bricks[1]; bx++)
+      {
+        const ::Brick* brick = internals.GetBrick(selection.Level, bx, by, bz);
+        if (!brick)
+        {
+          vtkErrorMacro("Cannot read the bricks of " << this->FileName);
+          return 0;
+        }
+        ::CopyBrickToRegion(brick->Data.data(),
+          ::GetBrickExtent(level, header.BrickSize, bx, by, bz), extent, voxelSize, data);
+      }
+    }
+  }
+  internals.Evict(static_cast<size_t>(this->CacheBudget) * 1024 * 1024, firstUse);
+
+  output->GetPointData()->SetScalars(array);
+  return 1;
+}
@@ -0,0 +1,122 @@
+/**
+ * @class   vtkF3DBrickedVolume
+ * @brief   Stream the visible bricks of a multiresolution volume stored on disk
+ *
+ * BuildPyramid converts the point scalars of an image reader into a pyramid file: each level
+ * halves the resolution of the previous one by averaging its voxels, and is split into cubic
+ * bricks stored contiguously, so that any region of any level is read with a few large reads.
+ * The reader is streamed by slabs of bricks when it supports update extents, so that volumes
+ * larger than the memory are converted.
+ *
+ * This source reads such a file and outputs a single image made of the bricks of one level
+ * visible in the renderer camera, see UpdateSelection. It uses the coarsest level whose voxels
+ * are smaller than the screen space error, or the finest one whose visible bricks fit the
+ * memory budget of the output, which is the size uploaded to the GPU.
+ * Read bricks are kept in a least recently used cache bounded by the cache budget.
+ */
+
+#ifndef vtkF3DBrickedVolume_h
+#define vtkF3DBrickedVolume_h
+
+#include <vtkImageAlgorithm.h>
+
+#include <memory>
+#include <string>
+
+class vtkAlgorithm;
+class vtkRenderer;
+
+class vtkF3DBrickedVolume : public vtkImageAlgorithm
+{
+public:
+  static vtkF3DBrickedVolume* New();
+  vtkTypeMacro(vtkF3DBrickedVolume, vtkImageAlgorithm);
+
+  /**
+   * Convert the point scalars of the image output by the provided reader, or its first point
+   * array, into a pyramid file with bricks of brickSize voxels per axis.
+   * The file is written atomically. Returns false if the reader does not output an image with
+   * point data or if the file cannot be written.
+   */
+  static bool BuildPyramid(vtkAlgorithm* reader, const std::string& filePath, int brickSize);
+
+  /**
+   * Return the path of the pyramid file of the provided volume file in the vtkF3DCache
+   * directory, which depends on the file path, size and modification time.
+   * Returns an empty string if there is no cache directory.
+   */
+  static std::string GetCacheFileName(const std::string& filePath);
+
+  ///@{
+  /**
+   * Set/Get the pyramid file to read.
+   */
+  vtkSetMacro(FileName, std::string);
+  vtkGetMacro(FileName, std::string);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the maximum size of the output image, in MiB.
+   * Default is 512.
+   */
+  vtkSetMacro(MemoryBudget, int);
+  vtkGetMacro(MemoryBudget, int);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the maximum memory used by the read bricks, in MiB.
+   * Bricks of the output are never discarded.
+   * Default is 1024.
+   */
+  vtkSetMacro(CacheBudget, int);
+  vtkGetMacro(CacheBudget, int);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the projected size of a voxel, in pixels, under which a finer level is not used.
+   * Default is 1.
+   */
+  vtkSetMacro(ScreenSpaceError, double);
+  vtkGetMacro(ScreenSpaceError, double);
+  ///@}
+
+  /**
+   * Update the selected level and bricks for the camera of the provided renderer and call
+   * Modified if they change. Without a renderer, the finest complete level fitting the memory
+   * budget is selected, which is also the selection of the first update.
+   * Returns true if the selection changed.
+   */
+  bool UpdateSelection(vtkRenderer* renderer);
+
+  ///@{
+  /**
+   * Get the number of levels of the pyramid and the selected level, only valid once updated.
+   */
+  int GetNumberOfLevels();
+  int GetSelectedLevel();
+  ///@}
+
+protected:
+  vtkF3DBrickedVolume();
+  ~vtkF3DBrickedVolume() override;
+
+  int RequestInformation(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+
+private:
+  vtkF3DBrickedVolume(const vtkF3DBrickedVolume&) = delete;
+  void operator=(const vtkF3DBrickedVolume&) = delete;
+
+  std::string FileName;
+  int MemoryBudget = 512;
+  int CacheBudget = 1024;
+  double ScreenSpaceError = 1.0;
+
+  struct Internals;
+  std::unique_ptr<Internals> Pimpl;
+};
+
+#endif
@@ -1,6 +1,11 @@
 /**
  * @class   vtkF3DCachedLUTTexture
- * @brief   create a LUT texture from a vti file
+ * @brief   create the BRDF LUT texture from an embedded precomputed table
+ *
+ * The split sum BRDF LUT does not depend on the environment, so it is generated offline
+ * and embedded in the binary as 128x128 RG half floats, the scale and the bias of the
+ * Fresnel term, for NdotV along the columns and the roughness along the rows.
+ * Loading it is an upload, nothing is rendered nor written in the cache directory.
  */
 
 #ifndef vtkF3DCachedLUTTexture_h
@@ -15,32 +20,15 @@ public:
   vtkTypeMacro(vtkF3DCachedLUTTexture, vtkPBRLUTTexture);
   void PrintSelf(ostream& os, vtkIndent indent) override;
 
-  /**
-   * Set the image file name.
-   */
-  vtkSetMacro(FileName, std::string);
-
   /**
    * Implement base class method.
    */
   void Load(vtkRenderer*) override;
 
-  ///@{
-  /**
-   * Turn on or off cache mechanism
-   * Default is off
-   */
-  vtkSetMacro(UseCache, bool);
-  vtkBooleanMacro(UseCache, bool);
-  ///@}
-
 protected:
   vtkF3DCachedLUTTexture() = default;
   ~vtkF3DCachedLUTTexture() override = default;
 
-  std::string FileName;
-  bool UseCache = false;
-
 private:
   vtkF3DCachedLUTTexture(const vtkF3DCachedLUTTexture&) = delete;
   void operator=(const vtkF3DCachedLUTTexture&) = delete;
@@ -1,13 +1,21 @@
 #include "vtkF3DCachedSpecularTexture.h"
 
+#if !defined(__ANDROID__) && !defined(__EMSCRIPTEN__) &&                                           \
+  VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240203)
+#include "vtkF3DEnvironmentCompute.h"
+#endif
+
+#include <vtkFloatArray.h>
 #include <vtkImageData.h>
 #include <vtkMultiBlockDataSet.h>
 #include <vtkObjectFactory.h>
 #include <vtkOpenGLRenderWindow.h>
+#include <vtkPointData.h>
 #include <vtkRenderer.h>
 #include <vtkTextureObject.h>
 #include <vtkVersion.h>
-#include <vtkXMLMultiBlockDataReader.h>
+#include <vtksys/FStream.hxx>
+#include <vtksys/SystemTools.hxx>
 
 #if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240914)
 #include <vtk_glad.h>
@@ -15,6 +23,103 @@
 #include <vtk_glew.h>
 #endif
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+//----------------------------------------------------------------------------
+// Header of the cache file, followed by the half-float RGB payloads of the 6 faces
+// of each mip level
+struct CacheHeader
+{
+  char Magic[8] = { 'F', '3', 'D', 'S', 'P', 'E', 'C', '\0' };
+  uint32_t Version = 1;
+  uint32_t Size = 0;
+  uint32_t Levels = 0;
+  uint32_t Reserved = 0;
+};
+
+constexpr CacheHeader DefaultHeader;
+
+//----------------------------------------------------------------------------
+// Number of bytes of the payload of a single face at a given mip level
+std::size_t GetFaceSize(uint32_t size, uint32_t level)
+{
+  std::size_t dim = std::max(size >> level, 1u);
+  return dim * dim * 3 * sizeof(uint16_t);
+}
+
+//----------------------------------------------------------------------------
+// Expected number of bytes of a cache file
+std::size_t GetCacheSize(const CacheHeader& header)
+{
+  std::size_t cacheSize = sizeof(CacheHeader);
+  for (uint32_t i = 0; i < header.Levels; i++)
+  {
+    cacheSize += 6 * ::GetFaceSize(header.Size, i);
+  }
+  return cacheSize;
+}
+
+//----------------------------------------------------------------------------
+bool IsValidHeader(const CacheHeader& header)
+{
+  return std::memcmp(header.Magic, DefaultHeader.Magic, sizeof(header.Magic)) == 0 &&
+    header.Version == DefaultHeader.Version && header.Size > 0 && header.Levels > 0 &&
+    header.Levels <= 32;
+}
+
+//----------------------------------------------------------------------------
+// Convert a float to a half-float, rounding to the nearest even
+uint16_t FloatToHalf(float value)
+{
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+
+  uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+  uint32_t absBits = bits & 0x7fffffff;
+
+  if (absBits >= 0x7f800000)
+  {
+    // infinity or NaN
+    return sign | 0x7c00 | (absBits > 0x7f800000 ? 0x200 : 0);
+  }
+  if (absBits >= 0x477ff000)
+  {
+    // rounds above the largest half-float
+    return sign | 0x7c00;
+  }
+  if (absBits < 0x38800000)
+  {
+    // subnormal half-float or zero
+    if (absBits < 0x33000000)
+    {
+      return sign;
+    }
+    uint32_t mantissa = (absBits & 0x7fffff) | 0x800000;
+    uint32_t shift = 126 - (absBits >> 23);
+    uint32_t half = mantissa >> shift;
+    uint32_t remainder = mantissa & ((1u << shift) - 1);
+    uint32_t midpoint = 1u << (shift - 1);
+    if (remainder > midpoint || (remainder == midpoint && (half & 1)))
+    {
+      half++;
+    }
+    return sign | static_cast<uint16_t>(half);
+  }
+
+  uint32_t half = (absBits - 0x38000000) >> 13;
+  uint32_t remainder = absBits & 0x1fff;
+  if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1)))
+  {
+    half++;
+  }
+  return sign | static_cast<uint16_t>(half);
+}
+}
 
 vtkStandardNewMacro(vtkF3DCachedSpecularTexture);
 
@@ -30,11 +135,38 @@ void vtkF3DCachedSpecularTexture::Load(vtkRenderer* ren)
 {
   if (!this->UseCache)
   {
+#if !defined(__ANDROID__) && !defined(__EMSCRIPTEN__) &&                                           \
+  VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240203)
+    if (this->LoadWithComputeShaders(ren))
+    {
+      return;
+    }
+#endif
     return this->Superclass::Load(ren);
   }
 
   if (this->GetMTime() > this->LoadTime.GetMTime())
   {
+    // Read the whole file at once, the payloads are uploaded without any conversion
+    std::vector<char> buffer(vtksys::SystemTools::FileLength(this->FileName));
+    vtksys::ifstream file(this->FileName.c_str(), std::ios::binary);
+    file.read(buffer.data(), buffer.size());
+
+    CacheHeader header;
+    bool valid = file && buffer.size() >= sizeof(CacheHeader);
+    if (valid)
+    {
+      std::memcpy(&header, buffer.data(), sizeof(CacheHeader));
+      valid = ::IsValidHeader(header) && buffer.size() == ::GetCacheSize(header);
+    }
+
+    if (!valid)
+    {
+      vtkWarningMacro("Specular cache is invalid, computing it instead: " << this->FileName);
+      this->UseCache = false;
+      return this->Superclass::Load(ren);
+    }
+
     vtkOpenGLRenderWindow* renWin = vtkOpenGLRenderWindow::SafeDownCast(ren->GetRenderWindow());
 
     if (this->TextureObject == nullptr)
@@ -44,8 +176,8 @@ void vtkF3DCachedSpecularTexture::Load(vtkRenderer* ren)
 
     this->TextureObject->SetContext(renWin);
     this->TextureObject->SetFormat(GL_RGB);
-    this->TextureObject->SetInternalFormat(GL_RGB32F);
-    this->TextureObject->SetDataType(GL_FLOAT);
+    this->TextureObject->SetInternalFormat(GL_RGB16F);
+    this->TextureObject->SetDataType(GL_HALF_FLOAT);
     this->TextureObject->SetWrapS(vtkTextureObject::ClampToEdge);
     this->TextureObject->SetWrapT(vtkTextureObject::ClampToEdge);
     this->TextureObject->SetWrapR(vtkTextureObject::ClampToEdge);
@@ -55,50 +187,181 @@ void vtkF3DCachedSpecularTexture::Load(vtkRenderer* ren)
 
     this->RenderWindow = renWin;
 
-    vtkNew<vtkXMLMultiBlockDataReader> reader;
-    reader->SetFileName(this->FileName.c_str());
-    reader->Update();
+    this->PrefilterSize = header.Size;
+    this->TextureObject->SetMaxLevel(static_cast<int>(header.Levels) - 1);
 
-    vtkMultiBlockDataSet* mb = vtkMultiBlockDataSet::SafeDownCast(reader->GetOutput());
-
-    unsigned int nbLevels = mb->GetNumberOfBlocks();
-
-    this->TextureObject->SetMaxLevel(static_cast<int>(nbLevels) - 1);
-
-    vtkImageData* firstImg = vtkImageData::SafeDownCast(mb->GetBlock(0));
+    // half-float RGB rows are not always 4 bytes aligned
+    GLint alignment;
+    glGetIntegerv(GL_UNPACK_ALIGNMENT, &alignment);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 
+    char* payload = buffer.data() + sizeof(CacheHeader);
     void* data[6];
     for (int i = 0; i < 6; i++)
     {
-      data[i] = firstImg->GetScalarPointer(0, 0, i);
+      data[i] = payload + i * ::GetFaceSize(header.Size, 0);
     }
 
-    int* firstDims = firstImg->GetDimensions();
-    if (firstDims[0] != firstDims[1])
-    {
-      vtkWarningMacro("Specular cache has unexpected dimensions");
-    }
-    this->PrefilterSize = firstDims[0];
+    // the data type given here is ignored since the formats are set explicitly above
     this->TextureObject->CreateCubeFromRaw(
       this->PrefilterSize, this->PrefilterSize, 3, VTK_FLOAT, data);
+    payload += 6 * ::GetFaceSize(header.Size, 0);
 
     // the mip levels are manually uploaded because there is no abstraction in VTK
-    for (unsigned int i = 1; i < nbLevels; i++)
+    for (uint32_t i = 1; i < header.Levels; i++)
+    {
+      GLsizei dim = static_cast<GLsizei>(std::max(header.Size >> i, 1u));
+      for (int j = 0; j < 6; j++)
+      {
+        glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + j, static_cast<GLint>(i), GL_RGB16F, dim,
+          dim, 0, GL_RGB, GL_HALF_FLOAT, payload);
+        payload += ::GetFaceSize(header.Size, i);
+      }
+    }
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, alignment);
+
+    this->LoadTime.Modified();
+  }
+
+  this->TextureObject->Activate();
+}
+
+#if !defined(__ANDROID__) && !defined(__EMSCRIPTEN__) &&                                           \
+  VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240203)
+//------------------------------------------------------------------------------
+void vtkF3DCachedSpecularTexture::SetEnvironmentCompute(vtkF3DEnvironmentCompute* compute)
+{
+  if (this->EnvironmentCompute != compute)
+  {
+    this->EnvironmentCompute = compute;
+    this->Modified();
+  }
+}
+
+//------------------------------------------------------------------------------
+bool vtkF3DCachedSpecularTexture::LoadWithComputeShaders(vtkRenderer* ren)
+{
+  vtkOpenGLRenderWindow* renWin = vtkOpenGLRenderWindow::SafeDownCast(ren->GetRenderWindow());
+  vtkOpenGLTexture* input = this->GetInputTexture();
+  if (!this->EnvironmentCompute || !renWin || !input || !vtkF3DEnvironmentCompute::IsSupported())
+  {
+    return false;
+  }
+
+  if (this->GetMTime() > this->LoadTime.GetMTime() ||
+    input->GetMTime() > this->LoadTime.GetMTime())
+  {
+    if (this->TextureObject == nullptr)
     {
-      vtkImageData* img = vtkImageData::SafeDownCast(mb->GetBlock(i));
-      int* dims = img->GetDimensions();
+      this->TextureObject = vtkTextureObject::New();
+    }
 
+    // the compute shaders store RGBA texels, there is no RGB image format
+    const bool half = this->GetHalfPrecision();
+    this->TextureObject->SetContext(renWin);
+    this->TextureObject->SetFormat(GL_RGBA);
+    this->TextureObject->SetInternalFormat(half ? GL_RGBA16F : GL_RGBA32F);
+    this->TextureObject->SetDataType(half ? GL_HALF_FLOAT : GL_FLOAT);
+    this->TextureObject->SetWrapS(vtkTextureObject::ClampToEdge);
+    this->TextureObject->SetWrapT(vtkTextureObject::ClampToEdge);
+    this->TextureObject->SetWrapR(vtkTextureObject::ClampToEdge);
+    this->TextureObject->SetMinificationFilter(vtkTextureObject::LinearMipmapLinear);
+    this->TextureObject->SetMagnificationFilter(vtkTextureObject::Linear);
+    this->TextureObject->SetGenerateMipmap(false);
+    this->TextureObject->SetMaxLevel(static_cast<int>(this->PrefilterLevels) - 1);
+
+    this->RenderWindow = renWin;
+
+    // allocate all the levels, they are written by the compute shaders
+    void* data[6] = { nullptr, nullptr, nullptr, nullptr, nullptr, nullptr };
+    this->TextureObject->CreateCubeFromRaw(
+      this->PrefilterSize, this->PrefilterSize, 4, VTK_FLOAT, data);
+    for (unsigned int i = 1; i < this->PrefilterLevels; i++)
+    {
+      GLsizei dim = static_cast<GLsizei>(std::max(this->PrefilterSize >> i, 1u));
       for (int j = 0; j < 6; j++)
       {
         glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + j, static_cast<GLint>(i),
-          this->TextureObject->GetInternalFormat(VTK_FLOAT, 3, false), static_cast<GLint>(dims[0]),
-          static_cast<GLint>(dims[1]), 0, this->TextureObject->GetFormat(VTK_FLOAT, 3, false),
-          this->TextureObject->GetDataType(VTK_FLOAT), img->GetScalarPointer(0, 0, j));
+          half ? GL_RGBA16F : GL_RGBA32F, dim, dim, 0, GL_RGBA, half ? GL_HALF_FLOAT : GL_FLOAT,
+          nullptr);
       }
     }
 
+    if (!this->EnvironmentCompute->ComputeSpecular(
+          ren, input, this->TextureObject, this->PrefilterLevels, half))
+    {
+      return false;
+    }
+
     this->LoadTime.Modified();
   }
 
   this->TextureObject->Activate();
+  return true;
+}
+#endif
+
+//------------------------------------------------------------------------------
+bool vtkF3DCachedSpecularTexture::WriteCache(
+  const std::string& fileName, vtkMultiBlockDataSet* levels)
+{
+  CacheHeader header;
+  header.Levels = levels->GetNumberOfBlocks();
+
+  vtkImageData* firstImg = vtkImageData::SafeDownCast(levels->GetBlock(0));
+  if (!firstImg)
+  {
+    return false;
+  }
+  header.Size = static_cast<uint32_t>(firstImg->GetDimensions()[0]);
+  if (!::IsValidHeader(header))
+  {
+    return false;
+  }
+
+  std::vector<uint16_t> payload;
+  payload.reserve((::GetCacheSize(header) - sizeof(CacheHeader)) / sizeof(uint16_t));
+  for (uint32_t i = 0; i < header.Levels; i++)
+  {
+    vtkImageData* img = vtkImageData::SafeDownCast(levels->GetBlock(i));
+    vtkFloatArray* scalars =
+      img ? vtkFloatArray::SafeDownCast(img->GetPointData()->GetScalars()) : nullptr;
+
+    std::size_t nbTexels = 6 * ::GetFaceSize(header.Size, i) / (3 * sizeof(uint16_t));
+    int nbComponents = scalars ? scalars->GetNumberOfComponents() : 0;
+    if ((nbComponents != 3 && nbComponents != 4) ||
+      static_cast<std::size_t>(scalars->GetNumberOfTuples()) != nbTexels)
+    {
+      return false;
+    }
+
+    const float* values = scalars->GetPointer(0);
+    for (std::size_t j = 0; j < nbTexels; j++)
+    {
+      for (int c = 0; c < 3; c++)
+      {
+        payload.push_back(::FloatToHalf(values[j * nbComponents + c]));
+      }
+    }
+  }
+
+  vtksys::ofstream file(fileName.c_str(), std::ios::binary);
+  file.write(reinterpret_cast<const char*>(&header), sizeof(CacheHeader));
+  file.write(reinterpret_cast<const char*>(payload.data()), payload.size() * sizeof(uint16_t));
+  return static_cast<bool>(file);
+}
+
+//------------------------------------------------------------------------------
+bool vtkF3DCachedSpecularTexture::IsValidCache(const std::string& fileName)
+{
+  vtksys::ifstream file(fileName.c_str(), std::ios::binary);
+  CacheHeader header;
+  if (!file.read(reinterpret_cast<char*>(&header), sizeof(CacheHeader)))
+  {
+    return false;
+  }
+
+  return ::IsValidHeader(header) &&
+    vtksys::SystemTools::FileLength(fileName) == ::GetCacheSize(header);
 }
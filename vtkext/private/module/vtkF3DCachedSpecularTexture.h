@@ -1,6 +1,11 @@
 /**
  * @class   vtkF3DCachedSpecularTexture
- * @brief   create a prefiltered specular texture from a vtm file
+ * @brief   create a prefiltered specular texture from a cache file
+ *
+ * The cache file stores the mip chain of the cube map as half-float RGB payloads, laid out
+ * in the order they are uploaded so that loading it does not require any conversion.
+ * Without cache, the texture is prefiltered by the compute shaders of the environment compute
+ * object if it is set and supported, or by vtkPBRPrefilterTexture otherwise.
  */
 
 #ifndef vtkF3DCachedSpecularTexture_h
@@ -8,6 +13,12 @@
 
 #include "vtkPBRPrefilterTexture.h"
 
+#include <vtkSmartPointer.h>
+#include <vtkVersion.h>
+
+class vtkF3DEnvironmentCompute;
+class vtkMultiBlockDataSet;
+
 class vtkF3DCachedSpecularTexture : public vtkPBRPrefilterTexture
 {
 public:
@@ -34,6 +45,27 @@ public:
   vtkBooleanMacro(UseCache, bool);
   ///@}
 
+#if !defined(__ANDROID__) && !defined(__EMSCRIPTEN__) &&                                           \
+  VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240203)
+  /**
+   * Set the compute shaders used to prefilter the texture when the cache is not used.
+   * Default is none.
+   */
+  void SetEnvironmentCompute(vtkF3DEnvironmentCompute* compute);
+#endif
+
+  /**
+   * Write a cache file from a multiblock containing a float RGB image data per mip level,
+   * each one having the 6 faces of the cube map as slices. The alpha of RGBA images is ignored.
+   * Return false if the file cannot be written.
+   */
+  static bool WriteCache(const std::string& fileName, vtkMultiBlockDataSet* levels);
+
+  /**
+   * Check that a cache file exists and has a valid header and size.
+   */
+  static bool IsValidCache(const std::string& fileName);
+
 protected:
   vtkF3DCachedSpecularTexture() = default;
   ~vtkF3DCachedSpecularTexture() override = default;
@@ -41,6 +73,17 @@ protected:
   std::string FileName;
   bool UseCache = false;
 
+#if !defined(__ANDROID__) && !defined(__EMSCRIPTEN__) &&                                           \
+  VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240203)
+  /**
+   * Prefilter the texture with the environment compute shaders.
+   * Returns false if they are not set or not supported.
+   */
+  bool LoadWithComputeShaders(vtkRenderer* ren);
+
+  vtkSmartPointer<vtkF3DEnvironmentCompute> EnvironmentCompute;
+#endif
+
 private:
   vtkF3DCachedSpecularTexture(const vtkF3DCachedSpecularTexture&) = delete;
   void operator=(const vtkF3DCachedSpecularTexture&) = delete;
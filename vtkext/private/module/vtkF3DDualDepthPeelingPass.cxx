@@ -0,0 +1,53 @@
+#include "vtkF3DDualDepthPeelingPass.h"
+
+#include <vtkObjectFactory.h>
+#include <vtkRenderState.h>
+#include <vtkRenderWindow.h>
+#include <vtkRenderWindowInteractor.h>
+#include <vtkRenderer.h>
+
+#include <algorithm>
+
+vtkStandardNewMacro(vtkF3DDualDepthPeelingPass);
+
+//----------------------------------------------------------------------------
+void vtkF3DDualDepthPeelingPass::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "MaximumNumberOfPeels: " << this->MaximumNumberOfPeels << "\n";
+  os << indent << "OcclusionRatio: " << this->OcclusionRatio << "\n";
+  os << indent << "LastNumberOfPeels: " << this->LastNumberOfPeels << "\n";
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DDualDepthPeelingPass::Render(const vtkRenderState* s)
+{
+  vtkRenderer* ren = s->GetRenderer();
+  vtkRenderWindow* renWin = ren->GetRenderWindow();
+  vtkRenderWindowInteractor* iren = renWin->GetInteractor();
+  const bool interacting = iren && renWin->GetDesiredUpdateRate() > iren->GetStillUpdateRate();
+
+  int limit = this->MaximumNumberOfPeels;
+  if (interacting && this->PredictedNumberOfPeels > 0)
+  {
+    limit = std::min(limit, this->PredictedNumberOfPeels + 1);
+  }
+
+  // the VTK pass reads them from the renderer when initialized, only set them when changed
+  // to avoid modifying the renderer every frame
+  if (ren->GetMaximumNumberOfPeels() != limit)
+  {
+    ren->SetMaximumNumberOfPeels(limit);
+  }
+  if (ren->GetOcclusionRatio() != this->OcclusionRatio)
+  {
+    ren->SetOcclusionRatio(this->OcclusionRatio);
+  }
+
+  this->Superclass::Render(s);
+
+  // the number of peels of the frame, which stopped either on the occlusion ratio or the limit
+  this->LastNumberOfPeels = this->CurrentPeel;
+  const bool limited = this->LastNumberOfPeels >= limit && limit < this->MaximumNumberOfPeels;
+  this->PredictedNumberOfPeels = limited ? 0 : this->LastNumberOfPeels;
+}
@@ -0,0 +1,74 @@
+/**
+ * @class   vtkF3DDualDepthPeelingPass
+ * @brief   Dual depth peeling predicting the number of peels of the next frame
+ *
+ * The VTK pass counts the pixels written by each peel with occlusion queries and stops when a
+ * peel writes fewer pixels than the occlusion ratio of the renderer, or when the maximum number
+ * of peels of the renderer is reached. This pass sets them from its own OcclusionRatio and
+ * MaximumNumberOfPeels before rendering.
+ *
+ * While interacting, the peels of a frame are limited to one more than the peels needed by the
+ * previous frame, so that a scene with a few translucent layers does not pay for the worst case
+ * when the occlusion ratio is not reached. When a frame reaches this limit, it may have needed
+ * more peels, and the next frame can use the maximum number of peels again.
+ * Still frames always use the maximum number of peels.
+ *
+ * @sa
+ * vtkDualDepthPeelingPass
+ */
+
+#ifndef vtkF3DDualDepthPeelingPass_h
+#define vtkF3DDualDepthPeelingPass_h
+
+#include <vtkDualDepthPeelingPass.h>
+
+class vtkF3DDualDepthPeelingPass : public vtkDualDepthPeelingPass
+{
+public:
+  static vtkF3DDualDepthPeelingPass* New();
+  vtkTypeMacro(vtkF3DDualDepthPeelingPass, vtkDualDepthPeelingPass);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  void Render(const vtkRenderState* s) override;
+
+  ///@{
+  /**
+   * Set/Get the maximum number of peels of a frame.
+   * Default is 4, like vtkRenderer.
+   */
+  vtkSetClampMacro(MaximumNumberOfPeels, int, 1, VTK_INT_MAX);
+  vtkGetMacro(MaximumNumberOfPeels, int);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the ratio of the viewport pixels. When a peel writes fewer pixels than this
+   * ratio, the peeling stops. 0 stops only when a peel does not write any pixel.
+   * Default is 0.
+   */
+  vtkSetClampMacro(OcclusionRatio, double, 0.0, 0.5);
+  vtkGetMacro(OcclusionRatio, double);
+  ///@}
+
+  /**
+   * Get the number of peels rendered by the last frame.
+   */
+  vtkGetMacro(LastNumberOfPeels, int);
+
+  vtkF3DDualDepthPeelingPass(const vtkF3DDualDepthPeelingPass&) = delete;
+  void operator=(const vtkF3DDualDepthPeelingPass&) = delete;
+
+protected:
+  vtkF3DDualDepthPeelingPass() = default;
+  ~vtkF3DDualDepthPeelingPass() override = default;
+
+private:
+  int MaximumNumberOfPeels = 4;
+  double OcclusionRatio = 0.0;
+  int LastNumberOfPeels = 0;
+
+  // the limit of the next interactive frame, 0 to use the maximum
+  int PredictedNumberOfPeels = 0;
+};
+
+#endif
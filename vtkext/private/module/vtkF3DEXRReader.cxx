@@ -5,14 +5,55 @@
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkSMPTools.h"
 #include "vtksys/FStream.hxx"
 
 #include <ImfArray.h>
 #include <ImfRgbaFile.h>
+#include <ImfTestFile.h>
+#include <ImfThreading.h>
+#include <ImfTiledRgbaFile.h>
 
+#include <algorithm>
+#include <mutex>
 #include <sstream>
 #include <thread>
 
+namespace
+{
+//------------------------------------------------------------------------------
+// OpenEXR decompresses the line and tile blocks on its global thread pool
+void InitializeThreadPool()
+{
+  static std::once_flag once;
+  std::call_once(once, []() { Imf::setGlobalThreadCount(std::thread::hardware_concurrency()); });
+}
+
+//------------------------------------------------------------------------------
+// Clamp a level to the levels available in a tiled file
+int ClampLevel(const Imf::TiledRgbaInputFile& file, int level)
+{
+  switch (file.levelMode())
+  {
+    case Imf::MIPMAP_LEVELS:
+      return std::min(level, file.numLevels() - 1);
+    case Imf::RIPMAP_LEVELS:
+      return std::min(level, std::min(file.numXLevels(), file.numYLevels()) - 1);
+    default:
+      return 0;
+  }
+}
+
+//------------------------------------------------------------------------------
+void CheckChannels(Imf::RgbaChannels channels)
+{
+  if (channels != Imf::RgbaChannels::WRITE_RGBA && channels != Imf::RgbaChannels::WRITE_RGB)
+  {
+    throw std::runtime_error("only RGB and RGBA channels are supported");
+  }
+}
+}
+
 vtkStandardNewMacro(vtkF3DEXRReader);
 
 //------------------------------------------------------------------------------
@@ -25,6 +66,7 @@ vtkF3DEXRReader::~vtkF3DEXRReader() = default;
 void vtkF3DEXRReader::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "Level: " << this->Level << endl;
 }
 
 //------------------------------------------------------------------------------
@@ -43,19 +85,28 @@ void vtkF3DEXRReader::ExecuteInformation()
 
   try
   {
-    Imf::RgbaInputFile file(this->InternalFileName);
+    ::InitializeThreadPool();
+
+    Imath::Box2i dw;
+    if (Imf::isTiledOpenexrFile(this->InternalFileName))
+    {
+      Imf::TiledRgbaInputFile file(this->InternalFileName);
+      ::CheckChannels(file.channels());
+      this->TiledLevel = ::ClampLevel(file, this->Level);
+      dw = file.dataWindowForLevel(this->TiledLevel, this->TiledLevel);
+    }
+    else
+    {
+      Imf::RgbaInputFile file(this->InternalFileName);
+      ::CheckChannels(file.channels());
+      this->TiledLevel = -1;
+      dw = file.dataWindow();
+    }
 
-    Imath::Box2i dw = file.dataWindow();
     this->DataExtent[0] = dw.min.x;
     this->DataExtent[1] = dw.max.x;
     this->DataExtent[2] = dw.min.y;
     this->DataExtent[3] = dw.max.y;
-
-    Imf::RgbaChannels channels = file.channels();
-    if (channels != Imf::RgbaChannels::WRITE_RGBA && channels != Imf::RgbaChannels::WRITE_RGB)
-    {
-      throw std::runtime_error("only RGB and RGBA channels are supported");
-    }
   }
   catch (const std::exception& e)
   {
@@ -115,25 +166,47 @@ void vtkF3DEXRReader::ExecuteDataWithInformation(vtkDataObject* output, vtkInfor
   try
   {
     assert(this->InternalFileName);
-    Imf::setGlobalThreadCount(std::thread::hardware_concurrency());
-    Imf::RgbaInputFile file(this->InternalFileName);
+    ::InitializeThreadPool();
 
-    Imf::Array2D<Imf::Rgba> pixels(this->GetHeight(), this->GetWidth());
+    const int width = this->GetWidth();
+    const int height = this->GetHeight();
+    Imf::Array2D<Imf::Rgba> pixels(height, width);
 
-    file.setFrameBuffer(&pixels[0][0], 1, this->GetWidth());
-    file.readPixels(this->DataExtent[2], this->DataExtent[3]);
+    // OpenEXR addresses the frame buffer with the data window coordinates
+    Imf::Rgba* base = &pixels[0][0] - this->DataExtent[0] -
+      static_cast<std::ptrdiff_t>(this->DataExtent[2]) * width;
 
-    for (int y = this->GetHeight() - 1; y >= 0; y--)
+    if (this->TiledLevel >= 0)
     {
-      for (int x = 0; x < this->GetWidth(); x++)
-      {
-        const Imf::Rgba& p = pixels[y][x];
-        dataPtr[0] = std::clamp(static_cast<float>(p.r), 0.f, 10000.f);
-        dataPtr[1] = std::clamp(static_cast<float>(p.g), 0.f, 10000.f);
-        dataPtr[2] = std::clamp(static_cast<float>(p.b), 0.f, 10000.f);
-        dataPtr += 3;
-      }
+      Imf::TiledRgbaInputFile file(this->InternalFileName);
+      file.setFrameBuffer(base, 1, width);
+      file.readTiles(0, file.numXTiles(this->TiledLevel) - 1, 0,
+        file.numYTiles(this->TiledLevel) - 1, this->TiledLevel, this->TiledLevel);
     }
+    else
+    {
+      Imf::RgbaInputFile file(this->InternalFileName);
+      file.setFrameBuffer(base, 1, width);
+      file.readPixels(this->DataExtent[2], this->DataExtent[3]);
+    }
+
+    // Rows are flipped and converted to float in parallel
+    vtkSMPTools::For(0, height,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        for (vtkIdType y = begin; y < end; y++)
+        {
+          float* rowPtr = dataPtr + static_cast<std::size_t>(height - 1 - y) * width * 3;
+          for (int x = 0; x < width; x++)
+          {
+            const Imf::Rgba& p = pixels[y][x];
+            rowPtr[0] = std::clamp(static_cast<float>(p.r), 0.f, 10000.f);
+            rowPtr[1] = std::clamp(static_cast<float>(p.g), 0.f, 10000.f);
+            rowPtr[2] = std::clamp(static_cast<float>(p.b), 0.f, 10000.f);
+            rowPtr += 3;
+          }
+        }
+      });
   }
   catch (const std::exception& e)
   {
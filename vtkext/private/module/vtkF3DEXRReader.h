@@ -31,6 +31,17 @@ public:
     return "OpenEXR";
   }
 
+  ///@{
+  /**
+   * Set/Get the level to read in a tiled file with mipmap or ripmap levels.
+   * The level is clamped to the levels available in the file, 0 being the full
+   * resolution. Files stored as scanlines only have the level 0.
+   * Default is 0
+   */
+  vtkSetClampMacro(Level, int, 0, VTK_INT_MAX);
+  vtkGetMacro(Level, int);
+  ///@}
+
 protected:
   vtkF3DEXRReader();
   ~vtkF3DEXRReader() override;
@@ -44,6 +55,13 @@ protected:
 private:
   vtkF3DEXRReader(const vtkF3DEXRReader&) = delete;
   void operator=(const vtkF3DEXRReader&) = delete;
+
+  int Level = 0;
+
+  /**
+   * Level actually read, computed in ExecuteInformation, -1 for scanline files
+   */
+  int TiledLevel = -1;
 };
 
 #endif
@@ -0,0 +1,208 @@
+#include "vtkF3DEXRWriter.h"
+
+#include <vtkErrorCode.h>
+#include <vtkImageData.h>
+#include <vtkObjectFactory.h>
+#include <vtkUnsignedCharArray.h>
+
+#include <ImfChannelList.h>
+#include <ImfFrameBuffer.h>
+#include <ImfHeader.h>
+#include <ImfIO.h>
+#include <ImfOutputFile.h>
+#include <ImfThreading.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+//------------------------------------------------------------------------------
+// OpenEXR compresses the line blocks on its global thread pool
+void InitializeThreadPool()
+{
+  static std::once_flag once;
+  std::call_once(once, []() { Imf::setGlobalThreadCount(std::thread::hardware_concurrency()); });
+}
+
+//------------------------------------------------------------------------------
+// An output stream growing a buffer in memory
+class MemoryStream : public Imf::OStream
+{
+public:
+  MemoryStream()
+    : Imf::OStream("memory")
+  {
+  }
+
+  void write(const char c[], int n) override
+  {
+    if (this->Position + n > this->Data.size())
+    {
+      this->Data.resize(this->Position + n);
+    }
+    std::memcpy(this->Data.data() + this->Position, c, n);
+    this->Position += n;
+  }
+
+  uint64_t tellp() override
+  {
+    return this->Position;
+  }
+
+  void seekp(uint64_t pos) override
+  {
+    this->Position = pos;
+  }
+
+  std::vector<char> Data;
+  uint64_t Position = 0;
+};
+}
+
+vtkStandardNewMacro(vtkF3DEXRWriter);
+
+//------------------------------------------------------------------------------
+vtkF3DEXRWriter::vtkF3DEXRWriter() = default;
+
+//------------------------------------------------------------------------------
+vtkF3DEXRWriter::~vtkF3DEXRWriter() = default;
+
+//------------------------------------------------------------------------------
+void vtkF3DEXRWriter::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Compression: " << this->Compression << endl;
+  os << indent << "WriteToMemory: " << this->WriteToMemory << endl;
+}
+
+//------------------------------------------------------------------------------
+vtkUnsignedCharArray* vtkF3DEXRWriter::GetResult()
+{
+  return this->Result;
+}
+
+//------------------------------------------------------------------------------
+void vtkF3DEXRWriter::Write()
+{
+  this->SetErrorCode(vtkErrorCode::NoError);
+  if (!this->WriteToMemory && (!this->FileName || this->FileName[0] == '\0'))
+  {
+    vtkErrorMacro("Write: a file name must be specified");
+    this->SetErrorCode(vtkErrorCode::NoFileNameError);
+    return;
+  }
+
+  if (this->GetInputAlgorithm())
+  {
+    this->GetInputAlgorithm()->Update();
+  }
+  vtkImageData* input = this->GetImageDataInput(0);
+  if (!input)
+  {
+    vtkErrorMacro("Write: no input image");
+    this->SetErrorCode(vtkErrorCode::UnknownError);
+    return;
+  }
+
+  const int scalarType = input->GetScalarType();
+  if (scalarType != VTK_FLOAT && scalarType != VTK_SHORT)
+  {
+    vtkErrorMacro("Write: only float and half float scalars can be written");
+    this->SetErrorCode(vtkErrorCode::FileFormatError);
+    return;
+  }
+
+  const int components = input->GetNumberOfScalarComponents();
+  static const std::array<std::vector<const char*>, 4> channelNames = { { { "Y" }, { "Y", "A" },
+    { "R", "G", "B" }, { "R", "G", "B", "A" } } };
+  if (components < 1 || components > 4)
+  {
+    vtkErrorMacro("Write: only images with 1 to 4 components can be written");
+    this->SetErrorCode(vtkErrorCode::FileFormatError);
+    return;
+  }
+
+  int dims[3];
+  input->GetDimensions(dims);
+  const int width = dims[0];
+  const int height = dims[1];
+  const Imf::PixelType pixelType = scalarType == VTK_FLOAT ? Imf::FLOAT : Imf::HALF;
+  const size_t pixelSize = static_cast<size_t>(components) * input->GetScalarSize();
+  const size_t rowSize = pixelSize * width;
+
+  try
+  {
+    ::InitializeThreadPool();
+
+    Imf::Header header(width, height);
+    switch (this->Compression)
+    {
+      case NONE:
+        header.compression() = Imf::NO_COMPRESSION;
+        break;
+      case PIZ:
+        header.compression() = Imf::PIZ_COMPRESSION;
+        break;
+      case DWAA:
+        header.compression() = Imf::DWAA_COMPRESSION;
+        break;
+      default:
+        header.compression() = Imf::ZIP_COMPRESSION;
+        break;
+    }
+    for (const char* name : channelNames[components - 1])
+    {
+      header.channels().insert(name, Imf::Channel(pixelType));
+    }
+
+    MemoryStream memory;
+    std::unique_ptr<Imf::OutputFile> file = this->WriteToMemory
+      ? std::make_unique<Imf::OutputFile>(memory, header)
+      : std::make_unique<Imf::OutputFile>(this->FileName, header);
+
+    // The rows of VTK images start from the bottom, they are flipped by blocks large enough
+    // for the line blocks of a block to be compressed in parallel
+    constexpr int blockHeight = 512;
+    std::vector<char> block(rowSize * std::min(blockHeight, height));
+    const char* scalars = static_cast<const char*>(input->GetScalarPointer());
+    for (int y0 = 0; y0 < height; y0 += blockHeight)
+    {
+      const int y1 = std::min(y0 + blockHeight, height);
+      for (int y = y0; y < y1; y++)
+      {
+        std::memcpy(block.data() + rowSize * (y - y0),
+          scalars + rowSize * static_cast<size_t>(height - 1 - y), rowSize);
+      }
+
+      // OpenEXR addresses the frame buffer with the data window coordinates
+      char* base = block.data() - rowSize * y0;
+      Imf::FrameBuffer frameBuffer;
+      for (int c = 0; c < components; c++)
+      {
+        frameBuffer.insert(channelNames[components - 1][c],
+          Imf::Slice(pixelType, base + c * input->GetScalarSize(), pixelSize, rowSize));
+      }
+      file->setFrameBuffer(frameBuffer);
+      file->writePixels(y1 - y0);
+    }
+    file.reset();
+
+    if (this->WriteToMemory)
+    {
+      this->Result = vtkSmartPointer<vtkUnsignedCharArray>::New();
+      this->Result->SetNumberOfValues(static_cast<vtkIdType>(memory.Data.size()));
+      std::copy(memory.Data.begin(), memory.Data.end(), this->Result->GetPointer(0));
+    }
+  }
+  catch (const std::exception& e)
+  {
+    vtkErrorMacro("Error writing EXR file: " << e.what());
+    this->SetErrorCode(vtkErrorCode::CannotOpenFileError);
+  }
+}
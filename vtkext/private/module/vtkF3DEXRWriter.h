@@ -0,0 +1,76 @@
+/**
+ * @class   vtkF3DEXRWriter
+ * @brief   Write an image to an OpenEXR file, or to memory
+ *
+ * Float scalars are written as 32 bits float channels and 16 bits signed integer scalars as
+ * half float channels holding the bits of the halves, which is how f3d::image stores its HALF
+ * channels. Images with 1 component are written as a Y channel, 2 as Y and A, 3 as RGB and 4 as
+ * RGBA. The scanlines are compressed by the OpenEXR thread pool, using all the cores.
+ */
+
+#ifndef vtkF3DEXRWriter_h
+#define vtkF3DEXRWriter_h
+
+#include <vtkImageWriter.h>
+#include <vtkSmartPointer.h>
+
+class vtkUnsignedCharArray;
+
+class vtkF3DEXRWriter : public vtkImageWriter
+{
+public:
+  static vtkF3DEXRWriter* New();
+  vtkTypeMacro(vtkF3DEXRWriter, vtkImageWriter);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  enum Compressions
+  {
+    NONE,
+    ZIP,
+    PIZ,
+    DWAA
+  };
+
+  ///@{
+  /**
+   * Set/Get the compression of the scanlines, ZIP and PIZ are lossless, DWAA is lossy.
+   * Default is ZIP
+   */
+  vtkSetClampMacro(Compression, int, NONE, DWAA);
+  vtkGetMacro(Compression, int);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get whether the file is written in memory, see GetResult, instead of to the file name.
+   * Default is false
+   */
+  vtkSetMacro(WriteToMemory, bool);
+  vtkGetMacro(WriteToMemory, bool);
+  vtkBooleanMacro(WriteToMemory, bool);
+  ///@}
+
+  /**
+   * Get the file written in memory
+   */
+  vtkUnsignedCharArray* GetResult();
+
+  /**
+   * Write the input image
+   */
+  void Write() override;
+
+protected:
+  vtkF3DEXRWriter();
+  ~vtkF3DEXRWriter() override;
+
+private:
+  vtkF3DEXRWriter(const vtkF3DEXRWriter&) = delete;
+  void operator=(const vtkF3DEXRWriter&) = delete;
+
+  int Compression = ZIP;
+  bool WriteToMemory = false;
+  vtkSmartPointer<vtkUnsignedCharArray> Result;
+};
+
+#endif
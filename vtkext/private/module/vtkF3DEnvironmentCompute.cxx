@@ -0,0 +1,218 @@
+#include "vtkF3DEnvironmentCompute.h"
+
+#include "vtkF3DCubeMapFunctions.h"
+#include "vtkF3DPrefilterSpecularCS.h"
+#include "vtkF3DSphericalHarmonicsCS.h"
+
+#include <vtkEquirectangularToCubeMapTexture.h>
+#include <vtkFloatArray.h>
+#include <vtkImageData.h>
+#include <vtkMath.h>
+#include <vtkObjectFactory.h>
+#include <vtkOpenGLBufferObject.h>
+#include <vtkOpenGLRenderWindow.h>
+#include <vtkOpenGLShaderCache.h>
+#include <vtkOpenGLTexture.h>
+#include <vtkRenderer.h>
+#include <vtkShader.h>
+#include <vtkShaderProgram.h>
+#include <vtkTextureObject.h>
+#include <vtkVersion.h>
+
+#if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240914)
+#include <vtk_glad.h>
+#else
+#include <vtk_glew.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace
+{
+// Number of floats written by each workgroup of the spherical harmonics projection
+constexpr int PartialSize = 28;
+
+//----------------------------------------------------------------------------
+// Compile a compute shader with the cube map functions, returns false on failure
+bool ReadyProgram(vtkOpenGLRenderWindow* renWin, vtkShader* shader, vtkShaderProgram* program,
+  std::string source)
+{
+  if (!program->GetComputeShader())
+  {
+    vtkShaderProgram::Substitute(source, "//F3D::CubeMapFunctions::Dec", vtkF3DCubeMapFunctions);
+    shader->SetType(vtkShader::Compute);
+    shader->SetSource(source);
+    program->SetComputeShader(shader);
+  }
+  return renWin->GetShaderCache()->ReadyShaderProgram(program) != nullptr;
+}
+}
+
+vtkStandardNewMacro(vtkF3DEnvironmentCompute);
+
+//----------------------------------------------------------------------------
+vtkF3DEnvironmentCompute::vtkF3DEnvironmentCompute() = default;
+
+//----------------------------------------------------------------------------
+vtkF3DEnvironmentCompute::~vtkF3DEnvironmentCompute() = default;
+
+//----------------------------------------------------------------------------
+void vtkF3DEnvironmentCompute::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "SpecularSamples: " << this->SpecularSamples << endl;
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DEnvironmentCompute::IsSupported()
+{
+  return vtkShader::IsComputeShaderSupported();
+}
+
+//----------------------------------------------------------------------------
+vtkTextureObject* vtkF3DEnvironmentCompute::UpdateCubeMap(
+  vtkRenderer* ren, vtkOpenGLTexture* environment)
+{
+  if (!environment)
+  {
+    return nullptr;
+  }
+
+  vtkOpenGLTexture* cubeMap = environment;
+  if (!environment->GetCubeMap())
+  {
+    if (!this->CubeMap || this->CubeMap->GetInputTexture() != environment)
+    {
+      this->CubeMap = vtkSmartPointer<vtkEquirectangularToCubeMapTexture>::New();
+      this->CubeMap->SetInputTexture(environment);
+    }
+
+    // a quarter of the width of the equirectangular image keeps its resolution at the equator
+    vtkImageData* image = environment->GetInput();
+    int width = image ? image->GetDimensions()[0] : 0;
+    this->CubeMap->SetCubeMapSize(static_cast<unsigned int>(
+      std::clamp(vtkMath::NearestPowerOfTwo(std::max(width / 4, 1)), 64, 2048)));
+    cubeMap = this->CubeMap;
+  }
+
+  cubeMap->Load(ren);
+  vtkTextureObject* texture = cubeMap->GetTextureObject();
+  if (texture)
+  {
+    // levels for the filtered importance sampling, regenerated since the cube map may be reloaded
+    texture->SetMinificationFilter(vtkTextureObject::LinearMipmapLinear);
+    texture->SetMaxLevel(vtkMath::Floor(std::log2(std::max(texture->GetWidth(), 1u))));
+    texture->Activate();
+    glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
+  }
+  cubeMap->PostRender(ren);
+  return texture;
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DEnvironmentCompute::ComputeSphericalHarmonics(
+  vtkRenderer* ren, vtkOpenGLTexture* environment, vtkFloatArray* harmonics)
+{
+  vtkOpenGLRenderWindow* renWin = vtkOpenGLRenderWindow::SafeDownCast(ren->GetRenderWindow());
+  if (!renWin || !harmonics || !vtkF3DEnvironmentCompute::IsSupported())
+  {
+    return false;
+  }
+
+  vtkTextureObject* cubeMap = this->UpdateCubeMap(ren, environment);
+  if (!cubeMap ||
+    !::ReadyProgram(renWin, this->SphericalHarmonicsShader, this->SphericalHarmonicsProgram,
+      vtkF3DSphericalHarmonicsCS))
+  {
+    return false;
+  }
+
+  const int size = static_cast<int>(cubeMap->GetWidth());
+  const int groups = (size + 15) / 16;
+  std::vector<float> partials(static_cast<size_t>(groups) * groups * 6 * ::PartialSize);
+  this->Partials->Allocate(partials.size() * sizeof(float), vtkOpenGLBufferObject::ArrayBuffer,
+    vtkOpenGLBufferObject::DynamicCopy);
+
+  cubeMap->Activate();
+  this->SphericalHarmonicsProgram->SetUniformi("environment", cubeMap->GetTextureUnit());
+  this->SphericalHarmonicsProgram->SetUniformi("size", size);
+  this->Partials->BindShaderStorage(0);
+  glDispatchCompute(groups, groups, 6);
+  glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+  cubeMap->Deactivate();
+
+  // the partial sums of the workgroups are small enough to be summed on the CPU, in double
+  this->Partials->Download(partials.data(), partials.size());
+  std::array<double, ::PartialSize> sums{};
+  for (size_t i = 0; i < partials.size(); i++)
+  {
+    sums[i % ::PartialSize] += partials[i];
+  }
+
+  const double totalWeight = sums[::PartialSize - 1];
+  if (totalWeight <= 0.0)
+  {
+    return false;
+  }
+
+  // the weights are proportional to the solid angles, which sum to the sphere area
+  const double normalization = 4.0 * vtkMath::Pi() / totalWeight;
+  harmonics->SetName("SphericalHarmonics");
+  harmonics->SetNumberOfComponents(3);
+  harmonics->SetNumberOfTuples(9);
+  for (int k = 0; k < 9; k++)
+  {
+    harmonics->SetTuple3(k, sums[3 * k] * normalization, sums[3 * k + 1] * normalization,
+      sums[3 * k + 2] * normalization);
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DEnvironmentCompute::ComputeSpecular(vtkRenderer* ren, vtkOpenGLTexture* environment,
+  vtkTextureObject* output, unsigned int levels, bool halfPrecision)
+{
+  vtkOpenGLRenderWindow* renWin = vtkOpenGLRenderWindow::SafeDownCast(ren->GetRenderWindow());
+  if (!renWin || !output || levels == 0 || !vtkF3DEnvironmentCompute::IsSupported())
+  {
+    return false;
+  }
+
+  vtkTextureObject* cubeMap = this->UpdateCubeMap(ren, environment);
+  const int precision = halfPrecision ? 0 : 1;
+  std::string source = vtkF3DPrefilterSpecularCS;
+  vtkShaderProgram::Substitute(
+    source, "//F3D::PrefilterFormat", halfPrecision ? "rgba16f" : "rgba32f");
+  vtkShaderProgram* program = this->SpecularPrograms[precision];
+  if (!cubeMap || !::ReadyProgram(renWin, this->SpecularShaders[precision], program, source))
+  {
+    return false;
+  }
+
+  cubeMap->Activate();
+  program->SetUniformi("environment", cubeMap->GetTextureUnit());
+  program->SetUniformi("environmentSize", static_cast<int>(cubeMap->GetWidth()));
+  program->SetUniformi("samples", this->SpecularSamples);
+
+  const GLenum format = halfPrecision ? GL_RGBA16F : GL_RGBA32F;
+  for (unsigned int level = 0; level < levels; level++)
+  {
+    const int size = static_cast<int>(std::max(output->GetWidth() >> level, 1u));
+    const float roughness = levels > 1 ? static_cast<float>(level) / (levels - 1) : 0.f;
+    program->SetUniformi("size", size);
+    program->SetUniformf("roughness", roughness);
+
+    glBindImageTexture(
+      0, output->GetHandle(), static_cast<GLint>(level), GL_TRUE, 0, GL_WRITE_ONLY, format);
+    glDispatchCompute((size + 7) / 8, (size + 7) / 8, 6);
+  }
+  glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT | GL_TEXTURE_UPDATE_BARRIER_BIT);
+  glBindImageTexture(0, 0, 0, GL_FALSE, 0, GL_WRITE_ONLY, format);
+  cubeMap->Deactivate();
+
+  return true;
+}
@@ -0,0 +1,95 @@
+/**
+ * @class   vtkF3DEnvironmentCompute
+ * @brief   Compute shaders preprocessing an environment texture for image based lighting
+ *
+ * An equirectangular environment is first converted to a cube map, whose mip levels are
+ * generated. Its radiance is projected on the spherical harmonics with a parallel reduction,
+ * and it is prefiltered into the specular cube map with GGX importance sampling. The samples
+ * read the mip level matching their solid angle (filtered importance sampling), so that far
+ * fewer samples than the fragment shader of vtkPBRPrefilterTexture are needed.
+ * The converted cube map is kept until the environment texture is modified.
+ */
+
+#ifndef vtkF3DEnvironmentCompute_h
+#define vtkF3DEnvironmentCompute_h
+
+#include <vtkNew.h>
+#include <vtkObject.h>
+#include <vtkSmartPointer.h>
+
+class vtkEquirectangularToCubeMapTexture;
+class vtkFloatArray;
+class vtkOpenGLBufferObject;
+class vtkOpenGLTexture;
+class vtkRenderer;
+class vtkShader;
+class vtkShaderProgram;
+class vtkTextureObject;
+
+class vtkF3DEnvironmentCompute : public vtkObject
+{
+public:
+  static vtkF3DEnvironmentCompute* New();
+  vtkTypeMacro(vtkF3DEnvironmentCompute, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Return true if compute shaders are supported by the current OpenGL context.
+   */
+  static bool IsSupported();
+
+  ///@{
+  /**
+   * Set/Get the number of samples per texel of the prefiltered specular levels.
+   * Default is 64.
+   */
+  vtkSetClampMacro(SpecularSamples, int, 1, 4096);
+  vtkGetMacro(SpecularSamples, int);
+  ///@}
+
+  /**
+   * Project the radiance of the environment texture on the 9 first spherical harmonics, in the
+   * layout of vtkSphericalHarmonics: 9 tuples of 3 components.
+   * The OpenGL context of the renderer must be current.
+   * Returns false if it cannot be computed.
+   */
+  bool ComputeSphericalHarmonics(
+    vtkRenderer* ren, vtkOpenGLTexture* environment, vtkFloatArray* harmonics);
+
+  /**
+   * Prefilter the environment texture in the levels of the output cube map, the roughness of
+   * the level i being i / (levels - 1). The output must be a RGBA16F, or RGBA32F if halfPrecision
+   * is false, cube map whose levels are allocated.
+   * The OpenGL context of the renderer must be current.
+   * Returns false if it cannot be computed.
+   */
+  bool ComputeSpecular(vtkRenderer* ren, vtkOpenGLTexture* environment, vtkTextureObject* output,
+    unsigned int levels, bool halfPrecision);
+
+protected:
+  vtkF3DEnvironmentCompute();
+  ~vtkF3DEnvironmentCompute() override;
+
+private:
+  vtkF3DEnvironmentCompute(const vtkF3DEnvironmentCompute&) = delete;
+  void operator=(const vtkF3DEnvironmentCompute&) = delete;
+
+  /**
+   * Load the mipmapped cube map of the environment, converting it if needed.
+   * The returned texture object is not active.
+   */
+  vtkTextureObject* UpdateCubeMap(vtkRenderer* ren, vtkOpenGLTexture* environment);
+
+  int SpecularSamples = 64;
+
+  vtkSmartPointer<vtkEquirectangularToCubeMapTexture> CubeMap;
+
+  vtkNew<vtkShader> SphericalHarmonicsShader;
+  vtkNew<vtkShaderProgram> SphericalHarmonicsProgram;
+  vtkNew<vtkOpenGLBufferObject> Partials;
+
+  vtkNew<vtkShader> SpecularShaders[2];
+  vtkNew<vtkShaderProgram> SpecularPrograms[2];
+};
+
+#endif
@@ -0,0 +1,244 @@
+#include "vtkF3DFrameStatistics.h"
+
+#include <vtkObjectFactory.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <map>
+#include <numeric>
+#include <sstream>
+
+namespace
+{
+//----------------------------------------------------------------------------
+vtkF3DFrameStatistics::Summary ComputeSummary(const std::deque<double>& samples)
+{
+  vtkF3DFrameStatistics::Summary summary;
+  summary.Count = samples.size();
+  if (samples.empty())
+  {
+    return summary;
+  }
+
+  std::vector<double> sorted(samples.begin(), samples.end());
+  std::sort(sorted.begin(), sorted.end());
+
+  // nearest-rank percentiles
+  auto percentile = [&](double p)
+  {
+    std::size_t rank = static_cast<std::size_t>(std::ceil(p * sorted.size()));
+    return sorted[std::clamp<std::size_t>(rank, 1, sorted.size()) - 1];
+  };
+
+  summary.Min = sorted.front();
+  summary.Average = std::accumulate(sorted.begin(), sorted.end(), 0.0) / sorted.size();
+  summary.P95 = percentile(0.95);
+  summary.P99 = percentile(0.99);
+  return summary;
+}
+
+//----------------------------------------------------------------------------
+void PrintSummaryJSON(std::ostream& os, const vtkF3DFrameStatistics::Summary& summary)
+{
+  os << "{\"min\":" << summary.Min << ",\"avg\":" << summary.Average << ",\"p95\":" << summary.P95
+     << ",\"p99\":" << summary.P99 << "}";
+}
+
+//----------------------------------------------------------------------------
+void PrintSummaryLine(
+  std::ostream& os, const std::string& name, const vtkF3DFrameStatistics::Summary& summary)
+{
+  os << std::left << std::setw(17) << name << std::right << std::setw(8) << summary.Min
+     << std::setw(8) << summary.Average << std::setw(8) << summary.P95 << std::setw(8)
+     << summary.P99 << "\n";
+}
+}
+
+vtkStandardNewMacro(vtkF3DFrameStatistics);
+
+//----------------------------------------------------------------------------
+void vtkF3DFrameStatistics::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "WindowSize: " << this->WindowSize << "\n";
+  os << indent << "Frames: " << this->CPUSamples.size() << "\n";
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DFrameStatistics::BeginPass(const std::string& name)
+{
+  int parent = this->PassStack.empty() ? -1 : this->PassStack.back();
+  this->PassStack.push_back(static_cast<int>(this->PendingPasses.size()));
+  this->PendingPasses.push_back({ name, parent, nullptr });
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DFrameStatistics::EndPass(std::function<double()> elapsed)
+{
+  if (this->PassStack.empty())
+  {
+    vtkErrorMacro("EndPass called without a matching BeginPass");
+    return;
+  }
+  this->PendingPasses[this->PassStack.back()].Elapsed = std::move(elapsed);
+  this->PassStack.pop_back();
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DFrameStatistics::EndFrame(double cpuTime, double gpuTime)
+{
+  this->AddSample(this->CPUSamples, cpuTime);
+  if (gpuTime >= 0)
+  {
+    this->AddSample(this->GPUSamples, gpuTime);
+  }
+
+  // resolve the inclusive time of the passes and remove the time of the nested ones
+  std::vector<double> times(this->PendingPasses.size(), 0.0);
+  for (std::size_t i = 0; i < this->PendingPasses.size(); i++)
+  {
+    const PendingPass& pass = this->PendingPasses[i];
+    double elapsed = pass.Elapsed ? pass.Elapsed() : 0.0;
+    times[i] += elapsed;
+    if (pass.Parent >= 0)
+    {
+      times[pass.Parent] -= elapsed;
+    }
+  }
+
+  // a pass rendered several times in a frame is accumulated
+  std::map<std::string, double> frameTimes;
+  for (std::size_t i = 0; i < this->PendingPasses.size(); i++)
+  {
+    const std::string& name = this->PendingPasses[i].Name;
+    if (frameTimes.find(name) == frameTimes.end() &&
+      std::none_of(this->Passes.begin(), this->Passes.end(),
+        [&](const PassSamples& passSamples) { return passSamples.Name == name; }))
+    {
+      this->Passes.push_back({ name, {} });
+    }
+    frameTimes[name] += std::max(times[i], 0.0);
+  }
+
+  for (PassSamples& passSamples : this->Passes)
+  {
+    auto it = frameTimes.find(passSamples.Name);
+    if (it != frameTimes.end())
+    {
+      this->AddSample(passSamples.Samples, it->second);
+    }
+  }
+
+  this->PendingPasses.clear();
+  this->PassStack.clear();
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DFrameStatistics::Reset()
+{
+  this->PendingPasses.clear();
+  this->PassStack.clear();
+  this->CPUSamples.clear();
+  this->GPUSamples.clear();
+  this->Passes.clear();
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DFrameStatistics::AddSample(std::deque<double>& samples, double value)
+{
+  samples.push_back(value);
+  while (samples.size() > static_cast<std::size_t>(this->WindowSize))
+  {
+    samples.pop_front();
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkF3DFrameStatistics::Summary vtkF3DFrameStatistics::GetCPUSummary() const
+{
+  return ::ComputeSummary(this->CPUSamples);
+}
+
+//----------------------------------------------------------------------------
+vtkF3DFrameStatistics::Summary vtkF3DFrameStatistics::GetGPUSummary() const
+{
+  return ::ComputeSummary(this->GPUSamples);
+}
+
+//----------------------------------------------------------------------------
+std::vector<std::string> vtkF3DFrameStatistics::GetPassNames() const
+{
+  std::vector<std::string> names;
+  for (const PassSamples& passSamples : this->Passes)
+  {
+    names.push_back(passSamples.Name);
+  }
+  return names;
+}
+
+//----------------------------------------------------------------------------
+vtkF3DFrameStatistics::Summary vtkF3DFrameStatistics::GetPassSummary(const std::string& name) const
+{
+  for (const PassSamples& passSamples : this->Passes)
+  {
+    if (passSamples.Name == name)
+    {
+      return ::ComputeSummary(passSamples.Samples);
+    }
+  }
+  return {};
+}
+
+//----------------------------------------------------------------------------
+std::string vtkF3DFrameStatistics::GetDescription() const
+{
+  std::stringstream stream;
+  stream << std::fixed << std::setprecision(2);
+  stream << "Last " << this->CPUSamples.size() << " frames (ms)\n";
+  stream << std::left << std::setw(17) << "" << std::right << std::setw(8) << "min"
+         << std::setw(8) << "avg" << std::setw(8) << "p95" << std::setw(8) << "p99" << "\n";
+  ::PrintSummaryLine(stream, "CPU", this->GetCPUSummary());
+
+  Summary gpu = this->GetGPUSummary();
+  if (gpu.Count > 0)
+  {
+    ::PrintSummaryLine(stream, "GPU", gpu);
+  }
+
+  for (const PassSamples& passSamples : this->Passes)
+  {
+    ::PrintSummaryLine(stream, " " + passSamples.Name, ::ComputeSummary(passSamples.Samples));
+  }
+
+  std::string description = stream.str();
+  description.pop_back();
+  return description;
+}
+
+//----------------------------------------------------------------------------
+std::string vtkF3DFrameStatistics::GetJSON() const
+{
+  std::stringstream stream;
+  stream << std::fixed << std::setprecision(3);
+  stream << "{\"frames\":" << this->CPUSamples.size() << ",\"cpu\":";
+  ::PrintSummaryJSON(stream, this->GetCPUSummary());
+
+  Summary gpu = this->GetGPUSummary();
+  if (gpu.Count > 0)
+  {
+    stream << ",\"gpu\":";
+    ::PrintSummaryJSON(stream, gpu);
+  }
+
+  stream << ",\"passes\":{";
+  for (std::size_t i = 0; i < this->Passes.size(); i++)
+  {
+    stream << (i > 0 ? "," : "") << "\"" << this->Passes[i].Name << "\":";
+    ::PrintSummaryJSON(stream, ::ComputeSummary(this->Passes[i].Samples));
+  }
+  stream << "}}";
+  return stream.str();
+}
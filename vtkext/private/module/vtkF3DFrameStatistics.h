@@ -0,0 +1,133 @@
+/**
+ * @class   vtkF3DFrameStatistics
+ * @brief   Sliding window statistics of the frame times
+ *
+ * This class stores the CPU and GPU times of the last rendered frames, as well as the time spent
+ * in each render pass, and computes their minimum, average, 95th and 99th percentiles.
+ * Passes are recorded between BeginPass and EndPass and can be nested, the time of a pass
+ * excludes the time of the passes nested into it.
+ * Pass times are resolved when calling EndFrame, so that GPU queries can be read back once the
+ * frame is complete instead of stalling the pipeline after each pass.
+ */
+
+#ifndef vtkF3DFrameStatistics_h
+#define vtkF3DFrameStatistics_h
+
+#include <vtkObject.h>
+
+#include <deque>
+#include <functional>
+#include <string>
+#include <vector>
+
+class vtkF3DFrameStatistics : public vtkObject
+{
+public:
+  static vtkF3DFrameStatistics* New();
+  vtkTypeMacro(vtkF3DFrameStatistics, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  struct Summary
+  {
+    double Min = 0;
+    double Average = 0;
+    double P95 = 0;
+    double P99 = 0;
+    std::size_t Count = 0;
+  };
+
+  ///@{
+  /**
+   * Set/Get the number of frames the statistics are computed on.
+   * Default is 120
+   */
+  vtkSetClampMacro(WindowSize, int, 1, VTK_INT_MAX);
+  vtkGetMacro(WindowSize, int);
+  ///@}
+
+  /**
+   * Start recording a pass named `name`, nested into the current pass if any
+   */
+  void BeginPass(const std::string& name);
+
+  /**
+   * Stop recording the current pass, `elapsed` returns its time in milliseconds
+   * and is called by EndFrame
+   */
+  void EndPass(std::function<double()> elapsed);
+
+  /**
+   * Add the times of a frame, in milliseconds, and the times of its passes.
+   * A negative GPU time is ignored.
+   */
+  void EndFrame(double cpuTime, double gpuTime);
+
+  /**
+   * Remove all the recorded frames
+   */
+  void Reset();
+
+  /**
+   * Get the statistics of the CPU frame times
+   */
+  Summary GetCPUSummary() const;
+
+  /**
+   * Get the statistics of the GPU frame times, Count is 0 if they are not available
+   */
+  Summary GetGPUSummary() const;
+
+  /**
+   * Get the names of the recorded passes, in the order they were first rendered
+   */
+  std::vector<std::string> GetPassNames() const;
+
+  /**
+   * Get the statistics of a pass, Count is 0 if it is not recorded
+   */
+  Summary GetPassSummary(const std::string& name) const;
+
+  /**
+   * Get a multi-line human readable description of the statistics
+   */
+  std::string GetDescription() const;
+
+  /**
+   * Get the statistics as a single line JSON object
+   */
+  std::string GetJSON() const;
+
+protected:
+  vtkF3DFrameStatistics() = default;
+  ~vtkF3DFrameStatistics() override = default;
+
+private:
+  vtkF3DFrameStatistics(const vtkF3DFrameStatistics&) = delete;
+  void operator=(const vtkF3DFrameStatistics&) = delete;
+
+  void AddSample(std::deque<double>& samples, double value);
+
+  struct PendingPass
+  {
+    std::string Name;
+    int Parent;
+    std::function<double()> Elapsed;
+  };
+
+  struct PassSamples
+  {
+    std::string Name;
+    std::deque<double> Samples;
+  };
+
+  std::vector<PendingPass> PendingPasses;
+  std::vector<int> PassStack;
+
+  std::deque<double> CPUSamples;
+  std::deque<double> GPUSamples;
+  std::vector<PassSamples> Passes;
+
+  int WindowSize = 120;
+};
+
+#endif
@@ -0,0 +1,529 @@
+#include "vtkF3DGLBWriter.h"
+
+#include "vtkF3DReorderTrianglesFilter.h"
+
+#include <vtkActor.h>
+#include <vtkCellArray.h>
+#include <vtkCellArrayIterator.h>
+#include <vtkDataArray.h>
+#include <vtkImageData.h>
+#include <vtkMatrix4x4.h>
+#include <vtkNew.h>
+#include <vtkObjectFactory.h>
+#include <vtkPNGWriter.h>
+#include <vtkPointData.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkPolyDataMapper.h>
+#include <vtkProperty.h>
+#include <vtkSmartPointer.h>
+#include <vtkTexture.h>
+#include <vtkUnsignedCharArray.h>
+#include <vtksys/FStream.hxx>
+#include <vtksys/SystemTools.hxx>
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <tuple>
+#include <utility>
+
+namespace
+{
+constexpr uint32_t Magic = 0x46546C67;
+constexpr uint32_t Version = 2;
+constexpr uint32_t JSONChunk = 0x4E4F534A;
+constexpr uint32_t BINChunk = 0x004E4942;
+
+// Values defined by the glTF specification
+constexpr int ArrayBuffer = 34962;
+constexpr int ElementArrayBuffer = 34963;
+constexpr int UnsignedShort = 5123;
+constexpr int UnsignedInt = 5125;
+constexpr int Float = 5126;
+constexpr int ModePoints = 0;
+constexpr int ModeLines = 1;
+constexpr int ModeTriangles = 4;
+constexpr int Nearest = 9728;
+constexpr int Linear = 9729;
+constexpr int LinearMipmapLinear = 9987;
+constexpr int ClampToEdge = 33071;
+constexpr int Repeat = 10497;
+
+//----------------------------------------------------------------------------
+template<typename T>
+void Write(std::ostream& os, const T& value)
+{
+  os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+//----------------------------------------------------------------------------
+std::vector<vtkIdType> GetConnectivity(vtkCellArray* cells)
+{
+  std::vector<vtkIdType> connectivity;
+  connectivity.reserve(cells->GetNumberOfConnectivityIds());
+  auto iter = vtk::TakeSmartPointer(cells->NewIterator());
+  for (iter->GoToFirstCell(); !iter->IsDoneWithTraversal(); iter->GoToNextCell())
+  {
+    vtkIdType npts;
+    const vtkIdType* pts;
+    iter->GetCurrentCell(npts, pts);
+    connectivity.insert(connectivity.end(), pts, pts + npts);
+  }
+  return connectivity;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * Triangulate the polygons as fans and the strips, keeping the orientation of the triangles
+ */
+vtkSmartPointer<vtkCellArray> Triangulate(vtkPolyData* surface)
+{
+  vtkNew<vtkCellArray> triangles;
+  auto iter = vtk::TakeSmartPointer(surface->GetPolys()->NewIterator());
+  for (iter->GoToFirstCell(); !iter->IsDoneWithTraversal(); iter->GoToNextCell())
+  {
+    vtkIdType npts;
+    const vtkIdType* pts;
+    iter->GetCurrentCell(npts, pts);
+    for (vtkIdType i = 2; i < npts; i++)
+    {
+      const vtkIdType triangle[3] = { pts[0], pts[i - 1], pts[i] };
+      triangles->InsertNextCell(3, triangle);
+    }
+  }
+
+  iter = vtk::TakeSmartPointer(surface->GetStrips()->NewIterator());
+  for (iter->GoToFirstCell(); !iter->IsDoneWithTraversal(); iter->GoToNextCell())
+  {
+    vtkIdType npts;
+    const vtkIdType* pts;
+    iter->GetCurrentCell(npts, pts);
+    for (vtkIdType i = 2; i < npts; i++)
+    {
+      const vtkIdType triangle[3] = { pts[i % 2 ? i - 1 : i - 2], pts[i % 2 ? i - 2 : i - 1],
+        pts[i] };
+      triangles->InsertNextCell(3, triangle);
+    }
+  }
+  return triangles;
+}
+
+//----------------------------------------------------------------------------
+vtkImageData* GetTextureImage(vtkTexture* texture)
+{
+  // Only the images that a PNG can store are written
+  if (texture->GetCubeMap() || texture->GetNumberOfInputConnections(0) == 0)
+  {
+    return nullptr;
+  }
+  texture->GetInputAlgorithm()->Update();
+  vtkImageData* image = texture->GetInput();
+  vtkDataArray* scalars = image ? image->GetPointData()->GetScalars() : nullptr;
+  return scalars &&
+      (scalars->GetDataType() == VTK_UNSIGNED_CHAR ||
+        scalars->GetDataType() == VTK_UNSIGNED_SHORT) &&
+      scalars->GetNumberOfComponents() <= 4
+    ? image
+    : nullptr;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * Build the glTF document and its binary buffer
+ */
+class Document
+{
+public:
+  nlohmann::json Root;
+  std::string Binary;
+
+  //----------------------------------------------------------------------------
+  int AddNode(vtkActor* actor)
+  {
+    vtkPolyData* surface = vtkPolyDataMapper::SafeDownCast(actor->GetMapper())->GetInput();
+    const nlohmann::json* primitive = this->GetPrimitive(surface);
+    if (!primitive)
+    {
+      return -1;
+    }
+
+    // A mesh is shared by the actors with the same surface and material
+    const int material = this->GetMaterial(actor);
+    auto key = std::make_pair(surface, material);
+    auto it = this->Meshes.find(key);
+    if (it == this->Meshes.end())
+    {
+      nlohmann::json meshPrimitive = *primitive;
+      meshPrimitive["material"] = material;
+      this->Root["meshes"].push_back(
+        { { "primitives", nlohmann::json::array({ meshPrimitive }) } });
+      it = this->Meshes.emplace(key, static_cast<int>(this->Root["meshes"].size()) - 1).first;
+    }
+
+    nlohmann::json node = { { "mesh", it->second } };
+    vtkNew<vtkMatrix4x4> matrix;
+    actor->GetMatrix(matrix);
+    bool identity = true;
+    nlohmann::json values = nlohmann::json::array();
+    for (int col = 0; col < 4; col++)
+    {
+      for (int row = 0; row < 4; row++)
+      {
+        values.push_back(matrix->GetElement(row, col));
+        identity = identity && matrix->GetElement(row, col) == (row == col ? 1.0 : 0.0);
+      }
+    }
+    if (!identity)
+    {
+      node["matrix"] = values;
+    }
+    this->Root["nodes"].push_back(node);
+    return static_cast<int>(this->Root["nodes"].size()) - 1;
+  }
+
+private:
+  std::map<vtkPolyData*, nlohmann::json> Primitives;
+  std::map<std::pair<vtkPolyData*, int>, int> Meshes;
+  std::map<std::pair<vtkProperty*, vtkTexture*>, int> Materials;
+  std::map<vtkTexture*, int> Textures;
+  std::map<std::tuple<int, int, int>, int> Samplers;
+
+  //----------------------------------------------------------------------------
+  int AddView(const void* data, std::size_t size, int target)
+  {
+    // Accessors need their data aligned on the size of their components
+    this->Binary.resize((this->Binary.size() + 3) / 4 * 4, '\0');
+    nlohmann::json view = { { "buffer", 0 }, { "byteOffset", this->Binary.size() },
+      { "byteLength", size } };
+    if (target != 0)
+    {
+      view["target"] = target;
+    }
+    this->Binary.append(static_cast<const char*>(data), size);
+    this->Root["bufferViews"].push_back(view);
+    return static_cast<int>(this->Root["bufferViews"].size()) - 1;
+  }
+
+  //----------------------------------------------------------------------------
+  int AddAccessor(nlohmann::json accessor)
+  {
+    this->Root["accessors"].push_back(std::move(accessor));
+    return static_cast<int>(this->Root["accessors"].size()) - 1;
+  }
+
+  //----------------------------------------------------------------------------
+  int AddFloatAccessor(vtkDataArray* array, int nbComponents, const char* type, bool flipV = false)
+  {
+    const vtkIdType nbTuples = array->GetNumberOfTuples();
+    std::vector<float> values(static_cast<std::size_t>(nbTuples) * nbComponents);
+    std::vector<float> minimum(nbComponents, std::numeric_limits<float>::max());
+    std::vector<float> maximum(nbComponents, std::numeric_limits<float>::lowest());
+    for (vtkIdType t = 0; t < nbTuples; t++)
+    {
+      for (int c = 0; c < nbComponents; c++)
+      {
+        // The texture coordinates start at the top of the images in glTF
+        double value = array->GetComponent(t, c);
+        float& out = values[t * nbComponents + c];
+        out = static_cast<float>(flipV && c == 1 ? 1.0 - value : value);
+        minimum[c] = std::min(minimum[c], out);
+        maximum[c] = std::max(maximum[c], out);
+      }
+    }
+
+    nlohmann::json accessor = { { "bufferView",
+                                  this->AddView(values.data(), values.size() * sizeof(float),
+                                    ::ArrayBuffer) },
+      { "componentType", ::Float }, { "count", nbTuples }, { "type", type } };
+    if (nbTuples > 0)
+    {
+      accessor["min"] = minimum;
+      accessor["max"] = maximum;
+    }
+    return this->AddAccessor(std::move(accessor));
+  }
+
+  //----------------------------------------------------------------------------
+  template<typename T>
+  int AddIndicesAccessor(const std::vector<vtkIdType>& indices, int componentType)
+  {
+    std::vector<T> values(indices.begin(), indices.end());
+    return this->AddAccessor({ { "bufferView",
+                                 this->AddView(values.data(), values.size() * sizeof(T),
+                                   ::ElementArrayBuffer) },
+      { "componentType", componentType }, { "count", values.size() }, { "type", "SCALAR" } });
+  }
+
+  //----------------------------------------------------------------------------
+  /**
+   * Return the primitive of a surface, without material, or nullptr if it cannot be written
+   */
+  const nlohmann::json* GetPrimitive(vtkPolyData* surface)
+  {
+    auto it = this->Primitives.find(surface);
+    if (it != this->Primitives.end())
+    {
+      return it->second.is_null() ? nullptr : &it->second;
+    }
+    nlohmann::json& primitive = this->Primitives[surface];
+    if (!surface || !surface->GetPoints() || surface->GetNumberOfPoints() == 0)
+    {
+      return nullptr;
+    }
+
+    // The surfaces with triangles are reordered for the vertex caches, only their triangles are
+    // written, other surfaces are written as lines or points
+    vtkSmartPointer<vtkPolyData> output = surface;
+    std::vector<vtkIdType> indices;
+    int mode = ::ModeTriangles;
+    vtkSmartPointer<vtkCellArray> triangles = ::Triangulate(surface);
+    if (triangles->GetNumberOfCells() > 0)
+    {
+      vtkNew<vtkPolyData> triangulated;
+      triangulated->SetPoints(surface->GetPoints());
+      triangulated->GetPointData()->ShallowCopy(surface->GetPointData());
+      triangulated->SetPolys(triangles);
+      vtkNew<vtkF3DReorderTrianglesFilter> reorder;
+      reorder->SetInputData(triangulated);
+      reorder->Update();
+      output = reorder->GetOutput();
+      indices = ::GetConnectivity(output->GetPolys());
+    }
+    else if (surface->GetNumberOfLines() > 0)
+    {
+      mode = ::ModeLines;
+      auto iter = vtk::TakeSmartPointer(surface->GetLines()->NewIterator());
+      for (iter->GoToFirstCell(); !iter->IsDoneWithTraversal(); iter->GoToNextCell())
+      {
+        vtkIdType npts;
+        const vtkIdType* pts;
+        iter->GetCurrentCell(npts, pts);
+        for (vtkIdType i = 1; i < npts; i++)
+        {
+          indices.insert(indices.end(), { pts[i - 1], pts[i] });
+        }
+      }
+    }
+    else if (surface->GetNumberOfVerts() > 0)
+    {
+      mode = ::ModePoints;
+      indices = ::GetConnectivity(surface->GetVerts());
+    }
+    if (indices.empty())
+    {
+      return nullptr;
+    }
+
+    nlohmann::json attributes = { { "POSITION",
+      this->AddFloatAccessor(output->GetPoints()->GetData(), 3, "VEC3") } };
+    vtkDataArray* normals = output->GetPointData()->GetNormals();
+    if (normals && normals->GetNumberOfComponents() == 3)
+    {
+      attributes["NORMAL"] = this->AddFloatAccessor(normals, 3, "VEC3");
+    }
+    vtkDataArray* tcoords = output->GetPointData()->GetTCoords();
+    if (tcoords && tcoords->GetNumberOfComponents() >= 2)
+    {
+      attributes["TEXCOORD_0"] = this->AddFloatAccessor(tcoords, 2, "VEC2", true);
+    }
+
+    // The largest value of the type is reserved for primitive restart
+    const int indicesAccessor = output->GetNumberOfPoints() < std::numeric_limits<uint16_t>::max()
+      ? this->AddIndicesAccessor<uint16_t>(indices, ::UnsignedShort)
+      : this->AddIndicesAccessor<uint32_t>(indices, ::UnsignedInt);
+
+    primitive = { { "attributes", attributes }, { "indices", indicesAccessor }, { "mode", mode } };
+    return &primitive;
+  }
+
+  //----------------------------------------------------------------------------
+  int GetSampler(vtkTexture* texture)
+  {
+    const bool interpolate = texture->GetInterpolate();
+    auto key = std::make_tuple(interpolate ? ::Linear : ::Nearest,
+      interpolate ? (texture->GetMipmap() ? ::LinearMipmapLinear : ::Linear) : ::Nearest,
+      texture->GetRepeat() ? ::Repeat : ::ClampToEdge);
+    auto it = this->Samplers.find(key);
+    if (it == this->Samplers.end())
+    {
+      this->Root["samplers"].push_back({ { "magFilter", std::get<0>(key) },
+        { "minFilter", std::get<1>(key) }, { "wrapS", std::get<2>(key) },
+        { "wrapT", std::get<2>(key) } });
+      it = this->Samplers.emplace(key, static_cast<int>(this->Root["samplers"].size()) - 1).first;
+    }
+    return it->second;
+  }
+
+  //----------------------------------------------------------------------------
+  /**
+   * Return the index of the texture, or -1 if its image cannot be written
+   */
+  int GetTexture(vtkTexture* texture)
+  {
+    if (!texture)
+    {
+      return -1;
+    }
+    auto it = this->Textures.find(texture);
+    if (it != this->Textures.end())
+    {
+      return it->second;
+    }
+
+    int index = -1;
+    vtkImageData* image = ::GetTextureImage(texture);
+    if (image)
+    {
+      vtkNew<vtkPNGWriter> writer;
+      writer->WriteToMemoryOn();
+      writer->SetInputData(image);
+      writer->Write();
+      vtkUnsignedCharArray* png = writer->GetResult();
+      if (png && png->GetNumberOfValues() > 0)
+      {
+        const int view = this->AddView(
+          png->GetPointer(0), static_cast<std::size_t>(png->GetNumberOfValues()), 0);
+        this->Root["images"].push_back({ { "bufferView", view }, { "mimeType", "image/png" } });
+        this->Root["textures"].push_back({ { "sampler", this->GetSampler(texture) },
+          { "source", static_cast<int>(this->Root["images"].size()) - 1 } });
+        index = static_cast<int>(this->Root["textures"].size()) - 1;
+      }
+    }
+    this->Textures.emplace(texture, index);
+    return index;
+  }
+
+  //----------------------------------------------------------------------------
+  int GetMaterial(vtkActor* actor)
+  {
+    vtkProperty* property = actor->GetProperty();
+    auto key = std::make_pair(property, actor->GetTexture());
+    auto it = this->Materials.find(key);
+    if (it != this->Materials.end())
+    {
+      return it->second;
+    }
+
+    double color[3];
+    property->GetColor(color);
+    const double opacity = property->GetOpacity();
+    nlohmann::json pbr = { { "baseColorFactor", { color[0], color[1], color[2], opacity } },
+      { "metallicFactor", property->GetMetallic() },
+      { "roughnessFactor", property->GetRoughness() } };
+    nlohmann::json material = { { "doubleSided", !property->GetBackfaceCulling() } };
+
+    int albedo = this->GetTexture(property->GetTexture("albedoTex"));
+    if (albedo < 0)
+    {
+      albedo = this->GetTexture(actor->GetTexture());
+    }
+    if (albedo >= 0)
+    {
+      pbr["baseColorTexture"] = { { "index", albedo } };
+    }
+
+    // The occlusion, roughness and metallic channels of the material texture match glTF ones
+    const int orm = this->GetTexture(property->GetTexture("materialTex"));
+    if (orm >= 0)
+    {
+      pbr["metallicRoughnessTexture"] = { { "index", orm } };
+      material["occlusionTexture"] = { { "index", orm },
+        { "strength", property->GetOcclusionStrength() } };
+    }
+    const int normal = this->GetTexture(property->GetTexture("normalTex"));
+    if (normal >= 0)
+    {
+      material["normalTexture"] = { { "index", normal }, { "scale", property->GetNormalScale() } };
+    }
+
+    // The emissive factor is only used with an emissive texture by VTK
+    const int emissive = this->GetTexture(property->GetTexture("emissiveTex"));
+    if (emissive >= 0)
+    {
+      const double* factor = property->GetEmissiveFactor();
+      material["emissiveTexture"] = { { "index", emissive } };
+      material["emissiveFactor"] = { factor[0], factor[1], factor[2] };
+    }
+
+    material["pbrMetallicRoughness"] = pbr;
+    if (opacity < 1.0)
+    {
+      material["alphaMode"] = "BLEND";
+    }
+    this->Root["materials"].push_back(material);
+    const int index = static_cast<int>(this->Root["materials"].size()) - 1;
+    this->Materials.emplace(key, index);
+    return index;
+  }
+};
+}
+
+//----------------------------------------------------------------------------
+vtkStandardNewMacro(vtkF3DGLBWriter);
+
+//----------------------------------------------------------------------------
+bool vtkF3DGLBWriter::Write(const std::vector<vtkActor*>& actors, const std::string& fileName)
+{
+  ::Document document;
+  document.Root["asset"] = { { "version", "2.0" }, { "generator", "F3D" } };
+  nlohmann::json nodes = nlohmann::json::array();
+  for (vtkActor* actor : actors)
+  {
+    if (!actor->GetVisibility() || !vtkPolyDataMapper::SafeDownCast(actor->GetMapper()))
+    {
+      continue;
+    }
+    const int node = document.AddNode(actor);
+    if (node >= 0)
+    {
+      nodes.push_back(node);
+    }
+  }
+
+  // A scene cannot have an empty list of nodes
+  document.Root["scene"] = 0;
+  document.Root["scenes"] = nlohmann::json::array(
+    { nodes.empty() ? nlohmann::json::object() : nlohmann::json({ { "nodes", nodes } }) });
+
+  std::string& binary = document.Binary;
+  binary.resize((binary.size() + 3) / 4 * 4, '\0');
+  if (!binary.empty())
+  {
+    document.Root["buffers"] = nlohmann::json::array({ { { "byteLength", binary.size() } } });
+  }
+  std::string json = document.Root.dump();
+  json.resize((json.size() + 3) / 4 * 4, ' ');
+
+  const std::string tmpPath = fileName + ".tmp";
+  vtksys::ofstream file(tmpPath.c_str(), std::ios::binary);
+  if (!file.is_open())
+  {
+    return false;
+  }
+
+  const std::size_t length = 12 + 8 + json.size() + (binary.empty() ? 0 : 8 + binary.size());
+  ::Write(file, ::Magic);
+  ::Write(file, ::Version);
+  ::Write(file, static_cast<uint32_t>(length));
+  ::Write(file, static_cast<uint32_t>(json.size()));
+  ::Write(file, ::JSONChunk);
+  file.write(json.data(), static_cast<std::streamsize>(json.size()));
+  if (!binary.empty())
+  {
+    ::Write(file, static_cast<uint32_t>(binary.size()));
+    ::Write(file, ::BINChunk);
+    file.write(binary.data(), static_cast<std::streamsize>(binary.size()));
+  }
+  file.close();
+
+  if (!file || !vtksys::SystemTools::RenameFile(tmpPath, fileName))
+  {
+    vtksys::SystemTools::RemoveFile(tmpPath);
+    return false;
+  }
+  return true;
+}
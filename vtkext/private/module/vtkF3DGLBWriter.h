@@ -0,0 +1,49 @@
+/**
+ * @class   vtkF3DGLBWriter
+ * @brief   Writer of imported actors in a binary glTF file
+ *
+ * Write the actors imported by any importer in a single GLB file, so that a scene that is slow
+ * to import, eg. a STEP, FBX or USD file, can be converted once in a file that any glTF viewer,
+ * including web clients, loads quickly.
+ * The surfaces are triangulated and their triangles reordered for the GPU vertex caches with
+ * vtkF3DReorderTrianglesFilter before being written with 16 bits indices when possible.
+ * A surface shared by several actors is only written once and used by a node for each actor,
+ * so that instancing is preserved, each node storing the matrix of its actor.
+ * The PBR materials are written with their textures, which are embedded as PNG images.
+ * Only the actors with a vtkPolyDataMapper are written, with their normals and texture
+ * coordinates; the surfaces without triangles are written as lines or points.
+ * The lights, cameras, animations and data arrays are not written.
+ */
+
+#ifndef vtkF3DGLBWriter_h
+#define vtkF3DGLBWriter_h
+
+#include <vtkObject.h>
+
+#include <string>
+#include <vector>
+
+class vtkActor;
+
+class vtkF3DGLBWriter : public vtkObject
+{
+public:
+  static vtkF3DGLBWriter* New();
+  vtkTypeMacro(vtkF3DGLBWriter, vtkObject);
+
+  /**
+   * Write the visible provided actors in a GLB file.
+   * Return false if the file cannot be written, in which case no file is left.
+   */
+  static bool Write(const std::vector<vtkActor*>& actors, const std::string& fileName);
+
+protected:
+  vtkF3DGLBWriter() = default;
+  ~vtkF3DGLBWriter() override = default;
+
+private:
+  vtkF3DGLBWriter(const vtkF3DGLBWriter&) = delete;
+  void operator=(const vtkF3DGLBWriter&) = delete;
+};
+
+#endif
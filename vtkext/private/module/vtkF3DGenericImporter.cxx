@@ -1,12 +1,21 @@
 #include "vtkF3DGenericImporter.h"
 
+#include "vtkF3DBrickedVolume.h"
 #include "vtkF3DPostProcessFilter.h"
+#include "F3DBoundsHierarchy.h"
 #include "F3DLog.h"
 
 #include <vtkActor.h>
+#include <vtkCallbackCommand.h>
+#include <vtkCamera.h>
+#include <vtkDataObjectTree.h>
+#include <vtkDataObjectTreeIterator.h>
 #include <vtkEventForwarderCommand.h>
 #include <vtkImageData.h>
 #include <vtkInformation.h>
+#include <vtkInformationDoubleVectorKey.h>
+#include <vtkMath.h>
+#include <vtkMatrix4x4.h>
 #include <vtkMultiBlockDataSet.h>
 #include <vtkObjectFactory.h>
 #include <vtkPartitionedDataSet.h>
@@ -17,10 +26,25 @@
 #include <vtkRenderer.h>
 #include <vtkSmartPointer.h>
 #include <vtkStreamingDemandDrivenPipeline.h>
+#include <vtkTrivialProducer.h>
 #include <vtkVersion.h>
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <future>
+#include <list>
+#include <map>
+#include <mutex>
+#include <optional>
 #include <sstream>
+#include <thread>
+#include <tuple>
+#include <vector>
 
 struct vtkF3DGenericImporter::Internals
 {
@@ -30,12 +54,376 @@ struct vtkF3DGenericImporter::Internals
   vtkNew<vtkPolyDataMapper> PolyDataMapper;
   std::string OutputDescription;
 
+  // Actors of the leaves of composite datasets that are not merged by the post processing filter.
+  // Surfaces are kept so that they can be updated in place when the time value changes.
+  std::vector<vtkSmartPointer<vtkActor>> BlockActors;
+  std::vector<vtkSmartPointer<vtkPolyData>> BlockSurfaces;
+
   vtkPolyData* ImportedPoints = nullptr;
   vtkImageData* ImportedImage = nullptr;
 
   bool HasAnimation = false;
   bool AnimationEnabled = false;
   std::array<double, 2> TimeRange;
+  std::vector<double> TimeSteps;
+
+  struct CachedFrame
+  {
+    double Time;
+    vtkSmartPointer<vtkDataObject> Data;
+    unsigned long Size; // in KiB
+  };
+
+  // Prefetching, the prefetch reader is only ever updated by the worker thread
+  vtkSmartPointer<vtkAlgorithm> PrefetchReader;
+  vtkNew<vtkTrivialProducer> CachedProducer;
+  int PrefetchCount = 0;
+  unsigned long PrefetchMemoryBudget = 512 * 1024; // in KiB
+  int LastTimeStepIndex = -1;
+  int Direction = 1;
+
+  // Asynchronous update, the time step requested but not decoded yet, if any
+  bool Asynchronous = false;
+  bool UpdatePending = false;
+  std::optional<double> PendingTime;
+
+  std::mutex Mutex;
+  std::condition_variable Condition;
+  std::thread Worker;
+  std::deque<double> Requests;
+  std::list<CachedFrame> Cache; // most recently used first
+  unsigned long CacheSize = 0;
+  bool StopWorker = false;
+
+  // Array selection, the generation is incremented each time the selection changes
+  ArraySelector Selector;
+  std::vector<std::string> SelectedArrays;
+  bool HasSelection = false;
+  int SelectionGeneration = 0;
+  std::optional<double> LastTimeValue;
+
+  // Adaptive tessellation, the surfaces are refined by a worker thread from their source
+  // surface output by the reader, and swapped in the surfaces of their actors by the main thread
+  struct TessellatedSurface
+  {
+    vtkSmartPointer<vtkPolyData> Source;
+    vtkSmartPointer<vtkPolyData> Surface;
+    std::vector<vtkActor*> Actors;
+    double RequestedDeflection = VTK_DOUBLE_MAX;
+  };
+  using RefinedSurfaces = std::vector<std::pair<size_t, vtkSmartPointer<vtkPolyData>>>;
+  Tessellator Refiner;
+  double TessellationError = 0.0;
+  std::vector<TessellatedSurface> TessellatedSurfaces;
+
+  // Declared last so that the refinement is finished before the other members are destroyed
+  std::future<RefinedSurfaces> Tessellation;
+
+  //----------------------------------------------------------------------------
+  ~Internals()
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      this->StopWorker = true;
+    }
+    this->Condition.notify_all();
+    if (this->Worker.joinable())
+    {
+      this->Worker.join();
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  /**
+   * Update the block surfaces with the blocks output by the post processing filter.
+   * Return false if the number of blocks has changed.
+   */
+  bool UpdateBlockSurfaces()
+  {
+    vtkMultiBlockDataSet* blocks =
+      vtkMultiBlockDataSet::SafeDownCast(this->PostPro->GetOutputDataObject(3));
+    if (blocks->GetNumberOfBlocks() != this->BlockSurfaces.size())
+    {
+      return false;
+    }
+    for (size_t i = 0; i < this->BlockSurfaces.size(); i++)
+    {
+      this->BlockSurfaces[i]->ShallowCopy(blocks->GetBlock(static_cast<unsigned int>(i)));
+    }
+    return true;
+  }
+
+  //----------------------------------------------------------------------------
+  /**
+   * Return the polydata output by a reader if it is not composite, or if it is the single leaf of
+   * a composite output without instance matrix, nullptr otherwise
+   */
+  static vtkPolyData* GetSingleSurface(vtkDataObject* object)
+  {
+    vtkDataObjectTree* tree = vtkDataObjectTree::SafeDownCast(object);
+    if (!tree)
+    {
+      return vtkPolyData::SafeDownCast(object);
+    }
+
+    auto iter = vtkSmartPointer<vtkDataObjectTreeIterator>::Take(tree->NewTreeIterator());
+    iter->VisitOnlyLeavesOn();
+    iter->SkipEmptyNodesOn();
+    iter->TraverseSubTreeOn();
+    vtkPolyData* surface = nullptr;
+    int nLeaf = 0;
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+    {
+      if (iter->HasCurrentMetaData() &&
+        iter->GetCurrentMetaData()->Has(vtkF3DImporter::INSTANCE_MATRIX()))
+      {
+        return nullptr;
+      }
+      surface = vtkPolyData::SafeDownCast(iter->GetCurrentDataObject());
+      nLeaf++;
+    }
+    return nLeaf == 1 ? surface : nullptr;
+  }
+
+  //----------------------------------------------------------------------------
+  /**
+   * Add an actor of a surface to refine, the instances of a source share its surface
+   */
+  void AddTessellatedActor(vtkPolyData* source, vtkPolyData* surface, vtkActor* actor)
+  {
+    auto it = std::find_if(this->TessellatedSurfaces.begin(), this->TessellatedSurfaces.end(),
+      [&](const TessellatedSurface& tessellated) { return tessellated.Surface == surface; });
+    if (it == this->TessellatedSurfaces.end())
+    {
+      it = this->TessellatedSurfaces.emplace(this->TessellatedSurfaces.end());
+      it->Source = source;
+      it->Surface = surface;
+    }
+    it->Actors.emplace_back(actor);
+  }
+
+  //----------------------------------------------------------------------------
+  /**
+   * Return the chordal error, in world units, that is projected on the screen of the renderer
+   * to the tessellation error in pixels at the nearest point of the visible instances of a
+   * surface. Return VTK_DOUBLE_MAX if no instance is visible.
+   */
+  double ComputeDeflection(
+    vtkRenderer* renderer, const double planes[24], const TessellatedSurface& tessellated)
+  {
+    vtkCamera* camera = renderer->GetActiveCamera();
+    double height = renderer->GetSize()[1];
+    double pixelsPerUnit = camera->GetParallelProjection()
+      ? height / (2.0 * camera->GetParallelScale())
+      : height / (2.0 * std::tan(vtkMath::RadiansFromDegrees(camera->GetViewAngle()) / 2.0));
+
+    double deflection = VTK_DOUBLE_MAX;
+    for (vtkActor* actor : tessellated.Actors)
+    {
+      bool inside;
+      const double* bounds = actor->GetBounds();
+      if (!actor->GetVisibility() || !bounds ||
+        F3DBoundsHierarchy::IsOutsideFrustum(planes, bounds, inside))
+      {
+        continue;
+      }
+
+      double distance = 1.0;
+      if (!camera->GetParallelProjection())
+      {
+        const double* eye = camera->GetPosition();
+        distance = 0.0;
+        for (int i = 0; i < 3; i++)
+        {
+          double delta = eye[i] - std::clamp(eye[i], bounds[2 * i], bounds[2 * i + 1]);
+          distance += delta * delta;
+        }
+        distance = std::sqrt(distance);
+      }
+      deflection = std::min(deflection, this->TessellationError * distance / pixelsPerUnit);
+    }
+    return deflection;
+  }
+
+  //----------------------------------------------------------------------------
+  /**
+   * Swap in the surfaces refined by the worker thread, waiting for them if needed.
+   * Return true if surfaces were swapped in.
+   */
+  bool SwapTessellatedSurfaces()
+  {
+    bool swapped = false;
+    for (auto& [index, refined] : this->Tessellation.get())
+    {
+      if (refined)
+      {
+        this->TessellatedSurfaces[index].Surface->ShallowCopy(refined);
+        swapped = true;
+      }
+    }
+    return swapped;
+  }
+
+  //----------------------------------------------------------------------------
+  /**
+   * Many file format libraries (eg: HDF5) are not thread safe, so readers of all generic importers
+   * never run concurrently when prefetching or refining
+   */
+  static std::mutex& GetReadersMutex()
+  {
+    static std::mutex mutex;
+    return mutex;
+  }
+
+  //----------------------------------------------------------------------------
+  std::list<CachedFrame>::iterator FindFrame(double time)
+  {
+    return std::find_if(this->Cache.begin(), this->Cache.end(),
+      [time](const CachedFrame& frame) { return frame.Time == time; });
+  }
+
+  //----------------------------------------------------------------------------
+  void RunWorker()
+  {
+    while (true)
+    {
+      double time;
+      int generation;
+      {
+        std::unique_lock<std::mutex> lock(this->Mutex);
+        this->Condition.wait(
+          lock, [this]() { return this->StopWorker || !this->Requests.empty(); });
+        if (this->StopWorker)
+        {
+          return;
+        }
+        time = this->Requests.front();
+        generation = this->SelectionGeneration;
+        this->Requests.pop_front();
+        if (this->FindFrame(time) != this->Cache.end())
+        {
+          continue;
+        }
+      }
+
+      // Decode outside of the cache lock, readers may take a while
+      vtkSmartPointer<vtkDataObject> frame;
+      {
+        std::lock_guard<std::mutex> readerLock(Internals::GetReadersMutex());
+        if (!this->PrefetchReader->UpdateTimeStep(time) ||
+          !this->PrefetchReader->GetOutputDataObject(0))
+        {
+          continue;
+        }
+        vtkDataObject* output = this->PrefetchReader->GetOutputDataObject(0);
+        frame = vtkSmartPointer<vtkDataObject>::Take(output->NewInstance());
+        frame->DeepCopy(output);
+      }
+
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      if (generation != this->SelectionGeneration)
+      {
+        // Decoded with previously selected arrays
+        continue;
+      }
+      const unsigned long size = frame->GetActualMemorySize();
+      this->Cache.push_front({ time, frame, size });
+      this->CacheSize += size;
+
+      // Evict least recently used frames, always keep the frame just decoded
+      while (this->CacheSize > this->PrefetchMemoryBudget && this->Cache.size() > 1)
+      {
+        this->CacheSize -= this->Cache.back().Size;
+        this->Cache.pop_back();
+      }
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  /**
+   * Return the prefetched frame for the provided time value if any, or nullptr.
+   * Schedule the prefetching of the next time steps in the current playing direction.
+   * When updating asynchronously, a missing frame is scheduled first and pending is set,
+   * the frame of the previous pending time value is returned instead if it is decoded.
+   */
+  vtkSmartPointer<vtkDataObject> GetPrefetchedFrame(double timeValue, bool& pending)
+  {
+    pending = false;
+    const int nbTimeSteps = static_cast<int>(this->TimeSteps.size());
+    if (this->PrefetchCount <= 0 || !this->PrefetchReader || nbTimeSteps < 2)
+    {
+      return nullptr;
+    }
+
+    // Readers use the last time step lower than the requested time value
+    auto it = std::upper_bound(this->TimeSteps.begin(), this->TimeSteps.end(), timeValue);
+    const int index =
+      std::max(static_cast<int>(std::distance(this->TimeSteps.begin(), it)) - 1, 0);
+    const double time = this->TimeSteps[index];
+
+    // Deduce the playing direction, a large jump backward is a forward loop and conversely
+    if (this->LastTimeStepIndex >= 0 && index != this->LastTimeStepIndex)
+    {
+      int delta = index - this->LastTimeStepIndex;
+      if (std::abs(delta) > nbTimeSteps / 2)
+      {
+        delta = -delta;
+      }
+      this->Direction = delta > 0 ? 1 : -1;
+    }
+    this->LastTimeStepIndex = index;
+
+    vtkSmartPointer<vtkDataObject> frame;
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    auto frameIt = this->FindFrame(time);
+    if (frameIt != this->Cache.end())
+    {
+      frame = frameIt->Data;
+      this->Cache.splice(this->Cache.begin(), this->Cache, frameIt);
+      this->PendingTime.reset();
+    }
+    else if (this->Asynchronous)
+    {
+      // Show the latest decoded state while the requested one is decoded
+      auto pendingIt = this->PendingTime.has_value() ? this->FindFrame(this->PendingTime.value())
+                                                     : this->Cache.end();
+      if (pendingIt != this->Cache.end())
+      {
+        frame = pendingIt->Data;
+        this->Cache.splice(this->Cache.begin(), this->Cache, pendingIt);
+      }
+      this->PendingTime = time;
+      pending = true;
+    }
+    else
+    {
+      this->PendingTime.reset();
+    }
+
+    // Only the latest requests are relevant
+    this->Requests.clear();
+    if (pending)
+    {
+      this->Requests.push_back(time);
+    }
+    for (int i = 1; i <= std::min(this->PrefetchCount, nbTimeSteps - 1); i++)
+    {
+      const int next = ((index + i * this->Direction) % nbTimeSteps + nbTimeSteps) % nbTimeSteps;
+      if (this->FindFrame(this->TimeSteps[next]) == this->Cache.end())
+      {
+        this->Requests.push_back(this->TimeSteps[next]);
+      }
+    }
+    if (!this->Requests.empty())
+    {
+      if (!this->Worker.joinable())
+      {
+        this->Worker = std::thread(&Internals::RunWorker, this);
+      }
+      this->Condition.notify_one();
+    }
+    return frame;
+  }
 };
 
 vtkStandardNewMacro(vtkF3DGenericImporter);
@@ -44,6 +432,8 @@ vtkStandardNewMacro(vtkF3DGenericImporter);
 vtkF3DGenericImporter::vtkF3DGenericImporter()
   : Pimpl(new Internals())
 {
+  // Each leaf is an actor, above that rendering is slower than merging them
+  this->Pimpl->PostPro->SetMaximumNumberOfBlocks(1000);
 }
 
 //----------------------------------------------------------------------------
@@ -60,6 +450,14 @@ void vtkF3DGenericImporter::UpdateTemporalInformation()
     this->Pimpl->TimeRange[1] = readerTimeRange[1];
     this->Pimpl->HasAnimation = true;
   }
+
+  this->Pimpl->TimeSteps.clear();
+  if (readerInfo->Has(vtkStreamingDemandDrivenPipeline::TIME_STEPS()))
+  {
+    double* readerTimeSteps = readerInfo->Get(vtkStreamingDemandDrivenPipeline::TIME_STEPS());
+    int nbTimeSteps = readerInfo->Length(vtkStreamingDemandDrivenPipeline::TIME_STEPS());
+    this->Pimpl->TimeSteps.assign(readerTimeSteps, readerTimeSteps + nbTimeSteps);
+  }
 }
 
 //----------------------------------------------------------------------------
@@ -123,10 +521,32 @@ void vtkF3DGenericImporter::ImportActors(vtkRenderer* ren)
 {
   assert(this->Pimpl->Reader);
 
+  if (this->IsCancelled())
+  {
+    this->SetFailureStatus();
+    return;
+  }
+
   // Read file and forward progress
   vtkNew<vtkEventForwarderCommand> progressForwarder;
   progressForwarder->SetTarget(this);
   this->Pimpl->Reader->AddObserver(vtkCommand::ProgressEvent, progressForwarder);
+
+  // The cancellation is forwarded to the reader on the thread updating it, with its
+  // AbortExecute flag checked by the reader between the chunks it reports the progress of
+  vtkNew<vtkCallbackCommand> cancelCallback;
+  cancelCallback->SetClientData(this);
+  cancelCallback->SetCallback(
+    [](vtkObject*, unsigned long, void* clientData, void*)
+    {
+      auto self = static_cast<vtkF3DGenericImporter*>(clientData);
+      if (self->IsCancelled())
+      {
+        self->AbortInternalReader();
+      }
+    });
+  this->Pimpl->Reader->AddObserver(vtkCommand::ProgressEvent, cancelCallback);
+  this->Pimpl->PostPro->SetReorderTriangles(this->GetOptimizeGeometry());
   bool status = this->Pimpl->PostPro->GetExecutive()->Update();
   if (!status || !this->Pimpl->Reader->GetOutputDataObject(0))
   {
@@ -135,7 +555,14 @@ void vtkF3DGenericImporter::ImportActors(vtkRenderer* ren)
   }
 
   // Cast to dataset types
-  this->Pimpl->ImportedPoints = vtkPolyData::SafeDownCast(this->Pimpl->PostPro->GetOutput(1));
+  vtkMultiBlockDataSet* blocks =
+    vtkMultiBlockDataSet::SafeDownCast(this->Pimpl->PostPro->GetOutputDataObject(3));
+  const bool hasBlocks = blocks->GetNumberOfBlocks() > 0;
+  this->Pimpl->BlockSurfaces.clear();
+  this->Pimpl->BlockActors.clear();
+  this->Pimpl->TessellatedSurfaces.clear();
+  this->Pimpl->ImportedPoints =
+    hasBlocks ? nullptr : vtkPolyData::SafeDownCast(this->Pimpl->PostPro->GetOutput(1));
   vtkImageData* image =  vtkImageData::SafeDownCast(this->Pimpl->PostPro->GetOutput(2));
   this->Pimpl->ImportedImage =  image->GetNumberOfCells() > 0 ? image : nullptr;
 
@@ -153,18 +580,73 @@ void vtkF3DGenericImporter::ImportActors(vtkRenderer* ren)
   this->Pimpl->GeometryActor->GetProperty()->SetRoughness(0.3);
   this->Pimpl->GeometryActor->GetProperty()->SetInterpolationToPBR();
 
-  // add mappers
-  // TODO implement proper composite support
-  this->Pimpl->GeometryActor->SetMapper(this->Pimpl->PolyDataMapper);
+  // Leaves of composite datasets are kept separate, each with its own actor sharing the
+  // geometry actor property, so that they are not copied into a merged surface.
+  // The instances of a leaf share its mapper, and thus its graphics buffers.
+  if (hasBlocks)
+  {
+    using SharedMapper =
+      std::pair<vtkSmartPointer<vtkPolyData>, vtkSmartPointer<vtkPolyDataMapper>>;
+    std::map<vtkDataObject*, SharedMapper> sharedMappers;
+    for (unsigned int i = 0; i < blocks->GetNumberOfBlocks(); i++)
+    {
+      auto& [surface, mapper] = sharedMappers[blocks->GetBlock(i)];
+      if (!mapper)
+      {
+        surface = vtkSmartPointer<vtkPolyData>::New();
+        surface->ShallowCopy(blocks->GetBlock(i));
+        mapper = vtkSmartPointer<vtkPolyDataMapper>::New();
+        mapper->SetInputData(surface);
+        mapper->ScalarVisibilityOff();
+      }
+      vtkNew<vtkActor> actor;
+      actor->SetMapper(mapper);
+      actor->SetProperty(this->Pimpl->GeometryActor->GetProperty());
+
+      if (blocks->HasMetaData(i) &&
+        blocks->GetMetaData(i)->Has(vtkF3DImporter::INSTANCE_MATRIX()))
+      {
+        vtkNew<vtkMatrix4x4> matrix;
+        blocks->GetMetaData(i)->Get(vtkF3DImporter::INSTANCE_MATRIX(), matrix->GetData());
+        actor->SetUserMatrix(matrix);
+      }
+      this->Pimpl->BlockSurfaces.emplace_back(surface);
+      this->Pimpl->BlockActors.emplace_back(actor);
 
-  // add props
-  ren->AddActor(this->Pimpl->GeometryActor);
+      vtkPolyData* source = vtkPolyData::SafeDownCast(blocks->GetBlock(i));
+      if (this->Pimpl->Refiner && source)
+      {
+        this->Pimpl->AddTessellatedActor(source, surface, actor);
+      }
+
+      ren->AddActor(actor);
 #if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240707)
-  this->ActorCollection->AddItem(this->Pimpl->GeometryActor);
+      this->ActorCollection->AddItem(actor);
 #endif
+    }
+  }
+  else
+  {
+    // add mappers
+    this->Pimpl->GeometryActor->SetMapper(this->Pimpl->PolyDataMapper);
 
-  // Set visibilities
-  this->Pimpl->GeometryActor->VisibilityOn();
+    // add props
+    ren->AddActor(this->Pimpl->GeometryActor);
+#if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240707)
+    this->ActorCollection->AddItem(this->Pimpl->GeometryActor);
+#endif
+
+    // Set visibilities
+    this->Pimpl->GeometryActor->VisibilityOn();
+
+    vtkPolyData* source =
+      Internals::GetSingleSurface(this->Pimpl->Reader->GetOutputDataObject(0));
+    if (this->Pimpl->Refiner && source)
+    {
+      this->Pimpl->AddTessellatedActor(source,
+        vtkPolyData::SafeDownCast(this->Pimpl->PostPro->GetOutput(0)), this->Pimpl->GeometryActor);
+    }
+  }
 
   this->UpdateTemporalInformation();
 }
@@ -179,6 +661,216 @@ void vtkF3DGenericImporter::SetInternalReader(vtkAlgorithm* reader)
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkF3DGenericImporter::SetPrefetchReader(vtkAlgorithm* reader)
+{
+  assert(!this->Pimpl->Worker.joinable());
+  this->Pimpl->PrefetchReader = reader;
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DGenericImporter::SetPrefetchCount(int count)
+{
+  this->Pimpl->PrefetchCount = count;
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DGenericImporter::SetPrefetchMemoryBudget(int budget)
+{
+  std::lock_guard<std::mutex> lock(this->Pimpl->Mutex);
+  this->Pimpl->PrefetchMemoryBudget = static_cast<unsigned long>(std::max(budget, 0)) * 1024;
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DGenericImporter::SetAsynchronousUpdate(bool async)
+{
+  this->Pimpl->Asynchronous = async;
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DGenericImporter::HasPendingUpdate()
+{
+  return this->Pimpl->UpdatePending;
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DGenericImporter::SetArraySelector(ArraySelector selector)
+{
+  this->Pimpl->Selector = std::move(selector);
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DGenericImporter::SetSelectedArrays(const std::vector<std::string>& arrayNames)
+{
+  if (!this->Pimpl->Selector || !this->Pimpl->HasAnimation ||
+    (this->Pimpl->HasSelection && this->Pimpl->SelectedArrays == arrayNames))
+  {
+    return;
+  }
+
+  if (!this->Pimpl->Selector(this->Pimpl->Reader, arrayNames))
+  {
+    // Not supported by this reader, always read all arrays
+    this->Pimpl->Selector = nullptr;
+    return;
+  }
+  this->Pimpl->SelectedArrays = arrayNames;
+  this->Pimpl->HasSelection = true;
+
+  if (this->Pimpl->PrefetchReader)
+  {
+    // The prefetch reader is being updated by the worker when the readers mutex is locked
+    std::lock_guard<std::mutex> readerLock(Internals::GetReadersMutex());
+    this->Pimpl->Selector(this->Pimpl->PrefetchReader, arrayNames);
+
+    std::lock_guard<std::mutex> lock(this->Pimpl->Mutex);
+    this->Pimpl->SelectionGeneration++;
+    this->Pimpl->Requests.clear();
+    this->Pimpl->Cache.clear();
+    this->Pimpl->CacheSize = 0;
+  }
+
+  // Read the newly selected arrays of the current time step
+  if (this->Pimpl->LastTimeValue.has_value())
+  {
+    this->UpdateAtTimeValue(this->Pimpl->LastTimeValue.value());
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DGenericImporter::SelectArraysForImport(const std::vector<std::string>& arrayNames)
+{
+  assert(this->Pimpl->Reader);
+  if (!this->Pimpl->Selector || !this->Pimpl->Selector(this->Pimpl->Reader, arrayNames))
+  {
+    return false;
+  }
+  if (this->Pimpl->PrefetchReader)
+  {
+    this->Pimpl->Selector(this->Pimpl->PrefetchReader, arrayNames);
+  }
+  this->Pimpl->SelectedArrays = arrayNames;
+  this->Pimpl->HasSelection = true;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DGenericImporter::SetTessellator(Tessellator tessellator, double pixelError)
+{
+  this->Pimpl->Refiner = std::move(tessellator);
+  this->Pimpl->TessellationError = pixelError;
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DGenericImporter::HasTessellator()
+{
+  return static_cast<bool>(this->Pimpl->Refiner);
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DGenericImporter::SetNormalsGeneration(bool generate, double featureAngle)
+{
+  this->Pimpl->PostPro->SetGenerateNormals(generate);
+  this->Pimpl->PostPro->SetNormalsFeatureAngle(featureAngle);
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DGenericImporter::UpdateTessellation(vtkRenderer* renderer, bool wait)
+{
+  if (this->Pimpl->TessellatedSurfaces.empty())
+  {
+    return false;
+  }
+
+  // Only one refinement is in progress at a time, the surfaces are compared again once it is done
+  bool swapped = false;
+  if (this->Pimpl->Tessellation.valid())
+  {
+    if (!wait && !this->IsTessellationRefined())
+    {
+      return false;
+    }
+    swapped = this->Pimpl->SwapTessellatedSurfaces();
+  }
+
+  if (!renderer || !renderer->IsActiveCameraCreated() || renderer->GetSize()[1] <= 0)
+  {
+    return swapped;
+  }
+
+  double planes[24];
+  renderer->GetActiveCamera()->GetFrustumPlanes(renderer->GetTiledAspectRatio(), planes);
+
+  // A surface is refined again only if the error at least doubled since the last refinement,
+  // so that slowly zooming in does not refine at each frame
+  std::vector<std::tuple<size_t, vtkSmartPointer<vtkPolyData>, double>> requests;
+  for (size_t i = 0; i < this->Pimpl->TessellatedSurfaces.size(); i++)
+  {
+    Internals::TessellatedSurface& tessellated = this->Pimpl->TessellatedSurfaces[i];
+    double deflection = this->Pimpl->ComputeDeflection(renderer, planes, tessellated);
+    if (deflection < 0.5 * tessellated.RequestedDeflection)
+    {
+      tessellated.RequestedDeflection = deflection;
+      requests.emplace_back(i, tessellated.Source, deflection);
+    }
+  }
+  if (requests.empty())
+  {
+    return swapped;
+  }
+
+  this->Pimpl->Tessellation = std::async(std::launch::async,
+    [refiner = this->Pimpl->Refiner, reader = this->Pimpl->Reader, requests = std::move(requests)]()
+    {
+      std::lock_guard<std::mutex> readerLock(Internals::GetReadersMutex());
+      Internals::RefinedSurfaces refined;
+      for (const auto& [index, source, deflection] : requests)
+      {
+        refined.emplace_back(index, refiner(reader, source, deflection));
+      }
+      return refined;
+    });
+
+  if (wait)
+  {
+    swapped = this->Pimpl->SwapTessellatedSurfaces() || swapped;
+  }
+  return swapped;
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DGenericImporter::IsTessellationRefined()
+{
+  return this->Pimpl->Tessellation.valid() &&
+    this->Pimpl->Tessellation.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DGenericImporter::UpdateStreamedVolume(vtkRenderer* renderer)
+{
+  vtkF3DBrickedVolume* volume = vtkF3DBrickedVolume::SafeDownCast(this->Pimpl->Reader);
+  if (!volume || !this->Pimpl->ImportedImage || !volume->UpdateSelection(renderer))
+  {
+    return false;
+  }
+
+  // Extracting the surface and the points of the whole image is not needed to show it
+  std::lock_guard<std::mutex> readerLock(Internals::GetReadersMutex());
+  volume->Update();
+  this->Pimpl->ImportedImage->ShallowCopy(volume->GetOutput());
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DGenericImporter::AbortInternalReader()
+{
+  if (this->Pimpl->Reader)
+  {
+    this->Pimpl->Reader->AbortExecuteOn();
+  }
+  this->Pimpl->PostPro->AbortExecuteOn();
+}
+
 //----------------------------------------------------------------------------
 std::string vtkF3DGenericImporter::GetOutputsDescription()
 {
@@ -260,6 +952,37 @@ std::string vtkF3DGenericImporter::GetDataObjectDescription(vtkDataObject* objec
 bool vtkF3DGenericImporter::UpdateAtTimeValue(double timeValue)
 {
   assert(this->Pimpl->Reader);
+  this->Pimpl->LastTimeValue = timeValue;
+
+  // Swap in the prefetched frame if available, this avoid reading the file on the render thread
+  bool pending;
+  vtkSmartPointer<vtkDataObject> frame = this->Pimpl->GetPrefetchedFrame(timeValue, pending);
+  this->Pimpl->UpdatePending = pending;
+  if (pending && !frame)
+  {
+    // Keep the current frame until the requested one is decoded
+    return true;
+  }
+  if (frame)
+  {
+    this->Pimpl->CachedProducer->SetOutput(frame);
+    this->Pimpl->PostPro->SetInputConnection(this->Pimpl->CachedProducer->GetOutputPort());
+    if (!this->Pimpl->PostPro->GetExecutive()->Update())
+    {
+      F3DLog::Print(
+        F3DLog::Severity::Warning, "A prefetched frame failed to update at a timeValue");
+      return false;
+    }
+    this->Pimpl->OutputDescription = vtkF3DGenericImporter::GetDataObjectDescription(frame);
+    return this->UpdateBlocks();
+  }
+
+  this->Pimpl->PostPro->SetInputConnection(this->Pimpl->Reader->GetOutputPort());
+  std::unique_lock<std::mutex> readerLock(Internals::GetReadersMutex(), std::defer_lock);
+  if (this->Pimpl->PrefetchReader)
+  {
+    readerLock.lock();
+  }
   if(!this->Pimpl->PostPro->UpdateTimeStep(timeValue) || !this->Pimpl->Reader->GetOutputDataObject(0))
   {
     F3DLog::Print(F3DLog::Severity::Warning, "A reader failed to update at a timeValue");
@@ -267,6 +990,18 @@ bool vtkF3DGenericImporter::UpdateAtTimeValue(double timeValue)
   }
 
   this->UpdateOutputDescriptions();
+  return this->UpdateBlocks();
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DGenericImporter::UpdateBlocks()
+{
+  if (!this->Pimpl->BlockSurfaces.empty() && !this->Pimpl->UpdateBlockSurfaces())
+  {
+    F3DLog::Print(F3DLog::Severity::Warning,
+      "The number of blocks changed at a timeValue, blocks are not updated");
+    return false;
+  }
   return true;
 }
 
@@ -8,7 +8,12 @@
 
 #include "vtkF3DImporter.h"
 
+#include <vtkSmartPointer.h>
+
+#include <functional>
 #include <memory>
+#include <string>
+#include <vector>
 
 class vtkAlgorithm;
 class vtkDataObject;
@@ -28,6 +33,106 @@ public:
    */
   void SetInternalReader(vtkAlgorithm* reader);
 
+  ///@{
+  /**
+   * Set a second instance of the internal reader, reading the same file, used
+   * to decode the next time steps on a background thread while playing the animation.
+   * Decoded frames are kept in a least recently used cache and swapped in by UpdateAtTimeValue.
+   * Only readers providing discrete time steps are prefetched.
+   * The prefetch reader must be set before the first UpdateAtTimeValue call.
+   * SetPrefetchCount sets the number of time steps to decode ahead, 0 disables prefetching.
+   * SetPrefetchMemoryBudget sets the maximum memory used by the cache in MiB, default is 512.
+   */
+  void SetPrefetchReader(vtkAlgorithm* reader);
+  void SetPrefetchCount(int count);
+  void SetPrefetchMemoryBudget(int budget);
+  ///@}
+
+  ///@{
+  /**
+   * Set whether UpdateAtTimeValue may show a previous time step instead of reading the requested
+   * one when it was not prefetched yet. The requested time step is then decoded first by the
+   * prefetching thread and swapped in by a later update, so that a slow reader does not slow
+   * down the playback of the other files. Only used when prefetching. Default is false.
+   * HasPendingUpdate returns true if the last update kept a previous time step.
+   */
+  void SetAsynchronousUpdate(bool async);
+  bool HasPendingUpdate();
+  ///@}
+
+  ///@{
+  /**
+   * Set a function restricting the arrays read by a reader to the provided array names,
+   * returning false if the reader does not support it.
+   * When the internal reader provides an animation, only the arrays provided to
+   * SetSelectedArrays are read when updating a time step, so that the arrays that are not shown
+   * are not read at each time step. The first import always reads all the arrays.
+   * Changing the selected arrays reads the current time step again and discards the prefetched
+   * time steps.
+   */
+  using ArraySelector = std::function<bool(vtkAlgorithm*, const std::vector<std::string>&)>;
+  void SetArraySelector(ArraySelector selector);
+  void SetSelectedArrays(const std::vector<std::string>& arrayNames);
+  ///@}
+
+  /**
+   * Restrict the arrays read by the first import too to the provided array names, so that the
+   * arrays that are not shown are never read, eg. for datasets larger than the memory.
+   * It must be called after SetArraySelector and SetPrefetchReader, before the import.
+   * Return false if the reader does not support it, in which case all arrays are read.
+   */
+  bool SelectArraysForImport(const std::vector<std::string>& arrayNames);
+
+  ///@{
+  /**
+   * Set a function returning a refined tessellation of a surface output by the internal reader,
+   * with a chordal error smaller than the provided one, or nullptr if it is not needed.
+   * It must be set before the import, with the maximum error of the tessellation on screen,
+   * in pixels. The surfaces of the leaves of composite outputs, or the single surface of the
+   * output, are then refined by UpdateTessellation.
+   * HasTessellator returns true if a tessellator is set.
+   */
+  using Tessellator =
+    std::function<vtkSmartPointer<vtkPolyData>(vtkAlgorithm*, vtkPolyData*, double)>;
+  void SetTessellator(Tessellator tessellator, double pixelError);
+  bool HasTessellator();
+  ///@}
+
+  /**
+   * Set if smooth point normals are generated for the surfaces read without normals, and the
+   * angle in degrees between two polygons above which their common points are split,
+   * see vtkF3DNormalsFilter. It must be called before the import.
+   */
+  void SetNormalsGeneration(bool generate, double featureAngle);
+
+  /**
+   * Swap in the surfaces refined on a worker thread, if they are ready or if wait is true,
+   * then start refining on the worker thread the visible surfaces whose tessellation error
+   * projected on the screen of the renderer exceeds the pixel error. When wait is true, the
+   * refinement is finished and swapped in before returning.
+   * Return true if surfaces were swapped in.
+   */
+  bool UpdateTessellation(vtkRenderer* renderer, bool wait);
+
+  /**
+   * Return true if the surfaces refined on a worker thread are ready to be swapped in
+   */
+  bool IsTessellationRefined();
+
+  /**
+   * When the internal reader is a vtkF3DBrickedVolume, update its selection of bricks for the
+   * camera of the provided renderer and read them into the imported image.
+   * The surface and the points are only updated if the post processing filter runs again.
+   * Return true if the imported image changed.
+   */
+  bool UpdateStreamedVolume(vtkRenderer* renderer);
+
+  /**
+   * Request the internal reader and the post processing filter to abort their execution.
+   * This is safe to call from a progress observer.
+   */
+  void AbortInternalReader();
+
   /**
    * Get a string describing the outputs
    */
@@ -81,6 +186,8 @@ public:
   ///@{
   /**
    * Direct access to generic importer specific datasets
+   * When the leaves of a composite dataset are imported as separate actors,
+   * there is no imported points, the surface of each actor should be used instead.
    */
   vtkPolyData* GetImportedPoints();
   vtkImageData* GetImportedImage();
@@ -105,6 +212,12 @@ protected:
    */
   void UpdateOutputDescriptions();
 
+  /**
+   * Update the surfaces of the actors of the blocks, if any, after a time value update
+   * Return false if the number of blocks has changed.
+   */
+  bool UpdateBlocks();
+
 private:
   vtkF3DGenericImporter(const vtkF3DGenericImporter&) = delete;
   void operator=(const vtkF3DGenericImporter&) = delete;
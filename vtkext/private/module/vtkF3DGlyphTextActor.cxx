@@ -0,0 +1,309 @@
+#include "vtkF3DGlyphTextActor.h"
+
+#include <vtkCellArray.h>
+#include <vtkFloatArray.h>
+#include <vtkImageData.h>
+#include <vtkObjectFactory.h>
+#include <vtkPointData.h>
+#include <vtkPolyData.h>
+#include <vtkPolyDataMapper2D.h>
+#include <vtkProperty2D.h>
+#include <vtkTextProperty.h>
+#include <vtkTextRenderer.h>
+#include <vtkTexture.h>
+#include <vtkTexturedActor2D.h>
+#include <vtkViewport.h>
+#include <vtkWindow.h>
+
+#include <array>
+#include <cmath>
+#include <map>
+#include <tuple>
+
+namespace
+{
+constexpr char FIRST_GLYPH = ' ';
+constexpr char LAST_GLYPH = '~';
+constexpr int NUMBER_OF_GLYPHS = LAST_GLYPH - FIRST_GLYPH + 1;
+
+// the region of a glyph in the atlas is larger than its advance so that overhanging
+// parts are kept, glyphs are separated by a space in the atlas so they do not overlap
+constexpr int GLYPH_PADDING = 2;
+constexpr const char* GLYPH_SEPARATOR = " ";
+
+//----------------------------------------------------------------------------
+int GetWidth(vtkTextRenderer* renderer, vtkTextProperty* tprop, const std::string& str, int dpi)
+{
+  int bbox[4];
+  if (!renderer->GetBoundingBox(tprop, str, bbox, dpi))
+  {
+    return 0;
+  }
+  return bbox[1] - bbox[0];
+}
+}
+
+struct vtkF3DGlyphTextActor::Internals
+{
+  struct Atlas
+  {
+    vtkNew<vtkTexture> Texture;
+    std::array<int, NUMBER_OF_GLYPHS> Start;
+    std::array<int, NUMBER_OF_GLYPHS> Advance;
+    int ImageSize[2] = { 1, 1 };
+    int LineHeight = 0;
+  };
+
+  std::map<std::string, Atlas> Atlases;
+  std::string BuiltInput;
+  std::string BuiltFont;
+  double BuiltLineSpacing = 0.0;
+
+  //----------------------------------------------------------------------------
+  static std::string GetFontKey(vtkTextProperty* tprop, int dpi)
+  {
+    std::string key = tprop->GetFontFamily() == VTK_FONT_FILE && tprop->GetFontFile()
+      ? tprop->GetFontFile()
+      : std::to_string(tprop->GetFontFamily());
+    return key + "/" + std::to_string(tprop->GetFontSize()) + "/" +
+      std::to_string(tprop->GetBold()) + std::to_string(tprop->GetItalic()) + "/" +
+      std::to_string(dpi);
+  }
+
+  //----------------------------------------------------------------------------
+  static bool Rasterize(vtkTextProperty* font, int dpi, Atlas& atlas)
+  {
+    vtkTextRenderer* renderer = vtkTextRenderer::GetInstance();
+    if (!renderer)
+    {
+      return false;
+    }
+
+    // the glyphs are rasterized in white, the color of the text is the color of the actor
+    vtkNew<vtkTextProperty> tprop;
+    tprop->ShallowCopy(font);
+    tprop->SetColor(1.0, 1.0, 1.0);
+    tprop->SetOpacity(1.0);
+    tprop->SetBackgroundOpacity(0.0);
+    tprop->FrameOff();
+    tprop->ShadowOff();
+    tprop->SetOrientation(0.0);
+    tprop->SetJustificationToLeft();
+    tprop->SetVerticalJustificationToBottom();
+
+    // all the glyphs are on a single line between two bars, so they share the same baseline
+    // and the start of each glyph is the width of the text before it, up to a constant shift
+    int barWidth = ::GetWidth(renderer, tprop, "|", dpi);
+    int barsWidth = ::GetWidth(renderer, tprop, "||", dpi);
+    std::string line;
+    for (int i = 0; i < NUMBER_OF_GLYPHS; i++)
+    {
+      atlas.Start[i] = ::GetWidth(renderer, tprop, "|" + line + "|", dpi) - barWidth;
+
+      std::string glyph(1, static_cast<char>(FIRST_GLYPH + i));
+      atlas.Advance[i] = ::GetWidth(renderer, tprop, "|" + glyph + "|", dpi) - barsWidth;
+      line += glyph + GLYPH_SEPARATOR;
+    }
+
+    vtkNew<vtkImageData> image;
+    int textDims[2];
+    if (!renderer->RenderString(tprop, "|" + line + "|", image, textDims, dpi))
+    {
+      return false;
+    }
+
+    int dims[3];
+    image->GetDimensions(dims);
+    atlas.ImageSize[0] = dims[0];
+    atlas.ImageSize[1] = dims[1];
+    atlas.LineHeight = textDims[1];
+
+    atlas.Texture->SetInputData(image);
+    atlas.Texture->InterpolateOff();
+    atlas.Texture->EdgeClampOn();
+    return true;
+  }
+};
+
+vtkStandardNewMacro(vtkF3DGlyphTextActor);
+
+//------------------------------------------------------------------------------
+vtkF3DGlyphTextActor::vtkF3DGlyphTextActor()
+  : Pimpl(new Internals())
+{
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToFloat();
+  this->GlyphPolyData->SetPoints(points);
+
+  vtkNew<vtkFloatArray> tcoords;
+  tcoords->SetNumberOfComponents(2);
+  this->GlyphPolyData->GetPointData()->SetTCoords(tcoords);
+
+  vtkNew<vtkCellArray> polys;
+  this->GlyphPolyData->SetPolys(polys);
+
+  this->GlyphMapper->SetInputData(this->GlyphPolyData);
+  this->GlyphMapper->ScalarVisibilityOff();
+  this->GlyphActor->SetMapper(this->GlyphMapper);
+}
+
+//------------------------------------------------------------------------------
+vtkF3DGlyphTextActor::~vtkF3DGlyphTextActor() = default;
+
+//------------------------------------------------------------------------------
+void vtkF3DGlyphTextActor::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Input: " << this->Input << "\n";
+  os << indent << "NumberOfAtlases: " << this->Pimpl->Atlases.size() << "\n";
+}
+
+//------------------------------------------------------------------------------
+void vtkF3DGlyphTextActor::SetInput(const std::string& input)
+{
+  if (this->Input != input)
+  {
+    this->Input = input;
+    this->Modified();
+  }
+}
+
+//------------------------------------------------------------------------------
+const std::string& vtkF3DGlyphTextActor::GetInput()
+{
+  return this->Input;
+}
+
+//------------------------------------------------------------------------------
+vtkTextProperty* vtkF3DGlyphTextActor::GetTextProperty()
+{
+  return this->TextProperty;
+}
+
+//------------------------------------------------------------------------------
+int vtkF3DGlyphTextActor::GetNumberOfAtlases()
+{
+  return static_cast<int>(this->Pimpl->Atlases.size());
+}
+
+//------------------------------------------------------------------------------
+void vtkF3DGlyphTextActor::ReleaseGraphicsResources(vtkWindow* win)
+{
+  this->GlyphActor->ReleaseGraphicsResources(win);
+  for (auto& atlas : this->Pimpl->Atlases)
+  {
+    atlas.second.Texture->ReleaseGraphicsResources(win);
+  }
+}
+
+//------------------------------------------------------------------------------
+int vtkF3DGlyphTextActor::RenderOverlay(vtkViewport* viewport)
+{
+  if (this->Input.empty() || !this->BuildGlyphGeometry(viewport))
+  {
+    return 0;
+  }
+
+  this->GlyphActor->SetPosition(this->GetPosition());
+  this->GlyphActor->GetProperty()->SetColor(this->TextProperty->GetColor());
+  this->GlyphActor->GetProperty()->SetOpacity(this->TextProperty->GetOpacity());
+  return this->GlyphActor->RenderOverlay(viewport);
+}
+
+//------------------------------------------------------------------------------
+bool vtkF3DGlyphTextActor::BuildGlyphGeometry(vtkViewport* viewport)
+{
+  vtkWindow* win = viewport->GetVTKWindow();
+  int dpi = win ? win->GetDPI() : 72;
+  std::string key = Internals::GetFontKey(this->TextProperty, dpi);
+
+  auto it = this->Pimpl->Atlases.find(key);
+  if (it == this->Pimpl->Atlases.end())
+  {
+    it = this->Pimpl->Atlases.emplace(std::piecewise_construct, std::forward_as_tuple(key),
+                                std::forward_as_tuple())
+           .first;
+    if (!Internals::Rasterize(this->TextProperty, dpi, it->second))
+    {
+      vtkErrorMacro("Cannot rasterize the glyph atlas");
+      this->Pimpl->Atlases.erase(it);
+      return false;
+    }
+  }
+  const Internals::Atlas& atlas = it->second;
+  this->GlyphActor->SetTexture(atlas.Texture);
+
+  double lineSpacing = this->TextProperty->GetLineSpacing();
+  if (this->Pimpl->BuiltInput == this->Input && this->Pimpl->BuiltFont == key &&
+    this->Pimpl->BuiltLineSpacing == lineSpacing)
+  {
+    return true;
+  }
+
+  int numberOfLines = 1;
+  for (char c : this->Input)
+  {
+    numberOfLines += c == '\n' ? 1 : 0;
+  }
+  int lineAdvance = static_cast<int>(std::round(atlas.LineHeight * lineSpacing));
+
+  vtkPoints* points = this->GlyphPolyData->GetPoints();
+  vtkFloatArray* tcoords =
+    vtkFloatArray::SafeDownCast(this->GlyphPolyData->GetPointData()->GetTCoords());
+  vtkCellArray* polys = this->GlyphPolyData->GetPolys();
+  points->SetNumberOfPoints(4 * static_cast<vtkIdType>(this->Input.size()));
+  tcoords->SetNumberOfTuples(4 * static_cast<vtkIdType>(this->Input.size()));
+  polys->Reset();
+
+  // the lowest line is at the position of the actor
+  int x = 0;
+  int y = (numberOfLines - 1) * lineAdvance;
+  vtkIdType index = 0;
+  for (char c : this->Input)
+  {
+    if (c == '\n')
+    {
+      x = 0;
+      y -= lineAdvance;
+      continue;
+    }
+
+    int glyph = c >= FIRST_GLYPH && c <= LAST_GLYPH ? c - FIRST_GLYPH : '?' - FIRST_GLYPH;
+    if (c != ' ')
+    {
+      float x0 = static_cast<float>(x - GLYPH_PADDING);
+      float x1 = static_cast<float>(x + atlas.Advance[glyph] + GLYPH_PADDING);
+      float y0 = static_cast<float>(y);
+      float y1 = static_cast<float>(y + atlas.LineHeight);
+      float s0 = static_cast<float>(atlas.Start[glyph] - GLYPH_PADDING) / atlas.ImageSize[0];
+      float s1 = static_cast<float>(atlas.Start[glyph] + atlas.Advance[glyph] + GLYPH_PADDING) /
+        atlas.ImageSize[0];
+      float t1 = static_cast<float>(atlas.LineHeight) / atlas.ImageSize[1];
+
+      vtkIdType ids[4] = { index, index + 1, index + 2, index + 3 };
+      points->SetPoint(ids[0], x0, y0, 0.f);
+      points->SetPoint(ids[1], x1, y0, 0.f);
+      points->SetPoint(ids[2], x1, y1, 0.f);
+      points->SetPoint(ids[3], x0, y1, 0.f);
+      tcoords->SetTuple2(ids[0], s0, 0.f);
+      tcoords->SetTuple2(ids[1], s1, 0.f);
+      tcoords->SetTuple2(ids[2], s1, t1);
+      tcoords->SetTuple2(ids[3], s0, t1);
+      polys->InsertNextCell(4, ids);
+      index += 4;
+    }
+    x += atlas.Advance[glyph];
+  }
+
+  // spaces and line breaks have no quad
+  points->SetNumberOfPoints(index);
+  tcoords->SetNumberOfTuples(index);
+  points->Modified();
+  tcoords->Modified();
+  this->GlyphPolyData->Modified();
+
+  this->Pimpl->BuiltInput = this->Input;
+  this->Pimpl->BuiltFont = key;
+  this->Pimpl->BuiltLineSpacing = lineSpacing;
+  return true;
+}
@@ -0,0 +1,108 @@
+/**
+ * @class   vtkF3DGlyphTextActor
+ * @brief   A text actor drawing glyph quads from a cached atlas
+ *
+ * Unlike vtkTextActor which rasterizes the whole string into a new texture each time
+ * the text changes, this actor rasterizes the printable ASCII glyphs of its font once
+ * into an atlas and draws the text as one textured quad per glyph. Changing the text only
+ * rewrites the points and texture coordinates of the quads, so it is suited to text
+ * updated every frame, like the frame rate.
+ * An atlas is kept for each font ever used (family or file, size, bold, italic and DPI),
+ * so switching back to a previous font does not rasterize it again.
+ * The text is left justified and its lowest line is at the position of the actor,
+ * kerning is not supported and other characters are displayed as '?'.
+ */
+
+#ifndef vtkF3DGlyphTextActor_h
+#define vtkF3DGlyphTextActor_h
+
+#include <vtkActor2D.h>
+
+#include <vtkNew.h>
+
+#include <memory>
+#include <string>
+
+class vtkPolyData;
+class vtkPolyDataMapper2D;
+class vtkTextProperty;
+class vtkTexturedActor2D;
+
+class vtkF3DGlyphTextActor : public vtkActor2D
+{
+public:
+  static vtkF3DGlyphTextActor* New();
+  vtkTypeMacro(vtkF3DGlyphTextActor, vtkActor2D);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /**
+   * Set/Get the text to display, lines are separated by '\n'
+   */
+  void SetInput(const std::string& input);
+  const std::string& GetInput();
+  ///@}
+
+  /**
+   * Get the text property used to display text in this actor
+   * Only the font, the color and the opacity are used
+   */
+  vtkTextProperty* GetTextProperty();
+
+  /**
+   * Get the number of atlases rasterized so far
+   */
+  int GetNumberOfAtlases();
+
+  /**
+   * Release private actor graphic resources
+   */
+  void ReleaseGraphicsResources(vtkWindow*) override;
+
+  /**
+   * Render the glyph quads overlay
+   */
+  int RenderOverlay(vtkViewport* viewport) override;
+
+  /**
+   * Reimplemented for noop
+   */
+  int RenderTranslucentPolygonalGeometry(vtkViewport* vtkNotUsed(viewport)) override
+  {
+    return 0;
+  }
+
+  /**
+   * Reimplemented for noop
+   */
+  int RenderOpaqueGeometry(vtkViewport* vtkNotUsed(viewport)) override
+  {
+    return 0;
+  }
+
+protected:
+  vtkF3DGlyphTextActor();
+  ~vtkF3DGlyphTextActor() override;
+
+private:
+  vtkF3DGlyphTextActor(const vtkF3DGlyphTextActor&) = delete;
+  void operator=(const vtkF3DGlyphTextActor&) = delete;
+
+  /**
+   * Rewrite the quads of the text with the atlas of the current font,
+   * rasterizing it first if it was never used
+   * Return true on success, false otherwise
+   */
+  bool BuildGlyphGeometry(vtkViewport* viewport);
+
+  std::string Input;
+  vtkNew<vtkTextProperty> TextProperty;
+  vtkNew<vtkPolyData> GlyphPolyData;
+  vtkNew<vtkPolyDataMapper2D> GlyphMapper;
+  vtkNew<vtkTexturedActor2D> GlyphActor;
+
+  struct Internals;
+  std::unique_ptr<Internals> Pimpl;
+};
+
+#endif
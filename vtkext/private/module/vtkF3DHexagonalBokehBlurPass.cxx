@@ -15,6 +15,8 @@
 #include "vtkShaderProgram.h"
 #include "vtkTextureObject.h"
 
+#include <algorithm>
+
 vtkStandardNewMacro(vtkF3DHexagonalBokehBlurPass);
 
 double BlurFuncStep(double CoC)
@@ -25,6 +27,14 @@ double BlurFuncStep(double CoC)
   return 2.0 / std::max(std::abs(CoC), 8.0);
 }
 
+int BlurDownsampling(double CoC)
+{
+  /* large circles of confusion blur the details lost at a lower resolution anyway,
+   * and the blur then needs less iterations and less pixels.
+   */
+  return std::clamp(static_cast<int>(std::abs(CoC) / 16.0), 1, 4);
+}
+
 constexpr std::string_view BlurFunc()
 {
   // clang-format off
@@ -133,7 +143,12 @@ void vtkF3DHexagonalBokehBlurPass::RenderDelegate(const vtkRenderState* s, int w
 
   glRen->GetState()->vtkglClear(GL_COLOR_BUFFER_BIT);
 
-  this->DelegatePass->Render(s);
+  // the delegate is rendered at the size of the framebuffer, that can be downsampled
+  vtkRenderState delegateState(s->GetRenderer());
+  delegateState.SetPropArrayAndCount(s->GetPropArray(), s->GetPropArrayCount());
+  delegateState.SetFrameBuffer(this->FrameBufferObject);
+
+  this->DelegatePass->Render(&delegateState);
   this->NumberOfRenderedProps += this->DelegatePass->GetNumberOfRenderedProps();
 
   this->FrameBufferObject->RemoveColorAttachments(1);
@@ -155,7 +170,9 @@ void vtkF3DHexagonalBokehBlurPass::RenderDirectionalBlur(
     ssDecl << "uniform sampler2D backgroundTexture;\n";
     ssDecl << "uniform vec2 invViewDims;\n";
     ssDecl << "uniform float coc;\n";
-    ssDecl << "const float step = " << BlurFuncStep(CircleOfConfusionRadius) << ";\n";
+    ssDecl << "const float step = "
+           << BlurFuncStep(CircleOfConfusionRadius / BlurDownsampling(CircleOfConfusionRadius))
+           << ";\n";
     ssDecl << BlurFunc();
     ssDecl << "//VTK::FSQ::Decl";
 
@@ -191,7 +208,8 @@ void vtkF3DHexagonalBokehBlurPass::RenderDirectionalBlur(
   float invViewDims[2] = { 1.f / static_cast<float>(width), 1.f / static_cast<float>(height) };
   this->BlurQuadHelper->Program->SetUniform2f("invViewDims", invViewDims);
 
-  this->BlurQuadHelper->Program->SetUniformf("coc", std::abs(this->CircleOfConfusionRadius));
+  this->BlurQuadHelper->Program->SetUniformf("coc",
+    std::abs(this->CircleOfConfusionRadius) / BlurDownsampling(this->CircleOfConfusionRadius));
 
   this->FrameBufferObject->GetContext()->GetState()->PushFramebufferBindings();
   this->FrameBufferObject->Bind();
@@ -223,7 +241,9 @@ void vtkF3DHexagonalBokehBlurPass::RenderRhomboidBlur(
     ssDecl << "uniform sampler2D diagonalBlurTexture;\n";
     ssDecl << "uniform vec2 invViewDims;\n";
     ssDecl << "uniform float coc;\n";
-    ssDecl << "const float step = " << BlurFuncStep(CircleOfConfusionRadius) << ";\n";
+    ssDecl << "const float step = "
+           << BlurFuncStep(CircleOfConfusionRadius / BlurDownsampling(CircleOfConfusionRadius))
+           << ";\n";
     ssDecl << BlurFunc();
     ssDecl << "//VTK::FSQ::Decl";
 
@@ -261,7 +281,8 @@ void vtkF3DHexagonalBokehBlurPass::RenderRhomboidBlur(
   float invViewDims[2] = { 1.f / static_cast<float>(width), 1.f / static_cast<float>(height) };
   this->RhomboidQuadHelper->Program->SetUniform2f("invViewDims", invViewDims);
 
-  this->RhomboidQuadHelper->Program->SetUniformf("coc", std::abs(this->CircleOfConfusionRadius));
+  this->RhomboidQuadHelper->Program->SetUniformf("coc",
+    std::abs(this->CircleOfConfusionRadius) / BlurDownsampling(this->CircleOfConfusionRadius));
 
   this->RhomboidQuadHelper->Render();
 
@@ -296,22 +317,32 @@ void vtkF3DHexagonalBokehBlurPass::Render(const vtkRenderState* s)
     r->GetTiledSizeAndOrigin(&w, &h, &x, &y);
   }
 
-  this->InitializeGraphicsResources(renWin, w, h);
+  // the background and the directional blurs are rendered at a lower resolution,
+  // the last blur is upsampled by the linear filtering of the textures
+  int downsampling = BlurDownsampling(this->CircleOfConfusionRadius);
+  int bw = std::max(1, w / downsampling);
+  int bh = std::max(1, h / downsampling);
 
-  this->BackgroundTexture->Resize(w, h);
-  this->VerticalBlurTexture->Resize(w, h);
-  this->DiagonalBlurTexture->Resize(w, h);
+  this->InitializeGraphicsResources(renWin, bw, bh);
 
-  ostate->vtkglViewport(x, y, w, h);
-  ostate->vtkglScissor(x, y, w, h);
+  this->BackgroundTexture->Resize(bw, bh);
+  this->VerticalBlurTexture->Resize(bw, bh);
+  this->DiagonalBlurTexture->Resize(bw, bh);
+
+  ostate->vtkglViewport(x, y, bw, bh);
+  ostate->vtkglScissor(x, y, bw, bh);
 
-  this->RenderDelegate(s, w, h);
+  this->RenderDelegate(s, bw, bh);
 
   ostate->vtkglDisable(GL_BLEND);
   ostate->vtkglDisable(GL_DEPTH_TEST);
 
-  this->RenderDirectionalBlur(renWin, w, h);
-  this->RenderRhomboidBlur(renWin, w, h);
+  this->RenderDirectionalBlur(renWin, bw, bh);
+
+  ostate->vtkglViewport(x, y, w, h);
+  ostate->vtkglScissor(x, y, w, h);
+
+  this->RenderRhomboidBlur(renWin, bw, bh);
 
   vtkOpenGLCheckErrorMacro("failed after Render");
 }
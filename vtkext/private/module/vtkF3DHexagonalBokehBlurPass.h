@@ -5,6 +5,8 @@
  * This pass is used to blur the background and simulate a depth of field.
  * Adapted from "Advances in Real-Time Rendering", Siggraph 2011
  * https://colinbarrebrisebois.com/2017/04/18/hexagonal-bokeh-blur-revisited-part-1-basic-3-pass-version/
+ * For large circles of confusion, the delegate and the first blur pass are rendered at a lower
+ * resolution and the second pass upsamples them.
  *
  */
 
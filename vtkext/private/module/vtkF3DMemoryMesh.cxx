@@ -1,5 +1,7 @@
 #include "vtkF3DMemoryMesh.h"
 
+#include "vtkCallbackCommand.h"
+#include "vtkCellData.h"
 #include "vtkDataArrayRange.h"
 #include "vtkFloatArray.h"
 #include "vtkIdTypeArray.h"
@@ -7,7 +9,12 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkSMPTools.h"
+#include "vtkTypeInt32Array.h"
+#include "vtkUnsignedCharArray.h"
 
+#include <algorithm>
+#include <functional>
+#include <limits>
 #include <numeric>
 
 vtkStandardNewMacro(vtkF3DMemoryMesh);
@@ -34,6 +41,198 @@ vtkSmartPointer<vtkFloatArray> ConvertToFloatArray(const std::vector<float>& pos
 
   return arr;
 }
+
+//------------------------------------------------------------------------------
+/**
+ * Keep the owner of the external buffers alive as long as the array exists
+ */
+void AttachOwner(vtkDataArray* arr, const std::shared_ptr<void>& owner)
+{
+  if (!owner)
+  {
+    return;
+  }
+
+  // The client data is deleted with the command, when the array is deleted
+  vtkNew<vtkCallbackCommand> command;
+  command->SetClientData(new std::shared_ptr<void>(owner));
+  command->SetClientDataDeleteCallback(
+    [](void* clientData) { delete static_cast<std::shared_ptr<void>*>(clientData); });
+  arr->AddObserver(vtkCommand::DeleteEvent, command);
+}
+
+//------------------------------------------------------------------------------
+template<typename ArrayType>
+vtkSmartPointer<ArrayType> WrapArray(const typename ArrayType::ValueType* values, vtkIdType size,
+  int nbComponents, const std::shared_ptr<void>& owner)
+{
+  using ValueType = typename ArrayType::ValueType;
+  vtkNew<ArrayType> arr;
+  arr->SetNumberOfComponents(nbComponents);
+
+  // The output of a source is never modified in place, the buffer is only read
+  arr->SetArray(const_cast<ValueType*>(values), size, 1);
+  ::AttachOwner(arr, owner);
+  return arr;
+}
+
+//------------------------------------------------------------------------------
+template<typename ArrayType, typename T>
+vtkSmartPointer<ArrayType> CopyArray(const T* values, vtkIdType size, int nbComponents)
+{
+  vtkNew<ArrayType> arr;
+  arr->SetNumberOfComponents(nbComponents);
+  arr->SetNumberOfValues(size);
+  typename ArrayType::ValueType* ptr = arr->GetPointer(0);
+  vtkSMPTools::For(0, size,
+    [&](vtkIdType begin, vtkIdType end) { std::copy(values + begin, values + end, ptr + begin); });
+  return arr;
+}
+
+//------------------------------------------------------------------------------
+/**
+ * Use the indices as connectivity, wrapping them if an owner is provided and they do not need
+ * to be converted, copying them otherwise
+ */
+template<typename ArrayType, typename T>
+vtkSmartPointer<ArrayType> CreateConnectivity(
+  const T* indices, vtkIdType nbIndices, const std::shared_ptr<void>* owner)
+{
+  using ValueType = typename ArrayType::ValueType;
+
+  // Indices are smaller than the number of points, their unsigned and signed values are the same
+  if constexpr (sizeof(T) == sizeof(ValueType))
+  {
+    if (owner)
+    {
+      return ::WrapArray<ArrayType>(
+        reinterpret_cast<const ValueType*>(indices), nbIndices, 1, *owner);
+    }
+  }
+  return ::CopyArray<ArrayType>(indices, nbIndices, 1);
+}
+
+//------------------------------------------------------------------------------
+/**
+ * Create cells of the same size, their offsets are computed analytically
+ */
+template<typename ArrayType, typename T>
+vtkSmartPointer<vtkCellArray> CreateTypedCells(
+  const T* indices, vtkIdType nbIndices, vtkIdType cellSize, const std::shared_ptr<void>* owner)
+{
+  using ValueType = typename ArrayType::ValueType;
+  vtkIdType nbOffsets = nbIndices / cellSize + 1;
+  vtkNew<ArrayType> offsets;
+  offsets->SetNumberOfValues(nbOffsets);
+  ValueType* offsetsPtr = offsets->GetPointer(0);
+  vtkSMPTools::For(0, nbOffsets,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType i = begin; i < end; i++)
+      {
+        offsetsPtr[i] = static_cast<ValueType>(cellSize * i);
+      }
+    });
+
+  vtkNew<vtkCellArray> polys;
+  polys->SetData(offsets, ::CreateConnectivity<ArrayType>(indices, nbIndices, owner));
+  return polys;
+}
+
+//------------------------------------------------------------------------------
+/**
+ * Create cells of any size, their offsets are a prefix sum of their sizes computed in parallel:
+ * the sizes of each block are summed, the block sums are scanned, then each block is scanned
+ * from its first offset
+ */
+template<typename ArrayType>
+vtkSmartPointer<vtkCellArray> CreateTypedFaces(const unsigned int* faceSizes, vtkIdType nbFaces,
+  const unsigned int* faceIndices, vtkIdType nbFaceIndices, const std::shared_ptr<void>* owner)
+{
+  using ValueType = typename ArrayType::ValueType;
+  vtkNew<ArrayType> offsets;
+  offsets->SetNumberOfValues(nbFaces + 1);
+  ValueType* offsetsPtr = offsets->GetPointer(0);
+  offsetsPtr[0] = 0;
+
+  constexpr vtkIdType blockSize = 1 << 16;
+  vtkIdType nbBlocks = (nbFaces + blockSize - 1) / blockSize;
+  std::vector<ValueType> blockOffsets(nbBlocks + 1, 0);
+  vtkSMPTools::For(0, nbBlocks,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType b = begin; b < end; b++)
+      {
+        const unsigned int* first = faceSizes + b * blockSize;
+        const unsigned int* last = faceSizes + std::min((b + 1) * blockSize, nbFaces);
+        blockOffsets[b + 1] = std::accumulate(first, last, ValueType(0));
+      }
+    });
+  std::partial_sum(blockOffsets.begin(), blockOffsets.end(), blockOffsets.begin());
+
+  vtkSMPTools::For(0, nbBlocks,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType b = begin; b < end; b++)
+      {
+        ValueType offset = blockOffsets[b];
+        for (vtkIdType i = b * blockSize; i < std::min((b + 1) * blockSize, nbFaces); i++)
+        {
+          offset += static_cast<ValueType>(faceSizes[i]);
+          offsetsPtr[i + 1] = offset;
+        }
+      }
+    });
+
+  vtkNew<vtkCellArray> polys;
+  polys->SetData(offsets, ::CreateConnectivity<ArrayType>(faceIndices, nbFaceIndices, owner));
+  return polys;
+}
+
+//------------------------------------------------------------------------------
+/**
+ * Create faces with 32-bit indices if possible, wrapping the indices if an owner is provided
+ * and they do not need to be converted, copying them otherwise.
+ * Faces of the same size, such as triangle meshes, do not need their sizes to be scanned.
+ */
+vtkSmartPointer<vtkCellArray> CreateFaces(const unsigned int* faceSizes, vtkIdType nbFaces,
+  const unsigned int* faceIndices, vtkIdType nbFaceIndices, vtkIdType nbPoints,
+  const std::shared_ptr<void>* owner)
+{
+  constexpr vtkIdType maxIndex = std::numeric_limits<vtkTypeInt32>::max();
+  bool use32 = nbPoints <= maxIndex && nbFaceIndices <= maxIndex;
+  bool sameSize = nbFaces > 0 && faceSizes[0] > 0 &&
+    std::adjacent_find(faceSizes, faceSizes + nbFaces, std::not_equal_to<unsigned int>()) ==
+      faceSizes + nbFaces;
+  if (sameSize)
+  {
+    return use32 ? ::CreateTypedCells<vtkTypeInt32Array>(
+                     faceIndices, nbFaceIndices, faceSizes[0], owner)
+                 : ::CreateTypedCells<vtkIdTypeArray>(
+                     faceIndices, nbFaceIndices, faceSizes[0], nullptr);
+  }
+  return use32 ? ::CreateTypedFaces<vtkTypeInt32Array>(
+                   faceSizes, nbFaces, faceIndices, nbFaceIndices, owner)
+               : ::CreateTypedFaces<vtkIdTypeArray>(
+                   faceSizes, nbFaces, faceIndices, nbFaceIndices, nullptr);
+}
+
+//------------------------------------------------------------------------------
+/**
+ * Create triangles with 32-bit indices if possible, wrapping the indices if an owner is provided
+ * and they do not need to be converted, copying them otherwise
+ */
+template<typename T>
+vtkSmartPointer<vtkCellArray> CreateTriangles(
+  const T* indices, vtkIdType nbIndices, vtkIdType nbPoints, const std::shared_ptr<void>* owner)
+{
+  constexpr vtkIdType maxIndex = std::numeric_limits<vtkTypeInt32>::max();
+  if (nbPoints > maxIndex || nbIndices > maxIndex)
+  {
+    return ::CreateTypedCells<vtkIdTypeArray>(indices, nbIndices, 3, nullptr);
+  }
+  return ::CreateTypedCells<vtkTypeInt32Array>(indices, nbIndices, 3, owner);
+}
 }
 
 //------------------------------------------------------------------------------
@@ -53,51 +252,185 @@ void vtkF3DMemoryMesh::SetPoints(const std::vector<float>& positions)
   points->SetData(ConvertToFloatArray<3>(positions));
 
   this->Mesh->SetPoints(points);
+  this->Modified();
 }
 
 //------------------------------------------------------------------------------
 void vtkF3DMemoryMesh::SetNormals(const std::vector<float>& normals)
 {
   this->Mesh->GetPointData()->SetNormals(ConvertToFloatArray<3>(normals));
+  this->Modified();
 }
 
 //------------------------------------------------------------------------------
 void vtkF3DMemoryMesh::SetTCoords(const std::vector<float>& tcoords)
 {
   this->Mesh->GetPointData()->SetTCoords(ConvertToFloatArray<2>(tcoords));
+  this->Modified();
 }
 
 //------------------------------------------------------------------------------
 void vtkF3DMemoryMesh::SetFaces(
   const std::vector<unsigned int>& faceSizes, const std::vector<unsigned int>& faceIndices)
 {
-  vtkNew<vtkIdTypeArray> offsets;
-  vtkNew<vtkIdTypeArray> connectivity;
-  offsets->SetNumberOfTuples(faceSizes.size() + 1);
-  connectivity->SetNumberOfTuples(faceIndices.size());
+  this->Mesh->SetPolys(::CreateFaces(faceSizes.data(), faceSizes.size(), faceIndices.data(),
+    faceIndices.size(), this->Mesh->GetNumberOfPoints(), nullptr));
+  this->Modified();
+}
 
-  // fill offsets
-  offsets->SetTypedComponent(0, 0, 0);
-  for (size_t i = 0; i < faceSizes.size(); i++)
+//------------------------------------------------------------------------------
+void vtkF3DMemoryMesh::SetExternalBuffersDeleter(std::function<void()> deleter)
+{
+  this->ExternalOwner.reset();
+  if (deleter)
   {
-    offsets->SetTypedComponent(
-      i + 1, 0, offsets->GetTypedComponent(i, 0) + static_cast<vtkIdType>(faceSizes[i]));
+    this->ExternalOwner =
+      std::shared_ptr<void>(nullptr, [deleter = std::move(deleter)](void*) { deleter(); });
   }
+}
 
-  // fill connectivity
-  vtkSMPTools::For(0, faceIndices.size(),
-    [&](vtkIdType begin, vtkIdType end)
-    {
-      for (vtkIdType i = begin; i < end; i++)
-      {
-        connectivity->SetTypedComponent(i, 0, static_cast<vtkIdType>(faceIndices[i]));
-      }
-    });
+//------------------------------------------------------------------------------
+void vtkF3DMemoryMesh::SetExternalPoints(const float* positions, vtkIdType size)
+{
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToFloat();
+  points->SetData(::WrapArray<vtkFloatArray>(positions, size, 3, this->ExternalOwner));
 
-  vtkNew<vtkCellArray> polys;
-  polys->SetData(offsets, connectivity);
+  this->Mesh->SetPoints(points);
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+void vtkF3DMemoryMesh::SetExternalNormals(const float* normals, vtkIdType size)
+{
+  this->Mesh->GetPointData()->SetNormals(
+    size > 0 ? ::WrapArray<vtkFloatArray>(normals, size, 3, this->ExternalOwner) : nullptr);
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+void vtkF3DMemoryMesh::SetExternalTCoords(const float* tcoords, vtkIdType size)
+{
+  this->Mesh->GetPointData()->SetTCoords(
+    size > 0 ? ::WrapArray<vtkFloatArray>(tcoords, size, 2, this->ExternalOwner) : nullptr);
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+void vtkF3DMemoryMesh::SetExternalFaces(const unsigned int* faceSizes, vtkIdType nbFaces,
+  const unsigned int* faceIndices, vtkIdType nbFaceIndices)
+{
+  this->Mesh->SetPolys(::CreateFaces(faceSizes, nbFaces, faceIndices, nbFaceIndices,
+    this->Mesh->GetNumberOfPoints(), &this->ExternalOwner));
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+void vtkF3DMemoryMesh::SetTriangles(const std::vector<unsigned int>& indices)
+{
+  this->Mesh->SetPolys(::CreateTriangles(
+    indices.data(), indices.size(), this->Mesh->GetNumberOfPoints(), nullptr));
+  this->Modified();
+}
 
-  this->Mesh->SetPolys(polys);
+//------------------------------------------------------------------------------
+void vtkF3DMemoryMesh::SetTriangles(const std::vector<uint16_t>& indices)
+{
+  this->Mesh->SetPolys(::CreateTriangles(
+    indices.data(), indices.size(), this->Mesh->GetNumberOfPoints(), nullptr));
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+void vtkF3DMemoryMesh::SetExternalTriangles(const unsigned int* indices, vtkIdType size)
+{
+  this->Mesh->SetPolys(
+    ::CreateTriangles(indices, size, this->Mesh->GetNumberOfPoints(), &this->ExternalOwner));
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+void vtkF3DMemoryMesh::SetExternalTriangles(const uint16_t* indices, vtkIdType size)
+{
+  this->Mesh->SetPolys(
+    ::CreateTriangles(indices, size, this->Mesh->GetNumberOfPoints(), &this->ExternalOwner));
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+void vtkF3DMemoryMesh::SetColors(const std::vector<unsigned char>& colors)
+{
+  vtkSmartPointer<vtkUnsignedCharArray> arr =
+    ::CopyArray<vtkUnsignedCharArray>(colors.data(), colors.size(), 4);
+  arr->SetName("colors");
+  this->Mesh->GetPointData()->AddArray(arr);
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+void vtkF3DMemoryMesh::SetExternalColors(const unsigned char* colors, vtkIdType size)
+{
+  vtkSmartPointer<vtkUnsignedCharArray> arr =
+    ::WrapArray<vtkUnsignedCharArray>(colors, size, 4, this->ExternalOwner);
+  arr->SetName("colors");
+  this->Mesh->GetPointData()->AddArray(arr);
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+void vtkF3DMemoryMesh::SetPointArray(
+  const std::string& name, int nbComponents, const std::vector<float>& values)
+{
+  vtkSmartPointer<vtkFloatArray> arr =
+    ::CopyArray<vtkFloatArray>(values.data(), values.size(), nbComponents);
+  arr->SetName(name.c_str());
+  this->Mesh->GetPointData()->AddArray(arr);
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+void vtkF3DMemoryMesh::SetCellArray(
+  const std::string& name, int nbComponents, const std::vector<float>& values)
+{
+  vtkSmartPointer<vtkFloatArray> arr =
+    ::CopyArray<vtkFloatArray>(values.data(), values.size(), nbComponents);
+  arr->SetName(name.c_str());
+  this->Mesh->GetCellData()->AddArray(arr);
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+void vtkF3DMemoryMesh::SetExternalPointArray(
+  const std::string& name, int nbComponents, const float* values, vtkIdType size)
+{
+  vtkSmartPointer<vtkFloatArray> arr =
+    ::WrapArray<vtkFloatArray>(values, size, nbComponents, this->ExternalOwner);
+  arr->SetName(name.c_str());
+  this->Mesh->GetPointData()->AddArray(arr);
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+void vtkF3DMemoryMesh::SetExternalCellArray(
+  const std::string& name, int nbComponents, const float* values, vtkIdType size)
+{
+  vtkSmartPointer<vtkFloatArray> arr =
+    ::WrapArray<vtkFloatArray>(values, size, nbComponents, this->ExternalOwner);
+  arr->SetName(name.c_str());
+  this->Mesh->GetCellData()->AddArray(arr);
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkF3DMemoryMesh::GetNumberOfPoints()
+{
+  return this->Mesh->GetNumberOfPoints();
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkF3DMemoryMesh::GetNumberOfCells()
+{
+  return this->Mesh->GetNumberOfCells();
 }
 
 //------------------------------------------------------------------------------
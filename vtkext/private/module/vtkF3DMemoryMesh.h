@@ -4,13 +4,20 @@
  *
  * Simple source which convert and copy vectors provided by the user
  * to internal structure of vtkPolyData.
- * Does not support point data (normals, tcoords...) nor cell data yet.
+ * Buffers owned by the user can also be used directly, without any copy.
+ * Also supports named float point and cell arrays, and RGBA colors as a "colors" point array.
  */
 #ifndef vtkF3DMemoryMesh_h
 #define vtkF3DMemoryMesh_h
 
 #include "vtkPolyDataAlgorithm.h"
 
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
 class vtkF3DMemoryMesh : public vtkPolyDataAlgorithm
 {
 public:
@@ -49,10 +56,85 @@ public:
    * The length of faceIndices should be the sum of all values in faceSizes
    * The lists are copied internally.
    * The lists can be empty, resulting in a point cloud.
+   * Indices are stored as 32-bit integers when the mesh has less than 2^31 points and face
+   * indices, must be called after SetPoints. Face offsets are computed analytically when all
+   * the faces have the same size, in parallel otherwise.
    */
   void SetFaces(
     const std::vector<unsigned int>& faceSizes, const std::vector<unsigned int>& faceIndices);
 
+  /**
+   * Set a function called once the buffers provided to the SetExternal methods are not used
+   * anymore, by this source and by its output.
+   * Must be called before the SetExternal methods.
+   */
+  void SetExternalBuffersDeleter(std::function<void()> deleter);
+
+  ///@{
+  /**
+   * Same as SetPoints, SetNormals and SetTCoords, but the buffers are used without any copy.
+   * `size` is the number of values of the buffer, which must not be modified while it is used.
+   * An empty normals or texture coordinates buffer removes them.
+   */
+  void SetExternalPoints(const float* positions, vtkIdType size);
+  void SetExternalNormals(const float* normals, vtkIdType size);
+  void SetExternalTCoords(const float* tcoords, vtkIdType size);
+  ///@}
+
+  /**
+   * Same as SetFaces, but faceIndices is used without any copy when the mesh has less than
+   * 2^31 points and face indices, only the face offsets are computed from faceSizes.
+   * Must be called after SetExternalPoints.
+   */
+  void SetExternalFaces(const unsigned int* faceSizes, vtkIdType nbFaces,
+    const unsigned int* faceIndices, vtkIdType nbFaceIndices);
+
+  ///@{
+  /**
+   * Set triangle faces by vertex indices, 3 indices per triangle.
+   * It is faster than SetFaces as no face sizes are needed. Indices are stored as 32-bit integers
+   * when the mesh has less than 2^31 points and indices, 16-bit indices are converted.
+   * The SetExternal versions use 32-bit indices without any copy when possible.
+   * Must be called after setting the points.
+   */
+  void SetTriangles(const std::vector<unsigned int>& indices);
+  void SetTriangles(const std::vector<uint16_t>& indices);
+  void SetExternalTriangles(const unsigned int* indices, vtkIdType size);
+  void SetExternalTriangles(const uint16_t* indices, vtkIdType size);
+  ///@}
+
+  ///@{
+  /**
+   * Set the RGBA colors of the points, as a 4 components unsigned char "colors" point array.
+   * Length of the list must be 4 times the number of points.
+   * SetColors copies the list internally, SetExternalColors uses it without any copy.
+   */
+  void SetColors(const std::vector<unsigned char>& colors);
+  void SetExternalColors(const unsigned char* colors, vtkIdType size);
+  ///@}
+
+  ///@{
+  /**
+   * Add a named point or cell array, replacing any array with the same name.
+   * Length of the list must be the number of points or cells times the number of components.
+   * The vector versions copy the list internally, the SetExternal versions use it without any copy.
+   */
+  void SetPointArray(const std::string& name, int nbComponents, const std::vector<float>& values);
+  void SetCellArray(const std::string& name, int nbComponents, const std::vector<float>& values);
+  void SetExternalPointArray(
+    const std::string& name, int nbComponents, const float* values, vtkIdType size);
+  void SetExternalCellArray(
+    const std::string& name, int nbComponents, const float* values, vtkIdType size);
+  ///@}
+
+  ///@{
+  /**
+   * Return the number of points or cells of the mesh.
+   */
+  vtkIdType GetNumberOfPoints();
+  vtkIdType GetNumberOfCells();
+  ///@}
+
 protected:
   vtkF3DMemoryMesh();
   ~vtkF3DMemoryMesh() override;
@@ -64,6 +146,9 @@ private:
   void operator=(const vtkF3DMemoryMesh&) = delete;
 
   vtkNew<vtkPolyData> Mesh;
+
+  // Calls the deleter of the external buffers when released by all the arrays using them
+  std::shared_ptr<void> ExternalOwner;
 };
 
 #endif
@@ -1,22 +1,52 @@
 #include "vtkF3DMetaImporter.h"
 
 #include "F3DLog.h"
+#include "vtkF3DGLBWriter.h"
 #include "vtkF3DGenericImporter.h"
+#include "vtkF3DNoRenderWindow.h"
+#include "vtkF3DSimplifyFilter.h"
+#include "vtkF3DSnapshotImporter.h"
+#include "vtkF3DTrace.h"
 
 #include <vtkActorCollection.h>
+#include <vtkAppendPolyData.h>
 #include <vtkCallbackCommand.h>
 #include <vtkCamera.h>
+#include <vtkCellData.h>
+#include <vtkGlyph3DMapper.h>
+#include <vtkIdTypeArray.h>
 #include <vtkImageData.h>
+#include <vtkImageResize.h>
+#include <vtkLight.h>
+#include <vtkLightCollection.h>
+#include <vtkMatrix4x4.h>
 #include <vtkObjectFactory.h>
+#include <vtkPointData.h>
 #include <vtkPolyData.h>
+#include <vtkPropCollection.h>
+#include <vtkProperty.h>
+#include <vtkQuadricClustering.h>
 #include <vtkRenderWindow.h>
+#include <vtkRenderer.h>
 #include <vtkRendererCollection.h>
 #include <vtkSmartPointer.h>
+#include <vtkTexture.h>
+#include <vtkTimeStamp.h>
+#include <vtkTransform.h>
+#include <vtkTransformPolyDataFilter.h>
+#include <vtkTrivialProducer.h>
 #include <vtkVersion.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <chrono>
+#include <future>
 #include <iostream>
+#include <map>
 #include <numeric>
+#include <set>
+#include <thread>
 #include <vector>
 
 struct vtkF3DMetaImporter::Internals
@@ -25,24 +55,261 @@ struct vtkF3DMetaImporter::Internals
   std::vector<vtkF3DMetaImporter::ColoringStruct> ColoringActorsAndMappers;
   std::vector<vtkF3DMetaImporter::PointSpritesStruct> PointSpritesActorsAndMappers;
   std::vector<vtkF3DMetaImporter::VolumeStruct> VolumePropsAndMappers;
+  std::vector<vtkF3DMetaImporter::LODStruct> LODActorsAndMappers;
+  std::vector<vtkF3DMetaImporter::BatchStruct> StaticBatches;
+
+  // Original actor of each point sprites and volume struct
+  std::vector<vtkActor*> PointSpritesOriginalActors;
+  std::vector<vtkActor*> VolumesOriginalActors;
+
+  // Data shown by the props created for each actor with a surface, in the order of the coloring
+  // structs, see CreateColoringActors, CreatePointSprites and CreateVolumes
+  struct SurfaceStruct
+  {
+    SurfaceStruct(vtkActor* originalActor, vtkPolyData* surface)
+      : OriginalActor(originalActor)
+      , Surface(surface)
+      , Points(surface)
+    {
+    }
+    vtkActor* OriginalActor;
+    vtkSmartPointer<vtkPolyData> Surface;
+    vtkSmartPointer<vtkPolyData> Points;
+    vtkSmartPointer<vtkImageData> Image;
+    bool PointSpritesCreated = false;
+    bool VolumeCreated = false;
+  };
+  std::vector<SurfaceStruct> Surfaces;
+
+  // Small surfaces of non-animated importers, that can be batched
+  std::vector<vtkActor*> StaticActors;
+  size_t NumberOfBatchedActors = 0;
 
   struct ImporterPair
   {
     vtkSmartPointer<vtkImporter> Importer;
     bool Updated = false;
+    bool UpdatedElsewhere = false;
+
+    // Lights added to the renderer by the importer
+    std::vector<vtkSmartPointer<vtkLight>> Lights;
+
+    // Snapshot to write once updated, see SetImporterSnapshot
+    std::string SnapshotFileName;
+
+    // Whether the importer has animations, known once updated, see UpdateAtTimeValue
+    std::optional<bool> Animated;
+
+    // The coloring info of the actors has to be updated, see UpdateInfoForColoring
+    bool ColoringInfoOutdated = true;
   };
   std::vector<ImporterPair> Importers;
   std::optional<vtkIdType> CameraIndex;
+  vtkIdType TriangleBudget = 0;
+  bool AsynchronousUpdate = false;
   vtkBoundingBox GeometryBoundingBox;
   bool ColoringInfoUpdated = false;
 
+  // Modified when the imported data changes without adding importers, eg. at a new time value
+  vtkTimeStamp UpdateTime;
+
+  // Modified when the imported data changes without adding importers nor a new time value
+  vtkTimeStamp DataTime;
+
+  // The time value of the last update, valid until the update time is modified again
+  std::optional<double> TimeValue;
+  vtkMTimeType TimeValueMTime = 0;
+
+  // Aggregated statistics of the actors, computed again when outdated by the update time
+  vtkTimeStamp CountsTime;
+  vtkIdType NumberOfPoints = 0;
+  vtkIdType NumberOfCells = 0;
+  vtkTimeStamp MemoryUsageTime;
+  vtkTypeInt64 CPUMemoryUsage = 0;
+  vtkTypeInt64 GPUMemoryUsage = 0;
+
   F3DColoringInfoHandler ColoringInfoHandler;
 
+  // Progress of each importer, only allocated when updating importers in parallel
+  std::unique_ptr<std::atomic<double>[]> ParallelProgress;
+
+  // Importers updated in parallel by the workers, see StartImportersInParallel
+  enum class ParallelStatus : unsigned char
+  {
+    PENDING,
+    UPDATED,
+    FAILED
+  };
+  std::unique_ptr<std::atomic<ParallelStatus>[]> ParallelStatuses;
+  std::vector<size_t> ParallelIndices;
+  std::atomic<size_t> ParallelNext = 0;
+  std::atomic<bool> ParallelAbort = false;
+  std::vector<std::future<void>> ParallelWorkers;
+
+  //----------------------------------------------------------------------------
+  /**
+   * Stop the workers from updating other importers and wait for them
+   */
+  void JoinParallelWorkers()
+  {
+    this->ParallelAbort = true;
+    for (std::future<void>& worker : this->ParallelWorkers)
+    {
+      worker.wait();
+    }
+    this->ParallelWorkers.clear();
+    this->ParallelIndices.clear();
+    this->ParallelStatuses.reset();
+    this->ParallelProgress.reset();
+  }
+
 #if VTK_VERSION_NUMBER < VTK_VERSION_CHECK(9, 3, 20240707)
   std::map<vtkImporter*, vtkSmartPointer<vtkActorCollection>> ActorsForImporterMap;
 #endif
 };
 
+namespace
+{
+//----------------------------------------------------------------------------
+std::string GetArrayName(vtkMapper* mapper)
+{
+  const char* name = mapper->GetArrayName();
+  return name ? name : "";
+}
+
+//----------------------------------------------------------------------------
+std::vector<vtkSmartPointer<vtkLight>> GetLights(vtkRenderer* renderer)
+{
+  std::vector<vtkSmartPointer<vtkLight>> lights;
+  vtkLightCollection* collection = renderer->GetLights();
+  vtkCollectionSimpleIterator lit;
+  collection->InitTraversal(lit);
+  while (auto* light = collection->GetNextLight(lit))
+  {
+    lights.emplace_back(light);
+  }
+  return lights;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * Remove the structs for which pred(index) is true, structs are not assignable
+ * so the kept ones are moved into a new vector
+ */
+template<typename T, typename Pred>
+void RemoveStructs(std::vector<T>& structs, Pred pred)
+{
+  std::vector<T> kept;
+  kept.reserve(structs.size());
+  for (size_t i = 0; i < structs.size(); i++)
+  {
+    if (!pred(i))
+    {
+      kept.emplace_back(std::move(structs[i]));
+    }
+  }
+  structs = std::move(kept);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * Return true if both actors are rendered the same way and can be part of the same batch
+ */
+bool CanBatchTogether(vtkActor* a, vtkActor* b)
+{
+  if (a->GetTexture() != b->GetTexture() || a->GetBackfaceProperty() || b->GetBackfaceProperty())
+  {
+    return false;
+  }
+
+  vtkMapper* mapperA = a->GetMapper();
+  vtkMapper* mapperB = b->GetMapper();
+  if (mapperA->GetScalarVisibility() != mapperB->GetScalarVisibility() ||
+    mapperA->GetColorMode() != mapperB->GetColorMode() ||
+    mapperA->GetScalarMode() != mapperB->GetScalarMode() ||
+    ::GetArrayName(mapperA) != ::GetArrayName(mapperB))
+  {
+    return false;
+  }
+
+  vtkProperty* propA = a->GetProperty();
+  vtkProperty* propB = b->GetProperty();
+  if (propA == propB)
+  {
+    return true;
+  }
+
+  double colorA[3], colorB[3];
+  propA->GetColor(colorA);
+  propB->GetColor(colorB);
+  double emissiveA[3], emissiveB[3];
+  propA->GetEmissiveFactor(emissiveA);
+  propB->GetEmissiveFactor(emissiveB);
+  double specularA[3], specularB[3];
+  propA->GetSpecularColor(specularA);
+  propB->GetSpecularColor(specularB);
+
+  return std::equal(colorA, colorA + 3, colorB) &&
+    std::equal(emissiveA, emissiveA + 3, emissiveB) &&
+    std::equal(specularA, specularA + 3, specularB) &&
+    propA->GetOpacity() == propB->GetOpacity() && propA->GetAmbient() == propB->GetAmbient() &&
+    propA->GetDiffuse() == propB->GetDiffuse() && propA->GetSpecular() == propB->GetSpecular() &&
+    propA->GetSpecularPower() == propB->GetSpecularPower() &&
+    propA->GetRoughness() == propB->GetRoughness() &&
+    propA->GetMetallic() == propB->GetMetallic() &&
+    propA->GetNormalScale() == propB->GetNormalScale() &&
+    propA->GetOcclusionStrength() == propB->GetOcclusionStrength() &&
+    propA->GetInterpolation() == propB->GetInterpolation() &&
+    propA->GetRepresentation() == propB->GetRepresentation() &&
+    propA->GetEdgeVisibility() == propB->GetEdgeVisibility() &&
+    propA->GetBackfaceCulling() == propB->GetBackfaceCulling() &&
+    propA->GetFrontfaceCulling() == propB->GetFrontfaceCulling() &&
+    propA->GetLighting() == propB->GetLighting() &&
+    propA->GetPointSize() == propB->GetPointSize() &&
+    propA->GetLineWidth() == propB->GetLineWidth() &&
+    propA->GetAllTextures() == propB->GetAllTextures();
+}
+
+//----------------------------------------------------------------------------
+/**
+ * Return the textures used by an actor, the color texture and the material textures
+ */
+std::vector<vtkTexture*> GetActorTextures(vtkActor* actor)
+{
+  std::vector<vtkTexture*> textures;
+  if (actor->GetTexture())
+  {
+    textures.emplace_back(actor->GetTexture());
+  }
+  for (const auto& [name, texture] : actor->GetProperty()->GetAllTextures())
+  {
+    textures.emplace_back(texture);
+  }
+  return textures;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * Estimate the size of the vertex and index buffers uploaded to render a surface, in bytes
+ */
+vtkTypeInt64 EstimateBuffersSize(vtkPolyData* surface)
+{
+  vtkPointData* pointData = surface->GetPointData();
+  vtkTypeInt64 pointSize = 3 * sizeof(float);
+  pointSize += pointData->GetNormals() ? 3 * sizeof(float) : 0;
+  pointSize += pointData->GetTCoords() ? 2 * sizeof(float) : 0;
+  pointSize += pointData->GetScalars() ? 4 : 0;
+
+  vtkTypeInt64 nbIndices = 0;
+  for (vtkCellArray* cells :
+    { surface->GetVerts(), surface->GetLines(), surface->GetPolys(), surface->GetStrips() })
+  {
+    nbIndices += cells->GetNumberOfConnectivityIds();
+  }
+  return pointSize * surface->GetNumberOfPoints() + nbIndices * sizeof(unsigned int);
+}
+}
+
 vtkStandardNewMacro(vtkF3DMetaImporter);
 
 //----------------------------------------------------------------------------
@@ -68,63 +335,877 @@ void vtkF3DMetaImporter::Clear()
   this->Pimpl->ColoringActorsAndMappers.clear();
   this->Pimpl->PointSpritesActorsAndMappers.clear();
   this->Pimpl->VolumePropsAndMappers.clear();
+  this->Pimpl->PointSpritesOriginalActors.clear();
+  this->Pimpl->VolumesOriginalActors.clear();
+  this->Pimpl->Surfaces.clear();
+  for (vtkF3DMetaImporter::LODStruct& lod : this->Pimpl->LODActorsAndMappers)
+  {
+    // Do not wait for proxies that are still being built
+    if (lod.Decimator)
+    {
+      lod.Decimator->AbortExecuteOn();
+    }
+  }
+  this->Pimpl->LODActorsAndMappers.clear();
+  this->Pimpl->StaticBatches.clear();
+  this->Pimpl->StaticActors.clear();
+  this->Pimpl->NumberOfBatchedActors = 0;
   this->Pimpl->ColoringInfoHandler.ClearColoringInfo();
   this->Modified();
 }
 
-//----------------------------------------------------------------------------
-void vtkF3DMetaImporter::AddImporter(const vtkSmartPointer<vtkImporter>& importer)
-{
-  this->Pimpl->Importers.emplace_back(vtkF3DMetaImporter::Internals::ImporterPair {importer, false});
-  this->Modified();
+//----------------------------------------------------------------------------
+void vtkF3DMetaImporter::AddImporter(const vtkSmartPointer<vtkImporter>& importer)
+{
+  this->Pimpl->Importers.emplace_back(
+    vtkF3DMetaImporter::Internals::ImporterPair{ importer, false, false });
+  this->Modified();
+  this->ObserveProgress(importer);
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DMetaImporter::ObserveProgress(vtkImporter* importer)
+{
+  vtkNew<vtkCallbackCommand> progressCallback;
+  progressCallback->SetClientData(this);
+  progressCallback->SetCallback(
+    [](vtkObject* const caller, unsigned long, void* clientData, void* callData)
+    {
+      vtkF3DMetaImporter* self = static_cast<vtkF3DMetaImporter*>(clientData);
+      double progress = *static_cast<double*>(callData);
+      if (self->Pimpl->ParallelProgress)
+      {
+        // Called from a worker thread, progress is forwarded by the calling thread
+        for (size_t i = 0; i < self->Pimpl->Importers.size(); i++)
+        {
+          if (self->Pimpl->Importers[i].Importer == caller)
+          {
+            self->Pimpl->ParallelProgress[i] = progress;
+          }
+        }
+        return;
+      }
+      double actualProgress = 0.0;
+      for (size_t i = 0; i < self->Pimpl->Importers.size(); i++)
+      {
+        if (self->Pimpl->Importers[i].Importer == caller)
+        {
+          // XXX: This does not consider that some importer may already have been updated
+          // or that some importers may take much longer than other.
+          actualProgress = (i + progress) / self->Pimpl->Importers.size();
+        }
+      }
+      self->InvokeEvent(vtkCommand::ProgressEvent, &actualProgress);
+    });
+  importer->AddObserver(vtkCommand::ProgressEvent, progressCallback);
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DMetaImporter::AddUpdatedImporter(const vtkSmartPointer<vtkImporter>& importer)
+{
+  this->Pimpl->Importers.emplace_back(
+    vtkF3DMetaImporter::Internals::ImporterPair{ importer, false, true });
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DMetaImporter::ReplaceImporter(
+  vtkImporter* previous, const vtkSmartPointer<vtkImporter>& importer)
+{
+  auto pairIt = std::find_if(this->Pimpl->Importers.begin(), this->Pimpl->Importers.end(),
+    [&](const auto& importerPair) { return importerPair.Importer == previous; });
+  if (pairIt == this->Pimpl->Importers.end())
+  {
+    return false;
+  }
+
+  this->RemoveImporterProps(std::distance(this->Pimpl->Importers.begin(), pairIt));
+
+  *pairIt = vtkF3DMetaImporter::Internals::ImporterPair{ importer, false, false };
+  this->Modified();
+  this->ObserveProgress(importer);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DMetaImporter::RemoveImporter(vtkImporter* importer)
+{
+  auto pairIt = std::find_if(this->Pimpl->Importers.begin(), this->Pimpl->Importers.end(),
+    [&](const auto& importerPair) { return importerPair.Importer == importer; });
+  if (pairIt == this->Pimpl->Importers.end())
+  {
+    return false;
+  }
+
+  this->RemoveImporterProps(std::distance(this->Pimpl->Importers.begin(), pairIt));
+  this->Pimpl->Importers.erase(pairIt);
+  this->Modified();
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DMetaImporter::RemoveImporterProps(size_t index)
+{
+  vtkF3DMetaImporter::Internals::ImporterPair& importerPair = this->Pimpl->Importers[index];
+  vtkImporter* previous = importerPair.Importer;
+  if (importerPair.Updated && this->Renderer)
+  {
+    std::vector<vtkActor*> removed = this->GetImporterActors(previous);
+    for (vtkActor* actor : removed)
+    {
+      this->Renderer->RemoveActor(actor);
+      this->ActorCollection->RemoveItem(actor);
+    }
+    auto isRemoved = [&](vtkActor* actor)
+    { return std::find(removed.begin(), removed.end(), actor) != removed.end(); };
+
+    for (vtkLight* light : importerPair.Lights)
+    {
+      this->Renderer->RemoveLight(light);
+    }
+
+    // Remove the structs created for the removed actors
+    auto& colorings = this->Pimpl->ColoringActorsAndMappers;
+    ::RemoveStructs(colorings,
+      [&](size_t i)
+      {
+        bool remove = isRemoved(colorings[i].OriginalActor);
+        if (remove && colorings[i].Actor)
+        {
+          this->Renderer->RemoveActor(colorings[i].Actor);
+        }
+        return remove;
+      });
+
+    auto& surfaces = this->Pimpl->Surfaces;
+    surfaces.erase(std::remove_if(surfaces.begin(), surfaces.end(),
+                     [&](const vtkF3DMetaImporter::Internals::SurfaceStruct& surfaceStruct)
+                     { return isRemoved(surfaceStruct.OriginalActor); }),
+      surfaces.end());
+
+    auto& pointSprites = this->Pimpl->PointSpritesActorsAndMappers;
+    auto& pointSpritesActors = this->Pimpl->PointSpritesOriginalActors;
+    ::RemoveStructs(pointSprites,
+      [&](size_t i)
+      {
+        bool remove = isRemoved(pointSpritesActors[i]);
+        if (remove)
+        {
+          this->Renderer->RemoveActor(pointSprites[i].Actor);
+        }
+        return remove;
+      });
+    pointSpritesActors.erase(
+      std::remove_if(pointSpritesActors.begin(), pointSpritesActors.end(), isRemoved),
+      pointSpritesActors.end());
+
+    auto& volumes = this->Pimpl->VolumePropsAndMappers;
+    auto& volumesActors = this->Pimpl->VolumesOriginalActors;
+    ::RemoveStructs(volumes,
+      [&](size_t i)
+      {
+        bool remove = isRemoved(volumesActors[i]);
+        if (remove)
+        {
+          this->Renderer->RemoveVolume(volumes[i].Prop);
+        }
+        return remove;
+      });
+    volumesActors.erase(std::remove_if(volumesActors.begin(), volumesActors.end(), isRemoved),
+      volumesActors.end());
+
+    auto& lods = this->Pimpl->LODActorsAndMappers;
+    ::RemoveStructs(lods,
+      [&](size_t i)
+      {
+        bool remove = isRemoved(lods[i].OriginalActor);
+        if (remove && lods[i].Decimator)
+        {
+          // Do not wait for proxies that are still being built
+          lods[i].Decimator->AbortExecuteOn();
+        }
+        return remove;
+      });
+
+    // Batches are built again from the remaining static actors
+    std::vector<vtkActor*>& staticActors = this->Pimpl->StaticActors;
+    staticActors.erase(
+      std::remove_if(staticActors.begin(), staticActors.end(), isRemoved), staticActors.end());
+    for (const vtkF3DMetaImporter::BatchStruct& batch : this->Pimpl->StaticBatches)
+    {
+      this->Renderer->RemoveActor(batch.Actor);
+    }
+    this->Pimpl->StaticBatches.clear();
+    this->Pimpl->NumberOfBatchedActors = 0;
+
+    // Bounding box of the remaining actors
+    this->Pimpl->GeometryBoundingBox.Reset();
+    vtkCollectionSimpleIterator ait;
+    this->ActorCollection->InitTraversal(ait);
+    while (auto* actor = this->ActorCollection->GetNextActor(ait))
+    {
+      vtkPolyDataMapper* pdMapper = vtkPolyDataMapper::SafeDownCast(actor->GetMapper());
+      this->Pimpl->GeometryBoundingBox.AddBounds(
+        pdMapper ? pdMapper->GetInput()->GetBounds() : actor->GetMapper()->GetBounds());
+    }
+
+    this->Pimpl->ColoringInfoHandler.ClearColoringInfo();
+  }
+
+#if VTK_VERSION_NUMBER < VTK_VERSION_CHECK(9, 3, 20240707)
+  this->Pimpl->ActorsForImporterMap.erase(previous);
+#endif
+  previous->RemoveObservers(vtkCommand::ProgressEvent);
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DMetaImporter::SetImporterDynamic(vtkImporter* importer)
+{
+  auto pairIt = std::find_if(this->Pimpl->Importers.begin(), this->Pimpl->Importers.end(),
+    [&](const auto& importerPair) { return importerPair.Importer == importer; });
+  if (pairIt == this->Pimpl->Importers.end() || !pairIt->Updated || !this->Renderer)
+  {
+    return false;
+  }
+
+  std::vector<vtkActor*> dynamicActors = this->GetImporterActors(importer);
+  auto isDynamic = [&](vtkActor* actor)
+  { return std::find(dynamicActors.begin(), dynamicActors.end(), actor) != dynamicActors.end(); };
+
+  auto& lods = this->Pimpl->LODActorsAndMappers;
+  ::RemoveStructs(lods,
+    [&](size_t i)
+    {
+      bool remove = isDynamic(lods[i].OriginalActor);
+      if (remove && lods[i].Decimator)
+      {
+        // Do not wait for proxies that are still being built
+        lods[i].Decimator->AbortExecuteOn();
+      }
+      return remove;
+    });
+
+  std::vector<vtkActor*>& staticActors = this->Pimpl->StaticActors;
+  auto staticEnd = std::remove_if(staticActors.begin(), staticActors.end(), isDynamic);
+  if (staticEnd != staticActors.end())
+  {
+    // Batches are built again from the remaining static actors
+    staticActors.erase(staticEnd, staticActors.end());
+    for (const vtkF3DMetaImporter::BatchStruct& batch : this->Pimpl->StaticBatches)
+    {
+      this->Renderer->RemoveActor(batch.Actor);
+    }
+    this->Pimpl->StaticBatches.clear();
+    this->Pimpl->NumberOfBatchedActors = 0;
+  }
+  this->Modified();
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DMetaImporter::SetImporterSnapshot(vtkImporter* importer, const std::string& fileName)
+{
+  auto pairIt = std::find_if(this->Pimpl->Importers.begin(), this->Pimpl->Importers.end(),
+    [&](const auto& importerPair) { return importerPair.Importer == importer; });
+  if (pairIt == this->Pimpl->Importers.end())
+  {
+    return false;
+  }
+
+  pairIt->SnapshotFileName = fileName;
+  if (pairIt->Updated)
+  {
+    this->WriteImporterSnapshot(std::distance(this->Pimpl->Importers.begin(), pairIt));
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DMetaImporter::WriteImporterSnapshot(size_t index)
+{
+  auto& importerPair = this->Pimpl->Importers[index];
+  std::string fileName = std::move(importerPair.SnapshotFileName);
+  importerPair.SnapshotFileName.clear();
+  vtkImporter* importer = importerPair.Importer;
+  if (fileName.empty())
+  {
+    return;
+  }
+
+  // Only the actors are stored, the generic importers volumes and refined surfaces are not
+  vtkF3DGenericImporter* genericImporter = vtkF3DGenericImporter::SafeDownCast(importer);
+  if (importer->GetNumberOfAnimations() > 0 || importer->GetNumberOfCameras() > 0 ||
+    !importerPair.Lights.empty() ||
+    (genericImporter && (genericImporter->GetImportedImage() || genericImporter->HasTessellator())))
+  {
+    F3DLog::Print(F3DLog::Severity::Debug,
+      std::string("No snapshot is written for the ") + importer->GetClassName() +
+        " with animations, cameras, lights or volumes");
+    return;
+  }
+
+  F3D_TRACE_SCOPE("vtkF3DSnapshotImporter::Write");
+  if (vtkF3DSnapshotImporter::Write(this->GetImporterActors(importer), fileName))
+  {
+    F3DLog::Print(F3DLog::Severity::Debug, "Snapshot written to " + fileName);
+  }
+  else
+  {
+    F3DLog::Print(F3DLog::Severity::Debug,
+      std::string("Cannot write a snapshot of the ") + importer->GetClassName() + " actors");
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DMetaImporter::WriteGLB(const std::string& fileName)
+{
+  std::vector<vtkActor*> actors;
+  for (const auto& importerPair : this->Pimpl->Importers)
+  {
+    if (importerPair.Updated)
+    {
+      std::vector<vtkActor*> importerActors = this->GetImporterActors(importerPair.Importer);
+      actors.insert(actors.end(), importerActors.begin(), importerActors.end());
+    }
+  }
+
+  F3D_TRACE_SCOPE("vtkF3DGLBWriter::Write");
+  return vtkF3DGLBWriter::Write(actors, fileName);
+}
+
+//----------------------------------------------------------------------------
+std::vector<vtkActor*> vtkF3DMetaImporter::GetImporterActors(vtkImporter* importer)
+{
+#if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240707)
+  vtkActorCollection* actorCollection = importer->GetImportedActors();
+#else
+  auto it = this->Pimpl->ActorsForImporterMap.find(importer);
+  vtkActorCollection* actorCollection =
+    it != this->Pimpl->ActorsForImporterMap.end() ? it->second.Get() : nullptr;
+#endif
+  std::vector<vtkActor*> actors;
+  if (actorCollection)
+  {
+    vtkCollectionSimpleIterator ait;
+    actorCollection->InitTraversal(ait);
+    while (auto* actor = actorCollection->GetNextActor(ait))
+    {
+      actors.emplace_back(actor);
+    }
+  }
+  return actors;
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DMetaImporter::MoveUpdatedImporterProps(vtkImporter* importer,
+  std::vector<vtkSmartPointer<vtkLight>>& movedLights, vtkIdType localCameraIndex)
+{
+  vtkRenderer* importerRenderer = importer->GetRenderer();
+  if (!importerRenderer || importerRenderer == this->Renderer)
+  {
+    return;
+  }
+
+#if VTK_VERSION_NUMBER < VTK_VERSION_CHECK(9, 3, 20240707)
+  // All actors of the importer renderer have been imported by this importer
+  vtkSmartPointer<vtkActorCollection> actorCollection =
+    vtkSmartPointer<vtkActorCollection>::New();
+  vtkActorCollection* importedActors = importerRenderer->GetActors();
+  vtkCollectionSimpleIterator ait;
+  importedActors->InitTraversal(ait);
+  while (auto* actor = importedActors->GetNextActor(ait))
+  {
+    actorCollection->AddItem(actor);
+  }
+  this->Pimpl->ActorsForImporterMap[importer] = actorCollection;
+#endif
+
+  vtkPropCollection* props = importerRenderer->GetViewProps();
+  vtkCollectionSimpleIterator pit;
+  props->InitTraversal(pit);
+  while (auto* prop = props->GetNextProp(pit))
+  {
+    this->Renderer->AddViewProp(prop);
+  }
+
+  vtkLightCollection* lights = importerRenderer->GetLights();
+  vtkCollectionSimpleIterator lit;
+  lights->InitTraversal(lit);
+  while (auto* light = lights->GetNextLight(lit))
+  {
+    this->Renderer->AddLight(light);
+    movedLights.emplace_back(light);
+  }
+
+  if (localCameraIndex >= 0 && localCameraIndex < importer->GetNumberOfCameras())
+  {
+    this->Renderer->GetActiveCamera()->DeepCopy(importerRenderer->GetActiveCamera());
+  }
+
+  importerRenderer->RemoveAllViewProps();
+  importerRenderer->RemoveAllLights();
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DMetaImporter::StartImportersInParallel()
+{
+  std::vector<size_t> pendingIndices;
+  for (size_t i = 0; i < this->Pimpl->Importers.size(); i++)
+  {
+    const auto& importerPair = this->Pimpl->Importers[i];
+    if (!importerPair.Updated && !importerPair.UpdatedElsewhere)
+    {
+      pendingIndices.emplace_back(i);
+    }
+  }
+
+  if (pendingIndices.size() < 2)
+  {
+    return;
+  }
+
+  // Each importer is updated into its own render window so that no renderer is shared between
+  // threads, props will be moved into the actual renderer afterwards
+  for (size_t index : pendingIndices)
+  {
+    vtkNew<vtkF3DNoRenderWindow> renWin;
+    vtkNew<vtkRenderer> renderer;
+    renWin->AddRenderer(renderer);
+    this->Pimpl->Importers[index].Importer->SetRenderWindow(renWin);
+  }
+
+  using ParallelStatus = vtkF3DMetaImporter::Internals::ParallelStatus;
+  const size_t nbImporters = this->Pimpl->Importers.size();
+  this->Pimpl->ParallelProgress = std::make_unique<std::atomic<double>[]>(nbImporters);
+  this->Pimpl->ParallelStatuses = std::make_unique<std::atomic<ParallelStatus>[]>(nbImporters);
+  for (size_t i = 0; i < nbImporters; i++)
+  {
+    // Already updated importers are considered finished
+    this->Pimpl->ParallelProgress[i] = 1.0;
+    this->Pimpl->ParallelStatuses[i] = ParallelStatus::UPDATED;
+  }
+  for (size_t index : pendingIndices)
+  {
+    this->Pimpl->ParallelProgress[index] = 0.0;
+    this->Pimpl->ParallelStatuses[index] = ParallelStatus::PENDING;
+  }
+
+  // Importers are picked in order so that the first ones can be shown as soon as possible
+  this->Pimpl->ParallelIndices = pendingIndices;
+  this->Pimpl->ParallelNext = 0;
+  this->Pimpl->ParallelAbort = false;
+  auto worker = [this]()
+  {
+    std::vector<size_t>& indices = this->Pimpl->ParallelIndices;
+    for (size_t k = this->Pimpl->ParallelNext++; k < indices.size() && !this->Pimpl->ParallelAbort;
+         k = this->Pimpl->ParallelNext++)
+    {
+      vtkImporter* importer = this->Pimpl->Importers[indices[k]].Importer;
+      F3D_TRACE_SCOPE(importer->GetClassName());
+      bool status = true;
+#if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240707)
+      status = importer->Update();
+#else
+      importer->Update();
+#endif
+      this->Pimpl->ParallelProgress[indices[k]] = 1.0;
+      this->Pimpl->ParallelStatuses[indices[k]] =
+        status ? ParallelStatus::UPDATED : ParallelStatus::FAILED;
+    }
+  };
+
+  size_t nbThreads = std::min<size_t>(
+    std::max(std::thread::hardware_concurrency(), 1u), pendingIndices.size());
+  for (size_t t = 0; t < nbThreads; t++)
+  {
+    this->Pimpl->ParallelWorkers.emplace_back(std::async(std::launch::async, worker));
+  }
+
+  for (size_t index : pendingIndices)
+  {
+    this->Pimpl->Importers[index].UpdatedElsewhere = true;
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DMetaImporter::WaitForParallelImporter(size_t index)
+{
+  using ParallelStatus = vtkF3DMetaImporter::Internals::ParallelStatus;
+  if (!this->Pimpl->ParallelStatuses)
+  {
+    return true;
+  }
+
+  // Forward progress from the calling thread while waiting for workers
+  const size_t nbImporters = this->Pimpl->Importers.size();
+  while (this->Pimpl->ParallelStatuses[index] == ParallelStatus::PENDING)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    double progress = 0.0;
+    for (size_t i = 0; i < nbImporters; i++)
+    {
+      progress += this->Pimpl->ParallelProgress[i];
+    }
+    progress /= nbImporters;
+    this->InvokeEvent(vtkCommand::ProgressEvent, &progress);
+  }
+  return this->Pimpl->ParallelStatuses[index] == ParallelStatus::UPDATED;
+}
+
+//----------------------------------------------------------------------------
+const vtkBoundingBox& vtkF3DMetaImporter::GetGeometryBoundingBox()
+{
+  return this->Pimpl->GeometryBoundingBox;
+}
+
+//----------------------------------------------------------------------------
+const std::vector<vtkF3DMetaImporter::ColoringStruct>&
+vtkF3DMetaImporter::GetColoringActorsAndMappers()
+{
+  return this->Pimpl->ColoringActorsAndMappers;
+}
+
+//----------------------------------------------------------------------------
+const std::vector<vtkF3DMetaImporter::PointSpritesStruct>&
+vtkF3DMetaImporter::GetPointSpritesActorsAndMappers()
+{
+  return this->Pimpl->PointSpritesActorsAndMappers;
+}
+
+//----------------------------------------------------------------------------
+const std::vector<vtkF3DMetaImporter::VolumeStruct>& vtkF3DMetaImporter::GetVolumePropsAndMappers()
+{
+  return this->Pimpl->VolumePropsAndMappers;
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DMetaImporter::CreateColoringActors()
+{
+  bool created = false;
+  auto& colorings = this->Pimpl->ColoringActorsAndMappers;
+  for (size_t i = 0; i < colorings.size() && this->Renderer; i++)
+  {
+    vtkF3DMetaImporter::ColoringStruct& cs = colorings[i];
+    if (cs.Actor)
+    {
+      continue;
+    }
+    assert(this->Pimpl->Surfaces[i].OriginalActor == cs.OriginalActor);
+
+    cs.Actor = vtkSmartPointer<vtkActor>::New();
+    cs.Mapper = vtkSmartPointer<vtkPolyDataMapper>::New();
+    cs.Actor->GetProperty()->SetPointSize(10.0);
+    cs.Actor->GetProperty()->SetLineWidth(1.0);
+    cs.Actor->GetProperty()->SetRoughness(0.3);
+    cs.Actor->GetProperty()->SetInterpolationToPBR();
+    cs.Actor->SetMapper(cs.Mapper);
+    cs.Mapper->InterpolateScalarsBeforeMappingOn();
+    cs.Mapper->SetInputData(this->Pimpl->Surfaces[i].Surface);
+    this->Renderer->AddActor(cs.Actor);
+    cs.Actor->VisibilityOff();
+    created = true;
+  }
+  return created;
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DMetaImporter::CreatePointSprites()
+{
+  bool created = false;
+  for (vtkF3DMetaImporter::Internals::SurfaceStruct& surfaceStruct : this->Pimpl->Surfaces)
+  {
+    if (surfaceStruct.PointSpritesCreated || !this->Renderer)
+    {
+      continue;
+    }
+
+    this->Pimpl->PointSpritesActorsAndMappers.emplace_back(
+      vtkF3DMetaImporter::PointSpritesStruct());
+    this->Pimpl->PointSpritesOriginalActors.emplace_back(surfaceStruct.OriginalActor);
+    vtkF3DMetaImporter::PointSpritesStruct& pss = this->Pimpl->PointSpritesActorsAndMappers.back();
+    pss.Mapper->SetInputData(surfaceStruct.Points);
+    this->Renderer->AddActor(pss.Actor);
+    pss.Actor->VisibilityOff();
+    surfaceStruct.PointSpritesCreated = true;
+    created = true;
+  }
+  return created;
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DMetaImporter::CreateVolumes()
+{
+  bool created = false;
+  for (vtkF3DMetaImporter::Internals::SurfaceStruct& surfaceStruct : this->Pimpl->Surfaces)
+  {
+    if (!surfaceStruct.Image || surfaceStruct.VolumeCreated || !this->Renderer)
+    {
+      continue;
+    }
+
+    // XXX: Note that creating this struct takes some time
+    this->Pimpl->VolumePropsAndMappers.emplace_back(vtkF3DMetaImporter::VolumeStruct());
+    this->Pimpl->VolumesOriginalActors.emplace_back(surfaceStruct.OriginalActor);
+    vtkF3DMetaImporter::VolumeStruct& vs = this->Pimpl->VolumePropsAndMappers.back();
+    vs.Mapper->SetInputData(surfaceStruct.Image);
+    vs.Quantizer->SetInputData(surfaceStruct.Image);
+    this->Renderer->AddVolume(vs.Prop);
+    vs.Prop->VisibilityOff();
+    surfaceStruct.VolumeCreated = true;
+    created = true;
+  }
+  return created;
+}
+
+//----------------------------------------------------------------------------
+std::vector<vtkF3DMetaImporter::LODStruct>& vtkF3DMetaImporter::GetLODActorsAndMappers()
+{
+  return this->Pimpl->LODActorsAndMappers;
+}
+
+//----------------------------------------------------------------------------
+const std::vector<vtkF3DMetaImporter::BatchStruct>& vtkF3DMetaImporter::GetStaticBatches()
+{
+  return this->Pimpl->StaticBatches;
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DMetaImporter::BuildStaticBatches()
+{
+  if (this->Pimpl->NumberOfBatchedActors == this->Pimpl->StaticActors.size())
+  {
+    // Already built
+    return;
+  }
+
+  for (const vtkF3DMetaImporter::BatchStruct& batch : this->Pimpl->StaticBatches)
+  {
+    this->Renderer->RemoveActor(batch.Actor);
+  }
+  this->Pimpl->StaticBatches.clear();
+  this->Pimpl->NumberOfBatchedActors = this->Pimpl->StaticActors.size();
+
+  // Group the actors, the number of different materials is expected to be small
+  std::vector<std::vector<vtkActor*>> groups;
+  for (vtkActor* actor : this->Pimpl->StaticActors)
+  {
+    auto it = std::find_if(groups.begin(), groups.end(),
+      [&](const std::vector<vtkActor*>& group) { return ::CanBatchTogether(group[0], actor); });
+    if (it == groups.end())
+    {
+      groups.emplace_back(1, actor);
+    }
+    else
+    {
+      it->emplace_back(actor);
+    }
+  }
+
+  for (const std::vector<vtkActor*>& group : groups)
+  {
+    if (group.size() < 2)
+    {
+      continue;
+    }
+
+    vtkNew<vtkAppendPolyData> append;
+    for (size_t i = 0; i < group.size(); i++)
+    {
+      vtkActor* actor = group[i];
+      vtkPolyData* surface = vtkPolyDataMapper::SafeDownCast(actor->GetMapper())->GetInput();
+
+      vtkSmartPointer<vtkPolyData> batchedSurface = vtkSmartPointer<vtkPolyData>::New();
+      vtkMatrix4x4* matrix = actor->GetMatrix();
+      if (matrix->IsIdentity())
+      {
+        batchedSurface->ShallowCopy(surface);
+      }
+      else
+      {
+        vtkNew<vtkTransform> transform;
+        transform->SetMatrix(matrix);
+        vtkNew<vtkTransformPolyDataFilter> transformFilter;
+        transformFilter->SetInputData(surface);
+        transformFilter->SetTransform(transform);
+        transformFilter->Update();
+        batchedSurface->ShallowCopy(transformFilter->GetOutput());
+      }
+
+      vtkNew<vtkIdTypeArray> ids;
+      ids->SetName("BatchedActorId");
+      ids->SetNumberOfTuples(batchedSurface->GetNumberOfCells());
+      ids->FillValue(static_cast<vtkIdType>(i));
+      batchedSurface->GetCellData()->AddArray(ids);
+
+      append->AddInputData(batchedSurface);
+    }
+    append->Update();
+
+    this->Pimpl->StaticBatches.emplace_back(vtkF3DMetaImporter::BatchStruct());
+    vtkF3DMetaImporter::BatchStruct& batch = this->Pimpl->StaticBatches.back();
+    batch.OriginalActors = group;
+
+    // Share the property so the renderer configuration of the original actors applies
+    vtkActor* first = group[0];
+    batch.Actor->SetProperty(first->GetProperty());
+    batch.Actor->SetTexture(first->GetTexture());
+    batch.Mapper->ShallowCopy(first->GetMapper());
+    batch.Mapper->SetInputData(append->GetOutput());
+
+    this->Renderer->AddActor(batch.Actor);
+    batch.Actor->VisibilityOff();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DMetaImporter::BuildLODProxies()
+{
+  for (vtkF3DMetaImporter::LODStruct& lod : this->Pimpl->LODActorsAndMappers)
+  {
+    if (lod.Proxy.valid() || lod.ProxyReady)
+    {
+      continue;
+    }
+
+    // Bounds are computed here so the surface is only read by the worker thread
+    double bounds[6];
+    lod.Surface->GetBounds(bounds);
+
+    // Quadric clustering is linear in the number of cells and its memory is bounded
+    // by the number of divisions, which also bounds the size of the proxy
+    lod.Decimator = vtkSmartPointer<vtkQuadricClustering>::New();
+    vtkQuadricClustering* decimator = lod.Decimator;
+    decimator->SetInputData(lod.Surface);
+    decimator->SetNumberOfDivisions(128, 128, 128);
+    decimator->AutoAdjustNumberOfDivisionsOn();
+    lod.Proxy = std::async(std::launch::async, [decimator]() { decimator->Update(); });
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DMetaImporter::SetTriangleBudget(vtkIdType budget)
+{
+  this->Pimpl->TriangleBudget = budget;
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DMetaImporter::SimplifySurfaces(vtkImporter* importer, vtkActorCollection* actors)
+{
+  const vtkIdType budget = this->Pimpl->TriangleBudget;
+  vtkF3DGenericImporter* genericImporter = vtkF3DGenericImporter::SafeDownCast(importer);
+  if (budget <= 0 || importer->GetNumberOfAnimations() > 0 ||
+    (genericImporter && genericImporter->HasTessellator()))
+  {
+    return;
+  }
+
+  // Each surface is counted once even when shared by several actors
+  std::map<vtkPolyData*, std::vector<vtkPolyDataMapper*>> surfaces;
+  vtkIdType nbTriangles = 0;
+  vtkCollectionSimpleIterator ait;
+  actors->InitTraversal(ait);
+  while (auto* actor = actors->GetNextActor(ait))
+  {
+    vtkPolyDataMapper* pdMapper = vtkPolyDataMapper::SafeDownCast(actor->GetMapper());
+    vtkPolyData* surface = pdMapper ? pdMapper->GetInput() : nullptr;
+    if (surface)
+    {
+      std::vector<vtkPolyDataMapper*>& mappers = surfaces[surface];
+      nbTriangles += mappers.empty() ? surface->GetNumberOfPolys() : 0;
+      mappers.emplace_back(pdMapper);
+    }
+  }
+  if (nbTriangles <= budget)
+  {
+    return;
+  }
+
+  // The budget is shared between the surfaces of the importer in proportion to their triangles
+  F3D_TRACE_SCOPE("SimplifySurfaces");
+  const double ratio = static_cast<double>(budget) / static_cast<double>(nbTriangles);
+  vtkIdType nbSimplified = 0;
+  for (const auto& [surface, mappers] : surfaces)
+  {
+    vtkNew<vtkF3DSimplifyFilter> simplifier;
+    simplifier->SetTargetNumberOfTriangles(std::max<vtkIdType>(
+      1, static_cast<vtkIdType>(ratio * static_cast<double>(surface->GetNumberOfPolys()))));
+
+    // A surface produced by a pipeline, eg. by a generic importer, keeps being simplified
+    // when the pipeline is updated, other surfaces are replaced to release their memory
+    vtkAlgorithm* producer = mappers[0]->GetInputAlgorithm();
+    const bool pipeline = producer && !vtkTrivialProducer::SafeDownCast(producer);
+    if (pipeline)
+    {
+      simplifier->SetInputConnection(mappers[0]->GetInputConnection(0, 0));
+    }
+    else
+    {
+      simplifier->SetInputData(surface);
+    }
+    simplifier->Update();
+    vtkIdType nbSurfaceTriangles = simplifier->GetOutput()->GetNumberOfPolys();
 
-  // Add a progress event observer
-  vtkNew<vtkCallbackCommand> progressCallback;
-  progressCallback->SetClientData(this);
-  progressCallback->SetCallback(
-    [](vtkObject* const caller, unsigned long, void* clientData, void* callData)
+    for (vtkPolyDataMapper* pdMapper : mappers)
     {
-      vtkF3DMetaImporter* self = static_cast<vtkF3DMetaImporter*>(clientData);
-      double progress = *static_cast<double*>(callData);
-      double actualProgress = 0.0;
-      for (size_t i = 0; i < self->Pimpl->Importers.size(); i++)
+      if (pipeline)
       {
-        if (self->Pimpl->Importers[i].Importer == caller)
-        {
-          // XXX: This does not consider that some importer may already have been updated
-          // or that some importers may take much longer than other.
-          actualProgress = (i + progress) / self->Pimpl->Importers.size();
-        }
+        pdMapper->SetInputConnection(simplifier->GetOutputPort());
       }
-      self->InvokeEvent(vtkCommand::ProgressEvent, &actualProgress);
-    });
-  importer->AddObserver(vtkCommand::ProgressEvent, progressCallback);
-}
+      else
+      {
+        pdMapper->SetInputData(simplifier->GetOutput());
+      }
+    }
+    nbSimplified += nbSurfaceTriangles;
+  }
 
-//----------------------------------------------------------------------------
-const vtkBoundingBox& vtkF3DMetaImporter::GetGeometryBoundingBox()
-{
-  return this->Pimpl->GeometryBoundingBox;
+  F3DLog::Print(F3DLog::Severity::Debug,
+    "Simplified " + std::to_string(nbTriangles) + " triangles to " +
+      std::to_string(nbSimplified) + " triangles");
 }
 
 //----------------------------------------------------------------------------
-const std::vector<vtkF3DMetaImporter::ColoringStruct>&
-vtkF3DMetaImporter::GetColoringActorsAndMappers()
+bool vtkF3DMetaImporter::UpdateTessellations(bool wait)
 {
-  return this->Pimpl->ColoringActorsAndMappers;
+  bool swapped = false;
+  for (const vtkF3DMetaImporter::Internals::ImporterPair& importerPair : this->Pimpl->Importers)
+  {
+    vtkF3DGenericImporter* genericImporter =
+      vtkF3DGenericImporter::SafeDownCast(importerPair.Importer);
+    if (importerPair.Updated && genericImporter)
+    {
+      swapped = genericImporter->UpdateTessellation(this->Renderer, wait) || swapped;
+    }
+  }
+  return swapped;
 }
 
 //----------------------------------------------------------------------------
-const std::vector<vtkF3DMetaImporter::PointSpritesStruct>&
-vtkF3DMetaImporter::GetPointSpritesActorsAndMappers()
+bool vtkF3DMetaImporter::IsTessellationRefined()
 {
-  return this->Pimpl->PointSpritesActorsAndMappers;
+  return std::any_of(this->Pimpl->Importers.begin(), this->Pimpl->Importers.end(),
+    [](const vtkF3DMetaImporter::Internals::ImporterPair& importerPair)
+    {
+      vtkF3DGenericImporter* genericImporter =
+        vtkF3DGenericImporter::SafeDownCast(importerPair.Importer);
+      return importerPair.Updated && genericImporter && genericImporter->IsTessellationRefined();
+    });
 }
 
 //----------------------------------------------------------------------------
-const std::vector<vtkF3DMetaImporter::VolumeStruct>& vtkF3DMetaImporter::GetVolumePropsAndMappers()
+bool vtkF3DMetaImporter::UpdateStreamedVolumes()
 {
-  return this->Pimpl->VolumePropsAndMappers;
+  bool changed = false;
+  for (const vtkF3DMetaImporter::Internals::ImporterPair& importerPair : this->Pimpl->Importers)
+  {
+    vtkF3DGenericImporter* genericImporter =
+      vtkF3DGenericImporter::SafeDownCast(importerPair.Importer);
+    if (importerPair.Updated && genericImporter)
+    {
+      changed = genericImporter->UpdateStreamedVolume(this->Renderer) || changed;
+    }
+  }
+  return changed;
 }
 
 //----------------------------------------------------------------------------
@@ -139,6 +1220,10 @@ bool vtkF3DMetaImporter::Update()
   // This is the simplest way to implement coloring
   // and should not have too big of an overhead.
   this->Pimpl->ColoringInfoUpdated = false;
+  for (auto& importerPair : this->Pimpl->Importers)
+  {
+    importerPair.ColoringInfoOutdated = true;
+  }
 
   vtkIdType localCameraIndex = -1;
 
@@ -153,8 +1238,17 @@ bool vtkF3DMetaImporter::Update()
     localCameraIndex = this->Pimpl->CameraIndex.value();
   }
 
-  for (auto& importerPair : this->Pimpl->Importers)
+  // Without camera index, importers are independent until their actors are added to the
+  // renderer, so read them in parallel then attach their props serially below, in order,
+  // as soon as each one is read
+  if (!this->Pimpl->CameraIndex.has_value())
+  {
+    this->StartImportersInParallel();
+  }
+
+  for (size_t index = 0; index < this->Pimpl->Importers.size(); index++)
   {
+    auto& importerPair = this->Pimpl->Importers[index];
     vtkImporter* importer = importerPair.Importer;
 
     // Importer has already been updated
@@ -164,67 +1258,96 @@ bool vtkF3DMetaImporter::Update()
       continue;
     }
 
-    importer->SetRenderWindow(this->RenderWindow);
-
-    // This is required to avoid updating two times
-    // but may cause a warning in VTK
-    if (localCameraIndex >= 0)
+    if (importerPair.UpdatedElsewhere)
     {
-      importer->SetCamera(localCameraIndex);
+      if (!this->WaitForParallelImporter(index))
+      {
+        this->Pimpl->JoinParallelWorkers();
+        return false;
+      }
+      this->MoveUpdatedImporterProps(importer, importerPair.Lights, localCameraIndex);
     }
+    else
+    {
+      importer->SetRenderWindow(this->RenderWindow);
+
+      // This is required to avoid updating two times
+      // but may cause a warning in VTK
+      if (localCameraIndex >= 0)
+      {
+        importer->SetCamera(localCameraIndex);
+      }
 
+      std::vector<vtkSmartPointer<vtkLight>> previousLights = ::GetLights(this->Renderer);
+
+      F3D_TRACE_SCOPE(importer->GetClassName());
 #if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240707)
-    if (!importer->Update())
-    {
-      return false;
-    }
+      if (!importer->Update())
+      {
+        this->Pimpl->JoinParallelWorkers();
+        return false;
+      }
 #else
-    vtkSmartPointer<vtkActorCollection> actorCollection =
-      vtkSmartPointer<vtkActorCollection>::New();
+      vtkSmartPointer<vtkActorCollection> actorCollection =
+        vtkSmartPointer<vtkActorCollection>::New();
 
-    vtkNew<vtkActorCollection> previousActorCollection;
-    vtkActorCollection* currentCollection = this->Renderer->GetActors();
-    vtkCollectionSimpleIterator tmpIt;
-    currentCollection->InitTraversal(tmpIt);
-    while (auto* actor = currentCollection->GetNextActor(tmpIt))
-    {
-      previousActorCollection->AddItem(actor);
-    }
+      vtkNew<vtkActorCollection> previousActorCollection;
+      vtkActorCollection* currentCollection = this->Renderer->GetActors();
+      vtkCollectionSimpleIterator tmpIt;
+      currentCollection->InitTraversal(tmpIt);
+      while (auto* actor = currentCollection->GetNextActor(tmpIt))
+      {
+        previousActorCollection->AddItem(actor);
+      }
 
-    importer->Update();
+      importer->Update();
 
-    currentCollection = this->Renderer->GetActors();
-    currentCollection->InitTraversal(tmpIt);
+      currentCollection = this->Renderer->GetActors();
+      currentCollection->InitTraversal(tmpIt);
 
-    vtkCollectionSimpleIterator tmpIt2;
-    previousActorCollection->InitTraversal(tmpIt2);
-    while (auto* actor = currentCollection->GetNextActor(tmpIt))
-    {
-      bool found = false;
-      while (auto* previousActor = previousActorCollection->GetNextActor(tmpIt2))
+      vtkCollectionSimpleIterator tmpIt2;
+      previousActorCollection->InitTraversal(tmpIt2);
+      while (auto* actor = currentCollection->GetNextActor(tmpIt))
       {
-        // This is a N^2 loop
-        if (previousActor == actor)
+        bool found = false;
+        while (auto* previousActor = previousActorCollection->GetNextActor(tmpIt2))
+        {
+          // This is a N^2 loop
+          if (previousActor == actor)
+          {
+            found = true;
+            break;
+          }
+        }
+        if (!found)
         {
-          found = true;
-          break;
+          actorCollection->AddItem(actor);
         }
       }
-      if (!found)
+
+      // Store the actor collection for further use
+      this->Pimpl->ActorsForImporterMap[importer] = actorCollection;
+#endif
+
+      // Keep track of the added lights so they can be removed with the importer
+      for (const vtkSmartPointer<vtkLight>& light : ::GetLights(this->Renderer))
       {
-        actorCollection->AddItem(actor);
+        if (std::find(previousLights.begin(), previousLights.end(), light) == previousLights.end())
+        {
+          importerPair.Lights.emplace_back(light);
+        }
       }
     }
 
-    // Store the actor collection for further use
-    this->Pimpl->ActorsForImporterMap[importer] = actorCollection;
-#endif
-
     localCameraIndex -= importer->GetNumberOfCameras();
 
 #if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240707)
     vtkActorCollection* actorCollection = importer->GetImportedActors();
+#else
+    vtkActorCollection* actorCollection = this->Pimpl->ActorsForImporterMap[importer];
 #endif
+    this->SimplifySurfaces(importer, actorCollection);
+
     vtkCollectionSimpleIterator ait;
     actorCollection->InitTraversal(ait);
     while (auto* actor = actorCollection->GetNextActor(ait))
@@ -233,6 +1356,12 @@ bool vtkF3DMetaImporter::Update()
       this->ActorCollection->AddItem(actor);
 
       vtkPolyDataMapper* pdMapper = vtkPolyDataMapper::SafeDownCast(actor->GetMapper());
+      if (!pdMapper)
+      {
+        // Instanced actors, using a vtkGlyph3DMapper, do not support coloring nor point sprites
+        this->Pimpl->GeometryBoundingBox.AddBounds(actor->GetMapper()->GetBounds());
+        continue;
+      }
       vtkPolyData* surface = pdMapper->GetInput();
 
       // Increase bounding box size if needed
@@ -243,48 +1372,58 @@ bool vtkF3DMetaImporter::Update()
       // Recover generic importer if any
       vtkF3DGenericImporter* genericImporter = vtkF3DGenericImporter::SafeDownCast(importer);
 
-      // Create and configure coloring actors
-      this->Pimpl->ColoringActorsAndMappers.emplace_back(vtkF3DMetaImporter::ColoringStruct(actor));
-      vtkF3DMetaImporter::ColoringStruct& cs = this->Pimpl->ColoringActorsAndMappers.back();
-      cs.Mapper->SetInputData(surface);
-      this->Renderer->AddActor(cs.Actor);
-      cs.Actor->VisibilityOff();
-
-      // Create and configure point sprites actors
-      this->Pimpl->PointSpritesActorsAndMappers.emplace_back(
-        vtkF3DMetaImporter::PointSpritesStruct());
-      vtkF3DMetaImporter::PointSpritesStruct& pss =
-        this->Pimpl->PointSpritesActorsAndMappers.back();
-
-      vtkPolyData* points = surface;
-      if (genericImporter)
+      // Dense surfaces of static importers can be replaced by a proxy while interacting,
+      // see BuildLODProxies
+      constexpr vtkIdType lodMinimumCells = 500000;
+      if (importer->GetNumberOfAnimations() == 0 && surface->GetNumberOfCells() >= lodMinimumCells)
+      {
+        this->Pimpl->LODActorsAndMappers.emplace_back(vtkF3DMetaImporter::LODStruct(actor));
+        vtkF3DMetaImporter::LODStruct& lod = this->Pimpl->LODActorsAndMappers.back();
+        vtkNew<vtkPolyData> lodSurface;
+        lodSurface->ShallowCopy(surface);
+        lod.Surface = lodSurface;
+      }
+
+      // Small surfaces of static importers can be batched together, see BuildStaticBatches,
+      // except the surfaces that are refined, which are not copied in the batches
+      constexpr vtkIdType batchMaximumCells = 10000;
+      bool directScalars = pdMapper->GetColorMode() == VTK_COLOR_MODE_DIRECT_SCALARS;
+      bool refined = genericImporter && genericImporter->HasTessellator();
+      if (importer->GetNumberOfAnimations() == 0 && !refined &&
+        surface->GetNumberOfCells() < batchMaximumCells &&
+        (!pdMapper->GetScalarVisibility() || directScalars))
       {
-        // For generic importer, use the single imported points
-        // TODO when supporting composite, handle with an actor based index
-        points = genericImporter->GetImportedPoints();
+        this->Pimpl->StaticActors.emplace_back(actor);
       }
-      pss.Mapper->SetInputData(points);
-      this->Renderer->AddActor(pss.Actor);
-      pss.Actor->VisibilityOff();
 
-      // Create and configure volume props
+      // The coloring, point sprites and volume props are only created once shown,
+      // see CreateColoringActors, CreatePointSprites and CreateVolumes
+      this->Pimpl->ColoringActorsAndMappers.emplace_back(vtkF3DMetaImporter::ColoringStruct(actor));
+      vtkF3DMetaImporter::Internals::SurfaceStruct surfaceStruct(actor, surface);
+      if (genericImporter && genericImporter->GetImportedPoints())
+      {
+        // For generic importer, use the single imported points,
+        // except for composite leaves imported as separate actors
+        surfaceStruct.Points = genericImporter->GetImportedPoints();
+      }
       if (genericImporter)
       {
-        vtkImageData* image = genericImporter->GetImportedImage();
-        if (image)
-        {
-          // XXX: Note that creating this struct takes some time
-          this->Pimpl->VolumePropsAndMappers.emplace_back(vtkF3DMetaImporter::VolumeStruct());
-          vtkF3DMetaImporter::VolumeStruct& vs = this->Pimpl->VolumePropsAndMappers.back();
-          vs.Mapper->SetInputData(image);
-          this->Renderer->AddVolume(vs.Prop);
-          vs.Prop->VisibilityOff();
-        }
+        surfaceStruct.Image = genericImporter->GetImportedImage();
       }
+      this->Pimpl->Surfaces.emplace_back(std::move(surfaceStruct));
     }
 
     importerPair.Updated = true;
+    this->WriteImporterSnapshot(index);
+
+    // Let observers show the importers added so far, while the next ones are being read
+    if (index + 1 < this->Pimpl->Importers.size())
+    {
+      this->Modified();
+      this->InvokeEvent(vtkF3DMetaImporter::ImporterAddedEvent);
+    }
   }
+  this->Pimpl->JoinParallelWorkers();
 
   if (localCameraIndex > 0)
   {
@@ -460,24 +1599,105 @@ bool vtkF3DMetaImporter::GetTemporalInformation(vtkIdType animationIndex, double
 //----------------------------------------------------------------------------
 bool vtkF3DMetaImporter::UpdateAtTimeValue(double timeValue)
 {
-  this->Pimpl->ColoringInfoUpdated = false;
   bool ret = true;
-  for (const auto& importerPair : this->Pimpl->Importers)
+  bool updated = false;
+  for (auto& importerPair : this->Pimpl->Importers)
   {
+    // Static importers, like a static mesh next to an animated one, do not change with time
+    if (importerPair.Updated && !importerPair.Animated.has_value())
+    {
+      importerPair.Animated = importerPair.Importer->GetNumberOfAnimations() > 0;
+    }
+    if (importerPair.Animated.has_value() && !importerPair.Animated.value())
+    {
+      continue;
+    }
+
+    // Each generic importer may lag behind on its own time step, other importers are updated
+    // in place and are always at the requested time value
+    vtkF3DGenericImporter* genericImporter =
+      vtkF3DGenericImporter::SafeDownCast(importerPair.Importer);
+    if (genericImporter)
+    {
+      genericImporter->SetAsynchronousUpdate(this->Pimpl->AsynchronousUpdate);
+    }
 #if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240707)
     ret = ret && importerPair.Importer->UpdateAtTimeValue(timeValue);
 #else
     importerPair.Importer->UpdateTimeStep(timeValue);
 #endif
+    if (genericImporter)
+    {
+      genericImporter->SetAsynchronousUpdate(false);
+    }
+    importerPair.ColoringInfoOutdated = true;
+    updated = true;
+  }
+
+  if (updated)
+  {
+    this->Pimpl->ColoringInfoUpdated = false;
+    this->Pimpl->UpdateTime.Modified();
+    this->Pimpl->TimeValue = timeValue;
+    this->Pimpl->TimeValueMTime = this->GetUpdateMTime();
+  }
+  if (!ret)
+  {
+    this->Pimpl->TimeValue.reset();
   }
   return ret;
 }
 
 //----------------------------------------------------------------------------
-void vtkF3DMetaImporter::UpdateInfoForColoring()
+void vtkF3DMetaImporter::SetAsynchronousUpdate(bool async)
+{
+  this->Pimpl->AsynchronousUpdate = async;
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DMetaImporter::HasPendingUpdate()
 {
   for (const auto& importerPair : this->Pimpl->Importers)
   {
+    vtkF3DGenericImporter* genericImporter =
+      vtkF3DGenericImporter::SafeDownCast(importerPair.Importer);
+    if (genericImporter && genericImporter->HasPendingUpdate())
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DMetaImporter::GetUpdatedTimeValue(double& timeValue)
+{
+  if (!this->Pimpl->TimeValue.has_value() ||
+    this->Pimpl->TimeValueMTime != this->GetUpdateMTime() || this->HasPendingUpdate())
+  {
+    return false;
+  }
+  timeValue = this->Pimpl->TimeValue.value();
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DMetaImporter::UpdateInfoForColoring()
+{
+  for (auto& importerPair : this->Pimpl->Importers)
+  {
+    if (!importerPair.Updated)
+    {
+      // May be being read by a worker while the imported ones are shown
+      continue;
+    }
+    if (!importerPair.ColoringInfoOutdated)
+    {
+      // The arrays of a static importer are already known
+      continue;
+    }
+    importerPair.ColoringInfoOutdated = false;
+
 #if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240707)
     vtkActorCollection* actorCollection = importerPair.Importer->GetImportedActors();
 #else
@@ -489,15 +1709,19 @@ void vtkF3DMetaImporter::UpdateInfoForColoring()
     while (auto* actor = actorCollection->GetNextActor(ait))
     {
       vtkPolyDataMapper* pdMapper = vtkPolyDataMapper::SafeDownCast(actor->GetMapper());
-      assert(pdMapper);
+      if (!pdMapper)
+      {
+        // Instanced actors are not colored
+        continue;
+      }
 
       // Update coloring vectors, with a dedicated logic for generic importer
       vtkDataSet* datasetForColoring = pdMapper->GetInput();
       vtkF3DGenericImporter* genericImporter = vtkF3DGenericImporter::SafeDownCast(importerPair.Importer);
       if (genericImporter)
       {
-        // TODO This will be improved with proper composite support
-        // Currently generic importer always has a single actor
+        // Generic importer has a single actor, except when importing composite leaves separately,
+        // in which case there are no imported points nor image
         if (genericImporter->GetImportedImage())
         {
           datasetForColoring = genericImporter->GetImportedImage();
@@ -515,7 +1739,144 @@ void vtkF3DMetaImporter::UpdateInfoForColoring()
 }
 
 //----------------------------------------------------------------------------
-std::string vtkF3DMetaImporter::GetMetaDataDescription() const
+vtkMTimeType vtkF3DMetaImporter::GetUpdateMTime()
+{
+  return std::max(this->GetMTime(), this->Pimpl->UpdateTime.GetMTime());
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DMetaImporter::DataModified()
+{
+  this->Pimpl->DataTime.Modified();
+  this->Pimpl->UpdateTime.Modified();
+}
+
+//----------------------------------------------------------------------------
+vtkMTimeType vtkF3DMetaImporter::GetDataMTime()
+{
+  return std::max(this->GetMTime(), this->Pimpl->DataTime.GetMTime());
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DMetaImporter::GetMemoryUsage(vtkTypeInt64& cpu, vtkTypeInt64& gpu)
+{
+  if (this->Pimpl->MemoryUsageTime.GetMTime() > this->GetUpdateMTime())
+  {
+    cpu = this->Pimpl->CPUMemoryUsage;
+    gpu = this->Pimpl->GPUMemoryUsage;
+    return;
+  }
+
+  cpu = 0;
+  gpu = 0;
+
+  // Data shared by several actors is only counted once, GetActualMemorySize is in KiB
+  std::set<vtkDataObject*> counted;
+  auto countData = [&](vtkDataObject* data)
+  {
+    bool added = data && counted.insert(data).second;
+    if (added)
+    {
+      cpu += static_cast<vtkTypeInt64>(data->GetActualMemorySize()) * 1024;
+    }
+    return added;
+  };
+
+  vtkCollectionSimpleIterator ait;
+  this->ActorCollection->InitTraversal(ait);
+  while (auto* actor = this->ActorCollection->GetNextActor(ait))
+  {
+    vtkMapper* mapper = actor->GetMapper();
+    vtkDataObject* input = mapper ? mapper->GetInputDataObject(0, 0) : nullptr;
+    if (countData(input) && vtkPolyData::SafeDownCast(input))
+    {
+      gpu += ::EstimateBuffersSize(vtkPolyData::SafeDownCast(input));
+    }
+
+    for (vtkTexture* texture : ::GetActorTextures(actor))
+    {
+      vtkImageData* image = vtkImageData::SafeDownCast(texture->GetInputDataObject(0, 0));
+      if (countData(image))
+      {
+        // Textures are uploaded as RGBA, mipmaps add a third of the size
+        vtkTypeInt64 size = static_cast<vtkTypeInt64>(image->GetNumberOfPoints()) * 4;
+        gpu += texture->GetMipmap() ? size * 4 / 3 : size;
+      }
+    }
+  }
+
+  for (const vtkF3DMetaImporter::VolumeStruct& vs : this->Pimpl->VolumePropsAndMappers)
+  {
+    vtkImageData* image = vtkImageData::SafeDownCast(vs.Mapper->GetInputDataObject(0, 0));
+    if (image && image->GetPointData()->GetScalars())
+    {
+      // The volume scalars are uploaded as is in a 3D texture, or quantized by the renderer
+      countData(vtkImageData::SafeDownCast(vs.Quantizer->GetInput()));
+      vtkDataArray* scalars = image->GetPointData()->GetScalars();
+      gpu += scalars->GetNumberOfValues() * scalars->GetDataTypeSize();
+    }
+  }
+
+  // The images of the volumes that are not created yet are only in CPU memory
+  for (const vtkF3DMetaImporter::Internals::SurfaceStruct& surfaceStruct : this->Pimpl->Surfaces)
+  {
+    countData(surfaceStruct.Image);
+  }
+
+  this->Pimpl->CPUMemoryUsage = cpu;
+  this->Pimpl->GPUMemoryUsage = gpu;
+  this->Pimpl->MemoryUsageTime.Modified();
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DMetaImporter::DownscaleTextures(int minimumSize)
+{
+  std::set<vtkTexture*> textures;
+  vtkCollectionSimpleIterator ait;
+  this->ActorCollection->InitTraversal(ait);
+  while (auto* actor = this->ActorCollection->GetNextActor(ait))
+  {
+    for (vtkTexture* texture : ::GetActorTextures(actor))
+    {
+      textures.insert(texture);
+    }
+  }
+
+  bool downscaled = false;
+  for (vtkTexture* texture : textures)
+  {
+    vtkImageData* image = vtkImageData::SafeDownCast(texture->GetInputDataObject(0, 0));
+    int dims[3] = { 0, 0, 0 };
+    if (image)
+    {
+      image->GetDimensions(dims);
+    }
+    if (std::max(dims[0], dims[1]) <= minimumSize || texture->GetCubeMap())
+    {
+      continue;
+    }
+
+    vtkNew<vtkImageResize> resize;
+    resize->SetInputData(image);
+    resize->SetResizeMethodToOutputDimensions();
+    resize->SetOutputDimensions(std::max(dims[0] / 2, 1), std::max(dims[1] / 2, 1), dims[2]);
+    resize->Update();
+
+    vtkNew<vtkImageData> downscaledImage;
+    downscaledImage->ShallowCopy(resize->GetOutput());
+    texture->SetInputData(downscaledImage);
+    downscaled = true;
+  }
+
+  if (downscaled)
+  {
+    this->Pimpl->UpdateTime.Modified();
+  }
+  return downscaled;
+}
+
+//----------------------------------------------------------------------------
+std::string vtkF3DMetaImporter::GetMetaDataDescription()
 {
   std::string description;
   if (this->Pimpl->Importers.size() > 1)
@@ -529,23 +1890,68 @@ std::string vtkF3DMetaImporter::GetMetaDataDescription() const
   description += std::to_string(this->ActorCollection->GetNumberOfItems());
   description += "\n";
 
+  this->UpdateCounts();
+
+  description += "Number of points: ";
+  description += std::to_string(this->Pimpl->NumberOfPoints);
+  description += "\n";
+  description += "Number of cells: ";
+  description += std::to_string(this->Pimpl->NumberOfCells);
+  return description;
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DMetaImporter::UpdateCounts()
+{
+  if (this->Pimpl->CountsTime.GetMTime() > this->GetUpdateMTime())
+  {
+    return;
+  }
+
   vtkIdType nPoints = 0;
   vtkIdType nCells = 0;
   vtkCollectionSimpleIterator ait;
   this->ActorCollection->InitTraversal(ait);
   while (auto* actor = this->ActorCollection->GetNextActor(ait))
   {
+    vtkGlyph3DMapper* glyphMapper = vtkGlyph3DMapper::SafeDownCast(actor->GetMapper());
+    if (glyphMapper)
+    {
+      // Count each instance of the shared geometry
+      vtkIdType nInstances = glyphMapper->GetInput()->GetNumberOfPoints();
+      nPoints += glyphMapper->GetSource()->GetNumberOfPoints() * nInstances;
+      nCells += glyphMapper->GetSource()->GetNumberOfCells() * nInstances;
+      continue;
+    }
+
     vtkPolyData* surface = vtkPolyDataMapper::SafeDownCast(actor->GetMapper())->GetInput();
     nPoints += surface->GetNumberOfPoints();
     nCells += surface->GetNumberOfCells();
   }
 
-  description += "Number of points: ";
-  description += std::to_string(nPoints);
-  description += "\n";
-  description += "Number of cells: ";
-  description += std::to_string(nCells);
-  return description;
+  this->Pimpl->NumberOfPoints = nPoints;
+  this->Pimpl->NumberOfCells = nCells;
+  this->Pimpl->CountsTime.Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DMetaImporter::SelectArrayForColoring(const std::string& arrayName)
+{
+  std::vector<std::string> arrayNames;
+  if (!arrayName.empty())
+  {
+    arrayNames.emplace_back(arrayName);
+  }
+
+  for (const auto& importerPair : this->Pimpl->Importers)
+  {
+    vtkF3DGenericImporter* genericImporter =
+      vtkF3DGenericImporter::SafeDownCast(importerPair.Importer);
+    if (importerPair.Updated && genericImporter)
+    {
+      genericImporter->SetSelectedArrays(arrayNames);
+    }
+  }
 }
 
 //----------------------------------------------------------------------------
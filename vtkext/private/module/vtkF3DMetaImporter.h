@@ -7,31 +7,48 @@
 #define vtkF3DMetaImporter_h
 
 #include "vtkF3DImporter.h"
+#include "vtkF3DQuantizeImageFilter.h"
 #include "F3DColoringInfoHandler.h"
 
 #include <vtkActor.h>
+#include <vtkPolyDataMapper.h>
 #include <vtkVolume.h>
 #include <vtkSmartVolumeMapper.h>
 #include <vtkPointGaussianMapper.h>
 #include <vtkProperty.h>
+#include <vtkSmartPointer.h>
 #include <vtkBoundingBox.h>
+#include <vtkCommand.h>
 #include <vtkVersion.h>
 
 #if VTK_VERSION_NUMBER < VTK_VERSION_CHECK(9, 3, 20240707)
 #include <vtkActorCollection.h>
 #endif
 
+#include <future>
 #include <memory>
 #include <optional>
 #include <string>
 #include <vector>
 
+class vtkLight;
+class vtkQuadricClustering;
+
 class vtkF3DMetaImporter : public vtkF3DImporter
 {
 public:
   static vtkF3DMetaImporter* New();
   vtkTypeMacro(vtkF3DMetaImporter, vtkF3DImporter);
 
+  /**
+   * Event invoked by Update each time the props of an importer have been added to the renderer,
+   * except for the last one, so that the scene can be shown while the next ones are read.
+   */
+  enum vtkCustomEvents
+  {
+    ImporterAddedEvent = vtkCommand::UserEvent + 200
+  };
+
   ///@{
   /**
    * Structs used to transfer actors information to the F3D renderer
@@ -45,6 +62,7 @@ public:
     }
     vtkNew<vtkVolume> Prop;
     vtkNew<vtkSmartVolumeMapper> Mapper;
+    vtkNew<vtkF3DQuantizeImageFilter> Quantizer;
   };
 
   struct PointSpritesStruct
@@ -58,21 +76,45 @@ public:
     vtkNew<vtkPointGaussianMapper> Mapper;
   };
 
+  /**
+   * There is a coloring struct for each imported actor with a surface, but its actor and mapper
+   * are nullptr until created by CreateColoringActors
+   */
   struct ColoringStruct
   {
     explicit ColoringStruct(vtkActor* originalActor)
       : OriginalActor(originalActor)
     {
-      this->Actor->GetProperty()->SetPointSize(10.0);
-      this->Actor->GetProperty()->SetLineWidth(1.0);
-      this->Actor->GetProperty()->SetRoughness(0.3);
-      this->Actor->GetProperty()->SetInterpolationToPBR();
+    }
+    vtkSmartPointer<vtkActor> Actor;
+    vtkSmartPointer<vtkPolyDataMapper> Mapper;
+    vtkActor* OriginalActor;
+  };
+
+  struct LODStruct
+  {
+    explicit LODStruct(vtkActor* originalActor)
+      : OriginalActor(originalActor)
+    {
+    }
+    vtkActor* OriginalActor;
+    vtkSmartPointer<vtkPolyData> Surface;
+    vtkSmartPointer<vtkMapper> FullMapper;
+    vtkNew<vtkPolyDataMapper> Mapper;
+    vtkSmartPointer<vtkQuadricClustering> Decimator;
+    std::future<void> Proxy;
+    bool ProxyReady = false;
+  };
+
+  struct BatchStruct
+  {
+    BatchStruct()
+    {
       this->Actor->SetMapper(this->Mapper);
-      this->Mapper->InterpolateScalarsBeforeMappingOn();
     }
     vtkNew<vtkActor> Actor;
     vtkNew<vtkPolyDataMapper> Mapper;
-    vtkActor* OriginalActor;
+    std::vector<vtkActor*> OriginalActors;
   };
   ///@}
 
@@ -86,6 +128,59 @@ public:
    */
   void AddImporter(const vtkSmartPointer<vtkImporter>& importer);
 
+  /**
+   * Add an importer that has already been updated into its own render window,
+   * eg. on a worker thread. Update will not update it again but will move its props, lights
+   * and camera if selected into the first renderer of the render window instead.
+   */
+  void AddUpdatedImporter(const vtkSmartPointer<vtkImporter>& importer);
+
+  /**
+   * Replace a previously added importer by another one, at the same position, so that
+   * camera and animation indices are not changed. The actors, lights and internal structures
+   * created for the previous importer are removed, those of the other importers are kept.
+   * The importer will be imported by the next Update.
+   * Return false if the previous importer has not been added.
+   */
+  bool ReplaceImporter(vtkImporter* previous, const vtkSmartPointer<vtkImporter>& importer);
+
+  /**
+   * Remove a previously added importer, with the actors, lights and internal structures
+   * created for it. Return false if the importer has not been added.
+   */
+  bool RemoveImporter(vtkImporter* importer);
+
+  /**
+   * Mark the actors of an added importer as dynamic, because their geometry is modified without
+   * importing them again. They are not batched with the static actors nor replaced by level of
+   * detail proxies anymore.
+   * Return false if the importer has not been added or updated yet.
+   */
+  bool SetImporterDynamic(vtkImporter* importer);
+
+  /**
+   * Write the actors of an added importer in a snapshot file once it has been updated, so that
+   * it can be imported by a vtkF3DSnapshotImporter the next time. The snapshot is not written
+   * if the importer has animations, cameras or lights, or props that a snapshot cannot store,
+   * eg. volumes or instanced actors.
+   * Return false if the importer has not been added.
+   */
+  bool SetImporterSnapshot(vtkImporter* importer, const std::string& fileName);
+
+  /**
+   * Write the actors of all the updated importers in a binary glTF file, see vtkF3DGLBWriter.
+   * Return false if the file cannot be written.
+   */
+  bool WriteGLB(const std::string& fileName);
+
+  /**
+   * Set the maximum number of triangles of the surfaces of each importer updated afterwards.
+   * The surfaces of the importers above the budget are simplified with vtkF3DSimplifyFilter,
+   * each one in proportion to its number of triangles, except for animated importers and
+   * generic importers with a tessellator. Default is 0, surfaces are not simplified.
+   */
+  void SetTriangleBudget(vtkIdType budget);
+
   /**
    * Get the bounding box of all geometry actors
    * Should be called after actors have been imported
@@ -93,29 +188,119 @@ public:
   const vtkBoundingBox& GetGeometryBoundingBox();
 
   /**
-   * Get a meta data description of all imported data
+   * Estimate the memory used by the imported data, in bytes.
+   * The CPU memory counts each geometry, texture and volume image once. The GPU memory
+   * estimates the vertex buffers and textures uploaded to render them.
+   * Should be called after actors have been imported.
+   * The estimation is cached until the imported data changes.
+   */
+  void GetMemoryUsage(vtkTypeInt64& cpu, vtkTypeInt64& gpu);
+
+  /**
+   * Halve the resolution of the textures of the imported actors that are larger than
+   * minimumSize pixels in a dimension, to reduce the memory they use.
+   * Return false if no texture was large enough to be downscaled.
+   */
+  bool DownscaleTextures(int minimumSize);
+
+  /**
+   * Get a meta data description of all imported data.
+   * The counts of points and cells are cached until the imported data changes.
    */
-  std::string GetMetaDataDescription() const;
+  std::string GetMetaDataDescription();
+
+  /**
+   * Get the last time the imported data changed, either by adding importers,
+   * or by updating them at a time value. The cached scene aggregates,
+   * like the counts, the memory usage or the bounds, are outdated after that time.
+   */
+  vtkMTimeType GetUpdateMTime();
+
+  /**
+   * Mark the imported data as changed without adding importers nor updating them at a time value,
+   * eg. when the geometry of a dynamic importer is modified in place, so that the cached scene
+   * aggregates are computed again. GetDataMTime returns the last time it was called,
+   * the aggregates cached by time value are outdated after that time.
+   */
+  void DataModified();
+  vtkMTimeType GetDataMTime();
 
 
   F3DColoringInfoHandler& GetColoringInfoHandler();
 
+  /**
+   * Restrict the arrays read by the generic importers when updating time steps
+   * to the provided array, used for coloring. An empty name reads none of the data arrays.
+   */
+  void SelectArrayForColoring(const std::string& arrayName);
+
+  ///@{
+  /**
+   * Create hidden in the renderer the coloring actors, the point sprites actors or the volume
+   * props of the imported actors that do not have them yet, so that these props, and the GPU
+   * resources they use, are only created once they are shown.
+   * Point sprites are created for the actors with a surface, volumes for the actors of the
+   * generic importers with an image.
+   * Return true if props were created.
+   */
+  bool CreateColoringActors();
+  bool CreatePointSprites();
+  bool CreateVolumes();
+  ///@}
+
   ///@{
   /**
-   * API to recover information about all imported actors, point sprites and volume if any
+   * API to recover information about all imported actors, point sprites and volume if any.
+   * The point sprites structs are in the same order as the coloring structs, once created.
    */
   const std::vector<ColoringStruct>& GetColoringActorsAndMappers();
   const std::vector<PointSpritesStruct>& GetPointSpritesActorsAndMappers();
   const std::vector<VolumeStruct>& GetVolumePropsAndMappers();
+  std::vector<LODStruct>& GetLODActorsAndMappers();
+  const std::vector<BatchStruct>& GetStaticBatches();
   ///@}
 
+  /**
+   * Start building in the background a decimated proxy of each dense surface imported by
+   * a non-animated importer, to use as a level of detail while interacting.
+   * Proxies already built or being built are not built again.
+   */
+  void BuildLODProxies();
+
+  /**
+   * Group the small surfaces of non-animated importers sharing the same material and
+   * concatenate each group, with the actors transforms applied, into a single batch actor.
+   * A "BatchedActorId" cell array identifies the original actor of each cell.
+   * Batches are built hidden and only built again when new importers have been updated.
+   */
+  void BuildStaticBatches();
+
+  /**
+   * Swap in the surfaces refined in the background by the generic importers having a tessellator
+   * and start refining the surfaces whose error on screen is too large for the current camera,
+   * see vtkF3DGenericImporter::UpdateTessellation. Return true if surfaces were swapped in.
+   */
+  bool UpdateTessellations(bool wait);
+
+  /**
+   * Return true if surfaces refined in the background are ready to be swapped in
+   */
+  bool IsTessellationRefined();
+
+  /**
+   * Update the bricks of the streamed volumes for the camera of the renderer,
+   * see vtkF3DGenericImporter::UpdateStreamedVolume. Return true if volumes changed.
+   */
+  bool UpdateStreamedVolumes();
+
   /**
    * XXX: HIDE the vtkImporter::Update method and declare our own
    * Import each of of the add importers into the first renderer of the render window.
    * Importers that have already been imported will be skipped
-   * Also handles camera index if specified
-   * After import, create point sprites actors for all importers, and volume props
-   * for generic importer if compatible.
+   * Importers added with AddUpdatedImporter will have their props moved into the renderer
+   * Also handles camera index if specified, importers are updated in parallel when not
+   * After import, the coloring structs of the actors are added, without creating their props,
+   * see CreateColoringActors, CreatePointSprites and CreateVolumes.
    */
   bool Update();
 
@@ -149,10 +334,30 @@ public:
   ///@}
 
   /**
-   * Update each individual importer at the provided value
+   * Update each individual importer with animations at the provided value.
+   * Importers without animation are not updated and their coloring info is kept.
    */
   bool UpdateAtTimeValue(double timeValue) override;
 
+  ///@{
+  /**
+   * Set whether UpdateAtTimeValue lets each generic importer keep showing its latest decoded
+   * time step while the requested one is decoded in the background, see
+   * vtkF3DGenericImporter::SetAsynchronousUpdate. Default is false.
+   * HasPendingUpdate returns true if an importer is not at the last requested time value, a
+   * synchronous update at this time value brings all importers to it.
+   */
+  void SetAsynchronousUpdate(bool async);
+  bool HasPendingUpdate();
+  ///@}
+
+  /**
+   * Get the time value of the last UpdateAtTimeValue, returning true only if the imported data
+   * did not change since and all the importers are at this time value, so that the imported
+   * data is the same each time this time value is returned.
+   */
+  bool GetUpdatedTimeValue(double& timeValue);
+
 protected:
   vtkF3DMetaImporter();
   ~vtkF3DMetaImporter() override;
@@ -172,6 +377,57 @@ private:
    */
   void UpdateInfoForColoring();
 
+  /**
+   * Simplify the surfaces of the actors of an updated importer to the triangle budget
+   */
+  void SimplifySurfaces(vtkImporter* importer, vtkActorCollection* actors);
+
+  /**
+   * Start updating all importers that have not been updated yet in parallel, each into
+   * its own render window, in order. Updated importers are then handled as if added with
+   * AddUpdatedImporter, once WaitForParallelImporter returns.
+   */
+  void StartImportersInParallel();
+
+  /**
+   * Wait for the importer at the provided index to be updated by StartImportersInParallel,
+   * while forwarding progress events from the calling thread.
+   * Return false if it failed to update.
+   */
+  bool WaitForParallelImporter(size_t index);
+
+  /**
+   * Move props, lights and camera of an importer that has been updated in its own render window
+   * into the renderer. Moved lights are added to movedLights.
+   */
+  void MoveUpdatedImporterProps(vtkImporter* importer,
+    std::vector<vtkSmartPointer<vtkLight>>& movedLights, vtkIdType localCameraIndex);
+
+  /**
+   * Forward the progress events of an importer, taking into account all importers.
+   */
+  void ObserveProgress(vtkImporter* importer);
+
+  /**
+   * Return the actors imported by an updated importer.
+   */
+  std::vector<vtkActor*> GetImporterActors(vtkImporter* importer);
+
+  /**
+   * Write the snapshot of the updated importer at the provided index, if any.
+   */
+  void WriteImporterSnapshot(size_t index);
+
+  /**
+   * Remove the actors, lights and structs of the importer at the provided index, if updated.
+   */
+  void RemoveImporterProps(size_t index);
+
+  /**
+   * Count the points and cells of the actors if they changed since the last count
+   */
+  void UpdateCounts();
+
   struct Internals;
   std::unique_ptr<Internals> Pimpl;
 
@@ -0,0 +1,239 @@
+#include "vtkF3DNormalsFilter.h"
+
+#include <vtkCellArray.h>
+#include <vtkCellArrayIterator.h>
+#include <vtkCellData.h>
+#include <vtkFloatArray.h>
+#include <vtkIdList.h>
+#include <vtkIdTypeArray.h>
+#include <vtkInformation.h>
+#include <vtkInformationVector.h>
+#include <vtkMath.h>
+#include <vtkObjectFactory.h>
+#include <vtkPointData.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkSMPTools.h>
+
+#include <array>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+namespace
+{
+using Normal = std::array<double, 3>;
+
+//----------------------------------------------------------------------------
+/**
+ * Return the normal of a polygon with Newell's method, its norm is twice the area of the polygon
+ */
+Normal GetPolygonNormal(vtkPoints* points, const vtkIdType* ids, vtkIdType nbIds)
+{
+  Normal normal = { 0.0, 0.0, 0.0 };
+  double a[3];
+  double b[3];
+  for (vtkIdType i = 0; i < nbIds; i++)
+  {
+    points->GetPoint(ids[i], a);
+    points->GetPoint(ids[(i + 1) % nbIds], b);
+    normal[0] += (a[1] - b[1]) * (a[2] + b[2]);
+    normal[1] += (a[2] - b[2]) * (a[0] + b[0]);
+    normal[2] += (a[0] - b[0]) * (a[1] + b[1]);
+  }
+  return normal;
+}
+}
+
+vtkStandardNewMacro(vtkF3DNormalsFilter);
+
+//----------------------------------------------------------------------------
+int vtkF3DNormalsFilter::RequestData(
+  vtkInformation*, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  vtkPolyData* input = vtkPolyData::GetData(inputVector[0]);
+  vtkPolyData* output = vtkPolyData::GetData(outputVector);
+
+  vtkCellArray* polys = input->GetPolys();
+  const vtkIdType nbPolys = input->GetNumberOfPolys();
+  if (nbPolys == 0 || input->GetPointData()->GetNormals())
+  {
+    output->ShallowCopy(input);
+    return 1;
+  }
+
+  // The corners of the polygons, the corners of polygon c being [offsets[c], offsets[c + 1])
+  std::vector<vtkIdType> offsets(nbPolys + 1, 0);
+  std::vector<vtkIdType> connectivity;
+  connectivity.reserve(polys->GetNumberOfConnectivityIds());
+  std::vector<vtkIdType> cornerPolys;
+  cornerPolys.reserve(polys->GetNumberOfConnectivityIds());
+  auto iter = vtk::TakeSmartPointer(polys->NewIterator());
+  vtkIdType c = 0;
+  for (iter->GoToFirstCell(); !iter->IsDoneWithTraversal(); iter->GoToNextCell(), c++)
+  {
+    vtkIdType npts;
+    const vtkIdType* pts;
+    iter->GetCurrentCell(npts, pts);
+    connectivity.insert(connectivity.end(), pts, pts + npts);
+    cornerPolys.insert(cornerPolys.end(), npts, c);
+    offsets[c + 1] = static_cast<vtkIdType>(connectivity.size());
+  }
+
+  vtkPoints* points = input->GetPoints();
+  std::vector<Normal> polyNormals(nbPolys);
+  std::vector<Normal> polyDirections(nbPolys);
+  vtkSMPTools::For(0, nbPolys,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType i = begin; i < end; i++)
+      {
+        polyNormals[i] = ::GetPolygonNormal(
+          points, connectivity.data() + offsets[i], offsets[i + 1] - offsets[i]);
+        polyDirections[i] = polyNormals[i];
+        vtkMath::Normalize(polyDirections[i].data());
+      }
+    });
+
+  // The corners using each point, in compressed rows
+  const vtkIdType nbPoints = input->GetNumberOfPoints();
+  std::vector<vtkIdType> pointOffsets(nbPoints + 1, 0);
+  for (vtkIdType p : connectivity)
+  {
+    pointOffsets[p + 1]++;
+  }
+  std::partial_sum(pointOffsets.begin(), pointOffsets.end(), pointOffsets.begin());
+  std::vector<vtkIdType> corners(connectivity.size());
+  {
+    std::vector<vtkIdType> fill(pointOffsets.begin(), pointOffsets.end() - 1);
+    for (size_t i = 0; i < connectivity.size(); i++)
+    {
+      corners[fill[connectivity[i]]++] = static_cast<vtkIdType>(i);
+    }
+  }
+
+  // Each point groups its corners, a group being identified by the entry of its first corner,
+  // which accumulates the normal of the group
+  const bool split = this->FeatureAngle < 180.0;
+  const double cosAngle = std::cos(vtkMath::RadiansFromDegrees(this->FeatureAngle));
+  std::vector<vtkIdType> groups(corners.size());
+  std::vector<Normal> groupNormals(corners.size());
+  std::vector<vtkIdType> nbCopies(nbPoints, 0);
+  vtkSMPTools::For(0, nbPoints,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType p = begin; p < end; p++)
+      {
+        const vtkIdType first = pointOffsets[p];
+        for (vtkIdType a = first; a < pointOffsets[p + 1]; a++)
+        {
+          // Degenerate polygons join the first group
+          const vtkIdType poly = cornerPolys[corners[a]];
+          const double* direction = polyDirections[poly].data();
+          const bool degenerate = direction[0] == 0.0 && direction[1] == 0.0 && direction[2] == 0.0;
+          vtkIdType group = a == first || !split || degenerate ? first : -1;
+          for (vtkIdType b = first; b < a && group < 0; b++)
+          {
+            if (groups[b] == b &&
+              vtkMath::Dot(polyDirections[cornerPolys[corners[b]]].data(), direction) >= cosAngle)
+            {
+              group = b;
+            }
+          }
+
+          if (group < 0)
+          {
+            group = a;
+            nbCopies[p]++;
+          }
+          if (group == a)
+          {
+            groupNormals[a] = { 0.0, 0.0, 0.0 };
+          }
+          groups[a] = group;
+          for (int i = 0; i < 3; i++)
+          {
+            groupNormals[group][i] += polyNormals[poly][i];
+          }
+        }
+      }
+    });
+
+  // The copies of the split points are added after the input points
+  std::vector<vtkIdType> copyOffsets(nbPoints + 1, 0);
+  std::partial_sum(nbCopies.begin(), nbCopies.end(), copyOffsets.begin() + 1);
+  const vtkIdType nbOutputPoints = nbPoints + copyOffsets[nbPoints];
+
+  vtkNew<vtkFloatArray> normals;
+  normals->SetName("Normals");
+  normals->SetNumberOfComponents(3);
+  normals->SetNumberOfTuples(nbOutputPoints);
+  vtkNew<vtkIdList> sourcePoints;
+  sourcePoints->SetNumberOfIds(nbOutputPoints);
+  std::vector<vtkIdType> outputConnectivity(connectivity.size());
+  const float defaultNormal[3] = { 0.f, 0.f, 1.f };
+  vtkSMPTools::For(0, nbPoints,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType p = begin; p < end; p++)
+      {
+        // The points only used by other cells have an arbitrary normal
+        sourcePoints->SetId(p, p);
+        normals->SetTypedTuple(p, defaultNormal);
+
+        vtkIdType copy = nbPoints + copyOffsets[p];
+        const vtkIdType first = pointOffsets[p];
+        for (vtkIdType a = first; a < pointOffsets[p + 1]; a++)
+        {
+          if (groups[a] == a)
+          {
+            // The first group keeps the input point
+            vtkIdType id = a == first ? p : copy++;
+            sourcePoints->SetId(id, p);
+            Normal normal = groupNormals[a];
+            vtkMath::Normalize(normal.data());
+            float value[3] = { static_cast<float>(normal[0]), static_cast<float>(normal[1]),
+              static_cast<float>(normal[2]) };
+            normals->SetTypedTuple(id, value);
+            // Store the output point of the group in its first corner
+            outputConnectivity[corners[a]] = id;
+          }
+        }
+        for (vtkIdType a = first; a < pointOffsets[p + 1]; a++)
+        {
+          outputConnectivity[corners[a]] = outputConnectivity[corners[groups[a]]];
+        }
+      }
+    });
+
+  output->ShallowCopy(input);
+  if (nbOutputPoints != nbPoints)
+  {
+    vtkNew<vtkPoints> outputPoints;
+    outputPoints->SetDataType(points->GetDataType());
+    points->GetPoints(sourcePoints, outputPoints);
+    output->SetPoints(outputPoints);
+
+    vtkNew<vtkIdList> identity;
+    identity->SetNumberOfIds(nbOutputPoints);
+    std::iota(identity->begin(), identity->end(), 0);
+    output->GetPointData()->Initialize();
+    output->GetPointData()->CopyAllOn();
+    output->GetPointData()->CopyAllocate(input->GetPointData(), nbOutputPoints);
+    output->GetPointData()->CopyData(input->GetPointData(), sourcePoints, identity);
+
+    vtkNew<vtkIdTypeArray> offsetsArray;
+    offsetsArray->SetNumberOfValues(nbPolys + 1);
+    std::copy(offsets.begin(), offsets.end(), offsetsArray->GetPointer(0));
+    vtkNew<vtkIdTypeArray> connectivityArray;
+    connectivityArray->SetNumberOfValues(static_cast<vtkIdType>(outputConnectivity.size()));
+    std::copy(
+      outputConnectivity.begin(), outputConnectivity.end(), connectivityArray->GetPointer(0));
+    vtkNew<vtkCellArray> outputPolys;
+    outputPolys->SetData(offsetsArray, connectivityArray);
+    output->SetPolys(outputPolys);
+  }
+  output->GetPointData()->SetNormals(normals);
+
+  return 1;
+}
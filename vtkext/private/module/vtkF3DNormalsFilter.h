@@ -0,0 +1,50 @@
+/**
+ * @class   vtkF3DNormalsFilter
+ * @brief   Generate smooth point normals of a surface in parallel
+ *
+ * Unlike vtkPolyDataNormals, which is serial, the normals of the polygons are computed
+ * concurrently with Newell's method, so that they are weighted by the area of the polygons,
+ * then each point gathers the normals of the polygons using it concurrently through a compressed
+ * point to polygons adjacency, without atomics.
+ * The polygons using a point whose normals differ by more than FeatureAngle are split in groups
+ * around this point, each group using a copy of the point with its own normal, so that sharp
+ * edges are kept. The copies are added after the input points, with the same point data.
+ * The polygons are not reoriented nor reordered, the other cells and the cell data are kept.
+ * Inputs that already have point normals or no polygon are passed through.
+ */
+
+#ifndef vtkF3DNormalsFilter_h
+#define vtkF3DNormalsFilter_h
+
+#include <vtkPolyDataAlgorithm.h>
+
+class vtkF3DNormalsFilter : public vtkPolyDataAlgorithm
+{
+public:
+  static vtkF3DNormalsFilter* New();
+  vtkTypeMacro(vtkF3DNormalsFilter, vtkPolyDataAlgorithm);
+
+  ///@{
+  /**
+   * Set/Get the angle in degrees between the normals of two polygons above which they do not
+   * share the normal of their common points.
+   * Default is 180, the points are never split.
+   */
+  vtkSetClampMacro(FeatureAngle, double, 0.0, 180.0);
+  vtkGetMacro(FeatureAngle, double);
+  ///@}
+
+protected:
+  vtkF3DNormalsFilter() = default;
+  ~vtkF3DNormalsFilter() override = default;
+
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+
+private:
+  vtkF3DNormalsFilter(const vtkF3DNormalsFilter&) = delete;
+  void operator=(const vtkF3DNormalsFilter&) = delete;
+
+  double FeatureAngle = 180.0;
+};
+
+#endif
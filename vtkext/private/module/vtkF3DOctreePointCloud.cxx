@@ -0,0 +1,851 @@
+#include "vtkF3DOctreePointCloud.h"
+
+#include "vtkF3DCache.h"
+
+#include <vtkCallbackCommand.h>
+#include <vtkCamera.h>
+#include <vtkFloatArray.h>
+#include <vtkInformation.h>
+#include <vtkInformationVector.h>
+#include <vtkMath.h>
+#include <vtkNew.h>
+#include <vtkObjectFactory.h>
+#include <vtkPointData.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkRenderer.h>
+#include <vtkUnsignedCharArray.h>
+#include <vtksys/FStream.hxx>
+#include <vtksys/MD5.h>
+#include <vtksys/SystemTools.hxx>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <iterator>
+#include <mutex>
+#include <numeric>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+constexpr char Magic[8] = { 'F', '3', 'D', 'O', 'C', 'T', 'R', '\0' };
+constexpr uint32_t Version = 1;
+
+// Number of sampling grid cells per axis of a node, the points of a node are at least one
+// cell size apart
+constexpr int GridResolution = 128;
+
+// Points still not distributed at this level are all kept in the leaf
+constexpr uint32_t MaxLevel = 20;
+
+struct Node
+{
+  std::array<double, 3> Origin;
+  double Size;
+  uint32_t Level;
+  std::array<int32_t, 8> Children;
+  uint64_t Offset;
+  uint64_t Count;
+};
+
+struct NodeData
+{
+  std::vector<float> Points;
+  std::vector<unsigned char> Colors;
+  uint64_t LastUse = 0;
+
+  size_t GetMemorySize() const
+  {
+    return this->Points.size() * sizeof(float) + this->Colors.size();
+  }
+};
+
+//----------------------------------------------------------------------------
+template<typename T>
+void Write(std::ostream& os, const T& value)
+{
+  os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+//----------------------------------------------------------------------------
+template<typename T>
+bool Read(std::istream& is, T& value)
+{
+  is.read(reinterpret_cast<char*>(&value), sizeof(T));
+  return static_cast<bool>(is);
+}
+
+//----------------------------------------------------------------------------
+void WriteHeader(std::ostream& os, bool hasColors, uint64_t nbNodes, uint64_t tableOffset,
+  uint64_t nbPoints, const double bounds[6])
+{
+  os.write(::Magic, sizeof(::Magic));
+  ::Write(os, ::Version);
+  ::Write(os, static_cast<uint32_t>(hasColors));
+  ::Write(os, nbNodes);
+  ::Write(os, tableOffset);
+  ::Write(os, nbPoints);
+  for (int i = 0; i < 6; i++)
+  {
+    ::Write(os, bounds[i]);
+  }
+}
+
+//----------------------------------------------------------------------------
+void WriteNode(std::ostream& os, const ::Node& node)
+{
+  for (double coord : node.Origin)
+  {
+    ::Write(os, coord);
+  }
+  ::Write(os, node.Size);
+  ::Write(os, node.Level);
+  for (int32_t child : node.Children)
+  {
+    ::Write(os, child);
+  }
+  ::Write(os, node.Offset);
+  ::Write(os, node.Count);
+}
+
+//----------------------------------------------------------------------------
+bool ReadNode(std::istream& is, ::Node& node)
+{
+  bool ok = true;
+  for (double& coord : node.Origin)
+  {
+    ok = ok && ::Read(is, coord);
+  }
+  ok = ok && ::Read(is, node.Size) && ::Read(is, node.Level);
+  for (int32_t& child : node.Children)
+  {
+    ok = ok && ::Read(is, child);
+  }
+  return ok && ::Read(is, node.Offset) && ::Read(is, node.Count);
+}
+
+//----------------------------------------------------------------------------
+double GetSpacing(const ::Node& node)
+{
+  return node.Size / ::GridResolution;
+}
+
+//----------------------------------------------------------------------------
+bool IsOutsideFrustum(const double planes[24], const ::Node& node)
+{
+  for (int i = 0; i < 6; i++)
+  {
+    const double* plane = planes + 4 * i;
+    double farthest = plane[3];
+    for (int j = 0; j < 3; j++)
+    {
+      farthest += std::max(plane[j] * node.Origin[j], plane[j] * (node.Origin[j] + node.Size));
+    }
+    if (farthest < 0.0)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+}
+
+//----------------------------------------------------------------------------
+struct vtkF3DOctreePointCloud::Internals
+{
+  ~Internals()
+  {
+    this->StopWorker();
+  }
+
+  /**
+   * Read the header and the node table of the octree file
+   */
+  bool ReadIndex(const std::string& fileName)
+  {
+    this->Nodes.clear();
+    vtksys::ifstream file(fileName.c_str(), std::ios::binary);
+    char magic[sizeof(::Magic)];
+    uint32_t version = 0;
+    uint32_t hasColors = 0;
+    uint64_t nbNodes = 0;
+    uint64_t tableOffset = 0;
+    if (!file.is_open() || !file.read(magic, sizeof(magic)) ||
+      std::memcmp(magic, ::Magic, sizeof(magic)) != 0 || !::Read(file, version) ||
+      version != ::Version || !::Read(file, hasColors) || !::Read(file, nbNodes) ||
+      !::Read(file, tableOffset) || !::Read(file, this->NbPoints))
+    {
+      return false;
+    }
+    this->HasColors = hasColors != 0;
+
+    file.seekg(static_cast<std::streamoff>(tableOffset));
+    this->Nodes.resize(nbNodes);
+    for (::Node& node : this->Nodes)
+    {
+      if (!::ReadNode(file, node))
+      {
+        this->Nodes.clear();
+        return false;
+      }
+    }
+    return !this->Nodes.empty();
+  }
+
+  /**
+   * Read the points of a node, thread safe
+   */
+  bool ReadNodeData(const std::string& fileName, int id, ::NodeData& data) const
+  {
+    const ::Node& node = this->Nodes[id];
+    vtksys::ifstream file(fileName.c_str(), std::ios::binary);
+    if (!file.is_open())
+    {
+      return false;
+    }
+    file.seekg(static_cast<std::streamoff>(node.Offset));
+    data.Points.resize(3 * node.Count);
+    file.read(reinterpret_cast<char*>(data.Points.data()),
+      static_cast<std::streamsize>(data.Points.size() * sizeof(float)));
+    if (this->HasColors)
+    {
+      data.Colors.resize(4 * node.Count);
+      file.read(reinterpret_cast<char*>(data.Colors.data()),
+        static_cast<std::streamsize>(data.Colors.size()));
+    }
+    return static_cast<bool>(file);
+  }
+
+  /**
+   * Select the nodes to show by decreasing screen space error until the point budget is reached,
+   * parents are always selected before their children.
+   * Without a renderer, the nodes are selected by decreasing spacing.
+   */
+  std::vector<int> ComputeSelection(vtkRenderer* renderer, vtkIdType budget, double maxError)
+  {
+    std::vector<int> selection;
+    if (this->Nodes.empty())
+    {
+      return selection;
+    }
+
+    vtkCamera* camera = nullptr;
+    double planes[24] = {};
+    double pixelsPerUnit = 1.0;
+    if (renderer && renderer->IsActiveCameraCreated() && renderer->GetSize()[1] > 0)
+    {
+      camera = renderer->GetActiveCamera();
+      camera->GetFrustumPlanes(renderer->GetTiledAspectRatio(), planes);
+      double height = renderer->GetSize()[1];
+      pixelsPerUnit = camera->GetParallelProjection()
+        ? height / (2.0 * camera->GetParallelScale())
+        : height / (2.0 * std::tan(vtkMath::RadiansFromDegrees(camera->GetViewAngle()) / 2.0));
+    }
+
+    // Projected spacing of the points of a node, in pixels
+    const double minDistance = this->Nodes[0].Size * 1e-6;
+    auto computeError = [&](const ::Node& node)
+    {
+      double error = ::GetSpacing(node) * pixelsPerUnit;
+      if (camera && !camera->GetParallelProjection())
+      {
+        const double* eye = camera->GetPosition();
+        double distance = 0.0;
+        for (int i = 0; i < 3; i++)
+        {
+          double delta = node.Origin[i] + node.Size / 2.0 - eye[i];
+          distance += delta * delta;
+        }
+        distance = std::sqrt(distance) - node.Size * std::sqrt(3.0) / 2.0;
+        error /= std::max(distance, minDistance);
+      }
+      return error;
+    };
+
+    std::priority_queue<std::pair<double, int>> queue;
+    if (!camera || !::IsOutsideFrustum(planes, this->Nodes[0]))
+    {
+      queue.emplace(computeError(this->Nodes[0]), 0);
+    }
+
+    vtkIdType count = 0;
+    while (!queue.empty())
+    {
+      auto [error, id] = queue.top();
+      queue.pop();
+
+      const ::Node& node = this->Nodes[id];
+      if (count + static_cast<vtkIdType>(node.Count) > budget)
+      {
+        continue;
+      }
+      selection.emplace_back(id);
+      count += static_cast<vtkIdType>(node.Count);
+
+      if (camera && error < maxError)
+      {
+        continue;
+      }
+      for (int32_t child : node.Children)
+      {
+        if (child >= 0 && (!camera || !::IsOutsideFrustum(planes, this->Nodes[child])))
+        {
+          queue.emplace(computeError(this->Nodes[child]), child);
+        }
+      }
+    }
+    return selection;
+  }
+
+  /**
+   * Return the selected nodes that are loaded
+   */
+  std::vector<int> GetLoadedSelection()
+  {
+    const std::lock_guard<std::mutex> lock(this->Mutex);
+    std::vector<int> loaded;
+    std::copy_if(this->Selection.begin(), this->Selection.end(), std::back_inserter(loaded),
+      [&](int id) { return this->Loaded.count(id) > 0; });
+    return loaded;
+  }
+
+  /**
+   * Insert the data of a node in the cache, the mutex must be locked
+   */
+  void Insert(int id, ::NodeData&& data)
+  {
+    this->LoadedMemory += data.GetMemorySize();
+    this->Loaded[id] = std::move(data);
+  }
+
+  /**
+   * Discard the least recently used nodes that are not selected until the memory budget is met,
+   * the mutex must be locked
+   */
+  void Evict(size_t budget)
+  {
+    if (this->LoadedMemory <= budget)
+    {
+      return;
+    }
+
+    std::vector<bool> selected(this->Nodes.size(), false);
+    for (int id : this->Selection)
+    {
+      selected[id] = true;
+    }
+
+    std::vector<std::pair<uint64_t, int>> candidates;
+    for (const auto& [id, data] : this->Loaded)
+    {
+      if (!selected[id])
+      {
+        candidates.emplace_back(data.LastUse, id);
+      }
+    }
+    std::sort(candidates.begin(), candidates.end());
+    for (const auto& [lastUse, id] : candidates)
+    {
+      if (this->LoadedMemory <= budget)
+      {
+        break;
+      }
+      this->LoadedMemory -= this->Loaded[id].GetMemorySize();
+      this->Loaded.erase(id);
+    }
+  }
+
+  /**
+   * Queue the selected nodes that are not loaded yet for the worker thread
+   */
+  void RequestMissingNodes(const std::string& fileName)
+  {
+    {
+      const std::lock_guard<std::mutex> lock(this->Mutex);
+      this->Requests.clear();
+      for (int id : this->Selection)
+      {
+        if (this->Loaded.count(id) == 0)
+        {
+          this->Requests.emplace_back(id);
+        }
+      }
+      if (this->Requests.empty())
+      {
+        return;
+      }
+    }
+
+    if (!this->Worker.joinable())
+    {
+      this->Stop = false;
+      this->Worker = std::thread(&Internals::ReadRequests, this, fileName);
+    }
+    this->Condition.notify_one();
+  }
+
+  /**
+   * Worker thread loop, read the requested nodes in order until stopped
+   */
+  void ReadRequests(std::string fileName)
+  {
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    while (true)
+    {
+      this->Condition.wait(lock, [this]() { return this->Stop || !this->Requests.empty(); });
+      if (this->Stop)
+      {
+        return;
+      }
+      int id = this->Requests.front();
+      this->Requests.pop_front();
+      if (this->Loaded.count(id) > 0)
+      {
+        continue;
+      }
+
+      lock.unlock();
+      ::NodeData data;
+      bool read = this->ReadNodeData(fileName, id, data);
+      lock.lock();
+
+      // An unreadable node is kept empty so that it is not requested again
+      if (!read)
+      {
+        data = ::NodeData();
+      }
+      this->Insert(id, std::move(data));
+      this->NewNodes = true;
+    }
+  }
+
+  void StopWorker()
+  {
+    if (this->Worker.joinable())
+    {
+      {
+        const std::lock_guard<std::mutex> lock(this->Mutex);
+        this->Stop = true;
+        this->Requests.clear();
+      }
+      this->Condition.notify_one();
+      this->Worker.join();
+    }
+  }
+
+  std::string IndexedFileName;
+  bool HasColors = false;
+  uint64_t NbPoints = 0;
+  std::vector<::Node> Nodes;
+
+  // Nodes selected for the current camera, and the ones in the current output
+  std::vector<int> Selection;
+  std::vector<int> Displayed;
+  bool Executed = false;
+
+  // Loaded nodes, also modified by the worker thread
+  std::mutex Mutex;
+  std::unordered_map<int, ::NodeData> Loaded;
+  size_t LoadedMemory = 0;
+  uint64_t Clock = 0;
+
+  std::thread Worker;
+  std::condition_variable Condition;
+  std::deque<int> Requests;
+  bool Stop = false;
+  std::atomic<bool> NewNodes = false;
+};
+
+//----------------------------------------------------------------------------
+vtkStandardNewMacro(vtkF3DOctreePointCloud);
+
+//----------------------------------------------------------------------------
+vtkF3DOctreePointCloud::vtkF3DOctreePointCloud()
+  : Pimpl(std::make_unique<Internals>())
+{
+  this->SetNumberOfInputPorts(0);
+}
+
+//----------------------------------------------------------------------------
+vtkF3DOctreePointCloud::~vtkF3DOctreePointCloud()
+{
+  this->SetRenderer(nullptr);
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DOctreePointCloud::BuildOctree(
+  vtkPolyData* input, const std::string& filePath, vtkIdType nodeCapacity)
+{
+  vtkIdType nbPoints = input ? input->GetNumberOfPoints() : 0;
+  if (nbPoints == 0 || nodeCapacity <= 0)
+  {
+    return false;
+  }
+
+  vtkPoints* points = input->GetPoints();
+  vtkUnsignedCharArray* scalars =
+    vtkUnsignedCharArray::SafeDownCast(input->GetPointData()->GetScalars());
+  if (scalars && scalars->GetNumberOfComponents() != 3 && scalars->GetNumberOfComponents() != 4)
+  {
+    scalars = nullptr;
+  }
+
+  double bounds[6];
+  points->GetBounds(bounds);
+  ::Node root;
+  root.Size = 0.0;
+  for (int i = 0; i < 3; i++)
+  {
+    root.Origin[i] = bounds[2 * i];
+    root.Size = std::max(root.Size, bounds[2 * i + 1] - bounds[2 * i]);
+  }
+  root.Size = root.Size > 0.0 ? root.Size : 1.0;
+  root.Level = 0;
+  root.Children.fill(-1);
+
+  vtksys::SystemTools::MakeDirectory(vtksys::SystemTools::GetFilenamePath(filePath));
+  const std::string tmpPath = filePath + ".tmp";
+  vtksys::ofstream file(tmpPath.c_str(), std::ios::binary);
+  if (!file.is_open())
+  {
+    return false;
+  }
+
+  // The header is written again once the node table offset is known
+  ::WriteHeader(file, scalars != nullptr, 0, 0, nbPoints, bounds);
+
+  // Nodes are processed breadth first, so that coarse levels are stored first
+  std::vector<::Node> nodes = { root };
+  std::deque<std::vector<vtkIdType>> pending(1, std::vector<vtkIdType>(nbPoints));
+  std::iota(pending.front().begin(), pending.front().end(), 0);
+
+  constexpr int g = ::GridResolution;
+  std::vector<bool> occupied;
+  std::vector<float> nodePoints;
+  std::vector<unsigned char> nodeColors;
+  for (size_t nodeIndex = 0; nodeIndex < nodes.size(); nodeIndex++)
+  {
+    std::vector<vtkIdType> ids = std::move(pending.front());
+    pending.pop_front();
+    const ::Node node = nodes[nodeIndex];
+
+    // Keep the first point of each grid cell, the other points go to the children
+    std::vector<vtkIdType> kept;
+    std::array<std::vector<vtkIdType>, 8> octants;
+    if (static_cast<vtkIdType>(ids.size()) <= nodeCapacity || node.Level >= ::MaxLevel)
+    {
+      kept = std::move(ids);
+    }
+    else
+    {
+      occupied.assign(static_cast<size_t>(g) * g * g, false);
+      const double cellSize = node.Size / g;
+      for (vtkIdType id : ids)
+      {
+        double point[3];
+        points->GetPoint(id, point);
+        int cell[3];
+        for (int i = 0; i < 3; i++)
+        {
+          cell[i] = std::clamp(static_cast<int>((point[i] - node.Origin[i]) / cellSize), 0, g - 1);
+        }
+        size_t cellIndex = (static_cast<size_t>(cell[2]) * g + cell[1]) * g + cell[0];
+        if (!occupied[cellIndex] && static_cast<vtkIdType>(kept.size()) < nodeCapacity)
+        {
+          occupied[cellIndex] = true;
+          kept.emplace_back(id);
+        }
+        else
+        {
+          int octant = (cell[0] >= g / 2 ? 1 : 0) | (cell[1] >= g / 2 ? 2 : 0) |
+            (cell[2] >= g / 2 ? 4 : 0);
+          octants[octant].emplace_back(id);
+        }
+      }
+    }
+
+    nodePoints.resize(3 * kept.size());
+    nodeColors.resize(scalars ? 4 * kept.size() : 0);
+    for (size_t i = 0; i < kept.size(); i++)
+    {
+      double point[3];
+      points->GetPoint(kept[i], point);
+      std::copy(point, point + 3, nodePoints.begin() + 3 * i);
+      if (scalars)
+      {
+        unsigned char color[4] = { 0, 0, 0, 255 };
+        scalars->GetTypedTuple(kept[i], color);
+        std::copy(color, color + 4, nodeColors.begin() + 4 * i);
+      }
+    }
+    nodes[nodeIndex].Offset = static_cast<uint64_t>(file.tellp());
+    nodes[nodeIndex].Count = kept.size();
+    file.write(reinterpret_cast<const char*>(nodePoints.data()),
+      static_cast<std::streamsize>(nodePoints.size() * sizeof(float)));
+    file.write(reinterpret_cast<const char*>(nodeColors.data()),
+      static_cast<std::streamsize>(nodeColors.size()));
+
+    for (int octant = 0; octant < 8; octant++)
+    {
+      if (octants[octant].empty())
+      {
+        continue;
+      }
+      ::Node child;
+      child.Size = node.Size / 2.0;
+      for (int i = 0; i < 3; i++)
+      {
+        child.Origin[i] = node.Origin[i] + (((octant >> i) & 1) ? child.Size : 0.0);
+      }
+      child.Level = node.Level + 1;
+      child.Children.fill(-1);
+      nodes[nodeIndex].Children[octant] = static_cast<int32_t>(nodes.size());
+      nodes.emplace_back(child);
+      pending.emplace_back(std::move(octants[octant]));
+    }
+  }
+
+  uint64_t tableOffset = static_cast<uint64_t>(file.tellp());
+  for (const ::Node& node : nodes)
+  {
+    ::WriteNode(file, node);
+  }
+  file.seekp(0);
+  ::WriteHeader(file, scalars != nullptr, nodes.size(), tableOffset, nbPoints, bounds);
+  file.close();
+
+  if (!file || std::rename(tmpPath.c_str(), filePath.c_str()) != 0)
+  {
+    vtksys::SystemTools::RemoveFile(tmpPath);
+    return false;
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+std::string vtkF3DOctreePointCloud::GetCacheFileName(const std::string& filePath)
+{
+  std::string directory = vtkF3DCache::GetDirectory();
+  if (directory.empty())
+  {
+    return "";
+  }
+
+  // The whole file is not hashed as it can be very large
+  std::string key = vtksys::SystemTools::CollapseFullPath(filePath) + ";" +
+    std::to_string(vtksys::SystemTools::FileLength(filePath)) + ";" +
+    std::to_string(vtksys::SystemTools::ModifiedTime(filePath)) + ";" +
+    std::to_string(::Version);
+
+  vtksysMD5* md5 = vtksysMD5_New();
+  vtksysMD5_Initialize(md5);
+  vtksysMD5_Append(
+    md5, reinterpret_cast<const unsigned char*>(key.data()), static_cast<int>(key.size()));
+  unsigned char digest[16];
+  char md5Hash[33];
+  md5Hash[32] = '\0';
+  vtksysMD5_Finalize(md5, digest);
+  vtksysMD5_DigestToHex(digest, md5Hash);
+  vtksysMD5_Delete(md5);
+
+  return directory + "/pointclouds/" + md5Hash + ".octree";
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DOctreePointCloud::SetRenderer(vtkRenderer* renderer)
+{
+  if (this->Renderer == renderer)
+  {
+    return;
+  }
+  if (this->Renderer)
+  {
+    this->Renderer->RemoveObserver(this->ObserverId);
+  }
+  this->Renderer = renderer;
+  if (renderer)
+  {
+    vtkNew<vtkCallbackCommand> callback;
+    callback->SetClientData(this);
+    callback->SetCallback([](vtkObject*, unsigned long, void* clientData, void*)
+      { static_cast<vtkF3DOctreePointCloud*>(clientData)->UpdateSelection(); });
+    this->ObserverId = renderer->AddObserver(vtkCommand::StartEvent, callback);
+  }
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DOctreePointCloud::SetAsyncLoading(bool async)
+{
+  this->AsyncLoading = async;
+  if (!async)
+  {
+    this->Pimpl->StopWorker();
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DOctreePointCloud::UpdateSelection()
+{
+  // The first output may be computed on another thread, before being added to the renderer
+  if (!this->Pimpl->Executed)
+  {
+    return false;
+  }
+
+  std::vector<int> selection =
+    this->Pimpl->ComputeSelection(this->Renderer, this->PointBudget, this->ScreenSpaceError);
+  {
+    const std::lock_guard<std::mutex> lock(this->Pimpl->Mutex);
+    this->Pimpl->Selection = std::move(selection);
+  }
+
+  // Asynchronously, the output only changes once missing nodes have been read
+  bool changed = false;
+  if (this->AsyncLoading)
+  {
+    this->Pimpl->RequestMissingNodes(this->FileName);
+    changed = this->Pimpl->GetLoadedSelection() != this->Pimpl->Displayed;
+  }
+  else
+  {
+    changed = this->Pimpl->Selection != this->Pimpl->Displayed;
+  }
+
+  if (!changed)
+  {
+    return false;
+  }
+  this->Modified();
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DOctreePointCloud::ConsumeNewNodes()
+{
+  return this->Pimpl->NewNodes.exchange(false);
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkF3DOctreePointCloud::GetNumberOfNodes()
+{
+  return static_cast<vtkIdType>(this->Pimpl->Nodes.size());
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkF3DOctreePointCloud::GetNumberOfPointsInFile()
+{
+  return static_cast<vtkIdType>(this->Pimpl->NbPoints);
+}
+
+//----------------------------------------------------------------------------
+int vtkF3DOctreePointCloud::RequestData(
+  vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector)
+{
+  vtkPolyData* output = vtkPolyData::GetData(outputVector->GetInformationObject(0));
+  Internals& internals = *this->Pimpl;
+
+  if (internals.IndexedFileName != this->FileName)
+  {
+    internals.StopWorker();
+    internals.Loaded.clear();
+    internals.LoadedMemory = 0;
+    internals.Displayed.clear();
+    internals.Executed = false;
+    internals.IndexedFileName = this->FileName;
+    if (!internals.ReadIndex(this->FileName))
+    {
+      vtkErrorMacro("Cannot read the point cloud octree " << this->FileName);
+      internals.IndexedFileName.clear();
+      return 0;
+    }
+  }
+
+  // The first output is always read synchronously so that the bounds are known,
+  // and does not depend on the camera as it may be computed on another thread
+  const bool async = this->AsyncLoading && internals.Executed;
+  if (!internals.Executed)
+  {
+    internals.Selection =
+      internals.ComputeSelection(nullptr, this->PointBudget, this->ScreenSpaceError);
+  }
+
+  if (async)
+  {
+    internals.RequestMissingNodes(this->FileName);
+  }
+  else
+  {
+    for (int id : internals.Selection)
+    {
+      if (internals.Loaded.count(id) == 0)
+      {
+        ::NodeData data;
+        if (!internals.ReadNodeData(this->FileName, id, data))
+        {
+          vtkWarningMacro("Cannot read node " << id << " of " << this->FileName);
+          data = ::NodeData();
+        }
+        const std::lock_guard<std::mutex> lock(internals.Mutex);
+        internals.Insert(id, std::move(data));
+      }
+    }
+  }
+
+  const std::lock_guard<std::mutex> lock(internals.Mutex);
+  internals.Displayed.clear();
+  vtkIdType nbPoints = 0;
+  internals.Clock++;
+  for (int id : internals.Selection)
+  {
+    auto it = internals.Loaded.find(id);
+    if (it != internals.Loaded.end())
+    {
+      it->second.LastUse = internals.Clock;
+      internals.Displayed.emplace_back(id);
+      nbPoints += static_cast<vtkIdType>(it->second.Points.size() / 3);
+    }
+  }
+
+  vtkNew<vtkFloatArray> positions;
+  positions->SetNumberOfComponents(3);
+  positions->SetNumberOfTuples(nbPoints);
+  vtkNew<vtkUnsignedCharArray> colors;
+  colors->SetName("Colors");
+  colors->SetNumberOfComponents(4);
+  colors->SetNumberOfTuples(internals.HasColors ? nbPoints : 0);
+
+  vtkIdType offset = 0;
+  for (int id : internals.Displayed)
+  {
+    const ::NodeData& data = internals.Loaded[id];
+    std::copy(data.Points.begin(), data.Points.end(), positions->GetPointer(3 * offset));
+    if (internals.HasColors)
+    {
+      std::copy(data.Colors.begin(), data.Colors.end(), colors->GetPointer(4 * offset));
+    }
+    offset += static_cast<vtkIdType>(data.Points.size() / 3);
+  }
+
+  vtkNew<vtkPoints> points;
+  points->SetData(positions);
+  output->SetPoints(points);
+  if (internals.HasColors)
+  {
+    output->GetPointData()->SetScalars(colors);
+  }
+
+  internals.Evict(static_cast<size_t>(std::max(this->MemoryBudget, 0)) * 1024 * 1024);
+  internals.Executed = true;
+  return 1;
+}
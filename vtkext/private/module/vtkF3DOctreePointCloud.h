@@ -0,0 +1,148 @@
+/**
+ * @class   vtkF3DOctreePointCloud
+ * @brief   Stream the visible nodes of a point cloud octree stored on disk
+ *
+ * BuildOctree indexes a point cloud into a multi-resolution octree file: each node keeps a grid
+ * sampled subset of its points and the remaining points are distributed to its children, so that
+ * a node and all its ancestors are a coarse but complete representation of the node volume.
+ *
+ * This source reads such a file and outputs the points of the nodes selected for the renderer
+ * camera, by decreasing screen space error, skipping nodes outside of the view frustum, until
+ * the point budget is reached. The selection is updated before each render of the renderer.
+ * Loaded nodes are kept in a least recently used cache bounded by the memory budget.
+ * When asynchronous loading is enabled, missing nodes are read by a worker thread and their
+ * ancestors are shown in the meantime, use ConsumeNewNodes to know when to render again.
+ *
+ * Only the positions and the RGB(A) unsigned char scalars of the points are kept.
+ */
+
+#ifndef vtkF3DOctreePointCloud_h
+#define vtkF3DOctreePointCloud_h
+
+#include <vtkPolyDataAlgorithm.h>
+#include <vtkWeakPointer.h>
+
+#include <memory>
+#include <string>
+
+class vtkPolyData;
+class vtkRenderer;
+
+class vtkF3DOctreePointCloud : public vtkPolyDataAlgorithm
+{
+public:
+  static vtkF3DOctreePointCloud* New();
+  vtkTypeMacro(vtkF3DOctreePointCloud, vtkPolyDataAlgorithm);
+
+  /**
+   * Index the points of the provided point cloud into an octree file.
+   * nodeCapacity is the maximum number of points of a node.
+   * The file is written atomically. Returns false if the file cannot be written.
+   */
+  static bool BuildOctree(vtkPolyData* input, const std::string& filePath, vtkIdType nodeCapacity);
+
+  /**
+   * Return the path of the octree file of the provided point cloud file in the vtkF3DCache
+   * directory, which depends on the file path, size and modification time.
+   * Returns an empty string if there is no cache directory.
+   */
+  static std::string GetCacheFileName(const std::string& filePath);
+
+  ///@{
+  /**
+   * Set/Get the octree file to read.
+   */
+  vtkSetMacro(FileName, std::string);
+  vtkGetMacro(FileName, std::string);
+  ///@}
+
+  /**
+   * Set the renderer whose camera is used to select the nodes, the selection is updated
+   * before each of its renders.
+   * Without a renderer, the coarsest levels are selected until the point budget is reached.
+   */
+  void SetRenderer(vtkRenderer* renderer);
+
+  ///@{
+  /**
+   * Set/Get the maximum number of points to output.
+   * Default is 5000000.
+   */
+  vtkSetMacro(PointBudget, vtkIdType);
+  vtkGetMacro(PointBudget, vtkIdType);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the maximum memory used by the loaded nodes, in MiB.
+   * Nodes that are selected are never discarded.
+   * Default is 1024.
+   */
+  vtkSetMacro(MemoryBudget, int);
+  vtkGetMacro(MemoryBudget, int);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the screen space error, in pixels, under which the children of a node are not
+   * selected. It is the projected distance between the points of a node.
+   * Default is 1.
+   */
+  vtkSetMacro(ScreenSpaceError, double);
+  vtkGetMacro(ScreenSpaceError, double);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get if missing nodes are read by a worker thread instead of during the update.
+   * Default is false.
+   */
+  void SetAsyncLoading(bool async);
+  vtkGetMacro(AsyncLoading, bool);
+  ///@}
+
+  /**
+   * Update the selected nodes for the renderer camera and call Modified if the output changes.
+   * Called before each render of the renderer, once the output has been computed once.
+   * Returns true if the output changed.
+   */
+  bool UpdateSelection();
+
+  /**
+   * Return true if nodes have been read by the worker thread since the last call,
+   * in which case the renderer should render again to show them.
+   * Thread safe.
+   */
+  bool ConsumeNewNodes();
+
+  ///@{
+  /**
+   * Get the number of nodes and points of the octree, only valid once updated.
+   */
+  vtkIdType GetNumberOfNodes();
+  vtkIdType GetNumberOfPointsInFile();
+  ///@}
+
+protected:
+  vtkF3DOctreePointCloud();
+  ~vtkF3DOctreePointCloud() override;
+
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+
+private:
+  vtkF3DOctreePointCloud(const vtkF3DOctreePointCloud&) = delete;
+  void operator=(const vtkF3DOctreePointCloud&) = delete;
+
+  std::string FileName;
+  vtkWeakPointer<vtkRenderer> Renderer;
+  unsigned long ObserverId = 0;
+  vtkIdType PointBudget = 5000000;
+  int MemoryBudget = 1024;
+  double ScreenSpaceError = 1.0;
+  bool AsyncLoading = false;
+
+  struct Internals;
+  std::unique_ptr<Internals> Pimpl;
+};
+
+#endif
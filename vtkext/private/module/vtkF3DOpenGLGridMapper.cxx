@@ -40,6 +40,8 @@ void vtkF3DOpenGLGridMapper::ReplaceShaderValues(
   std::string VSSource = shaders[vtkShader::Vertex]->GetSource();
   std::string FSSource = shaders[vtkShader::Fragment]->GetSource();
 
+  // the up axis is the only parameter baked in the shader, the others are uniforms
+  this->ShaderUpIndex = this->UpIndex;
   const std::string axes3d = this->UpIndex == 0 ? "zyx" : this->UpIndex == 1 ? "xzy" : "xyz";
   const std::string axes2d = this->UpIndex == 0 ? "zy" : this->UpIndex == 1 ? "xz" : "xy";
 
@@ -236,5 +238,6 @@ bool vtkF3DOpenGLGridMapper::GetNeedToRebuildShaders(
   vtkOpenGLHelper& cellBO, vtkRenderer* vtkNotUsed(ren), vtkActor* act)
 {
   vtkMTimeType renderPassMTime = this->GetRenderPassStageMTime(act, &cellBO);
-  return cellBO.Program == nullptr || cellBO.ShaderSourceTime < renderPassMTime;
+  return cellBO.Program == nullptr || cellBO.ShaderSourceTime < renderPassMTime ||
+    this->ShaderUpIndex != this->UpIndex;
 }
@@ -2,6 +2,9 @@
  * @class   vtkF3DOpenGLGridMapper
  * @brief   A mapper which display an infinite plane
  *
+ * The grid lines are computed in the fragment shader, with a density adapted to the screen space
+ * derivatives. All parameters but the up axis are uniforms, so changing them does not rebuild
+ * the shader.
  */
 
 #ifndef vtkF3DOpenGLGridMapper_h
@@ -69,6 +72,7 @@ protected:
   double UnitSquare = 1.0;
   int Subdivisions = 10;
   int UpIndex = 1;
+  int ShaderUpIndex = -1;
 };
 
 #endif
@@ -2,29 +2,259 @@
 
 #include "vtkF3DBitonicSort.h"
 #include "vtkF3DComputeDepthCS.h"
+#include "vtkF3DPointSpritesInstancesFS.h"
+#include "vtkF3DPointSpritesInstancesVS.h"
+#include "vtkF3DRadixSort.h"
 
 #include <vtkCamera.h>
+#include <vtkFloatArray.h>
+#include <vtkInformation.h>
+#include <vtkMatrix3x3.h>
+#include <vtkMatrix4x4.h>
 #include <vtkObjectFactory.h>
+#include <vtkOpenGLActor.h>
 #include <vtkOpenGLBufferObject.h>
+#include <vtkOpenGLCamera.h>
 #include <vtkOpenGLIndexBufferObject.h>
 #include <vtkOpenGLPointGaussianMapperHelper.h>
+#include <vtkOpenGLRenderPass.h>
 #include <vtkOpenGLRenderWindow.h>
 #include <vtkOpenGLRenderer.h>
 #include <vtkOpenGLShaderCache.h>
 #include <vtkOpenGLState.h>
+#include <vtkOpenGLVertexArrayObject.h>
 #include <vtkOpenGLVertexBufferObject.h>
 #include <vtkOpenGLVertexBufferObjectGroup.h>
+#include <vtkPointData.h>
 #include <vtkPolyData.h>
+#include <vtkProperty.h>
+#include <vtkRenderWindowInteractor.h>
+#include <vtkSMPTools.h>
 #include <vtkShader.h>
 #include <vtkShaderProgram.h>
+#include <vtkTextureObject.h>
+#include <vtkUnsignedCharArray.h>
 #include <vtkVersion.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <future>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
 #if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240914)
 #include <vtk_glad.h>
 #else
 #include <vtk_glew.h>
 #endif
 
+//----------------------------------------------------------------------------
+namespace
+{
+// Evaluate the spherical harmonics of degree 1 to 3 in the view direction, stored in a texture
+// buffer with the RGB values of each coefficient of each splat, like the 3DGS reference renderer
+constexpr const char* SphericalHarmonicsImpl = R"(
+  if (sphericalHarmonicsCoeffs > 0)
+  {
+    vec3 dir = normalize(vertexMC.xyz - cameraPositionMC);
+    float x = dir.x;
+    float y = dir.y;
+    float z = dir.z;
+    int base = gl_VertexID * sphericalHarmonicsCoeffs * 3;
+    vec3 sh[15];
+    for (int i = 0; i < sphericalHarmonicsCoeffs; i++)
+    {
+      sh[i] = vec3(texelFetch(sphericalHarmonics, base + 3 * i).r,
+        texelFetch(sphericalHarmonics, base + 3 * i + 1).r,
+        texelFetch(sphericalHarmonics, base + 3 * i + 2).r);
+    }
+    vec3 color = -0.4886025 * y * sh[0] + 0.4886025 * z * sh[1] - 0.4886025 * x * sh[2];
+    if (sphericalHarmonicsCoeffs > 3)
+    {
+      float xx = x * x, yy = y * y, zz = z * z;
+      color += 1.0925484 * x * y * sh[3] - 1.0925484 * y * z * sh[4] +
+        0.3153916 * (2.0 * zz - xx - yy) * sh[5] - 1.0925484 * x * z * sh[6] +
+        0.5462742 * (xx - yy) * sh[7];
+      if (sphericalHarmonicsCoeffs > 8)
+      {
+        color += -0.5900436 * y * (3.0 * xx - yy) * sh[8] + 2.8906114 * x * y * z * sh[9] -
+          0.4570458 * y * (4.0 * zz - xx - yy) * sh[10] +
+          0.3731763 * z * (2.0 * zz - 3.0 * xx - 3.0 * yy) * sh[11] -
+          0.4570458 * x * (4.0 * zz - xx - yy) * sh[12] + 1.4453057 * z * (xx - yy) * sh[13] -
+          0.5900436 * x * (xx - 3.0 * yy) * sh[14];
+      }
+    }
+    vertexColorVSOutput.rgb = clamp(vertexColorVSOutput.rgb + color, 0.0, 1.0);
+  }
+)";
+
+//----------------------------------------------------------------------------
+void CopyBuffer(vtkOpenGLBufferObject* src, vtkOpenGLBufferObject* dst, size_t size)
+{
+  glBindBuffer(GL_COPY_READ_BUFFER, src->GetHandle());
+  glBindBuffer(GL_COPY_WRITE_BUFFER, dst->GetHandle());
+  glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, size);
+  glBindBuffer(GL_COPY_READ_BUFFER, 0);
+  glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+  glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_ELEMENT_ARRAY_BARRIER_BIT);
+}
+
+//----------------------------------------------------------------------------
+// Copy the ranges of indices of src, given as offset and count, contiguously to dst
+void CopyRanges(vtkOpenGLBufferObject* src, vtkOpenGLBufferObject* dst,
+  const std::vector<std::pair<vtkIdType, vtkIdType>>& ranges)
+{
+  glBindBuffer(GL_COPY_READ_BUFFER, src->GetHandle());
+  glBindBuffer(GL_COPY_WRITE_BUFFER, dst->GetHandle());
+  GLintptr dstOffset = 0;
+  for (const auto& range : ranges)
+  {
+    const GLsizeiptr size = static_cast<GLsizeiptr>(range.second * sizeof(unsigned int));
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER,
+      static_cast<GLintptr>(range.first * sizeof(unsigned int)), dstOffset, size);
+    dstOffset += size;
+  }
+  glBindBuffer(GL_COPY_READ_BUFFER, 0);
+  glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+  glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_ELEMENT_ARRAY_BARRIER_BIT);
+}
+
+//----------------------------------------------------------------------------
+// Spread the 10 lower bits of x every 3 bits to interleave the Morton code coordinates
+uint32_t SpreadBits(uint32_t x)
+{
+  x &= 0x000003ff;
+  x = (x ^ (x << 16)) & 0xff0000ff;
+  x = (x ^ (x << 8)) & 0x0300f00f;
+  x = (x ^ (x << 4)) & 0x030c30c3;
+  x = (x ^ (x << 2)) & 0x09249249;
+  return x;
+}
+
+//----------------------------------------------------------------------------
+// Convert a float to an IEEE half float, rounded to the nearest, like packHalf2x16 in GLSL
+uint32_t FloatToHalf(float value)
+{
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  const uint32_t sign = (bits >> 16) & 0x8000;
+  const int exponent = static_cast<int>((bits >> 23) & 0xff) - 127 + 15;
+  uint32_t mantissa = bits & 0x7fffff;
+
+  if (exponent <= 0)
+  {
+    // subnormal half, or zero if too small
+    if (exponent < -10)
+    {
+      return sign;
+    }
+    mantissa |= 0x800000;
+    const int shift = 14 - exponent;
+    return sign | ((mantissa + (1u << (shift - 1))) >> shift);
+  }
+  if (exponent >= 31)
+  {
+    return sign | 0x7c00;
+  }
+
+  // a carry of the rounding correctly increments the exponent
+  return sign | ((static_cast<uint32_t>(exponent) << 10) + ((mantissa + 0x1000) >> 13));
+}
+
+//----------------------------------------------------------------------------
+// Pack two floats as halves, the first one in the lower bits, like packHalf2x16 in GLSL
+uint32_t PackHalf2(double x, double y)
+{
+  return ::FloatToHalf(static_cast<float>(x)) | (::FloatToHalf(static_cast<float>(y)) << 16);
+}
+
+//----------------------------------------------------------------------------
+// Pack two values of [-1, 1] as snorm16, the first one in the lower bits, like packSnorm2x16
+uint32_t PackSnorm2(double x, double y)
+{
+  auto snorm = [](double v)
+  {
+    const long value = std::lround(std::clamp(v, -1.0, 1.0) * 32767.0);
+    return static_cast<uint32_t>(static_cast<uint16_t>(static_cast<int16_t>(value)));
+  };
+  return snorm(x) | (snorm(y) << 16);
+}
+
+//----------------------------------------------------------------------------
+// Convert a float to an unsigned key with the same order, negative values being reversed
+uint32_t FloatToSortableKey(float value)
+{
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+}
+
+//----------------------------------------------------------------------------
+// Sort the values by their keys with a stable LSD radix sort of 8 bits digits. The histograms
+// and the scatter of each pass are computed by blocks in parallel.
+void RadixSort(std::vector<uint32_t>& keys, std::vector<unsigned int>& values)
+{
+  constexpr vtkIdType blockSize = 1 << 16;
+  const vtkIdType count = static_cast<vtkIdType>(keys.size());
+  const vtkIdType nbBlocks = (count + blockSize - 1) / blockSize;
+  std::vector<uint32_t> tmpKeys(keys.size());
+  std::vector<unsigned int> tmpValues(values.size());
+  std::vector<vtkIdType> offsets(nbBlocks * 256);
+
+  for (int shift = 0; shift < 32; shift += 8)
+  {
+    std::fill(offsets.begin(), offsets.end(), 0);
+    vtkSMPTools::For(0, nbBlocks, 1,
+      [&](vtkIdType first, vtkIdType last)
+      {
+        for (vtkIdType b = first; b < last; b++)
+        {
+          vtkIdType* histogram = offsets.data() + 256 * b;
+          for (vtkIdType i = b * blockSize; i < std::min(count, (b + 1) * blockSize); i++)
+          {
+            histogram[(keys[i] >> shift) & 0xff]++;
+          }
+        }
+      });
+
+    // the offsets are accumulated digit by digit, then block by block, to keep the sort stable
+    vtkIdType sum = 0;
+    for (int digit = 0; digit < 256; digit++)
+    {
+      for (vtkIdType b = 0; b < nbBlocks; b++)
+      {
+        const vtkIdType size = offsets[256 * b + digit];
+        offsets[256 * b + digit] = sum;
+        sum += size;
+      }
+    }
+
+    vtkSMPTools::For(0, nbBlocks, 1,
+      [&](vtkIdType first, vtkIdType last)
+      {
+        for (vtkIdType b = first; b < last; b++)
+        {
+          vtkIdType* offset = offsets.data() + 256 * b;
+          for (vtkIdType i = b * blockSize; i < std::min(count, (b + 1) * blockSize); i++)
+          {
+            const vtkIdType dst = offset[(keys[i] >> shift) & 0xff]++;
+            tmpKeys[dst] = keys[i];
+            tmpValues[dst] = values[i];
+          }
+        }
+      });
+
+    keys.swap(tmpKeys);
+    values.swap(tmpValues);
+  }
+}
+}
+
 //----------------------------------------------------------------------------
 class vtkF3DSplatMapperHelper : public vtkOpenGLPointGaussianMapperHelper
 {
@@ -32,29 +262,160 @@ public:
   static vtkF3DSplatMapperHelper* New();
   vtkTypeMacro(vtkF3DSplatMapperHelper, vtkOpenGLPointGaussianMapperHelper);
 
+  /**
+   * Return true if a sort spread across frames or running in the background is not finished
+   */
+  bool IsSortPending() const;
+
   vtkF3DSplatMapperHelper(const vtkF3DSplatMapperHelper&) = delete;
   void operator=(const vtkF3DSplatMapperHelper&) = delete;
 
 protected:
   vtkF3DSplatMapperHelper();
+  ~vtkF3DSplatMapperHelper() override;
 
-  // overridden to create the OpenGL depth buffer
+  // overridden to create the OpenGL depth buffer, and the buffers of the instanced splats
   void BuildBufferObjects(vtkRenderer* ren, vtkActor* act) override;
 
+  // overridden to rebuild the buffers when the splats are drawn with or without instancing
+  bool GetNeedToRebuildBufferObjects(vtkRenderer* ren, vtkActor* act) override;
+
   // overridden to sort splats
   void RenderPieceDraw(vtkRenderer* ren, vtkActor* act) override;
 
+  // overridden to evaluate the spherical harmonics in the vertex shader
+  void ReplaceShaderValues(
+    std::map<vtkShader::Type, vtkShader*> shaders, vtkRenderer* ren, vtkActor* act) override;
+
+  // overridden to map the scalars to colors in the shaders
+  void ReplaceShaderColor(
+    std::map<vtkShader::Type, vtkShader*> shaders, vtkRenderer* ren, vtkActor* act) override;
+  void SetMapperShaderParameters(vtkOpenGLHelper& cellBO, vtkRenderer* ren, vtkActor* act) override;
+
+  void ReleaseGraphicsResources(vtkWindow* win) override;
+
 private:
-  void SortSplats(vtkRenderer* ren);
+  struct SplatChunk
+  {
+    double Bounds[6];
+    double Center[3];
+    vtkIdType Offset;
+    vtkIdType Count;
+  };
+
+  void SortSplats(vtkRenderer* ren, vtkActor* act);
+
+  /**
+   * Sort the splats on the CPU when compute shaders are not used, see UseComputeSort.
+   * While interacting, the sort runs on a background thread and the previous order is drawn
+   * until it is finished.
+   */
+  void SortSplatsOnCPU(vtkRenderer* ren, vtkActor* act);
+
+  /**
+   * Wait for the CPU sort in progress, if any, and upload its indices to the IBO
+   */
+  void FinishCPUSort();
+
+  /**
+   * Return true if the splats are sorted with compute shaders, see
+   * vtkF3DPointSplatMapper::SetComputeSort
+   */
+  bool UseComputeSort();
+
+  /**
+   * Return the index buffer drawn, the one of the instances or the IBO of the VTK helper
+   */
+  vtkOpenGLIndexBufferObject* GetDrawnIndices();
+
+  /**
+   * Return true if the splats of the actor can be drawn as instances, see
+   * vtkF3DPointSplatMapper::SetInstancing
+   */
+  bool UseInstancing(vtkActor* act);
+
+  /**
+   * Upload the positions and the packed attributes of the splats read by the instances
+   */
+  void BuildInstanceBuffers(vtkPolyData* poly);
+
+  /**
+   * Draw a quad instance for each splat index of the instance indices
+   */
+  void RenderInstances(vtkRenderer* ren, vtkActor* act);
+
+  void SetSphericalHarmonicsParameters(vtkShaderProgram* program, vtkRenderer* ren, vtkActor* act);
+
+  /**
+   * Group the splats in the cells of a regular grid, ordered along a Morton curve,
+   * and upload the indices of the splats in the chunk order
+   */
+  void BuildChunks(vtkPolyData* poly);
+
+  /**
+   * Return the sorted ids of the chunks intersecting the view frustum
+   */
+  std::vector<size_t> CullChunks(vtkRenderer* ren, vtkActor* act);
+
+  /**
+   * Return the ranges of indices of the visible chunks, as offset and count, sorted back to front
+   * so the splats are almost sorted before the sort, and their total number of indices.
+   */
+  std::vector<std::pair<vtkIdType, vtkIdType>> GetVisibleRanges(
+    const double direction[3], vtkIdType& count);
+
+  /**
+   * Copy the indices of the visible chunks, sorted back to front, to the given buffer.
+   * Return the number of copied indices.
+   */
+  int CompactVisibleChunks(const double direction[3], vtkOpenGLBufferObject* indices);
 
   vtkNew<vtkShader> DepthComputeShader;
   vtkNew<vtkShaderProgram> DepthProgram;
   vtkNew<vtkOpenGLBufferObject> DepthBuffer;
 
   vtkNew<vtkF3DBitonicSort> Sorter;
+  vtkNew<vtkF3DRadixSort> RadixSorter;
+
+  // The radix sort is used when it can be initialized and run, the bitonic sort otherwise
+  bool UseRadixSort = false;
+
+  // Indices being sorted by the radix sort, copied to the IBO once the sort is finished
+  vtkNew<vtkOpenGLBufferObject> SortedIndices;
+  bool SortPending = false;
+  int PendingCount = 0;
+
+  // Indices of the splats ordered by chunk, and the chunks visible in the last sort
+  std::vector<SplatChunk> Chunks;
+  vtkNew<vtkOpenGLBufferObject> ChunkedIndices;
+  std::vector<size_t> VisibleChunks;
 
   double DirectionThreshold = 0.999;
   double LastDirection[3] = { 0.0, 0.0, 0.0 };
+
+  // Positions and chunk ordered indices of the splats kept on the CPU when compute shaders are
+  // not used, read by the CPU sort running in the background
+  bool ComputeSorted = true;
+  std::vector<float> CPUPositions;
+  std::vector<unsigned int> CPUChunkedIndices;
+  std::future<std::vector<unsigned int>> CPUSort;
+
+  // Spherical harmonics coefficients of the splats, read in the vertex shader
+  vtkNew<vtkOpenGLBufferObject> SphericalHarmonicsBuffer;
+  vtkNew<vtkTextureObject> SphericalHarmonicsTexture;
+  int SphericalHarmonicsCoeffs = 0;
+
+  // Buffers of the splats drawn as instances, the indices are sorted like the IBO otherwise
+  bool Instanced = false;
+  bool InstancedGaussians = false;
+  int AttributeStride = 1;
+  float InstanceRadius = 1.f;
+  bool HasInstanceColors = false;
+  vtkNew<vtkOpenGLBufferObject> InstancePositions;
+  vtkNew<vtkOpenGLBufferObject> InstanceAttributes;
+  vtkNew<vtkOpenGLIndexBufferObject> InstanceIndices;
+  vtkNew<vtkShaderProgram> InstanceProgram;
+  vtkNew<vtkOpenGLVertexArrayObject> InstanceVAO;
 };
 
 //----------------------------------------------------------------------------
@@ -68,6 +429,66 @@ vtkF3DSplatMapperHelper::vtkF3DSplatMapperHelper()
   this->DepthProgram->SetComputeShader(this->DepthComputeShader);
 
   this->Sorter->Initialize(512, VTK_FLOAT, VTK_UNSIGNED_INT);
+  this->UseRadixSort = this->RadixSorter->Initialize(256, VTK_FLOAT, VTK_UNSIGNED_INT);
+
+  // the spherical harmonics are evaluated for the splat of the instance
+  std::string harmonics = ::SphericalHarmonicsImpl;
+  vtkShaderProgram::Substitute(harmonics, "gl_VertexID", "int(splatId)");
+  std::string instanceVS = vtkF3DPointSpritesInstancesVS;
+  vtkShaderProgram::Substitute(instanceVS, "//F3D::SphericalHarmonics::Impl", harmonics);
+  this->InstanceProgram->GetVertexShader()->SetSource(instanceVS);
+  this->InstanceProgram->GetFragmentShader()->SetSource(vtkF3DPointSpritesInstancesFS);
+}
+
+//----------------------------------------------------------------------------
+vtkF3DSplatMapperHelper::~vtkF3DSplatMapperHelper()
+{
+  // the CPU sort reads the positions and indices of the helper
+  if (this->CPUSort.valid())
+  {
+    this->CPUSort.wait();
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DSplatMapperHelper::UseInstancing(vtkActor* act)
+{
+  vtkF3DPointSplatMapper* owner = vtkF3DPointSplatMapper::SafeDownCast(this->Owner);
+  if (!owner || !owner->GetInstancing() || !vtkShader::IsComputeShaderSupported())
+  {
+    return false;
+  }
+
+  // the render passes and the shader coloring modify the shaders of the VTK helper
+  vtkInformation* keys = act->GetPropertyKeys();
+  if ((keys && keys->Has(vtkOpenGLRenderPass::RenderPasses())) ||
+    owner->GetShaderColoring().IsUsed(this->CurrentInput))
+  {
+    return false;
+  }
+
+  return !owner->GetScaleFunction() && !owner->GetScalarOpacityFunction() &&
+    !owner->GetOpacityArray() && owner->GetScaleFactor() != 0.0;
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DSplatMapperHelper::UseComputeSort()
+{
+  vtkF3DPointSplatMapper* owner = vtkF3DPointSplatMapper::SafeDownCast(this->Owner);
+  return (!owner || owner->GetComputeSort()) && vtkShader::IsComputeShaderSupported();
+}
+
+//----------------------------------------------------------------------------
+vtkOpenGLIndexBufferObject* vtkF3DSplatMapperHelper::GetDrawnIndices()
+{
+  return this->Instanced ? this->InstanceIndices.Get() : this->Primitives[PrimitivePoints].IBO;
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DSplatMapperHelper::GetNeedToRebuildBufferObjects(vtkRenderer* ren, vtkActor* act)
+{
+  return this->Superclass::GetNeedToRebuildBufferObjects(ren, act) ||
+    this->Instanced != this->UseInstancing(act) || this->ComputeSorted != this->UseComputeSort();
 }
 
 //----------------------------------------------------------------------------
@@ -82,19 +503,524 @@ void vtkF3DSplatMapperHelper::BuildBufferObjects(vtkRenderer* ren, vtkActor* act
 
   int splatCount = poly->GetPoints()->GetNumberOfPoints();
 
-  vtkOpenGLPointGaussianMapperHelper::BuildBufferObjects(ren, act);
+  this->Instanced = this->UseInstancing(act);
+  if (this->Instanced)
+  {
+    // the vertex buffers of the VTK helper are not used, only the instance buffers are uploaded
+    this->VBOs->ReleaseGraphicsResources(ren->GetRenderWindow());
+    this->BuildInstanceBuffers(poly);
+    this->VBOBuildTime.Modified();
+  }
+  else
+  {
+    this->InstancePositions->ReleaseGraphicsResources();
+    this->InstanceAttributes->ReleaseGraphicsResources();
+    this->InstanceIndices->ReleaseGraphicsResources();
+    vtkOpenGLPointGaussianMapperHelper::BuildBufferObjects(ren, act);
+  }
 
   this->DepthBuffer->Allocate(splatCount * sizeof(float), vtkOpenGLBufferObject::ArrayBuffer,
     vtkOpenGLBufferObject::DynamicCopy);
+
+  if (this->UseRadixSort)
+  {
+    this->SortedIndices->Allocate(splatCount * sizeof(unsigned int),
+      vtkOpenGLBufferObject::ArrayBuffer, vtkOpenGLBufferObject::DynamicCopy);
+  }
+
+  // the buffers are rebuilt, a sort in progress is not valid anymore
+  this->SortPending = false;
+  if (this->CPUSort.valid())
+  {
+    this->CPUSort.wait();
+    this->CPUSort = {};
+  }
+  this->LastDirection[0] = this->LastDirection[1] = this->LastDirection[2] = 0.0;
+
+  this->ComputeSorted = this->UseComputeSort();
+  this->BuildChunks(poly);
+
+  this->CPUPositions.clear();
+  if (!this->ComputeSorted)
+  {
+    vtkPoints* points = poly->GetPoints();
+    this->CPUPositions.resize(3 * static_cast<size_t>(splatCount));
+    vtkSMPTools::For(0, splatCount,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        double p[3];
+        for (vtkIdType i = begin; i < end; i++)
+        {
+          points->GetPoint(i, p);
+          this->CPUPositions[3 * i] = static_cast<float>(p[0]);
+          this->CPUPositions[3 * i + 1] = static_cast<float>(p[1]);
+          this->CPUPositions[3 * i + 2] = static_cast<float>(p[2]);
+        }
+      });
+  }
+
+  if (this->Instanced)
+  {
+    // all the splats are drawn until they are culled and sorted
+    this->InstanceIndices->Allocate(splatCount * sizeof(unsigned int),
+      vtkOpenGLBufferObject::ArrayBuffer, vtkOpenGLBufferObject::DynamicCopy);
+    ::CopyBuffer(this->ChunkedIndices, this->InstanceIndices, splatCount * sizeof(unsigned int));
+    this->InstanceIndices->IndexCount = splatCount;
+  }
+
+  // the coefficients are only uploaded, in a texture buffer indexed by the vertex id
+  this->SphericalHarmonicsCoeffs = 0;
+  vtkFloatArray* harmonics =
+    vtkFloatArray::SafeDownCast(poly->GetPointData()->GetArray("spherical_harmonics"));
+  if (harmonics && harmonics->GetNumberOfTuples() == splatCount &&
+    harmonics->GetNumberOfComponents() % 3 == 0)
+  {
+    vtkOpenGLRenderWindow* renWin = vtkOpenGLRenderWindow::SafeDownCast(ren->GetRenderWindow());
+    const vtkIdType nbValues = harmonics->GetNumberOfValues();
+    this->SphericalHarmonicsTexture->SetContext(renWin);
+    if (this->SphericalHarmonicsBuffer->Upload(
+          harmonics->GetPointer(0), nbValues, vtkOpenGLBufferObject::TextureBuffer) &&
+      this->SphericalHarmonicsTexture->CreateTextureBuffer(
+        static_cast<unsigned int>(nbValues), 1, VTK_FLOAT, this->SphericalHarmonicsBuffer))
+    {
+      this->SphericalHarmonicsCoeffs = harmonics->GetNumberOfComponents() / 3;
+    }
+  }
 }
 
 //----------------------------------------------------------------------------
-void vtkF3DSplatMapperHelper::SortSplats(vtkRenderer* ren)
+void vtkF3DSplatMapperHelper::BuildInstanceBuffers(vtkPolyData* poly)
 {
-  int numVerts = this->VBOs->GetNumberOfTuples("vertexMC");
+  vtkF3DPointSplatMapper* owner = static_cast<vtkF3DPointSplatMapper*>(this->Owner);
+  vtkPoints* points = poly->GetPoints();
+  const vtkIdType nbSplats = points->GetNumberOfPoints();
 
-  if (numVerts)
+  // the positions have the layout of the vertexMC VBO, read by the depth compute shader
+  vtkFloatArray* floatPoints = vtkFloatArray::SafeDownCast(points->GetData());
+  if (floatPoints)
   {
+    this->InstancePositions->Upload(
+      floatPoints->GetPointer(0), 3 * nbSplats, vtkOpenGLBufferObject::ArrayBuffer);
+  }
+  else
+  {
+    std::vector<float> positions(3 * nbSplats);
+    vtkSMPTools::For(0, nbSplats,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        double p[3];
+        for (vtkIdType i = begin; i < end; i++)
+        {
+          points->GetPoint(i, p);
+          positions[3 * i] = static_cast<float>(p[0]);
+          positions[3 * i + 1] = static_cast<float>(p[1]);
+          positions[3 * i + 2] = static_cast<float>(p[2]);
+        }
+      });
+    this->InstancePositions->Upload(positions, vtkOpenGLBufferObject::ArrayBuffer);
+  }
+
+  vtkUnsignedCharArray* colors = this->MapScalars(poly, 1.0);
+  this->HasInstanceColors = colors && colors->GetNumberOfComponents() == 4;
+
+  // the default shader is the gaussian one, F3D only provides the sphere one otherwise
+  const char* splatCode = owner->GetSplatShaderCode();
+  this->InstancedGaussians = !splatCode || splatCode[0] == '\0';
+
+  vtkPointData* pointData = poly->GetPointData();
+  vtkDataArray* scales =
+    owner->GetScaleArray() ? pointData->GetArray(owner->GetScaleArray()) : nullptr;
+  vtkDataArray* rotations =
+    owner->GetRotationArray() ? pointData->GetArray(owner->GetRotationArray()) : nullptr;
+  const bool anisotropic = this->InstancedGaussians && owner->GetAnisotropic() && scales &&
+    scales->GetNumberOfComponents() == 3 && rotations && rotations->GetNumberOfComponents() == 4;
+  const int scaleComponent = scales
+    ? std::clamp(owner->GetScaleArrayComponent(), 0, scales->GetNumberOfComponents() - 1)
+    : 0;
+  const double scaleFactor = owner->GetScaleFactor();
+
+  // without a scale array, the radius of the spheres is a uniform
+  this->InstanceRadius = static_cast<float>(scaleFactor);
+  this->AttributeStride = this->InstancedGaussians ? 5 : (scales ? 2 : 1);
+  const int stride = this->AttributeStride;
+
+  std::vector<uint32_t> attributes(static_cast<size_t>(nbSplats) * stride, 0);
+  vtkSMPTools::For(0, nbSplats,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      double scale[3];
+      double rotation[4];
+      for (vtkIdType i = begin; i < end; i++)
+      {
+        uint32_t* splat = attributes.data() + static_cast<size_t>(i) * stride;
+        if (this->HasInstanceColors)
+        {
+          const unsigned char* rgba = colors->GetPointer(4 * i);
+          splat[0] = static_cast<uint32_t>(rgba[0]) | (static_cast<uint32_t>(rgba[1]) << 8) |
+            (static_cast<uint32_t>(rgba[2]) << 16) | (static_cast<uint32_t>(rgba[3]) << 24);
+        }
+
+        const double radius =
+          scales ? scaleFactor * std::abs(scales->GetComponent(i, scaleComponent)) : scaleFactor;
+        if (!this->InstancedGaussians)
+        {
+          if (stride > 1)
+          {
+            const float value = static_cast<float>(radius);
+            std::memcpy(splat + 1, &value, sizeof(value));
+          }
+          continue;
+        }
+
+        if (anisotropic)
+        {
+          scales->GetTuple(i, scale);
+          rotations->GetTuple(i, rotation);
+          for (double& s : scale)
+          {
+            s *= scaleFactor;
+          }
+          const double norm = std::sqrt(rotation[0] * rotation[0] + rotation[1] * rotation[1] +
+            rotation[2] * rotation[2] + rotation[3] * rotation[3]);
+          for (double& r : rotation)
+          {
+            r = norm > 0.0 ? r / norm : 0.0;
+          }
+        }
+        else
+        {
+          scale[0] = scale[1] = scale[2] = radius;
+          rotation[0] = 1.0;
+          rotation[1] = rotation[2] = rotation[3] = 0.0;
+        }
+
+        // the packed quaternion is normalized again in the shader
+        splat[1] = ::PackHalf2(scale[0], scale[1]);
+        splat[2] = ::PackHalf2(scale[2], 0.0);
+        splat[3] = ::PackSnorm2(rotation[0], rotation[1]);
+        splat[4] = ::PackSnorm2(rotation[2], rotation[3]);
+      }
+    });
+  this->InstanceAttributes->Upload(attributes, vtkOpenGLBufferObject::ArrayBuffer);
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DSplatMapperHelper::BuildChunks(vtkPolyData* poly)
+{
+  this->Chunks.clear();
+  this->VisibleChunks.clear();
+
+  vtkPoints* points = poly->GetPoints();
+  const vtkIdType nbSplats = points->GetNumberOfPoints();
+  vtkF3DPointSplatMapper* owner = vtkF3DPointSplatMapper::SafeDownCast(this->Owner);
+  const int chunkSize = owner ? owner->GetChunkSize() : 0;
+
+  // a grid cell contains around chunkSize splats if they are evenly distributed
+  int resolution = 1;
+  if (chunkSize > 0 && nbSplats > chunkSize)
+  {
+    resolution = static_cast<int>(std::ceil(std::cbrt(static_cast<double>(nbSplats) / chunkSize)));
+    resolution = std::min(resolution, 1024);
+  }
+
+  double bounds[6];
+  points->GetBounds(bounds);
+
+  std::vector<std::pair<uint32_t, unsigned int>> codes(nbSplats);
+  vtkSMPTools::For(0, nbSplats,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      double p[3];
+      for (vtkIdType i = begin; i < end; i++)
+      {
+        points->GetPoint(i, p);
+        uint32_t cell[3];
+        for (int k = 0; k < 3; k++)
+        {
+          const double extent = bounds[2 * k + 1] - bounds[2 * k];
+          const int c =
+            extent > 0.0 ? static_cast<int>((p[k] - bounds[2 * k]) / extent * resolution) : 0;
+          cell[k] = static_cast<uint32_t>(std::clamp(c, 0, resolution - 1));
+        }
+        codes[i] = { ::SpreadBits(cell[0]) | (::SpreadBits(cell[1]) << 1) |
+            (::SpreadBits(cell[2]) << 2),
+          static_cast<unsigned int>(i) };
+      }
+    });
+  vtkSMPTools::Sort(codes.begin(), codes.end());
+
+  // the bounds of the chunks are padded by the radius of their largest splat
+  vtkDataArray* scales = owner && owner->GetScaleArray()
+    ? poly->GetPointData()->GetArray(owner->GetScaleArray())
+    : nullptr;
+  const double scaleFactor = owner ? owner->GetScaleFactor() : 1.0;
+  std::vector<double> radiuses;
+
+  std::vector<unsigned int> order(nbSplats);
+  for (vtkIdType i = 0; i < nbSplats; i++)
+  {
+    order[i] = codes[i].second;
+
+    double p[3];
+    points->GetPoint(codes[i].second, p);
+    if (i == 0 || codes[i].first != codes[i - 1].first)
+    {
+      this->Chunks.push_back({ { p[0], p[0], p[1], p[1], p[2], p[2] }, {}, i, 0 });
+      radiuses.emplace_back(scales ? 0.0 : scaleFactor);
+    }
+
+    if (scales)
+    {
+      // the gaussians are drawn up to three standard deviations
+      for (int k = 0; k < scales->GetNumberOfComponents(); k++)
+      {
+        radiuses.back() = std::max(
+          radiuses.back(), 3.0 * scaleFactor * std::abs(scales->GetComponent(codes[i].second, k)));
+      }
+    }
+
+    SplatChunk& chunk = this->Chunks.back();
+    for (int k = 0; k < 3; k++)
+    {
+      chunk.Bounds[2 * k] = std::min(chunk.Bounds[2 * k], p[k]);
+      chunk.Bounds[2 * k + 1] = std::max(chunk.Bounds[2 * k + 1], p[k]);
+    }
+    chunk.Count++;
+  }
+
+  for (size_t c = 0; c < this->Chunks.size(); c++)
+  {
+    SplatChunk& chunk = this->Chunks[c];
+    for (int k = 0; k < 3; k++)
+    {
+      chunk.Bounds[2 * k] -= radiuses[c];
+      chunk.Bounds[2 * k + 1] += radiuses[c];
+      chunk.Center[k] = 0.5 * (chunk.Bounds[2 * k] + chunk.Bounds[2 * k + 1]);
+    }
+  }
+
+  this->ChunkedIndices->Upload(order, vtkOpenGLBufferObject::ArrayBuffer);
+
+  // the CPU sort does not read back the GPU buffers
+  this->CPUChunkedIndices.clear();
+  if (!this->ComputeSorted)
+  {
+    this->CPUChunkedIndices = std::move(order);
+  }
+}
+
+//----------------------------------------------------------------------------
+std::vector<size_t> vtkF3DSplatMapperHelper::CullChunks(vtkRenderer* ren, vtkActor* act)
+{
+  double planes[24];
+  ren->GetActiveCamera()->GetFrustumPlanes(ren->GetTiledAspectRatio(), planes);
+
+  // the planes are transformed in model coordinates, their normals point inside the frustum
+  vtkMatrix4x4* matrix = act->GetMatrix();
+  double modelPlanes[6][4];
+  for (int k = 0; k < 6; k++)
+  {
+    for (int j = 0; j < 4; j++)
+    {
+      modelPlanes[k][j] = 0.0;
+      for (int i = 0; i < 4; i++)
+      {
+        modelPlanes[k][j] += matrix->GetElement(i, j) * planes[4 * k + i];
+      }
+    }
+  }
+
+  std::vector<size_t> visible;
+  for (size_t c = 0; c < this->Chunks.size(); c++)
+  {
+    const double* b = this->Chunks[c].Bounds;
+    bool inside = true;
+    for (int k = 0; k < 6 && inside; k++)
+    {
+      // the corner of the bounds the furthest along the normal
+      const double* plane = modelPlanes[k];
+      const double x = plane[0] >= 0.0 ? b[1] : b[0];
+      const double y = plane[1] >= 0.0 ? b[3] : b[2];
+      const double z = plane[2] >= 0.0 ? b[5] : b[4];
+      inside = plane[0] * x + plane[1] * y + plane[2] * z + plane[3] >= 0.0;
+    }
+    if (inside)
+    {
+      visible.emplace_back(c);
+    }
+  }
+  return visible;
+}
+
+//----------------------------------------------------------------------------
+std::vector<std::pair<vtkIdType, vtkIdType>> vtkF3DSplatMapperHelper::GetVisibleRanges(
+  const double direction[3], vtkIdType& count)
+{
+  std::vector<std::pair<double, size_t>> depths;
+  depths.reserve(this->VisibleChunks.size());
+  for (size_t c : this->VisibleChunks)
+  {
+    depths.emplace_back(vtkMath::Dot(direction, this->Chunks[c].Center), c);
+  }
+  std::sort(depths.begin(), depths.end());
+
+  std::vector<std::pair<vtkIdType, vtkIdType>> ranges;
+  count = 0;
+  for (const auto& depth : depths)
+  {
+    const SplatChunk& chunk = this->Chunks[depth.second];
+    if (!ranges.empty() && ranges.back().first + ranges.back().second == chunk.Offset)
+    {
+      ranges.back().second += chunk.Count;
+    }
+    else
+    {
+      ranges.emplace_back(chunk.Offset, chunk.Count);
+    }
+    count += chunk.Count;
+  }
+  return ranges;
+}
+
+//----------------------------------------------------------------------------
+int vtkF3DSplatMapperHelper::CompactVisibleChunks(
+  const double direction[3], vtkOpenGLBufferObject* indices)
+{
+  // the chunks are copied back to front, so the splats are almost sorted before the sort
+  vtkIdType count = 0;
+  std::vector<std::pair<vtkIdType, vtkIdType>> ranges = this->GetVisibleRanges(direction, count);
+  if (count > 0)
+  {
+    ::CopyRanges(this->ChunkedIndices, indices, ranges);
+  }
+  return static_cast<int>(count);
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DSplatMapperHelper::ReplaceShaderValues(
+  std::map<vtkShader::Type, vtkShader*> shaders, vtkRenderer* ren, vtkActor* act)
+{
+  this->Superclass::ReplaceShaderValues(shaders, ren, act);
+
+  if (this->SphericalHarmonicsCoeffs > 0)
+  {
+    std::string VSSource = shaders[vtkShader::Vertex]->GetSource();
+    vtkShaderProgram::Substitute(VSSource, "//VTK::Color::Dec",
+      "//VTK::Color::Dec\n"
+      "uniform samplerBuffer sphericalHarmonics;\n"
+      "uniform int sphericalHarmonicsCoeffs;\n"
+      "uniform vec3 cameraPositionMC;\n");
+
+    // the view dependent color is added to the color of degree 0, once it is set
+    vtkShaderProgram::Substitute(VSSource, "vertexColorVSOutput = scalarColor;",
+      std::string("vertexColorVSOutput = scalarColor;\n") + ::SphericalHarmonicsImpl);
+    shaders[vtkShader::Vertex]->SetSource(VSSource);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DSplatMapperHelper::ReplaceShaderColor(
+  std::map<vtkShader::Type, vtkShader*> shaders, vtkRenderer* ren, vtkActor* act)
+{
+  // inserted before the splat shader code, which shapes the colors provided by the lookup table
+  F3DShaderColoring& coloring =
+    static_cast<vtkF3DPointSplatMapper*>(this->Owner)->GetShaderColoring();
+  if (coloring.IsUsed(this->CurrentInput))
+  {
+    F3DShaderColoring::ReplaceShaderValues(shaders);
+  }
+
+  this->Superclass::ReplaceShaderColor(shaders, ren, act);
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DSplatMapperHelper::SetMapperShaderParameters(
+  vtkOpenGLHelper& cellBO, vtkRenderer* ren, vtkActor* act)
+{
+  this->Superclass::SetMapperShaderParameters(cellBO, ren, act);
+
+  F3DShaderColoring& coloring =
+    static_cast<vtkF3DPointSplatMapper*>(this->Owner)->GetShaderColoring();
+  if (coloring.IsUsed(this->CurrentInput))
+  {
+    coloring.SetShaderParameters(
+      cellBO.Program, vtkOpenGLRenderWindow::SafeDownCast(ren->GetRenderWindow()));
+  }
+
+  this->SetSphericalHarmonicsParameters(cellBO.Program, ren, act);
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DSplatMapperHelper::SetSphericalHarmonicsParameters(
+  vtkShaderProgram* program, vtkRenderer* ren, vtkActor* act)
+{
+  if (this->SphericalHarmonicsCoeffs > 0 && program->IsUniformUsed("sphericalHarmonics"))
+  {
+    this->SphericalHarmonicsTexture->Activate();
+    program->SetUniformi("sphericalHarmonics", this->SphericalHarmonicsTexture->GetTextureUnit());
+    program->SetUniformi("sphericalHarmonicsCoeffs", this->SphericalHarmonicsCoeffs);
+
+    // the view direction of each splat is computed in model coordinates
+    vtkNew<vtkMatrix4x4> inverse;
+    vtkMatrix4x4::Invert(act->GetMatrix(), inverse);
+    double position[4] = { 0.0, 0.0, 0.0, 1.0 };
+    ren->GetActiveCamera()->GetPosition(position);
+    inverse->MultiplyPoint(position, position);
+    float positionMC[3] = { static_cast<float>(position[0] / position[3]),
+      static_cast<float>(position[1] / position[3]),
+      static_cast<float>(position[2] / position[3]) };
+    program->SetUniform3f("cameraPositionMC", positionMC);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DSplatMapperHelper::ReleaseGraphicsResources(vtkWindow* win)
+{
+  this->InstanceProgram->ReleaseGraphicsResources(win);
+  this->InstanceVAO->ReleaseGraphicsResources();
+  this->InstancePositions->ReleaseGraphicsResources();
+  this->InstanceAttributes->ReleaseGraphicsResources();
+  this->InstanceIndices->ReleaseGraphicsResources();
+  this->Instanced = false;
+  this->SphericalHarmonicsTexture->ReleaseGraphicsResources(win);
+  this->SphericalHarmonicsBuffer->ReleaseGraphicsResources();
+  this->SphericalHarmonicsCoeffs = 0;
+  this->ChunkedIndices->ReleaseGraphicsResources();
+  this->Chunks.clear();
+  this->VisibleChunks.clear();
+  if (this->CPUSort.valid())
+  {
+    this->CPUSort.wait();
+    this->CPUSort = {};
+  }
+  this->Superclass::ReleaseGraphicsResources(win);
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DSplatMapperHelper::SortSplats(vtkRenderer* ren, vtkActor* act)
+{
+  // the instances read the same positions and indices as the VTK helper
+  int numVerts = this->Instanced ? this->CurrentInput->GetNumberOfPoints()
+                                 : this->VBOs->GetNumberOfTuples("vertexMC");
+
+  if (numVerts && !this->Chunks.empty())
+  {
+    vtkOpenGLRenderWindow* renWin = vtkOpenGLRenderWindow::SafeDownCast(ren->GetRenderWindow());
+    vtkOpenGLIndexBufferObject* ibo = this->GetDrawnIndices();
+    vtkOpenGLBufferObject* positions = this->Instanced
+      ? static_cast<vtkOpenGLBufferObject*>(this->InstancePositions)
+      : this->VBOs->GetVBO("vertexMC");
+
+    // the sort is only spread across frames while interacting, still renders are fully sorted
+    int budget = 0;
+    vtkRenderWindowInteractor* iren = renWin->GetInteractor();
+    vtkF3DPointSplatMapper* owner = vtkF3DPointSplatMapper::SafeDownCast(this->Owner);
+    if (this->UseRadixSort && owner && iren &&
+      renWin->GetDesiredUpdateRate() > iren->GetStillUpdateRate())
+    {
+      budget = owner->GetSortBudget();
+    }
+
     double* focalPoint = ren->GetActiveCamera()->GetFocalPoint();
     double* origin = ren->GetActiveCamera()->GetPosition();
     double direction[3];
@@ -107,14 +1033,38 @@ void vtkF3DSplatMapperHelper::SortSplats(vtkRenderer* ren)
 
     vtkMath::Normalize(direction);
 
-    // sort the splats only if the camera direction has changed
-    if (vtkMath::Dot(this->LastDirection, direction) < this->DirectionThreshold)
+    std::vector<size_t> visibleChunks = this->CullChunks(ren, act);
+    const bool viewChanged =
+      vtkMath::Dot(this->LastDirection, direction) < this->DirectionThreshold ||
+      visibleChunks != this->VisibleChunks;
+
+    // a still render must be correctly sorted, drop an outdated sort in progress
+    if (this->SortPending && budget <= 0 && viewChanged)
     {
-      vtkOpenGLShaderCache* shaderCache =
-        vtkOpenGLRenderWindow::SafeDownCast(ren->GetRenderWindow())->GetShaderCache();
+      this->SortPending = false;
+    }
+
+    // sort the splats only if the camera direction or the visible chunks have changed
+    // and if there is no sort still in progress from a previous frame
+    if (!this->SortPending && viewChanged)
+    {
+      vtkOpenGLShaderCache* shaderCache = renWin->GetShaderCache();
 
-      // compute next power of two
-      unsigned int numVertsExt = vtkMath::NearestPowerOfTwo(numVerts);
+      // the radix sort works on a copy of the indices so the previous ordering
+      // can still be rendered while the sort is spread across several frames
+      vtkOpenGLBufferObject* indices = this->UseRadixSort ? this->SortedIndices : ibo;
+
+      // only the splats of the visible chunks are sorted and drawn
+      this->VisibleChunks = std::move(visibleChunks);
+      const int visibleCount = this->CompactVisibleChunks(direction, indices);
+      if (visibleCount == 0)
+      {
+        this->LastDirection[0] = direction[0];
+        this->LastDirection[1] = direction[1];
+        this->LastDirection[2] = direction[2];
+        ibo->IndexCount = 0;
+        return;
+      }
 
       // depth computation
       shaderCache->ReadyShaderProgram(this->DepthProgram);
@@ -124,30 +1074,283 @@ void vtkF3DSplatMapperHelper::SortSplats(vtkRenderer* ren)
       this->LastDirection[2] = direction[2];
 
       this->DepthProgram->SetUniform3f("viewDirection", direction);
-      this->DepthProgram->SetUniformi("count", numVerts);
-      this->VBOs->GetVBO("vertexMC")->BindShaderStorage(0);
-      this->Primitives[PrimitivePoints].IBO->BindShaderStorage(1);
+      this->DepthProgram->SetUniformi("count", visibleCount);
+      positions->BindShaderStorage(0);
+      indices->BindShaderStorage(1);
       this->DepthBuffer->BindShaderStorage(2);
 
-      glDispatchCompute(numVertsExt / 32, 1, 1);
+      glDispatchCompute((visibleCount + 31) / 32, 1, 1);
       glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
 
-      // sort
-      this->Sorter->Run(vtkOpenGLRenderWindow::SafeDownCast(ren->GetRenderWindow()), numVerts,
-        this->DepthBuffer, this->Primitives[PrimitivePoints].IBO);
+      if (!this->UseRadixSort)
+      {
+        this->Sorter->Run(renWin, visibleCount, this->DepthBuffer, ibo);
+        ibo->IndexCount = visibleCount;
+        return;
+      }
+
+      this->RadixSorter->ResetIncremental();
+      this->SortPending = true;
+      this->PendingCount = visibleCount;
+    }
+
+    if (this->SortPending)
+    {
+      // the radix sort does not need any padding to a power of two
+      bool finished = false;
+      if (!this->RadixSorter->RunIncremental(
+            renWin, this->PendingCount, this->DepthBuffer, this->SortedIndices, budget, finished))
+      {
+        // do not try again, the required shaders are not supported
+        // reset the direction to sort again with the bitonic sort on next frame
+        this->UseRadixSort = false;
+        this->SortPending = false;
+        this->LastDirection[0] = this->LastDirection[1] = this->LastDirection[2] = 0.0;
+        this->VisibleChunks.clear();
+        return;
+      }
+
+      if (finished)
+      {
+        ::CopyBuffer(this->SortedIndices, ibo, this->PendingCount * sizeof(unsigned int));
+        ibo->IndexCount = this->PendingCount;
+        this->SortPending = false;
+      }
     }
   }
 }
 
+//----------------------------------------------------------------------------
+bool vtkF3DSplatMapperHelper::IsSortPending() const
+{
+  return this->SortPending || this->CPUSort.valid();
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DSplatMapperHelper::FinishCPUSort()
+{
+  if (this->CPUSort.valid())
+  {
+    const std::vector<unsigned int> indices = this->CPUSort.get();
+    vtkOpenGLIndexBufferObject* ibo = this->GetDrawnIndices();
+    ibo->Upload(indices, vtkOpenGLBufferObject::ElementArrayBuffer);
+    ibo->IndexCount = indices.size();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DSplatMapperHelper::SortSplatsOnCPU(vtkRenderer* ren, vtkActor* act)
+{
+  const vtkIdType numVerts = static_cast<vtkIdType>(this->CPUPositions.size() / 3);
+  if (numVerts == 0 || this->Chunks.empty() ||
+    this->CPUChunkedIndices.size() != static_cast<size_t>(numVerts))
+  {
+    return;
+  }
+
+  // the sort is only done in the background while interacting, still renders are fully sorted
+  vtkRenderWindow* renWin = ren->GetRenderWindow();
+  vtkRenderWindowInteractor* iren = renWin->GetInteractor();
+  const bool interactive = iren && renWin->GetDesiredUpdateRate() > iren->GetStillUpdateRate();
+
+  // upload the indices of a finished sort, the previous order is drawn otherwise
+  if (this->CPUSort.valid() &&
+    (!interactive ||
+      this->CPUSort.wait_for(std::chrono::seconds(0)) == std::future_status::ready))
+  {
+    this->FinishCPUSort();
+  }
+
+  double* focalPoint = ren->GetActiveCamera()->GetFocalPoint();
+  double* origin = ren->GetActiveCamera()->GetPosition();
+  double direction[3];
+  for (int i = 0; i < 3; ++i)
+  {
+    // the orientation is reverted to sort splats back to front
+    direction[i] = origin[i] - focalPoint[i];
+  }
+  vtkMath::Normalize(direction);
+
+  std::vector<size_t> visibleChunks = this->CullChunks(ren, act);
+  const bool viewChanged =
+    vtkMath::Dot(this->LastDirection, direction) < this->DirectionThreshold ||
+    visibleChunks != this->VisibleChunks;
+  if (this->CPUSort.valid() || !viewChanged)
+  {
+    return;
+  }
+
+  this->VisibleChunks = std::move(visibleChunks);
+  this->LastDirection[0] = direction[0];
+  this->LastDirection[1] = direction[1];
+  this->LastDirection[2] = direction[2];
+
+  vtkIdType count = 0;
+  std::vector<std::pair<vtkIdType, vtkIdType>> ranges = this->GetVisibleRanges(direction, count);
+  if (count == 0)
+  {
+    this->GetDrawnIndices()->IndexCount = 0;
+    return;
+  }
+
+  // the positions and indices are not modified until the sort is finished
+  const float viewDirection[3] = { static_cast<float>(direction[0]),
+    static_cast<float>(direction[1]), static_cast<float>(direction[2]) };
+  this->CPUSort = std::async(std::launch::async,
+    [this, ranges = std::move(ranges), count, viewDirection]()
+    {
+      std::vector<unsigned int> indices;
+      indices.reserve(count);
+      for (const auto& range : ranges)
+      {
+        indices.insert(indices.end(), this->CPUChunkedIndices.begin() + range.first,
+          this->CPUChunkedIndices.begin() + range.first + range.second);
+      }
+
+      std::vector<uint32_t> keys(count);
+      vtkSMPTools::For(0, count,
+        [&](vtkIdType begin, vtkIdType end)
+        {
+          for (vtkIdType i = begin; i < end; i++)
+          {
+            const float* p = this->CPUPositions.data() + 3 * static_cast<size_t>(indices[i]);
+            keys[i] = ::FloatToSortableKey(
+              viewDirection[0] * p[0] + viewDirection[1] * p[1] + viewDirection[2] * p[2]);
+          }
+        });
+      ::RadixSort(keys, indices);
+      return indices;
+    });
+
+  if (!interactive)
+  {
+    this->FinishCPUSort();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DSplatMapperHelper::RenderInstances(vtkRenderer* ren, vtkActor* act)
+{
+  const GLsizei count = static_cast<GLsizei>(this->InstanceIndices->IndexCount);
+  vtkOpenGLRenderWindow* renWin = vtkOpenGLRenderWindow::SafeDownCast(ren->GetRenderWindow());
+  if (count == 0 || !renWin->GetShaderCache()->ReadyShaderProgram(this->InstanceProgram))
+  {
+    return;
+  }
+  vtkShaderProgram* program = this->InstanceProgram;
+
+  // the matrices are transposed by VTK, like in vtkOpenGLPolyDataMapper
+  vtkOpenGLCamera* cam = static_cast<vtkOpenGLCamera*>(ren->GetActiveCamera());
+  vtkMatrix4x4* wcvc;
+  vtkMatrix3x3* norms;
+  vtkMatrix4x4* vcdc;
+  vtkMatrix4x4* wcdc;
+  cam->GetKeyMatrices(ren, wcvc, norms, vcdc, wcdc);
+  if (act->GetIsIdentity())
+  {
+    program->SetUniformMatrix("MCVCMatrix", wcvc);
+  }
+  else
+  {
+    vtkMatrix4x4* mcwc;
+    vtkMatrix3x3* anorms;
+    static_cast<vtkOpenGLActor*>(act)->GetKeyMatrices(mcwc, anorms);
+    vtkNew<vtkMatrix4x4> mcvc;
+    vtkMatrix4x4::Multiply4x4(mcwc, wcvc, mcvc);
+    program->SetUniformMatrix("MCVCMatrix", mcvc);
+  }
+  program->SetUniformMatrix("VCDCMatrix", vcdc);
+
+  int width, height, x, y;
+  ren->GetTiledSizeAndOrigin(&width, &height, &x, &y);
+  float viewportSize[2] = { static_cast<float>(width), static_cast<float>(height) };
+  program->SetUniform2f("viewportSize", viewportSize);
+  program->SetUniformi("parallelProjection", cam->GetParallelProjection());
+
+  vtkF3DPointSplatMapper* owner = static_cast<vtkF3DPointSplatMapper*>(this->Owner);
+  vtkProperty* property = act->GetProperty();
+  double* color = property->GetDiffuseColor();
+  float defaultColor[4] = { static_cast<float>(color[0]), static_cast<float>(color[1]),
+    static_cast<float>(color[2]), 1.f };
+  program->SetUniformi("gaussian", this->InstancedGaussians);
+  program->SetUniformi("attributeStride", this->AttributeStride);
+  program->SetUniformi("hasColors", this->HasInstanceColors);
+  program->SetUniform4f("defaultColor", defaultColor);
+  program->SetUniformf("radius", this->InstanceRadius);
+  program->SetUniformf("boundScale", static_cast<float>(owner->GetBoundScale()));
+
+  // the dilation of the reference 3DGS renderer, in squared pixels
+  program->SetUniformf("lowPass", 0.3f);
+
+  // the lighting of the VTK helper without normals
+  program->SetUniformf(
+    "intensity", static_cast<float>(property->GetAmbient() + property->GetDiffuse()));
+  program->SetUniformf("opacity", static_cast<float>(property->GetOpacity()));
+
+  this->SetSphericalHarmonicsParameters(program, ren, act);
+
+  this->InstancePositions->BindShaderStorage(0);
+  this->InstanceAttributes->BindShaderStorage(1);
+  this->InstanceIndices->BindShaderStorage(2);
+
+  // the quad has no attribute, its corners are computed from the vertex id
+  this->InstanceVAO->Bind();
+  glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, count);
+  this->InstanceVAO->Release();
+}
+
 //----------------------------------------------------------------------------
 void vtkF3DSplatMapperHelper::RenderPieceDraw(vtkRenderer* ren, vtkActor* actor)
 {
-  if (vtkShader::IsComputeShaderSupported() && actor->GetForceTranslucent())
+  const bool computeSorted = this->ComputeSorted;
+  if (computeSorted && actor->GetForceTranslucent())
+  {
+    this->SortSplats(ren, actor);
+  }
+  else if (actor->GetForceTranslucent())
+  {
+    this->SortSplatsOnCPU(ren, actor);
+  }
+  else if (!this->VisibleChunks.empty())
+  {
+    // the splats are not culled anymore, restore all the indices
+    vtkOpenGLIndexBufferObject* ibo = this->GetDrawnIndices();
+    const int numVerts = this->Instanced ? this->CurrentInput->GetNumberOfPoints()
+                                         : this->VBOs->GetNumberOfTuples("vertexMC");
+    if (computeSorted)
+    {
+      ::CopyBuffer(this->ChunkedIndices, ibo, numVerts * sizeof(unsigned int));
+    }
+    else
+    {
+      // the memory barrier of the buffer copy requires OpenGL 4.2
+      if (this->CPUSort.valid())
+      {
+        this->CPUSort.wait();
+        this->CPUSort = {};
+      }
+      ibo->Upload(this->CPUChunkedIndices, vtkOpenGLBufferObject::ElementArrayBuffer);
+    }
+    ibo->IndexCount = numVerts;
+    this->VisibleChunks.clear();
+    this->SortPending = false;
+    this->LastDirection[0] = this->LastDirection[1] = this->LastDirection[2] = 0.0;
+  }
+
+  if (this->Instanced)
   {
-    this->SortSplats(ren);
+    this->RenderInstances(ren, actor);
+  }
+  else
+  {
+    vtkOpenGLPointGaussianMapperHelper::RenderPieceDraw(ren, actor);
   }
 
-  vtkOpenGLPointGaussianMapperHelper::RenderPieceDraw(ren, actor);
+  if (this->SphericalHarmonicsCoeffs > 0)
+  {
+    this->SphericalHarmonicsTexture->Deactivate();
+  }
+  static_cast<vtkF3DPointSplatMapper*>(this->Owner)->GetShaderColoring().Deactivate();
 }
 
 //----------------------------------------------------------------------------
@@ -160,3 +1363,24 @@ vtkOpenGLPointGaussianMapperHelper* vtkF3DPointSplatMapper::CreateHelper()
 
 //----------------------------------------------------------------------------
 vtkStandardNewMacro(vtkF3DPointSplatMapper);
+
+//----------------------------------------------------------------------------
+F3DShaderColoring& vtkF3DPointSplatMapper::GetShaderColoring()
+{
+  return this->ShaderColoring;
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DPointSplatMapper::IsSortPending()
+{
+  return std::any_of(this->Helpers.begin(), this->Helpers.end(),
+    [](vtkOpenGLPointGaussianMapperHelper* helper)
+    { return static_cast<vtkF3DSplatMapperHelper*>(helper)->IsSortPending(); });
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DPointSplatMapper::ReleaseGraphicsResources(vtkWindow* win)
+{
+  this->ShaderColoring.ReleaseGraphicsResources(win);
+  this->Superclass::ReleaseGraphicsResources(win);
+}
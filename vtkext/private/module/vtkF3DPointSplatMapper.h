@@ -2,11 +2,19 @@
  * @class   vtkF3DPointSplatMapper
  * @brief   Custom F3D gaussian mapper
  *
- * This mapper is used to add a depth sort compute shader pass
+ * This mapper is used to add a depth sort compute shader pass,
+ * restricted to the spatial chunks of splats inside the view frustum.
+ * When compute shaders are not supported, eg. with OpenGL 4.1 on macOS, or not used, see
+ * SetComputeSort, the depths are sorted on the CPU with a parallel radix sort, in the background
+ * while interacting.
+ * The point scalars can also be mapped to colors in the shaders of the point sprites.
+ * The splats can also be drawn as instances of a single quad, see SetInstancing.
  */
 #ifndef vtkF3DPointSplatMapper_h
 #define vtkF3DPointSplatMapper_h
 
+#include "F3DShaderColoring.h"
+
 #include <vtkOpenGLPointGaussianMapper.h>
 #include <vtkVersion.h>
 
@@ -16,8 +24,80 @@ public:
   static vtkF3DPointSplatMapper* New();
   vtkTypeMacro(vtkF3DPointSplatMapper, vtkOpenGLPointGaussianMapper);
 
+  ///@{
+  /**
+   * Set/Get the maximum number of splats sorted per frame during interaction.
+   * When the sort is not finished, the previous ordering is rendered.
+   * 0 means the splats are entirely sorted every frame.
+   * Default is 0.
+   */
+  vtkSetMacro(SortBudget, int);
+  vtkGetMacro(SortBudget, int);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the approximate number of splats per chunk.
+   * The splats are grouped in spatial chunks, and the chunks outside of the view frustum
+   * are neither sorted nor drawn. 0 means the splats are not chunked.
+   * Default is 4096.
+   */
+  vtkSetMacro(ChunkSize, int);
+  vtkGetMacro(ChunkSize, int);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get if the splats are sorted with compute shaders when they are supported.
+   * When false, the splats are sorted on the CPU like when compute shaders are not supported.
+   * Default is true.
+   */
+  vtkSetMacro(ComputeSort, bool);
+  vtkGetMacro(ComputeSort, bool);
+  vtkBooleanMacro(ComputeSort, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get if the splats are drawn as instances of a single quad, reading the packed attributes
+   * of each splat from shader storage buffers, instead of the vertex buffers and the geometry
+   * shader of the VTK helper. The spheres and the gaussians are shaded analytically in the
+   * fragment shader, the spheres also write their exact depth.
+   * It requires shader storage buffers and is not used when a render pass or the shader
+   * coloring modify the shaders of the actor, or with scale and opacity functions.
+   * Default is false.
+   */
+  vtkSetMacro(Instancing, bool);
+  vtkGetMacro(Instancing, bool);
+  vtkBooleanMacro(Instancing, bool);
+  ///@}
+
+  /**
+   * Get the mapping of the point scalars to colors in the shaders of the point sprites.
+   * The mapper must be modified when it returns that the shaders must be rebuilt.
+   */
+  F3DShaderColoring& GetShaderColoring();
+
+  /**
+   * Return true if the sort of the splats started while interacting is not finished,
+   * the previous order being drawn. Rendering again continues or finishes the sort.
+   */
+  bool IsSortPending();
+
+  /**
+   * Release the helpers and the textures of the coloring
+   */
+  void ReleaseGraphicsResources(vtkWindow* win) override;
+
 protected:
   vtkOpenGLPointGaussianMapperHelper* CreateHelper() override;
+
+private:
+  int SortBudget = 0;
+  int ChunkSize = 4096;
+  bool ComputeSort = true;
+  bool Instancing = false;
+  F3DShaderColoring ShaderColoring;
 };
 
 #endif
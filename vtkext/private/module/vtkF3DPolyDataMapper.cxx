@@ -3,22 +3,127 @@
 #include "F3DLog.h"
 
 #include <vtkActor.h>
+#include <vtkCellArray.h>
+#include <vtkCellArrayIterator.h>
 #include <vtkDoubleArray.h>
+#include <vtkMatrix3x3.h>
 #include <vtkMatrix4x4.h>
 #include <vtkObjectFactory.h>
+#include <vtkOpenGLCamera.h>
 #include <vtkOpenGLRenderWindow.h>
 #include <vtkOpenGLRenderer.h>
+#include <vtkOpenGLState.h>
 #include <vtkOpenGLVertexBufferObject.h>
+#include <vtkOpenGLVertexBufferObjectCache.h>
 #include <vtkOpenGLVertexBufferObjectGroup.h>
 #include <vtkPointData.h>
 #include <vtkPolyData.h>
 #include <vtkProperty.h>
+#include <vtkSMPTools.h>
 #include <vtkShaderProgram.h>
 #include <vtkShaderProperty.h>
+#include <vtkSignedCharArray.h>
 #include <vtkTexture.h>
+#include <vtkTextureObject.h>
 #include <vtkUniforms.h>
+#include <vtkUnsignedShortArray.h>
 #include <vtkVersion.h>
 
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+// the largest value of the quantized positions and texture coordinates
+constexpr double COMPACT_RANGE = 65535.0;
+
+// the largest value of the octahedral normals
+constexpr double COMPACT_NORMAL_RANGE = 127.0;
+
+//-----------------------------------------------------------------------------
+double SignNotZero(double v)
+{
+  return v >= 0.0 ? 1.0 : -1.0;
+}
+
+//-----------------------------------------------------------------------------
+signed char QuantizeNormal(double v)
+{
+  return static_cast<signed char>(std::lround(std::clamp(v, -1.0, 1.0) * COMPACT_NORMAL_RANGE));
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * Quantize the components of the array in [0, COMPACT_RANGE], relative to the range of each
+ * component, and store the scale and shift decoding them
+ */
+vtkSmartPointer<vtkUnsignedShortArray> QuantizeArray(
+  vtkDataArray* array, int nbComponents, float* scale, float* shift)
+{
+  double range[3][2];
+  for (int c = 0; c < nbComponents; c++)
+  {
+    array->GetRange(range[c], c);
+    double extent = range[c][1] - range[c][0];
+    scale[c] = static_cast<float>(extent > 0.0 ? extent / COMPACT_RANGE : 1.0);
+    shift[c] = static_cast<float>(range[c][0]);
+  }
+
+  vtkNew<vtkUnsignedShortArray> quantized;
+  quantized->SetNumberOfComponents(nbComponents);
+  quantized->SetNumberOfTuples(array->GetNumberOfTuples());
+  vtkSMPTools::For(0, array->GetNumberOfTuples(),
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType i = begin; i < end; i++)
+      {
+        for (int c = 0; c < nbComponents; c++)
+        {
+          double extent = range[c][1] - range[c][0];
+          double v = extent > 0.0 ? (array->GetComponent(i, c) - range[c][0]) / extent : 0.0;
+          quantized->SetTypedComponent(i, c,
+            static_cast<unsigned short>(std::lround(std::clamp(v, 0.0, 1.0) * COMPACT_RANGE)));
+        }
+      }
+    });
+  return quantized;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * Encode the normals with an octahedral mapping in the two first components, the third one
+ * being unused but needed by the normal attribute
+ */
+vtkSmartPointer<vtkSignedCharArray> EncodeNormals(vtkDataArray* normals)
+{
+  vtkNew<vtkSignedCharArray> encoded;
+  encoded->SetNumberOfComponents(3);
+  encoded->SetNumberOfTuples(normals->GetNumberOfTuples());
+  vtkSMPTools::For(0, normals->GetNumberOfTuples(),
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType i = begin; i < end; i++)
+      {
+        double n[3];
+        normals->GetTuple(i, n);
+        double norm = std::abs(n[0]) + std::abs(n[1]) + std::abs(n[2]);
+        double x = norm > 0.0 ? n[0] / norm : 0.0;
+        double y = norm > 0.0 ? n[1] / norm : 0.0;
+        if (norm > 0.0 && n[2] < 0.0)
+        {
+          double fx = (1.0 - std::abs(y)) * ::SignNotZero(x);
+          y = (1.0 - std::abs(x)) * ::SignNotZero(y);
+          x = fx;
+        }
+        encoded->SetTypedComponent(i, 0, ::QuantizeNormal(x));
+        encoded->SetTypedComponent(i, 1, ::QuantizeNormal(y));
+        encoded->SetTypedComponent(i, 2, 0);
+      }
+    });
+  return encoded;
+}
+}
+
 vtkStandardNewMacro(vtkF3DPolyDataMapper);
 
 //-----------------------------------------------------------------------------
@@ -75,11 +180,40 @@ void vtkF3DPolyDataMapper::ReplaceShaderValues(
   std::string beginImpl;
   std::string posImpl = "  vec4 posMC = vertexMC;\n";
 
+  // the compact vertex buffers are decoded first, they are never skinned nor morphed
+  if (this->CompactPositions)
+  {
+    customDecl += "uniform vec3 compactPositionScale;\n"
+                  "uniform vec3 compactPositionShift;\n";
+    posImpl = "  vec4 posMC = vec4(vertexMC.xyz * compactPositionScale + compactPositionShift, "
+              "1.0);\n";
+  }
+  bool compactNormals = this->CompactNormals && hasNormals;
+  if (compactNormals)
+  {
+    customDecl += "vec3 compactNormal(vec2 e)\n"
+                  "{\n"
+                  "  vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));\n"
+                  "  if (n.z < 0.0)\n"
+                  "  {\n"
+                  "    vec2 s = vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);\n"
+                  "    n.xy = (1.0 - abs(n.yx)) * s;\n"
+                  "  }\n"
+                  "  return normalize(n);\n"
+                  "}\n";
+  }
+  if (this->CompactTCoords)
+  {
+    customDecl += "uniform vec2 compactTCoordScale;\n"
+                  "uniform vec2 compactTCoordShift;\n";
+  }
+
   // normals and tangents can be modified by skinnning and morphing in model space
   std::string normalImpl;
   if (hasNormals)
   {
-    normalImpl += "  normalVCVSOutput = normalMC;\n";
+    normalImpl += compactNormals ? "  normalVCVSOutput = compactNormal(normalMC.xy / 127.0);\n"
+                                 : "  normalVCVSOutput = normalMC;\n";
   }
   if (hasTangents)
   {
@@ -130,6 +264,10 @@ void vtkF3DPolyDataMapper::ReplaceShaderValues(
   }
 
   // skin
+#if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20231108)
+  this->UseJointMatricesSSBO = false;
+#endif
+  std::vector<float> hiddenJointMatrices;
   type = uniforms->GetUniformTupleType("jointMatrices");
   if (type != vtkUniforms::TupleTypeInvalid)
   {
@@ -154,13 +292,13 @@ void vtkF3DPolyDataMapper::ReplaceShaderValues(
       // 4.3 is required for SSBO
       if (major == 4 && minor >= 3)
       {
-        std::vector<float> buffer(16 * sizeof(float) * nbJoints);
-        uniforms->GetUniformMatrix4x4v("jointMatrices", buffer);
-
-        this->JointMatrices->Upload(buffer, vtkOpenGLBufferObject::ArrayBuffer);
-        this->JointMatrices->BindShaderStorage(0);
-
+        // The uniform is hidden while building the shader so it is not declared,
+        // and restored afterwards so importers can keep updating it in place without
+        // triggering a shader rebuild. It is uploaded in the SSBO before each draw.
+        uniforms->GetUniformMatrix4x4v("jointMatrices", hiddenJointMatrices);
         uniforms->RemoveUniform("jointMatrices");
+        this->UseJointMatricesSSBO = true;
+        this->JointMatricesUploadTime = 0;
 
         customDecl += "layout(std430, binding = 0) readonly buffer JointsData\n"
                       "{\n"
@@ -234,7 +372,310 @@ void vtkF3DPolyDataMapper::ReplaceShaderValues(
 
   vertexShader->SetSource(VSSource);
 
+  // the edges are drawn over the shaded triangles, after the textures are applied
+  if (this->LastBoundBO == &this->Primitives[PrimitiveTris] && this->RenderWithSurfaceEdges(actor))
+  {
+    auto fragmentShader = shaders[vtkShader::Fragment];
+    auto FSSource = fragmentShader->GetSource();
+
+    // clang-format off
+    vtkShaderProgram::Substitute(FSSource, "//VTK::CustomUniforms::Dec",
+      "//VTK::CustomUniforms::Dec\n"
+      "uniform samplerBuffer edgeTriangles;\n"
+      "uniform mat4 edgeMCDCMatrix;\n"
+      "uniform vec4 edgeViewport;\n"
+      "uniform float edgeLineWidth;\n"
+      "uniform vec3 edgeColorUniform;\n"
+      "float edgeDistance(vec2 a, vec2 b, vec2 p)\n"
+      "{\n"
+      "  vec2 ab = b - a;\n"
+      "  return abs(ab.x * (p.y - a.y) - ab.y * (p.x - a.x)) / max(length(ab), 1e-6);\n"
+      "}\n"
+    );
+    vtkShaderProgram::Substitute(FSSource, "//VTK::TCoord::Impl",
+      "//VTK::TCoord::Impl\n"
+      "  vec2 edgeCorners[3];\n"
+      "  for (int i = 0; i < 3; i++)\n"
+      "  {\n"
+      "    vec4 cornerDC = edgeMCDCMatrix * texelFetch(edgeTriangles, 3 * gl_PrimitiveID + i);\n"
+      "    edgeCorners[i] = edgeViewport.xy + (0.5 * cornerDC.xy / cornerDC.w + 0.5) * edgeViewport.zw;\n"
+      "  }\n"
+      "  float edgeDist = min(min(edgeDistance(edgeCorners[0], edgeCorners[1], gl_FragCoord.xy),\n"
+      "    edgeDistance(edgeCorners[1], edgeCorners[2], gl_FragCoord.xy)),\n"
+      "    edgeDistance(edgeCorners[2], edgeCorners[0], gl_FragCoord.xy));\n"
+      "  float edgeAlpha = clamp(0.5 + 0.5 * edgeLineWidth - edgeDist, 0.0, 1.0);\n"
+      "  gl_FragData[0].rgb = mix(gl_FragData[0].rgb, edgeColorUniform, edgeAlpha);\n"
+    );
+    // clang-format on
+
+    fragmentShader->SetSource(FSSource);
+  }
+
   this->Superclass::ReplaceShaderValues(shaders, ren, actor);
+
+  if (!hiddenJointMatrices.empty())
+  {
+    uniforms->SetUniformMatrix4x4v("jointMatrices",
+      static_cast<int>(hiddenJointMatrices.size() / 16), hiddenJointMatrices.data());
+  }
+}
+
+//-----------------------------------------------------------------------------
+void vtkF3DPolyDataMapper::SetMapperShaderParameters(
+  vtkOpenGLHelper& cellBO, vtkRenderer* ren, vtkActor* actor)
+{
+  this->Superclass::SetMapperShaderParameters(cellBO, ren, actor);
+
+  if (&cellBO == &this->Primitives[PrimitiveTris] && this->RenderWithSurfaceEdges(actor))
+  {
+    vtkOpenGLRenderWindow* renWin = vtkOpenGLRenderWindow::SafeDownCast(ren->GetRenderWindow());
+    this->UpdateEdgeTriangles(renWin);
+    this->EdgeTrianglesTexture->Activate();
+    cellBO.Program->SetUniformi("edgeTriangles", this->EdgeTrianglesTexture->GetTextureUnit());
+
+    // same model to display matrix as the vertex shader, the shift and scale being disabled
+    vtkMatrix4x4* wcdc;
+    vtkMatrix4x4* wcvc;
+    vtkMatrix3x3* norms;
+    vtkMatrix4x4* vcdc;
+    static_cast<vtkOpenGLCamera*>(ren->GetActiveCamera())
+      ->GetKeyMatrices(ren, wcvc, norms, vcdc, wcdc);
+    vtkNew<vtkMatrix4x4> mcwc;
+    vtkMatrix4x4::Transpose(actor->GetMatrix(), mcwc);
+    vtkNew<vtkMatrix4x4> mcdc;
+    vtkMatrix4x4::Multiply4x4(mcwc, wcdc, mcdc);
+    cellBO.Program->SetUniformMatrix("edgeMCDCMatrix", mcdc);
+
+    GLint viewport[4];
+    renWin->GetState()->vtkglGetIntegerv(GL_VIEWPORT, viewport);
+    float edgeViewport[4] = { static_cast<float>(viewport[0]), static_cast<float>(viewport[1]),
+      static_cast<float>(viewport[2]), static_cast<float>(viewport[3]) };
+    cellBO.Program->SetUniform4f("edgeViewport", edgeViewport);
+
+    vtkProperty* property = actor->GetProperty();
+    cellBO.Program->SetUniformf("edgeLineWidth", property->GetLineWidth());
+    cellBO.Program->SetUniform3f("edgeColorUniform", property->GetEdgeColor());
+  }
+
+  if (this->RenderWithShaderColoring(actor))
+  {
+    this->ShaderColoring.SetShaderParameters(
+      cellBO.Program, vtkOpenGLRenderWindow::SafeDownCast(ren->GetRenderWindow()));
+  }
+
+  if (this->CompactPositions && cellBO.Program->IsUniformUsed("compactPositionScale"))
+  {
+    cellBO.Program->SetUniform3f("compactPositionScale", this->CompactPositionScale);
+    cellBO.Program->SetUniform3f("compactPositionShift", this->CompactPositionShift);
+  }
+  if (this->CompactTCoords && cellBO.Program->IsUniformUsed("compactTCoordScale"))
+  {
+    cellBO.Program->SetUniform2f("compactTCoordScale", this->CompactTCoordScale);
+    cellBO.Program->SetUniform2f("compactTCoordShift", this->CompactTCoordShift);
+  }
+
+#if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20231108)
+  if (this->UseJointMatricesSSBO)
+  {
+    // Only upload the joint matrices palette when it has been modified
+    vtkUniforms* uniforms = actor->GetShaderProperty()->GetVertexCustomUniforms();
+    if (uniforms->GetMTime() > this->JointMatricesUploadTime &&
+      uniforms->GetUniformMatrix4x4v("jointMatrices", this->JointMatricesBuffer))
+    {
+      this->JointMatrices->Upload(this->JointMatricesBuffer, vtkOpenGLBufferObject::ArrayBuffer);
+      this->JointMatricesUploadTime = uniforms->GetMTime();
+    }
+    this->JointMatrices->BindShaderStorage(0);
+  }
+#endif
+}
+
+//-----------------------------------------------------------------------------
+void vtkF3DPolyDataMapper::BuildBufferObjects(vtkRenderer* ren, vtkActor* act)
+{
+  this->Superclass::BuildBufferObjects(ren, act);
+
+  bool positions = this->CompactPositions;
+  bool normals = this->CompactNormals;
+  bool tcoords = this->CompactTCoords;
+  this->CompactPositions = false;
+  this->CompactNormals = false;
+  this->CompactTCoords = false;
+
+  if (this->RenderWithCompactVertices(act))
+  {
+    this->BuildCompactBufferObjects(ren);
+  }
+
+  if (positions != this->CompactPositions || normals != this->CompactNormals ||
+    tcoords != this->CompactTCoords)
+  {
+    this->CompactLayoutTime.Modified();
+  }
+}
+
+//-----------------------------------------------------------------------------
+void vtkF3DPolyDataMapper::BuildCompactBufferObjects(vtkRenderer* ren)
+{
+  vtkPolyData* poly = this->CurrentInput;
+  if (!poly || !poly->GetPoints() || poly->GetNumberOfPoints() == 0 ||
+    this->VBOs->GetNumberOfComponents("vertexMC") != 3)
+  {
+    return;
+  }
+
+  // the float buffers built by the superclass are replaced in the group,
+  // the cache releases them once they are not used by another mapper
+  vtkOpenGLVertexBufferObjectCache* cache =
+    static_cast<vtkOpenGLRenderWindow*>(ren->GetRenderWindow())->GetVBOCache();
+
+  this->VBOs->CacheDataArray("vertexMC",
+    ::QuantizeArray(poly->GetPoints()->GetData(), 3, this->CompactPositionScale,
+      this->CompactPositionShift),
+    cache, VTK_UNSIGNED_SHORT);
+  this->CompactPositions = true;
+
+  vtkDataArray* normals = poly->GetPointData()->GetNormals();
+  if (normals && normals->GetNumberOfComponents() == 3 &&
+    normals->GetNumberOfTuples() == poly->GetNumberOfPoints() &&
+    this->VBOs->GetNumberOfComponents("normalMC") == 3)
+  {
+    this->VBOs->CacheDataArray("normalMC", ::EncodeNormals(normals), cache, VTK_SIGNED_CHAR);
+    this->CompactNormals = true;
+  }
+
+  vtkDataArray* tcoords = poly->GetPointData()->GetTCoords();
+  if (tcoords && tcoords->GetNumberOfComponents() == 2 &&
+    tcoords->GetNumberOfTuples() == poly->GetNumberOfPoints() &&
+    this->VBOs->GetNumberOfComponents("tcoord") == 2)
+  {
+    this->VBOs->CacheDataArray("tcoord",
+      ::QuantizeArray(tcoords, 2, this->CompactTCoordScale, this->CompactTCoordShift), cache,
+      VTK_UNSIGNED_SHORT);
+    this->CompactTCoords = true;
+  }
+
+  this->VBOs->BuildAllVBOs(ren);
+}
+
+//-----------------------------------------------------------------------------
+bool vtkF3DPolyDataMapper::RenderWithCompactVertices(vtkActor* actor)
+{
+  if (!this->CompactVertices)
+  {
+    return false;
+  }
+
+  // skinning and morphing are applied on the decoded values, before the compact ones
+  vtkUniforms* uniforms = actor->GetShaderProperty()->GetVertexCustomUniforms();
+  return uniforms->GetUniformTupleType("jointMatrices") == vtkUniforms::TupleTypeInvalid &&
+    uniforms->GetUniformTupleType("morphWeights") == vtkUniforms::TupleTypeInvalid;
+}
+
+//-----------------------------------------------------------------------------
+void vtkF3DPolyDataMapper::RenderPieceFinish(vtkRenderer* ren, vtkActor* actor)
+{
+  if (this->EdgeTrianglesTexture)
+  {
+    this->EdgeTrianglesTexture->Deactivate();
+  }
+  this->ShaderColoring.Deactivate();
+
+  this->Superclass::RenderPieceFinish(ren, actor);
+}
+
+//-----------------------------------------------------------------------------
+void vtkF3DPolyDataMapper::ReleaseGraphicsResources(vtkWindow* win)
+{
+  if (this->EdgeTrianglesTexture)
+  {
+    this->EdgeTrianglesTexture->ReleaseGraphicsResources(win);
+    this->EdgeTrianglesTexture = nullptr;
+  }
+  this->EdgeTrianglesBuffer->ReleaseGraphicsResources();
+
+  this->ShaderColoring.ReleaseGraphicsResources(win);
+
+  this->Superclass::ReleaseGraphicsResources(win);
+}
+
+//-----------------------------------------------------------------------------
+bool vtkF3DPolyDataMapper::SupportsSurfaceEdges()
+{
+#ifdef GL_ES_VERSION_3_0
+  // texture buffers are not available
+  return false;
+#else
+  vtkPolyData* input = this->GetInput();
+  return input && input->GetNumberOfPolys() > 0 && input->GetNumberOfStrips() == 0 &&
+    input->GetPolys()->IsHomogeneous() == 3;
+#endif
+}
+
+//-----------------------------------------------------------------------------
+bool vtkF3DPolyDataMapper::RenderWithSurfaceEdges(vtkActor* actor)
+{
+  if (!this->SurfaceEdges || actor->GetProperty()->GetRepresentation() != VTK_SURFACE ||
+    !this->SupportsSurfaceEdges())
+  {
+    return false;
+  }
+
+  // the corners are not skinned nor morphed
+  vtkUniforms* uniforms = actor->GetShaderProperty()->GetVertexCustomUniforms();
+  return uniforms->GetUniformTupleType("jointMatrices") == vtkUniforms::TupleTypeInvalid &&
+    uniforms->GetUniformTupleType("morphWeights") == vtkUniforms::TupleTypeInvalid;
+}
+
+//-----------------------------------------------------------------------------
+void vtkF3DPolyDataMapper::UpdateEdgeTriangles(vtkOpenGLRenderWindow* renWin)
+{
+  vtkPolyData* input = this->GetInput();
+  if (this->EdgeTrianglesTexture && this->EdgeTrianglesTime >= input->GetMTime())
+  {
+    return;
+  }
+
+  // the triangles are in the same order as the index buffer, so the primitive id is their index
+  vtkPoints* points = input->GetPoints();
+  std::vector<float> corners;
+  corners.reserve(12 * input->GetNumberOfPolys());
+  auto iter = vtk::TakeSmartPointer(input->GetPolys()->NewIterator());
+  for (iter->GoToFirstCell(); !iter->IsDoneWithTraversal(); iter->GoToNextCell())
+  {
+    vtkIdType npts;
+    const vtkIdType* pts;
+    iter->GetCurrentCell(npts, pts);
+    for (vtkIdType i = 0; i < npts; i++)
+    {
+      double p[3];
+      points->GetPoint(pts[i], p);
+      corners.insert(corners.end(),
+        { static_cast<float>(p[0]), static_cast<float>(p[1]), static_cast<float>(p[2]), 1.f });
+    }
+  }
+
+  this->EdgeTrianglesBuffer->Upload(corners, vtkOpenGLBufferObject::TextureBuffer);
+  if (!this->EdgeTrianglesTexture)
+  {
+    this->EdgeTrianglesTexture = vtkSmartPointer<vtkTextureObject>::New();
+  }
+  this->EdgeTrianglesTexture->SetContext(renWin);
+  this->EdgeTrianglesTexture->CreateTextureBuffer(
+    static_cast<unsigned int>(corners.size() / 4), 4, VTK_FLOAT, this->EdgeTrianglesBuffer);
+  this->EdgeTrianglesTime = input->GetMTime();
+}
+
+//-----------------------------------------------------------------------------
+F3DShaderColoring& vtkF3DPolyDataMapper::GetShaderColoring()
+{
+  return this->ShaderColoring;
+}
+
+//-----------------------------------------------------------------------------
+bool vtkF3DPolyDataMapper::RenderWithShaderColoring(vtkActor* actor)
+{
+  return this->ShaderColoring.IsUsed(this->GetInput()) && !this->RenderWithMatCap(actor);
 }
 
 //-----------------------------------------------------------------------------
@@ -270,6 +711,11 @@ void vtkF3DPolyDataMapper::ReplaceShaderColor(
   }
   else
   {
+    if (this->RenderWithShaderColoring(actor))
+    {
+      F3DShaderColoring::ReplaceShaderValues(shaders);
+    }
+
     this->Superclass::ReplaceShaderColor(shaders, ren, actor);
   }
 }
@@ -312,16 +758,32 @@ void vtkF3DPolyDataMapper::ReplaceShaderTCoord(
   }
 
   this->Superclass::ReplaceShaderTCoord(shaders, ren, actor);
+
+  if (this->CompactTCoords)
+  {
+    auto vertexShader = shaders[vtkShader::Vertex];
+    std::string VSSource = vertexShader->GetSource();
+
+    vtkShaderProgram::Substitute(VSSource, "tcoordVCVSOutput = tcoord;",
+      "tcoordVCVSOutput = tcoord * compactTCoordScale + compactTCoordShift;");
+
+    vertexShader->SetSource(VSSource);
+  }
 }
 
-#if VTK_VERSION_NUMBER < VTK_VERSION_CHECK(9, 3, 20230902)
-// Integrated in VTK in https://gitlab.kitware.com/vtk/vtk/-/merge_requests/10456
 //------------------------------------------------------------------------------
 bool vtkF3DPolyDataMapper::GetNeedToRebuildShaders(
   vtkOpenGLHelper& cellBO, vtkRenderer* ren, vtkActor* actor)
 {
   bool ret = this->Superclass::GetNeedToRebuildShaders(cellBO, ren, actor);
 
+  if (cellBO.ShaderSourceTime < this->CompactLayoutTime)
+  {
+    ret = true;
+  }
+
+#if VTK_VERSION_NUMBER < VTK_VERSION_CHECK(9, 3, 20230902)
+  // Integrated in VTK in https://gitlab.kitware.com/vtk/vtk/-/merge_requests/10456
   vtkOpenGLRenderer* oren = static_cast<vtkOpenGLRenderer*>(ren);
   vtkTexture* envTexture = oren->GetEnvironmentTexture();
   if (this->EnvTexture != envTexture ||
@@ -334,7 +796,7 @@ bool vtkF3DPolyDataMapper::GetNeedToRebuildShaders(
       this->EnvTextureTime = envTexture->GetMTime();
     }
   }
+#endif
 
   return ret;
 }
-#endif
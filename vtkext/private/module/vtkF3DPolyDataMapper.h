@@ -2,14 +2,27 @@
  * @class   vtkF3DPolyDataMapper
  * @brief   Custom surface mapper used to include skinning and morphing for glTF format
  *
+ * It can also draw the edges of a triangle mesh in the surface pass, the screen space distance
+ * to the edges of each triangle being computed in the fragment shader.
+ * The point scalars can also be mapped to colors in the shaders, so that cycling the coloring
+ * does not map the scalars on the CPU and upload the vertex buffers again.
+ * The vertex buffers of large meshes can be compacted, see SetCompactVertices.
  */
 
 #ifndef vtkF3DPolyDataMapper_h
 #define vtkF3DPolyDataMapper_h
 
+#include "F3DShaderColoring.h"
+
+#include <vtkOpenGLBufferObject.h>
 #include <vtkOpenGLPolyDataMapper.h>
+#include <vtkSmartPointer.h>
 #include <vtkVersion.h>
 
+#include <vector>
+
+class vtkTextureObject;
+
 class vtkF3DPolyDataMapper : public vtkOpenGLPolyDataMapper
 {
 public:
@@ -34,18 +47,76 @@ public:
     std::map<vtkShader::Type, vtkShader*> shaders, vtkRenderer* ren, vtkActor* actor) override;
   ///@}
 
+  ///@{
+  /**
+   * Set/Get the drawing of the edges in the surface pass, using the edge color and the line
+   * width of the actor property, instead of the additional line pass of the edge visibility.
+   * Only used if SupportsSurfaceEdges returns true.
+   * Default is false.
+   */
+  vtkSetMacro(SurfaceEdges, bool);
+  vtkGetMacro(SurfaceEdges, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the upload of the points, the point normals and the texture coordinates in compact
+   * vertex buffers decoded in the vertex shader: 16-bit positions quantized in the bounds of the
+   * points, 8-bit octahedral normals and 16-bit texture coordinates quantized in their range.
+   * It halves the size of these buffers and the vertex fetch bandwidth at the cost of precision.
+   * Not used for skinned or morphed meshes. Default is false.
+   */
+  vtkSetMacro(CompactVertices, bool);
+  vtkGetMacro(CompactVertices, bool);
+  ///@}
+
+  /**
+   * Return true if the input is only made of triangles and the edges can be drawn in the
+   * surface pass, false if the edge visibility of the actor property should be used instead.
+   */
+  bool SupportsSurfaceEdges();
+
+  /**
+   * Get the mapping of the point scalars to colors in the shaders.
+   * When it is used, the scalar visibility of the mapper is off and cycling the coloring only
+   * changes uniforms. The mapper must be modified when it returns that the shaders must be rebuilt.
+   */
+  F3DShaderColoring& GetShaderColoring();
+
+  /**
+   * Release the texture buffers of the surface edges and of the coloring
+   */
+  void ReleaseGraphicsResources(vtkWindow* win) override;
+
 protected:
   vtkF3DPolyDataMapper();
   ~vtkF3DPolyDataMapper() override = default;
-#if VTK_VERSION_NUMBER < VTK_VERSION_CHECK(9, 3, 20230902)
+
+  /**
+   * Call superclass then replace the vertex buffers of the points, normals and texture
+   * coordinates by compact ones if CompactVertices is enabled
+   */
+  void BuildBufferObjects(vtkRenderer* ren, vtkActor* act) override;
+
+  /**
+   * Call superclass then upload the joint matrices in the SSBO if needed.
+   * The joint matrices are uploaded only when modified.
+   * Also set the uniforms of the surface edges.
+   */
+  void SetMapperShaderParameters(vtkOpenGLHelper& cellBO, vtkRenderer* ren, vtkActor* act) override;
+
+  /**
+   * Call superclass then release the texture units of the surface edges and of the coloring
+   */
+  void RenderPieceFinish(vtkRenderer* ren, vtkActor* act) override;
+
   /**
-   * Call superclass then check for changes in the environment texture
+   * Call superclass then check if the layout of the compact vertex buffers changed.
+   * Before VTK 9.3.20230902, also check for changes in the environment texture
    * in order to support correctly dynamic HDRIs.
-   * Return true if the HDRI texture was changed since last call, false otherwise.
    * Integrated in VTK in https://gitlab.kitware.com/vtk/vtk/-/merge_requests/10456
    */
   bool GetNeedToRebuildShaders(vtkOpenGLHelper& cellBO, vtkRenderer* ren, vtkActor* act) override;
-#endif
 
 private:
   /**
@@ -53,6 +124,49 @@ private:
    */
   bool RenderWithMatCap(vtkActor* actor);
 
+  /**
+   * Returns true if the edges are drawn in the surface pass for this actor
+   */
+  bool RenderWithSurfaceEdges(vtkActor* actor);
+
+  /**
+   * Upload the model coordinates of the triangles corners in a texture buffer if the input changed
+   */
+  void UpdateEdgeTriangles(vtkOpenGLRenderWindow* renWin);
+
+  /**
+   * Returns true if the scalars are mapped to colors in the shaders for this actor
+   */
+  bool RenderWithShaderColoring(vtkActor* actor);
+
+  /**
+   * Returns true if the vertex buffers can be compacted for this actor
+   */
+  bool RenderWithCompactVertices(vtkActor* actor);
+
+  /**
+   * Upload the compact vertex buffers of the input and set the compact layout
+   */
+  void BuildCompactBufferObjects(vtkRenderer* ren);
+
+  bool SurfaceEdges = false;
+  vtkNew<vtkOpenGLBufferObject> EdgeTrianglesBuffer;
+  vtkSmartPointer<vtkTextureObject> EdgeTrianglesTexture;
+  vtkMTimeType EdgeTrianglesTime = 0;
+
+  F3DShaderColoring ShaderColoring;
+
+  // The compact vertex buffers in use, with the scale and shift decoding the quantized values
+  bool CompactVertices = false;
+  bool CompactPositions = false;
+  bool CompactNormals = false;
+  bool CompactTCoords = false;
+  float CompactPositionScale[3] = { 1.f, 1.f, 1.f };
+  float CompactPositionShift[3] = { 0.f, 0.f, 0.f };
+  float CompactTCoordScale[2] = { 1.f, 1.f };
+  float CompactTCoordShift[2] = { 0.f, 0.f };
+  vtkTimeStamp CompactLayoutTime;
+
 #if VTK_VERSION_NUMBER < VTK_VERSION_CHECK(9, 3, 20230902)
   vtkMTimeType EnvTextureTime = 0;
   vtkTexture* EnvTexture = nullptr;
@@ -61,6 +175,9 @@ private:
 // SSBO support: https://gitlab.kitware.com/vtk/vtk/-/merge_requests/10675
 #if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20231108)
   vtkNew<vtkOpenGLBufferObject> JointMatrices;
+  std::vector<float> JointMatricesBuffer;
+  vtkMTimeType JointMatricesUploadTime = 0;
+  bool UseJointMatricesSSBO = false;
 #endif
 };
 
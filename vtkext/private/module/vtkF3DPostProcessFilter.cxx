@@ -1,6 +1,9 @@
 #include "vtkF3DPostProcessFilter.h"
 
 #include "F3DLog.h"
+#include "vtkF3DImporter.h"
+#include "vtkF3DNormalsFilter.h"
+#include "vtkF3DReorderTrianglesFilter.h"
 
 #include <vtkAppendPolyData.h>
 #include <vtkDataObject.h>
@@ -10,23 +13,65 @@
 #include <vtkImageData.h>
 #include <vtkImageToPoints.h>
 #include <vtkInformation.h>
+#include <vtkInformationDoubleVectorKey.h>
+#include <vtkMatrix4x4.h>
+#include <vtkMultiBlockDataSet.h>
 #include <vtkNew.h>
 #include <vtkObjectFactory.h>
 #include <vtkPolyData.h>
 #include <vtkRectilinearGrid.h>
 #include <vtkRectilinearGridToPointSet.h>
 #include <vtkResampleToImage.h>
+#include <vtkSMPTools.h>
+#include <vtkTransform.h>
+#include <vtkTransformFilter.h>
 #include <vtkUnstructuredGrid.h>
 #include <vtkVertexGlyphFilter.h>
 
 #include <numeric>
+#include <vector>
 
 vtkStandardNewMacro(vtkF3DPostProcessFilter);
 
+namespace
+{
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkMatrix4x4> GetInstanceMatrix(vtkDataObjectTreeIterator* iter)
+{
+  if (!iter->HasCurrentMetaData() ||
+    !iter->GetCurrentMetaData()->Has(vtkF3DImporter::INSTANCE_MATRIX()))
+  {
+    return nullptr;
+  }
+
+  vtkNew<vtkMatrix4x4> matrix;
+  iter->GetCurrentMetaData()->Get(vtkF3DImporter::INSTANCE_MATRIX(), matrix->GetData());
+  return matrix;
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkDataSet> ApplyInstanceMatrix(vtkDataSet* dataset, vtkMatrix4x4* matrix)
+{
+  if (!matrix)
+  {
+    return dataset;
+  }
+
+  vtkNew<vtkTransform> transform;
+  transform->SetMatrix(matrix);
+
+  vtkNew<vtkTransformFilter> transformFilter;
+  transformFilter->SetTransform(transform);
+  transformFilter->SetInputData(dataset);
+  transformFilter->Update();
+  return vtkDataSet::SafeDownCast(transformFilter->GetOutput());
+}
+}
+
 //----------------------------------------------------------------------------
 vtkF3DPostProcessFilter::vtkF3DPostProcessFilter()
 {
-  this->SetNumberOfOutputPorts(3);
+  this->SetNumberOfOutputPorts(4);
 }
 
 //----------------------------------------------------------------------------
@@ -37,9 +82,12 @@ int vtkF3DPostProcessFilter::RequestData(vtkInformation* vtkNotUsed(request),
   vtkPolyData* outputSurface = vtkPolyData::GetData(outputVector, 0);
   vtkPolyData* outputPoints = vtkPolyData::GetData(outputVector, 1);
   vtkImageData* outputImage = vtkImageData::GetData(outputVector, 2);
+  vtkMultiBlockDataSet* outputBlocks = vtkMultiBlockDataSet::GetData(outputVector, 3);
+  outputBlocks->Initialize();
 
   vtkDataObjectTree* composite = vtkDataObjectTree::SafeDownCast(dataObject);
   vtkSmartPointer<vtkDataSet> dataset = vtkDataSet::SafeDownCast(dataObject);
+  bool processed = false;
 
   // Extract data from a composite dataset
   if (composite)
@@ -51,20 +99,29 @@ int vtkF3DPostProcessFilter::RequestData(vtkInformation* vtkNotUsed(request),
 
     // If it contains a single leaf, extract it as is
     int nLeaf = 0;
+    vtkSmartPointer<vtkMatrix4x4> leafMatrix;
     for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
     {
       dataset = vtkDataSet::SafeDownCast(iter->GetCurrentDataObject());
+      leafMatrix = ::GetInstanceMatrix(iter);
       nLeaf++;
     }
 
-    // If multiple leafs, extract all surfaces and append them together
+    if (nLeaf == 1 && dataset)
+    {
+      dataset = ::ApplyInstanceMatrix(dataset, leafMatrix);
+    }
+
+    // If multiple leafs, extract all surfaces in parallel and append them together
     if (nLeaf > 1)
     {
-      vtkNew<vtkAppendPolyData> append;
+      processed = true;
+      std::vector<vtkSmartPointer<vtkPolyData>> leafSurfaces;
+      std::vector<vtkDataSet*> leafDatasets;
+      std::vector<vtkSmartPointer<vtkMatrix4x4>> leafMatrices;
       for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
       {
         vtkDataSet* leafDS = vtkDataSet::SafeDownCast(iter->GetCurrentDataObject());
-        vtkSmartPointer<vtkPolyData> leafPD = vtkPolyData::SafeDownCast(leafDS);
         if (!leafDS)
         {
           F3DLog::Print(F3DLog::Severity::Warning,
@@ -72,15 +129,67 @@ int vtkF3DPostProcessFilter::RequestData(vtkInformation* vtkNotUsed(request),
         }
         else
         {
-          if (!leafPD)
+          leafDatasets.emplace_back(leafDS);
+          leafSurfaces.emplace_back(vtkPolyData::SafeDownCast(leafDS));
+          leafMatrices.emplace_back(::GetInstanceMatrix(iter));
+        }
+      }
+
+      // Each leaf uses its own surface filter, so they can be extracted concurrently
+      vtkSMPTools::For(0, static_cast<vtkIdType>(leafDatasets.size()),
+        [&](vtkIdType begin, vtkIdType end)
+        {
+          for (vtkIdType i = begin; i < end; i++)
+          {
+            if (!leafSurfaces[i])
+            {
+              vtkNew<vtkDataSetSurfaceFilter> geom;
+              geom->SetInputData(leafDatasets[i]);
+              geom->Update();
+              leafSurfaces[i] = vtkPolyData::SafeDownCast(geom->GetOutput());
+            }
+            leafSurfaces[i] = this->ProcessSurface(leafSurfaces[i]);
+          }
+        });
+
+      // Output the leaves separately to avoid the copy of the append
+      if (leafSurfaces.size() <= static_cast<size_t>(this->MaximumNumberOfBlocks))
+      {
+        outputBlocks->SetNumberOfBlocks(static_cast<unsigned int>(leafSurfaces.size()));
+        for (size_t i = 0; i < leafSurfaces.size(); i++)
+        {
+          vtkSmartPointer<vtkPolyData> block = leafSurfaces[i];
+          if (block->GetNumberOfCells() == 0)
+          {
+            // Point clouds are shown with a polyvertex cell, without modifying the input
+            std::vector<vtkIdType> polyVertex(block->GetNumberOfPoints());
+            std::iota(polyVertex.begin(), polyVertex.end(), 0);
+            vtkNew<vtkCellArray> verts;
+            verts->InsertNextCell(block->GetNumberOfPoints(), polyVertex.data());
+            block = vtkSmartPointer<vtkPolyData>::New();
+            block->ShallowCopy(leafSurfaces[i]);
+            block->SetVerts(verts);
+          }
+          outputBlocks->SetBlock(static_cast<unsigned int>(i), block);
+
+          // instances keep sharing their surface, the matrix is applied by the importer
+          if (leafMatrices[i])
           {
-            vtkNew<vtkDataSetSurfaceFilter> geom;
-            geom->SetInputData(iter->GetCurrentDataObject());
-            geom->Update();
-            leafPD = vtkPolyData::SafeDownCast(geom->GetOutput());
+            outputBlocks->GetMetaData(static_cast<unsigned int>(i))
+              ->Set(vtkF3DImporter::INSTANCE_MATRIX(), leafMatrices[i]->GetData(), 16);
           }
-          append->AddInputData(leafPD);
         }
+        outputSurface->Initialize();
+        outputPoints->Initialize();
+        outputImage->Initialize();
+        return 1;
+      }
+
+      vtkNew<vtkAppendPolyData> append;
+      for (size_t i = 0; i < leafSurfaces.size(); i++)
+      {
+        append->AddInputData(
+          vtkPolyData::SafeDownCast(::ApplyInstanceMatrix(leafSurfaces[i], leafMatrices[i])));
       }
 
       append->Update();
@@ -150,12 +259,40 @@ int vtkF3DPostProcessFilter::RequestData(vtkInformation* vtkNotUsed(request),
     }
   }
 
+  // The appended leaves are already processed
+  if (!processed)
+  {
+    surface = this->ProcessSurface(surface);
+  }
+
   outputSurface->ShallowCopy(surface);
   outputPoints->ShallowCopy(cloud);
 
   return 1;
 }
 
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkPolyData> vtkF3DPostProcessFilter::ProcessSurface(vtkPolyData* surface) const
+{
+  vtkSmartPointer<vtkPolyData> output = surface;
+  if (this->GenerateNormals)
+  {
+    vtkNew<vtkF3DNormalsFilter> normals;
+    normals->SetFeatureAngle(this->NormalsFeatureAngle);
+    normals->SetInputData(output);
+    normals->Update();
+    output = normals->GetOutput();
+  }
+  if (this->ReorderTriangles)
+  {
+    vtkNew<vtkF3DReorderTrianglesFilter> reorder;
+    reorder->SetInputData(output);
+    reorder->Update();
+    output = reorder->GetOutput();
+  }
+  return output;
+}
+
 //----------------------------------------------------------------------------
 int vtkF3DPostProcessFilter::FillInputPortInformation(int vtkNotUsed(port), vtkInformation* info)
 {
@@ -171,9 +308,13 @@ int vtkF3DPostProcessFilter::FillOutputPortInformation(int port, vtkInformation*
   {
     info->Set(vtkDataObject::DATA_TYPE_NAME(), "vtkPolyData");
   }
-  else
+  else if (port == 2)
   {
     info->Set(vtkDataObject::DATA_TYPE_NAME(), "vtkImageData");
   }
+  else
+  {
+    info->Set(vtkDataObject::DATA_TYPE_NAME(), "vtkMultiBlockDataSet");
+  }
   return 1;
 }
@@ -8,6 +8,12 @@
  *  1/ the surface (hull) of the dataset as a vtkPolyData
  *  2/ a point cloud of the dataset as a vtkPolyData
  *  3/ a 3D image sampling of the dataset as a volumic vtkImageData (if supported)
+ *  4/ the surfaces of the leaves of a composite dataset as the blocks of a vtkMultiBlockDataSet,
+ *     if they are not merged, see SetMaximumNumberOfBlocks
+ * The leaves placed with a vtkF3DImporter::INSTANCE_MATRIX are transformed before being merged,
+ * or keep their matrix in the metadata of their block when output separately.
+ * The surfaces without normals can get smooth normals, see SetGenerateNormals, and their
+ * triangles can be reordered for the GPU vertex caches, see SetReorderTriangles.
  */
 
 #ifndef vtkF3DPostProcessFilter_h
@@ -15,6 +21,10 @@
 
 #include "vtkDataObjectAlgorithm.h"
 
+#include <vtkSmartPointer.h>
+
+class vtkPolyData;
+
 class vtkF3DPostProcessFilter : public vtkDataObjectAlgorithm
 {
 public:
@@ -24,6 +34,46 @@ public:
   vtkF3DPostProcessFilter(const vtkF3DPostProcessFilter&) = delete;
   void operator=(const vtkF3DPostProcessFilter&) = delete;
 
+  ///@{
+  /**
+   * Set/Get the maximum number of leaves of a composite dataset that are output separately in
+   * the fourth output instead of being merged, the surface and point cloud outputs are then empty.
+   * Default is 0, leaves are always merged.
+   */
+  vtkSetMacro(MaximumNumberOfBlocks, int);
+  vtkGetMacro(MaximumNumberOfBlocks, int);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get if the triangles and the points of the surfaces are reordered for the GPU vertex
+   * caches with vtkF3DReorderTrianglesFilter, the leaves of a composite dataset being
+   * reordered concurrently. Default is false.
+   */
+  vtkSetMacro(ReorderTriangles, bool);
+  vtkGetMacro(ReorderTriangles, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get if smooth point normals are generated with vtkF3DNormalsFilter for the surfaces
+   * without point normals, the leaves of a composite dataset being processed concurrently.
+   * Default is false.
+   */
+  vtkSetMacro(GenerateNormals, bool);
+  vtkGetMacro(GenerateNormals, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the angle in degrees between two polygons above which their common points are
+   * split when generating the normals, see vtkF3DNormalsFilter::SetFeatureAngle.
+   * Default is 180, the points are never split.
+   */
+  vtkSetClampMacro(NormalsFeatureAngle, double, 0.0, 180.0);
+  vtkGetMacro(NormalsFeatureAngle, double);
+  ///@}
+
 protected:
   vtkF3DPostProcessFilter();
   ~vtkF3DPostProcessFilter() override = default;
@@ -33,6 +83,17 @@ protected:
 
   int FillInputPortInformation(int port, vtkInformation* info) override;
   int FillOutputPortInformation(int port, vtkInformation* info) override;
+
+private:
+  /**
+   * Generate the normals and reorder the triangles of a surface, as configured
+   */
+  vtkSmartPointer<vtkPolyData> ProcessSurface(vtkPolyData* surface) const;
+
+  int MaximumNumberOfBlocks = 0;
+  bool ReorderTriangles = false;
+  bool GenerateNormals = false;
+  double NormalsFeatureAngle = 180.0;
 };
 
 #endif
@@ -0,0 +1,156 @@
+#include "vtkF3DPostProcessPass.h"
+
+#include "vtkF3DPostProcessFS.h"
+
+#include <vtkObjectFactory.h>
+#include <vtkOpenGLError.h>
+#include <vtkOpenGLFramebufferObject.h>
+#include <vtkOpenGLQuadHelper.h>
+#include <vtkOpenGLRenderUtilities.h>
+#include <vtkOpenGLRenderWindow.h>
+#include <vtkOpenGLShaderCache.h>
+#include <vtkOpenGLState.h>
+#include <vtkRenderState.h>
+#include <vtkRenderer.h>
+#include <vtkShaderProgram.h>
+#include <vtkTextureObject.h>
+
+vtkStandardNewMacro(vtkF3DPostProcessPass);
+
+//----------------------------------------------------------------------------
+void vtkF3DPostProcessPass::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "UseToneMapping: " << this->UseToneMapping << "\n";
+  os << indent << "UseFXAA: " << this->UseFXAA << "\n";
+  os << indent << "UserShader: " << this->UserShader << "\n";
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DPostProcessPass::Render(const vtkRenderState* s)
+{
+  vtkOpenGLClearErrorMacro();
+
+  this->NumberOfRenderedProps = 0;
+
+  vtkRenderer* r = s->GetRenderer();
+  vtkOpenGLRenderWindow* renWin = static_cast<vtkOpenGLRenderWindow*>(r->GetRenderWindow());
+  vtkOpenGLState* ostate = renWin->GetState();
+
+  vtkOpenGLState::ScopedglEnableDisable bsaver(ostate, GL_BLEND);
+  vtkOpenGLState::ScopedglEnableDisable dsaver(ostate, GL_DEPTH_TEST);
+
+  assert(this->DelegatePass != nullptr);
+
+  int pos[2];
+  int size[2];
+  r->GetTiledSizeAndOrigin(&size[0], &size[1], &pos[0], &pos[1]);
+
+  // the only intermediate texture, the linear output of the delegate
+  if (this->ColorTexture == nullptr)
+  {
+    this->ColorTexture = vtkSmartPointer<vtkTextureObject>::New();
+    this->ColorTexture->SetContext(renWin);
+    this->ColorTexture->SetMinificationFilter(vtkTextureObject::Linear);
+    this->ColorTexture->SetMagnificationFilter(vtkTextureObject::Linear);
+    this->ColorTexture->SetWrapS(vtkTextureObject::ClampToEdge);
+    this->ColorTexture->SetWrapT(vtkTextureObject::ClampToEdge);
+    this->ColorTexture->Allocate2D(size[0], size[1], 4, VTK_FLOAT);
+  }
+  this->ColorTexture->Resize(size[0], size[1]);
+
+  if (this->FrameBufferObject == nullptr)
+  {
+    this->FrameBufferObject = vtkSmartPointer<vtkOpenGLFramebufferObject>::New();
+    this->FrameBufferObject->SetContext(renWin);
+  }
+
+  renWin->GetState()->PushFramebufferBindings();
+  this->RenderDelegate(
+    s, size[0], size[1], size[0], size[1], this->FrameBufferObject, this->ColorTexture);
+  renWin->GetState()->PopFramebufferBindings();
+
+  if (this->QuadHelper && this->QuadHelper->ShaderChangeValue < this->GetMTime())
+  {
+    this->QuadHelper = nullptr;
+  }
+
+  if (!this->QuadHelper)
+  {
+    std::string FSSource = vtkOpenGLRenderUtilities::GetFullScreenQuadFragmentShaderTemplate();
+
+    std::string decl;
+    if (this->UseToneMapping)
+    {
+      decl += "#define F3D_TONE_MAPPING\n";
+    }
+    if (this->UseFXAA)
+    {
+      decl += "#define F3D_FXAA\n";
+    }
+    decl += vtkF3DPostProcessFS;
+
+    std::string impl = "gl_FragData[0] = f3dPostProcess(texCoord);";
+    if (!this->UserShader.empty())
+    {
+      // the user function can only sample the source texture, its samples are post processed
+      decl += "\n#define texture(s, uv) f3dPostProcess(uv)\n"
+              "#define textureLod(s, uv, lod) f3dPostProcess(uv)\n"
+              "#define texelFetch(s, p, lod) f3dPostProcess((vec2(p) + 0.5) / vec2(resolution))\n";
+      decl += this->UserShader;
+      decl += "\n#undef texture\n"
+              "#undef textureLod\n"
+              "#undef texelFetch\n";
+      impl = "gl_FragData[0] = pixel(texCoord);";
+    }
+
+    vtkShaderProgram::Substitute(FSSource, "//VTK::FSQ::Decl", decl);
+    vtkShaderProgram::Substitute(FSSource, "//VTK::FSQ::Impl", impl);
+
+    this->QuadHelper =
+      std::make_shared<vtkOpenGLQuadHelper>(renWin, nullptr, FSSource.c_str(), nullptr);
+    this->QuadHelper->ShaderChangeValue = this->GetMTime();
+  }
+  else
+  {
+    renWin->GetShaderCache()->ReadyShaderProgram(this->QuadHelper->Program);
+  }
+
+  if (!this->QuadHelper->Program || !this->QuadHelper->Program->GetCompiled())
+  {
+    vtkErrorMacro("Couldn't build the shader program.");
+    return;
+  }
+
+  this->ColorTexture->Activate();
+  this->QuadHelper->Program->SetUniformi("source", this->ColorTexture->GetTextureUnit());
+  this->QuadHelper->Program->SetUniform2i("resolution", size);
+
+  ostate->vtkglDisable(GL_BLEND);
+  ostate->vtkglDisable(GL_DEPTH_TEST);
+  ostate->vtkglClear(GL_DEPTH_BUFFER_BIT);
+  ostate->vtkglViewport(pos[0], pos[1], size[0], size[1]);
+  ostate->vtkglScissor(pos[0], pos[1], size[0], size[1]);
+
+  this->QuadHelper->Render();
+
+  this->ColorTexture->Deactivate();
+
+  vtkOpenGLCheckErrorMacro("failed after Render");
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DPostProcessPass::ReleaseGraphicsResources(vtkWindow* w)
+{
+  this->Superclass::ReleaseGraphicsResources(w);
+
+  this->QuadHelper = nullptr;
+  if (this->FrameBufferObject)
+  {
+    this->FrameBufferObject->ReleaseGraphicsResources(w);
+  }
+  if (this->ColorTexture)
+  {
+    this->ColorTexture->ReleaseGraphicsResources(w);
+  }
+}
@@ -0,0 +1,92 @@
+/**
+ * @class   vtkF3DPostProcessPass
+ * @brief   Apply the tone mapping, the FXAA and the user shader in a single full screen pass
+ *
+ * Chaining vtkToneMappingPass, vtkOpenGLFXAAPass and vtkF3DUserRenderPass reads and writes a
+ * full resolution framebuffer for each of them. This pass renders its delegate into a single
+ * texture and generates one fragment shader applying the enabled effects, in the same order:
+ * the samples read by the FXAA are tone mapped, and the samples of the `source` texture read
+ * by the user `pixel()` function, see vtkF3DUserRenderPass, are anti-aliased and tone mapped.
+ * Each pixel is then written once.
+ *
+ * The effects are computed for each sample of the previous effect: the FXAA reads up to 35
+ * tone mapped texels, and the effects are computed again for each sample of the user function.
+ * It is faster for a user function sampling the source once or a few times, not for a blur.
+ *
+ * The tone mapping is the Khronos PBR Neutral operator, like vtkToneMappingPass::NeutralPBR.
+ *
+ * @sa
+ * vtkF3DUserRenderPass
+ */
+
+#ifndef vtkF3DPostProcessPass_h
+#define vtkF3DPostProcessPass_h
+
+#include <vtkImageProcessingPass.h>
+#include <vtkSmartPointer.h>
+
+#include <memory>
+#include <string>
+
+class vtkOpenGLFramebufferObject;
+class vtkOpenGLQuadHelper;
+class vtkTextureObject;
+
+class vtkF3DPostProcessPass : public vtkImageProcessingPass
+{
+public:
+  static vtkF3DPostProcessPass* New();
+  vtkTypeMacro(vtkF3DPostProcessPass, vtkImageProcessingPass);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Perform rendering according to a render state.
+   */
+  void Render(const vtkRenderState* s) override;
+
+  /**
+   * Release graphics resources and ask components to release their own resources.
+   */
+  void ReleaseGraphicsResources(vtkWindow* w) override;
+
+  ///@{
+  /**
+   * Set/Get the effects applied by the pass.
+   * Default is false.
+   */
+  vtkSetMacro(UseToneMapping, bool);
+  vtkGetMacro(UseToneMapping, bool);
+  vtkSetMacro(UseFXAA, bool);
+  vtkGetMacro(UseFXAA, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the user shader code defining the `pixel()` function, applied last.
+   * An empty string does not apply any user shader.
+   */
+  vtkSetMacro(UserShader, std::string);
+  vtkGetMacro(UserShader, std::string);
+  ///@}
+
+  /**
+   * Forbidden copies.
+   */
+  vtkF3DPostProcessPass(const vtkF3DPostProcessPass&) = delete;
+  void operator=(const vtkF3DPostProcessPass&) = delete;
+
+private:
+  vtkF3DPostProcessPass() = default;
+  ~vtkF3DPostProcessPass() override = default;
+
+  vtkSmartPointer<vtkOpenGLFramebufferObject> FrameBufferObject;
+  vtkSmartPointer<vtkTextureObject> ColorTexture;
+
+  std::shared_ptr<vtkOpenGLQuadHelper> QuadHelper;
+
+  bool UseToneMapping = false;
+  bool UseFXAA = false;
+  std::string UserShader;
+};
+
+#endif
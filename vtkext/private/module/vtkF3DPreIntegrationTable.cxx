@@ -0,0 +1,136 @@
+#include "vtkF3DPreIntegrationTable.h"
+
+#include <vtkColorTransferFunction.h>
+#include <vtkFloatArray.h>
+#include <vtkImageData.h>
+#include <vtkNew.h>
+#include <vtkObjectFactory.h>
+#include <vtkPiecewiseFunction.h>
+#include <vtkPointData.h>
+#include <vtkShaderProperty.h>
+#include <vtkVolume.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+//----------------------------------------------------------------------------
+vtkStandardNewMacro(vtkF3DPreIntegrationTable);
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkImageData> vtkF3DPreIntegrationTable::Compute(vtkColorTransferFunction* ctf,
+  vtkPiecewiseFunction* otf, const double range[2], double segmentLength, double unitDistance,
+  int size)
+{
+  size = std::max(size, 2);
+  std::vector<double> colors(3 * size);
+  std::vector<double> opacities(size);
+  ctf->GetTable(range[0], range[1], size, colors.data());
+  otf->GetTable(range[0], range[1], size, opacities.data());
+
+  // the opacity of the transfer function is the one of a segment of the unit distance,
+  // it is converted to an extinction coefficient per world unit to be integrated
+  std::vector<double> extinctions(size);
+  for (int i = 0; i < size; i++)
+  {
+    double opacity = std::clamp(opacities[i], 0.0, 0.9999);
+    extinctions[i] = -std::log(1.0 - opacity) / std::max(unitDistance, 1e-6);
+  }
+
+  // integrals of the extinction and of the color weighted by the extinction from the first
+  // scalar, using the trapezoidal rule, so that any segment is integrated in constant time
+  std::vector<double> extinctionIntegrals(size, 0.0);
+  std::vector<double> colorIntegrals(3 * size, 0.0);
+  for (int i = 1; i < size; i++)
+  {
+    extinctionIntegrals[i] =
+      extinctionIntegrals[i - 1] + 0.5 * (extinctions[i - 1] + extinctions[i]);
+    for (int c = 0; c < 3; c++)
+    {
+      colorIntegrals[3 * i + c] = colorIntegrals[3 * (i - 1) + c] +
+        0.5 * (colors[3 * (i - 1) + c] * extinctions[i - 1] + colors[3 * i + c] * extinctions[i]);
+    }
+  }
+
+  vtkNew<vtkFloatArray> table;
+  table->SetName("PreIntegrationTable");
+  table->SetNumberOfComponents(4);
+  table->SetNumberOfTuples(static_cast<vtkIdType>(size) * size);
+  for (int back = 0; back < size; back++)
+  {
+    for (int front = 0; front < size; front++)
+    {
+      // the segment only depends on the scalars it covers, not on its direction
+      int first = std::min(front, back);
+      int last = std::max(front, back);
+      double extinction = extinctions[first];
+      double color[3] = { colors[3 * first], colors[3 * first + 1], colors[3 * first + 2] };
+      double extinctionIntegral = extinctionIntegrals[last] - extinctionIntegrals[first];
+      if (last > first)
+      {
+        extinction = extinctionIntegral / (last - first);
+        for (int c = 0; c < 3; c++)
+        {
+          color[c] = extinctionIntegral > 0.0
+            ? (colorIntegrals[3 * last + c] - colorIntegrals[3 * first + c]) / extinctionIntegral
+            : 0.5 * (colors[3 * first + c] + colors[3 * last + c]);
+        }
+      }
+
+      float* tuple = table->GetPointer(4 * (static_cast<vtkIdType>(back) * size + front));
+      for (int c = 0; c < 3; c++)
+      {
+        tuple[c] = static_cast<float>(std::clamp(color[c], 0.0, 1.0));
+      }
+      tuple[3] = static_cast<float>(1.0 - std::exp(-extinction * segmentLength));
+    }
+  }
+
+  vtkSmartPointer<vtkImageData> image = vtkSmartPointer<vtkImageData>::New();
+  image->SetDimensions(size, size, 1);
+  image->GetPointData()->SetScalars(table);
+  return image;
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DPreIntegrationTable::SetVolumeShading(vtkVolume* volume, bool preIntegrated)
+{
+  vtkShaderProperty* shaderProperty = volume->GetShaderProperty();
+  shaderProperty->ClearFragmentShaderReplacement("//VTK::Shading::Dec", true);
+  shaderProperty->ClearFragmentShaderReplacement("//VTK::Shading::Impl", true);
+  if (!preIntegrated)
+  {
+    return;
+  }
+
+  // the scalar of the previous sample, negative at the start of the ray and after the
+  // cropped regions, the declarations of VTK are kept
+  shaderProperty->AddFragmentShaderReplacement("//VTK::Shading::Dec", true,
+    "//VTK::Shading::Dec\n"
+    "float g_preIntegratedScalar = -1.0;\n",
+    false);
+
+  // the 2D transfer function is looked up with the scalars of the previous and current
+  // samples, at the center of the texels the table was computed for
+  shaderProperty->AddFragmentShaderReplacement("//VTK::Shading::Impl", true,
+    "    if (!g_skip)\n"
+    "    {\n"
+    "      float scalar = texture3D(in_volume[0], g_dataPos).r;\n"
+    "      scalar = clamp(scalar * in_volume_scale[0].r + in_volume_bias[0].r, 0.0, 1.0);\n"
+    "      float previous = g_preIntegratedScalar < 0.0 ? scalar : g_preIntegratedScalar;\n"
+    "      g_preIntegratedScalar = scalar;\n"
+    "      vec2 tableSize = vec2(textureSize(in_transfer2D_0[0], 0));\n"
+    "      vec2 tableCoord = (vec2(previous, scalar) * (tableSize - 1.0) + 0.5) / tableSize;\n"
+    "      g_srcColor = texture2D(in_transfer2D_0[0], tableCoord);\n"
+    "      if (g_srcColor.a > 0.0)\n"
+    "      {\n"
+    "        g_srcColor.rgb *= g_srcColor.a;\n"
+    "        g_fragColor = (1.0f - g_fragColor.a) * g_srcColor + g_fragColor;\n"
+    "      }\n"
+    "    }\n"
+    "    else\n"
+    "    {\n"
+    "      g_preIntegratedScalar = -1.0;\n"
+    "    }\n",
+    false);
+}
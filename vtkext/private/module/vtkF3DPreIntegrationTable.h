@@ -0,0 +1,59 @@
+/**
+ * @class   vtkF3DPreIntegrationTable
+ * @brief   Pre-integrated transfer functions of a volume
+ *
+ * Compute the color and opacity of the ray segments between two consecutive samples from the
+ * 1D transfer functions of a volume, in a 2D table indexed by the scalars of the front and back
+ * samples. The transfer functions are integrated along the segment, assuming the scalar varies
+ * linearly between the samples, so that the sharp colormaps do not cause slicing artifacts
+ * even with sample distances much larger than the ones needed by the 1D transfer functions.
+ * The table is used as the 2D transfer function of the volume property, and the shading of the
+ * GPU ray caster is replaced to look it up instead of the scalar and the gradient magnitude,
+ * see SetVolumeShading. The table must be computed again when the transfer functions, the range
+ * or the sample distance change.
+ */
+
+#ifndef vtkF3DPreIntegrationTable_h
+#define vtkF3DPreIntegrationTable_h
+
+#include <vtkObject.h>
+#include <vtkSmartPointer.h>
+
+class vtkColorTransferFunction;
+class vtkImageData;
+class vtkPiecewiseFunction;
+class vtkVolume;
+
+class vtkF3DPreIntegrationTable : public vtkObject
+{
+public:
+  static vtkF3DPreIntegrationTable* New();
+  vtkTypeMacro(vtkF3DPreIntegrationTable, vtkObject);
+
+  /**
+   * Compute the table of size x size RGBA floats, the scalars of the front and back samples
+   * being respectively the x and y coordinates, covering the range of the scalars of the volume.
+   * The opacities are corrected for the segment length, in world coordinates, like VTK corrects
+   * the opacity transfer functions with the unit distance of the volume property.
+   */
+  static vtkSmartPointer<vtkImageData> Compute(vtkColorTransferFunction* ctf,
+    vtkPiecewiseFunction* otf, const double range[2], double segmentLength, double unitDistance,
+    int size = 256);
+
+  /**
+   * Replace the shading of the GPU ray caster of the volume to composite the segments between
+   * the samples using its 2D transfer function, computed with Compute, or restore it.
+   * Only the single component volumes using the composite blend mode are supported.
+   */
+  static void SetVolumeShading(vtkVolume* volume, bool preIntegrated);
+
+protected:
+  vtkF3DPreIntegrationTable() = default;
+  ~vtkF3DPreIntegrationTable() override = default;
+
+private:
+  vtkF3DPreIntegrationTable(const vtkF3DPreIntegrationTable&) = delete;
+  void operator=(const vtkF3DPreIntegrationTable&) = delete;
+};
+
+#endif
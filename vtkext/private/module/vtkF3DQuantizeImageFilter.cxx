@@ -0,0 +1,131 @@
+#include "vtkF3DQuantizeImageFilter.h"
+
+#include "F3DLog.h"
+
+#include <vtkArrayDispatch.h>
+#include <vtkCellData.h>
+#include <vtkDataArrayRange.h>
+#include <vtkImageData.h>
+#include <vtkInformation.h>
+#include <vtkInformationVector.h>
+#include <vtkObjectFactory.h>
+#include <vtkPointData.h>
+#include <vtkSMPTools.h>
+#include <vtkUnsignedCharArray.h>
+#include <vtkUnsignedShortArray.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+//----------------------------------------------------------------------------
+// Map the component, or the magnitude, of each tuple from the scalar range to the output range
+template<typename OutputT>
+struct QuantizeWorker
+{
+  template<typename ArrayT>
+  void operator()(ArrayT* array, OutputT* output, int component, const double range[2])
+  {
+    const int nComps = array->GetNumberOfComponents();
+    const double maxValue = static_cast<double>(std::numeric_limits<OutputT>::max());
+    const double scale = range[1] > range[0] ? maxValue / (range[1] - range[0]) : 0.0;
+    const double minValue = range[0];
+
+    vtkSMPTools::For(0, array->GetNumberOfTuples(),
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        OutputT* out = output + begin;
+        for (const auto tuple : vtk::DataArrayTupleRange(array, begin, end))
+        {
+          double value = 0.0;
+          if (component >= 0)
+          {
+            value = static_cast<double>(tuple[component]);
+          }
+          else if (nComps == 1)
+          {
+            value = static_cast<double>(tuple[0]);
+          }
+          else
+          {
+            for (int comp = 0; comp < nComps; comp++)
+            {
+              double compValue = static_cast<double>(tuple[comp]);
+              value += compValue * compValue;
+            }
+            value = std::sqrt(value);
+          }
+
+          // NaN values are mapped to the minimum, like the values below the range
+          double quantized = (value - minValue) * scale + 0.5;
+          *out++ = static_cast<OutputT>(
+            quantized > 0.0 ? std::min(quantized, maxValue) : 0.0);
+        }
+      });
+  }
+};
+
+//----------------------------------------------------------------------------
+template<typename OutputArrayT>
+vtkSmartPointer<vtkDataArray> Quantize(vtkDataArray* array, int component, const double range[2])
+{
+  using OutputT = typename OutputArrayT::ValueType;
+  vtkNew<OutputArrayT> output;
+  output->SetName(array->GetName());
+  output->SetNumberOfTuples(array->GetNumberOfTuples());
+
+  QuantizeWorker<OutputT> worker;
+  if (!vtkArrayDispatch::Dispatch::Execute(array, worker, output->GetPointer(0), component, range))
+  {
+    worker(array, output->GetPointer(0), component, range);
+  }
+  return output;
+}
+}
+
+vtkStandardNewMacro(vtkF3DQuantizeImageFilter);
+
+//----------------------------------------------------------------------------
+vtkF3DQuantizeImageFilter::vtkF3DQuantizeImageFilter()
+{
+  this->SetInputArrayToProcess(
+    0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, vtkDataSetAttributes::SCALARS);
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DQuantizeImageFilter::GetOutputRange(double range[2])
+{
+  range[0] = 0.0;
+  range[1] = this->OutputScalarType == VTK_UNSIGNED_CHAR ?
+    static_cast<double>(std::numeric_limits<unsigned char>::max()) :
+    static_cast<double>(std::numeric_limits<unsigned short>::max());
+}
+
+//----------------------------------------------------------------------------
+int vtkF3DQuantizeImageFilter::RequestData(
+  vtkInformation*, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  vtkImageData* input = vtkImageData::GetData(inputVector[0]);
+  vtkImageData* output = vtkImageData::GetData(outputVector);
+  output->CopyStructure(input);
+
+  int association = vtkDataObject::FIELD_ASSOCIATION_POINTS;
+  vtkDataArray* array = this->GetInputArrayToProcess(0, inputVector, association);
+  if (!array || this->Component >= array->GetNumberOfComponents())
+  {
+    F3DLog::Print(F3DLog::Severity::Warning, "Cannot find the array to quantize");
+    return 1;
+  }
+
+  vtkSmartPointer<vtkDataArray> quantized = this->OutputScalarType == VTK_UNSIGNED_CHAR ?
+    ::Quantize<vtkUnsignedCharArray>(array, this->Component, this->ScalarRange) :
+    ::Quantize<vtkUnsignedShortArray>(array, this->Component, this->ScalarRange);
+
+  vtkDataSetAttributes* data = association == vtkDataObject::FIELD_ASSOCIATION_CELLS ?
+    static_cast<vtkDataSetAttributes*>(output->GetCellData()) :
+    static_cast<vtkDataSetAttributes*>(output->GetPointData());
+  data->SetScalars(quantized);
+  return 1;
+}
@@ -0,0 +1,71 @@
+/**
+ * @class   vtkF3DQuantizeImageFilter
+ * @brief   Quantize an array of an image to normalized 8-bit or 16-bit values
+ *
+ * The filter outputs an image with the structure of its input and a single array, with the name
+ * of the quantized input array selected with SetInputArrayToProcess. The component, or the
+ * magnitude, of each tuple is linearly mapped from the scalar range to the full range of the
+ * output type, the values out of the scalar range are clamped.
+ * It is used to upload the volumes in smaller 3D textures, the transfer functions must then be
+ * rescaled from the scalar range to the output range, see GetOutputRange.
+ */
+
+#ifndef vtkF3DQuantizeImageFilter_h
+#define vtkF3DQuantizeImageFilter_h
+
+#include <vtkImageAlgorithm.h>
+
+class vtkF3DQuantizeImageFilter : public vtkImageAlgorithm
+{
+public:
+  static vtkF3DQuantizeImageFilter* New();
+  vtkTypeMacro(vtkF3DQuantizeImageFilter, vtkImageAlgorithm);
+
+  ///@{
+  /**
+   * Set/Get the component to quantize, -1 quantizes the magnitude.
+   * Default is -1.
+   */
+  vtkSetMacro(Component, int);
+  vtkGetMacro(Component, int);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the scalar range mapped to the output range.
+   * Default is [0, 1].
+   */
+  vtkSetVector2Macro(ScalarRange, double);
+  vtkGetVector2Macro(ScalarRange, double);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the type of the output array, VTK_UNSIGNED_CHAR or VTK_UNSIGNED_SHORT.
+   * Default is VTK_UNSIGNED_SHORT.
+   */
+  vtkSetMacro(OutputScalarType, int);
+  vtkGetMacro(OutputScalarType, int);
+  ///@}
+
+  /**
+   * Get the range of the output values, [0, 255] or [0, 65535].
+   */
+  void GetOutputRange(double range[2]);
+
+protected:
+  vtkF3DQuantizeImageFilter();
+  ~vtkF3DQuantizeImageFilter() override = default;
+
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+
+private:
+  vtkF3DQuantizeImageFilter(const vtkF3DQuantizeImageFilter&) = delete;
+  void operator=(const vtkF3DQuantizeImageFilter&) = delete;
+
+  int Component = -1;
+  double ScalarRange[2] = { 0.0, 1.0 };
+  int OutputScalarType = VTK_UNSIGNED_SHORT;
+};
+
+#endif
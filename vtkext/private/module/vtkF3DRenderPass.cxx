@@ -1,57 +1,228 @@
 #include "vtkF3DRenderPass.h"
 
 #include "vtkF3DConfigure.h"
+#include "vtkF3DDualDepthPeelingPass.h"
+#include "vtkF3DFrameStatistics.h"
 #include "vtkF3DHexagonalBokehBlurPass.h"
+#include "vtkF3DSSAOPass.h"
+#include "vtkF3DTimerPass.h"
 
+#if !defined(__ANDROID__) && !defined(__EMSCRIPTEN__) &&                                           \
+  VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240203)
+#include "vtkF3DPointSplatMapper.h"
+#endif
+
+#include <vtkActor.h>
 #include <vtkBoundingBox.h>
+#include <vtkCamera.h>
 #include <vtkCameraPass.h>
-#include <vtkDualDepthPeelingPass.h>
+#include <vtkLight.h>
+#include <vtkLightCollection.h>
 #include <vtkLightsPass.h>
+#include <vtkMath.h>
+#include <vtkMatrix4x4.h>
+#include <vtkNew.h>
 #include <vtkObjectFactory.h>
 #include <vtkOpaquePass.h>
 #include <vtkOpenGLFXAAPass.h>
+#include <vtkOpenGLFramebufferObject.h>
 #include <vtkOpenGLRenderUtilities.h>
 #include <vtkOpenGLRenderWindow.h>
 #include <vtkOpenGLShaderCache.h>
 #include <vtkOpenGLState.h>
+#include <vtkOrderIndependentTranslucentPass.h>
 #include <vtkOverlayPass.h>
 #include <vtkProp.h>
+#include <vtkProp3D.h>
 #include <vtkRenderPassCollection.h>
 #include <vtkRenderState.h>
 #include <vtkRenderWindow.h>
+#include <vtkRenderWindowInteractor.h>
 #include <vtkRenderer.h>
 #include <vtkSSAOPass.h>
 #include <vtkSequencePass.h>
 #include <vtkShaderProgram.h>
+#include <vtkShaderProperty.h>
 #include <vtkSkybox.h>
+#include <vtkTexture.h>
 #include <vtkTextureObject.h>
 #include <vtkToneMappingPass.h>
 #include <vtkTranslucentPass.h>
+#include <vtkUniforms.h>
 #include <vtkVersion.h>
 #include <vtkVolumetricPass.h>
 
 #if F3D_MODULE_RAYTRACING
 #include <vtkOSPRayPass.h>
+#include <vtkOSPRayRendererNode.h>
 #endif
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <sstream>
 
+namespace
+{
+// size of the blocks of depth pixels reduced to a single texel of the hierarchical depth buffer
+constexpr int DEPTH_REDUCTION = 8;
+
+// number of jitter offsets of the temporal anti-aliasing, and of frames rendered once still
+constexpr int TEMPORAL_SAMPLES = 16;
+
+// bounds and step of the scale of the dynamic resolution, the step avoids resizing the
+// framebuffers for small variations of the render time
+constexpr double MIN_RESOLUTION_SCALE = 0.25;
+constexpr double RESOLUTION_SCALE_STEP = 0.125;
+
+//----------------------------------------------------------------------------
+/**
+ * Return the resolution scale reaching the frame rate, given the render time of a frame
+ * rendered with the provided scale. The render time is assumed proportional to the number of
+ * pixels, and the scale is only changed when the render time is not between 70% and 100% of
+ * the frame time, so that it does not oscillate between two steps.
+ */
+double AdaptResolutionScale(double scale, double renderTime, double frameRate)
+{
+  double ratio = renderTime * frameRate;
+  if (ratio <= 0.0 || (ratio >= 0.7 && ratio <= 1.0))
+  {
+    return scale;
+  }
+
+  // aim at 85% of the frame time, rounded down to a step
+  double target = scale * std::sqrt(0.85 / ratio);
+  target = std::floor(target / RESOLUTION_SCALE_STEP) * RESOLUTION_SCALE_STEP;
+  return std::clamp(target, MIN_RESOLUTION_SCALE, 1.0);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * Return true if the render window is rendering at the interactive update rate
+ */
+bool IsInteracting(vtkRenderer* r)
+{
+  vtkRenderWindow* renWin = r->GetRenderWindow();
+  vtkRenderWindowInteractor* iren = renWin->GetInteractor();
+  return iren && renWin->GetDesiredUpdateRate() > iren->GetStillUpdateRate();
+}
+
+//----------------------------------------------------------------------------
+/**
+ * Return true if the splats of one of the props are drawn in the order of a sort that is
+ * not finished yet
+ */
+bool IsSortPending(const std::vector<vtkProp*>& props)
+{
+#if !defined(__ANDROID__) && !defined(__EMSCRIPTEN__) &&                                           \
+  VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240203)
+  for (vtkProp* prop : props)
+  {
+    vtkActor* actor = vtkActor::SafeDownCast(prop);
+    vtkF3DPointSplatMapper* mapper =
+      actor ? vtkF3DPointSplatMapper::SafeDownCast(actor->GetMapper()) : nullptr;
+    if (mapper && mapper->IsSortPending())
+    {
+      return true;
+    }
+  }
+#else
+  (void)props;
+#endif
+  return false;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * Return the element of the Halton low discrepancy sequence of the provided base, in [0, 1[
+ */
+double Halton(int index, int base)
+{
+  double result = 0.0;
+  double fraction = 1.0;
+  for (int i = index; i > 0; i /= base)
+  {
+    fraction /= base;
+    result += fraction * (i % base);
+  }
+  return result;
+}
+}
+
 vtkStandardNewMacro(vtkF3DRenderPass);
 
+// ----------------------------------------------------------------------------
+vtkF3DRenderPass::vtkF3DRenderPass() = default;
+
+// ----------------------------------------------------------------------------
+vtkF3DRenderPass::~vtkF3DRenderPass() = default;
+
 // ----------------------------------------------------------------------------
 void vtkF3DRenderPass::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
   os << indent << "UseRaytracing: " << this->UseRaytracing << "\n";
   os << indent << "UseSSAOPass: " << this->UseSSAOPass << "\n";
+  os << indent << "AmbientOcclusionDownsampling: " << this->AmbientOcclusionDownsampling << "\n";
+  os << indent << "UseEDLPass: " << this->UseEDLPass << "\n";
   os << indent << "UseDepthPeelingPass: " << this->UseDepthPeelingPass << "\n";
+  os << indent << "UseOITPass: " << this->UseOITPass << "\n";
+  os << indent << "TranslucencyPeels: " << this->TranslucencyPeels << "\n";
+  os << indent << "TranslucencyThreshold: " << this->TranslucencyThreshold << "\n";
   os << indent << "UseBlurBackground: " << this->UseBlurBackground << "\n";
   os << indent << "ForceOpaqueBackground: " << this->ForceOpaqueBackground << "\n";
+  os << indent << "UseOcclusionCulling: " << this->UseOcclusionCulling << "\n";
+  os << indent << "UseTAAPass: " << this->UseTAAPass << "\n";
+  os << indent << "ProgressiveFrames: " << this->ProgressiveFrames << "\n";
+  os << indent << "DynamicResolutionFrameRate: " << this->DynamicResolutionFrameRate << "\n";
+}
+
+// ----------------------------------------------------------------------------
+void vtkF3DRenderPass::SetStatistics(vtkF3DFrameStatistics* statistics)
+{
+  if (this->Statistics != statistics)
+  {
+    this->Statistics = statistics;
+    this->Modified();
+  }
 }
 
 // ----------------------------------------------------------------------------
 void vtkF3DRenderPass::ReleaseGraphicsResources(vtkWindow* w)
 {
+  this->FrameState.Valid = false;
+  this->BackgroundState.Valid = false;
+  this->FrameTexture = nullptr;
+  this->AccumulatedFrames = 0;
+  this->ResolutionScale = 1.0;
+  if (this->InteractivePass)
+  {
+    this->InteractivePass->ReleaseGraphicsResources(w);
+  }
+  if (this->AccumulationQuadHelper)
+  {
+    this->AccumulationQuadHelper->ReleaseGraphicsResources(w);
+  }
+  if (this->AccumulationFramebuffer)
+  {
+    this->AccumulationFramebuffer->ReleaseGraphicsResources(w);
+  }
+  if (this->AccumulationTexture)
+  {
+    this->AccumulationTexture->ReleaseGraphicsResources(w);
+  }
+  this->TemporalHistoryValid = false;
+  for (vtkTextureObject* texture : this->TemporalTextures)
+  {
+    if (texture)
+    {
+      texture->ReleaseGraphicsResources(w);
+    }
+  }
+  if (this->TemporalQuadHelper)
+  {
+    this->TemporalQuadHelper->ReleaseGraphicsResources(w);
+  }
   if (this->BlendQuadHelper)
   {
     this->BlendQuadHelper->ReleaseGraphicsResources(w);
@@ -68,6 +239,27 @@ void vtkF3DRenderPass::ReleaseGraphicsResources(vtkWindow* w)
   {
     this->OverlayPass->ReleaseGraphicsResources(w);
   }
+  if (this->DepthReduceQuadHelper)
+  {
+    this->DepthReduceQuadHelper->ReleaseGraphicsResources(w);
+  }
+  if (this->DepthFramebuffer)
+  {
+    this->DepthFramebuffer->ReleaseGraphicsResources(w);
+  }
+  if (this->DepthReduceTexture)
+  {
+    this->DepthReduceTexture->ReleaseGraphicsResources(w);
+  }
+  if (this->DepthNormalsQuadHelper)
+  {
+    this->DepthNormalsQuadHelper->ReleaseGraphicsResources(w);
+  }
+  if (this->DepthNormalsTexture)
+  {
+    this->DepthNormalsTexture->ReleaseGraphicsResources(w);
+  }
+  this->DepthLevels.clear();
 }
 
 // ----------------------------------------------------------------------------
@@ -105,6 +297,9 @@ void vtkF3DRenderPass::Initialize(const vtkRenderState* s)
 
   this->ReleaseGraphicsResources(s->GetRenderer()->GetRenderWindow());
 
+  // passes are only measured when statistics are recorded
+  vtkF3DFrameStatistics* stats = this->Statistics;
+
   // background pass, setup framebuffer, clear and draw skybox
   vtkNew<vtkOpaquePass> bgP;
   vtkNew<vtkCameraPass> bgCamP;
@@ -117,11 +312,11 @@ void vtkF3DRenderPass::Initialize(const vtkRenderState* s)
     vtkNew<vtkF3DHexagonalBokehBlurPass> blur;
     blur->SetCircleOfConfusionRadius(this->CircleOfConfusionRadius);
     blur->SetDelegatePass(bgCamP);
-    this->BackgroundPass->SetDelegatePass(blur);
+    this->BackgroundPass->SetDelegatePass(vtkF3DTimerPass::Wrap(blur, "blur background", stats));
   }
   else
   {
-    this->BackgroundPass->SetDelegatePass(bgCamP);
+    this->BackgroundPass->SetDelegatePass(vtkF3DTimerPass::Wrap(bgCamP, "background", stats));
   }
 
   // overlay pass
@@ -130,16 +325,17 @@ void vtkF3DRenderPass::Initialize(const vtkRenderState* s)
   overlayCamP->SetDelegatePass(overlayP);
 
   this->OverlayPass = vtkSmartPointer<vtkFramebufferPass>::New();
-  this->OverlayPass->SetDelegatePass(overlayCamP);
+  this->OverlayPass->SetDelegatePass(vtkF3DTimerPass::Wrap(overlayCamP, "overlay", stats));
   this->OverlayPass->SetColorFormat(vtkTextureObject::Float32);
 
   // main pass
+  this->InteractivePass = nullptr;
   if (F3D_MODULE_RAYTRACING && this->UseRaytracing)
   {
 #if F3D_MODULE_RAYTRACING
     vtkNew<vtkOSPRayPass> ospP;
     this->MainPass = vtkSmartPointer<vtkFramebufferPass>::New();
-    this->MainPass->SetDelegatePass(ospP);
+    this->MainPass->SetDelegatePass(vtkF3DTimerPass::Wrap(ospP, "raytracing", stats));
     this->MainPass->SetColorFormat(vtkTextureObject::Float32);
 #endif
   }
@@ -160,38 +356,63 @@ void vtkF3DRenderPass::Initialize(const vtkRenderState* s)
       if (bbox.IsValid())
       {
         vtkNew<vtkCameraPass> ssaoCamP;
-        ssaoCamP->SetDelegatePass(opaqueP);
+        ssaoCamP->SetDelegatePass(vtkF3DTimerPass::Wrap(opaqueP, "opaque", stats));
 
-        vtkNew<vtkSSAOPass> ssaoP;
+        // the downsampled pass uses fewer samples per frame and accumulates them over the frames
+        vtkSmartPointer<vtkSSAOPass> ssaoP;
+        if (this->AmbientOcclusionDownsampling > 1)
+        {
+          vtkNew<vtkF3DSSAOPass> accumulatedP;
+          accumulatedP->SetDownsampling(this->AmbientOcclusionDownsampling);
+          accumulatedP->SetKernelSize(32);
+          this->AccumulatedSSAOPass = accumulatedP;
+          ssaoP = accumulatedP;
+        }
+        else
+        {
+          ssaoP = vtkSmartPointer<vtkSSAOPass>::New();
+          ssaoP->SetKernelSize(200);
+        }
         ssaoP->SetRadius(0.1 * bbox.GetDiagonalLength());
         ssaoP->SetBias(0.001 * bbox.GetDiagonalLength());
-        ssaoP->SetKernelSize(200);
         ssaoP->SetDelegatePass(ssaoCamP);
 
-        collection->AddItem(ssaoP);
+        collection->AddItem(vtkF3DTimerPass::Wrap(ssaoP, "ssao", stats));
       }
       else
       {
-        collection->AddItem(opaqueP);
+        collection->AddItem(vtkF3DTimerPass::Wrap(opaqueP, "opaque", stats));
       }
     }
     else
     {
-      collection->AddItem(opaqueP);
+      collection->AddItem(vtkF3DTimerPass::Wrap(opaqueP, "opaque", stats));
     }
 
     // translucent and volumic passes
-    if (this->UseDepthPeelingPass)
+    if (this->UseDepthPeelingPass && this->UseOITPass)
+    {
+      vtkNew<vtkOrderIndependentTranslucentPass> oitP;
+      oitP->SetTranslucentPass(translucentP);
+
+      collection->AddItem(vtkF3DTimerPass::Wrap(oitP, "translucent oit", stats));
+      collection->AddItem(vtkF3DTimerPass::Wrap(volumeP, "volume", stats));
+    }
+    else if (this->UseDepthPeelingPass)
     {
-      vtkNew<vtkDualDepthPeelingPass> ddpP;
+      vtkNew<vtkF3DDualDepthPeelingPass> ddpP;
       ddpP->SetTranslucentPass(translucentP);
       ddpP->SetVolumetricPass(volumeP);
-      collection->AddItem(ddpP);
+      ddpP->SetMaximumNumberOfPeels(this->TranslucencyPeels);
+      ddpP->SetOcclusionRatio(this->TranslucencyThreshold);
+
+      // the peels render the translucent pass several times, so it is measured as a whole
+      collection->AddItem(vtkF3DTimerPass::Wrap(ddpP, "depth peeling", stats));
     }
     else
     {
-      collection->AddItem(translucentP);
-      collection->AddItem(volumeP);
+      collection->AddItem(vtkF3DTimerPass::Wrap(translucentP, "translucent", stats));
+      collection->AddItem(vtkF3DTimerPass::Wrap(volumeP, "volume", stats));
     }
 
     vtkNew<vtkSequencePass> sequence;
@@ -206,11 +427,52 @@ void vtkF3DRenderPass::Initialize(const vtkRenderState* s)
 
     // Needed because VTK can pick the wrong format with certain drivers
     this->MainPass->SetDepthFormat(vtkTextureObject::Fixed32);
+
+    // while interacting, the progressive mode renders without ambient occlusion and depth peeling
+    if (this->ProgressiveFrames > 0)
+    {
+      vtkNew<vtkLightsPass> interactiveLightsP;
+      vtkNew<vtkOpaquePass> interactiveOpaqueP;
+      vtkNew<vtkTranslucentPass> interactiveTranslucentP;
+      vtkNew<vtkVolumetricPass> interactiveVolumeP;
+
+      vtkNew<vtkRenderPassCollection> interactiveCollection;
+      interactiveCollection->AddItem(interactiveLightsP);
+      interactiveCollection->AddItem(vtkF3DTimerPass::Wrap(interactiveOpaqueP, "opaque", stats));
+      interactiveCollection->AddItem(
+        vtkF3DTimerPass::Wrap(interactiveTranslucentP, "translucent", stats));
+      interactiveCollection->AddItem(vtkF3DTimerPass::Wrap(interactiveVolumeP, "volume", stats));
+
+      vtkNew<vtkSequencePass> interactiveSequence;
+      interactiveSequence->SetPasses(interactiveCollection);
+
+      vtkNew<vtkCameraPass> interactiveCamP;
+      interactiveCamP->SetDelegatePass(interactiveSequence);
+
+      this->InteractivePass = vtkSmartPointer<vtkFramebufferPass>::New();
+      this->InteractivePass->SetDelegatePass(interactiveCamP);
+      this->InteractivePass->SetColorFormat(vtkTextureObject::Float32);
+      this->InteractivePass->SetDepthFormat(vtkTextureObject::Fixed32);
+    }
   }
 
   this->InitializeTime = this->GetMTime();
 }
 
+// ----------------------------------------------------------------------------
+bool vtkF3DRenderPass::IsAccumulating() const
+{
+  if (this->ProgressiveFrames > 0)
+  {
+    return this->AccumulatedFrames < this->ProgressiveFrames;
+  }
+  if (this->UseTAAPass && !this->UseRaytracing && this->AccumulatedFrames < TEMPORAL_SAMPLES)
+  {
+    return true;
+  }
+  return this->AccumulatedSSAOPass && !this->AccumulatedSSAOPass->IsConverged();
+}
+
 // ----------------------------------------------------------------------------
 void vtkF3DRenderPass::Render(const vtkRenderState* s)
 {
@@ -221,17 +483,31 @@ void vtkF3DRenderPass::Render(const vtkRenderState* s)
   vtkRenderer* r = s->GetRenderer();
   r->GetBackground(bgColor);
 
+  // the progressive mode renders a cheap frame while interacting,
+  // and accumulates frames while the view is still
+  bool interacting = ::IsInteracting(r);
+  bool progressive = this->ProgressiveFrames > 0 && !r->GetSelector();
+  std::vector<vtkProp*> frameProps = this->BackgroundProps;
+  frameProps.insert(frameProps.end(), this->MainProps.begin(), this->MainProps.end());
+  bool frameChanged = this->HasStateChanged(this->FrameState, s, std::move(frameProps));
+  bool backgroundChanged = this->HasStateChanged(this->BackgroundState, s, this->BackgroundProps);
+  if (frameChanged || interacting)
+  {
+    this->AccumulatedFrames = 0;
+  }
+
+  // when only the overlay changed (fps counter, progress bar, ...), the previous frame is reused,
+  // except while raytracing accumulates samples outside of the progressive mode,
+  // when rendering it again would give another frame, or when it was rendered with the
+  // shortcuts of the interaction and the view is now still
+  bool frameUpToDate = !frameChanged && this->FrameTexture &&
+    !(this->UseRaytracing && !progressive) && !this->IsAccumulating() && !this->FrameIncomplete &&
+    (interacting || !this->FrameInteractive);
+
   // force background to full black when generating offscreen layers to avoid blending
   // problems when compositing layers in the Blend() function
   r->SetBackground(0.0, 0.0, 0.0);
 
-  vtkRenderState backgroundState(s->GetRenderer());
-  backgroundState.SetPropArrayAndCount(
-    this->BackgroundProps.data(), static_cast<int>(this->BackgroundProps.size()));
-  backgroundState.SetFrameBuffer(s->GetFrameBuffer());
-
-  this->BackgroundPass->Render(&backgroundState);
-
   vtkRenderState overlayState(s->GetRenderer());
   overlayState.SetPropArrayAndCount(
     this->OverlayProps.data(), static_cast<int>(this->OverlayProps.size()));
@@ -239,22 +515,508 @@ void vtkF3DRenderPass::Render(const vtkRenderState* s)
 
   this->OverlayPass->Render(&overlayState);
 
+  if (frameUpToDate)
+  {
+    this->FrameReused = true;
+    r->SetBackground(bgColor);
+    this->FrameState.RendererTime = this->BackgroundState.RendererTime = r->GetMTime();
+    this->Blend(s, this->FrameTexture);
+    return;
+  }
+
+  // the background, and its blur, is not rendered again when only the main props changed
+  if (backgroundChanged)
+  {
+    vtkRenderState backgroundState(s->GetRenderer());
+    backgroundState.SetPropArrayAndCount(
+      this->BackgroundProps.data(), static_cast<int>(this->BackgroundProps.size()));
+    backgroundState.SetFrameBuffer(s->GetFrameBuffer());
+
+    this->BackgroundPass->Render(&backgroundState);
+  }
+
+  // raytracing needs all the props for shadows and reflections,
+  // and the hardware selector for the props under the cursor
+  bool useCulling = !this->UseRaytracing && !r->GetSelector();
+
+  // the depth of the previous frame is only an approximation of the current one,
+  // so occlusion culling is only used while interacting and the still render is exact
+  bool useOcclusion = useCulling && this->UseOcclusionCulling && interacting;
+
+  std::vector<vtkProp*>& mainProps = useCulling ? this->VisibleProps : this->MainProps;
+  if (useCulling)
+  {
+    this->CullMainProps(s, useOcclusion);
+  }
+
+  vtkFramebufferPass* mainPass =
+    progressive && interacting && this->InteractivePass ? this->InteractivePass : this->MainPass;
+
+  // still frames are jittered by a sub-pixel offset and averaged, which anti-aliases them,
+  // raytracing accumulates its own samples while the camera is unchanged
+  bool accumulate = progressive && !interacting && !this->UseRaytracing;
+
+  // the temporal anti-aliasing jitters all the frames and blends them with the reprojected
+  // history, the hardware selector needs the exact props ids
+  bool temporal = this->UseTAAPass && !accumulate && !this->UseRaytracing && !r->GetSelector();
+
+  bool jitter = (accumulate && this->AccumulatedFrames > 0) || temporal;
+  vtkCamera* camera = r->GetActiveCamera();
+  double windowCenter[2];
+  camera->GetWindowCenter(windowCenter);
+  double jitterOffset[2] = { 0.0, 0.0 };
+  if (jitter)
+  {
+    int size[2];
+    r->GetTiledSize(&size[0], &size[1]);
+    int index = temporal ? this->TemporalFrames % TEMPORAL_SAMPLES + 1 : this->AccumulatedFrames;
+    jitterOffset[0] = (2.0 * ::Halton(index, 2) - 1.0) / size[0];
+    jitterOffset[1] = (2.0 * ::Halton(index, 3) - 1.0) / size[1];
+    camera->SetWindowCenter(windowCenter[0] + jitterOffset[0], windowCenter[1] + jitterOffset[1]);
+  }
+
+#if F3D_MODULE_RAYTRACING
+  // the denoiser is expensive, in progressive mode it is only run on the converged frame
+  if (this->UseRaytracing)
+  {
+    bool lastFrame = !progressive ||
+      (!interacting && this->AccumulatedFrames + 1 >= this->ProgressiveFrames);
+    vtkOSPRayRendererNode::SetEnableDenoiser(this->UseRaytracingDenoiser && lastFrame, r);
+  }
+#endif
+
+  // while interacting, the resolution is adapted using the render time of the previous frame,
+  // measured by the renderer
+  bool dynamicResolution = this->DynamicResolutionFrameRate > 0 && interacting &&
+    !this->UseRaytracing && !r->GetSelector();
+  if (!dynamicResolution)
+  {
+    this->ResolutionScale = 1.0;
+  }
+  else if (!this->FrameReused)
+  {
+    this->ResolutionScale = ::AdaptResolutionScale(
+      this->ResolutionScale, r->GetLastRenderTimeInSeconds(), this->DynamicResolutionFrameRate);
+  }
+  this->FrameReused = false;
+
   vtkRenderState mainState(s->GetRenderer());
-  mainState.SetPropArrayAndCount(this->MainProps.data(), static_cast<int>(this->MainProps.size()));
+  mainState.SetPropArrayAndCount(mainProps.data(), static_cast<int>(mainProps.size()));
   mainState.SetFrameBuffer(s->GetFrameBuffer());
 
-  this->MainPass->Render(&mainState);
+  // the main passes are sized by the tiled viewport of the renderer, so it is scaled to render
+  // into smaller framebuffers, with the same aspect ratio
+  double viewport[4];
+  r->GetViewport(viewport);
+  bool scaled = this->ResolutionScale < 1.0;
+  if (scaled)
+  {
+    r->SetViewport(viewport[0], viewport[1],
+      viewport[0] + this->ResolutionScale * (viewport[2] - viewport[0]),
+      viewport[1] + this->ResolutionScale * (viewport[3] - viewport[1]));
+    mainState.SetFrameBuffer(nullptr);
+  }
+
+  mainPass->Render(&mainState);
+
+  if (scaled)
+  {
+    r->SetViewport(viewport);
+  }
+
+  if (jitter)
+  {
+    camera->SetWindowCenter(windowCenter[0], windowCenter[1]);
+  }
+
+  if (useCulling && this->UseOcclusionCulling)
+  {
+    this->UpdateDepthPyramid(s, mainPass->GetDepthTexture());
+  }
+  else
+  {
+    this->DepthLevels.clear();
+  }
+
+  this->FrameDepthTexture = mainPass->GetDepthTexture();
+
+  // the occlusion culling uses the depth of the previous frame and the splats sort can be spread
+  // across several frames, so rendering the same view again gives a more exact frame
+  this->FrameIncomplete = useOcclusion || ::IsSortPending(mainProps);
+  this->FrameInteractive =
+    this->FrameIncomplete || scaled || mainPass == this->InteractivePass.GetPointer();
+
+  vtkTextureObject* mainTexture = mainPass->GetColorTexture();
+  if (accumulate)
+  {
+    mainTexture = this->Accumulate(s, mainTexture);
+  }
+  if (temporal)
+  {
+    mainTexture = this->ResolveTemporal(
+      s, mainTexture, mainPass->GetDepthTexture(), jitterOffset, !interacting);
+    this->TemporalFrames++;
+  }
+  else
+  {
+    this->TemporalHistoryValid = false;
+  }
+  if ((progressive || temporal) && !interacting)
+  {
+    this->AccumulatedFrames++;
+  }
+  this->FrameTexture = mainTexture;
 
   // restore background color before compositing the layers
   r->SetBackground(bgColor);
 
-  this->Blend(s);
+  // the renderer is modified by the background changes above, not by the user
+  this->FrameState.RendererTime = this->BackgroundState.RendererTime = r->GetMTime();
+
+  this->Blend(s, mainTexture);
 
-  this->NumberOfRenderedProps = this->MainPass->GetNumberOfRenderedProps();
+  this->NumberOfRenderedProps = mainPass->GetNumberOfRenderedProps();
 }
 
 // ----------------------------------------------------------------------------
-void vtkF3DRenderPass::Blend(const vtkRenderState* s)
+bool vtkF3DRenderPass::HasStateChanged(
+  PassState& state, const vtkRenderState* s, std::vector<vtkProp*> props)
+{
+  vtkRenderer* r = s->GetRenderer();
+
+  // the hardware selector renders the props ids in the textures
+  if (r->GetSelector())
+  {
+    state.Valid = false;
+    this->FrameTexture = nullptr;
+    return true;
+  }
+
+  // the animations can only modify the custom uniforms of the shaders, eg. the joint matrices
+  // of the skinning or the morphing weights, which are not part of the redraw time of the actor
+  vtkMTimeType propsTime = 0;
+  for (vtkProp* prop : props)
+  {
+    propsTime = std::max(propsTime, prop->GetRedrawMTime());
+    if (vtkActor* actor = vtkActor::SafeDownCast(prop))
+    {
+      vtkShaderProperty* shaderProperty = actor->GetShaderProperty();
+      propsTime = std::max({ propsTime, shaderProperty->GetMTime(),
+        shaderProperty->GetVertexCustomUniforms()->GetMTime(),
+        shaderProperty->GetFragmentCustomUniforms()->GetMTime(),
+        shaderProperty->GetGeometryCustomUniforms()->GetMTime() });
+    }
+  }
+
+  vtkLightCollection* lights = r->GetLights();
+  vtkCollectionSimpleIterator lightIt;
+  lights->InitTraversal(lightIt);
+  while (vtkLight* light = lights->GetNextLight(lightIt))
+  {
+    propsTime = std::max(propsTime, light->GetMTime());
+  }
+
+  if (vtkTexture* environment = r->GetEnvironmentTexture())
+  {
+    propsTime = std::max(propsTime, environment->GetMTime());
+  }
+
+  // the camera is modified by the clipping range reset of each render, compare its matrix instead
+  int size[2];
+  int origin[2];
+  r->GetTiledSizeAndOrigin(&size[0], &size[1], &origin[0], &origin[1]);
+  vtkMatrix4x4* cameraMatrix = r->GetActiveCamera()->GetCompositeProjectionTransformMatrix(
+    r->GetTiledAspectRatio(), -1, 1);
+
+  bool unchanged = state.Valid && state.Props == props && state.PropsTime == propsTime &&
+    state.RendererTime == r->GetMTime() && state.InitializeTime == this->InitializeTime &&
+    state.Size[0] == size[0] && state.Size[1] == size[1] &&
+    std::equal(state.Camera, state.Camera + 16, cameraMatrix->GetData());
+
+  if (!unchanged)
+  {
+    state.Valid = true;
+    state.Props = std::move(props);
+    state.PropsTime = propsTime;
+    state.InitializeTime = this->InitializeTime;
+    state.Size[0] = size[0];
+    state.Size[1] = size[1];
+    std::copy(cameraMatrix->GetData(), cameraMatrix->GetData() + 16, state.Camera);
+  }
+  return !unchanged;
+}
+
+// ----------------------------------------------------------------------------
+vtkTextureObject* vtkF3DRenderPass::Accumulate(const vtkRenderState* s, vtkTextureObject* color)
+{
+  vtkRenderer* r = s->GetRenderer();
+  vtkOpenGLRenderWindow* renWin = static_cast<vtkOpenGLRenderWindow*>(r->GetRenderWindow());
+
+  int width = static_cast<int>(color->GetWidth());
+  int height = static_cast<int>(color->GetHeight());
+
+  if (!this->AccumulationTexture ||
+    static_cast<int>(this->AccumulationTexture->GetWidth()) != width ||
+    static_cast<int>(this->AccumulationTexture->GetHeight()) != height)
+  {
+    this->AccumulationTexture = vtkSmartPointer<vtkTextureObject>::New();
+    this->AccumulationTexture->SetContext(renWin);
+    this->AccumulationTexture->SetFormat(GL_RGBA);
+    this->AccumulationTexture->SetInternalFormat(GL_RGBA32F);
+    this->AccumulationTexture->SetDataType(GL_FLOAT);
+    this->AccumulationTexture->SetMinificationFilter(vtkTextureObject::Nearest);
+    this->AccumulationTexture->SetMagnificationFilter(vtkTextureObject::Nearest);
+    this->AccumulationTexture->Allocate2D(width, height, 4, VTK_FLOAT);
+    this->AccumulatedFrames = 0;
+  }
+
+  if (!this->AccumulationFramebuffer)
+  {
+    this->AccumulationFramebuffer = vtkSmartPointer<vtkOpenGLFramebufferObject>::New();
+    this->AccumulationFramebuffer->SetContext(renWin);
+  }
+
+  if (!this->AccumulationQuadHelper)
+  {
+    std::string FSSource = vtkOpenGLRenderUtilities::GetFullScreenQuadFragmentShaderTemplate();
+
+    vtkShaderProgram::Substitute(
+      FSSource, "//VTK::FSQ::Decl", "uniform sampler2D texMain;\n//VTK::FSQ::Decl");
+    vtkShaderProgram::Substitute(
+      FSSource, "//VTK::FSQ::Impl", "  gl_FragData[0] = texture(texMain, texCoord);\n");
+
+    this->AccumulationQuadHelper = std::make_shared<vtkOpenGLQuadHelper>(renWin,
+      vtkOpenGLRenderUtilities::GetFullScreenQuadVertexShader().c_str(), FSSource.c_str(), "");
+  }
+  else
+  {
+    renWin->GetShaderCache()->ReadyShaderProgram(this->AccumulationQuadHelper->Program);
+  }
+
+  if (!this->AccumulationQuadHelper->Program ||
+    !this->AccumulationQuadHelper->Program->GetCompiled())
+  {
+    vtkErrorMacro("Couldn't build the accumulation shader program.");
+    return color;
+  }
+
+  color->Activate();
+  this->AccumulationQuadHelper->Program->SetUniformi("texMain", color->GetTextureUnit());
+
+  {
+    vtkOpenGLState* ostate = renWin->GetState();
+    vtkOpenGLState::ScopedglViewport viewportSaver(ostate);
+    vtkOpenGLState::ScopedglScissor scissorSaver(ostate);
+    vtkOpenGLState::ScopedglEnableDisable blendSaver(ostate, GL_BLEND);
+    vtkOpenGLState::ScopedglEnableDisable depthSaver(ostate, GL_DEPTH_TEST);
+    vtkOpenGLState::ScopedglBlendFuncSeparate blendFuncSaver(ostate);
+
+    // running average of the frames since the view changed
+    ostate->vtkglDisable(GL_DEPTH_TEST);
+    ostate->vtkglEnable(GL_BLEND);
+    ostate->vtkglBlendFuncSeparate(GL_CONSTANT_ALPHA, GL_ONE_MINUS_CONSTANT_ALPHA,
+      GL_CONSTANT_ALPHA, GL_ONE_MINUS_CONSTANT_ALPHA);
+    glBlendColor(0.f, 0.f, 0.f, 1.f / static_cast<float>(this->AccumulatedFrames + 1));
+
+    ostate->PushFramebufferBindings();
+    this->AccumulationFramebuffer->Bind();
+    this->AccumulationFramebuffer->AddColorAttachment(0, this->AccumulationTexture);
+    this->AccumulationFramebuffer->ActivateDrawBuffers(1);
+    this->AccumulationFramebuffer->StartNonOrtho(width, height);
+
+    this->AccumulationQuadHelper->Render();
+
+    this->AccumulationFramebuffer->RemoveColorAttachments(1);
+    ostate->PopFramebufferBindings();
+  }
+
+  color->Deactivate();
+
+  return this->AccumulationTexture;
+}
+
+// ----------------------------------------------------------------------------
+vtkTextureObject* vtkF3DRenderPass::ResolveTemporal(const vtkRenderState* s,
+  vtkTextureObject* color, vtkTextureObject* depth, const double jitter[2], bool still)
+{
+  vtkRenderer* r = s->GetRenderer();
+  vtkOpenGLRenderWindow* renWin = static_cast<vtkOpenGLRenderWindow*>(r->GetRenderWindow());
+
+  if (!depth)
+  {
+    this->TemporalHistoryValid = false;
+    return color;
+  }
+
+  int width = static_cast<int>(color->GetWidth());
+  int height = static_cast<int>(color->GetHeight());
+
+  for (vtkSmartPointer<vtkTextureObject>& texture : this->TemporalTextures)
+  {
+    if (!texture || static_cast<int>(texture->GetWidth()) != width ||
+      static_cast<int>(texture->GetHeight()) != height)
+    {
+      texture = vtkSmartPointer<vtkTextureObject>::New();
+      texture->SetContext(renWin);
+      texture->SetFormat(GL_RGBA);
+      texture->SetInternalFormat(GL_RGBA32F);
+      texture->SetDataType(GL_FLOAT);
+      texture->SetWrapS(vtkTextureObject::ClampToEdge);
+      texture->SetWrapT(vtkTextureObject::ClampToEdge);
+      texture->Allocate2D(width, height, 4, VTK_FLOAT);
+      this->TemporalHistoryValid = false;
+    }
+  }
+
+  if (!this->AccumulationFramebuffer)
+  {
+    this->AccumulationFramebuffer = vtkSmartPointer<vtkOpenGLFramebufferObject>::New();
+    this->AccumulationFramebuffer->SetContext(renWin);
+  }
+
+  if (!this->TemporalQuadHelper)
+  {
+    std::string FSSource = vtkOpenGLRenderUtilities::GetFullScreenQuadFragmentShaderTemplate();
+
+    std::stringstream ssDecl;
+    ssDecl << "uniform sampler2D texMain;\n"
+              "uniform sampler2D texDepth;\n"
+              "uniform sampler2D texHistory;\n"
+              "uniform mat4 reprojection;\n"
+              "uniform vec2 jitter;\n"
+              "uniform float blendFactor;\n"
+              "uniform int clampHistory;\n"
+              "//VTK::FSQ::Decl";
+
+    vtkShaderProgram::Substitute(FSSource, "//VTK::FSQ::Decl", ssDecl.str());
+
+    // the history is reprojected from the unjittered position of the pixel, and clamped to the
+    // colors of the 3x3 neighborhood so that the disoccluded surfaces do not leave trails
+    std::stringstream ssImpl;
+    ssImpl << "  ivec2 texel = ivec2(gl_FragCoord.xy);\n";
+    ssImpl << "  ivec2 size = textureSize(texMain, 0);\n";
+    ssImpl << "  vec4 current = texelFetch(texMain, texel, 0);\n";
+    ssImpl << "  vec4 minColor = current;\n";
+    ssImpl << "  vec4 maxColor = current;\n";
+    ssImpl << "  for (int j = -1; j <= 1; j++)\n";
+    ssImpl << "  {\n";
+    ssImpl << "    for (int i = -1; i <= 1; i++)\n";
+    ssImpl << "    {\n";
+    ssImpl << "      ivec2 neighbor = clamp(texel + ivec2(i, j), ivec2(0), size - 1);\n";
+    ssImpl << "      vec4 neighborColor = texelFetch(texMain, neighbor, 0);\n";
+    ssImpl << "      minColor = min(minColor, neighborColor);\n";
+    ssImpl << "      maxColor = max(maxColor, neighborColor);\n";
+    ssImpl << "    }\n";
+    ssImpl << "  }\n";
+    ssImpl << "  float depth = texelFetch(texDepth, texel, 0).r;\n";
+    ssImpl << "  vec4 ndc = vec4(texCoord * 2.0 - 1.0 - jitter, 2.0 * depth - 1.0, 1.0);\n";
+    ssImpl << "  vec4 previous = reprojection * ndc;\n";
+    ssImpl << "  vec2 previousCoord = previous.xy / previous.w * 0.5 + 0.5;\n";
+    ssImpl << "  if (blendFactor >= 1.0 || previous.w <= 0.0 ||\n";
+    ssImpl << "    any(lessThan(previousCoord, vec2(0.0))) ||\n";
+    ssImpl << "    any(greaterThan(previousCoord, vec2(1.0))))\n";
+    ssImpl << "  {\n";
+    ssImpl << "    gl_FragData[0] = current;\n";
+    ssImpl << "    return;\n";
+    ssImpl << "  }\n";
+    ssImpl << "  vec4 history = texture(texHistory, previousCoord);\n";
+    ssImpl << "  if (clampHistory == 1)\n";
+    ssImpl << "    history = clamp(history, minColor, maxColor);\n";
+    ssImpl << "  gl_FragData[0] = mix(history, current, blendFactor);\n";
+
+    vtkShaderProgram::Substitute(FSSource, "//VTK::FSQ::Impl", ssImpl.str());
+
+    this->TemporalQuadHelper = std::make_shared<vtkOpenGLQuadHelper>(renWin,
+      vtkOpenGLRenderUtilities::GetFullScreenQuadVertexShader().c_str(), FSSource.c_str(), "");
+  }
+  else
+  {
+    renWin->GetShaderCache()->ReadyShaderProgram(this->TemporalQuadHelper->Program);
+  }
+
+  if (!this->TemporalQuadHelper->Program || !this->TemporalQuadHelper->Program->GetCompiled())
+  {
+    vtkErrorMacro("Couldn't build the temporal anti-aliasing shader program.");
+    this->TemporalHistoryValid = false;
+    return color;
+  }
+
+  // the window center is restored, so this is the unjittered projection of the frame,
+  // the reprojection transforms its normalized device coordinates into the previous ones
+  vtkNew<vtkMatrix4x4> projection;
+  projection->DeepCopy(r->GetActiveCamera()->GetCompositeProjectionTransformMatrix(
+    static_cast<double>(width) / height, -1, 1));
+  vtkNew<vtkMatrix4x4> reprojection;
+  vtkMatrix4x4::Invert(projection, reprojection);
+  vtkNew<vtkMatrix4x4> previousProjection;
+  previousProjection->DeepCopy(this->TemporalProjection);
+  vtkMatrix4x4::Multiply4x4(previousProjection, reprojection, reprojection);
+  reprojection->Transpose();
+  std::copy(projection->GetData(), projection->GetData() + 16, this->TemporalProjection);
+
+  // once still, the history is exact and the frames are averaged like the progressive mode,
+  // the first still frame counting as the history, while interacting the history is
+  // exponentially decayed to follow the motion
+  float blendFactor = 1.0f;
+  if (this->TemporalHistoryValid)
+  {
+    blendFactor = still ? 1.f / static_cast<float>(this->AccumulatedFrames + 2) : 0.1f;
+  }
+  float jitterNDC[2] = { static_cast<float>(jitter[0]), static_cast<float>(jitter[1]) };
+
+  vtkTextureObject* history = this->TemporalTextures[this->TemporalHistoryIndex];
+  vtkTextureObject* output = this->TemporalTextures[1 - this->TemporalHistoryIndex];
+
+  // the history is sampled at the reprojected position, between the texels, its filter is
+  // set again since the previous output was blended with a nearest filter
+  history->SetMinificationFilter(vtkTextureObject::Linear);
+  history->SetMagnificationFilter(vtkTextureObject::Linear);
+
+  vtkShaderProgram* program = this->TemporalQuadHelper->Program;
+  color->Activate();
+  depth->Activate();
+  history->Activate();
+  program->SetUniformi("texMain", color->GetTextureUnit());
+  program->SetUniformi("texDepth", depth->GetTextureUnit());
+  program->SetUniformi("texHistory", history->GetTextureUnit());
+  program->SetUniformMatrix("reprojection", reprojection);
+  program->SetUniform2f("jitter", jitterNDC);
+  program->SetUniformf("blendFactor", blendFactor);
+  program->SetUniformi("clampHistory", still ? 0 : 1);
+
+  {
+    vtkOpenGLState* ostate = renWin->GetState();
+    vtkOpenGLState::ScopedglViewport viewportSaver(ostate);
+    vtkOpenGLState::ScopedglScissor scissorSaver(ostate);
+    vtkOpenGLState::ScopedglEnableDisable blendSaver(ostate, GL_BLEND);
+    vtkOpenGLState::ScopedglEnableDisable depthSaver(ostate, GL_DEPTH_TEST);
+    ostate->vtkglDisable(GL_BLEND);
+    ostate->vtkglDisable(GL_DEPTH_TEST);
+
+    ostate->PushFramebufferBindings();
+    this->AccumulationFramebuffer->Bind();
+    this->AccumulationFramebuffer->AddColorAttachment(0, output);
+    this->AccumulationFramebuffer->ActivateDrawBuffers(1);
+    this->AccumulationFramebuffer->StartNonOrtho(width, height);
+
+    this->TemporalQuadHelper->Render();
+
+    this->AccumulationFramebuffer->RemoveColorAttachments(1);
+    ostate->PopFramebufferBindings();
+  }
+
+  color->Deactivate();
+  depth->Deactivate();
+  history->Deactivate();
+
+  this->TemporalHistoryIndex = 1 - this->TemporalHistoryIndex;
+  this->TemporalHistoryValid = true;
+
+  return output;
+}
+
+// ----------------------------------------------------------------------------
+void vtkF3DRenderPass::Blend(const vtkRenderState* s, vtkTextureObject* mainTexture)
 {
   vtkRenderer* r = s->GetRenderer();
   vtkOpenGLRenderWindow* renWin = static_cast<vtkOpenGLRenderWindow*>(r->GetRenderWindow());
@@ -266,7 +1028,12 @@ void vtkF3DRenderPass::Blend(const vtkRenderState* s)
   renWin->GetState()->vtkglEnable(GL_BLEND);
   renWin->GetState()->vtkglBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
 
-  if (this->BlendQuadHelper && this->BlendQuadHelper->ShaderChangeValue < this->GetMTime())
+  // the depth is not meaningful when raytracing
+  vtkTextureObject* depthTexture = this->FrameDepthTexture;
+  bool useEDL = this->UseEDLPass && !this->UseRaytracing && depthTexture;
+
+  if (this->BlendQuadHelper &&
+    (this->BlendQuadHelper->ShaderChangeValue < this->GetMTime() || this->BlendUseEDL != useEDL))
   {
     this->BlendQuadHelper = nullptr;
   }
@@ -280,8 +1047,27 @@ void vtkF3DRenderPass::Blend(const vtkRenderState* s)
               "uniform sampler2D texOverlay;\n"
               "uniform sampler2D texMain;\n"
               "vec3 toLinear(vec3 color) { return pow(color.rgb, vec3(2.2)); }\n"
-              "vec3 toSRGB(vec3 color) { return pow(color.rgb, vec3(1.0 / 2.2)); }\n"
-              "//VTK::FSQ::Decl";
+              "vec3 toSRGB(vec3 color) { return pow(color.rgb, vec3(1.0 / 2.2)); }\n";
+
+    if (useEDL)
+    {
+      // the log of the distance to the camera plane, the background being at the far plane
+      ssDecl << "uniform sampler2D texDepth;\n"
+                "uniform vec2 clipRange;\n"
+                "uniform int parallelProjection;\n"
+                "float logDepth(ivec2 texel)\n"
+                "{\n"
+                "  ivec2 size = textureSize(texDepth, 0);\n"
+                "  float depth = texelFetch(texDepth, clamp(texel, ivec2(0), size - 1), 0).r;\n"
+                "  float n = clipRange.x;\n"
+                "  float f = clipRange.y;\n"
+                "  float z = parallelProjection == 1 ? n + depth * (f - n) :\n"
+                "    2.0 * n * f / (f + n - (2.0 * depth - 1.0) * (f - n));\n"
+                "  return log2(max(z, 1e-6));\n"
+                "}\n";
+    }
+
+    ssDecl << "//VTK::FSQ::Decl";
 
     vtkShaderProgram::Substitute(FSSource, "//VTK::FSQ::Decl", ssDecl.str());
 
@@ -304,6 +1090,28 @@ void vtkF3DRenderPass::Blend(const vtkRenderState* s)
       ssImpl << "  mainSample.rgb *= mainSample.a;\n";
     }
 
+    // the obscurance sums how much closer the neighbors are, at three scales whose weights
+    // decrease with the distance, and the dataset is darkened exponentially with it
+    if (useEDL)
+    {
+      ssImpl << "  ivec2 edlTexel = ivec2(texCoord * vec2(textureSize(texDepth, 0)));\n";
+      ssImpl << "  float edlCenter = logDepth(edlTexel);\n";
+      ssImpl << "  float obscurance = 0.0;\n";
+      ssImpl << "  for (int scale = 1; scale <= 4; scale *= 2)\n";
+      ssImpl << "  {\n";
+      ssImpl << "    float response = 0.0;\n";
+      ssImpl << "    for (int i = 0; i < 8; i++)\n";
+      ssImpl << "    {\n";
+      ssImpl << "      float angle = 0.785398 * float(i);\n";
+      ssImpl << "      ivec2 offset = ivec2(round(float(scale) * vec2(cos(angle), sin(angle))));\n";
+      ssImpl << "      response += max(0.0, edlCenter - logDepth(edlTexel + offset));\n";
+      ssImpl << "    }\n";
+      ssImpl << "    obscurance += response / (8.0 * float(scale));\n";
+      ssImpl << "  }\n";
+      ssImpl << "  if (texelFetch(texDepth, edlTexel, 0).r < 1.0)\n";
+      ssImpl << "    mainSample.rgb *= exp(-100.0 * obscurance);\n";
+    }
+
     // blend main with background
     if (this->ForceOpaqueBackground)
     {
@@ -345,6 +1153,7 @@ void vtkF3DRenderPass::Blend(const vtkRenderState* s)
       vtkOpenGLRenderUtilities::GetFullScreenQuadVertexShader().c_str(), FSSource.c_str(), "");
 
     this->BlendQuadHelper->ShaderChangeValue = this->GetMTime();
+    this->BlendUseEDL = useEDL;
   }
   else
   {
@@ -360,19 +1169,489 @@ void vtkF3DRenderPass::Blend(const vtkRenderState* s)
   this->BackgroundPass->GetColorTexture()->SetWrapS(vtkTextureObject::ClampToEdge);
   this->BackgroundPass->GetColorTexture()->SetWrapT(vtkTextureObject::ClampToEdge);
 
+  // the main texture is smaller than the viewport with a dynamic resolution
+  int vpSize[2];
+  r->GetTiledSize(&vpSize[0], &vpSize[1]);
+  bool upsampled = static_cast<int>(mainTexture->GetWidth()) != vpSize[0] ||
+    static_cast<int>(mainTexture->GetHeight()) != vpSize[1];
+  mainTexture->SetMinificationFilter(
+    upsampled ? vtkTextureObject::Linear : vtkTextureObject::Nearest);
+  mainTexture->SetMagnificationFilter(
+    upsampled ? vtkTextureObject::Linear : vtkTextureObject::Nearest);
+
   this->BackgroundPass->GetColorTexture()->Activate();
   this->OverlayPass->GetColorTexture()->Activate();
-  this->MainPass->GetColorTexture()->Activate();
+  mainTexture->Activate();
   this->BlendQuadHelper->Program->SetUniformi(
     "texBackground", this->BackgroundPass->GetColorTexture()->GetTextureUnit());
   this->BlendQuadHelper->Program->SetUniformi(
     "texOverlay", this->OverlayPass->GetColorTexture()->GetTextureUnit());
   this->BlendQuadHelper->Program->SetUniformi(
-    "texMain", this->MainPass->GetColorTexture()->GetTextureUnit());
+    "texMain", mainTexture->GetTextureUnit());
+  if (useEDL)
+  {
+    vtkCamera* camera = r->GetActiveCamera();
+    double* clipRange = camera->GetClippingRange();
+    float clipRangeF[2] = { static_cast<float>(clipRange[0]), static_cast<float>(clipRange[1]) };
+    depthTexture->Activate();
+    this->BlendQuadHelper->Program->SetUniformi("texDepth", depthTexture->GetTextureUnit());
+    this->BlendQuadHelper->Program->SetUniform2f("clipRange", clipRangeF);
+    this->BlendQuadHelper->Program->SetUniformi(
+      "parallelProjection", camera->GetParallelProjection() ? 1 : 0);
+  }
 
   this->BlendQuadHelper->Render();
 
   this->BackgroundPass->GetColorTexture()->Deactivate();
   this->OverlayPass->GetColorTexture()->Deactivate();
-  this->MainPass->GetColorTexture()->Deactivate();
+  mainTexture->Deactivate();
+  if (useEDL)
+  {
+    depthTexture->Deactivate();
+  }
+}
+
+// ----------------------------------------------------------------------------
+void vtkF3DRenderPass::CullMainProps(const vtkRenderState* s, bool useOcclusion)
+{
+  // props without bounds, or not using them, are never culled
+  std::vector<vtkProp*> cullableProps;
+  std::vector<double> cullableBounds;
+  std::vector<int> propIndices(this->MainProps.size(), -1);
+  for (size_t i = 0; i < this->MainProps.size(); i++)
+  {
+    vtkProp3D* prop = vtkProp3D::SafeDownCast(this->MainProps[i]);
+    if (!prop->GetVisibility() || !prop->GetUseBounds())
+    {
+      continue;
+    }
+
+    const double* bounds = prop->GetBounds();
+    if (!bounds || !vtkBoundingBox::IsValid(bounds))
+    {
+      continue;
+    }
+
+    propIndices[i] = static_cast<int>(cullableProps.size());
+    cullableProps.emplace_back(prop);
+    cullableBounds.insert(cullableBounds.end(), bounds, bounds + 6);
+  }
+
+  this->CullableProps = std::move(cullableProps);
+  this->CullingHierarchy.Update(std::move(cullableBounds));
+
+  vtkRenderer* r = s->GetRenderer();
+  vtkCamera* camera = r->GetActiveCamera();
+  double aspect = r->GetTiledAspectRatio();
+
+  double planes[24];
+  camera->GetFrustumPlanes(aspect, planes);
+
+  useOcclusion = useOcclusion && !this->DepthLevels.empty();
+  if (useOcclusion)
+  {
+    vtkMatrix4x4::DeepCopy(
+      this->CullingProjection, camera->GetCompositeProjectionTransformMatrix(aspect, -1, 1));
+    vtkMatrix4x4::DeepCopy(this->CullingView, camera->GetModelViewTransformMatrix());
+  }
+
+  // traverse the hierarchy, the frustum test is skipped for nodes known to be fully inside
+  std::vector<bool> visible(this->CullableProps.size(), false);
+  this->CullingHierarchy.Traverse(
+    planes, [&](const double* bounds) { return !useOcclusion || !this->IsOccluded(bounds); },
+    [&](int item) { visible[item] = true; });
+
+  // keep the props order, it matters for translucent props without depth peeling
+  this->VisibleProps.clear();
+  for (size_t i = 0; i < this->MainProps.size(); i++)
+  {
+    if (propIndices[i] < 0 || visible[propIndices[i]])
+    {
+      this->VisibleProps.emplace_back(this->MainProps[i]);
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+void vtkF3DRenderPass::UpdateDepthPyramid(
+  const vtkRenderState* s, vtkTextureObject* depthTexture)
+{
+  this->DepthLevels.clear();
+
+  if (!depthTexture)
+  {
+    return;
+  }
+
+  vtkRenderer* r = s->GetRenderer();
+  vtkOpenGLRenderWindow* renWin = static_cast<vtkOpenGLRenderWindow*>(r->GetRenderWindow());
+
+  int depthSize[2] = { static_cast<int>(depthTexture->GetWidth()),
+    static_cast<int>(depthTexture->GetHeight()) };
+  int width = (depthSize[0] + DEPTH_REDUCTION - 1) / DEPTH_REDUCTION;
+  int height = (depthSize[1] + DEPTH_REDUCTION - 1) / DEPTH_REDUCTION;
+
+  if (!this->DepthReduceTexture ||
+    static_cast<int>(this->DepthReduceTexture->GetWidth()) != width ||
+    static_cast<int>(this->DepthReduceTexture->GetHeight()) != height)
+  {
+    this->DepthReduceTexture = vtkSmartPointer<vtkTextureObject>::New();
+    this->DepthReduceTexture->SetContext(renWin);
+    this->DepthReduceTexture->SetFormat(GL_RED);
+    this->DepthReduceTexture->SetInternalFormat(GL_R32F);
+    this->DepthReduceTexture->SetDataType(GL_FLOAT);
+    this->DepthReduceTexture->SetMinificationFilter(vtkTextureObject::Nearest);
+    this->DepthReduceTexture->SetMagnificationFilter(vtkTextureObject::Nearest);
+    this->DepthReduceTexture->Allocate2D(width, height, 1, VTK_FLOAT);
+  }
+
+  if (!this->DepthFramebuffer)
+  {
+    this->DepthFramebuffer = vtkSmartPointer<vtkOpenGLFramebufferObject>::New();
+    this->DepthFramebuffer->SetContext(renWin);
+  }
+
+  if (!this->DepthReduceQuadHelper)
+  {
+    std::string FSSource = vtkOpenGLRenderUtilities::GetFullScreenQuadFragmentShaderTemplate();
+
+    std::stringstream ssDecl;
+    ssDecl << "uniform sampler2D texDepth;\n"
+              "uniform ivec2 depthSize;\n"
+              "//VTK::FSQ::Decl";
+
+    vtkShaderProgram::Substitute(FSSource, "//VTK::FSQ::Decl", ssDecl.str());
+
+    // keep the farthest depth of each block, so the test against it is conservative
+    std::stringstream ssImpl;
+    ssImpl << "  ivec2 base = ivec2(gl_FragCoord.xy) * " << DEPTH_REDUCTION << ";\n";
+    ssImpl << "  float depth = 0.0;\n";
+    ssImpl << "  for (int j = 0; j < " << DEPTH_REDUCTION << "; j++)\n";
+    ssImpl << "    for (int i = 0; i < " << DEPTH_REDUCTION << "; i++)\n";
+    ssImpl << "      depth = max(depth, texelFetch(texDepth, min(base + ivec2(i, j), depthSize - "
+              "1), 0).r);\n";
+    ssImpl << "  gl_FragData[0] = vec4(depth);\n";
+
+    vtkShaderProgram::Substitute(FSSource, "//VTK::FSQ::Impl", ssImpl.str());
+
+    this->DepthReduceQuadHelper = std::make_shared<vtkOpenGLQuadHelper>(renWin,
+      vtkOpenGLRenderUtilities::GetFullScreenQuadVertexShader().c_str(), FSSource.c_str(), "");
+  }
+  else
+  {
+    renWin->GetShaderCache()->ReadyShaderProgram(this->DepthReduceQuadHelper->Program);
+  }
+
+  if (!this->DepthReduceQuadHelper->Program ||
+    !this->DepthReduceQuadHelper->Program->GetCompiled())
+  {
+    vtkErrorMacro("Couldn't build the depth reduction shader program.");
+    return;
+  }
+
+  depthTexture->Activate();
+  this->DepthReduceQuadHelper->Program->SetUniformi("texDepth", depthTexture->GetTextureUnit());
+  this->DepthReduceQuadHelper->Program->SetUniform2i("depthSize", depthSize);
+
+  std::vector<float> depth(static_cast<size_t>(width) * height);
+
+  {
+    vtkOpenGLState* ostate = renWin->GetState();
+    vtkOpenGLState::ScopedglViewport viewportSaver(ostate);
+    vtkOpenGLState::ScopedglScissor scissorSaver(ostate);
+    vtkOpenGLState::ScopedglEnableDisable blendSaver(ostate, GL_BLEND);
+    ostate->vtkglDisable(GL_BLEND);
+
+    ostate->PushFramebufferBindings();
+    this->DepthFramebuffer->Bind();
+    this->DepthFramebuffer->AddColorAttachment(0, this->DepthReduceTexture);
+    this->DepthFramebuffer->ActivateDrawBuffers(1);
+    this->DepthFramebuffer->StartNonOrtho(width, height);
+
+    this->DepthReduceQuadHelper->Render();
+
+    // the reduced buffer is small, the read back cost is mostly the synchronization
+    this->DepthFramebuffer->ActivateReadBuffer(0);
+    glReadPixels(0, 0, width, height, GL_RED, GL_FLOAT, depth.data());
+
+    this->DepthFramebuffer->RemoveColorAttachments(1);
+    ostate->PopFramebufferBindings();
+  }
+
+  depthTexture->Deactivate();
+
+  // convert to view space distance, so the test does not depend on the clipping range
+  // that can change between frames, the background is infinitely far
+  vtkCamera* camera = r->GetActiveCamera();
+  double range[2];
+  camera->GetClippingRange(range);
+  bool parallel = camera->GetParallelProjection();
+  for (float& value : depth)
+  {
+    if (value >= 1.f)
+    {
+      value = std::numeric_limits<float>::infinity();
+    }
+    else if (parallel)
+    {
+      value = static_cast<float>(range[0] + value * (range[1] - range[0]));
+    }
+    else
+    {
+      double ndc = 2.0 * value - 1.0;
+      value = static_cast<float>(
+        2.0 * range[0] * range[1] / (range[1] + range[0] - ndc * (range[1] - range[0])));
+    }
+  }
+
+  this->DepthLevels.emplace_back(std::move(depth));
+  this->DepthLevelsWidth.assign(1, width);
+  this->DepthLevelsHeight.assign(1, height);
+
+  // each level keeps the farthest distance of 2x2 texels of the previous one
+  while (width > 1 || height > 1)
+  {
+    int nextWidth = (width + 1) / 2;
+    int nextHeight = (height + 1) / 2;
+    const std::vector<float>& previous = this->DepthLevels.back();
+    std::vector<float> next(static_cast<size_t>(nextWidth) * nextHeight);
+    for (int j = 0; j < nextHeight; j++)
+    {
+      for (int i = 0; i < nextWidth; i++)
+      {
+        int i0 = 2 * i;
+        int i1 = std::min(2 * i + 1, width - 1);
+        int j0 = 2 * j;
+        int j1 = std::min(2 * j + 1, height - 1);
+        next[j * nextWidth + i] = std::max(
+          std::max(previous[j0 * width + i0], previous[j0 * width + i1]),
+          std::max(previous[j1 * width + i0], previous[j1 * width + i1]));
+      }
+    }
+
+    width = nextWidth;
+    height = nextHeight;
+    this->DepthLevels.emplace_back(std::move(next));
+    this->DepthLevelsWidth.emplace_back(width);
+    this->DepthLevelsHeight.emplace_back(height);
+  }
+}
+
+// ----------------------------------------------------------------------------
+bool vtkF3DRenderPass::IsOccluded(const double bounds[6]) const
+{
+  double ndcMin[2] = { VTK_DOUBLE_MAX, VTK_DOUBLE_MAX };
+  double ndcMax[2] = { VTK_DOUBLE_MIN, VTK_DOUBLE_MIN };
+  double nearest = VTK_DOUBLE_MAX;
+  for (int c = 0; c < 8; c++)
+  {
+    double corner[4] = { bounds[c & 1], bounds[2 + ((c >> 1) & 1)], bounds[4 + ((c >> 2) & 1)],
+      1.0 };
+
+    double clip[4];
+    vtkMatrix4x4::MultiplyPoint(this->CullingProjection, corner, clip);
+    if (clip[3] <= 0.0)
+    {
+      // the bounds cross the camera plane
+      return false;
+    }
+
+    for (int i = 0; i < 2; i++)
+    {
+      ndcMin[i] = std::min(ndcMin[i], clip[i] / clip[3]);
+      ndcMax[i] = std::max(ndcMax[i], clip[i] / clip[3]);
+    }
+
+    double view[4];
+    vtkMatrix4x4::MultiplyPoint(this->CullingView, corner, view);
+    nearest = std::min(nearest, -view[2]);
+  }
+
+  // screen rectangle of the bounds in the first level
+  int width = this->DepthLevelsWidth[0];
+  int height = this->DepthLevelsHeight[0];
+  auto toTexel = [](double ndc, int size)
+  {
+    double texel = std::floor((0.5 * ndc + 0.5) * size);
+    return static_cast<int>(std::clamp(texel, 0.0, static_cast<double>(size - 1)));
+  };
+  int x0 = toTexel(ndcMin[0], width);
+  int x1 = toTexel(ndcMax[0], width);
+  int y0 = toTexel(ndcMin[1], height);
+  int y1 = toTexel(ndcMax[1], height);
+
+  // pick the level where the rectangle covers a few texels
+  size_t level = 0;
+  while (level + 1 < this->DepthLevels.size() && (x1 - x0 > 2 || y1 - y0 > 2))
+  {
+    level++;
+    x0 /= 2;
+    x1 /= 2;
+    y0 /= 2;
+    y1 /= 2;
+  }
+
+  const std::vector<float>& depth = this->DepthLevels[level];
+  width = this->DepthLevelsWidth[level];
+  for (int j = y0; j <= y1; j++)
+  {
+    for (int i = x0; i <= x1; i++)
+    {
+      if (depth[j * width + i] >= nearest)
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+bool vtkF3DRenderPass::ReadDepthAndNormals(vtkRenderer* r, std::vector<float>& values)
+{
+  vtkTextureObject* depthTexture = this->FrameDepthTexture;
+  if (!depthTexture || this->UseRaytracing)
+  {
+    return false;
+  }
+
+  vtkOpenGLRenderWindow* renWin = static_cast<vtkOpenGLRenderWindow*>(r->GetRenderWindow());
+
+  int size[2] = { static_cast<int>(depthTexture->GetWidth()),
+    static_cast<int>(depthTexture->GetHeight()) };
+
+  if (!this->DepthNormalsTexture ||
+    static_cast<int>(this->DepthNormalsTexture->GetWidth()) != size[0] ||
+    static_cast<int>(this->DepthNormalsTexture->GetHeight()) != size[1])
+  {
+    this->DepthNormalsTexture = vtkSmartPointer<vtkTextureObject>::New();
+    this->DepthNormalsTexture->SetContext(renWin);
+    this->DepthNormalsTexture->SetFormat(GL_RGBA);
+    this->DepthNormalsTexture->SetInternalFormat(GL_RGBA32F);
+    this->DepthNormalsTexture->SetDataType(GL_FLOAT);
+    this->DepthNormalsTexture->SetMinificationFilter(vtkTextureObject::Nearest);
+    this->DepthNormalsTexture->SetMagnificationFilter(vtkTextureObject::Nearest);
+    this->DepthNormalsTexture->Allocate2D(size[0], size[1], 4, VTK_FLOAT);
+  }
+
+  if (!this->DepthFramebuffer)
+  {
+    this->DepthFramebuffer = vtkSmartPointer<vtkOpenGLFramebufferObject>::New();
+    this->DepthFramebuffer->SetContext(renWin);
+  }
+
+  if (!this->DepthNormalsQuadHelper)
+  {
+    std::string FSSource = vtkOpenGLRenderUtilities::GetFullScreenQuadFragmentShaderTemplate();
+
+    std::stringstream ssDecl;
+    ssDecl << "uniform sampler2D texDepth;\n"
+              "uniform ivec2 depthSize;\n"
+              "uniform vec2 clippingRange;\n"
+              "uniform vec2 viewScale;\n"
+              "uniform vec2 windowCenter;\n"
+              "uniform int parallelProjection;\n"
+              "vec3 viewPosition(ivec2 texel)\n"
+              "{\n"
+              "  texel = clamp(texel, ivec2(0), depthSize - 1);\n"
+              "  float depth = texelFetch(texDepth, texel, 0).r;\n"
+              "  float near = clippingRange.x;\n"
+              "  float far = clippingRange.y;\n"
+              "  float dist = parallelProjection == 1 ? near + depth * (far - near) :\n"
+              "    2.0 * near * far / (far + near - (2.0 * depth - 1.0) * (far - near));\n"
+              "  vec2 ndc = (vec2(texel) + 0.5) / vec2(depthSize) * 2.0 - 1.0 - windowCenter;\n"
+              "  vec2 xy = ndc * viewScale * (parallelProjection == 1 ? 1.0 : dist);\n"
+              "  return vec3(xy, -dist);\n"
+              "}\n"
+              "//VTK::FSQ::Decl";
+
+    vtkShaderProgram::Substitute(FSSource, "//VTK::FSQ::Decl", ssDecl.str());
+
+    // the differences with the closest neighbours are used, so the normals are not smoothed
+    // across the silhouettes of the props
+    std::stringstream ssImpl;
+    ssImpl << "  ivec2 texel = ivec2(gl_FragCoord.xy);\n";
+    ssImpl << "  if (texelFetch(texDepth, texel, 0).r >= 1.0)\n";
+    ssImpl << "  {\n";
+    ssImpl << "    gl_FragData[0] = vec4(0.0);\n";
+    ssImpl << "    return;\n";
+    ssImpl << "  }\n";
+    ssImpl << "  vec3 center = viewPosition(texel);\n";
+    ssImpl << "  vec3 left = center - viewPosition(texel - ivec2(1, 0));\n";
+    ssImpl << "  vec3 right = viewPosition(texel + ivec2(1, 0)) - center;\n";
+    ssImpl << "  vec3 down = center - viewPosition(texel - ivec2(0, 1));\n";
+    ssImpl << "  vec3 up = viewPosition(texel + ivec2(0, 1)) - center;\n";
+    ssImpl << "  vec3 dx = abs(left.z) < abs(right.z) ? left : right;\n";
+    ssImpl << "  vec3 dy = abs(down.z) < abs(up.z) ? down : up;\n";
+    ssImpl << "  gl_FragData[0] = vec4(normalize(cross(dx, dy)), -center.z);\n";
+
+    vtkShaderProgram::Substitute(FSSource, "//VTK::FSQ::Impl", ssImpl.str());
+
+    this->DepthNormalsQuadHelper = std::make_shared<vtkOpenGLQuadHelper>(renWin,
+      vtkOpenGLRenderUtilities::GetFullScreenQuadVertexShader().c_str(), FSSource.c_str(), "");
+  }
+  else
+  {
+    renWin->GetShaderCache()->ReadyShaderProgram(this->DepthNormalsQuadHelper->Program);
+  }
+
+  if (!this->DepthNormalsQuadHelper->Program ||
+    !this->DepthNormalsQuadHelper->Program->GetCompiled())
+  {
+    vtkErrorMacro("Couldn't build the depth and normals shader program.");
+    return false;
+  }
+
+  // the size of the view at a distance of 1, or the size of the view for a parallel projection
+  vtkCamera* camera = r->GetActiveCamera();
+  double range[2];
+  camera->GetClippingRange(range);
+  double aspect = static_cast<double>(size[0]) / size[1];
+  bool parallel = camera->GetParallelProjection();
+  double halfHeight = parallel
+    ? camera->GetParallelScale()
+    : std::tan(vtkMath::RadiansFromDegrees(camera->GetViewAngle()) / 2.0);
+  double windowCenter[2];
+  camera->GetWindowCenter(windowCenter);
+
+  float clippingRange[2] = { static_cast<float>(range[0]), static_cast<float>(range[1]) };
+  float viewScale[2] = { static_cast<float>(halfHeight * aspect), static_cast<float>(halfHeight) };
+  float center[2] = { static_cast<float>(windowCenter[0]), static_cast<float>(windowCenter[1]) };
+
+  vtkShaderProgram* program = this->DepthNormalsQuadHelper->Program;
+  depthTexture->Activate();
+  program->SetUniformi("texDepth", depthTexture->GetTextureUnit());
+  program->SetUniform2i("depthSize", size);
+  program->SetUniform2f("clippingRange", clippingRange);
+  program->SetUniform2f("viewScale", viewScale);
+  program->SetUniform2f("windowCenter", center);
+  program->SetUniformi("parallelProjection", parallel ? 1 : 0);
+
+  values.resize(4 * static_cast<size_t>(size[0]) * size[1]);
+
+  {
+    vtkOpenGLState* ostate = renWin->GetState();
+    vtkOpenGLState::ScopedglViewport viewportSaver(ostate);
+    vtkOpenGLState::ScopedglScissor scissorSaver(ostate);
+    vtkOpenGLState::ScopedglEnableDisable blendSaver(ostate, GL_BLEND);
+    ostate->vtkglDisable(GL_BLEND);
+
+    ostate->PushFramebufferBindings();
+    this->DepthFramebuffer->Bind();
+    this->DepthFramebuffer->AddColorAttachment(0, this->DepthNormalsTexture);
+    this->DepthFramebuffer->ActivateDrawBuffers(1);
+    this->DepthFramebuffer->StartNonOrtho(size[0], size[1]);
+
+    this->DepthNormalsQuadHelper->Render();
+
+    this->DepthFramebuffer->ActivateReadBuffer(0);
+    glReadPixels(0, 0, size[0], size[1], GL_RGBA, GL_FLOAT, values.data());
+
+    this->DepthFramebuffer->RemoveColorAttachments(1);
+    ostate->PopFramebufferBindings();
+  }
+
+  depthTexture->Deactivate();
+
+  return true;
 }
@@ -7,6 +7,18 @@
  * The second pass renders the dataset with different options (raytracing, SSAO, depth peeling, ...)
  * Once the two passes are rendered into textures, a final shader is applied to combine the
  * background (and optionally blur it using Bokeh depth of field) and the dataset image.
+ * Before rendering the dataset, the props outside of the camera frustum are culled using a bounding
+ * volume hierarchy of their bounds. While interacting, the props hidden behind the depth of the
+ * previous frame can also be culled, using a hierarchical depth buffer read back from the GPU.
+ * When only the overlay props changed since the previous frame, the background and the dataset
+ * textures are reused as is and only the overlay is rendered again before the final shader,
+ * unless the previous frame used the shortcuts of the interaction and the view is now still.
+ * In progressive mode, the dataset is rendered without the expensive effects while interacting,
+ * and jittered frames are accumulated while the view is still.
+ * With the temporal anti-aliasing, each frame of the dataset is jittered and blended with the
+ * previous ones, reprojected using the depth and the camera motion.
+ * With a dynamic resolution, the dataset is rendered at a lower resolution while interacting,
+ * and upsampled when blended with the full resolution background and overlay.
  *
  * @sa
  * vtkRenderPass
@@ -15,15 +27,22 @@
 #ifndef vtkF3DRenderPass_h
 #define vtkF3DRenderPass_h
 
+#include "F3DBoundsHierarchy.h"
+
 #include <vtkFramebufferPass.h>
 #include <vtkOpenGLQuadHelper.h>
 #include <vtkSmartPointer.h>
 #include <vtkTimeStamp.h>
+#include <vtkWeakPointer.h>
 
 #include <memory>
 #include <vector>
 
+class vtkF3DFrameStatistics;
+class vtkF3DSSAOPass;
+class vtkOpenGLFramebufferObject;
 class vtkProp;
+class vtkTextureObject;
 
 class vtkF3DRenderPass : public vtkRenderPass
 {
@@ -36,36 +55,191 @@ public:
 
   vtkSetMacro(UseRaytracing, bool);
   vtkSetMacro(UseSSAOPass, bool);
+
+  /**
+   * Set the factor the resolution of the ambient occlusion is divided by.
+   * When greater than 1, vtkF3DSSAOPass is used instead of vtkSSAOPass and the
+   * ambient occlusion is accumulated over the frames while the view is unchanged.
+   */
+  vtkSetMacro(AmbientOcclusionDownsampling, int);
+
+  /**
+   * Set the use of the eye-dome lighting.
+   * The dataset is darkened where its log depth is larger than the one of its neighbors, sampled
+   * at 1, 2 and 4 pixels, when blending the layers. It only reads the depth of the main pass,
+   * so it costs a fraction of the ambient occlusion and shades the points without normals.
+   * It is not used when raytracing.
+   */
+  vtkSetMacro(UseEDLPass, bool);
   vtkSetMacro(UseDepthPeelingPass, bool);
+
+  /**
+   * Use weighted blended order independent transparency instead of depth peeling
+   * when UseDepthPeelingPass is true. Translucent props are rendered once, volumes are
+   * rendered after them.
+   */
+  vtkSetMacro(UseOITPass, bool);
+
+  /**
+   * Set the maximum number of peels of the depth peeling and the ratio of the viewport pixels
+   * under which a peel stops the peeling, see vtkF3DDualDepthPeelingPass.
+   */
+  vtkSetMacro(TranslucencyPeels, int);
+  vtkSetMacro(TranslucencyThreshold, double);
   vtkSetMacro(UseBlurBackground, bool);
   vtkSetMacro(ForceOpaqueBackground, bool);
   vtkSetVector6Macro(Bounds, double);
   vtkSetMacro(CircleOfConfusionRadius, double);
+  vtkSetMacro(UseOcclusionCulling, bool);
+
+  /**
+   * Set the use of the temporal anti-aliasing.
+   * Each frame of the dataset is rendered with the sub-pixel jitter of the progressive mode and
+   * blended with the history of the previous frames. The history is reprojected using the depth
+   * of the frame and the camera motion, and clamped to the colors around each pixel to reject
+   * the history that is not visible anymore. Once the view is still, frames are rendered until
+   * the jitter covered the pixels, the history is then not clamped since it is exact.
+   * It is not used when raytracing, nor while the progressive mode accumulates still frames.
+   */
+  vtkSetMacro(UseTAAPass, bool);
+
+  /**
+   * Set the number of frames of the progressive mode, 0 to disable it.
+   * In this mode, the props are rendered without ambient occlusion and depth peeling while
+   * interacting. While the view is still, up to this number of frames, jittered by a sub-pixel
+   * offset, are accumulated to anti-alias and converge the ambient occlusion, one per render.
+   * When raytracing, the frames accumulate the raytracing samples instead.
+   */
+  vtkSetMacro(ProgressiveFrames, int);
+
+  /**
+   * Set the frame rate the resolution of the dataset is adapted to while interacting,
+   * 0 to disable it. After each interactive frame, the resolution scale is raised or lowered,
+   * by steps of an eighth and down to a quarter, assuming the render time is proportional to the
+   * number of pixels. The full resolution is rendered again once the view is still.
+   * The resolution is not lowered when raytracing.
+   */
+  vtkSetMacro(DynamicResolutionFrameRate, double);
+
+  /**
+   * Get the resolution scale the dataset of the last frame was rendered with.
+   */
+  vtkGetMacro(ResolutionScale, double);
+
+  /**
+   * Set the use of the raytracing denoiser.
+   * In progressive mode, only the last accumulated frame is denoised.
+   */
+  vtkSetMacro(UseRaytracingDenoiser, bool);
+
+  /**
+   * Set the statistics the GPU time of the passes is recorded into.
+   * If not set, the passes are not measured.
+   */
+  void SetStatistics(vtkF3DFrameStatistics* statistics);
+
+  /**
+   * Return true if the last frame is not converged yet and rendering again would improve it.
+   */
+  bool IsAccumulating() const;
+
+  /**
+   * Read back the view space normal and the linear depth of each pixel of the last frame,
+   * reconstructed from the depth buffer of the main pass, so no additional geometry pass is needed.
+   * values receives 4 floats per pixel starting from the bottom left corner, the normal facing the
+   * camera and the distance to the camera plane, all null for the background.
+   * Return false if the depth of the last frame is not available, eg. when raytracing.
+   */
+  bool ReadDepthAndNormals(vtkRenderer* r, std::vector<float>& values);
 
   vtkF3DRenderPass(const vtkF3DRenderPass&) = delete;
   void operator=(const vtkF3DRenderPass&) = delete;
 
 protected:
-  vtkF3DRenderPass() = default;
-  ~vtkF3DRenderPass() override = default;
+  vtkF3DRenderPass();
+  ~vtkF3DRenderPass() override;
 
   void ReleaseGraphicsResources(vtkWindow* w) override;
 
   void Initialize(const vtkRenderState* s);
 
-  void Blend(const vtkRenderState* s);
+  void Blend(const vtkRenderState* s, vtkTextureObject* mainTexture);
+
+  /**
+   * Fill VisibleProps with the main props that are not culled.
+   * The bounding volume hierarchy is rebuilt only if the props or their bounds changed.
+   */
+  void CullMainProps(const vtkRenderState* s, bool useOcclusion);
+
+  /**
+   * Reduce the depth of the main pass and read it back to build the hierarchical depth buffer
+   * used for occlusion culling during the next frame
+   */
+  void UpdateDepthPyramid(const vtkRenderState* s, vtkTextureObject* depthTexture);
+
+  /**
+   * State the textures of a pass were rendered with, to know if they can be reused
+   */
+  struct PassState
+  {
+    bool Valid = false;
+    std::vector<vtkProp*> Props;
+    vtkMTimeType PropsTime = 0;
+    vtkMTimeType RendererTime = 0;
+    vtkMTimeType InitializeTime = 0;
+    double Camera[16] = {};
+    int Size[2] = {};
+  };
+
+  /**
+   * Return true if the props, the lights, the camera or the size changed since the state
+   * was recorded, and record the new state
+   */
+  bool HasStateChanged(PassState& state, const vtkRenderState* s, std::vector<vtkProp*> props);
+
+  /**
+   * Average the color texture with the previously accumulated frames
+   * and return the accumulation texture
+   */
+  vtkTextureObject* Accumulate(const vtkRenderState* s, vtkTextureObject* color);
+
+  /**
+   * Blend the jittered color texture with the reprojected history, see SetUseTAAPass,
+   * and return the texture of the new history
+   */
+  vtkTextureObject* ResolveTemporal(const vtkRenderState* s, vtkTextureObject* color,
+    vtkTextureObject* depth, const double jitter[2], bool still);
+
+  /**
+   * Return true if the bounds are hidden behind the hierarchical depth buffer
+   */
+  bool IsOccluded(const double bounds[6]) const;
 
   bool UseRaytracing = false;
   bool UseSSAOPass = false;
+  int AmbientOcclusionDownsampling = 1;
+  bool UseEDLPass = false;
   bool UseDepthPeelingPass = false;
+  bool UseOITPass = false;
+  int TranslucencyPeels = 4;
+  double TranslucencyThreshold = 0.0;
   bool UseBlurBackground = false;
   bool ForceOpaqueBackground = false;
+  bool UseOcclusionCulling = false;
+  bool UseTAAPass = false;
+  int ProgressiveFrames = 0;
+  double DynamicResolutionFrameRate = 0.0;
+  bool UseRaytracingDenoiser = false;
 
   double CircleOfConfusionRadius = 20.0;
 
+  vtkWeakPointer<vtkF3DFrameStatistics> Statistics;
+  vtkWeakPointer<vtkF3DSSAOPass> AccumulatedSSAOPass;
+
   vtkSmartPointer<vtkFramebufferPass> BackgroundPass;
   vtkSmartPointer<vtkFramebufferPass> OverlayPass;
   vtkSmartPointer<vtkFramebufferPass> MainPass;
+  vtkSmartPointer<vtkFramebufferPass> InteractivePass;
 
   double Bounds[6] = {};
 
@@ -74,8 +248,60 @@ protected:
   std::vector<vtkProp*> BackgroundProps;
   std::vector<vtkProp*> OverlayProps;
   std::vector<vtkProp*> MainProps;
+  std::vector<vtkProp*> VisibleProps;
+
+  // the hierarchy of the cullable props bounds, rebuilt only when they change
+  F3DBoundsHierarchy CullingHierarchy;
+  std::vector<vtkProp*> CullableProps;
+
+  // hierarchical depth buffer of the previous frame, in view space distance
+  std::vector<std::vector<float>> DepthLevels;
+  std::vector<int> DepthLevelsWidth;
+  std::vector<int> DepthLevelsHeight;
+  double CullingProjection[16] = {};
+  double CullingView[16] = {};
+
+  // state of the last frame rendered in the background and main textures,
+  // and of the background alone, that does not change when only the main props move
+  PassState FrameState;
+  PassState BackgroundState;
+  vtkWeakPointer<vtkTextureObject> FrameTexture;
+
+  // scale of the viewport the main props were last rendered in, and if the last frame was only
+  // blended again, so that its render time does not tell the render time of the main props
+  double ResolutionScale = 1.0;
+  bool FrameReused = false;
+
+  // if the last frame would be more exact if rendered again, and if it was rendered with the
+  // shortcuts of the interaction, so that it is not reused as a still frame
+  bool FrameIncomplete = false;
+  bool FrameInteractive = false;
+
+  // frames averaged by the progressive mode since the view changed
+  int AccumulatedFrames = 0;
+  vtkSmartPointer<vtkTextureObject> AccumulationTexture;
+  vtkSmartPointer<vtkOpenGLFramebufferObject> AccumulationFramebuffer;
+  std::shared_ptr<vtkOpenGLQuadHelper> AccumulationQuadHelper;
+
+  // history of the temporal anti-aliasing, the two textures are swapped after each frame,
+  // and the unjittered projection of the camera it was rendered with
+  int TemporalFrames = 0;
+  bool TemporalHistoryValid = false;
+  int TemporalHistoryIndex = 0;
+  vtkSmartPointer<vtkTextureObject> TemporalTextures[2];
+  double TemporalProjection[16] = {};
+  std::shared_ptr<vtkOpenGLQuadHelper> TemporalQuadHelper;
 
   std::shared_ptr<vtkOpenGLQuadHelper> BlendQuadHelper;
+  bool BlendUseEDL = false;
+  std::shared_ptr<vtkOpenGLQuadHelper> DepthReduceQuadHelper;
+  vtkSmartPointer<vtkOpenGLFramebufferObject> DepthFramebuffer;
+  vtkSmartPointer<vtkTextureObject> DepthReduceTexture;
+
+  // depth of the last frame, and the textures the normals and the linear depth are computed in
+  vtkWeakPointer<vtkTextureObject> FrameDepthTexture;
+  std::shared_ptr<vtkOpenGLQuadHelper> DepthNormalsQuadHelper;
+  vtkSmartPointer<vtkTextureObject> DepthNormalsTexture;
 };
 
 #endif
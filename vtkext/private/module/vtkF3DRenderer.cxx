@@ -7,10 +7,26 @@
 #include "vtkF3DCachedSpecularTexture.h"
 #include "vtkF3DConfigure.h"
 #include "vtkF3DDropZoneActor.h"
+#include "vtkF3DFrameStatistics.h"
+#include "vtkF3DGlyphTextActor.h"
+#include "vtkF3DMetrics.h"
 #include "vtkF3DOpenGLGridMapper.h"
+#include "vtkF3DPolyDataMapper.h"
+#include "vtkF3DPostProcessPass.h"
+#include "vtkF3DPreIntegrationTable.h"
+#include "vtkF3DQuantizeImageFilter.h"
+#include "vtkF3DReadAhead.h"
 #include "vtkF3DRenderPass.h"
+#include "vtkF3DTimerPass.h"
+#include "vtkF3DTrace.h"
 #include "vtkF3DUserRenderPass.h"
 
+#if !defined(__ANDROID__) && !defined(__EMSCRIPTEN__) &&                                           \
+  VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240203)
+#include "vtkF3DEnvironmentCompute.h"
+#include "vtkF3DPointSplatMapper.h"
+#endif
+
 #include <vtkAxesActor.h>
 #include <vtkBoundingBox.h>
 #include <vtkCamera.h>
@@ -19,13 +35,18 @@
 #include <vtkCornerAnnotation.h>
 #include <vtkCullerCollection.h>
 #include <vtkFloatArray.h>
+#include <vtkHardwareSelector.h>
 #include <vtkImageData.h>
 #include <vtkImageReader2.h>
 #include <vtkImageReader2Factory.h>
+#include <vtkImageResize.h>
+#include <vtkImageSincInterpolator.h>
+#include <vtkImageShrink3D.h>
 #include <vtkLight.h>
 #include <vtkLightCollection.h>
 #include <vtkLightKit.h>
 #include <vtkMath.h>
+#include <vtkMatrix4x4.h>
 #include <vtkMultiBlockDataSet.h>
 #include <vtkObjectFactory.h>
 #include <vtkOpenGLFXAAPass.h>
@@ -37,24 +58,26 @@
 #include <vtkPixelBufferObject.h>
 #include <vtkPointData.h>
 #include <vtkPolyData.h>
+#include <vtkPropCollection.h>
 #include <vtkProperty.h>
+#include <vtkQuadricClustering.h>
 #include <vtkRenderWindow.h>
+#include <vtkRenderWindowInteractor.h>
+#include <vtkSMPTools.h>
 #include <vtkScalarBarActor.h>
 #include <vtkSkybox.h>
 #include <vtkTable.h>
-#include <vtkTextActor.h>
 #include <vtkTextProperty.h>
 #include <vtkTextureObject.h>
 #include <vtkToneMappingPass.h>
 #include <vtkVersion.h>
 #include <vtkVolumeProperty.h>
+#include <vtkWeakPointer.h>
 #include <vtkXMLImageDataReader.h>
 #include <vtkXMLImageDataWriter.h>
-#include <vtkXMLMultiBlockDataWriter.h>
 #include <vtkXMLTableReader.h>
 #include <vtkXMLTableWriter.h>
 #include <vtksys/FStream.hxx>
-#include <vtksys/MD5.h>
 #include <vtksys/SystemTools.hxx>
 
 #if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 2, 20221220)
@@ -77,38 +100,206 @@
 #include <vtk_glew.h>
 #endif
 
+#include <algorithm>
+#include <array>
 #include <cctype>
+#include <cmath>
 #include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <regex>
 #include <sstream>
 
 namespace
 {
+//----------------------------------------------------------------------------
+// Return the mapping of the scalars in the shaders of the F3D mappers, nullptr for other mappers
+F3DShaderColoring* GetShaderColoring(vtkPolyDataMapper* mapper)
+{
+  if (vtkF3DPolyDataMapper* polyDataMapper = vtkF3DPolyDataMapper::SafeDownCast(mapper))
+  {
+    return &polyDataMapper->GetShaderColoring();
+  }
+#if !defined(__ANDROID__) && !defined(__EMSCRIPTEN__) &&                                           \
+  VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240203)
+  if (vtkF3DPointSplatMapper* splatMapper = vtkF3DPointSplatMapper::SafeDownCast(mapper))
+  {
+    return &splatMapper->GetShaderColoring();
+  }
+#endif
+  return nullptr;
+}
+
+//----------------------------------------------------------------------------
+// Enable the mapping of the scalars in the shaders of the F3D mappers
+void SetShaderColoringEnabled(vtkPolyDataMapper* mapper, bool enabled)
+{
+  F3DShaderColoring* coloring = ::GetShaderColoring(mapper);
+  if (coloring && coloring->SetEnabled(enabled && F3DShaderColoring::IsSupported()))
+  {
+    mapper->Modified();
+  }
+}
+
 #if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 2, 20221220)
 //----------------------------------------------------------------------------
-// Compute the MD5 hash of an existing file on disk
+// XXH64 hash of a buffer, see https://github.com/Cyan4973/xxHash/blob/dev/doc/xxhash_spec.md
+constexpr uint64_t XXH_PRIME1 = 11400714785074694791ULL;
+constexpr uint64_t XXH_PRIME2 = 14029467366897019727ULL;
+constexpr uint64_t XXH_PRIME3 = 1609587929392839161ULL;
+constexpr uint64_t XXH_PRIME4 = 9650029242287828579ULL;
+constexpr uint64_t XXH_PRIME5 = 2870177450012600261ULL;
+
+uint64_t XXHRotate(uint64_t value, int bits)
+{
+  return (value << bits) | (value >> (64 - bits));
+}
+
+uint64_t XXHRead64(const unsigned char* data)
+{
+  uint64_t value;
+  std::memcpy(&value, data, sizeof(value));
+  return value;
+}
+
+uint64_t XXHRound(uint64_t acc, uint64_t input)
+{
+  acc += input * XXH_PRIME2;
+  return XXHRotate(acc, 31) * XXH_PRIME1;
+}
+
+uint64_t XXHMergeRound(uint64_t acc, uint64_t value)
+{
+  acc ^= XXHRound(0, value);
+  return acc * XXH_PRIME1 + XXH_PRIME4;
+}
+
+uint64_t XXH64(const unsigned char* data, size_t length, uint64_t seed)
+{
+  const unsigned char* end = data + length;
+  uint64_t hash;
+  if (length >= 32)
+  {
+    uint64_t v1 = seed + XXH_PRIME1 + XXH_PRIME2;
+    uint64_t v2 = seed + XXH_PRIME2;
+    uint64_t v3 = seed;
+    uint64_t v4 = seed - XXH_PRIME1;
+    for (; data + 32 <= end; data += 32)
+    {
+      v1 = XXHRound(v1, XXHRead64(data));
+      v2 = XXHRound(v2, XXHRead64(data + 8));
+      v3 = XXHRound(v3, XXHRead64(data + 16));
+      v4 = XXHRound(v4, XXHRead64(data + 24));
+    }
+    hash = XXHRotate(v1, 1) + XXHRotate(v2, 7) + XXHRotate(v3, 12) + XXHRotate(v4, 18);
+    hash = XXHMergeRound(hash, v1);
+    hash = XXHMergeRound(hash, v2);
+    hash = XXHMergeRound(hash, v3);
+    hash = XXHMergeRound(hash, v4);
+  }
+  else
+  {
+    hash = seed + XXH_PRIME5;
+  }
+
+  hash += length;
+  for (; data + 8 <= end; data += 8)
+  {
+    hash ^= XXHRound(0, XXHRead64(data));
+    hash = XXHRotate(hash, 27) * XXH_PRIME1 + XXH_PRIME4;
+  }
+  if (data + 4 <= end)
+  {
+    uint32_t value;
+    std::memcpy(&value, data, sizeof(value));
+    hash ^= value * XXH_PRIME1;
+    hash = XXHRotate(hash, 23) * XXH_PRIME2 + XXH_PRIME3;
+    data += 4;
+  }
+  for (; data < end; data++)
+  {
+    hash ^= *data * XXH_PRIME5;
+    hash = XXHRotate(hash, 11) * XXH_PRIME1;
+  }
+
+  hash ^= hash >> 33;
+  hash *= XXH_PRIME2;
+  hash ^= hash >> 29;
+  hash *= XXH_PRIME3;
+  hash ^= hash >> 32;
+  return hash;
+}
+
+//----------------------------------------------------------------------------
+std::string ToHex(uint64_t value)
+{
+  std::stringstream ss;
+  ss << std::hex << std::setw(16) << std::setfill('0') << value;
+  return ss.str();
+}
+
+//----------------------------------------------------------------------------
+// Compute a hash of the content of an existing file on disk.
+// The file is read with concurrent requests, which matters on network filesystems.
+// Chunks of the file are hashed in parallel, then the hashes of the chunks are hashed.
 std::string ComputeFileHash(const std::string& filepath)
 {
-  unsigned char digest[16];
-  char md5Hash[33];
-  md5Hash[32] = '\0';
+  std::vector<unsigned char> buffer;
+  vtkF3DReadAhead::ReadFile(filepath, buffer);
+  std::size_t length = buffer.size();
+
+  constexpr std::size_t chunkSize = 1 << 24;
+  std::vector<uint64_t> hashes((length + chunkSize - 1) / chunkSize);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(hashes.size()),
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType i = begin; i < end; i++)
+      {
+        std::size_t offset = i * chunkSize;
+        hashes[i] = ::XXH64(buffer.data() + offset, std::min(chunkSize, length - offset), i);
+      }
+    });
+
+  return ::ToHex(::XXH64(reinterpret_cast<const unsigned char*>(hashes.data()),
+    hashes.size() * sizeof(uint64_t), length));
+}
+
+//----------------------------------------------------------------------------
+// Compute the hash of an existing HDRI file on disk.
+// A key made of the path, the size and the modification time of the file is stored in the
+// cache with the hash, so the file is only read again when it changed.
+std::string ComputeHDRIHash(const std::string& filepath, const std::string& cachePath)
+{
+  std::stringstream keyStream;
+  keyStream << filepath << "|" << vtksys::SystemTools::FileLength(filepath) << "|"
+            << vtksys::SystemTools::ModifiedTime(filepath);
+  std::string key = keyStream.str();
+  std::string keyPath = cachePath + "/" +
+    ::ToHex(::XXH64(reinterpret_cast<const unsigned char*>(key.data()), key.size(), 0)) + ".key";
 
-  std::size_t length = vtksys::SystemTools::FileLength(filepath);
-  std::vector<char> buffer(length);
+  // The whole key is stored to reject collisions
+  vtksys::ifstream keyFile(keyPath.c_str());
+  std::string storedKey;
+  std::string hash;
+  if (keyFile && std::getline(keyFile, storedKey) && std::getline(keyFile, hash) &&
+    storedKey == key && !hash.empty())
+  {
+    return hash;
+  }
+  keyFile.close();
 
-  vtksys::ifstream file;
-  file.open(filepath.c_str(), std::ios_base::binary);
-  file.read(buffer.data(), length);
+  hash = ::ComputeFileHash(filepath);
 
-  vtksysMD5* md5 = vtksysMD5_New();
-  vtksysMD5_Initialize(md5);
-  vtksysMD5_Append(
-    md5, reinterpret_cast<const unsigned char*>(buffer.data()), static_cast<int>(length));
-  vtksysMD5_Finalize(md5, digest);
-  vtksysMD5_DigestToHex(digest, md5Hash);
-  vtksysMD5_Delete(md5);
+#ifndef __EMSCRIPTEN__
+  vtksys::SystemTools::MakeDirectory(cachePath);
+  vtksys::ofstream newKeyFile(keyPath.c_str());
+  newKeyFile << key << "\n" << hash << "\n";
+#endif
 
-  return md5Hash;
+  return hash;
 }
 
 #ifndef __EMSCRIPTEN__
@@ -140,10 +331,11 @@ vtkSmartPointer<vtkImageData> SaveTextureToImage(
 #endif
 
 //----------------------------------------------------------------------------
-// TODO : add this function in a utils file for rendering in VTK directly
-vtkSmartPointer<vtkTexture> GetTexture(const std::string& filePath, bool isSRGB = false)
+// TODO : add these functions in a utils file for rendering in VTK directly
+// Create a reader for a texture file, without reading it
+vtkSmartPointer<vtkImageReader2> CreateTextureReader(const std::string& filePath)
 {
-  vtkSmartPointer<vtkTexture> texture;
+  vtkSmartPointer<vtkImageReader2> reader;
   if (!filePath.empty())
   {
     std::string fullPath = vtksys::SystemTools::CollapseFullPath(filePath);
@@ -153,21 +345,11 @@ vtkSmartPointer<vtkTexture> GetTexture(const std::string& filePath, bool isSRGB
     }
     else
     {
-      auto reader = vtkSmartPointer<vtkImageReader2>::Take(
+      reader = vtkSmartPointer<vtkImageReader2>::Take(
         vtkImageReader2Factory::CreateImageReader2(fullPath.c_str()));
       if (reader)
       {
         reader->SetFileName(fullPath.c_str());
-        reader->Update();
-        texture = vtkSmartPointer<vtkTexture>::New();
-        texture->SetInputConnection(reader->GetOutputPort());
-        if (isSRGB)
-        {
-          texture->UseSRGBColorSpaceOn();
-        }
-        texture->InterpolateOn();
-        texture->SetColorModeToDirectScalars();
-        return texture;
       }
       else
       {
@@ -176,7 +358,276 @@ vtkSmartPointer<vtkTexture> GetTexture(const std::string& filePath, bool isSRGB
     }
   }
 
-  return texture;
+  return reader;
+}
+
+//----------------------------------------------------------------------------
+// Read texture files, each file being decoded on its own thread.
+// The readers and the textures are created on the calling thread since the
+// reader factory and the logging are not thread safe.
+std::vector<vtkSmartPointer<vtkTexture>> GetTextures(
+  const std::vector<std::pair<std::optional<std::string>, bool>>& files)
+{
+  std::vector<vtkSmartPointer<vtkImageReader2>> readers;
+  std::vector<std::future<void>> decodings;
+  for (const auto& [file, isSRGB] : files)
+  {
+    vtkSmartPointer<vtkImageReader2> reader;
+    if (file.has_value())
+    {
+      reader = ::CreateTextureReader(file.value());
+    }
+    if (reader)
+    {
+      decodings.emplace_back(std::async(std::launch::async, [reader]() { reader->Update(); }));
+    }
+    readers.emplace_back(reader);
+  }
+
+  for (std::future<void>& decoding : decodings)
+  {
+    decoding.wait();
+  }
+
+  std::vector<vtkSmartPointer<vtkTexture>> textures(files.size());
+  for (size_t i = 0; i < files.size(); i++)
+  {
+    if (readers[i])
+    {
+      textures[i] = vtkSmartPointer<vtkTexture>::New();
+      textures[i]->SetInputConnection(readers[i]->GetOutputPort());
+      if (files[i].second)
+      {
+        textures[i]->UseSRGBColorSpaceOn();
+      }
+      textures[i]->InterpolateOn();
+      textures[i]->SetColorModeToDirectScalars();
+    }
+  }
+
+  return textures;
+}
+
+//----------------------------------------------------------------------------
+// Approximate number of pixels covered by a bounding box on screen
+double ComputeScreenFootprint(const double bounds[6], vtkCamera* camera, const int size[2])
+{
+  vtkMatrix4x4* mat =
+    camera->GetCompositeProjectionTransformMatrix(static_cast<double>(size[0]) / size[1], -1, 1);
+
+  double ndcBounds[4] = { VTK_DOUBLE_MAX, VTK_DOUBLE_MIN, VTK_DOUBLE_MAX, VTK_DOUBLE_MIN };
+  for (int i = 0; i < 8; i++)
+  {
+    double corner[4] = { bounds[i & 1], bounds[2 + ((i >> 1) & 1)], bounds[4 + ((i >> 2) & 1)],
+      1.0 };
+    mat->MultiplyPoint(corner, corner);
+    if (corner[3] <= 0.0)
+    {
+      // The camera is inside or next to the box, consider it fills the screen
+      return static_cast<double>(size[0]) * size[1];
+    }
+    ndcBounds[0] = std::min(ndcBounds[0], corner[0] / corner[3]);
+    ndcBounds[1] = std::max(ndcBounds[1], corner[0] / corner[3]);
+    ndcBounds[2] = std::min(ndcBounds[2], corner[1] / corner[3]);
+    ndcBounds[3] = std::max(ndcBounds[3], corner[1] / corner[3]);
+  }
+
+  double width = std::clamp(ndcBounds[1], -1.0, 1.0) - std::clamp(ndcBounds[0], -1.0, 1.0);
+  double height = std::clamp(ndcBounds[3], -1.0, 1.0) - std::clamp(ndcBounds[2], -1.0, 1.0);
+  return 0.25 * width * height * size[0] * size[1];
+}
+
+//----------------------------------------------------------------------------
+/**
+ * Min/max macrocell grid of a point data array of an image, in bricks of 16^3 voxels
+ */
+struct MacrocellGrid
+{
+  static constexpr int BrickSize = 16;
+
+  vtkWeakPointer<vtkDataArray> Array;
+  vtkMTimeType ArrayMTime = 0;
+  int Component = 0;
+  int Dimensions[3] = { 0, 0, 0 };
+  int NbBricks[3] = { 0, 0, 0 };
+  std::vector<std::array<double, 2>> Ranges;
+};
+
+//----------------------------------------------------------------------------
+/**
+ * Get the macrocell grid of the array component, or magnitude if component is -1.
+ * Grids are cached so that changing the colormap or the range does not scan the voxels again,
+ * they are only computed again when the array is modified.
+ */
+std::shared_ptr<const MacrocellGrid> GetMacrocellGrid(
+  vtkImageData* image, vtkDataArray* array, int component)
+{
+  static std::vector<std::shared_ptr<MacrocellGrid>> cache;
+  static std::mutex cacheMutex;
+  const std::lock_guard<std::mutex> lock(cacheMutex);
+
+  cache.erase(std::remove_if(cache.begin(), cache.end(),
+                [](const auto& grid) { return !grid->Array; }),
+    cache.end());
+
+  int dims[3];
+  image->GetDimensions(dims);
+  auto it = std::find_if(cache.begin(), cache.end(),
+    [&](const auto& grid)
+    {
+      return grid->Array == array && grid->ArrayMTime == array->GetMTime() &&
+        grid->Component == component && std::equal(dims, dims + 3, grid->Dimensions);
+    });
+  if (it != cache.end())
+  {
+    return *it;
+  }
+
+  F3D_TRACE_SCOPE("ComputeMacrocellGrid");
+  MacrocellGrid& grid = *cache.emplace_back(std::make_shared<MacrocellGrid>());
+  grid.Array = array;
+  grid.ArrayMTime = array->GetMTime();
+  grid.Component = component;
+  constexpr int brickSize = MacrocellGrid::BrickSize;
+  for (int c = 0; c < 3; c++)
+  {
+    grid.Dimensions[c] = dims[c];
+    grid.NbBricks[c] = (dims[c] + brickSize - 1) / brickSize;
+  }
+  const vtkIdType nbBricksTotal =
+    static_cast<vtkIdType>(grid.NbBricks[0]) * grid.NbBricks[1] * grid.NbBricks[2];
+  grid.Ranges.resize(nbBricksTotal);
+
+  const int nbComponents = array->GetNumberOfComponents();
+  auto getValue = [&](vtkIdType id)
+  {
+    if (component >= 0)
+    {
+      return array->GetComponent(id, component);
+    }
+    double value = 0.0;
+    for (int k = 0; k < nbComponents; k++)
+    {
+      double comp = array->GetComponent(id, k);
+      value += comp * comp;
+    }
+    return std::sqrt(value);
+  };
+
+  vtkSMPTools::For(0, nbBricksTotal,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType b = begin; b < end; b++)
+      {
+        const int brick[3] = { static_cast<int>(b % grid.NbBricks[0]),
+          static_cast<int>((b / grid.NbBricks[0]) % grid.NbBricks[1]),
+          static_cast<int>(b / (static_cast<vtkIdType>(grid.NbBricks[0]) * grid.NbBricks[1])) };
+
+        // The bricks share their boundary voxels so that the linear interpolation between two
+        // bricks is taken into account
+        std::array<double, 2> range = { VTK_DOUBLE_MAX, VTK_DOUBLE_MIN };
+        const int kEnd = std::min((brick[2] + 1) * brickSize + 1, dims[2]);
+        const int jEnd = std::min((brick[1] + 1) * brickSize + 1, dims[1]);
+        const int iEnd = std::min((brick[0] + 1) * brickSize + 1, dims[0]);
+        for (int k = brick[2] * brickSize; k < kEnd; k++)
+        {
+          for (int j = brick[1] * brickSize; j < jEnd; j++)
+          {
+            for (int i = brick[0] * brickSize; i < iEnd; i++)
+            {
+              double value = getValue(i + dims[0] * (j + static_cast<vtkIdType>(dims[1]) * k));
+              range[0] = std::min(range[0], value);
+              range[1] = std::max(range[1], value);
+            }
+          }
+        }
+        grid.Ranges[b] = range;
+      }
+    });
+  return cache.back();
+}
+
+//----------------------------------------------------------------------------
+/**
+ * Compute the bounds of the bricks of the image containing at least one voxel with a non-zero
+ * opacity, using the min/max macrocell grid of the array.
+ * A voxel is empty when its value is below range[0], or above range[1] with inverse opacity.
+ * Returns false if the whole image is occupied, or when it cannot be computed.
+ */
+bool ComputeOccupiedBounds(vtkImageData* image, vtkDataArray* array, int component,
+  const double range[2], bool inverseOpacityFlag, double bounds[6])
+{
+  if (array->GetNumberOfTuples() != image->GetNumberOfPoints() ||
+    !image->GetDirectionMatrix()->IsIdentity())
+  {
+    return false;
+  }
+
+  std::shared_ptr<const MacrocellGrid> gridPtr = ::GetMacrocellGrid(image, array, component);
+  const MacrocellGrid& grid = *gridPtr;
+  constexpr int brickSize = MacrocellGrid::BrickSize;
+  const int* dims = grid.Dimensions;
+
+  int extent[6] = { VTK_INT_MAX, VTK_INT_MIN, VTK_INT_MAX, VTK_INT_MIN, VTK_INT_MAX, VTK_INT_MIN };
+  for (size_t b = 0; b < grid.Ranges.size(); b++)
+  {
+    const std::array<double, 2>& brickRange = grid.Ranges[b];
+    if (inverseOpacityFlag ? brickRange[0] < range[1] : brickRange[1] > range[0])
+    {
+      const int brick[3] = { static_cast<int>(b % grid.NbBricks[0]),
+        static_cast<int>((b / grid.NbBricks[0]) % grid.NbBricks[1]),
+        static_cast<int>(b / (static_cast<size_t>(grid.NbBricks[0]) * grid.NbBricks[1])) };
+      for (int c = 0; c < 3; c++)
+      {
+        extent[2 * c] = std::min(extent[2 * c], brick[c] * brickSize);
+        extent[2 * c + 1] = std::max(extent[2 * c + 1], (brick[c] + 1) * brickSize);
+      }
+    }
+  }
+
+  if (extent[0] > extent[1])
+  {
+    // Fully transparent, keep a single voxel
+    std::fill(extent, extent + 6, 0);
+  }
+
+  bool cropped = false;
+  const double* origin = image->GetOrigin();
+  const double* spacing = image->GetSpacing();
+  const int* imageExtent = image->GetExtent();
+  for (int c = 0; c < 3; c++)
+  {
+    // One voxel margin so that the linear interpolation at the boundary is not modified
+    const int lower = std::max(extent[2 * c] - 1, 0);
+    const int upper = std::min(extent[2 * c + 1] + 1, dims[c] - 1);
+    cropped = cropped || lower > 0 || upper < dims[c] - 1;
+    bounds[2 * c] = origin[c] + spacing[c] * (imageExtent[2 * c] + lower);
+    bounds[2 * c + 1] = origin[c] + spacing[c] * (imageExtent[2 * c] + upper);
+  }
+  return cropped;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * Return a copy of a color transfer function with its nodes moved from one range to another,
+ * used to color the quantized volumes.
+ */
+vtkSmartPointer<vtkColorTransferFunction> RescaleColorTransferFunction(
+  vtkColorTransferFunction* ctf, const double fromRange[2], const double toRange[2])
+{
+  vtkNew<vtkColorTransferFunction> rescaled;
+  rescaled->DeepCopy(ctf);
+  rescaled->RemoveAllPoints();
+
+  const double scale = (toRange[1] - toRange[0]) / (fromRange[1] - fromRange[0]);
+  double node[6];
+  for (int i = 0; i < ctf->GetSize(); i++)
+  {
+    ctf->GetNodeValue(i, node);
+    rescaled->AddRGBPoint((node[0] - fromRange[0]) * scale + toRange[0], node[1], node[2],
+      node[3], node[4], node[5]);
+  }
+  return rescaled;
 }
 }
 
@@ -201,6 +652,15 @@ vtkF3DRenderer::vtkF3DRenderer()
 #if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 2, 20221220)
   this->EnvMapPrefiltered->HalfPrecisionOff();
 #endif
+#if !defined(__ANDROID__) && !defined(__EMSCRIPTEN__) &&                                           \
+  VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240203)
+  // the environment is preprocessed with compute shaders when they are supported
+  this->EnvironmentCompute = vtkSmartPointer<vtkF3DEnvironmentCompute>::New();
+  vtkF3DCachedSpecularTexture::SafeDownCast(this->EnvMapPrefiltered)
+    ->SetEnvironmentCompute(this->EnvironmentCompute);
+#endif
+
+  this->FrameStatistics = vtkSmartPointer<vtkF3DFrameStatistics>::New();
 
   // Init actors
   vtkNew<vtkTextProperty> textProp;
@@ -274,7 +734,6 @@ void vtkF3DRenderer::Initialize()
   this->TextActorsConfigured = false;
   this->MetaDataConfigured = false;
   this->HDRITextureConfigured = false;
-  this->HDRILUTConfigured = false;
   this->HDRISphericalHarmonicsConfigured = false;
   this->HDRISpecularConfigured = false;
   this->HDRISkyboxConfigured = false;
@@ -343,6 +802,7 @@ void vtkF3DRenderer::InitializeUpVector(const std::string& upString)
 //----------------------------------------------------------------------------
 void vtkF3DRenderer::ConfigureRenderPasses()
 {
+  F3D_TRACE_SCOPE("vtkF3DRenderer::ConfigureRenderPasses");
   // clean up previous pass
   vtkRenderPass* pass = this->GetPass();
   if (pass)
@@ -350,70 +810,152 @@ void vtkF3DRenderer::ConfigureRenderPasses()
     pass->ReleaseGraphicsResources(this->RenderWindow);
   }
 
+  // passes are only measured when the frame times are displayed
+  vtkF3DFrameStatistics* stats =
+    this->TimerVisible || this->FrameStatisticsVisible ? this->FrameStatistics.Get() : nullptr;
+  this->FrameStatistics->Reset();
+
   vtkNew<vtkF3DRenderPass> newPass;
   newPass->SetUseRaytracing(F3D_MODULE_RAYTRACING && this->UseRaytracing);
   newPass->SetUseSSAOPass(this->UseSSAOPass);
+  newPass->SetAmbientOcclusionDownsampling(std::max(this->AmbientOcclusionDownsampling, 1));
+  // when not specified, the eye-dome lighting is used by the scenes only shown with point sprites,
+  // which are hidden when raytracing, see ConfigureColoring
+  bool pointsOnly = this->Importer && this->UsePointSprites && !this->UseVolume &&
+    !this->UseRaytracing && !this->Importer->GetColoringActorsAndMappers().empty();
+  newPass->SetUseEDLPass(this->UseEDLPass.value_or(pointsOnly));
   newPass->SetUseDepthPeelingPass(this->UseDepthPeelingPass);
-  newPass->SetUseBlurBackground(this->UseBlurBackground);
+  newPass->SetTranslucencyPeels(std::max(this->TranslucencyPeels, 1));
+  newPass->SetTranslucencyThreshold(this->TranslucencyThreshold);
+  if (this->TranslucencyTechnique == "weighted_blended")
+  {
+    newPass->SetUseOITPass(true);
+  }
+  else if (this->TranslucencyTechnique != "depth_peeling")
+  {
+    F3DLog::Print(F3DLog::Severity::Warning,
+      this->TranslucencyTechnique + " is not a valid translucency technique, using depth_peeling");
+  }
+  // the temporal anti-aliasing is resolved in the main pass, before the post processing,
+  // raytracing accumulates its own samples so FXAA is used instead
+  bool useFXAA = this->UseFXAAPass;
+  if (this->AntiAliasingTechnique == "taa")
+  {
+    bool useTAA = this->UseFXAAPass && !(F3D_MODULE_RAYTRACING && this->UseRaytracing);
+    newPass->SetUseTAAPass(useTAA);
+    useFXAA = this->UseFXAAPass && !useTAA;
+  }
+  else if (this->AntiAliasingTechnique != "fxaa")
+  {
+    F3DLog::Print(F3DLog::Severity::Warning,
+      this->AntiAliasingTechnique + " is not a valid anti-aliasing technique, using fxaa");
+  }
+  // the skybox texture is blurred once when configured, the remaining background is a flat color
+  newPass->SetUseBlurBackground(this->UseBlurBackground && !this->HDRISkyboxVisible);
   newPass->SetCircleOfConfusionRadius(this->CircleOfConfusionRadius);
   newPass->SetForceOpaqueBackground(this->HDRISkyboxVisible);
+  newPass->SetUseOcclusionCulling(this->UseOcclusionCulling);
+  newPass->SetDynamicResolutionFrameRate(
+    this->UseDynamicResolution ? std::max(this->DynamicResolutionFrameRate, 0.0) : 0.0);
+  newPass->SetProgressiveFrames(this->ProgressiveFrames);
+  newPass->SetStatistics(stats);
+  this->F3DRenderPass = newPass;
 
   double bounds[6];
-  this->ComputeVisiblePropBounds(bounds);
+  this->GetSceneBounds(bounds);
   newPass->SetBounds(bounds);
 
   // Image post processing passes
-  vtkSmartPointer<vtkRenderPass> renderingPass = newPass;
+  vtkSmartPointer<vtkRenderPass> renderingPass = vtkF3DTimerPass::Wrap(newPass, "blend", stats);
 
-  if (this->UseToneMappingPass)
+  std::string userShader;
+  if (this->FinalShader.has_value())
   {
-    vtkNew<vtkToneMappingPass> toneP;
+    // basic validation
+    if (this->FinalShader.value().find("pixel") != std::string::npos)
+    {
+      userShader = this->FinalShader.value();
+    }
+    else
+    {
+      F3DLog::Print(F3DLog::Severity::Warning,
+        "Final shader must define a function named \"pixel\"");
+    }
+  }
 
+  // the tone mapping is applied to the samples of the next effect in a single pass, the FXAA
+  // is not fused with the user shader since it would be computed for each sample of the source
 #if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240609)
-    toneP->SetToneMappingType(vtkToneMappingPass::NeutralPBR);
+  const bool fusedUserShader = !userShader.empty() && !useFXAA;
+  const bool fusedEffects = this->UseToneMappingPass && (useFXAA || fusedUserShader);
 #else
-    toneP->SetToneMappingType(vtkToneMappingPass::GenericFilmic);
-    toneP->SetGenericFilmicDefaultPresets();
+  // the fused pass only implements the neutral tone mapping
+  const bool fusedUserShader = false;
+  const bool fusedEffects = false;
 #endif
-    toneP->SetDelegatePass(renderingPass);
-    renderingPass = toneP;
-  }
 
-  if (this->UseFXAAPass)
+  if (fusedEffects)
   {
-    vtkNew<vtkOpenGLFXAAPass> fxaaP;
-    fxaaP->SetDelegatePass(renderingPass);
+    vtkNew<vtkF3DPostProcessPass> postP;
+    postP->SetUseToneMapping(true);
+    postP->SetUseFXAA(useFXAA);
+    postP->SetUserShader(fusedUserShader ? userShader : "");
+    postP->SetDelegatePass(renderingPass);
 
-    this->SetPass(fxaaP);
-    renderingPass = fxaaP;
+    renderingPass = vtkF3DTimerPass::Wrap(postP, "post processing", stats);
   }
-
-  if (this->FinalShader.has_value())
+  else
   {
-    // basic validation
-    if (this->FinalShader.value().find("pixel") != std::string::npos)
+    if (this->UseToneMappingPass)
     {
-      vtkNew<vtkF3DUserRenderPass> userP;
-      userP->SetUserShader(this->FinalShader.value().c_str());
-      userP->SetDelegatePass(renderingPass);
+      vtkNew<vtkToneMappingPass> toneP;
 
-      this->SetPass(userP);
-      renderingPass = userP;
+#if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240609)
+      toneP->SetToneMappingType(vtkToneMappingPass::NeutralPBR);
+#else
+      toneP->SetToneMappingType(vtkToneMappingPass::GenericFilmic);
+      toneP->SetGenericFilmicDefaultPresets();
+#endif
+      toneP->SetDelegatePass(renderingPass);
+      renderingPass = vtkF3DTimerPass::Wrap(toneP, "tone mapping", stats);
     }
-    else
+
+    if (useFXAA)
     {
-      F3DLog::Print(F3DLog::Severity::Warning,
-        "Final shader must define a function named \"pixel\"");
+      vtkNew<vtkOpenGLFXAAPass> fxaaP;
+      fxaaP->SetDelegatePass(renderingPass);
+
+      renderingPass = vtkF3DTimerPass::Wrap(fxaaP, "fxaa", stats);
     }
   }
 
+  if (!userShader.empty() && !(fusedEffects && fusedUserShader))
+  {
+    vtkNew<vtkF3DUserRenderPass> userP;
+    userP->SetUserShader(userShader);
+    userP->SetDelegatePass(renderingPass);
+
+    renderingPass = vtkF3DTimerPass::Wrap(userP, "final shader", stats);
+  }
+
   this->SetPass(renderingPass);
 
+  this->ConfigureRaytracing();
+  this->RenderPassesConfigured = true;
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DRenderer::ConfigureRaytracing()
+{
 #if F3D_MODULE_RAYTRACING
   vtkOSPRayRendererNode::SetRendererType("pathtracer", this);
   vtkOSPRayRendererNode::SetSamplesPerPixel(this->RaytracingSamples, this);
   vtkOSPRayRendererNode::SetEnableDenoiser(this->UseRaytracingDenoiser, this);
   vtkOSPRayRendererNode::SetDenoiserThreshold(0, this);
+  if (this->F3DRenderPass)
+  {
+    this->F3DRenderPass->SetUseRaytracingDenoiser(this->UseRaytracingDenoiser);
+  }
 
   vtkOSPRayRendererNode::BackgroundMode mode = vtkOSPRayRendererNode::Backplate;
   if (this->GetUseImageBasedLighting())
@@ -421,6 +963,9 @@ void vtkF3DRenderer::ConfigureRenderPasses()
     mode = vtkOSPRayRendererNode::Both;
   }
   vtkOSPRayRendererNode::SetBackgroundMode(mode, this);
+
+  // the settings are stored in the renderer information, make sure the frame is not reused
+  this->Modified();
 #else
   if (this->UseRaytracing || this->UseRaytracingDenoiser)
   {
@@ -428,7 +973,7 @@ void vtkF3DRenderer::ConfigureRenderPasses()
       "Raytracing options can't be used if F3D has not been built with raytracing");
   }
 #endif
-  this->RenderPassesConfigured = true;
+  this->RaytracingConfigured = true;
 }
 
 //----------------------------------------------------------------------------
@@ -440,7 +985,7 @@ std::string vtkF3DRenderer::GetSceneDescription()
 
   // Bounding box
   double bounds[6];
-  this->ComputeVisiblePropBounds(bounds);
+  this->GetSceneBounds(bounds);
 
   stream << "Scene bounding box: " << bounds[0] << "," << bounds[1] << "," << bounds[2] << ","
          << bounds[3] << "," << bounds[4] << "," << bounds[5] << "\n\n";
@@ -458,6 +1003,16 @@ std::string vtkF3DRenderer::GetSceneDescription()
          << "Camera focal point: " << focal[0] << "," << focal[1] << "," << focal[2] << "\n"
          << "Camera view up: " << up[0] << "," << up[1] << "," << up[2] << "\n"
          << "Camera view angle: " << cam->GetViewAngle() << "\n\n";
+
+  // Memory Info
+  if (this->Importer)
+  {
+    vtkTypeInt64 cpu;
+    vtkTypeInt64 gpu;
+    this->Importer->GetMemoryUsage(cpu, gpu);
+    stream << "Memory usage: " << cpu / (1024 * 1024) << " MiB\n"
+           << "Estimated GPU memory usage: " << gpu / (1024 * 1024) << " MiB\n\n";
+  }
   descr += stream.str();
 
   // Grid Info
@@ -563,15 +1118,22 @@ void vtkF3DRenderer::ShowGrid(bool show)
 //----------------------------------------------------------------------------
 void vtkF3DRenderer::ConfigureGridUsingCurrentActors()
 {
+  F3D_TRACE_SCOPE("vtkF3DRenderer::ConfigureGridUsingCurrentActors");
   // Configure grid using visible prop bounds and actors
   // Also initialize GridInfo
   bool show = this->GridVisible;
   if (show)
   {
     double bounds[6];
-    this->ComputeVisiblePropBounds(bounds);
+    this->GetSceneBounds(bounds);
 
+    // the grid does not move while an animation stays within the bounds of its time values
     vtkBoundingBox bbox(bounds);
+    if (bbox.IsValid() && this->TimelineBounds.IsValid())
+    {
+      bbox.AddBox(this->TimelineBounds);
+      bbox.GetBounds(bounds);
+    }
 
     if (!bbox.IsValid())
     {
@@ -617,18 +1179,29 @@ void vtkF3DRenderer::ConfigureGridUsingCurrentActors()
              << "]\n";
       this->GridInfo = stream.str();
 
-      vtkNew<vtkF3DOpenGLGridMapper> gridMapper;
-      gridMapper->SetFadeDistance(diag);
-      gridMapper->SetUnitSquare(tmpUnitSquare);
-      gridMapper->SetSubdivisions(this->GridSubdivisions);
-      gridMapper->SetUpIndex(this->UpIndex);
+      // the grid is computed in the fragment shader from uniforms, so the same mapper is kept
+      // when the bounds change and its shader is only rebuilt when the up axis changes
+      if (!this->GridMapper)
+      {
+        this->GridMapper = vtkSmartPointer<vtkF3DOpenGLGridMapper>::New();
+      }
+      this->GridMapper->SetFadeDistance(diag);
+      this->GridMapper->SetUnitSquare(tmpUnitSquare);
+      this->GridMapper->SetSubdivisions(this->GridSubdivisions);
+      this->GridMapper->SetUpIndex(this->UpIndex);
       if (this->GridAbsolute)
-        gridMapper->SetOriginOffset(-gridPos[0], -gridPos[1], -gridPos[2]);
+      {
+        this->GridMapper->SetOriginOffset(-gridPos[0], -gridPos[1], -gridPos[2]);
+      }
+      else
+      {
+        this->GridMapper->SetOriginOffset(0.0, 0.0, 0.0);
+      }
 
       this->GridActor->GetProperty()->SetColor(this->GridColor);
       this->GridActor->ForceTranslucentOn();
       this->GridActor->SetPosition(gridPos);
-      this->GridActor->SetMapper(gridMapper);
+      this->GridActor->SetMapper(this->GridMapper);
       this->GridActor->UseBoundsOff();
       this->GridActor->PickableOff();
       this->GridConfigured = true;
@@ -668,6 +1241,7 @@ void vtkF3DRenderer::SetHDRIFile(const std::optional<std::string>& hdriFile)
     this->HDRISphericalHarmonicsConfigured = false;
     this->HDRISpecularConfigured = false;
     this->HDRISkyboxConfigured = false;
+    this->HDRIPreprocessed = false;
   }
 }
 
@@ -681,9 +1255,9 @@ void vtkF3DRenderer::SetUseImageBasedLighting(bool use)
     this->HDRIReaderConfigured = false;
     this->HDRIHashConfigured = false;
     this->HDRITextureConfigured = false;
-    this->HDRILUTConfigured = false;
     this->HDRISphericalHarmonicsConfigured = false;
     this->HDRISpecularConfigured = false;
+    this->HDRIPreprocessed = false;
 
     this->RenderPassesConfigured = false;
     this->CheatSheetConfigured = false;
@@ -699,13 +1273,12 @@ void vtkF3DRenderer::SetCachePath(const std::string& cachePath)
     this->TextActorsConfigured = false;
     this->RenderPassesConfigured = false;
 
-    this->HasValidHDRILUT = false;
     this->HasValidHDRISH = false;
     this->HasValidHDRISpec = false;
 
-    this->HDRILUTConfigured = false;
     this->HDRISphericalHarmonicsConfigured = false;
     this->HDRISpecularConfigured = false;
+    this->HDRIPreprocessed = false;
 
     if (this->HasValidHDRIHash)
     {
@@ -726,18 +1299,39 @@ bool vtkF3DRenderer::CheckForSHCache(std::string& path)
 bool vtkF3DRenderer::CheckForSpecCache(std::string& path)
 {
   assert(this->HasValidHDRIHash);
-  path = this->CachePath + "/" + this->HDRIHash + "/specular.vtm";
-  return vtksys::SystemTools::FileExists(path, true);
+  path = this->CachePath + "/" + this->HDRIHash + "/specular.bin";
+  return vtkF3DCachedSpecularTexture::IsValidCache(path);
 }
 
 //----------------------------------------------------------------------------
 void vtkF3DRenderer::ConfigureHDRI()
 {
+  F3D_TRACE_SCOPE("vtkF3DRenderer::ConfigureHDRI");
   if (!this->HDRIReaderConfigured)
   {
     this->ConfigureHDRIReader();
   }
 
+  // Keep the previous environment while the HDRI is preprocessed on a worker thread
+  if (this->HDRIPreprocessing.valid())
+  {
+    if (this->UseAsyncHDRI &&
+      this->HDRIPreprocessing.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+    {
+      return;
+    }
+    this->FinishHDRIPreprocessing();
+  }
+
+  bool useIBL = this->GetUseImageBasedLighting();
+  bool heavyWork = (!this->HDRIReaderUpdated && (this->HDRISkyboxVisible || useIBL)) ||
+    (useIBL && (!this->HasValidHDRIHash || !this->HasValidHDRISH));
+  if (this->UseAsyncHDRI && this->HasValidHDRIReader && !this->HDRIPreprocessed && heavyWork)
+  {
+    this->StartHDRIPreprocessing();
+    return;
+  }
+
   if (!this->HDRIHashConfigured)
   {
     this->ConfigureHDRIHash();
@@ -748,11 +1342,6 @@ void vtkF3DRenderer::ConfigureHDRI()
     this->ConfigureHDRITexture();
   }
 
-  if (!this->HDRILUTConfigured)
-  {
-    this->ConfigureHDRILUT();
-  }
-
   if (!this->HDRISphericalHarmonicsConfigured)
   {
     this->ConfigureHDRISphericalHarmonics();
@@ -770,30 +1359,240 @@ void vtkF3DRenderer::ConfigureHDRI()
 }
 
 //----------------------------------------------------------------------------
-void vtkF3DRenderer::ConfigureHDRIReader()
+void vtkF3DRenderer::StartHDRIPreprocessing()
 {
-  if (!this->HasValidHDRIReader && (this->HDRISkyboxVisible || this->GetUseImageBasedLighting()))
-  {
-    this->UseDefaultHDRI = false;
-    this->HDRIReader = nullptr;
-    if (this->HDRIFile.has_value())
+  bool useIBL = this->GetUseImageBasedLighting();
+  bool computeHash = false;
+  bool computeSH = false;
+#if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 2, 20221220)
+  computeHash = useIBL && !this->HasValidHDRIHash;
+  computeSH = useIBL && !this->HasValidHDRISH;
+#endif
+#if !defined(__ANDROID__) && !defined(__EMSCRIPTEN__) &&                                           \
+  VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240203)
+  // the spherical harmonics are computed on the GPU in a few milliseconds instead
+  computeSH = computeSH && !vtkF3DEnvironmentCompute::IsSupported();
+#endif
+
+  // Only copies are used by the worker, the reader is not used by the renderer until it is done
+  std::string hash = this->HasValidHDRIHash ? this->HDRIHash : "";
+  std::string file = this->UseDefaultHDRI ? "" : this->HDRIFile.value();
+  std::string cachePath = this->CachePath;
+  bool readerUpdated = this->HDRIReaderUpdated;
+  bool skybox = this->HDRISkyboxVisible;
+  bool raytracing = this->UseRaytracing;
+
+  this->HDRIPreprocessing = std::async(std::launch::async,
+    [=, reader = this->HDRIReader]()
     {
-      if (!vtksys::SystemTools::FileExists(this->HDRIFile.value(), true))
+      HDRIPreprocessingResult result;
+      result.Reader = reader;
+      result.Hash = hash;
+      if (computeHash)
       {
-        F3DLog::Print(
-          F3DLog::Severity::Warning, std::string("HDRI file does not exist ") + this->HDRIFile.value());
+#if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 2, 20221220)
+        result.Hash = file.empty() ? "default" : ::ComputeHDRIHash(file, cachePath);
+#endif
       }
-      else
+
+      // Same logic as ConfigureHDRITexture and ConfigureHDRISphericalHarmonics
+      bool shCached = false;
+      bool needTexture = skybox || useIBL;
+      if (!result.Hash.empty())
       {
-        this->HDRIReader = vtkSmartPointer<vtkImageReader2>::Take(
-          vtkImageReader2Factory::CreateImageReader2(this->HDRIFile.value().c_str()));
-        if (this->HDRIReader)
-        {
-          this->HDRIReader->SetFileName(this->HDRIFile.value().c_str());
-        }
-        else
-        {
-          F3DLog::Print(F3DLog::Severity::Warning,
+        std::string cacheDir = cachePath + "/" + result.Hash;
+        shCached = vtksys::SystemTools::FileExists(cacheDir + "/sh.vtt", true);
+        bool specCached = vtkF3DCachedSpecularTexture::IsValidCache(cacheDir + "/specular.bin");
+        needTexture = skybox || (useIBL && (!shCached || !specCached || raytracing));
+      }
+
+      if (needTexture && !readerUpdated)
+      {
+        reader->Update();
+        result.ReaderUpdated = true;
+      }
+
+#if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 2, 20221220)
+      if (computeSH && !shCached)
+      {
+        vtkNew<vtkSphericalHarmonics> sh;
+        sh->SetInputData(reader->GetOutput());
+        sh->Update();
+        result.SphericalHarmonics = vtkFloatArray::SafeDownCast(
+          vtkTable::SafeDownCast(sh->GetOutputDataObject(0))->GetColumn(0));
+      }
+#else
+      (void)computeSH;
+#endif
+      return result;
+    });
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DRenderer::FinishHDRIPreprocessing()
+{
+  HDRIPreprocessingResult result = this->HDRIPreprocessing.get();
+  if (result.Reader != this->HDRIReader)
+  {
+    // The HDRI changed while it was preprocessed
+    return;
+  }
+
+  if (result.ReaderUpdated)
+  {
+    this->HDRIReaderUpdated = true;
+  }
+
+  if (!result.Hash.empty() && !this->HasValidHDRIHash)
+  {
+    this->HDRIHash = result.Hash;
+    this->HasValidHDRIHash = true;
+    this->CreateCacheDirectory();
+  }
+
+  this->PreprocessedHDRISH = result.SphericalHarmonics;
+  this->HDRIPreprocessed = true;
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DRenderer::SetUseAsyncHDRI(bool use)
+{
+  this->UseAsyncHDRI = use;
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DRenderer::IsHDRIPreprocessed()
+{
+  return this->HDRIPreprocessing.valid() &&
+    this->HDRIPreprocessing.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DRenderer::SetUseAsyncTessellation(bool use)
+{
+  this->UseAsyncTessellation = use;
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DRenderer::IsTessellationRefined()
+{
+  return this->Importer && this->Importer->IsTessellationRefined();
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DRenderer::IsRenderAccumulating()
+{
+  return this->RenderPassesConfigured && this->F3DRenderPass &&
+    this->F3DRenderPass->IsAccumulating();
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DRenderer::ReadDepthAndNormals(std::vector<float>& values)
+{
+  return this->RenderPassesConfigured && this->F3DRenderPass &&
+    this->F3DRenderPass->ReadDepthAndNormals(this, values);
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DRenderer::RenderActorIndices(std::vector<unsigned short>& indices)
+{
+  F3D_TRACE_SCOPE("vtkF3DRenderer::RenderActorIndices");
+  int* size = this->GetSize();
+  indices.assign(static_cast<size_t>(size[0]) * size[1], 0);
+  if (!this->Importer || size[0] <= 0 || size[1] <= 0)
+  {
+    return false;
+  }
+
+  // the props drawn in place of an imported actor have its index
+  std::map<vtkProp*, unsigned short> propIndices;
+  const auto& coloringActors = this->Importer->GetColoringActorsAndMappers();
+  for (size_t i = 0; i < coloringActors.size(); i++)
+  {
+    unsigned short index =
+      static_cast<unsigned short>(std::min<size_t>(i + 1, VTK_UNSIGNED_SHORT_MAX));
+    propIndices[coloringActors[i].OriginalActor] = index;
+    if (coloringActors[i].Actor)
+    {
+      propIndices[coloringActors[i].Actor] = index;
+    }
+  }
+  const auto& pointSpritesActors = this->Importer->GetPointSpritesActorsAndMappers();
+  for (size_t i = 0; i < pointSpritesActors.size() && i < coloringActors.size(); i++)
+  {
+    propIndices[pointSpritesActors[i].Actor] = propIndices[coloringActors[i].OriginalActor];
+  }
+  for (const auto& batch : this->Importer->GetStaticBatches())
+  {
+    if (!batch.OriginalActors.empty())
+    {
+      propIndices[batch.Actor] = propIndices[batch.OriginalActors.front()];
+    }
+  }
+
+  // the render passes post process the colors the props ids are encoded in
+  vtkSmartPointer<vtkRenderPass> pass = this->GetPass();
+  this->SetPass(nullptr);
+
+  vtkNew<vtkHardwareSelector> selector;
+  selector->SetRenderer(this);
+  selector->SetActorPassOnly(true);
+  selector->SetFieldAssociation(vtkDataObject::FIELD_ASSOCIATION_CELLS);
+  selector->SetArea(0, 0, size[0] - 1, size[1] - 1);
+  bool captured = selector->CaptureBuffers();
+
+  this->SetPass(pass);
+
+  if (!captured)
+  {
+    return false;
+  }
+
+  for (int y = 0; y < size[1]; y++)
+  {
+    for (int x = 0; x < size[0]; x++)
+    {
+      unsigned int position[2] = { static_cast<unsigned int>(x), static_cast<unsigned int>(y) };
+      vtkHardwareSelector::PixelInformation info = selector->GetPixelInformation(position, 0);
+      auto it = info.Prop ? propIndices.find(info.Prop) : propIndices.end();
+      if (it != propIndices.end())
+      {
+        indices[static_cast<size_t>(y) * size[0] + x] = it->second;
+      }
+    }
+  }
+  selector->ClearBuffers();
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DRenderer::ConfigureHDRIReader()
+{
+  F3D_TRACE_SCOPE("vtkF3DRenderer::ConfigureHDRIReader");
+  if (!this->HasValidHDRIReader && (this->HDRISkyboxVisible || this->GetUseImageBasedLighting()))
+  {
+    this->UseDefaultHDRI = false;
+    this->HDRIReader = nullptr;
+    this->HDRIReaderUpdated = false;
+    this->PreprocessedHDRISH = nullptr;
+    if (this->HDRIFile.has_value())
+    {
+      if (!vtksys::SystemTools::FileExists(this->HDRIFile.value(), true))
+      {
+        F3DLog::Print(
+          F3DLog::Severity::Warning, std::string("HDRI file does not exist ") + this->HDRIFile.value());
+      }
+      else
+      {
+        this->HDRIReader = vtkSmartPointer<vtkImageReader2>::Take(
+          vtkImageReader2Factory::CreateImageReader2(this->HDRIFile.value().c_str()));
+        if (this->HDRIReader)
+        {
+          this->HDRIReader->SetFileName(this->HDRIFile.value().c_str());
+        }
+        else
+        {
+          F3DLog::Print(F3DLog::Severity::Warning,
             std::string("Cannot open HDRI file ") + this->HDRIFile.value() +
               std::string(". Using default HDRI"));
         }
@@ -818,6 +1617,7 @@ void vtkF3DRenderer::ConfigureHDRIReader()
 //----------------------------------------------------------------------------
 void vtkF3DRenderer::ConfigureHDRIHash()
 {
+  F3D_TRACE_SCOPE("vtkF3DRenderer::ConfigureHDRIHash");
 #if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 2, 20221220)
   if (!this->HasValidHDRIHash && this->GetUseImageBasedLighting() && this->HasValidHDRIReader)
   {
@@ -827,8 +1627,8 @@ void vtkF3DRenderer::ConfigureHDRIHash()
     }
     else
     {
-      // Compute HDRI MD5, here we know the HDRIFile has a value
-      this->HDRIHash = ::ComputeFileHash(this->HDRIFile.value());
+      // Compute HDRI hash, here we know the HDRIFile has a value
+      this->HDRIHash = ::ComputeHDRIHash(this->HDRIFile.value(), this->CachePath);
     }
     this->HasValidHDRIHash = true;
     this->CreateCacheDirectory();
@@ -840,6 +1640,7 @@ void vtkF3DRenderer::ConfigureHDRIHash()
 //----------------------------------------------------------------------------
 void vtkF3DRenderer::ConfigureHDRITexture()
 {
+  F3D_TRACE_SCOPE("vtkF3DRenderer::ConfigureHDRITexture");
   if (!this->HasValidHDRITexture)
   {
     bool needHDRITexture = this->HDRISkyboxVisible || this->GetUseImageBasedLighting();
@@ -859,6 +1660,7 @@ void vtkF3DRenderer::ConfigureHDRITexture()
     {
       assert(this->HasValidHDRIReader);
       this->HDRIReader->Update();
+      this->HDRIReaderUpdated = true;
 
       this->HDRITexture = vtkSmartPointer<vtkTexture>::New();
       this->HDRITexture->SetColorModeToDirectScalars();
@@ -912,59 +1714,19 @@ void vtkF3DRenderer::ConfigureHDRITexture()
   this->HDRITextureConfigured = true;
 }
 
-//----------------------------------------------------------------------------
-void vtkF3DRenderer::ConfigureHDRILUT()
-{
-#if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 2, 20221220)
-  if (this->GetUseImageBasedLighting() && !this->HasValidHDRILUT)
-  {
-    vtkF3DCachedLUTTexture* lut = vtkF3DCachedLUTTexture::SafeDownCast(this->EnvMapLookupTable);
-    assert(lut);
-
-    // Check LUT cache
-    std::string lutCachePath = this->CachePath + "/lut.vti";
-    bool lutCacheExists = vtksys::SystemTools::FileExists(lutCachePath, true);
-    if (lutCacheExists)
-    {
-      lut->SetFileName(lutCachePath.c_str());
-      lut->UseCacheOn();
-    }
-    else
-    {
-      if (!lut->GetTextureObject() || !this->HasValidHDRILUT)
-      {
-        lut->UseCacheOff();
-        lut->Load(this);
-        lut->PostRender(this);
-      }
-      assert(lut->GetTextureObject());
-
-#ifndef __EMSCRIPTEN__
-      vtkSmartPointer<vtkImageData> img = ::SaveTextureToImage(
-        lut->GetTextureObject(), GL_TEXTURE_2D, 0, lut->GetLUTSize(), VTK_UNSIGNED_SHORT);
-      assert(img);
-
-      vtkNew<vtkXMLImageDataWriter> writer;
-      writer->SetFileName(lutCachePath.c_str());
-      writer->SetInputData(img);
-      writer->Write();
-#endif
-    }
-    this->HasValidHDRILUT = true;
-  }
-#endif
-  this->HDRILUTConfigured = true;
-}
-
 //----------------------------------------------------------------------------
 void vtkF3DRenderer::ConfigureHDRISphericalHarmonics()
 {
+  F3D_TRACE_SCOPE("vtkF3DRenderer::ConfigureHDRISphericalHarmonics");
 #if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 2, 20221220)
   if (this->GetUseImageBasedLighting() && !this->HasValidHDRISH)
   {
     // Check spherical harmonics cache
     std::string shCachePath;
-    if (this->CheckForSHCache(shCachePath))
+    const bool shCached = this->CheckForSHCache(shCachePath);
+    vtkF3DMetrics::Increment(
+      shCached ? "f3d_cache_hits_total" : "f3d_cache_misses_total", { "cache", "hdri_sh" });
+    if (shCached)
     {
       vtkNew<vtkXMLTableReader> reader;
       reader->SetFileName(shCachePath.c_str());
@@ -974,15 +1736,34 @@ void vtkF3DRenderer::ConfigureHDRISphericalHarmonics()
     }
     else
     {
-      if (!this->SphericalHarmonics ||
+      if (this->PreprocessedHDRISH)
+      {
+        this->SphericalHarmonics = this->PreprocessedHDRISH;
+        this->PreprocessedHDRISH = nullptr;
+      }
+      else if (!this->SphericalHarmonics ||
         this->HDRITexture->GetInput()->GetMTime() > this->SphericalHarmonics->GetMTime() ||
         !this->HasValidHDRISH)
       {
-        vtkNew<vtkSphericalHarmonics> sh;
-        sh->SetInputData(this->HDRITexture->GetInput());
-        sh->Update();
-        this->SphericalHarmonics = vtkFloatArray::SafeDownCast(
-          vtkTable::SafeDownCast(sh->GetOutputDataObject(0))->GetColumn(0));
+        bool computed = false;
+#if !defined(__ANDROID__) && !defined(__EMSCRIPTEN__) &&                                           \
+  VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240203)
+        vtkNew<vtkFloatArray> harmonics;
+        computed = this->EnvironmentCompute->ComputeSphericalHarmonics(
+          this, vtkOpenGLTexture::SafeDownCast(this->HDRITexture), harmonics);
+        if (computed)
+        {
+          this->SphericalHarmonics = harmonics;
+        }
+#endif
+        if (!computed)
+        {
+          vtkNew<vtkSphericalHarmonics> sh;
+          sh->SetInputData(this->HDRITexture->GetInput());
+          sh->Update();
+          this->SphericalHarmonics = vtkFloatArray::SafeDownCast(
+            vtkTable::SafeDownCast(sh->GetOutputDataObject(0))->GetColumn(0));
+        }
       }
 
 #ifndef __EMSCRIPTEN__
@@ -1005,6 +1786,7 @@ void vtkF3DRenderer::ConfigureHDRISphericalHarmonics()
 //----------------------------------------------------------------------------
 void vtkF3DRenderer::ConfigureHDRISpecular()
 {
+  F3D_TRACE_SCOPE("vtkF3DRenderer::ConfigureHDRISpecular");
 #if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 2, 20221220)
   if (this->GetUseImageBasedLighting() && !this->HasValidHDRISpec)
   {
@@ -1014,7 +1796,10 @@ void vtkF3DRenderer::ConfigureHDRISpecular()
 
     // Check specular cache
     std::string specCachePath;
-    if (this->CheckForSpecCache(specCachePath))
+    const bool specCached = this->CheckForSpecCache(specCachePath);
+    vtkF3DMetrics::Increment(specCached ? "f3d_cache_hits_total" : "f3d_cache_misses_total",
+      { "cache", "hdri_specular" });
+    if (specCached)
     {
       spec->SetFileName(specCachePath.c_str());
       spec->UseCacheOn();
@@ -1044,14 +1829,10 @@ void vtkF3DRenderer::ConfigureHDRISpecular()
         mb->SetBlock(i, img);
       }
 
-      vtkNew<vtkXMLMultiBlockDataWriter> writer;
-      writer->SetCompressorTypeToNone();
-      writer->SetDataModeToAppended();
-      writer->EncodeAppendedDataOff();
-      writer->SetHeaderTypeToUInt64();
-      writer->SetFileName(specCachePath.c_str());
-      writer->SetInputData(mb);
-      writer->Write();
+      if (!vtkF3DCachedSpecularTexture::WriteCache(specCachePath, mb))
+      {
+        F3DLog::Print(F3DLog::Severity::Warning, "Cannot write specular cache: " + specCachePath);
+      }
 #endif
     }
     this->HasValidHDRISpec = true;
@@ -1064,14 +1845,88 @@ void vtkF3DRenderer::ConfigureHDRISpecular()
 //----------------------------------------------------------------------------
 void vtkF3DRenderer::ConfigureHDRISkybox()
 {
-  this->SkyboxActor->SetTexture(this->HDRITexture);
+  F3D_TRACE_SCOPE("vtkF3DRenderer::ConfigureHDRISkybox");
+  vtkTexture* texture = this->HDRITexture;
+  this->BlurredHDRILevel = -1;
+  if (this->HDRISkyboxVisible && this->UseBlurBackground && this->HDRITexture)
+  {
+    texture = this->ConfigureBlurredHDRITexture();
+  }
+  this->SkyboxActor->SetTexture(texture);
   this->SkyboxActor->SetVisibility(this->HDRISkyboxVisible);
   this->HDRISkyboxConfigured = true;
 }
 
+//----------------------------------------------------------------------------
+int vtkF3DRenderer::ComputeHDRIBlurLevel()
+{
+  vtkImageData* image = this->HDRITexture ? this->HDRITexture->GetInput() : nullptr;
+  int* size = this->GetSize();
+  if (!image || size[1] <= 0)
+  {
+    return 0;
+  }
+
+  // angle covered by the circle of confusion, compared to the angle of an equirectangular texel
+  double radius = vtkMath::RadiansFromDegrees(this->GetActiveCamera()->GetViewAngle()) *
+    this->CircleOfConfusionRadius / size[1];
+  double texelsPerRadius = radius * image->GetDimensions()[0] / (2.0 * vtkMath::Pi());
+
+  // the image is shrunk until the radius is about two texels, the interpolation blurs the rest
+  return std::clamp(static_cast<int>(std::floor(std::log2(std::max(texelsPerRadius, 1.0) / 2.0))),
+    0, 8);
+}
+
+//----------------------------------------------------------------------------
+vtkTexture* vtkF3DRenderer::ConfigureBlurredHDRITexture()
+{
+  F3D_TRACE_SCOPE("vtkF3DRenderer::ConfigureBlurredHDRITexture");
+  vtkImageData* image = this->HDRITexture->GetInput();
+  if (!image)
+  {
+    return this->HDRITexture;
+  }
+
+  int level = this->ComputeHDRIBlurLevel();
+  if (!this->BlurredHDRITexture || this->BlurredHDRILevelCached != level ||
+    this->BlurredHDRITime < image->GetMTime())
+  {
+    int* dims = image->GetDimensions();
+
+    // the antialiased sinc kernel widens with the shrink factor, the blur factors soften it further
+    vtkNew<vtkImageSincInterpolator> interpolator;
+    interpolator->AntialiasingOn();
+    interpolator->SetBlurFactors(2.0, 2.0, 1.0);
+
+    vtkNew<vtkImageResize> resize;
+    resize->SetInputData(image);
+    resize->SetInterpolator(interpolator);
+    resize->SetResizeMethodToOutputDimensions();
+    resize->SetOutputDimensions(std::max(dims[0] >> level, 4), std::max(dims[1] >> level, 2), 1);
+    resize->Update();
+
+    vtkNew<vtkImageData> blurred;
+    blurred->ShallowCopy(resize->GetOutput());
+
+    this->BlurredHDRITexture = vtkSmartPointer<vtkTexture>::New();
+    this->BlurredHDRITexture->SetColorModeToDirectScalars();
+    this->BlurredHDRITexture->MipmapOn();
+    this->BlurredHDRITexture->InterpolateOn();
+    this->BlurredHDRITexture->SetUseSRGBColorSpace(this->HDRITexture->GetUseSRGBColorSpace());
+    this->BlurredHDRITexture->SetInputData(blurred);
+
+    this->BlurredHDRILevelCached = level;
+    this->BlurredHDRITime = image->GetMTime();
+  }
+
+  this->BlurredHDRILevel = level;
+  return this->BlurredHDRITexture;
+}
+
 //----------------------------------------------------------------------------
 void vtkF3DRenderer::ConfigureTextActors()
 {
+  F3D_TRACE_SCOPE("vtkF3DRenderer::ConfigureTextActors");
   // Dynamic text color
   double textColor[3];
   if (this->IsBackgroundDark())
@@ -1140,6 +1995,16 @@ void vtkF3DRenderer::SetPointSize(const std::optional<double>& pointSize)
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkF3DRenderer::SetUseCompactVertices(bool use)
+{
+  if (this->UseCompactVertices != use)
+  {
+    this->UseCompactVertices = use;
+    this->ActorsPropertiesConfigured = false;
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkF3DRenderer::SetFontFile(const std::optional<std::string>& fontFile)
 {
@@ -1192,12 +2057,43 @@ void vtkF3DRenderer::SetUseDepthPeelingPass(bool use)
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkF3DRenderer::SetTranslucencyTechnique(const std::string& technique)
+{
+  if (this->TranslucencyTechnique != technique)
+  {
+    this->TranslucencyTechnique = technique;
+    this->RenderPassesConfigured = false;
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DRenderer::SetTranslucencyPeels(int peels)
+{
+  if (this->TranslucencyPeels != peels)
+  {
+    this->TranslucencyPeels = peels;
+    this->RenderPassesConfigured = false;
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DRenderer::SetTranslucencyThreshold(double threshold)
+{
+  if (this->TranslucencyThreshold != threshold)
+  {
+    this->TranslucencyThreshold = threshold;
+    this->RenderPassesConfigured = false;
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkF3DRenderer::SetUseBlurBackground(bool use)
 {
   if (this->UseBlurBackground != use)
   {
     this->UseBlurBackground = use;
+    this->HDRISkyboxConfigured = false;
     this->RenderPassesConfigured = false;
     this->CheatSheetConfigured = false;
   }
@@ -1219,6 +2115,7 @@ void vtkF3DRenderer::SetBlurCircleOfConfusionRadius(double radius)
   if (this->CircleOfConfusionRadius != radius)
   {
     this->CircleOfConfusionRadius = radius;
+    this->HDRISkyboxConfigured = false;
     this->RenderPassesConfigured = false;
   }
 }
@@ -1234,6 +2131,36 @@ void vtkF3DRenderer::SetUseSSAOPass(bool use)
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkF3DRenderer::SetUseEDLPass(const std::optional<bool>& use)
+{
+  if (this->UseEDLPass != use)
+  {
+    this->UseEDLPass = use;
+    this->RenderPassesConfigured = false;
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DRenderer::SetProgressiveFrames(int frames)
+{
+  if (this->ProgressiveFrames != frames)
+  {
+    this->ProgressiveFrames = frames;
+    this->RenderPassesConfigured = false;
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DRenderer::SetAmbientOcclusionDownsampling(int downsampling)
+{
+  if (this->AmbientOcclusionDownsampling != downsampling)
+  {
+    this->AmbientOcclusionDownsampling = downsampling;
+    this->RenderPassesConfigured = false;
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkF3DRenderer::SetFinalShader(const std::optional<std::string>& finalShader)
 {
@@ -1255,6 +2182,16 @@ void vtkF3DRenderer::SetUseFXAAPass(bool use)
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkF3DRenderer::SetAntiAliasingTechnique(const std::string& technique)
+{
+  if (this->AntiAliasingTechnique != technique)
+  {
+    this->AntiAliasingTechnique = technique;
+    this->RenderPassesConfigured = false;
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkF3DRenderer::SetUseToneMappingPass(bool use)
 {
@@ -1266,6 +2203,46 @@ void vtkF3DRenderer::SetUseToneMappingPass(bool use)
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkF3DRenderer::SetUseOcclusionCulling(bool use)
+{
+  if (this->UseOcclusionCulling != use)
+  {
+    this->UseOcclusionCulling = use;
+    this->RenderPassesConfigured = false;
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DRenderer::SetUseDynamicResolution(bool use)
+{
+  if (this->UseDynamicResolution != use)
+  {
+    this->UseDynamicResolution = use;
+    this->RenderPassesConfigured = false;
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DRenderer::SetDynamicResolutionFrameRate(double frameRate)
+{
+  if (this->DynamicResolutionFrameRate != frameRate)
+  {
+    this->DynamicResolutionFrameRate = frameRate;
+    this->RenderPassesConfigured = false;
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DRenderer::SetUseStaticBatching(bool use)
+{
+  if (this->UseStaticBatching != use)
+  {
+    this->UseStaticBatching = use;
+    this->ColoringConfigured = false;
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkF3DRenderer::SetUseRaytracing(bool use)
 {
@@ -1283,7 +2260,7 @@ void vtkF3DRenderer::SetRaytracingSamples(int samples)
   if (this->RaytracingSamples != samples)
   {
     this->RaytracingSamples = samples;
-    this->RenderPassesConfigured = false;
+    this->RaytracingConfigured = false;
   }
 }
 
@@ -1293,7 +2270,7 @@ void vtkF3DRenderer::SetUseRaytracingDenoiser(bool use)
   if (this->UseRaytracingDenoiser != use)
   {
     this->UseRaytracingDenoiser = use;
-    this->RenderPassesConfigured = false;
+    this->RaytracingConfigured = false;
     this->CheatSheetConfigured = false;
   }
 }
@@ -1304,12 +2281,29 @@ void vtkF3DRenderer::ShowTimer(bool show)
   if (this->TimerVisible != show)
   {
     this->TimerVisible = show;
-    this->TimerActor->SetVisibility(show);
+    this->TimerActor->SetVisibility(this->TimerVisible || this->FrameStatisticsVisible);
     this->RenderPassesConfigured = false;
     this->CheatSheetConfigured = false;
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkF3DRenderer::ShowFrameStatistics(bool show)
+{
+  if (this->FrameStatisticsVisible != show)
+  {
+    this->FrameStatisticsVisible = show;
+    this->TimerActor->SetVisibility(this->TimerVisible || this->FrameStatisticsVisible);
+    this->RenderPassesConfigured = false;
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkF3DFrameStatistics* vtkF3DRenderer::GetFrameStatistics()
+{
+  return this->FrameStatistics;
+}
+
 //----------------------------------------------------------------------------
 void vtkF3DRenderer::ShowFilename(bool show)
 {
@@ -1337,6 +2331,7 @@ void vtkF3DRenderer::ShowMetaData(bool show)
 //----------------------------------------------------------------------------
 void vtkF3DRenderer::ConfigureMetaData()
 {
+  F3D_TRACE_SCOPE("vtkF3DRenderer::ConfigureMetaData");
   this->MetaDataActor->SetVisibility(this->MetaDataVisible);
   if (this->MetaDataVisible)
   {
@@ -1361,6 +2356,7 @@ void vtkF3DRenderer::ShowCheatSheet(bool show)
 //----------------------------------------------------------------------------
 void vtkF3DRenderer::ConfigureCheatSheet()
 {
+  F3D_TRACE_SCOPE("vtkF3DRenderer::ConfigureCheatSheet");
   assert(this->Importer);
   if (this->CheatSheetVisible)
   {
@@ -1451,6 +2447,7 @@ void vtkF3DRenderer::ShowHDRISkybox(bool show)
     this->HDRIReaderConfigured = false;
     this->HDRITextureConfigured = false;
     this->HDRISkyboxConfigured = false;
+    this->HDRIPreprocessed = false;
     this->RenderPassesConfigured = false;
     this->CheatSheetConfigured = false;
   }
@@ -1520,6 +2517,7 @@ void vtkF3DRenderer::SetUseTrackball(bool use)
 //----------------------------------------------------------------------------
 void vtkF3DRenderer::UpdateActors()
 {
+  F3D_TRACE_SCOPE("vtkF3DRenderer::UpdateActors");
   assert(this->Importer);
 
   // Handle importer changes
@@ -1539,9 +2537,23 @@ void vtkF3DRenderer::UpdateActors()
     this->MetaDataConfigured = false;
     this->ActorsPropertiesConfigured = false;
     this->ColoringConfigured = false;
+    this->LODConfigured = false;
+    this->StaticBatchesConfigured = false;
   }
   this->ImporterTimeStamp = importerMTime;
 
+  if (this->UseLOD && !this->LODConfigured)
+  {
+    this->Importer->BuildLODProxies();
+    this->LODConfigured = true;
+  }
+
+  if (this->UseStaticBatching && !this->StaticBatchesConfigured)
+  {
+    this->Importer->BuildStaticBatches();
+    this->StaticBatchesConfigured = true;
+  }
+
   if (!this->ActorsPropertiesConfigured)
   {
     this->ConfigureActorsProperties();
@@ -1559,78 +2571,609 @@ void vtkF3DRenderer::UpdateActors()
     this->ConfigureMetaData();
   }
 
-  if (!this->TextActorsConfigured)
+  if (!this->TextActorsConfigured)
+  {
+    this->ConfigureTextActors();
+  }
+
+  if (!this->RenderPassesConfigured)
+  {
+    this->ConfigureRenderPasses();
+  }
+
+  if (!this->RaytracingConfigured)
+  {
+    this->ConfigureRaytracing();
+  }
+
+  // Grid need all actors setup to be configured correctly
+  if (!this->GridConfigured)
+  {
+    this->ConfigureGridUsingCurrentActors();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DRenderer::Render()
+{
+  F3D_TRACE_SCOPE("vtkF3DRenderer::Render");
+  if (!this->AdditionalViewCameras.empty() && !this->RenderingViews)
+  {
+    this->RenderViews();
+    return;
+  }
+
+  if (!this->CheatSheetConfigured)
+  {
+    this->ConfigureCheatSheet();
+  }
+
+  if (this->Importer)
+  {
+    this->Importer->UpdateTessellations(!this->UseAsyncTessellation);
+    if (!this->UseRaytracing && this->UseVolume && this->Importer->UpdateStreamedVolumes())
+    {
+      // The cropping of the empty space depends on the streamed bricks
+      this->VolumePropsAndMappersConfigured = false;
+      this->ConfigureColoring();
+    }
+  }
+  this->UpdateLODProxies();
+  this->UpdateTextureResidency();
+
+  // the blur of the skybox depends on the view angle and the size of the viewport
+  if (this->BlurredHDRILevel >= 0 && this->ComputeHDRIBlurLevel() != this->BlurredHDRILevel)
+  {
+    this->ConfigureHDRISkybox();
+  }
+
+  if (!this->TimerVisible && !this->FrameStatisticsVisible)
+  {
+    this->Superclass::Render();
+    return;
+  }
+
+  auto cpuStart = std::chrono::high_resolution_clock::now();
+  if (this->Timer == 0)
+  {
+    glGenQueries(1, &this->Timer);
+  }
+
+#if !defined(__ANDROID__) && !defined(__EMSCRIPTEN__)
+  glBeginQuery(GL_TIME_ELAPSED, this->Timer);
+#endif
+
+  this->Superclass::Render();
+
+  auto cpuElapsed = std::chrono::high_resolution_clock::now() - cpuStart;
+
+  // Get CPU frame per seconds
+  double cpuTime =
+    std::chrono::duration_cast<std::chrono::microseconds>(cpuElapsed).count() * 1e-3;
+  int fps = static_cast<int>(std::round(1.0 / (cpuTime * 1e-3)));
+  double gpuTime = -1.0;
+
+#if !defined(__ANDROID__) && !defined(__EMSCRIPTEN__)
+  glEndQuery(GL_TIME_ELAPSED);
+  GLuint64 elapsed;
+  glGetQueryObjectui64v(this->Timer, GL_QUERY_RESULT, &elapsed);
+  gpuTime = elapsed * 1e-6;
+
+  // Get min between CPU frame per seconds and GPU frame per seconds
+  fps = std::min(fps, static_cast<int>(std::round(1.0 / (elapsed * 1e-9))));
+#endif
+
+  // the frame is complete, so the timer passes queries can be read without stalling
+  this->FrameStatistics->EndFrame(cpuTime, gpuTime);
+
+  std::string str = std::to_string(fps);
+  str += " fps";
+  if (this->FrameStatisticsVisible)
+  {
+    str += "\n";
+    str += this->FrameStatistics->GetDescription();
+  }
+  this->TimerActor->SetInput(str);
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DRenderer::SetUseLOD(bool use)
+{
+  if (this->UseLOD != use)
+  {
+    this->UseLOD = use;
+    this->LODConfigured = false;
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DRenderer::SetLODFrameRate(double frameRate)
+{
+  this->LODFrameRate = frameRate;
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DRenderer::SetAdditionalViewCameras(
+  const std::vector<vtkSmartPointer<vtkCamera>>& cameras)
+{
+  this->AdditionalViewCameras = cameras;
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DRenderer::RenderViews()
+{
+  // each view renders the same props, only the camera and the viewport change
+  double viewport[4];
+  this->GetViewport(viewport);
+  vtkSmartPointer<vtkCamera> mainCamera = this->GetActiveCamera();
+
+  std::array<vtkProp*, 6> annotations = { this->FilenameActor, this->MetaDataActor,
+    this->CheatSheetActor, this->DropZoneActor, this->TimerActor, this->ScalarBarActor };
+  std::array<vtkTypeBool, 6> visibilities;
+  for (size_t i = 0; i < annotations.size(); i++)
+  {
+    visibilities[i] = annotations[i]->GetVisibility();
+  }
+
+  this->RenderingViews = true;
+  size_t nbViews = this->AdditionalViewCameras.size() + 1;
+  double width = (viewport[2] - viewport[0]) / nbViews;
+  for (size_t view = 0; view < nbViews; view++)
+  {
+    this->SetViewport(viewport[0] + view * width, viewport[1],
+      view + 1 == nbViews ? viewport[2] : viewport[0] + (view + 1) * width, viewport[3]);
+    if (view > 0)
+    {
+      vtkCamera* camera = this->AdditionalViewCameras[view - 1];
+      this->SetActiveCamera(camera);
+      this->ResetCameraClippingRange();
+      for (vtkProp* annotation : annotations)
+      {
+        annotation->VisibilityOff();
+      }
+    }
+    this->Render();
+  }
+  this->RenderingViews = false;
+
+  this->SetViewport(viewport);
+  this->SetActiveCamera(mainCamera);
+  for (size_t i = 0; i < annotations.size(); i++)
+  {
+    annotations[i]->SetVisibility(visibilities[i]);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DRenderer::SetTextureBudget(int budget)
+{
+  this->TextureBudget = budget;
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DRenderer::UpdateTextureResidency()
+{
+  if (this->TextureBudget <= 0 || !this->Importer)
+  {
+    // Restore the full resolution textures
+    for (auto& [tex, residency] : this->TextureResidencies)
+    {
+      if (residency.Level > 0)
+      {
+        residency.Texture->SetInputData(residency.Original);
+      }
+    }
+    this->TextureResidencies.clear();
+    return;
+  }
+
+  // The resolution is only raised when the camera settles
+  vtkRenderWindow* renWin = this->GetRenderWindow();
+  vtkRenderWindowInteractor* iren = renWin ? renWin->GetInteractor() : nullptr;
+  if (!renWin || (iren && renWin->GetDesiredUpdateRate() > iren->GetStillUpdateRate()))
+  {
+    return;
+  }
+
+  for (auto& [tex, residency] : this->TextureResidencies)
+  {
+    residency.Used = false;
+  }
+
+  // Gather the textures with the largest footprint of the visible actors using them
+  std::map<vtkTexture*, double> footprints;
+  vtkCamera* camera = this->GetActiveCamera();
+  const int* size = this->GetSize();
+  if (size[0] <= 0 || size[1] <= 0)
+  {
+    return;
+  }
+
+  for (const auto& [actor, mapper, originalActor] : this->Importer->GetColoringActorsAndMappers())
+  {
+    double footprint = 0.0;
+    if ((actor && actor->GetVisibility()) || originalActor->GetVisibility())
+    {
+      vtkActor* shown = actor ? actor.Get() : originalActor;
+      footprint = ::ComputeScreenFootprint(shown->GetBounds(), camera, size);
+    }
+
+    for (vtkActor* textured : std::initializer_list<vtkActor*>{ actor, originalActor })
+    {
+      if (!textured)
+      {
+        continue;
+      }
+      for (const auto& [name, tex] : textured->GetProperty()->GetAllTextures())
+      {
+        auto it = this->TextureResidencies.find(tex);
+        if (it == this->TextureResidencies.end())
+        {
+          vtkImageData* original = tex->GetImageDataInput(0);
+          if (!original)
+          {
+            continue;
+          }
+          it = this->TextureResidencies.emplace(tex, TextureResidency{ tex, original }).first;
+        }
+        it->second.Used = true;
+        footprints[tex] = std::max(footprints[tex], footprint);
+      }
+    }
+  }
+
+  // Forget the textures that are not used anymore, restoring their resolution since they can
+  // be shared with the next imports, see vtkF3DTextureCache
+  for (auto it = this->TextureResidencies.begin(); it != this->TextureResidencies.end();)
+  {
+    if (!it->second.Used && it->second.Level > 0)
+    {
+      it->second.Texture->SetInputData(it->second.Original);
+    }
+    it = it->second.Used ? std::next(it) : this->TextureResidencies.erase(it);
+  }
+
+  auto getSize = [](const TextureResidency& residency, int level)
+  {
+    int* dims = residency.Original->GetDimensions();
+    return static_cast<double>(std::max(dims[0] >> level, 1)) * std::max(dims[1] >> level, 1) *
+      residency.Original->GetNumberOfScalarComponents() * residency.Original->GetScalarSize();
+  };
+
+  auto getMaxLevel = [](const TextureResidency& residency)
+  {
+    int* dims = residency.Original->GetDimensions();
+    return static_cast<int>(std::floor(std::log2(std::max(std::min(dims[0], dims[1]), 1))));
+  };
+
+  // Each texture does not need more texels than the pixels it covers
+  std::map<vtkTexture*, int> levels;
+  double total = 0.0;
+  for (auto& [tex, residency] : this->TextureResidencies)
+  {
+    double texels = getSize(residency, 0) /
+      (residency.Original->GetNumberOfScalarComponents() * residency.Original->GetScalarSize());
+    int level = footprints[tex] > 0.0
+      ? static_cast<int>(std::floor(0.5 * std::log2(std::max(texels / footprints[tex], 1.0))))
+      : getMaxLevel(residency);
+    levels[tex] = std::min(level, getMaxLevel(residency));
+    total += getSize(residency, levels[tex]);
+  }
+
+  // Downsample the textures with the most texels per pixel on screen until the budget is met
+  const double budget = this->TextureBudget * 1024.0 * 1024.0;
+  while (total > budget)
+  {
+    vtkTexture* evicted = nullptr;
+    double lowestPriority = VTK_DOUBLE_MAX;
+    for (auto& [tex, residency] : this->TextureResidencies)
+    {
+      if (levels[tex] < getMaxLevel(residency))
+      {
+        double priority = footprints[tex] / getSize(residency, levels[tex]);
+        if (priority < lowestPriority)
+        {
+          lowestPriority = priority;
+          evicted = tex;
+        }
+      }
+    }
+
+    if (!evicted)
+    {
+      break;
+    }
+
+    const TextureResidency& residency = this->TextureResidencies[evicted];
+    total -= getSize(residency, levels[evicted]) - getSize(residency, levels[evicted] + 1);
+    levels[evicted]++;
+  }
+
+  for (auto& [tex, residency] : this->TextureResidencies)
+  {
+    int level = levels[tex];
+    if (level == residency.Level)
+    {
+      continue;
+    }
+
+    if (level == 0)
+    {
+      tex->SetInputData(residency.Original);
+    }
+    else
+    {
+      vtkNew<vtkImageShrink3D> shrink;
+      shrink->SetInputData(residency.Original);
+      shrink->SetShrinkFactors(1 << level, 1 << level, 1);
+      shrink->AveragingOn();
+      shrink->Update();
+      tex->SetInputData(shrink->GetOutput());
+    }
+    residency.Level = level;
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DRenderer::UpdateLODProxies()
+{
+  if (!this->Importer)
+  {
+    return;
+  }
+
+  std::vector<vtkF3DMetaImporter::LODStruct>& lods = this->Importer->GetLODActorsAndMappers();
+  if (lods.empty())
+  {
+    this->LODProxiesUsed = false;
+    return;
+  }
+
+  // The previous render tells if the full resolution reaches the target frame rate
+  if (!this->LODProxiesUsed)
+  {
+    this->FullRenderTime = this->GetLastRenderTimeInSeconds();
+  }
+
+  // The interactor style raises the desired update rate while interacting
+  vtkRenderWindow* renWin = this->GetRenderWindow();
+  vtkRenderWindowInteractor* iren = renWin ? renWin->GetInteractor() : nullptr;
+  bool interacting = iren && renWin->GetDesiredUpdateRate() > iren->GetStillUpdateRate();
+  bool useProxies = this->UseLOD && interacting && this->LODFrameRate > 0 &&
+    this->FullRenderTime > 1.0 / this->LODFrameRate;
+
+  for (vtkF3DMetaImporter::LODStruct& lod : lods)
+  {
+    if (!lod.ProxyReady && lod.Proxy.valid() &&
+      lod.Proxy.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+    {
+      lod.Proxy.get();
+      lod.ProxyReady = true;
+      lod.Mapper->SetInputData(lod.Decimator->GetOutput());
+      lod.Mapper->ScalarVisibilityOff();
+    }
+
+    bool proxyActive = lod.OriginalActor->GetMapper() == lod.Mapper;
+    if (useProxies && lod.ProxyReady && !proxyActive)
+    {
+      lod.FullMapper = lod.OriginalActor->GetMapper();
+      lod.OriginalActor->SetMapper(lod.Mapper);
+    }
+    else if (!useProxies && proxyActive)
+    {
+      lod.OriginalActor->SetMapper(lod.FullMapper);
+    }
+  }
+
+  this->LODProxiesUsed = useProxies;
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DRenderer::ResetCameraClippingRange()
+{
+  double bounds[6];
+  this->GetSceneBounds(bounds);
+
+  vtkCamera* camera = this->GetActiveCamera();
+
+  // the near and far planes of the frustum are the ones being computed, they are ignored
+  double planes[24];
+  camera->GetFrustumPlanes(this->GetTiledAspectRatio(), planes);
+  std::fill(planes + 16, planes + 24, 0.0);
+  planes[19] = planes[23] = 1.0;
+
+  // signed distances of the corners of the props in the frustum along the view direction
+  double position[3];
+  double direction[3];
+  camera->GetPosition(position);
+  camera->GetDirectionOfProjection(direction);
+  double range[2] = { VTK_DOUBLE_MAX, VTK_DOUBLE_MIN };
+  auto addBounds = [&](const double* b)
+  {
+    for (int i = 0; i < 8; i++)
+    {
+      double corner[3] = { b[i & 1], b[2 + ((i >> 1) & 1)], b[4 + ((i >> 2) & 1)] };
+      double distance = 0.0;
+      for (int k = 0; k < 3; k++)
+      {
+        distance += direction[k] * (corner[k] - position[k]);
+      }
+      range[0] = std::min(range[0], distance);
+      range[1] = std::max(range[1], distance);
+    }
+  };
+
+  this->SceneHierarchy.Traverse(planes, nullptr,
+    [&](int item) { addBounds(this->SceneHierarchy.GetItemBounds(item)); });
+
+  // the grid is not part of the scene bounds but must not be clipped
+  if (this->GridActor->GetVisibility() && !this->GridActor->GetUseBounds())
+  {
+    const double* gridBounds = this->GridActor->GetBounds();
+    if (gridBounds && vtkMath::AreBoundsInitialized(gridBounds))
+    {
+      addBounds(gridBounds);
+    }
+  }
+
+  // nothing in the frustum, or in front of the camera, use the whole scene
+  if (range[1] <= 0.0)
   {
-    this->ConfigureTextActors();
+    if (vtkMath::AreBoundsInitialized(bounds))
+    {
+      this->Superclass::ResetCameraClippingRange(bounds);
+    }
+    return;
   }
 
-  if (!this->RenderPassesConfigured)
+  // same margins as vtkRenderer::ResetCameraClippingRange, that does not cull the props
+  double minGap = camera->GetParallelProjection()
+    ? 0.2 * camera->GetParallelScale()
+    : 0.2 * std::tan(vtkMath::RadiansFromDegrees(camera->GetViewAngle()) / 2.0) * range[1];
+  if (range[1] - range[0] < minGap)
   {
-    this->ConfigureRenderPasses();
+    minGap = minGap - range[1] + range[0];
+    range[1] += minGap / 2.0;
+    range[0] -= minGap / 2.0;
   }
 
-  // Grid need all actors setup to be configured correctly
-  if (!this->GridConfigured)
+  range[0] = std::max(range[0], 0.0);
+  range[0] = 0.99 * range[0] - (range[1] - range[0]) * this->ClippingRangeExpansion;
+  range[1] = 1.01 * range[1] + (range[1] - range[0]) * this->ClippingRangeExpansion;
+  range[0] = range[0] >= range[1] ? 0.01 * range[1] : range[0];
+
+  if (this->NearClippingPlaneTolerance == 0)
   {
-    this->ConfigureGridUsingCurrentActors();
+    this->NearClippingPlaneTolerance = 0.01;
+    if (this->RenderWindow && this->RenderWindow->GetDepthBufferSize() > 16)
+    {
+      this->NearClippingPlaneTolerance = 0.001;
+    }
   }
+  range[0] = std::max(range[0], this->NearClippingPlaneTolerance * range[1]);
+
+  camera->SetClippingRange(range);
 }
 
 //----------------------------------------------------------------------------
-void vtkF3DRenderer::Render()
+void vtkF3DRenderer::SetPlaceholderBounds(const double* bounds)
 {
-  if (!this->CheatSheetConfigured)
+  if (bounds)
   {
-    this->ConfigureCheatSheet();
+    std::array<double, 6> placeholder;
+    std::copy(bounds, bounds + 6, placeholder.begin());
+    this->PlaceholderBounds = placeholder;
   }
-
-  if (!this->TimerVisible)
+  else if (this->PlaceholderBounds.has_value())
   {
-    this->Superclass::Render();
-    return;
+    this->PlaceholderBounds.reset();
   }
-
-  auto cpuStart = std::chrono::high_resolution_clock::now();
-  if (this->Timer == 0)
+  else
   {
-    glGenQueries(1, &this->Timer);
+    return;
   }
 
-#if !defined(__ANDROID__) && !defined(__EMSCRIPTEN__)
-  glBeginQuery(GL_TIME_ELAPSED, this->Timer);
-#endif
-
-  this->TimerActor->RenderOpaqueGeometry(this); // update texture
+  // the scene bounds and the grid are computed again
+  this->PropsVisibilityTime.Modified();
+  this->GridConfigured = false;
+}
 
-  this->Superclass::Render();
+//----------------------------------------------------------------------------
+void vtkF3DRenderer::GetSceneBounds(double bounds[6])
+{
+  const vtkMTimeType importerTime = this->Importer ? this->Importer->GetUpdateMTime() : 0;
+  const int nbProps = this->GetViewProps()->GetNumberOfItems();
+  const vtkMTimeType outdatedTime = std::max(importerTime, this->PropsVisibilityTime.GetMTime());
+  if (this->SceneBoundsTime.GetMTime() < outdatedTime || this->SceneBoundsNumberOfProps != nbProps)
+  {
+    // the bounds of the time values are outdated when the props or their data change,
+    // not when updating them at another time value
+    const vtkMTimeType propsTime = std::max(
+      this->Importer ? this->Importer->GetDataMTime() : 0, this->PropsVisibilityTime.GetMTime());
+    if (this->TimeStepsBoundsTime.GetMTime() < propsTime ||
+      this->TimeStepsBoundsNumberOfProps != nbProps)
+    {
+      this->TimeStepsBounds.clear();
+      this->TimeStepsBoundsSize = 0;
+      this->TimelineBounds.Reset();
+      this->TimeStepsBoundsNumberOfProps = nbProps;
+      this->TimeStepsBoundsTime.Modified();
+    }
 
-  auto cpuElapsed = std::chrono::high_resolution_clock::now() - cpuStart;
+    double timeValue = 0.0;
+    const bool timeStep = this->Importer && this->Importer->GetUpdatedTimeValue(timeValue);
+    auto cached = timeStep ? this->TimeStepsBounds.find(timeValue) : this->TimeStepsBounds.end();
+    if (cached != this->TimeStepsBounds.end())
+    {
+      std::copy(cached->second.Bounds.begin(), cached->second.Bounds.end(), this->SceneBounds);
+      this->SceneHierarchy.Update(cached->second.PropsBounds);
+      this->SceneBoundsTime.Modified();
+      std::copy(this->SceneBounds, this->SceneBounds + 6, bounds);
+      return;
+    }
 
-  // Get CPU frame per seconds
-  int fps = static_cast<int>(std::round(
-    1.0 / (std::chrono::duration_cast<std::chrono::microseconds>(cpuElapsed).count() * 1e-6)));
+    // same props as vtkRenderer::ComputeVisiblePropBounds
+    std::vector<double> propsBounds;
+    vtkBoundingBox bbox;
+    vtkCollectionSimpleIterator pit;
+    vtkPropCollection* props = this->GetViewProps();
+    props->InitTraversal(pit);
+    while (vtkProp* prop = props->GetNextProp(pit))
+    {
+      if (!prop->GetVisibility() || !prop->GetUseBounds())
+      {
+        continue;
+      }
 
-#if !defined(__ANDROID__) && !defined(__EMSCRIPTEN__)
-  glEndQuery(GL_TIME_ELAPSED);
-  GLint elapsed;
-  glGetQueryObjectiv(this->Timer, GL_QUERY_RESULT, &elapsed);
+      const double* propBounds = prop->GetBounds();
+      if (propBounds && vtkMath::AreBoundsInitialized(propBounds) &&
+        propBounds[0] > -VTK_DOUBLE_MAX && propBounds[1] < VTK_DOUBLE_MAX &&
+        propBounds[2] > -VTK_DOUBLE_MAX && propBounds[3] < VTK_DOUBLE_MAX &&
+        propBounds[4] > -VTK_DOUBLE_MAX && propBounds[5] < VTK_DOUBLE_MAX)
+      {
+        bbox.AddBounds(propBounds);
+        propsBounds.insert(propsBounds.end(), propBounds, propBounds + 6);
+      }
+    }
 
-  // Get min between CPU frame per seconds and GPU frame per seconds
-  fps = std::min(fps, static_cast<int>(std::round(1.0 / (elapsed * 1e-9))));
-#endif
+    if (!bbox.IsValid() && this->PlaceholderBounds.has_value())
+    {
+      bbox.SetBounds(this->PlaceholderBounds->data());
+    }
 
-  std::string str = std::to_string(fps);
-  str += " fps";
-  this->TimerActor->SetInput(str.c_str());
-}
+    if (bbox.IsValid())
+    {
+      bbox.GetBounds(this->SceneBounds);
+    }
+    else
+    {
+      vtkMath::UninitializeBounds(this->SceneBounds);
+    }
 
-//----------------------------------------------------------------------------
-void vtkF3DRenderer::ResetCameraClippingRange()
-{
-  const bool gridUseBounds = this->GridActor->GetUseBounds();
-  this->GridActor->UseBoundsOn();
-  this->Superclass::ResetCameraClippingRange();
-  this->GridActor->SetUseBounds(gridUseBounds);
+    // the props bounds of each time value are kept within a budget, for long animations of
+    // many props, and the grid is placed again when the animation goes beyond its bounds
+    constexpr size_t timeStepsBoundsBudget = 1 << 22;
+    if (timeStep && !propsBounds.empty() &&
+      this->TimeStepsBoundsSize + propsBounds.size() <= timeStepsBoundsBudget)
+    {
+      TimeStepBounds& timeStepBounds = this->TimeStepsBounds[timeValue];
+      std::copy(this->SceneBounds, this->SceneBounds + 6, timeStepBounds.Bounds.begin());
+      timeStepBounds.PropsBounds = propsBounds;
+      this->TimeStepsBoundsSize += propsBounds.size();
+
+      const vtkBoundingBox previousTimelineBounds = this->TimelineBounds;
+      this->TimelineBounds.AddBounds(this->SceneBounds);
+      if (previousTimelineBounds.IsValid() && previousTimelineBounds != this->TimelineBounds)
+      {
+        this->GridConfigured = false;
+      }
+    }
+    this->SceneHierarchy.Update(std::move(propsBounds));
+    this->SceneBoundsNumberOfProps = nbProps;
+    this->SceneBoundsTime.Modified();
+  }
+  std::copy(this->SceneBounds, this->SceneBounds + 6, bounds);
 }
 
 //----------------------------------------------------------------------------
@@ -1870,6 +3413,7 @@ void vtkF3DRenderer::SetTextureNormal(const std::optional<std::string>& tex)
 //----------------------------------------------------------------------------
 void vtkF3DRenderer::ConfigureActorsProperties()
 {
+  F3D_TRACE_SCOPE("vtkF3DRenderer::ConfigureActorsProperties");
   assert(this->Importer);
 
   double* surfaceColor = nullptr;
@@ -1920,109 +3464,122 @@ void vtkF3DRenderer::ConfigureActorsProperties()
     }
   }
 
-  for ([[maybe_unused]] const auto& [actor, mapper, originalActor] : this->Importer->GetColoringActorsAndMappers())
+  // Textures are decoded in parallel once and shared by all actors
+  std::vector<vtkSmartPointer<vtkTexture>> textures =
+    ::GetTextures({ { this->TextureBaseColor, true }, { this->TextureMaterial, false },
+      { this->TextureEmissive, true }, { this->TextureNormal, false },
+      { this->TextureMatCap, false } });
+  const vtkSmartPointer<vtkTexture>& colorTex = textures[0];
+  const vtkSmartPointer<vtkTexture>& matTex = textures[1];
+  const vtkSmartPointer<vtkTexture>& emissTex = textures[2];
+  const vtkSmartPointer<vtkTexture>& normTex = textures[3];
+  const vtkSmartPointer<vtkTexture>& matCapTex = textures[4];
+
+  // the coloring actors are only created once shown, see ConfigureColoring
+  for (const auto& coloring : this->Importer->GetColoringActorsAndMappers())
   {
-    if (this->EdgeVisible.has_value())
+    for (vtkActor* actor : std::initializer_list<vtkActor*>{ coloring.OriginalActor,
+           coloring.Actor })
     {
-      actor->GetProperty()->SetEdgeVisibility(this->EdgeVisible.value());
-      originalActor->GetProperty()->SetEdgeVisibility(this->EdgeVisible.value());
-    }
+      if (!actor)
+      {
+        continue;
+      }
 
-    if (this->LineWidth.has_value())
-    {
-      actor->GetProperty()->SetLineWidth(this->LineWidth.value());
-      originalActor->GetProperty()->SetLineWidth(this->LineWidth.value());
-    }
+      vtkF3DPolyDataMapper* f3dMapper = vtkF3DPolyDataMapper::SafeDownCast(actor->GetMapper());
+      if (this->EdgeVisible.has_value())
+      {
+        // triangle meshes draw their edges in the surface pass instead of an additional line pass
+        bool surfaceEdges =
+          this->EdgeVisible.value() && f3dMapper && f3dMapper->SupportsSurfaceEdges();
+        if (f3dMapper)
+        {
+          f3dMapper->SetSurfaceEdges(surfaceEdges);
+        }
+        actor->GetProperty()->SetEdgeVisibility(this->EdgeVisible.value() && !surfaceEdges);
+      }
 
-    if (this->PointSize.has_value())
-    {
-      actor->GetProperty()->SetPointSize(this->PointSize.value());
-      originalActor->GetProperty()->SetPointSize(this->PointSize.value());
-    }
+      if (f3dMapper)
+      {
+        f3dMapper->SetCompactVertices(this->UseCompactVertices);
+      }
 
-    if (setBackfaceCulling)
-    {
-      actor->GetProperty()->SetBackfaceCulling(backfaceCulling);
-      originalActor->GetProperty()->SetBackfaceCulling(backfaceCulling);
-    }
+      if (this->LineWidth.has_value())
+      {
+        actor->GetProperty()->SetLineWidth(this->LineWidth.value());
+      }
 
-    if(surfaceColor)
-    {
-      actor->GetProperty()->SetColor(surfaceColor);
-      originalActor->GetProperty()->SetColor(surfaceColor);
-    }
+      if (this->PointSize.has_value())
+      {
+        actor->GetProperty()->SetPointSize(this->PointSize.value());
+      }
 
-    if (this->Opacity.has_value())
-    {
-      actor->GetProperty()->SetOpacity(this->Opacity.value());
-      originalActor->GetProperty()->SetOpacity(this->Opacity.value());
-    }
+      if (setBackfaceCulling)
+      {
+        actor->GetProperty()->SetBackfaceCulling(backfaceCulling);
+      }
 
-    if (this->Roughness.has_value())
-    {
-      actor->GetProperty()->SetRoughness(this->Roughness.value());
-      originalActor->GetProperty()->SetRoughness(this->Roughness.value());
-    }
+      if(surfaceColor)
+      {
+        actor->GetProperty()->SetColor(surfaceColor);
+      }
 
-    if (this->Metallic.has_value())
-    {
-      actor->GetProperty()->SetMetallic(this->Metallic.value());
-      originalActor->GetProperty()->SetMetallic(this->Metallic.value());
-    }
+      if (this->Opacity.has_value())
+      {
+        actor->GetProperty()->SetOpacity(this->Opacity.value());
+      }
 
-    // Textures
-    if (this->TextureBaseColor.has_value())
-    {
-      auto colorTex = ::GetTexture(this->TextureBaseColor.value(), true);
-      actor->GetProperty()->SetBaseColorTexture(colorTex);
-      originalActor->GetProperty()->SetBaseColorTexture(colorTex);
+      if (this->Roughness.has_value())
+      {
+        actor->GetProperty()->SetRoughness(this->Roughness.value());
+      }
 
-      // If the input texture is RGBA, flag the actor as translucent
-      if (colorTex && colorTex->GetImageDataInput(0)->GetNumberOfScalarComponents() == 4)
+      if (this->Metallic.has_value())
       {
-        actor->ForceTranslucentOn();
-        originalActor->ForceTranslucentOn();
+        actor->GetProperty()->SetMetallic(this->Metallic.value());
       }
-    }
 
-    if (this->TextureMaterial.has_value())
-    {
-      auto matTex = ::GetTexture(this->TextureMaterial.value());
-      actor->GetProperty()->SetORMTexture(matTex);
-      originalActor->GetProperty()->SetORMTexture(matTex);
-    }
+      // Textures
+      if (this->TextureBaseColor.has_value())
+      {
+        actor->GetProperty()->SetBaseColorTexture(colorTex);
 
-    if (this->TextureEmissive.has_value())
-    {
-      auto emissTex = ::GetTexture(this->TextureEmissive.value(), true);
-      actor->GetProperty()->SetEmissiveTexture(emissTex);
-      originalActor->GetProperty()->SetEmissiveTexture(emissTex);
-    }
+        // If the input texture is RGBA, flag the actor as translucent
+        if (colorTex && colorTex->GetImageDataInput(0)->GetNumberOfScalarComponents() == 4)
+        {
+          actor->ForceTranslucentOn();
+        }
+      }
 
-    if (emissiveFactor)
-    {
-      actor->GetProperty()->SetEmissiveFactor(emissiveFactor);
-      originalActor->GetProperty()->SetEmissiveFactor(emissiveFactor);
-    }
+      if (this->TextureMaterial.has_value())
+      {
+        actor->GetProperty()->SetORMTexture(matTex);
+      }
 
-    if (this->TextureNormal.has_value())
-    {
-      auto normTex = ::GetTexture(this->TextureNormal.value());
-      actor->GetProperty()->SetNormalTexture(normTex);
-      originalActor->GetProperty()->SetNormalTexture(normTex);
-    }
+      if (this->TextureEmissive.has_value())
+      {
+        actor->GetProperty()->SetEmissiveTexture(emissTex);
+      }
 
-    if (this->NormalScale.has_value())
-    {
-      actor->GetProperty()->SetNormalScale(this->NormalScale.value());
-      originalActor->GetProperty()->SetNormalScale(this->NormalScale.value());
-    }
+      if (emissiveFactor)
+      {
+        actor->GetProperty()->SetEmissiveFactor(emissiveFactor);
+      }
 
-    if (this->TextureMatCap.has_value())
-    {
-      auto matCapTex = ::GetTexture(this->TextureMatCap.value());
-      actor->GetProperty()->SetTexture("matcap", matCapTex);
-      originalActor->GetProperty()->SetTexture("matcap", matCapTex);
+      if (this->TextureNormal.has_value())
+      {
+        actor->GetProperty()->SetNormalTexture(normTex);
+      }
+
+      if (this->NormalScale.has_value())
+      {
+        actor->GetProperty()->SetNormalScale(this->NormalScale.value());
+      }
+
+      if (this->TextureMatCap.has_value())
+      {
+        actor->GetProperty()->SetTexture("matcap", matCapTex);
+      }
     }
   }
 
@@ -2043,10 +3600,16 @@ void vtkF3DRenderer::ConfigureActorsProperties()
 }
 
 //----------------------------------------------------------------------------
-void vtkF3DRenderer::SetPointSpritesProperties(SplatType type, double pointSpritesSize)
+void vtkF3DRenderer::SetPointSpritesProperties(
+  SplatType type, double pointSpritesSize, int sortBudget, bool instancing)
 {
   assert(this->Importer);
 
+  this->PointSpritesType = type;
+  this->PointSpritesSize = pointSpritesSize;
+  this->PointSpritesSortBudget = sortBudget;
+  this->PointSpritesInstancing = instancing;
+
   if (type == SplatType::GAUSSIAN)
   {
 #if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20231102)
@@ -2059,16 +3622,37 @@ void vtkF3DRenderer::SetPointSpritesProperties(SplatType type, double pointSprit
 #endif
   }
 
+  this->ConfigurePointSpritesProperties();
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DRenderer::ConfigurePointSpritesProperties()
+{
+  const SplatType type = this->PointSpritesType;
+  const int sortBudget = this->PointSpritesSortBudget;
+  const bool instancing = this->PointSpritesInstancing;
   const vtkBoundingBox& bbox = this->Importer->GetGeometryBoundingBox();
 
   double scaleFactor = 1.0;
   if (bbox.IsValid())
   {
-    scaleFactor = pointSpritesSize * bbox.GetDiagonalLength() * 0.001;
+    scaleFactor = this->PointSpritesSize * bbox.GetDiagonalLength() * 0.001;
   }
 
   for (const auto& [actor, mapper] : this->Importer->GetPointSpritesActorsAndMappers())
   {
+#if !defined(__ANDROID__) && !defined(__EMSCRIPTEN__) &&                                           \
+  VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240203)
+    vtkF3DPointSplatMapper* splatMapper = vtkF3DPointSplatMapper::SafeDownCast(mapper);
+    if (splatMapper)
+    {
+      splatMapper->SetSortBudget(sortBudget);
+      splatMapper->SetInstancing(instancing);
+    }
+#else
+    (void)sortBudget;
+    (void)instancing;
+#endif
 
     mapper->EmissiveOff();
     if (type == SplatType::GAUSSIAN)
@@ -2159,7 +3743,8 @@ void vtkF3DRenderer::SetUseInverseOpacityFunction(bool use)
   if (this->UseInverseOpacityFunction != use)
   {
     this->UseInverseOpacityFunction = use;
-    for ([[maybe_unused]] const auto& [prop, mapper] : this->Importer->GetVolumePropsAndMappers())
+    for ([[maybe_unused]] const auto& [prop, mapper, quantizer] :
+      this->Importer->GetVolumePropsAndMappers())
     {
       if (prop)
       {
@@ -2181,6 +3766,28 @@ void vtkF3DRenderer::SetUseInverseOpacityFunction(bool use)
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkF3DRenderer::SetVolumePrecision(const std::string& precision)
+{
+  if (this->VolumePrecision != precision)
+  {
+    this->VolumePrecision = precision;
+    this->VolumePropsAndMappersConfigured = false;
+    this->ColoringConfigured = false;
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DRenderer::SetUseVolumePreIntegration(bool use)
+{
+  if (this->UseVolumePreIntegration != use)
+  {
+    this->UseVolumePreIntegration = use;
+    this->VolumePropsAndMappersConfigured = false;
+    this->ColoringConfigured = false;
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkF3DRenderer::SetScalarBarRange(const std::optional<std::vector<double>>& range)
 {
@@ -2278,9 +3885,22 @@ void vtkF3DRenderer::SetComponentForColoring(int component)
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkF3DRenderer::SetUseGPUColoring(bool use)
+{
+  if (use != this->UseGPUColoring)
+  {
+    this->UseGPUColoring = use;
+    this->ColoringMappersConfigured = false;
+    this->PointSpritesMappersConfigured = false;
+    this->ColoringConfigured = false;
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkF3DRenderer::ConfigureColoring()
 {
+  F3D_TRACE_SCOPE("vtkF3DRenderer::ConfigureColoring");
   assert(this->Importer);
 
   // Recover coloring information and update handler
@@ -2288,36 +3908,72 @@ void vtkF3DRenderer::ConfigureColoring()
   F3DColoringInfoHandler& coloringHandler = this->Importer->GetColoringInfoHandler();
   auto info = coloringHandler.SetCurrentColoring(enableColoring, this->UseCellColoring, this->ArrayNameForColoring, false);
   bool hasColoring = info.has_value();
+
+  // Only the colored array needs to be read when updating time steps
+  this->Importer->SelectArrayForColoring(hasColoring ? info.value().Name : "");
   if (hasColoring && !this->ColorTransferFunctionConfigured)
   {
     this->ConfigureRangeAndCTFForColoring(info.value());
     this->ColorTransferFunctionConfigured = true;
   }
 
-  // Handle surface geometry
+  // The props showing the imported actors differently are only created once shown,
+  // so they are configured the first time they are shown
   bool geometriesVisible = this->UseRaytracing || (!this->UseVolume && !this->UsePointSprites);
+  bool pointSpritesVisible = !this->UseRaytracing && !this->UseVolume && this->UsePointSprites;
+  bool volumeVisible = !this->UseRaytracing && this->UseVolume;
+  bool actorsCreated = false;
+  if (hasColoring && geometriesVisible && this->Importer->CreateColoringActors())
+  {
+    this->ColoringMappersConfigured = false;
+    actorsCreated = true;
+  }
+  if (pointSpritesVisible && this->Importer->CreatePointSprites())
+  {
+    this->PointSpritesMappersConfigured = false;
+    this->ConfigurePointSpritesProperties();
+    actorsCreated = true;
+  }
+  if (volumeVisible && this->Importer->CreateVolumes())
+  {
+    this->VolumePropsAndMappersConfigured = false;
+  }
+  if (actorsCreated)
+  {
+    this->ConfigureActorsProperties();
+  }
+
+  // Handle surface geometry
   for (const auto& [actor, mapper, originalActor] : this->Importer->GetColoringActorsAndMappers())
   {
     if (geometriesVisible)
     {
       bool visible = false;
-      if (hasColoring)
+      if (hasColoring && actor)
       {
         // Rely on the previous state of scalar visibility to know if we should show the actor by default
-        visible = mapper->GetScalarVisibility();
+        F3DShaderColoring* shaderColoring = ::GetShaderColoring(mapper);
+        visible = mapper->GetScalarVisibility() || (shaderColoring && shaderColoring->GetArray());
         if (!this->ColoringMappersConfigured)
         {
+          ::SetShaderColoringEnabled(mapper, this->UseGPUColoring);
           visible = vtkF3DRenderer::ConfigureMapperForColoring(mapper, info.value().Name,
             this->ComponentForColoring, this->ColorTransferFunction, this->ColorRange,
             this->UseCellColoring);
         }
       }
-      actor->SetVisibility(visible);
+      if (actor)
+      {
+        actor->SetVisibility(visible);
+      }
       originalActor->SetVisibility(!visible);
     }
     else
     {
-      actor->SetVisibility(false);
+      if (actor)
+      {
+        actor->SetVisibility(false);
+      }
       originalActor->SetVisibility(false);
     }
   }
@@ -2326,23 +3982,46 @@ void vtkF3DRenderer::ConfigureColoring()
     this->ColoringMappersConfigured = true;
   }
 
+  // Replace the original actors by their batch when they are all shown as imported
+  for (const auto& batch : this->Importer->GetStaticBatches())
+  {
+    bool batchVisible = this->UseStaticBatching &&
+      std::all_of(batch.OriginalActors.begin(), batch.OriginalActors.end(),
+        [](vtkActor* actor) { return actor->GetVisibility(); });
+    batch.Actor->SetVisibility(batchVisible);
+    if (batchVisible)
+    {
+      for (vtkActor* actor : batch.OriginalActors)
+      {
+        actor->VisibilityOff();
+      }
+    }
+  }
+
   // Handle point sprites
-  bool pointSpritesVisible = !this->UseRaytracing && !this->UseVolume && this->UsePointSprites;
   for (const auto& [actor, mapper] : this->Importer->GetPointSpritesActorsAndMappers())
   {
     actor->SetVisibility(pointSpritesVisible);
     if (pointSpritesVisible)
     {
+      F3DShaderColoring* shaderColoring = ::GetShaderColoring(mapper);
       if (hasColoring)
       {
         if (!this->PointSpritesMappersConfigured)
         {
+          ::SetShaderColoringEnabled(mapper, this->UseGPUColoring);
           vtkF3DRenderer::ConfigureMapperForColoring(mapper, info.value().Name,
             this->ComponentForColoring, this->ColorTransferFunction, this->ColorRange,
             this->UseCellColoring);
         }
       }
-      mapper->SetScalarVisibility(hasColoring);
+      else if (shaderColoring && shaderColoring->SetArray(nullptr, nullptr, nullptr))
+      {
+        mapper->Modified();
+      }
+
+      // the scalars mapped in the shaders are not mapped by VTK
+      mapper->SetScalarVisibility(hasColoring && !(shaderColoring && shaderColoring->GetArray()));
     }
   }
   if (pointSpritesVisible)
@@ -2351,9 +4030,25 @@ void vtkF3DRenderer::ConfigureColoring()
   }
 
   // Handle Volume prop
-  bool volumeVisible = !this->UseRaytracing && this->UseVolume;
+  int quantizedType = VTK_VOID;
+  if (volumeVisible && !this->VolumePropsAndMappersConfigured)
+  {
+    if (this->VolumePrecision == "16bit")
+    {
+      quantizedType = VTK_UNSIGNED_SHORT;
+    }
+    else if (this->VolumePrecision == "8bit")
+    {
+      quantizedType = VTK_UNSIGNED_CHAR;
+    }
+    else if (this->VolumePrecision != "native")
+    {
+      F3DLog::Print(F3DLog::Severity::Warning,
+        this->VolumePrecision + " is not a valid volume precision, using native");
+    }
+  }
   const auto& volPropsAndMappers = this->Importer->GetVolumePropsAndMappers();
-  for (const auto& [prop, mapper] : volPropsAndMappers)
+  for (const auto& [prop, mapper, quantizer] : volPropsAndMappers)
   {
     if (!volumeVisible)
     {
@@ -2371,7 +4066,8 @@ void vtkF3DRenderer::ConfigureColoring()
           visible = vtkF3DRenderer::ConfigureVolumeForColoring(mapper,
             prop, info.value().Name, this->ComponentForColoring,
             this->ColorTransferFunction, this->ColorRange, this->UseCellColoring,
-            this->UseInverseOpacityFunction);
+            this->UseInverseOpacityFunction, quantizer, quantizedType,
+            this->UseVolumePreIntegration);
           if (!visible)
           {
             F3DLog::Print(
@@ -2402,6 +4098,9 @@ void vtkF3DRenderer::ConfigureColoring()
     this->ScalarBarActorConfigured = true;
   }
 
+  // the visible props changed, the cached scene bounds are outdated
+  this->PropsVisibilityTime.Modified();
+
   this->RenderPassesConfigured = false;
   this->ColoringConfigured = true;
 }
@@ -2434,12 +4133,30 @@ bool vtkF3DRenderer::ConfigureMapperForColoring(vtkPolyDataMapper* mapper, const
     static_cast<vtkDataSetAttributes*>(mapper->GetInput()->GetCellData()) :
     static_cast<vtkDataSetAttributes*>(mapper->GetInput()->GetPointData());
   vtkDataArray* array = data->GetArray(name.c_str());
+  F3DShaderColoring* shaderColoring = ::GetShaderColoring(mapper);
+  if (shaderColoring && shaderColoring->SetArray(nullptr, nullptr, nullptr))
+  {
+    mapper->Modified();
+  }
   if (!array || component >= array->GetNumberOfComponents())
   {
     mapper->ScalarVisibilityOff();
     return false;
   }
 
+  // the raw point scalars are uploaded once and mapped in the shaders, so changing the range
+  // or the colormap only updates uniforms and a small texture.
+  // Direct scalars and cell scalars are still mapped by VTK.
+  if (shaderColoring && shaderColoring->GetEnabled() && !cellFlag && component != -2)
+  {
+    mapper->ScalarVisibilityOff();
+    if (shaderColoring->SetArray(array, ctf, range))
+    {
+      mapper->Modified();
+    }
+    return true;
+  }
+
   mapper->SetColorModeToMapScalars();
   mapper->SelectColorArray(name.c_str());
   mapper->SetScalarMode(
@@ -2472,11 +4189,21 @@ bool vtkF3DRenderer::ConfigureMapperForColoring(vtkPolyDataMapper* mapper, const
 //----------------------------------------------------------------------------
 bool vtkF3DRenderer::ConfigureVolumeForColoring(vtkSmartVolumeMapper* mapper,
   vtkVolume* volume, const std::string& name, int component, vtkColorTransferFunction* ctf,
-  double range[2], bool cellFlag, bool inverseOpacityFlag)
+  double range[2], bool cellFlag, bool inverseOpacityFlag, vtkF3DQuantizeImageFilter* quantizer,
+  int quantizedType, bool preIntegrationFlag)
 {
+  // The mapper may render the output of the quantizer, the arrays are looked up in its input
+  vtkImageData* image = vtkImageData::SafeDownCast(
+    quantizer ? quantizer->GetInputDataObject(0, 0) : mapper->GetInputDataObject(0, 0));
+  if (quantizer && image)
+  {
+    mapper->SetInputData(image);
+  }
+
+  vtkDataSet* input = image ? image : mapper->GetInput();
   vtkDataSetAttributes* data = cellFlag ?
-    static_cast<vtkDataSetAttributes*>(mapper->GetInput()->GetCellData()) :
-    static_cast<vtkDataSetAttributes*>(mapper->GetInput()->GetPointData());
+    static_cast<vtkDataSetAttributes*>(input->GetCellData()) :
+    static_cast<vtkDataSetAttributes*>(input->GetPointData());
   vtkDataArray* array = data->GetArray(name.c_str());
   if (!array || component >= array->GetNumberOfComponents())
   {
@@ -2513,17 +4240,85 @@ bool vtkF3DRenderer::ConfigureVolumeForColoring(vtkSmartVolumeMapper* mapper,
     }
   }
 
+  // Upload the quantized component, or magnitude, with the functions rescaled to its range
+  double functionRange[2] = { range[0], range[1] };
+  vtkSmartPointer<vtkColorTransferFunction> colorFunction = ctf;
+  bool quantized = quantizer && image && component != -2 && range[1] > range[0] &&
+    (quantizedType == VTK_UNSIGNED_SHORT || quantizedType == VTK_UNSIGNED_CHAR);
+  if (quantized)
+  {
+    quantizer->SetInputArrayToProcess(0, 0, 0,
+      cellFlag ? vtkDataObject::FIELD_ASSOCIATION_CELLS : vtkDataObject::FIELD_ASSOCIATION_POINTS,
+      name.c_str());
+    quantizer->SetComponent(component);
+    quantizer->SetScalarRange(range);
+    quantizer->SetOutputScalarType(quantizedType);
+    quantizer->GetOutputRange(functionRange);
+    mapper->SetInputConnection(quantizer->GetOutputPort());
+    mapper->SetVectorMode(vtkSmartVolumeMapper::DISABLED);
+    colorFunction = ::RescaleColorTransferFunction(ctf, range, functionRange);
+  }
+
   vtkNew<vtkPiecewiseFunction> otf;
-  otf->AddPoint(range[0], inverseOpacityFlag ? 1.0 : 0.0);
-  otf->AddPoint(range[1], inverseOpacityFlag ? 0.0 : 1.0);
+  otf->AddPoint(functionRange[0], inverseOpacityFlag ? 1.0 : 0.0);
+  otf->AddPoint(functionRange[1], inverseOpacityFlag ? 0.0 : 1.0);
 
   vtkNew<vtkVolumeProperty> property;
-  property->SetColor(ctf);
+  property->SetColor(colorFunction);
   property->SetScalarOpacity(otf);
   property->ShadeOff();
   property->SetInterpolationTypeToLinear();
 
+  // The 2D transfer function covers the range of the uploaded scalars, like the 1D ones, and
+  // the segments between the samples are integrated so the sample distance can be the spacing
+  bool preIntegrated = preIntegrationFlag && image && component != -2;
+  if (preIntegrated)
+  {
+    double dataRange[2];
+    if (quantized)
+    {
+      quantizer->Update();
+      vtkImageData* output = quantizer->GetOutput();
+      vtkDataSetAttributes* outputData = cellFlag
+        ? static_cast<vtkDataSetAttributes*>(output->GetCellData())
+        : static_cast<vtkDataSetAttributes*>(output->GetPointData());
+      outputData->GetScalars()->GetRange(dataRange, 0);
+    }
+    else
+    {
+      array->GetRange(dataRange, component);
+    }
+
+    double* spacing = image->GetSpacing();
+    double sampleDistance = std::min({ spacing[0], spacing[1], spacing[2] });
+    property->SetTransferFunction2D(vtkF3DPreIntegrationTable::Compute(colorFunction, otf,
+      dataRange, sampleDistance, property->GetScalarOpacityUnitDistance()));
+    property->SetTransferFunctionMode(vtkVolumeProperty::TF_2D);
+    mapper->SetAutoAdjustSampleDistances(false);
+    mapper->SetSampleDistance(static_cast<float>(sampleDistance));
+  }
+  else
+  {
+    mapper->SetAutoAdjustSampleDistances(true);
+    mapper->SetSampleDistance(-1.0f);
+  }
+  vtkF3DPreIntegrationTable::SetVolumeShading(volume, preIntegrated);
+
   volume->SetProperty(property);
+
+  // Skip the empty space of sparse volumes, such as VDB grids, by cropping the empty bricks
+  double occupiedBounds[6];
+  if (image && !cellFlag && component != -2 &&
+    ::ComputeOccupiedBounds(image, array, component, range, inverseOpacityFlag, occupiedBounds))
+  {
+    mapper->SetCropping(true);
+    mapper->SetCroppingRegionPlanes(occupiedBounds);
+    mapper->SetCroppingRegionFlagsToSubVolume();
+  }
+  else
+  {
+    mapper->SetCropping(false);
+  }
   return true;
 }
 
@@ -11,22 +11,34 @@
 #ifndef vtkF3DRenderer_h
 #define vtkF3DRenderer_h
 
+#include "F3DBoundsHierarchy.h"
 #include "vtkF3DMetaImporter.h"
 
+#include <vtkBoundingBox.h>
 #include <vtkLight.h>
 #include <vtkOpenGLRenderer.h>
 
+#include <array>
+#include <future>
 #include <map>
 #include <optional>
+#include <vector>
 
 class vtkColorTransferFunction;
 class vtkCornerAnnotation;
 class vtkF3DDropZoneActor;
+class vtkF3DEnvironmentCompute;
+class vtkF3DFrameStatistics;
+class vtkF3DGlyphTextActor;
+class vtkF3DOpenGLGridMapper;
+class vtkF3DQuantizeImageFilter;
+class vtkF3DRenderPass;
+class vtkFloatArray;
+class vtkImageData;
 class vtkImageReader2;
 class vtkOrientationMarkerWidget;
 class vtkScalarBarActor;
 class vtkSkybox;
-class vtkTextActor;
 
 class vtkF3DRenderer : public vtkOpenGLRenderer
 {
@@ -42,6 +54,7 @@ public:
   void ShowGrid(bool show);
   void ShowEdge(const std::optional<bool>& show);
   void ShowTimer(bool show);
+  void ShowFrameStatistics(bool show);
   void ShowMetaData(bool show);
   void ShowFilename(bool show);
   void ShowCheatSheet(bool show);
@@ -77,8 +90,15 @@ public:
   void SetUseRaytracing(bool use);
   void SetUseRaytracingDenoiser(bool use);
   void SetUseDepthPeelingPass(bool use);
+  void SetTranslucencyTechnique(const std::string& technique);
+  void SetTranslucencyPeels(int peels);
+  void SetTranslucencyThreshold(double threshold);
   void SetUseSSAOPass(bool use);
+  void SetAmbientOcclusionDownsampling(int downsampling);
+  void SetUseEDLPass(const std::optional<bool>& use);
+  void SetProgressiveFrames(int frames);
   void SetUseFXAAPass(bool use);
+  void SetAntiAliasingTechnique(const std::string& technique);
   void SetUseToneMappingPass(bool use);
   void SetUseBlurBackground(bool use);
   void SetBlurCircleOfConfusionRadius(double radius);
@@ -87,6 +107,112 @@ public:
   void SetFinalShader(const std::optional<std::string>& finalShader);
   ///@}
 
+  ///@{
+  /**
+   * Set the use of decimated proxies of dense surfaces while interacting,
+   * and the frame rate below which full resolution surfaces are replaced by their proxy.
+   * Proxies are built in the background by the importer.
+   */
+  void SetUseLOD(bool use);
+  void SetLODFrameRate(double frameRate);
+  ///@}
+
+  /**
+   * Set the upload of the surfaces in compact vertex buffers decoded in the vertex shader,
+   * halving the GPU memory used by large meshes, see vtkF3DPolyDataMapper::SetCompactVertices.
+   */
+  void SetUseCompactVertices(bool use);
+
+  /**
+   * Set the cameras of additional views, rendered side by side after the main view in equal
+   * parts of the viewport with the same props, so the scene is uploaded only once.
+   * The main view uses the active camera, 2D annotations are only rendered in the main view.
+   * An empty vector renders a single view.
+   */
+  void SetAdditionalViewCameras(const std::vector<vtkSmartPointer<vtkCamera>>& cameras);
+
+  ///@{
+  /**
+   * Set the use of a lower resolution for the props while interacting,
+   * and the frame rate the resolution is adapted to, see vtkF3DRenderPass.
+   */
+  void SetUseDynamicResolution(bool use);
+  void SetDynamicResolutionFrameRate(double frameRate);
+  ///@}
+
+  /**
+   * Set the use of occlusion culling while interacting.
+   * Props hidden behind the depth of the previous frame are not rendered.
+   */
+  void SetUseOcclusionCulling(bool use);
+
+  /**
+   * Set the use of the static batches built by the importer.
+   * When all the actors of a batch are shown without scalar coloring, they are hidden
+   * and the batch is shown instead, reducing the number of draw calls.
+   */
+  void SetUseStaticBatching(bool use);
+
+  /**
+   * Set the GPU memory budget of the surface textures, in megabytes.
+   * When the textures do not fit, the textures covering fewer pixels on screen are
+   * downsampled first, and they are restored when the camera settles closer to them.
+   * 0 means no budget.
+   * Default is 0.
+   */
+  void SetTextureBudget(int budget);
+
+  /**
+   * Set the use of a worker thread to read the HDRI file, compute its hash and its
+   * spherical harmonics. While this is in progress, the previous environment is rendered
+   * and the new one is used by the first render after IsHDRIPreprocessed returns true.
+   * When not used, the HDRI is entirely configured during the next render.
+   * Default is false.
+   */
+  void SetUseAsyncHDRI(bool use);
+
+  /**
+   * Return true if the HDRI preprocessing done on a worker thread is finished,
+   * and not used by a render yet.
+   */
+  bool IsHDRIPreprocessed();
+
+  /**
+   * Set the use of a worker thread to refine the surfaces of the importers having a tessellator,
+   * see vtkF3DGenericImporter::UpdateTessellation. The refined surfaces are then swapped in by
+   * the first render after IsTessellationRefined returns true.
+   * When not used, each render waits for the refinement it needs.
+   * Default is false.
+   */
+  void SetUseAsyncTessellation(bool use);
+
+  /**
+   * Return true if surfaces refined on a worker thread are ready and not rendered yet
+   */
+  bool IsTessellationRefined();
+
+  /**
+   * Return true if the render passes accumulate samples over the frames and the last frame is
+   * not converged yet, in which case rendering again while the view is unchanged improves it.
+   */
+  bool IsRenderAccumulating();
+
+  /**
+   * Read back the view space normal and the linear depth of each pixel of the last render,
+   * 4 floats per pixel, see vtkF3DRenderPass::ReadDepthAndNormals.
+   * Return false if they are not available.
+   */
+  bool ReadDepthAndNormals(std::vector<float>& values);
+
+  /**
+   * Render the index of the imported actor visible in each pixel, starting from 1,
+   * 0 being the background and the props that are not imported. The actors merged in a static
+   * batch share the index of the first one. The selection is rendered without the render passes,
+   * only the props ids are rendered.
+   * Return false if the selection could not be rendered.
+   */
+  bool RenderActorIndices(std::vector<unsigned short>& indices);
+
   /**
    * Set SetUseOrthographicProjection
    */
@@ -118,10 +244,19 @@ public:
   void Render() override;
 
   /**
-   * Reimplemented to account for grid actor
+   * Reimplemented to account for grid actor and to compute tight near and far planes
+   * from the bounds of the props intersecting the view frustum
    */
   void ResetCameraClippingRange() override;
 
+  /**
+   * Get the bounds of the visible props, like ComputeVisiblePropBounds.
+   * The bounds are cached until the imported data or the visibility of the actors change,
+   * the bounds of each time value of an animation are kept until the visibility of the actors
+   * or the importers change, so that they are not computed again when the animation loops.
+   */
+  void GetSceneBounds(double bounds[6]);
+
   /**
    * Set properties on each imported actors and also configure the coloring
    * Then update dedicated actors and logics according to the properties of this class:
@@ -241,9 +376,11 @@ public:
   };
 
   /**
-   * Set the point sprites size and the splat type on the pointGaussianMapper
+   * Set the point sprites size, the splat type, the maximum number of splats
+   * sorted per frame during interaction and the instanced drawing on the pointGaussianMapper
    */
-  void SetPointSpritesProperties(SplatType splatType, double pointSpritesSize);
+  void SetPointSpritesProperties(SplatType splatType, double pointSpritesSize, int sortBudget = 0,
+    bool instancing = false);
 
   /**
    * Set the visibility of the scalar bar.
@@ -271,6 +408,21 @@ public:
    */
   void SetUseInverseOpacityFunction(bool use);
 
+  /**
+   * Set the precision of the volume textures, can be `native`, `16bit` or `8bit`.
+   * With `16bit` or `8bit`, the colored array is quantized to normalized values over the
+   * coloring range before being uploaded, which reduces the size of the textures.
+   */
+  void SetVolumePrecision(const std::string& precision);
+
+  /**
+   * Set the use of pre-integrated transfer functions for volume rendering.
+   * The color and opacity of the segments between the samples are looked up in a table
+   * computed when the coloring changes, see vtkF3DPreIntegrationTable, so the volume is sampled
+   * at the smallest spacing of the image instead of half of it, without slicing artifacts.
+   */
+  void SetUseVolumePreIntegration(bool use);
+
   /**
    * Set the range of the scalar bar
    * Setting an empty vector will use automatic range
@@ -288,6 +440,13 @@ public:
    */
   void SetImporter(vtkF3DMetaImporter* importer);
 
+  /**
+   * Set bounds used as the scene bounds while no visible prop is bounded, eg. the probed bounds
+   * of the files being read, so that the grid is displayed before they are imported.
+   * nullptr to remove them.
+   */
+  void SetPlaceholderBounds(const double* bounds);
+
   ///@{
   /**
    * Set/Get if coloring is enabled
@@ -320,12 +479,27 @@ public:
   vtkGetMacro(ComponentForColoring, int);
   ///@}
 
+  ///@{
+  /**
+   * Set/Get if the point scalars are mapped to colors in the shaders,
+   * so cycling the array, the component or the range does not upload the geometry again
+   */
+  void SetUseGPUColoring(bool use);
+  vtkGetMacro(UseGPUColoring, bool);
+  ///@}
+
   /**
    * Get information about the current coloring
    * Returns a single line string containing the coloring description
    */
   virtual std::string GetColoringDescription();
 
+  /**
+   * Get the frame time statistics.
+   * They are only recorded when the timer or the frame statistics are visible.
+   */
+  vtkF3DFrameStatistics* GetFrameStatistics();
+
   /**
    * Switch between point data and cell data coloring, actually setting UseCellColoring member.
    * This can trigger CycleArrayForColoring if current array is not valid.
@@ -359,6 +533,11 @@ private:
    */
   void ConfigureMetaData();
 
+  /**
+   * Render the main view and each additional view in its part of the viewport
+   */
+  void RenderViews();
+
   /**
    * Configure text actors properties font file and color
    */
@@ -372,10 +551,25 @@ private:
   void ConfigureHDRIReader();
   void ConfigureHDRIHash();
   void ConfigureHDRITexture();
-  void ConfigureHDRILUT();
   void ConfigureHDRISphericalHarmonics();
   void ConfigureHDRISpecular();
   void ConfigureHDRISkybox();
+
+  /**
+   * Return the number of times the HDRI is halved so that the blur radius is about two texels,
+   * and the skybox texture blurred accordingly, cached until the HDRI or the level changes
+   */
+  int ComputeHDRIBlurLevel();
+  vtkTexture* ConfigureBlurredHDRITexture();
+  ///@}
+
+  ///@{
+  /**
+   * Start the HDRI preprocessing on a worker thread, and use its result once finished.
+   * Results computed for a reader that has been replaced since are discarded.
+   */
+  void StartHDRIPreprocessing();
+  void FinishHDRIPreprocessing();
   ///@}
 
   ///@{
@@ -391,6 +585,11 @@ private:
    */
   void ConfigureActorsProperties();
 
+  /**
+   * Configure the mappers of the point sprites with the properties of SetPointSpritesProperties
+   */
+  void ConfigurePointSpritesProperties();
+
   /**
    * Configure the cheatsheet text and hotkeys and mark it for rendering
    */
@@ -406,6 +605,12 @@ private:
    */
   void ConfigureRenderPasses();
 
+  /**
+   * Configure the raytracing settings on the renderer, without rebuilding the render passes
+   * so that the raytracing scene is kept
+   */
+  void ConfigureRaytracing();
+
   /**
    * Generate a padded metadata description
    * using the internal importer.
@@ -413,6 +618,18 @@ private:
    */
   std::string GenerateMetaDataDescription();
 
+  /**
+   * Swap the mappers of the surfaces with a proxy for their proxy mapper when interacting
+   * and the full resolution could not reach the target frame rate, swap them back otherwise
+   */
+  void UpdateLODProxies();
+
+  /**
+   * Choose the resolution of every surface texture from its footprint on screen and downsample
+   * the textures that do not fit in the budget, only when the camera is still
+   */
+  void UpdateTextureResidency();
+
   /**
    * Create a cache directory if a HDRIHash is set
    */
@@ -431,6 +648,8 @@ private:
   /**
    * Convenience method for configuring a poly data mapper for coloring
    * Return true if mapper was configured for coloring, false otherwise.
+   * The point scalars are mapped in the shaders of the F3D mappers with an enabled
+   * F3DShaderColoring, the range and the lookup table being then only used as uniforms.
    */
   static bool ConfigureMapperForColoring(vtkPolyDataMapper* mapper, const std::string& name,
     int component, vtkColorTransferFunction* ctf, double range[2], bool cellFlag = false);
@@ -438,10 +657,17 @@ private:
   /**
    * Convenience method for configuring a volume mapper and volume prop for coloring
    * Return true if they were configured for coloring, false otherwise.
+   * When a quantizer with the input image of the mapper is provided and quantizedType is
+   * VTK_UNSIGNED_CHAR or VTK_UNSIGNED_SHORT, the mapper renders the quantized array instead,
+   * with transfer functions rescaled to the quantized values.
+   * When preIntegrationFlag is true, the transfer functions are pre-integrated in a 2D transfer
+   * function, except for direct scalars.
    */
   static bool ConfigureVolumeForColoring(vtkSmartVolumeMapper* mapper, vtkVolume* volume,
     const std::string& name, int component, vtkColorTransferFunction* ctf, double range[2],
-    bool cellFlag = false, bool inverseOpacityFlag = false);
+    bool cellFlag = false, bool inverseOpacityFlag = false,
+    vtkF3DQuantizeImageFilter* quantizer = nullptr, int quantizedType = VTK_VOID,
+    bool preIntegrationFlag = false);
 
   /**
    * Convenience method for configuring a scalar bar actor for coloring
@@ -469,23 +695,26 @@ private:
   vtkNew<vtkCornerAnnotation> CheatSheetActor;
   vtkNew<vtkF3DDropZoneActor> DropZoneActor;
   vtkNew<vtkActor> GridActor;
+  vtkSmartPointer<vtkF3DOpenGLGridMapper> GridMapper;
   vtkNew<vtkSkybox> SkyboxActor;
 
   // vtkCornerAnnotation building is too slow for the timer
-  vtkNew<vtkTextActor> TimerActor;
+  vtkNew<vtkF3DGlyphTextActor> TimerActor;
   unsigned int Timer = 0;
+  vtkSmartPointer<vtkF3DFrameStatistics> FrameStatistics;
+  vtkSmartPointer<vtkF3DRenderPass> F3DRenderPass;
 
   bool CheatSheetConfigured = false;
   bool ActorsPropertiesConfigured = false;
   bool GridConfigured = false;
   bool RenderPassesConfigured = false;
+  bool RaytracingConfigured = false;
   bool LightIntensitiesConfigured = false;
   bool TextActorsConfigured = false;
   bool MetaDataConfigured = false;
   bool HDRIReaderConfigured = false;
   bool HDRIHashConfigured = false;
   bool HDRITextureConfigured = false;
-  bool HDRILUTConfigured = false;
   bool HDRISphericalHarmonicsConfigured = false;
   bool HDRISpecularConfigured = false;
   bool HDRISkyboxConfigured = false;
@@ -495,6 +724,7 @@ private:
   bool AxisVisible = false;
   std::optional<bool> EdgeVisible;
   bool TimerVisible = false;
+  bool FrameStatisticsVisible = false;
   bool FilenameVisible = false;
   bool MetaDataVisible = false;
   bool CheatSheetVisible = false;
@@ -503,8 +733,15 @@ private:
   bool UseRaytracing = false;
   bool UseRaytracingDenoiser = false;
   bool UseDepthPeelingPass = false;
+  std::string TranslucencyTechnique = "depth_peeling";
+  int TranslucencyPeels = 4;
+  double TranslucencyThreshold = 0.0;
   bool UseFXAAPass = false;
+  std::string AntiAliasingTechnique = "fxaa";
   bool UseSSAOPass = false;
+  int AmbientOcclusionDownsampling = 1;
+  std::optional<bool> UseEDLPass;
+  int ProgressiveFrames = 0;
   bool UseToneMappingPass = false;
   bool UseBlurBackground = false;
   std::optional<bool> UseOrthographicProjection = false;
@@ -517,6 +754,7 @@ private:
   double RightVector[3] = { 1.0, 0.0, 0.0 };
   double CircleOfConfusionRadius = 20.0;
   std::optional<double> PointSize;
+  bool UseCompactVertices = false;
   std::optional<double> LineWidth;
   std::optional<double> GridUnitSquare;
   int GridSubdivisions = 10;
@@ -530,9 +768,30 @@ private:
   bool HasValidHDRIHash = false;
   vtkSmartPointer<vtkTexture> HDRITexture;
   bool HasValidHDRITexture = false;
-  bool HasValidHDRILUT = false;
+  vtkSmartPointer<vtkTexture> BlurredHDRITexture;
+  int BlurredHDRILevel = -1;
+  int BlurredHDRILevelCached = -1;
+  vtkMTimeType BlurredHDRITime = 0;
   bool HasValidHDRISH = false;
   bool HasValidHDRISpec = false;
+  bool HDRIReaderUpdated = false;
+
+  struct HDRIPreprocessingResult
+  {
+    vtkSmartPointer<vtkImageReader2> Reader;
+    std::string Hash;
+    bool ReaderUpdated = false;
+    vtkSmartPointer<vtkFloatArray> SphericalHarmonics;
+  };
+  bool UseAsyncHDRI = false;
+  bool UseAsyncTessellation = false;
+  bool HDRIPreprocessed = false;
+  std::future<HDRIPreprocessingResult> HDRIPreprocessing;
+  vtkSmartPointer<vtkFloatArray> PreprocessedHDRISH;
+  vtkSmartPointer<vtkF3DEnvironmentCompute> EnvironmentCompute;
+
+  std::vector<vtkSmartPointer<vtkCamera>> AdditionalViewCameras;
+  bool RenderingViews = false;
 
   std::optional<std::string> FontFile;
 
@@ -551,6 +810,27 @@ private:
   vtkF3DMetaImporter* Importer = nullptr;
   vtkMTimeType ImporterTimeStamp = 0;
 
+  // Cached visible props bounds, outdated by importer updates and coloring configurations
+  // The hierarchy of the bounds of each visible prop is rebuilt at the same time
+  double SceneBounds[6] = {};
+  F3DBoundsHierarchy SceneHierarchy;
+  std::optional<std::array<double, 6>> PlaceholderBounds;
+  int SceneBoundsNumberOfProps = -1;
+  vtkTimeStamp SceneBoundsTime;
+  vtkTimeStamp PropsVisibilityTime;
+
+  // Cached visible props bounds of each time value, the grid is placed using their union
+  struct TimeStepBounds
+  {
+    std::array<double, 6> Bounds;
+    std::vector<double> PropsBounds;
+  };
+  std::map<double, TimeStepBounds> TimeStepsBounds;
+  size_t TimeStepsBoundsSize = 0;
+  int TimeStepsBoundsNumberOfProps = -1;
+  vtkTimeStamp TimeStepsBoundsTime;
+  vtkBoundingBox TimelineBounds;
+
   vtkNew<vtkScalarBarActor> ScalarBarActor;
   bool ScalarBarActorConfigured = false;
 
@@ -579,11 +859,39 @@ private:
   bool UseCellColoring = false;
   int ComponentForColoring = -1;
   std::optional<std::string> ArrayNameForColoring;
+  bool UseGPUColoring = false;
 
   bool ScalarBarVisible = false;
   bool UsePointSprites = false;
+  SplatType PointSpritesType = SplatType::SPHERE;
+  double PointSpritesSize = 10.0;
+  int PointSpritesSortBudget = 0;
+  bool PointSpritesInstancing = false;
   bool UseVolume = false;
   bool UseInverseOpacityFunction = false;
+  std::string VolumePrecision = "native";
+  bool UseVolumePreIntegration = false;
+
+  bool UseLOD = false;
+  double LODFrameRate = 30.0;
+  bool LODConfigured = false;
+  bool LODProxiesUsed = false;
+  double FullRenderTime = 0.0;
+  bool UseDynamicResolution = false;
+  double DynamicResolutionFrameRate = 30.0;
+  bool UseOcclusionCulling = false;
+  bool UseStaticBatching = false;
+  bool StaticBatchesConfigured = false;
+
+  struct TextureResidency
+  {
+    vtkSmartPointer<vtkTexture> Texture;
+    vtkSmartPointer<vtkImageData> Original;
+    int Level = 0;
+    bool Used = false;
+  };
+  int TextureBudget = 0;
+  std::map<vtkTexture*, TextureResidency> TextureResidencies;
 
   std::optional<std::vector<double>> UserScalarBarRange;
   std::vector<double> Colormap;
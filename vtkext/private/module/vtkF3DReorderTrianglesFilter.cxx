@@ -0,0 +1,221 @@
+#include "vtkF3DReorderTrianglesFilter.h"
+
+#include <vtkCellArray.h>
+#include <vtkCellArrayIterator.h>
+#include <vtkCellData.h>
+#include <vtkIdList.h>
+#include <vtkInformation.h>
+#include <vtkInformationVector.h>
+#include <vtkObjectFactory.h>
+#include <vtkPointData.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+
+#include <numeric>
+#include <vector>
+
+namespace
+{
+//----------------------------------------------------------------------------
+/**
+ * Return the triangles in the order they are emitted by Tipsify
+ */
+std::vector<vtkIdType> Tipsify(
+  const std::vector<vtkIdType>& indices, vtkIdType nbPoints, vtkIdType cacheSize)
+{
+  const vtkIdType nbTriangles = static_cast<vtkIdType>(indices.size() / 3);
+
+  // The triangles using each vertex, in compressed rows
+  std::vector<vtkIdType> offsets(nbPoints + 1, 0);
+  for (vtkIdType v : indices)
+  {
+    offsets[v + 1]++;
+  }
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+  std::vector<vtkIdType> adjacency(indices.size());
+  std::vector<vtkIdType> fill(offsets.begin(), offsets.end() - 1);
+  for (size_t i = 0; i < indices.size(); i++)
+  {
+    adjacency[fill[indices[i]]++] = static_cast<vtkIdType>(i / 3);
+  }
+
+  // The number of triangles not emitted yet and the time each vertex entered the cache
+  std::vector<vtkIdType> live(nbPoints);
+  for (vtkIdType v = 0; v < nbPoints; v++)
+  {
+    live[v] = offsets[v + 1] - offsets[v];
+  }
+  std::vector<vtkIdType> cacheTime(nbPoints, 0);
+  std::vector<bool> emitted(nbTriangles, false);
+  std::vector<vtkIdType> deadEnd;
+  std::vector<vtkIdType> candidates;
+  std::vector<vtkIdType> order;
+  order.reserve(nbTriangles);
+  vtkIdType time = cacheSize + 1;
+  vtkIdType cursor = 0;
+
+  // The most recent vertex with triangles left, or the next one in the input order
+  auto skipDeadEnd = [&]() -> vtkIdType
+  {
+    while (!deadEnd.empty())
+    {
+      vtkIdType v = deadEnd.back();
+      deadEnd.pop_back();
+      if (live[v] > 0)
+      {
+        return v;
+      }
+    }
+    for (; cursor < nbPoints; cursor++)
+    {
+      if (live[cursor] > 0)
+      {
+        return cursor;
+      }
+    }
+    return -1;
+  };
+
+  vtkIdType fan = skipDeadEnd();
+  while (fan >= 0)
+  {
+    // Emit all the triangles around the fanning vertex
+    candidates.clear();
+    for (vtkIdType a = offsets[fan]; a < offsets[fan + 1]; a++)
+    {
+      vtkIdType t = adjacency[a];
+      if (emitted[t])
+      {
+        continue;
+      }
+      emitted[t] = true;
+      order.emplace_back(t);
+      for (int c = 0; c < 3; c++)
+      {
+        vtkIdType v = indices[3 * t + c];
+        deadEnd.emplace_back(v);
+        candidates.emplace_back(v);
+        live[v]--;
+        if (time - cacheTime[v] > cacheSize)
+        {
+          cacheTime[v] = time;
+          time++;
+        }
+      }
+    }
+
+    // Fan next around the oldest candidate still in the cache once its triangles are emitted
+    fan = -1;
+    vtkIdType bestPriority = -1;
+    for (vtkIdType v : candidates)
+    {
+      if (live[v] > 0)
+      {
+        vtkIdType priority = 0;
+        if (time - cacheTime[v] + 2 * live[v] <= cacheSize)
+        {
+          priority = time - cacheTime[v];
+        }
+        if (priority > bestPriority)
+        {
+          bestPriority = priority;
+          fan = v;
+        }
+      }
+    }
+    if (fan < 0)
+    {
+      fan = skipDeadEnd();
+    }
+  }
+  return order;
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkIdList> GetIdentity(vtkIdType size)
+{
+  vtkNew<vtkIdList> ids;
+  ids->SetNumberOfIds(size);
+  std::iota(ids->begin(), ids->end(), 0);
+  return ids;
+}
+}
+
+vtkStandardNewMacro(vtkF3DReorderTrianglesFilter);
+
+//----------------------------------------------------------------------------
+int vtkF3DReorderTrianglesFilter::RequestData(
+  vtkInformation*, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  vtkPolyData* input = vtkPolyData::GetData(inputVector[0]);
+  vtkPolyData* output = vtkPolyData::GetData(outputVector);
+
+  vtkCellArray* polys = input->GetPolys();
+  const vtkIdType nbTriangles = input->GetNumberOfPolys();
+  if (nbTriangles == 0 || input->GetNumberOfCells() != nbTriangles || polys->IsHomogeneous() != 3)
+  {
+    output->ShallowCopy(input);
+    return 1;
+  }
+
+  std::vector<vtkIdType> indices(3 * nbTriangles);
+  auto iter = vtk::TakeSmartPointer(polys->NewIterator());
+  vtkIdType t = 0;
+  for (iter->GoToFirstCell(); !iter->IsDoneWithTraversal(); iter->GoToNextCell(), t++)
+  {
+    vtkIdType npts;
+    const vtkIdType* pts;
+    iter->GetCurrentCell(npts, pts);
+    std::copy(pts, pts + 3, indices.begin() + 3 * t);
+  }
+
+  const vtkIdType nbPoints = input->GetNumberOfPoints();
+  std::vector<vtkIdType> order = ::Tipsify(indices, nbPoints, this->CacheSize);
+
+  // Renumber the points in the order they are first used, the unused ones last
+  std::vector<vtkIdType> newIds(nbPoints, -1);
+  vtkNew<vtkIdList> pointIds;
+  pointIds->Allocate(nbPoints);
+  vtkNew<vtkIdList> cellIds;
+  cellIds->SetNumberOfIds(nbTriangles);
+  vtkNew<vtkCellArray> outputPolys;
+  outputPolys->AllocateExact(nbTriangles, 3 * nbTriangles);
+  for (vtkIdType i = 0; i < nbTriangles; i++)
+  {
+    cellIds->SetId(i, order[i]);
+    vtkIdType triangle[3];
+    for (int c = 0; c < 3; c++)
+    {
+      vtkIdType& newId = newIds[indices[3 * order[i] + c]];
+      if (newId < 0)
+      {
+        newId = pointIds->InsertNextId(indices[3 * order[i] + c]);
+      }
+      triangle[c] = newId;
+    }
+    outputPolys->InsertNextCell(3, triangle);
+  }
+  for (vtkIdType v = 0; v < nbPoints; v++)
+  {
+    if (newIds[v] < 0)
+    {
+      newIds[v] = pointIds->InsertNextId(v);
+    }
+  }
+
+  vtkNew<vtkPoints> points;
+  points->SetDataType(input->GetPoints()->GetDataType());
+  input->GetPoints()->GetPoints(pointIds, points);
+  output->SetPoints(points);
+  output->SetPolys(outputPolys);
+
+  output->GetPointData()->CopyAllOn();
+  output->GetPointData()->CopyAllocate(input->GetPointData(), nbPoints);
+  output->GetPointData()->CopyData(input->GetPointData(), pointIds, ::GetIdentity(nbPoints));
+  output->GetCellData()->CopyAllOn();
+  output->GetCellData()->CopyAllocate(input->GetCellData(), nbTriangles);
+  output->GetCellData()->CopyData(input->GetCellData(), cellIds, ::GetIdentity(nbTriangles));
+  output->GetFieldData()->ShallowCopy(input->GetFieldData());
+
+  return 1;
+}
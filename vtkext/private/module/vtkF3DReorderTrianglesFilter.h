@@ -0,0 +1,47 @@
+/**
+ * @class   vtkF3DReorderTrianglesFilter
+ * @brief   Reorder the triangles and the points of a surface for the GPU vertex caches
+ *
+ * The triangles are reordered with the Tipsify algorithm (Sander, Nehab and Barczak, 2007),
+ * which fans around the vertices most recently emitted so that the vertices of consecutive
+ * triangles are found in the post-transform cache of the GPU. It is linear in the number of
+ * triangles. The points are then renumbered in the order they are first used by the triangles,
+ * so that the vertex fetches are mostly sequential, the unused points being kept at the end.
+ * The point data and the cell data are reordered accordingly, the rendered surface is the same.
+ * Only surfaces made of triangles are reordered, other inputs are passed through.
+ */
+
+#ifndef vtkF3DReorderTrianglesFilter_h
+#define vtkF3DReorderTrianglesFilter_h
+
+#include <vtkPolyDataAlgorithm.h>
+
+class vtkF3DReorderTrianglesFilter : public vtkPolyDataAlgorithm
+{
+public:
+  static vtkF3DReorderTrianglesFilter* New();
+  vtkTypeMacro(vtkF3DReorderTrianglesFilter, vtkPolyDataAlgorithm);
+
+  ///@{
+  /**
+   * Set/Get the number of vertices of the post-transform cache the triangles are ordered for.
+   * Default is 16, which suits most GPUs.
+   */
+  vtkSetClampMacro(CacheSize, int, 3, VTK_INT_MAX);
+  vtkGetMacro(CacheSize, int);
+  ///@}
+
+protected:
+  vtkF3DReorderTrianglesFilter() = default;
+  ~vtkF3DReorderTrianglesFilter() override = default;
+
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+
+private:
+  vtkF3DReorderTrianglesFilter(const vtkF3DReorderTrianglesFilter&) = delete;
+  void operator=(const vtkF3DReorderTrianglesFilter&) = delete;
+
+  int CacheSize = 16;
+};
+
+#endif
@@ -0,0 +1,415 @@
+#include "vtkF3DSSAOPass.h"
+
+#include <vtkMatrix3x3.h>
+#include <vtkMatrix4x4.h>
+#include <vtkObjectFactory.h>
+#include <vtkOpenGLCamera.h>
+#include <vtkOpenGLError.h>
+#include <vtkOpenGLFramebufferObject.h>
+#include <vtkOpenGLQuadHelper.h>
+#include <vtkOpenGLRenderUtilities.h>
+#include <vtkOpenGLRenderWindow.h>
+#include <vtkOpenGLShaderCache.h>
+#include <vtkOpenGLState.h>
+#include <vtkProp.h>
+#include <vtkRenderState.h>
+#include <vtkRenderer.h>
+#include <vtkShaderProgram.h>
+#include <vtkTextureObject.h>
+
+#include <algorithm>
+#include <sstream>
+
+vtkStandardNewMacro(vtkF3DSSAOPass);
+
+//------------------------------------------------------------------------------
+vtkF3DSSAOPass::vtkF3DSSAOPass() = default;
+
+//------------------------------------------------------------------------------
+vtkF3DSSAOPass::~vtkF3DSSAOPass() = default;
+
+//------------------------------------------------------------------------------
+void vtkF3DSSAOPass::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Downsampling: " << this->Downsampling << "\n";
+  os << indent << "NumberOfFrames: " << this->NumberOfFrames << "\n";
+}
+
+//------------------------------------------------------------------------------
+bool vtkF3DSSAOPass::IsConverged() const
+{
+  return this->AccumulatedFrames >= this->NumberOfFrames;
+}
+
+//------------------------------------------------------------------------------
+void vtkF3DSSAOPass::ReleaseGraphicsResources(vtkWindow* w)
+{
+  this->Superclass::ReleaseGraphicsResources(w);
+
+  for (vtkSmartPointer<vtkTextureObject>& texture : this->AccumulationTextures)
+  {
+    if (texture)
+    {
+      texture->ReleaseGraphicsResources(w);
+      texture = nullptr;
+    }
+  }
+  if (this->AccumulationFramebuffer)
+  {
+    this->AccumulationFramebuffer->ReleaseGraphicsResources(w);
+    this->AccumulationFramebuffer = nullptr;
+  }
+  if (this->AccumulationQuadHelper)
+  {
+    this->AccumulationQuadHelper->ReleaseGraphicsResources(w);
+    this->AccumulationQuadHelper = nullptr;
+  }
+  if (this->UpsampleQuadHelper)
+  {
+    this->UpsampleQuadHelper->ReleaseGraphicsResources(w);
+    this->UpsampleQuadHelper = nullptr;
+  }
+  this->AccumulatedFrames = 0;
+}
+
+//------------------------------------------------------------------------------
+void vtkF3DSSAOPass::Render(const vtkRenderState* s)
+{
+  vtkOpenGLClearErrorMacro();
+
+  this->NumberOfRenderedProps = 0;
+
+  vtkRenderer* r = s->GetRenderer();
+  vtkOpenGLRenderWindow* renWin = static_cast<vtkOpenGLRenderWindow*>(r->GetRenderWindow());
+  vtkOpenGLState* ostate = renWin->GetState();
+
+  vtkOpenGLState::ScopedglEnableDisable blendSaver(ostate, GL_BLEND);
+  vtkOpenGLState::ScopedglEnableDisable depthSaver(ostate, GL_DEPTH_TEST);
+
+  if (!this->DelegatePass)
+  {
+    vtkWarningMacro("no delegate in vtkF3DSSAOPass.");
+    return;
+  }
+
+  int x, y, w, h;
+  r->GetTiledSizeAndOrigin(&w, &h, &x, &y);
+
+  // the geometry buffers of vtkSSAOPass are rendered at full resolution
+  this->InitializeGraphicsResources(renWin, w, h);
+  this->ColorTexture->Resize(w, h);
+  this->PositionTexture->Resize(w, h);
+  this->NormalTexture->Resize(w, h);
+  this->DepthTexture->Resize(w, h);
+  this->FrameBufferObject->Resize(w, h);
+
+  ostate->vtkglViewport(x, y, w, h);
+  ostate->vtkglScissor(x, y, w, h);
+
+  this->RenderDelegate(s, w, h);
+
+  this->UpdateAccumulation(s, w, h);
+
+  ostate->vtkglDisable(GL_BLEND);
+  ostate->vtkglDisable(GL_DEPTH_TEST);
+
+  // once converged, the accumulated occlusion is used as is
+  if (!this->IsConverged())
+  {
+    vtkMatrix4x4* wcvc;
+    vtkMatrix3x3* norms;
+    vtkMatrix4x4* vcdc;
+    vtkMatrix4x4* wcdc;
+    vtkOpenGLCamera* cam = static_cast<vtkOpenGLCamera*>(r->GetActiveCamera());
+    cam->GetKeyMatrices(r, wcvc, norms, vcdc, wcdc);
+
+    this->RenderAccumulation(renWin, vcdc);
+  }
+
+  ostate->vtkglViewport(x, y, w, h);
+  ostate->vtkglScissor(x, y, w, h);
+  ostate->vtkglEnable(GL_DEPTH_TEST);
+  ostate->vtkglClear(GL_DEPTH_BUFFER_BIT);
+
+  this->RenderUpsample(renWin);
+
+  vtkOpenGLCheckErrorMacro("failed after Render");
+}
+
+//------------------------------------------------------------------------------
+void vtkF3DSSAOPass::UpdateAccumulation(const vtkRenderState* s, int width, int height)
+{
+  vtkRenderer* r = s->GetRenderer();
+  vtkOpenGLRenderWindow* renWin = static_cast<vtkOpenGLRenderWindow*>(r->GetRenderWindow());
+
+  int size[2] = { std::max(1, (width + this->Downsampling - 1) / this->Downsampling),
+    std::max(1, (height + this->Downsampling - 1) / this->Downsampling) };
+
+  if (!this->AccumulationTextures[0] || size[0] != this->AccumulationSize[0] ||
+    size[1] != this->AccumulationSize[1])
+  {
+    for (vtkSmartPointer<vtkTextureObject>& texture : this->AccumulationTextures)
+    {
+      texture = vtkSmartPointer<vtkTextureObject>::New();
+      texture->SetContext(renWin);
+      texture->SetFormat(GL_RG);
+      texture->SetInternalFormat(GL_RG32F);
+      texture->SetDataType(GL_FLOAT);
+      texture->SetMinificationFilter(vtkTextureObject::Nearest);
+      texture->SetMagnificationFilter(vtkTextureObject::Nearest);
+      texture->SetWrapS(vtkTextureObject::ClampToEdge);
+      texture->SetWrapT(vtkTextureObject::ClampToEdge);
+      texture->Allocate2D(size[0], size[1], 2, VTK_FLOAT);
+    }
+    this->AccumulationSize[0] = size[0];
+    this->AccumulationSize[1] = size[1];
+    this->AccumulatedFrames = 0;
+  }
+
+  if (!this->AccumulationFramebuffer)
+  {
+    this->AccumulationFramebuffer = vtkSmartPointer<vtkOpenGLFramebufferObject>::New();
+    this->AccumulationFramebuffer->SetContext(renWin);
+  }
+
+  // the accumulated frames must show the same image, the pass parameters also change the occlusion
+  vtkMTimeType propsTime = this->GetMTime();
+  for (int i = 0; i < s->GetPropArrayCount(); i++)
+  {
+    propsTime = std::max(propsTime, s->GetPropArray()[i]->GetRedrawMTime());
+  }
+
+  // the camera is modified by the clipping range reset of each render, compare its matrix instead
+  vtkMatrix4x4* cameraMatrix = r->GetActiveCamera()->GetCompositeProjectionTransformMatrix(
+    r->GetTiledAspectRatio(), -1, 1);
+
+  if (propsTime != this->AccumulationPropsTime ||
+    s->GetPropArrayCount() != this->AccumulationNumberOfProps ||
+    !std::equal(this->AccumulationCamera, this->AccumulationCamera + 16, cameraMatrix->GetData()))
+  {
+    this->AccumulationPropsTime = propsTime;
+    this->AccumulationNumberOfProps = s->GetPropArrayCount();
+    std::copy(cameraMatrix->GetData(), cameraMatrix->GetData() + 16, this->AccumulationCamera);
+    this->AccumulatedFrames = 0;
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkF3DSSAOPass::RenderAccumulation(vtkOpenGLRenderWindow* renWin, vtkMatrix4x4* projection)
+{
+  if (this->AccumulationQuadHelper &&
+    this->AccumulationQuadHelper->ShaderChangeValue < this->GetMTime())
+  {
+    this->AccumulationQuadHelper = nullptr;
+  }
+
+  if (!this->AccumulationQuadHelper)
+  {
+    this->ComputeKernel();
+
+    std::string FSSource = vtkOpenGLRenderUtilities::GetFullScreenQuadFragmentShaderTemplate();
+
+    std::stringstream ssDecl;
+    ssDecl << "uniform sampler2D texPosition;\n"
+              "uniform sampler2D texNormal;\n"
+              "uniform sampler2D texDepth;\n"
+              "uniform sampler2D texHistory;\n"
+              "uniform vec3 samples["
+           << this->KernelSize
+           << "];\n"
+              "uniform mat4 matProjection;\n"
+              "uniform float kernelRadius;\n"
+              "uniform float kernelBias;\n"
+              "uniform float historyWeight;\n"
+              "uniform int frameIndex;\n"
+              "//VTK::FSQ::Decl";
+
+    vtkShaderProgram::Substitute(FSSource, "//VTK::FSQ::Decl", ssDecl.str());
+
+    // the kernel is rotated by a different random angle for each pixel and each frame,
+    // so that the accumulated frames sample different directions
+    std::stringstream ssImpl;
+    ssImpl << "  vec3 fragPosVC = texture(texPosition, texCoord).xyz;\n";
+    ssImpl << "  float ao = 1.0;\n";
+    ssImpl << "  if (texture(texDepth, texCoord).r < 1.0)\n";
+    ssImpl << "  {\n";
+    ssImpl << "    vec3 normal = normalize(texture(texNormal, texCoord).xyz);\n";
+    ssImpl << "    vec2 seed = gl_FragCoord.xy + float(frameIndex) * vec2(7.13, 3.71);\n";
+    ssImpl << "    float angle = 6.2831853 * fract(sin(dot(seed, vec2(12.9898, 78.233))) * "
+              "43758.5453);\n";
+    ssImpl << "    vec3 randomVec = vec3(cos(angle), sin(angle), 0.0);\n";
+    ssImpl << "    vec3 tangent = normalize(randomVec - normal * dot(randomVec, normal));\n";
+    ssImpl << "    mat3 TBN = mat3(tangent, cross(normal, tangent), normal);\n";
+    ssImpl << "    float occlusion = 0.0;\n";
+    ssImpl << "    for (int i = 0; i < " << this->KernelSize << "; i++)\n";
+    ssImpl << "    {\n";
+    ssImpl << "      vec3 sampleVC = fragPosVC + kernelRadius * (TBN * samples[i]);\n";
+    ssImpl << "      vec4 sampleDC = matProjection * vec4(sampleVC, 1.0);\n";
+    ssImpl << "      vec2 sampleCoord = 0.5 * (sampleDC.xy / sampleDC.w) + 0.5;\n";
+    ssImpl << "      float sampleDepth = texture(texPosition, sampleCoord).z;\n";
+    ssImpl << "      float rangeCheck = smoothstep(0.0, 1.0, kernelRadius / abs(fragPosVC.z - "
+              "sampleDepth));\n";
+    ssImpl << "      occlusion += (sampleDepth >= sampleVC.z + kernelBias ? 1.0 : 0.0) * "
+              "rangeCheck;\n";
+    ssImpl << "    }\n";
+    ssImpl << "    ao = 1.0 - occlusion / " << this->KernelSize << ".0;\n";
+    ssImpl << "  }\n";
+    ssImpl << "  float history = texture(texHistory, texCoord).r;\n";
+    ssImpl << "  gl_FragData[0] = vec4(mix(history, ao, historyWeight), fragPosVC.z, 0.0, 1.0);\n";
+
+    vtkShaderProgram::Substitute(FSSource, "//VTK::FSQ::Impl", ssImpl.str());
+
+    this->AccumulationQuadHelper = std::make_shared<vtkOpenGLQuadHelper>(renWin,
+      vtkOpenGLRenderUtilities::GetFullScreenQuadVertexShader().c_str(), FSSource.c_str(), "");
+
+    this->AccumulationQuadHelper->ShaderChangeValue = this->GetMTime();
+  }
+  else
+  {
+    renWin->GetShaderCache()->ReadyShaderProgram(this->AccumulationQuadHelper->Program);
+  }
+
+  vtkShaderProgram* program = this->AccumulationQuadHelper->Program;
+  if (!program || !program->GetCompiled())
+  {
+    vtkErrorMacro("Couldn't build the ambient occlusion accumulation shader program.");
+    return;
+  }
+
+  vtkTextureObject* history = this->AccumulationTextures[this->CurrentTexture];
+  vtkTextureObject* target = this->AccumulationTextures[1 - this->CurrentTexture];
+
+  this->PositionTexture->Activate();
+  this->NormalTexture->Activate();
+  this->DepthTexture->Activate();
+  history->Activate();
+  program->SetUniformi("texPosition", this->PositionTexture->GetTextureUnit());
+  program->SetUniformi("texNormal", this->NormalTexture->GetTextureUnit());
+  program->SetUniformi("texDepth", this->DepthTexture->GetTextureUnit());
+  program->SetUniformi("texHistory", history->GetTextureUnit());
+  program->SetUniform3fv("samples", static_cast<int>(this->KernelSize), this->Kernel.data());
+  program->SetUniformMatrix("matProjection", projection);
+  program->SetUniformf("kernelRadius", static_cast<float>(this->Radius));
+  program->SetUniformf("kernelBias", static_cast<float>(this->Bias));
+
+  // running average of the frames since the last change
+  program->SetUniformf("historyWeight", 1.f / static_cast<float>(this->AccumulatedFrames + 1));
+  program->SetUniformi("frameIndex", this->FrameIndex);
+
+  vtkOpenGLState* ostate = renWin->GetState();
+  ostate->PushFramebufferBindings();
+  this->AccumulationFramebuffer->Bind();
+  this->AccumulationFramebuffer->AddColorAttachment(0, target);
+  this->AccumulationFramebuffer->ActivateDrawBuffers(1);
+  this->AccumulationFramebuffer->StartNonOrtho(
+    this->AccumulationSize[0], this->AccumulationSize[1]);
+
+  this->AccumulationQuadHelper->Render();
+
+  this->AccumulationFramebuffer->RemoveColorAttachments(1);
+  ostate->PopFramebufferBindings();
+
+  this->PositionTexture->Deactivate();
+  this->NormalTexture->Deactivate();
+  this->DepthTexture->Deactivate();
+  history->Deactivate();
+
+  this->CurrentTexture = 1 - this->CurrentTexture;
+  this->AccumulatedFrames++;
+  this->FrameIndex++;
+}
+
+//------------------------------------------------------------------------------
+void vtkF3DSSAOPass::RenderUpsample(vtkOpenGLRenderWindow* renWin)
+{
+  if (!this->UpsampleQuadHelper)
+  {
+    std::string FSSource = vtkOpenGLRenderUtilities::GetFullScreenQuadFragmentShaderTemplate();
+
+    std::stringstream ssDecl;
+    ssDecl << "uniform sampler2D texColor;\n"
+              "uniform sampler2D texDepth;\n"
+              "uniform sampler2D texPosition;\n"
+              "uniform sampler2D texOcclusion;\n"
+              "uniform ivec2 occlusionSize;\n"
+              "uniform float depthTolerance;\n"
+              "//VTK::FSQ::Decl";
+
+    vtkShaderProgram::Substitute(FSSource, "//VTK::FSQ::Decl", ssDecl.str());
+
+    // bilinear interpolation of the 4 closest low resolution pixels,
+    // weighted down when their depth differs, so the occlusion does not bleed across edges
+    std::stringstream ssImpl;
+    ssImpl << "  vec4 color = texture(texColor, texCoord);\n";
+    ssImpl << "  float depth = texture(texDepth, texCoord).r;\n";
+    ssImpl << "  float z = texture(texPosition, texCoord).z;\n";
+    ssImpl << "  vec2 coord = texCoord * vec2(occlusionSize) - 0.5;\n";
+    ssImpl << "  ivec2 base = ivec2(floor(coord));\n";
+    ssImpl << "  vec2 f = coord - floor(coord);\n";
+    ssImpl << "  float ao = 0.0;\n";
+    ssImpl << "  float weights = 0.0;\n";
+    ssImpl << "  float nearestAO = 1.0;\n";
+    ssImpl << "  float nearestDistance = 1e30;\n";
+    ssImpl << "  for (int j = 0; j < 2; j++)\n";
+    ssImpl << "  {\n";
+    ssImpl << "    for (int i = 0; i < 2; i++)\n";
+    ssImpl << "    {\n";
+    ssImpl << "      ivec2 texel = clamp(base + ivec2(i, j), ivec2(0), occlusionSize - 1);\n";
+    ssImpl << "      vec2 occlusion = texelFetch(texOcclusion, texel, 0).rg;\n";
+    ssImpl << "      float distance = abs(occlusion.g - z);\n";
+    ssImpl << "      float w = (i == 0 ? 1.0 - f.x : f.x) * (j == 0 ? 1.0 - f.y : f.y);\n";
+    ssImpl << "      w *= exp(-distance / depthTolerance);\n";
+    ssImpl << "      ao += w * occlusion.r;\n";
+    ssImpl << "      weights += w;\n";
+    ssImpl << "      if (distance < nearestDistance)\n";
+    ssImpl << "      {\n";
+    ssImpl << "        nearestDistance = distance;\n";
+    ssImpl << "        nearestAO = occlusion.r;\n";
+    ssImpl << "      }\n";
+    ssImpl << "    }\n";
+    ssImpl << "  }\n";
+    ssImpl << "  ao = weights > 1e-4 ? ao / weights : nearestAO;\n";
+    ssImpl << "  if (depth >= 1.0)\n";
+    ssImpl << "    ao = 1.0;\n";
+    ssImpl << "  gl_FragData[0] = vec4(color.rgb * ao, color.a);\n";
+    ssImpl << "  gl_FragDepth = depth;\n";
+
+    vtkShaderProgram::Substitute(FSSource, "//VTK::FSQ::Impl", ssImpl.str());
+
+    this->UpsampleQuadHelper = std::make_shared<vtkOpenGLQuadHelper>(renWin,
+      vtkOpenGLRenderUtilities::GetFullScreenQuadVertexShader().c_str(), FSSource.c_str(), "");
+  }
+  else
+  {
+    renWin->GetShaderCache()->ReadyShaderProgram(this->UpsampleQuadHelper->Program);
+  }
+
+  vtkShaderProgram* program = this->UpsampleQuadHelper->Program;
+  if (!program || !program->GetCompiled())
+  {
+    vtkErrorMacro("Couldn't build the ambient occlusion upsampling shader program.");
+    return;
+  }
+
+  vtkTextureObject* occlusion = this->AccumulationTextures[this->CurrentTexture];
+
+  this->ColorTexture->Activate();
+  this->DepthTexture->Activate();
+  this->PositionTexture->Activate();
+  occlusion->Activate();
+  program->SetUniformi("texColor", this->ColorTexture->GetTextureUnit());
+  program->SetUniformi("texDepth", this->DepthTexture->GetTextureUnit());
+  program->SetUniformi("texPosition", this->PositionTexture->GetTextureUnit());
+  program->SetUniformi("texOcclusion", occlusion->GetTextureUnit());
+  program->SetUniform2i("occlusionSize", this->AccumulationSize);
+  program->SetUniformf(
+    "depthTolerance", static_cast<float>(std::max(this->Bias, 0.1 * this->Radius)));
+
+  this->UpsampleQuadHelper->Render();
+
+  this->ColorTexture->Deactivate();
+  this->DepthTexture->Deactivate();
+  this->PositionTexture->Deactivate();
+  occlusion->Deactivate();
+}
@@ -0,0 +1,104 @@
+/**
+ * @class   vtkF3DSSAOPass
+ * @brief   Implement a downsampled and temporally accumulated screen space ambient occlusion.
+ *
+ * This pass renders its delegate into the same geometry buffers as vtkSSAOPass, but computes the
+ * ambient occlusion at a fraction of the resolution, with a few samples rotated differently each
+ * frame. While the camera and the props are unchanged, the occlusion is accumulated over the
+ * frames until it converges. The occlusion is then upsampled with a depth aware bilateral filter
+ * before being combined with the color.
+ *
+ * @sa
+ * vtkSSAOPass
+ */
+
+#ifndef vtkF3DSSAOPass_h
+#define vtkF3DSSAOPass_h
+
+#include <vtkSSAOPass.h>
+#include <vtkSmartPointer.h>
+
+#include <memory>
+
+class vtkOpenGLFramebufferObject;
+class vtkOpenGLQuadHelper;
+class vtkTextureObject;
+
+class vtkF3DSSAOPass : public vtkSSAOPass
+{
+public:
+  static vtkF3DSSAOPass* New();
+  vtkTypeMacro(vtkF3DSSAOPass, vtkSSAOPass);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  void Render(const vtkRenderState* s) override;
+
+  void ReleaseGraphicsResources(vtkWindow* w) override;
+
+  ///@{
+  /**
+   * Set/Get the factor the resolution of the ambient occlusion is divided by.
+   * Default is 2.
+   */
+  vtkSetClampMacro(Downsampling, int, 1, 8);
+  vtkGetMacro(Downsampling, int);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the number of frames accumulated before the ambient occlusion is converged.
+   * Default is 16.
+   */
+  vtkSetClampMacro(NumberOfFrames, int, 1, 256);
+  vtkGetMacro(NumberOfFrames, int);
+  ///@}
+
+  /**
+   * Return true if the ambient occlusion of the last frame is converged,
+   * false if rendering again would improve it.
+   */
+  bool IsConverged() const;
+
+  vtkF3DSSAOPass(const vtkF3DSSAOPass&) = delete;
+  void operator=(const vtkF3DSSAOPass&) = delete;
+
+protected:
+  vtkF3DSSAOPass();
+  ~vtkF3DSSAOPass() override;
+
+  /**
+   * Reset the accumulation if the camera, the props or the size changed since the last frame
+   */
+  void UpdateAccumulation(const vtkRenderState* s, int width, int height);
+
+  /**
+   * Compute the occlusion of this frame at low resolution and accumulate it with the history
+   */
+  void RenderAccumulation(vtkOpenGLRenderWindow* renWin, vtkMatrix4x4* projection);
+
+  /**
+   * Upsample the accumulated occlusion and combine it with the color and the depth
+   */
+  void RenderUpsample(vtkOpenGLRenderWindow* renWin);
+
+  int Downsampling = 2;
+  int NumberOfFrames = 16;
+
+  // ping-pong textures storing the occlusion and the view space depth of the low resolution pixels
+  vtkSmartPointer<vtkTextureObject> AccumulationTextures[2];
+  vtkSmartPointer<vtkOpenGLFramebufferObject> AccumulationFramebuffer;
+  std::shared_ptr<vtkOpenGLQuadHelper> AccumulationQuadHelper;
+  std::shared_ptr<vtkOpenGLQuadHelper> UpsampleQuadHelper;
+
+  int CurrentTexture = 0;
+  int FrameIndex = 0;
+  int AccumulatedFrames = 0;
+  int AccumulationSize[2] = {};
+
+  // state of the accumulated frames
+  vtkMTimeType AccumulationPropsTime = 0;
+  int AccumulationNumberOfProps = 0;
+  double AccumulationCamera[16] = {};
+};
+
+#endif
@@ -0,0 +1,115 @@
+#include "vtkF3DSimplifyFilter.h"
+
+#include <vtkBinnedDecimation.h>
+#include <vtkCellArray.h>
+#include <vtkInformation.h>
+#include <vtkInformationVector.h>
+#include <vtkObjectFactory.h>
+#include <vtkPolyData.h>
+#include <vtkTriangleFilter.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+// The number of triangles of a clustered surface only roughly follows the size of the bins
+constexpr int MAXIMUM_ITERATIONS = 4;
+constexpr int MAXIMUM_DIVISIONS = 4096;
+}
+
+vtkStandardNewMacro(vtkF3DSimplifyFilter);
+
+//----------------------------------------------------------------------------
+int vtkF3DSimplifyFilter::RequestData(
+  vtkInformation*, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  vtkPolyData* input = vtkPolyData::GetData(inputVector[0]);
+  vtkPolyData* output = vtkPolyData::GetData(outputVector);
+
+  const vtkIdType target = this->TargetNumberOfTriangles;
+  if (target <= 0 || input->GetNumberOfPolys() <= target)
+  {
+    output->ShallowCopy(input);
+    return 1;
+  }
+
+  // vtkBinnedDecimation only processes triangles
+  vtkSmartPointer<vtkPolyData> triangles = input;
+  if (input->GetPolys()->IsHomogeneous() != 3)
+  {
+    vtkNew<vtkTriangleFilter> triangulate;
+    triangulate->SetInputData(input);
+    triangulate->PassVertsOff();
+    triangulate->PassLinesOff();
+    triangulate->Update();
+    triangles = triangulate->GetOutput();
+  }
+
+  double bounds[6];
+  triangles->GetBounds(bounds);
+  const double extent[3] = { bounds[1] - bounds[0], bounds[3] - bounds[2],
+    bounds[5] - bounds[4] };
+
+  // A surface of area A clustered in bins of size h has about 2 * A / h^2 triangles,
+  // the area is first estimated by the area of the bounding box
+  double area = 2.0 * (extent[0] * extent[1] + extent[1] * extent[2] + extent[2] * extent[0]);
+  if (area <= 0.0)
+  {
+    area = std::max({ extent[0], extent[1], extent[2], 1.0 });
+    area *= area;
+  }
+  double binSize = std::sqrt(2.0 * area / static_cast<double>(target));
+
+  vtkNew<vtkBinnedDecimation> decimator;
+  decimator->SetInputData(triangles);
+  decimator->AutoAdjustNumberOfDivisionsOff();
+  decimator->SetPointGenerationModeToBinPoints();
+  decimator->ProducePointDataOn();
+  decimator->ProduceCellDataOn();
+
+  vtkSmartPointer<vtkPolyData> best;
+  for (int iteration = 0; iteration < MAXIMUM_ITERATIONS; iteration++)
+  {
+    int divisions[3];
+    double bins = 1.0;
+    for (int i = 0; i < 3; i++)
+    {
+      divisions[i] = static_cast<int>(std::clamp(
+        std::ceil(extent[i] / binSize), 1.0, static_cast<double>(MAXIMUM_DIVISIONS)));
+      bins *= divisions[i];
+    }
+    decimator->SetLargeIds(bins > static_cast<double>(VTK_INT_MAX));
+    decimator->SetNumberOfDivisions(divisions[0], divisions[1], divisions[2]);
+    decimator->Update();
+
+    // Keep the largest output fitting in the budget, or the smallest one if none fits
+    vtkPolyData* decimated = decimator->GetOutput();
+    const vtkIdType nbTriangles = decimated->GetNumberOfPolys();
+    const bool fits = nbTriangles <= target;
+    const vtkIdType bestTriangles = best ? best->GetNumberOfPolys() : 0;
+    const bool bestFits = best && bestTriangles <= target;
+    if (!best || (fits && (!bestFits || nbTriangles > bestTriangles)) ||
+      (!fits && !bestFits && nbTriangles < bestTriangles))
+    {
+      best = vtkSmartPointer<vtkPolyData>::New();
+      best->ShallowCopy(decimated);
+    }
+
+    // Stop once within 10% below the budget
+    if (fits && nbTriangles >= target - target / 10)
+    {
+      break;
+    }
+
+    // Adjust the size of the bins from the area of the surface estimated by this clustering
+    binSize *= std::sqrt(std::max(static_cast<double>(nbTriangles), 1.0) / target);
+    if (!fits)
+    {
+      binSize *= 1.05;
+    }
+  }
+
+  output->ShallowCopy(best);
+  return 1;
+}
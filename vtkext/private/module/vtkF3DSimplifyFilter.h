@@ -0,0 +1,48 @@
+/**
+ * @class   vtkF3DSimplifyFilter
+ * @brief   Simplify the triangles of a surface to a triangle budget
+ *
+ * The filter clusters the points of the triangles in a regular grid of bins with
+ * vtkBinnedDecimation, which is linear in the number of cells and threaded. The size of the
+ * bins is first estimated from the bounds, then adjusted from the number of triangles obtained
+ * a few times, so that the output has at most, and close to, TargetNumberOfTriangles triangles.
+ * The point data of a representative input point of each bin, eg. normals and texture
+ * coordinates, and the cell data are kept, but texture seams are not preserved.
+ * Only the polygons are output, they are triangulated first if needed. The input is passed
+ * through when it already fits in the budget.
+ */
+
+#ifndef vtkF3DSimplifyFilter_h
+#define vtkF3DSimplifyFilter_h
+
+#include <vtkPolyDataAlgorithm.h>
+
+class vtkF3DSimplifyFilter : public vtkPolyDataAlgorithm
+{
+public:
+  static vtkF3DSimplifyFilter* New();
+  vtkTypeMacro(vtkF3DSimplifyFilter, vtkPolyDataAlgorithm);
+
+  ///@{
+  /**
+   * Set/Get the maximum number of triangles of the output.
+   * Default is 0, the input is passed through.
+   */
+  vtkSetMacro(TargetNumberOfTriangles, vtkIdType);
+  vtkGetMacro(TargetNumberOfTriangles, vtkIdType);
+  ///@}
+
+protected:
+  vtkF3DSimplifyFilter() = default;
+  ~vtkF3DSimplifyFilter() override = default;
+
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+
+private:
+  vtkF3DSimplifyFilter(const vtkF3DSimplifyFilter&) = delete;
+  void operator=(const vtkF3DSimplifyFilter&) = delete;
+
+  vtkIdType TargetNumberOfTriangles = 0;
+};
+
+#endif
@@ -0,0 +1,777 @@
+#include "vtkF3DSnapshotImporter.h"
+
+#include "vtkF3DCache.h"
+
+#include <vtkActor.h>
+#include <vtkCellArray.h>
+#include <vtkCellData.h>
+#include <vtkDataArray.h>
+#include <vtkImageData.h>
+#include <vtkMatrix4x4.h>
+#include <vtkNew.h>
+#include <vtkObjectFactory.h>
+#include <vtkPointData.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkPolyDataMapper.h>
+#include <vtkProperty.h>
+#include <vtkRenderer.h>
+#include <vtkSmartPointer.h>
+#include <vtkTexture.h>
+#include <vtkVersion.h>
+#include <vtksys/FStream.hxx>
+#include <vtksys/SystemTools.hxx>
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <sstream>
+
+namespace
+{
+constexpr char Magic[8] = { 'F', '3', 'D', 'S', 'N', 'A', 'P', '\0' };
+constexpr uint32_t Version = 1;
+
+//----------------------------------------------------------------------------
+template<typename T>
+void Write(std::ostream& os, const T& value)
+{
+  os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+//----------------------------------------------------------------------------
+template<typename T>
+bool Read(std::istream& is, T& value)
+{
+  is.read(reinterpret_cast<char*>(&value), sizeof(T));
+  return static_cast<bool>(is);
+}
+
+//----------------------------------------------------------------------------
+void WriteString(std::ostream& os, const std::string& str)
+{
+  ::Write(os, static_cast<uint64_t>(str.size()));
+  os.write(str.data(), static_cast<std::streamsize>(str.size()));
+}
+
+//----------------------------------------------------------------------------
+bool ReadString(std::istream& is, std::string& str)
+{
+  // Names are short, a larger size means the file is corrupted
+  uint64_t size = 0;
+  if (!::Read(is, size) || size > 4096)
+  {
+    return false;
+  }
+  str.resize(size);
+  return static_cast<bool>(is.read(str.data(), static_cast<std::streamsize>(size)));
+}
+
+//----------------------------------------------------------------------------
+bool IsSupported(vtkDataArray* array)
+{
+  return array && array->GetDataType() != VTK_BIT &&
+    vtkDataArray::GetDataTypeSize(array->GetDataType()) > 0;
+}
+
+//----------------------------------------------------------------------------
+void WriteArray(std::ostream& os, vtkDataArray* array)
+{
+  // Arrays not using the standard memory layout, eg. implicit arrays, are copied first
+  vtkSmartPointer<vtkDataArray> contiguous = array;
+  if (!array->HasStandardMemoryLayout())
+  {
+    contiguous = vtk::TakeSmartPointer(vtkDataArray::CreateDataArray(array->GetDataType()));
+    contiguous->DeepCopy(array);
+  }
+  ::WriteString(os, array->GetName() ? array->GetName() : "");
+  ::Write(os, static_cast<int32_t>(contiguous->GetDataType()));
+  ::Write(os, static_cast<int32_t>(contiguous->GetNumberOfComponents()));
+  ::Write(os, static_cast<int64_t>(contiguous->GetNumberOfTuples()));
+  std::streamsize size = static_cast<std::streamsize>(contiguous->GetNumberOfValues()) *
+    contiguous->GetDataTypeSize();
+  if (size > 0)
+  {
+    os.write(static_cast<const char*>(contiguous->GetVoidPointer(0)), size);
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkDataArray> ReadArray(std::istream& is, std::streamoff fileSize)
+{
+  std::string name;
+  int32_t type = 0;
+  int32_t nbComponents = 0;
+  int64_t nbTuples = 0;
+  if (!::ReadString(is, name) || !::Read(is, type) || !::Read(is, nbComponents) ||
+    !::Read(is, nbTuples) || type == VTK_BIT || vtkDataArray::GetDataTypeSize(type) <= 0 ||
+    nbComponents <= 0 || nbTuples < 0)
+  {
+    return nullptr;
+  }
+
+  // Check the size before allocating, so that a truncated file is not an allocation failure
+  std::streamoff size = static_cast<std::streamoff>(nbTuples) * nbComponents *
+    vtkDataArray::GetDataTypeSize(type);
+  if (size > fileSize - static_cast<std::streamoff>(is.tellg()))
+  {
+    return nullptr;
+  }
+
+  vtkSmartPointer<vtkDataArray> array = vtk::TakeSmartPointer(vtkDataArray::CreateDataArray(type));
+  if (!array)
+  {
+    return nullptr;
+  }
+  array->SetNumberOfComponents(nbComponents);
+  array->SetNumberOfTuples(nbTuples);
+  if (!name.empty())
+  {
+    array->SetName(name.c_str());
+  }
+
+  // The values are read directly in the array memory
+  if (size > 0 && !is.read(static_cast<char*>(array->GetVoidPointer(0)), size))
+  {
+    return nullptr;
+  }
+  return array;
+}
+
+//----------------------------------------------------------------------------
+void WriteAttributes(std::ostream& os, vtkDataSetAttributes* attributes)
+{
+  // String and bit arrays are not used to render, they are not stored
+  std::vector<int> indices;
+  for (int i = 0; i < attributes->GetNumberOfArrays(); i++)
+  {
+    if (::IsSupported(attributes->GetArray(i)))
+    {
+      indices.emplace_back(i);
+    }
+  }
+
+  ::Write(os, static_cast<uint64_t>(indices.size()));
+  for (int index : indices)
+  {
+    ::Write(os, static_cast<int32_t>(attributes->IsArrayAnAttribute(index)));
+    ::WriteArray(os, attributes->GetArray(index));
+  }
+}
+
+//----------------------------------------------------------------------------
+bool ReadAttributes(std::istream& is, std::streamoff fileSize, vtkDataSetAttributes* attributes)
+{
+  uint64_t nbArrays = 0;
+  if (!::Read(is, nbArrays))
+  {
+    return false;
+  }
+  for (uint64_t i = 0; i < nbArrays; i++)
+  {
+    int32_t attribute = -1;
+    if (!::Read(is, attribute))
+    {
+      return false;
+    }
+    vtkSmartPointer<vtkDataArray> array = ::ReadArray(is, fileSize);
+    if (!array)
+    {
+      return false;
+    }
+    int index = attributes->AddArray(array);
+    if (attribute >= 0 && attribute < vtkDataSetAttributes::NUM_ATTRIBUTES)
+    {
+      attributes->SetActiveAttribute(index, attribute);
+    }
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+std::array<vtkCellArray*, 4> GetCells(vtkPolyData* surface)
+{
+  return { surface->GetVerts(), surface->GetLines(), surface->GetPolys(), surface->GetStrips() };
+}
+
+//----------------------------------------------------------------------------
+bool IsSupported(vtkPolyData* surface)
+{
+  if (!surface)
+  {
+    return false;
+  }
+  if (surface->GetPoints() && !::IsSupported(surface->GetPoints()->GetData()))
+  {
+    return false;
+  }
+  for (vtkCellArray* cells : ::GetCells(surface))
+  {
+    if (cells && (!::IsSupported(cells->GetOffsetsArray()) ||
+                   !::IsSupported(cells->GetConnectivityArray())))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void WriteSurface(std::ostream& os, vtkPolyData* surface)
+{
+  vtkPoints* points = surface->GetPoints();
+  ::Write(os, static_cast<uint32_t>(points != nullptr));
+  if (points)
+  {
+    ::WriteArray(os, points->GetData());
+  }
+
+  for (vtkCellArray* cells : ::GetCells(surface))
+  {
+    ::Write(os, static_cast<uint32_t>(cells != nullptr));
+    if (cells)
+    {
+      ::WriteArray(os, cells->GetOffsetsArray());
+      ::WriteArray(os, cells->GetConnectivityArray());
+    }
+  }
+
+  ::WriteAttributes(os, surface->GetPointData());
+  ::WriteAttributes(os, surface->GetCellData());
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkPolyData> ReadSurface(std::istream& is, std::streamoff fileSize)
+{
+  vtkNew<vtkPolyData> surface;
+
+  uint32_t hasPoints = 0;
+  if (!::Read(is, hasPoints))
+  {
+    return nullptr;
+  }
+  if (hasPoints)
+  {
+    vtkSmartPointer<vtkDataArray> data = ::ReadArray(is, fileSize);
+    if (!data || data->GetNumberOfComponents() != 3)
+    {
+      return nullptr;
+    }
+    vtkNew<vtkPoints> points;
+    points->SetData(data);
+    surface->SetPoints(points);
+  }
+
+  std::array<vtkSmartPointer<vtkCellArray>, 4> cellArrays;
+  for (vtkSmartPointer<vtkCellArray>& cells : cellArrays)
+  {
+    uint32_t hasCells = 0;
+    if (!::Read(is, hasCells))
+    {
+      return nullptr;
+    }
+    if (hasCells)
+    {
+      vtkSmartPointer<vtkDataArray> offsets = ::ReadArray(is, fileSize);
+      vtkSmartPointer<vtkDataArray> connectivity = offsets ? ::ReadArray(is, fileSize) : nullptr;
+      cells = vtkSmartPointer<vtkCellArray>::New();
+      if (!connectivity || !cells->SetData(offsets, connectivity))
+      {
+        return nullptr;
+      }
+    }
+  }
+  surface->SetVerts(cellArrays[0]);
+  surface->SetLines(cellArrays[1]);
+  surface->SetPolys(cellArrays[2]);
+  surface->SetStrips(cellArrays[3]);
+
+  if (!::ReadAttributes(is, fileSize, surface->GetPointData()) ||
+    !::ReadAttributes(is, fileSize, surface->GetCellData()))
+  {
+    return nullptr;
+  }
+  return surface;
+}
+
+//----------------------------------------------------------------------------
+vtkImageData* GetTextureImage(vtkTexture* texture)
+{
+  // Cube maps have several inputs and are not used by the importers
+  if (texture->GetCubeMap() || texture->GetNumberOfInputConnections(0) == 0)
+  {
+    return nullptr;
+  }
+  texture->GetInputAlgorithm()->Update();
+  vtkImageData* image = texture->GetInput();
+  return image && ::IsSupported(image->GetPointData()->GetScalars()) ? image : nullptr;
+}
+
+//----------------------------------------------------------------------------
+void WriteTexture(std::ostream& os, vtkTexture* texture)
+{
+  vtkImageData* image = ::GetTextureImage(texture);
+  int dims[3];
+  image->GetDimensions(dims);
+  for (int dim : dims)
+  {
+    ::Write(os, static_cast<int32_t>(dim));
+  }
+  ::WriteArray(os, image->GetPointData()->GetScalars());
+
+  ::Write(os, static_cast<int32_t>(texture->GetInterpolate()));
+  ::Write(os, static_cast<int32_t>(texture->GetMipmap()));
+  ::Write(os, static_cast<int32_t>(texture->GetRepeat()));
+  ::Write(os, static_cast<int32_t>(texture->GetEdgeClamp()));
+  ::Write(os, static_cast<int32_t>(texture->GetUseSRGBColorSpace()));
+  ::Write(os, static_cast<int32_t>(texture->GetColorMode()));
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkTexture> ReadTexture(std::istream& is, std::streamoff fileSize)
+{
+  std::array<int32_t, 3> dims;
+  for (int32_t& dim : dims)
+  {
+    if (!::Read(is, dim) || dim <= 0)
+    {
+      return nullptr;
+    }
+  }
+  vtkSmartPointer<vtkDataArray> scalars = ::ReadArray(is, fileSize);
+  if (!scalars ||
+    scalars->GetNumberOfTuples() != static_cast<vtkIdType>(dims[0]) * dims[1] * dims[2])
+  {
+    return nullptr;
+  }
+
+  std::array<int32_t, 6> flags;
+  for (int32_t& flag : flags)
+  {
+    if (!::Read(is, flag))
+    {
+      return nullptr;
+    }
+  }
+
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(dims.data());
+  image->GetPointData()->SetScalars(scalars);
+
+  vtkNew<vtkTexture> texture;
+  texture->SetInputData(image);
+  texture->SetInterpolate(flags[0]);
+  texture->SetMipmap(flags[1] != 0);
+  texture->SetRepeat(flags[2]);
+  texture->SetEdgeClamp(flags[3]);
+  texture->SetUseSRGBColorSpace(flags[4] != 0);
+  texture->SetColorMode(flags[5]);
+  return texture;
+}
+
+//----------------------------------------------------------------------------
+void WriteDoubles(std::ostream& os, const double* values, int count)
+{
+  os.write(reinterpret_cast<const char*>(values),
+    static_cast<std::streamsize>(count * sizeof(double)));
+}
+
+//----------------------------------------------------------------------------
+void WriteProperty(std::ostream& os, vtkProperty* property)
+{
+  ::WriteDoubles(os, property->GetAmbientColor(), 3);
+  ::WriteDoubles(os, property->GetDiffuseColor(), 3);
+  ::WriteDoubles(os, property->GetSpecularColor(), 3);
+  ::WriteDoubles(os, property->GetEdgeColor(), 3);
+  ::WriteDoubles(os, property->GetEmissiveFactor(), 3);
+  ::Write(os, property->GetAmbient());
+  ::Write(os, property->GetDiffuse());
+  ::Write(os, property->GetSpecular());
+  ::Write(os, property->GetSpecularPower());
+  ::Write(os, property->GetOpacity());
+  ::Write(os, property->GetMetallic());
+  ::Write(os, property->GetRoughness());
+  ::Write(os, property->GetAnisotropy());
+  ::Write(os, property->GetAnisotropyRotation());
+  ::Write(os, property->GetBaseIOR());
+  ::Write(os, property->GetNormalScale());
+  ::Write(os, property->GetOcclusionStrength());
+  ::Write(os, static_cast<double>(property->GetPointSize()));
+  ::Write(os, static_cast<double>(property->GetLineWidth()));
+  ::Write(os, static_cast<int32_t>(property->GetInterpolation()));
+  ::Write(os, static_cast<int32_t>(property->GetRepresentation()));
+  ::Write(os, static_cast<int32_t>(property->GetBackfaceCulling()));
+  ::Write(os, static_cast<int32_t>(property->GetFrontfaceCulling()));
+  ::Write(os, static_cast<int32_t>(property->GetEdgeVisibility()));
+  ::Write(os, static_cast<int32_t>(property->GetLighting()));
+  ::Write(os, static_cast<int32_t>(property->GetRenderPointsAsSpheres()));
+  ::Write(os, static_cast<int32_t>(property->GetRenderLinesAsTubes()));
+}
+
+//----------------------------------------------------------------------------
+bool ReadProperty(std::istream& is, vtkProperty* property)
+{
+  std::array<double, 15> colors;
+  std::array<double, 14> values;
+  std::array<int32_t, 8> flags;
+  if (!is.read(reinterpret_cast<char*>(colors.data()), sizeof(colors)) ||
+    !is.read(reinterpret_cast<char*>(values.data()), sizeof(values)) ||
+    !is.read(reinterpret_cast<char*>(flags.data()), sizeof(flags)))
+  {
+    return false;
+  }
+
+  property->SetAmbientColor(&colors[0]);
+  property->SetDiffuseColor(&colors[3]);
+  property->SetSpecularColor(&colors[6]);
+  property->SetEdgeColor(&colors[9]);
+  property->SetEmissiveFactor(&colors[12]);
+  property->SetAmbient(values[0]);
+  property->SetDiffuse(values[1]);
+  property->SetSpecular(values[2]);
+  property->SetSpecularPower(values[3]);
+  property->SetOpacity(values[4]);
+  property->SetMetallic(values[5]);
+  property->SetRoughness(values[6]);
+  property->SetAnisotropy(values[7]);
+  property->SetAnisotropyRotation(values[8]);
+  property->SetBaseIOR(values[9]);
+  property->SetNormalScale(values[10]);
+  property->SetOcclusionStrength(values[11]);
+  property->SetPointSize(static_cast<float>(values[12]));
+  property->SetLineWidth(static_cast<float>(values[13]));
+  property->SetInterpolation(flags[0]);
+  property->SetRepresentation(flags[1]);
+  property->SetBackfaceCulling(flags[2]);
+  property->SetFrontfaceCulling(flags[3]);
+  property->SetEdgeVisibility(flags[4]);
+  property->SetLighting(flags[5] != 0);
+  property->SetRenderPointsAsSpheres(flags[6] != 0);
+  property->SetRenderLinesAsTubes(flags[7] != 0);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void WriteMapper(std::ostream& os, vtkPolyDataMapper* mapper)
+{
+  ::Write(os, static_cast<int32_t>(mapper->GetScalarVisibility()));
+  ::Write(os, static_cast<int32_t>(mapper->GetColorMode()));
+  ::Write(os, static_cast<int32_t>(mapper->GetScalarMode()));
+  ::Write(os, static_cast<int32_t>(mapper->GetArrayAccessMode()));
+  ::Write(os, static_cast<int32_t>(mapper->GetArrayComponent()));
+  ::Write(os, static_cast<int32_t>(mapper->GetInterpolateScalarsBeforeMapping()));
+  ::WriteString(os, mapper->GetArrayName() ? mapper->GetArrayName() : "");
+}
+
+//----------------------------------------------------------------------------
+bool ReadMapper(std::istream& is, vtkPolyDataMapper* mapper)
+{
+  std::array<int32_t, 6> flags;
+  std::string arrayName;
+  if (!is.read(reinterpret_cast<char*>(flags.data()), sizeof(flags)) ||
+    !::ReadString(is, arrayName))
+  {
+    return false;
+  }
+  mapper->SetScalarVisibility(flags[0]);
+  mapper->SetColorMode(flags[1]);
+  mapper->SetScalarMode(flags[2]);
+  mapper->SetArrayAccessMode(flags[3]);
+  mapper->SetArrayComponent(flags[4]);
+  mapper->SetInterpolateScalarsBeforeMapping(flags[5]);
+  mapper->SetArrayName(arrayName.c_str());
+  return true;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * Return the index of the item in the table, adding it if needed
+ */
+template<typename T>
+int64_t GetIndex(std::map<T*, int64_t>& indices, std::vector<T*>& items, T* item)
+{
+  auto [it, inserted] = indices.emplace(item, static_cast<int64_t>(items.size()));
+  if (inserted)
+  {
+    items.emplace_back(item);
+  }
+  return it->second;
+}
+}
+
+//----------------------------------------------------------------------------
+vtkStandardNewMacro(vtkF3DSnapshotImporter);
+
+//----------------------------------------------------------------------------
+std::string vtkF3DSnapshotImporter::GetCacheFileName(
+  const std::string& filePath, const std::string& key)
+{
+  std::string directory = vtkF3DCache::GetDirectory();
+  if (directory.empty())
+  {
+    return "";
+  }
+
+  std::string hash =
+    vtkF3DCache::ComputeHash(filePath, "snapshot-v" + std::to_string(::Version) + ";" + key);
+  if (hash.empty())
+  {
+    return "";
+  }
+  return directory + "/snapshots/" + hash + ".f3dsnap";
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DSnapshotImporter::CanReadFile(const std::string& fileName)
+{
+  vtksys::ifstream file(fileName.c_str(), std::ios::binary);
+  char magic[sizeof(::Magic)];
+  uint32_t version = 0;
+  return file.is_open() && file.read(magic, sizeof(magic)) &&
+    std::memcmp(magic, ::Magic, sizeof(magic)) == 0 && ::Read(file, version) &&
+    version == ::Version;
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DSnapshotImporter::Write(
+  const std::vector<vtkActor*>& actors, const std::string& fileName)
+{
+  // Gather the geometries and textures first, so that nothing is written if one is not supported
+  std::map<vtkPolyData*, int64_t> surfaceIndices;
+  std::vector<vtkPolyData*> surfaces;
+  std::map<vtkTexture*, int64_t> textureIndices;
+  std::vector<vtkTexture*> textures;
+  for (vtkActor* actor : actors)
+  {
+    vtkPolyDataMapper* mapper = vtkPolyDataMapper::SafeDownCast(actor->GetMapper());
+    if (!mapper || !::IsSupported(mapper->GetInput()))
+    {
+      return false;
+    }
+    ::GetIndex(surfaceIndices, surfaces, mapper->GetInput());
+
+    std::vector<vtkTexture*> actorTextures;
+    for (const auto& namedTexture : actor->GetProperty()->GetAllTextures())
+    {
+      actorTextures.emplace_back(namedTexture.second);
+    }
+    if (actor->GetTexture())
+    {
+      actorTextures.emplace_back(actor->GetTexture());
+    }
+    for (vtkTexture* texture : actorTextures)
+    {
+      if (!::GetTextureImage(texture))
+      {
+        return false;
+      }
+      ::GetIndex(textureIndices, textures, texture);
+    }
+  }
+
+  vtksys::SystemTools::MakeDirectory(vtksys::SystemTools::GetFilenamePath(fileName));
+  const std::string tmpPath = fileName + ".tmp";
+  vtksys::ofstream file(tmpPath.c_str(), std::ios::binary);
+  if (!file.is_open())
+  {
+    return false;
+  }
+
+  file.write(::Magic, sizeof(::Magic));
+  ::Write(file, ::Version);
+
+  ::Write(file, static_cast<uint64_t>(textures.size()));
+  for (vtkTexture* texture : textures)
+  {
+    ::WriteTexture(file, texture);
+  }
+
+  ::Write(file, static_cast<uint64_t>(surfaces.size()));
+  for (vtkPolyData* surface : surfaces)
+  {
+    ::WriteSurface(file, surface);
+  }
+
+  ::Write(file, static_cast<uint64_t>(actors.size()));
+  for (vtkActor* actor : actors)
+  {
+    vtkPolyDataMapper* mapper = vtkPolyDataMapper::SafeDownCast(actor->GetMapper());
+    ::Write(file, surfaceIndices.at(mapper->GetInput()));
+    ::WriteMapper(file, mapper);
+
+    vtkNew<vtkMatrix4x4> matrix;
+    actor->GetMatrix(matrix);
+    ::WriteDoubles(file, matrix->GetData(), 16);
+    ::Write(file, static_cast<int32_t>(actor->GetVisibility()));
+    ::Write(file, static_cast<int32_t>(actor->GetForceOpaque()));
+    ::Write(file, static_cast<int32_t>(actor->GetForceTranslucent()));
+
+    vtkProperty* property = actor->GetProperty();
+    ::WriteProperty(file, property);
+    ::Write(file, static_cast<uint64_t>(property->GetAllTextures().size()));
+    for (const auto& namedTexture : property->GetAllTextures())
+    {
+      ::WriteString(file, namedTexture.first);
+      ::Write(file, textureIndices.at(namedTexture.second));
+    }
+    ::Write(file, actor->GetTexture() ? textureIndices.at(actor->GetTexture()) : int64_t(-1));
+  }
+  file.close();
+
+  if (!file || std::rename(tmpPath.c_str(), fileName.c_str()) != 0)
+  {
+    vtksys::SystemTools::RemoveFile(tmpPath);
+    return false;
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DSnapshotImporter::ImportActors(vtkRenderer* ren)
+{
+  vtksys::ifstream file(this->FileName.c_str(), std::ios::binary);
+  const std::streamoff fileSize =
+    static_cast<std::streamoff>(vtksys::SystemTools::FileLength(this->FileName));
+
+  // Actors are only added to the renderer once the whole file has been read
+  auto readActors = [&](std::vector<vtkSmartPointer<vtkActor>>& actors,
+                      std::vector<vtkSmartPointer<vtkPolyData>>& surfaces)
+  {
+    char magic[sizeof(::Magic)];
+    uint32_t version = 0;
+    if (!file.is_open() || !file.read(magic, sizeof(magic)) ||
+      std::memcmp(magic, ::Magic, sizeof(magic)) != 0 || !::Read(file, version) ||
+      version != ::Version)
+    {
+      return false;
+    }
+
+    uint64_t nbTextures = 0;
+    if (!::Read(file, nbTextures))
+    {
+      return false;
+    }
+    std::vector<vtkSmartPointer<vtkTexture>> textures;
+    for (uint64_t i = 0; i < nbTextures; i++)
+    {
+      textures.emplace_back(::ReadTexture(file, fileSize));
+      if (!textures.back())
+      {
+        return false;
+      }
+    }
+    auto getTexture = [&](int64_t index) -> vtkTexture*
+    {
+      return index >= 0 && index < static_cast<int64_t>(textures.size()) ? textures[index].Get()
+                                                                          : nullptr;
+    };
+
+    uint64_t nbSurfaces = 0;
+    if (!::Read(file, nbSurfaces))
+    {
+      return false;
+    }
+    for (uint64_t i = 0; i < nbSurfaces; i++)
+    {
+      surfaces.emplace_back(::ReadSurface(file, fileSize));
+      if (!surfaces.back())
+      {
+        return false;
+      }
+    }
+
+    uint64_t nbActors = 0;
+    if (!::Read(file, nbActors))
+    {
+      return false;
+    }
+    for (uint64_t i = 0; i < nbActors; i++)
+    {
+      int64_t surfaceIndex = -1;
+      if (!::Read(file, surfaceIndex) || surfaceIndex < 0 ||
+        surfaceIndex >= static_cast<int64_t>(surfaces.size()))
+      {
+        return false;
+      }
+
+      vtkNew<vtkPolyDataMapper> mapper;
+      mapper->SetInputData(surfaces[surfaceIndex]);
+      vtkNew<vtkActor> actor;
+      actor->SetMapper(mapper);
+
+      vtkNew<vtkMatrix4x4> matrix;
+      std::array<int32_t, 3> flags;
+      if (!::ReadMapper(file, mapper) ||
+        !file.read(reinterpret_cast<char*>(matrix->GetData()), 16 * sizeof(double)) ||
+        !file.read(reinterpret_cast<char*>(flags.data()), sizeof(flags)))
+      {
+        return false;
+      }
+      actor->SetUserMatrix(matrix);
+      actor->SetVisibility(flags[0]);
+      actor->SetForceOpaque(flags[1]);
+      actor->SetForceTranslucent(flags[2]);
+
+      vtkProperty* property = actor->GetProperty();
+      uint64_t nbPropertyTextures = 0;
+      if (!::ReadProperty(file, property) || !::Read(file, nbPropertyTextures))
+      {
+        return false;
+      }
+      for (uint64_t j = 0; j < nbPropertyTextures; j++)
+      {
+        std::string name;
+        int64_t textureIndex = -1;
+        if (!::ReadString(file, name) || !::Read(file, textureIndex) ||
+          !getTexture(textureIndex))
+        {
+          return false;
+        }
+        property->SetTexture(name.c_str(), getTexture(textureIndex));
+      }
+
+      int64_t textureIndex = -1;
+      if (!::Read(file, textureIndex))
+      {
+        return false;
+      }
+      actor->SetTexture(getTexture(textureIndex));
+      actors.emplace_back(actor);
+    }
+    return true;
+  };
+
+  std::vector<vtkSmartPointer<vtkActor>> actors;
+  std::vector<vtkSmartPointer<vtkPolyData>> surfaces;
+  if (!readActors(actors, surfaces))
+  {
+    vtkErrorMacro("Cannot read the snapshot " << this->FileName);
+    this->SetFailureStatus();
+    return;
+  }
+
+  std::stringstream ss;
+  ss << "Snapshot: " << vtksys::SystemTools::GetFilenameName(this->FileName) << "\n";
+  ss << "Number of actors: " << actors.size() << "\n";
+  for (vtkPolyData* surface : surfaces)
+  {
+    ss << vtkImporter::GetDataSetDescription(surface, vtkIndent(0));
+  }
+  this->OutputDescription = ss.str();
+
+  for (vtkActor* actor : actors)
+  {
+    ren->AddActor(actor);
+#if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240707)
+    this->ActorCollection->AddItem(actor);
+#endif
+  }
+}
+
+//----------------------------------------------------------------------------
+std::string vtkF3DSnapshotImporter::GetOutputsDescription()
+{
+  return this->OutputDescription;
+}
@@ -0,0 +1,76 @@
+/**
+ * @class   vtkF3DSnapshotImporter
+ * @brief   Importer of the snapshots of imported scenes
+ *
+ * A snapshot stores the actors imported by any importer, with their matrices, materials,
+ * textures and surfaces, in a compact binary file whose arrays are read in a single block
+ * each, so that reopening a file that is slow to import, eg. a CAD model, is nearly instant.
+ * Snapshots are written by vtkF3DMetaImporter, see vtkF3DMetaImporter::SetImporterSnapshot.
+ * Only the actors with a vtkPolyDataMapper and the data arrays are stored, the lights, cameras
+ * and animations are not.
+ */
+
+#ifndef vtkF3DSnapshotImporter_h
+#define vtkF3DSnapshotImporter_h
+
+#include "vtkF3DImporter.h"
+
+#include <string>
+#include <vector>
+
+class vtkActor;
+
+class vtkF3DSnapshotImporter : public vtkF3DImporter
+{
+public:
+  static vtkF3DSnapshotImporter* New();
+  vtkTypeMacro(vtkF3DSnapshotImporter, vtkF3DImporter);
+
+  ///@{
+  /**
+   * Set/Get the snapshot file name.
+   */
+  vtkSetMacro(FileName, std::string);
+  vtkGetMacro(FileName, std::string);
+  ///@}
+
+  /**
+   * Return the file name of the snapshot of the provided file in the cache directory,
+   * see vtkF3DCache, for a key identifying the reader and the options used to import it.
+   * Return an empty string if there is no cache directory or if the file cannot be read.
+   */
+  static std::string GetCacheFileName(const std::string& filePath, const std::string& key);
+
+  /**
+   * Return true if the provided file is a snapshot of the current version.
+   */
+  static bool CanReadFile(const std::string& fileName);
+
+  /**
+   * Write a snapshot of the provided actors. The geometries and textures shared by several
+   * actors are only written once.
+   * Return false if an actor is not supported, eg. its mapper is not a vtkPolyDataMapper,
+   * or if the file cannot be written, in which case no file is left.
+   */
+  static bool Write(const std::vector<vtkActor*>& actors, const std::string& fileName);
+
+  /**
+   * Get a description of the imported actors.
+   */
+  std::string GetOutputsDescription() override;
+
+protected:
+  vtkF3DSnapshotImporter() = default;
+  ~vtkF3DSnapshotImporter() override = default;
+
+  void ImportActors(vtkRenderer*) override;
+
+private:
+  vtkF3DSnapshotImporter(const vtkF3DSnapshotImporter&) = delete;
+  void operator=(const vtkF3DSnapshotImporter&) = delete;
+
+  std::string FileName;
+  std::string OutputDescription;
+};
+
+#endif
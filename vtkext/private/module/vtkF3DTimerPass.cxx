@@ -0,0 +1,124 @@
+#include "vtkF3DTimerPass.h"
+
+#include "vtkF3DFrameStatistics.h"
+
+#include <vtkNew.h>
+#include <vtkObjectFactory.h>
+#include <vtkVersion.h>
+
+#if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240914)
+#include <vtk_glad.h>
+#else
+#include <vtk_glew.h>
+#endif
+
+vtkStandardNewMacro(vtkF3DTimerPass);
+
+//----------------------------------------------------------------------------
+vtkF3DTimerPass::~vtkF3DTimerPass() = default;
+
+//----------------------------------------------------------------------------
+void vtkF3DTimerPass::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Name: " << this->Name << "\n";
+  os << indent << "DelegatePass: " << this->DelegatePass << "\n";
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DTimerPass::SetDelegatePass(vtkRenderPass* pass)
+{
+  if (this->DelegatePass != pass)
+  {
+    this->DelegatePass = pass;
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkRenderPass* vtkF3DTimerPass::GetDelegatePass()
+{
+  return this->DelegatePass;
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DTimerPass::SetStatistics(vtkF3DFrameStatistics* statistics)
+{
+  this->Statistics = statistics;
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkRenderPass> vtkF3DTimerPass::Wrap(
+  vtkRenderPass* pass, const std::string& name, vtkF3DFrameStatistics* statistics)
+{
+  if (!statistics)
+  {
+    return pass;
+  }
+
+  vtkNew<vtkF3DTimerPass> timer;
+  timer->SetDelegatePass(pass);
+  timer->SetName(name);
+  timer->SetStatistics(statistics);
+  return timer;
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DTimerPass::Render(const vtkRenderState* s)
+{
+  this->NumberOfRenderedProps = 0;
+  if (!this->DelegatePass)
+  {
+    vtkWarningMacro("No delegate pass to render");
+    return;
+  }
+
+#if !defined(__ANDROID__) && !defined(__EMSCRIPTEN__)
+  vtkF3DFrameStatistics* statistics = this->Statistics;
+  if (statistics)
+  {
+    if (this->Queries[0] == 0)
+    {
+      glGenQueries(2, this->Queries);
+    }
+    glQueryCounter(this->Queries[0], GL_TIMESTAMP);
+    statistics->BeginPass(this->Name);
+  }
+#endif
+
+  this->DelegatePass->Render(s);
+  this->NumberOfRenderedProps = this->DelegatePass->GetNumberOfRenderedProps();
+
+#if !defined(__ANDROID__) && !defined(__EMSCRIPTEN__)
+  if (statistics)
+  {
+    glQueryCounter(this->Queries[1], GL_TIMESTAMP);
+    unsigned int start = this->Queries[0];
+    unsigned int end = this->Queries[1];
+    statistics->EndPass(
+      [start, end]()
+      {
+        GLuint64 startTime = 0;
+        GLuint64 endTime = 0;
+        glGetQueryObjectui64v(start, GL_QUERY_RESULT, &startTime);
+        glGetQueryObjectui64v(end, GL_QUERY_RESULT, &endTime);
+        return endTime > startTime ? (endTime - startTime) * 1e-6 : 0.0;
+      });
+  }
+#endif
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DTimerPass::ReleaseGraphicsResources(vtkWindow* w)
+{
+  if (this->Queries[0] != 0)
+  {
+    glDeleteQueries(2, this->Queries);
+    this->Queries[0] = 0;
+    this->Queries[1] = 0;
+  }
+  if (this->DelegatePass)
+  {
+    this->DelegatePass->ReleaseGraphicsResources(w);
+  }
+}
@@ -0,0 +1,84 @@
+/**
+ * @class   vtkF3DTimerPass
+ * @brief   Measure the GPU time of a delegate pass
+ *
+ * This pass renders its delegate pass between two GPU timestamp queries, and records the elapsed
+ * time in a vtkF3DFrameStatistics under the provided name.
+ * The queries are read back when the frame statistics are resolved, at the end of the frame.
+ * GPU timestamps are not available with OpenGL ES, only the delegate is rendered in that case.
+ *
+ * @sa
+ * vtkF3DFrameStatistics
+ */
+
+#ifndef vtkF3DTimerPass_h
+#define vtkF3DTimerPass_h
+
+#include <vtkRenderPass.h>
+#include <vtkSmartPointer.h>
+#include <vtkWeakPointer.h>
+
+#include <string>
+
+class vtkF3DFrameStatistics;
+
+class vtkF3DTimerPass : public vtkRenderPass
+{
+public:
+  static vtkF3DTimerPass* New();
+  vtkTypeMacro(vtkF3DTimerPass, vtkRenderPass);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Render the delegate pass and record its elapsed time.
+   */
+  void Render(const vtkRenderState* s) override;
+
+  /**
+   * Release graphics resources and ask the delegate to release its own resources.
+   */
+  void ReleaseGraphicsResources(vtkWindow* w) override;
+
+  ///@{
+  /**
+   * Set/Get the measured pass.
+   */
+  void SetDelegatePass(vtkRenderPass* pass);
+  vtkRenderPass* GetDelegatePass();
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the name of the pass in the statistics.
+   */
+  vtkSetMacro(Name, std::string);
+  vtkGetMacro(Name, std::string);
+  ///@}
+
+  /**
+   * Set the statistics the elapsed time is recorded into.
+   * If not set, only the delegate is rendered.
+   */
+  void SetStatistics(vtkF3DFrameStatistics* statistics);
+
+  /**
+   * Return a timer pass measuring `pass`, or `pass` itself if `statistics` is null.
+   */
+  static vtkSmartPointer<vtkRenderPass> Wrap(
+    vtkRenderPass* pass, const std::string& name, vtkF3DFrameStatistics* statistics);
+
+  vtkF3DTimerPass(const vtkF3DTimerPass&) = delete;
+  void operator=(const vtkF3DTimerPass&) = delete;
+
+protected:
+  vtkF3DTimerPass() = default;
+  ~vtkF3DTimerPass() override;
+
+  vtkSmartPointer<vtkRenderPass> DelegatePass;
+  vtkWeakPointer<vtkF3DFrameStatistics> Statistics;
+  std::string Name;
+
+  unsigned int Queries[2] = { 0, 0 };
+};
+
+#endif
@@ -0,0 +1,99 @@
+#include <vtkCellArray.h>
+#include <vtkFloatArray.h>
+#include <vtkInformation.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+
+#include "vtkF3DFaceVaryingPointDispatcher.h"
+
+#include <cmath>
+#include <iostream>
+
+int TestF3DFaceVaryingPointDispatcher(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  // two adjacent quads, 6 points and 8 corners
+  vtkNew<vtkPoints> points;
+  for (int i = 0; i < 3; i++)
+  {
+    points->InsertNextPoint(i, 0, 0);
+    points->InsertNextPoint(i, 1, 0);
+  }
+  vtkNew<vtkCellArray> quads;
+  vtkIdType quad0[4] = { 0, 2, 3, 1 };
+  vtkIdType quad1[4] = { 2, 4, 5, 3 };
+  quads->InsertNextCell(4, quad0);
+  quads->InsertNextCell(4, quad1);
+
+  // a vertex attribute and a face-varying attribute continuous across the shared edge
+  vtkNew<vtkFloatArray> vertexValues;
+  vertexValues->SetName("vertex");
+  for (int i = 0; i < 6; i++)
+  {
+    vertexValues->InsertNextValue(static_cast<float>(i));
+  }
+  vtkNew<vtkFloatArray> faceVaryingValues;
+  faceVaryingValues->SetName("faceVarying");
+  float values[8] = { 0, 2, 3, 1, 2, 4, 5, 3 };
+  for (float value : values)
+  {
+    faceVaryingValues->InsertNextValue(value);
+  }
+  faceVaryingValues->GetInformation()->Set(
+    vtkF3DFaceVaryingPointDispatcher::INTERPOLATION_TYPE(), 1);
+
+  vtkNew<vtkPolyData> polyData;
+  polyData->SetPoints(points);
+  polyData->SetPolys(quads);
+  polyData->GetPointData()->AddArray(vertexValues);
+  polyData->GetPointData()->AddArray(faceVaryingValues);
+
+  vtkNew<vtkF3DFaceVaryingPointDispatcher> dispatcher;
+  dispatcher->SetInputData(polyData);
+  dispatcher->Update();
+
+  vtkPolyData* output = dispatcher->GetOutput();
+  vtkDataArray* outputVertex = output->GetPointData()->GetArray("vertex");
+  if (output->GetNumberOfPoints() != 8 || output->GetNumberOfCells() != 2 || !outputVertex ||
+    outputVertex->GetNumberOfTuples() != 8 || outputVertex->GetComponent(5, 0) != 4.0 ||
+    output->GetPoint(5)[0] != 2.0)
+  {
+    std::cerr << "Unexpected expanded output" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // identical corners are merged when welding
+  dispatcher->WeldOn();
+  dispatcher->Update();
+  output = dispatcher->GetOutput();
+  outputVertex = output->GetPointData()->GetArray("vertex");
+  vtkDataArray* outputFaceVarying = output->GetPointData()->GetArray("faceVarying");
+  if (output->GetNumberOfPoints() != 6 || output->GetNumberOfCells() != 2 ||
+    !outputFaceVarying || outputFaceVarying->GetNumberOfTuples() != 6)
+  {
+    std::cerr << "Unexpected welded output: " << output->GetNumberOfPoints() << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (vtkIdType i = 0; i < 6; i++)
+  {
+    if (outputVertex->GetComponent(i, 0) != outputFaceVarying->GetComponent(i, 0) ||
+      output->GetPoint(i)[0] != std::floor(outputVertex->GetComponent(i, 0) / 2.0))
+    {
+      std::cerr << "Unexpected welded values at point " << i << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // discontinuous face-varying values are not merged
+  faceVaryingValues->SetValue(4, 10);
+  faceVaryingValues->Modified();
+  dispatcher->Update();
+  if (dispatcher->GetOutput()->GetNumberOfPoints() != 7)
+  {
+    std::cerr << "Discontinuous corners should not be welded" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,34 @@
+#include <vtkImageData.h>
+#include <vtkNew.h>
+
+#include "vtkF3DImporter.h"
+
+#include <iostream>
+
+int TestF3DImporterShrinkTexture(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(1000, 300, 1);
+  image->AllocateScalars(VTK_UNSIGNED_CHAR, 3);
+
+  // images fitting in the maximum size are kept as is
+  if (vtkF3DImporter::ShrinkTexture(image, 0) != image.Get() ||
+    vtkF3DImporter::ShrinkTexture(image, 1000) != image.Get())
+  {
+    std::cerr << "An image fitting in the maximum size is shrunk" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkSmartPointer<vtkImageData> shrunk = vtkF3DImporter::ShrinkTexture(image, 256);
+  int dims[3];
+  shrunk->GetDimensions(dims);
+  if (dims[0] != 250 || dims[1] != 75 || dims[2] != 1 ||
+    shrunk->GetNumberOfScalarComponents() != 3)
+  {
+    std::cerr << "Unexpected shrunk image: " << dims[0] << "x" << dims[1] << "x" << dims[2]
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
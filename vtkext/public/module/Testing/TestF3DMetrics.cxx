@@ -0,0 +1,91 @@
+#include "vtkF3DMetrics.h"
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+int TestF3DMetrics(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  vtkF3DMetrics::Reset();
+
+  // the counters are incremented concurrently
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++)
+  {
+    threads.emplace_back(
+      []()
+      {
+        for (int i = 0; i < 100; i++)
+        {
+          vtkF3DMetrics::Increment("test_loads_total", { "reader", "STL" });
+        }
+      });
+  }
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+  vtkF3DMetrics::Increment("test_loads_total", { "reader", "PLY" }, 2.0);
+  if (vtkF3DMetrics::GetValue("test_loads_total", { "reader", "STL" }) != 400.0 ||
+    vtkF3DMetrics::GetValue("test_loads_total", { "reader", "PLY" }) != 2.0 ||
+    vtkF3DMetrics::GetValue("test_loads_total") != 0.0)
+  {
+    std::cerr << "Unexpected counter values" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // a name keeps the type of its first record
+  vtkF3DMetrics::SetGauge("test_memory_bytes", 10.0);
+  vtkF3DMetrics::SetGauge("test_memory_bytes", 5.0);
+  vtkF3DMetrics::Observe("test_memory_bytes", 1.0);
+  if (vtkF3DMetrics::GetValue("test_memory_bytes") != 5.0)
+  {
+    std::cerr << "Unexpected gauge value" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkF3DMetrics::Observe("test_load_seconds", 0.003);
+  vtkF3DMetrics::Observe("test_load_seconds", 0.2);
+  vtkF3DMetrics::Observe("test_load_seconds", 1000.0);
+  {
+    vtkF3DMetrics::Timer timer("test_load_seconds");
+  }
+  if (vtkF3DMetrics::GetValue("test_load_seconds") != 4.0)
+  {
+    std::cerr << "Unexpected histogram count" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // the histogram buckets are cumulative in the Prometheus format
+  const std::string text = vtkF3DMetrics::ToPrometheus();
+  for (const char* line : { "# TYPE test_loads_total counter\n",
+         "test_loads_total{reader=\"STL\"} 400\n", "test_memory_bytes 5\n",
+         "test_load_seconds_bucket{le=\"0.25\"} 3\n", "test_load_seconds_bucket{le=\"60\"} 3\n",
+         "test_load_seconds_bucket{le=\"+Inf\"} 4\n", "test_load_seconds_count 4\n" })
+  {
+    if (text.find(line) == std::string::npos)
+    {
+      std::cerr << "Missing Prometheus line: " << line << "in:\n" << text << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  const std::string json = vtkF3DMetrics::ToJSON();
+  if (json.find("\"test_loads_total\":{\"type\":\"counter\",\"values\":[{\"labels\":{\"reader\":"
+                "\"PLY\"},\"value\":2}") == std::string::npos ||
+    json.find("\"count\":4") == std::string::npos)
+  {
+    std::cerr << "Unexpected JSON metrics: " << json << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkF3DMetrics::Reset();
+  if (!vtkF3DMetrics::ToPrometheus().empty() || vtkF3DMetrics::ToJSON() != "{}")
+  {
+    std::cerr << "Metrics not reset" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
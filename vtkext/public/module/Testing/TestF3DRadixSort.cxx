@@ -0,0 +1,158 @@
+#include <vtkOpenGLBufferObject.h>
+#include <vtkOpenGLRenderWindow.h>
+#include <vtkShader.h>
+
+#include "vtkF3DRadixSort.h"
+
+#include <algorithm>
+#include <random>
+
+int TestF3DRadixSort(int argc, char* argv[])
+{
+  // Turn off VTK error reporting to avoid unwanted failure detection by ctest
+  vtkObject::GlobalWarningDisplayOff();
+
+  // we need an OpenGL context
+  vtkNew<vtkRenderWindow> renWin;
+  renWin->OffScreenRenderingOn();
+  renWin->Start();
+
+  if (!vtkShader::IsComputeShaderSupported())
+  {
+    std::cerr << "Compute shaders are not supported on this system, skipping the test.\n";
+    return EXIT_SUCCESS;
+  }
+
+  // not a power of two and more than a single workgroup
+  constexpr int nbElements = 100003;
+
+  // fill CPU keys and values buffers, with negative keys to check float ordering
+  std::vector<float> keys(nbElements);
+  std::vector<unsigned int> values(nbElements);
+
+  std::random_device dev;
+  std::mt19937 rng(dev());
+  std::uniform_real_distribution<float> dist(-1000.f, 1000.f);
+
+  std::generate(std::begin(keys), std::end(keys), [&]() { return dist(rng); });
+  for (int i = 0; i < nbElements; i++)
+  {
+    values[i] = i;
+  }
+  std::vector<float> originalKeys = keys;
+
+  // upload these buffers to the GPU
+  vtkNew<vtkOpenGLBufferObject> bufferKeys;
+  vtkNew<vtkOpenGLBufferObject> bufferValues;
+
+  bufferKeys->Upload(keys, vtkOpenGLBufferObject::ArrayBuffer);
+  bufferValues->Upload(values, vtkOpenGLBufferObject::ArrayBuffer);
+
+  // sort
+  vtkNew<vtkF3DRadixSort> sorter;
+
+  // check invalid workgroup size
+  if (sorter->Initialize(128, VTK_FLOAT, VTK_UNSIGNED_INT))
+  {
+    std::cerr << "The invalid workgroup size is not failing" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // check invalid types, 64-bit keys are not supported
+  if (sorter->Initialize(256, VTK_DOUBLE, VTK_UNSIGNED_INT))
+  {
+    std::cerr << "The invalid key type is not failing" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (sorter->Initialize(256, VTK_FLOAT, VTK_CHAR))
+  {
+    std::cerr << "The invalid value type is not failing" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (sorter->Run(
+        vtkOpenGLRenderWindow::SafeDownCast(renWin), nbElements, bufferKeys, bufferValues))
+  {
+    std::cerr << "Uninitialized run is not failing" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (!sorter->Initialize(256, VTK_FLOAT, VTK_UNSIGNED_INT))
+  {
+    std::cerr << "Valid Initialize call failed" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (!sorter->Run(
+        vtkOpenGLRenderWindow::SafeDownCast(renWin), nbElements, bufferKeys, bufferValues))
+  {
+    std::cerr << "Sorter Run call failed" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // download sorted buffers to CPU
+  bufferKeys->Download(keys.data(), keys.size());
+  bufferValues->Download(values.data(), values.size());
+
+  // check if correctly sorted and if values followed their keys
+  for (int i = 0; i < nbElements; i++)
+  {
+    if (i > 0 && keys[i - 1] > keys[i])
+    {
+      std::cerr << "Keys are not sorted at index " << i << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (originalKeys[values[i]] != keys[i])
+    {
+      std::cerr << "Value does not match its key at index " << i << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // check the incremental sort, spread across several calls
+  for (int i = 0; i < nbElements; i++)
+  {
+    values[i] = i;
+  }
+  bufferKeys->Upload(originalKeys, vtkOpenGLBufferObject::ArrayBuffer);
+  bufferValues->Upload(values, vtkOpenGLBufferObject::ArrayBuffer);
+
+  int nbCalls = 0;
+  bool finished = false;
+  while (!finished)
+  {
+    if (!sorter->RunIncremental(vtkOpenGLRenderWindow::SafeDownCast(renWin), nbElements,
+          bufferKeys, bufferValues, 20000, finished))
+    {
+      std::cerr << "Sorter RunIncremental call failed" << std::endl;
+      return EXIT_FAILURE;
+    }
+    nbCalls++;
+  }
+
+  if (nbCalls <= 1 || sorter->IsIncrementalSortInProgress())
+  {
+    std::cerr << "The incremental sort is not spread across several calls" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  bufferKeys->Download(keys.data(), keys.size());
+  bufferValues->Download(values.data(), values.size());
+
+  for (int i = 0; i < nbElements; i++)
+  {
+    if (i > 0 && keys[i - 1] > keys[i])
+    {
+      std::cerr << "Keys are not sorted incrementally at index " << i << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (originalKeys[values[i]] != keys[i])
+    {
+      std::cerr << "Value does not match its key incrementally at index " << i << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
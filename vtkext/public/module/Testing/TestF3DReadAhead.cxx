@@ -0,0 +1,66 @@
+#include "vtkF3DCache.h"
+#include "vtkF3DReadAhead.h"
+
+#include <vtksys/FStream.hxx>
+#include <vtksys/SystemTools.hxx>
+
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+int TestF3DReadAhead(int argc, char* argv[])
+{
+  if (argc < 3)
+  {
+    std::cerr << "Missing the temporary directory" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // a file of several blocks, the last one being partial
+  std::vector<unsigned char> content((20 << 20) + 123);
+  for (size_t i = 0; i < content.size(); i++)
+  {
+    content[i] = static_cast<unsigned char>((i * 7919) >> 5);
+  }
+  const std::string filePath = std::string(argv[2]) + "/TestF3DReadAhead.bin";
+  vtksys::ofstream file(filePath.c_str(), std::ios_base::binary);
+  file.write(reinterpret_cast<const char*>(content.data()), content.size());
+  file.close();
+
+  std::vector<unsigned char> buffer;
+  if (!vtkF3DReadAhead::ReadFile(filePath, buffer) || buffer != content)
+  {
+    std::cerr << "Unexpected content read ahead" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (vtkF3DReadAhead::ReadFile(filePath + ".missing", buffer))
+  {
+    std::cerr << "Unexpected read of a missing file" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // the temporary directory is local, the file is not copied
+  vtkF3DCache::SetDirectory(argv[2]);
+  if (!vtkF3DReadAhead::IsOnNetworkFileSystem(filePath) &&
+    vtkF3DReadAhead::GetLocalCopy(filePath) != filePath)
+  {
+    std::cerr << "Unexpected copy of a local file" << std::endl;
+    return EXIT_FAILURE;
+  }
+  vtkF3DCache::SetDirectory("");
+
+  std::unique_ptr<std::istream> stream = vtkF3DReadAhead::OpenStream(filePath);
+  std::vector<unsigned char> streamed(
+    (std::istreambuf_iterator<char>(*stream)), std::istreambuf_iterator<char>());
+  if (streamed != content)
+  {
+    std::cerr << "Unexpected content streamed" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  stream.reset();
+  vtksys::SystemTools::RemoveFile(filePath);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,86 @@
+#include "vtkF3DScratchArena.h"
+
+#include <cstdint>
+#include <iostream>
+#include <numeric>
+#include <thread>
+#include <unordered_map>
+
+int TestF3DScratchArena(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  vtkF3DScratchArena::ResetCounters();
+  vtkF3DScratchArena* arena = vtkF3DScratchArena::GetThreadArena();
+
+  {
+    vtkF3DScratchArena::Scope scope;
+
+    // the allocations are aligned and do not overlap
+    char* small = static_cast<char*>(arena->Allocate(3, 1));
+    double* aligned = static_cast<double*>(arena->Allocate(10 * sizeof(double), 64));
+    if (reinterpret_cast<std::uintptr_t>(aligned) % 64 != 0 ||
+      reinterpret_cast<char*>(aligned) < small + 3)
+    {
+      std::cerr << "Unexpected scratch allocation alignment" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // the containers grow past the first block
+    vtkF3DScratchArena::Vector<int> values(100000);
+    std::iota(values.begin(), values.end(), 0);
+    std::unordered_map<int, int, std::hash<int>, std::equal_to<int>,
+      vtkF3DScratchArena::Allocator<std::pair<const int, int>>>
+      map;
+    for (int i = 0; i < 1000; i++)
+    {
+      map[i] = values[i];
+    }
+    if (values.back() != 99999 || map.size() != 1000 || map[999] != 999)
+    {
+      std::cerr << "Unexpected scratch containers content" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // each thread uses its own arena
+    vtkF3DScratchArena* threadArena = nullptr;
+    std::thread thread(
+      [&]()
+      {
+        vtkF3DScratchArena::Scope threadScope;
+        vtkF3DScratchArena::Vector<float> floats(10);
+        threadArena = floats.get_allocator().Arena;
+      });
+    thread.join();
+    if (!threadArena || threadArena == arena)
+    {
+      std::cerr << "The threads share the same scratch arena" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // most allocations did not use the system allocator
+  vtkF3DScratchArena::Counters counters = vtkF3DScratchArena::GetCounters();
+  if (counters.Allocations < 1000 || counters.Blocks < 2 || counters.Blocks > 20 ||
+    counters.BlockBytes < counters.AllocatedBytes)
+  {
+    std::cerr << "Unexpected scratch counters: " << counters.Allocations << " allocations in "
+              << counters.Blocks << " blocks" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // the first block is reused once the outermost scope ended
+  vtkF3DScratchArena::ResetCounters();
+  {
+    vtkF3DScratchArena::Scope scope;
+    arena->Allocate(1024, 8);
+  }
+  counters = vtkF3DScratchArena::GetCounters();
+  if (counters.Allocations != 1 || counters.Blocks != 0)
+  {
+    std::cerr << "The scratch arena is not released by its scope" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  arena->Print(std::cout);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,68 @@
+#include <vtkImageData.h>
+#include <vtkNew.h>
+#include <vtkTexture.h>
+
+#include "vtkF3DTextureCache.h"
+
+#include <iostream>
+
+int TestF3DTextureCache(int vtkNotUsed(argc), char* argv[])
+{
+  const std::string texturePath = std::string(argv[1]) + "data/albedo.png";
+  const std::string key = vtkF3DTextureCache::GetFileKey(texturePath, "256");
+  if (key.empty() || vtkF3DTextureCache::GetFileKey(texturePath, "0") == key ||
+    !vtkF3DTextureCache::GetFileKey(std::string(argv[1]) + "data/missing.png", "").empty())
+  {
+    std::cerr << "Unexpected texture file keys" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(512, 512, 1);
+  image->AllocateScalars(VTK_UNSIGNED_CHAR, 3);
+
+  // nothing is cached while the cache is disabled
+  vtkF3DTextureCache::AddImage(key, image);
+  if (vtkF3DTextureCache::FindImage(key) ||
+    vtkF3DTextureCache::GetTexture(image, false) == vtkF3DTextureCache::GetTexture(image, false))
+  {
+    std::cerr << "The disabled cache stores images" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // cached images share their textures
+  vtkF3DTextureCache::SetBudget(2);
+  vtkF3DTextureCache::AddImage(key, image);
+  vtkSmartPointer<vtkTexture> texture = vtkF3DTextureCache::GetTexture(image, true);
+  if (vtkF3DTextureCache::FindImage(key) != image ||
+    vtkF3DTextureCache::GetTexture(image, true) != texture ||
+    vtkF3DTextureCache::GetTexture(image, false) == texture || !texture->GetUseSRGBColorSpace())
+  {
+    std::cerr << "The cached image does not share its textures" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // two images of 768KB fit in the budget, a third one evicts the least recently used
+  vtkNew<vtkImageData> second;
+  second->DeepCopy(image);
+  vtkNew<vtkImageData> third;
+  third->DeepCopy(image);
+  vtkF3DTextureCache::AddImage("second", second);
+  vtkF3DTextureCache::FindImage(key);
+  vtkF3DTextureCache::AddImage("third", third);
+  if (vtkF3DTextureCache::GetNumberOfImages() != 2 || vtkF3DTextureCache::FindImage("second") ||
+    vtkF3DTextureCache::FindImage(key) != image)
+  {
+    std::cerr << "The least recently used image is not evicted" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkF3DTextureCache::SetBudget(0);
+  if (vtkF3DTextureCache::GetNumberOfImages() != 0)
+  {
+    std::cerr << "The cache is not cleared when disabled" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,66 @@
+#include <vtksys/FStream.hxx>
+
+#include "vtkF3DTrace.h"
+
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+int TestF3DTrace(int argc, char* argv[])
+{
+  // nothing is recorded before starting
+  {
+    F3D_TRACE_SCOPE("NotRecorded");
+  }
+  if (vtkF3DTrace::IsEnabled() || vtkF3DTrace::Stop())
+  {
+    std::cerr << "The trace is enabled before being started" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::string tracePath = std::string(argv[2]) + "TestF3DTrace.json";
+  vtkF3DTrace::Start(tracePath);
+  if (!vtkF3DTrace::IsEnabled())
+  {
+    std::cerr << "The trace is not enabled after being started" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  {
+    F3D_TRACE_SCOPE("Outer");
+    F3D_TRACE_SCOPE("Inner \"quoted\"");
+    std::thread thread([]() { F3D_TRACE_SCOPE("Thread"); });
+    thread.join();
+  }
+  vtkF3DTrace::AddSpan("Explicit", 1, 3);
+
+  if (!vtkF3DTrace::Stop() || vtkF3DTrace::IsEnabled())
+  {
+    std::cerr << "Cannot stop the trace" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtksys::ifstream file(tracePath.c_str());
+  std::stringstream buffer;
+  buffer << file.rdbuf();
+  const std::string trace = buffer.str();
+
+  for (const char* expected :
+    { "\"traceEvents\"", "\"name\":\"Outer\"", "\"name\":\"Inner \\\"quoted\\\"\"",
+      "\"name\":\"Thread\"", "\"tid\":1", "\"ts\":1,\"dur\":2" })
+  {
+    if (trace.find(expected) == std::string::npos)
+    {
+      std::cerr << "The trace does not contain " << expected << ":\n" << trace << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (trace.find("NotRecorded") != std::string::npos)
+  {
+    std::cerr << "The trace contains a scope recorded before starting" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
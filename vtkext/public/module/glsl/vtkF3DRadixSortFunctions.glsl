@@ -0,0 +1,17 @@
+// Convert a key to an unsigned integer preserving the ordering
+uint to_radix_key(KeyType k)
+{
+#if defined(KEY_IS_FLOAT)
+  uint u = floatBitsToUint(k);
+  return (u & 0x80000000u) != 0u ? ~u : (u | 0x80000000u);
+#elif defined(KEY_IS_INT)
+  return uint(k) ^ 0x80000000u;
+#else
+  return uint(k);
+#endif
+}
+
+uint get_digit(KeyType k, int shift)
+{
+  return (to_radix_key(k) >> uint(shift)) & (RadixBins - 1u);
+}
@@ -0,0 +1,54 @@
+#version 430
+
+//VTK::RadixDefines::Dec
+
+layout(local_size_x = WorkgroupSize) in;
+layout(std430) buffer;
+
+layout(binding = 0) readonly buffer Keys
+{
+  KeyType key[];
+};
+
+layout(binding = 4) writeonly buffer Histograms
+{
+  uint histogram[];
+};
+
+layout(location = 0) uniform int count;
+layout(location = 1) uniform int shift;
+layout(location = 2) uniform int workgroupOffset;
+layout(location = 3) uniform int workgroupCount;
+
+shared uint localHistogram[RadixBins];
+
+//VTK::RadixFunctions::Dec
+
+void main()
+{
+  uint lid = gl_LocalInvocationID.x;
+  uint wg = gl_WorkGroupID.x + uint(workgroupOffset);
+  uint blockStart = wg * WorkgroupSize * TilesPerWorkgroup;
+
+  if (lid < RadixBins)
+  {
+    localHistogram[lid] = 0u;
+  }
+  barrier();
+
+  for (uint t = 0u; t < TilesPerWorkgroup; t++)
+  {
+    uint i = blockStart + t * WorkgroupSize + lid;
+    if (i < uint(count))
+    {
+      atomicAdd(localHistogram[get_digit(key[i], shift)], 1u);
+    }
+  }
+  barrier();
+
+  // histograms are stored digit major so that a scan gives the global offsets
+  if (lid < RadixBins)
+  {
+    histogram[lid * uint(workgroupCount) + wg] = localHistogram[lid];
+  }
+}
@@ -0,0 +1,48 @@
+#version 430
+
+//VTK::RadixDefines::Dec
+
+layout(local_size_x = WorkgroupSize) in;
+layout(std430) buffer;
+
+layout(binding = 4) buffer Histograms
+{
+  uint histogram[];
+};
+
+layout(location = 0) uniform int total;
+
+shared uint partial[WorkgroupSize];
+
+// exclusive scan of the histograms, dispatched on a single workgroup
+void main()
+{
+  uint lid = gl_LocalInvocationID.x;
+  uint chunk = (uint(total) + WorkgroupSize - 1u) / WorkgroupSize;
+  uint begin = min(lid * chunk, uint(total));
+  uint end = min(begin + chunk, uint(total));
+
+  uint sum = 0u;
+  for (uint i = begin; i < end; i++)
+  {
+    sum += histogram[i];
+  }
+  partial[lid] = sum;
+  barrier();
+
+  for (uint offset = 1u; offset < WorkgroupSize; offset *= 2u)
+  {
+    uint v = lid >= offset ? partial[lid - offset] : 0u;
+    barrier();
+    partial[lid] += v;
+    barrier();
+  }
+
+  uint running = partial[lid] - sum;
+  for (uint i = begin; i < end; i++)
+  {
+    uint h = histogram[i];
+    histogram[i] = running;
+    running += h;
+  }
+}
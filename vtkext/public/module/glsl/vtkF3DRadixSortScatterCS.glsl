@@ -0,0 +1,125 @@
+#version 430
+
+//VTK::RadixDefines::Dec
+
+layout(local_size_x = WorkgroupSize) in;
+layout(std430) buffer;
+
+layout(binding = 0) readonly buffer KeysIn
+{
+  KeyType keyIn[];
+};
+
+layout(binding = 1) readonly buffer ValuesIn
+{
+  ValueType valueIn[];
+};
+
+layout(binding = 2) writeonly buffer KeysOut
+{
+  KeyType keyOut[];
+};
+
+layout(binding = 3) writeonly buffer ValuesOut
+{
+  ValueType valueOut[];
+};
+
+layout(binding = 4) readonly buffer Histograms
+{
+  uint histogram[];
+};
+
+layout(location = 0) uniform int count;
+layout(location = 1) uniform int shift;
+layout(location = 2) uniform int workgroupOffset;
+layout(location = 3) uniform int workgroupCount;
+
+shared uint sortDigits[WorkgroupSize];
+shared uint sortIndices[WorkgroupSize];
+shared uint scan[WorkgroupSize];
+shared uint digitOffsets[RadixBins];
+shared uint digitStarts[RadixBins];
+shared uint tileCounts[RadixBins];
+
+//VTK::RadixFunctions::Dec
+
+void main()
+{
+  uint lid = gl_LocalInvocationID.x;
+  uint wg = gl_WorkGroupID.x + uint(workgroupOffset);
+  uint blockStart = wg * WorkgroupSize * TilesPerWorkgroup;
+
+  if (lid < RadixBins)
+  {
+    digitOffsets[lid] = histogram[lid * uint(workgroupCount) + wg];
+  }
+
+  for (uint t = 0u; t < TilesPerWorkgroup; t++)
+  {
+    uint tileStart = blockStart + t * WorkgroupSize;
+    uint i = tileStart + lid;
+
+    // out of range elements use an extra digit so they are sorted last
+    sortDigits[lid] = i < uint(count) ? get_digit(keyIn[i], shift) : RadixBins;
+    sortIndices[lid] = lid;
+    if (lid < RadixBins)
+    {
+      tileCounts[lid] = 0u;
+    }
+    barrier();
+
+    // stable local sort of the tile using one split per bit of the digit
+    for (uint bit = 0u; bit <= RadixBits; bit++)
+    {
+      uint d = sortDigits[lid];
+      uint idx = sortIndices[lid];
+      uint isZero = 1u - ((d >> bit) & 1u);
+      scan[lid] = isZero;
+      barrier();
+
+      for (uint offset = 1u; offset < WorkgroupSize; offset *= 2u)
+      {
+        uint v = lid >= offset ? scan[lid - offset] : 0u;
+        barrier();
+        scan[lid] += v;
+        barrier();
+      }
+
+      uint zerosBefore = scan[lid] - isZero;
+      uint totalZeros = scan[WorkgroupSize - 1u];
+      barrier();
+
+      uint dest = isZero == 1u ? zerosBefore : totalZeros + lid - zerosBefore;
+      sortDigits[dest] = d;
+      sortIndices[dest] = idx;
+      barrier();
+    }
+
+    uint digit = sortDigits[lid];
+    if (digit < RadixBins)
+    {
+      if (lid == 0u || sortDigits[lid - 1u] != digit)
+      {
+        digitStarts[digit] = lid;
+      }
+      atomicAdd(tileCounts[digit], 1u);
+    }
+    barrier();
+
+    if (digit < RadixBins)
+    {
+      uint dst = digitOffsets[digit] + lid - digitStarts[digit];
+      uint src = tileStart + sortIndices[lid];
+      keyOut[dst] = keyIn[src];
+      valueOut[dst] = valueIn[src];
+    }
+    barrier();
+
+    if (lid < RadixBins)
+    {
+      digitOffsets[lid] += tileCounts[lid];
+    }
+    barrier();
+  }
+}
@@ -0,0 +1,70 @@
+#include "vtkF3DCache.h"
+
+#include <vtkObjectFactory.h>
+#include <vtksys/FStream.hxx>
+#include <vtksys/MD5.h>
+
+#include <mutex>
+#include <vector>
+
+namespace
+{
+std::mutex CacheMutex;
+std::string CacheDirectory;
+}
+
+//----------------------------------------------------------------------------
+vtkStandardNewMacro(vtkF3DCache);
+
+//----------------------------------------------------------------------------
+void vtkF3DCache::SetDirectory(const std::string& directory)
+{
+  const std::lock_guard<std::mutex> lock(::CacheMutex);
+  ::CacheDirectory = directory;
+}
+
+//----------------------------------------------------------------------------
+std::string vtkF3DCache::GetDirectory()
+{
+  const std::lock_guard<std::mutex> lock(::CacheMutex);
+  return ::CacheDirectory;
+}
+
+//----------------------------------------------------------------------------
+std::string vtkF3DCache::ComputeHash(const std::string& filePath, const std::string& salt)
+{
+  vtksys::ifstream file(filePath.c_str(), std::ios_base::binary);
+  if (!file.is_open())
+  {
+    return "";
+  }
+
+  vtksysMD5* md5 = vtksysMD5_New();
+  vtksysMD5_Initialize(md5);
+
+  // read by chunks, CAD files can be very large
+  constexpr std::streamsize chunkSize = 1 << 20;
+  std::vector<char> buffer(chunkSize);
+  while (file)
+  {
+    file.read(buffer.data(), chunkSize);
+    std::streamsize count = file.gcount();
+    if (count > 0)
+    {
+      vtksysMD5_Append(
+        md5, reinterpret_cast<const unsigned char*>(buffer.data()), static_cast<int>(count));
+    }
+  }
+
+  vtksysMD5_Append(
+    md5, reinterpret_cast<const unsigned char*>(salt.data()), static_cast<int>(salt.size()));
+
+  unsigned char digest[16];
+  char md5Hash[33];
+  md5Hash[32] = '\0';
+  vtksysMD5_Finalize(md5, digest);
+  vtksysMD5_DigestToHex(digest, md5Hash);
+  vtksysMD5_Delete(md5);
+
+  return md5Hash;
+}
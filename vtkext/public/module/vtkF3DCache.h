@@ -0,0 +1,53 @@
+/**
+ * @class   vtkF3DCache
+ * @brief   Cache directory shared between libf3d and plugins
+ *
+ * This class stores the directory set with `f3d::engine::setCachePath` so that
+ * readers and importers, including the ones provided by plugins, can cache
+ * expensive to compute data on disk.
+ * It also provides a hash helper to build cache keys out of a file content.
+ */
+
+#ifndef vtkF3DCache_h
+#define vtkF3DCache_h
+
+#include "vtkextModule.h"
+
+#include <vtkObject.h>
+
+#include <string>
+
+class VTKEXT_EXPORT vtkF3DCache : public vtkObject
+{
+public:
+  static vtkF3DCache* New();
+  vtkTypeMacro(vtkF3DCache, vtkObject);
+
+  ///@{
+  /**
+   * Set/Get the cache directory, it may not exist yet.
+   * An empty directory means that nothing should be cached.
+   * Thread safe.
+   * Default is empty.
+   */
+  static void SetDirectory(const std::string& directory);
+  static std::string GetDirectory();
+  ///@}
+
+  /**
+   * Compute the MD5 hash of the content of a file and of the provided salt, which can be used
+   * to add the parameters the cached data depends on.
+   * Returns an empty string if the file cannot be read.
+   */
+  static std::string ComputeHash(const std::string& filePath, const std::string& salt);
+
+protected:
+  vtkF3DCache() = default;
+  ~vtkF3DCache() override = default;
+
+private:
+  vtkF3DCache(const vtkF3DCache&) = delete;
+  void operator=(const vtkF3DCache&) = delete;
+};
+
+#endif
@@ -1,10 +1,126 @@
 #include "vtkF3DFaceVaryingPointDispatcher.h"
 
+#include "vtkF3DScratchArena.h"
+
 #include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationIntegerKey.h"
 #include "vtkInformationVector.h"
 #include "vtkPointData.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+//------------------------------------------------------------------------------
+/**
+ * Copy the source tuples provided by sourceIndex to all the tuples of the output, in parallel
+ */
+template<typename SourceIndex>
+void DispatchTuples(vtkDataArray* source, vtkDataArray* output, SourceIndex sourceIndex)
+{
+  vtkSMPTools::For(0, output->GetNumberOfTuples(),
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType i = begin; i < end; i++)
+      {
+        output->SetTuple(i, sourceIndex(i), source);
+      }
+    });
+}
+
+//------------------------------------------------------------------------------
+vtkSmartPointer<vtkDataArray> NewArrayLike(vtkDataArray* array, vtkIdType nbTuples)
+{
+  auto outputArray =
+    vtkSmartPointer<vtkDataArray>::Take(vtkDataArray::CreateDataArray(array->GetDataType()));
+  outputArray->SetNumberOfComponents(array->GetNumberOfComponents());
+  outputArray->SetNumberOfTuples(nbTuples);
+  outputArray->SetName(array->GetName());
+  return outputArray;
+}
+
+//------------------------------------------------------------------------------
+/**
+ * Merge the corners with the same point and the same face-varying values.
+ * Fill the output point of each corner and return the corner used for each output point.
+ */
+vtkF3DScratchArena::Vector<vtkIdType> WeldCorners(vtkIdTypeArray* pointIds,
+  const std::vector<vtkDataArray*>& faceVaryingArrays, vtkIdType* cornerPoints)
+{
+  const vtkIdType nbCorners = pointIds->GetNumberOfValues();
+  const vtkIdType* ids = pointIds->GetPointer(0);
+
+  // hashing is the expensive part, done in parallel
+  vtkF3DScratchArena::Vector<size_t> hashes(nbCorners);
+  vtkSMPTools::For(0, nbCorners,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType c = begin; c < end; c++)
+      {
+        size_t hash = std::hash<vtkIdType>()(ids[c]);
+        for (vtkDataArray* array : faceVaryingArrays)
+        {
+          for (int k = 0; k < array->GetNumberOfComponents(); k++)
+          {
+            hash ^= std::hash<double>()(array->GetComponent(c, k)) + 0x9e3779b97f4a7c15 +
+              (hash << 6) + (hash >> 2);
+          }
+        }
+        hashes[c] = hash;
+      }
+    });
+
+  auto isSameCorner = [&](vtkIdType a, vtkIdType b)
+  {
+    if (ids[a] != ids[b])
+    {
+      return false;
+    }
+    for (vtkDataArray* array : faceVaryingArrays)
+    {
+      for (int k = 0; k < array->GetNumberOfComponents(); k++)
+      {
+        if (array->GetComponent(a, k) != array->GetComponent(b, k))
+        {
+          return false;
+        }
+      }
+    }
+    return true;
+  };
+
+  // the nodes of the map are allocated in the scratch arena, they are all freed at once
+  vtkF3DScratchArena::Vector<vtkIdType> uniqueCorners;
+  std::unordered_multimap<size_t, vtkIdType, std::hash<size_t>, std::equal_to<size_t>,
+    vtkF3DScratchArena::Allocator<std::pair<const size_t, vtkIdType>>>
+    outputPoints;
+  outputPoints.reserve(nbCorners);
+  for (vtkIdType c = 0; c < nbCorners; c++)
+  {
+    auto range = outputPoints.equal_range(hashes[c]);
+    auto it = std::find_if(range.first, range.second,
+      [&](const auto& candidate) { return isSameCorner(uniqueCorners[candidate.second], c); });
+    if (it != range.second)
+    {
+      cornerPoints[c] = it->second;
+    }
+    else
+    {
+      cornerPoints[c] = static_cast<vtkIdType>(uniqueCorners.size());
+      outputPoints.emplace(hashes[c], cornerPoints[c]);
+      uniqueCorners.emplace_back(c);
+    }
+  }
+  return uniqueCorners;
+}
+}
 
 vtkStandardNewMacro(vtkF3DFaceVaryingPointDispatcher);
 
@@ -22,29 +138,37 @@ int vtkF3DFaceVaryingPointDispatcher::RequestData(vtkInformation* vtkNotUsed(req
 {
   vtkPolyData* input = vtkPolyData::GetData(inputVector[0]->GetInformationObject(0));
   vtkPolyData* output = vtkPolyData::GetData(outputVector->GetInformationObject(0));
+  vtkF3DScratchArena::Scope scratch;
 
   // early exit if all interpolations are "vertex"
   vtkPointData* inputPointData = input->GetPointData();
 
   vtkIdType nbArrays = inputPointData->GetNumberOfArrays();
 
-  bool earlyExit = true;
-
+  std::vector<vtkDataArray*> vertexArrays;
+  std::vector<vtkDataArray*> faceVaryingArrays;
   for (vtkIdType i = 0; i < nbArrays; i++)
   {
     vtkDataArray* inputArray = inputPointData->GetArray(i);
+    if (!inputArray)
+    {
+      continue;
+    }
 
     vtkInformation* info = inputArray->GetInformation();
     int interpType = info->Get(vtkF3DFaceVaryingPointDispatcher::INTERPOLATION_TYPE());
 
-    if (interpType != 0) // vertex
+    if (interpType == 0) // vertex
     {
-      earlyExit = false;
-      break;
+      vertexArrays.emplace_back(inputArray);
+    }
+    else
+    {
+      faceVaryingArrays.emplace_back(inputArray);
     }
   }
 
-  if (earlyExit)
+  if (faceVaryingArrays.empty())
   {
     // nothing to do, just return the input
     output->ShallowCopy(input);
@@ -54,12 +178,35 @@ int vtkF3DFaceVaryingPointDispatcher::RequestData(vtkInformation* vtkNotUsed(req
   vtkPoints* inputPoints = input->GetPoints();
   vtkCellArray* inputFaces = input->GetPolys();
 
-  vtkIdType nbCells = inputFaces->GetNumberOfCells();
-  vtkIdType nbConnectivity = inputFaces->GetNumberOfConnectivityIds();
+  // each cell connectivity entry, or corner, is a point of the expanded output
+  vtkNew<vtkIdTypeArray> pointIds;
+  pointIds->DeepCopy(inputFaces->GetConnectivityArray());
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->DeepCopy(inputFaces->GetOffsetsArray());
+  const vtkIdType nbCorners = pointIds->GetNumberOfValues();
+  const vtkIdType* ids = pointIds->GetPointer(0);
+
+  // when welding, output points are the unique corners
+  vtkF3DScratchArena::Vector<vtkIdType> uniqueCorners;
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(nbCorners);
+  vtkIdType nbOutputPoints = nbCorners;
+  if (this->Weld)
+  {
+    uniqueCorners = ::WeldCorners(pointIds, faceVaryingArrays, connectivity->GetPointer(0));
+    nbOutputPoints = static_cast<vtkIdType>(uniqueCorners.size());
+  }
+  else
+  {
+    std::iota(connectivity->GetPointer(0), connectivity->GetPointer(0) + nbCorners, 0);
+  }
+  auto outputCorner = [&](vtkIdType i) { return this->Weld ? uniqueCorners[i] : i; };
+  auto outputPoint = [&](vtkIdType i) { return ids[outputCorner(i)]; };
 
-  // the number of output points is the number of total cells connectivity
   vtkNew<vtkPoints> outputPoints;
-  outputPoints->SetNumberOfPoints(nbConnectivity);
+  outputPoints->SetDataType(inputPoints->GetDataType());
+  outputPoints->SetNumberOfPoints(nbOutputPoints);
+  ::DispatchTuples(inputPoints->GetData(), outputPoints->GetData(), outputPoint);
 
   vtkPointData* outputPointData = output->GetPointData();
 
@@ -69,66 +216,26 @@ int vtkF3DFaceVaryingPointDispatcher::RequestData(vtkInformation* vtkNotUsed(req
 
   // However, for vertex attributes, the arrays must be replaced by dispatching the values
   // in order to duplicate values and correspond to the new point location
-  for (vtkIdType i = 0; i < nbArrays; i++)
+  for (vtkDataArray* inputArray : vertexArrays)
   {
-    vtkDataArray* inputArray = inputPointData->GetArray(i);
-
-    vtkInformation* info = inputArray->GetInformation();
-    int interpType = info->Get(vtkF3DFaceVaryingPointDispatcher::INTERPOLATION_TYPE());
+    vtkSmartPointer<vtkDataArray> outputArray = ::NewArrayLike(inputArray, nbOutputPoints);
+    ::DispatchTuples(inputArray, outputArray, outputPoint);
+    outputPointData->AddArray(outputArray);
+  }
 
-    if (interpType == 0) // vertex
+  // Welded face-varying attributes only keep the values of the unique corners
+  if (this->Weld)
+  {
+    for (vtkDataArray* inputArray : faceVaryingArrays)
     {
-      auto outputArray = vtkSmartPointer<vtkDataArray>::Take(
-        vtkDataArray::CreateDataArray(inputArray->GetDataType()));
-      outputArray->SetNumberOfComponents(inputArray->GetNumberOfComponents());
-      outputArray->SetNumberOfTuples(nbConnectivity);
-      outputArray->SetName(inputArray->GetName());
-
+      vtkSmartPointer<vtkDataArray> outputArray = ::NewArrayLike(inputArray, nbOutputPoints);
+      ::DispatchTuples(inputArray, outputArray, outputCorner);
       outputPointData->AddArray(outputArray);
     }
   }
 
   vtkNew<vtkCellArray> outputFaces;
-
-  std::vector<vtkIdType> cell;
-  cell.resize(inputFaces->GetMaxCellSize());
-
-  vtkIdType currentVertexIndex = 0;
-
-  for (vtkIdType i = 0; i < nbCells; i++)
-  {
-    vtkIdType cellSize;
-    const vtkIdType* cellPoints;
-    inputFaces->GetCellAtId(i, cellSize, cellPoints);
-
-    for (vtkIdType j = 0; j < cellSize; j++)
-    {
-      cell[j] = currentVertexIndex + j;
-      outputPoints->SetPoint(currentVertexIndex + j, inputPoints->GetPoint(cellPoints[j]));
-
-      for (vtkIdType k = 0; k < nbArrays; k++)
-      {
-        vtkDataArray* inputArray = inputPointData->GetArray(k);
-
-        vtkInformation* info = inputArray->GetInformation();
-        int interpType = info->Get(vtkF3DFaceVaryingPointDispatcher::INTERPOLATION_TYPE());
-
-        if (interpType == 0) // vertex
-        {
-          vtkDataArray* outputArray = outputPointData->GetArray(inputArray->GetName());
-
-          if (outputArray)
-          {
-            outputArray->SetTuple(currentVertexIndex + j, inputArray->GetTuple(cellPoints[j]));
-          }
-        }
-      }
-    }
-
-    outputFaces->InsertNextCell(cellSize, cell.data());
-
-    currentVertexIndex += cellSize;
-  }
+  outputFaces->SetData(offsets, connectivity);
 
   output->SetPoints(outputPoints);
   output->SetPolys(outputFaces);
@@ -10,7 +10,9 @@
  * For example, if we have two adjacent quads, we will have 6 points and 8 cell indices (4 per quad)
  * Face-varying attributes, even if located on point data will have 8 tuples, and not 6
  * It can be seen as attributes, but this filter will normalize it by outputting 8 points.
- *
+ * When welding, corners with the same point and the same face-varying values share an output
+ * point, so that the two quads above with continuous attributes result in 6 points.
+ * Points and attributes are dispatched in parallel.
  */
 #ifndef vtkF3DFaceVaryingPointDispatcher_h
 #define vtkF3DFaceVaryingPointDispatcher_h
@@ -30,6 +32,17 @@ public:
    */
   static vtkInformationIntegerKey* INTERPOLATION_TYPE();
 
+  ///@{
+  /**
+   * Set/Get if corners with identical points and face-varying attributes are merged into a
+   * single output point.
+   * Default is false.
+   */
+  vtkSetMacro(Weld, bool);
+  vtkGetMacro(Weld, bool);
+  vtkBooleanMacro(Weld, bool);
+  ///@}
+
 protected:
   vtkF3DFaceVaryingPointDispatcher();
   ~vtkF3DFaceVaryingPointDispatcher() override;
@@ -39,6 +52,8 @@ protected:
 private:
   vtkF3DFaceVaryingPointDispatcher(const vtkF3DFaceVaryingPointDispatcher&) = delete;
   void operator=(const vtkF3DFaceVaryingPointDispatcher&) = delete;
+
+  bool Weld = false;
 };
 
 #endif
@@ -1,5 +1,14 @@
 #include "vtkF3DImporter.h"
 
+#include <vtkImageData.h>
+#include <vtkImageShrink3D.h>
+#include <vtkInformationDoubleVectorKey.h>
+#include <vtkNew.h>
+
+#include <algorithm>
+
+vtkInformationKeyRestrictedMacro(vtkF3DImporter, INSTANCE_MATRIX, DoubleVector, 16);
+
 #if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240707)
 
 //----------------------------------------------------------------------------
@@ -31,3 +40,44 @@ void vtkF3DImporter::SetFailureStatus()
   this->SetUpdateStatus(vtkImporter::UpdateStatusEnum::FAILURE);
 #endif
 }
+
+//----------------------------------------------------------------------------
+void vtkF3DImporter::Cancel()
+{
+  this->Cancelled = true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DImporter::IsCancelled() const
+{
+  return this->Cancelled;
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkImageData> vtkF3DImporter::ShrinkTexture(vtkImageData* image, int maximumSize)
+{
+  if (!image || maximumSize <= 0)
+  {
+    return image;
+  }
+
+  int dims[3];
+  image->GetDimensions(dims);
+  const int size = std::max(dims[0], dims[1]);
+  const int factor = (size + maximumSize - 1) / maximumSize;
+  if (factor <= 1)
+  {
+    return image;
+  }
+
+  vtkNew<vtkImageShrink3D> shrink;
+  shrink->SetInputData(image);
+  shrink->SetShrinkFactors(factor, factor, 1);
+  shrink->AveragingOn();
+  shrink->Update();
+
+  vtkSmartPointer<vtkImageData> shrunk = shrink->GetOutput();
+  shrunk->SetOrigin(0.0, 0.0, 0.0);
+  shrunk->SetSpacing(1.0, 1.0, 1.0);
+  return shrunk;
+}
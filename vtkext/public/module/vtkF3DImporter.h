@@ -12,11 +12,20 @@
 #include "vtkextModule.h"
 
 #include <vtkImporter.h>
+#include <vtkSmartPointer.h>
 #include <vtkVersion.h>
 
+#include <atomic>
+#include <string>
+
+class vtkImageData;
+class vtkInformationDoubleVectorKey;
+
 class VTKEXT_EXPORT vtkF3DImporter : public vtkImporter
 {
 public:
+  vtkAbstractTypeMacro(vtkF3DImporter, vtkImporter);
+
 #if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240707)
   /**
    * This method should be reimplemented in importer
@@ -34,6 +43,91 @@ public:
    * by the VTK version in use
    */
   void SetFailureStatus();
+
+  ///@{
+  /**
+   * Set/Get if the geometry should be optimized when imported, eg. by merging the duplicated
+   * vertices and the meshes, at the cost of a longer import.
+   * Importers that do not support it ignore it. Default is false.
+   */
+  vtkSetMacro(OptimizeGeometry, bool);
+  vtkGetMacro(OptimizeGeometry, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the regular expression matching the paths of the prims whose payloads are loaded,
+   * for the formats composing a stage from payloads, eg. USD.
+   * An empty pattern does not load any payload. Default is ".*", loading all of them.
+   */
+  vtkSetMacro(PayloadsPattern, std::string);
+  vtkGetMacro(PayloadsPattern, std::string);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the comma separated paths of the prims to populate, with their ancestors and
+   * descendants, for the formats composing a stage, eg. USD.
+   * Empty populates the whole stage, which is the default.
+   */
+  vtkSetMacro(PopulationMask, std::string);
+  vtkGetMacro(PopulationMask, std::string);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get if the animations and the skinning of the meshes are set up when imported.
+   * Importers that do not support it ignore it. Default is true.
+   */
+  vtkSetMacro(ImportAnimations, bool);
+  vtkGetMacro(ImportAnimations, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the maximum width and height in pixels of the imported textures, larger textures
+   * are shrunk by an integer factor once decoded, eg. to generate thumbnails.
+   * Importers that do not support it ignore it. Default is 0, keeping the textures unchanged.
+   */
+  vtkSetMacro(TextureMaximumSize, int);
+  vtkGetMacro(TextureMaximumSize, int);
+  ///@}
+
+  ///@{
+  /**
+   * Cancel the import, or return if it was cancelled. Cancel can be called from any thread while
+   * the importer is updated on another one, the importers check IsCancelled between the steps
+   * of their import, eg. at each node of the scene, and stop as soon as possible, leaving
+   * a partial scene and setting the failure status if supported.
+   * The geometry readers use the AbortExecute flag of their algorithm instead, see f3d::reader.
+   */
+  void Cancel();
+  bool IsCancelled() const;
+  ///@}
+
+  /**
+   * Return the image shrunk by the smallest integer factor fitting its width and height in
+   * the maximum size, by averaging the pixels, or the image itself if it already fits
+   * or if maximumSize is 0.
+   */
+  static vtkSmartPointer<vtkImageData> ShrinkTexture(vtkImageData* image, int maximumSize);
+
+  /**
+   * Information key of the metadata of a composite dataset block, placing the dataset of the
+   * block with this 4x4 row major matrix. Readers can set the same dataset in several blocks
+   * with different matrices, the instances then share the geometry when imported.
+   */
+  static vtkInformationDoubleVectorKey* INSTANCE_MATRIX();
+
+protected:
+  bool OptimizeGeometry = false;
+  std::string PayloadsPattern = ".*";
+  std::string PopulationMask;
+  bool ImportAnimations = true;
+  int TextureMaximumSize = 0;
+
+private:
+  std::atomic<bool> Cancelled = false;
 };
 
 #endif
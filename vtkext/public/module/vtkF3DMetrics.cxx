@@ -0,0 +1,284 @@
+#include "vtkF3DMetrics.h"
+
+#include <vtkObjectFactory.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iomanip>
+#include <locale>
+#include <map>
+#include <mutex>
+#include <sstream>
+
+namespace
+{
+// upper bounds of the buckets of the histograms, in seconds, the last bucket is unbounded
+constexpr std::array<double, 14> Buckets = { 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25,
+  0.5, 1.0, 2.5, 5.0, 10.0, 60.0 };
+
+enum class Type
+{
+  Counter,
+  Gauge,
+  Histogram
+};
+
+struct Series
+{
+  double Value = 0.0;
+  std::array<std::uint64_t, Buckets.size() + 1> Counts{};
+};
+
+struct Metric
+{
+  Type MetricType;
+  std::map<vtkF3DMetrics::Label, Series> Values;
+};
+
+std::mutex MetricsMutex;
+std::map<std::string, Metric> Metrics;
+
+//----------------------------------------------------------------------------
+/**
+ * Return the series of a metric, or nullptr if the name is already used by another type
+ */
+Series* GetSeries(const std::string& name, const vtkF3DMetrics::Label& label, Type type)
+{
+  Metric& metric = ::Metrics.emplace(name, Metric{ type, {} }).first->second;
+  return metric.MetricType == type ? &metric.Values[label] : nullptr;
+}
+
+//----------------------------------------------------------------------------
+std::string FormatNumber(double value)
+{
+  std::ostringstream stream;
+  stream.imbue(std::locale::classic());
+  stream << std::setprecision(12) << value;
+  return stream.str();
+}
+
+//----------------------------------------------------------------------------
+std::string Escape(const std::string& str)
+{
+  std::string escaped;
+  escaped.reserve(str.size());
+  for (char c : str)
+  {
+    if (c == '"' || c == '\\')
+    {
+      escaped += '\\';
+      escaped += c;
+    }
+    else if (c == '\n')
+    {
+      escaped += "\\n";
+    }
+    else if (static_cast<unsigned char>(c) < 0x20)
+    {
+      escaped += ' ';
+    }
+    else
+    {
+      escaped += c;
+    }
+  }
+  return escaped;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * Format the labels of a Prometheus sample, with an additional label if not empty
+ */
+std::string FormatLabels(const vtkF3DMetrics::Label& label, const std::string& extra = {})
+{
+  std::string labels;
+  if (!label.first.empty())
+  {
+    labels += label.first + "=\"" + ::Escape(label.second) + "\"";
+  }
+  if (!extra.empty())
+  {
+    labels += (labels.empty() ? "" : ",") + extra;
+  }
+  return labels.empty() ? labels : "{" + labels + "}";
+}
+
+//----------------------------------------------------------------------------
+const char* GetTypeName(Type type)
+{
+  switch (type)
+  {
+    case Type::Counter:
+      return "counter";
+    case Type::Gauge:
+      return "gauge";
+    default:
+      return "histogram";
+  }
+}
+
+//----------------------------------------------------------------------------
+std::uint64_t GetTotalCount(const Series& series)
+{
+  std::uint64_t count = 0;
+  for (std::uint64_t bucketCount : series.Counts)
+  {
+    count += bucketCount;
+  }
+  return count;
+}
+}
+
+//----------------------------------------------------------------------------
+vtkStandardNewMacro(vtkF3DMetrics);
+
+//----------------------------------------------------------------------------
+void vtkF3DMetrics::Increment(const std::string& name, const Label& label, double value)
+{
+  const std::lock_guard<std::mutex> lock(::MetricsMutex);
+  if (Series* series = ::GetSeries(name, label, ::Type::Counter))
+  {
+    series->Value += std::max(value, 0.0);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DMetrics::SetGauge(const std::string& name, double value, const Label& label)
+{
+  const std::lock_guard<std::mutex> lock(::MetricsMutex);
+  if (Series* series = ::GetSeries(name, label, ::Type::Gauge))
+  {
+    series->Value = value;
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DMetrics::Observe(const std::string& name, double seconds, const Label& label)
+{
+  const std::size_t bucket = static_cast<std::size_t>(
+    std::lower_bound(::Buckets.begin(), ::Buckets.end(), seconds) - ::Buckets.begin());
+
+  const std::lock_guard<std::mutex> lock(::MetricsMutex);
+  if (Series* series = ::GetSeries(name, label, ::Type::Histogram))
+  {
+    series->Value += seconds;
+    series->Counts[bucket]++;
+  }
+}
+
+//----------------------------------------------------------------------------
+double vtkF3DMetrics::GetValue(const std::string& name, const Label& label)
+{
+  const std::lock_guard<std::mutex> lock(::MetricsMutex);
+  auto metric = ::Metrics.find(name);
+  if (metric == ::Metrics.end())
+  {
+    return 0.0;
+  }
+  auto series = metric->second.Values.find(label);
+  if (series == metric->second.Values.end())
+  {
+    return 0.0;
+  }
+  return metric->second.MetricType == ::Type::Histogram
+    ? static_cast<double>(::GetTotalCount(series->second))
+    : series->second.Value;
+}
+
+//----------------------------------------------------------------------------
+std::string vtkF3DMetrics::ToPrometheus()
+{
+  const std::lock_guard<std::mutex> lock(::MetricsMutex);
+  std::string text;
+  for (const auto& [name, metric] : ::Metrics)
+  {
+    text += "# TYPE " + name + " " + ::GetTypeName(metric.MetricType) + "\n";
+    for (const auto& [label, series] : metric.Values)
+    {
+      if (metric.MetricType != ::Type::Histogram)
+      {
+        text += name + ::FormatLabels(label) + " " + ::FormatNumber(series.Value) + "\n";
+        continue;
+      }
+
+      // the buckets are cumulative
+      std::uint64_t count = 0;
+      for (std::size_t i = 0; i < series.Counts.size(); i++)
+      {
+        count += series.Counts[i];
+        const std::string bound = i < ::Buckets.size() ? ::FormatNumber(::Buckets[i]) : "+Inf";
+        text += name + "_bucket" + ::FormatLabels(label, "le=\"" + bound + "\"") + " " +
+          std::to_string(count) + "\n";
+      }
+      text += name + "_sum" + ::FormatLabels(label) + " " + ::FormatNumber(series.Value) + "\n";
+      text += name + "_count" + ::FormatLabels(label) + " " + std::to_string(count) + "\n";
+    }
+  }
+  return text;
+}
+
+//----------------------------------------------------------------------------
+std::string vtkF3DMetrics::ToJSON()
+{
+  const std::lock_guard<std::mutex> lock(::MetricsMutex);
+  std::string json = "{";
+  for (auto metric = ::Metrics.begin(); metric != ::Metrics.end(); ++metric)
+  {
+    json += std::string(metric == ::Metrics.begin() ? "" : ",") + "\"" + ::Escape(metric->first) +
+      "\":{\"type\":\"" + ::GetTypeName(metric->second.MetricType) + "\",\"values\":[";
+    for (auto series = metric->second.Values.begin(); series != metric->second.Values.end();
+         ++series)
+    {
+      const Label& label = series->first;
+      json += std::string(series == metric->second.Values.begin() ? "" : ",") + "{\"labels\":{";
+      if (!label.first.empty())
+      {
+        json += "\"" + ::Escape(label.first) + "\":\"" + ::Escape(label.second) + "\"";
+      }
+      json += "}";
+
+      if (metric->second.MetricType != ::Type::Histogram)
+      {
+        json += ",\"value\":" + ::FormatNumber(series->second.Value) + "}";
+        continue;
+      }
+
+      // the buckets are not cumulative, unlike the Prometheus ones
+      json += ",\"count\":" + std::to_string(::GetTotalCount(series->second)) +
+        ",\"sum\":" + ::FormatNumber(series->second.Value) + ",\"buckets\":{";
+      for (std::size_t i = 0; i < series->second.Counts.size(); i++)
+      {
+        const std::string bound = i < ::Buckets.size() ? ::FormatNumber(::Buckets[i]) : "+Inf";
+        json += std::string(i > 0 ? "," : "") + "\"" + bound +
+          "\":" + std::to_string(series->second.Counts[i]);
+      }
+      json += "}}";
+    }
+    json += "]}";
+  }
+  json += "}";
+  return json;
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DMetrics::Reset()
+{
+  const std::lock_guard<std::mutex> lock(::MetricsMutex);
+  ::Metrics.clear();
+}
+
+//----------------------------------------------------------------------------
+vtkF3DMetrics::Timer::Timer(const char* name, Label label)
+  : Name(name)
+  , TimerLabel(std::move(label))
+  , Start(std::chrono::steady_clock::now())
+{
+}
+
+//----------------------------------------------------------------------------
+vtkF3DMetrics::Timer::~Timer()
+{
+  const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - this->Start;
+  vtkF3DMetrics::Observe(this->Name, duration.count(), this->TimerLabel);
+}
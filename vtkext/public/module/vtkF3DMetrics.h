@@ -0,0 +1,100 @@
+/**
+ * @class   vtkF3DMetrics
+ * @brief   Registry of the operational metrics shared between libf3d and plugins
+ *
+ * This class accumulates counters, gauges and histograms of durations, identified by their
+ * name and an optional label, eg. the loads of a reader or the hits of a cache, so that a
+ * long-running process rendering many files can be monitored.
+ * The metrics are exported in the Prometheus text exposition format, or in JSON.
+ * Unlike vtkF3DTrace, the metrics are always recorded, each record only locks a mutex
+ * and updates a value, so they must not be recorded in tight loops.
+ * A name is of the type of its first record, the records of another type are ignored.
+ * All static methods are thread safe.
+ */
+
+#ifndef vtkF3DMetrics_h
+#define vtkF3DMetrics_h
+
+#include "vtkextModule.h"
+
+#include <vtkObject.h>
+
+#include <chrono>
+#include <string>
+#include <utility>
+
+class VTKEXT_EXPORT vtkF3DMetrics : public vtkObject
+{
+public:
+  static vtkF3DMetrics* New();
+  vtkTypeMacro(vtkF3DMetrics, vtkObject);
+
+  /**
+   * The name and value of the label of a record, eg. `{ "reader", "STL" }`,
+   * the records without label use an empty name
+   */
+  using Label = std::pair<std::string, std::string>;
+
+  /**
+   * Add a value to a counter, which is never decreased
+   */
+  static void Increment(const std::string& name, const Label& label = {}, double value = 1.0);
+
+  /**
+   * Set the current value of a gauge
+   */
+  static void SetGauge(const std::string& name, double value, const Label& label = {});
+
+  /**
+   * Add a duration in seconds in a histogram, counted in fixed buckets from 1 ms to 1 min
+   */
+  static void Observe(const std::string& name, double seconds, const Label& label = {});
+
+  /**
+   * Return the value of a counter or a gauge, or the number of durations of a histogram,
+   * 0 if nothing was recorded
+   */
+  static double GetValue(const std::string& name, const Label& label = {});
+
+  /**
+   * Return all the metrics in the Prometheus text exposition format
+   */
+  static std::string ToPrometheus();
+
+  /**
+   * Return all the metrics in a JSON object, by name, with their type and their values by label
+   */
+  static std::string ToJSON();
+
+  /**
+   * Forget all the metrics
+   */
+  static void Reset();
+
+  /**
+   * A duration observed in a histogram from its construction to its destruction
+   */
+  class VTKEXT_EXPORT Timer
+  {
+  public:
+    explicit Timer(const char* name, Label label = {});
+    ~Timer();
+    Timer(const Timer&) = delete;
+    Timer& operator=(const Timer&) = delete;
+
+  private:
+    const char* Name;
+    Label TimerLabel;
+    std::chrono::steady_clock::time_point Start;
+  };
+
+protected:
+  vtkF3DMetrics() = default;
+  ~vtkF3DMetrics() override = default;
+
+private:
+  vtkF3DMetrics(const vtkF3DMetrics&) = delete;
+  void operator=(const vtkF3DMetrics&) = delete;
+};
+
+#endif
@@ -0,0 +1,275 @@
+#include "vtkF3DRadixSort.h"
+
+#include "vtkF3DRadixSortFunctions.h"
+#include "vtkF3DRadixSortHistogramCS.h"
+#include "vtkF3DRadixSortScanCS.h"
+#include "vtkF3DRadixSortScatterCS.h"
+
+#include <vtkObjectFactory.h>
+#include <vtkOpenGLBufferObject.h>
+#include <vtkOpenGLRenderWindow.h>
+#include <vtkOpenGLShaderCache.h>
+#include <vtkShader.h>
+#include <vtkShaderProgram.h>
+#include <vtkVersion.h>
+
+#if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240914)
+#include <vtk_glad.h>
+#else
+#include <vtk_glew.h>
+#endif
+
+#include <algorithm>
+#include <limits>
+#include <sstream>
+
+namespace
+{
+constexpr int RadixBits = 8;
+constexpr int RadixBins = 1 << RadixBits;
+constexpr int TilesPerWorkgroup = 16;
+}
+
+//----------------------------------------------------------------------------
+vtkStandardNewMacro(vtkF3DRadixSort);
+
+//----------------------------------------------------------------------------
+bool vtkF3DRadixSort::Initialize(int workgroupSize, int keyType, int valueType)
+{
+  if (workgroupSize < RadixBins)
+  {
+    vtkErrorMacro("Invalid workgroupSize");
+    return false;
+  }
+
+  auto GetStringShaderType = [](int vtkType) -> std::string
+  {
+    switch (vtkType)
+    {
+      case VTK_INT:
+        return "int";
+      case VTK_UNSIGNED_INT:
+        return "uint";
+      case VTK_FLOAT:
+        return "float";
+    }
+    return "";
+  };
+
+  std::string keyTypeShader = GetStringShaderType(keyType);
+  if (keyTypeShader.empty())
+  {
+    vtkErrorMacro("Invalid keyType");
+    return false;
+  }
+
+  std::string valueTypeShader = GetStringShaderType(valueType);
+  if (valueTypeShader.empty())
+  {
+    vtkErrorMacro("Invalid valueType");
+    return false;
+  }
+
+  std::stringstream defines;
+  defines << "#define KeyType " << keyTypeShader << "\n";
+  defines << "#define ValueType " << valueTypeShader << "\n";
+  defines << "#define WorkgroupSize " << workgroupSize << "\n";
+  defines << "#define RadixBits " << RadixBits << "u\n";
+  defines << "#define RadixBins " << RadixBins << "u\n";
+  defines << "#define TilesPerWorkgroup " << TilesPerWorkgroup << "u\n";
+  if (keyType == VTK_FLOAT)
+  {
+    defines << "#define KEY_IS_FLOAT\n";
+  }
+  else if (keyType == VTK_INT)
+  {
+    defines << "#define KEY_IS_INT\n";
+  }
+
+  auto SetupProgram = [&](const char* source, vtkShader* shader, vtkShaderProgram* program)
+  {
+    std::string code = source;
+    vtkShaderProgram::Substitute(code, "//VTK::RadixFunctions::Dec", vtkF3DRadixSortFunctions);
+    vtkShaderProgram::Substitute(code, "//VTK::RadixDefines::Dec", defines.str());
+    shader->SetType(vtkShader::Compute);
+    shader->SetSource(code);
+    program->SetComputeShader(shader);
+  };
+
+  SetupProgram(vtkF3DRadixSortHistogramCS, this->RadixSortHistogramComputeShader,
+    this->RadixSortHistogramProgram);
+  SetupProgram(
+    vtkF3DRadixSortScanCS, this->RadixSortScanComputeShader, this->RadixSortScanProgram);
+  SetupProgram(vtkF3DRadixSortScatterCS, this->RadixSortScatterComputeShader,
+    this->RadixSortScatterProgram);
+
+  // All supported types are 32-bit
+  this->KeySize = 4;
+  this->ValueSize = 4;
+  this->WorkgroupSize = workgroupSize;
+
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DRadixSort::Run(vtkOpenGLRenderWindow* context, int nbPairs,
+  vtkOpenGLBufferObject* keys, vtkOpenGLBufferObject* values)
+{
+  this->ResetIncremental();
+  bool finished;
+  return this->RunIncremental(context, nbPairs, keys, values, 0, finished);
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DRadixSort::ResetIncremental()
+{
+  this->InProgress = false;
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DRadixSort::IsIncrementalSortInProgress() const
+{
+  return this->InProgress;
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DRadixSort::RunIncremental(vtkOpenGLRenderWindow* context, int nbPairs,
+  vtkOpenGLBufferObject* keys, vtkOpenGLBufferObject* values, int budget, bool& finished)
+{
+  finished = false;
+
+  if (this->WorkgroupSize < 0)
+  {
+    vtkErrorMacro("Shaders are not initialized");
+    return false;
+  }
+
+  if (nbPairs <= 1)
+  {
+    this->InProgress = false;
+    finished = true;
+    return true;
+  }
+
+  vtkOpenGLShaderCache* shaderCache = context->GetShaderCache();
+
+  const unsigned int elementsPerWorkgroup = this->WorkgroupSize * TilesPerWorkgroup;
+  const unsigned int workgroupCount = (nbPairs + elementsPerWorkgroup - 1) / elementsPerWorkgroup;
+  const int histogramsCount = RadixBins * workgroupCount;
+
+  if (!this->InProgress)
+  {
+    // allocate temporary buffers only when growing
+    auto Reserve = [](vtkOpenGLBufferObject* buffer, size_t& currentSize, size_t size)
+    {
+      if (currentSize < size)
+      {
+        buffer->Allocate(
+          size, vtkOpenGLBufferObject::ArrayBuffer, vtkOpenGLBufferObject::DynamicCopy);
+        currentSize = size;
+      }
+    };
+    Reserve(this->TemporaryKeys, this->TemporaryKeysSize, nbPairs * this->KeySize);
+    Reserve(this->TemporaryValues, this->TemporaryValuesSize, nbPairs * this->ValueSize);
+    Reserve(this->Histograms, this->HistogramsSize, histogramsCount * sizeof(unsigned int));
+
+    this->InProgress = true;
+    this->CurrentPass = 0;
+    this->CurrentStage = 0;
+    this->CurrentWorkgroup = 0;
+  }
+
+  // the budget is converted into a number of workgroups, at least one is processed per call
+  long long remaining = budget > 0 ? budget : std::numeric_limits<long long>::max();
+
+  // dispatch histogram or scatter on a range of workgroups
+  auto DispatchRange = [&](vtkShaderProgram* program, int shift) -> bool
+  {
+    unsigned int count = workgroupCount - this->CurrentWorkgroup;
+    if (budget > 0)
+    {
+      count = std::min<unsigned int>(count,
+        std::max<unsigned int>(static_cast<unsigned int>(remaining / elementsPerWorkgroup), 1));
+    }
+    if (!shaderCache->ReadyShaderProgram(program))
+    {
+      return false;
+    }
+    program->SetUniformi("count", nbPairs);
+    program->SetUniformi("shift", shift);
+    program->SetUniformi("workgroupOffset", static_cast<int>(this->CurrentWorkgroup));
+    program->SetUniformi("workgroupCount", static_cast<int>(workgroupCount));
+    glDispatchCompute(count, 1, 1);
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+    this->CurrentWorkgroup += count;
+    remaining -= static_cast<long long>(count) * elementsPerWorkgroup;
+    return true;
+  };
+
+  while (this->InProgress && remaining > 0)
+  {
+    // an even number of passes ensures the result ends up in the input buffers
+    const bool even = this->CurrentPass % 2 == 0;
+    vtkOpenGLBufferObject* keysIn = even ? keys : this->TemporaryKeys.Get();
+    vtkOpenGLBufferObject* valuesIn = even ? values : this->TemporaryValues.Get();
+    vtkOpenGLBufferObject* keysOut = even ? this->TemporaryKeys.Get() : keys;
+    vtkOpenGLBufferObject* valuesOut = even ? this->TemporaryValues.Get() : values;
+
+    keysIn->BindShaderStorage(0);
+    valuesIn->BindShaderStorage(1);
+    keysOut->BindShaderStorage(2);
+    valuesOut->BindShaderStorage(3);
+    this->Histograms->BindShaderStorage(4);
+
+    const int shift = this->CurrentPass * RadixBits;
+
+    if (this->CurrentStage == 0)
+    {
+      if (!DispatchRange(this->RadixSortHistogramProgram, shift))
+      {
+        vtkErrorMacro("Cannot compile the histogram shader");
+        this->InProgress = false;
+        return false;
+      }
+      if (this->CurrentWorkgroup == workgroupCount)
+      {
+        this->CurrentStage = 1;
+      }
+    }
+    else if (this->CurrentStage == 1)
+    {
+      if (!shaderCache->ReadyShaderProgram(this->RadixSortScanProgram))
+      {
+        vtkErrorMacro("Cannot compile the scan shader");
+        this->InProgress = false;
+        return false;
+      }
+      this->RadixSortScanProgram->SetUniformi("total", histogramsCount);
+      glDispatchCompute(1, 1, 1);
+      glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+      this->CurrentStage = 2;
+      this->CurrentWorkgroup = 0;
+    }
+    else
+    {
+      if (!DispatchRange(this->RadixSortScatterProgram, shift))
+      {
+        vtkErrorMacro("Cannot compile the scatter shader");
+        this->InProgress = false;
+        return false;
+      }
+      if (this->CurrentWorkgroup == workgroupCount)
+      {
+        this->CurrentStage = 0;
+        this->CurrentWorkgroup = 0;
+        this->CurrentPass++;
+        this->InProgress = this->CurrentPass < 32 / RadixBits;
+      }
+    }
+  }
+
+  finished = !this->InProgress;
+  return true;
+}
@@ -0,0 +1,101 @@
+/**
+ * @class   vtkF3DRadixSort
+ * @brief   Compute shader used to sort key/value pairs
+ *
+ * This class is used to sort buffers based on a least significant digit radix sort,
+ * processing 8 bits of the 32-bit keys per pass.
+ * Contrary to vtkF3DBitonicSort, the number of pairs does not need to be padded to a power
+ * of two and the complexity is linear, but two temporary buffers of the size of the input
+ * buffers are allocated.
+ * Each pass computes a histogram of the digits per workgroup, scans the histograms and
+ * scatters the pairs using a stable local sort of each tile in shared memory,
+ * so that only core OpenGL 4.3 features are required.
+ */
+#ifndef vtkF3DRadixSort_h
+#define vtkF3DRadixSort_h
+
+#include <vtkNew.h>
+#include <vtkObject.h>
+
+#include "vtkextModule.h"
+
+class vtkShader;
+class vtkShaderProgram;
+class vtkOpenGLBufferObject;
+class vtkOpenGLRenderWindow;
+
+class VTKEXT_EXPORT vtkF3DRadixSort : public vtkObject
+{
+public:
+  static vtkF3DRadixSort* New();
+  vtkTypeMacro(vtkF3DRadixSort, vtkObject);
+
+  /**
+   * Initialize the compute shaders.
+   * workgroupSize is the number of threads running in a single GPU workgroup,
+   * it must be at least 256, the number of digits of a pass
+   * keyType and valueType are the VTK types of the key and value to sort respectively
+   * Only VTK_FLOAT, VTK_INT and VTK_UNSIGNED_INT are supported
+   * Returns true if succeeded
+   */
+  bool Initialize(int workgroupSize, int keyType, int valueType);
+
+  /**
+   * Run the compute shader and sort the buffers.
+   * An OpenGL context must exists and given as input in the first argument
+   * nbPairs is the number of element in the buffer keys and values
+   * OpenGL buffers keys and values must be valid and containing data types specified when
+   * this class has been initialized
+   * Returns true if succeeded
+   */
+  bool Run(vtkOpenGLRenderWindow* context, int nbPairs, vtkOpenGLBufferObject* keys,
+    vtkOpenGLBufferObject* values);
+
+  /**
+   * Advance the sort of the buffers by processing approximately budget pairs, so that a sort
+   * can be spread across several frames. A new sort is started if none is in progress.
+   * The same buffers and nbPairs must be provided until finished is set to true,
+   * the buffers are not sorted, nor in their original order, until then.
+   * A budget lower or equal to zero finishes the sort in a single call.
+   * Returns true if succeeded
+   */
+  bool RunIncremental(vtkOpenGLRenderWindow* context, int nbPairs, vtkOpenGLBufferObject* keys,
+    vtkOpenGLBufferObject* values, int budget, bool& finished);
+
+  /**
+   * Abandon the sort in progress if any, the next call to RunIncremental will start a new one.
+   */
+  void ResetIncremental();
+
+  /**
+   * Return true if a sort started with RunIncremental is not finished yet
+   */
+  bool IsIncrementalSortInProgress() const;
+
+private:
+  vtkNew<vtkShader> RadixSortHistogramComputeShader;
+  vtkNew<vtkShaderProgram> RadixSortHistogramProgram;
+  vtkNew<vtkShader> RadixSortScanComputeShader;
+  vtkNew<vtkShaderProgram> RadixSortScanProgram;
+  vtkNew<vtkShader> RadixSortScatterComputeShader;
+  vtkNew<vtkShaderProgram> RadixSortScatterProgram;
+
+  vtkNew<vtkOpenGLBufferObject> TemporaryKeys;
+  vtkNew<vtkOpenGLBufferObject> TemporaryValues;
+  vtkNew<vtkOpenGLBufferObject> Histograms;
+  size_t TemporaryKeysSize = 0;
+  size_t TemporaryValuesSize = 0;
+  size_t HistogramsSize = 0;
+
+  // State of the incremental sort, a stage is either a histogram, a scan or a scatter
+  bool InProgress = false;
+  int CurrentPass = 0;
+  int CurrentStage = 0;
+  unsigned int CurrentWorkgroup = 0;
+
+  int WorkgroupSize = -1;
+  int KeySize = 0;
+  int ValueSize = 0;
+};
+
+#endif
@@ -0,0 +1,363 @@
+#include "vtkF3DReadAhead.h"
+
+#include "vtkF3DCache.h"
+#include "vtkF3DMetrics.h"
+
+#include <vtkObjectFactory.h>
+#include <vtksys/FStream.hxx>
+#include <vtksys/MD5.h>
+#include <vtksys/SystemTools.hxx>
+
+#ifdef _WIN32
+#include <vtksys/Encoding.hxx>
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#if defined(__APPLE__) || defined(__FreeBSD__)
+#include <sys/mount.h>
+#include <sys/param.h>
+#elif defined(__linux__)
+#include <sys/vfs.h>
+#endif
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <sstream>
+#include <thread>
+
+namespace
+{
+// the size of the positioned reads, and how many of them are in flight
+constexpr std::uint64_t BlockSize = 8 << 20;
+constexpr std::uint64_t MaxRequests = 8;
+constexpr std::size_t StreamBufferSize = 4 << 20;
+
+//----------------------------------------------------------------------------
+/**
+ * A file read or written at any offset, without a shared position so that
+ * several threads can use their own instance on the same file
+ */
+class PositionedFile
+{
+public:
+  PositionedFile(const std::string& filePath, bool write)
+  {
+#ifdef _WIN32
+    this->Handle = CreateFileW(vtksys::Encoding::ToWindowsExtendedPath(filePath).c_str(),
+      write ? GENERIC_WRITE : GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+      nullptr, write ? OPEN_ALWAYS : OPEN_EXISTING,
+      write ? FILE_ATTRIBUTE_NORMAL : FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+#else
+    this->Descriptor =
+      write ? open(filePath.c_str(), O_WRONLY | O_CREAT, 0644) : open(filePath.c_str(), O_RDONLY);
+#endif
+  }
+
+  ~PositionedFile()
+  {
+#ifdef _WIN32
+    if (this->Handle != INVALID_HANDLE_VALUE)
+    {
+      CloseHandle(this->Handle);
+    }
+#else
+    if (this->Descriptor >= 0)
+    {
+      close(this->Descriptor);
+    }
+#endif
+  }
+
+  PositionedFile(const PositionedFile&) = delete;
+  PositionedFile& operator=(const PositionedFile&) = delete;
+
+  bool IsOpen() const
+  {
+#ifdef _WIN32
+    return this->Handle != INVALID_HANDLE_VALUE;
+#else
+    return this->Descriptor >= 0;
+#endif
+  }
+
+  bool ReadAt(unsigned char* data, std::uint64_t count, std::uint64_t offset)
+  {
+    while (count > 0 && this->IsOpen())
+    {
+#ifdef _WIN32
+      OVERLAPPED overlapped{};
+      overlapped.Offset = static_cast<DWORD>(offset);
+      overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+      DWORD read = 0;
+      if (!::ReadFile(this->Handle, data,
+            static_cast<DWORD>(std::min<std::uint64_t>(count, 1 << 30)), &read, &overlapped) ||
+        read == 0)
+      {
+        return false;
+      }
+#else
+      const ssize_t read = pread(this->Descriptor, data, count, static_cast<off_t>(offset));
+      if (read < 0 && errno == EINTR)
+      {
+        continue;
+      }
+      if (read <= 0)
+      {
+        return false;
+      }
+#endif
+      data += read;
+      count -= read;
+      offset += read;
+    }
+    return count == 0;
+  }
+
+  bool WriteAt(const unsigned char* data, std::uint64_t count, std::uint64_t offset)
+  {
+    while (count > 0 && this->IsOpen())
+    {
+#ifdef _WIN32
+      OVERLAPPED overlapped{};
+      overlapped.Offset = static_cast<DWORD>(offset);
+      overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+      DWORD written = 0;
+      if (!::WriteFile(this->Handle, data,
+            static_cast<DWORD>(std::min<std::uint64_t>(count, 1 << 30)), &written, &overlapped) ||
+        written == 0)
+      {
+        return false;
+      }
+#else
+      const ssize_t written = pwrite(this->Descriptor, data, count, static_cast<off_t>(offset));
+      if (written < 0 && errno == EINTR)
+      {
+        continue;
+      }
+      if (written <= 0)
+      {
+        return false;
+      }
+#endif
+      data += written;
+      count -= written;
+      offset += written;
+    }
+    return count == 0;
+  }
+
+private:
+#ifdef _WIN32
+  HANDLE Handle = INVALID_HANDLE_VALUE;
+#else
+  int Descriptor = -1;
+#endif
+};
+
+//----------------------------------------------------------------------------
+/**
+ * Process the blocks of a file of the provided size on up to MaxRequests threads, each of them
+ * creating its worker with makeWorker, called with the offset and the size of its blocks.
+ * Return false as soon as a worker fails.
+ */
+bool ForEachBlock(std::uint64_t size,
+  const std::function<std::function<bool(std::uint64_t, std::uint64_t)>()>& makeWorker)
+{
+  const std::uint64_t nbBlocks = (size + ::BlockSize - 1) / ::BlockSize;
+  std::atomic<std::uint64_t> next = 0;
+  std::atomic<bool> failed = false;
+  auto run = [&]()
+  {
+    const std::function<bool(std::uint64_t, std::uint64_t)> worker = makeWorker();
+    for (std::uint64_t i = next++; i < nbBlocks && !failed; i = next++)
+    {
+      const std::uint64_t offset = i * ::BlockSize;
+      if (!worker(offset, std::min(::BlockSize, size - offset)))
+      {
+        failed = true;
+      }
+    }
+  };
+
+  const std::uint64_t nbThreads = std::min(::MaxRequests, nbBlocks);
+  if (nbThreads <= 1)
+  {
+    run();
+    return !failed;
+  }
+
+  std::vector<std::thread> threads;
+  for (std::uint64_t t = 0; t < nbThreads; t++)
+  {
+    threads.emplace_back(run);
+  }
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+  return !failed;
+}
+
+//----------------------------------------------------------------------------
+std::string ComputeKeyHash(const std::string& key)
+{
+  vtksysMD5* md5 = vtksysMD5_New();
+  vtksysMD5_Initialize(md5);
+  vtksysMD5_Append(
+    md5, reinterpret_cast<const unsigned char*>(key.data()), static_cast<int>(key.size()));
+  char hash[33];
+  hash[32] = '\0';
+  vtksysMD5_FinalizeHex(md5, hash);
+  vtksysMD5_Delete(md5);
+  return hash;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * A file stream owning its buffer, which must be set before the file is opened
+ */
+class BufferedFileStream : public vtksys::ifstream
+{
+public:
+  explicit BufferedFileStream(const std::string& filePath)
+    : Buffer(::StreamBufferSize)
+  {
+    this->rdbuf()->pubsetbuf(
+      this->Buffer.data(), static_cast<std::streamsize>(this->Buffer.size()));
+    this->open(filePath.c_str(), std::ios_base::binary);
+  }
+
+private:
+  std::vector<char> Buffer;
+};
+}
+
+//----------------------------------------------------------------------------
+vtkStandardNewMacro(vtkF3DReadAhead);
+
+//----------------------------------------------------------------------------
+bool vtkF3DReadAhead::IsOnNetworkFileSystem(const std::string& filePath)
+{
+#ifdef _WIN32
+  const std::wstring path = vtksys::Encoding::ToWindowsExtendedPath(filePath);
+  if (path.compare(0, 8, L"\\\\?\\UNC\\") == 0)
+  {
+    return true;
+  }
+  wchar_t volume[MAX_PATH];
+  return GetVolumePathNameW(path.c_str(), volume, MAX_PATH) &&
+    GetDriveTypeW(volume) == DRIVE_REMOTE;
+#elif defined(__APPLE__) || defined(__FreeBSD__)
+  struct statfs fs;
+  return statfs(filePath.c_str(), &fs) == 0 && !(fs.f_flags & MNT_LOCAL);
+#elif defined(__linux__)
+  struct statfs fs;
+  if (statfs(filePath.c_str(), &fs) != 0)
+  {
+    return false;
+  }
+
+  // the magic numbers of NFS, SMB, CIFS, SMB2, AFS, Ceph and 9P from linux/magic.h
+  const std::uint32_t type = static_cast<std::uint32_t>(fs.f_type);
+  return type == 0x6969 || type == 0x517B || type == 0xFF534D42 || type == 0xFE534D42 ||
+    type == 0x5346414F || type == 0x00C36400 || type == 0x01021997;
+#else
+  (void)filePath;
+  return false;
+#endif
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DReadAhead::ReadFile(const std::string& filePath, std::vector<unsigned char>& buffer)
+{
+  if (!vtksys::SystemTools::FileExists(filePath, true))
+  {
+    return false;
+  }
+
+  buffer.resize(vtksys::SystemTools::FileLength(filePath));
+  return ::ForEachBlock(buffer.size(),
+    [&]()
+    {
+      auto file = std::make_shared<::PositionedFile>(filePath, false);
+      return [&buffer, file](std::uint64_t offset, std::uint64_t count)
+      { return file->ReadAt(buffer.data() + offset, count, offset); };
+    });
+}
+
+//----------------------------------------------------------------------------
+std::string vtkF3DReadAhead::GetLocalCopy(const std::string& filePath)
+{
+  const std::string directory = vtkF3DCache::GetDirectory();
+  if (directory.empty() || !vtksys::SystemTools::FileExists(filePath, true) ||
+    !vtkF3DReadAhead::IsOnNetworkFileSystem(filePath))
+  {
+    return filePath;
+  }
+
+  const std::uint64_t size = vtksys::SystemTools::FileLength(filePath);
+  std::stringstream key;
+  key << vtksys::SystemTools::CollapseFullPath(filePath) << "|" << size << "|"
+      << vtksys::SystemTools::ModifiedTime(filePath);
+  const std::string copyDirectory = directory + "/remote/" + ::ComputeKeyHash(key.str());
+  const std::string copyPath =
+    copyDirectory + "/" + vtksys::SystemTools::GetFilenameName(filePath);
+
+  if (vtksys::SystemTools::FileExists(copyPath, true) &&
+    vtksys::SystemTools::FileLength(copyPath) == size)
+  {
+    vtkF3DMetrics::Increment("f3d_cache_hits_total", { "cache", "remote" });
+    return copyPath;
+  }
+  vtkF3DMetrics::Increment("f3d_cache_misses_total", { "cache", "remote" });
+
+  // the copy is renamed once complete, so that concurrent processes never read a partial copy
+  std::stringstream tmpPath;
+  tmpPath << copyPath << "." << std::hash<std::thread::id>()(std::this_thread::get_id()) << "."
+          << std::chrono::steady_clock::now().time_since_epoch().count() << ".tmp";
+  if (!vtksys::SystemTools::MakeDirectory(copyDirectory))
+  {
+    return filePath;
+  }
+  vtksys::ofstream(tmpPath.str().c_str(), std::ios_base::binary | std::ios_base::trunc).close();
+
+  const bool copied = ::ForEachBlock(size,
+    [&]()
+    {
+      auto source = std::make_shared<::PositionedFile>(filePath, false);
+      auto destination = std::make_shared<::PositionedFile>(tmpPath.str(), true);
+      auto block = std::make_shared<std::vector<unsigned char>>(::BlockSize);
+      return [source, destination, block](std::uint64_t offset, std::uint64_t count)
+      {
+        return source->ReadAt(block->data(), count, offset) &&
+          destination->WriteAt(block->data(), count, offset);
+      };
+    });
+
+  if (!copied || !vtksys::SystemTools::RenameFile(tmpPath.str(), copyPath))
+  {
+    vtksys::SystemTools::RemoveFile(tmpPath.str());
+
+    // another process may have copied the file concurrently
+    return vtksys::SystemTools::FileExists(copyPath, true) &&
+        vtksys::SystemTools::FileLength(copyPath) == size
+      ? copyPath
+      : filePath;
+  }
+  return copyPath;
+}
+
+//----------------------------------------------------------------------------
+std::unique_ptr<std::istream> vtkF3DReadAhead::OpenStream(const std::string& filePath)
+{
+  return std::make_unique<::BufferedFileStream>(vtkF3DReadAhead::GetLocalCopy(filePath));
+}
@@ -0,0 +1,70 @@
+/**
+ * @class   vtkF3DReadAhead
+ * @brief   Reads of the files on network filesystems shared between libf3d and plugins
+ *
+ * Readers issuing many small synchronous reads are much slower on network filesystems,
+ * eg. NFS or SMB, where each read is a round trip to the server.
+ * This class reads whole files with large positioned reads kept in flight concurrently,
+ * and copies the files on network filesystems to the cache directory, see vtkF3DCache,
+ * so that the readers reading them by name read a local copy instead.
+ * The readers reading a stream can open it with OpenStream instead.
+ * All static methods are thread safe.
+ */
+
+#ifndef vtkF3DReadAhead_h
+#define vtkF3DReadAhead_h
+
+#include "vtkextModule.h"
+
+#include <vtkObject.h>
+
+#include <istream>
+#include <memory>
+#include <string>
+#include <vector>
+
+class VTKEXT_EXPORT vtkF3DReadAhead : public vtkObject
+{
+public:
+  static vtkF3DReadAhead* New();
+  vtkTypeMacro(vtkF3DReadAhead, vtkObject);
+
+  /**
+   * Return true if the file is on a network filesystem, eg. NFS, SMB or a mapped network drive,
+   * false if it is local or if it cannot be known.
+   */
+  static bool IsOnNetworkFileSystem(const std::string& filePath);
+
+  /**
+   * Read the whole file in the buffer, with blocks of 8 MiB read concurrently so that several
+   * requests are in flight on network filesystems.
+   * Return false if the file cannot be read.
+   */
+  static bool ReadFile(const std::string& filePath, std::vector<unsigned char>& buffer);
+
+  /**
+   * Return the path of a local copy of a file on a network filesystem, in the cache directory,
+   * keyed by the path, the size and the modification time of the file so that it is copied
+   * again once it changes. The copy keeps the file name, but not the files it references.
+   * Return the file path itself if the file is local, if there is no cache directory
+   * or if the copy fails.
+   */
+  static std::string GetLocalCopy(const std::string& filePath);
+
+  /**
+   * Open a binary stream on the local copy of the file, see GetLocalCopy, with a buffer
+   * of 4 MiB so that it is read in few requests. Check the state of the stream to know
+   * if it was opened.
+   */
+  static std::unique_ptr<std::istream> OpenStream(const std::string& filePath);
+
+protected:
+  vtkF3DReadAhead() = default;
+  ~vtkF3DReadAhead() override = default;
+
+private:
+  vtkF3DReadAhead(const vtkF3DReadAhead&) = delete;
+  void operator=(const vtkF3DReadAhead&) = delete;
+};
+
+#endif
@@ -0,0 +1,129 @@
+#include "vtkF3DScratchArena.h"
+
+#include <vtkObjectFactory.h>
+#include <vtkSmartPointer.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+namespace
+{
+constexpr std::size_t FirstBlockSize = 64 * 1024;
+
+std::atomic<std::size_t> TotalAllocations{ 0 };
+std::atomic<std::size_t> TotalAllocatedBytes{ 0 };
+std::atomic<std::size_t> TotalBlocks{ 0 };
+std::atomic<std::size_t> TotalBlockBytes{ 0 };
+
+thread_local int ScopeDepth = 0;
+}
+
+//----------------------------------------------------------------------------
+vtkStandardNewMacro(vtkF3DScratchArena);
+
+//----------------------------------------------------------------------------
+vtkF3DScratchArena::vtkF3DScratchArena() = default;
+
+//----------------------------------------------------------------------------
+vtkF3DScratchArena::~vtkF3DScratchArena() = default;
+
+//----------------------------------------------------------------------------
+void* vtkF3DScratchArena::Allocate(std::size_t size, std::size_t alignment)
+{
+  // offset of the next aligned address in the current block
+  alignment = std::max<std::size_t>(alignment, 1);
+  const auto alignedOffset = [&](const Block& block)
+  {
+    const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(block.Data.get());
+    return static_cast<std::size_t>(
+      (address + this->Used + alignment - 1) / alignment * alignment - address);
+  };
+
+  std::size_t offset = this->Blocks.empty() ? 0 : alignedOffset(this->Blocks.back());
+  if (this->Blocks.empty() || offset + size > this->Blocks.back().Size)
+  {
+    const std::size_t previous =
+      this->Blocks.empty() ? ::FirstBlockSize / 2 : this->Blocks.back().Size;
+    const std::size_t blockSize = std::max(2 * previous, size + alignment);
+    this->Blocks.push_back(
+      { std::unique_ptr<unsigned char[]>(new unsigned char[blockSize]), blockSize });
+    ::TotalBlocks++;
+    ::TotalBlockBytes += blockSize;
+
+    this->Used = 0;
+    offset = alignedOffset(this->Blocks.back());
+  }
+
+  this->Used = offset + size;
+  ::TotalAllocations++;
+  ::TotalAllocatedBytes += size;
+  return this->Blocks.back().Data.get() + offset;
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DScratchArena::Release()
+{
+  if (this->Blocks.size() > 1)
+  {
+    this->Blocks.resize(1);
+  }
+  this->Used = 0;
+}
+
+//----------------------------------------------------------------------------
+vtkF3DScratchArena* vtkF3DScratchArena::GetThreadArena()
+{
+  thread_local vtkSmartPointer<vtkF3DScratchArena> arena =
+    vtkSmartPointer<vtkF3DScratchArena>::New();
+  return arena;
+}
+
+//----------------------------------------------------------------------------
+vtkF3DScratchArena::Scope::Scope()
+{
+  ::ScopeDepth++;
+}
+
+//----------------------------------------------------------------------------
+vtkF3DScratchArena::Scope::~Scope()
+{
+  if (--::ScopeDepth == 0)
+  {
+    vtkF3DScratchArena::GetThreadArena()->Release();
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkF3DScratchArena::Counters vtkF3DScratchArena::GetCounters()
+{
+  Counters counters;
+  counters.Allocations = ::TotalAllocations;
+  counters.AllocatedBytes = ::TotalAllocatedBytes;
+  counters.Blocks = ::TotalBlocks;
+  counters.BlockBytes = ::TotalBlockBytes;
+  return counters;
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DScratchArena::ResetCounters()
+{
+  ::TotalAllocations = 0;
+  ::TotalAllocatedBytes = 0;
+  ::TotalBlocks = 0;
+  ::TotalBlockBytes = 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DScratchArena::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  std::size_t size = 0;
+  for (const Block& block : this->Blocks)
+  {
+    size += block.Size;
+  }
+  os << indent << "Blocks: " << this->Blocks.size() << "\n";
+  os << indent << "Size: " << size << "\n";
+  os << indent << "Used: " << this->Used << "\n";
+}
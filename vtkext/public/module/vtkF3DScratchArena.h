@@ -0,0 +1,153 @@
+/**
+ * @class   vtkF3DScratchArena
+ * @brief   Monotonic memory arena for the temporary containers of the importers
+ *
+ * The conversion passes of the importers, including the ones provided by plugins, create many
+ * short-lived containers. Allocating them from the arena of the current thread only bumps
+ * a pointer in a block allocated once, and nothing is freed until the arena is released.
+ * A Scope marks the lifetime of the temporary containers: the arena of the thread is released
+ * when its outermost scope ends, only keeping its first block for the next conversions.
+ * Containers use the arena through the Allocator, eg. `vtkF3DScratchArena::Vector<int>`,
+ * and must not outlive the scope in which they are created.
+ * The counters of all the arenas tell how many allocations were served without the
+ * system allocator. An arena is not thread safe, the static methods are.
+ */
+
+#ifndef vtkF3DScratchArena_h
+#define vtkF3DScratchArena_h
+
+#include "vtkextModule.h"
+
+#include <vtkObject.h>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+class VTKEXT_EXPORT vtkF3DScratchArena : public vtkObject
+{
+public:
+  static vtkF3DScratchArena* New();
+  vtkTypeMacro(vtkF3DScratchArena, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Return memory of the given size and alignment, valid until the arena is released.
+   * A new block, at least twice as large as the previous one, is allocated when the current
+   * block is full.
+   */
+  void* Allocate(std::size_t size, std::size_t alignment);
+
+  /**
+   * Free all the allocations at once, only the first block is kept to be reused
+   */
+  void Release();
+
+  /**
+   * Return the arena of the calling thread
+   */
+  static vtkF3DScratchArena* GetThreadArena();
+
+  /**
+   * Mark the lifetime of the temporary containers created on the calling thread.
+   * The arena of the thread is released when the outermost scope ends.
+   */
+  class VTKEXT_EXPORT Scope
+  {
+  public:
+    Scope();
+    ~Scope();
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+  };
+
+  /**
+   * Standard allocator using the arena of the thread it is created on, deallocations are no-op
+   */
+  template<typename T>
+  struct Allocator
+  {
+    using value_type = T;
+
+    Allocator()
+      : Arena(vtkF3DScratchArena::GetThreadArena())
+    {
+    }
+
+    template<typename U>
+    Allocator(const Allocator<U>& other)
+      : Arena(other.Arena)
+    {
+    }
+
+    T* allocate(std::size_t n)
+    {
+      return static_cast<T*>(this->Arena->Allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T*, std::size_t)
+    {
+    }
+
+    template<typename U>
+    bool operator==(const Allocator<U>& other) const
+    {
+      return this->Arena == other.Arena;
+    }
+
+    template<typename U>
+    bool operator!=(const Allocator<U>& other) const
+    {
+      return this->Arena != other.Arena;
+    }
+
+    vtkF3DScratchArena* Arena;
+  };
+
+  template<typename T>
+  using Vector = std::vector<T, Allocator<T>>;
+
+  /**
+   * Counters of all the arenas
+   */
+  struct Counters
+  {
+    /** The number of allocations served by the arenas */
+    std::size_t Allocations = 0;
+    /** The number of bytes allocated in the arenas */
+    std::size_t AllocatedBytes = 0;
+    /** The number of blocks allocated with the system allocator */
+    std::size_t Blocks = 0;
+    /** The number of bytes of these blocks */
+    std::size_t BlockBytes = 0;
+  };
+
+  /**
+   * Get the counters accumulated by all the arenas since the last ResetCounters
+   */
+  static Counters GetCounters();
+
+  /**
+   * Set all the counters to 0
+   */
+  static void ResetCounters();
+
+protected:
+  vtkF3DScratchArena();
+  ~vtkF3DScratchArena() override;
+
+private:
+  vtkF3DScratchArena(const vtkF3DScratchArena&) = delete;
+  void operator=(const vtkF3DScratchArena&) = delete;
+
+  struct Block
+  {
+    std::unique_ptr<unsigned char[]> Data;
+    std::size_t Size;
+  };
+
+  std::vector<Block> Blocks;
+  std::size_t Used = 0;
+};
+
+#endif
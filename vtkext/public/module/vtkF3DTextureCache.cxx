@@ -0,0 +1,146 @@
+#include "vtkF3DTextureCache.h"
+
+#include <vtkImageData.h>
+#include <vtkNew.h>
+#include <vtkObjectFactory.h>
+#include <vtkTexture.h>
+#include <vtksys/SystemTools.hxx>
+
+#include <algorithm>
+#include <list>
+#include <map>
+#include <mutex>
+
+namespace
+{
+struct CachedImage
+{
+  std::string Key;
+  vtkSmartPointer<vtkImageData> Image;
+  vtkSmartPointer<vtkTexture> Textures[2];
+  vtkIdType Size = 0;
+};
+
+// The images from the most recently used to the least recently used
+std::mutex CacheMutex;
+std::list<CachedImage> Images;
+std::map<std::string, std::list<CachedImage>::iterator> ImagesByKey;
+vtkIdType CachedSize = 0;
+int Budget = 0;
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkTexture> CreateTexture(vtkImageData* image, bool sRGB)
+{
+  vtkNew<vtkTexture> texture;
+  texture->SetInputData(image);
+  texture->MipmapOn();
+  texture->InterpolateOn();
+  texture->SetColorModeToDirectScalars();
+  texture->SetUseSRGBColorSpace(sRGB);
+  return texture;
+}
+
+//----------------------------------------------------------------------------
+// Must be called with the mutex locked
+void EvictImages()
+{
+  const vtkIdType budget = static_cast<vtkIdType>(::Budget) * 1024 * 1024;
+  while (!::Images.empty() && ::CachedSize > budget)
+  {
+    ::CachedSize -= ::Images.back().Size;
+    ::ImagesByKey.erase(::Images.back().Key);
+    ::Images.pop_back();
+  }
+}
+}
+
+//----------------------------------------------------------------------------
+vtkStandardNewMacro(vtkF3DTextureCache);
+
+//----------------------------------------------------------------------------
+void vtkF3DTextureCache::SetBudget(int budget)
+{
+  const std::lock_guard<std::mutex> lock(::CacheMutex);
+  ::Budget = std::max(budget, 0);
+  ::EvictImages();
+}
+
+//----------------------------------------------------------------------------
+int vtkF3DTextureCache::GetBudget()
+{
+  const std::lock_guard<std::mutex> lock(::CacheMutex);
+  return ::Budget;
+}
+
+//----------------------------------------------------------------------------
+std::string vtkF3DTextureCache::GetFileKey(const std::string& filePath, const std::string& salt)
+{
+  std::string fullPath = vtksys::SystemTools::CollapseFullPath(filePath);
+  if (!vtksys::SystemTools::FileExists(fullPath, true))
+  {
+    return "";
+  }
+
+  return fullPath + ";" + std::to_string(vtksys::SystemTools::ModifiedTime(fullPath)) + ";" +
+    std::to_string(vtksys::SystemTools::FileLength(fullPath)) + ";" + salt;
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkImageData> vtkF3DTextureCache::FindImage(const std::string& key)
+{
+  const std::lock_guard<std::mutex> lock(::CacheMutex);
+  auto it = ::ImagesByKey.find(key);
+  if (it == ::ImagesByKey.end())
+  {
+    return nullptr;
+  }
+
+  ::Images.splice(::Images.begin(), ::Images, it->second);
+  return it->second->Image;
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DTextureCache::AddImage(const std::string& key, vtkImageData* image)
+{
+  const std::lock_guard<std::mutex> lock(::CacheMutex);
+  if (::Budget <= 0 || key.empty() || !image || image->GetNumberOfPoints() == 0 ||
+    ::ImagesByKey.count(key) > 0)
+  {
+    return;
+  }
+
+  CachedImage cached;
+  cached.Key = key;
+  cached.Image = image;
+  cached.Size = static_cast<vtkIdType>(image->GetActualMemorySize()) * 1024;
+  ::Images.emplace_front(std::move(cached));
+  ::ImagesByKey[key] = ::Images.begin();
+  ::CachedSize += ::Images.front().Size;
+  ::EvictImages();
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkTexture> vtkF3DTextureCache::GetTexture(vtkImageData* image, bool sRGB)
+{
+  const std::lock_guard<std::mutex> lock(::CacheMutex);
+  for (CachedImage& cached : ::Images)
+  {
+    if (cached.Image == image)
+    {
+      vtkSmartPointer<vtkTexture>& texture = cached.Textures[sRGB ? 1 : 0];
+      if (!texture)
+      {
+        texture = ::CreateTexture(image, sRGB);
+      }
+      return texture;
+    }
+  }
+  return ::CreateTexture(image, sRGB);
+}
+
+//----------------------------------------------------------------------------
+int vtkF3DTextureCache::GetNumberOfImages()
+{
+  const std::lock_guard<std::mutex> lock(::CacheMutex);
+  return static_cast<int>(::Images.size());
+}
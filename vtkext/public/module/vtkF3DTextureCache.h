@@ -0,0 +1,88 @@
+/**
+ * @class   vtkF3DTextureCache
+ * @brief   Cache of the texture images decoded by the importers, shared between files
+ *
+ * The texture files read by importers, including the ones provided by plugins, are stored
+ * with a key identifying their content, so that the other files of a group and the next imports
+ * of the same files do not decode them again. The key is made of the full path, the modification
+ * time and the size of the file, and of the parameters the decoded image depends on.
+ * The textures created with GetTexture for a cached image are shared as well, so that a texture
+ * used by the files of a group is uploaded to the GPU once.
+ * The images that were not used for the longest time are evicted first once the cached images
+ * exceed the memory budget. The cache is disabled when the budget is 0, which is the default.
+ * All methods are thread safe.
+ */
+
+#ifndef vtkF3DTextureCache_h
+#define vtkF3DTextureCache_h
+
+#include "vtkextModule.h"
+
+#include <vtkObject.h>
+#include <vtkSmartPointer.h>
+
+#include <string>
+
+class vtkImageData;
+class vtkTexture;
+
+class VTKEXT_EXPORT vtkF3DTextureCache : public vtkObject
+{
+public:
+  static vtkF3DTextureCache* New();
+  vtkTypeMacro(vtkF3DTextureCache, vtkObject);
+
+  ///@{
+  /**
+   * Set/Get the memory budget of the cached images, in megabytes.
+   * The images not used for the longest time are evicted when it is exceeded, 0 clears and
+   * disables the cache.
+   * Default is 0.
+   */
+  static void SetBudget(int budget);
+  static int GetBudget();
+  ///@}
+
+  /**
+   * Return the key of the image decoded from a texture file, made of its full path,
+   * modification time and size, and of the provided salt, eg. the maximum size of the image.
+   * Return an empty string if the file does not exist.
+   */
+  static std::string GetFileKey(const std::string& filePath, const std::string& salt);
+
+  /**
+   * Return the image cached for the key, marking it as the most recently used,
+   * or nullptr if there is none.
+   * The cached images are shared and must not be modified.
+   */
+  static vtkSmartPointer<vtkImageData> FindImage(const std::string& key);
+
+  /**
+   * Store the image decoded for the key if the cache is enabled, then evict the images
+   * not used for the longest time if the budget is exceeded.
+   * The image must not be modified afterwards.
+   */
+  static void AddImage(const std::string& key, vtkImageData* image);
+
+  /**
+   * Return a texture of the image with mipmaps, interpolation and direct scalars, in the sRGB
+   * color space if requested. A cached image always returns the same texture for a color space,
+   * other images return a new texture.
+   */
+  static vtkSmartPointer<vtkTexture> GetTexture(vtkImageData* image, bool sRGB);
+
+  /**
+   * Return the number of cached images.
+   */
+  static int GetNumberOfImages();
+
+protected:
+  vtkF3DTextureCache() = default;
+  ~vtkF3DTextureCache() override = default;
+
+private:
+  vtkF3DTextureCache(const vtkF3DTextureCache&) = delete;
+  void operator=(const vtkF3DTextureCache&) = delete;
+};
+
+#endif
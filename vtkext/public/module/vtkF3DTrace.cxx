@@ -0,0 +1,180 @@
+#include "vtkF3DTrace.h"
+
+#include <vtkObjectFactory.h>
+#include <vtksys/FStream.hxx>
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+struct Span
+{
+  std::string Name;
+  std::int64_t Start;
+  std::int64_t End;
+  std::size_t Thread;
+};
+
+struct Counter
+{
+  std::string Name;
+  std::int64_t Time;
+  std::int64_t Value;
+};
+
+std::atomic<bool> TraceEnabled = false;
+std::mutex TraceMutex;
+std::string TraceFileName;
+std::vector<Span> TraceSpans;
+std::vector<Counter> TraceCounters;
+std::map<std::thread::id, std::size_t> TraceThreads;
+const std::chrono::steady_clock::time_point TraceOrigin = std::chrono::steady_clock::now();
+
+//----------------------------------------------------------------------------
+std::string EscapeJSON(const std::string& str)
+{
+  std::string escaped;
+  escaped.reserve(str.size());
+  for (char c : str)
+  {
+    if (c == '"' || c == '\\')
+    {
+      escaped += '\\';
+      escaped += c;
+    }
+    else if (static_cast<unsigned char>(c) < 0x20)
+    {
+      escaped += ' ';
+    }
+    else
+    {
+      escaped += c;
+    }
+  }
+  return escaped;
+}
+}
+
+//----------------------------------------------------------------------------
+vtkStandardNewMacro(vtkF3DTrace);
+
+//----------------------------------------------------------------------------
+void vtkF3DTrace::Start(const std::string& fileName)
+{
+  const std::lock_guard<std::mutex> lock(::TraceMutex);
+  ::TraceFileName = fileName;
+  ::TraceSpans.clear();
+  ::TraceCounters.clear();
+  ::TraceThreads.clear();
+  ::TraceEnabled = true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DTrace::Stop()
+{
+  std::vector<Span> spans;
+  std::vector<Counter> counters;
+  std::string fileName;
+  {
+    const std::lock_guard<std::mutex> lock(::TraceMutex);
+    if (!::TraceEnabled)
+    {
+      return false;
+    }
+    ::TraceEnabled = false;
+    spans.swap(::TraceSpans);
+    counters.swap(::TraceCounters);
+    fileName = ::TraceFileName;
+  }
+
+  vtksys::ofstream file(fileName.c_str());
+  if (!file.is_open())
+  {
+    return false;
+  }
+
+  // Complete events, see the "Trace Event Format" specification
+  file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  for (std::size_t i = 0; i < spans.size(); i++)
+  {
+    const Span& span = spans[i];
+    file << (i > 0 ? "," : "") << "\n{\"name\":\"" << ::EscapeJSON(span.Name)
+         << "\",\"cat\":\"f3d\",\"ph\":\"X\",\"ts\":" << span.Start
+         << ",\"dur\":" << span.End - span.Start << ",\"pid\":1,\"tid\":" << span.Thread << "}";
+  }
+
+  // Counter events
+  for (std::size_t i = 0; i < counters.size(); i++)
+  {
+    const Counter& counter = counters[i];
+    file << (i > 0 || !spans.empty() ? "," : "") << "\n{\"name\":\"" << ::EscapeJSON(counter.Name)
+         << "\",\"cat\":\"f3d\",\"ph\":\"C\",\"ts\":" << counter.Time
+         << ",\"pid\":1,\"args\":{\"value\":" << counter.Value << "}}";
+  }
+  file << "\n]}\n";
+
+  return file.good();
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DTrace::IsEnabled()
+{
+  return ::TraceEnabled;
+}
+
+//----------------------------------------------------------------------------
+std::int64_t vtkF3DTrace::GetTime()
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+    std::chrono::steady_clock::now() - ::TraceOrigin)
+    .count();
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DTrace::AddSpan(const std::string& name, std::int64_t start, std::int64_t end)
+{
+  if (!::TraceEnabled)
+  {
+    return;
+  }
+
+  const std::lock_guard<std::mutex> lock(::TraceMutex);
+  auto thread = ::TraceThreads.emplace(std::this_thread::get_id(), ::TraceThreads.size()).first;
+  ::TraceSpans.push_back({ name, start, end, thread->second });
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DTrace::AddCounter(const std::string& name, std::int64_t value)
+{
+  if (!::TraceEnabled)
+  {
+    return;
+  }
+
+  const std::lock_guard<std::mutex> lock(::TraceMutex);
+  ::TraceCounters.push_back({ name, vtkF3DTrace::GetTime(), value });
+}
+
+//----------------------------------------------------------------------------
+vtkF3DTrace::Scope::Scope(const char* name)
+  : Name(name)
+{
+  if (::TraceEnabled)
+  {
+    this->StartTime = vtkF3DTrace::GetTime();
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkF3DTrace::Scope::~Scope()
+{
+  if (this->StartTime >= 0)
+  {
+    vtkF3DTrace::AddSpan(this->Name, this->StartTime, vtkF3DTrace::GetTime());
+  }
+}
@@ -0,0 +1,96 @@
+/**
+ * @class   vtkF3DTrace
+ * @brief   Scoped spans trace shared between libf3d and plugins
+ *
+ * This class records spans of time, usually using the F3D_TRACE_SCOPE macro,
+ * and writes them in the Chrome trace event JSON format that can be opened with
+ * chrome://tracing or https://ui.perfetto.dev.
+ * Nothing is recorded until Start is called, a disabled scope only costs an atomic load.
+ * All static methods are thread safe.
+ */
+
+#ifndef vtkF3DTrace_h
+#define vtkF3DTrace_h
+
+#include "vtkextModule.h"
+
+#include <vtkObject.h>
+
+#include <cstdint>
+#include <string>
+
+class VTKEXT_EXPORT vtkF3DTrace : public vtkObject
+{
+public:
+  static vtkF3DTrace* New();
+  vtkTypeMacro(vtkF3DTrace, vtkObject);
+
+  /**
+   * Start recording spans, they will be written in the provided file when calling Stop.
+   * Spans recorded by a previous Start are discarded.
+   */
+  static void Start(const std::string& fileName);
+
+  /**
+   * Stop recording spans and write them in the file provided to Start.
+   * Returns false if the trace was not started or if the file cannot be written.
+   */
+  static bool Stop();
+
+  /**
+   * Return true if spans are currently recorded
+   */
+  static bool IsEnabled();
+
+  /**
+   * Get the current time of the trace in microseconds
+   */
+  static std::int64_t GetTime();
+
+  /**
+   * Record a span between the provided trace times, on the current thread.
+   * Does nothing if spans are not recorded.
+   */
+  static void AddSpan(const std::string& name, std::int64_t start, std::int64_t end);
+
+  /**
+   * Record the value of a counter at the current trace time, shown as a graph in the trace.
+   * Does nothing if spans are not recorded.
+   */
+  static void AddCounter(const std::string& name, std::int64_t value);
+
+  /**
+   * A span recorded from its construction to its destruction
+   */
+  class VTKEXT_EXPORT Scope
+  {
+  public:
+    explicit Scope(const char* name);
+    ~Scope();
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+  private:
+    const char* Name;
+    std::int64_t StartTime = -1;
+  };
+
+protected:
+  vtkF3DTrace() = default;
+  ~vtkF3DTrace() override = default;
+
+private:
+  vtkF3DTrace(const vtkF3DTrace&) = delete;
+  void operator=(const vtkF3DTrace&) = delete;
+};
+
+#define F3D_TRACE_CONCAT_INTERNAL(a, b) a##b
+#define F3D_TRACE_CONCAT(a, b) F3D_TRACE_CONCAT_INTERNAL(a, b)
+
+/**
+ * Record a span named `name`, a `const char*`, until the end of the current scope
+ */
+#define F3D_TRACE_SCOPE(name)                                                                      \
+  const vtkF3DTrace::Scope F3D_TRACE_CONCAT(f3dTraceScope, __LINE__)(name)
+
+#endif
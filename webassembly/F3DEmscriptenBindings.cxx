@@ -1,4 +1,5 @@
 #include <emscripten/bind.h>
+#include <emscripten/val.h>
 
 #include "engine.h"
 #include "interactor.h"
@@ -54,6 +55,21 @@ f3d::scene& add(f3d::scene& l, const std::string& p)
 {
   return l.add(p);
 }
+f3d::scene& addBuffer(f3d::scene& l, const emscripten::val& data, const std::string& format)
+{
+  // copy the Uint8Array from the JavaScript heap
+  std::vector<std::byte> buffer(data["length"].as<size_t>());
+  emscripten::val view{ emscripten::typed_memory_view(
+    buffer.size(), reinterpret_cast<unsigned char*>(buffer.data())) };
+  view.call<void>("set", data);
+  return l.add(buffer.data(), buffer.size(), format);
+}
+#ifdef __EMSCRIPTEN_PTHREADS__
+std::shared_ptr<f3d::scene::load_handle> addAsync(f3d::scene& l, const std::string& p)
+{
+  return l.addAsync({ p });
+}
+#endif
 bool supports(f3d::scene& l, const std::string& p)
 {
   return l.supports(p);
@@ -84,11 +100,30 @@ EMSCRIPTEN_BINDINGS(f3d)
     .function("set_color", &set_color, emscripten::return_value_policy::reference());
 
   // f3d::scene
-  emscripten::class_<f3d::scene>("Scene")
-    .function("supports", &supports, emscripten::return_value_policy::reference())
+  emscripten::class_<f3d::scene> scene("Scene");
+
+  scene.function("supports", &supports, emscripten::return_value_policy::reference())
     .function("add", &add, emscripten::return_value_policy::reference())
+    .function("addBuffer", &addBuffer, emscripten::return_value_policy::reference())
     .function("clear", &clear, emscripten::return_value_policy::reference());
 
+#ifdef __EMSCRIPTEN_PTHREADS__
+  // asynchronous loads, read by a worker while the page keeps rendering
+  emscripten::enum_<f3d::scene::load_handle::Status>("LoadStatus")
+    .value("LOADING", f3d::scene::load_handle::Status::LOADING)
+    .value("LOADED", f3d::scene::load_handle::Status::LOADED)
+    .value("CANCELLED", f3d::scene::load_handle::Status::CANCELLED)
+    .value("FAILED", f3d::scene::load_handle::Status::FAILED);
+
+  emscripten::class_<f3d::scene::load_handle>("LoadHandle")
+    .smart_ptr<std::shared_ptr<f3d::scene::load_handle>>("LoadHandlePtr")
+    .function("getStatus", &f3d::scene::load_handle::getStatus)
+    .function("getProgress", &f3d::scene::load_handle::getProgress)
+    .function("cancel", &f3d::scene::load_handle::cancel);
+
+  scene.function("addAsync", &addAsync);
+#endif
+
   // f3d::window
   emscripten::class_<f3d::window>("Window")
     .function("setSize", &f3d::window::setSize, emscripten::return_value_policy::reference())
@@ -10,6 +10,7 @@ cmake -S /src -B /build \
     -DF3D_PLUGIN_BUILD_EXODUS=OFF \
     -DF3D_PLUGIN_BUILD_OCCT=ON \
     -DF3D_WASM_COPY_APP=ON \
+    -DF3D_WASM_THREADS=${2:-OFF} \
     -DCMAKE_BUILD_TYPE=$1 \
     -DCMAKE_FIND_ROOT_PATH:PATH=/depends
 
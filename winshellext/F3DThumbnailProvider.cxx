@@ -1,11 +1,14 @@
 #include "F3DThumbnailProvider.h"
 
+#include <nlohmann/json.hpp>
+
 #include <clocale>
 #include <codecvt>
 #include <locale>
 #include <pathcch.h>
 #include <shlwapi.h>
 #include <sstream>
+#include <string>
 #include <thumbcache.h>
 #include <wincodec.h>
 
@@ -86,6 +89,134 @@ HRESULT ConvertBitmapSourceTo32BPPHBITMAP(
   pBitmapSourceConverted->Release();
   return hr;
 }
+
+//------------------------------------------------------------------------------
+HRESULT LoadThumbnail(LPCWSTR image_filename, HBITMAP* phbmp, WTS_ALPHATYPE* pdwAlpha)
+{
+  // Create WIC factory
+  IWICImagingFactory* pIWICFactory = nullptr;
+  HRESULT hr = CoCreateInstance(
+    CLSID_WICImagingFactory, nullptr, CLSCTX_INPROC_SERVER, IID_PPV_ARGS(&pIWICFactory));
+
+  if (FAILED(hr))
+  {
+    return hr;
+  }
+
+  // Create image decoder
+  IWICBitmapDecoder* pDecoder = nullptr;
+  hr = pIWICFactory->CreateDecoderFromFilename(
+    image_filename, nullptr, GENERIC_READ, WICDecodeMetadataCacheOnDemand, &pDecoder);
+
+  if (FAILED(hr))
+  {
+    pIWICFactory->Release();
+    return hr;
+  }
+
+  // Load the first image frame
+  IWICBitmapFrameDecode* pFrame = nullptr;
+  hr = pDecoder->GetFrame(0, &pFrame);
+
+  if (FAILED(hr))
+  {
+    pDecoder->Release();
+    pIWICFactory->Release();
+    return hr;
+  }
+
+  // Convert to 32bpp BGRA format with pre-multiplied alpha
+  hr = ::ConvertBitmapSourceTo32BPPHBITMAP(pFrame, pIWICFactory, phbmp);
+  *pdwAlpha = WTSAT_ARGB;
+
+  pFrame->Release();
+  pDecoder->Release();
+  pIWICFactory->Release();
+  return hr;
+}
+
+//------------------------------------------------------------------------------
+std::string ToUTF8(const std::wstring& str)
+{
+  int size = WideCharToMultiByte(CP_UTF8, 0, str.c_str(), -1, nullptr, 0, nullptr, nullptr);
+  std::string utf8(size > 0 ? size - 1 : 0, '\0');
+  WideCharToMultiByte(CP_UTF8, 0, str.c_str(), -1, utf8.data(), size, nullptr, nullptr);
+  return utf8;
+}
+
+//------------------------------------------------------------------------------
+std::wstring FromUTF8(const std::string& str)
+{
+  int size = MultiByteToWideChar(CP_UTF8, 0, str.c_str(), -1, nullptr, 0);
+  std::wstring wide(size > 0 ? size - 1 : 0, L'\0');
+  MultiByteToWideChar(CP_UTF8, 0, str.c_str(), -1, wide.data(), size);
+  return wide;
+}
+
+//------------------------------------------------------------------------------
+// Ask the thumbnail server for a thumbnail, and return the cached image or an empty string.
+// The server is started in the background if it is not running, so the next thumbnails use it.
+std::wstring RequestThumbnailServer(LPCWSTR serverPath, LPCWSTR filePath, UINT cx)
+{
+  wchar_t user[256] = L"";
+  GetEnvironmentVariableW(L"USERNAME", user, ARRAYSIZE(user));
+  std::wstring pipeName = std::wstring(L"\\\\.\\pipe\\f3d-thumbnail-") + user;
+
+  HANDLE pipe = CreateFileW(
+    pipeName.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, OPEN_EXISTING, 0, nullptr);
+  if (pipe == INVALID_HANDLE_VALUE && GetLastError() == ERROR_PIPE_BUSY &&
+    WaitNamedPipeW(pipeName.c_str(), F3D_WINDOWS_THUMBNAIL_TIMEOUT))
+  {
+    pipe = CreateFileW(
+      pipeName.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, OPEN_EXISTING, 0, nullptr);
+  }
+
+  if (pipe == INVALID_HANDLE_VALUE)
+  {
+    if (GetLastError() == ERROR_FILE_NOT_FOUND && PathFileExistsW(serverPath))
+    {
+      PROCESS_INFORMATION pi;
+      ZeroMemory(&pi, sizeof(PROCESS_INFORMATION));
+      STARTUPINFO si;
+      ZeroMemory(&si, sizeof(STARTUPINFO));
+      si.cb = sizeof(STARTUPINFO);
+
+      wchar_t command[MAX_PATH + 2];
+      swprintf_s(command, MAX_PATH + 2, L"\"%s\"", serverPath);
+      if (CreateProcess(serverPath, command, nullptr, nullptr, FALSE,
+            DETACHED_PROCESS | CREATE_NO_WINDOW, nullptr, nullptr, &si, &pi))
+      {
+        CloseHandle(pi.hThread);
+        CloseHandle(pi.hProcess);
+      }
+    }
+    return {};
+  }
+
+  nlohmann::json request = { { "input", ::ToUTF8(filePath) }, { "size", cx } };
+  std::string data = request.dump() + "\n";
+  DWORD written = 0;
+  std::string response;
+  if (WriteFile(pipe, data.data(), static_cast<DWORD>(data.size()), &written, nullptr) &&
+    written == data.size())
+  {
+    char c;
+    DWORD read = 0;
+    while (ReadFile(pipe, &c, 1, &read, nullptr) && read == 1 && c != '\n')
+    {
+      response += c;
+    }
+  }
+  CloseHandle(pipe);
+
+  nlohmann::json result = nlohmann::json::parse(response, nullptr, false);
+  if (!result.is_object() || result.value("status", "") != "success" ||
+    !result["output"].is_string())
+  {
+    return {};
+  }
+  return ::FromUTF8(result["output"].get<std::string>());
+}
 }
 
 //------------------------------------------------------------------------------
@@ -101,6 +232,7 @@ F3DThumbnailProvider::F3DThumbnailProvider()
   {
     ::PathCchRemoveFileSpec(dll_path, MAX_PATH);
     PathCchCombine(m_f3dPath, MAX_PATH, dll_path, L"f3d.exe");
+    PathCchCombine(m_serverPath, MAX_PATH, dll_path, L"f3d-thumbnail-server.exe");
   }
 }
 
@@ -145,6 +277,15 @@ IFACEMETHODIMP F3DThumbnailProvider::Initialize(LPCWSTR pszFilePath, DWORD)
 // Generate the thumbnail bitmap for the requested file.
 IFACEMETHODIMP F3DThumbnailProvider::GetThumbnail(UINT cx, HBITMAP* phbmp, WTS_ALPHATYPE* pdwAlpha)
 {
+  // Use the thumbnail server when it is running, its images are cached and must not be deleted
+  std::wstring cached_filename = ::RequestThumbnailServer(m_serverPath, m_filePath, cx);
+  if (!cached_filename.empty() &&
+    SUCCEEDED(::LoadThumbnail(cached_filename.c_str(), phbmp, pdwAlpha)))
+  {
+    return S_OK;
+  }
+
+  // Otherwise, run f3d to produce the thumbnail
   // Get a temporary PNG image file name
   wchar_t lpTempPathBuffer[MAX_PATH];
   wchar_t image_filename[MAX_PATH];
@@ -207,49 +348,7 @@ IFACEMETHODIMP F3DThumbnailProvider::GetThumbnail(UINT cx, HBITMAP* phbmp, WTS_A
   }
 
   // Load the created image
-
-  // Create WIC factory
-  IWICImagingFactory* pIWICFactory = nullptr;
-  HRESULT hr = CoCreateInstance(
-    CLSID_WICImagingFactory, nullptr, CLSCTX_INPROC_SERVER, IID_PPV_ARGS(&pIWICFactory));
-
-  if (FAILED(hr))
-  {
-    DeleteFile(image_filename);
-    return hr;
-  }
-
-  // Create image decoder
-  IWICBitmapDecoder* pDecoder = nullptr;
-  hr = pIWICFactory->CreateDecoderFromFilename(
-    LPCWSTR(image_filename), nullptr, GENERIC_READ, WICDecodeMetadataCacheOnDemand, &pDecoder);
-
-  if (FAILED(hr))
-  {
-    pIWICFactory->Release();
-    DeleteFile(image_filename);
-    return hr;
-  }
-
-  // Load the first image frame
-  IWICBitmapFrameDecode* pFrame = nullptr;
-  hr = pDecoder->GetFrame(0, &pFrame);
-
-  if (FAILED(hr))
-  {
-    pDecoder->Release();
-    pIWICFactory->Release();
-    DeleteFile(image_filename);
-    return hr;
-  }
-
-  // Convert to 32bpp BGRA format with pre-multiplied alpha
-  hr = ::ConvertBitmapSourceTo32BPPHBITMAP(pFrame, pIWICFactory, phbmp);
-  *pdwAlpha = WTSAT_ARGB;
-
-  pFrame->Release();
-  pDecoder->Release();
-  pIWICFactory->Release();
+  HRESULT hr = ::LoadThumbnail(image_filename, phbmp, pdwAlpha);
 
   // Delete the temporary image file
   if (!DeleteFile(image_filename))
@@ -45,6 +45,9 @@ private:
   // The path to f3d executable that will be used to produce the thumbnail
   wchar_t m_f3dPath[MAX_PATH];
 
+  // The path to the thumbnail server that is used instead of f3d when it is running
+  wchar_t m_serverPath[MAX_PATH];
+
   // The path to the file for which we will have to produce the thumbnail
   wchar_t m_filePath[MAX_PATH];
 };